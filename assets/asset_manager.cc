@@ -6,6 +6,7 @@
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/fml/trace_event.h"
+#include "rapidjson/document.h"
 
 namespace flutter {
 
@@ -69,6 +70,70 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> AssetManager::GetAsExecutableMapping(
+    const std::string& asset_name) const {
+  if (asset_name.size() == 0) {
+    return nullptr;
+  }
+  TRACE_EVENT1("flutter", "AssetManager::GetAsExecutableMapping", "name",
+               asset_name.c_str());
+  for (const auto& resolver : resolvers_) {
+    auto mapping = resolver->GetAsExecutableMapping(asset_name);
+    if (mapping != nullptr) {
+      return mapping;
+    }
+  }
+  FML_DLOG(WARNING) << "Could not find executable asset: " << asset_name;
+  return nullptr;
+}
+
+// |AssetResolver|
+bool AssetManager::PrefetchAsset(const std::string& asset_name) const {
+  if (asset_name.size() == 0) {
+    return false;
+  }
+  for (const auto& resolver : resolvers_) {
+    if (resolver->PrefetchAsset(asset_name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t AssetManager::PrefetchManifestAssets() const {
+  TRACE_EVENT0("flutter", "AssetManager::PrefetchManifestAssets");
+  std::unique_ptr<fml::Mapping> manifest;
+  for (const auto& resolver : resolvers_) {
+    manifest = resolver->GetAsMapping(kPrefetchManifestName);
+    if (manifest) {
+      break;
+    }
+  }
+  if (!manifest) {
+    return 0;
+  }
+
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(manifest->GetMapping()),
+                 manifest->GetSize());
+  if (document.HasParseError() || !document.IsArray()) {
+    FML_LOG(ERROR) << "Could not parse the asset prefetch manifest.";
+    return 0;
+  }
+
+  size_t prefetched = 0;
+  for (const auto& name : document.GetArray()) {
+    if (!name.IsString()) {
+      continue;
+    }
+    if (PrefetchAsset(std::string(name.GetString(), name.GetStringLength()))) {
+      prefetched++;
+    }
+  }
+  return prefetched;
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
   return resolvers_.size() > 0;
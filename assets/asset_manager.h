@@ -17,6 +17,15 @@ namespace flutter {
 
 class AssetManager final : public AssetResolver {
  public:
+  //----------------------------------------------------------------------------
+  /// The name of the asset listing the assets to prefetch at startup.
+  ///
+  /// The manifest is a JSON array of asset names, usually the assets used by
+  /// the first frames of the application. It can be recorded from a startup
+  /// trace by collecting the names of the `AssetManager::GetAsMapping` events.
+  ///
+  static constexpr char kPrefetchManifestName[] = "AssetPrefetchManifest.json";
+
   AssetManager();
 
   ~AssetManager() override;
@@ -41,6 +50,22 @@ class AssetManager final : public AssetResolver {
   std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
       const std::string& asset_pattern) const override;
 
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsExecutableMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  bool PrefetchAsset(const std::string& asset_name) const override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prefetches the assets listed in the prefetch manifest, if
+  ///             there is one. This may block on I/O and is meant to be called
+  ///             on a background thread.
+  ///
+  /// @return     The number of assets being prefetched.
+  ///
+  size_t PrefetchManifestAssets() const;
+
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
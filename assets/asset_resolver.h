@@ -49,6 +49,30 @@ class AssetResolver {
     return {};
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Same as |GetAsMapping| but maps the asset readable and
+  ///             executable, so that it can hold machine code such as the
+  ///             instructions of an AOT loading unit.
+  ///
+  /// @return     The mapping, or nullptr if the asset is not found or this
+  ///             resolver can not map assets executable.
+  ///
+  [[nodiscard]] virtual std::unique_ptr<fml::Mapping> GetAsExecutableMapping(
+      const std::string& asset_name) const {
+    return nullptr;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts reading the asset into memory in the background so
+  ///             that a later call to |GetAsMapping| does not block on I/O.
+  ///
+  /// @return     Whether this resolver holds the asset and started reading
+  ///             it. Resolvers that can not read ahead return false.
+  ///
+  virtual bool PrefetchAsset(const std::string& asset_name) const {
+    return false;
+  }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(AssetResolver);
 };
@@ -0,0 +1,257 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/compressed_asset_bundle.h"
+
+#include <cstring>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kContainerMagic = 0x42414346;  // "FCAB"
+constexpr uint32_t kContainerVersion = 1;
+
+struct ContainerHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t reserved;
+};
+
+struct IndexRecord {
+  uint32_t name_size;
+  uint32_t method;
+  uint64_t offset;
+  uint64_t compressed_size;
+  uint64_t size;
+};
+
+// The size up to which an entry may decompress, so that a corrupt index
+// cannot make the bundle allocate arbitrary amounts of memory.
+constexpr uint64_t kMaxEntrySize = 1u << 30;
+
+// The highest ratio of the sizes of the data and its deflate stream that
+// zlib can produce.
+constexpr uint64_t kMaxDeflateRatio = 1032;
+
+bool IsValidRecord(const IndexRecord& record,
+                   size_t index_end,
+                   size_t container_size) {
+  // The data of an entry lies after the index and within the container.
+  if (record.offset < index_end || record.offset > container_size ||
+      record.compressed_size > container_size - record.offset ||
+      record.size > kMaxEntrySize) {
+    return false;
+  }
+  switch (static_cast<CompressedAssetBundle::Method>(record.method)) {
+    case CompressedAssetBundle::Method::kStored:
+      return record.size == record.compressed_size;
+    case CompressedAssetBundle::Method::kDeflate:
+      return record.size <= record.compressed_size * kMaxDeflateRatio;
+  }
+  return false;
+}
+
+}  // namespace
+
+CompressedAssetBundle::CompressedAssetBundle(
+    std::unique_ptr<fml::Mapping> container,
+    bool is_valid_after_asset_manager_change,
+    size_t cache_capacity)
+    : container_(std::move(container)), cache_capacity_(cache_capacity) {
+  if (!container_ || container_->GetMapping() == nullptr || !ReadIndex()) {
+    index_.clear();
+    return;
+  }
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+CompressedAssetBundle::~CompressedAssetBundle() = default;
+
+size_t CompressedAssetBundle::GetCachedBytes() const {
+  std::scoped_lock lock(cache_mutex_);
+  return cached_bytes_;
+}
+
+// |AssetResolver|
+bool CompressedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool CompressedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> CompressedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  auto found = index_.find(asset_name);
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  return GetEntryMapping(found->first, found->second);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>>
+CompressedAssetBundle::GetAsMappings(const std::string& asset_pattern) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    return mappings;
+  }
+
+  std::regex asset_regex(asset_pattern);
+  for (const auto& item : index_) {
+    // Match against the file name like |DirectoryAssetBundle| does.
+    const size_t separator = item.first.find_last_of('/');
+    const std::string filename = separator == std::string::npos
+                                     ? item.first
+                                     : item.first.substr(separator + 1);
+    if (!std::regex_match(filename, asset_regex)) {
+      continue;
+    }
+    auto mapping = GetEntryMapping(item.first, item.second);
+    if (mapping) {
+      mappings.push_back(std::move(mapping));
+    } else {
+      FML_LOG(ERROR) << "Mapping " << item.first << " failed";
+    }
+  }
+  return mappings;
+}
+
+bool CompressedAssetBundle::ReadIndex() {
+  const uint8_t* data = container_->GetMapping();
+  const size_t size = container_->GetSize();
+
+  ContainerHeader header = {};
+  if (size < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.magic != kContainerMagic || header.version != kContainerVersion) {
+    FML_LOG(ERROR) << "Unknown compressed asset bundle format.";
+    return false;
+  }
+
+  size_t offset = sizeof(header);
+  // Every record takes at least its fixed size, which bounds the entry count
+  // before anything is allocated for it.
+  if (header.entry_count > (size - offset) / sizeof(IndexRecord)) {
+    FML_LOG(ERROR) << "Corrupt compressed asset bundle index.";
+    return false;
+  }
+  std::vector<std::pair<std::string, IndexRecord>> records;
+  records.reserve(header.entry_count);
+  for (uint32_t i = 0; i < header.entry_count; i++) {
+    IndexRecord record = {};
+    if (size - offset < sizeof(record)) {
+      FML_LOG(ERROR) << "Corrupt compressed asset bundle index.";
+      return false;
+    }
+    memcpy(&record, data + offset, sizeof(record));
+    offset += sizeof(record);
+    if (size - offset < record.name_size) {
+      FML_LOG(ERROR) << "Corrupt compressed asset bundle index.";
+      return false;
+    }
+    records.emplace_back(
+        std::string(reinterpret_cast<const char*>(data + offset),
+                    record.name_size),
+        record);
+    offset += record.name_size;
+  }
+
+  // The index ends at |offset| now that all the names were read.
+  for (auto& [name, record] : records) {
+    if (!IsValidRecord(record, offset, size)) {
+      FML_LOG(ERROR) << "Corrupt compressed asset bundle entry " << name;
+      return false;
+    }
+    index_[std::move(name)] = {static_cast<Method>(record.method),
+                               static_cast<size_t>(record.offset),
+                               static_cast<size_t>(record.compressed_size),
+                               static_cast<size_t>(record.size)};
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> CompressedAssetBundle::GetEntryMapping(
+    const std::string& name,
+    const Entry& entry) const {
+  if (entry.size == 0) {
+    return std::make_unique<fml::DataMapping>(std::vector<uint8_t>());
+  }
+
+  if (entry.method == Method::kStored) {
+    std::shared_ptr<fml::Mapping> container = container_;
+    return std::make_unique<fml::NonOwnedMapping>(
+        container_->GetMapping() + entry.offset, entry.size,
+        [container](const uint8_t*, size_t) {});
+  }
+
+  std::shared_ptr<const Blob> blob = GetDecompressedBlob(name, entry);
+  if (!blob) {
+    return nullptr;
+  }
+  return std::make_unique<fml::NonOwnedMapping>(
+      blob->data(), blob->size(), [blob](const uint8_t*, size_t) {});
+}
+
+std::shared_ptr<const CompressedAssetBundle::Blob>
+CompressedAssetBundle::GetDecompressedBlob(const std::string& name,
+                                           const Entry& entry) const {
+  {
+    std::scoped_lock lock(cache_mutex_);
+    auto found = cache_index_.find(name);
+    if (found != cache_index_.end()) {
+      cache_.splice(cache_.begin(), cache_, found->second);
+      return found->second->blob;
+    }
+  }
+
+  // Decompress without holding the lock so that other assets can be served
+  // meanwhile. Concurrent requests for the same asset may both decompress it.
+  TRACE_EVENT1("flutter", "CompressedAssetBundle::Decompress", "name",
+               name.c_str());
+  auto blob = std::make_shared<Blob>(entry.size);
+  uLongf size = entry.size;
+  const int result =
+      ::uncompress(blob->data(), &size, container_->GetMapping() + entry.offset,
+                   entry.compressed_size);
+  if (result != Z_OK || size != entry.size) {
+    FML_LOG(ERROR) << "Could not decompress asset " << name;
+    return nullptr;
+  }
+
+  std::scoped_lock lock(cache_mutex_);
+  auto found = cache_index_.find(name);
+  if (found != cache_index_.end()) {
+    cache_.splice(cache_.begin(), cache_, found->second);
+    return found->second->blob;
+  }
+  if (blob->size() > cache_capacity_) {
+    return blob;
+  }
+  while (cached_bytes_ + blob->size() > cache_capacity_) {
+    cached_bytes_ -= cache_.back().blob->size();
+    cache_index_.erase(cache_.back().name);
+    cache_.pop_back();
+  }
+  cache_.push_front({name, blob});
+  cache_index_[name] = cache_.begin();
+  cached_bytes_ += blob->size();
+  return blob;
+}
+
+}  // namespace flutter
@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_COMPRESSED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_COMPRESSED_ASSET_BUNDLE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// An asset resolver for a single container file holding individually
+/// compressed assets.
+///
+/// The container starts with a header and an index of its entries, followed
+/// by the data of each entry. All integers are little endian.
+///
+///   header: u32 magic ("FCAB"), u32 version, u32 entry count, u32 reserved
+///   index:  per entry u32 name size, u32 method, u64 offset,
+///           u64 compressed size, u64 size, then the name
+///
+/// The method is |kStored| or |kDeflate| (a zlib stream). Offsets are from the
+/// start of the container. The bundle is invalid if the data of an entry is
+/// not between the index and the end of the container, or if its size is more
+/// than its data can decompress to.
+///
+/// Only the index is read when the bundle is created. An entry is decompressed
+/// the first time it is requested and kept in an LRU cache of decompressed
+/// entries of at most |cache_capacity| bytes. Mappings handed out keep their
+/// data alive after eviction. Stored entries are returned as mappings into the
+/// container without a copy.
+///
+class CompressedAssetBundle : public AssetResolver {
+ public:
+  enum class Method : uint32_t {
+    kStored = 0,
+    kDeflate = 1,
+  };
+
+  static constexpr char kFileName[] = "flutter_assets.fcab";
+
+  static constexpr size_t kDefaultCacheCapacity = 8 * 1024 * 1024;
+
+  CompressedAssetBundle(std::unique_ptr<fml::Mapping> container,
+                        bool is_valid_after_asset_manager_change,
+                        size_t cache_capacity = kDefaultCacheCapacity);
+
+  ~CompressedAssetBundle() override;
+
+  size_t GetCachedBytes() const;
+
+ private:
+  struct Entry {
+    Method method;
+    size_t offset;
+    size_t compressed_size;
+    size_t size;
+  };
+
+  using Blob = std::vector<uint8_t>;
+
+  struct CachedBlob {
+    std::string name;
+    std::shared_ptr<const Blob> blob;
+  };
+
+  const std::shared_ptr<fml::Mapping> container_;
+  const size_t cache_capacity_;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+  std::unordered_map<std::string, Entry> index_;
+
+  mutable std::mutex cache_mutex_;
+  // Most recently used first.
+  mutable std::list<CachedBlob> cache_;
+  mutable std::unordered_map<std::string, std::list<CachedBlob>::iterator>
+      cache_index_;
+  mutable size_t cached_bytes_ = 0;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern) const override;
+
+  bool ReadIndex();
+
+  std::unique_ptr<fml::Mapping> GetEntryMapping(const std::string& name,
+                                                const Entry& entry) const;
+
+  std::shared_ptr<const Blob> GetDecompressedBlob(const std::string& name,
+                                                  const Entry& entry) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CompressedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_COMPRESSED_ASSET_BUNDLE_H_
@@ -54,6 +54,29 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
   return mapping;
 }
 
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsExecutableMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  return fml::FileMapping::CreateReadExecute(descriptor_, asset_name);
+}
+
+// |AssetResolver|
+bool DirectoryAssetBundle::PrefetchAsset(const std::string& asset_name) const {
+  if (!is_valid_) {
+    return false;
+  }
+
+  // The pages read ahead stay in the page cache after the mapping is gone.
+  fml::FileMapping mapping(fml::OpenFile(descriptor_, asset_name.c_str(), false,
+                                         fml::FilePermission::kRead));
+  return mapping.IsValid() && mapping.WillNeed();
+}
+
 std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     const std::string& asset_pattern) const {
   std::vector<std::unique_ptr<fml::Mapping>> mappings;
@@ -38,6 +38,13 @@ class DirectoryAssetBundle : public AssetResolver {
   std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
       const std::string& asset_pattern) const override;
 
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsExecutableMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  bool PrefetchAsset(const std::string& asset_name) const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(DirectoryAssetBundle);
 };
 
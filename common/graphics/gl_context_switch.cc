@@ -4,12 +4,39 @@
 
 #include "flutter/common/graphics/gl_context_switch.h"
 
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
+namespace {
+
+struct ThreadSwitchState {
+  GLContextSwitch::Counts counts;
+  // The number of switches of the thread that are in scope.
+  size_t depth = 0;
+};
+
+FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<ThreadSwitchState>
+    tls_switch_state;
+
+ThreadSwitchState& GetThreadSwitchState() {
+  if (!tls_switch_state.get()) {
+    tls_switch_state.reset(new ThreadSwitchState());
+  }
+  return *tls_switch_state.get();
+}
+
+}  // namespace
+
 SwitchableGLContext::SwitchableGLContext() = default;
 
 SwitchableGLContext::~SwitchableGLContext() = default;
 
+bool SwitchableGLContext::IsCurrent() const {
+  return false;
+}
+
 GLContextResult::GLContextResult() = default;
 
 GLContextResult::~GLContextResult() = default;
@@ -28,11 +55,35 @@ GLContextDefaultResult::~GLContextDefaultResult() = default;
 GLContextSwitch::GLContextSwitch(std::unique_ptr<SwitchableGLContext> context)
     : context_(std::move(context)) {
   FML_CHECK(context_ != nullptr);
+  ThreadSwitchState& state = GetThreadSwitchState();
+  state.depth++;
+  if (context_->IsCurrent()) {
+    elided_ = true;
+    result_ = true;
+    state.counts.elided++;
+    return;
+  }
   result_ = context_->SetCurrent();
+  state.counts.made++;
 };
 
 GLContextSwitch::~GLContextSwitch() {
-  context_->RemoveCurrent();
+  if (!elided_) {
+    context_->RemoveCurrent();
+  }
+  ThreadSwitchState& state = GetThreadSwitchState();
+  FML_DCHECK(state.depth > 0);
+  if (--state.depth == 0) {
+#if !FLUTTER_RELEASE
+    FML_TRACE_COUNTER("flutter", "GLContextSwitch",
+                      reinterpret_cast<int64_t>(&state), "Made",
+                      state.counts.made, "Elided", state.counts.elided);
+#endif  // !FLUTTER_RELEASE
+  }
 };
 
+GLContextSwitch::Counts GLContextSwitch::GetCountsForCurrentThread() {
+  return GetThreadSwitchState().counts;
+}
+
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_GL_CONTEXT_SWITCH_H_
 #define FLUTTER_COMMON_GRAPHICS_GL_CONTEXT_SWITCH_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -34,6 +35,16 @@ class SwitchableGLContext {
   // object from current context;
   virtual bool RemoveCurrent() = 0;
 
+  // Implement this to return whether the context wrapped by this
+  // |SwitchableGLContext| object is already the current context of the calling
+  // thread. |GLContextSwitch| skips both the |SetCurrent| and the
+  // |RemoveCurrent| of such a context, since they would not change the current
+  // context. This should be much cheaper than |SetCurrent|.
+  //
+  // The default implementation returns false, so that the context is always
+  // switched.
+  virtual bool IsCurrent() const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(SwitchableGLContext);
 };
 
@@ -91,6 +102,12 @@ class GLContextDefaultResult : public GLContextResult {
 ///
 /// In destruction, it should restore the current context to what was
 /// before the construction of this switch.
+///
+/// A switch to a context that is already current, for example in a scope
+/// nested in the scope of another switch to the same context, is elided: the
+/// context is neither set nor removed. The switches made and elided on each
+/// thread are reported to the timeline as the "GLContextSwitch" counter when
+/// the outermost switch of the thread ends.
 class GLContextSwitch final : public GLContextResult {
  public:
   //----------------------------------------------------------------------------
@@ -103,8 +120,20 @@ class GLContextSwitch final : public GLContextResult {
 
   ~GLContextSwitch() override;
 
+  //----------------------------------------------------------------------------
+  /// The number of switches made and elided on the calling thread since it
+  /// started.
+  struct Counts {
+    int64_t made = 0;
+    int64_t elided = 0;
+  };
+  static Counts GetCountsForCurrentThread();
+
  private:
   std::unique_ptr<SwitchableGLContext> context_;
+  // Whether the context was already current, in which case the destructor
+  // leaves it current too.
+  bool elided_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GLContextSwitch);
 };
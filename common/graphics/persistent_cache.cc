@@ -4,11 +4,16 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
+#include <deque>
 #include <future>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <string_view>
 
+#include "flutter/common/graphics/persistent_cache_pack.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
@@ -50,6 +55,7 @@ bool PersistentCache::gIsReadOnly = false;
 
 std::atomic<bool> PersistentCache::cache_sksl_ = false;
 std::atomic<bool> PersistentCache::strategy_set_ = false;
+std::atomic<bool> PersistentCache::defer_sksl_warm_up_ = false;
 
 void PersistentCache::SetCacheSkSL(bool value) {
   if (strategy_set_ && value != cache_sksl_) {
@@ -86,7 +92,9 @@ bool PersistentCache::Purge() {
 
   std::promise<bool> removed;
   GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+                                   cache_directory = cache_directory_,
+                                   cache_pack = cache_pack_,
+                                   sksl_cache_pack = sksl_cache_pack_]() {
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -99,6 +107,8 @@ bool PersistentCache::Purge() {
         return fml::UnlinkFile(directory, filename.c_str());
       };
       removed.set_value(VisitFilesRecursively(*cache_directory, delete_file));
+      cache_pack->Reset();
+      sksl_cache_pack->Reset();
     } else {
       removed.set_value(false);
     }
@@ -156,6 +166,19 @@ static std::shared_ptr<fml::UniqueFD> MakeCacheDirectory(
     return std::make_shared<fml::UniqueFD>();
   }
 }
+
+static std::shared_ptr<fml::UniqueFD> MakeSubdirectory(
+    const std::shared_ptr<fml::UniqueFD>& cache_directory,
+    const char* name,
+    bool read_only) {
+  if (!cache_directory->is_valid()) {
+    return std::make_shared<fml::UniqueFD>();
+  }
+  return std::make_shared<fml::UniqueFD>(
+      CreateDirectory(*cache_directory, {name},
+                      read_only ? fml::FilePermission::kRead
+                                : fml::FilePermission::kReadWrite));
+}
 }  // namespace
 
 sk_sp<SkData> ParseBase32(const std::string& input) {
@@ -179,31 +202,58 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
   return SkData::MakeWithCopy(decoder.getData(), decoder.getDataSize());
 }
 
+// Whether the file is the pack or the temporary file used while compacting it.
+static bool IsPackFileName(const std::string& filename) {
+  return filename.rfind(PersistentCachePack::kFileName, 0) == 0;
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
-  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
-                                       const std::string& filename) {
-    sk_sp<SkData> key = ParseBase32(filename);
-    sk_sp<SkData> data = LoadFile(directory, filename);
-    if (key != nullptr && data != nullptr) {
-      result.push_back({key, data});
-    } else {
-      FML_LOG(ERROR) << "Failed to load: " << filename;
-    }
-    return true;
-  };
 
   // Only visit sksl_cache_directory_ if this persistent cache is valid.
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
   if (IsValid()) {
-    // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
+    sksl_cache_pack_->VisitEntries(
+        [&result](const fml::Mapping& key, const fml::Mapping& value) {
+          result.push_back(
+              {SkData::MakeWithCopy(key.GetMapping(), key.GetSize()),
+               SkData::MakeWithCopy(value.GetMapping(), value.GetSize())});
+        });
+
+    // Entries stored before the pack was introduced are in files of their
+    // own. In case `rewinddir` doesn't work reliably, load them from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
     fml::UniqueFD fresh_dir =
         fml::OpenDirectoryReadOnly(*cache_directory_, kSkSLSubdirName);
     if (fresh_dir.is_valid()) {
+      std::vector<std::string> filenames;
+      fml::FileVisitor visitor = [&filenames](const fml::UniqueFD& directory,
+                                              const std::string& filename) {
+        if (!IsPackFileName(filename)) {
+          filenames.push_back(filename);
+        }
+        return true;
+      };
       fml::VisitFiles(fresh_dir, visitor);
+
+      std::vector<SkSLCache> loaded(filenames.size());
+      ParallelFor(filenames.size(), [&](size_t i) {
+        TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLFile");
+        sk_sp<SkData> key = ParseBase32(filenames[i]);
+        sk_sp<SkData> data = LoadFile(fresh_dir, filenames[i]);
+        if (key != nullptr && data != nullptr) {
+          loaded[i] = {key, data};
+        } else {
+          FML_LOG(ERROR) << "Failed to load: " << filenames[i];
+        }
+      });
+      for (auto& cache : loaded) {
+        if (cache.first != nullptr) {
+          result.push_back(std::move(cache));
+        }
+      }
     }
   }
 
@@ -222,13 +272,24 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() {
     if (parse_result != rapidjson::ParseErrorCode::kParseErrorNone) {
       FML_LOG(ERROR) << "Failed to parse json file: " << kAssetFileName;
     } else {
+      std::vector<const rapidjson::Value::Member*> items;
       for (auto& item : json_doc["data"].GetObject()) {
-        sk_sp<SkData> key = ParseBase32(item.name.GetString());
-        sk_sp<SkData> sksl = ParseBase64(item.value.GetString());
+        items.push_back(&item);
+      }
+
+      std::vector<SkSLCache> decoded(items.size());
+      ParallelFor(items.size(), [&](size_t i) {
+        sk_sp<SkData> key = ParseBase32(items[i]->name.GetString());
+        sk_sp<SkData> sksl = ParseBase64(items[i]->value.GetString());
         if (key != nullptr && sksl != nullptr) {
-          result.push_back({key, sksl});
+          decoded[i] = {key, sksl};
         } else {
-          FML_LOG(ERROR) << "Failed to load: " << item.name.GetString();
+          FML_LOG(ERROR) << "Failed to load: " << items[i]->name.GetString();
+        }
+      });
+      for (auto& cache : decoded) {
+        if (cache.first != nullptr) {
+          result.push_back(std::move(cache));
         }
       }
     }
@@ -241,7 +302,23 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      raster_cache_directory_(MakeSubdirectory(cache_directory_,
+                                               kRasterCacheSubdirName,
+                                               read_only)),
+      vulkan_pipeline_cache_directory_(
+          MakeSubdirectory(cache_directory_,
+                           kVulkanPipelineCacheSubdirName,
+                           read_only)),
+      metal_binary_archive_directory_(
+          MakeSubdirectory(cache_directory_,
+                           kMetalBinaryArchiveSubdirName,
+                           read_only)),
+      raster_cache_writes_(std::make_shared<RasterCacheWrites>()),
+      cache_pack_(
+          std::make_shared<PersistentCachePack>(cache_directory_, read_only)),
+      sksl_cache_pack_(std::make_shared<PersistentCachePack>(
+          sksl_cache_directory_, read_only)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -273,11 +350,18 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
-  auto file_name = SkKeyToFilePath(key);
-  if (file_name.size() == 0) {
-    return nullptr;
+  sk_sp<SkData> result;
+  auto packed =
+      cache_pack_->Load(fml::NonOwnedMapping(key.bytes(), key.size()));
+  if (packed != nullptr) {
+    result = SkData::MakeWithCopy(packed->GetMapping(), packed->GetSize());
+  } else {
+    auto file_name = SkKeyToFilePath(key);
+    if (file_name.size() == 0) {
+      return nullptr;
+    }
+    result = PersistentCache::LoadFile(*cache_directory_, file_name);
   }
-  auto result = PersistentCache::LoadFile(*cache_directory_, file_name);
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
   }
@@ -312,6 +396,35 @@ static void PersistentCacheStore(fml::RefPtr<fml::TaskRunner> worker,
   }
 }
 
+static void PersistentCachePackStore(fml::RefPtr<fml::TaskRunner> worker,
+                                     std::shared_ptr<PersistentCachePack> pack,
+                                     std::unique_ptr<fml::Mapping> key,
+                                     std::unique_ptr<fml::Mapping> value) {
+  auto task = fml::MakeCopyable([pack,                     //
+                                 key = std::move(key),     //
+                                 value = std::move(value)  //
+  ]() mutable {
+    TRACE_EVENT0("flutter", "PersistentCacheStore");
+    if (!pack->Append(*key, *value)) {
+      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
+      return;
+    }
+    if (pack->NeedsCompaction()) {
+      pack->Compact();
+    }
+  });
+
+  if (!worker) {
+    FML_LOG(WARNING)
+        << "The persistent cache has no available workers. Performing the task "
+           "on the current thread. This slow operation is going to occur on a "
+           "frame workload.";
+    task();
+  } else {
+    worker->PostTask(std::move(task));
+  }
+}
+
 // |GrContextOptions::PersistentCache|
 void PersistentCache::store(const SkData& key, const SkData& data) {
   stored_new_shaders_ = true;
@@ -324,22 +437,205 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
-
-  if (file_name.size() == 0) {
+  if (key.size() == 0 || data.size() == 0) {
     return;
   }
 
+  auto key_mapping = std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>{key.bytes(), key.bytes() + key.size()});
   auto mapping = std::make_unique<fml::DataMapping>(
       std::vector<uint8_t>{data.bytes(), data.bytes() + data.size()});
 
-  if (mapping == nullptr || mapping->GetSize() == 0) {
+  PersistentCachePackStore(GetWorkerTaskRunner(),
+                           cache_sksl_ ? sksl_cache_pack_ : cache_pack_,
+                           std::move(key_mapping), std::move(mapping));
+}
+
+// The raster cache images written by this process, oldest first.
+struct PersistentCache::RasterCacheWrites {
+  std::mutex mutex;
+  std::deque<std::string> file_names;
+};
+
+// Removes stored raster cache images until an image of |size| bytes stored
+// as |file_name| fits in the limits. The images of earlier launches go
+// first, then those in |written|, oldest first.
+static void EvictRasterCacheImages(const fml::UniqueFD& directory,
+                                   std::deque<std::string>& written,
+                                   const std::string& file_name,
+                                   size_t size) {
+  std::map<std::string, size_t> sizes;
+  size_t bytes = 0;
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& dir,
+                                 const std::string& filename) {
+    // The file is about to be replaced.
+    if (filename == file_name) {
+      return true;
+    }
+    auto file = fml::OpenFileReadOnly(dir, filename.c_str());
+    if (file.is_valid()) {
+      const size_t file_size = fml::FileMapping(file).GetSize();
+      sizes[filename] = file_size;
+      bytes += file_size;
+    }
+    return true;
+  });
+
+  std::vector<std::string> victims;
+  for (const auto& file : sizes) {
+    if (std::find(written.begin(), written.end(), file.first) ==
+        written.end()) {
+      victims.push_back(file.first);
+    }
+  }
+  for (const auto& name : written) {
+    if (sizes.count(name) != 0) {
+      victims.push_back(name);
+    }
+  }
+
+  size_t count = sizes.size();
+  std::set<std::string> evicted;
+  for (const auto& victim : victims) {
+    if (count + 1 <= PersistentCache::kMaxRasterCacheImageCount &&
+        bytes + size <= PersistentCache::kMaxRasterCacheImageBytes) {
+      break;
+    }
+    fml::UnlinkFile(directory, victim.c_str());
+    evicted.insert(victim);
+    count--;
+    bytes -= sizes[victim];
+  }
+  written.erase(std::remove_if(written.begin(), written.end(),
+                               [&](const std::string& name) {
+                                 return name == file_name ||
+                                        evicted.count(name) != 0;
+                               }),
+                written.end());
+}
+
+void PersistentCache::StoreRasterCacheImage(sk_sp<SkData> key,
+                                            sk_sp<SkImage> image) {
+  if (is_read_only_ || !raster_cache_directory_->is_valid() || !key ||
+      !image) {
     return;
   }
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+  auto file_name = SkKeyToFilePath(*key);
+  if (file_name.size() == 0) {
+    return;
+  }
+
+  auto worker = GetWorkerTaskRunner();
+  if (!worker) {
+    // Unlike shaders, raster cache images are only an optimization and are
+    // not worth encoding on a frame workload.
+    return;
+  }
+
+  worker->PostTask([directory = raster_cache_directory_,  //
+                    writes = raster_cache_writes_,        //
+                    file_name = std::move(file_name),     //
+                    image = std::move(image)              //
+  ]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStoreRasterCacheImage");
+    sk_sp<SkData> encoded = image->encodeToData();
+    if (!encoded || encoded->size() > kMaxRasterCacheImageBytes) {
+      return;
+    }
+    std::scoped_lock lock(writes->mutex);
+    EvictRasterCacheImages(*directory, writes->file_names, file_name,
+                           encoded->size());
+    fml::NonOwnedMapping mapping(encoded->bytes(), encoded->size());
+    if (!fml::WriteAtomically(*directory, file_name.c_str(), mapping)) {
+      FML_LOG(WARNING) << "Could not write raster cache image to persistent "
+                          "store.";
+      return;
+    }
+    writes->file_names.push_back(file_name);
+  });
+}
+
+std::vector<PersistentCache::RasterCacheImage>
+PersistentCache::LoadRasterCacheImages() {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadRasterCacheImages");
+  std::vector<RasterCacheImage> result;
+  if (!raster_cache_directory_->is_valid()) {
+    return result;
+  }
+  fml::VisitFiles(*raster_cache_directory_,
+                  [&result](const fml::UniqueFD& directory,
+                            const std::string& filename) {
+                    sk_sp<SkData> key = ParseBase32(filename);
+                    sk_sp<SkData> data = LoadFile(directory, filename);
+                    if (key != nullptr && data != nullptr) {
+                      result.push_back({key, data});
+                    }
+                    return true;
+                  });
+  return result;
+}
+
+void PersistentCache::StoreVulkanPipelineCache(
+    const std::string& pipeline_cache_uuid,
+    sk_sp<SkData> data) {
+  StoreDeviceData(vulkan_pipeline_cache_directory_, pipeline_cache_uuid,
+                  std::move(data));
+}
+
+sk_sp<SkData> PersistentCache::LoadVulkanPipelineCache(
+    const std::string& pipeline_cache_uuid) {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadVulkanPipelineCache");
+  if (!vulkan_pipeline_cache_directory_->is_valid() ||
+      pipeline_cache_uuid.empty()) {
+    return nullptr;
+  }
+  return LoadFile(*vulkan_pipeline_cache_directory_, pipeline_cache_uuid);
+}
+
+void PersistentCache::StoreMetalBinaryArchive(const std::string& device_key,
+                                              sk_sp<SkData> data) {
+  StoreDeviceData(metal_binary_archive_directory_, device_key,
+                  std::move(data));
+}
+
+sk_sp<SkData> PersistentCache::LoadMetalBinaryArchive(
+    const std::string& device_key) {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadMetalBinaryArchive");
+  if (!metal_binary_archive_directory_->is_valid() || device_key.empty()) {
+    return nullptr;
+  }
+  return LoadFile(*metal_binary_archive_directory_, device_key);
+}
+
+void PersistentCache::StoreDeviceData(
+    const std::shared_ptr<fml::UniqueFD>& directory,
+    const std::string& device_key,
+    sk_sp<SkData> data) {
+  if (is_read_only_ || !directory->is_valid() || device_key.empty() ||
+      !data || data->size() == 0) {
+    return;
+  }
+
+  auto write = [directory,               //
+                file_name = device_key,  //
+                data = std::move(data)   //
+  ]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStoreDeviceData");
+    fml::NonOwnedMapping mapping(data->bytes(), data->size());
+    if (!fml::WriteAtomically(*directory, file_name.c_str(), mapping)) {
+      FML_LOG(WARNING) << "Could not write the pipeline data of a device to "
+                          "the persistent store.";
+    }
+  };
+
+  // Pipeline data is mostly stored when a surface is torn down, after which
+  // there may be no later chance to write it.
+  if (auto worker = GetWorkerTaskRunner()) {
+    worker->PostTask(std::move(write));
+  } else {
+    write();
+  }
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
@@ -375,6 +671,31 @@ void PersistentCache::RemoveWorkerTaskRunner(
   }
 }
 
+void PersistentCache::SetConcurrentTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  std::scoped_lock lock(worker_task_runners_mutex_);
+  concurrent_task_runner_ = task_runner;
+}
+
+void PersistentCache::ParallelFor(
+    size_t count,
+    const std::function<void(size_t)>& body) const {
+  std::shared_ptr<fml::ConcurrentTaskRunner> task_runner;
+  {
+    std::scoped_lock lock(worker_task_runners_mutex_);
+    task_runner = concurrent_task_runner_.lock();
+  }
+
+  if (task_runner) {
+    task_runner->ParallelFor(count, body);
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    body(i);
+  }
+}
+
 fml::RefPtr<fml::TaskRunner> PersistentCache::GetWorkerTaskRunner() const {
   fml::RefPtr<fml::TaskRunner> worker;
 
@@ -5,14 +5,17 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
 namespace testing {
@@ -21,6 +24,8 @@ class ShellTest;
 
 namespace flutter {
 
+class PersistentCachePack;
+
 /// A cache of SkData that gets stored to disk.
 ///
 /// This is mainly used for Shaders but is also written to by Dart.  It is
@@ -53,6 +58,11 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   void RemoveWorkerTaskRunner(fml::RefPtr<fml::TaskRunner> task_runner);
 
+  /// Set the task runner whose workers help |LoadSkSLs| read and decode the
+  /// cached shaders. Only a weak reference is kept.
+  void SetConcurrentTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
   // Whether Skia tries to store any shader into this persistent cache after
   // |ResetStoredNewShaders| is called. This flag is usually reset before each
   // frame so we can know if Skia tries to compile new shaders in that frame.
@@ -72,8 +82,48 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   using SkSLCache = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
 
   /// Load all the SkSL shader caches in the right directory.
+  ///
+  /// The files and bundled shaders are read and decoded on the workers of the
+  /// concurrent task runner, if one was set, as well as the calling thread.
   std::vector<SkSLCache> LoadSkSLs();
 
+  using RasterCacheImage = std::pair<sk_sp<SkData>, sk_sp<SkData>>;
+
+  /// The limits of the raster cache images kept on disk. Storing an image
+  /// beyond them evicts the images stored by earlier launches first, then the
+  /// oldest ones stored by this process.
+  static constexpr size_t kMaxRasterCacheImageCount = 64;
+  static constexpr size_t kMaxRasterCacheImageBytes = 32 * 1024 * 1024;
+
+  /// Encode and store an image of the raster cache on a worker task runner so
+  /// that it can be preloaded on the next launch.
+  void StoreRasterCacheImage(sk_sp<SkData> key, sk_sp<SkImage> image);
+
+  /// Load the keys and encoded images of all the stored raster cache images.
+  std::vector<RasterCacheImage> LoadRasterCacheImages();
+
+  /// Store the pipeline cache data of a Vulkan driver, on a worker task runner
+  /// if one is available. Drivers only accept data written by the same device
+  /// and driver version, so the data is keyed on the pipeline cache UUID of
+  /// the device.
+  void StoreVulkanPipelineCache(const std::string& pipeline_cache_uuid,
+                                sk_sp<SkData> data);
+
+  /// Load the pipeline cache data stored for the device with the given
+  /// pipeline cache UUID, or nullptr if there is none.
+  sk_sp<SkData> LoadVulkanPipelineCache(const std::string& pipeline_cache_uuid);
+
+  /// Store the serialized `MTLBinaryArchive` of a Metal device, on a worker
+  /// task runner if one is available. Archives only hold pipelines compiled
+  /// for one GPU and OS build, so the data is keyed on |device_key|, which
+  /// should identify both.
+  void StoreMetalBinaryArchive(const std::string& device_key,
+                               sk_sp<SkData> data);
+
+  /// Load the binary archive stored for |device_key|, or nullptr if there is
+  /// none.
+  sk_sp<SkData> LoadMetalBinaryArchive(const std::string& device_key);
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -85,10 +135,22 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static void SetCacheSkSL(bool value);
   static void MarkStrategySet() { strategy_set_ = true; }
 
+  /// Whether the SkSLs returned by |LoadSkSLs| should be precompiled in
+  /// portions between frames instead of all before the first frame.
+  static bool defer_sksl_warm_up() { return defer_sksl_warm_up_; }
+  static void SetDeferSkSLWarmUp(bool value) { defer_sksl_warm_up_ = value; }
+
   static constexpr char kSkSLSubdirName[] = "sksl";
+  static constexpr char kRasterCacheSubdirName[] = "raster_cache";
+  static constexpr char kVulkanPipelineCacheSubdirName[] =
+      "vulkan_pipeline_cache";
+  static constexpr char kMetalBinaryArchiveSubdirName[] =
+      "metal_binary_archive";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
 
  private:
+  struct RasterCacheWrites;
+
   static std::string cache_base_path_;
 
   static std::shared_ptr<AssetManager> asset_manager_;
@@ -106,11 +168,22 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // strategy_set_ becomes true.
   static std::atomic<bool> strategy_set_;
 
+  static std::atomic<bool> defer_sksl_warm_up_;
+
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<fml::UniqueFD> raster_cache_directory_;
+  const std::shared_ptr<fml::UniqueFD> vulkan_pipeline_cache_directory_;
+  const std::shared_ptr<fml::UniqueFD> metal_binary_archive_directory_;
+  const std::shared_ptr<RasterCacheWrites> raster_cache_writes_;
+  // Shaders are stored in packs instead of a file per key. Files written by
+  // earlier versions are still read.
+  const std::shared_ptr<PersistentCachePack> cache_pack_;
+  const std::shared_ptr<PersistentCachePack> sksl_cache_pack_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
+  std::weak_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
 
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
@@ -127,6 +200,16 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   fml::RefPtr<fml::TaskRunner> GetWorkerTaskRunner() const;
 
+  // Writes |data| to the file |device_key| of |directory|, on a worker task
+  // runner if one is available.
+  void StoreDeviceData(const std::shared_ptr<fml::UniqueFD>& directory,
+                       const std::string& device_key,
+                       sk_sp<SkData> data);
+
+  // Invokes |body| for every index in [0, count), concurrently if a concurrent
+  // task runner is available.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& body) const;
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PersistentCache);
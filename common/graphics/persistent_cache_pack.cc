@@ -0,0 +1,300 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_pack.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kPackMagic = 0x4b415046;  // "FPAK"
+constexpr uint32_t kPackVersion = 1;
+
+// Compacting small packs is not worth the write.
+constexpr size_t kMinCompactionDeadBytes = 64 * 1024;
+
+struct PackHeader {
+  uint32_t magic;
+  uint32_t version;
+};
+
+struct RecordHeader {
+  uint32_t key_size;
+  uint32_t value_size;
+  uint32_t checksum;
+};
+
+// FNV-1a over the key followed by the value.
+uint32_t Checksum(const uint8_t* key,
+                  size_t key_size,
+                  const uint8_t* value,
+                  size_t value_size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < key_size; i++) {
+    hash = (hash ^ key[i]) * 16777619u;
+  }
+  for (size_t i = 0; i < value_size; i++) {
+    hash = (hash ^ value[i]) * 16777619u;
+  }
+  return hash;
+}
+
+std::string ToIndexKey(const fml::Mapping& key) {
+  return std::string(reinterpret_cast<const char*>(key.GetMapping()),
+                     key.GetSize());
+}
+
+}  // namespace
+
+PersistentCachePack::PersistentCachePack(
+    std::shared_ptr<fml::UniqueFD> directory,
+    bool read_only)
+    : directory_(std::move(directory)), read_only_(read_only) {
+  std::scoped_lock lock(mutex_);
+  OpenLocked();
+}
+
+PersistentCachePack::~PersistentCachePack() = default;
+
+bool PersistentCachePack::IsValid() const {
+  std::scoped_lock lock(mutex_);
+  return file_.is_valid();
+}
+
+size_t PersistentCachePack::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return index_.size();
+}
+
+std::unique_ptr<fml::Mapping> PersistentCachePack::Load(
+    const fml::Mapping& key) const {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(ToIndexKey(key));
+  if (found == index_.end()) {
+    return nullptr;
+  }
+
+  const uint8_t* record = mapping_->GetMapping() + found->second.offset;
+  const uint8_t* value = record + sizeof(RecordHeader) + key.GetSize();
+  const uint8_t* record_end = record + found->second.record_size;
+  return std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>(value, record_end));
+}
+
+void PersistentCachePack::VisitEntries(const EntryVisitor& visitor) const {
+  std::scoped_lock lock(mutex_);
+  for (const auto& item : index_) {
+    const uint8_t* record = mapping_->GetMapping() + item.second.offset;
+    const size_t key_size = item.first.size();
+    const uint8_t* key = record + sizeof(RecordHeader);
+    fml::NonOwnedMapping key_mapping(key, key_size);
+    fml::NonOwnedMapping value_mapping(
+        key + key_size,
+        item.second.record_size - sizeof(RecordHeader) - key_size);
+    visitor(key_mapping, value_mapping);
+  }
+}
+
+bool PersistentCachePack::Append(const fml::Mapping& key,
+                                 const fml::Mapping& value) {
+  if (key.GetSize() == 0 ||
+      key.GetSize() > std::numeric_limits<uint32_t>::max() ||
+      value.GetSize() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (read_only_ || !file_.is_valid()) {
+    return false;
+  }
+
+  TRACE_EVENT0("flutter", "PersistentCachePack::Append");
+  const size_t offset = file_size_;
+  const size_t record_size =
+      sizeof(RecordHeader) + key.GetSize() + value.GetSize();
+  if (!fml::TruncateFile(file_, offset + record_size) || !RemapLocked()) {
+    FML_LOG(ERROR) << "Could not grow the persistent cache pack.";
+    OpenLocked();
+    return false;
+  }
+
+  RecordHeader header;
+  header.key_size = static_cast<uint32_t>(key.GetSize());
+  header.value_size = static_cast<uint32_t>(value.GetSize());
+  header.checksum = Checksum(key.GetMapping(), key.GetSize(),
+                             value.GetMapping(), value.GetSize());
+  uint8_t* record = mapping_->GetMutableMapping() + offset;
+  memcpy(record, &header, sizeof(header));
+  memcpy(record + sizeof(header), key.GetMapping(), key.GetSize());
+  if (value.GetSize() > 0) {
+    memcpy(record + sizeof(header) + key.GetSize(), value.GetMapping(),
+           value.GetSize());
+  }
+
+  Entry& entry = index_[ToIndexKey(key)];
+  if (entry.record_size != 0) {
+    dead_bytes_ += entry.record_size;
+  }
+  entry = {offset, record_size};
+  return true;
+}
+
+bool PersistentCachePack::NeedsCompaction() const {
+  std::scoped_lock lock(mutex_);
+  return !read_only_ && dead_bytes_ >= kMinCompactionDeadBytes &&
+         dead_bytes_ * 2 > file_size_;
+}
+
+bool PersistentCachePack::Compact() {
+  std::scoped_lock lock(mutex_);
+  if (read_only_ || !file_.is_valid()) {
+    return false;
+  }
+
+  TRACE_EVENT0("flutter", "PersistentCachePack::Compact");
+  std::vector<uint8_t> compacted(sizeof(PackHeader));
+  const PackHeader header = {kPackMagic, kPackVersion};
+  memcpy(compacted.data(), &header, sizeof(header));
+  compacted.reserve(file_size_ - dead_bytes_);
+  for (const auto& item : index_) {
+    const uint8_t* record = mapping_->GetMapping() + item.second.offset;
+    compacted.insert(compacted.end(), record,
+                     record + item.second.record_size);
+  }
+
+  fml::DataMapping data(std::move(compacted));
+  const bool written = fml::WriteAtomically(*directory_, kFileName, data);
+  if (!written) {
+    FML_LOG(ERROR) << "Could not compact the persistent cache pack.";
+  }
+  // The open file no longer is the pack if it was replaced.
+  OpenLocked();
+  return written;
+}
+
+void PersistentCachePack::Reset() {
+  std::scoped_lock lock(mutex_);
+  OpenLocked();
+}
+
+void PersistentCachePack::OpenLocked() {
+  index_.clear();
+  mapping_.reset();
+  file_.reset();
+  file_size_ = 0;
+  dead_bytes_ = 0;
+
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+
+  file_ = fml::OpenFile(*directory_, kFileName, !read_only_,
+                        read_only_ ? fml::FilePermission::kRead
+                                   : fml::FilePermission::kReadWrite);
+  if (!file_.is_valid()) {
+    return;
+  }
+
+  if (!RemapLocked()) {
+    file_.reset();
+    return;
+  }
+
+  BuildIndexLocked();
+}
+
+bool PersistentCachePack::RemapLocked() {
+  mapping_.reset();
+  if (read_only_) {
+    mapping_ = std::make_unique<fml::FileMapping>(file_);
+  } else {
+    mapping_ = std::make_unique<fml::FileMapping>(
+        file_, std::initializer_list<fml::FileMapping::Protection>{
+                   fml::FileMapping::Protection::kRead,
+                   fml::FileMapping::Protection::kWrite});
+  }
+  if (!mapping_->IsValid()) {
+    file_size_ = 0;
+    return false;
+  }
+  file_size_ = mapping_->GetSize();
+  return true;
+}
+
+void PersistentCachePack::BuildIndexLocked() {
+  TRACE_EVENT0("flutter", "PersistentCachePack::BuildIndex");
+  const uint8_t* data = mapping_->GetMapping();
+  const size_t size = file_size_;
+
+  PackHeader header = {};
+  if (size >= sizeof(header)) {
+    memcpy(&header, data, sizeof(header));
+  }
+  if (header.magic != kPackMagic || header.version != kPackVersion) {
+    if (read_only_) {
+      // Without any valid record there is nothing to read.
+      return;
+    }
+    if (size != 0) {
+      FML_LOG(WARNING) << "Discarding a persistent cache pack with an "
+                          "unknown format.";
+    }
+    header = {kPackMagic, kPackVersion};
+    if (!fml::TruncateFile(file_, 0) ||
+        !fml::TruncateFile(file_, sizeof(header)) || !RemapLocked()) {
+      file_.reset();
+      mapping_.reset();
+      file_size_ = 0;
+      return;
+    }
+    memcpy(mapping_->GetMutableMapping(), &header, sizeof(header));
+    return;
+  }
+
+  size_t offset = sizeof(header);
+  while (offset + sizeof(RecordHeader) <= size) {
+    RecordHeader record;
+    memcpy(&record, data + offset, sizeof(record));
+    const size_t record_size =
+        sizeof(RecordHeader) + record.key_size + record.value_size;
+    if (record.key_size == 0 || record_size > size - offset) {
+      break;
+    }
+    const uint8_t* key = data + offset + sizeof(RecordHeader);
+    const uint8_t* value = key + record.key_size;
+    if (Checksum(key, record.key_size, value, record.value_size) !=
+        record.checksum) {
+      break;
+    }
+
+    Entry& entry = index_[std::string(reinterpret_cast<const char*>(key),
+                                      record.key_size)];
+    if (entry.record_size != 0) {
+      dead_bytes_ += entry.record_size;
+    }
+    entry = {offset, record_size};
+    offset += record_size;
+  }
+
+  if (offset != size && !read_only_) {
+    FML_LOG(WARNING) << "Discarding " << size - offset
+                     << " bytes of incomplete persistent cache records.";
+    if (!fml::TruncateFile(file_, offset) || !RemapLocked()) {
+      index_.clear();
+      mapping_.reset();
+      file_.reset();
+      file_size_ = 0;
+    }
+  }
+}
+
+}  // namespace flutter
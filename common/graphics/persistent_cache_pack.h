@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A single append-only file holding the entries of a |PersistentCache|
+/// directory.
+///
+/// Storing every entry in a file of its own makes a mature cache thousands of
+/// small files, and loading it a directory scan followed by an open per file.
+/// The pack is instead opened and memory mapped once, and an in-memory index
+/// of the entries is built by walking the record headers.
+///
+/// Storing an existing key appends a new record that shadows the old one.
+/// Once the shadowed records make up most of the file, |NeedsCompaction|
+/// returns true and |Compact| rewrites the file with only the live records.
+///
+/// A record that was partially written, for instance because the process was
+/// killed during an append, fails its checksum and is discarded together with
+/// anything after it the next time the pack is opened.
+///
+/// All methods are thread-safe.
+///
+class PersistentCachePack {
+ public:
+  static constexpr char kFileName[] = "io.flutter.cache.pack";
+
+  using EntryVisitor =
+      std::function<void(const fml::Mapping& key, const fml::Mapping& value)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the pack in |directory|, creating it unless
+  ///             |read_only| is set.
+  ///
+  PersistentCachePack(std::shared_ptr<fml::UniqueFD> directory,
+                      bool read_only);
+
+  ~PersistentCachePack();
+
+  bool IsValid() const;
+
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     A copy of the value stored for |key|, or nullptr.
+  ///
+  std::unique_ptr<fml::Mapping> Load(const fml::Mapping& key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes |visitor| with every live entry. The mappings are
+  ///             only valid during the call.
+  ///
+  void VisitEntries(const EntryVisitor& visitor) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends an entry, shadowing any previous entry with the
+  ///             same key.
+  ///
+  bool Append(const fml::Mapping& key, const fml::Mapping& value);
+
+  bool NeedsCompaction() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Atomically replaces the file with one holding only the live
+  ///             entries.
+  ///
+  bool Compact();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all the entries and reopens the file. Used after the
+  ///             cache directory is purged.
+  ///
+  void Reset();
+
+ private:
+  struct Entry {
+    size_t offset;
+    size_t record_size;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const bool read_only_;
+  mutable std::mutex mutex_;
+  fml::UniqueFD file_;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  size_t file_size_ = 0;
+  size_t dead_bytes_ = 0;
+  std::unordered_map<std::string, Entry> index_;
+
+  void OpenLocked();
+
+  bool RemapLocked();
+
+  void BuildIndexLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCachePack);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
@@ -0,0 +1,23 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_MEMORY_PRESSURE_LEVEL_H_
+#define FLUTTER_COMMON_MEMORY_PRESSURE_LEVEL_H_
+
+namespace flutter {
+
+/// How much memory the engine is asked to free when the platform reports
+/// memory pressure.
+enum class MemoryPressureLevel {
+  /// Memory is running low. The engine trims its caches of the resources that
+  /// are least likely to be needed for the next frames.
+  kModerate,
+  /// The process is about to be killed for its memory use. The engine frees
+  /// everything it can recreate, at the cost of slower frames afterwards.
+  kCritical,
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_MEMORY_PRESSURE_LEVEL_H_
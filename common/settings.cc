@@ -36,11 +36,14 @@ std::string Settings::ToString() const {
   }
   stream << "start_paused: " << start_paused << std::endl;
   stream << "trace_skia: " << trace_skia << std::endl;
+  stream << "trace_skia_allowlist: " << trace_skia_allowlist << std::endl;
   stream << "trace_startup: " << trace_startup << std::endl;
   stream << "trace_systrace: " << trace_systrace << std::endl;
   stream << "dump_skp_on_shader_compilation: " << dump_skp_on_shader_compilation
          << std::endl;
   stream << "cache_sksl: " << cache_sksl << std::endl;
+  stream << "record_glyph_usage: " << record_glyph_usage << std::endl;
+  stream << "defer_sksl_warm_up: " << defer_sksl_warm_up << std::endl;
   stream << "purge_persistent_cache: " << purge_persistent_cache << std::endl;
   stream << "endless_trace_buffer: " << endless_trace_buffer << std::endl;
   stream << "enable_dart_profiling: " << enable_dart_profiling << std::endl;
@@ -62,6 +65,30 @@ std::string Settings::ToString() const {
   stream << "frame_rasterized_callback set: " << !!frame_rasterized_callback
          << std::endl;
   stream << "old_gen_heap_size: " << old_gen_heap_size << std::endl;
+  stream << "raster_cache_max_bytes: " << raster_cache_max_bytes << std::endl;
+  stream << "frame_stats_capacity: " << frame_stats_capacity << std::endl;
+  stream << "enable_async_raster_cache: " << enable_async_raster_cache
+         << std::endl;
+  stream << "enable_parallel_raster_cache_recording: "
+         << enable_parallel_raster_cache_recording << std::endl;
+  stream << "enable_raster_cache_persistence: "
+         << enable_raster_cache_persistence << std::endl;
+  stream << "enable_parallel_preroll: " << enable_parallel_preroll
+         << std::endl;
+  stream << "parallel_image_decode_pixel_threshold: "
+         << parallel_image_decode_pixel_threshold << std::endl;
+  stream << "decoded_image_cache_max_bytes: " << decoded_image_cache_max_bytes
+         << std::endl;
+  stream << "animated_image_frame_ahead_bytes: "
+         << animated_image_frame_ahead_bytes << std::endl;
+  stream << "enable_yuv_image_upload: " << enable_yuv_image_upload
+         << std::endl;
+  stream << "enable_display_list: " << enable_display_list << std::endl;
+  stream << "downsampled_blur_min_sigma: " << downsampled_blur_min_sigma
+         << std::endl;
+  stream << "downsampled_blur_max_factor: " << downsampled_blur_max_factor
+         << std::endl;
+  stream << "enable_skparagraph: " << enable_skparagraph << std::endl;
   return stream.str();
 }
 
@@ -16,6 +16,7 @@
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 
@@ -88,6 +89,21 @@ struct Settings {
   // case the primary path to the library can not be loaded.
   std::vector<std::string> application_library_path;
 
+  // Whether the pages of the isolate snapshot instructions executed at
+  // startup are faulted in when the snapshot is loaded instead of lazily
+  // during the first frames.
+  bool prefault_isolate_snapshot_instructions = false;
+
+  // Path to the order file listing the byte ranges of the isolate snapshot
+  // instructions to prefault, one "<offset> <size>" pair per line, as produced
+  // by a profiling run. All the instructions are prefaulted if this is empty
+  // and the size of the instructions is known.
+  std::string isolate_snapshot_instructions_order_file_path;
+
+  // Whether transparent huge pages are requested for the isolate snapshot
+  // instructions on platforms that support them.
+  bool isolate_snapshot_instructions_huge_pages = false;
+
   std::string application_kernel_asset;       // deprecated
   std::string application_kernel_list_asset;  // deprecated
   MappingsCallback application_kernels;
@@ -101,11 +117,21 @@ struct Settings {
   bool enable_checked_mode = false;
   bool start_paused = false;
   bool trace_skia = false;
+  // Comma separated prefixes of the Skia trace categories traced with
+  // |trace_skia|. All the categories are traced if this is empty.
+  std::string trace_skia_allowlist;
   std::string trace_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Record the trace events of the engine in the |fml::tracing::TraceRecorder|
+  // ring buffers. Unlike the timeline, this is available in release builds.
+  bool enable_trace_recorder = false;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
+  // Record the glyphs that are laid out so that they can be bundled and
+  // prewarmed at startup. See |GlyphUsageRecorder|.
+  bool record_glyph_usage = false;
+  bool defer_sksl_warm_up = false;
   bool purge_persistent_cache = false;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
@@ -128,6 +154,12 @@ struct Settings {
   // Whether the Dart VM service should be enabled.
   bool enable_observatory = false;
 
+  // Whether the creation of the service isolate is held back until
+  // |DartServiceIsolate::ResumeDeferredStartup| is called, so that the VM
+  // service costs nothing when no tooling attaches. The VM keeps recording the
+  // timeline meanwhile.
+  bool defer_service_isolate_startup = false;
+
   // Whether to publish the observatory URL over mDNS.
   // On iOS 14 this prompts a local network permission dialog,
   // which cannot be accepted or dismissed in a CI environment.
@@ -200,6 +232,36 @@ struct Settings {
   UnhandledExceptionCallback unhandled_exception_callback;
   bool enable_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
+  // Let the animator keep a second frame in flight only while the raster
+  // thread is the bottleneck instead of always allowing it.
+  bool enable_adaptive_frame_pipelining = false;
+  // Hold on to pointer events until right before the next frame begins so
+  // that the frame sees the latest pointer positions. See
+  // |LatchingPointerDataDispatcher|.
+  bool latch_pointer_events_before_frame = false;
+  // Let the rasterizer move the scroll layers of the last frame from pointer
+  // scroll events, ahead of the frame the framework builds for them. See
+  // |Rasterizer::HandleCompositorScroll|.
+  bool enable_compositor_scrolling = false;
+  // Create the GPU context of the platform view on the raster thread as soon
+  // as the shell is set up, while the isolate starts, instead of when the
+  // first rendering surface is created. See |PlatformView::PrewarmGPUContext|.
+  bool prewarm_gpu_context = false;
+  // The present mode of Vulkan swapchains, one of "fifo", "fifo-relaxed" or
+  // "mailbox". Surfaces that do not support the mode fall back to "fifo".
+  std::string vulkan_present_mode = "fifo";
+  // The number of images of Vulkan swapchains, clamped to what the surface
+  // supports. Zero uses the minimum the surface supports.
+  uint32_t vulkan_swapchain_image_count = 0;
+  // Pace the target times of frames to the refresh period reported through
+  // VK_GOOGLE_display_timing where the Vulkan device supports it.
+  bool enable_vulkan_display_timing = false;
+  // Present Vulkan frames by queueing AHardwareBuffers to a SurfaceControl
+  // instead of through a swapchain, on devices that support it.
+  bool enable_vulkan_surface_control = false;
+  // The number of drawables of Metal layers, 2 or 3. Zero keeps the default
+  // of Core Animation.
+  uint32_t metal_maximum_drawable_count = 0;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
 
@@ -235,6 +297,135 @@ struct Settings {
   /// https://github.com/dart-lang/sdk/blob/ca64509108b3e7219c50d6c52877c85ab6a35ff2/runtime/vm/flag_list.h#L150
   int64_t old_gen_heap_size = -1;
 
+  /// The maximum number of bytes used by the images in the raster cache, or 0
+  /// for no limit. When the limit is reached, new cache entries are not
+  /// rasterized and the least recently used entries are evicted.
+  size_t raster_cache_max_bytes = 0;
+
+  /// The number of frames whose layer tree and raster cache statistics are
+  /// kept for the "_flutter.getFrameStats" service protocol extension, or 0
+  /// to not record them.
+  size_t frame_stats_capacity = 0;
+
+  /// Whether fully opaque raster cache entries rasterized on the CPU are
+  /// stored as RGB565 images, which fit twice as many entries in the same
+  /// budget at the cost of some color precision.
+  bool raster_cache_compact_opaque_entries = false;
+
+  /// Whether the raster caches of the engines in the process share the images
+  /// of identical display lists instead of each rasterizing their own.
+  bool enable_shared_raster_cache = false;
+
+  // Whether pictures selected for the raster cache are rasterized on a
+  // concurrent worker instead of synchronously on the raster thread.
+  bool enable_async_raster_cache = false;
+
+  // Whether the asynchronously rasterized raster cache pictures are recorded
+  // into deferred display lists in parallel on the concurrent workers and
+  // replayed on the raster thread. Requires |enable_async_raster_cache|.
+  bool enable_parallel_raster_cache_recording = false;
+
+  // Whether the most used raster cache entries are stored in the persistent
+  // cache directory and preloaded on the next launch.
+  bool enable_raster_cache_persistence = false;
+
+  // Whether the size of Skia's GPU resource cache is adapted to how the cache
+  // is used and to low memory warnings, starting from the size derived from
+  // the surface size.
+  bool enable_adaptive_resource_cache_budget = false;
+
+  // The physical memory of the device in bytes, or 0 if it is not known. Caps
+  // the adaptive resource cache budget.
+  size_t device_memory_bytes = 0;
+
+  // The scheduling priorities of the UI, raster and IO threads created for the
+  // shell. Threads provided by the embedder keep their own priority.
+  fml::Thread::ThreadPriority ui_thread_priority =
+      fml::Thread::ThreadPriority::kDisplay;
+  fml::Thread::ThreadPriority raster_thread_priority =
+      fml::Thread::ThreadPriority::kRaster;
+  fml::Thread::ThreadPriority io_thread_priority =
+      fml::Thread::ThreadPriority::kNormal;
+
+  // Whether, on CPUs with cores of different speeds, the UI and raster threads
+  // created for the shell are kept on the fastest cores and the IO thread on
+  // the other ones.
+  bool enable_thread_cpu_affinity = false;
+
+  // Starts the UI, raster and IO threads created for the shell and the
+  // concurrent worker threads of the Dart VM, for hosts that manage all the
+  // threads of the process. Unset to let the engine start them. Since the VM
+  // is shared, its workers are started by the launcher of the settings of the
+  // first shell only.
+  fml::Thread::ThreadLauncher thread_launcher;
+
+  // How late, in milliseconds, the UI and IO task runners may wake up for
+  // their delayed tasks so that nearby ones share a wake up, which saves power
+  // when many timers are pending. Frame work is posted as critical and is
+  // never delayed. Zero wakes the task runners up at the exact times.
+  int64_t task_timer_slack_ms = 0;
+
+  // Whether the children of wide layers are prerolled in parallel on the
+  // concurrent worker threads.
+  bool enable_parallel_preroll = false;
+
+  // Whether frames drawn with the software backend are split into tiles
+  // painted in parallel on the concurrent worker threads.
+  bool enable_tiled_software_paint = false;
+
+  // Whether the preroll and paint of each layer is timed to report the
+  // costliest layers on the timeline and in the performance overlay. Layers
+  // are then prerolled and painted serially.
+  bool enable_layer_cost_profile = false;
+
+  // Whether the decision the raster cache makes for each candidate of each
+  // frame is recorded, traced to the timeline and served over the service
+  // protocol.
+  bool trace_raster_cache_decisions = false;
+
+  // Whether the decisions of the raster cache are painted over each frame.
+  bool show_raster_cache_heatmap = false;
+
+  // The number of pixels from which encoded images decoded at their full size
+  // are split into stripes decoded in parallel on the concurrent worker
+  // threads, or 0 to always decode an image on a single worker.
+  size_t parallel_image_decode_pixel_threshold = 0;
+
+  // The maximum number of bytes of decoded images kept by the IO manager so
+  // that image descriptors created from the same encoded bytes share a decode,
+  // or 0 to disable the cache.
+  size_t decoded_image_cache_max_bytes = 0;
+
+  // The maximum number of bytes of frames of each animated image decoded ahead
+  // of playback on the concurrent worker threads, or 0 to decode every frame
+  // on the IO thread when it is requested.
+  size_t animated_image_frame_ahead_bytes = 0;
+
+  // Whether JPEGs decoded at their full size are decoded to YUV planes and
+  // converted to RGB on the GPU instead of being decoded to RGBA.
+  bool enable_yuv_image_upload = false;
+
+  // The number of pixels from which encoded JPEG and HEIF still images are
+  // decoded by the decoder of the platform, which may be backed by hardware,
+  // instead of Skia, or 0 to only use it for formats Skia can not decode.
+  size_t platform_image_decode_pixel_threshold = 0;
+
+  // Whether pictures are recorded into engine owned display lists instead of
+  // Skia pictures.
+  bool enable_display_list = false;
+
+  // Blurs pushed as image filter or backdrop filter layers with a sigma of at
+  // least this value are evaluated at a reduced resolution, or never if 0.
+  double downsampled_blur_min_sigma = 20;
+
+  // The largest factor by which the resolution of such blurs is reduced.
+  int downsampled_blur_max_factor = 4;
+
+  // Whether paragraphs are laid out with Skia's text layout module
+  // (SkParagraph) instead of libtxt. This is ignored unless the engine was
+  // built with `flutter_enable_skshaper`.
+  bool enable_skparagraph = false;
+
   /// A timestamp representing when the engine started. The value is based
   /// on the clock used by the Dart timeline APIs. This timestamp is used
   /// to log a timeline event that tracks the latency of engine startup.
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/composition_timeline.h"
+
+#include <chrono>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+CompositionTimeline::CompositionTimeline(
+    fml::RefPtr<fml::TaskRunner> platform_task_runner,
+    CommitCallback commit_callback)
+    : platform_task_runner_(std::move(platform_task_runner)),
+      commit_callback_(std::move(commit_callback)) {
+  FML_DCHECK(platform_task_runner_);
+  FML_DCHECK(commit_callback_);
+}
+
+CompositionTimeline::~CompositionTimeline() = default;
+
+uint64_t CompositionTimeline::Publish(std::vector<PlatformView> views) {
+  TRACE_EVENT0("flutter", "CompositionTimeline::Publish");
+  uint64_t frame_number;
+  bool needs_commit_task;
+  {
+    std::scoped_lock lock(mutex_);
+    frame_number = ++published_frame_number_;
+    // A commit task is already pending for the superseded transaction.
+    needs_commit_task = !pending_transaction_.has_value();
+    if (!needs_commit_task) {
+      dropped_transaction_count_++;
+    }
+    pending_transaction_ = Transaction{frame_number, std::move(views)};
+  }
+  if (needs_commit_task) {
+    platform_task_runner_->PostTask([timeline = fml::Ref(this)]() {
+      timeline->CommitPendingTransaction();
+    });
+  }
+  return frame_number;
+}
+
+void CompositionTimeline::CommitPendingTransaction() {
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+  TRACE_EVENT0("flutter", "CompositionTimeline::Commit");
+  std::optional<Transaction> transaction;
+  {
+    std::scoped_lock lock(mutex_);
+    transaction.swap(pending_transaction_);
+  }
+  if (!transaction.has_value()) {
+    return;
+  }
+
+  commit_callback_(transaction.value());
+
+  {
+    std::scoped_lock lock(mutex_);
+    committed_frame_number_ = transaction->frame_number;
+  }
+  committed_.notify_all();
+}
+
+bool CompositionTimeline::WaitForCommit(uint64_t frame_number,
+                                        fml::TimeDelta timeout) {
+  FML_DCHECK(!platform_task_runner_->RunsTasksOnCurrentThread());
+  TRACE_EVENT0("flutter", "CompositionTimeline::WaitForCommit");
+  std::unique_lock lock(mutex_);
+  return committed_.wait_for(
+      lock, std::chrono::microseconds(timeout.ToMicroseconds()),
+      [&]() { return committed_frame_number_ >= frame_number; });
+}
+
+uint64_t CompositionTimeline::GetCommittedFrameNumber() const {
+  std::scoped_lock lock(mutex_);
+  return committed_frame_number_;
+}
+
+size_t CompositionTimeline::GetDroppedTransactionCount() const {
+  std::scoped_lock lock(mutex_);
+  return dropped_transaction_count_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_COMPOSITION_TIMELINE_H_
+#define FLUTTER_FLOW_COMPOSITION_TIMELINE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "flutter/flow/embedded_views.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Publishes the geometry of the platform views of each frame from
+///             the raster thread to the platform thread, as an alternative to
+///             merging the two threads with a |fml::RasterThreadMerger|.
+///
+///             After rasterizing a frame, the external view embedder publishes
+///             the parameters of its platform views in composition order as a
+///             transaction. The transaction is committed on the platform
+///             thread, where the embedder applies it to the native views, so
+///             rasterization keeps running on its own thread.
+///
+///             Only the latest transaction is committed. A transaction that
+///             is superseded before the platform thread gets to it is
+///             dropped, as the views would be moved again right away. An
+///             embedder that must present the Flutter contents in lockstep
+///             with the native views can wait for the commit of its frame.
+///
+class CompositionTimeline
+    : public fml::RefCountedThreadSafe<CompositionTimeline> {
+ public:
+  struct PlatformView {
+    int64_t view_id;
+    EmbeddedViewParams params;
+  };
+
+  struct Transaction {
+    // Starts at 1 and increases with each published transaction.
+    uint64_t frame_number;
+    // In composition order.
+    std::vector<PlatformView> views;
+  };
+
+  // Invoked on the platform thread to apply a transaction.
+  using CommitCallback = std::function<void(const Transaction&)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Publishes the platform views of a frame. May be called on
+  ///             any thread, usually the raster thread.
+  ///
+  /// @return     The frame number of the transaction.
+  ///
+  uint64_t Publish(std::vector<PlatformView> views);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits until the transaction of the given frame, or of a later
+  ///             one, is committed. Must not be called on the platform
+  ///             thread.
+  ///
+  /// @return     Whether the transaction was committed before the timeout.
+  ///
+  bool WaitForCommit(uint64_t frame_number, fml::TimeDelta timeout);
+
+  // The frame number of the last committed transaction, or 0 if none is.
+  uint64_t GetCommittedFrameNumber() const;
+
+  // The number of transactions that were superseded before being committed.
+  size_t GetDroppedTransactionCount() const;
+
+ private:
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  const CommitCallback commit_callback_;
+  mutable std::mutex mutex_;
+  std::condition_variable committed_;
+  std::optional<Transaction> pending_transaction_;
+  uint64_t published_frame_number_ = 0;
+  uint64_t committed_frame_number_ = 0;
+  size_t dropped_transaction_count_ = 0;
+
+  CompositionTimeline(fml::RefPtr<fml::TaskRunner> platform_task_runner,
+                      CommitCallback commit_callback);
+
+  ~CompositionTimeline();
+
+  void CommitPendingTransaction();
+
+  FML_FRIEND_MAKE_REF_COUNTED(CompositionTimeline);
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(CompositionTimeline);
+  FML_DISALLOW_COPY_AND_ASSIGN(CompositionTimeline);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_COMPOSITION_TIMELINE_H_
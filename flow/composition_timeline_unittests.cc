@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/composition_timeline.h"
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<CompositionTimeline::PlatformView> MakeViews(
+    int64_t view_id) {
+  EmbeddedViewParams params(SkMatrix::Translate(10, 20), SkSize::Make(30, 40),
+                            MutatorsStack());
+  return {{view_id, params}};
+}
+
+TEST(CompositionTimelineTest, CommitsTransactionsOnThePlatformThread) {
+  fml::Thread platform_thread("platform");
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+  std::vector<CompositionTimeline::Transaction> transactions;
+  auto timeline = fml::MakeRefCounted<CompositionTimeline>(
+      platform_task_runner,
+      [&](const CompositionTimeline::Transaction& transaction) {
+        ASSERT_TRUE(platform_task_runner->RunsTasksOnCurrentThread());
+        transactions.push_back(transaction);
+      });
+
+  auto frame_number = timeline->Publish(MakeViews(42));
+  ASSERT_EQ(frame_number, 1u);
+  ASSERT_TRUE(
+      timeline->WaitForCommit(frame_number, fml::TimeDelta::FromSeconds(10)));
+  ASSERT_EQ(timeline->GetCommittedFrameNumber(), 1u);
+
+  ASSERT_EQ(transactions.size(), 1u);
+  ASSERT_EQ(transactions[0].frame_number, 1u);
+  ASSERT_EQ(transactions[0].views.size(), 1u);
+  ASSERT_EQ(transactions[0].views[0].view_id, 42);
+  ASSERT_EQ(transactions[0].views[0].params.finalBoundingRect(),
+            SkRect::MakeXYWH(10, 20, 30, 40));
+}
+
+TEST(CompositionTimelineTest, DropsSupersededTransactions) {
+  fml::Thread platform_thread("platform");
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+  std::vector<uint64_t> committed_frame_numbers;
+  auto timeline = fml::MakeRefCounted<CompositionTimeline>(
+      platform_task_runner,
+      [&](const CompositionTimeline::Transaction& transaction) {
+        committed_frame_numbers.push_back(transaction.frame_number);
+      });
+
+  // Keep the platform thread busy while the frames are published.
+  fml::AutoResetWaitableEvent busy;
+  platform_task_runner->PostTask([&busy]() { busy.Wait(); });
+  timeline->Publish(MakeViews(1));
+  timeline->Publish(MakeViews(2));
+  auto frame_number = timeline->Publish(MakeViews(3));
+  ASSERT_FALSE(timeline->WaitForCommit(frame_number,
+                                       fml::TimeDelta::FromMilliseconds(1)));
+  busy.Signal();
+
+  ASSERT_TRUE(
+      timeline->WaitForCommit(frame_number, fml::TimeDelta::FromSeconds(10)));
+  ASSERT_EQ(timeline->GetDroppedTransactionCount(), 2u);
+
+  // Make sure no other transaction is committed afterwards.
+  fml::AutoResetWaitableEvent done;
+  platform_task_runner->PostTask([&done]() { done.Signal(); });
+  done.Wait();
+  ASSERT_EQ(committed_frame_numbers, std::vector<uint64_t>{3u});
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -10,10 +10,26 @@
 namespace flutter {
 
 CompositorContext::CompositorContext(fml::Milliseconds frame_budget)
-    : raster_time_(frame_budget), ui_time_(frame_budget) {}
+    : raster_time_(frame_budget),
+      ui_time_(frame_budget),
+      gpu_time_(frame_budget) {}
 
 CompositorContext::~CompositorContext() = default;
 
+void CompositorContext::SetFrameBudget(fml::Milliseconds frame_budget) {
+  raster_time_.SetFrameBudget(frame_budget);
+  ui_time_.SetFrameBudget(frame_budget);
+  gpu_time_.SetFrameBudget(frame_budget);
+}
+
+void CompositorContext::SetLayerCostProfileEnabled(bool enabled) {
+  if (!enabled) {
+    layer_cost_profile_.reset();
+  } else if (!layer_cost_profile_) {
+    layer_cost_profile_ = std::make_unique<LayerCostProfile>();
+  }
+}
+
 void CompositorContext::BeginFrame(ScopedFrame& frame,
                                    bool enable_instrumentation) {
   if (enable_instrumentation) {
@@ -24,7 +40,27 @@ void CompositorContext::BeginFrame(ScopedFrame& frame,
 
 void CompositorContext::EndFrame(ScopedFrame& frame,
                                  bool enable_instrumentation) {
-  raster_cache_.SweepAfterFrame();
+  if (enable_instrumentation) {
+    frame_histograms_.Record(FrameHistograms::kRasterCacheHits,
+                             raster_cache_.GetHitsThisFrame());
+  }
+  if (pending_frame_stats_) {
+    FrameStats& stats = pending_frame_stats_.value();
+    stats.raster_cache_hits = raster_cache_.GetHitsThisFrame();
+    stats.raster_cache_insertions = raster_cache_.GetPicturesCachedThisFrame();
+    stats.raster_cache_layer_entries =
+        raster_cache_.GetLayerCachedEntriesCount();
+    stats.raster_cache_picture_entries =
+        raster_cache_.GetPictureCachedEntriesCount();
+    frame_stats_.Record(stats);
+    pending_frame_stats_.reset();
+  }
+  if (frame.sweeps_raster_cache()) {
+    raster_cache_.SweepAfterFrame();
+  }
+  if (layer_cost_profile_) {
+    layer_cost_profile_->EndFrame();
+  }
   if (enable_instrumentation) {
     raster_time_.Stop();
   }
@@ -69,9 +105,17 @@ CompositorContext::ScopedFrame::~ScopedFrame() {
 
 RasterStatus CompositorContext::ScopedFrame::Raster(
     flutter::LayerTree& layer_tree,
-    bool ignore_raster_cache) {
+    bool ignore_raster_cache,
+    FrameDamage* frame_damage) {
   TRACE_EVENT0("flutter", "CompositorContext::ScopedFrame::Raster");
-  bool root_needs_readback = layer_tree.Preroll(*this, ignore_raster_cache);
+  const fml::TimePoint preroll_start = fml::TimePoint::Now();
+  bool root_needs_readback = layer_tree.Preroll(
+      *this, ignore_raster_cache, frame_damage != nullptr);
+  const fml::TimePoint paint_start = fml::TimePoint::Now();
+  if (instrumentation_enabled_) {
+    context_.frame_histograms().Record(FrameHistograms::kPreroll,
+                                       paint_start - preroll_start);
+  }
   bool needs_save_layer = root_needs_readback && !surface_supports_readback();
   PostPrerollResult post_preroll_result = PostPrerollResult::kSuccess;
   if (view_embedder_ && raster_thread_merger_) {
@@ -85,6 +129,21 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (post_preroll_result == PostPrerollResult::kSkipAndRetryFrame) {
     return RasterStatus::kSkipAndRetry;
   }
+  std::optional<SkIRect> clip_rect;
+  if (frame_damage && layer_tree.paint_regions()) {
+    clip_rect = frame_damage->ComputeClipRect(*layer_tree.paint_regions());
+  }
+
+  // Restrict painting to the damaged area. The damage is expressed in device
+  // coordinates so the clip is applied without the canvas transformation.
+  if (canvas() && clip_rect) {
+    canvas()->save();
+    const SkMatrix total_matrix = canvas()->getTotalMatrix();
+    canvas()->resetMatrix();
+    canvas()->clipRect(SkRect::Make(clip_rect.value()));
+    canvas()->setMatrix(total_matrix);
+  }
+
   // Clearing canvas after preroll reduces one render target switch when preroll
   // paints some raster cache.
   if (canvas()) {
@@ -98,9 +157,31 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     canvas()->clear(SK_ColorTRANSPARENT);
   }
   layer_tree.Paint(*this, ignore_raster_cache);
+  if (canvas() && context_.raster_cache().GetShowDecisionHeatmap()) {
+    context_.raster_cache().DrawDecisionHeatmap(*canvas());
+  }
+  const fml::TimePoint paint_end = fml::TimePoint::Now();
+  if (instrumentation_enabled_) {
+    context_.frame_histograms().Record(FrameHistograms::kPaint,
+                                       paint_end - paint_start);
+    if (context_.frame_stats_.GetCapacity() > 0) {
+      FrameStats stats;
+      stats.frame_number = context_.frame_count_.count();
+      stats.raster_start_micros = preroll_start.ToEpochDelta().ToMicroseconds();
+      stats.preroll_micros = (paint_start - preroll_start).ToMicroseconds();
+      stats.paint_micros = (paint_end - paint_start).ToMicroseconds();
+      if (auto* root_layer = layer_tree.root_layer()) {
+        root_layer->AccumulateStats(&stats);
+      }
+      context_.pending_frame_stats_ = stats;
+    }
+  }
   if (canvas() && needs_save_layer) {
     canvas()->restore();
   }
+  if (canvas() && clip_rect) {
+    canvas()->restore();
+  }
   return RasterStatus::kSuccess;
 }
 
@@ -6,14 +6,20 @@
 #define FLUTTER_FLOW_COMPOSITOR_CONTEXT_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/frame_histograms.h"
+#include "flutter/flow/frame_stats.h"
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layer_cost_profile.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -79,8 +85,19 @@ class CompositorContext {
 
     GrDirectContext* gr_context() const { return gr_context_; }
 
+    // Whether the raster cache evicts the entries that were not used since
+    // the last sweep when the frame ends. Frames that draw only part of what
+    // is on screen, like the frames of additional views, keep the entries
+    // for the frames that draw the rest.
+    void set_sweeps_raster_cache(bool sweeps) { sweeps_raster_cache_ = sweeps; }
+    bool sweeps_raster_cache() const { return sweeps_raster_cache_; }
+
+    // If |frame_damage| is not null, only the area of the frame that changed
+    // since the previous frame (plus any damage already present in the
+    // framebuffer) is repainted.
     virtual RasterStatus Raster(LayerTree& layer_tree,
-                                bool ignore_raster_cache);
+                                bool ignore_raster_cache,
+                                FrameDamage* frame_damage);
 
    private:
     CompositorContext& context_;
@@ -91,6 +108,7 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    bool sweeps_raster_cache_ = true;
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -120,14 +138,70 @@ class CompositorContext {
 
   const Stopwatch& raster_time() const { return raster_time_; }
 
+  // Sets the frame budget of the raster, UI and GPU time stopwatches.
+  void SetFrameBudget(fml::Milliseconds frame_budget);
+
   Stopwatch& ui_time() { return ui_time_; }
 
+  // The time the GPU spent on the recent frames, when the surface can
+  // measure it.
+  Stopwatch& gpu_time() { return gpu_time_; }
+
+  // The phases of all the instrumented frames drawn so far. Safe to read from
+  // any thread.
+  FrameHistograms& frame_histograms() { return frame_histograms_; }
+
+  // The contents of the last instrumented frames, when the ring has a
+  // capacity. Safe to read from any thread.
+  FrameStatsRing& frame_stats() { return frame_stats_; }
+
+  // When set, wide layer subtrees are prerolled in parallel on
+  // |task_runner|.
+  void SetPrerollTaskRunner(std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+    preroll_task_runner_ = std::move(task_runner);
+  }
+
+  fml::BasicTaskRunner* preroll_task_runner() const {
+    return preroll_task_runner_.get();
+  }
+
+  // When set, frames drawn to raster surfaces without a GrDirectContext are
+  // split into horizontal tiles painted in parallel on |task_runner|. See
+  // |LayerTree::Paint|.
+  void SetTiledPaintTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+    tiled_paint_task_runner_ = std::move(task_runner);
+  }
+
+  fml::BasicTaskRunner* tiled_paint_task_runner() const {
+    return tiled_paint_task_runner_.get();
+  }
+
+  // When enabled, the preroll and paint of each layer is timed to find the
+  // costliest layers. Layers are then prerolled and painted serially. See
+  // |LayerCostProfile|.
+  void SetLayerCostProfileEnabled(bool enabled);
+
+  // The profile of the costliest layers, or null when it is disabled.
+  LayerCostProfile* layer_cost_profile() const {
+    return layer_cost_profile_.get();
+  }
+
  private:
   RasterCache raster_cache_;
   TextureRegistry texture_registry_;
   Counter frame_count_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  Stopwatch gpu_time_;
+  FrameHistograms frame_histograms_;
+  FrameStatsRing frame_stats_;
+  // The stats of the frame being rasterized, recorded by |EndFrame| once the
+  // raster cache decisions of the frame are known.
+  std::optional<FrameStats> pending_frame_stats_;
+  std::shared_ptr<fml::BasicTaskRunner> preroll_task_runner_;
+  std::shared_ptr<fml::BasicTaskRunner> tiled_paint_task_runner_;
+  std::unique_ptr<LayerCostProfile> layer_cost_profile_;
 
   void BeginFrame(ScopedFrame& frame, bool enable_instrumentation);
 
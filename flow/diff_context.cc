@@ -0,0 +1,297 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/diff_context.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+namespace {
+
+uint64_t HashBytes(const void* bytes, size_t length) {
+  return std::hash<std::string_view>{}(
+      std::string_view(static_cast<const char*>(bytes), length));
+}
+
+uint64_t RegionKey(const PaintRegion& region) {
+  const SkIRect bounds = region.bounds.roundOut();
+  return fml::HashCombine(region.fingerprint, bounds.fLeft, bounds.fTop,
+                          bounds.fRight, bounds.fBottom);
+}
+
+// Grows |damage| until it includes the readback bounds of every region whose
+// pixels it touches, as those pixels are recomputed from whatever is painted
+// within the readback bounds.
+void ExpandDamageToReadbacks(const PaintRegionList& regions, SkIRect* damage) {
+  bool expanded = true;
+  while (expanded) {
+    expanded = false;
+    for (const auto& region : regions.regions) {
+      if (region.readback_bounds.isEmpty()) {
+        continue;
+      }
+      const SkIRect readback_bounds = region.readback_bounds.roundOut();
+      if (SkIRect::Intersects(*damage, region.bounds.roundOut()) &&
+          !damage->contains(readback_bounds)) {
+        damage->join(readback_bounds);
+        expanded = true;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+DiffContext::DiffContext(const SkISize& frame_size) {
+  regions_.frame_size = frame_size;
+}
+
+DiffContext::~DiffContext() = default;
+
+DiffContext::AutoEffect::AutoEffect(DiffContext* context, uint64_t signature)
+    : context_(context) {
+  if (context_) {
+    previous_signature_ = context_->effect_signature_;
+    context_->effect_signature_ =
+        fml::HashCombine(previous_signature_, signature);
+  }
+}
+
+DiffContext::AutoEffect::~AutoEffect() {
+  if (context_) {
+    context_->effect_signature_ = previous_signature_;
+  }
+}
+
+void DiffContext::AddPaintRegion(uint64_t content_fingerprint,
+                                 const SkRect& bounds,
+                                 const SkMatrix& matrix,
+                                 const SkRect& cull_rect) {
+  SkRect visible_bounds = bounds;
+  if (!visible_bounds.intersect(cull_rect)) {
+    return;
+  }
+  const SkRect device_bounds = matrix.mapRect(visible_bounds);
+  if (device_bounds.isEmpty()) {
+    return;
+  }
+  regions_.regions.push_back({
+      fml::HashCombine(effect_signature_, content_fingerprint,
+                       HashMatrix(matrix)),  // fingerprint
+      device_bounds,                         // bounds
+  });
+}
+
+void DiffContext::AddDirtyRegion(const SkRect& bounds,
+                                 const SkMatrix& matrix,
+                                 const SkRect& cull_rect) {
+  // A fingerprint that never matches a region of another frame.
+  static std::atomic<uint64_t> next_dirty_fingerprint(1);
+  AddPaintRegion(next_dirty_fingerprint.fetch_add(1), bounds, matrix,
+                 cull_rect);
+}
+
+uint64_t DiffContext::AddBackdropRegion(size_t subtree_start,
+                                        uint64_t filter_fingerprint,
+                                        const SkRect& device_bounds,
+                                        const SkRect& device_readback_bounds) {
+  FML_DCHECK(subtree_start <= regions_.regions.size());
+  if (forked_) {
+    MarkRequiresFullRepaint();
+    return 0;
+  }
+  if (device_bounds.isEmpty()) {
+    return 0;
+  }
+  uint64_t fingerprint = fml::HashCombine(effect_signature_, filter_fingerprint,
+                                          HashRect(device_bounds));
+  for (size_t i = 0; i < subtree_start; i++) {
+    const PaintRegion& region = regions_.regions[i];
+    if (region.bounds.intersects(device_readback_bounds)) {
+      fingerprint = fml::HashCombine(fingerprint, RegionKey(region));
+    }
+  }
+  regions_.regions.insert(
+      regions_.regions.begin() + subtree_start,
+      {
+          fingerprint,            // fingerprint
+          device_bounds,          // bounds
+          device_readback_bounds  // readback_bounds
+      });
+  // 0 is reserved for unknown content.
+  return fingerprint == 0 ? 1 : fingerprint;
+}
+
+void DiffContext::CollapseSubtree(size_t subtree_start,
+                                  uint64_t signature,
+                                  const SkRect& bounds,
+                                  const SkMatrix& matrix,
+                                  const SkRect& cull_rect) {
+  FML_DCHECK(subtree_start <= regions_.regions.size());
+  uint64_t subtree_fingerprint = signature;
+  SkRect readback_bounds = SkRect::MakeEmpty();
+  for (size_t i = subtree_start; i < regions_.regions.size(); i++) {
+    subtree_fingerprint =
+        fml::HashCombine(subtree_fingerprint, RegionKey(regions_.regions[i]));
+    readback_bounds.join(regions_.regions[i].readback_bounds);
+  }
+  regions_.regions.resize(subtree_start);
+  AddPaintRegion(subtree_fingerprint, bounds, matrix, cull_rect);
+  // The collapsed region still depends on what the subtree reads back.
+  if (regions_.regions.size() > subtree_start) {
+    regions_.regions.back().readback_bounds = readback_bounds;
+  }
+}
+
+std::unique_ptr<DiffContext> DiffContext::Fork() const {
+  auto forked = std::make_unique<DiffContext>(regions_.frame_size);
+  forked->effect_signature_ = effect_signature_;
+  forked->forked_ = true;
+  return forked;
+}
+
+void DiffContext::Join(DiffContext& forked) {
+  FML_DCHECK(forked.regions_.frame_size == regions_.frame_size);
+  if (forked.regions_.requires_full_repaint) {
+    regions_.requires_full_repaint = true;
+  }
+  regions_.regions.insert(regions_.regions.end(),
+                          forked.regions_.regions.begin(),
+                          forked.regions_.regions.end());
+  forked.regions_.regions.clear();
+}
+
+PaintRegionList DiffContext::TakePaintRegions() {
+  PaintRegionList regions = std::move(regions_);
+  regions_ = {};
+  regions_.frame_size = regions.frame_size;
+  return regions;
+}
+
+std::optional<SkIRect> DiffContext::ComputeDamage(
+    const PaintRegionList* previous,
+    const PaintRegionList& current) {
+  if (previous == nullptr || previous->requires_full_repaint ||
+      current.requires_full_repaint ||
+      previous->frame_size != current.frame_size) {
+    return std::nullopt;
+  }
+
+  // Regions present in both frames are matched in painting order.
+  std::unordered_map<uint64_t, std::deque<size_t>> unmatched_previous;
+  for (size_t i = 0; i < previous->regions.size(); i++) {
+    unmatched_previous[RegionKey(previous->regions[i])].push_back(i);
+  }
+
+  SkIRect damage = SkIRect::MakeEmpty();
+  size_t max_matched_index = 0;
+  bool matched_any = false;
+  for (const auto& region : current.regions) {
+    auto found = unmatched_previous.find(RegionKey(region));
+    if (found == unmatched_previous.end() || found->second.empty()) {
+      // New content.
+      damage.join(region.bounds.roundOut());
+      continue;
+    }
+    const size_t previous_index = found->second.front();
+    found->second.pop_front();
+    if (matched_any && previous_index < max_matched_index) {
+      // The content was reordered relative to a region painted before it.
+      // Its pixels may differ wherever it overlaps that region.
+      damage.join(region.bounds.roundOut());
+    }
+    max_matched_index = std::max(max_matched_index, previous_index);
+    matched_any = true;
+  }
+
+  // Content that is no longer present.
+  for (const auto& entry : unmatched_previous) {
+    for (size_t index : entry.second) {
+      damage.join(previous->regions[index].bounds.roundOut());
+    }
+  }
+
+  ExpandDamageToReadbacks(current, &damage);
+
+  if (!damage.intersect(SkIRect::MakeSize(current.frame_size))) {
+    return SkIRect::MakeEmpty();
+  }
+  return damage;
+}
+
+uint64_t DiffContext::HashFlattenable(const SkFlattenable* flattenable) {
+  if (flattenable == nullptr) {
+    return 0;
+  }
+  sk_sp<SkData> data = flattenable->serialize();
+  if (!data) {
+    return 0;
+  }
+  return HashBytes(data->data(), data->size());
+}
+
+uint64_t DiffContext::HashPath(const SkPath& path) {
+  const size_t size = path.writeToMemory(nullptr);
+  std::vector<uint8_t> buffer(size);
+  path.writeToMemory(buffer.data());
+  return HashBytes(buffer.data(), buffer.size());
+}
+
+uint64_t DiffContext::HashRRect(const SkRRect& rrect) {
+  uint8_t buffer[SkRRect::kSizeInMemory];
+  rrect.writeToMemory(buffer);
+  return HashBytes(buffer, sizeof(buffer));
+}
+
+uint64_t DiffContext::HashMatrix(const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  return HashBytes(values, sizeof(values));
+}
+
+uint64_t DiffContext::HashRect(const SkRect& rect) {
+  return fml::HashCombine(rect.fLeft, rect.fTop, rect.fRight, rect.fBottom);
+}
+
+FrameDamage::FrameDamage() = default;
+
+FrameDamage::~FrameDamage() = default;
+
+void FrameDamage::SetPreviousPaintRegions(const PaintRegionList* previous) {
+  previous_ = previous;
+}
+
+void FrameDamage::SetExistingBufferDamage(
+    std::optional<SkIRect> existing_damage) {
+  existing_damage_ = existing_damage;
+}
+
+std::optional<SkIRect> FrameDamage::ComputeClipRect(
+    const PaintRegionList& current) {
+  frame_damage_ = DiffContext::ComputeDamage(previous_, current);
+  if (!frame_damage_.has_value() || !existing_damage_.has_value()) {
+    buffer_damage_ = std::nullopt;
+    return std::nullopt;
+  }
+
+  SkIRect buffer_damage = frame_damage_.value();
+  buffer_damage.join(existing_damage_.value());
+  ExpandDamageToReadbacks(current, &buffer_damage);
+  if (!buffer_damage.intersect(SkIRect::MakeSize(current.frame_size))) {
+    buffer_damage.setEmpty();
+  }
+  buffer_damage_ = buffer_damage;
+  return buffer_damage_;
+}
+
+}  // namespace flutter
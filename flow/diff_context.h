@@ -0,0 +1,197 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DIFF_CONTEXT_H_
+#define FLUTTER_FLOW_DIFF_CONTEXT_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFlattenable.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+// A single piece of content painted by a layer in a frame, described by a
+// fingerprint of everything that influences its pixels and its bounds in
+// device (surface) coordinates.
+struct PaintRegion {
+  uint64_t fingerprint;
+  SkRect bounds;
+  // The device area whose prior content the region's pixels are computed
+  // from (e.g. the input of a backdrop filter). Empty for regular content.
+  SkRect readback_bounds = SkRect::MakeEmpty();
+};
+
+// All the content painted by a layer tree, as recorded during preroll.
+struct PaintRegionList {
+  SkISize frame_size = SkISize::MakeEmpty();
+  // Set when the tree contains content that cannot be tracked by paint
+  // regions (e.g. backdrop filters or platform views). The whole frame must
+  // then be repainted.
+  bool requires_full_repaint = false;
+  std::vector<PaintRegion> regions;
+};
+
+// Collects the paint regions of a layer tree during preroll so that the
+// damage between two consecutive frames can be computed without comparing
+// the layer objects themselves (most of which are rebuilt every frame by the
+// SceneBuilder).
+//
+// Leaf layers report what they paint via |AddPaintRegion|. Layers that
+// change how their children are rendered mix their own parameters into the
+// fingerprints of their descendants via |AutoEffect|.
+class DiffContext {
+ public:
+  explicit DiffContext(const SkISize& frame_size);
+
+  ~DiffContext();
+
+  // Mixes |signature| into the fingerprint of every paint region added while
+  // this object is alive. Does nothing if |context| is null.
+  class AutoEffect {
+   public:
+    AutoEffect(DiffContext* context, uint64_t signature);
+
+    ~AutoEffect();
+
+   private:
+    DiffContext* context_;
+    uint64_t previous_signature_ = 0;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(AutoEffect);
+  };
+
+  // Records content with the given fingerprint painted within |bounds| (in
+  // the local coordinates described by |matrix|), clipped to |cull_rect|.
+  void AddPaintRegion(uint64_t content_fingerprint,
+                      const SkRect& bounds,
+                      const SkMatrix& matrix,
+                      const SkRect& cull_rect);
+
+  // Records content that must be repainted every frame regardless of its
+  // fingerprint (e.g. external textures).
+  void AddDirtyRegion(const SkRect& bounds,
+                      const SkMatrix& matrix,
+                      const SkRect& cull_rect);
+
+  // Returns a marker to be passed to |CollapseSubtree|.
+  size_t BeginSubtree() const { return regions_.regions.size(); }
+
+  // Replaces all the regions added since |subtree_start| with a single region
+  // covering |bounds|. This is used by layers whose effect spreads the pixels
+  // of their children (e.g. blurs), so that a change anywhere in the subtree
+  // damages the whole area affected by the effect.
+  void CollapseSubtree(size_t subtree_start,
+                       uint64_t signature,
+                       const SkRect& bounds,
+                       const SkMatrix& matrix,
+                       const SkRect& cull_rect);
+
+  // Records the output of a backdrop filter covering |device_bounds| and
+  // computed from the content painted before it within
+  // |device_readback_bounds|. The output is inserted at |subtree_start|,
+  // before the regions of the filter's children.
+  //
+  // Returns a fingerprint of the filter, of its bounds and of the content it
+  // reads, which identifies its output across frames. Returns 0 if that
+  // content is not known to this context, in which case the whole frame is
+  // repainted.
+  uint64_t AddBackdropRegion(size_t subtree_start,
+                             uint64_t filter_fingerprint,
+                             const SkRect& device_bounds,
+                             const SkRect& device_readback_bounds);
+
+  void MarkRequiresFullRepaint() { regions_.requires_full_repaint = true; }
+
+  // Creates a context that records regions with the current effect signature,
+  // so that a subtree can be prerolled on another thread. The regions recorded
+  // by the returned context are appended to this one by |Join|.
+  std::unique_ptr<DiffContext> Fork() const;
+
+  void Join(DiffContext& forked);
+
+  PaintRegionList TakePaintRegions();
+
+  // Computes the device space area that differs between two frames. Returns
+  // std::nullopt if the whole frame must be repainted.
+  static std::optional<SkIRect> ComputeDamage(const PaintRegionList* previous,
+                                              const PaintRegionList& current);
+
+  static uint64_t HashFlattenable(const SkFlattenable* flattenable);
+
+  static uint64_t HashPath(const SkPath& path);
+
+  static uint64_t HashRRect(const SkRRect& rrect);
+
+  static uint64_t HashMatrix(const SkMatrix& matrix);
+
+  static uint64_t HashRect(const SkRect& rect);
+
+ private:
+  PaintRegionList regions_;
+  uint64_t effect_signature_ = 0;
+  // Whether this context was created by |Fork|, and so lacks the regions
+  // painted before the subtree it records.
+  bool forked_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DiffContext);
+};
+
+// Tracks the damage of a single frame for partial repaint.
+//
+// The rasterizer configures this object with the previously rasterized layer
+// tree and the damage already present in the framebuffer about to be
+// rendered into (as reported by the surface). After preroll, it provides the
+// clip to apply to the paint traversal and the damage to report to the
+// surface on submission.
+class FrameDamage {
+ public:
+  FrameDamage();
+
+  ~FrameDamage();
+
+  // The paint regions of the layer tree that was last presented. If never
+  // set, or set to null, the whole frame is considered damaged.
+  void SetPreviousPaintRegions(const PaintRegionList* previous);
+
+  // Area of the target framebuffer that is stale with respect to the
+  // previous frame (e.g. due to buffer age). If std::nullopt, the whole
+  // framebuffer content is assumed to be undefined.
+  void SetExistingBufferDamage(std::optional<SkIRect> existing_damage);
+
+  // Computes the damage for |current|. Returns the clip rect that must be
+  // applied while painting or std::nullopt if the whole frame is to be
+  // painted.
+  std::optional<SkIRect> ComputeClipRect(const PaintRegionList& current);
+
+  // Area of the frame that differs from the previous frame. Only valid after
+  // |ComputeClipRect|.
+  const std::optional<SkIRect>& frame_damage() const { return frame_damage_; }
+
+  // Area of the framebuffer that is repainted this frame. Only valid after
+  // |ComputeClipRect|.
+  const std::optional<SkIRect>& buffer_damage() const {
+    return buffer_damage_;
+  }
+
+ private:
+  const PaintRegionList* previous_ = nullptr;
+  std::optional<SkIRect> existing_damage_;
+  std::optional<SkIRect> frame_damage_;
+  std::optional<SkIRect> buffer_damage_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameDamage);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DIFF_CONTEXT_H_
@@ -0,0 +1,276 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/diff_context.h"
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr SkISize kFrameSize = SkISize::Make(100, 100);
+
+PaintRegionList MakeRegions(const std::vector<PaintRegion>& regions) {
+  PaintRegionList list;
+  list.frame_size = kFrameSize;
+  list.regions = regions;
+  return list;
+}
+
+}  // namespace
+
+using DiffContextTest = LayerTest;
+
+TEST(DiffContext, NoPreviousFrameRequiresFullRepaint) {
+  auto current = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  EXPECT_FALSE(DiffContext::ComputeDamage(nullptr, current).has_value());
+}
+
+TEST(DiffContext, FrameSizeChangeRequiresFullRepaint) {
+  auto previous = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  auto current = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  current.frame_size = SkISize::Make(200, 100);
+  EXPECT_FALSE(DiffContext::ComputeDamage(&previous, current).has_value());
+}
+
+TEST(DiffContext, UntrackedContentRequiresFullRepaint) {
+  auto previous = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  auto current = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  current.requires_full_repaint = true;
+  EXPECT_FALSE(DiffContext::ComputeDamage(&previous, current).has_value());
+}
+
+TEST(DiffContext, IdenticalFramesHaveNoDamage) {
+  auto previous = MakeRegions({{1, SkRect::MakeWH(10, 10)},
+                               {2, SkRect::MakeXYWH(20, 20, 10, 10)}});
+  auto current = previous;
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_TRUE(damage->isEmpty());
+}
+
+TEST(DiffContext, ChangedContentDamagesItsBounds) {
+  auto previous = MakeRegions({{1, SkRect::MakeWH(10, 10)},
+                               {2, SkRect::MakeXYWH(20, 20, 10, 10)}});
+  auto current = MakeRegions({{1, SkRect::MakeWH(10, 10)},
+                              {3, SkRect::MakeXYWH(20, 20, 10, 10)}});
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeXYWH(20, 20, 10, 10));
+}
+
+TEST(DiffContext, MovedContentDamagesOldAndNewBounds) {
+  auto previous = MakeRegions({{1, SkRect::MakeXYWH(10, 10, 10, 10)}});
+  auto current = MakeRegions({{1, SkRect::MakeXYWH(30, 10, 10, 10.5)}});
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeLTRB(10, 10, 40, 21));
+}
+
+TEST(DiffContext, RemovedContentDamagesItsBounds) {
+  auto previous = MakeRegions({{1, SkRect::MakeWH(10, 10)},
+                               {2, SkRect::MakeXYWH(50, 50, 10, 10)}});
+  auto current = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeXYWH(50, 50, 10, 10));
+}
+
+TEST(DiffContext, ReorderedContentIsDamaged) {
+  auto previous = MakeRegions({{1, SkRect::MakeXYWH(0, 0, 20, 20)},
+                               {2, SkRect::MakeXYWH(10, 10, 20, 20)}});
+  auto current = MakeRegions({{2, SkRect::MakeXYWH(10, 10, 20, 20)},
+                              {1, SkRect::MakeXYWH(0, 0, 20, 20)}});
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_TRUE(damage->contains(SkIRect::MakeXYWH(10, 10, 10, 10)));
+}
+
+TEST(DiffContext, DamageIsClippedToFrame) {
+  auto previous = MakeRegions({});
+  auto current = MakeRegions({{1, SkRect::MakeXYWH(90, 90, 50, 50)}});
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeXYWH(90, 90, 10, 10));
+}
+
+TEST(DiffContext, DirtyRegionsNeverMatch) {
+  DiffContext first(kFrameSize);
+  first.AddDirtyRegion(SkRect::MakeWH(10, 10), SkMatrix(), kGiantRect);
+  auto previous = first.TakePaintRegions();
+
+  DiffContext second(kFrameSize);
+  second.AddDirtyRegion(SkRect::MakeWH(10, 10), SkMatrix(), kGiantRect);
+  auto current = second.TakePaintRegions();
+
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeWH(10, 10));
+}
+
+TEST(DiffContext, PaintRegionsAreCulledAndTransformed) {
+  DiffContext context(kFrameSize);
+  context.AddPaintRegion(1, SkRect::MakeWH(20, 20), SkMatrix::Translate(5, 5),
+                         SkRect::MakeWH(10, 10));
+  context.AddPaintRegion(2, SkRect::MakeXYWH(50, 50, 10, 10), SkMatrix(),
+                         SkRect::MakeWH(10, 10));
+  auto regions = context.TakePaintRegions();
+  ASSERT_EQ(regions.regions.size(), 1u);
+  EXPECT_EQ(regions.regions[0].bounds, SkRect::MakeXYWH(5, 5, 10, 10));
+}
+
+TEST(DiffContext, CollapsedSubtreeCoversWholeBounds) {
+  DiffContext context(kFrameSize);
+  const size_t start = context.BeginSubtree();
+  context.AddPaintRegion(1, SkRect::MakeWH(10, 10), SkMatrix(), kGiantRect);
+  context.AddPaintRegion(2, SkRect::MakeXYWH(20, 20, 10, 10), SkMatrix(),
+                         kGiantRect);
+  context.CollapseSubtree(start, 3, SkRect::MakeWH(50, 50), SkMatrix(),
+                          kGiantRect);
+  auto regions = context.TakePaintRegions();
+  ASSERT_EQ(regions.regions.size(), 1u);
+  EXPECT_EQ(regions.regions[0].bounds, SkRect::MakeWH(50, 50));
+}
+
+TEST(DiffContext, BackdropFingerprintIdentifiesContentBehind) {
+  const SkRect backdrop_bounds = SkRect::MakeXYWH(20, 20, 20, 20);
+  const SkRect readback_bounds = SkRect::MakeXYWH(10, 10, 40, 40);
+  auto fingerprint = [&](uint64_t behind, uint64_t elsewhere) {
+    DiffContext context(kFrameSize);
+    context.AddPaintRegion(behind, SkRect::MakeWH(15, 15), SkMatrix(),
+                           kGiantRect);
+    context.AddPaintRegion(elsewhere, SkRect::MakeXYWH(80, 80, 10, 10),
+                           SkMatrix(), kGiantRect);
+    const size_t start = context.BeginSubtree();
+    context.AddPaintRegion(3, SkRect::MakeXYWH(25, 25, 5, 5), SkMatrix(),
+                           kGiantRect);
+    uint64_t result = context.AddBackdropRegion(start, 4, backdrop_bounds,
+                                                readback_bounds);
+    auto regions = context.TakePaintRegions();
+    // The backdrop is painted before the children of the filter.
+    EXPECT_EQ(regions.regions.size(), 4u);
+    EXPECT_EQ(regions.regions[2].bounds, backdrop_bounds);
+    EXPECT_EQ(regions.regions[2].readback_bounds, readback_bounds);
+    return result;
+  };
+
+  const uint64_t first = fingerprint(1, 2);
+  EXPECT_NE(first, 0u);
+  EXPECT_EQ(fingerprint(1, 2), first);
+  EXPECT_EQ(fingerprint(1, 5), first);
+  EXPECT_NE(fingerprint(5, 2), first);
+}
+
+TEST(DiffContext, ForkedContextCannotFingerprintBackdrops) {
+  DiffContext context(kFrameSize);
+  auto forked = context.Fork();
+  EXPECT_EQ(forked->AddBackdropRegion(0, 1, SkRect::MakeWH(10, 10),
+                                      SkRect::MakeWH(20, 20)),
+            0u);
+  context.Join(*forked);
+  EXPECT_TRUE(context.TakePaintRegions().requires_full_repaint);
+}
+
+TEST(DiffContext, DamagedBackdropRepaintsItsReadback) {
+  const PaintRegion backdrop = {3, SkRect::MakeXYWH(20, 20, 20, 20),
+                                SkRect::MakeXYWH(10, 10, 40, 40)};
+  auto previous =
+      MakeRegions({backdrop, {1, SkRect::MakeXYWH(25, 25, 5, 5)}});
+  auto current = MakeRegions({backdrop, {2, SkRect::MakeXYWH(25, 25, 5, 5)}});
+  auto damage = DiffContext::ComputeDamage(&previous, current);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeXYWH(10, 10, 40, 40));
+
+  auto unrelated =
+      MakeRegions({backdrop, {1, SkRect::MakeXYWH(25, 25, 5, 5)},
+                   {4, SkRect::MakeXYWH(80, 80, 10, 10)}});
+  damage = DiffContext::ComputeDamage(&previous, unrelated);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeXYWH(80, 80, 10, 10));
+}
+
+TEST(FrameDamage, BufferDamageIncludesExistingDamage) {
+  auto previous = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  auto current = MakeRegions({{2, SkRect::MakeWH(10, 10)}});
+
+  FrameDamage damage;
+  damage.SetPreviousPaintRegions(&previous);
+  damage.SetExistingBufferDamage(SkIRect::MakeXYWH(50, 50, 10, 10));
+  auto clip = damage.ComputeClipRect(current);
+  ASSERT_TRUE(clip.has_value());
+  EXPECT_EQ(clip.value(), SkIRect::MakeWH(60, 60));
+  EXPECT_EQ(damage.frame_damage(), SkIRect::MakeWH(10, 10));
+  EXPECT_EQ(damage.buffer_damage(), SkIRect::MakeWH(60, 60));
+}
+
+TEST(FrameDamage, UndefinedBufferRequiresFullRepaint) {
+  auto previous = MakeRegions({{1, SkRect::MakeWH(10, 10)}});
+  auto current = MakeRegions({{2, SkRect::MakeWH(10, 10)}});
+
+  FrameDamage damage;
+  damage.SetPreviousPaintRegions(&previous);
+  damage.SetExistingBufferDamage(std::nullopt);
+  EXPECT_FALSE(damage.ComputeClipRect(current).has_value());
+  EXPECT_EQ(damage.frame_damage(), SkIRect::MakeWH(10, 10));
+  EXPECT_FALSE(damage.buffer_damage().has_value());
+}
+
+TEST_F(DiffContextTest, EffectChangeDamagesChildren) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeXYWH(5, 5, 10, 10));
+
+  auto preroll = [this, &child_path](SkAlpha alpha) {
+    auto layer = std::make_shared<OpacityLayer>(alpha, SkPoint::Make(0, 0));
+    layer->Add(std::make_shared<MockLayer>(child_path));
+    DiffContext diff_context(kFrameSize);
+    preroll_context()->diff_context = &diff_context;
+    layer->Preroll(preroll_context(), SkMatrix());
+    preroll_context()->diff_context = nullptr;
+    return diff_context.TakePaintRegions();
+  };
+
+  auto first = preroll(128);
+  auto same = preroll(128);
+  auto changed = preroll(64);
+
+  auto no_damage = DiffContext::ComputeDamage(&first, same);
+  ASSERT_TRUE(no_damage.has_value());
+  EXPECT_TRUE(no_damage->isEmpty());
+
+  auto damage = DiffContext::ComputeDamage(&first, changed);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeXYWH(5, 5, 10, 10));
+}
+
+TEST_F(DiffContextTest, RebuiltLayersWithSameContentHaveNoDamage) {
+  const SkPath path1 = SkPath().addRect(SkRect::MakeXYWH(5, 5, 10, 10));
+  const SkPath path2 = SkPath().addRect(SkRect::MakeXYWH(50, 50, 10, 10));
+
+  auto preroll = [this, &path1, &path2](SkColor second_color) {
+    auto layer = std::make_shared<ContainerLayer>();
+    layer->Add(std::make_shared<MockLayer>(path1));
+    layer->Add(std::make_shared<MockLayer>(path2, SkPaint(SkColor4f::FromColor(
+                                                      second_color))));
+    DiffContext diff_context(kFrameSize);
+    preroll_context()->diff_context = &diff_context;
+    layer->Preroll(preroll_context(), SkMatrix());
+    preroll_context()->diff_context = nullptr;
+    return diff_context.TakePaintRegions();
+  };
+
+  auto first = preroll(SK_ColorBLUE);
+  auto second = preroll(SK_ColorRED);
+
+  auto damage = DiffContext::ComputeDamage(&first, second);
+  ASSERT_TRUE(damage.has_value());
+  EXPECT_EQ(damage.value(), SkIRect::MakeXYWH(50, 50, 10, 10));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,1797 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flutter/flow/diff_context.h"
+#include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkDrawable.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkM44.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkRegion.h"
+#include "third_party/skia/include/core/SkShader.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+#include "third_party/skia/src/core/SkDrawShadowInfo.h"
+
+namespace flutter {
+
+namespace {
+
+// The operations, in the order of |OpType|.
+#define FOR_EACH_DISPLAY_LIST_OP(V) \
+  V(SetPaint)                       \
+  V(Save)                           \
+  V(SaveLayer)                      \
+  V(Restore)                        \
+  V(Translate)                      \
+  V(Scale)                          \
+  V(Concat)                         \
+  V(Concat44)                       \
+  V(SetMatrix)                      \
+  V(ClipRect)                       \
+  V(ClipRRect)                      \
+  V(ClipPath)                       \
+  V(ClipRegion)                     \
+  V(DrawPaint)                      \
+  V(DrawPoints)                     \
+  V(DrawRect)                       \
+  V(DrawRegion)                     \
+  V(DrawOval)                       \
+  V(DrawArc)                        \
+  V(DrawRRect)                      \
+  V(DrawDRRect)                     \
+  V(DrawPath)                       \
+  V(DrawImage)                      \
+  V(DrawImageRect)                  \
+  V(DrawImageLattice)               \
+  V(DrawImageNine)                  \
+  V(DrawTextBlob)                   \
+  V(DrawPatch)                      \
+  V(DrawVertices)                   \
+  V(DrawAtlas)                      \
+  V(DrawShadowRec)                  \
+  V(DrawPicture)                    \
+  V(DrawDrawable)                   \
+  V(DrawAnnotation)                 \
+  V(DrawEdgeAAQuad)                 \
+  V(DrawEdgeAAImageSet)
+
+#define DISPLAY_LIST_OP_TYPE(name) k##name,
+enum class OpType : uint8_t { FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_TYPE) };
+#undef DISPLAY_LIST_OP_TYPE
+
+// The header of every operation. Operations are aligned to 8 bytes so that
+// the arrays that follow some of them are suitably aligned.
+struct alignas(8) Op {
+  OpType type;
+  // The size of the operation including its arrays.
+  uint32_t size;
+};
+
+// The arrays of an operation are stored right after it.
+template <typename T>
+const T* ArrayAfter(const void* op, size_t op_size, size_t offset = 0) {
+  return reinterpret_cast<const T*>(static_cast<const uint8_t*>(op) + op_size +
+                                    offset);
+}
+
+template <typename T>
+void CopyArray(void* dst, const T* src, size_t count) {
+  if (count > 0) {
+    memcpy(dst, src, count * sizeof(T));
+  }
+}
+
+template <typename T>
+bool SameArray(const T* a, const T* b, size_t count) {
+  return count == 0 || memcmp(a, b, count * sizeof(T)) == 0;
+}
+
+// The state carried from one operation to the next while rendering.
+struct DispatchState {
+  // The current paint, with |opacity| applied.
+  SkPaint paint;
+  SkMatrix initial_matrix;
+  SkScalar opacity = SK_Scalar1;
+  // Stands in for the missing optional paints when |opacity| is below 1.
+  SkPaint opacity_paint;
+};
+
+// Content fingerprints only identify Skia objects that cannot be hashed
+// cheaply, like images and text blobs, by their unique IDs. Everything else is
+// hashed by value: display lists that are re-recorded with the same content
+// must share a fingerprint.
+void HashBytes(size_t& seed, const void* bytes, size_t length) {
+  fml::HashCombineSeed(seed,
+                       std::hash<std::string_view>{}(std::string_view(
+                           static_cast<const char*>(bytes), length)));
+}
+
+template <typename T>
+void HashArray(size_t& seed, const T* array, size_t count) {
+  if (count > 0) {
+    HashBytes(seed, array, count * sizeof(T));
+  }
+}
+
+// For plain structs of scalars like rects, points and colors.
+template <typename T>
+void HashValue(size_t& seed, const T& value) {
+  HashBytes(seed, &value, sizeof(T));
+}
+
+void HashRegion(size_t& seed, const SkRegion& region) {
+  std::vector<uint8_t> buffer(region.writeToMemory(nullptr));
+  region.writeToMemory(buffer.data());
+  HashArray(seed, buffer.data(), buffer.size());
+}
+
+void HashShader(size_t& seed, SkShader* shader) {
+  SkMatrix matrix;
+  SkTileMode tile_modes[2];
+  if (SkImage* image = shader ? shader->isAImage(&matrix, tile_modes)
+                              : nullptr) {
+    // Serializing an image shader would encode its image.
+    fml::HashCombineSeed(seed, image->uniqueID(),
+                         DiffContext::HashMatrix(matrix), tile_modes[0],
+                         tile_modes[1]);
+  } else {
+    fml::HashCombineSeed(seed, DiffContext::HashFlattenable(shader));
+  }
+}
+
+void HashPaint(size_t& seed, const SkPaint& paint) {
+  HashValue(seed, paint.getColor4f());
+  fml::HashCombineSeed(seed, paint.getStrokeWidth(), paint.getStrokeMiter(),
+                       paint.getStrokeCap(), paint.getStrokeJoin(),
+                       paint.getStyle(), paint.getBlendMode(),
+                       paint.isAntiAlias(), paint.isDither(),
+                       paint.getFilterQuality());
+  HashShader(seed, paint.getShader());
+  fml::HashCombineSeed(seed,
+                       DiffContext::HashFlattenable(paint.getColorFilter()),
+                       DiffContext::HashFlattenable(paint.getMaskFilter()),
+                       DiffContext::HashFlattenable(paint.getPathEffect()),
+                       DiffContext::HashFlattenable(paint.getImageFilter()));
+}
+
+const SkPaint* OptionalPaint(bool has_paint, const DispatchState& state) {
+  if (has_paint) {
+    return &state.paint;
+  }
+  return state.opacity < SK_Scalar1 ? &state.opacity_paint : nullptr;
+}
+
+// Whether applying an opacity to the paint has the same result as compositing
+// what it draws with that opacity.
+bool PaintCanApplyOpacity(const SkPaint& paint) {
+  return paint.getBlendMode() == SkBlendMode::kSrcOver &&
+         paint.getColorFilter() == nullptr && paint.getImageFilter() == nullptr;
+}
+
+// Whether drawing with the blend mode leaves opaque pixels opaque.
+bool BlendModeKeepsDstOpaque(SkBlendMode mode) {
+  switch (mode) {
+    case SkBlendMode::kClear:
+    case SkBlendMode::kSrc:
+    case SkBlendMode::kSrcIn:
+    case SkBlendMode::kDstIn:
+    case SkBlendMode::kSrcOut:
+    case SkBlendMode::kDstOut:
+    case SkBlendMode::kDstATop:
+    case SkBlendMode::kXor:
+    case SkBlendMode::kModulate:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Whether filling a shape with the paint makes its pixels opaque.
+bool PaintIsOpaque(const SkPaint& paint) {
+  return (paint.getBlendMode() == SkBlendMode::kSrcOver ||
+          paint.getBlendMode() == SkBlendMode::kSrc) &&
+         paint.getAlpha() == 0xff && paint.getStyle() == SkPaint::kFill_Style &&
+         (paint.getShader() == nullptr || paint.getShader()->isOpaque()) &&
+         paint.getColorFilter() == nullptr &&
+         paint.getImageFilter() == nullptr &&
+         paint.getMaskFilter() == nullptr && paint.getPathEffect() == nullptr;
+}
+
+// Unlike |SkRect::intersects|, bounds that only touch overlap as antialiased
+// edges share pixels.
+bool BoundsOverlap(const SkRect& a, const SkRect& b) {
+  return !a.isEmpty() && !b.isEmpty() && a.fLeft <= b.fRight &&
+         b.fLeft <= a.fRight && a.fTop <= b.fBottom && b.fTop <= a.fBottom;
+}
+
+struct SetPaintOp : Op {
+  static constexpr OpType kType = OpType::kSetPaint;
+  explicit SetPaintOp(const SkPaint& p) : paint(p) {}
+  SkPaint paint;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    state.paint = paint;
+    if (state.opacity < SK_Scalar1) {
+      state.paint.setAlphaf(paint.getAlphaf() * state.opacity);
+    }
+  }
+  bool Equals(const SetPaintOp& other) const { return paint == other.paint; }
+  void Hash(size_t& seed) const {
+    HashPaint(seed, paint);
+  }
+};
+
+struct SaveOp : Op {
+  static constexpr OpType kType = OpType::kSave;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->save();
+  }
+  bool Equals(const SaveOp& other) const { return true; }
+  void Hash(size_t& seed) const {}
+};
+
+struct SaveLayerOp : Op {
+  static constexpr OpType kType = OpType::kSaveLayer;
+  SaveLayerOp(const SkRect* b,
+              bool p,
+              const SkImageFilter* backdrop,
+              SkCanvas::SaveLayerFlags f)
+      : bounds(b ? *b : SkRect::MakeEmpty()),
+        has_bounds(b != nullptr),
+        has_paint(p),
+        backdrop(sk_ref_sp(backdrop)),
+        flags(f) {}
+  SkRect bounds;
+  bool has_bounds;
+  bool has_paint;
+  sk_sp<SkImageFilter> backdrop;
+  SkCanvas::SaveLayerFlags flags;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->saveLayer(SkCanvas::SaveLayerRec(
+        has_bounds ? &bounds : nullptr, OptionalPaint(has_paint, state),
+        backdrop.get(), flags));
+  }
+  bool Equals(const SaveLayerOp& other) const {
+    return has_bounds == other.has_bounds &&
+           (!has_bounds || bounds == other.bounds) &&
+           has_paint == other.has_paint && backdrop == other.backdrop &&
+           flags == other.flags;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, has_bounds, has_paint, flags,
+                         DiffContext::HashFlattenable(backdrop.get()));
+    if (has_bounds) {
+      HashValue(seed, bounds);
+    }
+  }
+};
+
+struct RestoreOp : Op {
+  static constexpr OpType kType = OpType::kRestore;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->restore();
+  }
+  bool Equals(const RestoreOp& other) const { return true; }
+  void Hash(size_t& seed) const {}
+};
+
+struct TranslateOp : Op {
+  static constexpr OpType kType = OpType::kTranslate;
+  TranslateOp(SkScalar x, SkScalar y) : dx(x), dy(y) {}
+  SkScalar dx;
+  SkScalar dy;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->translate(dx, dy);
+  }
+  bool Equals(const TranslateOp& other) const {
+    return dx == other.dx && dy == other.dy;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, dx, dy);
+  }
+};
+
+struct ScaleOp : Op {
+  static constexpr OpType kType = OpType::kScale;
+  ScaleOp(SkScalar x, SkScalar y) : sx(x), sy(y) {}
+  SkScalar sx;
+  SkScalar sy;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->scale(sx, sy);
+  }
+  bool Equals(const ScaleOp& other) const {
+    return sx == other.sx && sy == other.sy;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, sx, sy);
+  }
+};
+
+struct ConcatOp : Op {
+  static constexpr OpType kType = OpType::kConcat;
+  explicit ConcatOp(const SkMatrix& m) : matrix(m) {}
+  SkMatrix matrix;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->concat(matrix);
+  }
+  bool Equals(const ConcatOp& other) const { return matrix == other.matrix; }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, DiffContext::HashMatrix(matrix));
+  }
+};
+
+struct Concat44Op : Op {
+  static constexpr OpType kType = OpType::kConcat44;
+  explicit Concat44Op(const SkM44& m) : matrix(m) {}
+  SkM44 matrix;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->concat(matrix);
+  }
+  bool Equals(const Concat44Op& other) const { return matrix == other.matrix; }
+  void Hash(size_t& seed) const {
+    HashValue(seed, matrix);
+  }
+};
+
+struct SetMatrixOp : Op {
+  static constexpr OpType kType = OpType::kSetMatrix;
+  explicit SetMatrixOp(const SkMatrix& m) : matrix(m) {}
+  SkMatrix matrix;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    // Like for pictures, the matrix is relative to the matrix the display
+    // list is rendered with.
+    canvas->setMatrix(SkMatrix::Concat(state.initial_matrix, matrix));
+  }
+  bool Equals(const SetMatrixOp& other) const {
+    return matrix == other.matrix;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, DiffContext::HashMatrix(matrix));
+  }
+};
+
+struct ClipRectOp : Op {
+  static constexpr OpType kType = OpType::kClipRect;
+  ClipRectOp(const SkRect& r, SkClipOp o, bool a) : rect(r), op(o), aa(a) {}
+  SkRect rect;
+  SkClipOp op;
+  bool aa;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->clipRect(rect, op, aa);
+  }
+  bool Equals(const ClipRectOp& other) const {
+    return rect == other.rect && op == other.op && aa == other.aa;
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, rect);
+    fml::HashCombineSeed(seed, op, aa);
+  }
+};
+
+struct ClipRRectOp : Op {
+  static constexpr OpType kType = OpType::kClipRRect;
+  ClipRRectOp(const SkRRect& r, SkClipOp o, bool a) : rrect(r), op(o), aa(a) {}
+  SkRRect rrect;
+  SkClipOp op;
+  bool aa;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->clipRRect(rrect, op, aa);
+  }
+  bool Equals(const ClipRRectOp& other) const {
+    return rrect == other.rrect && op == other.op && aa == other.aa;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, DiffContext::HashRRect(rrect), op, aa);
+  }
+};
+
+struct ClipPathOp : Op {
+  static constexpr OpType kType = OpType::kClipPath;
+  ClipPathOp(const SkPath& p, SkClipOp o, bool a) : path(p), op(o), aa(a) {}
+  SkPath path;
+  SkClipOp op;
+  bool aa;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->clipPath(path, op, aa);
+  }
+  bool Equals(const ClipPathOp& other) const {
+    return path == other.path && op == other.op && aa == other.aa;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, DiffContext::HashPath(path), op, aa);
+  }
+};
+
+struct ClipRegionOp : Op {
+  static constexpr OpType kType = OpType::kClipRegion;
+  ClipRegionOp(const SkRegion& r, SkClipOp o) : region(r), op(o) {}
+  SkRegion region;
+  SkClipOp op;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->clipRegion(region, op);
+  }
+  bool Equals(const ClipRegionOp& other) const {
+    return region == other.region && op == other.op;
+  }
+  void Hash(size_t& seed) const {
+    HashRegion(seed, region);
+    fml::HashCombineSeed(seed, op);
+  }
+};
+
+struct DrawPaintOp : Op {
+  static constexpr OpType kType = OpType::kDrawPaint;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawPaint(state.paint);
+  }
+  bool Equals(const DrawPaintOp& other) const { return true; }
+  void Hash(size_t& seed) const {}
+};
+
+// Followed by |count| points.
+struct DrawPointsOp : Op {
+  static constexpr OpType kType = OpType::kDrawPoints;
+  DrawPointsOp(SkCanvas::PointMode m, size_t c, const SkPoint* points)
+      : mode(m), count(c) {
+    CopyArray(this + 1, points, count);
+  }
+  SkCanvas::PointMode mode;
+  size_t count;
+  const SkPoint* points() const {
+    return ArrayAfter<SkPoint>(this, sizeof(*this));
+  }
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawPoints(mode, count, points(), state.paint);
+  }
+  bool Equals(const DrawPointsOp& other) const {
+    return mode == other.mode && count == other.count &&
+           SameArray(points(), other.points(), count);
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, mode, count);
+    HashArray(seed, points(), count);
+  }
+};
+
+struct DrawRectOp : Op {
+  static constexpr OpType kType = OpType::kDrawRect;
+  explicit DrawRectOp(const SkRect& r) : rect(r) {}
+  SkRect rect;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawRect(rect, state.paint);
+  }
+  bool Equals(const DrawRectOp& other) const { return rect == other.rect; }
+  void Hash(size_t& seed) const {
+    HashValue(seed, rect);
+  }
+};
+
+struct DrawRegionOp : Op {
+  static constexpr OpType kType = OpType::kDrawRegion;
+  explicit DrawRegionOp(const SkRegion& r) : region(r) {}
+  SkRegion region;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawRegion(region, state.paint);
+  }
+  bool Equals(const DrawRegionOp& other) const {
+    return region == other.region;
+  }
+  void Hash(size_t& seed) const {
+    HashRegion(seed, region);
+  }
+};
+
+struct DrawOvalOp : Op {
+  static constexpr OpType kType = OpType::kDrawOval;
+  explicit DrawOvalOp(const SkRect& r) : oval(r) {}
+  SkRect oval;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawOval(oval, state.paint);
+  }
+  bool Equals(const DrawOvalOp& other) const { return oval == other.oval; }
+  void Hash(size_t& seed) const {
+    HashValue(seed, oval);
+  }
+};
+
+struct DrawArcOp : Op {
+  static constexpr OpType kType = OpType::kDrawArc;
+  DrawArcOp(const SkRect& r, SkScalar start, SkScalar sweep, bool center)
+      : oval(r), start_angle(start), sweep_angle(sweep), use_center(center) {}
+  SkRect oval;
+  SkScalar start_angle;
+  SkScalar sweep_angle;
+  bool use_center;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawArc(oval, start_angle, sweep_angle, use_center, state.paint);
+  }
+  bool Equals(const DrawArcOp& other) const {
+    return oval == other.oval && start_angle == other.start_angle &&
+           sweep_angle == other.sweep_angle && use_center == other.use_center;
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, oval);
+    fml::HashCombineSeed(seed, start_angle, sweep_angle, use_center);
+  }
+};
+
+struct DrawRRectOp : Op {
+  static constexpr OpType kType = OpType::kDrawRRect;
+  explicit DrawRRectOp(const SkRRect& r) : rrect(r) {}
+  SkRRect rrect;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawRRect(rrect, state.paint);
+  }
+  bool Equals(const DrawRRectOp& other) const { return rrect == other.rrect; }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, DiffContext::HashRRect(rrect));
+  }
+};
+
+struct DrawDRRectOp : Op {
+  static constexpr OpType kType = OpType::kDrawDRRect;
+  DrawDRRectOp(const SkRRect& o, const SkRRect& i) : outer(o), inner(i) {}
+  SkRRect outer;
+  SkRRect inner;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawDRRect(outer, inner, state.paint);
+  }
+  bool Equals(const DrawDRRectOp& other) const {
+    return outer == other.outer && inner == other.inner;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, DiffContext::HashRRect(outer),
+                         DiffContext::HashRRect(inner));
+  }
+};
+
+struct DrawPathOp : Op {
+  static constexpr OpType kType = OpType::kDrawPath;
+  explicit DrawPathOp(const SkPath& p) : path(p) {}
+  SkPath path;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawPath(path, state.paint);
+  }
+  bool Equals(const DrawPathOp& other) const { return path == other.path; }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, DiffContext::HashPath(path));
+  }
+};
+
+struct DrawImageOp : Op {
+  static constexpr OpType kType = OpType::kDrawImage;
+  DrawImageOp(const SkImage* i, SkScalar l, SkScalar t, bool p)
+      : image(sk_ref_sp(i)), left(l), top(t), has_paint(p) {}
+  sk_sp<const SkImage> image;
+  SkScalar left;
+  SkScalar top;
+  bool has_paint;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawImage(image.get(), left, top,
+                      OptionalPaint(has_paint, state));
+  }
+  bool Equals(const DrawImageOp& other) const {
+    return image == other.image && left == other.left && top == other.top &&
+           has_paint == other.has_paint;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, image->uniqueID(), left, top, has_paint);
+  }
+};
+
+struct DrawImageRectOp : Op {
+  static constexpr OpType kType = OpType::kDrawImageRect;
+  DrawImageRectOp(const SkImage* i,
+                  const SkRect* s,
+                  const SkRect& d,
+                  bool p,
+                  SkCanvas::SrcRectConstraint c)
+      : image(sk_ref_sp(i)),
+        src(s ? *s : SkRect::MakeIWH(i->width(), i->height())),
+        dst(d),
+        has_paint(p),
+        constraint(c) {}
+  sk_sp<const SkImage> image;
+  SkRect src;
+  SkRect dst;
+  bool has_paint;
+  SkCanvas::SrcRectConstraint constraint;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawImageRect(image.get(), src, dst,
+                          OptionalPaint(has_paint, state), constraint);
+  }
+  bool Equals(const DrawImageRectOp& other) const {
+    return image == other.image && src == other.src && dst == other.dst &&
+           has_paint == other.has_paint && constraint == other.constraint;
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, src);
+    HashValue(seed, dst);
+    fml::HashCombineSeed(seed, image->uniqueID(), has_paint, constraint);
+  }
+};
+
+// Followed by the x divs, the y divs and, if there are rect types, the colors
+// and the rect types of the cells.
+struct DrawImageLatticeOp : Op {
+  static constexpr OpType kType = OpType::kDrawImageLattice;
+  static size_t CellCount(const SkCanvas::Lattice& lattice) {
+    return lattice.fRectTypes
+               ? (lattice.fXCount + 1) * (lattice.fYCount + 1)
+               : 0;
+  }
+  static size_t ArraysSize(const SkCanvas::Lattice& lattice) {
+    const size_t cells = CellCount(lattice);
+    return (lattice.fXCount + lattice.fYCount) * sizeof(int) +
+           cells * (sizeof(SkColor) + sizeof(SkCanvas::Lattice::RectType));
+  }
+  DrawImageLatticeOp(const SkImage* i,
+                     const SkCanvas::Lattice& lattice,
+                     const SkRect& d,
+                     bool p)
+      : image(sk_ref_sp(i)),
+        dst(d),
+        has_paint(p),
+        x_count(lattice.fXCount),
+        y_count(lattice.fYCount),
+        cell_count(CellCount(lattice)),
+        has_bounds(lattice.fBounds != nullptr),
+        bounds(lattice.fBounds ? *lattice.fBounds : SkIRect::MakeEmpty()) {
+    uint8_t* arrays = reinterpret_cast<uint8_t*>(this + 1);
+    CopyArray(arrays, lattice.fXDivs, x_count);
+    arrays += x_count * sizeof(int);
+    CopyArray(arrays, lattice.fYDivs, y_count);
+    arrays += y_count * sizeof(int);
+    if (cell_count > 0) {
+      if (lattice.fColors) {
+        CopyArray(arrays, lattice.fColors, cell_count);
+      } else {
+        memset(arrays, 0, cell_count * sizeof(SkColor));
+      }
+      arrays += cell_count * sizeof(SkColor);
+      CopyArray(arrays, lattice.fRectTypes, cell_count);
+    }
+  }
+  sk_sp<const SkImage> image;
+  SkRect dst;
+  bool has_paint;
+  int x_count;
+  int y_count;
+  size_t cell_count;
+  bool has_bounds;
+  SkIRect bounds;
+  const int* x_divs() const { return ArrayAfter<int>(this, sizeof(*this)); }
+  const int* y_divs() const {
+    return ArrayAfter<int>(this, sizeof(*this), x_count * sizeof(int));
+  }
+  const SkColor* colors() const {
+    return ArrayAfter<SkColor>(this, sizeof(*this),
+                               (x_count + y_count) * sizeof(int));
+  }
+  const SkCanvas::Lattice::RectType* rect_types() const {
+    return ArrayAfter<SkCanvas::Lattice::RectType>(
+        this, sizeof(*this),
+        (x_count + y_count) * sizeof(int) + cell_count * sizeof(SkColor));
+  }
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    SkCanvas::Lattice lattice;
+    lattice.fXDivs = x_divs();
+    lattice.fYDivs = y_divs();
+    lattice.fRectTypes = cell_count > 0 ? rect_types() : nullptr;
+    lattice.fXCount = x_count;
+    lattice.fYCount = y_count;
+    lattice.fBounds = has_bounds ? &bounds : nullptr;
+    lattice.fColors = cell_count > 0 ? colors() : nullptr;
+    canvas->drawImageLattice(image.get(), lattice, dst,
+                             OptionalPaint(has_paint, state));
+  }
+  bool Equals(const DrawImageLatticeOp& other) const {
+    return image == other.image && dst == other.dst &&
+           has_paint == other.has_paint && x_count == other.x_count &&
+           y_count == other.y_count && cell_count == other.cell_count &&
+           has_bounds == other.has_bounds &&
+           (!has_bounds || bounds == other.bounds) &&
+           SameArray(x_divs(), other.x_divs(), x_count + y_count) &&
+           SameArray(colors(), other.colors(), cell_count) &&
+           SameArray(rect_types(), other.rect_types(), cell_count);
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, dst);
+    fml::HashCombineSeed(seed, image->uniqueID(), has_paint, x_count, y_count,
+                         cell_count, has_bounds);
+    if (has_bounds) {
+      HashValue(seed, bounds);
+    }
+    HashArray(seed, x_divs(), x_count + y_count);
+    HashArray(seed, colors(), cell_count);
+    HashArray(seed, rect_types(), cell_count);
+  }
+};
+
+struct DrawImageNineOp : Op {
+  static constexpr OpType kType = OpType::kDrawImageNine;
+  DrawImageNineOp(const SkImage* i, const SkIRect& c, const SkRect& d, bool p)
+      : image(sk_ref_sp(i)), center(c), dst(d), has_paint(p) {}
+  sk_sp<const SkImage> image;
+  SkIRect center;
+  SkRect dst;
+  bool has_paint;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawImageNine(image.get(), center, dst,
+                          OptionalPaint(has_paint, state));
+  }
+  bool Equals(const DrawImageNineOp& other) const {
+    return image == other.image && center == other.center &&
+           dst == other.dst && has_paint == other.has_paint;
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, center);
+    HashValue(seed, dst);
+    fml::HashCombineSeed(seed, image->uniqueID(), has_paint);
+  }
+};
+
+struct DrawTextBlobOp : Op {
+  static constexpr OpType kType = OpType::kDrawTextBlob;
+  DrawTextBlobOp(const SkTextBlob* b, SkScalar x_, SkScalar y_)
+      : blob(sk_ref_sp(b)), x(x_), y(y_) {}
+  sk_sp<const SkTextBlob> blob;
+  SkScalar x;
+  SkScalar y;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawTextBlob(blob.get(), x, y, state.paint);
+  }
+  bool Equals(const DrawTextBlobOp& other) const {
+    return blob == other.blob && x == other.x && y == other.y;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, blob->uniqueID(), x, y);
+  }
+};
+
+struct DrawPatchOp : Op {
+  static constexpr OpType kType = OpType::kDrawPatch;
+  DrawPatchOp(const SkPoint c[12],
+              const SkColor col[4],
+              const SkPoint t[4],
+              SkBlendMode m)
+      : has_colors(col != nullptr), has_tex_coords(t != nullptr), mode(m) {
+    CopyArray(cubics, c, 12);
+    if (col) {
+      CopyArray(colors, col, 4);
+    }
+    if (t) {
+      CopyArray(tex_coords, t, 4);
+    }
+  }
+  SkPoint cubics[12];
+  SkColor colors[4] = {};
+  SkPoint tex_coords[4] = {};
+  bool has_colors;
+  bool has_tex_coords;
+  SkBlendMode mode;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawPatch(cubics, has_colors ? colors : nullptr,
+                      has_tex_coords ? tex_coords : nullptr, mode, state.paint);
+  }
+  bool Equals(const DrawPatchOp& other) const {
+    return SameArray(cubics, other.cubics, 12) &&
+           SameArray(colors, other.colors, 4) &&
+           SameArray(tex_coords, other.tex_coords, 4) &&
+           has_colors == other.has_colors &&
+           has_tex_coords == other.has_tex_coords && mode == other.mode;
+  }
+  void Hash(size_t& seed) const {
+    HashArray(seed, cubics, 12);
+    HashArray(seed, colors, 4);
+    HashArray(seed, tex_coords, 4);
+    fml::HashCombineSeed(seed, has_colors, has_tex_coords, mode);
+  }
+};
+
+struct DrawVerticesOp : Op {
+  static constexpr OpType kType = OpType::kDrawVertices;
+  DrawVerticesOp(const SkVertices* v, SkBlendMode m)
+      : vertices(sk_ref_sp(v)), mode(m) {}
+  sk_sp<const SkVertices> vertices;
+  SkBlendMode mode;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawVertices(vertices.get(), mode, state.paint);
+  }
+  bool Equals(const DrawVerticesOp& other) const {
+    return vertices == other.vertices && mode == other.mode;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, vertices->uniqueID(), mode);
+  }
+};
+
+// Followed by |count| transforms, |count| texture rects and, if there are
+// colors, |count| colors.
+struct DrawAtlasOp : Op {
+  static constexpr OpType kType = OpType::kDrawAtlas;
+  static size_t ArraysSize(int count, bool has_colors) {
+    return count * (sizeof(SkRSXform) + sizeof(SkRect) +
+                    (has_colors ? sizeof(SkColor) : 0));
+  }
+  DrawAtlasOp(const SkImage* a,
+              const SkRSXform* xforms,
+              const SkRect* tex,
+              const SkColor* cols,
+              int c,
+              SkBlendMode m,
+              const SkRect* cull,
+              bool p)
+      : atlas(sk_ref_sp(a)),
+        count(c),
+        mode(m),
+        has_colors(cols != nullptr),
+        has_cull_rect(cull != nullptr),
+        cull_rect(cull ? *cull : SkRect::MakeEmpty()),
+        has_paint(p) {
+    uint8_t* arrays = reinterpret_cast<uint8_t*>(this + 1);
+    CopyArray(arrays, xforms, count);
+    arrays += count * sizeof(SkRSXform);
+    CopyArray(arrays, tex, count);
+    arrays += count * sizeof(SkRect);
+    if (cols) {
+      CopyArray(arrays, cols, count);
+    }
+  }
+  sk_sp<const SkImage> atlas;
+  int count;
+  SkBlendMode mode;
+  bool has_colors;
+  bool has_cull_rect;
+  SkRect cull_rect;
+  bool has_paint;
+  const SkRSXform* xforms() const {
+    return ArrayAfter<SkRSXform>(this, sizeof(*this));
+  }
+  const SkRect* tex() const {
+    return ArrayAfter<SkRect>(this, sizeof(*this), count * sizeof(SkRSXform));
+  }
+  const SkColor* colors() const {
+    return has_colors ? ArrayAfter<SkColor>(
+                            this, sizeof(*this),
+                            count * (sizeof(SkRSXform) + sizeof(SkRect)))
+                      : nullptr;
+  }
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawAtlas(atlas.get(), xforms(), tex(), colors(), count, mode,
+                      has_cull_rect ? &cull_rect : nullptr,
+                      OptionalPaint(has_paint, state));
+  }
+  bool Equals(const DrawAtlasOp& other) const {
+    return atlas == other.atlas && count == other.count &&
+           mode == other.mode && has_colors == other.has_colors &&
+           has_cull_rect == other.has_cull_rect &&
+           (!has_cull_rect || cull_rect == other.cull_rect) &&
+           has_paint == other.has_paint &&
+           SameArray(xforms(), other.xforms(), count) &&
+           SameArray(tex(), other.tex(), count) &&
+           (!has_colors || SameArray(colors(), other.colors(), count));
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, atlas->uniqueID(), count, mode, has_colors,
+                         has_cull_rect, has_paint);
+    if (has_cull_rect) {
+      HashValue(seed, cull_rect);
+    }
+    HashArray(seed, xforms(), count);
+    HashArray(seed, tex(), count);
+    if (has_colors) {
+      HashArray(seed, colors(), count);
+    }
+  }
+};
+
+struct DrawShadowRecOp : Op {
+  static constexpr OpType kType = OpType::kDrawShadowRec;
+  DrawShadowRecOp(const SkPath& p, const SkDrawShadowRec& r)
+      : path(p), rec(r) {}
+  SkPath path;
+  SkDrawShadowRec rec;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->private_draw_shadow_rec(path, rec);
+  }
+  bool Equals(const DrawShadowRecOp& other) const {
+    return path == other.path &&
+           rec.fZPlaneParams == other.rec.fZPlaneParams &&
+           rec.fLightPos == other.rec.fLightPos &&
+           rec.fLightRadius == other.rec.fLightRadius &&
+           rec.fAmbientColor == other.rec.fAmbientColor &&
+           rec.fSpotColor == other.rec.fSpotColor &&
+           rec.fFlags == other.rec.fFlags;
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, rec.fZPlaneParams);
+    HashValue(seed, rec.fLightPos);
+    fml::HashCombineSeed(seed, DiffContext::HashPath(path), rec.fLightRadius,
+                         rec.fAmbientColor, rec.fSpotColor, rec.fFlags);
+  }
+};
+
+struct DrawPictureOp : Op {
+  static constexpr OpType kType = OpType::kDrawPicture;
+  DrawPictureOp(const SkPicture* p, const SkMatrix* m, bool paint)
+      : picture(sk_ref_sp(p)),
+        has_matrix(m != nullptr),
+        matrix(m ? *m : SkMatrix::I()),
+        has_paint(paint) {}
+  sk_sp<const SkPicture> picture;
+  bool has_matrix;
+  SkMatrix matrix;
+  bool has_paint;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawPicture(picture.get(), has_matrix ? &matrix : nullptr,
+                        OptionalPaint(has_paint, state));
+  }
+  bool Equals(const DrawPictureOp& other) const {
+    return picture == other.picture && has_matrix == other.has_matrix &&
+           matrix == other.matrix && has_paint == other.has_paint;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, picture->uniqueID(), has_matrix,
+                         DiffContext::HashMatrix(matrix), has_paint);
+  }
+};
+
+struct DrawDrawableOp : Op {
+  static constexpr OpType kType = OpType::kDrawDrawable;
+  DrawDrawableOp(SkDrawable* d, const SkMatrix* m)
+      : drawable(sk_ref_sp(d)),
+        has_matrix(m != nullptr),
+        matrix(m ? *m : SkMatrix::I()) {}
+  sk_sp<SkDrawable> drawable;
+  bool has_matrix;
+  SkMatrix matrix;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawDrawable(drawable.get(), has_matrix ? &matrix : nullptr);
+  }
+  bool Equals(const DrawDrawableOp& other) const {
+    // Drawables may draw differently every time.
+    return false;
+  }
+  void Hash(size_t& seed) const {
+    // Drawables may draw differently every time, so the fingerprint never
+    // matches that of another display list.
+    static std::atomic<uint64_t> next_drawable_fingerprint(1);
+    fml::HashCombineSeed(seed, next_drawable_fingerprint.fetch_add(1));
+  }
+};
+
+// Followed by the null terminated key.
+struct DrawAnnotationOp : Op {
+  static constexpr OpType kType = OpType::kDrawAnnotation;
+  DrawAnnotationOp(const SkRect& r, const char* key, SkData* v)
+      : rect(r), value(sk_ref_sp(v)) {
+    strcpy(reinterpret_cast<char*>(this + 1), key);
+  }
+  SkRect rect;
+  sk_sp<SkData> value;
+  const char* key() const { return ArrayAfter<char>(this, sizeof(*this)); }
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->drawAnnotation(rect, key(), value.get());
+  }
+  bool Equals(const DrawAnnotationOp& other) const {
+    return rect == other.rect && strcmp(key(), other.key()) == 0 &&
+           (value == other.value ||
+            (value && other.value && value->equals(other.value.get())));
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, rect);
+    HashArray(seed, key(), strlen(key()));
+    if (value) {
+      HashArray(seed, value->bytes(), value->size());
+    }
+  }
+};
+
+struct DrawEdgeAAQuadOp : Op {
+  static constexpr OpType kType = OpType::kDrawEdgeAAQuad;
+  DrawEdgeAAQuadOp(const SkRect& r,
+                   const SkPoint c[4],
+                   SkCanvas::QuadAAFlags f,
+                   const SkColor4f& col,
+                   SkBlendMode m)
+      : rect(r), has_clip(c != nullptr), flags(f), color(col), mode(m) {
+    if (c) {
+      CopyArray(clip, c, 4);
+    }
+  }
+  SkRect rect;
+  SkPoint clip[4] = {};
+  bool has_clip;
+  SkCanvas::QuadAAFlags flags;
+  SkColor4f color;
+  SkBlendMode mode;
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    SkColor4f modulated = color;
+    modulated.fA *= state.opacity;
+    canvas->experimental_DrawEdgeAAQuad(rect, has_clip ? clip : nullptr, flags,
+                                        modulated, mode);
+  }
+  bool Equals(const DrawEdgeAAQuadOp& other) const {
+    return rect == other.rect && has_clip == other.has_clip &&
+           SameArray(clip, other.clip, 4) && flags == other.flags &&
+           color == other.color && mode == other.mode;
+  }
+  void Hash(size_t& seed) const {
+    HashValue(seed, rect);
+    HashArray(seed, clip, 4);
+    HashValue(seed, color);
+    fml::HashCombineSeed(seed, has_clip, flags, mode);
+  }
+};
+
+// Followed by |count| entries, |clip_count| clip points and |matrix_count|
+// matrices.
+struct DrawEdgeAAImageSetOp : Op {
+  static constexpr OpType kType = OpType::kDrawEdgeAAImageSet;
+  using Entry = SkCanvas::ImageSetEntry;
+  static int ClipCount(const Entry set[], int count) {
+    int clips = 0;
+    for (int i = 0; i < count; i++) {
+      clips += set[i].fHasClip ? 4 : 0;
+    }
+    return clips;
+  }
+  static int MatrixCount(const Entry set[], int count) {
+    int matrices = 0;
+    for (int i = 0; i < count; i++) {
+      matrices = std::max(matrices, set[i].fMatrixIndex + 1);
+    }
+    return matrices;
+  }
+  static size_t ArraysSize(const Entry set[], int count) {
+    return count * sizeof(Entry) + ClipCount(set, count) * sizeof(SkPoint) +
+           MatrixCount(set, count) * sizeof(SkMatrix);
+  }
+  DrawEdgeAAImageSetOp(const Entry set[],
+                       int c,
+                       const SkPoint clips[],
+                       const SkMatrix matrices[],
+                       bool p,
+                       SkCanvas::SrcRectConstraint con)
+      : count(c),
+        clip_count(ClipCount(set, c)),
+        matrix_count(MatrixCount(set, c)),
+        has_paint(p),
+        constraint(con) {
+    Entry* entries = reinterpret_cast<Entry*>(this + 1);
+    for (int i = 0; i < count; i++) {
+      new (&entries[i]) Entry(set[i]);
+    }
+    CopyArray(entries + count, clips, clip_count);
+    uint8_t* matrix_storage =
+        reinterpret_cast<uint8_t*>(entries + count) +
+        clip_count * sizeof(SkPoint);
+    for (int i = 0; i < matrix_count; i++) {
+      new (matrix_storage + i * sizeof(SkMatrix)) SkMatrix(matrices[i]);
+    }
+  }
+  ~DrawEdgeAAImageSetOp() {
+    Entry* entries = reinterpret_cast<Entry*>(this + 1);
+    for (int i = 0; i < count; i++) {
+      entries[i].~Entry();
+    }
+  }
+  int count;
+  int clip_count;
+  int matrix_count;
+  bool has_paint;
+  SkCanvas::SrcRectConstraint constraint;
+  const Entry* entries() const {
+    return ArrayAfter<Entry>(this, sizeof(*this));
+  }
+  const SkPoint* clips() const {
+    return ArrayAfter<SkPoint>(this, sizeof(*this), count * sizeof(Entry));
+  }
+  const SkMatrix* matrices() const {
+    return ArrayAfter<SkMatrix>(
+        this, sizeof(*this),
+        count * sizeof(Entry) + clip_count * sizeof(SkPoint));
+  }
+  void Dispatch(SkCanvas* canvas, DispatchState& state) const {
+    canvas->experimental_DrawEdgeAAImageSet(
+        entries(), count, clip_count > 0 ? clips() : nullptr,
+        matrix_count > 0 ? matrices() : nullptr,
+        OptionalPaint(has_paint, state), constraint);
+  }
+  bool Equals(const DrawEdgeAAImageSetOp& other) const {
+    if (count != other.count || clip_count != other.clip_count ||
+        matrix_count != other.matrix_count || has_paint != other.has_paint ||
+        constraint != other.constraint ||
+        !SameArray(clips(), other.clips(), clip_count)) {
+      return false;
+    }
+    for (int i = 0; i < count; i++) {
+      const Entry& a = entries()[i];
+      const Entry& b = other.entries()[i];
+      if (a.fImage != b.fImage || a.fSrcRect != b.fSrcRect ||
+          a.fDstRect != b.fDstRect || a.fMatrixIndex != b.fMatrixIndex ||
+          a.fAlpha != b.fAlpha || a.fAAFlags != b.fAAFlags ||
+          a.fHasClip != b.fHasClip) {
+        return false;
+      }
+    }
+    for (int i = 0; i < matrix_count; i++) {
+      if (matrices()[i] != other.matrices()[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  void Hash(size_t& seed) const {
+    fml::HashCombineSeed(seed, count, clip_count, matrix_count, has_paint,
+                         constraint);
+    for (int i = 0; i < count; i++) {
+      const Entry& entry = entries()[i];
+      HashValue(seed, entry.fSrcRect);
+      HashValue(seed, entry.fDstRect);
+      fml::HashCombineSeed(seed, entry.fImage->uniqueID(), entry.fMatrixIndex,
+                           entry.fAlpha, entry.fAAFlags, entry.fHasClip);
+    }
+    HashArray(seed, clips(), clip_count);
+    for (int i = 0; i < matrix_count; i++) {
+      fml::HashCombineSeed(seed, DiffContext::HashMatrix(matrices()[i]));
+    }
+  }
+};
+
+#define DISPLAY_LIST_OP_SIZE_CHECK(name)          \
+  static_assert(alignof(name##Op) == alignof(Op), \
+                #name "Op must be aligned like Op.");
+FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_SIZE_CHECK)
+#undef DISPLAY_LIST_OP_SIZE_CHECK
+
+std::atomic<uint32_t> next_unique_id(1);
+
+}  // namespace
+
+DisplayList::DisplayList(uint8_t* storage,
+                         size_t used,
+                         size_t op_count,
+                         const SkRect& bounds,
+                         bool can_apply_opacity,
+                         const SkRect& opaque_bounds)
+    : storage_(storage),
+      used_(used),
+      op_count_(op_count),
+      bounds_(bounds),
+      can_apply_opacity_(can_apply_opacity),
+      opaque_bounds_(opaque_bounds),
+      unique_id_(next_unique_id++),
+      fingerprint_(ComputeFingerprint()) {}
+
+DisplayList::~DisplayList() {
+  uint8_t* ptr = storage_;
+  uint8_t* end = storage_ + used_;
+  while (ptr < end) {
+    Op* op = reinterpret_cast<Op*>(ptr);
+    ptr += op->size;
+    switch (op->type) {
+#define DISPLAY_LIST_OP_DESTROY(name)        \
+  case OpType::k##name:                      \
+    static_cast<name##Op*>(op)->~name##Op(); \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_DESTROY)
+#undef DISPLAY_LIST_OP_DESTROY
+    }
+  }
+  free(storage_);
+}
+
+void DisplayList::RenderTo(SkCanvas* canvas, SkScalar opacity) const {
+  FML_DCHECK(opacity >= SK_Scalar1 || can_apply_opacity_);
+  const int save_count = canvas->getSaveCount();
+  DispatchState state;
+  state.initial_matrix = canvas->getTotalMatrix();
+  if (opacity < SK_Scalar1) {
+    state.opacity = opacity;
+    state.paint.setAlphaf(opacity);
+    state.opacity_paint.setAlphaf(opacity);
+  }
+  const uint8_t* ptr = storage_;
+  const uint8_t* end = storage_ + used_;
+  while (ptr < end) {
+    const Op* op = reinterpret_cast<const Op*>(ptr);
+    ptr += op->size;
+    switch (op->type) {
+#define DISPLAY_LIST_OP_DISPATCH(name)                         \
+  case OpType::k##name:                                        \
+    static_cast<const name##Op*>(op)->Dispatch(canvas, state); \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_DISPATCH)
+#undef DISPLAY_LIST_OP_DISPATCH
+    }
+  }
+  // Like pictures, display lists leave the canvas as they found it even if
+  // their saves and restores are unbalanced.
+  canvas->restoreToCount(save_count);
+}
+
+uint64_t DisplayList::ComputeFingerprint() const {
+  size_t seed = fml::HashCombine(used_, op_count_);
+  HashValue(seed, bounds_);
+  const uint8_t* ptr = storage_;
+  const uint8_t* end = storage_ + used_;
+  while (ptr < end) {
+    const Op* op = reinterpret_cast<const Op*>(ptr);
+    ptr += op->size;
+    fml::HashCombineSeed(seed, op->type);
+    switch (op->type) {
+#define DISPLAY_LIST_OP_HASH(name)                \
+  case OpType::k##name:                           \
+    static_cast<const name##Op*>(op)->Hash(seed); \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_HASH)
+#undef DISPLAY_LIST_OP_HASH
+    }
+  }
+  return seed;
+}
+
+bool DisplayList::Equals(const DisplayList& other) const {
+  if (this == &other) {
+    return true;
+  }
+  if (used_ != other.used_ || op_count_ != other.op_count_ ||
+      bounds_ != other.bounds_) {
+    return false;
+  }
+  const uint8_t* ptr = storage_;
+  const uint8_t* other_ptr = other.storage_;
+  const uint8_t* end = storage_ + used_;
+  while (ptr < end) {
+    const Op* op = reinterpret_cast<const Op*>(ptr);
+    const Op* other_op = reinterpret_cast<const Op*>(other_ptr);
+    if (op->type != other_op->type || op->size != other_op->size) {
+      return false;
+    }
+    ptr += op->size;
+    other_ptr += other_op->size;
+    switch (op->type) {
+#define DISPLAY_LIST_OP_EQUALS(name)                    \
+  case OpType::k##name:                                 \
+    if (!static_cast<const name##Op*>(op)->Equals(      \
+            *static_cast<const name##Op*>(other_op))) { \
+      return false;                                     \
+    }                                                   \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_EQUALS)
+#undef DISPLAY_LIST_OP_EQUALS
+    }
+  }
+  return true;
+}
+
+DisplayListCanvasRecorder::DisplayListCanvasRecorder(const SkRect& bounds)
+    : SkCanvasVirtualEnforcer<SkNoDrawCanvas>(bounds.roundOut()),
+      bounds_(bounds) {}
+
+DisplayListCanvasRecorder::~DisplayListCanvasRecorder() {
+  // Destroys the operations of an unfinished recording.
+  if (storage_) {
+    sk_sp<DisplayList> unused = Build();
+  }
+}
+
+sk_sp<DisplayList> DisplayListCanvasRecorder::Build() {
+  if (used_ < allocated_) {
+    // Recordings are kept around for a while, so the slack is returned.
+    storage_ =
+        static_cast<uint8_t*>(realloc(storage_, std::max<size_t>(used_, 1)));
+  }
+  sk_sp<DisplayList> display_list(
+      new DisplayList(storage_, used_, op_count_, bounds_, can_apply_opacity_,
+                      opaque_bounds_));
+  storage_ = nullptr;
+  used_ = 0;
+  allocated_ = 0;
+  op_count_ = 0;
+  current_paint_ = SkPaint();
+  can_apply_opacity_ = true;
+  drawn_bounds_ = SkRect::MakeEmpty();
+  opaque_bounds_ = SkRect::MakeEmpty();
+  clip_save_count_ = 0;
+  layer_save_count_ = 0;
+  last_draw_atlas_offset_ = 0;
+  return display_list;
+}
+
+template <typename T, typename... Args>
+T* DisplayListCanvasRecorder::Push(size_t extra, Args&&... args) {
+  const size_t size = SkAlign8(sizeof(T) + extra);
+  if (used_ + size > allocated_) {
+    // The operations only hold Skia objects and plain data, which may be
+    // moved with the buffer.
+    allocated_ = std::max(used_ + size, std::max<size_t>(allocated_ * 2, 512));
+    storage_ = static_cast<uint8_t*>(realloc(storage_, allocated_));
+    FML_CHECK(storage_);
+  }
+  T* op = new (storage_ + used_) T(std::forward<Args>(args)...);
+  op->type = T::kType;
+  op->size = size;
+  last_draw_atlas_offset_ =
+      T::kType == OpType::kDrawAtlas ? used_ : used_ + size;
+  used_ += size;
+  if (T::kType != OpType::kSetPaint) {
+    op_count_++;
+  }
+  return op;
+}
+
+void DisplayListCanvasRecorder::SetPaint(const SkPaint& paint) {
+  if (paint != current_paint_) {
+    current_paint_ = paint;
+    Push<SetPaintOp>(0, paint);
+    // The operations drawn with the paint may erase what is below.
+    if (!BlendModeKeepsDstOpaque(paint.getBlendMode())) {
+      opaque_bounds_.setEmpty();
+    }
+  }
+}
+
+void DisplayListCanvasRecorder::AccumulateOpBounds(const SkRect& bounds,
+                                                   const SkPaint* paint) {
+  if (paint && !paint->canComputeFastBounds()) {
+    AccumulateUnboundedOp(paint);
+    return;
+  }
+  SkRect storage;
+  AccumulateDrawnBounds(
+      getTotalMatrix().mapRect(
+          paint ? paint->computeFastBounds(bounds, &storage) : bounds),
+      paint);
+}
+
+void DisplayListCanvasRecorder::AccumulateUnboundedOp(const SkPaint* paint) {
+  AccumulateDrawnBounds(bounds_, paint);
+}
+
+void DisplayListCanvasRecorder::AccumulateDrawnBounds(const SkRect& bounds,
+                                                      const SkPaint* paint) {
+  if (!can_apply_opacity_) {
+    return;
+  }
+  if ((paint && !PaintCanApplyOpacity(*paint)) ||
+      BoundsOverlap(bounds, drawn_bounds_)) {
+    can_apply_opacity_ = false;
+    return;
+  }
+  drawn_bounds_.join(bounds);
+}
+
+void DisplayListCanvasRecorder::AccumulateOpaqueOp(const SkRect& rect,
+                                                   const SkPaint& paint) {
+  const SkMatrix& matrix = getTotalMatrix();
+  if (clip_save_count_ != 0 || layer_save_count_ != 0 ||
+      !matrix.rectStaysRect() || !PaintIsOpaque(paint)) {
+    return;
+  }
+  SkRect opaque_rect = matrix.mapRect(rect);
+  if (opaque_rect.intersect(bounds_)) {
+    AccumulateOpaqueRect(&opaque_bounds_, opaque_rect);
+  }
+}
+
+bool DisplayListCanvasRecorder::SetPaint(const SkPaint* paint) {
+  if (paint) {
+    SetPaint(*paint);
+  }
+  return paint != nullptr;
+}
+
+void DisplayListCanvasRecorder::willSave() {
+  Push<SaveOp>(0);
+}
+
+SkCanvas::SaveLayerStrategy DisplayListCanvasRecorder::getSaveLayerStrategy(
+    const SaveLayerRec& rec) {
+  const bool has_paint = SetPaint(rec.fPaint);
+  Push<SaveLayerOp>(0, rec.fBounds, has_paint, rec.fBackdrop,
+                    rec.fSaveLayerFlags);
+  // The save count is only incremented after this call.
+  if (layer_save_count_ == 0) {
+    layer_save_count_ = getSaveCount() + 1;
+  }
+  // The layer could apply the opacity, but not its contents as well.
+  CannotApplyOpacity();
+  return kNoLayer_SaveLayerStrategy;
+}
+
+bool DisplayListCanvasRecorder::onDoSaveBehind(const SkRect*) {
+  // There is no public API to replay this, so the save is recorded without
+  // the layer behind it. The framework never issues it.
+  Push<SaveOp>(0);
+  return false;
+}
+
+void DisplayListCanvasRecorder::willRestore() {
+  Push<RestoreOp>(0);
+  // Only realized saves are restored here, and clips realize the saves.
+  const int save_count = getSaveCount();
+  if (save_count <= clip_save_count_) {
+    clip_save_count_ = 0;
+  }
+  if (save_count <= layer_save_count_) {
+    layer_save_count_ = 0;
+  }
+}
+
+void DisplayListCanvasRecorder::didConcat(const SkMatrix& matrix) {
+  Push<ConcatOp>(0, matrix);
+}
+
+void DisplayListCanvasRecorder::didConcat44(const SkM44& matrix) {
+  Push<Concat44Op>(0, matrix);
+}
+
+void DisplayListCanvasRecorder::didScale(SkScalar sx, SkScalar sy) {
+  Push<ScaleOp>(0, sx, sy);
+}
+
+void DisplayListCanvasRecorder::didTranslate(SkScalar dx, SkScalar dy) {
+  Push<TranslateOp>(0, dx, dy);
+}
+
+void DisplayListCanvasRecorder::didSetMatrix(const SkMatrix& matrix) {
+  Push<SetMatrixOp>(0, matrix);
+}
+
+void DisplayListCanvasRecorder::onDrawDRRect(const SkRRect& outer,
+                                             const SkRRect& inner,
+                                             const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawDRRectOp>(0, outer, inner);
+  AccumulateOpBounds(outer.getBounds(), &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawTextBlob(const SkTextBlob* blob,
+                                               SkScalar x,
+                                               SkScalar y,
+                                               const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawTextBlobOp>(0, blob, x, y);
+  AccumulateOpBounds(blob->bounds().makeOffset(x, y), &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawPatch(const SkPoint cubics[12],
+                                            const SkColor colors[4],
+                                            const SkPoint tex_coords[4],
+                                            SkBlendMode mode,
+                                            const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawPatchOp>(0, cubics, colors, tex_coords, mode);
+  // Patches may overlap themselves.
+  CannotApplyOpacity();
+}
+
+void DisplayListCanvasRecorder::onDrawPaint(const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawPaintOp>(0);
+  AccumulateUnboundedOp(&paint);
+  AccumulateOpaqueOp(bounds_, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawBehind(const SkPaint& paint) {
+  // There is no public API to replay this. The framework never issues it.
+  FML_DLOG(WARNING) << "Display lists do not record drawBehind.";
+}
+
+void DisplayListCanvasRecorder::onDrawPoints(PointMode mode,
+                                             size_t count,
+                                             const SkPoint pts[],
+                                             const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawPointsOp>(count * sizeof(SkPoint), mode, count, pts);
+  // Points and lines may overlap each other.
+  CannotApplyOpacity();
+}
+
+void DisplayListCanvasRecorder::onDrawRect(const SkRect& rect,
+                                           const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawRectOp>(0, rect);
+  AccumulateOpBounds(rect, &paint);
+  AccumulateOpaqueOp(rect, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawRegion(const SkRegion& region,
+                                             const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawRegionOp>(0, region);
+  AccumulateOpBounds(SkRect::Make(region.getBounds()), &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawOval(const SkRect& oval,
+                                           const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawOvalOp>(0, oval);
+  AccumulateOpBounds(oval, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawArc(const SkRect& oval,
+                                          SkScalar start_angle,
+                                          SkScalar sweep_angle,
+                                          bool use_center,
+                                          const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawArcOp>(0, oval, start_angle, sweep_angle, use_center);
+  AccumulateOpBounds(oval, &paint);
+}
+
+void DisplayListCanvasRecorder::onDrawRRect(const SkRRect& rrect,
+                                            const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawRRectOp>(0, rrect);
+  AccumulateOpBounds(rrect.getBounds(), &paint);
+  AccumulateOpaqueOp(GetRRectInnerRect(rrect), paint);
+}
+
+void DisplayListCanvasRecorder::onDrawPath(const SkPath& path,
+                                           const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawPathOp>(0, path);
+  if (path.isInverseFillType()) {
+    AccumulateUnboundedOp(&paint);
+  } else {
+    AccumulateOpBounds(path.getBounds(), &paint);
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawImage(const SkImage* image,
+                                            SkScalar left,
+                                            SkScalar top,
+                                            const SkPaint* paint) {
+  const bool has_paint = SetPaint(paint);
+  Push<DrawImageOp>(0, image, left, top, has_paint);
+  AccumulateOpBounds(
+      SkRect::MakeXYWH(left, top, image->width(), image->height()), paint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageRect(
+    const SkImage* image,
+    const SkRect* src,
+    const SkRect& dst,
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  const bool has_paint = SetPaint(paint);
+  Push<DrawImageRectOp>(0, image, src, dst, has_paint, constraint);
+  AccumulateOpBounds(dst, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageLattice(const SkImage* image,
+                                                   const Lattice& lattice,
+                                                   const SkRect& dst,
+                                                   const SkPaint* paint) {
+  const bool has_paint = SetPaint(paint);
+  Push<DrawImageLatticeOp>(DrawImageLatticeOp::ArraysSize(lattice), image,
+                           lattice, dst, has_paint);
+  AccumulateOpBounds(dst, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawImageNine(const SkImage* image,
+                                                const SkIRect& center,
+                                                const SkRect& dst,
+                                                const SkPaint* paint) {
+  const bool has_paint = SetPaint(paint);
+  Push<DrawImageNineOp>(0, image, center, dst, has_paint);
+  AccumulateOpBounds(dst, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawVerticesObject(const SkVertices* vertices,
+                                                     SkBlendMode mode,
+                                                     const SkPaint& paint) {
+  SetPaint(paint);
+  Push<DrawVerticesOp>(0, vertices, mode);
+  // Triangles may overlap each other.
+  CannotApplyOpacity();
+}
+
+void DisplayListCanvasRecorder::onDrawAtlas(const SkImage* atlas,
+                                            const SkRSXform xforms[],
+                                            const SkRect tex[],
+                                            const SkColor colors[],
+                                            int count,
+                                            SkBlendMode mode,
+                                            const SkRect* cull_rect,
+                                            const SkPaint* paint) {
+  const bool has_paint = SetPaint(paint);
+  if (!AppendToLastDrawAtlas(atlas, xforms, tex, colors, count, mode,
+                             cull_rect, has_paint)) {
+    Push<DrawAtlasOp>(DrawAtlasOp::ArraysSize(count, colors != nullptr), atlas,
+                      xforms, tex, colors, count, mode, cull_rect, has_paint);
+  }
+  // Sprites may overlap each other.
+  CannotApplyOpacity();
+}
+
+bool DisplayListCanvasRecorder::AppendToLastDrawAtlas(const SkImage* atlas,
+                                                      const SkRSXform xforms[],
+                                                      const SkRect tex[],
+                                                      const SkColor colors[],
+                                                      int count,
+                                                      SkBlendMode mode,
+                                                      const SkRect* cull_rect,
+                                                      bool has_paint) {
+  if (last_draw_atlas_offset_ >= used_) {
+    return false;
+  }
+  // Filters apply to each draw as a whole, not to each sprite.
+  if (has_paint && (current_paint_.getImageFilter() != nullptr ||
+                    current_paint_.getMaskFilter() != nullptr)) {
+    return false;
+  }
+  auto* op = reinterpret_cast<DrawAtlasOp*>(storage_ + last_draw_atlas_offset_);
+  const bool has_colors = colors != nullptr;
+  if (op->atlas.get() != atlas || op->mode != mode ||
+      op->has_colors != has_colors || op->has_paint != has_paint ||
+      op->has_cull_rect != (cull_rect != nullptr)) {
+    return false;
+  }
+  // An empty cull rect skips its sprites, which its union with another would
+  // not.
+  if (cull_rect && (cull_rect->isEmpty() || op->cull_rect.isEmpty())) {
+    return false;
+  }
+
+  const int old_count = op->count;
+  const int new_count = old_count + count;
+  const size_t size = SkAlign8(
+      sizeof(DrawAtlasOp) + DrawAtlasOp::ArraysSize(new_count, has_colors));
+  if (last_draw_atlas_offset_ + size > allocated_) {
+    allocated_ = std::max(last_draw_atlas_offset_ + size, allocated_ * 2);
+    storage_ = static_cast<uint8_t*>(realloc(storage_, allocated_));
+    FML_CHECK(storage_);
+    op = reinterpret_cast<DrawAtlasOp*>(storage_ + last_draw_atlas_offset_);
+  }
+
+  // The arrays are laid out one after the other, so the later ones are moved
+  // to make room, starting with the last one.
+  uint8_t* arrays = reinterpret_cast<uint8_t*>(op + 1);
+  const size_t xforms_size = sizeof(SkRSXform);
+  const size_t tex_size = sizeof(SkRect);
+  if (has_colors) {
+    uint8_t* old_colors = arrays + old_count * (xforms_size + tex_size);
+    uint8_t* new_colors = arrays + new_count * (xforms_size + tex_size);
+    memmove(new_colors, old_colors, old_count * sizeof(SkColor));
+    CopyArray(new_colors + old_count * sizeof(SkColor), colors, count);
+  }
+  uint8_t* old_tex = arrays + old_count * xforms_size;
+  uint8_t* new_tex = arrays + new_count * xforms_size;
+  memmove(new_tex, old_tex, old_count * tex_size);
+  CopyArray(new_tex + old_count * tex_size, tex, count);
+  CopyArray(arrays + old_count * xforms_size, xforms, count);
+
+  op->count = new_count;
+  if (cull_rect) {
+    op->cull_rect.join(*cull_rect);
+  }
+  op->size = size;
+  used_ = last_draw_atlas_offset_ + size;
+  return true;
+}
+
+void DisplayListCanvasRecorder::onDrawShadowRec(const SkPath& path,
+                                                const SkDrawShadowRec& rec) {
+  Push<DrawShadowRecOp>(0, path, rec);
+  // Shadows have no paint to apply the opacity to.
+  CannotApplyOpacity();
+}
+
+void DisplayListCanvasRecorder::onClipRect(const SkRect& rect,
+                                           SkClipOp op,
+                                           ClipEdgeStyle style) {
+  Push<ClipRectOp>(0, rect, op, style == kSoft_ClipEdgeStyle);
+  AccumulateClip();
+  SkNoDrawCanvas::onClipRect(rect, op, style);
+}
+
+void DisplayListCanvasRecorder::onClipRRect(const SkRRect& rrect,
+                                            SkClipOp op,
+                                            ClipEdgeStyle style) {
+  Push<ClipRRectOp>(0, rrect, op, style == kSoft_ClipEdgeStyle);
+  AccumulateClip();
+  SkNoDrawCanvas::onClipRRect(rrect, op, style);
+}
+
+void DisplayListCanvasRecorder::onClipPath(const SkPath& path,
+                                           SkClipOp op,
+                                           ClipEdgeStyle style) {
+  Push<ClipPathOp>(0, path, op, style == kSoft_ClipEdgeStyle);
+  AccumulateClip();
+  SkNoDrawCanvas::onClipPath(path, op, style);
+}
+
+void DisplayListCanvasRecorder::onClipRegion(const SkRegion& region,
+                                             SkClipOp op) {
+  Push<ClipRegionOp>(0, region, op);
+  AccumulateClip();
+  SkNoDrawCanvas::onClipRegion(region, op);
+}
+
+void DisplayListCanvasRecorder::onDrawPicture(const SkPicture* picture,
+                                              const SkMatrix* matrix,
+                                              const SkPaint* paint) {
+  const bool has_paint = SetPaint(paint);
+  Push<DrawPictureOp>(0, picture, matrix, has_paint);
+  // What the picture draws is not known.
+  opaque_bounds_.setEmpty();
+  // Without a paint of its own the picture is drawn with the opacity paint,
+  // which groups its operations into a layer, so they may overlap.
+  SkRect picture_bounds = picture->cullRect();
+  if (matrix) {
+    picture_bounds = matrix->mapRect(picture_bounds);
+  }
+  AccumulateOpBounds(picture_bounds, paint);
+}
+
+void DisplayListCanvasRecorder::onDrawDrawable(SkDrawable* drawable,
+                                               const SkMatrix* matrix) {
+  Push<DrawDrawableOp>(0, drawable, matrix);
+  opaque_bounds_.setEmpty();
+  CannotApplyOpacity();
+}
+
+void DisplayListCanvasRecorder::onDrawAnnotation(const SkRect& rect,
+                                                 const char key[],
+                                                 SkData* value) {
+  Push<DrawAnnotationOp>(strlen(key) + 1, rect, key, value);
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAQuad(const SkRect& rect,
+                                                 const SkPoint clip[4],
+                                                 SkCanvas::QuadAAFlags flags,
+                                                 const SkColor4f& color,
+                                                 SkBlendMode mode) {
+  Push<DrawEdgeAAQuadOp>(0, rect, clip, flags, color, mode);
+  if (!BlendModeKeepsDstOpaque(mode)) {
+    opaque_bounds_.setEmpty();
+  }
+  if (mode == SkBlendMode::kSrcOver) {
+    AccumulateOpBounds(rect, nullptr);
+  } else {
+    CannotApplyOpacity();
+  }
+}
+
+void DisplayListCanvasRecorder::onDrawEdgeAAImageSet(
+    const ImageSetEntry set[],
+    int count,
+    const SkPoint dst_clips[],
+    const SkMatrix pre_view_matrices[],
+    const SkPaint* paint,
+    SrcRectConstraint constraint) {
+  const bool has_paint = SetPaint(paint);
+  Push<DrawEdgeAAImageSetOp>(DrawEdgeAAImageSetOp::ArraysSize(set, count), set,
+                             count, dst_clips, pre_view_matrices, has_paint,
+                             constraint);
+  // The images may overlap each other.
+  CannotApplyOpacity();
+}
+
+void DisplayListCanvasRecorder::onFlush() {}
+
+}  // namespace flutter
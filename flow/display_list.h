@@ -0,0 +1,367 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkCanvasVirtualEnforcer.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An immutable recording of canvas operations that is owned by
+///             the engine, unlike an `SkPicture`.
+///
+///             The operations are stored one after the other in a single flat
+///             buffer. The paint is only stored when it changes between
+///             operations, so runs of operations drawn with the same paint
+///             are compact. Display lists are dispatched to an `SkCanvas` when
+///             painted and can be inspected and compared cheaply.
+///
+///             Display lists are recorded with a |DisplayListCanvasRecorder|.
+///
+class DisplayList : public SkRefCnt {
+ public:
+  ~DisplayList() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replays the operations onto the canvas, like
+  ///             `SkPicture::playback`.
+  ///
+  ///
+  /// @param[in]  opacity  An opacity applied to every operation, which must be
+  ///                      1 unless |can_apply_opacity| is true.
+  ///
+  void RenderTo(SkCanvas* canvas, SkScalar opacity = SK_Scalar1) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the display lists record the same operations with the
+  ///             same arguments. Images, text blobs, vertices and other
+  ///             immutable Skia objects are compared by identity, paths and
+  ///             paints by value.
+  ///
+  bool Equals(const DisplayList& other) const;
+
+  const SkRect& bounds() const { return bounds_; }
+
+  // The number of drawing, clipping, transform and save operations. Paint
+  // changes are not counted.
+  size_t op_count() const { return op_count_; }
+
+  // The size of the operation buffer in bytes.
+  size_t bytes() const { return used_; }
+
+  uint32_t unique_id() const { return unique_id_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      A hash of the recorded operations, computed when the
+  ///             recording finishes. Display lists recorded with the same
+  ///             content share a fingerprint even though their unique IDs
+  ///             differ, which lets the raster cache and the frame damage
+  ///             recognize content that is re-recorded every frame.
+  ///
+  ///             Images, text blobs, vertices and pictures contribute their
+  ///             unique IDs. Display lists that draw drawables never share
+  ///             a fingerprint.
+  ///
+  uint64_t fingerprint() const { return fingerprint_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether rendering with an opacity gives the same result as
+  ///             rendering into a layer composited with that opacity. This is
+  ///             the case when no two operations overlap and every operation
+  ///             can apply the opacity to its own paint, so that a parent can
+  ///             skip the layer.
+  ///
+  bool can_apply_opacity() const { return can_apply_opacity_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      A rect, in the coordinates of the recording, that the display
+  ///             list paints fully opaque, or an empty rect if it is not
+  ///             known to paint anything opaque. It is computed from opaque
+  ///             rects, rounded rects and paints drawn outside of clips and
+  ///             layers, so it may be smaller than what is actually painted.
+  ///             Layers use it to skip the content hidden below.
+  ///
+  const SkRect& opaque_bounds() const { return opaque_bounds_; }
+
+ private:
+  friend class DisplayListCanvasRecorder;
+
+  uint8_t* storage_;
+  size_t used_;
+  size_t op_count_;
+  SkRect bounds_;
+  bool can_apply_opacity_;
+  SkRect opaque_bounds_;
+  uint32_t unique_id_;
+  uint64_t fingerprint_;
+
+  DisplayList(uint8_t* storage,
+              size_t used,
+              size_t op_count,
+              const SkRect& bounds,
+              bool can_apply_opacity,
+              const SkRect& opaque_bounds);
+
+  uint64_t ComputeFingerprint() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayList);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A canvas that records the operations drawn into it into a
+///             |DisplayList|. Every `SkCanvas` operation is recorded, so it
+///             can be handed to code that draws into an `SkCanvas`, like the
+///             text layout.
+///
+class DisplayListCanvasRecorder
+    : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
+ public:
+  explicit DisplayListCanvasRecorder(const SkRect& bounds);
+
+  ~DisplayListCanvasRecorder() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finishes the recording. Must only be called once.
+  ///
+  sk_sp<DisplayList> Build();
+
+ private:
+  SkRect bounds_;
+  uint8_t* storage_ = nullptr;
+  size_t used_ = 0;
+  size_t allocated_ = 0;
+  size_t op_count_ = 0;
+  // The paint of the last SetPaint operation.
+  SkPaint current_paint_;
+  // Whether the operations so far could apply an opacity, and the union of
+  // the bounds they draw within. See |DisplayList::can_apply_opacity|.
+  bool can_apply_opacity_ = true;
+  SkRect drawn_bounds_ = SkRect::MakeEmpty();
+  // The opaque rect painted so far. See |DisplayList::opaque_bounds|.
+  SkRect opaque_bounds_ = SkRect::MakeEmpty();
+  // The save counts at which the outermost clip and layer were made, or 0.
+  // Nothing drawn while either is active counts as opaque.
+  int clip_save_count_ = 0;
+  int layer_save_count_ = 0;
+  // The offset of the last operation if it draws an atlas, or |used_|.
+  size_t last_draw_atlas_offset_ = 0;
+
+  // Appends an operation of type |T| followed by |extra| bytes for its
+  // arrays.
+  template <typename T, typename... Args>
+  T* Push(size_t extra, Args&&... args);
+
+  // Appends the sprites to the last operation if it draws the same atlas in
+  // the same way, so that they are drawn in a single batch. Returns false if
+  // they cannot be appended.
+  bool AppendToLastDrawAtlas(const SkImage* atlas,
+                             const SkRSXform xforms[],
+                             const SkRect tex[],
+                             const SkColor colors[],
+                             int count,
+                             SkBlendMode mode,
+                             const SkRect* cull_rect,
+                             bool has_paint);
+
+  // Records a paint change if |paint| differs from the current paint.
+  void SetPaint(const SkPaint& paint);
+
+  // Records a paint change if the optional paint is given and returns if it
+  // was given.
+  bool SetPaint(const SkPaint* paint);
+
+  // Updates |can_apply_opacity_| for an operation drawing within |bounds|, in
+  // the current local coordinates, with the optional |paint|.
+  void AccumulateOpBounds(const SkRect& bounds, const SkPaint* paint);
+
+  // Same for an operation that may draw anywhere, like drawPaint.
+  void AccumulateUnboundedOp(const SkPaint* paint);
+
+  void AccumulateDrawnBounds(const SkRect& bounds, const SkPaint* paint);
+
+  void CannotApplyOpacity() { can_apply_opacity_ = false; }
+
+  // Records that a clip is made at the current save count.
+  void AccumulateClip() {
+    if (clip_save_count_ == 0) {
+      clip_save_count_ = getSaveCount();
+    }
+  }
+
+  // Updates |opaque_bounds_| for an operation filling |rect|, in the current
+  // local coordinates, with |paint|.
+  void AccumulateOpaqueOp(const SkRect& rect, const SkPaint& paint);
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void willSave() override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  bool onDoSaveBehind(const SkRect*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void willRestore() override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didConcat(const SkMatrix&) override;
+  void didConcat44(const SkM44&) override;
+  void didScale(SkScalar, SkScalar) override;
+  void didTranslate(SkScalar, SkScalar) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didSetMatrix(const SkMatrix&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawTextBlob(const SkTextBlob* blob,
+                      SkScalar x,
+                      SkScalar y,
+                      const SkPaint& paint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPatch(const SkPoint cubics[12],
+                   const SkColor colors[4],
+                   const SkPoint texCoords[4],
+                   SkBlendMode,
+                   const SkPaint& paint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPaint(const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawBehind(const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPoints(PointMode,
+                    size_t count,
+                    const SkPoint pts[],
+                    const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRect(const SkRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRegion(const SkRegion&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawOval(const SkRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawArc(const SkRect&,
+                 SkScalar,
+                 SkScalar,
+                 bool,
+                 const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRRect(const SkRRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPath(const SkPath&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImage(const SkImage*,
+                   SkScalar left,
+                   SkScalar top,
+                   const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageRect(const SkImage*,
+                       const SkRect* src,
+                       const SkRect& dst,
+                       const SkPaint*,
+                       SrcRectConstraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageLattice(const SkImage*,
+                          const Lattice&,
+                          const SkRect&,
+                          const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageNine(const SkImage*,
+                       const SkIRect& center,
+                       const SkRect& dst,
+                       const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawVerticesObject(const SkVertices*,
+                            SkBlendMode,
+                            const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawAtlas(const SkImage*,
+                   const SkRSXform[],
+                   const SkRect[],
+                   const SkColor[],
+                   int,
+                   SkBlendMode,
+                   const SkRect*,
+                   const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRect(const SkRect&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRRect(const SkRRect&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipPath(const SkPath&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRegion(const SkRegion&, SkClipOp) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPicture(const SkPicture*,
+                     const SkMatrix*,
+                     const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawDrawable(SkDrawable*, const SkMatrix*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawAnnotation(const SkRect&, const char[], SkData*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawEdgeAAQuad(const SkRect&,
+                        const SkPoint[4],
+                        SkCanvas::QuadAAFlags,
+                        const SkColor4f&,
+                        SkBlendMode) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawEdgeAAImageSet(const ImageSetEntry[],
+                            int count,
+                            const SkPoint[],
+                            const SkMatrix[],
+                            const SkPaint*,
+                            SrcRectConstraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onFlush() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListCanvasRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_H_
@@ -0,0 +1,262 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include "flutter/testing/mock_canvas.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkDrawable.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<DisplayList> RecordRectAndPath(SkColor color) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setColor(color);
+  recorder.translate(5, 5);
+  recorder.drawRect(SkRect::MakeWH(10, 10), paint);
+  recorder.drawPath(SkPath().addOval(SkRect::MakeWH(20, 20)), paint);
+  return recorder.Build();
+}
+
+TEST(DisplayList, RecordsOperations) {
+  sk_sp<DisplayList> display_list = RecordRectAndPath(SK_ColorRED);
+
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeWH(100, 100));
+  // The paint change is not counted as an operation.
+  EXPECT_EQ(display_list->op_count(), 3u);
+  EXPECT_GT(display_list->bytes(), 0u);
+}
+
+TEST(DisplayList, RendersOperations) {
+  sk_sp<DisplayList> display_list = RecordRectAndPath(SK_ColorRED);
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+
+  MockCanvas canvas;
+  display_list->RenderTo(&canvas);
+
+  EXPECT_EQ(
+      canvas.draw_calls(),
+      std::vector({MockCanvas::DrawCall{
+                       0, MockCanvas::ConcatMatrixData{SkMatrix::Translate(
+                              5, 5)}},
+                   MockCanvas::DrawCall{0, MockCanvas::DrawRectData{
+                                               SkRect::MakeWH(10, 10), paint}},
+                   MockCanvas::DrawCall{
+                       0, MockCanvas::DrawPathData{
+                              SkPath().addOval(SkRect::MakeWH(20, 20)),
+                              paint}}}));
+}
+
+TEST(DisplayList, RestoresUnbalancedSaves) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.save();
+  recorder.save();
+  sk_sp<DisplayList> display_list = recorder.Build();
+
+  MockCanvas canvas;
+  display_list->RenderTo(&canvas);
+  EXPECT_EQ(canvas.getSaveCount(), 1);
+}
+
+TEST(DisplayList, EqualsComparesOperations) {
+  sk_sp<DisplayList> red = RecordRectAndPath(SK_ColorRED);
+  sk_sp<DisplayList> red_again = RecordRectAndPath(SK_ColorRED);
+  sk_sp<DisplayList> blue = RecordRectAndPath(SK_ColorBLUE);
+
+  EXPECT_NE(red->unique_id(), red_again->unique_id());
+  EXPECT_TRUE(red->Equals(*red_again));
+  EXPECT_FALSE(red->Equals(*blue));
+}
+
+TEST(DisplayList, FingerprintIdentifiesContent) {
+  sk_sp<DisplayList> red = RecordRectAndPath(SK_ColorRED);
+  sk_sp<DisplayList> red_again = RecordRectAndPath(SK_ColorRED);
+  sk_sp<DisplayList> blue = RecordRectAndPath(SK_ColorBLUE);
+
+  EXPECT_EQ(red->fingerprint(), red_again->fingerprint());
+  EXPECT_NE(red->fingerprint(), blue->fingerprint());
+}
+
+namespace {
+class TestDrawable : public SkDrawable {
+ protected:
+  SkRect onGetBounds() override { return SkRect::MakeWH(10, 10); }
+  void onDraw(SkCanvas* canvas) override {}
+};
+}  // namespace
+
+TEST(DisplayList, FingerprintsOfDrawablesNeverMatch) {
+  auto drawable = sk_make_sp<TestDrawable>();
+  DisplayListCanvasRecorder first(SkRect::MakeWH(100, 100));
+  first.drawDrawable(drawable.get());
+  DisplayListCanvasRecorder second(SkRect::MakeWH(100, 100));
+  second.drawDrawable(drawable.get());
+
+  EXPECT_NE(first.Build()->fingerprint(), second.Build()->fingerprint());
+}
+
+TEST(DisplayList, RecordsPaintChangesOnly) {
+  DisplayListCanvasRecorder same_paint(SkRect::MakeWH(100, 100));
+  DisplayListCanvasRecorder other_paint(SkRect::MakeWH(100, 100));
+  SkPaint red;
+  red.setColor(SK_ColorRED);
+  SkPaint blue;
+  blue.setColor(SK_ColorBLUE);
+  for (int i = 0; i < 10; i++) {
+    same_paint.drawRect(SkRect::MakeWH(i, i), red);
+    other_paint.drawRect(SkRect::MakeWH(i, i), i % 2 ? red : blue);
+  }
+
+  sk_sp<DisplayList> same = same_paint.Build();
+  sk_sp<DisplayList> other = other_paint.Build();
+  EXPECT_EQ(same->op_count(), other->op_count());
+  EXPECT_LT(same->bytes(), other->bytes());
+}
+
+TEST(DisplayList, CanApplyOpacityToDisjointOperations) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), SkPaint());
+  recorder.drawOval(SkRect::MakeLTRB(20, 0, 30, 10), SkPaint());
+  recorder.translate(0, 20);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), SkPaint());
+
+  EXPECT_TRUE(recorder.Build()->can_apply_opacity());
+}
+
+TEST(DisplayList, CannotApplyOpacityToOverlappingOperations) {
+  DisplayListCanvasRecorder overlapping(SkRect::MakeWH(100, 100));
+  overlapping.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), SkPaint());
+  overlapping.drawRect(SkRect::MakeLTRB(5, 5, 15, 15), SkPaint());
+  EXPECT_FALSE(overlapping.Build()->can_apply_opacity());
+
+  // Edges that only touch share antialiased pixels.
+  DisplayListCanvasRecorder touching(SkRect::MakeWH(100, 100));
+  touching.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), SkPaint());
+  touching.drawRect(SkRect::MakeLTRB(10, 0, 20, 10), SkPaint());
+  EXPECT_FALSE(touching.Build()->can_apply_opacity());
+
+  // The recorder is reset by |Build|.
+  touching.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), SkPaint());
+  EXPECT_TRUE(touching.Build()->can_apply_opacity());
+}
+
+TEST(DisplayList, CannotApplyOpacityThroughBlendModes) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setBlendMode(SkBlendMode::kSrc);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), paint);
+
+  EXPECT_FALSE(recorder.Build()->can_apply_opacity());
+}
+
+TEST(DisplayList, OpaqueBoundsJoinOpaqueRects) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 50, 10), SkPaint());
+  recorder.translate(0, 10);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 50, 20), SkPaint());
+  SkPaint translucent;
+  translucent.setAlpha(0x80);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 100, 100), translucent);
+
+  EXPECT_EQ(recorder.Build()->opaque_bounds(),
+            SkRect::MakeLTRB(0, 0, 50, 30));
+}
+
+TEST(DisplayList, OpaqueBoundsIgnoreClippedAndLayeredOperations) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.save();
+  recorder.clipRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  recorder.drawPaint(SkPaint());
+  recorder.restore();
+  recorder.saveLayerAlpha(nullptr, 0x80);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 50, 50), SkPaint());
+  recorder.restore();
+  EXPECT_TRUE(recorder.Build()->opaque_bounds().isEmpty());
+
+  // The clip and the layer no longer apply once they are restored.
+  recorder.save();
+  recorder.clipRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  recorder.restore();
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 50, 50), SkPaint());
+  EXPECT_EQ(recorder.Build()->opaque_bounds(),
+            SkRect::MakeLTRB(0, 0, 50, 50));
+}
+
+TEST(DisplayList, OpaqueBoundsAreErasedByBlendModes) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 50, 50), SkPaint());
+  SkPaint clear;
+  clear.setBlendMode(SkBlendMode::kClear);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), clear);
+
+  EXPECT_TRUE(recorder.Build()->opaque_bounds().isEmpty());
+}
+
+TEST(DisplayList, BatchesConsecutiveDrawAtlasCalls) {
+  sk_sp<SkImage> atlas =
+      SkSurface::MakeRasterN32Premul(20, 10)->makeImageSnapshot();
+  const SkRSXform xforms[] = {SkRSXform::Make(1, 0, 0, 0),
+                              SkRSXform::Make(1, 0, 30, 0)};
+  const SkRect tex[] = {SkRect::MakeWH(10, 10),
+                        SkRect::MakeXYWH(10, 0, 10, 10)};
+  const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+
+  DisplayListCanvasRecorder single(SkRect::MakeWH(100, 100));
+  single.drawAtlas(atlas.get(), xforms, tex, colors, 2, SkBlendMode::kModulate,
+                   nullptr, nullptr);
+  DisplayListCanvasRecorder batched(SkRect::MakeWH(100, 100));
+  batched.drawAtlas(atlas.get(), xforms, tex, colors, 1,
+                    SkBlendMode::kModulate, nullptr, nullptr);
+  batched.drawAtlas(atlas.get(), xforms + 1, tex + 1, colors + 1, 1,
+                    SkBlendMode::kModulate, nullptr, nullptr);
+  sk_sp<DisplayList> single_list = single.Build();
+  sk_sp<DisplayList> batched_list = batched.Build();
+  EXPECT_EQ(batched_list->op_count(), 1u);
+  EXPECT_TRUE(batched_list->Equals(*single_list));
+
+  // Calls separated by other operations are not batched.
+  DisplayListCanvasRecorder separated(SkRect::MakeWH(100, 100));
+  separated.drawAtlas(atlas.get(), xforms, tex, colors, 1,
+                      SkBlendMode::kModulate, nullptr, nullptr);
+  separated.translate(0, 20);
+  separated.drawAtlas(atlas.get(), xforms + 1, tex + 1, colors + 1, 1,
+                      SkBlendMode::kModulate, nullptr, nullptr);
+  EXPECT_EQ(separated.Build()->op_count(), 3u);
+}
+
+TEST(DisplayList, RendersWithOpacity) {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), paint);
+  recorder.drawRect(SkRect::MakeLTRB(20, 0, 30, 10), SkPaint());
+  sk_sp<DisplayList> display_list = recorder.Build();
+  ASSERT_TRUE(display_list->can_apply_opacity());
+
+  MockCanvas canvas;
+  display_list->RenderTo(&canvas, 0.5f);
+
+  SkPaint expected_red = paint;
+  expected_red.setAlphaf(0.5f);
+  SkPaint expected_black;
+  expected_black.setAlphaf(0.5f);
+  EXPECT_EQ(canvas.draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                             0, MockCanvas::DrawRectData{
+                                    SkRect::MakeLTRB(0, 0, 10, 10),
+                                    expected_red}},
+                         MockCanvas::DrawCall{
+                             0, MockCanvas::DrawRectData{
+                                    SkRect::MakeLTRB(20, 0, 30, 10),
+                                    expected_black}}}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/embedded_views.h"
 
+#include "flutter/flow/composition_timeline.h"
+
 namespace flutter {
 
 void ExternalViewEmbedder::SubmitFrame(GrDirectContext* context,
@@ -64,4 +66,9 @@ bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+fml::RefPtr<CompositionTimeline>
+ExternalViewEmbedder::GetCompositionTimeline() {
+  return nullptr;
+}
+
 }  // namespace flutter
@@ -157,6 +157,8 @@ class MutatorsStack {
 
   bool is_empty() const { return vector_.empty(); }
 
+  size_t size() const { return vector_.size(); }
+
   bool operator==(const MutatorsStack& other) const {
     if (vector_.size() != other.vector_.size()) {
       return false;
@@ -242,6 +244,8 @@ class EmbeddedViewParams {
   SkRect final_bounding_rect_;
 };
 
+class CompositionTimeline;
+
 enum class PostPrerollResult {
   // Frame has successfully rasterized.
   kSuccess,
@@ -334,6 +338,12 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Embedders that apply the geometry of their platform views on the platform
+  // thread through a |CompositionTimeline| return it here. The rasterizer then
+  // keeps rasterizing on its own thread instead of merging it with the
+  // platform thread, even if |SupportsDynamicThreadMerging| returns true.
+  virtual fml::RefPtr<CompositionTimeline> GetCompositionTimeline();
+
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalViewEmbedder);
 
 };  // ExternalViewEmbedder
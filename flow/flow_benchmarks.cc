@@ -0,0 +1,398 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/embedded_views.h"
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_path_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/image_filter_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/shader_mask_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/rtree.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/thread.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkShader.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+namespace flutter {
+
+namespace {
+
+const SkISize kFrameSize = SkISize::Make(800, 600);
+
+// The size of the pictures of the benchmark layer trees.
+const SkScalar kPictureSize = 32;
+
+enum class LayerType {
+  kBackdropFilter,
+  kClipPath,
+  kClipRect,
+  kClipRRect,
+  kColorFilter,
+  kImageFilter,
+  kOpacity,
+  kPhysicalShape,
+  kPicture,
+  kShaderMask,
+  kTransform,
+};
+
+sk_sp<SkPicture> MakePicture(SkColor color) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas =
+      recorder.beginRecording(SkRect::MakeWH(kPictureSize, kPictureSize));
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  paint.setColor(color);
+  canvas->drawRRect(
+      SkRRect::MakeRectXY(SkRect::MakeWH(kPictureSize, kPictureSize), 4, 4),
+      paint);
+  paint.setColor(SK_ColorWHITE);
+  canvas->drawCircle(kPictureSize / 2, kPictureSize / 2, kPictureSize / 4,
+                     paint);
+  return recorder.finishRecordingAsPicture();
+}
+
+// The offset of the |index|th layer of a tree, which lays out the layers in
+// a grid that covers the frame.
+SkPoint GetLayerOffset(int index) {
+  return SkPoint::Make((index % 16) * (kPictureSize + 16),
+                       (index / 16 % 16) * (kPictureSize + 4));
+}
+
+// Makes the picture layers of the benchmarks, whose pictures are released on a
+// thread of their own like the pictures of the layers built by the UI thread.
+// Must outlive the layers it makes.
+class PictureLayerFactory {
+ public:
+  PictureLayerFactory()
+      : unref_thread_("io.flutter.bench.unref"),
+        unref_queue_(fml::MakeRefCounted<SkiaUnrefQueue>(
+            unref_thread_.GetTaskRunner(),
+            fml::TimeDelta::Zero())) {}
+
+  ~PictureLayerFactory() { unref_queue_->Drain(); }
+
+  std::shared_ptr<PictureLayer> MakeLayer(const SkPoint& offset,
+                                          SkColor color = SK_ColorBLUE) {
+    return std::make_shared<PictureLayer>(
+        offset, SkiaGPUObject(MakePicture(color), unref_queue_),
+        /*is_complex=*/true, /*will_change=*/false);
+  }
+
+ private:
+  fml::Thread unref_thread_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PictureLayerFactory);
+};
+
+// Makes a layer of |type| holding a picture, or the picture layer itself.
+std::shared_ptr<Layer> MakeLayer(LayerType type,
+                                 int index,
+                                 PictureLayerFactory& factory) {
+  const SkPoint offset = GetLayerOffset(index);
+  const SkRect bounds = SkRect::MakeXYWH(offset.x(), offset.y(), kPictureSize,
+                                         kPictureSize);
+  SkPoint picture_offset = offset;
+  std::shared_ptr<ContainerLayer> layer;
+  switch (type) {
+    case LayerType::kBackdropFilter:
+      layer = std::make_shared<BackdropFilterLayer>(
+          SkImageFilters::Blur(2, 2, nullptr));
+      break;
+    case LayerType::kClipPath:
+      layer = std::make_shared<ClipPathLayer>(SkPath().addOval(bounds),
+                                              Clip::antiAlias);
+      break;
+    case LayerType::kClipRect:
+      layer = std::make_shared<ClipRectLayer>(bounds, Clip::hardEdge);
+      break;
+    case LayerType::kClipRRect:
+      layer = std::make_shared<ClipRRectLayer>(
+          SkRRect::MakeRectXY(bounds, 4, 4), Clip::antiAlias);
+      break;
+    case LayerType::kColorFilter:
+      layer = std::make_shared<ColorFilterLayer>(
+          SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kModulate));
+      break;
+    case LayerType::kImageFilter:
+      layer = std::make_shared<ImageFilterLayer>(
+          SkImageFilters::Blur(2, 2, nullptr));
+      break;
+    case LayerType::kOpacity:
+      layer = std::make_shared<OpacityLayer>(128, offset);
+      picture_offset = SkPoint::Make(0, 0);
+      break;
+    case LayerType::kPhysicalShape:
+      layer = std::make_shared<PhysicalShapeLayer>(
+          SK_ColorWHITE, SK_ColorBLACK, 4.0f, SkPath().addRect(bounds),
+          Clip::antiAlias);
+      break;
+    case LayerType::kPicture:
+      return factory.MakeLayer(offset);
+    case LayerType::kShaderMask:
+      layer = std::make_shared<ShaderMaskLayer>(
+          SkShaders::Color(SK_ColorGREEN), bounds, SkBlendMode::kSrcIn);
+      break;
+    case LayerType::kTransform:
+      layer = std::make_shared<TransformLayer>(
+          SkMatrix::Translate(offset.x(), offset.y()));
+      picture_offset = SkPoint::Make(0, 0);
+      break;
+  }
+  layer->Add(factory.MakeLayer(picture_offset));
+  return layer;
+}
+
+// Makes a layer tree of |count| sibling layers of |type|.
+std::unique_ptr<LayerTree> MakeLayerTree(LayerType type,
+                                         int count,
+                                         PictureLayerFactory& factory) {
+  auto root = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < count; i++) {
+    root->Add(MakeLayer(type, i, factory));
+  }
+  auto layer_tree = std::make_unique<LayerTree>(kFrameSize, 1.0f);
+  layer_tree->set_root_layer(std::move(root));
+  return layer_tree;
+}
+
+// Measures the preroll or the paint of the layers of a tree of
+// |state.range(0)| layers of |type|, drawn to a raster surface without the
+// raster cache.
+void DrawLayerTree(benchmark::State& state, LayerType type, bool paint) {
+  PictureLayerFactory factory;
+  auto layer_tree = MakeLayerTree(type, state.range(0), factory);
+  auto surface = SkSurface::MakeRasterN32Premul(kFrameSize.width(),
+                                                kFrameSize.height());
+  CompositorContext compositor_context;
+  const SkMatrix root_surface_transformation = SkMatrix::I();
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<CompositorContext::ScopedFrame> frame;
+    {
+      benchmarking::ScopedPauseTiming pause(state, paint);
+      frame = compositor_context.AcquireFrame(
+          nullptr, surface->getCanvas(), nullptr, root_surface_transformation,
+          false, true, nullptr);
+      layer_tree->Preroll(*frame, /*ignore_raster_cache=*/true);
+    }
+    {
+      benchmarking::ScopedPauseTiming pause(state, !paint);
+      layer_tree->Paint(*frame, /*ignore_raster_cache=*/true);
+    }
+    benchmarking::ScopedPauseTiming pause(state);
+    frame.reset();
+  }
+}
+
+}  // namespace
+
+static void BM_LayerPreroll(benchmark::State& state, LayerType type) {
+  DrawLayerTree(state, type, /*paint=*/false);
+}
+
+static void BM_LayerPaint(benchmark::State& state, LayerType type) {
+  DrawLayerTree(state, type, /*paint=*/true);
+}
+
+#define LAYER_BENCHMARKS(type)                                             \
+  BENCHMARK_CAPTURE(BM_LayerPreroll, type, LayerType::k##type)             \
+      ->Arg(8)                                                             \
+      ->Arg(64)                                                            \
+      ->Arg(512)                                                           \
+      ->Unit(benchmark::kMicrosecond);                                     \
+  BENCHMARK_CAPTURE(BM_LayerPaint, type, LayerType::k##type)               \
+      ->Arg(8)                                                             \
+      ->Arg(64)                                                            \
+      ->Arg(512)                                                           \
+      ->Unit(benchmark::kMicrosecond);
+
+LAYER_BENCHMARKS(BackdropFilter)
+LAYER_BENCHMARKS(ClipPath)
+LAYER_BENCHMARKS(ClipRect)
+LAYER_BENCHMARKS(ClipRRect)
+LAYER_BENCHMARKS(ColorFilter)
+LAYER_BENCHMARKS(ImageFilter)
+LAYER_BENCHMARKS(Opacity)
+LAYER_BENCHMARKS(PhysicalShape)
+LAYER_BENCHMARKS(Picture)
+LAYER_BENCHMARKS(ShaderMask)
+LAYER_BENCHMARKS(Transform)
+
+static void BM_LayerTreeFlatten(benchmark::State& state) {
+  PictureLayerFactory factory;
+  auto layer_tree = MakeLayerTree(LayerType::kPicture, state.range(0), factory);
+  const SkRect bounds = SkRect::Make(kFrameSize);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(layer_tree->Flatten(bounds));
+  }
+}
+
+BENCHMARK(BM_LayerTreeFlatten)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(512)
+    ->Unit(benchmark::kMicrosecond);
+
+// Records |state.range(0)| rects laid out in a grid of overlapping rows into
+// an RTree, the way pictures with platform views are recorded.
+static sk_sp<RTree> MakeRTree(benchmark::State& state) {
+  RTreeFactory factory;
+  SkPictureRecorder recorder;
+  SkCanvas* canvas =
+      recorder.beginRecording(SkRect::Make(kFrameSize), &factory);
+  SkPaint paint;
+  const int count = state.range(0);
+  const int columns = 64;
+  const SkScalar width = kFrameSize.width() / static_cast<SkScalar>(columns);
+  const SkScalar height =
+      kFrameSize.height() * columns / static_cast<SkScalar>(count);
+  for (int i = 0; i < count; i++) {
+    canvas->drawRect(SkRect::MakeXYWH((i % columns) * width,
+                                      (i / columns) * height, width * 1.5f,
+                                      height * 1.5f),
+                     paint);
+  }
+  recorder.finishRecordingAsPicture();
+  return factory.getInstance();
+}
+
+static void BM_RTreeSearch(benchmark::State& state) {
+  auto rtree = MakeRTree(state);
+  const SkRect query = SkRect::MakeXYWH(200, 150, 400, 300);
+  std::vector<int> results;
+  while (state.KeepRunning()) {
+    results.clear();
+    rtree->search(query, &results);
+    benchmark::DoNotOptimize(results.data());
+  }
+}
+
+BENCHMARK(BM_RTreeSearch)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_RTreeSearchNonOverlappingDrawnRects(benchmark::State& state) {
+  auto rtree = MakeRTree(state);
+  const SkRect query = SkRect::MakeXYWH(200, 150, 400, 300);
+  std::vector<SkRect> results;
+  while (state.KeepRunning()) {
+    rtree->searchNonOverlappingDrawnRects(query, &results);
+    benchmark::DoNotOptimize(results.data());
+  }
+}
+
+BENCHMARK(BM_RTreeSearchNonOverlappingDrawnRects)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(16384)
+    ->Unit(benchmark::kMicrosecond);
+
+// Pushes |state.range(0)| mutators of each kind and pops them all, like the
+// preroll of a layer subtree with embedded platform views does.
+static void BM_MutatorsStackPushPop(benchmark::State& state) {
+  const SkRect rect = SkRect::MakeWH(100, 100);
+  const SkRRect rrect = SkRRect::MakeRectXY(rect, 4, 4);
+  const SkMatrix matrix = SkMatrix::Translate(1, 1);
+  MutatorsStack stack;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < state.range(0); i++) {
+      stack.PushTransform(matrix);
+      stack.PushClipRect(rect);
+      stack.PushClipRRect(rrect);
+      stack.PushOpacity(128);
+    }
+    for (int i = 0; i < state.range(0) * 4; i++) {
+      stack.Pop();
+    }
+  }
+}
+
+BENCHMARK(BM_MutatorsStackPushPop)->Arg(1)->Arg(8)->Arg(64);
+
+// Prepares |state.range(0)| pictures in an empty raster cache, which
+// rasterizes them all.
+static void BM_RasterCachePrepare(benchmark::State& state) {
+  const int count = state.range(0);
+  RasterCache cache(/*access_threshold=*/1, count);
+  std::vector<sk_sp<SkPicture>> pictures;
+  for (int i = 0; i < count; i++) {
+    pictures.push_back(MakePicture(SK_ColorBLUE));
+  }
+  const SkMatrix matrix = SkMatrix::I();
+  SkCanvas canvas;
+
+  while (state.KeepRunning()) {
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      cache.Clear();
+      // Reach the access threshold of the pictures.
+      for (const auto& picture : pictures) {
+        cache.Prepare(nullptr, picture.get(), matrix, nullptr, true, false);
+        cache.Draw(*picture, canvas);
+      }
+      cache.SweepAfterFrame();
+    }
+    for (const auto& picture : pictures) {
+      cache.Prepare(nullptr, picture.get(), matrix, nullptr, true, false);
+    }
+  }
+}
+
+BENCHMARK(BM_RasterCachePrepare)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64)
+    ->Unit(benchmark::kMicrosecond);
+
+// A frame that draws |state.range(0)| pictures from the raster cache.
+static void BM_RasterCacheDraw(benchmark::State& state) {
+  const int count = state.range(0);
+  RasterCache cache(/*access_threshold=*/1, count);
+  std::vector<sk_sp<SkPicture>> pictures;
+  for (int i = 0; i < count; i++) {
+    pictures.push_back(MakePicture(SK_ColorBLUE));
+  }
+  const SkMatrix matrix = SkMatrix::I();
+  auto surface = SkSurface::MakeRasterN32Premul(kFrameSize.width(),
+                                                kFrameSize.height());
+  SkCanvas* canvas = surface->getCanvas();
+
+  auto draw_frame = [&]() {
+    for (const auto& picture : pictures) {
+      cache.Prepare(nullptr, picture.get(), matrix, nullptr, true, false);
+      cache.Draw(*picture, *canvas);
+    }
+    cache.SweepAfterFrame();
+  };
+
+  // Populate the cache.
+  draw_frame();
+  draw_frame();
+  while (state.KeepRunning()) {
+    draw_frame();
+  }
+}
+
+BENCHMARK(BM_RasterCacheDraw)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(64)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
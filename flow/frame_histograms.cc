@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_histograms.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+const char* FrameHistograms::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case kVsyncOverhead:
+      return "vsyncOverhead";
+    case kBuild:
+      return "build";
+    case kPreroll:
+      return "preroll";
+    case kPaint:
+      return "paint";
+    case kSubmit:
+      return "submit";
+    case kRasterCacheHits:
+      return "rasterCacheHits";
+    case kGPU:
+      return "gpu";
+    case kCount:
+      break;
+  }
+  FML_DCHECK(false);
+  return "";
+}
+
+FrameHistograms::FrameHistograms() = default;
+
+FrameHistograms::~FrameHistograms() = default;
+
+void FrameHistograms::Reset() {
+  for (auto& histogram : histograms_) {
+    histogram.Reset();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_HISTOGRAMS_H_
+#define FLUTTER_FLOW_FRAME_HISTOGRAMS_H_
+
+#include <array>
+#include <cstdint>
+
+#include "flutter/fml/histogram.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// The histogram the phases are recorded in, shared with the statistics of
+/// the task queues.
+using Histogram = fml::Histogram;
+
+/// Aggregates the cost of the phases of every frame drawn by a compositor
+/// context over its lifetime, for monitoring that needs percentiles instead
+/// of the last few frames shown by the performance overlay.
+///
+/// Recording a phase is a couple of relaxed atomic operations. Percentiles
+/// are only computed when they are queried.
+class FrameHistograms {
+ public:
+  enum Phase {
+    // Time from the vsync to the start of the frame build, in microseconds.
+    kVsyncOverhead,
+    // Time spent building the layer tree on the UI thread, in microseconds.
+    kBuild,
+    // Time spent prerolling the layer tree, in microseconds.
+    kPreroll,
+    // Time spent painting the layer tree, in microseconds.
+    kPaint,
+    // Time spent submitting the frame to the GPU, in microseconds.
+    kSubmit,
+    // Number of raster cache entries drawn in place of their layers or
+    // pictures.
+    kRasterCacheHits,
+    // Time the GPU spent executing the commands of the frame, in
+    // microseconds. Only measured by surfaces that support GPU timer queries,
+    // and recorded a few frames after the frame was submitted.
+    kGPU,
+    kCount
+  };
+
+  static constexpr Phase kPhases[kCount] = {kVsyncOverhead, kBuild,
+                                            kPreroll,       kPaint,
+                                            kSubmit,        kRasterCacheHits,
+                                            kGPU};
+
+  /// The name of |phase| used by the service protocol.
+  static const char* GetPhaseName(Phase phase);
+
+  FrameHistograms();
+
+  ~FrameHistograms();
+
+  void Record(Phase phase, int64_t value) { histograms_[phase].Record(value); }
+
+  void Record(Phase phase, fml::TimeDelta delta) {
+    Record(phase, delta.ToMicroseconds());
+  }
+
+  Histogram::Summary Summarize(Phase phase) const {
+    return histograms_[phase].Summarize();
+  }
+
+  void Reset();
+
+ private:
+  std::array<Histogram, kCount> histograms_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameHistograms);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_HISTOGRAMS_H_
@@ -0,0 +1,28 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_histograms.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(FrameHistogramsTest, RecordsPhasesIndependently) {
+  FrameHistograms histograms;
+  histograms.Record(FrameHistograms::kBuild,
+                    fml::TimeDelta::FromMilliseconds(3));
+  histograms.Record(FrameHistograms::kRasterCacheHits, 2);
+  ASSERT_EQ(histograms.Summarize(FrameHistograms::kBuild).max, 3000u);
+  ASSERT_EQ(histograms.Summarize(FrameHistograms::kRasterCacheHits).max, 2u);
+  ASSERT_EQ(histograms.Summarize(FrameHistograms::kPaint).count, 0u);
+
+  histograms.Reset();
+  for (auto phase : FrameHistograms::kPhases) {
+    ASSERT_EQ(histograms.Summarize(phase).count, 0u);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
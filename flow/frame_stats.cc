@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_stats.h"
+
+namespace flutter {
+
+FrameStatsRing::FrameStatsRing(size_t capacity) : capacity_(capacity) {}
+
+FrameStatsRing::~FrameStatsRing() = default;
+
+size_t FrameStatsRing::GetCapacity() const {
+  std::scoped_lock lock(mutex_);
+  return capacity_;
+}
+
+void FrameStatsRing::SetCapacity(size_t capacity) {
+  std::scoped_lock lock(mutex_);
+  capacity_ = capacity;
+  frames_.clear();
+  frames_.shrink_to_fit();
+  next_ = 0;
+  dropped_count_ = 0;
+}
+
+void FrameStatsRing::Record(const FrameStats& stats) {
+  std::scoped_lock lock(mutex_);
+  if (capacity_ == 0) {
+    return;
+  }
+  if (frames_.size() < capacity_) {
+    frames_.push_back(stats);
+    return;
+  }
+  frames_[next_] = stats;
+  next_ = (next_ + 1) % capacity_;
+  dropped_count_++;
+}
+
+std::vector<FrameStats> FrameStatsRing::GetFrames() const {
+  std::scoped_lock lock(mutex_);
+  std::vector<FrameStats> frames;
+  frames.reserve(frames_.size());
+  frames.insert(frames.end(), frames_.begin() + next_, frames_.end());
+  frames.insert(frames.end(), frames_.begin(), frames_.begin() + next_);
+  return frames;
+}
+
+uint64_t FrameStatsRing::GetDroppedCount() const {
+  std::scoped_lock lock(mutex_);
+  return dropped_count_;
+}
+
+void FrameStatsRing::Clear() {
+  std::scoped_lock lock(mutex_);
+  frames_.clear();
+  next_ = 0;
+  dropped_count_ = 0;
+}
+
+}  // namespace flutter
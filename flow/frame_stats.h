@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_STATS_H_
+#define FLUTTER_FLOW_FRAME_STATS_H_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+/// What a single rasterized frame contained and how the raster cache treated
+/// it. Kept small so that a few minutes of frames fit in a |FrameStatsRing|.
+struct FrameStats {
+  // The number of the frame, counted from the first frame the compositor
+  // context recorded.
+  uint64_t frame_number = 0;
+  // When the rasterization of the frame started, in microseconds since the
+  // epoch of |fml::TimePoint|.
+  int64_t raster_start_micros = 0;
+  uint32_t preroll_micros = 0;
+  uint32_t paint_micros = 0;
+  // The layers in the tree, containers included.
+  uint32_t layer_count = 0;
+  // The picture and display list layers in the tree.
+  uint32_t picture_count = 0;
+  // The drawing operations recorded in the pictures and display lists.
+  uint32_t op_count = 0;
+  // Raster cache entries drawn in place of their layers or pictures.
+  uint32_t raster_cache_hits = 0;
+  // Pictures rasterized into the raster cache during the frame.
+  uint32_t raster_cache_insertions = 0;
+  // The entries in the raster cache at the end of the frame.
+  uint32_t raster_cache_layer_entries = 0;
+  uint32_t raster_cache_picture_entries = 0;
+};
+
+/// Keeps the |FrameStats| of the last frames so that jank can be investigated
+/// after the fact, for example from a device in the field, instead of having
+/// to reproduce it while tracing.
+///
+/// Once the ring is full, recording a frame replaces the oldest one. A ring
+/// with no capacity records nothing.
+///
+/// This class is thread-safe.
+class FrameStatsRing {
+ public:
+  explicit FrameStatsRing(size_t capacity = 0);
+
+  ~FrameStatsRing();
+
+  size_t GetCapacity() const;
+
+  /// Changes the number of frames kept, discarding the recorded ones.
+  void SetCapacity(size_t capacity);
+
+  void Record(const FrameStats& stats);
+
+  /// The recorded frames, oldest first.
+  std::vector<FrameStats> GetFrames() const;
+
+  /// The number of frames that were replaced by newer ones since the ring was
+  /// last cleared.
+  uint64_t GetDroppedCount() const;
+
+  void Clear();
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<FrameStats> frames_;
+  size_t capacity_ = 0;
+  // Where the next frame is recorded once |frames_| is full.
+  size_t next_ = 0;
+  uint64_t dropped_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStatsRing);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_STATS_H_
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_stats.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static FrameStats StatsForFrame(uint64_t frame_number) {
+  FrameStats stats;
+  stats.frame_number = frame_number;
+  return stats;
+}
+
+TEST(FrameStatsRingTest, RingWithoutCapacityRecordsNothing) {
+  FrameStatsRing ring;
+  ring.Record(StatsForFrame(1));
+  ASSERT_TRUE(ring.GetFrames().empty());
+  ASSERT_EQ(ring.GetDroppedCount(), 0u);
+}
+
+TEST(FrameStatsRingTest, FramesAreReturnedOldestFirst) {
+  FrameStatsRing ring(3);
+  ring.Record(StatsForFrame(1));
+  ring.Record(StatsForFrame(2));
+  auto frames = ring.GetFrames();
+  ASSERT_EQ(frames.size(), 2u);
+  ASSERT_EQ(frames[0].frame_number, 1u);
+  ASSERT_EQ(frames[1].frame_number, 2u);
+}
+
+TEST(FrameStatsRingTest, NewFramesReplaceTheOldest) {
+  FrameStatsRing ring(3);
+  for (uint64_t i = 1; i <= 7; i++) {
+    ring.Record(StatsForFrame(i));
+  }
+  auto frames = ring.GetFrames();
+  ASSERT_EQ(frames.size(), 3u);
+  ASSERT_EQ(frames[0].frame_number, 5u);
+  ASSERT_EQ(frames[1].frame_number, 6u);
+  ASSERT_EQ(frames[2].frame_number, 7u);
+  ASSERT_EQ(ring.GetDroppedCount(), 4u);
+}
+
+TEST(FrameStatsRingTest, ClearDiscardsFrames) {
+  FrameStatsRing ring(2);
+  for (uint64_t i = 1; i <= 3; i++) {
+    ring.Record(StatsForFrame(i));
+  }
+  ring.Clear();
+  ASSERT_TRUE(ring.GetFrames().empty());
+  ASSERT_EQ(ring.GetDroppedCount(), 0u);
+  ring.Record(StatsForFrame(4));
+  ASSERT_EQ(ring.GetFrames()[0].frame_number, 4u);
+}
+
+TEST(FrameStatsRingTest, SetCapacityDiscardsFrames) {
+  FrameStatsRing ring(2);
+  ring.Record(StatsForFrame(1));
+  ring.SetCapacity(4);
+  ASSERT_EQ(ring.GetCapacity(), 4u);
+  ASSERT_TRUE(ring.GetFrames().empty());
+  ring.SetCapacity(0);
+  ring.Record(StatsForFrame(2));
+  ASSERT_TRUE(ring.GetFrames().empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -24,5 +24,45 @@ TEST(GLContextSwitchTest, SwitchKeepsContextCurrentWhileInScope) {
   ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), -1);
 }
 
+TEST(GLContextSwitchTest, SwitchToTheCurrentContextIsElided) {
+  GLContextSwitch::Counts initial_counts =
+      GLContextSwitch::GetCountsForCurrentThread();
+  {
+    auto outer_switch =
+        GLContextSwitch(std::make_unique<TestSwitchableGLContext>(1));
+    {
+      auto inner_switch =
+          GLContextSwitch(std::make_unique<TestSwitchableGLContext>(1));
+      ASSERT_TRUE(inner_switch.GetResult());
+      ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), 1);
+    }
+    // The inner switch did not remove the context of the outer one.
+    ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), 1);
+  }
+  ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), -1);
+
+  GLContextSwitch::Counts counts = GLContextSwitch::GetCountsForCurrentThread();
+  EXPECT_EQ(counts.made - initial_counts.made, 1);
+  EXPECT_EQ(counts.elided - initial_counts.elided, 1);
+}
+
+TEST(GLContextSwitchTest, SwitchToAnotherContextIsMade) {
+  GLContextSwitch::Counts initial_counts =
+      GLContextSwitch::GetCountsForCurrentThread();
+  {
+    auto outer_switch =
+        GLContextSwitch(std::make_unique<TestSwitchableGLContext>(1));
+    {
+      auto inner_switch =
+          GLContextSwitch(std::make_unique<TestSwitchableGLContext>(2));
+      ASSERT_EQ(TestSwitchableGLContext::GetCurrentContext(), 2);
+    }
+  }
+
+  GLContextSwitch::Counts counts = GLContextSwitch::GetCountsForCurrentThread();
+  EXPECT_EQ(counts.made - initial_counts.made, 2);
+  EXPECT_EQ(counts.elided - initial_counts.elided, 0);
+}
+
 }  // namespace testing
 }  // namespace flutter
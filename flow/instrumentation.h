@@ -38,6 +38,12 @@ class Stopwatch {
 
   void SetLapTime(const fml::TimeDelta& delta);
 
+  // The budget of a frame, which the visualization marks. Follows the vsync
+  // interval on displays whose refresh rate changes.
+  void SetFrameBudget(fml::Milliseconds frame_budget);
+
+  fml::Milliseconds GetFrameBudget() const { return frame_budget_; }
+
  private:
   inline double UnitFrameInterval(double time_ms) const;
   inline double UnitHeight(double time_ms, double max_height) const;
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_cost_profile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+LayerCostProfile::AutoScope::AutoScope(LayerCostProfile* profile,
+                                       uint64_t unique_id,
+                                       const char* type_name,
+                                       Phase phase)
+    : profile_(profile),
+      unique_id_(unique_id),
+      type_name_(type_name),
+      phase_(phase) {
+  if (profile_) {
+    profile_->BeginLayer();
+    start_ = fml::TimePoint::Now();
+  }
+}
+
+LayerCostProfile::AutoScope::~AutoScope() {
+  if (profile_) {
+    profile_->EndLayer(unique_id_, type_name_, phase_,
+                       fml::TimePoint::Now() - start_);
+  }
+}
+
+LayerCostProfile::LayerCostProfile(size_t window_frames, size_t top_count)
+    : window_frames_(std::max<size_t>(window_frames, 1)),
+      top_count_(top_count) {}
+
+LayerCostProfile::~LayerCostProfile() = default;
+
+void LayerCostProfile::BeginLayer() {
+  children_time_stack_.push_back(fml::TimeDelta::Zero());
+}
+
+void LayerCostProfile::EndLayer(uint64_t unique_id,
+                                const char* type_name,
+                                Phase phase,
+                                fml::TimeDelta elapsed) {
+  FML_DCHECK(!children_time_stack_.empty());
+  const fml::TimeDelta self_time = elapsed - children_time_stack_.back();
+  children_time_stack_.pop_back();
+  if (!children_time_stack_.empty()) {
+    children_time_stack_.back() = children_time_stack_.back() + elapsed;
+  }
+  Totals& totals = totals_[unique_id];
+  totals.type_name = type_name;
+  totals.self_time[phase] = totals.self_time[phase] + self_time;
+  frame_has_layers_ = true;
+}
+
+void LayerCostProfile::EndFrame() {
+  FML_DCHECK(children_time_stack_.empty());
+  if (!frame_has_layers_) {
+    return;
+  }
+  frame_has_layers_ = false;
+  if (++frame_count_ >= window_frames_) {
+    EndWindow();
+  }
+}
+
+void LayerCostProfile::EndWindow() {
+  const int64_t frame_count = static_cast<int64_t>(frame_count_);
+  std::vector<Entry> entries;
+  entries.reserve(totals_.size());
+  std::vector<TypeCost> type_costs;
+  for (const auto& [unique_id, totals] : totals_) {
+    Entry entry;
+    entry.unique_id = unique_id;
+    entry.type_name = totals.type_name;
+    for (size_t phase = 0; phase < kPhaseCount; phase++) {
+      entry.self_time[phase] = totals.self_time[phase] / frame_count;
+    }
+    // There are only a handful of types, so they are looked up linearly.
+    auto type_cost = std::find_if(
+        type_costs.begin(), type_costs.end(), [&entry](const TypeCost& cost) {
+          return std::strcmp(cost.type_name, entry.type_name) == 0;
+        });
+    if (type_cost == type_costs.end()) {
+      type_costs.push_back({entry.type_name, fml::TimeDelta::Zero()});
+      type_cost = type_costs.end() - 1;
+    }
+    type_cost->self_time = type_cost->self_time + entry.GetTotalSelfTime();
+    entries.push_back(entry);
+  }
+
+  const size_t top_count = std::min(top_count_, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + top_count,
+                    entries.end(), [](const Entry& a, const Entry& b) {
+                      return a.GetTotalSelfTime() > b.GetTotalSelfTime();
+                    });
+  entries.resize(top_count);
+  std::sort(type_costs.begin(), type_costs.end(),
+            [](const TypeCost& a, const TypeCost& b) {
+              return a.self_time > b.self_time;
+            });
+
+  for (const auto& entry : entries) {
+    FML_TRACE_COUNTER("flutter", "LayerCost",
+                      static_cast<int64_t>(entry.unique_id), entry.type_name,
+                      entry.GetTotalSelfTime().ToMicroseconds(),
+                      "PrerollMicros",
+                      entry.self_time[kPreroll].ToMicroseconds(),
+                      "PaintMicros", entry.self_time[kPaint].ToMicroseconds());
+  }
+  for (const auto& type_cost : type_costs) {
+    FML_TRACE_COUNTER("flutter", "LayerTypeCost",
+                      reinterpret_cast<int64_t>(this), type_cost.type_name,
+                      type_cost.self_time.ToMicroseconds());
+  }
+
+  top_entries_ = std::move(entries);
+  type_costs_ = std::move(type_costs);
+  totals_.clear();
+  frame_count_ = 0;
+}
+
+}  // namespace flutter
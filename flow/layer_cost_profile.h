@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_COST_PROFILE_H_
+#define FLUTTER_FLOW_LAYER_COST_PROFILE_H_
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Attributes the time spent prerolling and painting a layer tree to its
+/// layers, to tell whether a frame is expensive because of, say, a backdrop
+/// filter or a huge picture rather than just that it is expensive.
+///
+/// Each layer is timed with an |AutoScope| around its |Layer::Preroll| and
+/// |Layer::Paint|. The time of a layer excludes the time of its children, so
+/// that a container is not blamed for the cost of its subtree. The costs are
+/// averaged over windows of frames. At the end of each window, the costliest
+/// layers and the cost of each type of layer are published to the timeline as
+/// counters and made available to the performance overlay.
+///
+/// Timing every layer has a cost of its own, so profiles are only created
+/// when requested. They must only be used on the raster thread.
+class LayerCostProfile {
+ public:
+  enum Phase { kPreroll, kPaint, kPhaseCount };
+
+  struct Entry {
+    uint64_t unique_id = 0;
+    const char* type_name = nullptr;
+    // The average time per frame spent in each phase of the layer, excluding
+    // its children.
+    std::array<fml::TimeDelta, kPhaseCount> self_time = {};
+
+    fml::TimeDelta GetTotalSelfTime() const {
+      return self_time[kPreroll] + self_time[kPaint];
+    }
+  };
+
+  struct TypeCost {
+    const char* type_name = nullptr;
+    // The average time per frame spent in the layers of the type, excluding
+    // their children.
+    fml::TimeDelta self_time;
+  };
+
+  /// Times a phase of a layer until destroyed. Does nothing if |profile| is
+  /// null, so that callers do not need to check whether profiling is on.
+  class AutoScope {
+   public:
+    AutoScope(LayerCostProfile* profile,
+              uint64_t unique_id,
+              const char* type_name,
+              Phase phase);
+
+    ~AutoScope();
+
+   private:
+    LayerCostProfile* profile_;
+    const uint64_t unique_id_;
+    const char* type_name_;
+    const Phase phase_;
+    fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(AutoScope);
+  };
+
+  static constexpr size_t kDefaultWindowFrames = 60;
+  static constexpr size_t kDefaultTopCount = 5;
+
+  explicit LayerCostProfile(size_t window_frames = kDefaultWindowFrames,
+                            size_t top_count = kDefaultTopCount);
+
+  ~LayerCostProfile();
+
+  /// Ends the frame whose layers were timed since the last call. Frames in
+  /// which no layer was timed do not count towards the window.
+  void EndFrame();
+
+  /// The costliest layers of the last complete window, costliest first.
+  const std::vector<Entry>& GetTopEntries() const { return top_entries_; }
+
+  /// The cost of each type of layer in the last complete window, costliest
+  /// first.
+  const std::vector<TypeCost>& GetTypeCosts() const { return type_costs_; }
+
+ private:
+  struct Totals {
+    const char* type_name = nullptr;
+    std::array<fml::TimeDelta, kPhaseCount> self_time = {};
+  };
+
+  const size_t window_frames_;
+  const size_t top_count_;
+  // The time spent in the children of each layer being timed, innermost last.
+  std::vector<fml::TimeDelta> children_time_stack_;
+  std::unordered_map<uint64_t, Totals> totals_;
+  bool frame_has_layers_ = false;
+  size_t frame_count_ = 0;
+  std::vector<Entry> top_entries_;
+  std::vector<TypeCost> type_costs_;
+
+  void BeginLayer();
+
+  void EndLayer(uint64_t unique_id,
+                const char* type_name,
+                Phase phase,
+                fml::TimeDelta elapsed);
+
+  void EndWindow();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerCostProfile);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_COST_PROFILE_H_
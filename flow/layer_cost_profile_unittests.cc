@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_cost_profile.h"
+
+#include <thread>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static void TimeLayer(LayerCostProfile* profile,
+                      uint64_t unique_id,
+                      const char* type_name,
+                      fml::TimeDelta duration) {
+  LayerCostProfile::AutoScope scope(profile, unique_id, type_name,
+                                    LayerCostProfile::kPaint);
+  std::this_thread::sleep_for(
+      std::chrono::microseconds(duration.ToMicroseconds()));
+}
+
+TEST(LayerCostProfileTest, ScopeWithoutProfileDoesNothing) {
+  TimeLayer(nullptr, 1, "PictureLayer", fml::TimeDelta::Zero());
+}
+
+TEST(LayerCostProfileTest, CostsArePublishedAtTheEndOfTheWindow) {
+  LayerCostProfile profile(2, 5);
+  TimeLayer(&profile, 1, "PictureLayer", fml::TimeDelta::Zero());
+  profile.EndFrame();
+  ASSERT_TRUE(profile.GetTopEntries().empty());
+
+  // Frames without layers do not count.
+  profile.EndFrame();
+  ASSERT_TRUE(profile.GetTopEntries().empty());
+
+  TimeLayer(&profile, 1, "PictureLayer", fml::TimeDelta::Zero());
+  profile.EndFrame();
+  ASSERT_EQ(profile.GetTopEntries().size(), 1u);
+  ASSERT_EQ(profile.GetTopEntries()[0].unique_id, 1u);
+  ASSERT_STREQ(profile.GetTopEntries()[0].type_name, "PictureLayer");
+  ASSERT_EQ(profile.GetTypeCosts().size(), 1u);
+}
+
+TEST(LayerCostProfileTest, ChildrenAreExcludedFromTheirParent) {
+  LayerCostProfile profile(1, 5);
+  {
+    LayerCostProfile::AutoScope parent(&profile, 1, "ContainerLayer",
+                                       LayerCostProfile::kPaint);
+    TimeLayer(&profile, 2, "BackdropFilterLayer",
+              fml::TimeDelta::FromMilliseconds(20));
+  }
+  profile.EndFrame();
+
+  const auto& entries = profile.GetTopEntries();
+  ASSERT_EQ(entries.size(), 2u);
+  ASSERT_EQ(entries[0].unique_id, 2u);
+  ASSERT_GE(entries[0].self_time[LayerCostProfile::kPaint],
+            fml::TimeDelta::FromMilliseconds(20));
+  ASSERT_EQ(entries[0].self_time[LayerCostProfile::kPreroll],
+            fml::TimeDelta::Zero());
+  ASSERT_EQ(entries[1].unique_id, 1u);
+  ASSERT_LT(entries[1].GetTotalSelfTime(), entries[0].GetTotalSelfTime());
+  ASSERT_STREQ(profile.GetTypeCosts()[0].type_name, "BackdropFilterLayer");
+}
+
+TEST(LayerCostProfileTest, OnlyTheCostliestLayersAreKept) {
+  LayerCostProfile profile(1, 2);
+  TimeLayer(&profile, 1, "PictureLayer", fml::TimeDelta::Zero());
+  TimeLayer(&profile, 2, "PictureLayer", fml::TimeDelta::FromMilliseconds(10));
+  TimeLayer(&profile, 3, "TextureLayer", fml::TimeDelta::FromMilliseconds(5));
+  profile.EndFrame();
+
+  const auto& entries = profile.GetTopEntries();
+  ASSERT_EQ(entries.size(), 2u);
+  ASSERT_EQ(entries[0].unique_id, 2u);
+  ASSERT_EQ(entries[1].unique_id, 3u);
+  // The types cover all the layers, not only the costliest ones.
+  ASSERT_EQ(profile.GetTypeCosts().size(), 2u);
+  ASSERT_STREQ(profile.GetTypeCosts()[0].type_name, "PictureLayer");
+}
+
+}  // namespace testing
+}  // namespace flutter
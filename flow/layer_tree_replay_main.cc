@@ -0,0 +1,254 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Rasterizes a layer tree capture, as returned by the
+// _flutter.captureLayerTree service extension, through a compositor context
+// and reports how long its frames took. This lets the jank of a frame
+// captured on a device be investigated, and fixes be measured, without the
+// application that produced it.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/utils/SkBase64.h"
+
+#ifdef LAYER_TREE_REPLAY_ENABLE_GL
+#include "flutter/testing/test_gl_surface.h"
+#endif  // LAYER_TREE_REPLAY_ENABLE_GL
+
+namespace flutter {
+namespace {
+
+void Usage() {
+  std::cerr
+      << "Usage: layer_tree_replay [options] <capture>\n"
+         "\n"
+         "Rasterizes a layer tree capture, as returned Base 64 encoded by the\n"
+         "_flutter.captureLayerTree service extension or decoded, and prints\n"
+         "the raster times of its frames in microseconds.\n"
+         "\n"
+         "  --backend=software|gl    The backend to rasterize with. Defaults\n"
+         "                           to software.\n"
+         "  --frames=<count>         The frames to time. Defaults to 100.\n"
+         "  --warmup-frames=<count>  The frames to rasterize before timing,\n"
+         "                           which fill the raster cache and the\n"
+         "                           shader caches. Defaults to 10.\n"
+         "  --ignore-raster-cache    Rasterize without the raster cache.\n"
+         "  --output=<path>          Write the last frame as a PNG image.\n";
+}
+
+enum class Backend { kSoftware, kGL };
+
+// The surface the frames are rasterized to.
+class RenderTarget {
+ public:
+  static std::unique_ptr<RenderTarget> Create(Backend backend,
+                                              const SkISize& size) {
+    auto target = std::unique_ptr<RenderTarget>(new RenderTarget());
+    switch (backend) {
+      case Backend::kSoftware:
+        target->surface_ =
+            SkSurface::MakeRasterN32Premul(size.width(), size.height());
+        break;
+      case Backend::kGL:
+#ifdef LAYER_TREE_REPLAY_ENABLE_GL
+        target->gl_surface_ = std::make_unique<testing::TestGLSurface>(size);
+        if (!target->gl_surface_->MakeCurrent()) {
+          return nullptr;
+        }
+        target->gr_context_ = target->gl_surface_->GetGrContext();
+        target->surface_ = target->gl_surface_->GetOnscreenSurface();
+#endif  // LAYER_TREE_REPLAY_ENABLE_GL
+        break;
+    }
+    if (!target->surface_) {
+      return nullptr;
+    }
+    return target;
+  }
+
+  SkCanvas* canvas() const { return surface_->getCanvas(); }
+
+  GrDirectContext* gr_context() const { return gr_context_.get(); }
+
+  // Waits for the GPU to finish the frame, so that its time is counted.
+  void Flush() {
+    if (gr_context_) {
+      gr_context_->flushAndSubmit(/*syncCpu=*/true);
+    }
+  }
+
+  sk_sp<SkImage> Snapshot() { return surface_->makeImageSnapshot(); }
+
+ private:
+#ifdef LAYER_TREE_REPLAY_ENABLE_GL
+  std::unique_ptr<testing::TestGLSurface> gl_surface_;
+#endif  // LAYER_TREE_REPLAY_ENABLE_GL
+  sk_sp<GrDirectContext> gr_context_;
+  sk_sp<SkSurface> surface_;
+
+  RenderTarget() = default;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTarget);
+};
+
+// Captures returned by the service protocol are Base 64 encoded, while
+// decoded ones start with "FLTC".
+sk_sp<SkData> DecodeCapture(const fml::Mapping& mapping) {
+  const size_t magic_size = 4;
+  if (mapping.GetSize() >= magic_size &&
+      std::memcmp(mapping.GetMapping(), "FLTC", magic_size) == 0) {
+    return SkData::MakeWithCopy(mapping.GetMapping(), mapping.GetSize());
+  }
+  size_t size = 0;
+  if (SkBase64::Decode(mapping.GetMapping(), mapping.GetSize(), nullptr,
+                       &size) != SkBase64::kNoError) {
+    return SkData::MakeEmpty();
+  }
+  auto decoded = SkData::MakeUninitialized(size);
+  SkBase64::Decode(mapping.GetMapping(), mapping.GetSize(),
+                   decoded->writable_data(), &size);
+  return decoded;
+}
+
+void PrintTimes(const char* name, std::vector<int64_t> times) {
+  std::sort(times.begin(), times.end());
+  int64_t total = 0;
+  for (int64_t time : times) {
+    total += time;
+  }
+  auto percentile = [&times](size_t percent) {
+    return times[std::min(times.size() - 1, times.size() * percent / 100)];
+  };
+  const int64_t average = total / static_cast<int64_t>(times.size());
+  std::cout << name << ": average " << average << ", p50 " << percentile(50) << ", p90 " << percentile(90)
+            << ", p99 " << percentile(99) << ", max " << times.back()
+            << std::endl;
+}
+
+int Replay(const fml::CommandLine& command_line) {
+  if (command_line.positional_args().size() != 1 ||
+      command_line.HasOption("help")) {
+    Usage();
+    return EXIT_FAILURE;
+  }
+
+  Backend backend = Backend::kSoftware;
+  const std::string backend_name =
+      command_line.GetOptionValueWithDefault("backend", "software");
+  if (backend_name == "gl") {
+    backend = Backend::kGL;
+  } else if (backend_name != "software") {
+    std::cerr << "Unknown backend " << backend_name << "." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const int frame_count =
+      std::stoi(command_line.GetOptionValueWithDefault("frames", "100"));
+  const int warmup_frame_count =
+      std::stoi(command_line.GetOptionValueWithDefault("warmup-frames", "10"));
+  const bool ignore_raster_cache =
+      command_line.HasOption("ignore-raster-cache");
+  if (frame_count <= 0 || warmup_frame_count < 0) {
+    std::cerr << "The frame counts must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string& capture_path = command_line.positional_args()[0];
+  auto mapping = fml::FileMapping::CreateReadOnly(capture_path);
+  if (!mapping || mapping->GetSize() == 0) {
+    std::cerr << "Could not read " << capture_path << "." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::unique_ptr<LayerTree> layer_tree =
+      ReadLayerTreeCapture(*DecodeCapture(*mapping));
+  if (!layer_tree) {
+    std::cerr << capture_path << " is not a layer tree capture." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto target = RenderTarget::Create(backend, layer_tree->frame_size());
+  if (!target) {
+    std::cerr << "Could not create a " << backend_name << " surface."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The same tree is rasterized for every frame, as if it was resubmitted,
+  // so that the raster cache behaves as it does for a static scene.
+  CompositorContext compositor_context;
+  const SkMatrix root_surface_transformation;
+  std::vector<int64_t> raster_times;
+  std::vector<int64_t> flush_times;
+  for (int i = 0; i < warmup_frame_count + frame_count; i++) {
+    const fml::TimePoint start = fml::TimePoint::Now();
+    {
+      auto frame = compositor_context.AcquireFrame(
+          target->gr_context(), target->canvas(), nullptr,
+          root_surface_transformation, true, true, nullptr);
+      target->canvas()->clear(SK_ColorTRANSPARENT);
+      if (frame->Raster(*layer_tree, ignore_raster_cache, nullptr) ==
+          RasterStatus::kFailed) {
+        std::cerr << "Could not rasterize the layer tree." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    const fml::TimePoint raster_end = fml::TimePoint::Now();
+    target->Flush();
+    const fml::TimePoint flush_end = fml::TimePoint::Now();
+    if (i >= warmup_frame_count) {
+      raster_times.push_back((raster_end - start).ToMicroseconds());
+      flush_times.push_back((flush_end - raster_end).ToMicroseconds());
+    }
+  }
+
+  std::cout << "Replayed " << frame_count << " frames of "
+            << layer_tree->frame_size().width() << "x"
+            << layer_tree->frame_size().height() << " with the "
+            << backend_name << " backend, in microseconds." << std::endl;
+  PrintTimes("Preroll and paint", raster_times);
+  PrintTimes("GPU flush", flush_times);
+  const auto& raster_cache = compositor_context.raster_cache();
+  std::cout << "Raster cache: " << raster_cache.GetLayerCachedEntriesCount()
+            << " layers, " << raster_cache.GetPictureCachedEntriesCount()
+            << " pictures, "
+            << (raster_cache.EstimateLayerCacheByteSize() +
+                raster_cache.EstimatePictureCacheByteSize())
+            << " bytes" << std::endl;
+
+  std::string output_path;
+  if (command_line.GetOptionValue("output", &output_path)) {
+    sk_sp<SkImage> image = target->Snapshot();
+    sk_sp<SkData> png = image ? image->encodeToData() : nullptr;
+    SkFILEWStream output(output_path.c_str());
+    if (!png || !output.isValid() || !output.write(png->data(), png->size())) {
+      std::cerr << "Could not write " << output_path << "." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace flutter
+
+int main(int argc, char** argv) {
+  return flutter::Replay(fml::CommandLineFromArgcArgv(argc, argv));
+}
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter)
@@ -11,19 +14,154 @@ BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter)
 
 void BackdropFilterLayer::Preroll(PrerollContext* context,
                                   const SkMatrix& matrix) {
+  // A filter applied within an ancestor's saveLayer reads the content of that
+  // layer rather than the content of the surface.
+  const bool inside_save_layer = context->inside_save_layer;
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
+  const size_t diff_subtree_start =
+      context->diff_context ? context->diff_context->BeginSubtree() : 0;
   ContainerLayer::Preroll(context, matrix);
+  // The filter reads what is below the children, so it must be painted.
+  set_opaque_bounds(SkRect::MakeEmpty());
+  // A tile of the frame lacks the pixels around it that the filter reads.
+  if (filter_) {
+    context->needs_single_canvas = true;
+  }
+
+  backdrop_fingerprint_ = 0;
+  if (!filter_ || !context->diff_context) {
+    return;
+  }
+
+  // The filter replaces the pixels within the visible bounds of the layer
+  // with a filtered copy of the content painted before it, which it reads
+  // from a larger area when the filter spreads pixels (e.g. blurs).
+  SkRect visible_bounds = paint_bounds();
+  device_bounds_ = visible_bounds.intersect(context->cull_rect)
+                       ? matrix.mapRect(visible_bounds).roundOut()
+                       : SkIRect::MakeEmpty();
+  const SkIRect readback_bounds =
+      filter_->filterBounds(device_bounds_, matrix,
+                            SkImageFilter::kReverse_MapDirection,
+                            &device_bounds_);
+  const uint64_t backdrop_fingerprint =
+      context->diff_context->AddBackdropRegion(
+          diff_subtree_start, DiffContext::HashFlattenable(filter_.get()),
+          SkRect::Make(device_bounds_), SkRect::Make(readback_bounds));
+
+  // The cached output is drawn in device space, which only matches the
+  // output of the saveLayer for axis aligned layers.
+  if (!inside_save_layer && matrix.isScaleTranslate()) {
+    backdrop_fingerprint_ = backdrop_fingerprint;
+    matrix_ = matrix;
+  }
 }
 
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
+  if (PaintCachedBackdrop(context)) {
+    return;
+  }
+
   Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
       context,
       SkCanvas::SaveLayerRec{&paint_bounds(), nullptr, filter_.get(), 0});
   PaintChildren(context);
 }
 
+bool BackdropFilterLayer::PaintCachedBackdrop(PaintContext& context) const {
+  const RasterCache* raster_cache = context.raster_cache;
+  SkCanvas* canvas = context.internal_nodes_canvas;
+  if (backdrop_fingerprint_ == 0 || !raster_cache ||
+      !context.surface_supports_readback ||
+      context.leaf_nodes_canvas->getTotalMatrix() != matrix_) {
+    return false;
+  }
+  // Outside of the damaged area the saveLayer is culled for free.
+  if (!SkIRect::Intersects(canvas->getDeviceClipBounds(), device_bounds_)) {
+    return false;
+  }
+
+  // The backdrop is read from the surface, so it must be rendered before the
+  // layer is saved.
+  sk_sp<SkImage> rendered;
+  SkIRect rendered_rect;
+  if (!raster_cache->HasBackdrop(backdrop_fingerprint_)) {
+    rendered = RenderBackdrop(context, &rendered_rect);
+    if (!rendered) {
+      return false;
+    }
+    raster_cache->CacheBackdrop(backdrop_fingerprint_, rendered_rect,
+                                rendered);
+  }
+
+  // Like the saveLayer with a backdrop, the children are painted in a layer
+  // that starts with the filtered backdrop.
+  Layer::AutoSaveLayer save =
+      Layer::AutoSaveLayer::Create(context, paint_bounds(), nullptr);
+  if (raster_cache->DrawBackdrop(backdrop_fingerprint_, *canvas)) {
+    if (!rendered) {
+      TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+    }
+  } else {
+    // The cache is over its budget.
+    SkAutoCanvasRestore auto_restore(canvas, true);
+    canvas->resetMatrix();
+    canvas->drawImage(rendered, rendered_rect.fLeft, rendered_rect.fTop);
+  }
+  PaintChildren(context);
+  return true;
+}
+
+sk_sp<SkImage> BackdropFilterLayer::RenderBackdrop(const PaintContext& context,
+                                                   SkIRect* device_rect) const {
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::RenderBackdrop");
+  SkSurface* surface = context.leaf_nodes_canvas->getSurface();
+  if (!surface) {
+    return nullptr;
+  }
+  SkIRect readback_bounds =
+      filter_->filterBounds(device_bounds_, matrix_,
+                            SkImageFilter::kReverse_MapDirection,
+                            &device_bounds_);
+  if (!readback_bounds.intersect(
+          SkIRect::MakeSize(surface->imageInfo().dimensions()))) {
+    return nullptr;
+  }
+  sk_sp<SkImage> snapshot = surface->makeImageSnapshot(readback_bounds);
+  // The snapshot is filtered in its own pixel space, whose origin is the
+  // corner of the area read back.
+  sk_sp<SkImageFilter> filter = filter_->makeWithLocalMatrix(
+      SkMatrix::Concat(SkMatrix::Translate(-readback_bounds.fLeft,
+                                           -readback_bounds.fTop),
+                       matrix_));
+  if (!snapshot || !filter) {
+    return nullptr;
+  }
+
+  SkIRect subset;
+  SkIPoint offset;
+  sk_sp<SkImage> filtered = snapshot->makeWithFilter(
+      context.gr_context, filter.get(),
+      SkIRect::MakeSize(snapshot->dimensions()),
+      device_bounds_.makeOffset(-readback_bounds.fLeft, -readback_bounds.fTop),
+      &subset, &offset);
+  if (!filtered) {
+    return nullptr;
+  }
+  *device_rect = SkIRect::MakeXYWH(offset.fX + readback_bounds.fLeft,
+                                   offset.fY + readback_bounds.fTop,
+                                   subset.width(), subset.height());
+  return filtered->makeSubset(subset, context.gr_context);
+}
+
+void BackdropFilterLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kBackdropFilter);
+  writer.WriteFlattenable(filter_.get());
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
@@ -18,8 +18,31 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "BackdropFilterLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  // The children are filtered or blended as a group.
+  bool CanInheritOpacity() const override { return false; }
+
  private:
+  // Paints the filtered backdrop from the raster cache, filling the cache
+  // first if needed. Returns false if the backdrop must be filtered by
+  // the saveLayer instead.
+  bool PaintCachedBackdrop(PaintContext& context) const;
+
+  // Filters a snapshot of the content painted so far. Returns the output of
+  // the filter and sets |device_rect| to the area it covers.
+  sk_sp<SkImage> RenderBackdrop(const PaintContext& context,
+                                SkIRect* device_rect) const;
+
   sk_sp<SkImageFilter> filter_;
+  // Identifies the output of the filter across frames when it can be cached,
+  // 0 otherwise. Computed during |Preroll| along with the matrix and the
+  // device bounds of the output.
+  uint64_t backdrop_fingerprint_ = 0;
+  SkMatrix matrix_;
+  SkIRect device_bounds_ = SkIRect::MakeEmpty();
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
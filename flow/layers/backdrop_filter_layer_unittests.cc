@@ -182,6 +182,31 @@ TEST_F(BackdropFilterLayerTest, Nested) {
                  MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(BackdropFilterLayerTest, RecordsBackdropRegion) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  auto layer_filter = SkImageFilters::Blur(4.0f, 4.0f, nullptr);
+  auto layer = std::make_shared<BackdropFilterLayer>(layer_filter);
+  layer->Add(std::make_shared<MockLayer>(child_path));
+
+  DiffContext diff_context(SkISize::Make(100, 100));
+  diff_context.AddPaintRegion(1, SkRect::MakeWH(100, 100), SkMatrix(),
+                              kGiantRect);
+  preroll_context()->diff_context = &diff_context;
+  layer->Preroll(preroll_context(), SkMatrix());
+  preroll_context()->diff_context = nullptr;
+
+  // The backdrop no longer forces the whole frame to be repainted.
+  auto regions = diff_context.TakePaintRegions();
+  EXPECT_FALSE(regions.requires_full_repaint);
+  ASSERT_EQ(regions.regions.size(), 3u);
+  const PaintRegion& backdrop = regions.regions[1];
+  EXPECT_EQ(backdrop.bounds, SkRect::Make(child_bounds.roundOut()));
+  // The blur reads the content around its output.
+  EXPECT_TRUE(backdrop.readback_bounds.contains(backdrop.bounds));
+  EXPECT_NE(backdrop.readback_bounds, backdrop.bounds);
+}
+
 TEST_F(BackdropFilterLayerTest, Readback) {
   sk_sp<SkImageFilter> no_filter;
   auto layer_filter = SkImageFilters::Paint(SkPaint(SkColors::kMagenta));
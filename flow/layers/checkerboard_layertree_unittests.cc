@@ -140,22 +140,19 @@ TEST_F(CheckerBoardLayerTest, ClipPathSaveLayerNotCheckBoard) {
   EXPECT_TRUE(layer->needs_painting(paint_context()));
   EXPECT_EQ(mock_layer->parent_cull_rect(), layer_bounds);
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
-  EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_path)}));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(layer_bounds)}));
 
+  // The child paints within the clip, so only the saveLayer remains.
   layer->Paint(paint_context());
   EXPECT_EQ(
       mock_canvas().draw_calls(),
       std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kSoft_ClipEdgeStyle}},
+          {MockCanvas::DrawCall{
+               0,
+               MockCanvas::SaveLayerData{child_bounds, clip_paint, nullptr, 1}},
            MockCanvas::DrawCall{
-               1,
-               MockCanvas::SaveLayerData{child_bounds, clip_paint, nullptr, 2}},
-           MockCanvas::DrawCall{
-               2, MockCanvas::DrawPathData{child_path, child_paint}},
-           MockCanvas::DrawCall{2, MockCanvas::RestoreData{1}},
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
@@ -181,7 +178,8 @@ TEST_F(CheckerBoardLayerTest, ClipPathSaveLayerCheckBoard) {
   EXPECT_TRUE(layer->needs_painting(paint_context()));
   EXPECT_EQ(mock_layer->parent_cull_rect(), layer_bounds);
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
-  EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_path)}));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(layer_bounds)}));
 
   layer->Paint(check_board_context());
   EXPECT_NE(
@@ -224,20 +222,16 @@ TEST_F(CheckerBoardLayerTest, ClipRRectSaveLayerNotCheckBoard) {
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
   EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_rrect)}));
 
+  // The child paints within the clip, so only the saveLayer remains.
   layer->Paint(paint_context());
   EXPECT_EQ(
       mock_canvas().draw_calls(),
       std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kSoft_ClipEdgeStyle}},
+          {MockCanvas::DrawCall{
+               0,
+               MockCanvas::SaveLayerData{child_bounds, clip_paint, nullptr, 1}},
            MockCanvas::DrawCall{
-               1,
-               MockCanvas::SaveLayerData{child_bounds, clip_paint, nullptr, 2}},
-           MockCanvas::DrawCall{
-               2, MockCanvas::DrawPathData{child_path, child_paint}},
-           MockCanvas::DrawCall{2, MockCanvas::RestoreData{1}},
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
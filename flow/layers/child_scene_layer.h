@@ -26,6 +26,8 @@ class ChildSceneLayer : public Layer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "ChildSceneLayer"; }
+
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
 
  private:
@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/layers/clip_path_layer.h"
+
+#include "flutter/flow/layers/layer_tree_capture.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 #include "lib/ui/scenic/cpp/commands.h"
@@ -14,23 +17,81 @@ namespace flutter {
 ClipPathLayer::ClipPathLayer(const SkPath& clip_path, Clip clip_behavior)
     : clip_path_(clip_path), clip_behavior_(clip_behavior) {
   FML_DCHECK(clip_behavior != Clip::none);
+  if (!clip_path_.isInverseFillType()) {
+    SkRect rect;
+    if (clip_path_.isRect(&rect)) {
+      clip_rrect_.setRect(rect);
+      clip_path_is_rrect_ = true;
+    } else if (clip_path_.isOval(&rect)) {
+      clip_rrect_.setOval(rect);
+      clip_path_is_rrect_ = true;
+    } else {
+      clip_path_is_rrect_ = clip_path_.isRRect(&clip_rrect_);
+    }
+  }
+}
+
+bool ClipPathLayer::ClipContains(const SkRect& rect) const {
+  if (clip_path_is_rrect_) {
+    return clip_rrect_.contains(rect);
+  }
+  return !rect.isEmpty() && !clip_path_.isInverseFillType() &&
+         clip_path_.conservativelyContainsRect(rect);
 }
 
 void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ClipPathLayer::Preroll");
 
+  // The clip is redundant when the enclosing clips already remove every pixel
+  // that it would.
+  const SkRect enclosing_clip_pixels = GetEnclosingClipPixels(context);
+  clip_is_redundant_ = ClipContains(enclosing_clip_pixels);
+
   SkRect previous_cull_rect = context->cull_rect;
   SkRect clip_path_bounds = clip_path_.getBounds();
   context->cull_rect.intersect(clip_path_bounds);
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
-  context->mutators_stack.PushClipPath(clip_path_);
+  if (!clip_path_is_rrect_) {
+    context->mutators_stack.PushClipPath(clip_path_);
+  } else if (clip_rrect_.isRect()) {
+    context->mutators_stack.PushClipRect(clip_rrect_.rect());
+  } else {
+    context->mutators_stack.PushClipRRect(clip_rrect_);
+  }
+  Layer::AutoPrerollClipState clip = Layer::AutoPrerollClipState::Create(
+      context, matrix, clip_path_bounds, enclosing_clip_pixels);
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
-  PrerollChildren(context, matrix, &child_paint_bounds);
-  if (child_paint_bounds.intersect(clip_path_bounds)) {
+  {
+    DiffContext::AutoEffect effect(
+        context->diff_context,
+        context->diff_context
+            ? fml::HashCombine(DiffContext::HashPath(clip_path_),
+                               static_cast<int>(clip_behavior_))
+            : 0);
+    PrerollChildren(context, matrix, &child_paint_bounds);
+  }
+  // It is also redundant when the children paint within it.
+  SkRect child_pixels;
+  if (!clip_is_redundant_ &&
+      GetPixelAlignedBounds(matrix, child_paint_bounds, &child_pixels)) {
+    clip_is_redundant_ = ClipContains(child_pixels);
+  }
+  // A redundant clip is not applied, so what the children paint is not
+  // limited to it.
+  if (clip_is_redundant_) {
     set_paint_bounds(child_paint_bounds);
+  } else if (child_paint_bounds.intersect(clip_path_bounds)) {
+    set_paint_bounds(child_paint_bounds);
+  }
+  // Only the inner rect of a rounded rect is known to be within other paths.
+  SkRect opaque_bounds = child_opaque_bounds();
+  if (!clip_path_is_rrect_ ||
+      !opaque_bounds.intersect(GetRRectInnerRect(clip_rrect_))) {
+    opaque_bounds.setEmpty();
   }
+  set_opaque_bounds(opaque_bounds);
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -43,7 +104,7 @@ void ClipPathLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
   FML_DCHECK(needs_system_composite());
 
   // TODO(liyuqian): respect clip_behavior_
-  SceneUpdateContext::Clip clip(context, clip_path_.getBounds());
+  SceneUpdateContext::Clip clip(context, clip_path_.getBounds(), this);
   UpdateSceneChildren(context);
 }
 
@@ -53,9 +114,19 @@ void ClipPathLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ClipPathLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipPath(clip_path_,
-                                          clip_behavior_ != Clip::hardEdge);
+  SkAutoCanvasRestore save(context.internal_nodes_canvas,
+                           !clip_is_redundant_);
+  if (!clip_is_redundant_) {
+    const bool do_anti_alias = clip_behavior_ != Clip::hardEdge;
+    if (!clip_path_is_rrect_) {
+      context.internal_nodes_canvas->clipPath(clip_path_, do_anti_alias);
+    } else if (clip_rrect_.isRect()) {
+      context.internal_nodes_canvas->clipRect(clip_rrect_.rect(),
+                                              do_anti_alias);
+    } else {
+      context.internal_nodes_canvas->clipRRect(clip_rrect_, do_anti_alias);
+    }
+  }
 
   if (UsesSaveLayer()) {
     context.internal_nodes_canvas->saveLayer(paint_bounds(), nullptr);
@@ -69,4 +140,11 @@ void ClipPathLayer::Paint(PaintContext& context) const {
   }
 }
 
+void ClipPathLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kClipPath);
+  writer.WritePath(clip_path_);
+  writer.WriteUInt(clip_behavior_);
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
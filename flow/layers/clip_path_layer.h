@@ -17,10 +17,18 @@ class ClipPathLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "ClipPathLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
+  bool CanInheritOpacity() const override {
+    return !UsesSaveLayer() && ContainerLayer::CanInheritOpacity();
+  }
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
 #endif
@@ -28,6 +36,16 @@ class ClipPathLayer : public ContainerLayer {
  private:
   SkPath clip_path_;
   Clip clip_behavior_;
+  // Whether |clip_path_| is a rect, an oval or a rounded rect, which is then
+  // also held in |clip_rrect_|. Such clips are applied as rect or rrect clips,
+  // which are cheaper than path clips.
+  bool clip_path_is_rrect_ = false;
+  SkRRect clip_rrect_;
+  // Whether the last Preroll() found that the clip removes no pixel, either
+  // because the enclosing clips lie within it or because the children do.
+  bool clip_is_redundant_ = false;
+
+  bool ClipContains(const SkRect& rect) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ClipPathLayer);
 };
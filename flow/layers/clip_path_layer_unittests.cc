@@ -67,7 +67,8 @@ TEST_F(ClipPathLayerTest, PaintingCulledLayerDies) {
   EXPECT_TRUE(layer->needs_painting(paint_context()));
   EXPECT_EQ(mock_layer->parent_cull_rect(), distant_bounds);
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
-  EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_path)}));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(layer_bounds)}));
 
   paint_context().internal_nodes_canvas->clipRect(distant_bounds, false);
   EXPECT_FALSE(mock_layer->needs_painting(paint_context()));
@@ -104,7 +105,8 @@ TEST_F(ClipPathLayerTest, ChildOutsideBounds) {
   EXPECT_TRUE(layer->needs_painting(paint_context()));
   EXPECT_EQ(mock_layer->parent_cull_rect(), intersect_bounds);
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
-  EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_path)}));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(layer_bounds)}));
 
   layer->Paint(paint_context());
   EXPECT_EQ(
@@ -139,19 +141,14 @@ TEST_F(ClipPathLayerTest, FullyContainedChild) {
   EXPECT_TRUE(layer->needs_painting(paint_context()));
   EXPECT_EQ(mock_layer->parent_cull_rect(), layer_bounds);
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
-  EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_path)}));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(layer_bounds)}));
 
+  // The child paints within the clip, so the clip is not applied.
   layer->Paint(paint_context());
-  EXPECT_EQ(
-      mock_canvas().draw_calls(),
-      std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::DrawPathData{child_path, child_paint}},
-           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
 }
 
 TEST_F(ClipPathLayerTest, PartiallyContainedChild) {
@@ -181,7 +178,8 @@ TEST_F(ClipPathLayerTest, PartiallyContainedChild) {
   EXPECT_TRUE(layer->needs_painting(paint_context()));
   EXPECT_EQ(mock_layer->parent_cull_rect(), intersect_bounds);
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
-  EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_path)}));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(layer_bounds)}));
 
   layer->Paint(paint_context());
   EXPECT_EQ(
@@ -196,6 +194,34 @@ TEST_F(ClipPathLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipPathLayerTest, OvalPathIsAppliedAsRRect) {
+  const SkRect child_bounds = SkRect::MakeXYWH(0.0, 0.0, 20.0, 20.0);
+  const SkRect layer_bounds = SkRect::MakeXYWH(5.0, 5.0, 10.0, 10.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPath layer_path = SkPath().addOval(layer_bounds);
+  const SkRRect layer_rrect = SkRRect::MakeOval(layer_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ClipPathLayer>(layer_path, Clip::antiAlias);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(layer->paint_bounds(), layer_bounds);
+  EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_rrect)}));
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRRectData{layer_rrect, SkClipOp::kIntersect,
+                                            MockCanvas::kSoft_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/layers/clip_rect_layer.h"
+
+#include "flutter/flow/layers/layer_tree_capture.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -12,20 +15,59 @@ ClipRectLayer::ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior)
   FML_DCHECK(clip_behavior != Clip::none);
 }
 
+void ClipRectLayer::LatchClipRect(const SkRect& clip_rect) {
+  if (!clip_rect.isFinite()) {
+    FML_LOG(ERROR) << "Ignoring an invalid latched clip rect.";
+    return;
+  }
+  latched_clip_rect_.Latch(clip_rect);
+}
+
 void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ClipRectLayer::Preroll");
+  if (latched_clip_rect_.Apply(&clip_rect_)) {
+    context->subtree_has_changes = true;
+  }
+
+  // The clip is redundant when the enclosing clips already remove every pixel
+  // that it would.
+  const SkRect enclosing_clip_pixels = GetEnclosingClipPixels(context);
+  clip_is_redundant_ = clip_rect_.contains(enclosing_clip_pixels);
 
   SkRect previous_cull_rect = context->cull_rect;
   context->cull_rect.intersect(clip_rect_);
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
   context->mutators_stack.PushClipRect(clip_rect_);
+  Layer::AutoPrerollClipState clip = Layer::AutoPrerollClipState::Create(
+      context, matrix, clip_rect_, enclosing_clip_pixels);
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
-  PrerollChildren(context, matrix, &child_paint_bounds);
-  if (child_paint_bounds.intersect(clip_rect_)) {
+  {
+    DiffContext::AutoEffect effect(
+        context->diff_context,
+        fml::HashCombine(DiffContext::HashRect(clip_rect_),
+                         static_cast<int>(clip_behavior_)));
+    PrerollChildren(context, matrix, &child_paint_bounds);
+  }
+  // It is also redundant when the children paint within it.
+  SkRect child_pixels;
+  if (!clip_is_redundant_ &&
+      GetPixelAlignedBounds(matrix, child_paint_bounds, &child_pixels)) {
+    clip_is_redundant_ = clip_rect_.contains(child_pixels);
+  }
+  // A redundant clip is not applied, so what the children paint is not
+  // limited to it.
+  if (clip_is_redundant_) {
+    set_paint_bounds(child_paint_bounds);
+  } else if (child_paint_bounds.intersect(clip_rect_)) {
     set_paint_bounds(child_paint_bounds);
   }
+  SkRect opaque_bounds = child_opaque_bounds();
+  if (!opaque_bounds.intersect(clip_rect_)) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_bounds(opaque_bounds);
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -38,7 +80,7 @@ void ClipRectLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
   FML_DCHECK(needs_system_composite());
 
   // TODO(liyuqian): respect clip_behavior_
-  SceneUpdateContext::Clip clip(context, clip_rect_);
+  SceneUpdateContext::Clip clip(context, clip_rect_, this);
   UpdateSceneChildren(context);
 }
 
@@ -48,9 +90,12 @@ void ClipRectLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ClipRectLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipRect(clip_rect_,
-                                          clip_behavior_ != Clip::hardEdge);
+  SkAutoCanvasRestore save(context.internal_nodes_canvas,
+                           !clip_is_redundant_);
+  if (!clip_is_redundant_) {
+    context.internal_nodes_canvas->clipRect(clip_rect_,
+                                            clip_behavior_ != Clip::hardEdge);
+  }
 
   if (UsesSaveLayer()) {
     context.internal_nodes_canvas->saveLayer(clip_rect_, nullptr);
@@ -64,4 +109,11 @@ void ClipRectLayer::Paint(PaintContext& context) const {
   }
 }
 
+void ClipRectLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kClipRect);
+  writer.WriteRect(clip_rect_);
+  writer.WriteUInt(clip_behavior_);
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_CLIP_RECT_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/latched_property.h"
 
 namespace flutter {
 
@@ -16,17 +17,33 @@ class ClipRectLayer : public ContainerLayer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "ClipRectLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
+  bool CanInheritOpacity() const override {
+    return !UsesSaveLayer() && ContainerLayer::CanInheritOpacity();
+  }
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
 #endif
 
+  // Replaces the clip of this layer, starting with the next preroll. Like
+  // |TransformLayer::LatchTransform|, this may be called from any thread.
+  void LatchClipRect(const SkRect& clip_rect);
+
  private:
   SkRect clip_rect_;
   Clip clip_behavior_;
+  LatchedProperty<SkRect> latched_clip_rect_;
+  // Whether the last Preroll() found that the clip removes no pixel, either
+  // because the enclosing clips lie within it or because the children do.
+  bool clip_is_redundant_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRectLayer);
 };
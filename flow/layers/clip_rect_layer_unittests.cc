@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/clip_rect_layer.h"
 
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -140,17 +142,11 @@ TEST_F(ClipRectLayerTest, FullyContainedChild) {
   EXPECT_EQ(mock_layer->parent_mutators(),
             std::vector({Mutator(layer_bounds)}));
 
+  // The child paints within the clip, so the clip is not applied.
   layer->Paint(paint_context());
-  EXPECT_EQ(
-      mock_canvas().draw_calls(),
-      std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::DrawPathData{child_path, child_paint}},
-           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
 }
 
 TEST_F(ClipRectLayerTest, PartiallyContainedChild) {
@@ -195,6 +191,73 @@ TEST_F(ClipRectLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipRectLayerTest, NestedClipContainingEnclosingClipIsNotApplied) {
+  const SkRect child_bounds = SkRect::MakeXYWH(0.0, 0.0, 30.0, 30.0);
+  const SkRect outer_bounds = SkRect::MakeXYWH(0.0, 0.0, 10.0, 10.0);
+  const SkRect inner_bounds = SkRect::MakeXYWH(0.0, 0.0, 20.0, 20.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto inner = std::make_shared<ClipRectLayer>(inner_bounds, Clip::antiAlias);
+  auto outer = std::make_shared<ClipRectLayer>(outer_bounds, Clip::hardEdge);
+  inner->Add(mock_layer);
+  outer->Add(inner);
+
+  outer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->enclosing_clip_pixels.isEmpty());
+  // The inner clip is not applied, so its bounds are those of its child.
+  EXPECT_EQ(inner->paint_bounds(), child_bounds);
+  EXPECT_EQ(outer->paint_bounds(), outer_bounds);
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(outer_bounds), Mutator(inner_bounds)}));
+
+  outer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{outer_bounds, SkClipOp::kIntersect,
+                                           MockCanvas::kHard_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
+TEST_F(ClipRectLayerTest, NestedClipSeparatedByTransformOrFilterIsApplied) {
+  const SkRect child_bounds = SkRect::MakeXYWH(0.0, 0.0, 30.0, 30.0);
+  const SkRect outer_bounds = SkRect::MakeXYWH(0.0, 0.0, 10.0, 10.0);
+  const SkRect inner_bounds = SkRect::MakeXYWH(0.0, 0.0, 20.0, 20.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+
+  // The enclosing clip is in other coordinates.
+  auto transformed_child = std::make_shared<MockLayer>(child_path);
+  auto transformed_inner =
+      std::make_shared<ClipRectLayer>(inner_bounds, Clip::hardEdge);
+  auto transform = std::make_shared<TransformLayer>(SkMatrix());
+  auto transformed_outer =
+      std::make_shared<ClipRectLayer>(outer_bounds, Clip::hardEdge);
+  transformed_inner->Add(transformed_child);
+  transform->Add(transformed_inner);
+  transformed_outer->Add(transform);
+  transformed_outer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(transformed_inner->paint_bounds(), inner_bounds);
+
+  // The filter may move clipped pixels back into view.
+  auto filtered_child = std::make_shared<MockLayer>(child_path);
+  auto filtered_inner =
+      std::make_shared<ClipRectLayer>(inner_bounds, Clip::hardEdge);
+  auto filter =
+      std::make_shared<ColorFilterLayer>(SkColorFilters::LinearToSRGBGamma());
+  auto filtered_outer =
+      std::make_shared<ClipRectLayer>(outer_bounds, Clip::hardEdge);
+  filtered_inner->Add(filtered_child);
+  filter->Add(filtered_inner);
+  filtered_outer->Add(filter);
+  filtered_outer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(filtered_inner->paint_bounds(), inner_bounds);
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
@@ -254,5 +317,30 @@ TEST_F(ClipRectLayerTest, Readback) {
   EXPECT_TRUE(ReadbackResult(context, save_layer, reader, true));
 }
 
+TEST_F(ClipRectLayerTest, LatchedClipRectAppliesFromNextPreroll) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(20.0f, 20.0f));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto layer = std::make_shared<ClipRectLayer>(SkRect::MakeWH(10.0f, 10.0f),
+                                               Clip::hardEdge);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(layer->paint_bounds(), SkRect::MakeWH(10.0f, 10.0f));
+
+  const SkRect latched_clip_rect = SkRect::MakeXYWH(5.0f, 5.0f, 10.0f, 10.0f);
+  layer->LatchClipRect(latched_clip_rect);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(layer->paint_bounds(), latched_clip_rect);
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(latched_clip_rect)}));
+  EXPECT_TRUE(preroll_context()->subtree_has_changes);
+
+  // Latching the current clip again is not a change.
+  preroll_context()->subtree_has_changes = false;
+  layer->LatchClipRect(latched_clip_rect);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(preroll_context()->subtree_has_changes);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/layers/clip_rrect_layer.h"
+
+#include "flutter/flow/layers/layer_tree_capture.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -12,8 +15,24 @@ ClipRRectLayer::ClipRRectLayer(const SkRRect& clip_rrect, Clip clip_behavior)
   FML_DCHECK(clip_behavior != Clip::none);
 }
 
+void ClipRRectLayer::LatchClipRRect(const SkRRect& clip_rrect) {
+  if (!clip_rrect.isValid() || !clip_rrect.getBounds().isFinite()) {
+    FML_LOG(ERROR) << "Ignoring an invalid latched clip rrect.";
+    return;
+  }
+  latched_clip_rrect_.Latch(clip_rrect);
+}
+
 void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ClipRRectLayer::Preroll");
+  if (latched_clip_rrect_.Apply(&clip_rrect_)) {
+    context->subtree_has_changes = true;
+  }
+
+  // The clip is redundant when the enclosing clips already remove every pixel
+  // that it would.
+  const SkRect enclosing_clip_pixels = GetEnclosingClipPixels(context);
+  clip_is_redundant_ = clip_rrect_.contains(enclosing_clip_pixels);
 
   SkRect previous_cull_rect = context->cull_rect;
   SkRect clip_rrect_bounds = clip_rrect_.getBounds();
@@ -21,12 +40,37 @@ void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
   context->mutators_stack.PushClipRRect(clip_rrect_);
+  Layer::AutoPrerollClipState clip = Layer::AutoPrerollClipState::Create(
+      context, matrix, clip_rrect_bounds, enclosing_clip_pixels);
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
-  PrerollChildren(context, matrix, &child_paint_bounds);
-  if (child_paint_bounds.intersect(clip_rrect_bounds)) {
+  {
+    DiffContext::AutoEffect effect(
+        context->diff_context,
+        context->diff_context
+            ? fml::HashCombine(DiffContext::HashRRect(clip_rrect_),
+                               static_cast<int>(clip_behavior_))
+            : 0);
+    PrerollChildren(context, matrix, &child_paint_bounds);
+  }
+  // It is also redundant when the children paint within it.
+  SkRect child_pixels;
+  if (!clip_is_redundant_ &&
+      GetPixelAlignedBounds(matrix, child_paint_bounds, &child_pixels)) {
+    clip_is_redundant_ = clip_rrect_.contains(child_pixels);
+  }
+  // A redundant clip is not applied, so what the children paint is not
+  // limited to it.
+  if (clip_is_redundant_) {
+    set_paint_bounds(child_paint_bounds);
+  } else if (child_paint_bounds.intersect(clip_rrect_bounds)) {
     set_paint_bounds(child_paint_bounds);
   }
+  SkRect opaque_bounds = child_opaque_bounds();
+  if (!opaque_bounds.intersect(GetRRectInnerRect(clip_rrect_))) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_bounds(opaque_bounds);
 
   context->mutators_stack.Pop();
   context->cull_rect = previous_cull_rect;
@@ -39,7 +83,7 @@ void ClipRRectLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
   FML_DCHECK(needs_system_composite());
 
   // TODO(liyuqian): respect clip_behavior_
-  SceneUpdateContext::Clip clip(context, clip_rrect_.getBounds());
+  SceneUpdateContext::Clip clip(context, clip_rrect_.getBounds(), this);
   UpdateSceneChildren(context);
 }
 
@@ -49,9 +93,12 @@ void ClipRRectLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ClipRRectLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipRRect(clip_rrect_,
-                                           clip_behavior_ != Clip::hardEdge);
+  SkAutoCanvasRestore save(context.internal_nodes_canvas,
+                           !clip_is_redundant_);
+  if (!clip_is_redundant_) {
+    context.internal_nodes_canvas->clipRRect(clip_rrect_,
+                                             clip_behavior_ != Clip::hardEdge);
+  }
 
   if (UsesSaveLayer()) {
     context.internal_nodes_canvas->saveLayer(paint_bounds(), nullptr);
@@ -65,4 +112,11 @@ void ClipRRectLayer::Paint(PaintContext& context) const {
   }
 }
 
+void ClipRRectLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kClipRRect);
+  writer.WriteRRect(clip_rrect_);
+  writer.WriteUInt(clip_behavior_);
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
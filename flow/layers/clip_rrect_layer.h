@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_CLIP_RRECT_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/latched_property.h"
 
 namespace flutter {
 
@@ -17,17 +18,33 @@ class ClipRRectLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "ClipRRectLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
+  bool CanInheritOpacity() const override {
+    return !UsesSaveLayer() && ContainerLayer::CanInheritOpacity();
+  }
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
 #endif
 
+  // Replaces the clip of this layer, starting with the next preroll. Like
+  // |TransformLayer::LatchTransform|, this may be called from any thread.
+  void LatchClipRRect(const SkRRect& clip_rrect);
+
  private:
   SkRRect clip_rrect_;
   Clip clip_behavior_;
+  LatchedProperty<SkRRect> latched_clip_rrect_;
+  // Whether the last Preroll() found that the clip removes no pixel, either
+  // because the enclosing clips lie within it or because the children do.
+  bool clip_is_redundant_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRRectLayer);
 };
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/color_filter_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+
 namespace flutter {
 
 ColorFilterLayer::ColorFilterLayer(sk_sp<SkColorFilter> filter)
@@ -13,19 +16,71 @@ void ColorFilterLayer::Preroll(PrerollContext* context,
                                const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
+  DiffContext::AutoEffect effect(
+      context->diff_context,
+      context->diff_context ? DiffContext::HashFlattenable(filter_.get()) : 0);
   ContainerLayer::Preroll(context, matrix);
+  // The filter may make the children translucent.
+  set_opaque_bounds(SkRect::MakeEmpty());
+
+  // A filter that changes transparent black also changes the pixels of the
+  // saveLayer that the child does not paint, which the child would not
+  // reproduce.
+  child_inherits_color_filter_ =
+      layers().size() == 1 && layers()[0]->CanInheritColorFilter() &&
+      (!filter_ ||
+       filter_->filterColor(SK_ColorTRANSPARENT) == SK_ColorTRANSPARENT);
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ColorFilterLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  SkPaint paint;
-  paint.setColorFilter(filter_);
+  // The filter of this layer applies first, then the one of the parents that
+  // skipped their saveLayer, then the opacity.
+  sk_sp<SkColorFilter> filter = filter_;
+  if (context.inherited_color_filter) {
+    filter = context.inherited_color_filter->makeComposed(filter);
+  }
+  if (context.inherited_opacity < SK_Scalar1) {
+    // Scales the alpha of the unpremultiplied colors, which scales all the
+    // components of the premultiplied ones like an opacity does.
+    const float opacity = context.inherited_opacity;
+    const float matrix[20] = {
+        1, 0, 0, 0,       0,  //
+        0, 1, 0, 0,       0,  //
+        0, 0, 1, 0,       0,  //
+        0, 0, 0, opacity, 0,  //
+    };
+    filter = SkColorFilters::Matrix(matrix)->makeComposed(filter);
+  }
+
+  const SkScalar saved_opacity = context.inherited_opacity;
+  const sk_sp<SkColorFilter> saved_color_filter =
+      std::move(context.inherited_color_filter);
+  context.inherited_opacity = SK_Scalar1;
+
+  if (child_inherits_color_filter_) {
+    context.inherited_color_filter = std::move(filter);
+    PaintChildren(context);
+  } else {
+    context.inherited_color_filter = nullptr;
+    SkPaint paint;
+    paint.setColorFilter(std::move(filter));
+
+    Layer::AutoSaveLayer save =
+        Layer::AutoSaveLayer::Create(context, paint_bounds(), &paint);
+    PaintChildren(context);
+  }
+
+  context.inherited_opacity = saved_opacity;
+  context.inherited_color_filter = saved_color_filter;
+}
 
-  Layer::AutoSaveLayer save =
-      Layer::AutoSaveLayer::Create(context, paint_bounds(), &paint);
-  PaintChildren(context);
+void ColorFilterLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kColorFilter);
+  writer.WriteFlattenable(filter_.get());
+  CaptureChildren(writer);
 }
 
 }  // namespace flutter
@@ -18,8 +18,23 @@ class ColorFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "ColorFilterLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  // The opacity is applied by the color filter of the saveLayer of the
+  // children, composed after the filter of the layer.
+  bool CanInheritOpacity() const override { return true; }
+
+  // The filters are composed into the color filter of the saveLayer.
+  bool CanInheritColorFilter() const override { return true; }
+
  private:
   sk_sp<SkColorFilter> filter_;
+  // Whether the only child applies the filter of this layer, composed with
+  // its own effects, so that this layer does not need a saveLayer. Stacked
+  // color filters then cost a single saveLayer.
+  bool child_inherits_color_filter_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ColorFilterLayer);
 };
@@ -195,6 +195,92 @@ TEST_F(ColorFilterLayerTest, Nested) {
                    MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ColorFilterLayerTest, StackedFiltersShareASaveLayer) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto outer_filter =
+      SkColorMatrixFilter::MakeLightingFilter(SK_ColorGREEN, SK_ColorBLACK);
+  auto inner_filter =
+      SkColorMatrixFilter::MakeLightingFilter(SK_ColorGRAY, SK_ColorBLUE);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto outer = std::make_shared<ColorFilterLayer>(outer_filter);
+  auto inner = std::make_shared<ColorFilterLayer>(inner_filter);
+  inner->Add(mock_layer);
+  outer->Add(inner);
+
+  outer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(outer->paint_bounds(), child_bounds);
+  outer->Paint(paint_context());
+
+  const auto& draw_calls = mock_canvas().draw_calls();
+  ASSERT_EQ(draw_calls.size(), 3u);
+  const auto& save_layer =
+      std::get<MockCanvas::SaveLayerData>(draw_calls[0].data);
+  EXPECT_EQ(save_layer.save_bounds, child_bounds);
+  EXPECT_EQ(draw_calls[1],
+            (MockCanvas::DrawCall{
+                1, MockCanvas::DrawPathData{child_path, child_paint}}));
+  EXPECT_EQ(draw_calls[2],
+            (MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}));
+
+  // The inner filter applies first.
+  SkColorFilter* filter = save_layer.restore_paint.getColorFilter();
+  ASSERT_NE(filter, nullptr);
+  const SkColor inner_filtered = inner_filter->filterColor(SK_ColorWHITE);
+  EXPECT_EQ(filter->filterColor(SK_ColorWHITE),
+            outer_filter->filterColor(inner_filtered));
+  EXPECT_EQ(paint_context().inherited_color_filter, nullptr);
+}
+
+TEST_F(ColorFilterLayerTest, FiltersChangingTransparentBlackAreNotInherited) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(10, 10));
+  auto outer_filter =
+      SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kDstOver);
+  auto inner_filter =
+      SkColorMatrixFilter::MakeLightingFilter(SK_ColorGRAY, SK_ColorBLUE);
+  auto outer = std::make_shared<ColorFilterLayer>(outer_filter);
+  auto inner = std::make_shared<ColorFilterLayer>(inner_filter);
+  inner->Add(std::make_shared<MockLayer>(child_path));
+  outer->Add(inner);
+
+  outer->Preroll(preroll_context(), SkMatrix());
+  outer->Paint(paint_context());
+
+  // Each layer has its own saveLayer.
+  const auto& draw_calls = mock_canvas().draw_calls();
+  ASSERT_EQ(draw_calls.size(), 5u);
+  EXPECT_TRUE(
+      std::holds_alternative<MockCanvas::SaveLayerData>(draw_calls[0].data));
+  EXPECT_TRUE(
+      std::holds_alternative<MockCanvas::SaveLayerData>(draw_calls[1].data));
+}
+
+TEST_F(ColorFilterLayerTest, InheritsOpacityIntoTheFilter) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  auto layer_filter =
+      SkColorMatrixFilter::MakeLightingFilter(SK_ColorGRAY, SK_ColorBLUE);
+  auto layer = std::make_shared<ColorFilterLayer>(layer_filter);
+  layer->Add(std::make_shared<MockLayer>(child_path));
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(layer->CanInheritOpacity());
+  paint_context().inherited_opacity = 0.5f;
+  layer->Paint(paint_context());
+  EXPECT_EQ(paint_context().inherited_opacity, 0.5f);
+
+  const auto& draw_calls = mock_canvas().draw_calls();
+  ASSERT_EQ(draw_calls.size(), 3u);
+  const auto& save_layer =
+      std::get<MockCanvas::SaveLayerData>(draw_calls[0].data);
+  SkColorFilter* filter = save_layer.restore_paint.getColorFilter();
+  ASSERT_NE(filter, nullptr);
+  const SkColor filtered = layer_filter->filterColor(SK_ColorWHITE);
+  EXPECT_NEAR(SkColorGetA(filter->filterColor(SK_ColorWHITE)),
+              SkColorGetA(filtered) / 2.0, 1.0);
+}
+
 TEST_F(ColorFilterLayerTest, Readback) {
   auto layer_filter = SkColorFilters::LinearToSRGBGamma();
   auto initial_transform = SkMatrix();
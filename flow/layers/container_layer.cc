@@ -4,10 +4,47 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include <algorithm>
+#include <atomic>
 #include <optional>
 
+#include "flutter/flow/paint_utils.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
 namespace flutter {
 
+namespace {
+
+// Containers with fewer children are always prerolled serially, as the cost
+// of dispatching the work would outweigh the benefits.
+constexpr size_t kMinParallelPrerollChildCount = 16;
+
+// The maximum number of groups of children prerolled in parallel.
+constexpr size_t kMaxParallelPrerollTasks = 8;
+
+// Returns the rect, in the coordinates of |matrix|, of the device pixels that
+// |rect| covers entirely, or an empty rect when |matrix| does not keep rects
+// axis aligned. Leaf layers may snap their content to integral device
+// translations, which moves it by up to half a pixel, so one pixel is given
+// up on each side for both the occluding and the occluded content.
+SkRect GetCoveredPixels(const SkMatrix& matrix, const SkRect& rect) {
+  SkMatrix inverse;
+  if (rect.isEmpty() || !matrix.rectStaysRect() || !matrix.invert(&inverse)) {
+    return SkRect::MakeEmpty();
+  }
+  SkRect device_rect = matrix.mapRect(rect);
+  device_rect.inset(1, 1);
+  SkIRect pixels;
+  device_rect.roundIn(&pixels);
+  if (pixels.isEmpty()) {
+    return SkRect::MakeEmpty();
+  }
+  return inverse.mapRect(SkRect::Make(pixels));
+}
+
+}  // namespace
+
 ContainerLayer::ContainerLayer() {}
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
@@ -20,6 +57,7 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_bounds(child_opaque_bounds());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -28,6 +66,19 @@ void ContainerLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+void ContainerLayer::AccumulateStats(FrameStats* stats) const {
+  Layer::AccumulateStats(stats);
+  for (auto& layer : layers_) {
+    layer->AccumulateStats(stats);
+  }
+}
+
+void ContainerLayer::FindScrollLayers(std::vector<ScrollLayer*>* layers) {
+  for (auto& layer : layers_) {
+    layer->FindScrollLayers(layers);
+  }
+}
+
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      const SkMatrix& child_matrix,
                                      SkRect* child_paint_bounds) {
@@ -42,14 +93,46 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // Platform views have no children, so context->has_platform_view should
   // always be false.
   FML_DCHECK(!context->has_platform_view);
+
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+  // Platform views are prerolled through the view embedder, which is not
+  // thread safe, and neither is the layer cost profile.
+  if (context->preroll_task_runner && context->view_embedder == nullptr &&
+      context->layer_cost_profile == nullptr &&
+      context->deferred_raster_cache_preparations == nullptr &&
+      layers_.size() >= kMinParallelPrerollChildCount) {
+    const bool surface_needs_readback = context->surface_needs_readback;
+    context->surface_needs_readback = false;
+    PrerollChildrenInParallel(context, child_matrix, child_paint_bounds);
+    UpdateChildrenCanInheritOpacity();
+    UpdateChildrenOcclusion(child_matrix, !context->has_platform_view &&
+                                              !context->surface_needs_readback);
+    context->surface_needs_readback =
+        surface_needs_readback || context->surface_needs_readback;
+    return;
+  }
+#endif
+
   bool child_has_platform_view = false;
+  const bool surface_needs_readback = context->surface_needs_readback;
+  context->surface_needs_readback = false;
   for (auto& layer : layers_) {
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
     // sibling tree.
     context->has_platform_view = false;
 
-    layer->Preroll(context, child_matrix);
+    const bool had_changes = context->subtree_has_changes;
+    context->subtree_has_changes = false;
+    {
+      LayerCostProfile::AutoScope cost_scope(
+          context->layer_cost_profile, layer->unique_id(),
+          layer->GetTypeName(), LayerCostProfile::kPreroll);
+      layer->Preroll(context, child_matrix);
+    }
+    layer->set_subtree_has_changes(context->subtree_has_changes);
+    context->subtree_has_changes =
+        had_changes || context->subtree_has_changes;
 
     if (layer->needs_system_composite()) {
       set_needs_system_composite(true);
@@ -61,6 +144,11 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   }
 
   context->has_platform_view = child_has_platform_view;
+  UpdateChildrenCanInheritOpacity();
+  UpdateChildrenOcclusion(child_matrix, !child_has_platform_view &&
+                                            !context->surface_needs_readback);
+  context->surface_needs_readback =
+      surface_needs_readback || context->surface_needs_readback;
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   if (child_layer_exists_below_) {
@@ -71,6 +159,175 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
 #endif
 }
 
+void ContainerLayer::UpdateChildrenCanInheritOpacity() {
+  children_can_inherit_opacity_ = !layers_.empty();
+  // The union of the bounds of the children checked so far.
+  SkRect covered = SkRect::MakeEmpty();
+  for (auto& layer : layers_) {
+    const SkRect& bounds = layer->paint_bounds();
+    // Antialiased edges of children that only touch share pixels, so touching
+    // bounds count as overlapping.
+    const bool overlaps = !covered.isEmpty() && !bounds.isEmpty() &&
+                          bounds.fLeft <= covered.fRight &&
+                          covered.fLeft <= bounds.fRight &&
+                          bounds.fTop <= covered.fBottom &&
+                          covered.fTop <= bounds.fBottom;
+    if (overlaps || !layer->CanInheritOpacity()) {
+      children_can_inherit_opacity_ = false;
+      return;
+    }
+    covered.join(bounds);
+  }
+}
+
+void ContainerLayer::UpdateChildrenOcclusion(const SkMatrix& child_matrix,
+                                             bool can_occlude) {
+  // The children are checked from the top down. |covered| is the opaque
+  // bounds of the children above the one checked, and |covered_pixels| the
+  // pixels that it hides.
+  SkRect covered = SkRect::MakeEmpty();
+  SkRect covered_pixels = SkRect::MakeEmpty();
+  for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+    Layer* layer = it->get();
+    // System composited layers are not painted into the canvas.
+    SkRect pixels;
+    const bool is_occluded =
+        can_occlude && !covered_pixels.isEmpty() &&
+        !layer->needs_system_composite() &&
+        Layer::GetPixelAlignedBounds(child_matrix, layer->paint_bounds(),
+                                     &pixels) &&
+        covered_pixels.contains(pixels);
+    layer->set_is_occluded(is_occluded);
+    if (!is_occluded && !covered.contains(layer->opaque_bounds())) {
+      AccumulateOpaqueRect(&covered, layer->opaque_bounds());
+      covered_pixels = GetCoveredPixels(child_matrix, covered);
+    }
+  }
+  child_opaque_bounds_ = covered;
+}
+
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+void ContainerLayer::PrerollChildrenInParallel(PrerollContext* context,
+                                               const SkMatrix& child_matrix,
+                                               SkRect* child_paint_bounds) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenInParallel");
+
+  // The children are split into contiguous groups. Each group is prerolled
+  // with its own copy of the mutable parts of the context, which are then
+  // merged in the order of the children so that the result is the same as
+  // a serial preroll.
+  struct Group {
+    MutatorsStack mutators_stack;
+    std::unique_ptr<DiffContext> diff_context;
+    std::vector<fml::closure> deferred_raster_cache_preparations;
+    bool has_platform_view = false;
+    bool surface_needs_readback = false;
+    bool subtree_has_changes = false;
+    bool needs_single_canvas = false;
+    bool has_running_animations = false;
+  };
+  const size_t group_count =
+      std::min(kMaxParallelPrerollTasks, layers_.size());
+  std::vector<Group> groups(group_count);
+
+  auto preroll_group = [this, context, &child_matrix, &groups,
+                        group_count](size_t index) {
+    Group& group = groups[index];
+    group.mutators_stack = context->mutators_stack;
+    if (context->diff_context) {
+      group.diff_context = context->diff_context->Fork();
+    }
+    PrerollContext group_context = {
+        context->raster_cache,
+        context->gr_context,
+        context->view_embedder,
+        group.mutators_stack,
+        context->dst_color_space,
+        context->cull_rect,
+        context->surface_needs_readback,
+        context->raster_time,
+        context->ui_time,
+        context->texture_registry,
+        context->checkerboard_offscreen_layers,
+        context->frame_device_pixel_ratio,
+        false,                                     // has_platform_view
+        group.diff_context.get(),                  // diff_context
+        nullptr,                                   // preroll_task_runner
+        &group.deferred_raster_cache_preparations  // deferred preparations
+    };
+    group_context.inside_save_layer = context->inside_save_layer;
+    group_context.enclosing_clip_pixels = context->enclosing_clip_pixels;
+    group_context.enclosing_clip_depth = context->enclosing_clip_depth;
+    group_context.animation_time = context->animation_time;
+    const size_t begin = index * layers_.size() / group_count;
+    const size_t end = (index + 1) * layers_.size() / group_count;
+    for (size_t i = begin; i < end; i++) {
+      group_context.has_platform_view = false;
+      group_context.subtree_has_changes = false;
+      layers_[i]->Preroll(&group_context, child_matrix);
+      layers_[i]->set_subtree_has_changes(group_context.subtree_has_changes);
+      group.has_platform_view =
+          group.has_platform_view || group_context.has_platform_view;
+      group.subtree_has_changes =
+          group.subtree_has_changes || group_context.subtree_has_changes;
+    }
+    group.surface_needs_readback = group_context.surface_needs_readback;
+    group.needs_single_canvas = group_context.needs_single_canvas;
+    group.has_running_animations = group_context.has_running_animations;
+  };
+
+  // Groups are claimed by whichever thread gets to them first. The calling
+  // thread claims groups too, so it never waits on a group that no worker has
+  // started. Workers that run after all the groups are claimed return without
+  // touching anything but |state|.
+  struct State {
+    explicit State(size_t count) : finished(count) {}
+    std::atomic<size_t> next_group{0};
+    fml::CountDownLatch finished;
+  };
+  auto state = std::make_shared<State>(group_count);
+  auto claim_groups = [state, group_count, &preroll_group]() {
+    for (size_t index = state->next_group.fetch_add(1); index < group_count;
+         index = state->next_group.fetch_add(1)) {
+      preroll_group(index);
+      state->finished.CountDown();
+    }
+  };
+  for (size_t i = 1; i < group_count; i++) {
+    context->preroll_task_runner->PostTask(claim_groups);
+  }
+  claim_groups();
+  state->finished.Wait();
+
+  bool child_has_platform_view = false;
+  for (auto& group : groups) {
+    if (context->diff_context) {
+      context->diff_context->Join(*group.diff_context);
+    }
+    child_has_platform_view =
+        child_has_platform_view || group.has_platform_view;
+    context->surface_needs_readback =
+        context->surface_needs_readback || group.surface_needs_readback;
+    context->subtree_has_changes =
+        context->subtree_has_changes || group.subtree_has_changes;
+    context->needs_single_canvas =
+        context->needs_single_canvas || group.needs_single_canvas;
+    context->has_running_animations =
+        context->has_running_animations || group.has_running_animations;
+    for (auto& preparation : group.deferred_raster_cache_preparations) {
+      preparation();
+    }
+  }
+  for (auto& layer : layers_) {
+    if (layer->needs_system_composite()) {
+      set_needs_system_composite(true);
+    }
+    child_paint_bounds->join(layer->paint_bounds());
+  }
+  context->has_platform_view = child_has_platform_view;
+}
+#endif
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // We can no longer call FML_DCHECK here on the needs_painting(context)
   // condition as that test is only valid for the PaintContext that
@@ -81,7 +338,10 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
-    if (layer->needs_painting(context)) {
+    if (!layer->is_occluded() && layer->needs_painting(context)) {
+      LayerCostProfile::AutoScope cost_scope(
+          context.layer_cost_profile, layer->unique_id(),
+          layer->GetTypeName(), LayerCostProfile::kPaint);
       layer->Paint(context);
     }
   }
@@ -92,7 +352,18 @@ void ContainerLayer::TryToPrepareRasterCache(PrerollContext* context,
                                              const SkMatrix& matrix) {
   if (!context->has_platform_view && context->raster_cache &&
       SkRect::Intersects(context->cull_rect, layer->paint_bounds())) {
-    context->raster_cache->Prepare(context, layer, matrix);
+    if (auto* deferred = context->deferred_raster_cache_preparations) {
+      // The copy refers to the mutators stack of the parallel preroll task,
+      // which outlives the deferred preparations.
+      PrerollContext prepare_context = *context;
+      prepare_context.diff_context = nullptr;
+      prepare_context.deferred_raster_cache_preparations = nullptr;
+      deferred->push_back([prepare_context, layer, matrix]() mutable {
+        prepare_context.raster_cache->Prepare(&prepare_context, layer, matrix);
+      });
+    } else {
+      context->raster_cache->Prepare(context, layer, matrix);
+    }
   }
 }
 
@@ -112,9 +383,10 @@ void ContainerLayer::UpdateSceneChildren(
 
   std::optional<SceneUpdateContext::Frame> frame;
   if (child_layer_exists_below_) {
-    frame.emplace(
-        context, SkRRect::MakeRect(paint_bounds()), SK_ColorTRANSPARENT,
-        SkScalarRoundToInt(context->alphaf() * 255), "flutter::ContainerLayer");
+    frame.emplace(context, SkRRect::MakeRect(paint_bounds()),
+                  SK_ColorTRANSPARENT,
+                  SkScalarRoundToInt(context->alphaf() * 255),
+                  "flutter::ContainerLayer", this);
     frame->AddPaintLayer(this);
   }
 
@@ -159,4 +431,18 @@ Layer* MergedContainerLayer::GetCacheableChild() const {
   return child_container;
 }
 
+void MergedContainerLayer::CaptureChildren(
+    LayerTreeCaptureWriter& writer) const {
+  writer.WriteChildren(GetChildContainer()->layers());
+}
+
+void ContainerLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kContainer);
+  CaptureChildren(writer);
+}
+
+void ContainerLayer::CaptureChildren(LayerTreeCaptureWriter& writer) const {
+  writer.WriteChildren(layers());
+}
+
 }  // namespace flutter
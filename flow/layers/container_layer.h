@@ -19,6 +19,10 @@ class ContainerLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
+
+  const char* GetTypeName() const override { return "ContainerLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void CheckForChildLayerBelow(PrerollContext* context) override;
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
@@ -26,12 +30,39 @@ class ContainerLayer : public Layer {
 
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
+  // Containers that only group, clip or transform their children can pass an
+  // inherited opacity on to them when the children can all inherit it and do
+  // not overlap. Subclasses that filter or blend their children override this
+  // to return false.
+  bool CanInheritOpacity() const override {
+    return children_can_inherit_opacity_;
+  }
+
+  void AccumulateStats(FrameStats* stats) const override;
+
+  void FindScrollLayers(std::vector<ScrollLayer*>* layers) override;
+
  protected:
   void PrerollChildren(PrerollContext* context,
                        const SkMatrix& child_matrix,
                        SkRect* child_paint_bounds);
   void PaintChildren(PaintContext& context) const;
 
+  // Writes the children for |Capture|.
+  virtual void CaptureChildren(LayerTreeCaptureWriter& writer) const;
+
+  // The opaque bounds of the children, in their coordinates, once they are
+  // prerolled. See |Layer::opaque_bounds|.
+  const SkRect& child_opaque_bounds() const { return child_opaque_bounds_; }
+
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+  // Prerolls groups of children on |context->preroll_task_runner| and merges
+  // the results as if they had been prerolled serially.
+  void PrerollChildrenInParallel(PrerollContext* context,
+                                 const SkMatrix& child_matrix,
+                                 SkRect* child_paint_bounds);
+#endif
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateSceneChildren(std::shared_ptr<SceneUpdateContext> context);
 #endif
@@ -52,6 +83,19 @@ class ContainerLayer : public Layer {
 
  private:
   std::vector<std::shared_ptr<Layer>> layers_;
+  bool children_can_inherit_opacity_ = false;
+
+  SkRect child_opaque_bounds_ = SkRect::MakeEmpty();
+
+  // Updates |children_can_inherit_opacity_| once the children are prerolled.
+  void UpdateChildrenCanInheritOpacity();
+
+  // Marks the children hidden by the opaque content of the children above
+  // them as occluded and updates |child_opaque_bounds_|, once the children
+  // are prerolled. Nothing is occluded unless |can_occlude|: platform views
+  // are composited with what is painted below them, and layers that read
+  // the surface, like backdrop filters, sample it.
+  void UpdateChildrenOcclusion(const SkMatrix& child_matrix, bool can_occlude);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -127,6 +171,10 @@ class MergedContainerLayer : public ContainerLayer {
    */
   Layer* GetCacheableChild() const;
 
+  // Writes the children of the child container, which is recreated when the
+  // capture is read.
+  void CaptureChildren(LayerTreeCaptureWriter& writer) const override;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(MergedContainerLayer);
 };
@@ -4,8 +4,10 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -268,5 +270,203 @@ TEST_F(ContainerLayerTest, MergedMultipleChildren) {
                                                child_path2, child_paint2}}}));
 }
 
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+TEST_F(ContainerLayerTest, ParallelPrerollMatchesSerialPreroll) {
+  constexpr int kChildCount = 40;
+  SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+
+  auto build = [](std::vector<std::shared_ptr<MockLayer>>* children) {
+    auto layer = std::make_shared<ContainerLayer>();
+    for (int i = 0; i < kChildCount; i++) {
+      SkPath path;
+      path.addRect(i * 10.0f, i * 5.0f, i * 10.0f + 8.0f, i * 5.0f + 4.0f);
+      auto child = std::make_shared<MockLayer>(
+          path, SkPaint(), i == 17 /* fake_has_platform_view */,
+          i == 3 /* fake_needs_system_composite */,
+          i == 29 /* fake_reads_surface */);
+      children->push_back(child);
+      layer->Add(child);
+    }
+    return layer;
+  };
+
+  std::vector<std::shared_ptr<MockLayer>> serial_children;
+  auto serial_layer = build(&serial_children);
+  DiffContext serial_diff_context(SkISize::Make(1000, 1000));
+  preroll_context()->diff_context = &serial_diff_context;
+  serial_layer->Preroll(preroll_context(), initial_transform);
+  const bool serial_has_platform_view = preroll_context()->has_platform_view;
+  const bool serial_needs_readback = preroll_context()->surface_needs_readback;
+
+  preroll_context()->has_platform_view = false;
+  preroll_context()->surface_needs_readback = false;
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  std::vector<std::shared_ptr<MockLayer>> parallel_children;
+  auto parallel_layer = build(&parallel_children);
+  DiffContext parallel_diff_context(SkISize::Make(1000, 1000));
+  preroll_context()->diff_context = &parallel_diff_context;
+  preroll_context()->preroll_task_runner = task_runner.get();
+  parallel_layer->Preroll(preroll_context(), initial_transform);
+  preroll_context()->preroll_task_runner = nullptr;
+  preroll_context()->diff_context = nullptr;
+
+  EXPECT_TRUE(serial_has_platform_view);
+  EXPECT_TRUE(serial_needs_readback);
+  EXPECT_EQ(preroll_context()->has_platform_view, serial_has_platform_view);
+  EXPECT_EQ(preroll_context()->surface_needs_readback, serial_needs_readback);
+  EXPECT_EQ(parallel_layer->paint_bounds(), serial_layer->paint_bounds());
+  EXPECT_TRUE(parallel_layer->needs_system_composite());
+  for (int i = 0; i < kChildCount; i++) {
+    EXPECT_EQ(parallel_children[i]->paint_bounds(),
+              serial_children[i]->paint_bounds());
+    EXPECT_EQ(parallel_children[i]->parent_matrix(), initial_transform);
+    EXPECT_EQ(parallel_children[i]->parent_cull_rect(), kGiantRect);
+    EXPECT_FALSE(parallel_children[i]->parent_has_platform_view());
+  }
+
+  auto serial_regions = serial_diff_context.TakePaintRegions();
+  auto parallel_regions = parallel_diff_context.TakePaintRegions();
+  ASSERT_EQ(parallel_regions.regions.size(), serial_regions.regions.size());
+  for (size_t i = 0; i < serial_regions.regions.size(); i++) {
+    EXPECT_EQ(parallel_regions.regions[i].fingerprint,
+              serial_regions.regions[i].fingerprint);
+    EXPECT_EQ(parallel_regions.regions[i].bounds,
+              serial_regions.regions[i].bounds);
+  }
+}
+#endif
+
+TEST_F(ContainerLayerTest, SubtreeChangesAreTrackedPerChild) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto transform_layer = std::make_shared<TransformLayer>(SkMatrix());
+  transform_layer->Add(std::make_shared<MockLayer>(child_path));
+  auto changed_child = std::make_shared<ContainerLayer>();
+  changed_child->Add(transform_layer);
+  auto unchanged_child = std::make_shared<MockLayer>(child_path);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(changed_child);
+  layer->Add(unchanged_child);
+
+  transform_layer->LatchTransform(SkMatrix::Translate(5.0f, 0.0f));
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(transform_layer->subtree_has_changes());
+  EXPECT_TRUE(changed_child->subtree_has_changes());
+  EXPECT_FALSE(unchanged_child->subtree_has_changes());
+  EXPECT_TRUE(preroll_context()->subtree_has_changes);
+
+  preroll_context()->subtree_has_changes = false;
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(transform_layer->subtree_has_changes());
+  EXPECT_FALSE(changed_child->subtree_has_changes());
+  EXPECT_FALSE(preroll_context()->subtree_has_changes);
+}
+
+TEST_F(ContainerLayerTest, ChildrenBelowOpaqueChildrenAreNotPainted) {
+  const SkPath hidden_path = SkPath().addRect(SkRect::MakeLTRB(5, 5, 15, 15));
+  const SkPath visible_path = SkPath().addRect(SkRect::MakeLTRB(5, 5, 25, 15));
+  const SkPath opaque_path = SkPath().addRect(SkRect::MakeLTRB(0, 0, 20, 20));
+  auto hidden_layer = std::make_shared<MockLayer>(hidden_path);
+  auto visible_layer = std::make_shared<MockLayer>(visible_path);
+  auto opaque_layer = std::make_shared<MockLayer>(opaque_path);
+  opaque_layer->set_opaque_bounds(opaque_path.getBounds());
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(hidden_layer);
+  layer->Add(visible_layer);
+  layer->Add(opaque_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(hidden_layer->is_occluded());
+  EXPECT_FALSE(visible_layer->is_occluded());
+  EXPECT_FALSE(opaque_layer->is_occluded());
+  EXPECT_EQ(layer->opaque_bounds(), opaque_path.getBounds());
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector({MockCanvas::DrawCall{
+                       0, MockCanvas::DrawPathData{visible_path, SkPaint()}},
+                   MockCanvas::DrawCall{
+                       0, MockCanvas::DrawPathData{opaque_path, SkPaint()}}}));
+}
+
+TEST_F(ContainerLayerTest, ChildrenBelowOpaqueChildrenAreKeptForReadback) {
+  const SkPath hidden_path = SkPath().addRect(SkRect::MakeLTRB(5, 5, 15, 15));
+  const SkPath opaque_path = SkPath().addRect(SkRect::MakeLTRB(0, 0, 20, 20));
+  auto hidden_layer = std::make_shared<MockLayer>(hidden_path);
+  auto reading_layer = std::make_shared<MockLayer>(
+      hidden_path, SkPaint(), false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */, true /* fake_reads_surface */);
+  auto opaque_layer = std::make_shared<MockLayer>(opaque_path);
+  opaque_layer->set_opaque_bounds(opaque_path.getBounds());
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(hidden_layer);
+  layer->Add(reading_layer);
+  layer->Add(opaque_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_FALSE(hidden_layer->is_occluded());
+  EXPECT_FALSE(reading_layer->is_occluded());
+}
+
+TEST_F(ContainerLayerTest, OpaqueBoundsAreLimitedToWholePixels) {
+  // The opaque layer leaves the edge pixels of the layer below partially
+  // visible once it is snapped to the pixel grid.
+  const SkPath below_path = SkPath().addRect(SkRect::MakeLTRB(1, 1, 19, 19));
+  const SkPath opaque_path =
+      SkPath().addRect(SkRect::MakeLTRB(0.5f, 0.5f, 19.5f, 19.5f));
+  auto below_layer = std::make_shared<MockLayer>(below_path);
+  auto opaque_layer = std::make_shared<MockLayer>(opaque_path);
+  opaque_layer->set_opaque_bounds(opaque_path.getBounds());
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(below_layer);
+  layer->Add(opaque_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(below_layer->is_occluded());
+}
+
+TEST_F(ContainerLayerTest, TransformedOpaqueBoundsOccludeSiblings) {
+  const SkPath hidden_path = SkPath().addRect(SkRect::MakeLTRB(5, 5, 35, 35));
+  const SkPath opaque_path = SkPath().addRect(SkRect::MakeLTRB(0, 0, 20, 20));
+  auto hidden_layer = std::make_shared<MockLayer>(hidden_path);
+  auto opaque_layer = std::make_shared<MockLayer>(opaque_path);
+  opaque_layer->set_opaque_bounds(opaque_path.getBounds());
+  auto scaled_layer = std::make_shared<TransformLayer>(SkMatrix::Scale(2, 2));
+  scaled_layer->Add(opaque_layer);
+  auto rotated_child = std::make_shared<MockLayer>(opaque_path);
+  rotated_child->set_opaque_bounds(opaque_path.getBounds());
+  auto rotated_layer =
+      std::make_shared<TransformLayer>(SkMatrix::RotateDeg(45));
+  rotated_layer->Add(rotated_child);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(hidden_layer);
+  layer->Add(scaled_layer);
+  layer->Add(rotated_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(scaled_layer->opaque_bounds(), SkRect::MakeLTRB(0, 0, 40, 40));
+  EXPECT_TRUE(rotated_layer->opaque_bounds().isEmpty());
+  EXPECT_TRUE(hidden_layer->is_occluded());
+}
+
+TEST_F(ContainerLayerTest, AccumulateStatsCountsNestedLayers) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  auto nested_layer = std::make_shared<TransformLayer>(SkMatrix::Scale(2, 2));
+  nested_layer->Add(std::make_shared<MockLayer>(child_path));
+  nested_layer->Add(std::make_shared<MockLayer>(child_path));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockLayer>(child_path));
+  layer->Add(nested_layer);
+
+  FrameStats stats;
+  layer->AccumulateStats(&stats);
+  EXPECT_EQ(stats.layer_count, 5u);
+  EXPECT_EQ(stats.picture_count, 0u);
+  EXPECT_EQ(stats.op_count, 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/display_list_layer.h"
+
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace flutter {
+
+DisplayListLayer::DisplayListLayer(const SkPoint& offset,
+                                   SkiaGPUObject<DisplayList> display_list,
+                                   bool is_complex,
+                                   bool will_change)
+    : offset_(offset),
+      display_list_(std::move(display_list)),
+      is_complex_(is_complex),
+      will_change_(will_change) {}
+
+void DisplayListLayer::Preroll(PrerollContext* context,
+                               const SkMatrix& matrix) {
+  TRACE_EVENT0("flutter", "DisplayListLayer::Preroll");
+
+#if defined(LEGACY_FUCHSIA_EMBEDDER)
+  CheckForChildLayerBelow(context);
+#endif
+
+  DisplayList* list = display_list();
+
+  if (auto* cache = context->raster_cache) {
+    TRACE_EVENT0("flutter", "DisplayListLayer::RasterCache (Preroll)");
+
+    SkMatrix ctm = matrix;
+    ctm.preTranslate(offset_.x(), offset_.y());
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+    ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+    if (auto* deferred = context->deferred_raster_cache_preparations) {
+      deferred->push_back([cache, gr_context = context->gr_context,
+                           display_list = display_list_.get(), ctm,
+                           dst_color_space = context->dst_color_space,
+                           is_complex = is_complex_,
+                           will_change = will_change_]() {
+        cache->Prepare(gr_context, display_list.get(), ctm, dst_color_space,
+                       is_complex, will_change);
+      });
+    } else {
+      cache->Prepare(context->gr_context, list, ctm, context->dst_color_space,
+                     is_complex_, will_change_);
+    }
+  }
+
+  SkRect bounds = list->bounds().makeOffset(offset_.x(), offset_.y());
+  set_paint_bounds(bounds);
+  set_opaque_bounds(
+      list->opaque_bounds().makeOffset(offset_.x(), offset_.y()));
+
+  if (auto* diff_context = context->diff_context) {
+    diff_context->AddPaintRegion(
+        fml::HashCombine(list->fingerprint(), offset_.x(), offset_.y()),
+        bounds, matrix, context->cull_rect);
+  }
+}
+
+void DisplayListLayer::Paint(PaintContext& context) const {
+  TRACE_EVENT0("flutter", "DisplayListLayer::Paint");
+  FML_DCHECK(display_list_.get());
+  FML_DCHECK(needs_painting(context));
+
+  SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
+  context.leaf_nodes_canvas->translate(offset_.x(), offset_.y());
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  context.leaf_nodes_canvas->setMatrix(RasterCache::GetIntegralTransCTM(
+      context.leaf_nodes_canvas->getTotalMatrix()));
+#endif
+
+  SkPaint paint;
+  paint.setAlphaf(context.inherited_opacity);
+  SkPaint* cache_paint =
+      context.inherited_opacity < SK_Scalar1 ? &paint : nullptr;
+  if (context.raster_cache &&
+      context.raster_cache->Draw(*display_list(), *context.leaf_nodes_canvas,
+                                 cache_paint)) {
+    TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+    return;
+  }
+  display_list()->RenderTo(context.leaf_nodes_canvas,
+                           context.inherited_opacity);
+}
+
+void DisplayListLayer::AccumulateStats(FrameStats* stats) const {
+  Layer::AccumulateStats(stats);
+  stats->picture_count++;
+  stats->op_count += display_list()->op_count();
+}
+
+void DisplayListLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  // Display lists have no serialized form, so they are captured as the
+  // pictures they render to.
+  SkPictureRecorder recorder;
+  display_list()->RenderTo(recorder.beginRecording(display_list()->bounds()));
+  writer.WriteType(CapturedLayerType::kPicture);
+  writer.WritePoint(offset_);
+  writer.WritePicture(*recorder.finishRecordingAsPicture());
+  writer.WriteBool(is_complex_);
+  writer.WriteBool(will_change_);
+}
+
+}  // namespace flutter
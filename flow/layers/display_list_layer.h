@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_DISPLAY_LIST_LAYER_H_
+#define FLUTTER_FLOW_LAYERS_DISPLAY_LIST_LAYER_H_
+
+#include <memory>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/skia_gpu_object.h"
+
+namespace flutter {
+
+class DisplayListLayer : public Layer {
+ public:
+  DisplayListLayer(const SkPoint& offset,
+                   SkiaGPUObject<DisplayList> display_list,
+                   bool is_complex,
+                   bool will_change);
+
+  DisplayList* display_list() const { return display_list_.get().get(); }
+
+  void Preroll(PrerollContext* frame, const SkMatrix& matrix) override;
+
+  void Paint(PaintContext& context) const override;
+
+  const char* GetTypeName() const override { return "DisplayListLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  bool CanInheritOpacity() const override {
+    return display_list()->can_apply_opacity();
+  }
+
+  void AccumulateStats(FrameStats* stats) const override;
+
+ private:
+  SkPoint offset_;
+  // Even though display lists themselves are not GPU resources, they may
+  // reference images that have a reference to a GPU resource.
+  SkiaGPUObject<DisplayList> display_list_;
+  bool is_complex_ = false;
+  bool will_change_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListLayer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_DISPLAY_LIST_LAYER_H_
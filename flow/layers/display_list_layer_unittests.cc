@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/flow/layers/display_list_layer.h"
+
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/testing/skia_gpu_object_layer_test.h"
+#include "flutter/fml/macros.h"
+#include "flutter/testing/mock_canvas.h"
+
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+#include "flutter/flow/raster_cache.h"
+#endif
+
+namespace flutter {
+namespace testing {
+
+using DisplayListLayerTest = SkiaGPUObjectLayerTest;
+
+#ifndef NDEBUG
+TEST_F(DisplayListLayerTest, PaintBeforePrerollInvalidDisplayListDies) {
+  const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
+  auto layer = std::make_shared<DisplayListLayer>(
+      layer_offset, SkiaGPUObject<DisplayList>(), false, false);
+
+  EXPECT_DEATH_IF_SUPPORTED(layer->Paint(paint_context()),
+                            "display_list_\\.get\\(\\)");
+}
+#endif
+
+TEST_F(DisplayListLayerTest, SimpleDisplayList) {
+  const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
+  const SkMatrix layer_offset_matrix =
+      SkMatrix::Translate(layer_offset.fX, layer_offset.fY);
+  const SkRect display_list_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkRect rect = SkRect::MakeLTRB(10.0f, 10.0f, 20.0f, 20.0f);
+  DisplayListCanvasRecorder recorder(display_list_bounds);
+  recorder.drawRect(rect, SkPaint());
+  sk_sp<DisplayList> display_list = recorder.Build();
+  auto layer = std::make_shared<DisplayListLayer>(
+      layer_offset, SkiaGPUObject(display_list, unref_queue()), false, false);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(layer->paint_bounds(),
+            display_list_bounds.makeOffset(layer_offset.fX, layer_offset.fY));
+  EXPECT_EQ(layer->display_list(), display_list.get());
+  EXPECT_TRUE(layer->needs_painting(paint_context()));
+
+  layer->Paint(paint_context());
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{1,
+                            MockCanvas::ConcatMatrixData{layer_offset_matrix}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{RasterCache::GetIntegralTransCTM(
+                  layer_offset_matrix)}},
+#endif
+       MockCanvas::DrawCall{1, MockCanvas::DrawRectData{rect, SkPaint()}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
+TEST_F(DisplayListLayerTest, DisjointDisplayListsInheritOpacity) {
+  const SkRect left_rect = SkRect::MakeLTRB(0.0f, 0.0f, 10.0f, 10.0f);
+  const SkRect right_rect = SkRect::MakeLTRB(20.0f, 0.0f, 30.0f, 10.0f);
+  DisplayListCanvasRecorder left_recorder(left_rect);
+  left_recorder.drawRect(left_rect, SkPaint());
+  DisplayListCanvasRecorder right_recorder(right_rect);
+  right_recorder.drawRect(right_rect, SkPaint());
+  auto left_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0.0f, 0.0f),
+      SkiaGPUObject(left_recorder.Build(), unref_queue()), false, false);
+  auto right_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0.0f, 0.0f),
+      SkiaGPUObject(right_recorder.Build(), unref_queue()), false, false);
+  auto opacity_layer =
+      std::make_shared<OpacityLayer>(128, SkPoint::Make(0.0f, 0.0f));
+  opacity_layer->Add(left_layer);
+  opacity_layer->Add(right_layer);
+
+  opacity_layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(left_layer->CanInheritOpacity());
+  EXPECT_TRUE(right_layer->CanInheritOpacity());
+
+  opacity_layer->Paint(paint_context());
+  SkPaint expected_paint;
+  expected_paint.setAlphaf(128 / 255.f);
+  int draw_rect_count = 0;
+  for (const MockCanvas::DrawCall& call : mock_canvas().draw_calls()) {
+    EXPECT_FALSE(std::holds_alternative<MockCanvas::SaveLayerData>(call.data));
+    if (auto draw_rect = std::get_if<MockCanvas::DrawRectData>(&call.data)) {
+      EXPECT_EQ(draw_rect->paint, expected_paint);
+      draw_rect_count++;
+    }
+  }
+  EXPECT_EQ(draw_rect_count, 2);
+  EXPECT_EQ(paint_context().inherited_opacity, SK_Scalar1);
+}
+
+TEST_F(DisplayListLayerTest, OverlappingDisplayListsUseSaveLayer) {
+  const SkRect rect = SkRect::MakeLTRB(0.0f, 0.0f, 10.0f, 10.0f);
+  DisplayListCanvasRecorder recorder(rect);
+  recorder.drawRect(rect, SkPaint());
+  sk_sp<DisplayList> display_list = recorder.Build();
+  auto opacity_layer =
+      std::make_shared<OpacityLayer>(128, SkPoint::Make(0.0f, 0.0f));
+  opacity_layer->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0.0f, 0.0f), SkiaGPUObject(display_list, unref_queue()),
+      false, false));
+  opacity_layer->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(5.0f, 5.0f), SkiaGPUObject(display_list, unref_queue()),
+      false, false));
+
+  opacity_layer->Preroll(preroll_context(), SkMatrix());
+  opacity_layer->Paint(paint_context());
+  int save_layer_count = 0;
+  for (const MockCanvas::DrawCall& call : mock_canvas().draw_calls()) {
+    if (std::holds_alternative<MockCanvas::SaveLayerData>(call.data)) {
+      save_layer_count++;
+    }
+    if (auto draw_rect = std::get_if<MockCanvas::DrawRectData>(&call.data)) {
+      EXPECT_EQ(draw_rect->paint, SkPaint());
+    }
+  }
+  EXPECT_EQ(save_layer_count, 1);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/image_filter_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
 namespace flutter {
 
 ImageFilterLayer::ImageFilterLayer(sk_sp<SkImageFilter> filter)
@@ -18,6 +21,9 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
 
+  const size_t diff_subtree_start =
+      context->diff_context ? context->diff_context->BeginSubtree() : 0;
+
   SkRect child_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, matrix, &child_bounds);
   if (filter_) {
@@ -29,6 +35,14 @@ void ImageFilterLayer::Preroll(PrerollContext* context,
   }
   set_paint_bounds(child_bounds);
 
+  // The filter may move pixels of the children anywhere within its output
+  // bounds, so any change in the subtree damages all of them.
+  if (auto* diff_context = context->diff_context) {
+    diff_context->CollapseSubtree(
+        diff_subtree_start, DiffContext::HashFlattenable(filter_.get()),
+        child_bounds, matrix, context->cull_rect);
+  }
+
   transformed_filter_ = nullptr;
   if (render_count_ >= kMinimumRendersBeforeCachingFilterLayer) {
     // We have rendered this same ImageFilterLayer object enough
@@ -65,13 +79,26 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ImageFilterLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
+  // The color filter of a parent that skipped its saveLayer. The paint
+  // applies its color filter before its image filter, so the color filter
+  // is composed into the image filter instead, except when drawing the
+  // already filtered output of the layer.
+  const sk_sp<SkColorFilter> color_filter = context.inherited_color_filter;
+  auto with_color_filter = [&color_filter](sk_sp<SkImageFilter> filter) {
+    return color_filter ? SkImageFilters::ColorFilter(color_filter, filter)
+                        : filter;
+  };
+
   if (context.raster_cache) {
-    if (context.raster_cache->Draw(this, *context.leaf_nodes_canvas)) {
+    SkPaint layer_paint;
+    layer_paint.setColorFilter(color_filter);
+    if (context.raster_cache->Draw(this, *context.leaf_nodes_canvas,
+                                   color_filter ? &layer_paint : nullptr)) {
       return;
     }
     if (transformed_filter_) {
       SkPaint paint;
-      paint.setImageFilter(transformed_filter_);
+      paint.setImageFilter(with_color_filter(transformed_filter_));
 
       if (context.raster_cache->Draw(GetCacheableChild(),
                                      *context.leaf_nodes_canvas, &paint)) {
@@ -81,15 +108,25 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
   }
 
   SkPaint paint;
-  paint.setImageFilter(filter_);
-
-  // Normally a save_layer is sized to the current layer bounds, but in this
-  // case the bounds of the child may not be the same as the filtered version
-  // so we use the bounds of the child container which do not include any
-  // modifications that the filter might apply.
-  Layer::AutoSaveLayer save_layer = Layer::AutoSaveLayer::Create(
-      context, GetChildContainer()->paint_bounds(), &paint);
-  PaintChildren(context);
+  paint.setImageFilter(with_color_filter(filter_));
+
+  context.inherited_color_filter = nullptr;
+  {
+    // Normally a save_layer is sized to the current layer bounds, but in this
+    // case the bounds of the child may not be the same as the filtered
+    // version so we use the bounds of the child container which do not
+    // include any modifications that the filter might apply.
+    Layer::AutoSaveLayer save_layer = Layer::AutoSaveLayer::Create(
+        context, GetChildContainer()->paint_bounds(), &paint);
+    PaintChildren(context);
+  }
+  context.inherited_color_filter = color_filter;
+}
+
+void ImageFilterLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kImageFilter);
+  writer.WriteFlattenable(filter_.get());
+  CaptureChildren(writer);
 }
 
 }  // namespace flutter
@@ -18,6 +18,16 @@ class ImageFilterLayer : public MergedContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "ImageFilterLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  // The children are filtered or blended as a group.
+  bool CanInheritOpacity() const override { return false; }
+
+  // The color filter is applied to the output of the image filter.
+  bool CanInheritColorFilter() const override { return true; }
+
  private:
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
@@ -8,6 +8,7 @@
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 
 namespace flutter {
@@ -240,6 +241,43 @@ TEST_F(ImageFilterLayerTest, Nested) {
             }));
 }
 
+TEST_F(ImageFilterLayerTest, InheritedColorFilterFiltersTheOutput) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto layer_filter = SkImageFilter::MakeMatrixFilter(
+      SkMatrix(), SkFilterQuality::kMedium_SkFilterQuality, nullptr);
+  auto color_filter = SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kSrcIn);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ImageFilterLayer>(layer_filter);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(layer->CanInheritColorFilter());
+  paint_context().inherited_color_filter = color_filter;
+  layer->Paint(paint_context());
+  EXPECT_EQ(paint_context().inherited_color_filter, color_filter);
+
+  const auto& draw_calls = mock_canvas().draw_calls();
+  ASSERT_EQ(draw_calls.size(), 3u);
+  const auto& save_layer =
+      std::get<MockCanvas::SaveLayerData>(draw_calls[0].data);
+  EXPECT_EQ(save_layer.restore_paint.getColorFilter(), nullptr);
+  // The color filter applies to the output of the image filter.
+  SkImageFilter* filter = save_layer.restore_paint.getImageFilter();
+  ASSERT_NE(filter, nullptr);
+  SkColorFilter* filter_node = nullptr;
+  ASSERT_TRUE(filter->isColorFilterNode(&filter_node));
+  EXPECT_EQ(filter_node, color_filter.get());
+  SkSafeUnref(filter_node);
+  ASSERT_EQ(filter->countInputs(), 1);
+  EXPECT_EQ(filter->getInput(0), layer_filter.get());
+  // The children are not filtered twice.
+  EXPECT_EQ(draw_calls[1],
+            (MockCanvas::DrawCall{
+                1, MockCanvas::DrawPathData{child_path, child_paint}}));
+}
+
 TEST_F(ImageFilterLayerTest, Readback) {
   auto layer_filter = SkImageFilter::MakeMatrixFilter(
       SkMatrix(), SkFilterQuality::kMedium_SkFilterQuality, nullptr);
@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LATCHED_PROPERTY_H_
+#define FLUTTER_FLOW_LAYERS_LATCHED_PROPERTY_H_
+
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A replacement for a property of a layer that may be latched from any thread
+// while the layer is part of a layer tree waiting to be rasterized, and that
+// the layer applies at the start of its next preroll.
+//
+// Layers that apply a changed value report it through
+// |PrerollContext::subtree_has_changes|, so that the raster cache entries
+// rendered with the previous value are not reused.
+template <typename T>
+class LatchedProperty {
+ public:
+  LatchedProperty() = default;
+
+  void Latch(const T& value) {
+    std::scoped_lock lock(mutex_);
+    latched_ = value;
+  }
+
+  // Moves the latched value, if any, into |value|. Returns true if |value|
+  // changed.
+  bool Apply(T* value) {
+    std::scoped_lock lock(mutex_);
+    if (!latched_.has_value()) {
+      return false;
+    }
+    const bool changed = !(*value == latched_.value());
+    *value = latched_.value();
+    latched_.reset();
+    return changed;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::optional<T> latched_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LatchedProperty);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LATCHED_PROPERTY_H_
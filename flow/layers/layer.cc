@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
 #include "flutter/flow/paint_utils.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 
@@ -37,6 +38,14 @@ Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
   if (save_layer_is_active_) {
     prev_surface_needs_readback_ = preroll_context_->surface_needs_readback;
     preroll_context_->surface_needs_readback = false;
+    prev_inside_save_layer_ = preroll_context_->inside_save_layer;
+    preroll_context_->inside_save_layer = true;
+    // A filter applied to the saveLayer may move pixels that an enclosing
+    // clip removes back into view, and the content of the saveLayer may be
+    // rendered into the raster cache apart from the enclosing clips. Clips
+    // within it must therefore be applied.
+    prev_enclosing_clip_pixels_ = preroll_context_->enclosing_clip_pixels;
+    preroll_context_->enclosing_clip_pixels = SkRect::MakeEmpty();
   }
 }
 
@@ -52,9 +61,65 @@ Layer::AutoPrerollSaveLayerState::~AutoPrerollSaveLayerState() {
   if (save_layer_is_active_) {
     preroll_context_->surface_needs_readback =
         (prev_surface_needs_readback_ || layer_itself_performs_readback_);
+    preroll_context_->inside_save_layer = prev_inside_save_layer_;
+    preroll_context_->enclosing_clip_pixels = prev_enclosing_clip_pixels_;
   }
 }
 
+Layer::AutoPrerollClipState::AutoPrerollClipState(
+    PrerollContext* preroll_context,
+    const SkMatrix& matrix,
+    const SkRect& clip_bounds,
+    const SkRect& enclosing_clip_pixels)
+    : preroll_context_(preroll_context),
+      prev_enclosing_clip_pixels_(preroll_context->enclosing_clip_pixels),
+      prev_enclosing_clip_depth_(preroll_context->enclosing_clip_depth) {
+  SkRect pixels;
+  if (!GetPixelAlignedBounds(matrix, clip_bounds, &pixels)) {
+    pixels = enclosing_clip_pixels;
+  } else if (!enclosing_clip_pixels.isEmpty() &&
+             !pixels.intersect(enclosing_clip_pixels)) {
+    pixels.setEmpty();
+  }
+  preroll_context_->enclosing_clip_pixels = pixels;
+  preroll_context_->enclosing_clip_depth =
+      preroll_context_->mutators_stack.size();
+}
+
+Layer::AutoPrerollClipState Layer::AutoPrerollClipState::Create(
+    PrerollContext* preroll_context,
+    const SkMatrix& matrix,
+    const SkRect& clip_bounds,
+    const SkRect& enclosing_clip_pixels) {
+  return Layer::AutoPrerollClipState(preroll_context, matrix, clip_bounds,
+                                     enclosing_clip_pixels);
+}
+
+Layer::AutoPrerollClipState::~AutoPrerollClipState() {
+  preroll_context_->enclosing_clip_pixels = prev_enclosing_clip_pixels_;
+  preroll_context_->enclosing_clip_depth = prev_enclosing_clip_depth_;
+}
+
+SkRect Layer::GetEnclosingClipPixels(const PrerollContext* context) {
+  // Layers that transform their children push a mutator, after which the
+  // pixels are no longer in the coordinates of the layer being prerolled.
+  if (context->mutators_stack.size() != context->enclosing_clip_depth) {
+    return SkRect::MakeEmpty();
+  }
+  return context->enclosing_clip_pixels;
+}
+
+bool Layer::GetPixelAlignedBounds(const SkMatrix& matrix,
+                                  const SkRect& rect,
+                                  SkRect* pixels) {
+  SkMatrix inverse;
+  if (!matrix.rectStaysRect() || !matrix.invert(&inverse)) {
+    return false;
+  }
+  *pixels = inverse.mapRect(SkRect::Make(matrix.mapRect(rect).roundOut()));
+  return true;
+}
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
 
 void Layer::CheckForChildLayerBelow(PrerollContext* context) {
@@ -73,7 +138,7 @@ void Layer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
 
   SceneUpdateContext::Frame frame(
       context, SkRRect::MakeRect(paint_bounds()), SK_ColorTRANSPARENT,
-      SkScalarRoundToInt(context->alphaf() * 255), "flutter::Layer");
+      SkScalarRoundToInt(context->alphaf() * 255), "flutter::Layer", this);
 
   frame.AddPaintLayer(this);
 }
@@ -113,4 +178,9 @@ Layer::AutoSaveLayer::~AutoSaveLayer() {
   paint_context_.internal_nodes_canvas->restore();
 }
 
+void Layer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kPlaceholder);
+  writer.WriteRect(paint_bounds());
+}
+
 }  // namespace flutter
@@ -9,13 +9,19 @@
 #include <vector>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/frame_stats.h"
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layer_cost_profile.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -40,6 +46,9 @@ static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 // This should be an exact copy of the Clip enum in painting.dart.
 enum Clip { none, hardEdge, antiAlias, antiAliasWithSaveLayer };
 
+class LayerTreeCaptureWriter;
+class ScrollLayer;
+
 struct PrerollContext {
   RasterCache* raster_cache;
   GrDirectContext* gr_context;
@@ -64,6 +73,56 @@ struct PrerollContext {
   // Informs whether a layer needs to be system composited.
   bool child_scene_layer_exists_below = false;
 #endif
+
+  // When set, layers record the content they paint so that the damage
+  // between consecutive frames can be computed for partial repaint.
+  DiffContext* diff_context = nullptr;
+
+  // When set, the children of wide container layers may be prerolled in
+  // parallel on this task runner. See |ContainerLayer::PrerollChildren|.
+  fml::BasicTaskRunner* preroll_task_runner = nullptr;
+
+  // When set, raster cache preparations are appended to this list instead of
+  // being performed immediately, since the raster cache may only be used on
+  // the raster thread. The list runs in order once the parallel preroll that
+  // installed it completes.
+  std::vector<fml::closure>* deferred_raster_cache_preparations = nullptr;
+
+  // Whether an ancestor paints its subtree into a saveLayer, so that what the
+  // layer paints over is not the content of the surface. Maintained by
+  // |Layer::AutoPrerollSaveLayerState|.
+  bool inside_save_layer = false;
+
+  // Whether a layer prerolled so far in the current subtree replaced one of
+  // its properties in place (see |LatchedProperty|). Maintained per child by
+  // |ContainerLayer::PrerollChildren|, see |Layer::subtree_has_changes|.
+  bool subtree_has_changes = false;
+
+  // The device pixels that the clips of the enclosing clip layers may leave
+  // visible, in the coordinates of the layer being prerolled, and the size of
+  // |mutators_stack| for which these coordinates hold. A clip that contains
+  // these pixels does not need to be applied. Maintained by
+  // |Layer::AutoPrerollClipState| and cleared by
+  // |Layer::AutoPrerollSaveLayerState|. See |Layer::GetEnclosingClipPixels|.
+  SkRect enclosing_clip_pixels = SkRect::MakeEmpty();
+  size_t enclosing_clip_depth = 0;
+
+  // Whether a layer prerolled so far must be painted into the whole frame on
+  // the raster thread, because it reads back the pixels painted around it or
+  // paints state that is not thread-safe. Such trees are never split into
+  // tiles painted in parallel. See |LayerTree::Paint|.
+  bool needs_single_canvas = false;
+
+  // When set, the preroll of each layer is timed into this profile. Layers
+  // are then prerolled serially.
+  LayerCostProfile* layer_cost_profile = nullptr;
+
+  // The time at which the layer animations of the frame are evaluated (see
+  // |LayerAnimation|), and whether a layer prerolled so far has an animation
+  // that is still running after it, so that the tree must be rasterized again
+  // for the next frame.
+  fml::TimePoint animation_time;
+  bool has_running_animations = false;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -99,8 +158,53 @@ class Layer {
     bool layer_itself_performs_readback_;
 
     bool prev_surface_needs_readback_;
+    bool prev_inside_save_layer_;
+    SkRect prev_enclosing_clip_pixels_;
   };
 
+  // Used during Preroll by clip layers, once their clip is pushed onto the
+  // mutators stack, to tell their children which device pixels the clip and
+  // the enclosing clips may leave visible. The previous state is restored
+  // upon destruction.
+  class AutoPrerollClipState {
+   public:
+    // |clip_bounds| are the bounds of the clip of the layer in the
+    // coordinates of |matrix|, and |enclosing_clip_pixels| is what
+    // |GetEnclosingClipPixels| returned before the clip was pushed.
+    [[nodiscard]] static AutoPrerollClipState Create(
+        PrerollContext* preroll_context,
+        const SkMatrix& matrix,
+        const SkRect& clip_bounds,
+        const SkRect& enclosing_clip_pixels);
+
+    ~AutoPrerollClipState();
+
+   private:
+    AutoPrerollClipState(PrerollContext* preroll_context,
+                         const SkMatrix& matrix,
+                         const SkRect& clip_bounds,
+                         const SkRect& enclosing_clip_pixels);
+
+    PrerollContext* preroll_context_;
+
+    SkRect prev_enclosing_clip_pixels_;
+    size_t prev_enclosing_clip_depth_;
+  };
+
+  // Returns the device pixels that the clips of the enclosing clip layers may
+  // leave visible, in the coordinates of the layer being prerolled. The rect
+  // is empty when no such clip applies in these coordinates, which is the
+  // case once a transform or a saveLayer separates the layer from the clips.
+  static SkRect GetEnclosingClipPixels(const PrerollContext* context);
+
+  // Sets |pixels| to the rect, in the coordinates of |matrix|, that covers
+  // every device pixel touched by |rect|. A clip that contains these pixels
+  // leaves any content within |rect| untouched, even when anti-aliased.
+  // Returns false when |matrix| does not keep rects axis aligned.
+  static bool GetPixelAlignedBounds(const SkMatrix& matrix,
+                                    const SkRect& rect,
+                                    SkRect* pixels);
+
   struct PaintContext {
     // When splitting the scene into multiple canvases (e.g when embedding
     // a platform view on iOS) during the paint traversal we apply the non leaf
@@ -122,6 +226,25 @@ class Layer {
     const RasterCache* raster_cache;
     const bool checkerboard_offscreen_layers;
     const float frame_device_pixel_ratio;
+    // The time the GPU spent on the recent frames. Null when the GPU time is
+    // not measured.
+    const Stopwatch* gpu_time = nullptr;
+    // The opacity that a parent which skipped its saveLayer expects this layer
+    // to apply to what it paints. Only layers that return true from
+    // |CanInheritOpacity| are painted with an opacity other than 1.
+    SkScalar inherited_opacity = SK_Scalar1;
+    // Whether the content painted so far can be snapshotted from the surface
+    // of |leaf_nodes_canvas|. When false, the surface may not support reads
+    // or the whole frame may be painted into a saveLayer.
+    bool surface_supports_readback = false;
+    // When set, the paint of each layer is timed into this profile, and the
+    // performance overlay shows the costliest layers.
+    LayerCostProfile* layer_cost_profile = nullptr;
+    // The color filter that a parent which skipped its saveLayer expects this
+    // layer to apply to what it paints, after the layer's own effects. Only
+    // layers that return true from |CanInheritColorFilter| are painted with
+    // one.
+    sk_sp<SkColorFilter> inherited_color_filter;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -187,6 +310,53 @@ class Layer {
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.isEmpty(); }
 
+  // Returns a rect, in the same coordinates as the paint bounds, that the
+  // layer covers with opaque content, as determined during Preroll(). It is
+  // empty when the layer does not know of any, which is the default. Layers
+  // below it within the same container may be hidden by it.
+  const SkRect& opaque_bounds() const { return opaque_bounds_; }
+  void set_opaque_bounds(const SkRect& opaque_bounds) {
+    opaque_bounds_ = opaque_bounds;
+  }
+
+  // Whether the layer is hidden by the opaque content of the layers painted
+  // after it within the same container, so that the container does not paint
+  // it. Set during the Preroll() of the container.
+  bool is_occluded() const { return is_occluded_; }
+  void set_is_occluded(bool value) { is_occluded_ = value; }
+
+  // Whether the layer can apply |PaintContext::inherited_opacity| to what it
+  // paints with the same result as if it was painted into a saveLayer
+  // composited with that opacity. This lets an OpacityLayer above skip its
+  // saveLayer. Only valid once Preroll() returned.
+  virtual bool CanInheritOpacity() const { return false; }
+
+  // Whether the layer can apply |PaintContext::inherited_color_filter| to
+  // what it paints with the same result as if it was painted into a saveLayer
+  // composited with that color filter. This lets a ColorFilterLayer above
+  // skip its saveLayer. Only valid once Preroll() returned.
+  virtual bool CanInheritColorFilter() const { return false; }
+
+  // The name of the class of the layer, for attributing costs to types of
+  // layers. See |LayerCostProfile|.
+  virtual const char* GetTypeName() const { return "Layer"; }
+
+  // Adds the layer, and the layers below it, to the layer and op counts of
+  // |stats|.
+  virtual void AccumulateStats(FrameStats* stats) const {
+    stats->layer_count++;
+  }
+
+  // Writes the layer, and the layers below it, to a layer tree capture.
+  // Layers whose content cannot be captured keep this implementation, which
+  // writes a placeholder covering their paint bounds. See
+  // |LayerTreeCaptureWriter|.
+  virtual void Capture(LayerTreeCaptureWriter& writer) const;
+
+  // Appends the scroll layers at or below this layer to |layers|, each
+  // before its descendants and in paint order. See |ScrollLayer|.
+  virtual void FindScrollLayers(std::vector<ScrollLayer*>* layers) {}
+
   // Determines if the Paint() method is necessary based on the properties
   // of the indicated PaintContext object.
   bool needs_painting(PaintContext& context) const {
@@ -200,6 +370,12 @@ class Layer {
 
   uint64_t unique_id() const { return unique_id_; }
 
+  // Whether a property of this layer or of one of its descendants was
+  // replaced in place during the last Preroll(). What was rendered from this
+  // layer before, such as its raster cache entries, is then stale.
+  bool subtree_has_changes() const { return subtree_has_changes_; }
+  void set_subtree_has_changes(bool value) { subtree_has_changes_ = value; }
+
  protected:
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   bool child_layer_exists_below_ = false;
@@ -207,8 +383,11 @@ class Layer {
 
  private:
   SkRect paint_bounds_;
+  SkRect opaque_bounds_ = SkRect::MakeEmpty();
   uint64_t unique_id_;
   bool needs_system_composite_;
+  bool subtree_has_changes_ = false;
+  bool is_occluded_ = false;
 
   static uint64_t NextUniqueID();
 
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_animation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+namespace {
+
+// The coordinate at |m| of a cubic Bézier curve from 0 to 1 with the control
+// points |a| and |b|.
+float EvaluateCubic(float a, float b, float m) {
+  return 3.f * a * (1.f - m) * (1.f - m) * m + 3.f * b * (1.f - m) * m * m +
+         m * m * m;
+}
+
+// Like the framework's Cubic curve, finds the point of the curve at |t| on the
+// x axis by bisection and returns its y coordinate.
+float TransformCubic(float x1, float y1, float x2, float y2, float t) {
+  static constexpr float kCubicErrorBound = 0.001f;
+  static constexpr int kMaxIterations = 32;
+  float start = 0.f;
+  float end = 1.f;
+  float midpoint = 0.5f;
+  for (int i = 0; i < kMaxIterations; i++) {
+    midpoint = (start + end) / 2.f;
+    const float estimate = EvaluateCubic(x1, x2, midpoint);
+    if (std::abs(t - estimate) < kCubicErrorBound) {
+      break;
+    }
+    if (estimate < t) {
+      start = midpoint;
+    } else {
+      end = midpoint;
+    }
+  }
+  return EvaluateCubic(y1, y2, midpoint);
+}
+
+}  // namespace
+
+float EaseLayerAnimationProgress(LayerAnimationCurve curve, float t) {
+  t = std::clamp(t, 0.f, 1.f);
+  if (t == 0.f || t == 1.f) {
+    return t;
+  }
+  switch (curve) {
+    case LayerAnimationCurve::kLinear:
+      return t;
+    case LayerAnimationCurve::kEaseIn:
+      return TransformCubic(0.42f, 0.f, 1.f, 1.f, t);
+    case LayerAnimationCurve::kEaseOut:
+      return TransformCubic(0.f, 0.f, 0.58f, 1.f, t);
+    case LayerAnimationCurve::kEaseInOut:
+      return TransformCubic(0.42f, 0.f, 0.58f, 1.f, t);
+  }
+  return t;
+}
+
+SkMatrix InterpolateLayerProperty(const SkMatrix& begin,
+                                  const SkMatrix& end,
+                                  float t) {
+  SkScalar begin_values[9];
+  SkScalar end_values[9];
+  begin.get9(begin_values);
+  end.get9(end_values);
+  SkScalar values[9];
+  for (int i = 0; i < 9; i++) {
+    values[i] = begin_values[i] + (end_values[i] - begin_values[i]) * t;
+  }
+  SkMatrix result;
+  result.set9(values);
+  return result;
+}
+
+SkAlpha InterpolateLayerProperty(SkAlpha begin, SkAlpha end, float t) {
+  const float value = begin + (static_cast<float>(end) - begin) * t;
+  return static_cast<SkAlpha>(std::clamp(std::round(value), 0.f, 255.f));
+}
+
+}  // namespace flutter
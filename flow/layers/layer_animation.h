@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ANIMATION_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ANIMATION_H_
+
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+
+namespace flutter {
+
+// The easing of a |LayerAnimation|. These match the framework curves of the
+// same names.
+enum class LayerAnimationCurve { kLinear, kEaseIn, kEaseOut, kEaseInOut };
+
+// Maps the linear progress |t| of an animation, in [0, 1], to its eased
+// progress.
+float EaseLayerAnimationProgress(LayerAnimationCurve curve, float t);
+
+// Interpolates between |begin| and |end|. Matrices are interpolated
+// component-wise, which suits translations and scales but not rotations.
+SkMatrix InterpolateLayerProperty(const SkMatrix& begin,
+                                  const SkMatrix& end,
+                                  float t);
+SkAlpha InterpolateLayerProperty(SkAlpha begin, SkAlpha end, float t);
+
+// An animation of a property of a layer that is advanced on the raster thread,
+// so that simple property animations do not need a new layer tree for every
+// frame. The rasterizer keeps drawing the last layer tree while one of its
+// layers reports a running animation (see
+// |PrerollContext::has_running_animations|).
+//
+// Like |LatchedProperty|, an animation may be started from any thread while
+// the layer is part of a layer tree waiting to be rasterized.
+template <typename T>
+class LayerAnimation {
+ public:
+  LayerAnimation() = default;
+
+  void Start(const T& begin,
+             const T& end,
+             fml::TimePoint start_time,
+             fml::TimeDelta duration,
+             LayerAnimationCurve curve) {
+    std::scoped_lock lock(mutex_);
+    animation_ = Animation{begin, end, start_time, duration, curve};
+  }
+
+  void Cancel() {
+    std::scoped_lock lock(mutex_);
+    animation_.reset();
+  }
+
+  // Moves the value of the animation at |time|, if one was started, into
+  // |value|. The animation ends once |time| is past its duration, leaving
+  // |value| at its end value. Returns true if |value| changed.
+  bool Apply(fml::TimePoint time, T* value) {
+    std::scoped_lock lock(mutex_);
+    if (!animation_.has_value()) {
+      return false;
+    }
+    const Animation& animation = animation_.value();
+    const fml::TimeDelta elapsed = time - animation.start_time;
+    T next = animation.end;
+    if (elapsed < animation.duration) {
+      const float t =
+          elapsed <= fml::TimeDelta::Zero()
+              ? 0.f
+              : static_cast<float>(elapsed.ToSecondsF() /
+                                   animation.duration.ToSecondsF());
+      next = InterpolateLayerProperty(
+          animation.begin, animation.end,
+          EaseLayerAnimationProgress(animation.curve, t));
+    } else {
+      animation_.reset();
+    }
+    const bool changed = !(*value == next);
+    *value = next;
+    return changed;
+  }
+
+  // Whether the animation has yet to reach its end value.
+  bool IsRunning() const {
+    std::scoped_lock lock(mutex_);
+    return animation_.has_value();
+  }
+
+ private:
+  struct Animation {
+    T begin;
+    T end;
+    fml::TimePoint start_time;
+    fml::TimeDelta duration;
+    LayerAnimationCurve curve;
+  };
+
+  mutable std::mutex mutex_;
+  std::optional<Animation> animation_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerAnimation);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ANIMATION_H_
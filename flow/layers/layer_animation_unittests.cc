@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_animation.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static fml::TimePoint TimeAt(int64_t millis) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(millis));
+}
+
+TEST(LayerAnimationTest, AdvancesFromBeginToEnd) {
+  LayerAnimation<SkAlpha> animation;
+  SkAlpha alpha = 0;
+  EXPECT_FALSE(animation.IsRunning());
+  EXPECT_FALSE(animation.Apply(TimeAt(0), &alpha));
+
+  animation.Start(0, 200, TimeAt(100), fml::TimeDelta::FromMilliseconds(100),
+                  LayerAnimationCurve::kLinear);
+  EXPECT_FALSE(animation.Apply(TimeAt(50), &alpha));
+  EXPECT_EQ(alpha, 0);
+  EXPECT_TRUE(animation.IsRunning());
+
+  EXPECT_TRUE(animation.Apply(TimeAt(150), &alpha));
+  EXPECT_EQ(alpha, 100);
+  EXPECT_TRUE(animation.IsRunning());
+
+  EXPECT_TRUE(animation.Apply(TimeAt(250), &alpha));
+  EXPECT_EQ(alpha, 200);
+  EXPECT_FALSE(animation.IsRunning());
+
+  // The layer keeps the end value once the animation is over.
+  alpha = 10;
+  EXPECT_FALSE(animation.Apply(TimeAt(300), &alpha));
+  EXPECT_EQ(alpha, 10);
+}
+
+TEST(LayerAnimationTest, CancelStopsTheAnimation) {
+  LayerAnimation<SkAlpha> animation;
+  animation.Start(0, 200, TimeAt(0), fml::TimeDelta::FromMilliseconds(100),
+                  LayerAnimationCurve::kLinear);
+  animation.Cancel();
+  SkAlpha alpha = 50;
+  EXPECT_FALSE(animation.Apply(TimeAt(50), &alpha));
+  EXPECT_EQ(alpha, 50);
+  EXPECT_FALSE(animation.IsRunning());
+}
+
+TEST(LayerAnimationTest, InterpolatesMatrices) {
+  LayerAnimation<SkMatrix> animation;
+  animation.Start(SkMatrix::Translate(0, 0), SkMatrix::Translate(10, 20),
+                  TimeAt(0), fml::TimeDelta::FromMilliseconds(100),
+                  LayerAnimationCurve::kLinear);
+  SkMatrix matrix;
+  EXPECT_TRUE(animation.Apply(TimeAt(25), &matrix));
+  EXPECT_EQ(matrix, SkMatrix::Translate(2.5f, 5));
+}
+
+TEST(LayerAnimationTest, CurvesEaseTheProgress) {
+  for (auto curve :
+       {LayerAnimationCurve::kLinear, LayerAnimationCurve::kEaseIn,
+        LayerAnimationCurve::kEaseOut, LayerAnimationCurve::kEaseInOut}) {
+    EXPECT_EQ(EaseLayerAnimationProgress(curve, 0.f), 0.f);
+    EXPECT_EQ(EaseLayerAnimationProgress(curve, 1.f), 1.f);
+  }
+  EXPECT_EQ(EaseLayerAnimationProgress(LayerAnimationCurve::kLinear, 0.3f),
+            0.3f);
+  EXPECT_LT(EaseLayerAnimationProgress(LayerAnimationCurve::kEaseIn, 0.3f),
+            0.3f);
+  EXPECT_GT(EaseLayerAnimationProgress(LayerAnimationCurve::kEaseOut, 0.3f),
+            0.3f);
+  EXPECT_NEAR(
+      EaseLayerAnimationProgress(LayerAnimationCurve::kEaseInOut, 0.5f), 0.5f,
+      0.01f);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// Allocations larger than this get a block of their own so that they do not
+// waste the remainder of the current block.
+constexpr size_t kMaxSharedAllocationSize = LayerArena::kBlockSize / 4;
+
+std::atomic<size_t> gLiveArenaCount{0};
+
+uint8_t* AlignUp(uint8_t* pointer, size_t alignment) {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+  return reinterpret_cast<uint8_t*>((address + alignment - 1) &
+                                    ~(alignment - 1));
+}
+
+}  // namespace
+
+std::shared_ptr<LayerArena> LayerArena::Create() {
+  return std::shared_ptr<LayerArena>(new LayerArena());
+}
+
+LayerArena::LayerArena() {
+  gLiveArenaCount++;
+}
+
+LayerArena::~LayerArena() {
+  gLiveArenaCount--;
+}
+
+size_t LayerArena::live_count() {
+  return gLiveArenaCount.load();
+}
+
+void* LayerArena::Allocate(size_t size, size_t alignment) {
+  FML_DCHECK(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  bytes_allocated_ += size;
+
+  if (size + alignment > kMaxSharedAllocationSize) {
+    blocks_.emplace_back(new uint8_t[size + alignment]);
+    bytes_reserved_ += size + alignment;
+    return AlignUp(blocks_.back().get(), alignment);
+  }
+
+  uint8_t* aligned = AlignUp(cursor_, alignment);
+  const size_t padding = aligned - cursor_;
+  if (cursor_ == nullptr || padding + size > remaining_) {
+    size_t block_size = next_block_size_;
+    while (block_size < size + alignment) {
+      block_size *= 2;
+    }
+    next_block_size_ = std::min(block_size * 2, kBlockSize);
+    blocks_.emplace_back(new uint8_t[block_size]);
+    bytes_reserved_ += block_size;
+    cursor_ = blocks_.back().get();
+    remaining_ = block_size;
+    aligned = AlignUp(cursor_, alignment);
+  }
+
+  const size_t used = (aligned - cursor_) + size;
+  cursor_ += used;
+  remaining_ -= used;
+  return aligned;
+}
+
+}  // namespace flutter
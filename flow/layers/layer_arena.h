@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A bump allocator for the layers of a single frame.
+//
+// The SceneBuilder creates the leaf layers of a frame in arenas owned by
+// their parent containers so that building the layer tree only bumps a
+// pointer per layer and tearing it down (on the raster thread) frees a
+// handful of blocks instead of every layer individually. Blocks start small
+// and grow up to |kBlockSize|, so that the arena of a container with only a
+// few leaves stays small.
+//
+// Layers created via |Make| are ordinary |std::shared_ptr|s whose control
+// block holds a reference to the arena. The memory of the arena is therefore
+// released when the arena handle and the last layer allocated from it are
+// gone, whichever thread that happens on. Individual deallocations are
+// no-ops.
+//
+// Allocation is not thread safe and must only happen on the thread that
+// builds the frame.
+class LayerArena {
+ public:
+  static constexpr size_t kInitialBlockSize = 1024;
+  static constexpr size_t kBlockSize = 16 * 1024;
+
+  static std::shared_ptr<LayerArena> Create();
+
+  ~LayerArena();
+
+  // Creates a |T| whose storage (and that of its shared_ptr control block)
+  // lives in |arena|.
+  template <typename T, typename... Args>
+  static std::shared_ptr<T> Make(const std::shared_ptr<LayerArena>& arena,
+                                 Args&&... args) {
+    return std::allocate_shared<T>(Allocator<T>(arena),
+                                   std::forward<Args>(args)...);
+  }
+
+  void* Allocate(size_t size, size_t alignment);
+
+  size_t block_count() const { return blocks_.size(); }
+
+  size_t bytes_allocated() const { return bytes_allocated_; }
+
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+  // The number of arenas that are currently alive in the process.
+  static size_t live_count();
+
+  template <typename T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<LayerArena> arena)
+        : arena_(std::move(arena)) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other)  // NOLINT(google-explicit-constructor)
+        : arena_(other.arena()) {}
+
+    T* allocate(size_t count) {
+      return static_cast<T*>(arena_->Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) {}
+
+    const std::shared_ptr<LayerArena>& arena() const { return arena_; }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return arena_ == other.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+      return arena_ != other.arena();
+    }
+
+   private:
+    std::shared_ptr<LayerArena> arena_;
+  };
+
+ private:
+  std::vector<std::unique_ptr<uint8_t[]>> blocks_;
+  uint8_t* cursor_ = nullptr;
+  size_t remaining_ = 0;
+  size_t next_block_size_ = kInitialBlockSize;
+  size_t bytes_allocated_ = 0;
+  size_t bytes_reserved_ = 0;
+
+  LayerArena();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(LayerArenaTest, AllocationsAreAligned) {
+  auto arena = LayerArena::Create();
+  for (size_t alignment : {1u, 2u, 4u, 8u, 16u, 1u, 16u}) {
+    void* pointer = arena->Allocate(3, alignment);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(pointer) % alignment, 0u);
+  }
+  EXPECT_EQ(arena->block_count(), 1u);
+  EXPECT_EQ(arena->bytes_allocated(), 21u);
+}
+
+TEST(LayerArenaTest, SmallAllocationsShareBlocks) {
+  auto arena = LayerArena::Create();
+  for (size_t i = 0; i < 1000; i++) {
+    arena->Allocate(64, 8);
+  }
+  EXPECT_GE(arena->bytes_reserved(), 1000u * 64);
+  EXPECT_LE(arena->bytes_reserved(), 1000u * 64 + LayerArena::kBlockSize);
+}
+
+TEST(LayerArenaTest, BlocksGrowFromTheInitialSize) {
+  auto arena = LayerArena::Create();
+  arena->Allocate(64, 8);
+  EXPECT_EQ(arena->bytes_reserved(), LayerArena::kInitialBlockSize);
+
+  while (arena->bytes_allocated() < 4 * LayerArena::kBlockSize) {
+    arena->Allocate(64, 8);
+  }
+  size_t reserved = arena->bytes_reserved();
+  while (arena->bytes_reserved() == reserved) {
+    arena->Allocate(64, 8);
+  }
+  EXPECT_EQ(arena->bytes_reserved() - reserved, LayerArena::kBlockSize);
+}
+
+TEST(LayerArenaTest, LargeAllocationsGetTheirOwnBlock) {
+  auto arena = LayerArena::Create();
+  uint8_t* small = static_cast<uint8_t*>(arena->Allocate(16, 8));
+  arena->Allocate(LayerArena::kBlockSize * 2, 8);
+  uint8_t* next_small = static_cast<uint8_t*>(arena->Allocate(16, 8));
+  EXPECT_EQ(arena->block_count(), 2u);
+  // The large allocation did not retire the block used for small ones.
+  EXPECT_EQ(next_small, small + 16);
+}
+
+TEST(LayerArenaTest, LayersKeepTheArenaAlive) {
+  auto arena = LayerArena::Create();
+  std::weak_ptr<LayerArena> weak_arena = arena;
+
+  auto root = LayerArena::Make<ContainerLayer>(arena);
+  root->Add(LayerArena::Make<MockLayer>(arena, SkPath()));
+  root->Add(LayerArena::Make<MockLayer>(arena, SkPath()));
+  EXPECT_EQ(arena->block_count(), 1u);
+
+  arena.reset();
+  EXPECT_FALSE(weak_arena.expired());
+  EXPECT_EQ(root->layers().size(), 2u);
+
+  root.reset();
+  EXPECT_TRUE(weak_arena.expired());
+}
+
+TEST(LayerArenaTest, HeapLayersCanBeMixedWithArenaLayers) {
+  auto arena = LayerArena::Create();
+  std::weak_ptr<LayerArena> weak_arena = arena;
+
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(LayerArena::Make<MockLayer>(arena, SkPath()));
+  arena.reset();
+
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(retained);
+  root.reset();
+  EXPECT_FALSE(weak_arena.expired());
+
+  retained.reset();
+  EXPECT_TRUE(weak_arena.expired());
+}
+
+TEST(LayerArenaTest, CountsLiveArenas) {
+  const size_t initial_count = LayerArena::live_count();
+  auto arena = LayerArena::Create();
+  auto layer = LayerArena::Make<MockLayer>(arena, SkPath());
+  EXPECT_EQ(LayerArena::live_count(), initial_count + 1);
+
+  arena.reset();
+  EXPECT_EQ(LayerArena::live_count(), initial_count + 1);
+  layer.reset();
+  EXPECT_EQ(LayerArena::live_count(), initial_count);
+}
+
+// Builds frames the way the SceneBuilder does: the root and its leaves share
+// the frame's arena, and every pushed (retainable) container owns the arena
+// of its own leaves. Retaining one leaf per frame must not pin the arenas of
+// the frames it came from.
+TEST(LayerArenaTest, RetainedLeavesDoNotPinPreviousFrames) {
+  const size_t initial_count = LayerArena::live_count();
+  std::vector<std::shared_ptr<ContainerLayer>> retained;
+  for (int frame = 0; frame < 100; frame++) {
+    auto frame_arena = LayerArena::Create();
+    auto root = LayerArena::Make<ContainerLayer>(frame_arena);
+    root->Add(LayerArena::Make<MockLayer>(frame_arena, SkPath()));
+    for (auto& layer : retained) {
+      root->Add(layer);
+    }
+
+    auto container = std::make_shared<ContainerLayer>();
+    auto leaf_arena = LayerArena::Create();
+    container->Add(LayerArena::Make<MockLayer>(leaf_arena, SkPath()));
+    container->Add(LayerArena::Make<MockLayer>(leaf_arena, SkPath()));
+    root->Add(container);
+    retained.push_back(container);
+  }
+
+  // One arena per retained container, none for the frames that built them.
+  EXPECT_EQ(LayerArena::live_count(), initial_count + retained.size());
+  retained.clear();
+  EXPECT_EQ(LayerArena::live_count(), initial_count);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,13 +4,27 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "flutter/flow/layers/layer.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/utils/SkNWayCanvas.h"
 
 namespace flutter {
 
+namespace {
+
+// Layers that span several tiles are replayed once per tile, so tiles are
+// kept tall enough for that to be cheaper than painting serially.
+constexpr int kMinPaintTileHeight = 128;
+constexpr int kMaxPaintTiles = 8;
+
+}  // namespace
+
 LayerTree::LayerTree(const SkISize& frame_size, float device_pixel_ratio)
     : frame_size_(frame_size),
       device_pixel_ratio_(device_pixel_ratio),
@@ -30,7 +44,8 @@ void LayerTree::RecordBuildTime(fml::TimePoint vsync_start,
 }
 
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
-                        bool ignore_raster_cache) {
+                        bool ignore_raster_cache,
+                        bool collect_paint_regions) {
   TRACE_EVENT0("flutter", "LayerTree::Preroll");
 
   if (!root_layer_) {
@@ -57,7 +72,30 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
 
-  root_layer_->Preroll(&context, frame.root_surface_transformation());
+  context.preroll_task_runner = frame.context().preroll_task_runner();
+  context.layer_cost_profile = frame.context().layer_cost_profile();
+  // Trees built for a frame are evaluated at the time they are presented.
+  // Trees drawn again to advance their animations are past that time.
+  context.animation_time = std::max(target_time_, fml::TimePoint::Now());
+
+  std::optional<DiffContext> diff_context;
+  if (collect_paint_regions) {
+    diff_context.emplace(frame_size_);
+    context.diff_context = &diff_context.value();
+  }
+
+  {
+    LayerCostProfile::AutoScope cost_scope(
+        context.layer_cost_profile, root_layer_->unique_id(),
+        root_layer_->GetTypeName(), LayerCostProfile::kPreroll);
+    root_layer_->Preroll(&context, frame.root_surface_transformation());
+  }
+  needs_single_canvas_ = context.needs_single_canvas;
+  has_running_animations_ = context.has_running_animations;
+
+  if (diff_context) {
+    paint_regions_ = diff_context->TakePaintRegions();
+  }
   return context.surface_needs_readback;
 }
 
@@ -95,8 +133,18 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     return;
   }
 
+  if (PaintInTiles(frame)) {
+    return;
+  }
+
   SkISize canvas_size = frame.canvas()->getBaseLayerSize();
   SkNWayCanvas internal_nodes_canvas(canvas_size.width(), canvas_size.height());
+  // When only part of the frame is repainted, let layers outside of the
+  // damaged area be culled early.
+  if (frame.root_surface_transformation().isIdentity()) {
+    internal_nodes_canvas.clipRect(
+        SkRect::Make(frame.canvas()->getDeviceClipBounds()));
+  }
   internal_nodes_canvas.addCanvas(frame.canvas());
   if (frame.view_embedder() != nullptr) {
     auto overlay_canvases = frame.view_embedder()->GetCurrentCanvases();
@@ -116,12 +164,102 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
       checkerboard_offscreen_layers_,
       device_pixel_ratio_};
+  context.gpu_time = &frame.context().gpu_time();
+  context.surface_supports_readback = frame.surface_supports_readback();
+  context.layer_cost_profile = frame.context().layer_cost_profile();
 
   if (root_layer_->needs_painting(context)) {
+    LayerCostProfile::AutoScope cost_scope(
+        context.layer_cost_profile, root_layer_->unique_id(),
+        root_layer_->GetTypeName(), LayerCostProfile::kPaint);
     root_layer_->Paint(context);
   }
 }
 
+bool LayerTree::PaintInTiles(CompositorContext::ScopedFrame& frame) const {
+  fml::BasicTaskRunner* task_runner =
+      frame.context().tiled_paint_task_runner();
+  // The layer cost profile may only be used on the raster thread.
+  if (!task_runner || needs_single_canvas_ || !frame.canvas() ||
+      frame.gr_context() || frame.view_embedder() ||
+      frame.context().layer_cost_profile()) {
+    return false;
+  }
+  SkSurface* surface = frame.canvas()->getSurface();
+  if (!surface) {
+    return false;
+  }
+  const SkIRect clip_bounds = frame.canvas()->getDeviceClipBounds();
+  const int tile_count =
+      std::min(kMaxPaintTiles, clip_bounds.height() / kMinPaintTileHeight);
+  if (tile_count < 2) {
+    return false;
+  }
+  // The tiles write to the pixels directly, so images snapshotted from the
+  // surface must be detached from them first.
+  surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  SkPixmap pixmap;
+  if (!frame.canvas()->peekPixels(&pixmap)) {
+    return false;
+  }
+
+  TRACE_EVENT0("flutter", "LayerTree::PaintInTiles");
+  const SkMatrix matrix = frame.canvas()->getTotalMatrix();
+  auto paint_tile = [this, &frame, &pixmap, &matrix, &clip_bounds,
+                     tile_count](int index) {
+    TRACE_EVENT0("flutter", "LayerTree::PaintTile");
+    const int top =
+        clip_bounds.top() + clip_bounds.height() * index / tile_count;
+    const int bottom =
+        clip_bounds.top() + clip_bounds.height() * (index + 1) / tile_count;
+    // The tiles share the pixels of the surface but each only draws within
+    // its own rows.
+    std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+        pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+    canvas->clipRect(SkRect::Make(SkIRect::MakeLTRB(
+        clip_bounds.left(), top, clip_bounds.right(), bottom)));
+    canvas->setMatrix(matrix);
+
+    Layer::PaintContext context = {
+        canvas.get(),
+        canvas.get(),
+        nullptr,
+        nullptr,
+        frame.context().raster_time(),
+        frame.context().ui_time(),
+        frame.context().texture_registry(),
+        nullptr,
+        checkerboard_offscreen_layers_,
+        device_pixel_ratio_};
+    context.surface_supports_readback = frame.surface_supports_readback();
+    if (root_layer_->needs_painting(context)) {
+      root_layer_->Paint(context);
+    }
+  };
+
+  // As in |ContainerLayer::PrerollChildren|, tiles are claimed by whichever
+  // thread gets to them first, including the calling thread.
+  struct State {
+    explicit State(int count) : finished(count) {}
+    std::atomic<int> next_tile{0};
+    fml::CountDownLatch finished;
+  };
+  auto state = std::make_shared<State>(tile_count);
+  auto claim_tiles = [state, tile_count, &paint_tile]() {
+    for (int index = state->next_tile.fetch_add(1); index < tile_count;
+         index = state->next_tile.fetch_add(1)) {
+      paint_tile(index);
+      state->finished.CountDown();
+    }
+  };
+  for (int i = 1; i < tile_count; i++) {
+    task_runner->PostTask(claim_tiles);
+  }
+  claim_tiles();
+  state->finished.Wait();
+  return true;
+}
+
 sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
   TRACE_EVENT0("flutter", "LayerTree::Flatten");
 
@@ -7,8 +7,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/diff_context.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
@@ -28,13 +31,25 @@ class LayerTree {
   // - a boolean indicating whether or not the top level of the
   //   layer tree performs any operations that require readback
   //   from the root surface.
+  //
+  // If |collect_paint_regions| is true, the content painted by the tree is
+  // recorded and made available via |paint_regions()| for damage
+  // computation.
   bool Preroll(CompositorContext::ScopedFrame& frame,
-               bool ignore_raster_cache = false);
+               bool ignore_raster_cache = false,
+               bool collect_paint_regions = false);
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context);
 #endif
 
+  // Paints the tree into the canvas of |frame|.
+  //
+  // When the compositor context has a tiled paint task runner and the frame
+  // is drawn to a raster surface, the frame is split into horizontal tiles
+  // that are painted in parallel into the pixels of the surface, each
+  // skipping the subtrees outside of its tile. Tiles do not use the raster
+  // cache, which may only be used on the raster thread.
   void Paint(CompositorContext::ScopedFrame& frame,
              bool ignore_raster_cache = false) const;
 
@@ -46,9 +61,43 @@ class LayerTree {
     root_layer_ = std::move(root_layer);
   }
 
+  // The paint regions recorded by the last |Preroll| that was asked to
+  // collect them, or null if no such preroll took place.
+  const PaintRegionList* paint_regions() const {
+    return paint_regions_ ? &paint_regions_.value() : nullptr;
+  }
+
+  // Whether a layer animation was still running after the last |Preroll|, so
+  // that the tree has to be rasterized again for the next frame even if no
+  // new tree is built.
+  bool has_running_animations() const { return has_running_animations_; }
+
+  // The trace flow id of the last pointer data packet that the framework
+  // received before it built the tree, if any. Scroll offsets in the tree
+  // include the scroll events up to that packet. See
+  // |Rasterizer::HandleCompositorScroll|.
+  std::optional<uint64_t> dispatched_pointer_flow_id() const {
+    return dispatched_pointer_flow_id_;
+  }
+  void set_dispatched_pointer_flow_id(uint64_t flow_id) {
+    dispatched_pointer_flow_id_ = flow_id;
+  }
+
+  // The view the tree was rendered for by the framework. See
+  // |PlatformView::AddView|.
+  int64_t view_id() const { return view_id_; }
+  void set_view_id(int64_t view_id) { view_id_ = view_id; }
+
   const SkISize& frame_size() const { return frame_size_; }
   float device_pixel_ratio() const { return device_pixel_ratio_; }
 
+  // Sizes the tree for the view it is rendered into, when that differs from
+  // the view it was created for.
+  void set_frame_metrics(const SkISize& frame_size, float device_pixel_ratio) {
+    frame_size_ = frame_size;
+    device_pixel_ratio_ = device_pixel_ratio;
+  }
+
   void RecordBuildTime(fml::TimePoint vsync_start,
                        fml::TimePoint build_start,
                        fml::TimePoint target_time);
@@ -79,16 +128,25 @@ class LayerTree {
   }
 
  private:
+  bool PaintInTiles(CompositorContext::ScopedFrame& frame) const;
+
   std::shared_ptr<Layer> root_layer_;
+  std::optional<PaintRegionList> paint_regions_;
   fml::TimePoint vsync_start_;
   fml::TimePoint build_start_;
   fml::TimePoint build_finish_;
   fml::TimePoint target_time_;
+  std::optional<uint64_t> dispatched_pointer_flow_id_;
+  int64_t view_id_ = kFlutterImplicitViewId;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
-  const float device_pixel_ratio_;  // Logical / Physical pixels ratio.
+  float device_pixel_ratio_;  // Logical / Physical pixels ratio.
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
+  // Set by |Preroll|, see |PrerollContext::needs_single_canvas|.
+  bool needs_single_canvas_ = true;
+  // Set by |Preroll|.
+  bool has_running_animations_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
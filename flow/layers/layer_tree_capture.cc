@@ -0,0 +1,440 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_tree_capture.h"
+
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_path_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/image_filter_layer.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/shader_mask_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkShader.h"
+
+namespace flutter {
+
+// "FLTC", for Flutter layer tree capture.
+static constexpr uint32_t kCaptureMagic = 0x43544c46;
+static constexpr uint32_t kCaptureVersion = 1;
+
+// Deeper trees are rejected rather than risking a stack overflow on
+// malformed captures.
+static constexpr size_t kMaxCaptureDepth = 256;
+
+// The color of the placeholders, a mid gray that stands out from most
+// content without hiding what is painted over it.
+static constexpr SkColor kPlaceholderColor =
+    SkColorSetARGB(0x80, 0x80, 0x80, 0x80);
+
+LayerTreeCaptureWriter::LayerTreeCaptureWriter(
+    const SkSerialProcs& picture_procs)
+    : picture_procs_(picture_procs) {}
+
+LayerTreeCaptureWriter::~LayerTreeCaptureWriter() = default;
+
+void LayerTreeCaptureWriter::WriteLayer(const Layer& layer) {
+  layer.Capture(*this);
+}
+
+void LayerTreeCaptureWriter::WriteChildren(
+    const std::vector<std::shared_ptr<Layer>>& layers) {
+  WriteUInt(layers.size());
+  for (const auto& layer : layers) {
+    WriteLayer(*layer);
+  }
+}
+
+void LayerTreeCaptureWriter::WriteType(CapturedLayerType type) {
+  WriteUInt(static_cast<uint32_t>(type));
+}
+
+void LayerTreeCaptureWriter::WriteUInt(uint32_t value) {
+  stream_.write32(value);
+}
+
+void LayerTreeCaptureWriter::WriteBool(bool value) {
+  stream_.writeBool(value);
+}
+
+void LayerTreeCaptureWriter::WriteScalar(SkScalar value) {
+  stream_.writeScalar(value);
+}
+
+void LayerTreeCaptureWriter::WritePoint(const SkPoint& point) {
+  WriteScalar(point.x());
+  WriteScalar(point.y());
+}
+
+void LayerTreeCaptureWriter::WriteRect(const SkRect& rect) {
+  WriteScalar(rect.left());
+  WriteScalar(rect.top());
+  WriteScalar(rect.right());
+  WriteScalar(rect.bottom());
+}
+
+void LayerTreeCaptureWriter::WriteRRect(const SkRRect& rrect) {
+  char buffer[SkRRect::kSizeInMemory];
+  rrect.writeToMemory(buffer);
+  stream_.write(buffer, sizeof(buffer));
+}
+
+void LayerTreeCaptureWriter::WritePath(const SkPath& path) {
+  sk_sp<SkData> data = path.serialize();
+  WriteData(data.get());
+}
+
+void LayerTreeCaptureWriter::WriteMatrix(const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  for (SkScalar value : values) {
+    WriteScalar(value);
+  }
+}
+
+void LayerTreeCaptureWriter::WriteFlattenable(
+    const SkFlattenable* flattenable) {
+  sk_sp<SkData> data = flattenable ? flattenable->serialize() : nullptr;
+  WriteData(data.get());
+}
+
+void LayerTreeCaptureWriter::WritePicture(const SkPicture& picture) {
+  sk_sp<SkData> data = picture.serialize(&picture_procs_);
+  WriteData(data.get());
+}
+
+void LayerTreeCaptureWriter::WriteData(const SkData* data) {
+  const uint32_t size = data ? data->size() : 0;
+  WriteUInt(size);
+  if (size > 0) {
+    stream_.write(data->data(), size);
+  }
+}
+
+sk_sp<SkData> LayerTreeCaptureWriter::Finish() {
+  return stream_.detachAsData();
+}
+
+sk_sp<SkData> CaptureLayerTree(const LayerTree& layer_tree,
+                               const SkSerialProcs& picture_procs) {
+  if (!layer_tree.root_layer()) {
+    return nullptr;
+  }
+  LayerTreeCaptureWriter writer(picture_procs);
+  writer.WriteUInt(kCaptureMagic);
+  writer.WriteUInt(kCaptureVersion);
+  writer.WriteUInt(layer_tree.frame_size().width());
+  writer.WriteUInt(layer_tree.frame_size().height());
+  writer.WriteScalar(layer_tree.device_pixel_ratio());
+  writer.WriteLayer(*layer_tree.root_layer());
+  return writer.Finish();
+}
+
+namespace {
+
+// Reads what |LayerTreeCaptureWriter| wrote. Every read fails once the
+// capture turns out to be truncated or malformed, so that callers only need
+// to check |ok| once they are done.
+class LayerTreeCaptureReader {
+ public:
+  explicit LayerTreeCaptureReader(const SkData& data)
+      : stream_(data.data(), data.size()) {}
+
+  bool ok() const { return ok_; }
+
+  uint32_t ReadUInt() {
+    uint32_t value = 0;
+    ok_ = ok_ && stream_.readU32(&value);
+    return value;
+  }
+
+  bool ReadBool() {
+    bool value = false;
+    ok_ = ok_ && stream_.readBool(&value);
+    return value;
+  }
+
+  SkScalar ReadScalar() {
+    SkScalar value = 0;
+    ok_ = ok_ && stream_.readScalar(&value) && SkScalarIsFinite(value);
+    return value;
+  }
+
+  SkPoint ReadPoint() {
+    const SkScalar x = ReadScalar();
+    const SkScalar y = ReadScalar();
+    return SkPoint::Make(x, y);
+  }
+
+  SkRect ReadRect() {
+    const SkScalar left = ReadScalar();
+    const SkScalar top = ReadScalar();
+    const SkScalar right = ReadScalar();
+    const SkScalar bottom = ReadScalar();
+    return SkRect::MakeLTRB(left, top, right, bottom);
+  }
+
+  SkRRect ReadRRect() {
+    char buffer[SkRRect::kSizeInMemory];
+    SkRRect rrect;
+    ok_ = ok_ && stream_.read(buffer, sizeof(buffer)) == sizeof(buffer) &&
+          rrect.readFromMemory(buffer, sizeof(buffer)) == sizeof(buffer);
+    return rrect;
+  }
+
+  SkPath ReadPath() {
+    SkPath path;
+    sk_sp<SkData> data = ReadData();
+    ok_ = ok_ && data && path.readFromMemory(data->data(), data->size()) > 0;
+    return path;
+  }
+
+  SkMatrix ReadMatrix() {
+    SkScalar values[9];
+    for (SkScalar& value : values) {
+      value = ReadScalar();
+    }
+    SkMatrix matrix;
+    matrix.set9(values);
+    return matrix;
+  }
+
+  // Returns null if a null flattenable was written, in which case |ok| still
+  // holds.
+  template <typename T>
+  sk_sp<T> ReadFlattenable(SkFlattenable::Type type) {
+    sk_sp<SkData> data = ReadData();
+    if (!ok_ || !data) {
+      return nullptr;
+    }
+    sk_sp<SkFlattenable> flattenable =
+        SkFlattenable::Deserialize(type, data->data(), data->size());
+    ok_ = flattenable != nullptr;
+    return sk_sp<T>(static_cast<T*>(flattenable.release()));
+  }
+
+  sk_sp<SkPicture> ReadPicture() {
+    sk_sp<SkData> data = ReadData();
+    sk_sp<SkPicture> picture =
+        data ? SkPicture::MakeFromData(data.get()) : nullptr;
+    ok_ = ok_ && picture;
+    return picture;
+  }
+
+  std::shared_ptr<Layer> ReadLayer(size_t depth);
+
+ private:
+  SkMemoryStream stream_;
+  bool ok_ = true;
+
+  // Returns null for empty data.
+  sk_sp<SkData> ReadData() {
+    const uint32_t size = ReadUInt();
+    if (!ok_ || size == 0) {
+      return nullptr;
+    }
+    if (size > stream_.getLength() - stream_.getPosition()) {
+      ok_ = false;
+      return nullptr;
+    }
+    sk_sp<SkData> data = SkData::MakeUninitialized(size);
+    ok_ = stream_.read(data->writable_data(), size) == size;
+    return data;
+  }
+
+  bool ReadChildren(ContainerLayer* container, size_t depth) {
+    const uint32_t count = ReadUInt();
+    for (uint32_t i = 0; ok_ && i < count; i++) {
+      std::shared_ptr<Layer> child = ReadLayer(depth + 1);
+      if (!child) {
+        return false;
+      }
+      container->Add(std::move(child));
+    }
+    return ok_;
+  }
+
+  Clip ReadClip() {
+    const uint32_t clip = ReadUInt();
+    ok_ = ok_ && clip <= Clip::antiAliasWithSaveLayer;
+    return static_cast<Clip>(clip);
+  }
+
+  static sk_sp<SkPicture> MakePlaceholderPicture(const SkRect& bounds) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(bounds);
+    SkPaint paint;
+    paint.setColor(kPlaceholderColor);
+    canvas->drawRect(bounds, paint);
+    return recorder.finishRecordingAsPicture();
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerTreeCaptureReader);
+};
+
+std::shared_ptr<Layer> LayerTreeCaptureReader::ReadLayer(size_t depth) {
+  if (depth > kMaxCaptureDepth) {
+    ok_ = false;
+    return nullptr;
+  }
+  const auto type = static_cast<CapturedLayerType>(ReadUInt());
+  if (!ok_) {
+    return nullptr;
+  }
+  std::shared_ptr<Layer> layer;
+  std::shared_ptr<ContainerLayer> container;
+  switch (type) {
+    case CapturedLayerType::kContainer:
+      layer = container = std::make_shared<ContainerLayer>();
+      break;
+    case CapturedLayerType::kTransform: {
+      const SkMatrix transform = ReadMatrix();
+      layer = container = std::make_shared<TransformLayer>(transform);
+      break;
+    }
+    case CapturedLayerType::kClipRect: {
+      const SkRect clip_rect = ReadRect();
+      const Clip clip_behavior = ReadClip();
+      layer = container =
+          std::make_shared<ClipRectLayer>(clip_rect, clip_behavior);
+      break;
+    }
+    case CapturedLayerType::kClipRRect: {
+      const SkRRect clip_rrect = ReadRRect();
+      const Clip clip_behavior = ReadClip();
+      layer = container =
+          std::make_shared<ClipRRectLayer>(clip_rrect, clip_behavior);
+      break;
+    }
+    case CapturedLayerType::kClipPath: {
+      const SkPath clip_path = ReadPath();
+      const Clip clip_behavior = ReadClip();
+      layer = container =
+          std::make_shared<ClipPathLayer>(clip_path, clip_behavior);
+      break;
+    }
+    case CapturedLayerType::kOpacity: {
+      const uint32_t alpha = ReadUInt();
+      const SkPoint offset = ReadPoint();
+      ok_ = ok_ && alpha <= SK_AlphaOPAQUE;
+      layer = container = std::make_shared<OpacityLayer>(alpha, offset);
+      break;
+    }
+    case CapturedLayerType::kColorFilter: {
+      auto filter =
+          ReadFlattenable<SkColorFilter>(SkFlattenable::kSkColorFilter_Type);
+      layer = container = std::make_shared<ColorFilterLayer>(filter);
+      break;
+    }
+    case CapturedLayerType::kImageFilter: {
+      auto filter =
+          ReadFlattenable<SkImageFilter>(SkFlattenable::kSkImageFilter_Type);
+      layer = container = std::make_shared<ImageFilterLayer>(filter);
+      break;
+    }
+    case CapturedLayerType::kBackdropFilter: {
+      auto filter =
+          ReadFlattenable<SkImageFilter>(SkFlattenable::kSkImageFilter_Type);
+      layer = container = std::make_shared<BackdropFilterLayer>(filter);
+      break;
+    }
+    case CapturedLayerType::kShaderMask: {
+      auto shader = ReadFlattenable<SkShader>(SkFlattenable::kSkShaderBase_Type);
+      const SkRect mask_rect = ReadRect();
+      const uint32_t blend_mode = ReadUInt();
+      ok_ = ok_ && blend_mode <= static_cast<uint32_t>(SkBlendMode::kLastMode);
+      layer = container = std::make_shared<ShaderMaskLayer>(
+          shader, mask_rect, static_cast<SkBlendMode>(blend_mode));
+      break;
+    }
+    case CapturedLayerType::kPhysicalShape: {
+      const SkColor color = ReadUInt();
+      const SkColor shadow_color = ReadUInt();
+      const SkScalar elevation = ReadScalar();
+      const SkPath path = ReadPath();
+      const Clip clip_behavior = ReadClip();
+      layer = container = std::make_shared<PhysicalShapeLayer>(
+          color, shadow_color, elevation, path, clip_behavior);
+      break;
+    }
+    case CapturedLayerType::kPicture: {
+      const SkPoint offset = ReadPoint();
+      sk_sp<SkPicture> picture = ReadPicture();
+      const bool is_complex = ReadBool();
+      const bool will_change = ReadBool();
+      if (!ok_) {
+        return nullptr;
+      }
+      layer = std::make_shared<PictureLayer>(
+          offset, SkiaGPUObject<SkPicture>(std::move(picture), nullptr),
+          is_complex, will_change);
+      break;
+    }
+    case CapturedLayerType::kPlaceholder: {
+      const SkRect bounds = ReadRect();
+      if (!ok_) {
+        return nullptr;
+      }
+      // Placeholders stand for content that changes on its own, like video,
+      // so they are never cached.
+      layer = std::make_shared<PictureLayer>(
+          SkPoint::Make(0, 0),
+          SkiaGPUObject<SkPicture>(MakePlaceholderPicture(bounds), nullptr),
+          false, true);
+      break;
+    }
+    default:
+      FML_LOG(ERROR) << "Unknown layer type in layer tree capture: "
+                     << static_cast<uint32_t>(type);
+      ok_ = false;
+      return nullptr;
+  }
+  if (!ok_ || (container && !ReadChildren(container.get(), depth))) {
+    return nullptr;
+  }
+  return layer;
+}
+
+}  // namespace
+
+std::unique_ptr<LayerTree> ReadLayerTreeCapture(const SkData& data) {
+  LayerTreeCaptureReader reader(data);
+  if (reader.ReadUInt() != kCaptureMagic) {
+    FML_LOG(ERROR) << "The data is not a layer tree capture.";
+    return nullptr;
+  }
+  const uint32_t version = reader.ReadUInt();
+  if (version != kCaptureVersion) {
+    FML_LOG(ERROR) << "Unsupported layer tree capture version " << version
+                   << ", expected " << kCaptureVersion << ".";
+    return nullptr;
+  }
+  const uint32_t width = reader.ReadUInt();
+  const uint32_t height = reader.ReadUInt();
+  const SkScalar device_pixel_ratio = reader.ReadScalar();
+  std::shared_ptr<Layer> root_layer = reader.ReadLayer(0);
+  if (!reader.ok() || !root_layer) {
+    FML_LOG(ERROR) << "The layer tree capture is malformed.";
+    return nullptr;
+  }
+  auto layer_tree = std::make_unique<LayerTree>(
+      SkISize::Make(width, height), device_pixel_ratio);
+  layer_tree->set_root_layer(std::move(root_layer));
+  return layer_tree;
+}
+
+}  // namespace flutter
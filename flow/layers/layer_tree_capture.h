@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_TREE_CAPTURE_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_TREE_CAPTURE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFlattenable.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace flutter {
+
+class Layer;
+class LayerTree;
+
+// The layers a capture can hold. The values are part of the format and must
+// not change.
+enum class CapturedLayerType : uint32_t {
+  kContainer = 0,
+  kTransform = 1,
+  kClipRect = 2,
+  kClipRRect = 3,
+  kClipPath = 4,
+  kOpacity = 5,
+  kColorFilter = 6,
+  kImageFilter = 7,
+  kBackdropFilter = 8,
+  kShaderMask = 9,
+  kPhysicalShape = 10,
+  kPicture = 11,
+  // A layer whose content cannot be captured, such as a texture or a
+  // platform view. It is replayed as a flat rect covering its paint bounds.
+  kPlaceholder = 12,
+};
+
+/// Serializes a layer tree, so that a frame can be rasterized again away from
+/// the application that produced it, for example to investigate jank reported
+/// from the field. See |CaptureLayerTree|.
+///
+/// Each layer writes itself in |Layer::Capture| as its |CapturedLayerType|
+/// followed by its properties and, for containers, its children. Display
+/// lists are captured as the pictures they render to. Textures and platform
+/// views, whose content belongs to the embedder, become placeholders.
+class LayerTreeCaptureWriter {
+ public:
+  // |picture_procs| serialize the images and typefaces of the pictures.
+  explicit LayerTreeCaptureWriter(const SkSerialProcs& picture_procs);
+
+  ~LayerTreeCaptureWriter();
+
+  void WriteLayer(const Layer& layer);
+
+  void WriteChildren(const std::vector<std::shared_ptr<Layer>>& layers);
+
+  void WriteType(CapturedLayerType type);
+
+  void WriteUInt(uint32_t value);
+
+  void WriteBool(bool value);
+
+  void WriteScalar(SkScalar value);
+
+  void WritePoint(const SkPoint& point);
+
+  void WriteRect(const SkRect& rect);
+
+  void WriteRRect(const SkRRect& rrect);
+
+  void WritePath(const SkPath& path);
+
+  void WriteMatrix(const SkMatrix& matrix);
+
+  // Writes a color filter, image filter or shader, which may be null.
+  void WriteFlattenable(const SkFlattenable* flattenable);
+
+  void WritePicture(const SkPicture& picture);
+
+  sk_sp<SkData> Finish();
+
+ private:
+  const SkSerialProcs picture_procs_;
+  SkDynamicMemoryWStream stream_;
+
+  void WriteData(const SkData* data);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerTreeCaptureWriter);
+};
+
+/// Serializes |layer_tree|, which must have been prerolled, along with its
+/// frame size and device pixel ratio. |picture_procs| serialize the images
+/// and typefaces of the pictures, which must embed their data for the capture
+/// to be replayed on another device.
+sk_sp<SkData> CaptureLayerTree(const LayerTree& layer_tree,
+                               const SkSerialProcs& picture_procs);
+
+/// Rebuilds a layer tree serialized by |CaptureLayerTree|. Returns null if
+/// |data| is not a capture or was written by an incompatible version.
+std::unique_ptr<LayerTree> ReadLayerTreeCapture(const SkData& data);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_TREE_CAPTURE_H_
@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_tree_capture.h"
+
+#include <cstring>
+
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/color_filter_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr SkISize kFrameSize = SkISize::Make(64, 64);
+
+static sk_sp<SkPicture> MakeSamplePicture() {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(40, 40));
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  canvas->drawRect(SkRect::MakeXYWH(5, 5, 30, 20), paint);
+  paint.setColor(SK_ColorBLUE);
+  canvas->drawCircle(20, 30, 8, paint);
+  return recorder.finishRecordingAsPicture();
+}
+
+// Prerolls and paints |layer_tree| into a new bitmap.
+static SkBitmap RasterizeLayerTree(LayerTree& layer_tree) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kFrameSize.width(), kFrameSize.height());
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorWHITE);
+  CompositorContext compositor_context;
+  const SkMatrix root_surface_transformation;
+  auto frame = compositor_context.AcquireFrame(
+      nullptr, &canvas, nullptr, root_surface_transformation, false, true,
+      nullptr);
+  frame->Raster(layer_tree, true, nullptr);
+  return bitmap;
+}
+
+static bool BitmapsAreEqual(const SkBitmap& a, const SkBitmap& b) {
+  return a.computeByteSize() == b.computeByteSize() &&
+         std::memcmp(a.getPixels(), b.getPixels(), a.computeByteSize()) == 0;
+}
+
+static sk_sp<SkData> Capture(const LayerTree& layer_tree) {
+  return CaptureLayerTree(layer_tree, SkSerialProcs());
+}
+
+TEST(LayerTreeCaptureTest, ReplayedTreePaintsTheSamePixels) {
+  auto transform =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(10, 10));
+  auto clip = std::make_shared<ClipRRectLayer>(
+      SkRRect::MakeRectXY(SkRect::MakeWH(40, 40), 6, 6), Clip::antiAlias);
+  auto opacity = std::make_shared<OpacityLayer>(0x80, SkPoint::Make(2, 2));
+  auto color_filter = std::make_shared<ColorFilterLayer>(
+      SkColorFilters::Blend(SK_ColorGREEN, SkBlendMode::kModulate));
+  color_filter->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(1, 1),
+      SkiaGPUObject<SkPicture>(MakeSamplePicture(), nullptr), false, false));
+  opacity->Add(color_filter);
+  clip->Add(opacity);
+  transform->Add(clip);
+
+  LayerTree layer_tree(kFrameSize, 2.0f);
+  layer_tree.set_root_layer(transform);
+  const SkBitmap expected = RasterizeLayerTree(layer_tree);
+
+  sk_sp<SkData> capture = Capture(layer_tree);
+  ASSERT_TRUE(capture);
+  std::unique_ptr<LayerTree> replayed = ReadLayerTreeCapture(*capture);
+  ASSERT_TRUE(replayed);
+  EXPECT_EQ(replayed->frame_size(), kFrameSize);
+  EXPECT_EQ(replayed->device_pixel_ratio(), 2.0f);
+  EXPECT_STREQ(replayed->root_layer()->GetTypeName(), "TransformLayer");
+  EXPECT_TRUE(BitmapsAreEqual(RasterizeLayerTree(*replayed), expected));
+
+  // A replayed tree can be captured again.
+  sk_sp<SkData> recapture = Capture(*replayed);
+  ASSERT_TRUE(recapture);
+  EXPECT_EQ(recapture->size(), capture->size());
+}
+
+TEST(LayerTreeCaptureTest, UncapturableLayersBecomePlaceholders) {
+  const SkPath path = SkPath().addRect(SkRect::MakeXYWH(4, 8, 16, 12));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<MockLayer>(path));
+
+  LayerTree layer_tree(kFrameSize, 1.0f);
+  layer_tree.set_root_layer(root);
+  RasterizeLayerTree(layer_tree);
+
+  sk_sp<SkData> capture = Capture(layer_tree);
+  ASSERT_TRUE(capture);
+  std::unique_ptr<LayerTree> replayed = ReadLayerTreeCapture(*capture);
+  ASSERT_TRUE(replayed);
+  auto* replayed_root = static_cast<ContainerLayer*>(replayed->root_layer());
+  ASSERT_EQ(replayed_root->layers().size(), 1u);
+  EXPECT_STREQ(replayed_root->layers()[0]->GetTypeName(), "PictureLayer");
+  auto* placeholder =
+      static_cast<PictureLayer*>(replayed_root->layers()[0].get());
+  EXPECT_EQ(placeholder->picture()->cullRect(), path.getBounds());
+}
+
+TEST(LayerTreeCaptureTest, MalformedCapturesAreRejected) {
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject<SkPicture>(MakeSamplePicture(), nullptr), false, false));
+  LayerTree layer_tree(kFrameSize, 1.0f);
+  layer_tree.set_root_layer(root);
+  RasterizeLayerTree(layer_tree);
+  sk_sp<SkData> capture = Capture(layer_tree);
+  ASSERT_TRUE(capture);
+
+  EXPECT_FALSE(ReadLayerTreeCapture(*SkData::MakeEmpty()));
+  for (size_t size : {size_t{4}, size_t{20}, capture->size() - 1}) {
+    EXPECT_FALSE(ReadLayerTreeCapture(
+        *SkData::MakeWithoutCopy(capture->data(), size)))
+        << "Truncated to " << size << " bytes";
+  }
+
+  // Captures written by other versions are not read.
+  sk_sp<SkData> other_version =
+      SkData::MakeWithCopy(capture->data(), capture->size());
+  static_cast<uint8_t*>(other_version->writable_data())[4]++;
+  EXPECT_FALSE(ReadLayerTreeCapture(*other_version));
+}
+
+}  // namespace testing
+}  // namespace flutter
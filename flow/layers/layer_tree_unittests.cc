@@ -4,13 +4,18 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include <cstring>
+
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/canvas_test.h"
 #include "flutter/testing/mock_canvas.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -203,5 +208,52 @@ TEST_F(LayerTreeTest, NeedsSystemComposite) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST(LayerTreeTiledPaintTest, TilesPaintTheSamePixelsAsTheWholeFrame) {
+  const SkISize frame_size = SkISize::Make(64, 512);
+  const SkMatrix root_transform = SkMatrix::Translate(1.0f, 1.0f);
+  auto build = []() {
+    auto layer = std::make_shared<ContainerLayer>();
+    layer->Add(std::make_shared<MockLayer>(
+        SkPath().addRect(4.0f, 4.0f, 60.0f, 500.0f), SkPaint(SkColors::kRed)));
+    // Drawn in a single tile.
+    layer->Add(std::make_shared<MockLayer>(
+        SkPath().addOval(SkRect::MakeLTRB(10.0f, 10.0f, 50.0f, 50.0f)),
+        SkPaint(SkColors::kBlue)));
+    // Crosses the boundaries of several tiles.
+    layer->Add(std::make_shared<MockLayer>(
+        SkPath().addCircle(32.0f, 256.0f, 30.0f), SkPaint(SkColors::kGreen)));
+    return layer;
+  };
+  auto paint = [&](CompositorContext& compositor_context) {
+    auto surface = SkSurface::MakeRasterN32Premul(frame_size.width(),
+                                                  frame_size.height());
+    auto frame = compositor_context.AcquireFrame(
+        nullptr, surface->getCanvas(), nullptr, root_transform, false, true,
+        nullptr);
+    LayerTree layer_tree(frame_size, 1.0f);
+    layer_tree.set_root_layer(build());
+    layer_tree.Preroll(*frame);
+    layer_tree.Paint(*frame);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(frame_size.width(), frame_size.height());
+    surface->readPixels(bitmap, 0, 0);
+    return bitmap;
+  };
+
+  CompositorContext serial_context(fml::kDefaultFrameBudget);
+  const SkBitmap expected = paint(serial_context);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  CompositorContext tiled_context(fml::kDefaultFrameBudget);
+  tiled_context.SetTiledPaintTaskRunner(loop->GetTaskRunner());
+  const SkBitmap actual = paint(tiled_context);
+
+  ASSERT_EQ(expected.computeByteSize(), actual.computeByteSize());
+  EXPECT_EQ(memcmp(expected.getPixels(), actual.getPixels(),
+                   expected.computeByteSize()),
+            0);
+  EXPECT_EQ(actual.getColor(32, 256), SK_ColorGREEN);
+}
+
 }  // namespace testing
 }  // namespace flutter
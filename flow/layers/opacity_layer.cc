@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPaint.h"
 
@@ -12,9 +13,31 @@ namespace flutter {
 OpacityLayer::OpacityLayer(SkAlpha alpha, const SkPoint& offset)
     : alpha_(alpha), offset_(offset) {}
 
+void OpacityLayer::LatchAlpha(SkAlpha alpha) {
+  alpha_animation_.Cancel();
+  latched_alpha_.Latch(alpha);
+}
+
+void OpacityLayer::AnimateAlpha(SkAlpha begin,
+                                SkAlpha end,
+                                fml::TimePoint start_time,
+                                fml::TimeDelta duration,
+                                LayerAnimationCurve curve) {
+  alpha_animation_.Start(begin, end, start_time, duration, curve);
+}
+
 void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "OpacityLayer::Preroll");
   FML_DCHECK(!GetChildContainer()->layers().empty());  // We can't be a leaf.
+  if (latched_alpha_.Apply(&alpha_)) {
+    context->subtree_has_changes = true;
+  }
+  if (alpha_animation_.Apply(context->animation_time, &alpha_)) {
+    context->subtree_has_changes = true;
+  }
+  if (alpha_animation_.IsRunning()) {
+    context->has_running_animations = true;
+  }
 
   SkMatrix child_matrix = matrix;
   child_matrix.preTranslate(offset_.fX, offset_.fY);
@@ -28,12 +51,22 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   context->mutators_stack.PushOpacity(alpha_);
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
-  ContainerLayer::Preroll(context, child_matrix);
+  {
+    DiffContext::AutoEffect effect(context->diff_context, alpha_);
+    ContainerLayer::Preroll(context, child_matrix);
+  }
   context->mutators_stack.Pop();
   context->mutators_stack.Pop();
 
-  {
-    set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
+  set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
+  set_opaque_bounds(alpha_ == SK_AlphaOPAQUE
+                        ? opaque_bounds().makeOffset(offset_.fX, offset_.fY)
+                        : SkRect::MakeEmpty());
+
+  // Children that can apply the opacity themselves need neither a saveLayer
+  // nor a raster cache entry to be painted translucently.
+  children_can_inherit_opacity_ = GetChildContainer()->CanInheritOpacity();
+  if (!children_can_inherit_opacity_) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     child_matrix = RasterCache::GetIntegralTransCTM(child_matrix);
 #endif
@@ -48,8 +81,8 @@ void OpacityLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "OpacityLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  SkPaint paint;
-  paint.setAlpha(alpha_);
+  const SkScalar saved_opacity = context.inherited_opacity;
+  const SkScalar opacity = saved_opacity * (alpha_ / 255.f);
 
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
   context.internal_nodes_canvas->translate(offset_.fX, offset_.fY);
@@ -59,6 +92,16 @@ void OpacityLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
+  if (children_can_inherit_opacity_) {
+    context.inherited_opacity = opacity;
+    PaintChildren(context);
+    context.inherited_opacity = saved_opacity;
+    return;
+  }
+
+  SkPaint paint;
+  paint.setAlphaf(opacity);
+
   if (context.raster_cache &&
       context.raster_cache->Draw(GetCacheableChild(),
                                  *context.leaf_nodes_canvas, &paint)) {
@@ -80,7 +123,9 @@ void OpacityLayer::Paint(PaintContext& context) const {
 
   Layer::AutoSaveLayer save_layer =
       Layer::AutoSaveLayer::Create(context, saveLayerBounds, &paint);
+  context.inherited_opacity = SK_Scalar1;
   PaintChildren(context);
+  context.inherited_opacity = saved_opacity;
 }
 
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
@@ -94,4 +139,11 @@ void OpacityLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
 
 #endif
 
+void OpacityLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kOpacity);
+  writer.WriteUInt(alpha_);
+  writer.WritePoint(offset_);
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
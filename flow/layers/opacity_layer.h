@@ -6,6 +6,8 @@
 #define FLUTTER_FLOW_LAYERS_OPACITY_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/latched_property.h"
+#include "flutter/flow/layers/layer_animation.h"
 
 namespace flutter {
 
@@ -31,13 +33,39 @@ class OpacityLayer : public MergedContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "OpacityLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  // The opacity is either folded into the children or applied to the layer
+  // the children are painted into, and either can be modulated by an
+  // ancestor's opacity.
+  bool CanInheritOpacity() const override { return true; }
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
 #endif
 
+  // Replaces the alpha of this layer, starting with the next preroll. Like
+  // |TransformLayer::LatchTransform|, this may be called from any thread.
+  void LatchAlpha(SkAlpha alpha);
+
+  // Animates the alpha of this layer like |TransformLayer::AnimateTransform|.
+  // Latching an alpha stops the animation.
+  void AnimateAlpha(SkAlpha begin,
+                    SkAlpha end,
+                    fml::TimePoint start_time,
+                    fml::TimeDelta duration,
+                    LayerAnimationCurve curve);
+
  private:
   SkAlpha alpha_;
   SkPoint offset_;
+  LatchedProperty<SkAlpha> latched_alpha_;
+  LayerAnimation<SkAlpha> alpha_animation_;
+  // Whether |alpha_| is passed down to the children in |Paint| instead of
+  // being applied with a saveLayer. Computed during |Preroll|.
+  bool children_can_inherit_opacity_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(OpacityLayer);
 };
@@ -422,5 +422,25 @@ TEST_F(OpacityLayerTest, CullRectIsTransformed) {
   EXPECT_EQ(mockLayer->parent_cull_rect().fTop, -20);
 }
 
+TEST_F(OpacityLayerTest, LatchedAlphaAppliesFromNextPreroll) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto layer =
+      std::make_shared<OpacityLayer>(SK_AlphaOPAQUE, SkPoint::Make(0, 0));
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(SkMatrix()), Mutator(SK_AlphaOPAQUE)}));
+  EXPECT_FALSE(preroll_context()->subtree_has_changes);
+
+  const SkAlpha latched_alpha = 255 / 2;
+  layer->LatchAlpha(latched_alpha);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(SkMatrix()), Mutator(latched_alpha)}));
+  EXPECT_TRUE(preroll_context()->subtree_has_changes);
+}
+
 }  // namespace testing
 }  // namespace flutter
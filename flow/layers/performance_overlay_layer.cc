@@ -66,6 +66,30 @@ sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
                                   SkTextEncoding::kUTF8);
 }
 
+sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeLayerCostText(
+    const LayerCostProfile::Entry& entry,
+    const std::string& font_path) {
+  SkFont font;
+  if (font_path != "") {
+    font = SkFont(SkTypeface::MakeFromFile(font_path.c_str()));
+  }
+  font.setSize(12);
+
+  std::stringstream stream;
+  stream.setf(std::ios::fixed | std::ios::showpoint);
+  stream << std::setprecision(2);
+  stream << entry.type_name << " #" << entry.unique_id << "  "
+         << entry.GetTotalSelfTime().ToMillisecondsF() << " ms/frame "
+         << "(preroll "
+         << entry.self_time[LayerCostProfile::kPreroll].ToMillisecondsF()
+         << ", paint "
+         << entry.self_time[LayerCostProfile::kPaint].ToMillisecondsF()
+         << ")";
+  auto text = stream.str();
+  return SkTextBlob::MakeFromText(text.c_str(), text.size(), font,
+                                  SkTextEncoding::kUTF8);
+}
+
 PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options,
                                                  const char* font_path)
     : options_(options) {
@@ -74,6 +98,17 @@ PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options,
   }
 }
 
+void PerformanceOverlayLayer::Preroll(PrerollContext* context,
+                                      const SkMatrix& matrix) {
+  // The statistics change every frame.
+  if (auto* diff_context = context->diff_context) {
+    diff_context->AddDirtyRegion(paint_bounds(), matrix, context->cull_rect);
+  }
+  // The statistics visualizations are cached in the stopwatches as they are
+  // painted.
+  context->needs_single_canvas = true;
+}
+
 void PerformanceOverlayLayer::Paint(PaintContext& context) const {
   const int padding = 8;
 
@@ -93,6 +128,34 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
       height - padding, options_ & kVisualizeRasterizerStatistics,
       options_ & kDisplayRasterizerStatistics, "Raster", font_path_);
 
+  // The GPU time is only known when the surface measures it, so it is shown
+  // as a second label of the raster graph rather than as a graph of its own.
+  if ((options_ & kDisplayRasterizerStatistics) && context.gpu_time &&
+      context.gpu_time->MaxDelta() > fml::TimeDelta::Zero()) {
+    const int label_x = 8;    // distance from x
+    const int label_y = -28;  // distance from y+height
+    auto text = MakeStatisticsText(*context.gpu_time, "GPU", font_path_);
+    SkPaint paint;
+    paint.setColor(SK_ColorGRAY);
+    context.leaf_nodes_canvas->drawTextBlob(
+        text, x + label_x, y + height - padding + label_y, paint);
+  }
+
+  // The costliest layers are listed at the top of the raster graph, which
+  // they explain.
+  if ((options_ & kDisplayRasterizerStatistics) && context.layer_cost_profile) {
+    const int label_x = 8;        // distance from x
+    const int label_height = 14;  // distance between the lines
+    const auto& entries = context.layer_cost_profile->GetTopEntries();
+    SkPaint paint;
+    paint.setColor(SK_ColorGRAY);
+    for (size_t i = 0; i < entries.size(); i++) {
+      auto text = MakeLayerCostText(entries[i], font_path_);
+      context.leaf_nodes_canvas->drawTextBlob(
+          text, x + label_x, y + label_height * (i + 1), paint);
+    }
+  }
+
   VisualizeStopWatch(context.leaf_nodes_canvas, context.ui_time, x, y + height,
                      width, height - padding,
                      options_ & kVisualizeEngineStatistics,
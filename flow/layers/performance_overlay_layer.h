@@ -26,11 +26,19 @@ class PerformanceOverlayLayer : public Layer {
                                               const std::string& label_prefix,
                                               const std::string& font_path);
 
+  static sk_sp<SkTextBlob> MakeLayerCostText(
+      const LayerCostProfile::Entry& entry,
+      const std::string& font_path);
+
   explicit PerformanceOverlayLayer(uint64_t options,
                                    const char* font_path = nullptr);
 
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "PerformanceOverlayLayer"; }
+
  private:
   int options_;
   std::string font_path_;
@@ -176,6 +176,32 @@ TEST_F(PerformanceOverlayLayerTest, SimpleRasterizerStatistics) {
                                             text_position}}}));
 }
 
+TEST_F(PerformanceOverlayLayerTest, RasterizerStatisticsListCostliestLayers) {
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 64.0f, 64.0f);
+  const uint64_t overlay_opts = kDisplayRasterizerStatistics;
+  auto layer = std::make_shared<PerformanceOverlayLayer>(overlay_opts);
+  layer->set_paint_bounds(layer_bounds);
+
+  LayerCostProfile profile(1, 2);
+  for (uint64_t unique_id = 1; unique_id <= 3; unique_id++) {
+    LayerCostProfile::AutoScope scope(&profile, unique_id, "PictureLayer",
+                                      LayerCostProfile::kPaint);
+  }
+  profile.EndFrame();
+  ASSERT_EQ(profile.GetTopEntries().size(), 2u);
+  paint_context().layer_cost_profile = &profile;
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  const auto& draw_calls = mock_canvas().draw_calls();
+  ASSERT_EQ(draw_calls.size(), 3u);
+  for (size_t i = 1; i < draw_calls.size(); i++) {
+    const auto& text_data =
+        std::get<MockCanvas::DrawTextData>(draw_calls[i].data);
+    EXPECT_EQ(text_data.offset, SkPoint::Make(16.0f, 8.0f + 14.0f * i));
+  }
+}
+
 TEST(PerformanceOverlayLayerDefault, Gold) {
   TestPerformanceOverlayLayerGold(60);
 }
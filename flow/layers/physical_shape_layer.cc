@@ -4,7 +4,9 @@
 
 #include "flutter/flow/layers/physical_shape_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
 
 namespace flutter {
@@ -29,17 +31,98 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
 
-  SkRect child_paint_bounds;
-  PrerollChildren(context, matrix, &child_paint_bounds);
-
+  SkRect bounds;
   if (elevation_ == 0) {
-    set_paint_bounds(path_.getBounds());
+    bounds = path_.getBounds();
   } else {
     // We will draw the shadow in Paint(), so add some margin to the paint
     // bounds to leave space for the shadow. We fill this whole region and clip
     // children to it so we don't need to join the child paint bounds.
-    set_paint_bounds(ComputeShadowBounds(path_.getBounds(), elevation_,
-                                         context->frame_device_pixel_ratio));
+    bounds = ComputeShadowBounds(path_.getBounds(), elevation_,
+                                 context->frame_device_pixel_ratio);
+  }
+
+  // The shape and its shadow are painted below the children, so their paint
+  // region must be recorded first.
+  uint64_t path_hash = 0;
+  if (auto* diff_context = context->diff_context) {
+    path_hash = DiffContext::HashPath(path_);
+    diff_context->AddPaintRegion(
+        fml::HashCombine(path_hash, color_, shadow_color_, elevation_,
+                         context->frame_device_pixel_ratio),
+        bounds, matrix, context->cull_rect);
+  }
+
+  SkRect child_paint_bounds;
+  {
+    DiffContext::AutoEffect effect(
+        context->diff_context,
+        fml::HashCombine(path_hash, static_cast<int>(clip_behavior_)));
+    PrerollChildren(context, matrix, &child_paint_bounds);
+  }
+
+  set_paint_bounds(bounds);
+
+  // An opaque shape hides what is below its inner rect. Children clipped to
+  // the shape cannot paint opaque pixels outside of it.
+  SkRect opaque_bounds = SkRect::MakeEmpty();
+  if (SkColorGetA(color_) == 0xff && !path_.isInverseFillType()) {
+    SkRect rect;
+    SkRRect rrect;
+    if (path_.isRect(&rect)) {
+      opaque_bounds = rect;
+    } else if (path_.isOval(&rect)) {
+      opaque_bounds = GetRRectInnerRect(SkRRect::MakeOval(rect));
+    } else if (path_.isRRect(&rrect)) {
+      opaque_bounds = GetRRectInnerRect(rrect);
+    }
+  }
+  if (clip_behavior_ == Clip::none) {
+    AccumulateOpaqueRect(&opaque_bounds, child_opaque_bounds());
+  }
+  set_opaque_bounds(opaque_bounds);
+
+  // The shadow only depends on the shape of the path, not on its position, so
+  // it is cached for the path moved to the origin and shared by the layers
+  // with the same shape.
+  shadow_fingerprint_ = 0;
+  if (elevation_ != 0 && context->raster_cache) {
+    const SkRect& path_bounds = path_.getBounds();
+    SkPath shadow_path;
+    path_.offset(-path_bounds.left(), -path_bounds.top(), &shadow_path);
+    const SkScalar dpr = context->frame_device_pixel_ratio;
+    const bool transparent_occluder = SkColorGetA(color_) != 0xff;
+    const uint64_t shadow_fingerprint =
+        fml::HashCombine(DiffContext::HashPath(shadow_path), shadow_color_,
+                         elevation_, transparent_occluder, dpr);
+    SkMatrix shadow_matrix = matrix;
+    shadow_matrix.preTranslate(path_bounds.left(), path_bounds.top());
+    const SkRect shadow_bounds =
+        ComputeShadowBounds(shadow_path.getBounds(), elevation_, dpr);
+    auto prepare = [cache = context->raster_cache,
+                    gr_context = context->gr_context,
+                    dst_color_space = context->dst_color_space,
+                    shadow_path = std::move(shadow_path),
+                    shadow_color = shadow_color_, elevation = elevation_,
+                    transparent_occluder, dpr, shadow_fingerprint,
+                    shadow_bounds, shadow_matrix]() {
+      cache->PrepareShadow(gr_context, shadow_fingerprint, shadow_bounds,
+                           shadow_matrix, dst_color_space,
+                           [&](SkCanvas* canvas) {
+                             DrawShadow(canvas, shadow_path, shadow_color,
+                                        elevation, transparent_occluder, dpr);
+                           });
+    };
+    // Like the pictures, the shadows of children prerolled on worker threads
+    // are rasterized on the raster thread once the preroll is done.
+    if (auto* deferred = context->deferred_raster_cache_preparations) {
+      deferred->push_back(std::move(prepare));
+    } else {
+      prepare();
+    }
+    // The entry counts its accesses when it is drawn, so it is looked up even
+    // if it has not been rasterized yet.
+    shadow_fingerprint_ = shadow_fingerprint;
   }
 }
 
@@ -47,7 +130,7 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PhysicalShapeLayer::Paint");
   FML_DCHECK(needs_painting(context));
 
-  if (elevation_ != 0) {
+  if (elevation_ != 0 && !PaintCachedShadow(context)) {
     DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
                SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
   }
@@ -95,6 +178,17 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   }
 }
 
+bool PhysicalShapeLayer::PaintCachedShadow(PaintContext& context) const {
+  if (!shadow_fingerprint_ || !context.raster_cache) {
+    return false;
+  }
+  const SkRect& path_bounds = path_.getBounds();
+  SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
+  context.leaf_nodes_canvas->translate(path_bounds.left(), path_bounds.top());
+  return context.raster_cache->DrawShadow(shadow_fingerprint_,
+                                          *context.leaf_nodes_canvas);
+}
+
 SkRect PhysicalShapeLayer::ComputeShadowBounds(const SkRect& bounds,
                                                float elevation,
                                                float pixel_ratio) {
@@ -165,4 +259,14 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
       dpr * kLightRadius, ambientColor, spotColor, flags);
 }
 
+void PhysicalShapeLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kPhysicalShape);
+  writer.WriteUInt(color_);
+  writer.WriteUInt(shadow_color_);
+  writer.WriteScalar(elevation_);
+  writer.WritePath(path_);
+  writer.WriteUInt(clip_behavior_);
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
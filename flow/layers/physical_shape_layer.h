@@ -31,6 +31,13 @@ class PhysicalShapeLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "PhysicalShapeLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  // The shape and its shadow are painted below the children.
+  bool CanInheritOpacity() const override { return false; }
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
@@ -38,11 +45,18 @@ class PhysicalShapeLayer : public ContainerLayer {
   float elevation() const { return elevation_; }
 
  private:
+  // Draws the shadow from the raster cache. Returns false if it is not
+  // cached.
+  bool PaintCachedShadow(PaintContext& context) const;
+
   SkColor color_;
   SkColor shadow_color_;
   float elevation_ = 0.0f;
   SkPath path_;
   Clip clip_behavior_;
+  // Identifies the shadow in the raster cache, see |ShadowRasterCacheKey|.
+  // Zero if the shadow was not prerolled with a raster cache.
+  uint64_t shadow_fingerprint_ = 0;
 };
 
 }  // namespace flutter
@@ -6,6 +6,7 @@
 
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 
@@ -232,6 +233,68 @@ static bool ReadbackResult(PrerollContext* context,
   return context->surface_needs_readback;
 }
 
+TEST_F(PhysicalShapeLayerTest, IdenticalShapesShareCachedShadow) {
+  use_skia_raster_cache();
+  SkPath path1 = SkPath().addRect(0, 0, 8, 8);
+  SkPath path2 = SkPath().addRect(20, 30, 28, 38);
+  SkPath path3 = SkPath().addRect(0, 0, 8, 16);
+  auto layer1 = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorGREEN, SK_ColorBLACK, 4.0f, path1, Clip::none);
+  auto layer2 = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorGREEN, SK_ColorBLACK, 4.0f, path2, Clip::none);
+  auto layer3 = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorGREEN, SK_ColorBLACK, 4.0f, path3, Clip::none);
+
+  layer1->Preroll(preroll_context(), SkMatrix());
+  layer2->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(raster_cache()->GetShadowCachedEntriesCount(), 1u);
+
+  layer3->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(raster_cache()->GetShadowCachedEntriesCount(), 2u);
+}
+
+TEST_F(PhysicalShapeLayerTest, DefersShadowPreparationWhenAsked) {
+  use_skia_raster_cache();
+  auto layer = std::make_shared<PhysicalShapeLayer>(
+      SK_ColorGREEN, SK_ColorBLACK, 4.0f, SkPath().addRect(0, 0, 8, 8),
+      Clip::none);
+
+  std::vector<fml::closure> deferred;
+  preroll_context()->deferred_raster_cache_preparations = &deferred;
+  layer->Preroll(preroll_context(), SkMatrix());
+  preroll_context()->deferred_raster_cache_preparations = nullptr;
+  EXPECT_EQ(raster_cache()->GetShadowCachedEntriesCount(), 0u);
+  ASSERT_EQ(deferred.size(), 1u);
+
+  deferred[0]();
+  EXPECT_EQ(raster_cache()->GetShadowCachedEntriesCount(), 1u);
+}
+
+#if !defined(LEGACY_FUCHSIA_EMBEDDER)
+TEST_F(PhysicalShapeLayerTest, ParallelPrerollPreparesShadowsLikeSerial) {
+  use_skia_raster_cache();
+  constexpr int kChildCount = 40;
+  constexpr int kShapeCount = 5;
+  auto layer = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < kChildCount; i++) {
+    // Children with the same shape share a shadow, wherever they are.
+    const SkScalar size = 8.0f * (1 + i % kShapeCount);
+    layer->Add(std::make_shared<PhysicalShapeLayer>(
+        SK_ColorGREEN, SK_ColorBLACK, 4.0f,
+        SkPath().addRect(i * 10.0f, 0, i * 10.0f + size, size), Clip::none));
+  }
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  preroll_context()->preroll_task_runner = task_runner.get();
+  layer->Preroll(preroll_context(), SkMatrix());
+  preroll_context()->preroll_task_runner = nullptr;
+
+  EXPECT_EQ(raster_cache()->GetShadowCachedEntriesCount(),
+            static_cast<size_t>(kShapeCount));
+}
+#endif
+
 TEST_F(PhysicalShapeLayerTest, Readback) {
   PrerollContext* context = preroll_context();
   SkPath path;
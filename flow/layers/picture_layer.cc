@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 
 namespace flutter {
@@ -34,12 +36,29 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-    cache->Prepare(context->gr_context, sk_picture, ctm,
-                   context->dst_color_space, is_complex_, will_change_);
+    if (auto* deferred = context->deferred_raster_cache_preparations) {
+      deferred->push_back([cache, gr_context = context->gr_context,
+                           picture = picture_.get(), ctm,
+                           dst_color_space = context->dst_color_space,
+                           is_complex = is_complex_,
+                           will_change = will_change_]() {
+        cache->Prepare(gr_context, picture.get(), ctm, dst_color_space,
+                       is_complex, will_change);
+      });
+    } else {
+      cache->Prepare(context->gr_context, sk_picture, ctm,
+                     context->dst_color_space, is_complex_, will_change_);
+    }
   }
 
   SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
+
+  if (auto* diff_context = context->diff_context) {
+    diff_context->AddPaintRegion(
+        fml::HashCombine(sk_picture->uniqueID(), offset_.x(), offset_.y()),
+        bounds, matrix, context->cull_rect);
+  }
 }
 
 void PictureLayer::Paint(PaintContext& context) const {
@@ -62,4 +81,18 @@ void PictureLayer::Paint(PaintContext& context) const {
   picture()->playback(context.leaf_nodes_canvas);
 }
 
+void PictureLayer::AccumulateStats(FrameStats* stats) const {
+  Layer::AccumulateStats(stats);
+  stats->picture_count++;
+  stats->op_count += picture()->approximateOpCount();
+}
+
+void PictureLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kPicture);
+  writer.WritePoint(offset_);
+  writer.WritePicture(*picture());
+  writer.WriteBool(is_complex_);
+  writer.WriteBool(will_change_);
+}
+
 }  // namespace flutter
@@ -26,6 +26,12 @@ class PictureLayer : public Layer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "PictureLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  void AccumulateStats(FrameStats* stats) const override;
+
  private:
   SkPoint offset_;
   // Even though pictures themselves are not GPU resources, they may reference
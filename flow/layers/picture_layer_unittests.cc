@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
 #include "flutter/flow/raster_cache.h"
@@ -98,5 +99,23 @@ TEST_F(PictureLayerTest, SimplePicture) {
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
 
+TEST_F(PictureLayerTest, AccumulateStatsCountsOps) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(10, 10));
+  canvas->drawRect(SkRect::MakeWH(5, 5), SkPaint());
+  canvas->drawRect(SkRect::MakeXYWH(5, 5, 5, 5), SkPaint());
+  auto picture = recorder.finishRecordingAsPicture();
+  auto layer = std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0), SkiaGPUObject(picture, unref_queue()), false,
+      false);
+
+  FrameStats stats;
+  layer->AccumulateStats(&stats);
+  EXPECT_EQ(stats.layer_count, 1u);
+  EXPECT_EQ(stats.picture_count, 1u);
+  EXPECT_EQ(stats.op_count,
+            static_cast<uint32_t>(picture->approximateOpCount()));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -21,6 +21,12 @@ void PlatformViewLayer::Preroll(PrerollContext* context,
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
 
+  // Platform views are composited by the embedder and split the frame into
+  // several canvases. Damage is not tracked across them.
+  if (context->diff_context) {
+    context->diff_context->MarkRequiresFullRepaint();
+  }
+
   if (context->view_embedder == nullptr) {
     FML_LOG(ERROR) << "Trying to embed a platform view but the PrerollContext "
                       "does not support embedding";
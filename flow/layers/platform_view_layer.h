@@ -17,6 +17,8 @@ class PlatformViewLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
+
+  const char* GetTypeName() const override { return "PlatformViewLayer"; }
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   // Updates the system composited scene.
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
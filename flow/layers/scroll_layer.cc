@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/scroll_layer.h"
+
+#include <algorithm>
+
+#include "flutter/flow/layers/layer_tree_capture.h"
+
+namespace flutter {
+
+namespace {
+
+SkPoint ClampOffset(const SkPoint& offset, const SkRect& range) {
+  return SkPoint::Make(std::clamp(offset.x(), range.left(), range.right()),
+                       std::clamp(offset.y(), range.top(), range.bottom()));
+}
+
+}  // namespace
+
+ScrollLayer::ScrollLayer(int64_t scroll_id,
+                         const SkRect& viewport,
+                         const SkPoint& offset,
+                         const SkRect& offset_range)
+    : scroll_id_(scroll_id),
+      viewport_(viewport),
+      offset_range_(offset_range.makeSorted()),
+      initial_offset_(ClampOffset(offset, offset_range_)),
+      offset_(initial_offset_),
+      device_matrix_(SkMatrix::I()) {}
+
+void ScrollLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  TRACE_EVENT0("flutter", "ScrollLayer::Preroll");
+  if (offset_changed_) {
+    context->subtree_has_changes = true;
+    offset_changed_ = false;
+  }
+  device_matrix_ = matrix;
+
+  const SkRect enclosing_clip_pixels = GetEnclosingClipPixels(context);
+  SkRect previous_cull_rect = context->cull_rect;
+  context->cull_rect.intersect(viewport_);
+  context->mutators_stack.PushClipRect(viewport_);
+  Layer::AutoPrerollClipState clip = Layer::AutoPrerollClipState::Create(
+      context, matrix, viewport_, enclosing_clip_pixels);
+
+  const SkMatrix translation = SkMatrix::Translate(-offset_.x(), -offset_.y());
+  context->mutators_stack.PushTransform(translation);
+  context->cull_rect.offset(offset_.x(), offset_.y());
+
+  SkRect child_paint_bounds = SkRect::MakeEmpty();
+  {
+    DiffContext::AutoEffect effect(context->diff_context,
+                                   DiffContext::HashRect(viewport_));
+    PrerollChildren(context, SkMatrix::Concat(matrix, translation),
+                    &child_paint_bounds);
+  }
+
+  child_paint_bounds.offset(-offset_.x(), -offset_.y());
+  if (!child_paint_bounds.intersect(viewport_)) {
+    child_paint_bounds.setEmpty();
+  }
+  set_paint_bounds(child_paint_bounds);
+  SkRect opaque_bounds = child_opaque_bounds();
+  opaque_bounds.offset(-offset_.x(), -offset_.y());
+  if (!opaque_bounds.intersect(viewport_)) {
+    opaque_bounds.setEmpty();
+  }
+  set_opaque_bounds(opaque_bounds);
+
+  context->mutators_stack.Pop();
+  context->mutators_stack.Pop();
+  context->cull_rect = previous_cull_rect;
+}
+
+void ScrollLayer::Paint(PaintContext& context) const {
+  TRACE_EVENT0("flutter", "ScrollLayer::Paint");
+  FML_DCHECK(needs_painting(context));
+
+  SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
+  context.internal_nodes_canvas->clipRect(viewport_);
+  context.internal_nodes_canvas->translate(-offset_.x(), -offset_.y());
+
+  PaintChildren(context);
+}
+
+void ScrollLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  // Captured as the clip rect and transform layers it behaves like, so that
+  // captures stay readable by replay tools that do not know scroll layers.
+  writer.WriteType(CapturedLayerType::kClipRect);
+  writer.WriteRect(viewport_);
+  writer.WriteUInt(Clip::hardEdge);
+  writer.WriteUInt(1);
+  writer.WriteType(CapturedLayerType::kTransform);
+  writer.WriteMatrix(SkMatrix::Translate(-offset_.x(), -offset_.y()));
+  CaptureChildren(writer);
+}
+
+void ScrollLayer::FindScrollLayers(std::vector<ScrollLayer*>* layers) {
+  layers->push_back(this);
+  ContainerLayer::FindScrollLayers(layers);
+}
+
+bool ScrollLayer::ContainsDevicePoint(const SkPoint& device_point) const {
+  SkMatrix inverse;
+  if (!device_matrix_.invert(&inverse)) {
+    return false;
+  }
+  return viewport_.contains(inverse.mapXY(device_point.x(), device_point.y()));
+}
+
+SkVector ScrollLayer::MapDeviceDelta(const SkVector& device_delta) const {
+  SkMatrix inverse;
+  if (!device_matrix_.invert(&inverse)) {
+    return SkVector::Make(0, 0);
+  }
+  return inverse.mapVector(device_delta.x(), device_delta.y());
+}
+
+bool ScrollLayer::ScrollBy(const SkVector& delta) {
+  const SkPoint offset = ClampOffset(offset_ + delta, offset_range_);
+  if (offset == offset_) {
+    return false;
+  }
+  offset_ = offset;
+  offset_changed_ = true;
+  return true;
+}
+
+void ScrollLayer::SetCompositorScrollDelta(const SkVector& delta) {
+  const SkPoint offset = ClampOffset(initial_offset_ + delta, offset_range_);
+  if (offset != offset_) {
+    offset_ = offset;
+    offset_changed_ = true;
+  }
+}
+
+}  // namespace flutter
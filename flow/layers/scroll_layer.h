@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_SCROLL_LAYER_H_
+#define FLUTTER_FLOW_LAYERS_SCROLL_LAYER_H_
+
+#include <cstdint>
+
+#include "flutter/flow/layers/container_layer.h"
+
+namespace flutter {
+
+// Clips its children to a viewport and translates them by the negated scroll
+// offset, like a clip rect layer above a transform layer would. Unlike these,
+// the offset can be moved on the raster thread from pointer input, so that
+// the rasterizer can scroll the content that was already recorded without
+// waiting for the framework to build a new tree. See
+// |Rasterizer::HandleCompositorScroll|.
+//
+// The children are only translated, so the raster cache entries of their
+// pictures remain valid while scrolling.
+class ScrollLayer : public ContainerLayer {
+ public:
+  // |viewport| is the clip of the children in the coordinates of the layer.
+  // |offset| is the initial scroll offset, which stays within
+  // |offset_range|. |scroll_id| identifies the scrollable across the trees
+  // built by the framework.
+  ScrollLayer(int64_t scroll_id,
+              const SkRect& viewport,
+              const SkPoint& offset,
+              const SkRect& offset_range);
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  void Paint(PaintContext& context) const override;
+
+  const char* GetTypeName() const override { return "ScrollLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  void FindScrollLayers(std::vector<ScrollLayer*>* layers) override;
+
+  int64_t scroll_id() const { return scroll_id_; }
+
+  const SkPoint& offset() const { return offset_; }
+
+  // Whether |device_point| lies within the viewport, as it was placed on the
+  // surface by the last Preroll().
+  bool ContainsDevicePoint(const SkPoint& device_point) const;
+
+  // Maps a scroll delta in device pixels, such as the delta of a pointer
+  // scroll event, to the coordinates of the layer as of the last Preroll().
+  SkVector MapDeviceDelta(const SkVector& device_delta) const;
+
+  // Moves the scroll offset by |delta|, clamped to the offset range, starting
+  // with the next preroll. Returns false if the offset could not move.
+  //
+  // This may only be called on the raster thread, between frames.
+  bool ScrollBy(const SkVector& delta);
+
+  // Places the scroll offset at |delta| from the offset the layer was built
+  // with, clamped to the offset range. This replays on a new layer the
+  // scrolls that the framework had not received yet when it built it. Like
+  // |ScrollBy|, this may only be called on the raster thread.
+  void SetCompositorScrollDelta(const SkVector& delta);
+
+ private:
+  const int64_t scroll_id_;
+  const SkRect viewport_;
+  const SkRect offset_range_;
+  const SkPoint initial_offset_;
+  SkPoint offset_;
+  // Set by |ScrollBy| until the next preroll.
+  bool offset_changed_ = false;
+  // The transform from the coordinates of the layer to the surface, as of
+  // the last preroll.
+  SkMatrix device_matrix_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScrollLayer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_SCROLL_LAYER_H_
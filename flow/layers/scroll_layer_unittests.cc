@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/scroll_layer.h"
+
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/macros.h"
+#include "flutter/testing/mock_canvas.h"
+
+namespace flutter {
+namespace testing {
+
+using ScrollLayerTest = LayerTest;
+
+TEST_F(ScrollLayerTest, TranslatesAndClipsChildren) {
+  const SkRect viewport = SkRect::MakeXYWH(10.0, 10.0, 50.0, 50.0);
+  const SkRect child_bounds = SkRect::MakeXYWH(10.0, 10.0, 50.0, 200.0);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ScrollLayer>(
+      1, viewport, SkPoint::Make(0, 30), SkRect::MakeLTRB(0, 0, 0, 150));
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(preroll_context()->cull_rect, kGiantRect);        // Untouched
+  EXPECT_TRUE(preroll_context()->mutators_stack.is_empty());  // Untouched
+  EXPECT_EQ(layer->paint_bounds(), viewport);
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(0, -30));
+  EXPECT_EQ(mock_layer->parent_cull_rect(), viewport.makeOffset(0, 30));
+  EXPECT_EQ(mock_layer->parent_mutators(),
+            std::vector({Mutator(viewport),
+                         Mutator(SkMatrix::Translate(0, -30))}));
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{viewport, SkClipOp::kIntersect,
+                                           MockCanvas::kHard_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ConcatMatrixData{SkMatrix::Translate(0, -30)}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
+TEST_F(ScrollLayerTest, ScrollByClampsToTheOffsetRange) {
+  auto layer = std::make_shared<ScrollLayer>(
+      1, SkRect::MakeWH(50, 50), SkPoint::Make(0, 0),
+      SkRect::MakeLTRB(0, 0, 0, 100));
+
+  EXPECT_TRUE(layer->ScrollBy(SkVector::Make(0, 40)));
+  EXPECT_EQ(layer->offset(), SkPoint::Make(0, 40));
+  EXPECT_TRUE(layer->ScrollBy(SkVector::Make(25, 100)));
+  EXPECT_EQ(layer->offset(), SkPoint::Make(0, 100));
+  // Already at the end of the range.
+  EXPECT_FALSE(layer->ScrollBy(SkVector::Make(0, 10)));
+  EXPECT_FALSE(layer->ScrollBy(SkVector::Make(10, 0)));
+}
+
+TEST_F(ScrollLayerTest, CompositorScrollDeltaIsRelativeToTheInitialOffset) {
+  auto layer = std::make_shared<ScrollLayer>(
+      1, SkRect::MakeWH(50, 50), SkPoint::Make(0, 30),
+      SkRect::MakeLTRB(0, 0, 0, 100));
+
+  layer->SetCompositorScrollDelta(SkVector::Make(0, 20));
+  EXPECT_EQ(layer->offset(), SkPoint::Make(0, 50));
+  // Setting the same delta again does not move the offset further.
+  layer->SetCompositorScrollDelta(SkVector::Make(0, 20));
+  EXPECT_EQ(layer->offset(), SkPoint::Make(0, 50));
+  layer->SetCompositorScrollDelta(SkVector::Make(0, 200));
+  EXPECT_EQ(layer->offset(), SkPoint::Make(0, 100));
+}
+
+TEST_F(ScrollLayerTest, ScrollingMarksTheSubtreeAsChanged) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(50, 200));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto layer = std::make_shared<ScrollLayer>(
+      1, SkRect::MakeWH(50, 50), SkPoint::Make(0, 0),
+      SkRect::MakeLTRB(0, 0, 0, 150));
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(preroll_context()->subtree_has_changes);
+
+  ASSERT_TRUE(layer->ScrollBy(SkVector::Make(0, 20)));
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->subtree_has_changes);
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(0, -20));
+}
+
+TEST_F(ScrollLayerTest, MapsDevicePointsAndDeltas) {
+  auto layer = std::make_shared<ScrollLayer>(
+      1, SkRect::MakeXYWH(10, 10, 50, 50), SkPoint::Make(0, 0),
+      SkRect::MakeLTRB(0, 0, 0, 150));
+  layer->Add(std::make_shared<MockLayer>(SkPath().addRect(0, 0, 60, 200)));
+
+  // The surface is 2 device pixels per logical pixel.
+  layer->Preroll(preroll_context(), SkMatrix::Scale(2, 2));
+  EXPECT_TRUE(layer->ContainsDevicePoint(SkPoint::Make(30, 30)));
+  EXPECT_FALSE(layer->ContainsDevicePoint(SkPoint::Make(10, 10)));
+  EXPECT_FALSE(layer->ContainsDevicePoint(SkPoint::Make(130, 30)));
+  EXPECT_EQ(layer->MapDeviceDelta(SkVector::Make(0, 40)),
+            SkVector::Make(0, 20));
+}
+
+TEST_F(ScrollLayerTest, FindScrollLayersListsOuterLayersFirst) {
+  auto outer = std::make_shared<ScrollLayer>(
+      1, SkRect::MakeWH(50, 50), SkPoint::Make(0, 0),
+      SkRect::MakeLTRB(0, 0, 0, 150));
+  auto transform = std::make_shared<TransformLayer>(SkMatrix::Translate(5, 5));
+  auto inner = std::make_shared<ScrollLayer>(
+      2, SkRect::MakeWH(20, 20), SkPoint::Make(0, 0),
+      SkRect::MakeLTRB(0, 0, 100, 0));
+  transform->Add(inner);
+  outer->Add(transform);
+
+  std::vector<ScrollLayer*> layers;
+  outer->FindScrollLayers(&layers);
+  EXPECT_EQ(layers, std::vector<ScrollLayer*>({outer.get(), inner.get()}));
+}
+
+}  // namespace testing
+}  // namespace flutter
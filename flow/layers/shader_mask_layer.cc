@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/shader_mask_layer.h"
 
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 
 ShaderMaskLayer::ShaderMaskLayer(sk_sp<SkShader> shader,
@@ -18,7 +21,16 @@ void ShaderMaskLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
+  DiffContext::AutoEffect effect(
+      context->diff_context,
+      context->diff_context
+          ? fml::HashCombine(DiffContext::HashFlattenable(shader_.get()),
+                             DiffContext::HashRect(mask_rect_),
+                             static_cast<int>(blend_mode_))
+          : 0);
   ContainerLayer::Preroll(context, matrix);
+  // The mask may make the children translucent.
+  set_opaque_bounds(SkRect::MakeEmpty());
 }
 
 void ShaderMaskLayer::Paint(PaintContext& context) const {
@@ -37,4 +49,12 @@ void ShaderMaskLayer::Paint(PaintContext& context) const {
       SkRect::MakeWH(mask_rect_.width(), mask_rect_.height()), paint);
 }
 
+void ShaderMaskLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kShaderMask);
+  writer.WriteFlattenable(shader_.get());
+  writer.WriteRect(mask_rect_);
+  writer.WriteUInt(static_cast<uint32_t>(blend_mode_));
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
@@ -20,6 +20,13 @@ class ShaderMaskLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "ShaderMaskLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
+  // The children are filtered or blended as a group.
+  bool CanInheritOpacity() const override { return false; }
+
  private:
   sk_sp<SkShader> shader_;
   SkRect mask_rect_;
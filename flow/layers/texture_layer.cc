@@ -28,6 +28,13 @@ void TextureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
+
+  // The texture contents may change without the layer changing.
+  if (auto* diff_context = context->diff_context) {
+    diff_context->AddDirtyRegion(paint_bounds(), matrix, context->cull_rect);
+  }
+  // Textures are only updated and painted on the raster thread.
+  context->needs_single_canvas = true;
 }
 
 void TextureLayer::Paint(PaintContext& context) const {
@@ -4,7 +4,7 @@
 
 #include "flutter/flow/layers/transform_layer.h"
 
-#include <optional>
+#include "flutter/flow/layers/layer_tree_capture.h"
 
 namespace flutter {
 
@@ -26,8 +26,38 @@ TransformLayer::TransformLayer(const SkMatrix& transform)
   }
 }
 
+void TransformLayer::LatchTransform(const SkMatrix& transform) {
+  if (!transform.isFinite()) {
+    FML_LOG(ERROR) << "Ignoring an invalid latched transform.";
+    return;
+  }
+  transform_animation_.Cancel();
+  latched_transform_.Latch(transform);
+}
+
+void TransformLayer::AnimateTransform(const SkMatrix& begin,
+                                      const SkMatrix& end,
+                                      fml::TimePoint start_time,
+                                      fml::TimeDelta duration,
+                                      LayerAnimationCurve curve) {
+  if (!begin.isFinite() || !end.isFinite()) {
+    FML_LOG(ERROR) << "Ignoring a transform animation with invalid matrices.";
+    return;
+  }
+  transform_animation_.Start(begin, end, start_time, duration, curve);
+}
+
 void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "TransformLayer::Preroll");
+  if (latched_transform_.Apply(&transform_)) {
+    context->subtree_has_changes = true;
+  }
+  if (transform_animation_.Apply(context->animation_time, &transform_)) {
+    context->subtree_has_changes = true;
+  }
+  if (transform_animation_.IsRunning()) {
+    context->has_running_animations = true;
+  }
 
   SkMatrix child_matrix;
   child_matrix.setConcat(matrix, transform_);
@@ -47,6 +77,10 @@ void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
   transform_.mapRect(&child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  // A rotated or skewed opaque rect is not a rect in the parent coordinates.
+  set_opaque_bounds(transform_.rectStaysRect()
+                        ? transform_.mapRect(child_opaque_bounds())
+                        : SkRect::MakeEmpty());
 
   context->cull_rect = previous_cull_rect;
   context->mutators_stack.Pop();
@@ -60,7 +94,7 @@ void TransformLayer::UpdateScene(std::shared_ptr<SceneUpdateContext> context) {
 
   std::optional<SceneUpdateContext::Transform> transform;
   if (!transform_.isIdentity()) {
-    transform.emplace(context, transform_);
+    transform.emplace(context, transform_, this);
   }
 
   UpdateSceneChildren(context);
@@ -78,4 +112,10 @@ void TransformLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+void TransformLayer::Capture(LayerTreeCaptureWriter& writer) const {
+  writer.WriteType(CapturedLayerType::kTransform);
+  writer.WriteMatrix(transform_);
+  CaptureChildren(writer);
+}
+
 }  // namespace flutter
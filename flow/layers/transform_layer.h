@@ -6,6 +6,8 @@
 #define FLUTTER_FLOW_LAYERS_TRANSFORM_LAYER_H_
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/latched_property.h"
+#include "flutter/flow/layers/layer_animation.h"
 
 namespace flutter {
 
@@ -19,12 +21,36 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  const char* GetTypeName() const override { return "TransformLayer"; }
+
+  void Capture(LayerTreeCaptureWriter& writer) const override;
+
 #if defined(LEGACY_FUCHSIA_EMBEDDER)
   void UpdateScene(std::shared_ptr<SceneUpdateContext> context) override;
 #endif
 
+  // Replaces the transform of this layer, starting with the next preroll.
+  //
+  // Unlike the rest of the layer, this may be called from any thread while
+  // the layer is part of a layer tree that is waiting to be rasterized. This
+  // allows transform-only updates (e.g. scroll offsets) to be applied right
+  // before the tree is submitted instead of having to build a new one.
+  void LatchTransform(const SkMatrix& transform);
+
+  // Animates the transform of this layer from |begin| to |end|, starting at
+  // |start_time|. The animation is advanced on the raster thread for every
+  // frame, without new layer trees. Like |LatchTransform|, this may be called
+  // from any thread. Latching a transform stops the animation.
+  void AnimateTransform(const SkMatrix& begin,
+                        const SkMatrix& end,
+                        fml::TimePoint start_time,
+                        fml::TimeDelta duration,
+                        LayerAnimationCurve curve);
+
  private:
   SkMatrix transform_;
+  LatchedProperty<SkMatrix> latched_transform_;
+  LayerAnimation<SkMatrix> transform_animation_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TransformLayer);
 };
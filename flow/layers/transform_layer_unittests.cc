@@ -224,5 +224,100 @@ TEST_F(TransformLayerTest, NestedSeparated) {
                    MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(TransformLayerTest, LatchedTransformAppliesFromNextPreroll) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, SkPaint());
+  auto layer =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(2.5f, 2.5f));
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(2.5f, 2.5f));
+
+  const SkMatrix latched_transform = SkMatrix::Translate(0.0f, -10.0f);
+  layer->LatchTransform(latched_transform);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_matrix(), latched_transform);
+  EXPECT_EQ(layer->paint_bounds(),
+            latched_transform.mapRect(child_path.getBounds()));
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector({MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+                   MockCanvas::DrawCall{
+                       1, MockCanvas::ConcatMatrixData{latched_transform}},
+                   MockCanvas::DrawCall{
+                       1, MockCanvas::DrawPathData{child_path, SkPaint()}},
+                   MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+
+  // The latched transform sticks.
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_matrix(), latched_transform);
+}
+
+TEST_F(TransformLayerTest, InvalidLatchedTransformIsIgnored) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, SkPaint());
+  auto layer =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(2.5f, 2.5f));
+  layer->Add(mock_layer);
+
+  layer->LatchTransform(SkMatrix::Scale(SK_ScalarNaN, 1.0f));
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(2.5f, 2.5f));
+}
+
+TEST_F(TransformLayerTest, AnimatedTransformAdvancesWithTheAnimationTime) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, SkPaint());
+  auto layer = std::make_shared<TransformLayer>(SkMatrix());
+  layer->Add(mock_layer);
+
+  const fml::TimePoint start_time = fml::TimePoint::Now();
+  layer->AnimateTransform(SkMatrix::Translate(0.0f, 0.0f),
+                          SkMatrix::Translate(0.0f, 40.0f), start_time,
+                          fml::TimeDelta::FromMilliseconds(100),
+                          LayerAnimationCurve::kLinear);
+
+  preroll_context()->animation_time =
+      start_time + fml::TimeDelta::FromMilliseconds(50);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(0.0f, 20.0f));
+  EXPECT_TRUE(preroll_context()->has_running_animations);
+  EXPECT_TRUE(preroll_context()->subtree_has_changes);
+
+  preroll_context()->has_running_animations = false;
+  preroll_context()->animation_time =
+      start_time + fml::TimeDelta::FromMilliseconds(150);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(0.0f, 40.0f));
+  EXPECT_FALSE(preroll_context()->has_running_animations);
+}
+
+TEST_F(TransformLayerTest, LatchedTransformStopsTheAnimation) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, SkPaint());
+  auto layer = std::make_shared<TransformLayer>(SkMatrix());
+  layer->Add(mock_layer);
+
+  const fml::TimePoint start_time = fml::TimePoint::Now();
+  layer->AnimateTransform(SkMatrix::Translate(0.0f, 0.0f),
+                          SkMatrix::Translate(0.0f, 40.0f), start_time,
+                          fml::TimeDelta::FromMilliseconds(100),
+                          LayerAnimationCurve::kLinear);
+  layer->LatchTransform(SkMatrix::Translate(5.0f, 5.0f));
+
+  preroll_context()->animation_time =
+      start_time + fml::TimeDelta::FromMilliseconds(50);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(5.0f, 5.0f));
+  EXPECT_FALSE(preroll_context()->has_running_animations);
+}
+
 }  // namespace testing
 }  // namespace flutter
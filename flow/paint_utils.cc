@@ -6,9 +6,13 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkShader.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
 
 namespace flutter {
 
@@ -23,6 +27,22 @@ sk_sp<SkShader> CreateCheckerboardShader(SkColor c1, SkColor c2, int size) {
   return bm.makeShader(SkTileMode::kRepeat, SkTileMode::kRepeat);
 }
 
+// The largest power of two by which a blur of |sigma| can be downsampled
+// while the blur at the reduced resolution remains at least half as wide as
+// |min_sigma|.
+int GetBlurDownsampleFactor(SkScalar sigma,
+                            SkScalar min_sigma,
+                            int max_factor) {
+  if (min_sigma <= 0 || sigma < min_sigma) {
+    return 1;
+  }
+  int factor = 1;
+  while (factor * 2 <= max_factor && sigma / (factor * 2) >= min_sigma / 2) {
+    factor *= 2;
+  }
+  return factor;
+}
+
 }  // anonymous namespace
 
 void DrawCheckerboard(SkCanvas* canvas, SkColor c1, SkColor c2, int size) {
@@ -50,4 +70,70 @@ void DrawCheckerboard(SkCanvas* canvas, const SkRect& rect) {
   canvas->drawRect(rect, debugPaint);
 }
 
+sk_sp<SkImageFilter> MakeBlurImageFilter(SkScalar sigma_x,
+                                         SkScalar sigma_y,
+                                         SkScalar downsample_min_sigma,
+                                         int max_downsample_factor) {
+  const int factor_x = GetBlurDownsampleFactor(sigma_x, downsample_min_sigma,
+                                               max_downsample_factor);
+  const int factor_y = GetBlurDownsampleFactor(sigma_y, downsample_min_sigma,
+                                               max_downsample_factor);
+  if (factor_x == 1 && factor_y == 1) {
+    return SkImageFilters::Blur(sigma_x, sigma_y, SkTileMode::kClamp, nullptr);
+  }
+
+  sk_sp<SkImageFilter> downsample = SkImageFilters::MatrixTransform(
+      SkMatrix::Scale(1.0f / factor_x, 1.0f / factor_y), kLow_SkFilterQuality,
+      nullptr);
+  sk_sp<SkImageFilter> blur =
+      SkImageFilters::Blur(sigma_x / factor_x, sigma_y / factor_y,
+                           SkTileMode::kClamp, std::move(downsample));
+  return SkImageFilters::MatrixTransform(SkMatrix::Scale(factor_x, factor_y),
+                                         kLow_SkFilterQuality, std::move(blur));
+}
+
+void AccumulateOpaqueRect(SkRect* opaque, const SkRect& rect) {
+  if (rect.isEmpty() || opaque->contains(rect)) {
+    return;
+  }
+  if (opaque->isEmpty() || rect.contains(*opaque)) {
+    *opaque = rect;
+    return;
+  }
+  // Rects that share two opposite edges and overlap or touch along them form
+  // a rect together.
+  const bool same_columns =
+      rect.fLeft == opaque->fLeft && rect.fRight == opaque->fRight &&
+      rect.fTop <= opaque->fBottom && opaque->fTop <= rect.fBottom;
+  const bool same_rows =
+      rect.fTop == opaque->fTop && rect.fBottom == opaque->fBottom &&
+      rect.fLeft <= opaque->fRight && opaque->fLeft <= rect.fRight;
+  if (same_columns || same_rows) {
+    opaque->join(rect);
+  } else if (rect.width() * rect.height() >
+             opaque->width() * opaque->height()) {
+    *opaque = rect;
+  }
+}
+
+SkRect GetRRectInnerRect(const SkRRect& rrect) {
+  const SkRect& rect = rrect.rect();
+  if (rrect.isRect()) {
+    return rect;
+  }
+  // Insetting each side by the radii of the corners it meets leaves every
+  // corner of the result at or within the center of the ellipse of the
+  // corner of the rrect.
+  const SkVector upper_left = rrect.radii(SkRRect::kUpperLeft_Corner);
+  const SkVector upper_right = rrect.radii(SkRRect::kUpperRight_Corner);
+  const SkVector lower_right = rrect.radii(SkRRect::kLowerRight_Corner);
+  const SkVector lower_left = rrect.radii(SkRRect::kLowerLeft_Corner);
+  SkRect inner = SkRect::MakeLTRB(
+      rect.fLeft + std::max(upper_left.fX, lower_left.fX),
+      rect.fTop + std::max(upper_left.fY, upper_right.fY),
+      rect.fRight - std::max(upper_right.fX, lower_right.fX),
+      rect.fBottom - std::max(lower_left.fY, lower_right.fY));
+  return inner.isSorted() ? inner : SkRect::MakeEmpty();
+}
+
 }  // namespace flutter
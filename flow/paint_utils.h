@@ -7,6 +7,8 @@
 
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkRRect.h"
 #include "third_party/skia/include/core/SkRect.h"
 
 namespace flutter {
@@ -15,6 +17,27 @@ void DrawCheckerboard(SkCanvas* canvas, SkColor c1, SkColor c2, int size);
 
 void DrawCheckerboard(SkCanvas* canvas, const SkRect& rect);
 
+// Returns a Gaussian blur with the given sigmas.
+//
+// Along the axes whose sigma is at least |downsample_min_sigma|, the blur is
+// evaluated at a resolution reduced by up to |max_downsample_factor| and then
+// scaled back up. The difference is not visible for such large blurs, and the
+// cost drops with the square of the factor. A |downsample_min_sigma| of 0
+// disables the downsampling.
+sk_sp<SkImageFilter> MakeBlurImageFilter(SkScalar sigma_x,
+                                         SkScalar sigma_y,
+                                         SkScalar downsample_min_sigma,
+                                         int max_downsample_factor);
+
+// Grows |opaque|, a rect covered by opaque content, by the opaque |rect|. As
+// the union of two rects is not a rect in general, the result is the union
+// when it is a rect and the larger of the two otherwise.
+void AccumulateOpaqueRect(SkRect* opaque, const SkRect& rect);
+
+// Returns a rect that lies within |rrect|, which is empty when the corners
+// leave no room for one.
+SkRect GetRRectInnerRect(const SkRRect& rrect);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_PAINT_UTILS_H_
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/paint_utils.h"
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+SkIRect FilterBounds(const sk_sp<SkImageFilter>& filter) {
+  return filter->filterBounds(SkIRect::MakeXYWH(100, 100, 200, 100),
+                              SkMatrix::I(),
+                              SkImageFilter::kForward_MapDirection);
+}
+
+}  // namespace
+
+TEST(PaintUtils, SmallBlursAreNotDownsampled) {
+  sk_sp<SkImageFilter> filter = MakeBlurImageFilter(10, 10, 20, 4);
+  EXPECT_EQ(filter->getInput(0), nullptr);
+  EXPECT_EQ(FilterBounds(filter),
+            FilterBounds(SkImageFilters::Blur(10, 10, SkTileMode::kClamp,
+                                              nullptr)));
+
+  // A minimum sigma of 0 disables the downsampling.
+  EXPECT_EQ(MakeBlurImageFilter(50, 50, 0, 4)->getInput(0), nullptr);
+}
+
+TEST(PaintUtils, LargeBlursAreDownsampled) {
+  sk_sp<SkImageFilter> filter = MakeBlurImageFilter(40, 40, 20, 4);
+  // The upsampling of the blur of the downsampled input.
+  ASSERT_NE(filter->getInput(0), nullptr);
+  ASSERT_NE(filter->getInput(0)->getInput(0), nullptr);
+
+  // The blur covers about the same area as a full resolution blur.
+  const SkIRect bounds = FilterBounds(filter);
+  const SkIRect expected_bounds = FilterBounds(
+      SkImageFilters::Blur(40, 40, SkTileMode::kClamp, nullptr));
+  EXPECT_LE(std::abs(bounds.fLeft - expected_bounds.fLeft), 4);
+  EXPECT_LE(std::abs(bounds.fTop - expected_bounds.fTop), 4);
+  EXPECT_LE(std::abs(bounds.fRight - expected_bounds.fRight), 4);
+  EXPECT_LE(std::abs(bounds.fBottom - expected_bounds.fBottom), 4);
+}
+
+TEST(PaintUtils, DirectionalBlursAreDownsampledAlongTheirAxis) {
+  EXPECT_NE(MakeBlurImageFilter(40, 0, 20, 4)->getInput(0), nullptr);
+  EXPECT_EQ(MakeBlurImageFilter(40, 0, 20, 1)->getInput(0), nullptr);
+}
+
+TEST(PaintUtils, OpaqueRectsAreJoinedWhenTheirUnionIsARect) {
+  SkRect opaque = SkRect::MakeEmpty();
+  AccumulateOpaqueRect(&opaque, SkRect::MakeLTRB(0, 0, 10, 10));
+  EXPECT_EQ(opaque, SkRect::MakeLTRB(0, 0, 10, 10));
+
+  AccumulateOpaqueRect(&opaque, SkRect::MakeLTRB(0, 10, 10, 30));
+  EXPECT_EQ(opaque, SkRect::MakeLTRB(0, 0, 10, 30));
+
+  // The union is not a rect, so the larger rect is kept.
+  AccumulateOpaqueRect(&opaque, SkRect::MakeLTRB(5, 0, 25, 20));
+  EXPECT_EQ(opaque, SkRect::MakeLTRB(5, 0, 25, 20));
+  AccumulateOpaqueRect(&opaque, SkRect::MakeLTRB(0, 0, 4, 4));
+  EXPECT_EQ(opaque, SkRect::MakeLTRB(5, 0, 25, 20));
+}
+
+TEST(PaintUtils, RRectInnerRectIsWithinTheCorners) {
+  const SkRect rect = SkRect::MakeLTRB(0, 0, 100, 50);
+  EXPECT_EQ(GetRRectInnerRect(SkRRect::MakeRect(rect)), rect);
+  EXPECT_EQ(GetRRectInnerRect(SkRRect::MakeRectXY(rect, 10, 5)),
+            SkRect::MakeLTRB(10, 5, 90, 45));
+  EXPECT_TRUE(GetRRectInnerRect(SkRRect::MakeOval(rect)).isEmpty());
+}
+
+}  // namespace testing
+}  // namespace flutter
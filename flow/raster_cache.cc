@@ -4,17 +4,25 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
 #include <vector>
 
 #include "flutter/common/constants.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkDeferredDisplayListRecorder.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkSurfaceCharacterization.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -23,6 +31,71 @@ RasterCacheResult::RasterCacheResult(sk_sp<SkImage> image,
                                      const SkRect& logical_rect)
     : image_(std::move(image)), logical_rect_(logical_rect) {}
 
+// Copies the pixels of an opaque raster image straight into the top layer of a
+// raster canvas when drawing it at an integer offset could not blend. Returns
+// false, without drawing anything, if the draw needs Skia's raster pipeline.
+static bool BlitOpaqueImage(SkCanvas& canvas,
+                            const SkImage& image,
+                            int left,
+                            int top,
+                            const SkPaint* paint) {
+  if (!image.isOpaque() || !canvas.getTotalMatrix().isIdentity() ||
+      !canvas.isClipRect()) {
+    return false;
+  }
+  if (paint != nullptr &&
+      (paint->getAlpha() != 0xff ||
+       (paint->getBlendMode() != SkBlendMode::kSrcOver &&
+        paint->getBlendMode() != SkBlendMode::kSrc) ||
+       paint->getShader() != nullptr || paint->getColorFilter() != nullptr ||
+       paint->getImageFilter() != nullptr ||
+       paint->getMaskFilter() != nullptr)) {
+    return false;
+  }
+
+  SkPixmap src;
+  if (!image.peekPixels(&src)) {
+    return false;
+  }
+
+  SkImageInfo dst_info;
+  size_t dst_row_bytes = 0;
+  SkIPoint dst_origin;
+  void* dst_pixels =
+      canvas.accessTopLayerPixels(&dst_info, &dst_row_bytes, &dst_origin);
+  if (dst_pixels == nullptr || dst_info.colorType() != src.colorType() ||
+      !SkColorSpace::Equals(dst_info.colorSpace(), src.colorSpace())) {
+    return false;
+  }
+
+  // Both rectangles are in device coordinates.
+  SkIRect rect = SkIRect::MakeXYWH(left, top, src.width(), src.height());
+  if (!rect.intersect(canvas.getDeviceClipBounds()) ||
+      !rect.intersect(SkIRect::MakeXYWH(dst_origin.x(), dst_origin.y(),
+                                        dst_info.width(),
+                                        dst_info.height()))) {
+    // Nothing is visible, which is as good as drawn.
+    return true;
+  }
+
+  if (auto* surface = canvas.getSurface()) {
+    // Writing to the pixels directly bypasses the copy on write of images
+    // snapshotted from the surface.
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  }
+
+  const size_t bytes_per_pixel = dst_info.bytesPerPixel();
+  const size_t row_size = rect.width() * bytes_per_pixel;
+  for (int y = rect.top(); y < rect.bottom(); y++) {
+    auto* dst_row = static_cast<uint8_t*>(dst_pixels) +
+                    (y - dst_origin.y()) * dst_row_bytes +
+                    (rect.left() - dst_origin.x()) * bytes_per_pixel;
+    const void* src_row = src.addr(rect.left() - left, y - top);
+    std::memcpy(dst_row, src_row, row_size);
+  }
+  return true;
+}
+
 void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
   TRACE_EVENT0("flutter", "RasterCacheResult::draw");
   SkAutoCanvasRestore auto_restore(&canvas, true);
@@ -32,9 +105,56 @@ void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
       std::abs(bounds.size().width() - image_->dimensions().width()) <= 1 &&
       std::abs(bounds.size().height() - image_->dimensions().height()) <= 1);
   canvas.resetMatrix();
+  if (BlitOpaqueImage(canvas, *image_, bounds.fLeft, bounds.fTop, paint)) {
+    return;
+  }
   canvas.drawImage(image_, bounds.fLeft, bounds.fTop, paint);
 }
 
+const char* RasterCacheDecision::GetKindName(Kind kind) {
+  switch (kind) {
+    case Kind::kPicture:
+      return "picture";
+    case Kind::kDisplayList:
+      return "displayList";
+    case Kind::kLayer:
+      return "layer";
+    case Kind::kShadow:
+      return "shadow";
+  }
+  return "";
+}
+
+const char* RasterCacheDecision::GetOutcomeName(Outcome outcome) {
+  switch (outcome) {
+    case Outcome::kCached:
+      return "cached";
+    case Outcome::kRasterized:
+      return "rasterized";
+    case Outcome::kAdopted:
+      return "adopted";
+    case Outcome::kPending:
+      return "pending";
+    case Outcome::kFailed:
+      return "failed";
+    case Outcome::kDisabled:
+      return "disabled";
+    case Outcome::kFrameLimitReached:
+      return "frameLimitReached";
+    case Outcome::kNotWorthRasterizing:
+      return "notWorthRasterizing";
+    case Outcome::kSingularMatrix:
+      return "singularMatrix";
+    case Outcome::kBelowAccessThreshold:
+      return "belowAccessThreshold";
+    case Outcome::kOverBudget:
+      return "overBudget";
+    case Outcome::kCount:
+      break;
+  }
+  return "";
+}
+
 RasterCache::RasterCache(size_t access_threshold,
                          size_t picture_cache_limit_per_frame)
     : access_threshold_(access_threshold),
@@ -87,15 +207,46 @@ static bool IsPictureWorthRasterizing(SkPicture* picture,
   return picture->approximateOpCount() > 5;
 }
 
+// Returns a GPU backed copy of |image| if |context| is not null.
+static sk_sp<SkImage> UploadImage(GrDirectContext* context,
+                                  sk_sp<SkImage> image) {
+  if (context) {
+    TRACE_EVENT0("flutter", "RasterCacheUpload");
+    if (sk_sp<SkImage> texture_image = image->makeTextureImage(context)) {
+      return texture_image;
+    }
+  }
+  return image;
+}
+
+// Draws the contents of a cache entry into |canvas|, whose origin is the top
+// left corner of |cache_rect|.
+static void DrawCacheContents(
+    SkCanvas* canvas,
+    const SkIRect& cache_rect,
+    const SkMatrix& ctm,
+    bool checkerboard,
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(-cache_rect.left(), -cache_rect.top());
+  canvas->concat(ctm);
+  draw_function(canvas);
+
+  if (checkerboard) {
+    DrawCheckerboard(canvas, logical_rect);
+  }
+}
+
 /// @note Procedure doesn't copy all closures.
-static std::unique_ptr<RasterCacheResult> Rasterize(
+static sk_sp<SkImage> RasterizeImage(
     GrDirectContext* context,
     const SkMatrix& ctm,
     SkColorSpace* dst_color_space,
     bool checkerboard,
+    bool compact_opaque,
     const SkRect& logical_rect,
     const std::function<void(SkCanvas*)>& draw_function) {
-  TRACE_EVENT0("flutter", "RasterCachePopulate");
   SkIRect cache_rect = RasterCache::GetDeviceBounds(logical_rect, ctm);
 
   const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
@@ -110,18 +261,57 @@ static std::unique_ptr<RasterCacheResult> Rasterize(
     return nullptr;
   }
 
-  SkCanvas* canvas = surface->getCanvas();
-  canvas->clear(SK_ColorTRANSPARENT);
-  canvas->translate(-cache_rect.left(), -cache_rect.top());
-  canvas->concat(ctm);
-  draw_function(canvas);
+  DrawCacheContents(surface->getCanvas(), cache_rect, ctm, checkerboard,
+                    logical_rect, draw_function);
 
-  if (checkerboard) {
-    DrawCheckerboard(canvas, logical_rect);
+  sk_sp<SkImage> image = surface->makeImageSnapshot();
+
+  // Raster images that turn out to be fully opaque are marked as such so that
+  // drawing them can skip blending and copy their pixels.
+  SkPixmap pixmap;
+  if (image && image->peekPixels(&pixmap) && pixmap.computeIsOpaque()) {
+    if (compact_opaque) {
+      // Opaque entries don't need an alpha channel, and RGB565 halves their
+      // memory at the cost of some color precision.
+      SkBitmap bitmap;
+      if (bitmap.tryAllocPixels(
+              pixmap.info().makeColorType(kRGB_565_SkColorType)) &&
+          pixmap.readPixels(bitmap.pixmap())) {
+        bitmap.setImmutable();
+        return SkImage::MakeFromBitmap(bitmap);
+      }
+    }
+    SkPixmap opaque_pixmap(pixmap.info().makeAlphaType(kOpaque_SkAlphaType),
+                           pixmap.addr(), pixmap.rowBytes());
+    SkImage* original = image.release();
+    return SkImage::MakeFromRaster(
+        opaque_pixmap,
+        [](const void* pixels, SkImage::ReleaseContext context) {
+          static_cast<SkImage*>(context)->unref();
+        },
+        original);
   }
 
-  return std::make_unique<RasterCacheResult>(surface->makeImageSnapshot(),
-                                             logical_rect);
+  return image;
+}
+
+/// @note Procedure doesn't copy all closures.
+static std::unique_ptr<RasterCacheResult> Rasterize(
+    GrDirectContext* context,
+    const SkMatrix& ctm,
+    SkColorSpace* dst_color_space,
+    bool checkerboard,
+    bool compact_opaque,
+    const SkRect& logical_rect,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  TRACE_EVENT0("flutter", "RasterCachePopulate");
+  sk_sp<SkImage> image =
+      RasterizeImage(context, ctm, dst_color_space, checkerboard,
+                     compact_opaque, logical_rect, draw_function);
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(std::move(image), logical_rect);
 }
 
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
@@ -131,20 +321,87 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizePicture(
     SkColorSpace* dst_color_space,
     bool checkerboard) const {
   return Rasterize(context, ctm, dst_color_space, checkerboard,
-                   picture->cullRect(),
+                   compact_opaque_entries_, picture->cullRect(),
                    [=](SkCanvas* canvas) { canvas->drawPicture(picture); });
 }
 
 void RasterCache::Prepare(PrerollContext* context,
                           Layer* layer,
                           const SkMatrix& ctm) {
+  using Outcome = RasterCacheDecision::Outcome;
+  RasterCacheDecision decision =
+      MakeDecision(RasterCacheDecision::Kind::kLayer, layer->unique_id(),
+                   layer->paint_bounds(), ctm);
   LayerRasterCacheKey cache_key(layer->unique_id(), ctm);
   Entry& entry = layer_cache_[cache_key];
   entry.access_count++;
-  entry.used_this_frame = true;
-  if (!entry.image) {
-    entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
+  MarkUsed(entry);
+  if (layer->subtree_has_changes()) {
+    // The layer was updated in place since the entry was rendered.
+    entry.image.reset();
+  }
+  if (entry.image) {
+    Decide(decision, Outcome::kCached, &entry);
+    return;
+  }
+  if (!FitsInBudget(layer->paint_bounds(), ctm)) {
+    Decide(decision, Outcome::kOverBudget, &entry);
+    return;
+  }
+  const fml::TimePoint rasterize_start = fml::TimePoint::Now();
+  entry.image = RasterizeLayer(context, layer, ctm, checkerboard_images_);
+  decision.rasterize_time = fml::TimePoint::Now() - rasterize_start;
+  Decide(decision, entry.image ? Outcome::kRasterized : Outcome::kFailed,
+         &entry);
+}
+
+bool RasterCache::PrepareShadow(
+    GrDirectContext* context,
+    uint64_t shadow_fingerprint,
+    const SkRect& logical_rect,
+    const SkMatrix& transformation_matrix,
+    SkColorSpace* dst_color_space,
+    const std::function<void(SkCanvas*)>& draw_shadow) {
+  using Outcome = RasterCacheDecision::Outcome;
+  RasterCacheDecision decision =
+      MakeDecision(RasterCacheDecision::Kind::kShadow, shadow_fingerprint,
+                   logical_rect, transformation_matrix);
+  if (access_threshold_ == 0) {
+    return Decide(decision, Outcome::kDisabled);
+  }
+  if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+    return Decide(decision, Outcome::kFrameLimitReached);
   }
+  if (logical_rect.isEmpty() || !logical_rect.isFinite()) {
+    return Decide(decision, Outcome::kNotWorthRasterizing);
+  }
+
+  const MatrixDecomposition matrix(transformation_matrix);
+  if (!matrix.IsValid()) {
+    return Decide(decision, Outcome::kSingularMatrix);
+  }
+
+  ShadowRasterCacheKey cache_key(shadow_fingerprint, transformation_matrix);
+  Entry& entry = shadow_cache_[cache_key];
+  if (entry.access_count < access_threshold_) {
+    return Decide(decision, Outcome::kBelowAccessThreshold, &entry);
+  }
+
+  if (entry.image) {
+    return Decide(decision, Outcome::kCached, &entry);
+  }
+  if (!FitsInBudget(logical_rect, transformation_matrix)) {
+    return Decide(decision, Outcome::kOverBudget, &entry);
+  }
+  const fml::TimePoint rasterize_start = fml::TimePoint::Now();
+  entry.image = Rasterize(context, transformation_matrix, dst_color_space,
+                          checkerboard_images_, compact_opaque_entries_,
+                          logical_rect, draw_shadow);
+  decision.rasterize_time = fml::TimePoint::Now() - rasterize_start;
+  picture_cached_this_frame_++;
+  Decide(decision, entry.image ? Outcome::kRasterized : Outcome::kFailed,
+         &entry);
+  return true;
 }
 
 std::unique_ptr<RasterCacheResult> RasterCache::RasterizeLayer(
@@ -154,7 +411,8 @@ std::unique_ptr<RasterCacheResult> RasterCache::RasterizeLayer(
     bool checkerboard) const {
   return Rasterize(
       context->gr_context, ctm, context->dst_color_space, checkerboard,
-      layer->paint_bounds(), [layer, context](SkCanvas* canvas) {
+      compact_opaque_entries_, layer->paint_bounds(),
+      [layer, context](SkCanvas* canvas) {
         SkISize canvas_size = canvas->getBaseLayerSize();
         SkNWayCanvas internal_nodes_canvas(canvas_size.width(),
                                            canvas_size.height());
@@ -183,16 +441,21 @@ bool RasterCache::Prepare(GrDirectContext* context,
                           SkColorSpace* dst_color_space,
                           bool is_complex,
                           bool will_change) {
+  using Outcome = RasterCacheDecision::Outcome;
+  RasterCacheDecision decision = MakeDecision(
+      RasterCacheDecision::Kind::kPicture, picture ? picture->uniqueID() : 0,
+      picture ? picture->cullRect() : SkRect::MakeEmpty(),
+      transformation_matrix);
   // Disabling caching when access_threshold is zero is historic behavior.
   if (access_threshold_ == 0) {
-    return false;
+    return Decide(decision, Outcome::kDisabled);
   }
   if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
-    return false;
+    return Decide(decision, Outcome::kFrameLimitReached);
   }
   if (!IsPictureWorthRasterizing(picture, will_change, is_complex)) {
     // We only deal with pictures that are worthy of rasterization.
-    return false;
+    return Decide(decision, Outcome::kNotWorthRasterizing);
   }
 
   // Decompose the matrix (once) for all subsequent operations. We want to make
@@ -201,23 +464,321 @@ bool RasterCache::Prepare(GrDirectContext* context,
 
   if (!matrix.IsValid()) {
     // The matrix was singular. No point in going further.
-    return false;
+    return Decide(decision, Outcome::kSingularMatrix);
   }
 
   PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
 
   // Creates an entry, if not present prior.
   Entry& entry = picture_cache_[cache_key];
+
+  // Persisted images were the most used entries of a previous launch, so they
+  // are installed without waiting for the access threshold. Searching them
+  // requires serializing the picture, which is left for after the frame.
+  if (!entry.image && entry.persisted_image) {
+    if (InstallPersistedImage(entry, context, picture,
+                              transformation_matrix)) {
+      return Decide(decision, Outcome::kAdopted, &entry);
+    }
+  } else if (!entry.image && !entry.persisted_image_lookup_done &&
+             !persisted_images_.empty()) {
+    entry.persisted_image_lookup_done = true;
+    persisted_image_lookups_.push_back(
+        {cache_key, sk_ref_sp(picture), transformation_matrix, nullptr});
+  }
+
   if (entry.access_count < access_threshold_) {
     // Frame threshold has not yet been reached.
-    return false;
+    return Decide(decision, Outcome::kBelowAccessThreshold, &entry);
   }
 
+  Outcome outcome = Outcome::kCached;
   if (!entry.image) {
+    if (!FitsInBudget(picture->cullRect(), transformation_matrix)) {
+      // Drawing the picture directly is preferred over exceeding the budget.
+      return Decide(decision, Outcome::kOverBudget, &entry);
+    }
+    if (async_rasterization_task_runner_) {
+      const fml::TimePoint rasterize_start = fml::TimePoint::Now();
+      const bool ready = PrepareAsync(entry, context, picture,
+                                      transformation_matrix, dst_color_space);
+      decision.rasterize_time = fml::TimePoint::Now() - rasterize_start;
+      return Decide(decision, ready ? Outcome::kRasterized : Outcome::kPending,
+                    &entry);
+    }
+    const fml::TimePoint rasterize_start = fml::TimePoint::Now();
     entry.image = RasterizePicture(picture, context, transformation_matrix,
                                    dst_color_space, checkerboard_images_);
+    decision.rasterize_time = fml::TimePoint::Now() - rasterize_start;
     picture_cached_this_frame_++;
+    outcome = entry.image ? Outcome::kRasterized : Outcome::kFailed;
   }
+  PersistIfNeeded(entry, cache_key, picture, transformation_matrix);
+  Decide(decision, outcome, &entry);
+  return true;
+}
+
+static bool IsDisplayListWorthRasterizing(DisplayList* display_list,
+                                          bool will_change,
+                                          bool is_complex) {
+  if (will_change || display_list == nullptr) {
+    return false;
+  }
+
+  const SkRect& bounds = display_list->bounds();
+  if (bounds.isEmpty() || !bounds.isFinite()) {
+    return false;
+  }
+
+  // Same heuristic as for pictures.
+  return is_complex || display_list->op_count() > 5;
+}
+
+bool RasterCache::Prepare(GrDirectContext* context,
+                          DisplayList* display_list,
+                          const SkMatrix& transformation_matrix,
+                          SkColorSpace* dst_color_space,
+                          bool is_complex,
+                          bool will_change) {
+  using Outcome = RasterCacheDecision::Outcome;
+  RasterCacheDecision decision =
+      MakeDecision(RasterCacheDecision::Kind::kDisplayList,
+                   display_list ? display_list->fingerprint() : 0,
+                   display_list ? display_list->bounds() : SkRect::MakeEmpty(),
+                   transformation_matrix);
+  if (access_threshold_ == 0) {
+    return Decide(decision, Outcome::kDisabled);
+  }
+  if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+    return Decide(decision, Outcome::kFrameLimitReached);
+  }
+  if (!IsDisplayListWorthRasterizing(display_list, will_change, is_complex)) {
+    return Decide(decision, Outcome::kNotWorthRasterizing);
+  }
+
+  const MatrixDecomposition matrix(transformation_matrix);
+  if (!matrix.IsValid()) {
+    return Decide(decision, Outcome::kSingularMatrix);
+  }
+
+  DisplayListRasterCacheKey cache_key(display_list->fingerprint(),
+                                      transformation_matrix);
+  Entry& entry = display_list_cache_[cache_key];
+
+  // Another engine already paid for rasterizing the same content, so its
+  // image is used without waiting for the access threshold.
+  if (!entry.image && shared_cache_ &&
+      FitsInBudget(display_list->bounds(), transformation_matrix)) {
+    if (sk_sp<SkImage> image =
+            shared_cache_->Get(cache_key, context, dst_color_space)) {
+      entry.image = std::make_unique<RasterCacheResult>(
+          std::move(image), display_list->bounds());
+      return Decide(decision, Outcome::kAdopted, &entry);
+    }
+  }
+
+  if (entry.access_count < access_threshold_) {
+    return Decide(decision, Outcome::kBelowAccessThreshold, &entry);
+  }
+
+  if (entry.image) {
+    return Decide(decision, Outcome::kCached, &entry);
+  }
+  if (!FitsInBudget(display_list->bounds(), transformation_matrix)) {
+    return Decide(decision, Outcome::kOverBudget, &entry);
+  }
+  const fml::TimePoint rasterize_start = fml::TimePoint::Now();
+  entry.image = Rasterize(context, transformation_matrix, dst_color_space,
+                          checkerboard_images_, compact_opaque_entries_,
+                          display_list->bounds(),
+                          [display_list](SkCanvas* canvas) {
+                            display_list->RenderTo(canvas);
+                          });
+  decision.rasterize_time = fml::TimePoint::Now() - rasterize_start;
+  picture_cached_this_frame_++;
+  if (entry.image && shared_cache_) {
+    shared_cache_->Put(cache_key, context, entry.image->image());
+  }
+  Decide(decision, entry.image ? Outcome::kRasterized : Outcome::kFailed,
+         &entry);
+  return true;
+}
+
+bool RasterCache::InstallPersistedImage(Entry& entry,
+                                        GrDirectContext* context,
+                                        SkPicture* picture,
+                                        const SkMatrix& transformation_matrix) {
+  sk_sp<SkImage> image = std::move(entry.persisted_image);
+  const SkIRect cache_rect =
+      GetDeviceBounds(picture->cullRect(), transformation_matrix);
+  if (image->width() != cache_rect.width() ||
+      image->height() != cache_rect.height() ||
+      !FitsInBudget(picture->cullRect(), transformation_matrix)) {
+    return false;
+  }
+
+  entry.image = std::make_unique<RasterCacheResult>(
+      UploadImage(context, std::move(image)), picture->cullRect());
+  entry.persisted = true;
+  picture_cached_this_frame_++;
+  return true;
+}
+
+void RasterCache::PersistIfNeeded(Entry& entry,
+                                  const PictureRasterCacheKey& cache_key,
+                                  SkPicture* picture,
+                                  const SkMatrix& transformation_matrix) {
+  if (!persist_callback_ || persisted_this_frame_ || entry.persisted ||
+      entry.access_count < kPersistAccessThreshold || !entry.image ||
+      !entry.image->image()) {
+    return;
+  }
+  entry.persisted = true;
+  persisted_this_frame_ = true;
+  pending_persists_.push_back({cache_key, sk_ref_sp(picture),
+                               transformation_matrix, entry.image->image()});
+}
+
+void RasterCache::ProcessPersistentCandidates() {
+  if (persisted_image_lookups_.empty() && pending_persists_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "RasterCache::ProcessPersistentCandidates");
+
+  // Bounds the pictures serialized between two frames the same way the
+  // pictures rasterized in a frame are bounded. The remaining lookups are
+  // done after the next frames.
+  size_t lookups = 0;
+  auto lookup = persisted_image_lookups_.begin();
+  for (; lookup != persisted_image_lookups_.end() &&
+         lookups < picture_cache_limit_per_frame_;
+       ++lookup) {
+    auto entry = picture_cache_.find(lookup->cache_key);
+    if (entry == picture_cache_.end() || entry->second.image) {
+      // The entry was swept or rasterized in the meantime.
+      continue;
+    }
+    lookups++;
+    sk_sp<SkData> key =
+        GetPersistentKey(lookup->picture.get(), lookup->matrix);
+    if (!key) {
+      continue;
+    }
+    auto found = persisted_images_.find(
+        std::string(static_cast<const char*>(key->data()), key->size()));
+    if (found == persisted_images_.end()) {
+      continue;
+    }
+    entry->second.persisted_image = std::move(found->second);
+    persisted_images_.erase(found);
+  }
+  persisted_image_lookups_.erase(persisted_image_lookups_.begin(), lookup);
+
+  for (const PersistentCandidate& pending : pending_persists_) {
+    sk_sp<SkData> key =
+        GetPersistentKey(pending.picture.get(), pending.matrix);
+    if (!key) {
+      continue;
+    }
+    // Reads back GPU backed images so that they can be encoded on another
+    // thread.
+    sk_sp<SkImage> image = pending.image->makeRasterImage();
+    if (!image) {
+      continue;
+    }
+    persist_callback_(std::move(key), std::move(image));
+  }
+  pending_persists_.clear();
+}
+
+bool RasterCache::PrepareAsync(Entry& entry,
+                               GrDirectContext* context,
+                               SkPicture* picture,
+                               const SkMatrix& transformation_matrix,
+                               SkColorSpace* dst_color_space) {
+  if (!entry.pending) {
+    auto pending = std::make_shared<AsyncRasterization>();
+    const SkIRect cache_rect =
+        GetDeviceBounds(picture->cullRect(), transformation_matrix);
+    SkSurfaceCharacterization characterization;
+    if (context && record_deferred_display_lists_) {
+      // The render target is allocated here because the GrDirectContext may
+      // only be used on the raster thread. The worker records the picture
+      // against its characterization.
+      const SkImageInfo image_info =
+          SkImageInfo::MakeN32Premul(cache_rect.width(), cache_rect.height(),
+                                     sk_ref_sp(dst_color_space));
+      pending->surface =
+          SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, image_info);
+      if (pending->surface &&
+          !pending->surface->characterize(&characterization)) {
+        pending->surface = nullptr;
+      }
+    }
+    entry.pending = pending;
+    async_rasterization_task_runner_->PostTask(
+        [pending, picture = sk_ref_sp(picture), ctm = transformation_matrix,
+         dst_color_space = sk_ref_sp(dst_color_space),
+         checkerboard = checkerboard_images_,
+         compact_opaque = compact_opaque_entries_, cache_rect,
+         characterization, record = pending->surface != nullptr]() {
+          if (record) {
+            TRACE_EVENT0("flutter", "RasterCacheRecordAsync");
+            SkDeferredDisplayListRecorder recorder(characterization);
+            DrawCacheContents(
+                recorder.getCanvas(), cache_rect, ctm, checkerboard,
+                picture->cullRect(),
+                [&picture](SkCanvas* canvas) { canvas->drawPicture(picture); });
+            sk_sp<SkDeferredDisplayList> display_list = recorder.detach();
+            std::scoped_lock lock(pending->mutex);
+            pending->display_list = std::move(display_list);
+            pending->done = true;
+            return;
+          }
+          TRACE_EVENT0("flutter", "RasterCachePopulateAsync");
+          // The raster thread's GrDirectContext may not be used here, so the
+          // picture is rasterized into a CPU backed image.
+          sk_sp<SkImage> image = RasterizeImage(
+              nullptr, ctm, dst_color_space.get(), checkerboard,
+              compact_opaque, picture->cullRect(),
+              [&picture](SkCanvas* canvas) { canvas->drawPicture(picture); });
+          std::scoped_lock lock(pending->mutex);
+          pending->image = std::move(image);
+          pending->done = true;
+        });
+    return false;
+  }
+
+  sk_sp<SkImage> image;
+  sk_sp<SkDeferredDisplayList> display_list;
+  {
+    std::scoped_lock lock(entry.pending->mutex);
+    if (!entry.pending->done) {
+      return false;
+    }
+    image = std::move(entry.pending->image);
+    display_list = std::move(entry.pending->display_list);
+  }
+  sk_sp<SkSurface> surface = std::move(entry.pending->surface);
+  entry.pending = nullptr;
+
+  if (display_list) {
+    // The recorded commands are submitted with the rest of the frame.
+    TRACE_EVENT0("flutter", "RasterCacheReplay");
+    if (!surface || !surface->draw(std::move(display_list))) {
+      return false;
+    }
+    image = surface->makeImageSnapshot();
+  } else {
+    image = UploadImage(context, std::move(image));
+  }
+  if (!image) {
+    return false;
+  }
+
+  entry.image = std::make_unique<RasterCacheResult>(std::move(image),
+                                                    picture->cullRect());
+  picture_cached_this_frame_++;
   return true;
 }
 
@@ -230,9 +791,10 @@ bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
 
   Entry& entry = it->second;
   entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
 
   if (entry.image) {
+    hits_this_frame_++;
     entry.image->draw(canvas, nullptr);
     return true;
   }
@@ -240,6 +802,29 @@ bool RasterCache::Draw(const SkPicture& picture, SkCanvas& canvas) const {
   return false;
 }
 
+bool RasterCache::Draw(const DisplayList& display_list,
+                       SkCanvas& canvas,
+                       SkPaint* paint) const {
+  DisplayListRasterCacheKey cache_key(display_list.fingerprint(),
+                                      canvas.getTotalMatrix());
+  auto it = display_list_cache_.find(cache_key);
+  if (it == display_list_cache_.end()) {
+    return false;
+  }
+
+  Entry& entry = it->second;
+  entry.access_count++;
+  MarkUsed(entry);
+
+  if (entry.image) {
+    hits_this_frame_++;
+    entry.image->draw(canvas, paint);
+    return true;
+  }
+
+  return false;
+}
+
 bool RasterCache::Draw(const Layer* layer,
                        SkCanvas& canvas,
                        SkPaint* paint) const {
@@ -251,9 +836,10 @@ bool RasterCache::Draw(const Layer* layer,
 
   Entry& entry = it->second;
   entry.access_count++;
-  entry.used_this_frame = true;
+  MarkUsed(entry);
 
   if (entry.image) {
+    hits_this_frame_++;
     entry.image->draw(canvas, paint);
     return true;
   }
@@ -261,28 +847,352 @@ bool RasterCache::Draw(const Layer* layer,
   return false;
 }
 
+bool RasterCache::DrawShadow(uint64_t shadow_fingerprint,
+                             SkCanvas& canvas) const {
+  ShadowRasterCacheKey cache_key(shadow_fingerprint, canvas.getTotalMatrix());
+  auto it = shadow_cache_.find(cache_key);
+  if (it == shadow_cache_.end()) {
+    return false;
+  }
+
+  Entry& entry = it->second;
+  entry.access_count++;
+  MarkUsed(entry);
+
+  if (entry.image) {
+    hits_this_frame_++;
+    entry.image->draw(canvas, nullptr);
+    return true;
+  }
+
+  return false;
+}
+
+bool RasterCache::DrawBackdrop(uint64_t backdrop_fingerprint,
+                               SkCanvas& canvas) const {
+  BackdropRasterCacheKey cache_key(backdrop_fingerprint, SkMatrix::I());
+  auto it = backdrop_cache_.find(cache_key);
+  if (it == backdrop_cache_.end()) {
+    return false;
+  }
+
+  Entry& entry = it->second;
+  entry.access_count++;
+  MarkUsed(entry);
+
+  if (entry.image) {
+    hits_this_frame_++;
+    SkAutoCanvasRestore auto_restore(&canvas, true);
+    canvas.resetMatrix();
+    entry.image->draw(canvas, nullptr);
+    return true;
+  }
+
+  return false;
+}
+
+bool RasterCache::HasBackdrop(uint64_t backdrop_fingerprint) const {
+  auto it = backdrop_cache_.find(
+      BackdropRasterCacheKey(backdrop_fingerprint, SkMatrix::I()));
+  return it != backdrop_cache_.end() && it->second.image;
+}
+
+void RasterCache::CacheBackdrop(uint64_t backdrop_fingerprint,
+                                const SkIRect& device_rect,
+                                sk_sp<SkImage> image) const {
+  const SkRect logical_rect = SkRect::Make(device_rect);
+  if (!image || !FitsInBudget(logical_rect, SkMatrix::I())) {
+    return;
+  }
+  BackdropRasterCacheKey cache_key(backdrop_fingerprint, SkMatrix::I());
+  Entry& entry = backdrop_cache_[cache_key];
+  MarkUsed(entry);
+  entry.image =
+      std::make_unique<RasterCacheResult>(std::move(image), logical_rect);
+}
+
+RasterCacheDecision RasterCache::MakeDecision(RasterCacheDecision::Kind kind,
+                                              uint64_t id,
+                                              const SkRect& logical_rect,
+                                              const SkMatrix& ctm) const {
+  RasterCacheDecision decision;
+  decision.kind = kind;
+  decision.outcome = RasterCacheDecision::Outcome::kCount;
+  decision.id = id;
+  if (IsRecordingDecisions() && logical_rect.isFinite()) {
+    decision.device_rect = GetDeviceBounds(logical_rect, ctm);
+  }
+  return decision;
+}
+
+bool RasterCache::Decide(RasterCacheDecision& decision,
+                         RasterCacheDecision::Outcome outcome,
+                         const Entry* entry) {
+  if (IsRecordingDecisions()) {
+    decision.outcome = outcome;
+    if (entry) {
+      decision.access_count = entry->access_count;
+      if (entry->image) {
+        decision.bytes = entry->image->image_bytes();
+      }
+    }
+    decisions_this_frame_.push_back(decision);
+  }
+  return RasterCacheDecision::IsCached(outcome);
+}
+
+void RasterCache::SetRecordDecisions(bool record) {
+  record_decisions_ = record;
+  if (!IsRecordingDecisions()) {
+    decisions_this_frame_.clear();
+    last_frame_decisions_.clear();
+  }
+}
+
+void RasterCache::SetShowDecisionHeatmap(bool show) {
+  show_decision_heatmap_ = show;
+  if (!IsRecordingDecisions()) {
+    decisions_this_frame_.clear();
+    last_frame_decisions_.clear();
+  }
+}
+
+void RasterCache::DrawDecisionHeatmap(SkCanvas& canvas) const {
+  using Outcome = RasterCacheDecision::Outcome;
+  SkAutoCanvasRestore auto_restore(&canvas, true);
+  canvas.resetMatrix();
+  SkPaint fill;
+  SkPaint stroke;
+  stroke.setStyle(SkPaint::kStroke_Style);
+  for (const auto& decision : decisions_this_frame_) {
+    SkColor color;
+    switch (decision.outcome) {
+      case Outcome::kCached:
+      case Outcome::kAdopted:
+        color = SK_ColorGREEN;
+        break;
+      case Outcome::kRasterized:
+      case Outcome::kFailed:
+        color = SK_ColorRED;
+        break;
+      case Outcome::kPending:
+      case Outcome::kBelowAccessThreshold:
+        color = SK_ColorYELLOW;
+        break;
+      default:
+        color = SK_ColorBLUE;
+        break;
+    }
+    const SkRect rect = SkRect::Make(decision.device_rect);
+    fill.setColor(SkColorSetA(color, 0x40));
+    stroke.setColor(color);
+    canvas.drawRect(rect, fill);
+    canvas.drawRect(rect, stroke);
+  }
+}
+
+void RasterCache::MarkUsed(Entry& entry) const {
+  entry.used_this_frame = true;
+  entry.last_access = ++access_clock_;
+}
+
+bool RasterCache::FitsInBudget(const SkRect& logical_rect,
+                               const SkMatrix& ctm) const {
+  if (max_bytes_ == 0) {
+    return true;
+  }
+  const SkIRect cache_rect = GetDeviceBounds(logical_rect, ctm);
+  const size_t image_bytes = SkImageInfo::MakeN32Premul(cache_rect.width(),
+                                                        cache_rect.height())
+                                 .computeMinByteSize();
+  const size_t cache_bytes = EstimatePictureCacheByteSize() +
+                             EstimateLayerCacheByteSize() +
+                             EstimateShadowCacheByteSize();
+  return cache_bytes + image_bytes <= max_bytes_;
+}
+
+void RasterCache::EnforceMaxBytes() {
+  if (max_bytes_ == 0) {
+    return;
+  }
+  EvictLeastRecentlyUsed(max_bytes_);
+}
+
+void RasterCache::Trim(size_t max_bytes) {
+  EvictLeastRecentlyUsed(max_bytes);
+}
+
+void RasterCache::EvictLeastRecentlyUsed(size_t max_bytes) {
+  size_t cache_bytes = EstimatePictureCacheByteSize() +
+                       EstimateLayerCacheByteSize() +
+                       EstimateShadowCacheByteSize();
+  if (cache_bytes <= max_bytes) {
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "RasterCache::EvictLeastRecentlyUsed");
+  // Pairs of (last access, image bytes) for every rasterized entry.
+  std::vector<std::pair<uint64_t, size_t>> entries;
+  for (const auto& item : picture_cache_) {
+    if (item.second.image) {
+      entries.emplace_back(item.second.last_access,
+                           item.second.image->image_bytes());
+    }
+  }
+  for (const auto& item : display_list_cache_) {
+    if (item.second.image) {
+      entries.emplace_back(item.second.last_access,
+                           item.second.image->image_bytes());
+    }
+  }
+  for (const auto& item : layer_cache_) {
+    if (item.second.image) {
+      entries.emplace_back(item.second.last_access,
+                           item.second.image->image_bytes());
+    }
+  }
+  for (const auto& item : backdrop_cache_) {
+    if (item.second.image) {
+      entries.emplace_back(item.second.last_access,
+                           item.second.image->image_bytes());
+    }
+  }
+  for (const auto& item : shadow_cache_) {
+    if (item.second.image) {
+      entries.emplace_back(item.second.last_access,
+                           item.second.image->image_bytes());
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+
+  uint64_t evict_until = 0;
+  for (const auto& entry : entries) {
+    if (cache_bytes <= max_bytes) {
+      break;
+    }
+    cache_bytes -= entry.second;
+    evict_until = entry.first;
+  }
+
+  EvictOneCacheUntil(picture_cache_, evict_until);
+  EvictOneCacheUntil(display_list_cache_, evict_until);
+  EvictOneCacheUntil(layer_cache_, evict_until);
+  EvictOneCacheUntil(backdrop_cache_, evict_until);
+  EvictOneCacheUntil(shadow_cache_, evict_until);
+}
+
 void RasterCache::SweepAfterFrame() {
   SweepOneCacheAfterFrame(picture_cache_);
+  SweepOneCacheAfterFrame(display_list_cache_);
   SweepOneCacheAfterFrame(layer_cache_);
+  SweepOneCacheAfterFrame(backdrop_cache_);
+  SweepOneCacheAfterFrame(shadow_cache_);
+  EnforceMaxBytes();
+  ProcessPersistentCandidates();
+  if (!persisted_images_.empty() && --persisted_images_sweeps_left_ == 0) {
+    // The pictures drawn at launch have been matched by now. Holding on to
+    // the remaining images would only keep every new entry searching them.
+    persisted_images_.clear();
+  }
+  if (persisted_images_.empty()) {
+    persisted_image_lookups_.clear();
+  }
   picture_cached_this_frame_ = 0;
+  hits_this_frame_ = 0;
+  persisted_this_frame_ = false;
   TraceStatsToTimeline();
+  if (IsRecordingDecisions()) {
+    TraceDecisionsToTimeline();
+    last_frame_decisions_ = std::move(decisions_this_frame_);
+    decisions_this_frame_.clear();
+  }
 }
 
 void RasterCache::Clear() {
   picture_cache_.clear();
+  display_list_cache_.clear();
   layer_cache_.clear();
+  backdrop_cache_.clear();
+  shadow_cache_.clear();
+  persisted_image_lookups_.clear();
+  pending_persists_.clear();
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
-  return layer_cache_.size() + picture_cache_.size();
+  return GetLayerCachedEntriesCount() + GetPictureCachedEntriesCount() +
+         GetShadowCachedEntriesCount();
 }
 
 size_t RasterCache::GetLayerCachedEntriesCount() const {
-  return layer_cache_.size();
+  return layer_cache_.size() + backdrop_cache_.size();
 }
 
 size_t RasterCache::GetPictureCachedEntriesCount() const {
-  return picture_cache_.size();
+  return picture_cache_.size() + display_list_cache_.size();
+}
+
+size_t RasterCache::GetShadowCachedEntriesCount() const {
+  return shadow_cache_.size();
+}
+
+void RasterCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  EnforceMaxBytes();
+}
+
+void RasterCache::SetAsyncRasterizationTaskRunner(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+  async_rasterization_task_runner_ = std::move(task_runner);
+}
+
+void RasterCache::SetRecordDeferredDisplayLists(bool record) {
+  record_deferred_display_lists_ = record;
+}
+
+void RasterCache::SetPersistCallback(PersistCallback callback) {
+  persist_callback_ = std::move(callback);
+}
+
+void RasterCache::AddPersistedImage(sk_sp<SkData> key, sk_sp<SkImage> image) {
+  if (!key || !image) {
+    return;
+  }
+  persisted_images_[std::string(static_cast<const char*>(key->data()),
+                                key->size())] = std::move(image);
+  persisted_images_sweeps_left_ = kPersistedImageLifetime;
+}
+
+sk_sp<SkData> RasterCache::GetPersistentKey(SkPicture* picture,
+                                            const SkMatrix& matrix) {
+  TRACE_EVENT0("flutter", "RasterCache::GetPersistentKey");
+  sk_sp<SkData> serialized = picture->serialize();
+  if (!serialized) {
+    return nullptr;
+  }
+  const uint64_t content_hash = std::hash<std::string_view>{}(std::string_view(
+      static_cast<const char*>(serialized->data()), serialized->size()));
+  const uint64_t content_size = serialized->size();
+  SkScalar matrix_values[9];
+  matrix.get9(matrix_values);
+
+  sk_sp<SkData> key = SkData::MakeUninitialized(
+      sizeof(content_hash) + sizeof(content_size) + sizeof(matrix_values));
+  uint8_t* bytes = static_cast<uint8_t*>(key->writable_data());
+  memcpy(bytes, &content_hash, sizeof(content_hash));
+  bytes += sizeof(content_hash);
+  memcpy(bytes, &content_size, sizeof(content_size));
+  bytes += sizeof(content_size);
+  memcpy(bytes, matrix_values, sizeof(matrix_values));
+  return key;
+}
+
+void RasterCache::SetSharedCache(
+    std::shared_ptr<SharedRasterCache> shared_cache) {
+  shared_cache_ = std::move(shared_cache);
+}
+
+void RasterCache::SetCompactOpaqueEntries(bool compact) {
+  compact_opaque_entries_ = compact;
 }
 
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
@@ -300,14 +1210,48 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "RasterCache", reinterpret_cast<int64_t>(this),
-                    "LayerCount", layer_cache_.size(), "LayerMBytes",
+                    "LayerCount", GetLayerCachedEntriesCount(), "LayerMBytes",
                     EstimateLayerCacheByteSize() / kMegaByteSizeInBytes,
-                    "PictureCount", picture_cache_.size(), "PictureMBytes",
-                    EstimatePictureCacheByteSize() / kMegaByteSizeInBytes);
+                    "PictureCount", GetPictureCachedEntriesCount(),
+                    "PictureMBytes",
+                    EstimatePictureCacheByteSize() / kMegaByteSizeInBytes,
+                    "ShadowCount", GetShadowCachedEntriesCount(),
+                    "ShadowMBytes",
+                    EstimateShadowCacheByteSize() / kMegaByteSizeInBytes);
 
 #endif  // !FLUTTER_RELEASE
 }
 
+void RasterCache::TraceDecisionsToTimeline() const {
+#if !FLUTTER_RELEASE
+  using Outcome = RasterCacheDecision::Outcome;
+  std::array<size_t, static_cast<size_t>(Outcome::kCount)> counts = {};
+  fml::TimeDelta rasterize_time;
+  int64_t rasterized_bytes = 0;
+  for (const auto& decision : decisions_this_frame_) {
+    counts[static_cast<size_t>(decision.outcome)]++;
+    rasterize_time = rasterize_time + decision.rasterize_time;
+    if (decision.outcome == Outcome::kRasterized) {
+      rasterized_bytes += decision.bytes;
+    }
+  }
+  auto count = [&counts](Outcome outcome) {
+    return counts[static_cast<size_t>(outcome)];
+  };
+  FML_TRACE_COUNTER(
+      "flutter", "RasterCacheDecisions", reinterpret_cast<int64_t>(this),
+      "Cached", count(Outcome::kCached) + count(Outcome::kAdopted),
+      "Rasterized", count(Outcome::kRasterized), "Pending",
+      count(Outcome::kPending), "BelowAccessThreshold",
+      count(Outcome::kBelowAccessThreshold), "FrameLimitReached",
+      count(Outcome::kFrameLimitReached), "NotWorthRasterizing",
+      count(Outcome::kNotWorthRasterizing), "OverBudget",
+      count(Outcome::kOverBudget), "RasterizeMicros",
+      rasterize_time.ToMicroseconds(), "RasterizedKBytes",
+      rasterized_bytes / 1024);
+#endif  // !FLUTTER_RELEASE
+}
+
 size_t RasterCache::EstimateLayerCacheByteSize() const {
   size_t layer_cache_bytes = 0;
   for (const auto& item : layer_cache_) {
@@ -315,6 +1259,11 @@ size_t RasterCache::EstimateLayerCacheByteSize() const {
       layer_cache_bytes += item.second.image->image_bytes();
     }
   }
+  for (const auto& item : backdrop_cache_) {
+    if (item.second.image) {
+      layer_cache_bytes += item.second.image->image_bytes();
+    }
+  }
   return layer_cache_bytes;
 }
 
@@ -325,7 +1274,22 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
       picture_cache_bytes += item.second.image->image_bytes();
     }
   }
+  for (const auto& item : display_list_cache_) {
+    if (item.second.image) {
+      picture_cache_bytes += item.second.image->image_bytes();
+    }
+  }
   return picture_cache_bytes;
 }
 
+size_t RasterCache::EstimateShadowCacheByteSize() const {
+  size_t shadow_cache_bytes = 0;
+  for (const auto& item : shadow_cache_) {
+    if (item.second.image) {
+      shadow_cache_bytes += item.second.image->image_bytes();
+    }
+  }
+  return shadow_cache_bytes;
+}
+
 }  // namespace flutter
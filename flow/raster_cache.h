@@ -5,14 +5,26 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/raster_cache_key.h"
+#include "flutter/flow/shared_raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkDeferredDisplayList.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
@@ -32,6 +44,8 @@ class RasterCacheResult {
     return image_ ? image_->imageInfo().computeMinByteSize() : 0;
   };
 
+  const sk_sp<SkImage>& image() const { return image_; }
+
  private:
   sk_sp<SkImage> image_;
   SkRect logical_rect_;
@@ -39,6 +53,64 @@ class RasterCacheResult {
 
 struct PrerollContext;
 
+// Why |RasterCache::Prepare| did or did not cache a candidate during a frame.
+// See |RasterCache::SetRecordDecisions|.
+struct RasterCacheDecision {
+  enum class Kind { kPicture, kDisplayList, kLayer, kShadow };
+
+  enum class Outcome {
+    // The image rasterized in a previous frame is drawn.
+    kCached,
+    // The candidate was rasterized during this frame.
+    kRasterized,
+    // An image persisted by a previous launch or rasterized by another engine
+    // is drawn without rasterizing the candidate.
+    kAdopted,
+    // The candidate is being rasterized asynchronously.
+    kPending,
+    // The rasterization of the candidate failed.
+    kFailed,
+    // The access threshold of the cache is zero.
+    kDisabled,
+    // The per frame limit of rasterizations was reached.
+    kFrameLimitReached,
+    // The candidate will change, is empty, or is too simple to be worth it.
+    kNotWorthRasterizing,
+    // The candidate is drawn with a singular matrix.
+    kSingularMatrix,
+    // The candidate was not drawn in enough frames yet.
+    kBelowAccessThreshold,
+    // The image would not fit in the budget set with
+    // |RasterCache::SetMaxBytes|.
+    kOverBudget,
+    kCount
+  };
+
+  static const char* GetKindName(Kind kind);
+
+  static const char* GetOutcomeName(Outcome outcome);
+
+  // Whether the cache draws an image in place of the candidate.
+  static bool IsCached(Outcome outcome) {
+    return outcome == Outcome::kCached || outcome == Outcome::kRasterized ||
+           outcome == Outcome::kAdopted;
+  }
+
+  Kind kind;
+  Outcome outcome;
+  // The unique ID of the picture or layer, or the fingerprint of the display
+  // list or shadow.
+  uint64_t id = 0;
+  // The pixels the candidate covers on the surface.
+  SkIRect device_rect = SkIRect::MakeEmpty();
+  // The number of frames in which the candidate was drawn.
+  size_t access_count = 0;
+  // The time spent rasterizing the candidate during this frame.
+  fml::TimeDelta rasterize_time;
+  // The bytes used by the image of the candidate, if any.
+  int64_t bytes = 0;
+};
+
 class RasterCache {
  public:
   // The default max number of picture raster caches to be generated per frame.
@@ -47,6 +119,17 @@ class RasterCache {
   // multiple frames.
   static constexpr int kDefaultPictureCacheLimitPerFrame = 3;
 
+  // The number of accesses after which a picture raster cache entry is handed
+  // to the persist callback. See |SetPersistCallback|.
+  static constexpr size_t kPersistAccessThreshold = 60;
+
+  // The number of frames after which the persisted images that were not
+  // matched by any picture are dropped. See |AddPersistedImage|.
+  static constexpr size_t kPersistedImageLifetime = 120;
+
+  using PersistCallback =
+      std::function<void(sk_sp<SkData> key, sk_sp<SkImage> image)>;
+
   explicit RasterCache(
       size_t access_threshold = 3,
       size_t picture_cache_limit_per_frame = kDefaultPictureCacheLimitPerFrame);
@@ -139,13 +222,46 @@ class RasterCache {
                bool is_complex,
                bool will_change);
 
+  // Like the |Prepare| for pictures, for a display list. Entries are shared
+  // by the display lists with the same fingerprint, so content re-recorded
+  // every frame keeps its access count and its image. Display lists are
+  // always rasterized synchronously and are not persisted.
+  bool Prepare(GrDirectContext* context,
+               DisplayList* display_list,
+               const SkMatrix& transformation_matrix,
+               SkColorSpace* dst_color_space,
+               bool is_complex,
+               bool will_change);
+
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
+  // Like the |Prepare| for pictures, for the shadow identified by
+  // |shadow_fingerprint|. |draw_shadow| draws the shadow, which covers
+  // |logical_rect|, and is only called if the shadow is rasterized.
+  //
+  // Shadows share the per frame limit of the pictures.
+  bool PrepareShadow(GrDirectContext* context,
+                     uint64_t shadow_fingerprint,
+                     const SkRect& logical_rect,
+                     const SkMatrix& transformation_matrix,
+                     SkColorSpace* dst_color_space,
+                     const std::function<void(SkCanvas*)>& draw_shadow);
+
   // Find the raster cache for the picture and draw it to the canvas.
   //
   // Return true if it's found and drawn.
   bool Draw(const SkPicture& picture, SkCanvas& canvas) const;
 
+  // Find the raster cache for the display list and draw it to the canvas.
+  //
+  // Addional paint can be given to change how the raster cache is drawn (e.g.,
+  // draw the raster cache with an opacity inherited from an ancestor).
+  //
+  // Return true if it's found and drawn.
+  bool Draw(const DisplayList& display_list,
+            SkCanvas& canvas,
+            SkPaint* paint = nullptr) const;
+
   // Find the raster cache for the layer and draw it to the canvas.
   //
   // Addional paint can be given to change how the raster cache is drawn (e.g.,
@@ -156,18 +272,201 @@ class RasterCache {
             SkCanvas& canvas,
             SkPaint* paint = nullptr) const;
 
+  // Find the raster cache for the shadow identified by |shadow_fingerprint|
+  // and draw it to the canvas.
+  //
+  // Return true if it's found and drawn.
+  bool DrawShadow(uint64_t shadow_fingerprint, SkCanvas& canvas) const;
+
+  // Find the cached output of the backdrop filter identified by
+  // |backdrop_fingerprint| and draw it to the canvas in device space, i.e.
+  // ignoring the canvas matrix.
+  //
+  // Return true if it's found and drawn.
+  bool DrawBackdrop(uint64_t backdrop_fingerprint, SkCanvas& canvas) const;
+
+  // Whether the output of the backdrop filter identified by
+  // |backdrop_fingerprint| is cached.
+  bool HasBackdrop(uint64_t backdrop_fingerprint) const;
+
+  // Cache |image| as the output of the backdrop filter identified by
+  // |backdrop_fingerprint|, covering |device_rect|.
+  //
+  // Unlike the other entries, the output of a backdrop filter can only be
+  // computed while painting, once the content behind it has been painted.
+  void CacheBackdrop(uint64_t backdrop_fingerprint,
+                     const SkIRect& device_rect,
+                     sk_sp<SkImage> image) const;
+
   void SweepAfterFrame();
 
   void Clear();
 
+  /**
+   * @brief The number of times an entry was drawn in place of its picture or
+   * layer since the last |SweepAfterFrame|.
+   */
+  size_t GetHitsThisFrame() const { return hits_this_frame_; }
+
+  /**
+   * @brief The number of pictures rasterized into the cache since the last
+   * |SweepAfterFrame|.
+   */
+  size_t GetPicturesCachedThisFrame() const {
+    return picture_cached_this_frame_;
+  }
+
+  /**
+   * @brief Limit the memory used by the raster cache entries to |max_bytes|.
+   *
+   * New entries that would not fit in the budget are not rasterized, and the
+   * least recently used entries are evicted at the end of each frame until
+   * the cache fits in the budget again. A value of zero means no limit.
+   */
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t GetMaxBytes() const { return max_bytes_; }
+
+  /**
+   * @brief Evicts the least recently used entries until the images in the
+   * cache use at most |max_bytes|, without changing the budget.
+   */
+  void Trim(size_t max_bytes);
+
+  /**
+   * @brief Rasterize pictures asynchronously on |task_runner| instead of
+   * during preroll.
+   *
+   * Pictures are rasterized into CPU backed images on the given task runner
+   * and the picture itself is drawn until the result is ready. The result is
+   * uploaded to the GPU the next time the picture is prepared on the raster
+   * thread. Passing null restores synchronous rasterization.
+   */
+  void SetAsyncRasterizationTaskRunner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner);
+
+  /**
+   * @brief Record the pictures rasterized asynchronously into deferred
+   * display lists instead of CPU backed images.
+   *
+   * When a GrDirectContext is available, the render target of an entry is
+   * allocated on the raster thread and the worker records the GPU commands
+   * drawing the picture against its characterization. Several entries are
+   * recorded in parallel and the recordings are replayed into their render
+   * targets on the raster thread, which avoids the CPU rasterization and the
+   * upload. Without a GrDirectContext, the pictures are rasterized into CPU
+   * backed images as usual. This has no effect unless a task runner was set
+   * with |SetAsyncRasterizationTaskRunner|.
+   */
+  void SetRecordDeferredDisplayLists(bool record);
+
+  /**
+   * @brief Set the callback used to persist frequently used picture raster
+   * cache entries across application launches.
+   *
+   * The callback is invoked on the raster thread with the persistent key of
+   * the entry (see |GetPersistentKey|) and a CPU backed copy of its image once
+   * the entry has been accessed |kPersistAccessThreshold| times. It is invoked
+   * at most once per entry and once per frame, from |SweepAfterFrame| so that
+   * computing the key and reading the image back do not delay the frame.
+   */
+  void SetPersistCallback(PersistCallback callback);
+
+  /**
+   * @brief Provide an image persisted by a previous launch.
+   *
+   * The image is used instead of rasterizing the picture with the same
+   * persistent key. Pictures are matched against the persisted images after
+   * the frame in which they are first prepared and use the image from the
+   * next frame on. Images that were not matched within
+   * |kPersistedImageLifetime| frames are dropped.
+   */
+  void AddPersistedImage(sk_sp<SkData> key, sk_sp<SkImage> image);
+
+  size_t GetPersistedImagesCount() const { return persisted_images_.size(); }
+
+  /**
+   * @brief A key identifying the rasterization of |picture| with |matrix| that
+   * is stable across application launches.
+   *
+   * Unlike the |PictureRasterCacheKey|, which uses the picture's unique ID,
+   * this key is derived from the serialized contents of the picture. Returns
+   * null if the picture cannot be serialized.
+   */
+  static sk_sp<SkData> GetPersistentKey(SkPicture* picture,
+                                        const SkMatrix& matrix);
+
+  /**
+   * @brief Share the display list entries of this cache with the other raster
+   * caches using |shared_cache|.
+   *
+   * Display lists are keyed by their content, so engines drawing the same
+   * content with the same matrix reuse each other's images instead of each
+   * rasterizing their own copy. A shared image is used as soon as it is
+   * found, and counts against the budget of every cache using it. Passing
+   * null stops sharing.
+   */
+  void SetSharedCache(std::shared_ptr<SharedRasterCache> shared_cache);
+
+  /**
+   * @brief Store the entries rasterized on the CPU that turn out to be fully
+   * opaque as RGB565 images, which use half the memory of N32 images.
+   *
+   * This trades color precision for cache capacity, so more entries fit in
+   * the budget set with |SetMaxBytes|. Entries rasterized asynchronously are
+   * uploaded to the GPU in the compact format as well.
+   */
+  void SetCompactOpaqueEntries(bool compact);
+
   void SetCheckboardCacheImages(bool checkerboard);
 
+  /**
+   * @brief Record why each candidate of |Prepare| was cached or not.
+   *
+   * The decisions are summarized on the timeline at the end of each frame,
+   * and those of the last frame are available from |GetLastFrameDecisions|.
+   */
+  void SetRecordDecisions(bool record);
+
+  /**
+   * @brief Paint the area of each candidate over the frame, colored by the
+   * decision made for it: green when it is drawn from the cache, red when it
+   * was rasterized during the frame, yellow while it waits for the access
+   * threshold or an asynchronous rasterization, and blue when it was
+   * rejected. Implies |SetRecordDecisions|.
+   *
+   * Unlike |SetCheckboardCacheImages|, this shows the candidates that are not
+   * cached and does not change the cached images.
+   */
+  void SetShowDecisionHeatmap(bool show);
+
+  bool GetShowDecisionHeatmap() const { return show_decision_heatmap_; }
+
+  bool IsRecordingDecisions() const {
+    return record_decisions_ || show_decision_heatmap_;
+  }
+
+  /**
+   * @brief The decisions recorded during the last complete frame.
+   */
+  const std::vector<RasterCacheDecision>& GetLastFrameDecisions() const {
+    return last_frame_decisions_;
+  }
+
+  /**
+   * @brief Paint the heatmap of the decisions of the current frame into
+   * |canvas|, whose device coordinates are those of the frame.
+   */
+  void DrawDecisionHeatmap(SkCanvas& canvas) const;
+
   size_t GetCachedEntriesCount() const;
 
   size_t GetLayerCachedEntriesCount() const;
 
   size_t GetPictureCachedEntriesCount() const;
 
+  size_t GetShadowCachedEntriesCount() const;
+
   /**
    * @brief Estimate how much memory is used by picture raster cache entries in
    * bytes.
@@ -188,11 +487,46 @@ class RasterCache {
    */
   size_t EstimateLayerCacheByteSize() const;
 
+  /**
+   * @brief Estimate how much memory is used by shadow raster cache entries in
+   * bytes.
+   *
+   * Only SkImage's memory usage is counted as other objects are often much
+   * smaller compared to SkImage. SkImageInfo::computeMinByteSize is used to
+   * estimate the SkImage memory usage.
+   */
+  size_t EstimateShadowCacheByteSize() const;
+
  private:
+  // The result of a picture rasterization running on
+  // |async_rasterization_task_runner_|.
+  struct AsyncRasterization {
+    std::mutex mutex;
+    bool done = false;
+    sk_sp<SkImage> image;
+    // The render target and the recording of the picture into it when
+    // deferred display lists are recorded. |surface| is only accessed on the
+    // raster thread.
+    sk_sp<SkSurface> surface;
+    sk_sp<SkDeferredDisplayList> display_list;
+  };
+
   struct Entry {
     bool used_this_frame = false;
     size_t access_count = 0;
+    // The value of |access_clock_| when this entry was last used. Used to
+    // find the least recently used entries when the cache is over budget.
+    uint64_t last_access = 0;
     std::unique_ptr<RasterCacheResult> image;
+    std::shared_ptr<AsyncRasterization> pending;
+    // Whether the persisted images were searched for this entry.
+    bool persisted_image_lookup_done = false;
+    // The persisted image matched by the lookup, installed the next time the
+    // entry is prepared.
+    sk_sp<SkImage> persisted_image;
+    // Whether this entry was handed to |persist_callback_| or comes from a
+    // persisted image.
+    bool persisted = false;
   };
 
   template <class Cache>
@@ -212,15 +546,115 @@ class RasterCache {
     }
   }
 
+  template <class Cache>
+  static void EvictOneCacheUntil(Cache& cache, uint64_t last_access) {
+    for (auto it = cache.begin(); it != cache.end();) {
+      if (it->second.image && it->second.last_access <= last_access) {
+        it = cache.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void MarkUsed(Entry& entry) const;
+
+  // Whether an image covering |logical_rect| under |ctm| can be added to the
+  // cache without exceeding |max_bytes_|.
+  bool FitsInBudget(const SkRect& logical_rect, const SkMatrix& ctm) const;
+
+  // Evicts the least recently used entries until the cache fits in
+  // |max_bytes_|.
+  void EnforceMaxBytes();
+
+  // Evicts the least recently used entries until the cache fits in
+  // |max_bytes|.
+  void EvictLeastRecentlyUsed(size_t max_bytes);
+
+  // Starts or completes the asynchronous rasterization of |picture| into
+  // |entry|. Returns true if |entry| holds an image afterwards.
+  bool PrepareAsync(Entry& entry,
+                    GrDirectContext* context,
+                    SkPicture* picture,
+                    const SkMatrix& transformation_matrix,
+                    SkColorSpace* dst_color_space);
+
+  // A picture entry to search the persisted images for, or whose image to
+  // persist, after the frame.
+  struct PersistentCandidate {
+    PictureRasterCacheKey cache_key;
+    sk_sp<SkPicture> picture;
+    SkMatrix matrix;
+    sk_sp<SkImage> image;
+  };
+
+  // Fills |entry| with its matched |Entry::persisted_image|. Returns true if
+  // |entry| holds an image afterwards.
+  bool InstallPersistedImage(Entry& entry,
+                             GrDirectContext* context,
+                             SkPicture* picture,
+                             const SkMatrix& transformation_matrix);
+
+  // Queues the image of |entry| for |persist_callback_| if it is used often
+  // enough.
+  void PersistIfNeeded(Entry& entry,
+                       const PictureRasterCacheKey& cache_key,
+                       SkPicture* picture,
+                       const SkMatrix& transformation_matrix);
+
+  // Searches the persisted images for the entries prepared during the frame
+  // and hands the queued images to |persist_callback_|. Called once the frame
+  // is done so that neither serializing the pictures nor reading back their
+  // images happens during the frame.
+  void ProcessPersistentCandidates();
+
+  // Starts the decision for a candidate covering |logical_rect| under |ctm|.
+  RasterCacheDecision MakeDecision(RasterCacheDecision::Kind kind,
+                                   uint64_t id,
+                                   const SkRect& logical_rect,
+                                   const SkMatrix& ctm) const;
+
+  // Records |outcome| as the decision for |decision| when decisions are
+  // recorded. Returns whether the candidate is drawn from the cache.
+  bool Decide(RasterCacheDecision& decision,
+              RasterCacheDecision::Outcome outcome,
+              const Entry* entry = nullptr);
+
   const size_t access_threshold_;
   const size_t picture_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
+  mutable size_t hits_this_frame_ = 0;
+  size_t max_bytes_ = 0;
+  bool compact_opaque_entries_ = false;
+  std::shared_ptr<SharedRasterCache> shared_cache_;
+  mutable uint64_t access_clock_ = 0;
+  std::shared_ptr<fml::BasicTaskRunner> async_rasterization_task_runner_;
+  bool record_deferred_display_lists_ = false;
+  PersistCallback persist_callback_;
+  bool persisted_this_frame_ = false;
+  std::unordered_map<std::string, sk_sp<SkImage>> persisted_images_;
+  // The number of sweeps left before |persisted_images_| is dropped.
+  size_t persisted_images_sweeps_left_ = 0;
+  std::vector<PersistentCandidate> persisted_image_lookups_;
+  std::vector<PersistentCandidate> pending_persists_;
   mutable PictureRasterCacheKey::Map<Entry> picture_cache_;
+  // Display lists are keyed by their content fingerprints, which are unrelated
+  // to picture IDs, so they are cached apart.
+  mutable DisplayListRasterCacheKey::Map<Entry> display_list_cache_;
   mutable LayerRasterCacheKey::Map<Entry> layer_cache_;
+  // Filled during paint, see |CacheBackdrop|. Counted as layer entries.
+  mutable BackdropRasterCacheKey::Map<Entry> backdrop_cache_;
+  mutable ShadowRasterCacheKey::Map<Entry> shadow_cache_;
   bool checkerboard_images_;
+  bool record_decisions_ = false;
+  bool show_decision_heatmap_ = false;
+  std::vector<RasterCacheDecision> decisions_this_frame_;
+  std::vector<RasterCacheDecision> last_frame_decisions_;
 
   void TraceStatsToTimeline() const;
 
+  void TraceDecisionsToTimeline() const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(RasterCache);
 };
 
@@ -52,6 +52,20 @@ class RasterCacheKey {
 // The ID is the uint32_t picture uniqueID
 using PictureRasterCacheKey = RasterCacheKey<uint32_t>;
 
+// The ID is the uint64_t display list fingerprint, so that display lists
+// re-recorded with the same content share their entries.
+using DisplayListRasterCacheKey = RasterCacheKey<uint64_t>;
+
+// The ID is the backdrop fingerprint computed by
+// |DiffContext::AddBackdropRegion|. Backdrop entries are in device space, so
+// their matrix is always the identity.
+using BackdropRasterCacheKey = RasterCacheKey<uint64_t>;
+
+// The ID is the shadow fingerprint computed by |PhysicalShapeLayer|, which
+// only depends on the shape and the shadow parameters, so that identical
+// shapes share their entries regardless of their positions.
+using ShadowRasterCacheKey = RasterCacheKey<uint64_t>;
+
 class Layer;
 
 // The ID is the uint64_t layer unique_id
@@ -4,11 +4,16 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -24,6 +29,14 @@ sk_sp<SkPicture> GetSamplePicture() {
   return recorder.finishRecordingAsPicture();
 }
 
+sk_sp<DisplayList> GetSampleDisplayList() {
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(150, 100));
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  recorder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80), paint);
+  return recorder.Build();
+}
+
 }  // namespace
 
 TEST(RasterCache, SimpleInitialization) {
@@ -65,6 +78,59 @@ TEST(RasterCache, ThresholdIsRespected) {
   ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
 }
 
+TEST(RasterCache, ReRecordedDisplayListsShareEntries) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  // Every frame records a new display list with the same content.
+  for (int frame = 0; frame < 2; frame++) {
+    auto display_list = GetSampleDisplayList();
+    ASSERT_FALSE(cache.Prepare(NULL, display_list.get(), matrix, srgb.get(),
+                               true, false));
+    ASSERT_FALSE(cache.Draw(*display_list, dummy_canvas));
+    cache.SweepAfterFrame();
+  }
+
+  auto display_list = GetSampleDisplayList();
+  ASSERT_TRUE(cache.Prepare(NULL, display_list.get(), matrix, srgb.get(), true,
+                            false));
+  ASSERT_TRUE(cache.Draw(*display_list, dummy_canvas));
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+}
+
+TEST(RasterCache, CountsHitsOfTheCurrentFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  // A miss is not a hit.
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(cache.GetHitsThisFrame(), 0u);
+
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(cache.GetHitsThisFrame(), 2u);
+
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetHitsThisFrame(), 0u);
+}
+
 TEST(RasterCache, AccessThresholdOfZeroDisablesCaching) {
   size_t threshold = 0;
   flutter::RasterCache cache(threshold);
@@ -132,6 +198,342 @@ TEST(RasterCache, SweepsRemoveUnusedFrames) {
   ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
 }
 
+TEST(RasterCache, PicturesExceedingMaxBytesAreNotCached) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // The sample picture requires 150 * 100 * 4 bytes.
+  cache.SetMaxBytes(1000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.SweepAfterFrame();
+
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, MaxBytesEvictsLeastRecentlyUsedEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture1 = GetSamplePicture();
+  auto picture2 = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (auto& picture : {picture1, picture2}) {
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+    ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  }
+
+  cache.SweepAfterFrame();
+
+  for (auto& picture : {picture1, picture2}) {
+    ASSERT_TRUE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  }
+  // Make picture1 the most recently used entry.
+  ASSERT_TRUE(cache.Draw(*picture2, dummy_canvas));
+  ASSERT_TRUE(cache.Draw(*picture1, dummy_canvas));
+
+  const size_t picture_bytes = 150 * 100 * 4;
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 2 * picture_bytes);
+
+  cache.SetMaxBytes(picture_bytes);
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), picture_bytes);
+  ASSERT_TRUE(cache.Draw(*picture1, dummy_canvas));
+  ASSERT_FALSE(cache.Draw(*picture2, dummy_canvas));
+}
+
+TEST(RasterCache, TrimEvictsLeastRecentlyUsedEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture1 = GetSamplePicture();
+  auto picture2 = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (auto& picture : {picture1, picture2}) {
+    ASSERT_FALSE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  }
+  cache.SweepAfterFrame();
+  for (auto& picture : {picture2, picture1}) {
+    ASSERT_TRUE(
+        cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+    ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  }
+
+  const size_t picture_bytes = 150 * 100 * 4;
+  cache.Trim(picture_bytes);
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), picture_bytes);
+  ASSERT_TRUE(cache.Draw(*picture1, dummy_canvas));
+  ASSERT_FALSE(cache.Draw(*picture2, dummy_canvas));
+  // Trimming does not set a budget.
+  ASSERT_EQ(cache.GetMaxBytes(), 0u);
+}
+
+TEST(RasterCache, AsyncRasterizationDrawsPictureUntilReady) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // A single worker runs tasks in order, which lets the test wait for the
+  // rasterization to finish.
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  cache.SetAsyncRasterizationTaskRunner(task_runner);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  cache.SweepAfterFrame();
+
+  // The rasterization is started but the result is not available yet.
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 150u * 100u * 4u);
+}
+
+TEST(RasterCache, DeferredDisplayListsFallBackToImagesWithoutContext) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  cache.SetAsyncRasterizationTaskRunner(task_runner);
+  cache.SetRecordDeferredDisplayLists(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  cache.SweepAfterFrame();
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  cache.SweepAfterFrame();
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 150u * 100u * 4u);
+}
+
+TEST(RasterCache, PersistentKeyDependsOnContentAndMatrix) {
+  auto picture1 = GetSamplePicture();
+  auto picture2 = GetSamplePicture();
+  ASSERT_NE(picture1->uniqueID(), picture2->uniqueID());
+
+  auto key1 = RasterCache::GetPersistentKey(picture1.get(), SkMatrix::I());
+  auto key2 = RasterCache::GetPersistentKey(picture2.get(), SkMatrix::I());
+  auto scaled_key =
+      RasterCache::GetPersistentKey(picture1.get(), SkMatrix::Scale(2, 2));
+  ASSERT_TRUE(key1);
+  ASSERT_TRUE(key2);
+  ASSERT_TRUE(scaled_key);
+  ASSERT_TRUE(key1->equals(key2.get()));
+  ASSERT_FALSE(key1->equals(scaled_key.get()));
+}
+
+TEST(RasterCache, FrequentlyUsedEntriesArePersistedOnce) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  std::vector<sk_sp<SkData>> persisted_keys;
+  bool in_frame = false;
+  cache.SetPersistCallback(
+      [&persisted_keys, &in_frame](sk_sp<SkData> key, sk_sp<SkImage> image) {
+        // Images are only read back once the frame is done.
+        ASSERT_FALSE(in_frame);
+        ASSERT_TRUE(image);
+        ASSERT_FALSE(image->isTextureBacked());
+        persisted_keys.push_back(std::move(key));
+      });
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (size_t i = 0; i < RasterCache::kPersistAccessThreshold + 2; i++) {
+    in_frame = true;
+    cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false);
+    cache.Draw(*picture, dummy_canvas);
+    in_frame = false;
+    cache.SweepAfterFrame();
+  }
+
+  ASSERT_EQ(persisted_keys.size(), 1u);
+  auto key = RasterCache::GetPersistentKey(picture.get(), matrix);
+  ASSERT_TRUE(persisted_keys[0]->equals(key.get()));
+}
+
+TEST(RasterCache, PersistedImagesSkipAccessThreshold) {
+  size_t threshold = 3;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+  auto image = SkImage::MakeRasterData(
+      SkImageInfo::MakeN32Premul(150, 100),
+      SkData::MakeUninitialized(150 * 100 * 4), 150 * 4);
+  cache.AddPersistedImage(RasterCache::GetPersistentKey(picture.get(), matrix),
+                          image);
+  ASSERT_EQ(cache.GetPersistedImagesCount(), 1u);
+
+  SkCanvas dummy_canvas;
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  // The picture is matched against the persisted images after the frame.
+  ASSERT_FALSE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_FALSE(cache.Draw(*picture, dummy_canvas));
+  ASSERT_EQ(cache.GetPersistedImagesCount(), 1u);
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPersistedImagesCount(), 0u);
+
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+}
+
+TEST(RasterCache, UnmatchedPersistedImagesExpire) {
+  flutter::RasterCache cache;
+
+  auto image = SkImage::MakeRasterData(
+      SkImageInfo::MakeN32Premul(150, 100),
+      SkData::MakeUninitialized(150 * 100 * 4), 150 * 4);
+  cache.AddPersistedImage(SkData::MakeWithCString("stale"), image);
+  ASSERT_EQ(cache.GetPersistedImagesCount(), 1u);
+
+  SkMatrix matrix = SkMatrix::I();
+  auto picture = GetSamplePicture();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (size_t i = 0; i + 1 < RasterCache::kPersistedImageLifetime; i++) {
+    cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false);
+    cache.Draw(*picture, dummy_canvas);
+    cache.SweepAfterFrame();
+  }
+  ASSERT_EQ(cache.GetPersistedImagesCount(), 1u);
+
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPersistedImagesCount(), 0u);
+}
+
+TEST(RasterCache, BackdropsAreDrawnInDeviceSpaceUntilUnused) {
+  flutter::RasterCache cache;
+  auto image = SkImage::MakeRasterData(SkImageInfo::MakeN32Premul(20, 10),
+                                       SkData::MakeUninitialized(20 * 10 * 4),
+                                       20 * 4);
+  SkCanvas dummy_canvas;
+  dummy_canvas.scale(2, 2);
+
+  ASSERT_FALSE(cache.HasBackdrop(1));
+  ASSERT_FALSE(cache.DrawBackdrop(1, dummy_canvas));
+  cache.CacheBackdrop(1, SkIRect::MakeXYWH(5, 5, 20, 10), image);
+  ASSERT_TRUE(cache.HasBackdrop(1));
+  ASSERT_FALSE(cache.HasBackdrop(2));
+  ASSERT_EQ(cache.GetLayerCachedEntriesCount(), 1u);
+
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.DrawBackdrop(1, dummy_canvas));
+  ASSERT_EQ(cache.GetHitsThisFrame(), 1u);
+  ASSERT_EQ(dummy_canvas.getTotalMatrix(), SkMatrix::Scale(2, 2));
+
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();  // Extra frame without a draw.
+  ASSERT_FALSE(cache.HasBackdrop(1));
+}
+
+TEST(RasterCache, ShadowsAreCachedAfterThreshold) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+  SkRect logical_rect = SkRect::MakeWH(20, 10);
+  size_t draw_count = 0;
+  auto draw_shadow = [&draw_count](SkCanvas* canvas) { draw_count++; };
+  SkCanvas dummy_canvas;
+  dummy_canvas.setMatrix(matrix);
+
+  ASSERT_FALSE(cache.PrepareShadow(nullptr, 1, logical_rect, matrix, nullptr,
+                                   draw_shadow));
+  ASSERT_FALSE(cache.DrawShadow(1, dummy_canvas));
+  cache.SweepAfterFrame();
+  ASSERT_FALSE(cache.PrepareShadow(nullptr, 1, logical_rect, matrix, nullptr,
+                                   draw_shadow));
+  ASSERT_FALSE(cache.DrawShadow(1, dummy_canvas));
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.PrepareShadow(nullptr, 1, logical_rect, matrix, nullptr,
+                                  draw_shadow));
+  ASSERT_EQ(draw_count, 1u);
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 1u);
+  ASSERT_GT(cache.EstimateShadowCacheByteSize(), 0u);
+
+  // The translation of the canvas does not matter, so shapes at different
+  // positions share the entry.
+  dummy_canvas.translate(30, 40);
+  ASSERT_TRUE(cache.DrawShadow(1, dummy_canvas));
+  ASSERT_FALSE(cache.DrawShadow(2, dummy_canvas));
+  dummy_canvas.scale(2, 2);
+  ASSERT_FALSE(cache.DrawShadow(1, dummy_canvas));
+  ASSERT_EQ(cache.GetHitsThisFrame(), 1u);
+
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();  // Extra frame without a draw.
+  ASSERT_EQ(cache.GetShadowCachedEntriesCount(), 0u);
+}
+
 // Construct a cache result whose device target rectangle rounds out to be one
 // pixel wider than the cached image.  Verify that it can be drawn without
 // triggering any assertions.
@@ -164,5 +566,155 @@ TEST(RasterCache, DeviceRectRoundOut) {
   ASSERT_TRUE(cache.Draw(*picture, canvas));
 }
 
+TEST(RasterCache, OpaqueSoftwareEntriesAreBlittedLikeDrawnImages) {
+  flutter::RasterCache cache;
+
+  SkPictureRecorder recorder;
+  SkCanvas* recording_canvas =
+      recorder.beginRecording(SkRect::MakeWH(40, 30));
+  recording_canvas->drawColor(SK_ColorBLUE);
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  recording_canvas->drawCircle(20, 15, 10, paint);
+  sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+  SkMatrix ctm = SkMatrix::Translate(7, 5);
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  auto result =
+      cache.RasterizePicture(picture.get(), nullptr, ctm, srgb.get(), false);
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(result->image()->isOpaque());
+
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 48, srgb);
+  auto blitted = SkSurface::MakeRaster(info);
+  auto drawn = SkSurface::MakeRaster(info);
+  for (auto& surface : {blitted, drawn}) {
+    surface->getCanvas()->clear(SK_ColorGREEN);
+    surface->getCanvas()->clipRect(SkRect::MakeLTRB(10, 0, 64, 20));
+    surface->getCanvas()->setMatrix(ctm);
+  }
+  auto snapshot = blitted->makeImageSnapshot();
+  result->draw(*blitted->getCanvas(), nullptr);
+  drawn->getCanvas()->resetMatrix();
+  drawn->getCanvas()->drawImage(result->image(), 7, 5);
+
+  SkBitmap blitted_bitmap;
+  SkBitmap drawn_bitmap;
+  ASSERT_TRUE(blitted_bitmap.tryAllocPixels(info));
+  ASSERT_TRUE(drawn_bitmap.tryAllocPixels(info));
+  ASSERT_TRUE(blitted->readPixels(blitted_bitmap, 0, 0));
+  ASSERT_TRUE(drawn->readPixels(drawn_bitmap, 0, 0));
+  ASSERT_EQ(memcmp(blitted_bitmap.getPixels(), drawn_bitmap.getPixels(),
+                   info.computeMinByteSize()),
+            0);
+
+  // Images snapshotted before the blit keep their pixels.
+  SkBitmap snapshot_bitmap;
+  ASSERT_TRUE(snapshot_bitmap.tryAllocPixels(info));
+  ASSERT_TRUE(snapshot->readPixels(snapshot_bitmap.pixmap(), 0, 0));
+  ASSERT_EQ(snapshot_bitmap.getColor(20, 10), SK_ColorGREEN);
+}
+
+TEST(RasterCache, CompactOpaqueEntriesUseHalfTheMemory) {
+  flutter::RasterCache cache;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(40, 30))->drawColor(SK_ColorBLUE);
+  sk_sp<SkPicture> opaque_picture = recorder.finishRecordingAsPicture();
+  sk_sp<SkPicture> translucent_picture = GetSamplePicture();
+
+  auto opaque = cache.RasterizePicture(opaque_picture.get(), nullptr,
+                                       SkMatrix::I(), srgb.get(), false);
+  ASSERT_TRUE(opaque);
+  ASSERT_EQ(opaque->image()->colorType(), kN32_SkColorType);
+
+  cache.SetCompactOpaqueEntries(true);
+  auto compact = cache.RasterizePicture(opaque_picture.get(), nullptr,
+                                        SkMatrix::I(), srgb.get(), false);
+  ASSERT_TRUE(compact);
+  ASSERT_EQ(compact->image()->colorType(), kRGB_565_SkColorType);
+  ASSERT_EQ(compact->image_bytes() * 2, opaque->image_bytes());
+
+  auto translucent = cache.RasterizePicture(
+      translucent_picture.get(), nullptr, SkMatrix::I(), srgb.get(), false);
+  ASSERT_TRUE(translucent);
+  ASSERT_EQ(translucent->image()->colorType(), kN32_SkColorType);
+}
+
+TEST(RasterCache, DecisionsAreRecordedPerFrame) {
+  using Outcome = RasterCacheDecision::Outcome;
+  flutter::RasterCache cache(1, 1);
+  cache.SetRecordDecisions(true);
+
+  SkMatrix matrix = SkMatrix::Translate(5, 5);
+  auto picture = GetSamplePicture();
+  auto other_picture = GetSamplePicture();
+  SkCanvas dummy_canvas;
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  // First frame: the pictures have not been drawn yet, and the simple one is
+  // not worth rasterizing.
+  cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false);
+  cache.Prepare(NULL, other_picture.get(), matrix, srgb.get(), false, false);
+  dummy_canvas.setMatrix(matrix);
+  cache.Draw(*picture, dummy_canvas);
+  cache.SweepAfterFrame();
+  auto decisions = cache.GetLastFrameDecisions();
+  ASSERT_EQ(decisions.size(), 2u);
+  EXPECT_EQ(decisions[0].kind, RasterCacheDecision::Kind::kPicture);
+  EXPECT_EQ(decisions[0].id, picture->uniqueID());
+  EXPECT_EQ(decisions[0].outcome, Outcome::kBelowAccessThreshold);
+  EXPECT_EQ(decisions[0].device_rect, SkIRect::MakeXYWH(5, 5, 150, 100));
+  EXPECT_EQ(decisions[1].outcome, Outcome::kNotWorthRasterizing);
+
+  // Second frame: the picture is rasterized, which uses up the frame limit.
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  cache.Prepare(NULL, other_picture.get(), matrix, srgb.get(), true, false);
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+  decisions = cache.GetLastFrameDecisions();
+  ASSERT_EQ(decisions.size(), 2u);
+  EXPECT_EQ(decisions[0].outcome, Outcome::kRasterized);
+  EXPECT_GT(decisions[0].bytes, 0u);
+  EXPECT_EQ(decisions[1].outcome, Outcome::kFrameLimitReached);
+
+  // Third frame: the image is reused.
+  ASSERT_TRUE(
+      cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true, false));
+  ASSERT_TRUE(cache.Draw(*picture, dummy_canvas));
+  cache.SweepAfterFrame();
+  decisions = cache.GetLastFrameDecisions();
+  ASSERT_EQ(decisions.size(), 1u);
+  EXPECT_EQ(decisions[0].outcome, Outcome::kCached);
+  EXPECT_EQ(decisions[0].rasterize_time, fml::TimeDelta::Zero());
+
+  cache.SetRecordDecisions(false);
+  ASSERT_TRUE(cache.GetLastFrameDecisions().empty());
+}
+
+TEST(RasterCache, DecisionHeatmapColorsCandidates) {
+  flutter::RasterCache cache(1);
+  cache.SetShowDecisionHeatmap(true);
+  ASSERT_TRUE(cache.IsRecordingDecisions());
+
+  auto picture = GetSamplePicture();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  cache.Prepare(NULL, picture.get(), SkMatrix::I(), srgb.get(), true, false);
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(200, 200);
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorBLACK);
+  cache.DrawDecisionHeatmap(canvas);
+  // The picture waits for the access threshold, so it is yellow.
+  const SkColor inside = bitmap.getColor(50, 50);
+  EXPECT_GT(SkColorGetR(inside), 0u);
+  EXPECT_GT(SkColorGetG(inside), 0u);
+  EXPECT_EQ(SkColorGetB(inside), 0u);
+  EXPECT_EQ(bitmap.getColor(175, 175), SK_ColorBLACK);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,85 +4,200 @@
 
 #include "rtree.h"
 
-#include <list>
+#include <algorithm>
+#include <cmath>
 
 #include "flutter/fml/logging.h"
-#include "third_party/skia/include/core/SkBBHFactory.h"
 
 namespace flutter {
 
-RTree::RTree() : bbh_{SkRTreeFactory{}()}, all_ops_count_(0) {}
+namespace {
+
+// Same as |SkRect::Intersects|, but evaluates all the comparisons without
+// branching, which lets the compiler vectorize the test.
+inline bool Intersects(const SkRect& a, const SkRect& b) {
+  return (a.fLeft < b.fRight) & (b.fLeft < a.fRight) & (a.fTop < b.fBottom) &
+         (b.fTop < a.fBottom);
+}
+
+}  // namespace
+
+RTree::RTree() : leaf_count_(0), all_ops_count_(0) {}
+
+template <typename T>
+void RTree::PackLevel(std::vector<T>& items,
+                      int first_item,
+                      std::vector<Node>& parents) {
+  const int count = static_cast<int>(items.size());
+  const int parent_count = (count + kMaxChildren - 1) / kMaxChildren;
+  const int slice_count = static_cast<int>(std::ceil(std::sqrt(parent_count)));
+  const int slice_size = slice_count * kMaxChildren;
+
+  // Sort the items into vertical slices, and each slice from top to bottom.
+  std::sort(items.begin(), items.end(), [](const T& a, const T& b) {
+    return a.bounds.centerX() < b.bounds.centerX();
+  });
+  for (int slice = 0; slice < count; slice += slice_size) {
+    std::sort(items.begin() + slice,
+              items.begin() + std::min(slice + slice_size, count),
+              [](const T& a, const T& b) {
+                return a.bounds.centerY() < b.bounds.centerY();
+              });
+  }
+
+  parents.clear();
+  parents.reserve(parent_count + slice_count);
+  for (int slice = 0; slice < count; slice += slice_size) {
+    const int slice_end = std::min(slice + slice_size, count);
+    for (int first = slice; first < slice_end; first += kMaxChildren) {
+      const int last = std::min(first + kMaxChildren, slice_end);
+      Node parent = {items[first].bounds, first_item + first, last - first};
+      for (int i = first + 1; i < last; i++) {
+        parent.bounds.join(items[i].bounds);
+      }
+      parents.push_back(parent);
+    }
+  }
+}
 
 void RTree::insert(const SkRect boundsArray[],
                    const SkBBoxHierarchy::Metadata metadata[],
                    int N) {
   FML_DCHECK(0 == all_ops_count_);
-  bbh_->insert(boundsArray, metadata, N);
+  entries_.reserve(N);
   for (int i = 0; i < N; i++) {
-    if (metadata != nullptr && metadata[i].isDraw) {
-      draw_op_[i] = boundsArray[i];
+    // Empty rects never intersect with a query, so they are left out.
+    if (boundsArray[i].isEmpty()) {
+      continue;
     }
+    entries_.push_back(
+        {boundsArray[i], i, metadata != nullptr && metadata[i].isDraw});
   }
   all_ops_count_ = N;
+  if (entries_.empty()) {
+    return;
+  }
+
+  // Build the tree bottom up. Packing a level reorders its nodes, so they
+  // are only copied into |nodes_| once their parents are known.
+  std::vector<Node> level;
+  PackLevel(entries_, 0, level);
+  leaf_count_ = level.size();
+  nodes_ = level;
+  while (level.size() > 1) {
+    const int first = nodes_.size() - level.size();
+    std::vector<Node> parents;
+    PackLevel(level, first, parents);
+    std::copy(level.begin(), level.end(), nodes_.begin() + first);
+    nodes_.insert(nodes_.end(), parents.begin(), parents.end());
+    level.swap(parents);
+  }
+  entries_.shrink_to_fit();
+  nodes_.shrink_to_fit();
 }
 
 void RTree::insert(const SkRect boundsArray[], int N) {
   insert(boundsArray, nullptr, N);
 }
 
+template <typename Visitor>
+void RTree::Visit(int node, const SkRect& query, Visitor& visitor) const {
+  const Node& current = nodes_[node];
+  const int end = current.first + current.count;
+  if (node < leaf_count_) {
+    for (int i = current.first; i < end; i++) {
+      if (Intersects(entries_[i].bounds, query)) {
+        visitor(entries_[i]);
+      }
+    }
+    return;
+  }
+  for (int i = current.first; i < end; i++) {
+    if (Intersects(nodes_[i].bounds, query)) {
+      Visit(i, query, visitor);
+    }
+  }
+}
+
 void RTree::search(const SkRect& query, std::vector<int>* results) const {
-  bbh_->search(query, results);
+  if (nodes_.empty() || !Intersects(nodes_.back().bounds, query)) {
+    return;
+  }
+  const size_t first_result = results->size();
+  auto visitor = [results](const Entry& entry) {
+    results->push_back(entry.index);
+  };
+  Visit(nodes_.size() - 1, query, visitor);
+  // Pictures play back the operations in the order of the results.
+  std::sort(results->begin() + first_result, results->end());
 }
 
-std::list<SkRect> RTree::searchNonOverlappingDrawnRects(
-    const SkRect& query) const {
-  // Get the indexes for the operations that intersect with the query rect.
-  std::vector<int> intermediary_results;
-  search(query, &intermediary_results);
+void RTree::searchNonOverlappingDrawnRects(
+    const SkRect& query,
+    std::vector<SkRect>* results) const {
+  results->clear();
+  if (nodes_.empty() || !Intersects(nodes_.back().bounds, query)) {
+    return;
+  }
 
-  std::list<SkRect> final_results;
-  for (int index : intermediary_results) {
-    auto draw_op = draw_op_.find(index);
+  // Get the operations that draw and intersect with the query rect, in the
+  // order they were recorded.
+  std::vector<const Entry*> draw_ops;
+  auto visitor = [&draw_ops](const Entry& entry) {
     // Ignore records that don't draw anything.
-    if (draw_op == draw_op_.end()) {
-      continue;
+    if (entry.is_draw) {
+      draw_ops.push_back(&entry);
     }
-    auto current_record_rect = draw_op->second;
-    auto replaced_existing_rect = false;
-    // // If the current record rect intersects with any of the rects in the
-    // // result list, then join them, and update the rect in final_results.
-    std::list<SkRect>::iterator curr_rect_itr = final_results.begin();
-    std::list<SkRect>::iterator first_intersecting_rect_itr;
-    while (!replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, current_record_rect)) {
-        replaced_existing_rect = true;
-        first_intersecting_rect_itr = curr_rect_itr;
-        curr_rect_itr->join(current_record_rect);
-      }
-      curr_rect_itr++;
+  };
+  Visit(nodes_.size() - 1, query, visitor);
+  std::sort(draw_ops.begin(), draw_ops.end(),
+            [](const Entry* a, const Entry* b) { return a->index < b->index; });
+
+  for (const Entry* draw_op : draw_ops) {
+    const SkRect& current_record_rect = draw_op->bounds;
+    // If the current record rect intersects with any of the rects in the
+    // results, then join them, and update the first rect it intersects with.
+    auto first_intersecting_rect =
+        std::find_if(results->begin(), results->end(),
+                     [&current_record_rect](const SkRect& rect) {
+                       return Intersects(rect, current_record_rect);
+                     });
+    if (first_intersecting_rect == results->end()) {
+      results->push_back(current_record_rect);
+      continue;
     }
-    // It's possible that the result contains duplicated rects at this point.
-    // For example, consider a result list that contains rects A, B. If a
-    // new rect C is a superset of A and B, then A and B are the same set after
-    // the merge. As a result, find such cases and remove them from the result
-    // list.
-    while (replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, *first_intersecting_rect_itr)) {
-        first_intersecting_rect_itr->join(*curr_rect_itr);
-        curr_rect_itr = final_results.erase(curr_rect_itr);
-      } else {
-        curr_rect_itr++;
+    first_intersecting_rect->join(current_record_rect);
+    // It's possible that the results contain rects that intersect with each
+    // other at this point. For example, consider results that contain rects
+    // A, B. If a new rect C is a superset of A and B, then A and B are the
+    // same set after the merge. As a result, join such rects into the first
+    // intersecting rect, and remove them from the results until none of them
+    // intersect.
+    size_t joined_index = first_intersecting_rect - results->begin();
+    bool did_join = true;
+    while (did_join) {
+      did_join = false;
+      size_t kept = 0;
+      for (size_t i = 0; i < results->size(); i++) {
+        SkRect& joined_rect = (*results)[joined_index];
+        if (i != joined_index && Intersects((*results)[i], joined_rect)) {
+          joined_rect.join((*results)[i]);
+          did_join = true;
+          continue;
+        }
+        if (i == joined_index) {
+          joined_index = kept;
+        }
+        (*results)[kept++] = (*results)[i];
       }
-    }
-    if (!replaced_existing_rect) {
-      final_results.push_back(current_record_rect);
+      results->resize(kept);
     }
   }
-  return final_results;
 }
 
 size_t RTree::bytesUsed() const {
-  return bbh_->bytesUsed();
+  return entries_.capacity() * sizeof(Entry) +
+         nodes_.capacity() * sizeof(Node);
 }
 
 RTreeFactory::RTreeFactory() {
@@ -5,15 +5,18 @@
 #ifndef FLUTTER_FLOW_RTREE_H_
 #define FLUTTER_FLOW_RTREE_H_
 
-#include <list>
-#include <map>
+#include <vector>
 
 #include "third_party/skia/include/core/SkBBHFactory.h"
 #include "third_party/skia/include/core/SkTypes.h"
 
 namespace flutter {
 /**
- * An R-Tree implementation that forwards calls to an SkRTree.
+ * A static R-Tree that is bulk loaded with the Sort-Tile-Recursive algorithm.
+ *
+ * The tree is built once by the insert call, and its nodes are stored level
+ * by level in a flat array, so that searches walk contiguous memory instead
+ * of chasing pointers.
  *
  * This implementation provides a searchNonOverlappingDrawnRects method,
  * which can be used to query the rects for the operations recorded in the tree.
@@ -35,16 +38,51 @@ class RTree : public SkBBoxHierarchy {
   // When two rects intersect with each other, they are joined into a single
   // rect which also intersects with the query rect. In other words, the bounds
   // of each rect in the result list are mutually exclusive.
-  std::list<SkRect> searchNonOverlappingDrawnRects(const SkRect& query) const;
+  //
+  // The results are written into |results|, which is cleared first, so that
+  // callers can reuse its storage between queries.
+  void searchNonOverlappingDrawnRects(const SkRect& query,
+                                      std::vector<SkRect>* results) const;
 
   // Insertion count (not overall node count, which may be greater).
   int getCount() const { return all_ops_count_; }
 
  private:
-  // A map containing the draw operation rects keyed off the operation index
-  // in the insert call.
-  std::map<int, SkRect> draw_op_;
-  sk_sp<SkBBoxHierarchy> bbh_;
+  // The maximum number of children of a node.
+  static constexpr int kMaxChildren = 16;
+
+  // A rect inserted in the tree, and its index in the insert call.
+  struct Entry {
+    SkRect bounds;
+    int index;
+    bool is_draw;
+  };
+
+  // A node covers |count| consecutive entries starting at |first| if it is a
+  // leaf, or |count| consecutive nodes otherwise.
+  struct Node {
+    SkRect bounds;
+    int first;
+    int count;
+  };
+
+  // Sorts |items| into tiles of |kMaxChildren| items that are close to each
+  // other, and appends a parent node for each tile to |parents|.
+  template <typename T>
+  static void PackLevel(std::vector<T>& items,
+                        int first_item,
+                        std::vector<Node>& parents);
+
+  // Calls |visitor| with each entry under |node| that intersects with
+  // |query|, in no particular order.
+  template <typename Visitor>
+  void Visit(int node, const SkRect& query, Visitor& visitor) const;
+
+  // The entries, in the order of the leaves that cover them.
+  std::vector<Entry> entries_;
+  // The leaves come first, and the root last.
+  std::vector<Node> nodes_;
+  int leaf_count_;
   int all_ops_count_;
 };
 
@@ -26,8 +26,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsNoIntersection) {
   recording_canvas->drawRect(SkRect::MakeLTRB(20, 20, 40, 40), rect_paint);
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(40, 40, 80, 80));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(40, 40, 80, 80), &hits);
   ASSERT_TRUE(hits.empty());
 }
 
@@ -47,8 +48,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsSingleRectIntersection) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(140, 140, 150, 150));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(140, 140, 150, 150), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(120, 120, 160, 160));
 }
@@ -75,8 +77,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsIgnoresNonDrawingRecords) {
   // The rtree has a translate, a clip and a rect record.
   ASSERT_EQ(3, rtree_factory.getInstance()->getCount());
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(0, 0, 1000, 1000));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1000), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(120, 120, 180, 180));
 }
@@ -105,8 +108,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsMultipleRectIntersection) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(0, 0, 1000, 1050));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1050), &hits);
   ASSERT_EQ(2UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(100, 100, 200, 200));
   ASSERT_EQ(*std::next(hits.begin(), 1), SkRect::MakeLTRB(300, 100, 400, 200));
@@ -140,8 +144,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase1) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeXYWH(120, 120, 126, 126));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeXYWH(120, 120, 126, 126), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(100, 100, 175, 175));
 }
@@ -181,8 +186,9 @@ TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase2) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(30, 30, 550, 270));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(30, 30, 550, 270), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(50, 50, 500, 250));
 }
@@ -225,11 +231,111 @@ TEST(RTree, searchNonOverlappingDrawnRectsJoinRectsWhenIntersectedCase3) {
 
   recorder->finishRecordingAsPicture();
 
-  auto hits = rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
-      SkRect::MakeLTRB(30, 30, 550, 270));
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(30, 30, 550, 270), &hits);
   ASSERT_EQ(1UL, hits.size());
   ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(50, 50, 620, 300));
 }
 
+TEST(RTree, searchNonOverlappingDrawnRectsJoinsRectsUntilTheyDontIntersect) {
+  auto rtree_factory = RTreeFactory();
+  auto recorder = std::make_unique<SkPictureRecorder>();
+  auto recording_canvas =
+      recorder->beginRecording(SkRect::MakeIWH(1000, 1000), &rtree_factory);
+
+  auto rect_paint = SkPaint();
+  rect_paint.setColor(SkColors::kCyan);
+  rect_paint.setStyle(SkPaint::Style::kFill_Style);
+
+  // Given the A, B and C rects, where C intersects with B, and the union of
+  // B and C intersects with A, the result list contains the union of A, B
+  // and C.
+  //
+  //  +-----+
+  //  |  A  |  +-----+
+  //  +-----+  |  B  |
+  //           |  +-----+
+  //   +-------|--|  C  |
+  //   |       +--|     |
+  //   +----------+-----+
+
+  // A
+  recording_canvas->drawRect(SkRect::MakeLTRB(100, 100, 200, 200), rect_paint);
+  // B
+  recording_canvas->drawRect(SkRect::MakeLTRB(300, 150, 400, 300), rect_paint);
+  // C
+  recording_canvas->drawRect(SkRect::MakeLTRB(150, 250, 450, 350), rect_paint);
+
+  recorder->finishRecordingAsPicture();
+
+  std::vector<SkRect> hits;
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 1000, 1000), &hits);
+  ASSERT_EQ(1UL, hits.size());
+  ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(100, 100, 450, 350));
+}
+
+TEST(RTree, searchNonOverlappingDrawnRectsClearsTheResults) {
+  auto rtree_factory = RTreeFactory();
+  auto recorder = std::make_unique<SkPictureRecorder>();
+  auto recording_canvas =
+      recorder->beginRecording(SkRect::MakeIWH(1000, 1000), &rtree_factory);
+
+  auto rect_paint = SkPaint();
+  rect_paint.setColor(SkColors::kCyan);
+  rect_paint.setStyle(SkPaint::Style::kFill_Style);
+
+  recording_canvas->drawRect(SkRect::MakeLTRB(20, 20, 40, 40), rect_paint);
+  recorder->finishRecordingAsPicture();
+
+  std::vector<SkRect> hits = {SkRect::MakeLTRB(0, 0, 10, 10)};
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(0, 0, 30, 30), &hits);
+  ASSERT_EQ(1UL, hits.size());
+  ASSERT_EQ(*hits.begin(), SkRect::MakeLTRB(20, 20, 40, 40));
+
+  rtree_factory.getInstance()->searchNonOverlappingDrawnRects(
+      SkRect::MakeLTRB(40, 40, 80, 80), &hits);
+  ASSERT_TRUE(hits.empty());
+}
+
+TEST(RTree, searchReturnsTheIntersectingOperationsInOrder) {
+  auto rtree_factory = RTreeFactory();
+  auto recorder = std::make_unique<SkPictureRecorder>();
+  auto recording_canvas =
+      recorder->beginRecording(SkRect::MakeIWH(1000, 1000), &rtree_factory);
+
+  auto rect_paint = SkPaint();
+  rect_paint.setColor(SkColors::kCyan);
+  rect_paint.setStyle(SkPaint::Style::kFill_Style);
+
+  // Record enough rects for the tree to have several levels, in an order
+  // that doesn't match their position.
+  const int count = 1000;
+  for (int i = 0; i < count; i++) {
+    const int x = (i * 37) % 100;
+    const int y = i / 100;
+    recording_canvas->drawRect(SkRect::MakeXYWH(x * 10, y * 100, 15, 15),
+                               rect_paint);
+  }
+  recorder->finishRecordingAsPicture();
+
+  const SkRect query = SkRect::MakeLTRB(200, 200, 600, 600);
+  std::vector<int> expected;
+  for (int i = 0; i < count; i++) {
+    const int x = (i * 37) % 100;
+    const int y = i / 100;
+    if (SkRect::Intersects(SkRect::MakeXYWH(x * 10, y * 100, 15, 15), query)) {
+      expected.push_back(i);
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  std::vector<int> results;
+  rtree_factory.getInstance()->search(query, &results);
+  ASSERT_EQ(results, expected);
+}
+
 }  // namespace testing
 }  // namespace flutter
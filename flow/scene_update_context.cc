@@ -99,6 +99,16 @@ void SceneUpdateContext::EnableWireframe(bool enable) {
 
 void SceneUpdateContext::Reset() {
   paint_tasks_.clear();
+
+  for (auto it = retained_entities_.begin(); it != retained_entities_.end();) {
+    if (it->second->used) {
+      it->second->used = false;
+      ++it;
+    } else {
+      it = retained_entities_.erase(it);
+    }
+  }
+
   top_entity_ = nullptr;
   top_scale_x_ = 1.f;
   top_scale_y_ = 1.f;
@@ -106,11 +116,37 @@ void SceneUpdateContext::Reset() {
   next_elevation_ = 0.f;
   alpha_ = 1.f;
 
-  // We are going to be sending down a fresh node hierarchy every frame. So just
-  // enqueue a detach op on the imported root node.
+  // The node hierarchy is put together again every frame, from retained and
+  // new nodes. So just enqueue a detach op on the imported root node.
   session_.get()->Enqueue(scenic::NewDetachChildrenCmd(root_node_.id()));
 }
 
+std::shared_ptr<SceneUpdateContext::RetainedEntity>
+SceneUpdateContext::AcquireEntityNodes(const Layer* layer, EntityKind kind) {
+  if (layer == nullptr) {
+    return std::make_shared<RetainedEntity>(session_.get());
+  }
+
+  auto& nodes = retained_entities_[{layer->unique_id(), kind}];
+  if (!nodes) {
+    nodes = std::make_shared<RetainedEntity>(session_.get());
+  } else if (nodes->used) {
+    // The layer is in the tree more than once. Only its first entity reuses
+    // the nodes.
+    return std::make_shared<RetainedEntity>(session_.get());
+  } else {
+    // The children are added again as the rest of the tree is walked.
+    session_.get()->Enqueue(
+        scenic::NewDetachChildrenCmd(nodes->entity_node.id()));
+    if (nodes->opacity_node) {
+      session_.get()->Enqueue(
+          scenic::NewDetachChildrenCmd(nodes->opacity_node->id()));
+    }
+  }
+  nodes->used = true;
+  return nodes;
+}
+
 void SceneUpdateContext::CreateFrame(scenic::EntityNode& entity_node,
                                      const SkRRect& rrect,
                                      SkColor color,
@@ -121,9 +157,7 @@ void SceneUpdateContext::CreateFrame(scenic::EntityNode& entity_node,
   if (rrect.isEmpty())
     return;
 
-  // Frames always clip their children.
   SkRect shape_bounds = rrect.getBounds();
-  SetEntityNodeClipPlanes(entity_node, shape_bounds);
 
   // TODO(SCN-137): Need to be able to express the radii as vectors.
   scenic::ShapeNode shape_node(session_.get());
@@ -218,55 +252,119 @@ void SceneUpdateContext::DestroyView(int64_t view_id) {
 }
 
 SceneUpdateContext::Entity::Entity(std::shared_ptr<SceneUpdateContext> context)
+    : Entity(context, nullptr, EntityKind::kTransform) {}
+
+SceneUpdateContext::Entity::Entity(std::shared_ptr<SceneUpdateContext> context,
+                                   const Layer* layer,
+                                   EntityKind kind)
     : context_(context),
       previous_entity_(context->top_entity_),
-      entity_node_(context->session_.get()) {
+      nodes_(context->AcquireEntityNodes(layer, kind)) {
   context->top_entity_ = this;
 }
 
 SceneUpdateContext::Entity::~Entity() {
   if (previous_entity_) {
-    previous_entity_->embedder_node().AddChild(entity_node_);
+    previous_entity_->embedder_node().AddChild(entity_node());
   } else {
-    context_->root_node_.AddChild(entity_node_);
+    context_->root_node_.AddChild(entity_node());
   }
 
   FML_DCHECK(context_->top_entity_ == this);
   context_->top_entity_ = previous_entity_;
 }
 
+scenic::EntityNode& SceneUpdateContext::Entity::entity_node() {
+  return nodes_->entity_node;
+}
+
+void SceneUpdateContext::Entity::SetTranslation(float x, float y, float z) {
+  const std::array<float, 3> translation = {x, y, z};
+  if (nodes_->translation != translation) {
+    nodes_->translation = translation;
+    entity_node().SetTranslation(x, y, z);
+  }
+}
+
+void SceneUpdateContext::Entity::SetScale(float x, float y, float z) {
+  const std::array<float, 3> scale = {x, y, z};
+  if (nodes_->scale != scale) {
+    nodes_->scale = scale;
+    entity_node().SetScale(x, y, z);
+  }
+}
+
+void SceneUpdateContext::Entity::SetRotation(float x,
+                                             float y,
+                                             float z,
+                                             float w) {
+  const std::array<float, 4> rotation = {x, y, z, w};
+  if (nodes_->rotation != rotation) {
+    nodes_->rotation = rotation;
+    entity_node().SetRotation(x, y, z, w);
+  }
+}
+
+void SceneUpdateContext::Entity::SetClipBounds(
+    const std::optional<SkRect>& bounds) {
+  if (nodes_->clip_bounds == bounds) {
+    return;
+  }
+  nodes_->clip_bounds = bounds;
+  if (bounds) {
+    SetEntityNodeClipPlanes(entity_node(), *bounds);
+  } else {
+    entity_node().SetClipPlanes({});
+  }
+}
+
+void SceneUpdateContext::Entity::SetLabel(const std::string& label) {
+  if (nodes_->label != label) {
+    nodes_->label = label;
+    entity_node().SetLabel(label);
+  }
+}
+
 SceneUpdateContext::Transform::Transform(
     std::shared_ptr<SceneUpdateContext> context,
-    const SkMatrix& transform)
-    : Entity(context),
+    const SkMatrix& transform,
+    const Layer* layer)
+    : Entity(context, layer, EntityKind::kTransform),
       previous_scale_x_(context->top_scale_x_),
       previous_scale_y_(context->top_scale_y_) {
-  entity_node().SetLabel("flutter::Transform");
-  if (!transform.isIdentity()) {
-    // TODO(SCN-192): The perspective and shear components in the matrix
-    // are not handled correctly.
-    MatrixDecomposition decomposition(transform);
-    if (decomposition.IsValid()) {
-      // Don't allow clients to control the z dimension; we control that
-      // instead to make sure layers appear in proper order.
-      entity_node().SetTranslation(decomposition.translation().x,  //
-                                   decomposition.translation().y,  //
-                                   0.f                             //
-      );
-
-      entity_node().SetScale(decomposition.scale().x,  //
-                             decomposition.scale().y,  //
-                             1.f                       //
-      );
-      context->top_scale_x_ *= decomposition.scale().x;
-      context->top_scale_y_ *= decomposition.scale().y;
-
-      entity_node().SetRotation(decomposition.rotation().x,  //
-                                decomposition.rotation().y,  //
-                                decomposition.rotation().z,  //
-                                decomposition.rotation().w   //
-      );
-    }
+  SetLabel("flutter::Transform");
+  // Retained nodes may have been transformed in the last frame, so the
+  // identity is set too. It only sends commands to such nodes.
+  if (transform.isIdentity()) {
+    SetTranslation(0.f, 0.f, 0.f);
+    SetScale(1.f, 1.f, 1.f);
+    SetRotation(0.f, 0.f, 0.f, 1.f);
+    return;
+  }
+
+  // TODO(SCN-192): The perspective and shear components in the matrix
+  // are not handled correctly.
+  MatrixDecomposition decomposition(transform);
+  if (decomposition.IsValid()) {
+    // Don't allow clients to control the z dimension; we control that
+    // instead to make sure layers appear in proper order.
+    SetTranslation(decomposition.translation().x,  //
+                   decomposition.translation().y,  //
+                   0.f                             //
+    );
+
+    SetScale(decomposition.scale().x,  //
+             decomposition.scale().y,  //
+             1.f                       //
+    );
+    context->top_scale_x_ *= decomposition.scale().x;
+    context->top_scale_y_ *= decomposition.scale().y;
+
+    SetRotation(decomposition.rotation().x,  //
+                decomposition.rotation().y,  //
+                decomposition.rotation().z,  //
+                decomposition.rotation().w   //
+    );
   }
 }
 
@@ -278,9 +376,9 @@ SceneUpdateContext::Transform::Transform(
     : Entity(context),
       previous_scale_x_(context->top_scale_x_),
       previous_scale_y_(context->top_scale_y_) {
-  entity_node().SetLabel("flutter::Transform");
+  SetLabel("flutter::Transform");
   if (scale_x != 1.f || scale_y != 1.f || scale_z != 1.f) {
-    entity_node().SetScale(scale_x, scale_y, scale_z);
+    SetScale(scale_x, scale_y, scale_z);
     context->top_scale_x_ *= scale_x;
     context->top_scale_y_ *= scale_y;
   }
@@ -295,14 +393,18 @@ SceneUpdateContext::Frame::Frame(std::shared_ptr<SceneUpdateContext> context,
                                  const SkRRect& rrect,
                                  SkColor color,
                                  SkAlpha opacity,
-                                 std::string label)
-    : Entity(context),
+                                 std::string label,
+                                 const Layer* layer)
+    : Entity(context, layer, EntityKind::kFrame),
       previous_elevation_(context->top_elevation_),
       rrect_(rrect),
       color_(color),
       opacity_(opacity),
-      opacity_node_(context->session_.get()),
       paint_bounds_(SkRect::MakeEmpty()) {
+  if (!nodes().opacity_node) {
+    nodes().opacity_node.emplace(context->session_.get());
+  }
+
   // Increment elevation trackers before calculating any local elevation.
   // |UpdateView| can modify context->next_elevation_, which is why it is
   // neccesary to track this addtional state.
@@ -310,15 +412,19 @@ SceneUpdateContext::Frame::Frame(std::shared_ptr<SceneUpdateContext> context,
   context->next_elevation_ += kScenicZElevationBetweenLayers;
 
   float local_elevation = context->next_elevation_ - previous_elevation_;
-  entity_node().SetTranslation(0.f, 0.f, -local_elevation);
-  entity_node().SetLabel(label);
-  entity_node().AddChild(opacity_node_);
+  SetTranslation(0.f, 0.f, -local_elevation);
+  SetLabel(label);
+  entity_node().AddChild(*nodes().opacity_node);
 
   // Scenic currently lacks an API to enable rendering of alpha channel; alpha
   // channels are only rendered if there is a OpacityNode higher in the tree
   // with opacity != 1. For now, clamp to a infinitesimally smaller value than
   // 1, which does not cause visual problems in practice.
-  opacity_node_.SetOpacity(std::min(kOneMinusEpsilon, opacity_ / 255.0f));
+  const float node_opacity = std::min(kOneMinusEpsilon, opacity_ / 255.0f);
+  if (nodes().opacity != node_opacity) {
+    nodes().opacity = node_opacity;
+    nodes().opacity_node->SetOpacity(node_opacity);
+  }
 
   if (context->intercept_all_input_) {
     context->input_interceptor_.emplace(context->session_.get());
@@ -332,11 +438,19 @@ SceneUpdateContext::Frame::Frame(std::shared_ptr<SceneUpdateContext> context,
 SceneUpdateContext::Frame::~Frame() {
   context()->top_elevation_ = previous_elevation_;
 
+  // Frames always clip their children, unless they are zero size.
+  SetClipBounds(rrect_.isEmpty() ? std::nullopt
+                                 : std::make_optional(rrect_.getBounds()));
+
   // Add a part which represents the frame's geometry for clipping purposes
   context()->CreateFrame(entity_node(), rrect_, color_, opacity_, paint_bounds_,
                          std::move(paint_layers_));
 }
 
+scenic::ContainerNode& SceneUpdateContext::Frame::embedder_node() {
+  return *nodes().opacity_node;
+}
+
 void SceneUpdateContext::Frame::AddPaintLayer(Layer* layer) {
   FML_DCHECK(!layer->is_empty());
   paint_layers_.push_back(layer);
@@ -344,10 +458,11 @@ void SceneUpdateContext::Frame::AddPaintLayer(Layer* layer) {
 }
 
 SceneUpdateContext::Clip::Clip(std::shared_ptr<SceneUpdateContext> context,
-                               const SkRect& shape_bounds)
-    : Entity(context) {
-  entity_node().SetLabel("flutter::Clip");
-  SetEntityNodeClipPlanes(entity_node(), shape_bounds);
+                               const SkRect& shape_bounds,
+                               const Layer* layer)
+    : Entity(context, layer, EntityKind::kClip) {
+  SetLabel("flutter::Clip");
+  SetClipBounds(shape_bounds);
 }
 
 }  // namespace flutter
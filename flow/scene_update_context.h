@@ -10,9 +10,14 @@
 #include <lib/ui/scenic/cpp/session.h>
 #include <lib/ui/scenic/cpp/view_ref_pair.h>
 
+#include <array>
 #include <cfloat>
+#include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "flutter/flow/embedded_views.h"
@@ -43,27 +48,54 @@ class SessionWrapper {
 };
 
 class SceneUpdateContext : public flutter::ExternalViewEmbedder {
+ private:
+  // Which of the entities a layer can create a retained entity is.
+  enum class EntityKind { kTransform, kFrame, kClip };
+
+  struct RetainedEntity;
+
  public:
+  // An entity node in the Scenic scene. Entities created for a layer keep
+  // their nodes across frames, as long as the layer is part of every frame's
+  // tree, and only the properties that changed are sent to Scenic.
   class Entity {
    public:
     Entity(std::shared_ptr<SceneUpdateContext> context);
     virtual ~Entity();
 
     std::shared_ptr<SceneUpdateContext> context() { return context_; }
-    scenic::EntityNode& entity_node() { return entity_node_; }
-    virtual scenic::ContainerNode& embedder_node() { return entity_node_; }
+    scenic::EntityNode& entity_node();
+    virtual scenic::ContainerNode& embedder_node() { return entity_node(); }
+
+   protected:
+    // Creates an entity that reuses the nodes it had in the last frame if
+    // |layer| is not nullptr.
+    Entity(std::shared_ptr<SceneUpdateContext> context,
+           const Layer* layer,
+           EntityKind kind);
+
+    RetainedEntity& nodes() { return *nodes_; }
+
+    // These only send a command if the property changed since it was last
+    // set on the node.
+    void SetTranslation(float x, float y, float z);
+    void SetScale(float x, float y, float z);
+    void SetRotation(float x, float y, float z, float w);
+    void SetClipBounds(const std::optional<SkRect>& bounds);
+    void SetLabel(const std::string& label);
 
    private:
     std::shared_ptr<SceneUpdateContext> context_;
     Entity* const previous_entity_;
 
-    scenic::EntityNode entity_node_;
+    std::shared_ptr<RetainedEntity> nodes_;
   };
 
   class Transform : public Entity {
    public:
     Transform(std::shared_ptr<SceneUpdateContext> context,
-              const SkMatrix& transform);
+              const SkMatrix& transform,
+              const Layer* layer = nullptr);
     Transform(std::shared_ptr<SceneUpdateContext> context,
               float scale_x,
               float scale_y,
@@ -78,16 +110,16 @@ class SceneUpdateContext : public flutter::ExternalViewEmbedder {
   class Frame : public Entity {
    public:
     // When layer is not nullptr, the frame is associated with a layer subtree
-    // rooted with that layer. The frame may then create a surface that will be
-    // retained for that layer.
+    // rooted with that layer, and its nodes are retained for that layer.
     Frame(std::shared_ptr<SceneUpdateContext> context,
           const SkRRect& rrect,
           SkColor color,
           SkAlpha opacity,
-          std::string label);
+          std::string label,
+          const Layer* layer = nullptr);
     virtual ~Frame();
 
-    scenic::ContainerNode& embedder_node() override { return opacity_node_; }
+    scenic::ContainerNode& embedder_node() override;
 
     void AddPaintLayer(Layer* layer);
 
@@ -98,7 +130,6 @@ class SceneUpdateContext : public flutter::ExternalViewEmbedder {
     SkColor const color_;
     SkAlpha const opacity_;
 
-    scenic::OpacityNodeHACK opacity_node_;
     std::vector<Layer*> paint_layers_;
     SkRect paint_bounds_;
   };
@@ -106,7 +137,8 @@ class SceneUpdateContext : public flutter::ExternalViewEmbedder {
   class Clip : public Entity {
    public:
     Clip(std::shared_ptr<SceneUpdateContext> context,
-         const SkRect& shape_bounds);
+         const SkRect& shape_bounds,
+         const Layer* layer = nullptr);
     ~Clip() = default;
   };
 
@@ -138,7 +170,8 @@ class SceneUpdateContext : public flutter::ExternalViewEmbedder {
   // Enable/disable wireframe rendering around the root view bounds.
   void EnableWireframe(bool enable);
 
-  // Reset state for a new frame.
+  // Reset state for a new frame. The nodes retained for layers that were not
+  // part of the last frame are released.
   void Reset();
 
   // |ExternalViewEmbedder|
@@ -212,6 +245,30 @@ class SceneUpdateContext : public flutter::ExternalViewEmbedder {
     scenic::ShapeNode shape_node_;
   };
 
+  // The nodes of an entity, and the properties last set on them.
+  struct RetainedEntity {
+    explicit RetainedEntity(scenic::Session* session) : entity_node(session) {}
+
+    scenic::EntityNode entity_node;
+    // Only created for frames.
+    std::optional<scenic::OpacityNodeHACK> opacity_node;
+
+    std::array<float, 3> translation = {0.f, 0.f, 0.f};
+    std::array<float, 3> scale = {1.f, 1.f, 1.f};
+    std::array<float, 4> rotation = {0.f, 0.f, 0.f, 1.f};
+    std::optional<SkRect> clip_bounds;
+    std::string label;
+    float opacity = 1.f;
+
+    // Whether an entity of the current frame uses these nodes.
+    bool used = false;
+  };
+
+  // Returns the nodes retained for the |kind| entity of |layer|, with their
+  // children detached, or new nodes if |layer| is nullptr.
+  std::shared_ptr<RetainedEntity> AcquireEntityNodes(const Layer* layer,
+                                                     EntityKind kind);
+
   void CreateFrame(scenic::EntityNode& entity_node,
                    const SkRRect& rrect,
                    SkColor color,
@@ -226,6 +283,9 @@ class SceneUpdateContext : public flutter::ExternalViewEmbedder {
 
   std::vector<PaintTask> paint_tasks_;
 
+  std::map<std::pair<uint64_t, EntityKind>, std::shared_ptr<RetainedEntity>>
+      retained_entities_;
+
   Entity* top_entity_ = nullptr;
   float top_scale_x_ = 1.f;
   float top_scale_y_ = 1.f;
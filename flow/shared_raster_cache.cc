@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shared_raster_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// Whether |image| may be drawn, and released, with |context|. Raster images
+// may be used anywhere.
+static bool CanUseImage(const SkImage& image, GrDirectContext* context) {
+  return !image.isTextureBacked() || image.isValid(context);
+}
+
+SharedRasterCache::SharedRasterCache() = default;
+
+SharedRasterCache::~SharedRasterCache() = default;
+
+const std::shared_ptr<SharedRasterCache>& SharedRasterCache::GetInstance() {
+  static const std::shared_ptr<SharedRasterCache> instance =
+      std::make_shared<SharedRasterCache>();
+  return instance;
+}
+
+void SharedRasterCache::Prune(std::vector<sk_sp<SkImage>>& images,
+                              GrDirectContext* context) {
+  // Texture backed images must be released with their context, so only the
+  // images of |context| are dropped here.
+  images.erase(std::remove_if(images.begin(), images.end(),
+                              [context](const sk_sp<SkImage>& image) {
+                                return image->unique() &&
+                                       CanUseImage(*image, context);
+                              }),
+               images.end());
+}
+
+sk_sp<SkImage> SharedRasterCache::Get(const DisplayListRasterCacheKey& key,
+                                      GrDirectContext* context,
+                                      SkColorSpace* dst_color_space) {
+  std::scoped_lock lock(mutex_);
+  auto found = images_.find(key);
+  if (found == images_.end()) {
+    return nullptr;
+  }
+  std::vector<sk_sp<SkImage>>& images = found->second;
+  Prune(images, context);
+  for (const auto& image : images) {
+    if (CanUseImage(*image, context) &&
+        SkColorSpace::Equals(image->colorSpace(), dst_color_space)) {
+      TRACE_EVENT0("flutter", "SharedRasterCacheHit");
+      return image;
+    }
+  }
+  if (images.empty()) {
+    images_.erase(found);
+  }
+  return nullptr;
+}
+
+void SharedRasterCache::Put(const DisplayListRasterCacheKey& key,
+                            GrDirectContext* context,
+                            sk_sp<SkImage> image) {
+  if (!image) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  std::vector<sk_sp<SkImage>>& images = images_[key];
+  Prune(images, context);
+  images.push_back(std::move(image));
+}
+
+size_t SharedRasterCache::GetImageCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0;
+  for (const auto& item : images_) {
+    for (const auto& image : item.second) {
+      count += image->unique() ? 0 : 1;
+    }
+  }
+  return count;
+}
+
+size_t SharedRasterCache::GetByteSize() const {
+  std::scoped_lock lock(mutex_);
+  size_t bytes = 0;
+  for (const auto& item : images_) {
+    for (const auto& image : item.second) {
+      if (!image->unique()) {
+        bytes += image->imageInfo().computeMinByteSize();
+      }
+    }
+  }
+  return bytes;
+}
+
+}  // namespace flutter
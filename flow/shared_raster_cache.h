@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_SHARED_RASTER_CACHE_H_
+#define FLUTTER_FLOW_SHARED_RASTER_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/flow/raster_cache_key.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+/**
+ * @brief A thread-safe store of display list raster cache images, shared by
+ * the raster caches of the engines in a process.
+ *
+ * Images are keyed by the content fingerprint of their display list and the
+ * matrix they were rasterized with. A texture backed image is only handed to
+ * raster caches using the GrDirectContext it was created with, so engines
+ * share GPU images only when they share a context. The store does not keep
+ * images alive on its own: an image is dropped once no raster cache entry
+ * uses it anymore. Each raster cache still counts the images it uses against
+ * its own budget.
+ */
+class SharedRasterCache {
+ public:
+  SharedRasterCache();
+
+  ~SharedRasterCache();
+
+  /**
+   * @brief The store shared by every engine of the process.
+   */
+  static const std::shared_ptr<SharedRasterCache>& GetInstance();
+
+  /**
+   * @brief Find the image rasterized for |key| that can be drawn with
+   * |context| into a surface of |dst_color_space|, or null.
+   */
+  sk_sp<SkImage> Get(const DisplayListRasterCacheKey& key,
+                     GrDirectContext* context,
+                     SkColorSpace* dst_color_space);
+
+  /**
+   * @brief Make |image|, rasterized for |key| with |context|, available to the
+   * other raster caches.
+   */
+  void Put(const DisplayListRasterCacheKey& key,
+           GrDirectContext* context,
+           sk_sp<SkImage> image);
+
+  /**
+   * @brief The number of images still used by some raster cache.
+   */
+  size_t GetImageCount() const;
+
+  /**
+   * @brief The memory used by the images still used by some raster cache, each
+   * counted once however many raster caches use it.
+   */
+  size_t GetByteSize() const;
+
+ private:
+  mutable std::mutex mutex_;
+  DisplayListRasterCacheKey::Map<std::vector<sk_sp<SkImage>>> images_;
+
+  // Drops the images of |images| that only the store still references and
+  // that may be released on the calling thread.
+  static void Prune(std::vector<sk_sp<SkImage>>& images,
+                    GrDirectContext* context);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedRasterCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_SHARED_RASTER_CACHE_H_
@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shared_raster_cache.h"
+
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/raster_cache.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<SkImage> MakeImage(int width, int height) {
+  auto surface = SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(
+      width, height, SkColorSpace::MakeSRGB()));
+  surface->getCanvas()->clear(SK_ColorRED);
+  return surface->makeImageSnapshot();
+}
+
+TEST(SharedRasterCacheTest, ImagesAreSharedWhileUsed) {
+  SharedRasterCache shared_cache;
+  DisplayListRasterCacheKey key(42, SkMatrix::I());
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  sk_sp<SkImage> image = MakeImage(10, 10);
+  shared_cache.Put(key, nullptr, image);
+  ASSERT_EQ(shared_cache.GetImageCount(), 1u);
+  ASSERT_EQ(shared_cache.GetByteSize(), 400u);
+  ASSERT_EQ(shared_cache.Get(key, nullptr, srgb.get()), image);
+
+  // Other matrices and color spaces need their own rasterization.
+  DisplayListRasterCacheKey scaled_key(42, SkMatrix::Scale(2, 2));
+  ASSERT_EQ(shared_cache.Get(scaled_key, nullptr, srgb.get()), nullptr);
+  ASSERT_EQ(shared_cache.Get(key, nullptr, nullptr), nullptr);
+
+  // The store does not keep images alive on its own.
+  image.reset();
+  ASSERT_EQ(shared_cache.GetImageCount(), 0u);
+  ASSERT_EQ(shared_cache.GetByteSize(), 0u);
+  ASSERT_EQ(shared_cache.Get(key, nullptr, srgb.get()), nullptr);
+}
+
+TEST(SharedRasterCacheTest, RasterCachesReuseEachOthersDisplayListImages) {
+  auto shared_cache = std::make_shared<SharedRasterCache>();
+  RasterCache first_cache(1);
+  RasterCache second_cache(1);
+  first_cache.SetSharedCache(shared_cache);
+  second_cache.SetSharedCache(shared_cache);
+
+  DisplayListCanvasRecorder recorder(SkRect::MakeWH(100, 10));
+  SkPaint paint;
+  for (int i = 0; i < 10; i++) {
+    recorder.drawRect(SkRect::MakeXYWH(i * 10, 0, 5, 5), paint);
+  }
+  sk_sp<DisplayList> display_list = recorder.Build();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  const SkMatrix matrix = SkMatrix::I();
+
+  SkCanvas canvas(200, 200);
+  ASSERT_FALSE(first_cache.Prepare(nullptr, display_list.get(), matrix,
+                                   srgb.get(), true, false));
+  first_cache.Draw(*display_list, canvas);
+  first_cache.SweepAfterFrame();
+  ASSERT_TRUE(first_cache.Prepare(nullptr, display_list.get(), matrix,
+                                  srgb.get(), true, false));
+  ASSERT_EQ(shared_cache->GetImageCount(), 1u);
+
+  // The second cache uses the image right away.
+  ASSERT_TRUE(second_cache.Prepare(nullptr, display_list.get(), matrix,
+                                   srgb.get(), true, false));
+  ASSERT_TRUE(second_cache.Draw(*display_list, canvas));
+  ASSERT_EQ(shared_cache->GetImageCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,11 +4,22 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+// The time a drain is expected to take when scheduled into an idle period
+// without a drain budget.
+static constexpr fml::TimeDelta kEstimatedDrainDuration =
+    fml::TimeDelta::FromMilliseconds(1);
+
+// The number of objects released between checks of the drain budget.
+static constexpr size_t kDrainBatchSize = 16;
+
 SkiaUnrefQueue::SkiaUnrefQueue(fml::RefPtr<fml::TaskRunner> task_runner,
                                fml::TimeDelta delay,
                                fml::WeakPtr<GrDirectContext> context)
@@ -25,12 +36,51 @@ void SkiaUnrefQueue::Unref(SkRefCnt* object) {
   std::scoped_lock lock(mutex_);
   objects_.push_back(object);
   if (!drain_pending_) {
-    drain_pending_ = true;
+    ScheduleDrainLocked(drain_delay_);
+    TraceQueueDepthLocked();
+  }
+}
+
+void SkiaUnrefQueue::SetIdleTaskQueue(fml::RefPtr<fml::IdleTaskQueue> queue,
+                                      fml::TimeDelta max_drain_delay) {
+  std::scoped_lock lock(mutex_);
+  idle_task_queue_ = std::move(queue);
+  max_drain_delay_ = std::max(max_drain_delay, drain_delay_);
+}
+
+void SkiaUnrefQueue::SetDrainBudget(fml::TimeDelta budget) {
+  std::scoped_lock lock(mutex_);
+  drain_budget_ = budget;
+}
+
+size_t SkiaUnrefQueue::GetPendingObjectCount() {
+  std::scoped_lock lock(mutex_);
+  return objects_.size();
+}
+
+void SkiaUnrefQueue::ScheduleDrainLocked(fml::TimeDelta delay) {
+  drain_pending_ = true;
+  if (idle_task_queue_) {
+    const auto estimate = drain_budget_ > fml::TimeDelta::Zero()
+                              ? drain_budget_
+                              : kEstimatedDrainDuration;
+    idle_task_queue_->PostTask(
+        [strong = fml::Ref(this)]() { strong->DrainSlice(); }, estimate,
+        std::max(max_drain_delay_, delay));
+  } else {
     task_runner_->PostDelayedTask(
-        [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
+        [strong = fml::Ref(this)]() { strong->DrainSlice(); }, delay);
   }
 }
 
+void SkiaUnrefQueue::TraceQueueDepthLocked() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "SkiaUnrefQueue",
+                    reinterpret_cast<int64_t>(this), "PendingObjects",
+                    objects_.size());
+#endif  // !FLUTTER_RELEASE
+}
+
 void SkiaUnrefQueue::Drain() {
   TRACE_EVENT0("flutter", "SkiaUnrefQueue::Drain");
   std::deque<SkRefCnt*> skia_objects;
@@ -38,6 +88,7 @@ void SkiaUnrefQueue::Drain() {
     std::scoped_lock lock(mutex_);
     objects_.swap(skia_objects);
     drain_pending_ = false;
+    TraceQueueDepthLocked();
   }
 
   for (SkRefCnt* skia_object : skia_objects) {
@@ -49,4 +100,50 @@ void SkiaUnrefQueue::Drain() {
   }
 }
 
+void SkiaUnrefQueue::DrainSlice() {
+  fml::TimeDelta budget;
+  {
+    std::scoped_lock lock(mutex_);
+    budget = drain_budget_;
+  }
+  if (budget <= fml::TimeDelta::Zero()) {
+    Drain();
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainSlice");
+  const auto slice_deadline = fml::TimePoint::Now() + budget;
+  size_t released = 0;
+  std::vector<SkRefCnt*> batch;
+  batch.reserve(kDrainBatchSize);
+  do {
+    batch.clear();
+    {
+      std::scoped_lock lock(mutex_);
+      const size_t count = std::min(kDrainBatchSize, objects_.size());
+      batch.assign(objects_.begin(), objects_.begin() + count);
+      objects_.erase(objects_.begin(), objects_.begin() + count);
+    }
+    for (SkRefCnt* skia_object : batch) {
+      skia_object->unref();
+    }
+    released += batch.size();
+  } while (!batch.empty() && fml::TimePoint::Now() < slice_deadline);
+
+  // Purge the resources of the whole slice from the context at once rather
+  // than once per object.
+  if (context_ && released > 0) {
+    context_->performDeferredCleanup(std::chrono::milliseconds(0));
+  }
+
+  std::scoped_lock lock(mutex_);
+  TraceQueueDepthLocked();
+  if (objects_.empty()) {
+    drain_pending_ = false;
+  } else {
+    // Yield to other tasks before releasing the rest.
+    ScheduleDrainLocked(fml::TimeDelta::Zero());
+  }
+}
+
 }  // namespace flutter
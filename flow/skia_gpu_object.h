@@ -8,6 +8,7 @@
 #include <mutex>
 #include <queue>
 
+#include "flutter/fml/idle_task_queue.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/task_runner.h"
@@ -29,12 +30,29 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   // after this call.
   void Drain();
 
+  // Schedules drains into the idle periods of |queue| instead of after a
+  // fixed delay. A drain that does not fit the idle budget still happens after
+  // at most |max_drain_delay|.
+  void SetIdleTaskQueue(fml::RefPtr<fml::IdleTaskQueue> queue,
+                        fml::TimeDelta max_drain_delay);
+
+  // Limits how long a scheduled drain may spend releasing objects. Objects
+  // left over once |budget| is spent are released by a follow-up drain, so
+  // that releasing many textures at once does not stall the task runner. A
+  // zero budget, the default, releases all pending objects in one drain.
+  void SetDrainBudget(fml::TimeDelta budget);
+
+  size_t GetPendingObjectCount();
+
  private:
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
   std::mutex mutex_;
   std::deque<SkRefCnt*> objects_;
   bool drain_pending_;
+  fml::RefPtr<fml::IdleTaskQueue> idle_task_queue_;
+  fml::TimeDelta max_drain_delay_;
+  fml::TimeDelta drain_budget_;
   fml::WeakPtr<GrDirectContext> context_;
 
   // The `GrDirectContext* context` is only used for signaling Skia to
@@ -46,6 +64,13 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
 
   ~SkiaUnrefQueue();
 
+  void ScheduleDrainLocked(fml::TimeDelta delay);
+
+  // Releases pending objects until |drain_budget_| is spent.
+  void DrainSlice();
+
+  void TraceQueueDepthLocked() const;
+
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(SkiaUnrefQueue);
   FML_FRIEND_MAKE_REF_COUNTED(SkiaUnrefQueue);
   FML_DISALLOW_COPY_AND_ASSIGN(SkiaUnrefQueue);
@@ -5,6 +5,7 @@
 #include "flutter/flow/skia_gpu_object.h"
 
 #include <future>
+#include <vector>
 
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -127,5 +128,41 @@ TEST_F(SkiaGpuObjectTest, ObjectResetTwice) {
   ASSERT_EQ(dtor_task_queue_id, unref_task_runner()->GetTaskQueueId());
 }
 
+TEST_F(SkiaGpuObjectTest, BudgetedDrainReleasesObjectsInSlices) {
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      unref_task_runner(), fml::TimeDelta::FromSeconds(0));
+  queue->SetDrainBudget(fml::TimeDelta::FromMicroseconds(1));
+
+  constexpr size_t kObjectCount = 40;
+  std::vector<std::shared_ptr<fml::AutoResetWaitableEvent>> latches;
+  std::vector<SkRefCnt*> objects;
+  for (size_t i = 0; i < kObjectCount; i++) {
+    latches.push_back(std::make_shared<fml::AutoResetWaitableEvent>());
+    objects.push_back(new TestSkObject(latches.back(), nullptr));
+  }
+
+  // The first slice runs before the check posted right after the unrefs,
+  // and posts the slice that follows it after the check.
+  fml::AutoResetWaitableEvent checked;
+  size_t pending_after_first_slice = 0;
+  unref_task_runner()->PostTask([&]() {
+    for (SkRefCnt* object : objects) {
+      queue->Unref(object);
+    }
+    unref_task_runner()->PostTask([&]() {
+      pending_after_first_slice = queue->GetPendingObjectCount();
+      checked.Signal();
+    });
+  });
+  checked.Wait();
+
+  for (const auto& latch : latches) {
+    latch->Wait();
+  }
+  ASSERT_GT(pending_after_first_slice, 0u);
+  ASSERT_LT(pending_after_first_slice, kObjectCount);
+  ASSERT_EQ(queue->GetPendingObjectCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -18,4 +18,12 @@ bool Surface::ClearRenderContext() {
   return false;
 }
 
+std::vector<fml::TimeDelta> Surface::TakeGPUFrameTimes() {
+  return {};
+}
+
+std::optional<PresentationFeedback> Surface::TakePresentationFeedback() {
+  return std::nullopt;
+}
+
 }  // namespace flutter
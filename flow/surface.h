@@ -6,14 +6,30 @@
 #define FLUTTER_FLOW_SURFACE_H_
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface_frame.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 
 namespace flutter {
 
+/// How the frames presented by a surface met the display, as reported by the
+/// presentation engine.
+struct PresentationFeedback {
+  // The refresh period the display actually runs at.
+  fml::TimeDelta refresh_period;
+  // How much earlier than necessary the latest frame was handed to the
+  // presentation engine.
+  fml::TimeDelta present_margin;
+  // The number of frames that were shown later than they could have been
+  // because earlier frames were still queued.
+  size_t late_frames = 0;
+};
+
 /// Abstract Base Class that represents where we will be rendering content.
 class Surface {
  public:
@@ -33,6 +49,17 @@ class Surface {
 
   virtual bool ClearRenderContext();
 
+  // Returns the time the GPU spent executing each of the frames whose GPU
+  // work completed since the last call, oldest first. The GPU finishes a
+  // frame some time after it was submitted, so the times usually belong to
+  // earlier frames. Surfaces that can not measure the GPU return nothing.
+  virtual std::vector<fml::TimeDelta> TakeGPUFrameTimes();
+
+  // Returns how the frames presented since the last call met the display.
+  // Surfaces whose presentation engine does not report timings, or that did
+  // not present a frame since the last call, return nothing.
+  virtual std::optional<PresentationFeedback> TakePresentationFeedback();
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Surface);
 };
@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_SURFACE_FRAME_H_
 
 #include <memory>
+#include <optional>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/fml/macros.h"
@@ -21,6 +22,31 @@ class SurfaceFrame {
   using SubmitCallback =
       std::function<bool(const SurfaceFrame& surface_frame, SkCanvas* canvas)>;
 
+  // Information about the framebuffer backing this frame, provided by the
+  // surface that created it.
+  struct FramebufferInfo {
+    // Whether the surface is able to present a frame in which only part of
+    // the framebuffer has been repainted.
+    bool supports_partial_repaint = false;
+
+    // The area of the framebuffer whose contents are out of date with
+    // respect to the last presented frame, in device coordinates. If
+    // std::nullopt, the contents of the framebuffer are undefined and the
+    // whole frame must be repainted.
+    std::optional<SkIRect> existing_damage;
+  };
+
+  // Information passed to the surface when the frame is submitted.
+  struct SubmitInfo {
+    // The area of the frame that changed since the previous frame, in device
+    // coordinates. If std::nullopt, the whole frame changed.
+    std::optional<SkIRect> frame_damage;
+
+    // The area of the framebuffer that was repainted, in device coordinates.
+    // If std::nullopt, the whole framebuffer was repainted.
+    std::optional<SkIRect> buffer_damage;
+  };
+
   SurfaceFrame(sk_sp<SkSurface> surface,
                bool supports_readback,
                const SubmitCallback& submit_callback);
@@ -42,10 +68,22 @@ class SurfaceFrame {
 
   bool supports_readback() { return supports_readback_; }
 
+  void set_framebuffer_info(const FramebufferInfo& framebuffer_info) {
+    framebuffer_info_ = framebuffer_info;
+  }
+  const FramebufferInfo& framebuffer_info() const { return framebuffer_info_; }
+
+  void set_submit_info(const SubmitInfo& submit_info) {
+    submit_info_ = submit_info;
+  }
+  const SubmitInfo& submit_info() const { return submit_info_; }
+
  private:
   bool submitted_ = false;
   sk_sp<SkSurface> surface_;
   bool supports_readback_;
+  FramebufferInfo framebuffer_info_;
+  SubmitInfo submit_info_;
   SubmitCallback submit_callback_;
   std::unique_ptr<GLContextResult> context_result_;
 
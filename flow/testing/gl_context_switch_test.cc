@@ -28,6 +28,11 @@ bool TestSwitchableGLContext::RemoveCurrent() {
   return true;
 };
 
+bool TestSwitchableGLContext::IsCurrent() const {
+  int* current = current_context.get();
+  return current && *current == context_;
+};
+
 int TestSwitchableGLContext::GetContext() {
   return context_;
 };
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/testing/mock_layer.h"
 
+#include "flutter/fml/hash_combine.h"
+
 namespace flutter {
 namespace testing {
 
@@ -30,6 +32,12 @@ void MockLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   if (fake_reads_surface_) {
     context->surface_needs_readback = true;
   }
+  if (auto* diff_context = context->diff_context) {
+    diff_context->AddPaintRegion(
+        fml::HashCombine(DiffContext::HashPath(fake_paint_path_),
+                         fake_paint_.getColor()),
+        paint_bounds(), matrix, context->cull_rect);
+  }
 }
 
 void MockLayer::Paint(PaintContext& context) const {
@@ -6,29 +6,61 @@
 
 #include <algorithm>
 
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/thread.h"
+#include "flutter/fml/thread_local.h"
 #include "flutter/fml/trace_event.h"
 
 namespace fml {
 
+namespace {
+
+struct WorkerIdentity {
+  const ConcurrentMessageLoop* loop;
+  size_t index;
+};
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<WorkerIdentity> tls_worker;
+
+}  // namespace
+
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
-    size_t worker_count) {
+    size_t worker_count,
+    const Thread::ThreadLauncher& launcher) {
   return std::shared_ptr<ConcurrentMessageLoop>{
-      new ConcurrentMessageLoop(worker_count)};
+      new ConcurrentMessageLoop(worker_count, launcher)};
 }
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
-    : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+ConcurrentMessageLoop::ConcurrentMessageLoop(
+    size_t worker_count,
+    const Thread::ThreadLauncher& launcher)
+    : worker_count_(std::max<size_t>(worker_count, 1ul)),
+      launched_workers_exited_(
+          std::make_shared<CountDownLatch>(launcher ? worker_count_ : 0)) {
   for (size_t i = 0; i < worker_count_; ++i) {
-    workers_.emplace_back([i, this]() {
-      fml::Thread::SetCurrentThreadName(
-          std::string{"io.flutter.worker." + std::to_string(i + 1)});
-      WorkerMain();
-    });
+    worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
   }
 
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
+  for (size_t i = 0; i < worker_count_; ++i) {
+    const std::string name = "io.flutter.worker." + std::to_string(i + 1);
+    if (launcher &&
+        launcher(Thread::ThreadConfig(name),
+                 [i, this, exited = launched_workers_exited_]() {
+                   WorkerMain(i);
+                   // The loop may be collected as soon as the last worker
+                   // exits, |this| must not be used past this point.
+                   exited->CountDown();
+                 })) {
+      continue;
+    }
+    if (launcher) {
+      // Account for the worker the launcher did not start.
+      launched_workers_exited_->CountDown();
+    }
+    workers_.emplace_back([i, this, name]() {
+      fml::Thread::SetCurrentThreadName(name);
+      WorkerMain(i);
+    });
   }
 }
 
@@ -37,6 +69,7 @@ ConcurrentMessageLoop::~ConcurrentMessageLoop() {
   for (auto& worker : workers_) {
     worker.join();
   }
+  launched_workers_exited_->Wait();
 }
 
 size_t ConcurrentMessageLoop::GetWorkerCount() const {
@@ -48,79 +81,129 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
 }
 
 void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+  const WorkerIdentity* worker = tls_worker.get();
+  if (worker && worker->loop == this) {
+    // Keep the task on the worker that posted it, it is likely to work on
+    // data that is still in the cache of that core.
+    PostTaskWithAffinity(task, worker->index);
+  } else {
+    PostTaskWithAffinity(task, next_worker_.fetch_add(1));
+  }
+}
+
+void ConcurrentMessageLoop::PostTaskWithAffinity(const fml::closure& task,
+                                                 size_t affinity_hint) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     task();
     return;
   }
 
-  tasks_.push(task);
+  PushTask(affinity_hint % worker_count_, task);
+}
+
+void ConcurrentMessageLoop::PushTask(size_t worker_index, fml::closure task) {
+  {
+    auto& queue = *worker_queues_[worker_index];
+    std::scoped_lock lock(queue.mutex);
+    queue.tasks.emplace_back(std::move(task));
+  }
+  pending_task_count_.fetch_add(1);
+  WakeUpIdleWorker();
+}
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+fml::closure ConcurrentMessageLoop::TakeTask(size_t worker_index) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    if (i > 0 && pending_task_count_.load() == 0) {
+      break;
+    }
+    auto& queue = *worker_queues_[(worker_index + i) % worker_count_];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      fml::closure task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      pending_task_count_.fetch_sub(1);
+      return task;
+    }
+  }
+  return nullptr;
+}
 
-  tasks_condition_.notify_one();
+std::vector<fml::closure> ConcurrentMessageLoop::TakeThreadTasks(
+    size_t worker_index) {
+  auto& queue = *worker_queues_[worker_index];
+  std::scoped_lock lock(queue.mutex);
+  std::vector<fml::closure> thread_tasks;
+  std::swap(thread_tasks, queue.thread_tasks);
+  return thread_tasks;
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return tasks_.size() > 0 || shutdown_ || HasThreadTasksLocked();
-    });
+bool ConcurrentMessageLoop::HasThreadTasks(size_t worker_index) const {
+  auto& queue = *worker_queues_[worker_index];
+  std::scoped_lock lock(queue.mutex);
+  return !queue.thread_tasks.empty();
+}
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+void ConcurrentMessageLoop::WakeUpIdleWorker() {
+  if (idle_worker_count_.load() == 0) {
+    return;
+  }
+  // An idle worker holds the mutex from the moment it checks for tasks until
+  // it waits on the condition variable. Acquiring it here makes sure the
+  // notification is not missed. It doesn't need to be held while notifying
+  // because it has to be acquired on the other thread anyway.
+  { std::scoped_lock lock(idle_mutex_); }
+  idle_condition_.notify_one();
+}
 
-    if (tasks_.size() != 0) {
-      task = tasks_.front();
-      tasks_.pop();
-    }
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tls_worker.reset(new WorkerIdentity{this, worker_index});
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+  while (true) {
+    {
+      std::unique_lock lock(idle_mutex_);
+      idle_worker_count_.fetch_add(1);
+      idle_condition_.wait(lock, [&]() {
+        return pending_task_count_.load() > 0 || shutdown_ ||
+               HasThreadTasks(worker_index);
+      });
+      idle_worker_count_.fetch_sub(1);
     }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
-
     TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
+    // Run tasks, stealing them from other workers if needed, until there are
+    // none left. Tasks are executed with no lock held as they could
+    // themselves try to post more tasks to the message loop.
+    while (true) {
+      for (const auto& thread_task : TakeThreadTasks(worker_index)) {
+        thread_task();
+      }
+      fml::closure task = TakeTask(worker_index);
+      if (!task) {
+        break;
+      }
       task();
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      thread_task();
-    }
-
-    if (shutdown_now) {
+    if (shutdown_) {
       break;
     }
   }
+
+  tls_worker.reset(nullptr);
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
   shutdown_ = true;
-  tasks_condition_.notify_all();
+  { std::scoped_lock lock(idle_mutex_); }
+  idle_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
@@ -128,24 +211,12 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(fml::closure task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (const auto& queue : worker_queues_) {
+    std::scoped_lock lock(queue->mutex);
+    queue->thread_tasks.emplace_back(task);
   }
-  tasks_condition_.notify_all();
-}
-
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
+  { std::scoped_lock lock(idle_mutex_); }
+  idle_condition_.notify_all();
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
@@ -170,4 +241,67 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   task();
 }
 
+void ConcurrentTaskRunner::PostTaskWithAffinity(const fml::closure& task,
+                                                size_t affinity_hint) {
+  if (!task) {
+    return;
+  }
+
+  if (auto loop = weak_loop_.lock()) {
+    loop->PostTaskWithAffinity(task, affinity_hint);
+    return;
+  }
+
+  FML_DLOG(WARNING)
+      << "Tried to post to a concurrent message loop that has already died. "
+         "Executing the task on the callers thread.";
+  task();
+}
+
+void ConcurrentTaskRunner::ParallelFor(
+    size_t count,
+    const std::function<void(size_t)>& body) {
+  if (count == 0) {
+    return;
+  }
+
+  struct State {
+    const std::function<void(size_t)>* body;
+    size_t count;
+    std::atomic<size_t> next_index{0};
+    std::atomic<size_t> done_count{0};
+    fml::ManualResetWaitableEvent done;
+  };
+  auto state = std::make_shared<State>();
+  state->body = &body;
+  state->count = count;
+
+  // Helpers that only start once all the indices have been claimed return
+  // without touching |body|, which may no longer be alive by then.
+  auto run = [state]() {
+    size_t invocations = 0;
+    for (size_t index = state->next_index.fetch_add(1); index < state->count;
+         index = state->next_index.fetch_add(1)) {
+      (*state->body)(index);
+      invocations++;
+    }
+    if (invocations > 0 &&
+        state->done_count.fetch_add(invocations) + invocations ==
+            state->count) {
+      state->done.Signal();
+    }
+  };
+
+  if (auto loop = weak_loop_.lock()) {
+    const size_t helper_count =
+        std::min(count, loop->GetWorkerCount() + 1) - 1;
+    for (size_t i = 0; i < helper_count; ++i) {
+      loop->PostTask(run);
+    }
+  }
+
+  run();
+  state->done.Wait();
+}
+
 }  // namespace fml
@@ -5,24 +5,36 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+// A pool of worker threads. Each worker has its own task deque. Tasks posted
+// from a worker are queued on that worker, other tasks are distributed among
+// the workers, and workers that run out of tasks steal from the others.
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  // Workers are started by |launcher| if one is provided, see
+  // |Thread::ThreadLauncher|.
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      const Thread::ThreadLauncher& launcher = nullptr);
 
   ~ConcurrentMessageLoop();
 
@@ -37,24 +49,49 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<fml::closure> tasks;
+    // Tasks posted via |PostTaskToAllWorkers| that must run on this worker.
+    std::vector<fml::closure> thread_tasks;
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  // Counted down when a worker started by a |Thread::ThreadLauncher| exits.
+  std::shared_ptr<CountDownLatch> launched_workers_exited_;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  // The number of tasks in all the |WorkerQueue::tasks|.
+  std::atomic<size_t> pending_task_count_{0};
+  std::atomic<size_t> next_worker_{0};
+  // Only taken by idle workers and to wake them up.
+  std::mutex idle_mutex_;
+  std::condition_variable idle_condition_;
+  std::atomic<size_t> idle_worker_count_{0};
+  std::atomic_bool shutdown_{false};
+
+  ConcurrentMessageLoop(size_t worker_count,
+                        const Thread::ThreadLauncher& launcher);
+
+  void WorkerMain(size_t worker_index);
+
+  void PostTask(const fml::closure& task);
 
-  ConcurrentMessageLoop(size_t worker_count);
+  // Queues |task| on the worker selected by |affinity_hint| (modulo the
+  // number of workers). An idle worker may still steal it.
+  void PostTaskWithAffinity(const fml::closure& task, size_t affinity_hint);
 
-  void WorkerMain();
+  void PushTask(size_t worker_index, fml::closure task);
 
-  void PostTask(const fml::closure& task);
+  // Pops a task from the worker's own queue or, failing that, steals one
+  // from another worker.
+  fml::closure TakeTask(size_t worker_index);
 
-  bool HasThreadTasksLocked() const;
+  std::vector<fml::closure> TakeThreadTasks(size_t worker_index);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  bool HasThreadTasks(size_t worker_index) const;
+
+  void WakeUpIdleWorker();
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -67,6 +104,15 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   void PostTask(const fml::closure& task) override;
 
+  // Posts a task to be preferably run by the same worker as other tasks
+  // posted with the same hint, e.g. tasks working on the same data.
+  void PostTaskWithAffinity(const fml::closure& task, size_t affinity_hint);
+
+  // Invokes |body| for every index in [0, count) on the workers of the loop
+  // and the calling thread, and returns once all the invocations are done.
+  // The calling thread participates, so this may be called from a worker.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
  private:
   friend ConcurrentMessageLoop;
 
@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+#include <sched.h>
+#endif
+
+namespace fml {
+
+CPUSpeedTracker::CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data) {
+  if (data.empty()) {
+    return;
+  }
+  const auto [min, max] = std::minmax_element(
+      data.begin(), data.end(),
+      [](const CpuIndexAndSpeed& a, const CpuIndexAndSpeed& b) {
+        return a.speed < b.speed;
+      });
+  const int64_t min_speed = min->speed;
+  const int64_t max_speed = max->speed;
+  if (min_speed == max_speed) {
+    return;
+  }
+  std::sort(data.begin(), data.end(),
+            [](const CpuIndexAndSpeed& a, const CpuIndexAndSpeed& b) {
+              return a.index < b.index;
+            });
+  for (const auto& cpu : data) {
+    if (cpu.speed == max_speed) {
+      performance_.push_back(cpu.index);
+    } else {
+      not_performance_.push_back(cpu.index);
+    }
+    if (cpu.speed == min_speed) {
+      efficiency_.push_back(cpu.index);
+    }
+  }
+  valid_ = true;
+}
+
+bool CPUSpeedTracker::IsValid() const {
+  return valid_;
+}
+
+const std::vector<size_t>& CPUSpeedTracker::GetIndices(
+    CpuAffinity affinity) const {
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      return performance_;
+    case CpuAffinity::kEfficiency:
+      return efficiency_;
+    case CpuAffinity::kNotPerformance:
+      return not_performance_;
+  }
+  FML_UNREACHABLE();
+}
+
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+
+std::optional<std::vector<CpuIndexAndSpeed>> ReadCpuSpeeds() {
+  const size_t count = std::thread::hardware_concurrency();
+  std::vector<CpuIndexAndSpeed> speeds;
+  for (size_t i = 0; i < count; i++) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(i) +
+                       "/cpufreq/cpuinfo_max_freq");
+    int64_t speed = 0;
+    if (!(file >> speed)) {
+      // Cores may be offline, or the kernel may not expose their frequency.
+      // Pinning threads to a partial view of the device would be wrong.
+      return std::nullopt;
+    }
+    speeds.push_back({i, speed});
+  }
+  return speeds;
+}
+
+static const CPUSpeedTracker& GetCPUSpeedTracker() {
+  static const CPUSpeedTracker tracker(
+      ReadCpuSpeeds().value_or(std::vector<CpuIndexAndSpeed>{}));
+  return tracker;
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  const auto& tracker = GetCPUSpeedTracker();
+  if (!tracker.IsValid()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t index : tracker.GetIndices(affinity)) {
+    CPU_SET(index, &set);
+  }
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    FML_DLOG(ERROR) << "Could not set the CPU affinity of the thread.";
+    return false;
+  }
+  return true;
+}
+
+#else
+
+std::optional<std::vector<CpuIndexAndSpeed>> ReadCpuSpeeds() {
+  return std::nullopt;
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  return false;
+}
+
+#endif
+
+}  // namespace fml
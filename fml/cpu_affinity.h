@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fml {
+
+// The cores of a heterogeneous (big.LITTLE) CPU a thread should run on.
+enum class CpuAffinity {
+  // The fastest cores of the device.
+  kPerformance,
+
+  // The slowest cores of the device.
+  kEfficiency,
+
+  // Every core but the fastest ones, so that the threads with performance
+  // affinity are not competing with this thread.
+  kNotPerformance,
+};
+
+struct CpuIndexAndSpeed {
+  // The index of the core, as used by the scheduler.
+  size_t index;
+
+  // The maximum frequency of the core. Only the relative order matters.
+  int64_t speed;
+};
+
+// Groups the cores of a device by their maximum frequency.
+//
+// A device whose cores all have the same speed is not heterogeneous. The
+// tracker is invalid for it, and threads should not be pinned to any core.
+class CPUSpeedTracker {
+ public:
+  explicit CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data);
+
+  // Whether the device has cores of different speeds.
+  bool IsValid() const;
+
+  // The indices of the cores matching |affinity|, in increasing order.
+  const std::vector<size_t>& GetIndices(CpuAffinity affinity) const;
+
+ private:
+  bool valid_ = false;
+  std::vector<size_t> performance_;
+  std::vector<size_t> efficiency_;
+  std::vector<size_t> not_performance_;
+};
+
+// Reads the maximum frequency of the cores of the device, or returns
+// |std::nullopt| if the platform does not expose it.
+std::optional<std::vector<CpuIndexAndSpeed>> ReadCpuSpeeds();
+
+// Restricts the current thread to the cores matching |affinity|. Returns false
+// if the platform does not support thread affinity, the device is not
+// heterogeneous, or the request was rejected.
+bool RequestAffinity(CpuAffinity affinity);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
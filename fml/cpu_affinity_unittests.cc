@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(CpuAffinity, HomogeneousCpusAreNotTracked) {
+  CPUSpeedTracker tracker({{0, 1800}, {1, 1800}, {2, 1800}, {3, 1800}});
+  ASSERT_FALSE(tracker.IsValid());
+  ASSERT_TRUE(tracker.GetIndices(CpuAffinity::kPerformance).empty());
+}
+
+TEST(CpuAffinity, EmptyCpuListIsNotTracked) {
+  CPUSpeedTracker tracker({});
+  ASSERT_FALSE(tracker.IsValid());
+}
+
+TEST(CpuAffinity, GroupsBigAndLittleCores) {
+  CPUSpeedTracker tracker({{3, 2400}, {0, 1200}, {2, 1800}, {1, 1200}});
+  ASSERT_TRUE(tracker.IsValid());
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            std::vector<size_t>({3}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kEfficiency),
+            std::vector<size_t>({0, 1}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            std::vector<size_t>({0, 1, 2}));
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -10,8 +10,16 @@ namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
                          const fml::closure& task,
-                         fml::TimePoint target_time)
-    : order_(order), task_(task), target_time_(target_time) {}
+                         fml::TimePoint target_time,
+                         TaskPriority priority,
+                         fml::TimePoint deadline,
+                         fml::TimePoint post_time)
+    : order_(order),
+      task_(task),
+      target_time_(target_time),
+      priority_(priority),
+      deadline_(deadline),
+      post_time_(post_time) {}
 
 DelayedTask::DelayedTask(const DelayedTask& other) = default;
 
@@ -25,6 +33,22 @@ fml::TimePoint DelayedTask::GetTargetTime() const {
   return target_time_;
 }
 
+TaskPriority DelayedTask::GetPriority() const {
+  return priority_;
+}
+
+fml::TimePoint DelayedTask::GetDeadline() const {
+  return deadline_;
+}
+
+fml::TimePoint DelayedTask::GetPostTime() const {
+  return post_time_;
+}
+
+TaskPriority DelayedTask::GetEffectivePriority(fml::TimePoint now) const {
+  return deadline_ <= now ? TaskPriority::kCritical : priority_;
+}
+
 bool DelayedTask::operator>(const DelayedTask& other) const {
   if (target_time_ == other.target_time_) {
     return order_ > other.order_;
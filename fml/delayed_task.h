@@ -12,11 +12,31 @@
 
 namespace fml {
 
+// The lanes tasks of a message loop are posted in. Of the tasks that are due,
+// the ones in the lane with the lowest value run first.
+enum class TaskPriority {
+  // Work that produces the next frame, e.g. vsync callbacks and rasterization.
+  kCritical,
+  kNormal,
+  // Work that should only run when there is nothing else to do, e.g. idle
+  // notifications.
+  kIdle,
+};
+
+constexpr size_t kTaskPriorityCount =
+    static_cast<size_t>(TaskPriority::kIdle) + 1;
+
 class DelayedTask {
  public:
+  // A task that is still pending once |deadline| has passed runs as if it had
+  // been posted with |TaskPriority::kCritical|. |post_time| is only set for
+  // the tasks whose queue latency is sampled.
   DelayedTask(size_t order,
               const fml::closure& task,
-              fml::TimePoint target_time);
+              fml::TimePoint target_time,
+              TaskPriority priority = TaskPriority::kNormal,
+              fml::TimePoint deadline = fml::TimePoint::Max(),
+              fml::TimePoint post_time = fml::TimePoint());
 
   DelayedTask(const DelayedTask& other);
 
@@ -26,12 +46,25 @@ class DelayedTask {
 
   fml::TimePoint GetTargetTime() const;
 
+  TaskPriority GetPriority() const;
+
+  fml::TimePoint GetDeadline() const;
+
+  fml::TimePoint GetPostTime() const;
+
+  // The priority of the task when run at |now|, taking its deadline into
+  // account.
+  TaskPriority GetEffectivePriority(fml::TimePoint now) const;
+
   bool operator>(const DelayedTask& other) const;
 
  private:
   size_t order_;
   fml::closure task_;
   fml::TimePoint target_time_;
+  TaskPriority priority_;
+  fml::TimePoint deadline_;
+  fml::TimePoint post_time_;
 };
 
 using DelayedTaskQueue = std::priority_queue<DelayedTask,
@@ -5,6 +5,9 @@
 #include "flutter/fml/file.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
 
 namespace fml {
@@ -124,4 +127,27 @@ bool RemoveDirectoryRecursively(const fml::UniqueFD& parent,
   return RemoveFilesInDirectory(dir) && UnlinkDirectory(parent, directory_name);
 }
 
+void ReadFileAsync(fml::RefPtr<fml::TaskRunner> task_runner,
+                   std::string path,
+                   fml::RefPtr<fml::TaskRunner> completion_task_runner,
+                   ReadFileCallback callback) {
+  FML_DCHECK(task_runner && completion_task_runner && callback);
+  task_runner->PostTask([path = std::move(path),
+                         completion_task_runner =
+                             std::move(completion_task_runner),
+                         callback = std::move(callback)]() {
+    std::unique_ptr<Mapping> contents;
+    // Copy the mapping so that its pages are not faulted in by the caller.
+    if (auto mapping = FileMapping::CreateReadOnly(path)) {
+      const uint8_t* data = mapping->GetMapping();
+      contents = std::make_unique<DataMapping>(
+          std::vector<uint8_t>(data, data + mapping->GetSize()));
+    }
+    completion_task_runner->PostTask(fml::MakeCopyable(
+        [callback, contents = std::move(contents)]() mutable {
+          callback(std::move(contents));
+        }));
+  });
+}
+
 }  // namespace fml
@@ -7,10 +7,12 @@
 
 #include <functional>
 #include <initializer_list>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/unique_fd.h"
 
 #ifdef ERROR
@@ -20,6 +22,7 @@
 namespace fml {
 
 class Mapping;
+class TaskRunner;
 
 enum class FilePermission {
   kRead,
@@ -137,6 +140,17 @@ bool RemoveFilesInDirectory(const fml::UniqueFD& directory);
 bool RemoveDirectoryRecursively(const fml::UniqueFD& parent,
                                 const char* directory_name);
 
+using ReadFileCallback = std::function<void(std::unique_ptr<Mapping>)>;
+
+/// Reads the whole file at `path` into memory on `task_runner`, so that the
+/// caller does not block on slow storage, then invokes `callback` with the
+/// contents on `completion_task_runner`. The contents are null if the file
+/// could not be read.
+void ReadFileAsync(fml::RefPtr<fml::TaskRunner> task_runner,
+                   std::string path,
+                   fml::RefPtr<fml::TaskRunner> completion_task_runner,
+                   ReadFileCallback callback);
+
 class ScopedTemporaryDirectory {
  public:
   ScopedTemporaryDirectory();
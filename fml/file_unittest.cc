@@ -10,6 +10,8 @@
 #include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/unique_fd.h"
 #include "gtest/gtest.h"
 
@@ -296,3 +298,44 @@ TEST(FileTest, FileTestsSupportsUnicode) {
       fml::IsFile(fml::paths::JoinPaths({dir.path(), filename}).c_str()));
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), filename));
 }
+
+TEST(FileTest, CanReadFilesAsynchronously) {
+  fml::ScopedTemporaryDirectory dir;
+  const std::string contents = "These are my contents.";
+  auto data = std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>{contents.begin(), contents.end()});
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "async_data", *data));
+
+  fml::Thread read_thread("read");
+  fml::Thread completion_thread("completion");
+  auto completion_task_runner = completion_thread.GetTaskRunner();
+
+  fml::AutoResetWaitableEvent latch;
+  std::string read_contents;
+  fml::ReadFileAsync(
+      read_thread.GetTaskRunner(),
+      fml::paths::JoinPaths({dir.path(), "async_data"}), completion_task_runner,
+      [&](std::unique_ptr<fml::Mapping> mapping) {
+        EXPECT_TRUE(completion_task_runner->RunsTasksOnCurrentThread());
+        ASSERT_TRUE(mapping);
+        read_contents.assign(
+            reinterpret_cast<const char*>(mapping->GetMapping()),
+            mapping->GetSize());
+        latch.Signal();
+      });
+  latch.Wait();
+  ASSERT_EQ(read_contents, contents);
+
+  bool read_missing_file = true;
+  fml::ReadFileAsync(read_thread.GetTaskRunner(),
+                     fml::paths::JoinPaths({dir.path(), "missing"}),
+                     completion_task_runner,
+                     [&](std::unique_ptr<fml::Mapping> mapping) {
+                       read_missing_file = mapping != nullptr;
+                       latch.Signal();
+                     });
+  latch.Wait();
+  ASSERT_FALSE(read_missing_file);
+
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "async_data"));
+}
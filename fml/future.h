@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_FUTURE_H_
+#define FLUTTER_FML_FUTURE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_runner.h"
+
+namespace fml {
+
+template <typename T>
+class Promise;
+
+namespace internal {
+
+template <typename T>
+class FutureState {
+ public:
+  using Callback = std::function<void(const T&)>;
+
+  void SetValue(T value) {
+    std::vector<Callback> callbacks;
+    {
+      std::scoped_lock lock(mutex_);
+      FML_CHECK(!value_.has_value()) << "The value of a promise was set twice.";
+      value_.emplace(std::move(value));
+      callbacks.swap(callbacks_);
+    }
+    ready_.notify_all();
+    for (const auto& callback : callbacks) {
+      callback(*value_);
+    }
+  }
+
+  bool IsReady() const {
+    std::scoped_lock lock(mutex_);
+    return value_.has_value();
+  }
+
+  const T& Wait() const {
+    std::unique_lock lock(mutex_);
+    ready_.wait(lock, [this]() { return value_.has_value(); });
+    return *value_;
+  }
+
+  // Runs |callback| on the thread that sets the value, or right away if the
+  // value is already set.
+  void AddCallback(Callback callback) {
+    {
+      std::scoped_lock lock(mutex_);
+      if (!value_.has_value()) {
+        callbacks_.emplace_back(std::move(callback));
+        return;
+      }
+    }
+    callback(*value_);
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  mutable std::condition_variable ready_;
+  std::optional<T> value_;
+  std::vector<Callback> callbacks_;
+};
+
+}  // namespace internal
+
+// The value a |Promise| will provide. Unlike |std::future|, a |Future| can be
+// copied and can schedule continuations on a |TaskRunner| instead of blocking a
+// thread until the value is available.
+//
+// The value is handed out by constant reference and is kept alive as long as
+// any copy of the future or of its promise, so it is best used with values
+// that are cheap to copy like smart pointers.
+template <typename T>
+class Future {
+ public:
+  Future() = default;
+
+  // Whether this future was obtained from a |Promise|.
+  bool IsValid() const { return state_ != nullptr; }
+
+  // Whether the value was set. Prefer |OnReady| or |Then| to polling.
+  bool IsReady() const { return state_->IsReady(); }
+
+  // Blocks the calling thread until the value is set. This must not be called
+  // on the thread that sets the value, or on a thread a continuation that
+  // sets the value is scheduled on.
+  const T& Wait() const { return state_->Wait(); }
+
+  // Posts |callback| to |task_runner| once the value is set. The callback
+  // runs right away if the value is set from a task on |task_runner|, or if it
+  // is already set and this is called on |task_runner|.
+  void OnReady(fml::RefPtr<fml::TaskRunner> task_runner,
+               std::function<void(const T&)> callback) const {
+    FML_DCHECK(task_runner);
+    state_->AddCallback([task_runner = std::move(task_runner),
+                         callback = std::move(callback)](const T& value) {
+      fml::TaskRunner::RunNowOrPostTask(
+          task_runner, [callback, value]() { callback(value); });
+    });
+  }
+
+  // Posts |continuation| to |task_runner| once the value is set, and returns a
+  // future of the value the continuation returns.
+  template <typename F, typename R = std::invoke_result_t<F, const T&>>
+  Future<R> Then(fml::RefPtr<fml::TaskRunner> task_runner,
+                 F continuation) const {
+    static_assert(!std::is_void_v<R>,
+                  "Use OnReady for continuations that return no value.");
+    Promise<R> promise;
+    OnReady(std::move(task_runner),
+            [promise, continuation = std::move(continuation)](
+                const T& value) mutable {
+              promise.SetValue(continuation(value));
+            });
+    return promise.GetFuture();
+  }
+
+ private:
+  friend class Promise<T>;
+
+  explicit Future(std::shared_ptr<internal::FutureState<T>> state)
+      : state_(std::move(state)) {}
+
+  std::shared_ptr<internal::FutureState<T>> state_;
+};
+
+// Provides the value of a |Future|. The value must be set exactly once. A
+// promise can be copied, e.g. into a task, all copies set the same value.
+template <typename T>
+class Promise {
+ public:
+  Promise() : state_(std::make_shared<internal::FutureState<T>>()) {}
+
+  Future<T> GetFuture() const { return Future<T>(state_); }
+
+  // Sets the value and schedules the continuations of the future.
+  void SetValue(T value) const { state_->SetValue(std::move(value)); }
+
+ private:
+  std::shared_ptr<internal::FutureState<T>> state_;
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_FUTURE_H_
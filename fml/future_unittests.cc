@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/future.h"
+
+#include <string>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(FutureTest, WaitReturnsTheValue) {
+  fml::Thread thread;
+  Promise<int> promise;
+  auto future = promise.GetFuture();
+  ASSERT_TRUE(future.IsValid());
+  ASSERT_FALSE(future.IsReady());
+  thread.GetTaskRunner()->PostTask([promise]() { promise.SetValue(42); });
+  ASSERT_EQ(future.Wait(), 42);
+  ASSERT_TRUE(future.IsReady());
+}
+
+TEST(FutureTest, DefaultFutureIsInvalid) {
+  Future<int> future;
+  ASSERT_FALSE(future.IsValid());
+}
+
+TEST(FutureTest, OnReadyRunsOnTheTaskRunner) {
+  fml::Thread producer;
+  fml::Thread consumer;
+  Promise<std::string> promise;
+  fml::AutoResetWaitableEvent latch;
+  std::string received;
+  bool ran_on_consumer = false;
+  auto consumer_runner = consumer.GetTaskRunner();
+  promise.GetFuture().OnReady(consumer_runner, [&](const std::string& value) {
+    received = value;
+    ran_on_consumer = consumer_runner->RunsTasksOnCurrentThread();
+    latch.Signal();
+  });
+  producer.GetTaskRunner()->PostTask(
+      [promise]() { promise.SetValue("ready"); });
+  latch.Wait();
+  ASSERT_EQ(received, "ready");
+  ASSERT_TRUE(ran_on_consumer);
+}
+
+TEST(FutureTest, OnReadyAfterTheValueIsSetStillRuns) {
+  fml::Thread consumer;
+  Promise<int> promise;
+  promise.SetValue(7);
+  fml::AutoResetWaitableEvent latch;
+  int received = 0;
+  promise.GetFuture().OnReady(consumer.GetTaskRunner(), [&](const int& value) {
+    received = value;
+    latch.Signal();
+  });
+  latch.Wait();
+  ASSERT_EQ(received, 7);
+}
+
+TEST(FutureTest, ThenChainsContinuationsAcrossTaskRunners) {
+  fml::Thread first;
+  fml::Thread second;
+  Promise<int> promise;
+  auto doubled = promise.GetFuture().Then(
+      first.GetTaskRunner(), [](const int& value) { return value * 2; });
+  auto described = doubled.Then(second.GetTaskRunner(), [](const int& value) {
+    return std::to_string(value);
+  });
+  promise.SetValue(21);
+  ASSERT_EQ(described.Wait(), "42");
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/histogram.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace fml {
+
+Histogram::Histogram() {
+  Reset();
+}
+
+Histogram::~Histogram() = default;
+
+size_t Histogram::BucketForValue(uint64_t value) {
+  if (value < kLinearBuckets) {
+    return value;
+  }
+  value = std::min<uint64_t>(value, std::numeric_limits<uint32_t>::max());
+  // Shift the value until it fits in the sub-buckets. The number of shifts
+  // identifies the power of two and what is left the sub-bucket.
+  size_t shift = 0;
+  while (value >= 2 * kSubBuckets) {
+    value >>= 1;
+    shift++;
+  }
+  return kLinearBuckets + (shift - 1) * kSubBuckets + (value - kSubBuckets);
+}
+
+uint64_t Histogram::BucketUpperBound(size_t bucket) {
+  if (bucket < kLinearBuckets) {
+    return bucket;
+  }
+  const size_t shift = (bucket - kLinearBuckets) / kSubBuckets + 1;
+  const uint64_t lower = (kSubBuckets + (bucket - kLinearBuckets) % kSubBuckets)
+                         << shift;
+  return lower + (uint64_t{1} << shift) - 1;
+}
+
+void Histogram::Record(int64_t value) {
+  const uint64_t sample = value < 0 ? 0 : static_cast<uint64_t>(value);
+  buckets_[BucketForValue(sample)].fetch_add(1, std::memory_order_relaxed);
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (sample > max &&
+         !max_.compare_exchange_weak(max, sample, std::memory_order_relaxed)) {
+  }
+}
+
+Histogram::Summary Histogram::Summarize() const {
+  std::array<uint64_t, kBucketCount> counts;
+  Summary summary;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    summary.count += counts[i];
+  }
+  summary.max = max_.load(std::memory_order_relaxed);
+  if (summary.count == 0) {
+    return summary;
+  }
+
+  auto percentile = [&](uint64_t percent) -> uint64_t {
+    // The rank of the percentile, rounded up so that it is at least 1.
+    const uint64_t rank = (summary.count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+      seen += counts[i];
+      if (seen >= rank) {
+        return std::min(BucketUpperBound(i), summary.max);
+      }
+    }
+    return summary.max;
+  };
+
+  summary.p50 = percentile(50);
+  summary.p90 = percentile(90);
+  summary.p99 = percentile(99);
+  return summary;
+}
+
+void Histogram::Reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  max_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace fml
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_HISTOGRAM_H_
+#define FLUTTER_FML_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+/// A histogram of non-negative values that is cheap to record into and can be
+/// read from any thread.
+///
+/// Values below |kLinearBuckets| are counted exactly. Larger values are
+/// counted in |kSubBuckets| buckets per power of two, so a reported
+/// percentile is within 1/|kSubBuckets| of the recorded value. Values that do
+/// not fit in 32 bits are counted in the last bucket.
+class Histogram {
+ public:
+  struct Summary {
+    uint64_t count = 0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t max = 0;
+  };
+
+  Histogram();
+
+  ~Histogram();
+
+  void Record(int64_t value);
+
+  /// Computes the percentiles of all the values recorded so far. Each
+  /// percentile is reported as the largest value of its bucket, but never
+  /// more than the largest recorded value.
+  Summary Summarize() const;
+
+  void Reset();
+
+ private:
+  static constexpr size_t kLinearBuckets = 16;
+  static constexpr size_t kSubBuckets = 8;
+  static constexpr size_t kBucketCount = kLinearBuckets + 28 * kSubBuckets;
+
+  static size_t BucketForValue(uint64_t value);
+
+  static uint64_t BucketUpperBound(size_t bucket);
+
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+  std::atomic<uint64_t> max_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Histogram);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_HISTOGRAM_H_
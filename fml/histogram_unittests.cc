@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/histogram.h"
+
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace testing {
+
+TEST(HistogramTest, EmptyHistogramHasNoCount) {
+  Histogram histogram;
+  auto summary = histogram.Summarize();
+  ASSERT_EQ(summary.count, 0u);
+  ASSERT_EQ(summary.p50, 0u);
+  ASSERT_EQ(summary.p99, 0u);
+  ASSERT_EQ(summary.max, 0u);
+}
+
+TEST(HistogramTest, SmallValuesAreExact) {
+  Histogram histogram;
+  for (int i = 0; i < 10; i++) {
+    histogram.Record(i);
+  }
+  auto summary = histogram.Summarize();
+  ASSERT_EQ(summary.count, 10u);
+  ASSERT_EQ(summary.p50, 4u);
+  ASSERT_EQ(summary.p90, 8u);
+  ASSERT_EQ(summary.p99, 9u);
+  ASSERT_EQ(summary.max, 9u);
+}
+
+TEST(HistogramTest, PercentilesAreWithinBucketPrecision) {
+  Histogram histogram;
+  for (int i = 1; i <= 1000; i++) {
+    histogram.Record(i);
+  }
+  auto summary = histogram.Summarize();
+  ASSERT_EQ(summary.count, 1000u);
+  ASSERT_EQ(summary.max, 1000u);
+  ASSERT_GE(summary.p50, 500u);
+  ASSERT_LE(summary.p50, 500u + 500u / 8);
+  ASSERT_GE(summary.p90, 900u);
+  ASSERT_LE(summary.p90, 900u + 900u / 8);
+  ASSERT_GE(summary.p99, 990u);
+  ASSERT_LE(summary.p99, 1000u);
+}
+
+TEST(HistogramTest, OutOfRangeValuesAreClamped) {
+  Histogram histogram;
+  histogram.Record(-1);
+  histogram.Record(int64_t{1} << 40);
+  auto summary = histogram.Summarize();
+  ASSERT_EQ(summary.count, 2u);
+  ASSERT_EQ(summary.p50, 0u);
+  ASSERT_EQ(summary.max, uint64_t{1} << 40);
+}
+
+}  // namespace testing
+}  // namespace fml
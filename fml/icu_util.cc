@@ -8,11 +8,14 @@
 #include <mutex>
 
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
+#include "third_party/icu/source/common/unicode/putil.h"
 #include "third_party/icu/source/common/unicode/udata.h"
+#include "third_party/icu/source/common/unicode/ures.h"
 
 namespace fml {
 namespace icu {
@@ -20,7 +23,8 @@ namespace icu {
 class ICUContext {
  public:
   explicit ICUContext(const std::string& icu_data_path) : valid_(false) {
-    valid_ = SetupMapping(icu_data_path) && SetupICU();
+    valid_ = SetupDataDirectory(icu_data_path) ||
+             (SetupMapping(icu_data_path) && SetupICU());
   }
 
   explicit ICUContext(std::unique_ptr<Mapping> mapping)
@@ -30,6 +34,34 @@ class ICUContext {
 
   ~ICUContext() = default;
 
+  // Points ICU at a directory of individual data items instead of a single
+  // common data file. ICU then only opens and maps the items, such as the
+  // resource bundles of a locale, when they are first used.
+  bool SetupDataDirectory(const std::string& icu_data_path) {
+    std::string directory_path = icu_data_path;
+    if (!fml::IsDirectory(fml::OpenDirectory(directory_path.c_str(), false,
+                                             fml::FilePermission::kRead))) {
+      auto directory = fml::paths::GetExecutableDirectoryPath();
+      if (!directory.first) {
+        return false;
+      }
+      directory_path = paths::JoinPaths({directory.second, icu_data_path});
+      if (!fml::IsDirectory(fml::OpenDirectory(directory_path.c_str(), false,
+                                               fml::FilePermission::kRead))) {
+        return false;
+      }
+    }
+
+    u_setDataDirectory(directory_path.c_str());
+
+    // Every locale falls back to the root bundle, so the directory is only
+    // usable if it has one.
+    UErrorCode err_code = U_ZERO_ERROR;
+    UResourceBundle* root = ures_open(nullptr, "root", &err_code);
+    ures_close(root);
+    return U_SUCCESS(err_code);
+  }
+
   bool SetupMapping(const std::string& icu_data_path) {
     // Check if the path exists and it readable directly.
     auto fd =
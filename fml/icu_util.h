@@ -13,6 +13,13 @@
 namespace fml {
 namespace icu {
 
+// Initializes ICU with the data at |icu_data_path|, which is resolved
+// relative to the executable if it does not exist as is. The path is either a
+// common data file, such as `icudtl.dat`, which is mapped as a whole, or a
+// directory of individual data items, which ICU opens when they are first
+// used. The directory has the layout ICU's data build tool produces in its
+// "files" packaging mode, and may only contain the items for the locales the
+// application needs.
 void InitializeICU(const std::string& icu_data_path = "");
 
 void InitializeICUFromMapping(std::unique_ptr<Mapping> mapping);
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/idle_task_queue.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+IdleTaskQueue::IdleTaskQueue(fml::RefPtr<fml::TaskRunner> task_runner)
+    : task_runner_(std::move(task_runner)),
+      idle_deadline_(fml::TimePoint::Max()),
+      next_run_time_(fml::TimePoint::Max()) {
+  FML_DCHECK(task_runner_);
+}
+
+IdleTaskQueue::~IdleTaskQueue() = default;
+
+void IdleTaskQueue::PostTask(const fml::closure& task,
+                             fml::TimeDelta estimated_duration,
+                             fml::TimeDelta max_delay) {
+  FML_DCHECK(task);
+  const auto now = fml::TimePoint::Now();
+  std::scoped_lock lock(mutex_);
+  tasks_.push_back({task, estimated_duration, now + max_delay});
+  const Task& front = tasks_.front();
+  ScheduleRunLocked(FitsBudgetLocked(front, now) ? now : front.deadline,
+                    front.deadline);
+}
+
+void IdleTaskQueue::SetIdleDeadline(fml::TimePoint deadline) {
+  const auto now = fml::TimePoint::Now();
+  std::scoped_lock lock(mutex_);
+  idle_deadline_ = deadline;
+  if (!tasks_.empty() && FitsBudgetLocked(tasks_.front(), now)) {
+    ScheduleRunLocked(now, tasks_.front().deadline);
+  }
+}
+
+fml::TimePoint IdleTaskQueue::GetIdleDeadline() const {
+  std::scoped_lock lock(mutex_);
+  return idle_deadline_;
+}
+
+size_t IdleTaskQueue::GetPendingTaskCount() const {
+  std::scoped_lock lock(mutex_);
+  return tasks_.size();
+}
+
+bool IdleTaskQueue::FitsBudgetLocked(const Task& task,
+                                     fml::TimePoint now) const {
+  if (idle_deadline_ == fml::TimePoint::Max()) {
+    return true;
+  }
+  return now + task.estimated_duration <= idle_deadline_;
+}
+
+void IdleTaskQueue::ScheduleRunLocked(fml::TimePoint target_time,
+                                      fml::TimePoint deadline) {
+  if (target_time >= next_run_time_) {
+    return;
+  }
+  next_run_time_ = target_time;
+  // A run that is still starved by other work once the first task has waited
+  // for its maximum delay is promoted out of the idle lane.
+  task_runner_->PostTaskForTimeWithPriority(
+      [strong = fml::Ref(this)]() { strong->RunIdleTasks(); }, target_time,
+      fml::TaskPriority::kIdle, std::max(target_time, deadline));
+}
+
+void IdleTaskQueue::RunIdleTasks() {
+  TRACE_EVENT0("flutter", "IdleTaskQueue::RunIdleTasks");
+  {
+    std::scoped_lock lock(mutex_);
+    next_run_time_ = fml::TimePoint::Max();
+  }
+
+  while (true) {
+    fml::closure task;
+    {
+      std::scoped_lock lock(mutex_);
+      if (tasks_.empty()) {
+        return;
+      }
+      const auto now = fml::TimePoint::Now();
+      const Task& front = tasks_.front();
+      if (now < front.deadline && !FitsBudgetLocked(front, now)) {
+        // Wait for the next idle period, or for the task to become overdue.
+        ScheduleRunLocked(front.deadline, front.deadline);
+        return;
+      }
+      task = std::move(tasks_.front().task);
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace fml
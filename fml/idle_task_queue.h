@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_IDLE_TASK_QUEUE_H_
+#define FLUTTER_FML_IDLE_TASK_QUEUE_H_
+
+#include <deque>
+#include <mutex>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+
+// A queue of maintenance work for a task runner that is only run while the
+// current idle period leaves enough budget for it.
+//
+// The idle period is driven by the owner through |SetIdleDeadline|, usually
+// from the animator's frame timing: the period ends when a frame begins and
+// lasts until the next frame deadline once the frame has been produced. Tasks
+// that do not fit in the remaining budget are deferred, but never for longer
+// than the maximum delay they were posted with.
+//
+// Tasks run in the order they were posted, in the |TaskPriority::kIdle| lane
+// of the task runner. This class is thread-safe.
+class IdleTaskQueue : public fml::RefCountedThreadSafe<IdleTaskQueue> {
+ public:
+  // Posts |task| to run once the idle period has at least
+  // |estimated_duration| left, or after |max_delay| regardless of the budget.
+  void PostTask(const fml::closure& task,
+                fml::TimeDelta estimated_duration,
+                fml::TimeDelta max_delay);
+
+  // Sets the time at which the current idle period ends. Pass |Now()| when a
+  // frame begins and |TimePoint::Max()| when no frames are being produced.
+  void SetIdleDeadline(fml::TimePoint deadline);
+
+  fml::TimePoint GetIdleDeadline() const;
+
+  size_t GetPendingTaskCount() const;
+
+ private:
+  struct Task {
+    fml::closure task;
+    fml::TimeDelta estimated_duration;
+    // The time after which the task runs even if it does not fit the budget.
+    fml::TimePoint deadline;
+  };
+
+  const fml::RefPtr<fml::TaskRunner> task_runner_;
+  mutable std::mutex mutex_;
+  std::deque<Task> tasks_;
+  fml::TimePoint idle_deadline_;
+  // The earliest time a pending call to |RunIdleTasks| is posted for.
+  fml::TimePoint next_run_time_;
+
+  explicit IdleTaskQueue(fml::RefPtr<fml::TaskRunner> task_runner);
+
+  ~IdleTaskQueue();
+
+  bool FitsBudgetLocked(const Task& task, fml::TimePoint now) const;
+
+  void ScheduleRunLocked(fml::TimePoint target_time, fml::TimePoint deadline);
+
+  void RunIdleTasks();
+
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(IdleTaskQueue);
+  FML_FRIEND_MAKE_REF_COUNTED(IdleTaskQueue);
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskQueue);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_IDLE_TASK_QUEUE_H_
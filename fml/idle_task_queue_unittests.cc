@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/idle_task_queue.h"
+
+#include <atomic>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(IdleTaskQueueTest, RunsTasksWhenNoDeadlineIsSet) {
+  fml::Thread thread;
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>(thread.GetTaskRunner());
+  fml::AutoResetWaitableEvent latch;
+  queue->PostTask([&latch]() { latch.Signal(); },
+                  fml::TimeDelta::FromMilliseconds(1),
+                  fml::TimeDelta::FromSeconds(60));
+  latch.Wait();
+  ASSERT_EQ(queue->GetPendingTaskCount(), 0u);
+}
+
+TEST(IdleTaskQueueTest, DefersTasksThatDoNotFitTheIdleBudget) {
+  fml::Thread thread;
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>(thread.GetTaskRunner());
+  queue->SetIdleDeadline(fml::TimePoint::Now());
+
+  std::atomic_bool ran = false;
+  fml::AutoResetWaitableEvent latch;
+  queue->PostTask(
+      [&ran, &latch]() {
+        ran = true;
+        latch.Signal();
+      },
+      fml::TimeDelta::FromMilliseconds(1), fml::TimeDelta::FromSeconds(60));
+
+  fml::AutoResetWaitableEvent flushed;
+  thread.GetTaskRunner()->PostDelayedTask([&flushed]() { flushed.Signal(); },
+                                          fml::TimeDelta::FromMilliseconds(20));
+  flushed.Wait();
+  ASSERT_FALSE(ran);
+  ASSERT_EQ(queue->GetPendingTaskCount(), 1u);
+
+  queue->SetIdleDeadline(fml::TimePoint::Now() +
+                         fml::TimeDelta::FromSeconds(60));
+  latch.Wait();
+  ASSERT_TRUE(ran);
+}
+
+TEST(IdleTaskQueueTest, RunsDeferredTasksOnceTheirMaxDelayExpires) {
+  fml::Thread thread;
+  auto queue = fml::MakeRefCounted<IdleTaskQueue>(thread.GetTaskRunner());
+  queue->SetIdleDeadline(fml::TimePoint::Now());
+
+  fml::AutoResetWaitableEvent latch;
+  const auto posted = fml::TimePoint::Now();
+  queue->PostTask([&latch]() { latch.Signal(); },
+                  fml::TimeDelta::FromMilliseconds(1),
+                  fml::TimeDelta::FromMilliseconds(10));
+  latch.Wait();
+  ASSERT_GE(fml::TimePoint::Now() - posted,
+            fml::TimeDelta::FromMilliseconds(10));
+}
+
+}  // namespace testing
+}  // namespace fml
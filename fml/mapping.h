@@ -69,6 +69,16 @@ class FileMapping final : public Mapping {
 
   bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Advises the kernel that the whole mapping will be accessed
+  ///             soon so that it can start reading the file into the page
+  ///             cache in the background.
+  ///
+  /// @return     Whether the advice was given. This is a no-op on platforms
+  ///             without such hints.
+  ///
+  bool WillNeed() const;
+
  private:
   bool valid_ = false;
   size_t size_ = 0;
@@ -145,6 +155,26 @@ class SymbolMapping final : public Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(SymbolMapping);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Faults in the pages backing the `size` bytes at `data`, reading
+///             them from storage if needed, so that later accesses do not stall
+///             on page faults.
+///
+/// @return     Whether the pages were faulted in. This is a no-op on platforms
+///             without such support.
+///
+bool PrefaultMemory(const uint8_t* data, size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Asks the kernel to back the `size` bytes at `data` with
+///             transparent huge pages, which reduces the page faults and TLB
+///             misses when accessing them.
+///
+/// @return     Whether the advice was given. This is a no-op on platforms
+///             without transparent huge pages.
+///
+bool AdviseHugePages(const uint8_t* data, size_t size);
+
 }  // namespace fml
 
 #endif  // FLUTTER_FML_MAPPING_H_
@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/mapping.h"
+
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(MappingTest, CanPrefaultFileMappings) {
+  fml::ScopedTemporaryDirectory dir;
+  DataMapping data(std::vector<uint8_t>(64 * 1024, 0x42));
+  ASSERT_TRUE(WriteAtomically(dir.fd(), "instructions", data));
+
+  auto mapping = FileMapping::CreateReadOnly(
+      paths::JoinPaths({dir.path(), "instructions"}));
+  ASSERT_TRUE(mapping);
+  ASSERT_EQ(mapping->GetSize(), data.GetSize());
+
+#if OS_WIN
+  ASSERT_FALSE(PrefaultMemory(mapping->GetMapping(), mapping->GetSize()));
+#else   // OS_WIN
+  // Neither end of the range needs to be page aligned.
+  ASSERT_TRUE(PrefaultMemory(mapping->GetMapping() + 1, 5000));
+  ASSERT_TRUE(PrefaultMemory(mapping->GetMapping(), mapping->GetSize()));
+#endif  // OS_WIN
+  ASSERT_EQ(mapping->GetMapping()[mapping->GetSize() - 1], 0x42);
+}
+
+TEST(MappingTest, PrefaultingNothingFails) {
+  ASSERT_FALSE(PrefaultMemory(nullptr, 0));
+  ASSERT_FALSE(AdviseHugePages(nullptr, 0));
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,183 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_THREAD_SAFE_WEAK_PTR_H_
+#define FLUTTER_FML_MEMORY_THREAD_SAFE_WEAK_PTR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/memory/ref_ptr.h"
+
+namespace fml {
+
+namespace internal {
+
+// The state shared by a |ThreadSafeWeakPtrFactory| and its weak pointers: the
+// number of pins currently held and whether the factory was destroyed.
+class ThreadSafeWeakPtrFlag
+    : public fml::RefCountedThreadSafe<ThreadSafeWeakPtrFlag> {
+ public:
+  ThreadSafeWeakPtrFlag() = default;
+
+  ~ThreadSafeWeakPtrFlag() { FML_DCHECK(state_.load() == kInvalidated); }
+
+  // Takes a pin unless the flag was invalidated.
+  bool TryPin() {
+    uint32_t state = state_.load(std::memory_order_relaxed);
+    do {
+      if (state & kInvalidated) {
+        return false;
+      }
+    } while (!state_.compare_exchange_weak(state, state + 1,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed));
+    return true;
+  }
+
+  void Unpin() { state_.fetch_sub(1, std::memory_order_release); }
+
+  // Prevents new pins and waits for the ones held to be released.
+  void Invalidate() {
+    const uint32_t previous_state =
+        state_.fetch_or(kInvalidated, std::memory_order_acquire);
+    FML_DCHECK(!(previous_state & kInvalidated));
+    uint32_t state = previous_state | kInvalidated;
+    while (state != kInvalidated) {
+      std::this_thread::yield();
+      state = state_.load(std::memory_order_acquire);
+    }
+  }
+
+ private:
+  static constexpr uint32_t kInvalidated = 1u << 31;
+
+  std::atomic<uint32_t> state_ = {0};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadSafeWeakPtrFlag);
+};
+
+}  // namespace internal
+
+template <typename T>
+class ThreadSafeWeakPtrFactory;
+
+// A weak pointer that, unlike |WeakPtr|, may be dereferenced on any thread.
+//
+// The object is accessed by pinning it with |Pin|, which is a couple of atomic
+// operations and never waits. The object is kept alive for as long as the pin
+// is held: destroying the originating |ThreadSafeWeakPtrFactory| waits for
+// the pins to be released. Pins should hence only be held for short,
+// read-only accesses to members that are themselves safe to use from the
+// calling thread (e.g. atomics), for example to query statistics of an object
+// owned by another thread without posting a task to it. The thread that
+// destroys the object must not hold a pin to it.
+template <typename T>
+class ThreadSafeWeakPtr {
+ public:
+  // Keeps the object alive until it is destroyed.
+  class Pinned {
+   public:
+    Pinned(Pinned&& other)
+        : ptr_(std::exchange(other.ptr_, nullptr)),
+          flag_(std::move(other.flag_)) {}
+
+    ~Pinned() {
+      if (ptr_) {
+        flag_->Unpin();
+      }
+    }
+
+    explicit operator bool() const { return ptr_ != nullptr; }
+
+    T* get() const { return ptr_; }
+
+    T& operator*() const {
+      FML_DCHECK(ptr_);
+      return *ptr_;
+    }
+
+    T* operator->() const {
+      FML_DCHECK(ptr_);
+      return ptr_;
+    }
+
+   private:
+    friend class ThreadSafeWeakPtr<T>;
+
+    Pinned(T* ptr, fml::RefPtr<internal::ThreadSafeWeakPtrFlag> flag)
+        : ptr_(ptr), flag_(std::move(flag)) {}
+
+    T* ptr_;
+    fml::RefPtr<internal::ThreadSafeWeakPtrFlag> flag_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Pinned);
+  };
+
+  ThreadSafeWeakPtr() : ptr_(nullptr) {}
+
+  ThreadSafeWeakPtr(const ThreadSafeWeakPtr<T>& r) = default;
+
+  ThreadSafeWeakPtr(ThreadSafeWeakPtr<T>&& r) = default;
+
+  ThreadSafeWeakPtr<T>& operator=(const ThreadSafeWeakPtr<T>& r) = default;
+
+  ThreadSafeWeakPtr<T>& operator=(ThreadSafeWeakPtr<T>&& r) = default;
+
+  void reset() {
+    ptr_ = nullptr;
+    flag_ = nullptr;
+  }
+
+  // Returns a pin that evaluates to false if the object was destroyed.
+  Pinned Pin() const {
+    if (flag_ && flag_->TryPin()) {
+      return Pinned(ptr_, flag_);
+    }
+    return Pinned(nullptr, nullptr);
+  }
+
+ private:
+  friend class ThreadSafeWeakPtrFactory<T>;
+
+  ThreadSafeWeakPtr(T* ptr, fml::RefPtr<internal::ThreadSafeWeakPtrFlag> flag)
+      : ptr_(ptr), flag_(std::move(flag)) {}
+
+  T* ptr_;
+  fml::RefPtr<internal::ThreadSafeWeakPtrFlag> flag_;
+};
+
+// Produces |ThreadSafeWeakPtr<T>|s. Like |WeakPtrFactory|, this should be the
+// last member of |T| so that the pointers are invalidated, and the pins
+// released, before the other members are destroyed.
+template <typename T>
+class ThreadSafeWeakPtrFactory {
+ public:
+  explicit ThreadSafeWeakPtrFactory(T* ptr)
+      : ptr_(ptr),
+        flag_(fml::MakeRefCounted<internal::ThreadSafeWeakPtrFlag>()) {
+    FML_DCHECK(ptr_);
+  }
+
+  ~ThreadSafeWeakPtrFactory() { flag_->Invalidate(); }
+
+  ThreadSafeWeakPtr<T> GetWeakPtr() const {
+    return ThreadSafeWeakPtr<T>(ptr_, flag_);
+  }
+
+ private:
+  T* const ptr_;
+  fml::RefPtr<internal::ThreadSafeWeakPtrFlag> flag_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadSafeWeakPtrFactory);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_THREAD_SAFE_WEAK_PTR_H_
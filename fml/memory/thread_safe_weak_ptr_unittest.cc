@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/thread_safe_weak_ptr.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+TEST(ThreadSafeWeakPtrTest, Basic) {
+  int data = 0;
+  ThreadSafeWeakPtrFactory<int> factory(&data);
+  ThreadSafeWeakPtr<int> ptr = factory.GetWeakPtr();
+  auto pinned = ptr.Pin();
+  ASSERT_TRUE(pinned);
+  EXPECT_EQ(&data, pinned.get());
+}
+
+TEST(ThreadSafeWeakPtrTest, DefaultAndResetPointersAreEmpty) {
+  ThreadSafeWeakPtr<int> ptr;
+  EXPECT_FALSE(ptr.Pin());
+
+  int data = 0;
+  ThreadSafeWeakPtrFactory<int> factory(&data);
+  ptr = factory.GetWeakPtr();
+  EXPECT_TRUE(ptr.Pin());
+  ptr.reset();
+  EXPECT_FALSE(ptr.Pin());
+}
+
+TEST(ThreadSafeWeakPtrTest, InvalidatedWhenFactoryIsDestroyed) {
+  int data = 0;
+  ThreadSafeWeakPtr<int> ptr;
+  {
+    ThreadSafeWeakPtrFactory<int> factory(&data);
+    ptr = factory.GetWeakPtr();
+    EXPECT_TRUE(ptr.Pin());
+  }
+  EXPECT_FALSE(ptr.Pin());
+}
+
+TEST(ThreadSafeWeakPtrTest, FactoryDestructionWaitsForPins) {
+  auto data = std::make_unique<int>(42);
+  auto factory = std::make_unique<ThreadSafeWeakPtrFactory<int>>(data.get());
+  auto ptr = factory->GetWeakPtr();
+
+  fml::AutoResetWaitableEvent pinned;
+  fml::AutoResetWaitableEvent release;
+  std::atomic_bool released = false;
+  std::thread reader([&] {
+    auto pin = ptr.Pin();
+    ASSERT_TRUE(pin);
+    pinned.Signal();
+    release.Wait();
+    EXPECT_EQ(*pin, 42);
+    released = true;
+  });
+
+  pinned.Wait();
+  std::thread destroyer([&] {
+    factory.reset();
+    EXPECT_TRUE(released);
+    data.reset();
+  });
+  release.Signal();
+  destroyer.join();
+  reader.join();
+  EXPECT_FALSE(ptr.Pin());
+}
+
+TEST(ThreadSafeWeakPtrTest, PinsFromManyThreads) {
+  int data = 0;
+  ThreadSafeWeakPtrFactory<int> factory(&data);
+  auto ptr = factory.GetWeakPtr();
+  std::atomic_int pins = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([ptr, &pins] {
+      for (int j = 0; j < 1000; j++) {
+        if (auto pin = ptr.Pin()) {
+          pins++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pins, 4000);
+}
+
+}  // namespace
+}  // namespace fml
@@ -69,6 +69,20 @@ void MessageLoop::RemoveTaskObserver(intptr_t key) {
   loop_->RemoveTaskObserver(key);
 }
 
+bool MessageLoop::WatchFileDescriptor(int fd,
+                                      uint32_t events,
+                                      FileDescriptorCallback callback) {
+  FML_DCHECK(tls_message_loop.get() == this)
+      << "File descriptors must be watched from the thread of the loop.";
+  return loop_->WatchFileDescriptor(fd, events, std::move(callback));
+}
+
+bool MessageLoop::UnwatchFileDescriptor(int fd) {
+  FML_DCHECK(tls_message_loop.get() == this)
+      << "File descriptors must be unwatched from the thread of the loop.";
+  return loop_->UnwatchFileDescriptor(fd);
+}
+
 void MessageLoop::RunExpiredTasksNow() {
   loop_->RunExpiredTasksNow();
 }
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_H_
 #define FLUTTER_FML_MESSAGE_LOOP_H_
 
+#include <cstdint>
+#include <functional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -30,6 +33,35 @@ class MessageLoop {
 
   fml::RefPtr<fml::TaskRunner> GetTaskRunner() const;
 
+  // The readiness of a watched file descriptor, as a bitmask.
+  enum FileDescriptorEvent : uint32_t {
+    kReadable = 1 << 0,
+    kWritable = 1 << 1,
+    // The descriptor was closed by the peer or is in an error state. Always
+    // reported, whether watched for or not.
+    kError = 1 << 2,
+  };
+
+  using FileDescriptorCallback = std::function<void(int fd, uint32_t events)>;
+
+  // Invokes |callback| on the thread of this loop whenever |fd| is ready for
+  // one of the |events|, so that descriptors (e.g. sockets) can be serviced
+  // without dedicating a thread to them. The callback keeps being invoked for
+  // as long as the descriptor stays ready, it must consume the data or stop
+  // watching. The descriptor is not owned by the loop and must be unwatched
+  // before it is closed.
+  //
+  // Must be called on the thread of this loop. Returns false if the platform
+  // loop does not support watching descriptors (only Linux does) or if |fd| is
+  // already watched.
+  bool WatchFileDescriptor(int fd,
+                           uint32_t events,
+                           FileDescriptorCallback callback);
+
+  // Stops invoking the callback of |fd|, including for the events already
+  // collected. Must be called on the thread of this loop.
+  bool UnwatchFileDescriptor(int fd);
+
   // Exposed for the embedder shell which allows clients to poll for events
   // instead of dedicating a thread to the message loop.
   void RunExpiredTasksNow();
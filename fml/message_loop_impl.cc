@@ -55,7 +55,9 @@ MessageLoopImpl::~MessageLoopImpl() {
 }
 
 void MessageLoopImpl::PostTask(const fml::closure& task,
-                               fml::TimePoint target_time) {
+                               fml::TimePoint target_time,
+                               TaskPriority priority,
+                               fml::TimePoint deadline) {
   FML_DCHECK(task != nullptr);
   FML_DCHECK(task != nullptr);
   if (terminated_) {
@@ -63,7 +65,7 @@ void MessageLoopImpl::PostTask(const fml::closure& task,
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, task, target_time, priority, deadline);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
@@ -86,6 +88,17 @@ void MessageLoopImpl::RemoveTaskObserver(intptr_t key) {
   task_queue_->RemoveTaskObserver(queue_id_, key);
 }
 
+bool MessageLoopImpl::WatchFileDescriptor(
+    int fd,
+    uint32_t events,
+    MessageLoop::FileDescriptorCallback callback) {
+  return false;
+}
+
+bool MessageLoopImpl::UnwatchFileDescriptor(int fd) {
+  return false;
+}
+
 void MessageLoopImpl::DoRun() {
   if (terminated_) {
     // Message loops may be run only once.
@@ -123,11 +136,23 @@ void MessageLoopImpl::FlushTasks(FlushType type) {
   const auto now = fml::TimePoint::Now();
   fml::closure invocation;
   do {
-    invocation = task_queue_->GetNextTaskToRun(queue_id_, now);
+    TaskSample sample;
+    invocation = task_queue_->GetNextTaskToRun(queue_id_, now, &sample);
     if (!invocation) {
       break;
     }
-    invocation();
+    if (sample.sampled) {
+      const auto start = fml::TimePoint::Now();
+      invocation();
+      const auto run_time = fml::TimePoint::Now() - start;
+      task_queue_->RecordTaskRunTime(queue_id_, run_time);
+      FML_TRACE_COUNTER("fml", "TaskQueue", static_cast<int>(queue_id_),
+                        "LatencyMicros", sample.queue_latency.ToMicroseconds(),
+                        "RunMicros", run_time.ToMicroseconds(), "Depth",
+                        sample.queue_depth);
+    } else {
+      invocation();
+    }
     std::vector<fml::closure> observers =
         task_queue_->GetObserversToNotify(queue_id_);
     for (const auto& observer : observers) {
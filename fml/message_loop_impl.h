@@ -34,12 +34,22 @@ class MessageLoopImpl : public Wakeable,
 
   virtual void Terminate() = 0;
 
-  void PostTask(const fml::closure& task, fml::TimePoint target_time);
+  void PostTask(const fml::closure& task,
+                fml::TimePoint target_time,
+                TaskPriority priority = TaskPriority::kNormal,
+                fml::TimePoint deadline = fml::TimePoint::Max());
 
   void AddTaskObserver(intptr_t key, const fml::closure& callback);
 
   void RemoveTaskObserver(intptr_t key);
 
+  // See |MessageLoop::WatchFileDescriptor|. Unsupported by default.
+  virtual bool WatchFileDescriptor(int fd,
+                                   uint32_t events,
+                                   MessageLoop::FileDescriptorCallback callback);
+
+  virtual bool UnwatchFileDescriptor(int fd);
+
   void DoRun();
 
   void DoTerminate();
@@ -6,6 +6,7 @@
 
 #include "flutter/fml/message_loop_task_queues.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "flutter/fml/make_copyable.h"
@@ -19,11 +20,170 @@ const size_t TaskQueueId::kUnmerged = ULONG_MAX;
 
 fml::RefPtr<MessageLoopTaskQueues> MessageLoopTaskQueues::instance_;
 
+namespace {
+
+int64_t ToWakeTime(fml::TimePoint time) {
+  return time.ToEpochDelta().ToNanoseconds();
+}
+
+fml::TimePoint FromWakeTime(int64_t wake_time) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(wake_time));
+}
+
+// Delays the wake up for a task to the end of the window of |slack| that its
+// target time falls in, so that the tasks due within a window share a wake up.
+fml::TimePoint CoalesceWakeTime(fml::TimeDelta slack,
+                                fml::TimePoint target_time,
+                                TaskPriority priority,
+                                fml::TimePoint deadline) {
+  if (slack <= fml::TimeDelta::Zero() || priority == TaskPriority::kCritical ||
+      target_time == fml::TimePoint::Max() ||
+      target_time <= fml::TimePoint::Now()) {
+    return target_time;
+  }
+  const int64_t window = slack.ToNanoseconds();
+  const int64_t target = ToWakeTime(target_time);
+  const auto coalesced = FromWakeTime((target + window - 1) / window * window);
+  return std::max(target_time, std::min(coalesced, deadline));
+}
+
+// Locks the task heap of a queue and, if it owns another queue, the heap of
+// the subsumed queue. The owner is always locked first.
+class ScopedDelayedTasksLock {
+ public:
+  ScopedDelayedTasksLock(TaskQueueEntry& entry, TaskQueueEntry* subsumed)
+      : owner_lock_(entry.delayed_tasks_mutex) {
+    if (subsumed) {
+      subsumed_lock_ =
+          std::unique_lock<std::mutex>(subsumed->delayed_tasks_mutex);
+    }
+  }
+
+ private:
+  std::unique_lock<std::mutex> owner_lock_;
+  std::unique_lock<std::mutex> subsumed_lock_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedDelayedTasksLock);
+};
+
+}  // namespace
+
+TaskQueueStats::TaskQueueStats() : registered_count_(0) {}
+
+TaskQueueStats::~TaskQueueStats() = default;
+
+bool TaskQueueStats::ShouldSample() {
+  return registered_count_.fetch_add(1, std::memory_order_relaxed) %
+             kSampleInterval ==
+         0;
+}
+
+void TaskQueueStats::RecordQueueLatency(fml::TimeDelta latency) {
+  queue_latency_.Record(latency.ToMicroseconds());
+}
+
+void TaskQueueStats::RecordRunTime(fml::TimeDelta run_time) {
+  run_time_.Record(run_time.ToMicroseconds());
+}
+
+void TaskQueueStats::RecordQueueDepth(size_t depth) {
+  queue_depth_.Record(static_cast<int64_t>(depth));
+}
+
+TaskQueueStats::Summary TaskQueueStats::Summarize() const {
+  Summary summary;
+  summary.queue_latency = queue_latency_.Summarize();
+  summary.run_time = run_time_.Summarize();
+  summary.queue_depth = queue_depth_.Summarize();
+  return summary;
+}
+
+void TaskQueueStats::Reset() {
+  queue_latency_.Reset();
+  run_time_.Reset();
+  queue_depth_.Reset();
+}
+
 TaskQueueEntry::TaskQueueEntry()
-    : owner_of(_kUnmerged), subsumed_by(_kUnmerged) {
+    : next_wake_time(ToWakeTime(fml::TimePoint::Max())),
+      owner_of(_kUnmerged),
+      subsumed_by(_kUnmerged),
+      pending_tasks_(nullptr) {
   wakeable = NULL;
   task_observers = TaskObservers();
-  delayed_tasks = DelayedTaskQueue();
+}
+
+TaskQueueEntry::~TaskQueueEntry() {
+  PendingTask* pending = pending_tasks_.exchange(nullptr);
+  while (pending) {
+    PendingTask* next = pending->next;
+    delete pending;
+    pending = next;
+  }
+}
+
+void TaskQueueEntry::AddPendingTask(DelayedTask task) {
+  auto* pending = new PendingTask{
+      std::move(task), pending_tasks_.load(std::memory_order_relaxed)};
+  while (!pending_tasks_.compare_exchange_weak(pending->next, pending,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+  }
+}
+
+void TaskQueueEntry::CollectPendingTasks() {
+  // The whole stack is taken at once, so nodes are never popped while
+  // another thread may be pushing on top of them.
+  PendingTask* pending =
+      pending_tasks_.exchange(nullptr, std::memory_order_acquire);
+  while (pending) {
+    const auto lane = static_cast<size_t>(pending->task.GetPriority());
+    delayed_tasks[lane].push(std::move(pending->task));
+    PendingTask* next = pending->next;
+    delete pending;
+    pending = next;
+  }
+}
+
+bool TaskQueueEntry::HasUncollectedTasks() const {
+  return pending_tasks_.load(std::memory_order_acquire) != nullptr;
+}
+
+bool TaskQueueEntry::HasDelayedTasks() const {
+  for (const auto& lane : delayed_tasks) {
+    if (!lane.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t TaskQueueEntry::GetNumDelayedTasks() const {
+  size_t count = 0;
+  for (const auto& lane : delayed_tasks) {
+    count += lane.size();
+  }
+  return count;
+}
+
+void TaskQueueEntry::ClearDelayedTasks() {
+  for (auto& lane : delayed_tasks) {
+    lane = {};
+  }
+}
+
+fml::TimePoint TaskQueueEntry::LowerNextWakeTime(fml::TimePoint time) {
+  const int64_t wake_time = ToWakeTime(time);
+  int64_t current = next_wake_time.load();
+  while (wake_time < current &&
+         !next_wake_time.compare_exchange_weak(current, wake_time)) {
+  }
+  return FromWakeTime(std::min(current, wake_time));
+}
+
+void TaskQueueEntry::SetNextWakeTime(fml::TimePoint time) {
+  next_wake_time.store(ToWakeTime(time));
 }
 
 fml::RefPtr<MessageLoopTaskQueues> MessageLoopTaskQueues::GetInstance() {
@@ -34,8 +194,31 @@ fml::RefPtr<MessageLoopTaskQueues> MessageLoopTaskQueues::GetInstance() {
   return instance_;
 }
 
+// Acquires all the lock shards exclusively, always in the same order.
+class MessageLoopTaskQueues::ScopedExclusiveLock {
+ public:
+  explicit ScopedExclusiveLock(const MessageLoopTaskQueues& queues)
+      : queues_(queues) {
+    for (const auto& shard : queues_.lock_shards_) {
+      shard->Lock();
+    }
+  }
+
+  ~ScopedExclusiveLock() {
+    for (auto shard = queues_.lock_shards_.rbegin();
+         shard != queues_.lock_shards_.rend(); ++shard) {
+      (*shard)->Unlock();
+    }
+  }
+
+ private:
+  const MessageLoopTaskQueues& queues_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedExclusiveLock);
+};
+
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>();
@@ -43,12 +226,20 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {}
+    : task_queue_id_counter_(0), order_(0) {
+  for (auto& shard : lock_shards_) {
+    shard.reset(fml::SharedMutex::Create());
+  }
+}
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
+SharedMutex& MessageLoopTaskQueues::GetLockShard(TaskQueueId queue_id) const {
+  return *lock_shards_[static_cast<size_t>(queue_id) % kLockShardCount];
+}
+
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   TaskQueueId subsumed = queue_entry->owner_of;
@@ -59,58 +250,119 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   TaskQueueId subsumed = queue_entry->owner_of;
-  queue_entry->delayed_tasks = {};
+  CollectPendingTasksUnlocked(queue_id);
+  queue_entry->ClearDelayedTasks();
+  queue_entry->SetNextWakeTime(fml::TimePoint::Max());
   if (subsumed != _kUnmerged) {
-    queue_entries_.at(subsumed)->delayed_tasks = {};
+    queue_entries_.at(subsumed)->ClearDelayedTasks();
   }
 }
 
 void MessageLoopTaskQueues::RegisterTask(TaskQueueId queue_id,
                                          const fml::closure& task,
-                                         fml::TimePoint target_time) {
-  std::lock_guard guard(queue_mutex_);
+                                         fml::TimePoint target_time,
+                                         TaskPriority priority,
+                                         fml::TimePoint deadline) {
+  SharedLock lock(GetLockShard(queue_id));
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->delayed_tasks.push({order, task, target_time});
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != _kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
   }
-  WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  const auto& wake_entry = queue_entries_.at(loop_to_wake);
+  // Sampled in the statistics of the loop that runs the task.
+  const auto post_time = wake_entry->stats.ShouldSample()
+                             ? fml::TimePoint::Now()
+                             : fml::TimePoint();
+  queue_entry->AddPendingTask(
+      {order, task, target_time, priority, deadline, post_time});
+  // The loop already wakes up at |next_wake_time| or earlier, so it only
+  // needs to move if this task is due sooner. Should this race with the loop
+  // re-arming itself, the loop notices the task after re-arming and wakes up
+  // immediately.
+  const auto wake_time = CoalesceWakeTime(queue_entry->timer_slack, target_time,
+                                          priority, deadline);
+  WakeUpUnlocked(loop_to_wake, wake_entry->LowerNextWakeTime(wake_time));
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  SharedLock lock(GetLockShard(queue_id));
+  const auto& entry = queue_entries_.at(queue_id);
+  if (entry->subsumed_by != _kUnmerged) {
+    return false;
+  }
+  ScopedDelayedTasksLock tasks_lock(*entry, GetSubsumedEntryUnlocked(queue_id));
+  CollectPendingTasksUnlocked(queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
-                                                     fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+                                                     fml::TimePoint from_time,
+                                                     TaskSample* sample) {
+  SharedLock lock(GetLockShard(queue_id));
+  const auto& entry = queue_entries_.at(queue_id);
+  if (entry->subsumed_by != _kUnmerged) {
+    return nullptr;
+  }
+  TaskQueueEntry* subsumed_entry = GetSubsumedEntryUnlocked(queue_id);
+  ScopedDelayedTasksLock tasks_lock(*entry, subsumed_entry);
+  CollectPendingTasksUnlocked(queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
-  TaskQueueId top_queue = _kUnmerged;
-  const auto& top = PeekNextTaskUnlocked(queue_id, top_queue);
+  auto& top_queue = PeekNextTaskQueueUnlocked(queue_id, from_time);
+  const auto& top = top_queue.top();
 
-  if (!HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, fml::TimePoint::Max());
-  } else {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+  RearmUnlocked(queue_id);
+
+  // A task registered after the collection above may have lowered the wake
+  // time before it was re-armed, in which case its wake up was overridden.
+  if (entry->HasUncollectedTasks() ||
+      (subsumed_entry && subsumed_entry->HasUncollectedTasks())) {
+    const auto now = fml::TimePoint::Now();
+    WakeUpUnlocked(queue_id, entry->LowerNextWakeTime(now));
   }
 
-  if (top.GetTargetTime() > from_time) {
+  const auto top_target_time = top.GetTargetTime();
+  if (top_target_time > from_time) {
     return nullptr;
   }
+  const auto post_time = top.GetPostTime();
   fml::closure invocation = top.GetTask();
-  queue_entries_.at(top_queue)->delayed_tasks.pop();
+  top_queue.pop();
+
+  if (post_time != fml::TimePoint()) {
+    const auto due_time = std::max(post_time, top_target_time);
+    const auto latency =
+        std::max(fml::TimePoint::Now() - due_time, fml::TimeDelta::Zero());
+    size_t depth = entry->GetNumDelayedTasks();
+    if (subsumed_entry) {
+      depth += subsumed_entry->GetNumDelayedTasks();
+    }
+    entry->stats.RecordQueueLatency(latency);
+    entry->stats.RecordQueueDepth(depth);
+    if (sample) {
+      sample->sampled = true;
+      sample->queue_latency = latency;
+      sample->queue_depth = depth;
+    }
+  }
   return invocation;
 }
 
+void MessageLoopTaskQueues::RearmUnlocked(TaskQueueId queue_id) const {
+  const auto wake_time = HasPendingTasksUnlocked(queue_id)
+                             ? GetNextWakeTimeUnlocked(queue_id)
+                             : fml::TimePoint::Max();
+  queue_entries_.at(queue_id)->SetNextWakeTime(wake_time);
+  WakeUpUnlocked(queue_id, wake_time);
+}
+
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
                                            fml::TimePoint time) const {
   if (queue_entries_.at(queue_id)->wakeable) {
@@ -119,40 +371,69 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  SharedLock lock(GetLockShard(queue_id));
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
   }
+  ScopedDelayedTasksLock tasks_lock(*queue_entry,
+                                    GetSubsumedEntryUnlocked(queue_id));
+  CollectPendingTasksUnlocked(queue_id);
 
   size_t total_tasks = 0;
-  total_tasks += queue_entry->delayed_tasks.size();
+  total_tasks += queue_entry->GetNumDelayedTasks();
 
   TaskQueueId subsumed = queue_entry->owner_of;
   if (subsumed != _kUnmerged) {
     const auto& subsumed_entry = queue_entries_.at(subsumed);
-    total_tasks += subsumed_entry->delayed_tasks.size();
+    total_tasks += subsumed_entry->GetNumDelayedTasks();
   }
   return total_tasks;
 }
 
+void MessageLoopTaskQueues::RecordTaskRunTime(TaskQueueId queue_id,
+                                              fml::TimeDelta run_time) {
+  SharedLock lock(GetLockShard(queue_id));
+  queue_entries_.at(queue_id)->stats.RecordRunTime(run_time);
+}
+
+bool MessageLoopTaskQueues::GetTaskStats(
+    TaskQueueId queue_id,
+    TaskQueueStats::Summary* summary) const {
+  SharedLock lock(GetLockShard(queue_id));
+  auto entry = queue_entries_.find(queue_id);
+  if (entry == queue_entries_.end()) {
+    return false;
+  }
+  *summary = entry->second->stats.Summarize();
+  return true;
+}
+
+void MessageLoopTaskQueues::ResetTaskStats(TaskQueueId queue_id) {
+  SharedLock lock(GetLockShard(queue_id));
+  auto entry = queue_entries_.find(queue_id);
+  if (entry != queue_entries_.end()) {
+    entry->second->stats.Reset();
+  }
+}
+
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
   queue_entries_.at(queue_id)->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   queue_entries_.at(queue_id)->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  SharedLock lock(GetLockShard(queue_id));
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -175,17 +456,23 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
       << "Wakeable can only be set once.";
   queue_entries_.at(queue_id)->wakeable = wakeable;
 }
 
+void MessageLoopTaskQueues::SetTimerSlack(TaskQueueId queue_id,
+                                          fml::TimeDelta slack) {
+  ScopedExclusiveLock lock(*this);
+  queue_entries_.at(queue_id)->timer_slack = slack;
+}
+
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
 
@@ -206,15 +493,16 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   owner_entry->owner_of = subsumed;
   subsumed_entry->subsumed_by = owner;
 
+  CollectPendingTasksUnlocked(owner);
   if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+    RearmUnlocked(owner);
   }
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
-  std::lock_guard guard(queue_mutex_);
+  ScopedExclusiveLock lock(*this);
   const auto& owner_entry = queue_entries_.at(owner);
   const TaskQueueId subsumed = owner_entry->owner_of;
   if (subsumed == _kUnmerged) {
@@ -224,12 +512,17 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
   queue_entries_.at(subsumed)->subsumed_by = _kUnmerged;
   owner_entry->owner_of = _kUnmerged;
 
+  CollectPendingTasksUnlocked(owner);
+  CollectPendingTasksUnlocked(subsumed);
+
   if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+    RearmUnlocked(owner);
   }
 
   if (HasPendingTasksUnlocked(subsumed)) {
-    WakeUpUnlocked(subsumed, GetNextWakeTimeUnlocked(subsumed));
+    RearmUnlocked(subsumed);
+  } else {
+    queue_entries_.at(subsumed)->SetNextWakeTime(fml::TimePoint::Max());
   }
 
   return true;
@@ -237,10 +530,27 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  SharedLock lock(GetLockShard(owner));
   return subsumed == queue_entries_.at(owner)->owner_of;
 }
 
+TaskQueueEntry* MessageLoopTaskQueues::GetSubsumedEntryUnlocked(
+    TaskQueueId queue_id) const {
+  const TaskQueueId subsumed = queue_entries_.at(queue_id)->owner_of;
+  if (subsumed == _kUnmerged) {
+    return nullptr;
+  }
+  return queue_entries_.at(subsumed).get();
+}
+
+void MessageLoopTaskQueues::CollectPendingTasksUnlocked(
+    TaskQueueId queue_id) const {
+  queue_entries_.at(queue_id)->CollectPendingTasks();
+  if (TaskQueueEntry* subsumed = GetSubsumedEntryUnlocked(queue_id)) {
+    subsumed->CollectPendingTasks();
+  }
+}
+
 // Subsumed queues will never have pending tasks.
 // Owning queues will consider both their and their subsumed tasks.
 bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
@@ -251,7 +561,7 @@ bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
     return false;
   }
 
-  if (!entry->delayed_tasks.empty()) {
+  if (entry->HasDelayedTasks()) {
     return true;
   }
 
@@ -260,47 +570,72 @@ bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
     // this is not an owner and queue is empty.
     return false;
   } else {
-    return !queue_entries_.at(subsumed)->delayed_tasks.empty();
+    return queue_entries_.at(subsumed)->HasDelayedTasks();
   }
 }
 
 fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
     TaskQueueId queue_id) const {
-  TaskQueueId tmp = _kUnmerged;
-  return PeekNextTaskUnlocked(queue_id, tmp).GetTargetTime();
+  FML_DCHECK(HasPendingTasksUnlocked(queue_id));
+  fml::TimePoint wake_time = fml::TimePoint::Max();
+  auto consider = [&wake_time](const TaskQueueEntry& entry) {
+    for (const auto& lane : entry.delayed_tasks) {
+      if (!lane.empty()) {
+        const DelayedTask& task = lane.top();
+        wake_time = std::min(
+            wake_time,
+            CoalesceWakeTime(entry.timer_slack, task.GetTargetTime(),
+                             task.GetPriority(), task.GetDeadline()));
+      }
+    }
+  };
+  consider(*queue_entries_.at(queue_id));
+  if (const TaskQueueEntry* subsumed = GetSubsumedEntryUnlocked(queue_id)) {
+    consider(*subsumed);
+  }
+  return wake_time;
 }
 
-const DelayedTask& MessageLoopTaskQueues::PeekNextTaskUnlocked(
+DelayedTaskQueue& MessageLoopTaskQueues::PeekNextTaskQueueUnlocked(
     TaskQueueId owner,
-    TaskQueueId& top_queue_id) const {
+    fml::TimePoint from_time) const {
   FML_DCHECK(HasPendingTasksUnlocked(owner));
-  const auto& entry = queue_entries_.at(owner);
-  const TaskQueueId subsumed = entry->owner_of;
-  if (subsumed == _kUnmerged) {
-    top_queue_id = owner;
-    return entry->delayed_tasks.top();
-  }
-
-  const auto& owner_tasks = entry->delayed_tasks;
-  const auto& subsumed_tasks = queue_entries_.at(subsumed)->delayed_tasks;
-
-  // we are owning another task queue
-  const bool subsumed_has_task = !subsumed_tasks.empty();
-  const bool owner_has_task = !owner_tasks.empty();
-  if (owner_has_task && subsumed_has_task) {
-    const auto owner_task = owner_tasks.top();
-    const auto subsumed_task = subsumed_tasks.top();
-    if (owner_task > subsumed_task) {
-      top_queue_id = subsumed;
-    } else {
-      top_queue_id = owner;
+  DelayedTaskQueue* next = nullptr;
+  bool next_is_due = false;
+  TaskPriority next_priority = TaskPriority::kIdle;
+
+  // Due tasks run most urgent first, then in target time order. If no task is
+  // due, the loop waits for the earliest one.
+  auto consider = [&](TaskQueueEntry& entry) {
+    for (auto& lane : entry.delayed_tasks) {
+      if (lane.empty()) {
+        continue;
+      }
+      const DelayedTask& task = lane.top();
+      const bool is_due = task.GetTargetTime() <= from_time;
+      const TaskPriority priority = task.GetEffectivePriority(from_time);
+      bool is_next;
+      if (!next) {
+        is_next = true;
+      } else if (is_due != next_is_due) {
+        is_next = is_due;
+      } else if (is_due && priority != next_priority) {
+        is_next = priority < next_priority;
+      } else {
+        is_next = next->top() > task;
+      }
+      if (is_next) {
+        next = &lane;
+        next_is_due = is_due;
+        next_priority = priority;
+      }
     }
-  } else if (owner_has_task) {
-    top_queue_id = owner;
-  } else {
-    top_queue_id = subsumed;
+  };
+  consider(*queue_entries_.at(owner));
+  if (TaskQueueEntry* subsumed = GetSubsumedEntryUnlocked(owner)) {
+    consider(*subsumed);
   }
-  return queue_entries_.at(top_queue_id)->delayed_tasks.top();
+  return *next;
 }
 
 }  // namespace fml
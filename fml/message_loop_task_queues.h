@@ -5,12 +5,16 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/delayed_task.h"
+#include "flutter/fml/histogram.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/shared_mutex.h"
@@ -32,6 +36,61 @@ class TaskQueueId {
 
 static const TaskQueueId _kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 
+// How long the tasks of a queue wait to run, how long they run, and how many
+// tasks are pending when they are taken to run, for telling a backlog apart
+// from long tasks without a full trace.
+//
+// Only one task in every |kSampleInterval| registered to a queue is measured,
+// so that most tasks do not read the clock. Recording a sample is a few
+// relaxed atomic operations, and percentiles are only computed when queried.
+class TaskQueueStats {
+ public:
+  static constexpr size_t kSampleInterval = 8;
+
+  struct Summary {
+    // Time from when a task became due, the later of its registration and
+    // target time, to when it started running, in microseconds.
+    Histogram::Summary queue_latency;
+    // Time a task ran for, in microseconds.
+    Histogram::Summary run_time;
+    // Number of tasks still pending when a task was taken to run.
+    Histogram::Summary queue_depth;
+  };
+
+  TaskQueueStats();
+
+  ~TaskQueueStats();
+
+  // Whether the task being registered is one of the sampled ones.
+  bool ShouldSample();
+
+  void RecordQueueLatency(fml::TimeDelta latency);
+
+  void RecordRunTime(fml::TimeDelta run_time);
+
+  void RecordQueueDepth(size_t depth);
+
+  Summary Summarize() const;
+
+  void Reset();
+
+ private:
+  std::atomic<size_t> registered_count_;
+  Histogram queue_latency_;
+  Histogram run_time_;
+  Histogram queue_depth_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TaskQueueStats);
+};
+
+// The measurements of a sampled task returned by
+// |MessageLoopTaskQueues::GetNextTaskToRun|.
+struct TaskSample {
+  bool sampled = false;
+  fml::TimeDelta queue_latency;
+  size_t queue_depth = 0;
+};
+
 // This is keyed by the |TaskQueueId| and contains all the queue
 // components that make up a single TaskQueue.
 class TaskQueueEntry {
@@ -39,7 +98,24 @@ class TaskQueueEntry {
   using TaskObservers = std::map<intptr_t, fml::closure>;
   Wakeable* wakeable;
   TaskObservers task_observers;
-  DelayedTaskQueue delayed_tasks;
+
+  // One heap per |TaskPriority|. Only accessed with |delayed_tasks_mutex|
+  // held, or with exclusive access to all the queues. Threads registering
+  // tasks never touch them; the tasks they register are moved here by
+  // |CollectPendingTasks|.
+  std::array<DelayedTaskQueue, kTaskPriorityCount> delayed_tasks;
+  std::mutex delayed_tasks_mutex;
+
+  // The earliest time the loop running the tasks of this queue has been
+  // asked to wake up at, in nanoseconds since epoch.
+  std::atomic<int64_t> next_wake_time;
+
+  // How late the loop may wake up for the non-critical tasks of this queue.
+  fml::TimeDelta timer_slack;
+
+  // The tasks run by the loop of this queue, including the ones registered to
+  // a queue it owns.
+  TaskQueueStats stats;
 
   // Note: Both of these can be _kUnmerged, which indicates that
   // this queue has not been merged or subsumed. OR exactly one
@@ -50,7 +126,40 @@ class TaskQueueEntry {
 
   TaskQueueEntry();
 
+  ~TaskQueueEntry();
+
+  // Adds a task without locking. Safe to call from any number of threads
+  // concurrently with each other and with |CollectPendingTasks|.
+  void AddPendingTask(DelayedTask task);
+
+  // Moves the tasks added by |AddPendingTask| into |delayed_tasks|. The
+  // caller must have the access required for |delayed_tasks|.
+  void CollectPendingTasks();
+
+  bool HasUncollectedTasks() const;
+
+  bool HasDelayedTasks() const;
+
+  size_t GetNumDelayedTasks() const;
+
+  void ClearDelayedTasks();
+
+  // Lowers |next_wake_time| to |time| if it is later and returns the
+  // resulting wake time.
+  fml::TimePoint LowerNextWakeTime(fml::TimePoint time);
+
+  void SetNextWakeTime(fml::TimePoint time);
+
  private:
+  struct PendingTask {
+    DelayedTask task;
+    PendingTask* next;
+  };
+
+  // Intrusive stack of the tasks registered since the last call to
+  // |CollectPendingTasks|.
+  std::atomic<PendingTask*> pending_tasks_;
+
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskQueueEntry);
 };
 
@@ -62,6 +171,14 @@ enum class FlushType {
 // This class keeps track of all the tasks and observers that
 // need to be run on it's MessageLoopImpl. This also wakes up the
 // loop at the required times.
+//
+// Registering tasks and running them only acquire one of |lock_shards_| for
+// shared access, picked by queue id, so loops do not contend with each other
+// even on the lock itself. Tasks are registered without taking any lock and
+// are only ordered by target time when the queue is about to run or count
+// them. Creating, disposing, merging and configuring queues acquire all the
+// shards exclusively, so holding any shard gives a consistent view of every
+// queue, including the ones merged with it.
 class MessageLoopTaskQueues
     : public fml::RefCountedThreadSafe<MessageLoopTaskQueues> {
  public:
@@ -79,14 +196,31 @@ class MessageLoopTaskQueues
 
   void RegisterTask(TaskQueueId queue_id,
                     const fml::closure& task,
-                    fml::TimePoint target_time);
+                    fml::TimePoint target_time,
+                    TaskPriority priority = TaskPriority::kNormal,
+                    fml::TimePoint deadline = fml::TimePoint::Max());
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  // If the returned task is one of the sampled tasks of |TaskQueueStats|, its
+  // queue latency and depth are recorded and reported in |sample|, and the
+  // caller should record its run time with |RecordTaskRunTime|.
+  fml::closure GetNextTaskToRun(TaskQueueId queue_id,
+                                fml::TimePoint from_time,
+                                TaskSample* sample = nullptr);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
+  // Statistics methods.
+
+  void RecordTaskRunTime(TaskQueueId queue_id, fml::TimeDelta run_time);
+
+  // Returns false if |queue_id| has been disposed of.
+  bool GetTaskStats(TaskQueueId queue_id,
+                    TaskQueueStats::Summary* summary) const;
+
+  void ResetTaskStats(TaskQueueId queue_id);
+
   // Observers methods.
 
   void AddTaskObserver(TaskQueueId queue_id,
@@ -101,6 +235,13 @@ class MessageLoopTaskQueues
 
   void SetWakeable(TaskQueueId queue_id, fml::Wakeable* wakeable);
 
+  // Lets the loop wake up to |slack| late for the tasks of |queue_id| that are
+  // not |TaskPriority::kCritical|, so that the tasks due within the same window
+  // of |slack| are run after a single wake up. Tasks that are already due and
+  // tasks that reach their deadline are not delayed. Zero, the default, wakes
+  // the loop up at the exact target times.
+  void SetTimerSlack(TaskQueueId queue_id, fml::TimeDelta slack);
+
   // Invariants for merge and un-merge
   //  1. RegisterTask will always submit to the queue_id that is passed
   //     to it. It is not aware of whether a queue is merged or not. Same with
@@ -131,17 +272,37 @@ class MessageLoopTaskQueues
 
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
+  // Re-arms the loop of |queue_id| at its next wake time, or |Max| if it has
+  // no pending tasks.
+  void RearmUnlocked(TaskQueueId queue_id) const;
+
+  TaskQueueEntry* GetSubsumedEntryUnlocked(TaskQueueId queue_id) const;
+
+  void CollectPendingTasksUnlocked(TaskQueueId queue_id) const;
+
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
-  const DelayedTask& PeekNextTaskUnlocked(TaskQueueId owner,
-                                          TaskQueueId& top_queue_id) const;
+  // Returns the heap whose top task is the next to run at |from_time|: the
+  // most urgent of the tasks that are due or, if none is, the earliest.
+  DelayedTaskQueue& PeekNextTaskQueueUnlocked(TaskQueueId owner,
+                                              fml::TimePoint from_time) const;
 
+  // The time to wake up at for the earliest task of |queue_id| and of the
+  // queue it owns, taking their timer slack into account.
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
   static std::mutex creation_mutex_;
   static fml::RefPtr<MessageLoopTaskQueues> instance_;
 
-  mutable std::mutex queue_mutex_;
+  // With many engines in a process, a single reader-writer lock is still a
+  // point of contention since every shared acquisition writes to it.
+  static constexpr size_t kLockShardCount = 8;
+
+  class ScopedExclusiveLock;
+
+  SharedMutex& GetLockShard(TaskQueueId queue_id) const;
+
+  std::array<std::unique_ptr<fml::SharedMutex>, kLockShardCount> lock_shards_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
@@ -66,5 +66,53 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Many threads posting to a single queue while its loop drains it, as the
+// platform and UI task runners see when worker threads post results back.
+static void BM_RegisterTasksFromManyThreads(
+    benchmark::State& state) {  // NOLINT
+  const int num_producers = state.range(0);
+  const int num_tasks_per_producer = 1000;
+  const int num_tasks = num_producers * num_tasks_per_producer;
+
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  while (state.KeepRunning()) {
+    const auto queue_id = task_queue->CreateTaskQueue();
+    const fml::TimePoint past = fml::TimePoint::Now();
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < num_producers; i++) {
+      producers.emplace_back([&task_queue, queue_id, past]() {
+        for (int j = 0; j < num_tasks_per_producer; j++) {
+          task_queue->RegisterTask(
+              queue_id, [] {}, past);
+        }
+      });
+    }
+
+    int num_invocations = 0;
+    while (num_invocations < num_tasks) {
+      fml::closure invocation =
+          task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+      if (invocation) {
+        num_invocations++;
+      }
+    }
+
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    task_queue->Dispose(queue_id);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+}
+
+BENCHMARK(BM_RegisterTasksFromManyThreads)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
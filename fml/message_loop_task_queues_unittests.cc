@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -283,5 +284,209 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, DueTasksRunInPriorityOrder) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto past = fml::TimePoint::Now();
+  std::vector<int> order;
+
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(3); }, past,
+      fml::TaskPriority::kIdle);
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(1); }, past);
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(2); }, past);
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(0); }, past,
+      fml::TaskPriority::kCritical);
+
+  const auto now = fml::TimePoint::Now();
+  while (auto invocation = task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+  }
+  ASSERT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST(MessageLoopTaskQueue, PendingCriticalTaskDoesNotDelayDueTasks) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto now = fml::TimePoint::Now();
+  int normal_runs = 0;
+
+  task_queue->RegisterTask(
+      queue_id, []() {}, now + fml::TimeDelta::FromSeconds(10),
+      fml::TaskPriority::kCritical);
+  task_queue->RegisterTask(
+      queue_id, [&normal_runs]() { normal_runs++; }, now);
+
+  auto invocation = task_queue->GetNextTaskToRun(queue_id, now);
+  ASSERT_TRUE(invocation);
+  invocation();
+  ASSERT_EQ(normal_runs, 1);
+  ASSERT_FALSE(task_queue->GetNextTaskToRun(queue_id, now));
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_id), 1u);
+}
+
+TEST(MessageLoopTaskQueue, TasksPastTheirDeadlineRunAsCritical) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto past = fml::TimePoint::Now();
+  std::vector<int> order;
+
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(2); }, past,
+      fml::TaskPriority::kCritical);
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(3); }, past);
+  // Due before the critical task and past its deadline.
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(1); },
+      past - fml::TimeDelta::FromMilliseconds(1), fml::TaskPriority::kIdle,
+      past);
+
+  const auto now = fml::TimePoint::Now();
+  while (auto invocation = task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+  }
+  ASSERT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(MessageLoopTaskQueue, TimerSlackCoalescesWakeUps) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto slack = fml::TimeDelta::FromSeconds(10);
+  task_queue->SetTimerSlack(queue_id, slack);
+  std::vector<fml::TimePoint> wake_times;
+  task_queue->SetWakeable(queue_id,
+                          new TestWakeable([&wake_times](fml::TimePoint time) {
+                            wake_times.push_back(time);
+                          }));
+
+  const auto now = fml::TimePoint::Now();
+  const auto target = now + fml::TimeDelta::FromMilliseconds(10);
+  const auto window_end = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(
+          (target.ToEpochDelta().ToNanoseconds() + slack.ToNanoseconds() - 1) /
+          slack.ToNanoseconds() * slack.ToNanoseconds()));
+
+  // Delayed tasks in the same window share a wake up at the end of it.
+  task_queue->RegisterTask(
+      queue_id, [] {}, target);
+  task_queue->RegisterTask(
+      queue_id, [] {}, target + fml::TimeDelta::FromMilliseconds(1));
+  ASSERT_EQ(wake_times.size(), 2u);
+  EXPECT_EQ(wake_times[0], window_end);
+  EXPECT_EQ(wake_times[1], window_end);
+
+  // The deadline of a task bounds its wake up.
+  const auto deadline = target + fml::TimeDelta::FromMilliseconds(5);
+  task_queue->RegisterTask(
+      queue_id, [] {}, target, fml::TaskPriority::kIdle, deadline);
+  ASSERT_EQ(wake_times.size(), 3u);
+  EXPECT_EQ(wake_times[2], std::min(window_end, deadline));
+
+  // Critical tasks are not delayed.
+  task_queue->RegisterTask(
+      queue_id, [] {}, target, fml::TaskPriority::kCritical);
+  ASSERT_EQ(wake_times.size(), 4u);
+  EXPECT_EQ(wake_times[3], target);
+
+  // Neither are tasks that are already due.
+  task_queue->RegisterTask(
+      queue_id, [] {}, now);
+  ASSERT_EQ(wake_times.size(), 5u);
+  EXPECT_EQ(wake_times[4], now);
+}
+
+TEST(MessageLoopTaskQueue, SamplesTheTasksOfAQueue) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  const size_t num_tasks = 4 * TaskQueueStats::kSampleInterval;
+  const auto past = fml::TimePoint::Now();
+  for (size_t i = 0; i < num_tasks; i++) {
+    task_queue->RegisterTask(queue_id, [] {}, past);
+  }
+
+  size_t num_sampled = 0;
+  size_t num_run = 0;
+  for (;;) {
+    TaskSample sample;
+    auto invocation =
+        task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now(), &sample);
+    if (!invocation) {
+      break;
+    }
+    num_run++;
+    if (sample.sampled) {
+      // The tasks registered after the sampled one are still pending.
+      EXPECT_EQ(sample.queue_depth, num_tasks - num_run);
+      task_queue->RecordTaskRunTime(queue_id,
+                                    fml::TimeDelta::FromMicroseconds(100));
+      num_sampled++;
+    }
+  }
+  ASSERT_EQ(num_run, num_tasks);
+  ASSERT_EQ(num_sampled, num_tasks / TaskQueueStats::kSampleInterval);
+
+  TaskQueueStats::Summary summary;
+  ASSERT_TRUE(task_queue->GetTaskStats(queue_id, &summary));
+  EXPECT_EQ(summary.queue_latency.count, num_sampled);
+  EXPECT_EQ(summary.queue_depth.count, num_sampled);
+  EXPECT_EQ(summary.queue_depth.max, num_tasks - 1);
+  EXPECT_EQ(summary.run_time.count, num_sampled);
+  EXPECT_EQ(summary.run_time.max, 100u);
+
+  task_queue->ResetTaskStats(queue_id);
+  ASSERT_TRUE(task_queue->GetTaskStats(queue_id, &summary));
+  EXPECT_EQ(summary.queue_latency.count, 0u);
+  EXPECT_EQ(summary.run_time.count, 0u);
+}
+
+TEST(MessageLoopTaskQueue, ConcurrentlyRegisteredTasksRunInOrder) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  const int num_producers = 8;
+  const int num_tasks_per_producer = 1000;
+  const auto past = fml::TimePoint::Now();
+
+  std::vector<int> last_run(num_producers, -1);
+  bool in_order = true;
+
+  std::vector<std::thread> producers;
+  for (int i = 0; i < num_producers; i++) {
+    producers.emplace_back([&, producer = i]() {
+      for (int j = 0; j < num_tasks_per_producer; j++) {
+        task_queue->RegisterTask(
+            queue_id,
+            [&, producer, j]() {
+              in_order = in_order && last_run[producer] == j - 1;
+              last_run[producer] = j;
+            },
+            past);
+      }
+    });
+  }
+
+  int num_run = 0;
+  while (num_run < num_producers * num_tasks_per_producer) {
+    auto invocation =
+        task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+    if (invocation) {
+      invocation();
+      num_run++;
+    }
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  ASSERT_TRUE(in_order);
+  ASSERT_FALSE(task_queue->HasPendingTasks(queue_id));
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop.h"
 
 #include <iostream>
+#include <string>
 #include <thread>
 
 #include "flutter/fml/build_config.h"
@@ -16,6 +17,10 @@
 #include "flutter/fml/task_runner.h"
 #include "gtest/gtest.h"
 
+#if OS_LINUX
+#include <unistd.h>
+#endif
+
 #define TIMESENSITIVE(x) TimeSensitiveTest_##x
 #if OS_WIN
 #define PLATFORM_SPECIFIC_CAPTURE(...) [ __VA_ARGS__, count ]
@@ -297,6 +302,32 @@ TEST(MessageLoop, CanCreateAndShutdownConcurrentMessageLoopsOverAndOver) {
   }
 }
 
+TEST(MessageLoop, ConcurrentMessageLoopWorkersCanBeLaunchedByHost) {
+  const size_t kWorkerCount = 3;
+  std::mutex launched_threads_mutex;
+  std::vector<std::thread> launched_threads;
+  fml::Thread::ThreadLauncher launcher =
+      [&](const fml::Thread::ThreadConfig& config, fml::closure entry) {
+        std::scoped_lock lock(launched_threads_mutex);
+        launched_threads.emplace_back(entry);
+        return true;
+      };
+  {
+    auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount, launcher);
+    ASSERT_EQ(launched_threads.size(), kWorkerCount);
+    fml::CountDownLatch latch(kWorkerCount);
+    auto task_runner = loop->GetTaskRunner();
+    for (size_t i = 0; i < kWorkerCount; ++i) {
+      task_runner->PostTask([&latch]() { latch.CountDown(); });
+    }
+    latch.Wait();
+  }
+  // Collecting the loop waited for the workers to exit.
+  for (auto& launched_thread : launched_threads) {
+    launched_thread.join();
+  }
+}
+
 TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   auto task_runner = loop->GetTaskRunner();
@@ -316,3 +347,124 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopStealsTasksPostedFromAWorker) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  auto task_runner = loop->GetTaskRunner();
+  // All the tasks are queued on the worker that posts them. They can only
+  // all run at the same time if the other workers steal them.
+  fml::CountDownLatch all_running(kWorkerCount);
+  fml::CountDownLatch done(kWorkerCount);
+  task_runner->PostTask([&]() {
+    for (size_t i = 0; i < kWorkerCount; ++i) {
+      task_runner->PostTask([&]() {
+        all_running.CountDown();
+        all_running.Wait();
+        done.CountDown();
+      });
+    }
+  });
+  done.Wait();
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTaskOnAllWorkers) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    std::scoped_lock lock(thread_ids_mutex);
+    thread_ids.insert(std::this_thread::get_id());
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
+
+TEST(MessageLoop, ConcurrentTaskRunnerParallelForVisitsEveryIndexOnce) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 1000;
+  std::vector<std::atomic<int>> visits(kCount);
+  task_runner->ParallelFor(kCount, [&](size_t index) { visits[index]++; });
+  for (size_t i = 0; i < kCount; ++i) {
+    ASSERT_EQ(visits[i].load(), 1);
+  }
+}
+
+TEST(MessageLoop, ConcurrentTaskRunnerParallelForCanBeCalledFromAWorker) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic<size_t> sum(0);
+  fml::AutoResetWaitableEvent done;
+  task_runner->PostTask([&]() {
+    task_runner->ParallelFor(100, [&](size_t index) { sum += index; });
+    done.Signal();
+  });
+  done.Wait();
+  ASSERT_EQ(sum.load(), 4950u);
+}
+
+#if OS_LINUX
+TEST(MessageLoop, CanWatchFileDescriptors) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  const int read_fd = fds[0];
+  const int write_fd = fds[1];
+  std::string received;
+  std::thread thread([read_fd, &received]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    ASSERT_TRUE(loop.WatchFileDescriptor(
+        read_fd, fml::MessageLoop::kReadable,
+        [&received](int fd, uint32_t events) {
+          ASSERT_TRUE(events & fml::MessageLoop::kReadable);
+          char buffer[16];
+          ssize_t size = read(fd, buffer, sizeof(buffer));
+          ASSERT_GT(size, 0);
+          received.append(buffer, size);
+          if (received.size() == 5) {
+            auto& loop = fml::MessageLoop::GetCurrent();
+            ASSERT_TRUE(loop.UnwatchFileDescriptor(fd));
+            loop.Terminate();
+          }
+        }));
+    // Watching the same descriptor twice is an error.
+    ASSERT_FALSE(loop.WatchFileDescriptor(read_fd, fml::MessageLoop::kReadable,
+                                          [](int, uint32_t) {}));
+    loop.Run();
+    ASSERT_FALSE(loop.UnwatchFileDescriptor(read_fd));
+  });
+  ASSERT_EQ(write(write_fd, "he", 2), 2);
+  ASSERT_EQ(write(write_fd, "llo", 3), 3);
+  thread.join();
+  ASSERT_EQ(received, "hello");
+  close(read_fd);
+  close(write_fd);
+}
+
+TEST(MessageLoop, ReportsErrorsOfWatchedFileDescriptors) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  const int read_fd = fds[0];
+  close(fds[1]);
+  bool hung_up = false;
+  std::thread thread([read_fd, &hung_up]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    ASSERT_TRUE(loop.WatchFileDescriptor(
+        read_fd, fml::MessageLoop::kReadable,
+        [&hung_up](int fd, uint32_t events) {
+          hung_up = events & fml::MessageLoop::kError;
+          fml::MessageLoop::GetCurrent().UnwatchFileDescriptor(fd);
+          fml::MessageLoop::GetCurrent().Terminate();
+        }));
+    loop.Run();
+  });
+  thread.join();
+  ASSERT_TRUE(hung_up);
+  close(read_fd);
+}
+#endif  // OS_LINUX
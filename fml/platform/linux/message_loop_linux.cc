@@ -14,6 +14,15 @@ namespace fml {
 
 static constexpr int kClockType = CLOCK_MONOTONIC;
 
+// The number of events collected by each wait.
+static constexpr int kMaxEvents = 16;
+
+// The data of the epoll events: the id of the watch in the upper half and the
+// descriptor in the lower one. The timer uses the id 0.
+static uint64_t PackEventData(uint32_t watch_id, int fd) {
+  return (static_cast<uint64_t>(watch_id) << 32) | static_cast<uint32_t>(fd);
+}
+
 MessageLoopLinux::MessageLoopLinux()
     : epoll_fd_(FML_HANDLE_EINTR(::epoll_create(1 /* unused */))),
       timer_fd_(::timerfd_create(kClockType, TFD_NONBLOCK | TFD_CLOEXEC)),
@@ -33,9 +42,7 @@ bool MessageLoopLinux::AddOrRemoveTimerSource(bool add) {
   struct epoll_event event = {};
 
   event.events = EPOLLIN;
-  // The data is just for informational purposes so we know when we were worken
-  // by the FD.
-  event.data.fd = timer_fd_.get();
+  event.data.u64 = PackEventData(0, timer_fd_.get());
 
   int ctl_result =
       ::epoll_ctl(epoll_fd_.get(), add ? EPOLL_CTL_ADD : EPOLL_CTL_DEL,
@@ -48,26 +55,29 @@ void MessageLoopLinux::Run() {
   running_ = true;
 
   while (running_) {
-    struct epoll_event event = {};
+    struct epoll_event events[kMaxEvents] = {};
 
     int epoll_result = FML_HANDLE_EINTR(
-        ::epoll_wait(epoll_fd_.get(), &event, 1, -1 /* timeout */));
-
-    // Errors are fatal.
-    if (event.events & (EPOLLERR | EPOLLHUP)) {
-      running_ = false;
-      continue;
-    }
+        ::epoll_wait(epoll_fd_.get(), events, kMaxEvents, -1 /* timeout */));
 
     // Timeouts are fatal since we specified an infinite timeout already.
-    // Likewise, > 1 is not possible since we waited for one result.
-    if (epoll_result != 1) {
+    if (epoll_result <= 0) {
       running_ = false;
       continue;
     }
 
-    if (event.data.fd == timer_fd_.get()) {
-      OnEventFired();
+    for (int i = 0; i < epoll_result && running_; i++) {
+      const auto& event = events[i];
+      if (event.data.u64 == PackEventData(0, timer_fd_.get())) {
+        // Errors of the timer are fatal.
+        if (event.events & (EPOLLERR | EPOLLHUP)) {
+          running_ = false;
+          continue;
+        }
+        OnEventFired();
+      } else {
+        OnFileDescriptorEvent(event.data.u64, event.events);
+      }
     }
   }
 }
@@ -84,6 +94,73 @@ void MessageLoopLinux::WakeUp(fml::TimePoint time_point) {
   FML_DCHECK(result);
 }
 
+// |fml::MessageLoopImpl|
+bool MessageLoopLinux::WatchFileDescriptor(
+    int fd,
+    uint32_t events,
+    MessageLoop::FileDescriptorCallback callback) {
+  if (fd < 0 || !callback || watches_.count(fd) > 0) {
+    return false;
+  }
+
+  if (next_watch_id_ == 0) {
+    next_watch_id_ = 1;
+  }
+  const uint32_t id = next_watch_id_++;
+
+  struct epoll_event event = {};
+  if (events & MessageLoop::kReadable) {
+    event.events |= EPOLLIN;
+  }
+  if (events & MessageLoop::kWritable) {
+    event.events |= EPOLLOUT;
+  }
+  event.data.u64 = PackEventData(id, fd);
+  if (::epoll_ctl(epoll_fd_.get(), EPOLL_CTL_ADD, fd, &event) != 0) {
+    return false;
+  }
+
+  watches_[fd] = {id, std::move(callback)};
+  return true;
+}
+
+// |fml::MessageLoopImpl|
+bool MessageLoopLinux::UnwatchFileDescriptor(int fd) {
+  auto found = watches_.find(fd);
+  if (found == watches_.end()) {
+    return false;
+  }
+  ::epoll_ctl(epoll_fd_.get(), EPOLL_CTL_DEL, fd, nullptr);
+  watches_.erase(found);
+  return true;
+}
+
+void MessageLoopLinux::OnFileDescriptorEvent(uint64_t data,
+                                             uint32_t epoll_events) {
+  const int fd = static_cast<int>(data & 0xffffffff);
+  const uint32_t id = static_cast<uint32_t>(data >> 32);
+  auto found = watches_.find(fd);
+  // The descriptor may have been unwatched by a callback of the same wait.
+  if (found == watches_.end() || found->second.id != id) {
+    return;
+  }
+
+  uint32_t events = 0;
+  if (epoll_events & EPOLLIN) {
+    events |= MessageLoop::kReadable;
+  }
+  if (epoll_events & EPOLLOUT) {
+    events |= MessageLoop::kWritable;
+  }
+  if (epoll_events & (EPOLLERR | EPOLLHUP)) {
+    events |= MessageLoop::kError;
+  }
+
+  // The callback may unwatch the descriptor, which destroys the watch.
+  auto callback = found->second.callback;
+  callback(fd, events);
+}
+
 void MessageLoopLinux::OnEventFired() {
   if (TimerDrain(timer_fd_.get())) {
     RunExpiredTasksNow();
@@ -6,6 +6,8 @@
 #define FLUTTER_FML_PLATFORM_LINUX_MESSAGE_LOOP_LINUX_H_
 
 #include <atomic>
+#include <cstdint>
+#include <map>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/message_loop_impl.h"
@@ -15,9 +17,18 @@ namespace fml {
 
 class MessageLoopLinux : public MessageLoopImpl {
  private:
+  struct FileDescriptorWatch {
+    // Tells the events of a descriptor apart from the ones of a previous
+    // watch of the same descriptor number.
+    uint32_t id;
+    MessageLoop::FileDescriptorCallback callback;
+  };
+
   fml::UniqueFD epoll_fd_;
   fml::UniqueFD timer_fd_;
   bool running_;
+  std::map<int, FileDescriptorWatch> watches_;
+  uint32_t next_watch_id_ = 1;
 
   MessageLoopLinux();
 
@@ -32,8 +43,19 @@ class MessageLoopLinux : public MessageLoopImpl {
   // |fml::MessageLoopImpl|
   void WakeUp(fml::TimePoint time_point) override;
 
+  // |fml::MessageLoopImpl|
+  bool WatchFileDescriptor(
+      int fd,
+      uint32_t events,
+      MessageLoop::FileDescriptorCallback callback) override;
+
+  // |fml::MessageLoopImpl|
+  bool UnwatchFileDescriptor(int fd) override;
+
   void OnEventFired();
 
+  void OnFileDescriptorEvent(uint64_t data, uint32_t epoll_events);
+
   bool AddOrRemoveTimerSource(bool add);
 
   FML_FRIEND_MAKE_REF_COUNTED(MessageLoopLinux);
@@ -10,6 +10,7 @@
 #include <unistd.h>
 
 #include <type_traits>
+#include <utility>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/eintr_wrapper.h"
@@ -104,4 +105,53 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::WillNeed() const {
+  if (mapping_ == nullptr) {
+    return false;
+  }
+  return ::madvise(mapping_, size_, MADV_WILLNEED) == 0;
+}
+
+// Widens [data, data + size) to the pages that contain it.
+static std::pair<uint8_t*, size_t> PageAlignedRange(const uint8_t* data,
+                                                    size_t size) {
+  const uintptr_t page_size = ::sysconf(_SC_PAGESIZE);
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(data) & ~(page_size - 1);
+  const uintptr_t end =
+      (reinterpret_cast<uintptr_t>(data) + size + page_size - 1) &
+      ~(page_size - 1);
+  return {reinterpret_cast<uint8_t*>(begin), end - begin};
+}
+
+bool PrefaultMemory(const uint8_t* data, size_t size) {
+  if (data == nullptr || size == 0) {
+    return false;
+  }
+  auto [begin, length] = PageAlignedRange(data, size);
+#if defined(MADV_POPULATE_READ)
+  if (::madvise(begin, length, MADV_POPULATE_READ) == 0) {
+    return true;
+  }
+#endif  // defined(MADV_POPULATE_READ)
+  // Start reading the whole range in the background, then touch every page.
+  ::madvise(begin, length, MADV_WILLNEED);
+  const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  for (size_t offset = 0; offset < length; offset += page_size) {
+    static_cast<void>(*static_cast<volatile const uint8_t*>(begin + offset));
+  }
+  return true;
+}
+
+bool AdviseHugePages(const uint8_t* data, size_t size) {
+#if defined(MADV_HUGEPAGE)
+  if (data == nullptr || size == 0) {
+    return false;
+  }
+  auto [begin, length] = PageAlignedRange(data, size);
+  return ::madvise(begin, length, MADV_HUGEPAGE) == 0;
+#else   // defined(MADV_HUGEPAGE)
+  return false;
+#endif  // defined(MADV_HUGEPAGE)
+}
+
 }  // namespace fml
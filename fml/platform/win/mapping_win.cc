@@ -119,4 +119,16 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::WillNeed() const {
+  return false;
+}
+
+bool PrefaultMemory(const uint8_t* data, size_t size) {
+  return false;
+}
+
+bool AdviseHugePages(const uint8_t* data, size_t size) {
+  return false;
+}
+
 }  // namespace fml
@@ -6,7 +6,10 @@
 
 #include "flutter/fml/raster_thread_merger.h"
 
+#include <algorithm>
+
 #include "flutter/fml/message_loop_impl.h"
+#include "flutter/fml/trace_event.h"
 
 namespace fml {
 
@@ -46,13 +49,30 @@ void RasterThreadMerger::MergeWithLease(size_t lease_term) {
     merge_unmerge_callback_();
   }
   FML_CHECK(success) << "Unable to merge the raster and platform threads.";
-  lease_term_ = lease_term;
+
+  if (lease_expired_ && frames_since_unmerge_ < last_lease_term_) {
+    lease_term_multiplier_ =
+        std::min(lease_term_multiplier_ * 2, kMaxLeaseTermMultiplier);
+  } else {
+    lease_term_multiplier_ = 1;
+  }
+  lease_expired_ = false;
+  last_lease_term_ = lease_term * lease_term_multiplier_;
+  lease_term_ = static_cast<int>(last_lease_term_);
+  merge_count_++;
+  TraceStatsUnSafe();
 
   merged_condition_.notify_one();
 }
 
 void RasterThreadMerger::UnMergeNow() {
   std::scoped_lock lock(lease_term_mutex_);
+  // Only the expiry of a lease tells that the lease term was too short.
+  lease_expired_ = false;
+  UnMergeNowUnSafe();
+}
+
+void RasterThreadMerger::UnMergeNowUnSafe() {
   if (TaskQueuesAreSame()) {
     return;
   }
@@ -65,6 +85,8 @@ void RasterThreadMerger::UnMergeNow() {
     merge_unmerge_callback_();
   }
   FML_CHECK(success) << "Unable to un-merge the raster and platform threads.";
+  unmerge_count_++;
+  TraceStatsUnSafe();
 }
 
 bool RasterThreadMerger::IsOnPlatformThread() const {
@@ -85,9 +107,10 @@ void RasterThreadMerger::ExtendLeaseTo(size_t lease_term) {
   }
   std::scoped_lock lock(lease_term_mutex_);
   FML_DCHECK(IsMergedUnSafe()) << "lease_term should be positive.";
-  if (lease_term_ != kLeaseNotSet &&
-      static_cast<int>(lease_term) > lease_term_) {
-    lease_term_ = lease_term;
+  const int extended_lease_term =
+      static_cast<int>(lease_term * lease_term_multiplier_);
+  if (lease_term_ != kLeaseNotSet && extended_lease_term > lease_term_) {
+    lease_term_ = extended_lease_term;
   }
 }
 
@@ -111,6 +134,18 @@ bool RasterThreadMerger::IsEnabled() {
   return IsEnabledUnSafe();
 }
 
+RasterThreadMerger::Stats RasterThreadMerger::GetStats() {
+  std::scoped_lock lock(lease_term_mutex_);
+  return {merge_count_, unmerge_count_, lease_term_multiplier_};
+}
+
+void RasterThreadMerger::TraceStatsUnSafe() const {
+  FML_TRACE_COUNTER("flutter", "RasterThreadMerger",
+                    reinterpret_cast<int64_t>(this), "MergeCount",
+                    merge_count_, "UnmergeCount", unmerge_count_,
+                    "LeaseTermMultiplier", lease_term_multiplier_);
+}
+
 bool RasterThreadMerger::IsEnabledUnSafe() const {
   return enabled_;
 }
@@ -138,6 +173,7 @@ RasterThreadStatus RasterThreadMerger::DecrementLease() {
   }
   std::unique_lock<std::mutex> lock(lease_term_mutex_);
   if (!IsMergedUnSafe()) {
+    frames_since_unmerge_++;
     return RasterThreadStatus::kRemainsUnmerged;
   }
   if (!IsEnabledUnSafe()) {
@@ -147,9 +183,9 @@ RasterThreadStatus RasterThreadMerger::DecrementLease() {
       << "lease_term should always be positive when merged.";
   lease_term_--;
   if (lease_term_ == 0) {
-    // |UnMergeNow| is going to acquire the lock again.
-    lock.unlock();
-    UnMergeNow();
+    UnMergeNowUnSafe();
+    lease_expired_ = true;
+    frames_since_unmerge_ = 0;
     return RasterThreadStatus::kUnmergedNow;
   }
 
@@ -25,6 +25,18 @@ enum class RasterThreadStatus {
 class RasterThreadMerger
     : public fml::RefCountedThreadSafe<RasterThreadMerger> {
  public:
+  // The lease terms are multiplied by at most this much when the threads keep
+  // being merged again shortly after their lease expired.
+  static constexpr size_t kMaxLeaseTermMultiplier = 16;
+
+  struct Stats {
+    // The number of times the threads were merged and un-merged.
+    size_t merge_count;
+    size_t unmerge_count;
+    // The factor the lease terms are currently multiplied by.
+    size_t lease_term_multiplier;
+  };
+
   // Merges the raster thread into platform thread for the duration of
   // the lease term. Lease is managed by the caller by either calling
   // |ExtendLeaseTo| or |DecrementLease|.
@@ -32,6 +44,12 @@ class RasterThreadMerger
   // are going to remain merged until 2 invocations of |DecreaseLease|,
   // unless an |ExtendLeaseTo| gets called.
   //
+  // To avoid merging and un-merging the threads back and forth when platform
+  // views come and go, the lease term is doubled, up to
+  // |kMaxLeaseTermMultiplier| times, each time the threads are merged again
+  // before they stayed un-merged for as many frames as the previous lease
+  // term. It goes back to the given lease term once they do.
+  //
   // If the task queues are the same, we consider them statically merged.
   // When task queues are statically merged this method becomes no-op.
   void MergeWithLease(size_t lease_term);
@@ -93,6 +111,9 @@ class RasterThreadMerger
   // the next task from a different thread.
   void SetMergeUnmergeCallback(const fml::closure& callback);
 
+  // Counters of the merge transitions, which are also traced.
+  Stats GetStats();
+
  private:
   static const int kLeaseNotSet;
   fml::TaskQueueId platform_queue_id_;
@@ -103,11 +124,24 @@ class RasterThreadMerger
   std::mutex lease_term_mutex_;
   fml::closure merge_unmerge_callback_;
   bool enabled_;
+  // Whether the threads were last un-merged by the expiry of their lease, and
+  // the number of |DecrementLease| calls since.
+  bool lease_expired_ = false;
+  size_t frames_since_unmerge_ = 0;
+  // The lease term of the last merge, including the multiplier.
+  size_t last_lease_term_ = 0;
+  size_t lease_term_multiplier_ = 1;
+  size_t merge_count_ = 0;
+  size_t unmerge_count_ = 0;
 
   bool IsMergedUnSafe() const;
 
   bool IsEnabledUnSafe() const;
 
+  void UnMergeNowUnSafe();
+
+  void TraceStatsUnSafe() const;
+
   // The platform_queue_id and gpu_queue_id are exactly the same.
   // We consider the threads are always merged and cannot be unmerged.
   bool TaskQueuesAreSame() const;
@@ -628,5 +628,120 @@ TEST(RasterThreadMerger, SetMergeUnmergeCallback) {
   thread2.join();
 }
 
+TEST(RasterThreadMerger, LeaseTermGrowsWhenThreadsAreMergedRepeatedly) {
+  fml::MessageLoop* loop1 = nullptr;
+  fml::AutoResetWaitableEvent latch1;
+  fml::AutoResetWaitableEvent term1;
+  std::thread thread1([&loop1, &latch1, &term1]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    loop1 = &fml::MessageLoop::GetCurrent();
+    latch1.Signal();
+    term1.Wait();
+  });
+
+  fml::MessageLoop* loop2 = nullptr;
+  fml::AutoResetWaitableEvent latch2;
+  fml::AutoResetWaitableEvent term2;
+  std::thread thread2([&loop2, &latch2, &term2]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    loop2 = &fml::MessageLoop::GetCurrent();
+    latch2.Signal();
+    term2.Wait();
+  });
+
+  latch1.Wait();
+  latch2.Wait();
+
+  fml::TaskQueueId qid1 = loop1->GetTaskRunner()->GetTaskQueueId();
+  fml::TaskQueueId qid2 = loop2->GetTaskRunner()->GetTaskQueueId();
+  const auto raster_thread_merger_ =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+  const size_t kNumFramesMerged = 2;
+
+  // Returns the number of frames the threads stay merged for.
+  auto merge = [&]() {
+    raster_thread_merger_->MergeWithLease(kNumFramesMerged);
+    size_t frames = 0;
+    while (raster_thread_merger_->DecrementLease() !=
+           fml::RasterThreadStatus::kUnmergedNow) {
+      frames++;
+    }
+    return frames + 1;
+  };
+
+  ASSERT_EQ(merge(), kNumFramesMerged);
+  // Merging again right after the lease expired doubles the lease term.
+  ASSERT_EQ(merge(), kNumFramesMerged * 2);
+  ASSERT_EQ(merge(), kNumFramesMerged * 4);
+  for (int i = 0; i < 10; i++) {
+    merge();
+  }
+  const size_t kMaxLeaseTerm =
+      kNumFramesMerged * fml::RasterThreadMerger::kMaxLeaseTermMultiplier;
+  ASSERT_EQ(merge(), kMaxLeaseTerm);
+
+  // Staying un-merged for as long as the last lease term resets it.
+  for (size_t i = 0; i < kMaxLeaseTerm; i++) {
+    ASSERT_EQ(raster_thread_merger_->DecrementLease(),
+              fml::RasterThreadStatus::kRemainsUnmerged);
+  }
+  ASSERT_EQ(merge(), kNumFramesMerged);
+
+  auto stats = raster_thread_merger_->GetStats();
+  ASSERT_EQ(stats.merge_count, 15u);
+  ASSERT_EQ(stats.unmerge_count, 15u);
+  ASSERT_EQ(stats.lease_term_multiplier, 1u);
+
+  term1.Signal();
+  term2.Signal();
+  thread1.join();
+  thread2.join();
+}
+
+TEST(RasterThreadMerger, UnMergeNowDoesNotGrowTheLeaseTerm) {
+  fml::MessageLoop* loop1 = nullptr;
+  fml::AutoResetWaitableEvent latch1;
+  fml::AutoResetWaitableEvent term1;
+  std::thread thread1([&loop1, &latch1, &term1]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    loop1 = &fml::MessageLoop::GetCurrent();
+    latch1.Signal();
+    term1.Wait();
+  });
+
+  fml::MessageLoop* loop2 = nullptr;
+  fml::AutoResetWaitableEvent latch2;
+  fml::AutoResetWaitableEvent term2;
+  std::thread thread2([&loop2, &latch2, &term2]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    loop2 = &fml::MessageLoop::GetCurrent();
+    latch2.Signal();
+    term2.Wait();
+  });
+
+  latch1.Wait();
+  latch2.Wait();
+
+  fml::TaskQueueId qid1 = loop1->GetTaskRunner()->GetTaskQueueId();
+  fml::TaskQueueId qid2 = loop2->GetTaskRunner()->GetTaskQueueId();
+  const auto raster_thread_merger_ =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+
+  for (int i = 0; i < 3; i++) {
+    raster_thread_merger_->MergeWithLease(1);
+    raster_thread_merger_->UnMergeNow();
+  }
+  ASSERT_EQ(raster_thread_merger_->GetStats().lease_term_multiplier, 1u);
+
+  raster_thread_merger_->MergeWithLease(1);
+  ASSERT_EQ(raster_thread_merger_->DecrementLease(),
+            fml::RasterThreadStatus::kUnmergedNow);
+
+  term1.Signal();
+  term2.Signal();
+  thread1.join();
+  thread2.join();
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -22,7 +22,7 @@ class SharedMutexStd : public SharedMutex {
   friend SharedMutex* SharedMutex::Create();
   SharedMutexStd() = default;
 
-  std::shared_timed_mutex mutex_;
+  std::shared_mutex mutex_;
 };
 
 }  // namespace fml
@@ -5,19 +5,20 @@
 #ifndef FLUTTER_FML_SYNCHRONIZATION_SYNC_SWITCH_H_
 #define FLUTTER_FML_SYNCHRONIZATION_SYNC_SWITCH_H_
 
-#include <forward_list>
 #include <functional>
-#include <mutex>
+#include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/shared_mutex.h"
 
 namespace fml {
 
 /// A threadsafe structure that allows you to switch between 2 different
 /// execution paths.
 ///
-/// Execution and setting the switch is exclusive, i.e. only one will happen
-/// at a time.
+/// Setting the switch is exclusive with execution, i.e. it waits for the
+/// handlers that are running to return. Executions on different threads do not
+/// exclude each other since the switch is read far more often than it is set.
 class SyncSwitch {
  public:
   /// Represents the 2 code paths available when calling |SyncSwitch::Execute|.
@@ -56,7 +57,7 @@ class SyncSwitch {
   void SetSwitch(bool value);
 
  private:
-  std::mutex mutex_;
+  std::unique_ptr<SharedMutex> mutex_;
   bool value_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SyncSwitch);
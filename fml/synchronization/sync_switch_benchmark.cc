@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/sync_switch.h"
+
+#include <memory>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/shared_mutex.h"
+
+namespace fml {
+namespace benchmarking {
+
+static void BM_SyncSwitchExecute(benchmark::State& state) {  // NOLINT
+  static SyncSwitch sync_switch;
+  int count = 0;
+  const auto handlers =
+      SyncSwitch::Handlers().SetIfFalse([&count] { count++; });
+  for (auto _ : state) {
+    sync_switch.Execute(handlers);
+  }
+  benchmark::DoNotOptimize(count);
+}
+
+static void BM_SharedMutexLockShared(benchmark::State& state) {  // NOLINT
+  static std::unique_ptr<SharedMutex> mutex(SharedMutex::Create());
+  for (auto _ : state) {
+    SharedLock lock(*mutex);
+  }
+}
+
+static void BM_SharedMutexLock(benchmark::State& state) {  // NOLINT
+  static std::unique_ptr<SharedMutex> mutex(SharedMutex::Create());
+  for (auto _ : state) {
+    UniqueLock lock(*mutex);
+  }
+}
+
+BENCHMARK(BM_SyncSwitchExecute)->ThreadRange(1, 8);
+BENCHMARK(BM_SharedMutexLockShared)->ThreadRange(1, 8);
+BENCHMARK(BM_SharedMutexLock)->ThreadRange(1, 8);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -4,6 +4,10 @@
 
 #include "flutter/fml/synchronization/sync_switch.h"
 
+#include <thread>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"
 
 using fml::SyncSwitch;
@@ -28,3 +32,45 @@ TEST(SyncSwitchTest, NoopIfUndefined) {
   syncSwitch.Execute(SyncSwitch::Handlers());
   EXPECT_FALSE(switchValue);
 }
+
+TEST(SyncSwitchTest, ExecutionsDoNotExcludeEachOther) {
+  SyncSwitch syncSwitch;
+  fml::CountDownLatch latch(2);
+  auto execute = [&] {
+    // Each execution waits for the other one to start, this would deadlock if
+    // executions were exclusive.
+    syncSwitch.Execute(SyncSwitch::Handlers().SetIfFalse([&] {
+      latch.CountDown();
+      latch.Wait();
+    }));
+  };
+  std::thread thread(execute);
+  execute();
+  thread.join();
+}
+
+TEST(SyncSwitchTest, SetSwitchWaitsForExecutions) {
+  SyncSwitch syncSwitch;
+  fml::AutoResetWaitableEvent started;
+  fml::AutoResetWaitableEvent finish;
+  bool executed = false;
+  std::thread thread([&] {
+    syncSwitch.Execute(SyncSwitch::Handlers().SetIfFalse([&] {
+      started.Signal();
+      finish.Wait();
+      executed = true;
+    }));
+  });
+  started.Wait();
+  std::thread setter([&] {
+    syncSwitch.SetSwitch(true);
+    EXPECT_TRUE(executed);
+  });
+  finish.Signal();
+  setter.join();
+  thread.join();
+  bool switchValue = false;
+  syncSwitch.Execute(
+      SyncSwitch::Handlers().SetIfTrue([&] { switchValue = true; }));
+  EXPECT_TRUE(switchValue);
+}
@@ -35,6 +35,18 @@ void TaskRunner::PostDelayedTask(const fml::closure& task,
   loop_->PostTask(task, fml::TimePoint::Now() + delay);
 }
 
+void TaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                      TaskPriority priority) {
+  loop_->PostTask(task, fml::TimePoint::Now(), priority);
+}
+
+void TaskRunner::PostTaskForTimeWithPriority(const fml::closure& task,
+                                             fml::TimePoint target_time,
+                                             TaskPriority priority,
+                                             fml::TimePoint deadline) {
+  loop_->PostTask(task, target_time, priority, deadline);
+}
+
 TaskQueueId TaskRunner::GetTaskQueueId() {
   FML_DCHECK(loop_);
   return loop_->GetTaskQueueId();
@@ -33,6 +33,18 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
 
   virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
 
+  // Posts a task in the lane for |priority|. Task runners that are not backed
+  // by an |fml::MessageLoop| ignore the priority.
+  virtual void PostTaskWithPriority(const fml::closure& task,
+                                    TaskPriority priority);
+
+  // Posts a task in the lane for |priority| that runs as a critical task if
+  // it is still pending at |deadline|.
+  virtual void PostTaskForTimeWithPriority(const fml::closure& task,
+                                           fml::TimePoint target_time,
+                                           TaskPriority priority,
+                                           fml::TimePoint deadline);
+
   virtual bool RunsTasksOnCurrentThread();
 
   virtual TaskQueueId GetTaskQueueId();
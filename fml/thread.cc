@@ -10,6 +10,7 @@
 #include <string>
 
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 
@@ -21,19 +22,56 @@
 #include <pthread.h>
 #endif
 
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace fml {
 
-Thread::Thread(const std::string& name) : joined_(false) {
+Thread::Thread(const std::string& name) : Thread(ThreadConfig(name)) {}
+
+Thread::Thread(const ThreadConfig& config) : Thread(nullptr, config) {}
+
+Thread::Thread(const ThreadLauncher& launcher, const ThreadConfig& config)
+    : joined_(false) {
   fml::AutoResetWaitableEvent latch;
   fml::RefPtr<fml::TaskRunner> runner;
-  thread_ = std::make_unique<std::thread>([&latch, &runner, name]() -> void {
-    SetCurrentThreadName(name);
+  auto thread_main = [&latch, &runner]() -> void {
     fml::MessageLoop::EnsureInitializedForCurrentThread();
     auto& loop = MessageLoop::GetCurrent();
     runner = loop.GetTaskRunner();
     latch.Signal();
     loop.Run();
-  });
+  };
+
+  if (launcher) {
+    auto exited = std::make_shared<fml::ManualResetWaitableEvent>();
+    if (launcher(config, [thread_main, exited]() {
+          thread_main();
+          exited->Signal();
+        })) {
+      launched_thread_exited_ = std::move(exited);
+    } else {
+      FML_LOG(ERROR) << "Could not launch the thread '" << config.name
+                     << "', starting it with the default launcher.";
+    }
+  }
+
+  if (!launched_thread_exited_) {
+    thread_ = std::make_unique<std::thread>([thread_main, config]() -> void {
+      SetCurrentThreadName(config.name);
+      if (config.priority != ThreadPriority::kNormal) {
+        SetCurrentThreadPriority(config.priority);
+      }
+      if (config.affinity.has_value()) {
+        RequestAffinity(config.affinity.value());
+      }
+      thread_main();
+    });
+  }
+
   latch.Wait();
   task_runner_ = runner;
 }
@@ -52,7 +90,11 @@ void Thread::Join() {
   }
   joined_ = true;
   task_runner_->PostTask([]() { MessageLoop::GetCurrent().Terminate(); });
-  thread_->join();
+  if (thread_) {
+    thread_->join();
+  } else {
+    launched_thread_exited_->Wait();
+  }
 }
 
 #if defined(OS_WIN)
@@ -94,4 +136,79 @@ void Thread::SetCurrentThreadName(const std::string& name) {
 #endif
 }
 
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+static bool SetCurrentThreadNiceValue(int nice_value) {
+#if defined(OS_ANDROID)
+  const pid_t tid = gettid();
+#else
+  const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+#endif
+  return ::setpriority(PRIO_PROCESS, tid, nice_value) == 0;
+}
+#endif
+
+void Thread::SetCurrentThreadPriority(ThreadPriority priority) {
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+  bool success = false;
+  switch (priority) {
+    case ThreadPriority::kBackground:
+      success = SetCurrentThreadNiceValue(10);
+      break;
+    case ThreadPriority::kNormal:
+      success = SetCurrentThreadNiceValue(0);
+      break;
+    case ThreadPriority::kDisplay:
+      success = SetCurrentThreadNiceValue(-1);
+      break;
+    case ThreadPriority::kRaster:
+      // Android describes -8 as "most important display threads, for
+      // compositing the screen and retrieving input events". Conservatively
+      // set the raster thread to slightly lower priority than it. Depending on
+      // the OEM, it may not be possible to set priority to -5.
+      success = SetCurrentThreadNiceValue(-5) || SetCurrentThreadNiceValue(-2);
+      break;
+  }
+  if (!success) {
+    // Unprivileged Linux processes may not raise the priority of threads.
+    FML_DLOG(ERROR) << "Failed to set the priority of the current thread.";
+  }
+#elif defined(OS_MACOSX)
+  qos_class_t qos_class = QOS_CLASS_DEFAULT;
+  switch (priority) {
+    case ThreadPriority::kBackground:
+      qos_class = QOS_CLASS_UTILITY;
+      break;
+    case ThreadPriority::kNormal:
+      qos_class = QOS_CLASS_DEFAULT;
+      break;
+    case ThreadPriority::kDisplay:
+    case ThreadPriority::kRaster:
+      qos_class = QOS_CLASS_USER_INTERACTIVE;
+      break;
+  }
+  if (pthread_set_qos_class_self_np(qos_class, 0) != 0) {
+    FML_DLOG(ERROR) << "Failed to set the QoS class of the current thread.";
+  }
+#elif defined(OS_WIN)
+  int thread_priority = THREAD_PRIORITY_NORMAL;
+  switch (priority) {
+    case ThreadPriority::kBackground:
+      thread_priority = THREAD_PRIORITY_BELOW_NORMAL;
+      break;
+    case ThreadPriority::kNormal:
+      thread_priority = THREAD_PRIORITY_NORMAL;
+      break;
+    case ThreadPriority::kDisplay:
+    case ThreadPriority::kRaster:
+      thread_priority = THREAD_PRIORITY_ABOVE_NORMAL;
+      break;
+  }
+  if (!SetThreadPriority(GetCurrentThread(), thread_priority)) {
+    FML_DLOG(ERROR) << "Failed to set the priority of the current thread.";
+  }
+#else
+  FML_DLOG(INFO) << "Could not set the thread priority on this platform.";
+#endif
+}
+
 }  // namespace fml
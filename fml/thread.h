@@ -6,18 +6,63 @@
 #define FLUTTER_FML_THREAD_H_
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <thread>
 
+#include "flutter/fml/closure.h"
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/task_runner.h"
 
 namespace fml {
 
 class Thread {
  public:
+  // The scheduling priority of a thread. It maps to a nice value on Android
+  // and Linux, to a QoS class on Apple platforms and to a thread priority on
+  // Windows. Platforms without thread priorities ignore it.
+  enum class ThreadPriority {
+    // For threads that must not compete with the rendering of frames.
+    kBackground,
+    // The default priority of new threads.
+    kNormal,
+    // For threads that produce the content of frames, like the UI thread.
+    kDisplay,
+    // For threads that rasterize frames.
+    kRaster,
+  };
+
+  struct ThreadConfig {
+    explicit ThreadConfig(const std::string& name = "",
+                          ThreadPriority priority = ThreadPriority::kNormal,
+                          std::optional<CpuAffinity> affinity = std::nullopt)
+        : name(name), priority(priority), affinity(affinity) {}
+
+    std::string name;
+    ThreadPriority priority;
+    // The cores the thread should run on, or |std::nullopt| to let the
+    // scheduler decide.
+    std::optional<CpuAffinity> affinity;
+  };
+
+  // Starts a thread described by |config| that runs |entry|, for hosts that
+  // manage all the threads of the process. The launcher is responsible for
+  // the name, priority and affinity of the thread. The thread must not be
+  // used for anything else until |entry| returns. Returns false if the thread
+  // could not be started, in which case a thread is started by |fml| instead.
+  using ThreadLauncher =
+      std::function<bool(const ThreadConfig& config, fml::closure entry)>;
+
   explicit Thread(const std::string& name = "");
 
+  explicit Thread(const ThreadConfig& config);
+
+  Thread(const ThreadLauncher& launcher, const ThreadConfig& config);
+
   ~Thread();
 
   fml::RefPtr<fml::TaskRunner> GetTaskRunner() const;
@@ -26,8 +71,12 @@ class Thread {
 
   static void SetCurrentThreadName(const std::string& name);
 
+  static void SetCurrentThreadPriority(ThreadPriority priority);
+
  private:
   std::unique_ptr<std::thread> thread_;
+  // Signaled when a thread started by a |ThreadLauncher| exits.
+  std::shared_ptr<fml::ManualResetWaitableEvent> launched_thread_exited_;
   fml::RefPtr<fml::TaskRunner> task_runner_;
   std::atomic_bool joined_;
 
@@ -4,8 +4,18 @@
 
 #include "flutter/fml/thread.h"
 
+#include <string>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
 #include "gtest/gtest.h"
 
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 TEST(Thread, CanStartAndEnd) {
   fml::Thread thread;
   ASSERT_TRUE(thread.GetTaskRunner());
@@ -24,3 +34,69 @@ TEST(Thread, HasARunningMessageLoop) {
   thread.Join();
   ASSERT_TRUE(done);
 }
+
+TEST(Thread, CanStartWithConfig) {
+  fml::Thread thread(fml::Thread::ThreadConfig(
+      "io.flutter.test.background",
+      fml::Thread::ThreadPriority::kBackground));
+  bool done = false;
+  thread.GetTaskRunner()->PostTask([&done]() { done = true; });
+  thread.Join();
+  ASSERT_TRUE(done);
+}
+
+TEST(Thread, CanStartWithLauncher) {
+  std::vector<std::thread> launched_threads;
+  std::string launched_name;
+  fml::Thread::ThreadLauncher launcher =
+      [&](const fml::Thread::ThreadConfig& config, fml::closure entry) {
+        launched_name = config.name;
+        launched_threads.emplace_back(entry);
+        return true;
+      };
+  {
+    fml::Thread thread(launcher,
+                       fml::Thread::ThreadConfig("io.flutter.test.launched"));
+    bool done = false;
+    std::thread::id task_thread_id;
+    thread.GetTaskRunner()->PostTask([&]() {
+      task_thread_id = std::this_thread::get_id();
+      done = true;
+    });
+    thread.Join();
+    ASSERT_TRUE(done);
+    ASSERT_EQ(launched_threads.size(), 1u);
+    ASSERT_EQ(task_thread_id, launched_threads.front().get_id());
+  }
+  ASSERT_EQ(launched_name, "io.flutter.test.launched");
+  for (auto& launched_thread : launched_threads) {
+    launched_thread.join();
+  }
+}
+
+TEST(Thread, FallsBackWhenLauncherFails) {
+  fml::Thread::ThreadLauncher launcher =
+      [](const fml::Thread::ThreadConfig& config, fml::closure entry) {
+        return false;
+      };
+  fml::Thread thread(launcher, fml::Thread::ThreadConfig("io.flutter.test"));
+  bool done = false;
+  thread.GetTaskRunner()->PostTask([&done]() { done = true; });
+  thread.Join();
+  ASSERT_TRUE(done);
+}
+
+#if defined(OS_ANDROID) || defined(OS_LINUX)
+TEST(Thread, BackgroundPriorityLowersNiceValue) {
+  fml::Thread thread(fml::Thread::ThreadConfig(
+      "io.flutter.test.background",
+      fml::Thread::ThreadPriority::kBackground));
+  int nice_value = 0;
+  thread.GetTaskRunner()->PostTask([&nice_value]() {
+    nice_value = getpriority(PRIO_PROCESS,
+                             static_cast<id_t>(syscall(SYS_gettid)));
+  });
+  thread.Join();
+  ASSERT_EQ(nice_value, 10);
+}
+#endif
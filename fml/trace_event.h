@@ -43,6 +43,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_recorder.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA))
@@ -56,9 +57,17 @@
 
 #define __FML__TOKEN_CAT__(x, y) x##y
 #define __FML__TOKEN_CAT__2(x, y) __FML__TOKEN_CAT__(x, y)
-#define __FML__AUTO_TRACE_END(name)                                  \
+#define __FML__AUTO_TRACE_END(category_group, name)                  \
   ::fml::tracing::ScopedInstantEnd __FML__TOKEN_CAT__2(__trace_end_, \
-                                                       __LINE__)(name);
+                                                       __LINE__)(    \
+      category_group, name);
+
+// Records the event in the |TraceRecorder| as well. The names passed to the
+// macros are static strings.
+#define __FML__TRACE_RECORD(type, category_group, name, id)             \
+  ::fml::tracing::TraceRecorder::Record(                                \
+      ::fml::tracing::TraceRecorder::EventType::type, (category_group), \
+      (name), (id))
 
 // This macro has the FML_ prefix so that it does not collide with the macros
 // from lib/trace/event.h on Fuchsia.
@@ -70,47 +79,55 @@
 
 #define FML_TRACE_EVENT(category_group, name, ...)                   \
   ::fml::tracing::TraceEvent((category_group), (name), __VA_ARGS__); \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(category_group, name)
 
 #define TRACE_EVENT0(category_group, name)           \
   ::fml::tracing::TraceEvent0(category_group, name); \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(category_group, name)
 
 #define TRACE_EVENT1(category_group, name, arg1_name, arg1_val)           \
   ::fml::tracing::TraceEvent1(category_group, name, arg1_name, arg1_val); \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(category_group, name)
 
 #define TRACE_EVENT2(category_group, name, arg1_name, arg1_val, arg2_name, \
                      arg2_val)                                             \
   ::fml::tracing::TraceEvent2(category_group, name, arg1_name, arg1_val,   \
                               arg2_name, arg2_val);                        \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(category_group, name)
 
-#define TRACE_EVENT_ASYNC_BEGIN0(category_group, name, id) \
-  ::fml::tracing::TraceEventAsyncBegin0(category_group, name, id);
+#define TRACE_EVENT_ASYNC_BEGIN0(category_group, name, id)         \
+  ::fml::tracing::TraceEventAsyncBegin0(category_group, name, id), \
+      __FML__TRACE_RECORD(kAsyncBegin, category_group, name, id);
 
-#define TRACE_EVENT_ASYNC_END0(category_group, name, id) \
-  ::fml::tracing::TraceEventAsyncEnd0(category_group, name, id);
+#define TRACE_EVENT_ASYNC_END0(category_group, name, id)         \
+  ::fml::tracing::TraceEventAsyncEnd0(category_group, name, id), \
+      __FML__TRACE_RECORD(kAsyncEnd, category_group, name, id);
 
 #define TRACE_EVENT_ASYNC_BEGIN1(category_group, name, id, arg1_name,        \
                                  arg1_val)                                   \
   ::fml::tracing::TraceEventAsyncBegin1(category_group, name, id, arg1_name, \
-                                        arg1_val);
+                                        arg1_val),                           \
+      __FML__TRACE_RECORD(kAsyncBegin, category_group, name, id);
 
 #define TRACE_EVENT_ASYNC_END1(category_group, name, id, arg1_name, arg1_val) \
   ::fml::tracing::TraceEventAsyncEnd1(category_group, name, id, arg1_name,    \
-                                      arg1_val);
+                                      arg1_val),                              \
+      __FML__TRACE_RECORD(kAsyncEnd, category_group, name, id);
 
-#define TRACE_EVENT_INSTANT0(category_group, name) \
-  ::fml::tracing::TraceEventInstant0(category_group, name);
+#define TRACE_EVENT_INSTANT0(category_group, name)          \
+  ::fml::tracing::TraceEventInstant0(category_group, name), \
+      __FML__TRACE_RECORD(kInstant, category_group, name, 0);
 
 #define TRACE_EVENT_INSTANT1(category_group, name, arg1_name, arg1_val) \
-  ::fml::tracing::TraceEventInstant1(category_group, name, arg1_name, arg1_val);
+  ::fml::tracing::TraceEventInstant1(category_group, name, arg1_name,   \
+                                     arg1_val),                         \
+      __FML__TRACE_RECORD(kInstant, category_group, name, 0);
 
 #define TRACE_EVENT_INSTANT2(category_group, name, arg1_name, arg1_val, \
                              arg2_name, arg2_val)                       \
   ::fml::tracing::TraceEventInstant2(category_group, name, arg1_name,   \
-                                     arg1_val, arg2_name, arg2_val);
+                                     arg1_val, arg2_name, arg2_val),    \
+      __FML__TRACE_RECORD(kInstant, category_group, name, 0);
 
 #define TRACE_FLOW_BEGIN(category, name, id) \
   ::fml::tracing::TraceEventFlowBegin0(category, name, id);
@@ -316,13 +333,22 @@ void TraceEventFlowStep0(TraceArg category_group, TraceArg name, TraceIDArg id);
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id);
 
+// Ends the timeline event started by the |TRACE_EVENT| macros when it goes
+// out of scope. The whole event is recorded in the |TraceRecorder| as well.
 class ScopedInstantEnd {
  public:
-  ScopedInstantEnd(const char* str) : label_(str) {}
+  ScopedInstantEnd(const char* category, const char* str)
+      : category_(category), label_(str) {
+    TraceRecorder::Record(TraceRecorder::EventType::kBegin, category_, label_);
+  }
 
-  ~ScopedInstantEnd() { TraceEventEnd(label_); }
+  ~ScopedInstantEnd() {
+    TraceEventEnd(label_);
+    TraceRecorder::Record(TraceRecorder::EventType::kEnd, category_, label_);
+  }
 
  private:
+  const char* category_;
   const char* label_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ScopedInstantEnd);
@@ -0,0 +1,289 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// A ring buffer written by a single thread and read by any thread.
+//
+// The writer bumps |begin_count_| before it overwrites a slot and
+// |end_count_| once the slot is complete. A reader copies the slots up to
+// |end_count_| and then discards the copies of the slots that a write started
+// since may have overwritten, like a sequence lock.
+class ThreadBuffer {
+ public:
+  void Write(size_t thread_id,
+             TraceRecorder::EventType type,
+             const char* category,
+             const char* name,
+             int64_t id,
+             const char* arg_name,
+             int64_t arg_value) {
+    const uint64_t index = end_count_.load(std::memory_order_relaxed);
+    begin_count_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot& slot = slots_[index % TraceRecorder::kEventsPerThread];
+    slot.type.store(type, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.timestamp_micros.store(
+        TimePoint::Now().ToEpochDelta().ToMicroseconds(),
+        std::memory_order_relaxed);
+    slot.id.store(id, std::memory_order_relaxed);
+    slot.arg_name.store(arg_name, std::memory_order_relaxed);
+    slot.arg_value.store(arg_value, std::memory_order_relaxed);
+    slot.thread_id.store(thread_id, std::memory_order_relaxed);
+
+    end_count_.store(index + 1, std::memory_order_release);
+  }
+
+  void Read(std::vector<TraceRecorder::Event>& events) const {
+    const uint64_t end = end_count_.load(std::memory_order_acquire);
+    const uint64_t begin = std::max(
+        discard_before_.load(std::memory_order_relaxed),
+        end > TraceRecorder::kEventsPerThread
+            ? end - TraceRecorder::kEventsPerThread
+            : 0);
+    if (begin >= end) {
+      return;
+    }
+
+    std::vector<TraceRecorder::Event> copies;
+    copies.reserve(end - begin);
+    for (uint64_t index = begin; index < end; index++) {
+      const Slot& slot = slots_[index % TraceRecorder::kEventsPerThread];
+      copies.push_back({
+          slot.type.load(std::memory_order_relaxed),
+          slot.category.load(std::memory_order_relaxed),
+          slot.name.load(std::memory_order_relaxed),
+          slot.timestamp_micros.load(std::memory_order_relaxed),
+          slot.id.load(std::memory_order_relaxed),
+          slot.arg_name.load(std::memory_order_relaxed),
+          slot.arg_value.load(std::memory_order_relaxed),
+          slot.thread_id.load(std::memory_order_relaxed),
+      });
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t started = begin_count_.load(std::memory_order_relaxed);
+    const uint64_t valid_begin =
+        started > TraceRecorder::kEventsPerThread
+            ? started - TraceRecorder::kEventsPerThread
+            : 0;
+    const size_t skip = valid_begin > begin ? valid_begin - begin : 0;
+    if (skip < copies.size()) {
+      events.insert(events.end(), copies.begin() + skip, copies.end());
+    }
+  }
+
+  void Clear() {
+    discard_before_.store(end_count_.load(std::memory_order_acquire),
+                          std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<TraceRecorder::EventType> type;
+    std::atomic<const char*> category;
+    std::atomic<const char*> name;
+    std::atomic<int64_t> timestamp_micros;
+    std::atomic<int64_t> id;
+    std::atomic<const char*> arg_name;
+    std::atomic<int64_t> arg_value;
+    std::atomic<size_t> thread_id;
+  };
+
+  std::atomic<uint64_t> begin_count_ = {0};
+  std::atomic<uint64_t> end_count_ = {0};
+  std::atomic<uint64_t> discard_before_ = {0};
+  std::array<Slot, TraceRecorder::kEventsPerThread> slots_;
+};
+
+// The buffers of all the threads that recorded events. Buffers are never
+// freed. The buffer of a thread that exited is handed to the next thread
+// that starts recording.
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::vector<ThreadBuffer*> free_buffers;
+  size_t last_thread_id = 0;
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+// The buffer of the current thread. Null if the thread could not get one.
+struct ThreadState {
+  ThreadBuffer* buffer = nullptr;
+  size_t thread_id = 0;
+
+  ~ThreadState() {
+    if (buffer) {
+      Registry& registry = GetRegistry();
+      std::scoped_lock lock(registry.mutex);
+      registry.free_buffers.push_back(buffer);
+    }
+  }
+};
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadState> tls_thread_state;
+
+ThreadState& GetThreadState() {
+  ThreadState* state = tls_thread_state.get();
+  if (state) {
+    return *state;
+  }
+
+  state = new ThreadState();
+  Registry& registry = GetRegistry();
+  {
+    std::scoped_lock lock(registry.mutex);
+    if (!registry.free_buffers.empty()) {
+      state->buffer = registry.free_buffers.back();
+      registry.free_buffers.pop_back();
+    } else if (registry.buffers.size() < TraceRecorder::kMaxThreads) {
+      registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+      state->buffer = registry.buffers.back().get();
+    }
+    state->thread_id = ++registry.last_thread_id;
+  }
+  tls_thread_state.reset(state);
+  return *state;
+}
+
+const char* GetPhase(TraceRecorder::EventType type) {
+  switch (type) {
+    case TraceRecorder::EventType::kBegin:
+      return "B";
+    case TraceRecorder::EventType::kEnd:
+      return "E";
+    case TraceRecorder::EventType::kInstant:
+      return "i";
+    case TraceRecorder::EventType::kAsyncBegin:
+      return "b";
+    case TraceRecorder::EventType::kAsyncEnd:
+      return "e";
+  }
+  return "i";
+}
+
+void WriteJSONString(std::ostream& stream, const char* string) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  stream << '"';
+  for (const char* c = string ? string : ""; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          stream << "\\u00" << kHexDigits[(*c >> 4) & 0xf]
+                 << kHexDigits[*c & 0xf];
+        } else {
+          stream << *c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+}  // namespace
+
+std::atomic_bool TraceRecorder::enabled_ = {false};
+
+void TraceRecorder::SetEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::RecordEvent(EventType type,
+                                const char* category,
+                                const char* name,
+                                int64_t id,
+                                const char* arg_name,
+                                int64_t arg_value) {
+  ThreadState& state = GetThreadState();
+  if (state.buffer) {
+    state.buffer->Write(state.thread_id, type, category, name, id, arg_name,
+                        arg_value);
+  }
+}
+
+std::vector<TraceRecorder::Event> TraceRecorder::GetEvents() {
+  std::vector<Event> events;
+  Registry& registry = GetRegistry();
+  {
+    std::scoped_lock lock(registry.mutex);
+    for (const auto& buffer : registry.buffers) {
+      buffer->Read(events);
+    }
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const Event& a, const Event& b) {
+                     return a.timestamp_micros < b.timestamp_micros;
+                   });
+  return events;
+}
+
+std::string TraceRecorder::GetChromeTraceJSON() {
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto& event : GetEvents()) {
+    stream << (first ? "{" : ",{");
+    first = false;
+    stream << "\"name\":";
+    WriteJSONString(stream, event.name);
+    stream << ",\"cat\":";
+    WriteJSONString(stream, event.category);
+    stream << ",\"ph\":\"" << GetPhase(event.type) << "\"";
+    stream << ",\"ts\":" << event.timestamp_micros;
+    stream << ",\"pid\":0,\"tid\":" << event.thread_id;
+    if (event.type == EventType::kInstant) {
+      stream << ",\"s\":\"t\"";
+    }
+    if (event.type == EventType::kAsyncBegin ||
+        event.type == EventType::kAsyncEnd) {
+      stream << ",\"id\":" << event.id;
+    }
+    if (event.arg_name) {
+      stream << ",\"args\":{";
+      WriteJSONString(stream, event.arg_name);
+      stream << ":" << event.arg_value << "}";
+    }
+    stream << "}";
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+void TraceRecorder::Clear() {
+  Registry& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (const auto& buffer : registry.buffers) {
+    buffer->Clear();
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      A trace recorder that does not depend on the Dart timeline and
+///             is cheap enough to be left on in release builds.
+///
+///             Events are recorded into a fixed size ring buffer owned by the
+///             recording thread without taking locks or allocating. Only
+///             pointers to the category, name and argument name are stored,
+///             so these must be static strings, and the only argument that
+///             can be recorded is an integer. The `TRACE_EVENT` macros record
+///             their names here, but not their string arguments.
+///
+///             The recorded events of all threads are collected on demand in
+///             the Chrome JSON trace format, which Perfetto can open.
+///
+class TraceRecorder {
+ public:
+  enum class EventType : uint8_t {
+    kBegin,
+    kEnd,
+    kInstant,
+    kAsyncBegin,
+    kAsyncEnd,
+  };
+
+  struct Event {
+    EventType type;
+    const char* category;
+    const char* name;
+    // Microseconds of the |fml::TimePoint| clock.
+    int64_t timestamp_micros;
+    // The identifier of async events.
+    int64_t id;
+    // Null if the event has no argument.
+    const char* arg_name;
+    int64_t arg_value;
+    // A small integer identifying the recording thread within the process.
+    size_t thread_id;
+  };
+
+  // The number of most recent events kept for each thread.
+  static constexpr size_t kEventsPerThread = 2048;
+
+  // Threads that start recording once this many threads already have, do not
+  // record. This bounds the memory used by the recorder.
+  static constexpr size_t kMaxThreads = 64;
+
+  static void SetEnabled(bool enabled);
+
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  static void Record(EventType type,
+                     const char* category,
+                     const char* name,
+                     int64_t id = 0,
+                     const char* arg_name = nullptr,
+                     int64_t arg_value = 0) {
+    if (IsEnabled()) {
+      RecordEvent(type, category, name, id, arg_name, arg_value);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the events still in the ring buffers of all the
+  ///             threads, ordered by timestamp. May be called on any thread
+  ///             while other threads are recording.
+  ///
+  static std::vector<Event> GetEvents();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the events like |GetEvents| and formats them as a
+  ///             Chrome JSON trace.
+  ///
+  static std::string GetChromeTraceJSON();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all the recorded events. Threads that are recording
+  ///             at the same time may keep some of their events.
+  ///
+  static void Clear();
+
+ private:
+  static std::atomic_bool enabled_;
+
+  static void RecordEvent(EventType type,
+                          const char* category,
+                          const char* name,
+                          int64_t id,
+                          const char* arg_name,
+                          int64_t arg_value);
+
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(TraceRecorder);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+class TraceRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TraceRecorder::Clear();
+    TraceRecorder::SetEnabled(true);
+  }
+
+  void TearDown() override {
+    TraceRecorder::SetEnabled(false);
+    TraceRecorder::Clear();
+  }
+};
+
+TEST_F(TraceRecorderTest, NothingIsRecordedWhenDisabled) {
+  TraceRecorder::SetEnabled(false);
+  TraceRecorder::Record(TraceRecorder::EventType::kInstant, "test", "event");
+  ASSERT_TRUE(TraceRecorder::GetEvents().empty());
+}
+
+TEST_F(TraceRecorderTest, RecordsTraceEventMacros) {
+  {
+    TRACE_EVENT0("test", "scope");
+    TRACE_EVENT_INSTANT0("test", "instant");
+  }
+  TRACE_EVENT_ASYNC_BEGIN0("test", "async", 42);
+
+  auto events = TraceRecorder::GetEvents();
+  ASSERT_EQ(events.size(), 4u);
+  ASSERT_EQ(events[0].type, TraceRecorder::EventType::kBegin);
+  ASSERT_STREQ(events[0].name, "scope");
+  ASSERT_STREQ(events[0].category, "test");
+  ASSERT_EQ(events[1].type, TraceRecorder::EventType::kInstant);
+  ASSERT_STREQ(events[1].name, "instant");
+  ASSERT_EQ(events[2].type, TraceRecorder::EventType::kEnd);
+  ASSERT_STREQ(events[2].name, "scope");
+  ASSERT_EQ(events[3].type, TraceRecorder::EventType::kAsyncBegin);
+  ASSERT_EQ(events[3].id, 42);
+}
+
+TEST_F(TraceRecorderTest, KeepsTheMostRecentEvents) {
+  const size_t count = TraceRecorder::kEventsPerThread + 10;
+  for (size_t i = 0; i < count; i++) {
+    TraceRecorder::Record(TraceRecorder::EventType::kInstant, "test", "event",
+                          0, "index", i);
+  }
+  auto events = TraceRecorder::GetEvents();
+  ASSERT_EQ(events.size(), TraceRecorder::kEventsPerThread);
+  ASSERT_EQ(events.front().arg_value, 10);
+  ASSERT_EQ(events.back().arg_value, static_cast<int64_t>(count - 1));
+}
+
+TEST_F(TraceRecorderTest, CollectsEventsOfAllThreads) {
+  TraceRecorder::Record(TraceRecorder::EventType::kInstant, "test", "main");
+  std::thread thread([]() {
+    TraceRecorder::Record(TraceRecorder::EventType::kInstant, "test", "other");
+  });
+  thread.join();
+
+  auto events = TraceRecorder::GetEvents();
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_NE(events[0].thread_id, events[1].thread_id);
+}
+
+TEST_F(TraceRecorderTest, CanReadWhileRecording) {
+  std::atomic_bool done = false;
+  std::thread thread([&done]() {
+    int64_t value = 0;
+    while (!done) {
+      TraceRecorder::Record(TraceRecorder::EventType::kInstant, "test",
+                            "event", 0, "value", value++);
+    }
+  });
+  for (size_t i = 0; i < 100; i++) {
+    auto events = TraceRecorder::GetEvents();
+    // The events of a thread are consecutive even when the ring buffer wraps
+    // around while it is read.
+    for (size_t j = 1; j < events.size(); j++) {
+      ASSERT_EQ(events[j].arg_value, events[j - 1].arg_value + 1);
+    }
+  }
+  done = true;
+  thread.join();
+}
+
+TEST_F(TraceRecorderTest, FormatsChromeTraceJSON) {
+  TraceRecorder::Record(TraceRecorder::EventType::kInstant, "test",
+                        "quoted \"name\"", 0, "count", 3);
+  auto json = TraceRecorder::GetChromeTraceJSON();
+  ASSERT_EQ(json.find("{\"traceEvents\":[{"), 0u);
+  ASSERT_NE(json.find("\"name\":\"quoted \\\"name\\\"\""), std::string::npos);
+  ASSERT_NE(json.find("\"ph\":\"i\""), std::string::npos);
+  ASSERT_NE(json.find("\"args\":{\"count\":3}"), std::string::npos);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
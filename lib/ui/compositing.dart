@@ -81,6 +81,25 @@ abstract class _EngineLayerWrapper implements EngineLayer {
   }
 }
 
+/// The easing of an animation started with
+/// [TransformEngineLayer.animateTransform] or
+/// [OpacityEngineLayer.animateAlpha].
+///
+/// The curves match the framework curves of the same names.
+enum LayerAnimationCurve {
+  /// Progresses at a constant rate.
+  linear,
+
+  /// Starts slowly and speeds up.
+  easeIn,
+
+  /// Starts quickly and slows down.
+  easeOut,
+
+  /// Starts slowly, speeds up, and slows down again.
+  easeInOut,
+}
+
 /// An opaque handle to a transform engine layer.
 ///
 /// Instances of this class are created by [SceneBuilder.pushTransform].
@@ -92,6 +111,50 @@ abstract class _EngineLayerWrapper implements EngineLayer {
 /// {@endtemplate}
 class TransformEngineLayer extends _EngineLayerWrapper {
   TransformEngineLayer._(EngineLayer nativeLayer) : super._(nativeLayer);
+
+  /// {@template dart.ui.engineLayer.latchTransform}
+  /// Replaces the transform of this layer without building a new scene.
+  ///
+  /// The new transform also applies to scenes containing this layer that
+  /// were already rendered but have not been rasterized yet. This lets
+  /// transform-only updates (such as scroll offsets) computed from the latest
+  /// input reach the screen a frame earlier.
+  ///
+  /// Scenes built afterwards keep using the latched transform when this layer
+  /// is retained, until `oldLayer` updates it again.
+  /// {@endtemplate}
+  void latchTransform(Float64List matrix4) {
+    assert(_matrix4IsValid(matrix4));
+    _nativeLayer._latchTransform(matrix4);
+  }
+
+  /// {@template dart.ui.engineLayer.animateTransform}
+  /// Animates the transform of this layer from `begin` to `end` over
+  /// `duration`, following `curve`, without building new scenes.
+  ///
+  /// The animation starts when this method is called. The engine advances it
+  /// for every frame it draws, and keeps drawing the last rendered scene while
+  /// the animation runs, so that the animation stays smooth while the UI
+  /// thread is busy. Once the animation finishes, the layer keeps the end
+  /// value.
+  ///
+  /// Scenes built afterwards keep animating this layer when it is retained.
+  /// Starting another animation replaces this one, and latching a value stops
+  /// it.
+  ///
+  /// On the web, this method does nothing, and animations have to be driven
+  /// by building new scenes.
+  /// {@endtemplate}
+  ///
+  /// The matrices are interpolated component-wise, which suits translations
+  /// and scales but not rotations.
+  void animateTransform(Float64List begin, Float64List end, Duration duration,
+      {LayerAnimationCurve curve = LayerAnimationCurve.linear}) {
+    assert(_matrix4IsValid(begin));
+    assert(_matrix4IsValid(end));
+    _nativeLayer._animateTransform(
+        begin, end, duration.inMicroseconds, curve.index);
+  }
 }
 
 /// An opaque handle to an offset engine layer.
@@ -101,6 +164,20 @@ class TransformEngineLayer extends _EngineLayerWrapper {
 /// {@macro dart.ui.sceneBuilder.oldLayerCompatibility}
 class OffsetEngineLayer extends _EngineLayerWrapper {
   OffsetEngineLayer._(EngineLayer nativeLayer) : super._(nativeLayer);
+
+  /// Replaces the offset of this layer without building a new scene.
+  ///
+  /// {@macro dart.ui.engineLayer.latchTransform}
+  void latchOffset(double dx, double dy) {
+    final Float64List matrix4 = Float64List(16);
+    matrix4[0] = 1.0;
+    matrix4[5] = 1.0;
+    matrix4[10] = 1.0;
+    matrix4[12] = dx;
+    matrix4[13] = dy;
+    matrix4[15] = 1.0;
+    _nativeLayer._latchTransform(matrix4);
+  }
 }
 
 /// An opaque handle to a clip rect engine layer.
@@ -110,6 +187,14 @@ class OffsetEngineLayer extends _EngineLayerWrapper {
 /// {@macro dart.ui.sceneBuilder.oldLayerCompatibility}
 class ClipRectEngineLayer extends _EngineLayerWrapper {
   ClipRectEngineLayer._(EngineLayer nativeLayer) : super._(nativeLayer);
+
+  /// Replaces the clip rectangle of this layer without building a new scene.
+  ///
+  /// {@macro dart.ui.engineLayer.latchTransform}
+  void latchClipRect(Rect rect) {
+    assert(_rectIsValid(rect));
+    _nativeLayer._latchClipRect(rect.left, rect.right, rect.top, rect.bottom);
+  }
 }
 
 /// An opaque handle to a clip rounded rect engine layer.
@@ -119,6 +204,15 @@ class ClipRectEngineLayer extends _EngineLayerWrapper {
 /// {@macro dart.ui.sceneBuilder.oldLayerCompatibility}
 class ClipRRectEngineLayer extends _EngineLayerWrapper {
   ClipRRectEngineLayer._(EngineLayer nativeLayer) : super._(nativeLayer);
+
+  /// Replaces the clip rounded rectangle of this layer without building a
+  /// new scene.
+  ///
+  /// {@macro dart.ui.engineLayer.latchTransform}
+  void latchClipRRect(RRect rrect) {
+    assert(_rrectIsValid(rrect));
+    _nativeLayer._latchClipRRect(rrect._value32);
+  }
 }
 
 /// An opaque handle to a clip path engine layer.
@@ -130,6 +224,15 @@ class ClipPathEngineLayer extends _EngineLayerWrapper {
   ClipPathEngineLayer._(EngineLayer nativeLayer) : super._(nativeLayer);
 }
 
+/// An opaque handle to a scroll engine layer.
+///
+/// Instances of this class are created by [SceneBuilder.pushScroll].
+///
+/// {@macro dart.ui.sceneBuilder.oldLayerCompatibility}
+class ScrollEngineLayer extends _EngineLayerWrapper {
+  ScrollEngineLayer._(EngineLayer nativeLayer) : super._(nativeLayer);
+}
+
 /// An opaque handle to an opacity engine layer.
 ///
 /// Instances of this class are created by [SceneBuilder.pushOpacity].
@@ -137,6 +240,25 @@ class ClipPathEngineLayer extends _EngineLayerWrapper {
 /// {@macro dart.ui.sceneBuilder.oldLayerCompatibility}
 class OpacityEngineLayer extends _EngineLayerWrapper {
   OpacityEngineLayer._(EngineLayer nativeLayer) : super._(nativeLayer);
+
+  /// Replaces the alpha of this layer without building a new scene.
+  ///
+  /// The `alpha` argument is interpreted like in [SceneBuilder.pushOpacity].
+  ///
+  /// {@macro dart.ui.engineLayer.latchTransform}
+  void latchAlpha(int alpha) {
+    _nativeLayer._latchAlpha(alpha);
+  }
+
+  /// Animates the alpha of this layer from `begin` to `end` over `duration`,
+  /// following `curve`, without building new scenes.
+  ///
+  /// {@macro dart.ui.engineLayer.animateTransform}
+  void animateAlpha(int begin, int end, Duration duration,
+      {LayerAnimationCurve curve = LayerAnimationCurve.linear}) {
+    _nativeLayer._animateAlpha(
+        begin, end, duration.inMicroseconds, curve.index);
+  }
 }
 
 /// An opaque handle to a color filter engine layer.
@@ -401,6 +523,68 @@ class SceneBuilder extends NativeFieldWrapperClass2 {
 
   void _pushClipPath(EngineLayer layer, Path path, int clipBehavior) native 'SceneBuilder_pushClipPath';
 
+  /// Pushes a scroll operation onto the operation stack.
+  ///
+  /// Rasterization outside of `viewport` is discarded, and the children are
+  /// translated by the negation of `offset`, as with a [pushClipRect] with
+  /// [Clip.hardEdge] followed by a [pushOffset].
+  ///
+  /// When the engine scrolls on the raster thread, pointer scroll events over
+  /// `viewport` move the offset of the layer right away, within
+  /// `offsetRange`, without waiting for a new scene. The framework receives
+  /// the same events and is expected to scroll by the same deltas, clamped
+  /// to the same range. The scenes it builds before it received them are
+  /// drawn with the deltas the engine applied ahead of it. `scrollId`
+  /// identifies the scrollable across scenes.
+  ///
+  /// {@macro dart.ui.sceneBuilder.oldLayer}
+  ///
+  /// {@macro dart.ui.sceneBuilder.oldLayerVsRetained}
+  ///
+  /// See [pop] for details about the operation stack.
+  ScrollEngineLayer? pushScroll(
+    Rect viewport,
+    Offset offset, {
+    required int scrollId,
+    required Rect offsetRange,
+    ScrollEngineLayer? oldLayer,
+  }) {
+    assert(_rectIsValid(viewport));
+    assert(_offsetIsValid(offset));
+    assert(_debugCheckCanBeUsedAsOldLayer(oldLayer, 'pushScroll'));
+    final EngineLayer engineLayer = EngineLayer._();
+    _pushScroll(
+        engineLayer,
+        scrollId,
+        viewport.left,
+        viewport.right,
+        viewport.top,
+        viewport.bottom,
+        offset.dx,
+        offset.dy,
+        offsetRange.left,
+        offsetRange.right,
+        offsetRange.top,
+        offsetRange.bottom);
+    final ScrollEngineLayer layer = ScrollEngineLayer._(engineLayer);
+    assert(_debugPushLayer(layer));
+    return layer;
+  }
+
+  void _pushScroll(
+      EngineLayer outEngineLayer,
+      int scrollId,
+      double left,
+      double right,
+      double top,
+      double bottom,
+      double dx,
+      double dy,
+      double minDx,
+      double maxDx,
+      double minDy,
+      double maxDy) native 'SceneBuilder_pushScroll';
+
   /// Pushes an opacity operation onto the operation stack.
   ///
   /// The given alpha value is blended into the alpha value of the objects'
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/compositing/scene.h"
 
+#include "flutter/common/constants.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/picture.h"
@@ -42,7 +43,7 @@ Scene::Scene(std::shared_ptr<flutter::Layer> rootLayer,
              uint32_t rasterizerTracingThreshold,
              bool checkerboardRasterCacheImages,
              bool checkerboardOffscreenLayers) {
-  // Currently only supports a single window.
+  // Sized for the implicit view until the scene is rendered into a view.
   auto viewport_metrics = UIDartState::Current()
                               ->platform_configuration()
                               ->get_window(0)
@@ -82,7 +83,21 @@ Dart_Handle Scene::toImage(uint32_t width,
   return Picture::RasterizeToImage(picture, width, height, raw_image_callback);
 }
 
-std::unique_ptr<flutter::LayerTree> Scene::takeLayerTree() {
+std::unique_ptr<flutter::LayerTree> Scene::takeLayerTree(int64_t view_id) {
+  if (!layer_tree_ || view_id == kFlutterImplicitViewId) {
+    return std::move(layer_tree_);
+  }
+  Window* window =
+      UIDartState::Current()->platform_configuration()->get_window(view_id);
+  if (!window) {
+    return nullptr;
+  }
+  const ViewportMetrics& viewport_metrics = window->viewport_metrics();
+  layer_tree_->set_frame_metrics(
+      SkISize::Make(viewport_metrics.physical_width,
+                    viewport_metrics.physical_height),
+      static_cast<float>(viewport_metrics.device_pixel_ratio));
+  layer_tree_->set_view_id(view_id);
   return std::move(layer_tree_);
 }
 
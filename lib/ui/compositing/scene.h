@@ -30,7 +30,9 @@ class Scene : public RefCountedDartWrappable<Scene> {
                      bool checkerboardRasterCacheImages,
                      bool checkerboardOffscreenLayers);
 
-  std::unique_ptr<flutter::LayerTree> takeLayerTree();
+  // Takes the layer tree of the scene, sized for the window of |view_id|.
+  // Returns null if the tree was taken already or there is no such window.
+  std::unique_ptr<flutter::LayerTree> takeLayerTree(int64_t view_id);
 
   Dart_Handle toImage(uint32_t width,
                       uint32_t height,
@@ -10,14 +10,17 @@
 #include "flutter/flow/layers/clip_rrect_layer.h"
 #include "flutter/flow/layers/color_filter_layer.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/image_filter_layer.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/opacity_layer.h"
 #include "flutter/flow/layers/performance_overlay_layer.h"
 #include "flutter/flow/layers/physical_shape_layer.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/flow/layers/platform_view_layer.h"
+#include "flutter/flow/layers/scroll_layer.h"
 #include "flutter/flow/layers/shader_mask_layer.h"
 #include "flutter/flow/layers/texture_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -49,6 +52,7 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, SceneBuilder);
   V(SceneBuilder, pushClipRect)                     \
   V(SceneBuilder, pushClipRRect)                    \
   V(SceneBuilder, pushClipPath)                     \
+  V(SceneBuilder, pushScroll)                       \
   V(SceneBuilder, pushOpacity)                      \
   V(SceneBuilder, pushColorFilter)                  \
   V(SceneBuilder, pushImageFilter)                  \
@@ -83,8 +87,11 @@ void SceneBuilder::RegisterNatives(tonic::DartLibraryNatives* natives) {
 
 SceneBuilder::SceneBuilder() {
   // Add a ContainerLayer as the root layer, so that AddLayer operations are
-  // always valid.
-  PushLayer(std::make_shared<flutter::ContainerLayer>());
+  // always valid. The root is never retained, so it shares its arena with the
+  // leaves added to it.
+  auto arena = LayerArena::Create();
+  PushLayer(LayerArena::Make<flutter::ContainerLayer>(arena));
+  arena_stack_.back() = std::move(arena);
 }
 
 SceneBuilder::~SceneBuilder() = default;
@@ -141,6 +148,25 @@ void SceneBuilder::pushClipPath(Dart_Handle layer_handle,
   EngineLayer::MakeRetained(layer_handle, layer);
 }
 
+void SceneBuilder::pushScroll(Dart_Handle layer_handle,
+                              int64_t scroll_id,
+                              double left,
+                              double right,
+                              double top,
+                              double bottom,
+                              double dx,
+                              double dy,
+                              double min_dx,
+                              double max_dx,
+                              double min_dy,
+                              double max_dy) {
+  auto layer = std::make_shared<flutter::ScrollLayer>(
+      scroll_id, SkRect::MakeLTRB(left, top, right, bottom),
+      SkPoint::Make(dx, dy), SkRect::MakeLTRB(min_dx, min_dy, max_dx, max_dy));
+  PushLayer(layer);
+  EngineLayer::MakeRetained(layer_handle, layer);
+}
+
 void SceneBuilder::pushOpacity(Dart_Handle layer_handle,
                                int alpha,
                                double dx,
@@ -162,14 +188,15 @@ void SceneBuilder::pushColorFilter(Dart_Handle layer_handle,
 void SceneBuilder::pushImageFilter(Dart_Handle layer_handle,
                                    const ImageFilter* image_filter) {
   auto layer =
-      std::make_shared<flutter::ImageFilterLayer>(image_filter->filter());
+      std::make_shared<flutter::ImageFilterLayer>(image_filter->layer_filter());
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 }
 
 void SceneBuilder::pushBackdropFilter(Dart_Handle layer_handle,
                                       ImageFilter* filter) {
-  auto layer = std::make_shared<flutter::BackdropFilterLayer>(filter->filter());
+  auto layer =
+      std::make_shared<flutter::BackdropFilterLayer>(filter->layer_filter());
   PushLayer(layer);
   EngineLayer::MakeRetained(layer_handle, layer);
 }
@@ -216,11 +243,16 @@ void SceneBuilder::addPicture(double dx,
                               Picture* picture,
                               int hints) {
   SkPoint offset = SkPoint::Make(dx, dy);
-  SkRect pictureRect = picture->picture()->cullRect();
-  pictureRect.offset(offset.x(), offset.y());
-  auto layer = std::make_unique<flutter::PictureLayer>(
-      offset, UIDartState::CreateGPUObject(picture->picture()), !!(hints & 1),
-      !!(hints & 2));
+  if (auto display_list = picture->display_list()) {
+    auto layer = LayerArena::Make<flutter::DisplayListLayer>(
+        LeafArena(), offset, UIDartState::CreateGPUObject(display_list),
+        !!(hints & 1), !!(hints & 2));
+    AddLayer(std::move(layer));
+    return;
+  }
+  auto layer = LayerArena::Make<flutter::PictureLayer>(
+      LeafArena(), offset, UIDartState::CreateGPUObject(picture->picture()),
+      !!(hints & 1), !!(hints & 2));
   AddLayer(std::move(layer));
 }
 
@@ -231,9 +263,9 @@ void SceneBuilder::addTexture(double dx,
                               int64_t textureId,
                               bool freeze,
                               int filterQuality) {
-  auto layer = std::make_unique<flutter::TextureLayer>(
-      SkPoint::Make(dx, dy), SkSize::Make(width, height), textureId, freeze,
-      static_cast<SkFilterQuality>(filterQuality));
+  auto layer = LayerArena::Make<flutter::TextureLayer>(
+      LeafArena(), SkPoint::Make(dx, dy), SkSize::Make(width, height), textureId,
+      freeze, static_cast<SkFilterQuality>(filterQuality));
   AddLayer(std::move(layer));
 }
 
@@ -242,8 +274,8 @@ void SceneBuilder::addPlatformView(double dx,
                                    double width,
                                    double height,
                                    int64_t viewId) {
-  auto layer = std::make_unique<flutter::PlatformViewLayer>(
-      SkPoint::Make(dx, dy), SkSize::Make(width, height), viewId);
+  auto layer = LayerArena::Make<flutter::PlatformViewLayer>(
+      LeafArena(), SkPoint::Make(dx, dy), SkSize::Make(width, height), viewId);
   AddLayer(std::move(layer));
 }
 
@@ -254,9 +286,9 @@ void SceneBuilder::addChildScene(double dx,
                                  double height,
                                  SceneHost* sceneHost,
                                  bool hitTestable) {
-  auto layer = std::make_unique<flutter::ChildSceneLayer>(
-      sceneHost->id(), SkPoint::Make(dx, dy), SkSize::Make(width, height),
-      hitTestable);
+  auto layer = LayerArena::Make<flutter::ChildSceneLayer>(
+      LeafArena(), sceneHost->id(), SkPoint::Make(dx, dy),
+      SkSize::Make(width, height), hitTestable);
   AddLayer(std::move(layer));
 }
 #endif
@@ -267,8 +299,8 @@ void SceneBuilder::addPerformanceOverlay(uint64_t enabledOptions,
                                          double top,
                                          double bottom) {
   SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
-  auto layer =
-      std::make_unique<flutter::PerformanceOverlayLayer>(enabledOptions);
+  auto layer = LayerArena::Make<flutter::PerformanceOverlayLayer>(
+      LeafArena(), enabledOptions);
   layer->set_paint_bounds(rect);
   AddLayer(std::move(layer));
 }
@@ -305,13 +337,22 @@ void SceneBuilder::AddLayer(std::shared_ptr<Layer> layer) {
 void SceneBuilder::PushLayer(std::shared_ptr<ContainerLayer> layer) {
   AddLayer(layer);
   layer_stack_.push_back(std::move(layer));
+  arena_stack_.push_back(nullptr);
 }
 
 void SceneBuilder::PopLayer() {
   // We never pop the root layer, so that AddLayer operations are always valid.
   if (layer_stack_.size() > 1) {
     layer_stack_.pop_back();
+    arena_stack_.pop_back();
+  }
+}
+
+const std::shared_ptr<LayerArena>& SceneBuilder::LeafArena() {
+  if (!arena_stack_.back()) {
+    arena_stack_.back() = LayerArena::Create();
   }
+  return arena_stack_.back();
 }
 
 }  // namespace flutter
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/color_filter.h"
@@ -51,6 +52,18 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
   void pushClipPath(Dart_Handle layer_handle,
                     const CanvasPath* path,
                     int clipBehavior);
+  void pushScroll(Dart_Handle layer_handle,
+                  int64_t scroll_id,
+                  double left,
+                  double right,
+                  double top,
+                  double bottom,
+                  double dx,
+                  double dy,
+                  double min_dx,
+                  double max_dx,
+                  double min_dy,
+                  double max_dy);
   void pushOpacity(Dart_Handle layer_handle,
                    int alpha,
                    double dx = 0,
@@ -124,7 +137,17 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
   void PushLayer(std::shared_ptr<ContainerLayer> layer);
   void PopLayer();
 
+  // The arena that leaf layers added to the current container are allocated
+  // from, created when the container gets its first leaf.
+  const std::shared_ptr<LayerArena>& LeafArena();
+
   std::vector<std::shared_ptr<ContainerLayer>> layer_stack_;
+  // Parallel to |layer_stack_|. Leaves live in an arena owned by their parent
+  // rather than in one arena per frame: the container layers handed out as
+  // |EngineLayer|s (which are allocated on the heap) may be retained via
+  // |addRetained| in later frames, and a retained container must only keep
+  // its own leaves alive, not every layer of the frame that built it.
+  std::vector<std::shared_ptr<LayerArena>> arena_stack_;
   int rasterizer_tracing_threshold_ = 0;
   bool checkerboard_raster_cache_images_ = false;
   bool checkerboard_offscreen_layers_ = false;
@@ -48,6 +48,12 @@ void _updateWindowMetrics(
   );
 }
 
+@pragma('vm:entry-point')
+// ignore: unused_element
+void _removeWindow(Object id) {
+  PlatformDispatcher.instance._removeWindow(id);
+}
+
 typedef _LocaleClosure = String Function();
 
 @pragma('vm:entry-point')
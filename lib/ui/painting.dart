@@ -1766,6 +1766,51 @@ class Image {
     return Image._(_image);
   }
 
+  /// Hands the underlying image over to another isolate without copying it.
+  ///
+  /// Returns a token to send to the other isolate, for example through a
+  /// [SendPort], which passes it to [fromTransferToken] to claim the image.
+  /// This handle is disposed and is no longer usable after this method is
+  /// called.
+  ///
+  /// An image that lives on the GPU can only be claimed by the isolates of the
+  /// same Flutter engine, and is released when that engine shuts down if it
+  /// was never claimed. An image whose pixels are in memory can be claimed by
+  /// any isolate, and stays alive until the process exits if it is never
+  /// claimed.
+  ///
+  /// Throws a [StateError] if this handle is disposed or if other handles to
+  /// the underlying image are still open, since they would lose the image.
+  int transfer() {
+    if (_disposed) {
+      throw StateError('Cannot transfer a disposed image.');
+    }
+    if (_image._handles.length != 1) {
+      throw StateError(
+        'Cannot transfer an image with ${_image._handles.length} open handles.\n'
+        'Dispose of the other handles created with clone() before transferring '
+        'the image.'
+      );
+    }
+    assert(!_image._disposed);
+    _disposed = true;
+    _image._handles.remove(this);
+    return _image._transfer();
+  }
+
+  /// Claims an image that another isolate passed to [transfer].
+  ///
+  /// The pixels are not copied. Each token can only be claimed once, and
+  /// throws an [ArgumentError] if it is unknown, was already claimed, or is
+  /// an image on the GPU of another Flutter engine.
+  static Image fromTransferToken(int token) {
+    final _Image image = _Image._();
+    if (!image._initFromTransferToken(token)) {
+      throw ArgumentError.value(token, 'token', 'No transferred image');
+    }
+    return Image._(image);
+  }
+
   /// Returns true if `other` is a [clone] of this and thus shares the same
   /// underlying image memory, even if this or `other` is [dispose]d.
   ///
@@ -1822,6 +1867,17 @@ class _Image extends NativeFieldWrapperClass2 {
 
   void _dispose() native 'Image_dispose';
 
+  int _transfer() {
+    assert(!_disposed);
+    assert(_handles.isEmpty);
+    _disposed = true;
+    return _transferNative();
+  }
+
+  int _transferNative() native 'Image_transfer';
+
+  bool _initFromTransferToken(int token) native 'Image_initFromTransferToken';
+
   Set<Image> _handles = <Image>{};
 
   @override
@@ -2183,6 +2239,22 @@ class EngineLayer extends NativeFieldWrapperClass2 {
   /// or extended directly.
   @pragma('vm:entry-point')
   EngineLayer._();
+
+  void _latchTransform(Float64List matrix4) native 'EngineLayer_latchTransform';
+
+  void _latchClipRect(double left, double right, double top, double bottom)
+      native 'EngineLayer_latchClipRect';
+
+  void _latchClipRRect(Float32List rrect) native 'EngineLayer_latchClipRRect';
+
+  void _latchAlpha(int alpha) native 'EngineLayer_latchAlpha';
+
+  void _animateTransform(Float64List begin, Float64List end,
+      int durationMicroseconds, int curve)
+      native 'EngineLayer_animateTransform';
+
+  void _animateAlpha(int begin, int end, int durationMicroseconds, int curve)
+      native 'EngineLayer_animateAlpha';
 }
 
 /// A complex, one-dimensional subset of a plane.
@@ -2744,6 +2816,22 @@ class PathMetric {
     return _measure.getTangentForOffset(contourIndex, distance);
   }
 
+  /// Computes the positions and tangent vectors of the current contour at each
+  /// of the given offsets in one call.
+  ///
+  /// The result holds four values per offset: the x and y of the position
+  /// followed by the x and y of the tangent vector, as returned by
+  /// [getTangentForOffset]. The values for an offset that can't be measured,
+  /// like [double.nan], are all [double.nan].
+  ///
+  /// The distances are clamped to the [length] of the current contour.
+  ///
+  /// This is much cheaper than calling [getTangentForOffset] for each offset
+  /// when placing many objects along a path.
+  Float32List getTangentsForOffsets(Float32List distances) {
+    return _measure.getTangentsForOffsets(contourIndex, distances);
+  }
+
   /// Given a start and end distance, return the intervening segment(s).
   ///
   /// `start` and `end` are clamped to legal values (0..[length])
@@ -2752,6 +2840,15 @@ class PathMetric {
     return _measure.extractPath(contourIndex, start, end, startWithMoveTo: startWithMoveTo);
   }
 
+  /// Returns a single path holding the segments between each pair of start and
+  /// end distances in `intervals`, in order.
+  ///
+  /// `intervals` must have an even length. Each segment is extracted as by
+  /// [extractPath], with the same `startWithMoveTo` for every segment.
+  Path extractPathSegments(Float32List intervals, {bool startWithMoveTo = true}) {
+    return _measure.extractPathSegments(contourIndex, intervals, startWithMoveTo: startWithMoveTo);
+  }
+
   @override
   String toString() => '$runtimeType{length: $length, isClosed: $isClosed, contourIndex:$contourIndex}';
 }
@@ -2783,6 +2880,12 @@ class _PathMeasure extends NativeFieldWrapperClass2 {
   }
   Float32List _getPosTan(int contourIndex, double distance) native 'PathMeasure_getPosTan';
 
+  Float32List getTangentsForOffsets(int contourIndex, Float32List distances) {
+    assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
+    return _getPosTans(contourIndex, distances);
+  }
+  Float32List _getPosTans(int contourIndex, Float32List distances) native 'PathMeasure_getPosTans';
+
   Path extractPath(int contourIndex, double start, double end, {bool startWithMoveTo = true}) {
     assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
     final Path path = Path._();
@@ -2791,6 +2894,15 @@ class _PathMeasure extends NativeFieldWrapperClass2 {
   }
   void _extractPath(Path outPath, int contourIndex, double start, double end, {bool startWithMoveTo = true}) native 'PathMeasure_getSegment';
 
+  Path extractPathSegments(int contourIndex, Float32List intervals, {bool startWithMoveTo = true}) {
+    assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
+    assert(intervals.length.isEven, 'Intervals must hold pairs of start and end distances.');
+    final Path path = Path._();
+    _extractPathSegments(path, contourIndex, intervals, startWithMoveTo);
+    return path;
+  }
+  void _extractPathSegments(Path outPath, int contourIndex, Float32List intervals, bool startWithMoveTo) native 'PathMeasure_getSegments';
+
   bool isClosed(int contourIndex) {
     assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
     return _isClosed(contourIndex);
@@ -3812,6 +3924,50 @@ class Canvas extends NativeFieldWrapperClass2 {
   // garbage collected until PictureRecorder.endRecording is called.
   PictureRecorder? _recorder;
 
+  // Lines, rectangles, ovals and circles drawn with paints that have no
+  // shader, color filter or image filter are recorded in a command buffer and
+  // executed in a single native call, instead of one call each, when the
+  // buffer is full, when another method of the canvas is called or when the
+  // recording ends. Each command is an opcode, four coordinates and the data of
+  // the paint.
+  //
+  // Must be kept in sync with CanvasCommand in canvas.cc.
+  static const int _kDrawLineCommand = 0;
+  static const int _kDrawRectCommand = 1;
+  static const int _kDrawOvalCommand = 2;
+  static const int _kDrawCircleCommand = 3;
+  static const int _kCommandByteCount = 4 + 4 * 4 + Paint._kDataByteCount;
+  static const int _kCommandBufferByteCount = 1024 * _kCommandByteCount;
+
+  ByteData? _commands;
+  int _commandsByteCount = 0;
+
+  void _recordCommand(int command, double a, double b, double c, double d, Paint paint) {
+    if (_commandsByteCount == _kCommandBufferByteCount)
+      _flushCommands();
+    final ByteData commands = _commands ??= ByteData(_kCommandBufferByteCount);
+    final int offset = _commandsByteCount;
+    commands.setUint32(offset, command, _kFakeHostEndian);
+    commands.setFloat32(offset + 4, a, _kFakeHostEndian);
+    commands.setFloat32(offset + 8, b, _kFakeHostEndian);
+    commands.setFloat32(offset + 12, c, _kFakeHostEndian);
+    commands.setFloat32(offset + 16, d, _kFakeHostEndian);
+    final ByteData paintData = paint._data;
+    for (int i = 0; i < Paint._kDataByteCount; i += 4)
+      commands.setUint32(offset + 20 + i, paintData.getUint32(i, _kFakeHostEndian), _kFakeHostEndian);
+    _commandsByteCount = offset + _kCommandByteCount;
+  }
+
+  void _flushCommands() {
+    if (_commandsByteCount == 0)
+      return;
+    final int byteCount = _commandsByteCount;
+    _commandsByteCount = 0;
+    _executeCommands(_commands!, byteCount);
+  }
+
+  void _executeCommands(ByteData commands, int byteCount) native 'Canvas_executeCommands';
+
   /// Saves a copy of the current transform and clip on the save stack.
   ///
   /// Call [restore] to pop the save stack.
@@ -3820,7 +3976,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   ///  * [saveLayer], which does the same thing but additionally also groups the
   ///    commands done until the matching [restore].
-  void save() native 'Canvas_save';
+  void save() {
+    _flushCommands();
+    _save();
+  }
+  void _save() native 'Canvas_save';
 
   /// Saves a copy of the current transform and clip on the save stack, and then
   /// creates a new group which subsequent calls will become a part of. When the
@@ -3932,6 +4092,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///  * [BlendMode], which discusses the use of [Paint.blendMode] with
   ///    [saveLayer].
   void saveLayer(Rect? bounds, Paint paint) {
+    _flushCommands();
     assert(paint != null); // ignore: unnecessary_null_comparison
     if (bounds == null) {
       _saveLayerWithoutBounds(paint._objects, paint._data);
@@ -3957,7 +4118,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// If the state was pushed with with [saveLayer], then this call will also
   /// cause the new layer to be composited into the previous layer.
-  void restore() native 'Canvas_restore';
+  void restore() {
+    _flushCommands();
+    _restore();
+  }
+  void _restore() native 'Canvas_restore';
 
   /// Returns the number of items on the save stack, including the
   /// initial state. This means it returns 1 for a clean canvas, and
@@ -3965,11 +4130,19 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// each matching call to [restore] decrements it.
   ///
   /// This number cannot go below 1.
-  int getSaveCount() native 'Canvas_getSaveCount';
+  int getSaveCount() {
+    _flushCommands();
+    return _getSaveCount();
+  }
+  int _getSaveCount() native 'Canvas_getSaveCount';
 
   /// Add a translation to the current transform, shifting the coordinate space
   /// horizontally by the first argument and vertically by the second argument.
-  void translate(double dx, double dy) native 'Canvas_translate';
+  void translate(double dx, double dy) {
+    _flushCommands();
+    _translate(dx, dy);
+  }
+  void _translate(double dx, double dy) native 'Canvas_translate';
 
   /// Add an axis-aligned scale to the current transform, scaling by the first
   /// argument in the horizontal direction and the second in the vertical
@@ -3977,22 +4150,34 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// If [sy] is unspecified, [sx] will be used for the scale in both
   /// directions.
-  void scale(double sx, [double? sy]) => _scale(sx, sy ?? sx);
+  void scale(double sx, [double? sy]) {
+    _flushCommands();
+    _scale(sx, sy ?? sx);
+  }
 
   void _scale(double sx, double sy) native 'Canvas_scale';
 
   /// Add a rotation to the current transform. The argument is in radians clockwise.
-  void rotate(double radians) native 'Canvas_rotate';
+  void rotate(double radians) {
+    _flushCommands();
+    _rotate(radians);
+  }
+  void _rotate(double radians) native 'Canvas_rotate';
 
   /// Add an axis-aligned skew to the current transform, with the first argument
   /// being the horizontal skew in rise over run units clockwise around the
   /// origin, and the second argument being the vertical skew in rise over run
   /// units clockwise around the origin.
-  void skew(double sx, double sy) native 'Canvas_skew';
+  void skew(double sx, double sy) {
+    _flushCommands();
+    _skew(sx, sy);
+  }
+  void _skew(double sx, double sy) native 'Canvas_skew';
 
   /// Multiply the current transform by the specified 4⨉4 transformation matrix
   /// specified as a list of values in column-major order.
   void transform(Float64List matrix4) {
+    _flushCommands();
     assert(matrix4 != null); // ignore: unnecessary_null_comparison
     if (matrix4.length != 16)
       throw ArgumentError('"matrix4" must have 16 entries.');
@@ -4012,6 +4197,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// Use [ClipOp.difference] to subtract the provided rectangle from the
   /// current clip.
   void clipRect(Rect rect, { ClipOp clipOp = ClipOp.intersect, bool doAntiAlias = true }) {
+    _flushCommands();
     assert(_rectIsValid(rect));
     assert(clipOp != null); // ignore: unnecessary_null_comparison
     assert(doAntiAlias != null); // ignore: unnecessary_null_comparison
@@ -4033,6 +4219,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// in incorrect blending at the clip boundary. See [saveLayer] for a
   /// discussion of how to address that and some examples of using [clipRRect].
   void clipRRect(RRect rrect, {bool doAntiAlias = true}) {
+    _flushCommands();
     assert(_rrectIsValid(rrect));
     assert(doAntiAlias != null); // ignore: unnecessary_null_comparison
     _clipRRect(rrect._value32, doAntiAlias);
@@ -4049,6 +4236,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// in incorrect blending at the clip boundary. See [saveLayer] for a
   /// discussion of how to address that.
   void clipPath(Path path, {bool doAntiAlias = true}) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(path != null); // path is checked on the engine side
     assert(doAntiAlias != null); // ignore: unnecessary_null_comparison
@@ -4060,6 +4248,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// [BlendMode], with the given color being the source and the background
   /// being the destination.
   void drawColor(Color color, BlendMode blendMode) {
+    _flushCommands();
     assert(color != null); // ignore: unnecessary_null_comparison
     assert(blendMode != null); // ignore: unnecessary_null_comparison
     _drawColor(color.value, blendMode.index);
@@ -4074,6 +4263,11 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(_offsetIsValid(p1));
     assert(_offsetIsValid(p2));
     assert(paint != null); // ignore: unnecessary_null_comparison
+    if (paint._objects == null) {
+      _recordCommand(_kDrawLineCommand, p1.dx, p1.dy, p2.dx, p2.dy, paint);
+      return;
+    }
+    _flushCommands();
     _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
   }
   void _drawLine(double x1,
@@ -4088,6 +4282,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// To fill the canvas with a solid color and blend mode, consider
   /// [drawColor] instead.
   void drawPaint(Paint paint) {
+    _flushCommands();
     assert(paint != null); // ignore: unnecessary_null_comparison
     _drawPaint(paint._objects, paint._data);
   }
@@ -4098,6 +4293,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawRect(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
     assert(paint != null); // ignore: unnecessary_null_comparison
+    if (paint._objects == null) {
+      _recordCommand(_kDrawRectCommand, rect.left, rect.top, rect.right, rect.bottom, paint);
+      return;
+    }
+    _flushCommands();
     _drawRect(rect.left, rect.top, rect.right, rect.bottom,
               paint._objects, paint._data);
   }
@@ -4111,6 +4311,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// Draws a rounded rectangle with the given [Paint]. Whether the rectangle is
   /// filled or stroked (or both) is controlled by [Paint.style].
   void drawRRect(RRect rrect, Paint paint) {
+    _flushCommands();
     assert(_rrectIsValid(rrect));
     assert(paint != null); // ignore: unnecessary_null_comparison
     _drawRRect(rrect._value32, paint._objects, paint._data);
@@ -4125,6 +4326,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// This shape is almost but not quite entirely unlike an annulus.
   void drawDRRect(RRect outer, RRect inner, Paint paint) {
+    _flushCommands();
     assert(_rrectIsValid(outer));
     assert(_rrectIsValid(inner));
     assert(paint != null); // ignore: unnecessary_null_comparison
@@ -4141,6 +4343,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawOval(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
     assert(paint != null); // ignore: unnecessary_null_comparison
+    if (paint._objects == null) {
+      _recordCommand(_kDrawOvalCommand, rect.left, rect.top, rect.right, rect.bottom, paint);
+      return;
+    }
+    _flushCommands();
     _drawOval(rect.left, rect.top, rect.right, rect.bottom,
               paint._objects, paint._data);
   }
@@ -4158,6 +4365,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawCircle(Offset c, double radius, Paint paint) {
     assert(_offsetIsValid(c));
     assert(paint != null); // ignore: unnecessary_null_comparison
+    if (paint._objects == null) {
+      _recordCommand(_kDrawCircleCommand, c.dx, c.dy, radius, 0.0, paint);
+      return;
+    }
+    _flushCommands();
     _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
   }
   void _drawCircle(double x,
@@ -4178,6 +4390,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// This method is optimized for drawing arcs and should be faster than [Path.arcTo].
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
+    _flushCommands();
     assert(_rectIsValid(rect));
     assert(paint != null); // ignore: unnecessary_null_comparison
     _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle,
@@ -4199,6 +4412,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// [Paint.style]. If the path is filled, then sub-paths within it are
   /// implicitly closed (see [Path.close]).
   void drawPath(Path path, Paint paint) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(path != null); // path is checked on the engine side
     assert(paint != null); // ignore: unnecessary_null_comparison
@@ -4211,6 +4425,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// Draws the given [Image] into the canvas with its top-left corner at the
   /// given [Offset]. The image is composited into the canvas using the given [Paint].
   void drawImage(Image image, Offset offset, Paint paint) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(image != null); // image is checked on the engine side
     assert(_offsetIsValid(offset));
@@ -4233,6 +4448,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// image) can be batched into a single call to [drawAtlas] to improve
   /// performance.
   void drawImageRect(Image image, Rect src, Rect dst, Paint paint) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(image != null); // image is checked on the engine side
     assert(_rectIsValid(src));
@@ -4276,6 +4492,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// cover the destination rectangle while maintaining their relative
   /// positions.
   void drawImageNine(Image image, Rect center, Rect dst, Paint paint) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(image != null); // image is checked on the engine side
     assert(_rectIsValid(center));
@@ -4308,6 +4525,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// Draw the given picture onto the canvas. To create a picture, see
   /// [PictureRecorder].
   void drawPicture(Picture picture) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(picture != null); // picture is checked on the engine side
     _drawPicture(picture);
@@ -4335,6 +4553,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// described by adding half of the [ParagraphConstraints.width] given to
   /// [Paragraph.layout], to the `offset` argument's [Offset.dx] coordinate.
   void drawParagraph(Paragraph paragraph, Offset offset) {
+    _flushCommands();
     assert(paragraph != null); // ignore: unnecessary_null_comparison
     assert(_offsetIsValid(offset));
     paragraph._paint(this, offset.dx, offset.dy);
@@ -4349,6 +4568,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///  * [drawRawPoints], which takes `points` as a [Float32List] rather than a
   ///    [List<Offset>].
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint) {
+    _flushCommands();
     assert(pointMode != null); // ignore: unnecessary_null_comparison
     assert(points != null); // ignore: unnecessary_null_comparison
     assert(paint != null); // ignore: unnecessary_null_comparison
@@ -4365,6 +4585,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///  * [drawPoints], which takes `points` as a [List<Offset>] rather than a
   ///    [List<Float32List>].
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint) {
+    _flushCommands();
     assert(pointMode != null); // ignore: unnecessary_null_comparison
     assert(points != null); // ignore: unnecessary_null_comparison
     assert(paint != null); // ignore: unnecessary_null_comparison
@@ -4387,6 +4608,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///   * [Vertices.raw], which creates the vertices using typed data lists
   ///     rather than unencoded lists.
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(vertices != null); // vertices is checked on the engine side
     assert(paint != null); // ignore: unnecessary_null_comparison
@@ -4532,6 +4754,7 @@ class Canvas extends NativeFieldWrapperClass2 {
                  BlendMode? blendMode,
                  Rect? cullRect,
                  Paint paint) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(atlas != null); // atlas is checked on the engine side
     assert(transforms != null); // ignore: unnecessary_null_comparison
@@ -4723,6 +4946,7 @@ class Canvas extends NativeFieldWrapperClass2 {
                     BlendMode? blendMode,
                     Rect? cullRect,
                     Paint paint) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(atlas != null); // atlas is checked on the engine side
     assert(rstTransforms != null); // ignore: unnecessary_null_comparison
@@ -4760,6 +4984,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// The arguments must not be null.
   void drawShadow(Path path, Color color, double elevation, bool transparentOccluder) {
+    _flushCommands();
     // ignore: unnecessary_null_comparison
     assert(path != null); // path is checked on the engine side
     assert(color != null); // ignore: unnecessary_null_comparison
@@ -4848,6 +5073,7 @@ class PictureRecorder extends NativeFieldWrapperClass2 {
   Picture endRecording() {
     if (_canvas == null)
       throw StateError('PictureRecorder did not start recording.');
+    _canvas!._flushCommands();
     final Picture picture = Picture._();
     _endRecording(picture);
     _canvas!._recorder = null;
@@ -5065,7 +5291,7 @@ class Shadow {
 
 /// A handle to a read-only byte buffer that is managed by the engine.
 class ImmutableBuffer extends NativeFieldWrapperClass2 {
-  ImmutableBuffer._(this.length);
+  ImmutableBuffer._(this._length);
 
   /// Creates a copy of the data from a [Uint8List] suitable for internal use
   /// in the engine.
@@ -5077,12 +5303,56 @@ class ImmutableBuffer extends NativeFieldWrapperClass2 {
   }
   void _init(Uint8List list, _Callback<void> callback) native 'ImmutableBuffer_init';
 
+  /// Creates a buffer with the contents of the asset named by [assetKey].
+  ///
+  /// Unlike loading the asset into a [Uint8List] and calling [fromUint8List],
+  /// the data is not copied into the Dart heap. The buffer refers to the
+  /// asset's data in the engine, which for most assets is a memory mapping of
+  /// the asset's file.
+  ///
+  /// The returned future completes with an error if the asset does not exist.
+  static Future<ImmutableBuffer> fromAsset(String assetKey) {
+    final String encodedKey = Uri(path: Uri.encodeFull(assetKey)).path;
+    final ImmutableBuffer instance = ImmutableBuffer._(0);
+    return _futurize((_Callback<int> callback) {
+      return instance._initFromAsset(encodedKey, callback);
+    }).then((int length) {
+      instance._length = length;
+      return instance;
+    });
+  }
+  String? _initFromAsset(String assetKey, _Callback<int> callback) native 'ImmutableBuffer_initFromAsset';
+
+  /// Claims the data of a buffer that another isolate passed to [transfer].
+  ///
+  /// The data is not copied. Each token can only be claimed once, and throws
+  /// an [ArgumentError] if it is unknown or was already claimed.
+  static ImmutableBuffer fromTransferToken(int token) {
+    final ImmutableBuffer instance = ImmutableBuffer._(0);
+    final int length = instance._initFromTransferToken(token);
+    if (length < 0) {
+      throw ArgumentError.value(token, 'token', 'No transferred buffer');
+    }
+    instance._length = length;
+    return instance;
+  }
+  int _initFromTransferToken(int token) native 'ImmutableBuffer_initFromTransferToken';
+
   /// The length, in bytes, of the underlying data.
-  final int length;
+  int get length => _length;
+  int _length;
 
   /// Release the resources used by this object. The object is no longer usable
   /// after this method is called.
   void dispose() native 'ImmutableBuffer_dispose';
+
+  /// Hands the data of this buffer over to another isolate without copying it.
+  ///
+  /// Returns a token to send to the other isolate, for example through a
+  /// [SendPort], which passes it to [fromTransferToken] to claim the data.
+  /// This buffer is disposed and is no longer usable after this method is
+  /// called. Data that is never claimed stays alive until the process exits.
+  int transfer() native 'ImmutableBuffer_transfer';
 }
 
 /// A descriptor of data that can be turned into an [Image] via a [Codec].
@@ -5093,6 +5363,12 @@ class ImageDescriptor extends NativeFieldWrapperClass2 {
   ImageDescriptor._();
 
   /// Creates an image descriptor from encoded data in a supported format.
+  ///
+  /// Besides encoded images, the data may be a little endian KTX 1.1 container
+  /// of an ETC2 RGB8 or BC1 texture. Its first mipmap level is uploaded to the
+  /// GPU as a compressed texture without being decoded, and is not resized to
+  /// the target size of the codec. Where the GPU does not support the format,
+  /// the texture is decompressed on the CPU instead.
   static Future<ImageDescriptor> encoded(ImmutableBuffer buffer) {
     final ImageDescriptor descriptor = ImageDescriptor._();
     return _futurize((_Callback<void> callback) {
@@ -5101,6 +5377,28 @@ class ImageDescriptor extends NativeFieldWrapperClass2 {
   }
   String? _initEncoded(ImmutableBuffer buffer, _Callback<void> callback) native 'ImageDescriptor_initEncoded';
 
+  /// Reads the size in pixels of the encoded image in `buffer` from its
+  /// header, without decoding the image.
+  ///
+  /// This accepts the same data as [encoded], and the size is the one its
+  /// descriptor would report. Unlike [encoded], the engine keeps no reference
+  /// to the buffer, so layouts that only need the aspect ratio of images can
+  /// probe them and then [ImmutableBuffer.dispose] the buffer. For a buffer
+  /// created with [ImmutableBuffer.fromAsset], only the beginning of the asset
+  /// is read.
+  ///
+  /// Returns null if the format of the image is not supported.
+  ///
+  /// On the Web, this always returns null.
+  static Size? probeEncodedSize(ImmutableBuffer buffer) {
+    final List<int> size = _probeEncoded(buffer);
+    if (size.isEmpty) {
+      return null;
+    }
+    return Size(size[0].toDouble(), size[1].toDouble());
+  }
+  static List<int> _probeEncoded(ImmutableBuffer buffer) native 'ImageDescriptor_probeEncoded';
+
   /// Creates an image descriptor from raw image pixels.
   ///
   /// The `pixels` parameter is the pixel data in the encoding described by
@@ -5187,6 +5485,55 @@ class ImageDescriptor extends NativeFieldWrapperClass2 {
   void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight) native 'ImageDescriptor_instantiateCodec';
 }
 
+/// Decodes an encoded image while its bytes are still being received, for
+/// example from a network response.
+///
+/// Add the bytes with [addBytes] as they arrive and call [close] once all of
+/// them were added. Each call to [decode] returns an image of what can be
+/// decoded from the bytes added so far, such as the rows of a baseline JPEG
+/// or the passes of an interlaced PNG received so far. The parts of the image
+/// that are not decoded yet are transparent.
+///
+/// Formats that can not be decoded incrementally are decoded once [close] was
+/// called.
+class IncrementalImageDecoder extends NativeFieldWrapperClass2 {
+  /// Creates a decoder without any bytes.
+  @pragma('vm:entry-point')
+  IncrementalImageDecoder() { _constructor(); }
+  void _constructor() native 'IncrementalImageDecoder_constructor';
+
+  /// Appends the next bytes of the encoded image.
+  ///
+  /// Bytes added after [close] was called are ignored.
+  void addBytes(Uint8List bytes) native 'IncrementalImageDecoder_addBytes';
+
+  /// Signals that all bytes of the encoded image were added.
+  void close() native 'IncrementalImageDecoder_close';
+
+  /// Whether a previous call to [decode] decoded the whole image.
+  bool get isComplete => _isComplete();
+  bool _isComplete() native 'IncrementalImageDecoder_isComplete';
+
+  /// Decodes the image from the bytes added so far.
+  ///
+  /// Completes with null if no part of the image can be decoded yet.
+  Future<Image?> decode() {
+    final Completer<Image?> completer = Completer<Image?>.sync();
+    final String? error = _decode((_Image? image) {
+      completer.complete(image == null ? null : Image._(image));
+    });
+    if (error != null) {
+      throw Exception(error);
+    }
+    return completer.future;
+  }
+  String? _decode(void Function(_Image?) callback) native 'IncrementalImageDecoder_decode';
+
+  /// Release the resources used by this object. The object is no longer usable
+  /// after this method is called.
+  void dispose() native 'IncrementalImageDecoder_dispose';
+}
+
 /// Generic callback signature, used by [_futurize].
 typedef _Callback<T> = void Function(T result);
 
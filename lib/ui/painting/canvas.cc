@@ -25,7 +25,7 @@ using tonic::ToDart;
 namespace flutter {
 
 static void Canvas_constructor(Dart_NativeArguments args) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
   DartCallConstructor(&Canvas::Create, args);
 }
 
@@ -62,7 +62,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawPoints)             \
   V(Canvas, drawVertices)           \
   V(Canvas, drawAtlas)              \
-  V(Canvas, drawShadow)
+  V(Canvas, drawShadow)              \
+  V(Canvas, executeCommands)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
@@ -197,7 +198,8 @@ void Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
         ToDart("Canvas.clipPath called with non-genuine Path."));
     return;
   }
-  canvas_->clipPath(path->path(), doAntiAlias);
+  canvas_->clipPath(UIDartState::Current()->GetPathCache().Get(path->path()),
+                    doAntiAlias);
 }
 
 void Canvas::drawColor(SkColor color, SkBlendMode blend_mode) {
@@ -308,7 +310,8 @@ void Canvas::drawPath(const CanvasPath* path,
         ToDart("Canvas.drawPath called with non-genuine Path."));
     return;
   }
-  canvas_->drawPath(path->path(), *paint.paint());
+  canvas_->drawPath(UIDartState::Current()->GetPathCache().Get(path->path()),
+                    *paint.paint());
 }
 
 void Canvas::drawImage(const CanvasImage* image,
@@ -388,7 +391,11 @@ void Canvas::drawPicture(Picture* picture) {
         ToDart("Canvas.drawPicture called with non-genuine Picture."));
     return;
   }
-  canvas_->drawPicture(picture->picture().get());
+  if (auto display_list = picture->display_list()) {
+    display_list->RenderTo(canvas_);
+  } else {
+    canvas_->drawPicture(picture->picture().get());
+  }
 }
 
 void Canvas::drawPoints(const Paint& paint,
@@ -402,10 +409,8 @@ void Canvas::drawPoints(const Paint& paint,
   static_assert(sizeof(SkPoint) == sizeof(float) * 2,
                 "SkPoint doesn't use floats.");
 
-  canvas_->drawPoints(point_mode,
-                      points.num_elements() / 2,  // SkPoints have two floats.
-                      reinterpret_cast<const SkPoint*>(points.data()),
-                      *paint.paint());
+  canvas_->drawPoints(point_mode, points.num_elements_as<SkPoint>(),
+                      points.data_as<SkPoint>(), *paint.paint());
 }
 
 void Canvas::drawVertices(const Vertices* vertices,
@@ -441,6 +446,17 @@ void Canvas::drawAtlas(const Paint& paint,
     return;
   }
 
+  // The lists are read for as many sprites as there are rects.
+  const int sprite_count = rects.num_elements_as<SkRect>();
+  if (transforms.num_elements() != rects.num_elements() ||
+      (colors.data() && colors.num_elements() != sprite_count) ||
+      (cull_rect.data() && cull_rect.num_elements() != 4)) {
+    Dart_ThrowException(
+        ToDart("Canvas.drawAtlas or Canvas.drawRawAtlas called with "
+               "mismatched lists."));
+    return;
+  }
+
   sk_sp<SkImage> skImage = atlas->image();
 
   static_assert(sizeof(SkRSXform) == sizeof(float) * 4,
@@ -449,12 +465,9 @@ void Canvas::drawAtlas(const Paint& paint,
                 "SkRect doesn't use floats.");
 
   canvas_->drawAtlas(
-      skImage.get(), reinterpret_cast<const SkRSXform*>(transforms.data()),
-      reinterpret_cast<const SkRect*>(rects.data()),
-      reinterpret_cast<const SkColor*>(colors.data()),
-      rects.num_elements() / 4,  // SkRect have four floats.
-      blend_mode, reinterpret_cast<const SkRect*>(cull_rect.data()),
-      paint.paint());
+      skImage.get(), transforms.data_as<SkRSXform>(), rects.data_as<SkRect>(),
+      colors.data_as<SkColor>(), sprite_count, blend_mode,
+      cull_rect.data_as<SkRect>(), paint.paint());
 }
 
 void Canvas::drawShadow(const CanvasPath* path,
@@ -466,15 +479,81 @@ void Canvas::drawShadow(const CanvasPath* path,
         ToDart("Canvas.drawShader called with non-genuine Path."));
     return;
   }
-  SkScalar dpr = UIDartState::Current()
-                     ->platform_configuration()
-                     ->get_window(0)
-                     ->viewport_metrics()
-                     .device_pixel_ratio;
+  // Isolates other than the root isolate have no window and draw shadows as
+  // if the device pixel ratio were 1.
+  PlatformConfiguration* platform_configuration =
+      UIDartState::Current()->platform_configuration();
+  SkScalar dpr = platform_configuration
+                     ? platform_configuration->get_window(0)
+                           ->viewport_metrics()
+                           .device_pixel_ratio
+                     : 1.0f;
   flutter::PhysicalShapeLayer::DrawShadow(canvas_, path->path(), color,
                                           elevation, transparentOccluder, dpr);
 }
 
+// Must be kept in sync with the command constants of the Canvas class in
+// painting.dart. Every command is an opcode followed by four coordinates and
+// the data of a paint without objects.
+enum CanvasCommand : uint32_t {
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+};
+constexpr size_t kCanvasCommandCoordinateCount = 4;
+constexpr size_t kCanvasCommandByteCount =
+    sizeof(uint32_t) + kCanvasCommandCoordinateCount * sizeof(float) +
+    Paint::kDataByteCount;
+
+void Canvas::executeCommands(const tonic::DartByteData& commands,
+                             int byte_count) {
+  if (!canvas_) {
+    return;
+  }
+  if (byte_count < 0 ||
+      static_cast<size_t>(byte_count) > commands.length_in_bytes() ||
+      byte_count % kCanvasCommandByteCount != 0) {
+    FML_DLOG(ERROR) << "Invalid canvas command buffer.";
+    return;
+  }
+
+  const uint8_t* command = static_cast<const uint8_t*>(commands.data());
+  const uint8_t* end = command + byte_count;
+  for (; command < end; command += kCanvasCommandByteCount) {
+    const uint32_t opcode = *reinterpret_cast<const uint32_t*>(command);
+    const float* coordinates =
+        reinterpret_cast<const float*>(command + sizeof(uint32_t));
+    const Paint paint(command + sizeof(uint32_t) +
+                      kCanvasCommandCoordinateCount * sizeof(float));
+    switch (opcode) {
+      case kDrawLine:
+        canvas_->drawLine(coordinates[0], coordinates[1], coordinates[2],
+                          coordinates[3], *paint.paint());
+        break;
+      case kDrawRect:
+        canvas_->drawRect(
+            SkRect::MakeLTRB(coordinates[0], coordinates[1], coordinates[2],
+                             coordinates[3]),
+            *paint.paint());
+        break;
+      case kDrawOval:
+        canvas_->drawOval(
+            SkRect::MakeLTRB(coordinates[0], coordinates[1], coordinates[2],
+                             coordinates[3]),
+            *paint.paint());
+        break;
+      case kDrawCircle:
+        canvas_->drawCircle(coordinates[0], coordinates[1], coordinates[2],
+                            *paint.paint());
+        break;
+      default:
+        FML_DLOG(ERROR) << "Unknown canvas command " << opcode << ".";
+        return;
+    }
+  }
+}
+
 void Canvas::Invalidate() {
   canvas_ = nullptr;
   if (dart_wrapper()) {
@@ -14,6 +14,7 @@
 #include "flutter/lib/ui/painting/vertices.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 
 namespace tonic {
@@ -164,6 +165,11 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                   double elevation,
                   bool transparentOccluder);
 
+  // Executes the first |byte_count| bytes of drawing commands recorded by the
+  // Canvas class in painting.dart, so that batches of simple draws cost a
+  // single native call.
+  void executeCommands(const tonic::DartByteData& commands, int byte_count);
+
   SkCanvas* canvas() const { return canvas_; }
   void Invalidate();
 
@@ -15,7 +15,7 @@
 namespace flutter {
 
 static void ColorFilter_constructor(Dart_NativeArguments args) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
   DartCallConstructor(&ColorFilter::Create, args);
 }
 
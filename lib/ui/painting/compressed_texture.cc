@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/compressed_texture.h"
+
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint8_t kKTXIdentifier[12] = {0xAB, 'K',  'T',  'X',  ' ',  '1',
+                                        '1',  0xBB, '\r', '\n', 0x1A, '\n'};
+constexpr uint32_t kKTXEndianness = 0x04030201;
+
+// The OpenGL internal formats of the supported compression formats.
+constexpr uint32_t kCompressedRGBS3TCDXT1 = 0x83F0;
+constexpr uint32_t kCompressedRGBAS3TCDXT1 = 0x83F1;
+constexpr uint32_t kCompressedRGB8ETC2 = 0x9274;
+
+// All supported formats store 4x4 blocks of 8 bytes.
+constexpr int kBlockDimension = 4;
+constexpr size_t kBlockSize = 8;
+
+struct KTXHeader {
+  uint8_t identifier[12];
+  uint32_t endianness;
+  uint32_t gl_type;
+  uint32_t gl_type_size;
+  uint32_t gl_format;
+  uint32_t gl_internal_format;
+  uint32_t gl_base_internal_format;
+  uint32_t pixel_width;
+  uint32_t pixel_height;
+  uint32_t pixel_depth;
+  uint32_t number_of_array_elements;
+  uint32_t number_of_faces;
+  uint32_t number_of_mipmap_levels;
+  uint32_t bytes_of_key_value_data;
+};
+
+std::optional<SkImage::CompressionType> CompressionTypeForInternalFormat(
+    uint32_t internal_format) {
+  switch (internal_format) {
+    case kCompressedRGBS3TCDXT1:
+      return SkImage::CompressionType::kBC1_RGB8_UNORM;
+    case kCompressedRGBAS3TCDXT1:
+      return SkImage::CompressionType::kBC1_RGBA8_UNORM;
+    case kCompressedRGB8ETC2:
+      return SkImage::CompressionType::kETC2_RGB8_UNORM;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+std::optional<CompressedTexture> ReadKTXCompressedTexture(
+    const sk_sp<SkData>& data) {
+  KTXHeader header = {};
+  if (!data || data->size() < sizeof(header)) {
+    return std::nullopt;
+  }
+  memcpy(&header, data->data(), sizeof(header));
+  if (memcmp(header.identifier, kKTXIdentifier, sizeof(kKTXIdentifier)) !=
+      0) {
+    return std::nullopt;
+  }
+
+  if (header.endianness != kKTXEndianness) {
+    FML_LOG(ERROR) << "Big endian KTX containers are not supported.";
+    return std::nullopt;
+  }
+  auto type = CompressionTypeForInternalFormat(header.gl_internal_format);
+  // Compressed formats have no glType.
+  if (header.gl_type != 0 || !type) {
+    FML_LOG(ERROR) << "Unsupported KTX texture format 0x" << std::hex
+                   << header.gl_internal_format;
+    return std::nullopt;
+  }
+  if (header.pixel_width == 0 || header.pixel_height == 0 ||
+      header.pixel_width > INT32_MAX || header.pixel_height > INT32_MAX ||
+      header.pixel_depth != 0 || header.number_of_array_elements != 0 ||
+      header.number_of_faces != 1) {
+    FML_LOG(ERROR) << "Only 2D KTX textures are supported.";
+    return std::nullopt;
+  }
+
+  const size_t level_offset = sizeof(header) + header.bytes_of_key_value_data;
+  uint32_t level_size = 0;
+  if (level_offset > data->size() ||
+      data->size() - level_offset < sizeof(level_size)) {
+    FML_LOG(ERROR) << "Truncated KTX container.";
+    return std::nullopt;
+  }
+  memcpy(&level_size, data->bytes() + level_offset, sizeof(level_size));
+
+  const size_t blocks_wide =
+      (header.pixel_width + kBlockDimension - 1) / kBlockDimension;
+  const size_t blocks_high =
+      (header.pixel_height + kBlockDimension - 1) / kBlockDimension;
+  const size_t expected_size = blocks_wide * blocks_high * kBlockSize;
+  const size_t data_offset = level_offset + sizeof(level_size);
+  if (level_size < expected_size ||
+      data->size() - data_offset < expected_size) {
+    FML_LOG(ERROR) << "Truncated KTX container.";
+    return std::nullopt;
+  }
+
+  return CompressedTexture{
+      *type,
+      SkISize::Make(header.pixel_width, header.pixel_height),
+      SkData::MakeSubset(data.get(), data_offset, expected_size),
+  };
+}
+
+}  // namespace flutter
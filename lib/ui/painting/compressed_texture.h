@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_COMPRESSED_TEXTURE_H_
+#define FLUTTER_LIB_UI_PAINTING_COMPRESSED_TEXTURE_H_
+
+#include <optional>
+
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+/// The blocks of a texture in a GPU compression format, which can be uploaded
+/// without decoding.
+struct CompressedTexture {
+  SkImage::CompressionType type;
+  SkISize dimensions;
+  sk_sp<SkData> data;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Reads the first mipmap level of a texture from a little endian
+///             KTX 1.1 container.
+///
+///             Only the compression formats Skia can upload are supported:
+///             ETC2 RGB8 and BC1 (DXT1) RGB8 and RGBA8. Array, cube map and 3D
+///             textures are not.
+///
+/// @param[in]  data  The container.
+///
+/// @return     The texture, or std::nullopt if |data| is not a KTX container
+///             of a supported texture. The texture data shares the memory of
+///             |data|.
+///
+std::optional<CompressedTexture> ReadKTXCompressedTexture(
+    const sk_sp<SkData>& data);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_COMPRESSED_TEXTURE_H_
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/compressed_texture.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+template <typename T>
+void Append(std::vector<uint8_t>& data, T value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+std::vector<uint8_t> CreateKTX(uint32_t internal_format,
+                               uint32_t width,
+                               uint32_t height,
+                               size_t image_size) {
+  const uint8_t identifier[12] = {0xAB, 'K',  'T',  'X',  ' ',  '1',
+                                  '1',  0xBB, '\r', '\n', 0x1A, '\n'};
+  std::vector<uint8_t> data(identifier, identifier + sizeof(identifier));
+  Append<uint32_t>(data, 0x04030201);       // endianness
+  Append<uint32_t>(data, 0);                // glType
+  Append<uint32_t>(data, 1);                // glTypeSize
+  Append<uint32_t>(data, 0);                // glFormat
+  Append<uint32_t>(data, internal_format);  // glInternalFormat
+  Append<uint32_t>(data, 0x1907);           // glBaseInternalFormat
+  Append<uint32_t>(data, width);            // pixelWidth
+  Append<uint32_t>(data, height);           // pixelHeight
+  Append<uint32_t>(data, 0);                // pixelDepth
+  Append<uint32_t>(data, 0);                // numberOfArrayElements
+  Append<uint32_t>(data, 1);                // numberOfFaces
+  Append<uint32_t>(data, 1);                // numberOfMipmapLevels
+  Append<uint32_t>(data, 8);                // bytesOfKeyValueData
+  Append<uint64_t>(data, 0);
+  Append<uint32_t>(data, image_size);
+  data.resize(data.size() + image_size, 0x55);
+  return data;
+}
+
+sk_sp<SkData> ToSkData(const std::vector<uint8_t>& data) {
+  return SkData::MakeWithCopy(data.data(), data.size());
+}
+
+}  // namespace
+
+TEST(CompressedTextureTest, ReadsETC2AndBC1Textures) {
+  // 9x5 pixels take 3x2 blocks of 8 bytes.
+  auto etc2 = ReadKTXCompressedTexture(ToSkData(CreateKTX(0x9274, 9, 5, 48)));
+  ASSERT_TRUE(etc2.has_value());
+  ASSERT_EQ(etc2->type, SkImage::CompressionType::kETC2_RGB8_UNORM);
+  ASSERT_EQ(etc2->dimensions, SkISize::Make(9, 5));
+  ASSERT_EQ(etc2->data->size(), 48u);
+  ASSERT_EQ(etc2->data->bytes()[0], 0x55);
+
+  auto bc1 = ReadKTXCompressedTexture(ToSkData(CreateKTX(0x83F1, 4, 4, 8)));
+  ASSERT_TRUE(bc1.has_value());
+  ASSERT_EQ(bc1->type, SkImage::CompressionType::kBC1_RGBA8_UNORM);
+}
+
+TEST(CompressedTextureTest, RejectsUnsupportedOrTruncatedContainers) {
+  // ASTC 4x4.
+  ASSERT_FALSE(ReadKTXCompressedTexture(ToSkData(CreateKTX(0x93B0, 4, 4, 16))));
+  // Too small for 3x2 blocks.
+  ASSERT_FALSE(ReadKTXCompressedTexture(ToSkData(CreateKTX(0x9274, 9, 5, 40))));
+
+  auto data = CreateKTX(0x9274, 4, 4, 8);
+  data.resize(data.size() - 1);
+  ASSERT_FALSE(ReadKTXCompressedTexture(ToSkData(data)));
+  data.resize(20);
+  ASSERT_FALSE(ReadKTXCompressedTexture(ToSkData(data)));
+
+  ASSERT_FALSE(ReadKTXCompressedTexture(SkData::MakeEmpty()));
+  ASSERT_FALSE(ReadKTXCompressedTexture(nullptr));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <functional>
+#include <string_view>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+bool DecodedImageCache::Key::operator==(const Key& other) const {
+  if (hash != other.hash || target_width != other.target_width ||
+      target_height != other.target_height) {
+    return false;
+  }
+  return data == other.data ||
+         (data && other.data && data->equals(other.data.get()));
+}
+
+DecodedImageCache::DecodedImageCache(size_t max_bytes,
+                                     fml::RefPtr<SkiaUnrefQueue> unref_queue)
+    : max_bytes_(max_bytes), unref_queue_(std::move(unref_queue)) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+DecodedImageCache::Key DecodedImageCache::MakeKey(sk_sp<SkData> data,
+                                                  uint32_t target_width,
+                                                  uint32_t target_height) {
+  TRACE_EVENT0("flutter", "DecodedImageCache::MakeKey");
+  size_t hash = 0;
+  if (data) {
+    hash = std::hash<std::string_view>()(std::string_view(
+        static_cast<const char*>(data->data()), data->size()));
+  }
+  hash = hash * 31 + target_width;
+  hash = hash * 31 + target_height;
+  return {std::move(data), target_width, target_height, hash};
+}
+
+SkiaGPUObject<SkImage> DecodedImageCache::Get(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    miss_count_++;
+    return {};
+  }
+  hit_count_++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return {found->second->image.get(), found->second->unref_queue};
+}
+
+void DecodedImageCache::Put(Key key,
+                            sk_sp<SkImage> image,
+                            fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+  if (!image) {
+    return;
+  }
+  // The key keeps the encoded bytes alive, so they count against the budget.
+  const size_t byte_size = image->imageInfo().computeMinByteSize() +
+                           (key.data ? key.data->size() : 0);
+  if (byte_size > max_bytes_) {
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (index_.find(key) != index_.end()) {
+    // Another decode of the same image finished first.
+    return;
+  }
+  EvictLocked(max_bytes_ - byte_size);
+  if (!unref_queue) {
+    unref_queue = unref_queue_;
+  }
+  entries_.push_front(
+      {key, {std::move(image), unref_queue}, unref_queue, byte_size});
+  index_[std::move(key)] = entries_.begin();
+  byte_size_ += byte_size;
+}
+
+void DecodedImageCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  byte_size_ = 0;
+}
+
+void DecodedImageCache::Trim(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  EvictLocked(max_bytes);
+}
+
+void DecodedImageCache::EvictLocked(size_t max_bytes) {
+  while (byte_size_ > max_bytes) {
+    byte_size_ -= entries_.back().byte_size;
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+DecodedImageCache::Stats DecodedImageCache::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  Stats stats;
+  stats.hit_count = hit_count_;
+  stats.miss_count = miss_count_;
+  stats.entry_count = entries_.size();
+  stats.byte_size = byte_size_;
+  stats.max_bytes = max_bytes_;
+  return stats;
+}
+
+}  // namespace flutter
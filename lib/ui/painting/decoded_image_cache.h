@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A cache of the images produced by the |ImageDecoder|, keyed by the content
+/// of the encoded data and the size it was decoded to.
+///
+/// Two image descriptors created from the same bytes and decoded at the same
+/// size share a single decode and texture upload. Keys compare the encoded
+/// bytes themselves, so a hash collision never returns the wrong image.
+///
+/// The cache is bounded by the byte size of the decoded images and of the
+/// encoded bytes their keys retain, and evicts the least recently used images
+/// first. Evicted images are released through the unref queue of the IO
+/// manager that uploaded them.
+///
+/// All methods are thread-safe.
+///
+class DecodedImageCache {
+ public:
+  struct Key {
+    sk_sp<SkData> data;
+    uint32_t target_width = 0;
+    uint32_t target_height = 0;
+    size_t hash = 0;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct Stats {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    size_t entry_count = 0;
+    size_t byte_size = 0;
+    size_t max_bytes = 0;
+  };
+
+  DecodedImageCache(size_t max_bytes, fml::RefPtr<SkiaUnrefQueue> unref_queue);
+
+  ~DecodedImageCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hashes the encoded data. This reads all of |data| and should
+  ///             not be done on the UI thread.
+  ///
+  static Key MakeKey(sk_sp<SkData> data,
+                     uint32_t target_width,
+                     uint32_t target_height);
+
+  //----------------------------------------------------------------------------
+  /// @return     A new reference to the cached image, or an empty object.
+  ///
+  SkiaGPUObject<SkImage> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds |image| to the cache. The image is released through
+  ///             |unref_queue|, or through the unref queue of the cache if
+  ///             it is null.
+  ///
+  void Put(Key key,
+           sk_sp<SkImage> image,
+           fml::RefPtr<SkiaUnrefQueue> unref_queue = nullptr);
+
+  void Clear();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Evicts the least recently used images until the cache holds
+  ///             at most |max_bytes|.
+  ///
+  void Trim(size_t max_bytes);
+
+  Stats GetStats() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  struct Entry {
+    Key key;
+    SkiaGPUObject<SkImage> image;
+    fml::RefPtr<SkiaUnrefQueue> unref_queue;
+    size_t byte_size;
+  };
+
+  const size_t max_bytes_;
+  const fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  size_t byte_size_ = 0;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+
+  void EvictLocked(size_t max_bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
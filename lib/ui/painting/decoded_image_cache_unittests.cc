@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include "flutter/testing/testing.h"
+#include "flutter/testing/thread_test.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+using DecodedImageCacheTest = ThreadTest;
+
+namespace {
+
+sk_sp<SkData> MakeData(const std::string& contents) {
+  return SkData::MakeWithCopy(contents.data(), contents.size());
+}
+
+// A 10x10 N32 image of 400 bytes.
+sk_sp<SkImage> MakeImage() {
+  auto surface = SkSurface::MakeRasterN32Premul(10, 10);
+  return surface->makeImageSnapshot();
+}
+
+}  // namespace
+
+TEST_F(DecodedImageCacheTest, EqualBytesShareAnImage) {
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      GetCurrentTaskRunner(), fml::TimeDelta::FromSeconds(0));
+  auto cache = std::make_unique<DecodedImageCache>(1000, queue);
+
+  auto image = MakeImage();
+  cache->Put(DecodedImageCache::MakeKey(MakeData("png"), 10, 10), image);
+
+  // A different SkData with the same contents finds the image.
+  auto found =
+      cache->Get(DecodedImageCache::MakeKey(MakeData("png"), 10, 10));
+  ASSERT_EQ(found.get(), image);
+  ASSERT_EQ(
+      cache->Get(DecodedImageCache::MakeKey(MakeData("png"), 5, 5)).get(),
+      nullptr);
+  ASSERT_EQ(
+      cache->Get(DecodedImageCache::MakeKey(MakeData("jpg"), 10, 10)).get(),
+      nullptr);
+
+  const auto stats = cache->GetStats();
+  ASSERT_EQ(stats.hit_count, 1u);
+  ASSERT_EQ(stats.miss_count, 2u);
+  ASSERT_EQ(stats.entry_count, 1u);
+  ASSERT_EQ(stats.byte_size, 403u);
+
+  found.reset();
+  cache.reset();
+  queue->Drain();
+}
+
+TEST_F(DecodedImageCacheTest, LeastRecentlyUsedImagesAreEvicted) {
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      GetCurrentTaskRunner(), fml::TimeDelta::FromSeconds(0));
+  auto cache = std::make_unique<DecodedImageCache>(1000, queue);
+  auto key = [](const std::string& contents) {
+    return DecodedImageCache::MakeKey(MakeData(contents), 10, 10);
+  };
+
+  cache->Put(key("a"), MakeImage());
+  cache->Put(key("b"), MakeImage());
+  // Touching "a" makes "b" the least recently used image.
+  ASSERT_NE(cache->Get(key("a")).get(), nullptr);
+  cache->Put(key("c"), MakeImage());
+
+  ASSERT_EQ(cache->GetStats().byte_size, 802u);
+  ASSERT_NE(cache->Get(key("a")).get(), nullptr);
+  ASSERT_EQ(cache->Get(key("b")).get(), nullptr);
+  ASSERT_NE(cache->Get(key("c")).get(), nullptr);
+
+  // Images larger than the whole budget are not cached.
+  DecodedImageCache small_cache(100, queue);
+  small_cache.Put(key("a"), MakeImage());
+  ASSERT_EQ(small_cache.GetStats().entry_count, 0u);
+
+  cache->Clear();
+  ASSERT_EQ(cache->GetStats().entry_count, 0u);
+  ASSERT_EQ(cache->GetStats().byte_size, 0u);
+
+  cache.reset();
+  queue->Drain();
+}
+
+TEST_F(DecodedImageCacheTest, TrimEvictsLeastRecentlyUsedImages) {
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      GetCurrentTaskRunner(), fml::TimeDelta::FromSeconds(0));
+  auto cache = std::make_unique<DecodedImageCache>(1000, queue);
+  auto key = [](const std::string& contents) {
+    return DecodedImageCache::MakeKey(MakeData(contents), 10, 10);
+  };
+
+  cache->Put(key("a"), MakeImage());
+  cache->Put(key("b"), MakeImage());
+  ASSERT_NE(cache->Get(key("a")).get(), nullptr);
+
+  cache->Trim(cache->GetStats().byte_size / 2);
+  ASSERT_EQ(cache->GetStats().entry_count, 1u);
+  ASSERT_EQ(cache->GetStats().byte_size, 401u);
+  ASSERT_NE(cache->Get(key("a")).get(), nullptr);
+  ASSERT_EQ(cache->Get(key("b")).get(), nullptr);
+
+  // The budget is unchanged.
+  cache->Put(key("c"), MakeImage());
+  ASSERT_EQ(cache->GetStats().entry_count, 2u);
+
+  cache.reset();
+  queue->Drain();
+}
+
+}  // namespace testing
+}  // namespace flutter
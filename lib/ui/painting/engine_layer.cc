@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/engine_layer.h"
 
+#include "flutter/lib/ui/painting/matrix.h"
+
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -25,9 +27,87 @@ size_t EngineLayer::GetAllocationSize() const {
   return 3000;
 };
 
+void EngineLayer::latchTransform(tonic::Float64List& matrix4) {
+  if (!transform_layer_) {
+    return;
+  }
+  transform_layer_->LatchTransform(ToSkMatrix(matrix4));
+}
+
+void EngineLayer::latchClipRect(double left,
+                                double right,
+                                double top,
+                                double bottom) {
+  if (!clip_rect_layer_) {
+    return;
+  }
+  clip_rect_layer_->LatchClipRect(SkRect::MakeLTRB(left, top, right, bottom));
+}
+
+void EngineLayer::latchClipRRect(const RRect& rrect) {
+  if (!clip_rrect_layer_ || rrect.is_null) {
+    return;
+  }
+  clip_rrect_layer_->LatchClipRRect(rrect.sk_rrect);
+}
+
+void EngineLayer::latchAlpha(int alpha) {
+  if (!opacity_layer_) {
+    return;
+  }
+  opacity_layer_->LatchAlpha(static_cast<SkAlpha>(alpha));
+}
+
+// The curves are listed in the same order as LayerAnimationCurve in
+// compositing.dart.
+static LayerAnimationCurve ToLayerAnimationCurve(int curve) {
+  switch (curve) {
+    case 1:
+      return LayerAnimationCurve::kEaseIn;
+    case 2:
+      return LayerAnimationCurve::kEaseOut;
+    case 3:
+      return LayerAnimationCurve::kEaseInOut;
+    default:
+      return LayerAnimationCurve::kLinear;
+  }
+}
+
+void EngineLayer::animateTransform(tonic::Float64List& begin,
+                                   tonic::Float64List& end,
+                                   int64_t duration_micros,
+                                   int curve) {
+  if (!transform_layer_) {
+    return;
+  }
+  transform_layer_->AnimateTransform(
+      ToSkMatrix(begin), ToSkMatrix(end), fml::TimePoint::Now(),
+      fml::TimeDelta::FromMicroseconds(duration_micros),
+      ToLayerAnimationCurve(curve));
+}
+
+void EngineLayer::animateAlpha(int begin,
+                               int end,
+                               int64_t duration_micros,
+                               int curve) {
+  if (!opacity_layer_) {
+    return;
+  }
+  opacity_layer_->AnimateAlpha(
+      static_cast<SkAlpha>(begin), static_cast<SkAlpha>(end),
+      fml::TimePoint::Now(), fml::TimeDelta::FromMicroseconds(duration_micros),
+      ToLayerAnimationCurve(curve));
+}
+
 IMPLEMENT_WRAPPERTYPEINFO(ui, EngineLayer);
 
-#define FOR_EACH_BINDING(V)  // nothing to bind
+#define FOR_EACH_BINDING(V)         \
+  V(EngineLayer, latchTransform)   \
+  V(EngineLayer, latchClipRect)    \
+  V(EngineLayer, latchClipRRect)   \
+  V(EngineLayer, latchAlpha)       \
+  V(EngineLayer, animateTransform) \
+  V(EngineLayer, animateAlpha)
 
 DART_BIND_ALL(EngineLayer, FOR_EACH_BINDING)
 
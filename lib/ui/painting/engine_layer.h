@@ -5,8 +5,14 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_ENGINE_LAYER_H_
 #define FLUTTER_LIB_UI_PAINTING_ENGINE_LAYER_H_
 
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/rrect.h"
+#include "third_party/tonic/typed_data/typed_list.h"
 
 namespace tonic {
 class DartLibraryNatives;
@@ -35,13 +41,78 @@ class EngineLayer : public RefCountedDartWrappable<EngineLayer> {
     engine_layer->AssociateWithDartWrapper(dart_handle);
   }
 
+  static void MakeRetained(Dart_Handle dart_handle,
+                           std::shared_ptr<flutter::TransformLayer> layer) {
+    auto engine_layer = fml::MakeRefCounted<EngineLayer>(layer);
+    engine_layer->transform_layer_ = std::move(layer);
+    engine_layer->AssociateWithDartWrapper(dart_handle);
+  }
+
+  static void MakeRetained(Dart_Handle dart_handle,
+                           std::shared_ptr<flutter::ClipRectLayer> layer) {
+    auto engine_layer = fml::MakeRefCounted<EngineLayer>(layer);
+    engine_layer->clip_rect_layer_ = std::move(layer);
+    engine_layer->AssociateWithDartWrapper(dart_handle);
+  }
+
+  static void MakeRetained(Dart_Handle dart_handle,
+                           std::shared_ptr<flutter::ClipRRectLayer> layer) {
+    auto engine_layer = fml::MakeRefCounted<EngineLayer>(layer);
+    engine_layer->clip_rrect_layer_ = std::move(layer);
+    engine_layer->AssociateWithDartWrapper(dart_handle);
+  }
+
+  static void MakeRetained(Dart_Handle dart_handle,
+                           std::shared_ptr<flutter::OpacityLayer> layer) {
+    auto engine_layer = fml::MakeRefCounted<EngineLayer>(layer);
+    engine_layer->opacity_layer_ = std::move(layer);
+    engine_layer->AssociateWithDartWrapper(dart_handle);
+  }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
   std::shared_ptr<flutter::ContainerLayer> Layer() const { return layer_; }
 
+  // Replaces the transform of a transform layer, including in layer trees
+  // that have already been handed to the rasterizer. See
+  // |TransformLayer::LatchTransform|.
+  void latchTransform(tonic::Float64List& matrix4);
+
+  // Like |latchTransform|, for the clip of a clip rect layer. See
+  // |ClipRectLayer::LatchClipRect|.
+  void latchClipRect(double left, double right, double top, double bottom);
+
+  // Like |latchTransform|, for the clip of a clip rrect layer. See
+  // |ClipRRectLayer::LatchClipRRect|.
+  void latchClipRRect(const RRect& rrect);
+
+  // Like |latchTransform|, for the alpha of an opacity layer. See
+  // |OpacityLayer::LatchAlpha|.
+  void latchAlpha(int alpha);
+
+  // Starts animating the transform of a transform layer now. See
+  // |TransformLayer::AnimateTransform|.
+  void animateTransform(tonic::Float64List& begin,
+                        tonic::Float64List& end,
+                        int64_t duration_micros,
+                        int curve);
+
+  // Starts animating the alpha of an opacity layer now. See
+  // |OpacityLayer::AnimateAlpha|.
+  void animateAlpha(int begin, int end, int64_t duration_micros, int curve);
+
  private:
   explicit EngineLayer(std::shared_ptr<flutter::ContainerLayer> layer);
   std::shared_ptr<flutter::ContainerLayer> layer_;
+  // Only set for the layers created by |SceneBuilder::pushTransform| and
+  // |SceneBuilder::pushOffset|.
+  std::shared_ptr<flutter::TransformLayer> transform_layer_;
+  // Only set for the layers created by |SceneBuilder::pushClipRect|.
+  std::shared_ptr<flutter::ClipRectLayer> clip_rect_layer_;
+  // Only set for the layers created by |SceneBuilder::pushClipRRect|.
+  std::shared_ptr<flutter::ClipRRectLayer> clip_rrect_layer_;
+  // Only set for the layers created by |SceneBuilder::pushOpacity|.
+  std::shared_ptr<flutter::OpacityLayer> opacity_layer_;
 
   FML_FRIEND_MAKE_REF_COUNTED(EngineLayer);
 };
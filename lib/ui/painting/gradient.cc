@@ -4,6 +4,10 @@
 
 #include "flutter/lib/ui/painting/gradient.h"
 
+#include <string>
+
+#include "flutter/lib/ui/painting/shader_cache.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -15,7 +19,7 @@ typedef CanvasGradient
     Gradient;  // Because the C++ name doesn't match the Dart name.
 
 static void Gradient_constructor(Dart_NativeArguments args) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
   DartCallConstructor(&CanvasGradient::Create, args);
 }
 
@@ -38,6 +42,33 @@ fml::RefPtr<CanvasGradient> CanvasGradient::Create() {
   return fml::MakeRefCounted<CanvasGradient>();
 }
 
+namespace {
+
+enum class GradientType : uint8_t {
+  kLinear,
+  kRadial,
+  kSweep,
+  kTwoPointConical,
+};
+
+// Starts the shader cache key of a gradient with the parameters that all the
+// types of gradients have.
+std::string MakeGradientKey(GradientType type,
+                            const tonic::Int32List& colors,
+                            const tonic::Float32List& color_stops,
+                            SkTileMode tile_mode,
+                            const tonic::Float64List& matrix4) {
+  std::string key;
+  ShaderCache::AppendToKey(key, type);
+  ShaderCache::AppendToKey(key, colors.data(), colors.num_elements());
+  ShaderCache::AppendToKey(key, color_stops.data(), color_stops.num_elements());
+  ShaderCache::AppendToKey(key, tile_mode);
+  ShaderCache::AppendToKey(key, matrix4.data(), matrix4.num_elements());
+  return key;
+}
+
+}  // namespace
+
 void CanvasGradient::initLinear(const tonic::Float32List& end_points,
                                 const tonic::Int32List& colors,
                                 const tonic::Float32List& color_stops,
@@ -58,10 +89,18 @@ void CanvasGradient::initLinear(const tonic::Float32List& end_points,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  set_shader(UIDartState::CreateGPUObject(SkGradientShader::MakeLinear(
-      reinterpret_cast<const SkPoint*>(end_points.data()),
-      reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-      colors.num_elements(), tile_mode, 0, has_matrix ? &sk_matrix : nullptr)));
+  std::string key = MakeGradientKey(GradientType::kLinear, colors, color_stops,
+                                    tile_mode, matrix4);
+  ShaderCache::AppendToKey(key, end_points.data(), end_points.num_elements());
+
+  set_shader(UIDartState::CreateGPUObject(
+      UIDartState::Current()->GetShaderCache().Get(key, [&]() {
+        return SkGradientShader::MakeLinear(
+            reinterpret_cast<const SkPoint*>(end_points.data()),
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      })));
 }
 
 void CanvasGradient::initRadial(double center_x,
@@ -83,10 +122,20 @@ void CanvasGradient::initRadial(double center_x,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  set_shader(UIDartState::CreateGPUObject(SkGradientShader::MakeRadial(
-      SkPoint::Make(center_x, center_y), radius,
-      reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-      colors.num_elements(), tile_mode, 0, has_matrix ? &sk_matrix : nullptr)));
+  std::string key = MakeGradientKey(GradientType::kRadial, colors, color_stops,
+                                    tile_mode, matrix4);
+  ShaderCache::AppendToKey(key, center_x);
+  ShaderCache::AppendToKey(key, center_y);
+  ShaderCache::AppendToKey(key, radius);
+
+  set_shader(UIDartState::CreateGPUObject(
+      UIDartState::Current()->GetShaderCache().Get(key, [&]() {
+        return SkGradientShader::MakeRadial(
+            SkPoint::Make(center_x, center_y), radius,
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      })));
 }
 
 void CanvasGradient::initSweep(double center_x,
@@ -109,11 +158,22 @@ void CanvasGradient::initSweep(double center_x,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  set_shader(UIDartState::CreateGPUObject(SkGradientShader::MakeSweep(
-      center_x, center_y, reinterpret_cast<const SkColor*>(colors.data()),
-      color_stops.data(), colors.num_elements(), tile_mode,
-      start_angle * 180.0 / M_PI, end_angle * 180.0 / M_PI, 0,
-      has_matrix ? &sk_matrix : nullptr)));
+  std::string key = MakeGradientKey(GradientType::kSweep, colors, color_stops,
+                                    tile_mode, matrix4);
+  ShaderCache::AppendToKey(key, center_x);
+  ShaderCache::AppendToKey(key, center_y);
+  ShaderCache::AppendToKey(key, start_angle);
+  ShaderCache::AppendToKey(key, end_angle);
+
+  set_shader(UIDartState::CreateGPUObject(
+      UIDartState::Current()->GetShaderCache().Get(key, [&]() {
+        return SkGradientShader::MakeSweep(
+            center_x, center_y,
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode,
+            start_angle * 180.0 / M_PI, end_angle * 180.0 / M_PI, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      })));
 }
 
 void CanvasGradient::initTwoPointConical(double start_x,
@@ -138,11 +198,24 @@ void CanvasGradient::initTwoPointConical(double start_x,
     sk_matrix = ToSkMatrix(matrix4);
   }
 
-  set_shader(UIDartState::CreateGPUObject(SkGradientShader::MakeTwoPointConical(
-      SkPoint::Make(start_x, start_y), start_radius,
-      SkPoint::Make(end_x, end_y), end_radius,
-      reinterpret_cast<const SkColor*>(colors.data()), color_stops.data(),
-      colors.num_elements(), tile_mode, 0, has_matrix ? &sk_matrix : nullptr)));
+  std::string key = MakeGradientKey(GradientType::kTwoPointConical, colors,
+                                    color_stops, tile_mode, matrix4);
+  ShaderCache::AppendToKey(key, start_x);
+  ShaderCache::AppendToKey(key, start_y);
+  ShaderCache::AppendToKey(key, start_radius);
+  ShaderCache::AppendToKey(key, end_x);
+  ShaderCache::AppendToKey(key, end_y);
+  ShaderCache::AppendToKey(key, end_radius);
+
+  set_shader(UIDartState::CreateGPUObject(
+      UIDartState::Current()->GetShaderCache().Get(key, [&]() {
+        return SkGradientShader::MakeTwoPointConical(
+            SkPoint::Make(start_x, start_y), start_radius,
+            SkPoint::Make(end_x, end_y), end_radius,
+            reinterpret_cast<const SkColor*>(colors.data()),
+            color_stops.data(), colors.num_elements(), tile_mode, 0,
+            has_matrix ? &sk_matrix : nullptr);
+      })));
 }
 
 CanvasGradient::CanvasGradient() = default;
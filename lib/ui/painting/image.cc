@@ -4,7 +4,10 @@
 
 #include "flutter/lib/ui/painting/image.h"
 
+#include <optional>
+
 #include "flutter/lib/ui/painting/image_encoding.h"
+#include "flutter/lib/ui/painting/transfer_registry.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -27,12 +30,25 @@ const tonic::DartWrapperInfo& Image::dart_wrapper_info_ =
   V(Image, width)           \
   V(Image, height)          \
   V(Image, toByteData)      \
-  V(Image, dispose)
+  V(Image, dispose)         \
+  V(Image, transfer)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
+namespace {
+
+TransferRegistry<SkiaGPUObject<SkImage>>& GetTransferRegistry() {
+  static TransferRegistry<SkiaGPUObject<SkImage>>* registry =
+      new TransferRegistry<SkiaGPUObject<SkImage>>();
+  return *registry;
+}
+
+}  // namespace
+
 void CanvasImage::RegisterNatives(tonic::DartLibraryNatives* natives) {
-  natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+  natives->Register({{"Image_initFromTransferToken",
+                      CanvasImage::initFromTransferToken, 2, true},
+                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
 CanvasImage::CanvasImage() = default;
@@ -52,6 +68,50 @@ void CanvasImage::dispose() {
   ClearDartWrapper();
 }
 
+int64_t CanvasImage::transfer() {
+  // The pixels stay alive, so unlike |dispose| this does not hint that memory
+  // was freed.
+  int64_t token;
+  sk_sp<SkImage> image = image_.get();
+  if (image && !image->isTextureBacked()) {
+    // Pixels in memory can be drawn by any engine and released on any
+    // thread.
+    image_.reset();
+    token = GetTransferRegistry().Add(
+        SkiaGPUObject<SkImage>(std::move(image), nullptr));
+  } else {
+    // A texture can only be drawn with the resource context of this engine,
+    // and released on its IO thread, so only the isolates of this engine may
+    // claim it.
+    token = GetTransferRegistry().Add(
+        std::move(image_), UIDartState::Current()->GetSkiaUnrefQueue().get());
+  }
+  ClearDartWrapper();
+  return token;
+}
+
+void CanvasImage::ReleaseTransferredImages(const SkiaUnrefQueue* unref_queue) {
+  GetTransferRegistry().RemoveOwnedBy(unref_queue);
+}
+
+void CanvasImage::initFromTransferToken(Dart_NativeArguments args) {
+  Dart_Handle image_handle = Dart_GetNativeArgument(args, 0);
+  int64_t token = tonic::DartConverter<int64_t>::FromDart(
+      Dart_GetNativeArgument(args, 1));
+
+  std::optional<SkiaGPUObject<SkImage>> image = GetTransferRegistry().Take(
+      token, UIDartState::Current()->GetSkiaUnrefQueue().get());
+  if (!image) {
+    Dart_SetBooleanReturnValue(args, false);
+    return;
+  }
+
+  auto canvas_image = CanvasImage::Create();
+  canvas_image->set_image(std::move(*image));
+  canvas_image->AssociateWithDartWrapper(image_handle);
+  Dart_SetBooleanReturnValue(args, true);
+}
+
 size_t CanvasImage::GetAllocationSize() const {
   if (auto image = image_.get()) {
     const auto& info = image->imageInfo();
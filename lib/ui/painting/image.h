@@ -34,6 +34,20 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
 
   void dispose();
 
+  // Moves the image into the process-wide transfer registry, clears the Dart
+  // wrapper, and returns the token with which another isolate can claim it.
+  int64_t transfer();
+
+  // Wraps the image transferred with the token in the second argument in the
+  // Dart |_Image| passed as the first argument. Returns false if the token is
+  // unknown, was already claimed, or is a texture of another engine.
+  static void initFromTransferToken(Dart_NativeArguments args);
+
+  // Releases the textures transferred by the isolates of the engine with
+  // |unref_queue| that were not claimed. Called when the engine's IO manager
+  // goes away, on the IO thread.
+  static void ReleaseTransferredImages(const SkiaUnrefQueue* unref_queue);
+
   sk_sp<SkImage> image() const { return image_.get(); }
   void set_image(flutter::SkiaGPUObject<SkImage> image) {
     image_ = std::move(image);
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "flutter/fml/make_copyable.h"
 #include "third_party/skia/include/codec/SkCodec.h"
@@ -150,6 +151,22 @@ sk_sp<SkImage> ImageFromCompressedData(fml::RefPtr<ImageDescriptor> descriptor,
     }
   }
 
+  // Codecs that can not scale while decoding, such as PNG, can still skip
+  // rows and columns. Sample by the largest factor that keeps the image at
+  // least as large as the target.
+  if (decode_dimensions == source_dimensions && !resized_dimensions.isEmpty()) {
+    const int sample_size =
+        std::min(source_dimensions.width() / resized_dimensions.width(),
+                 source_dimensions.height() / resized_dimensions.height());
+    if (sample_size > 1) {
+      auto sampled_image = descriptor->sampled_image(sample_size);
+      if (sampled_image) {
+        return ResizeRasterImage(std::move(sampled_image), resized_dimensions,
+                                 flow);
+      }
+    }
+  }
+
   auto image = descriptor->image();
   if (!image) {
     return nullptr;
@@ -158,6 +175,146 @@ sk_sp<SkImage> ImageFromCompressedData(fml::RefPtr<ImageDescriptor> descriptor,
   return ResizeRasterImage(std::move(image), resized_dimensions, flow);
 }
 
+sk_sp<SkImage> ImageFromDescriptor(fml::RefPtr<ImageDescriptor> descriptor,
+                                   uint32_t target_width,
+                                   uint32_t target_height,
+                                   const fml::tracing::TraceFlow& flow) {
+  if (!descriptor->data() || descriptor->data()->size() == 0 ||
+      descriptor->compressed_texture()) {
+    return nullptr;
+  }
+  return descriptor->is_compressed()
+             ? ImageFromCompressedData(std::move(descriptor), target_width,
+                                       target_height, flow)
+             : ImageFromDecompressedData(std::move(descriptor), target_width,
+                                         target_height, flow);
+}
+
+// Stripes shorter than this are not worth a codec of their own.
+static constexpr int kMinStripeRows = 256;
+static constexpr size_t kMaxStripes = 8;
+
+sk_sp<SkImage> ImageFromCompressedDataInStripes(
+    fml::RefPtr<ImageDescriptor> descriptor,
+    fml::ConcurrentTaskRunner& task_runner,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  const SkImageInfo& info = descriptor->image_info();
+  const size_t stripe_count = std::min(
+      kMaxStripes, static_cast<size_t>(info.height() / kMinStripeRows));
+  if (stripe_count < 2) {
+    return nullptr;
+  }
+
+  // Skipping the scanlines above a stripe only avoids most of their decoding
+  // work for JPEG. The EXIF orientation is not applied by scanline decodes.
+  std::unique_ptr<SkCodec> first_codec =
+      SkCodec::MakeFromData(descriptor->data());
+  if (!first_codec ||
+      first_codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG ||
+      first_codec->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      first_codec->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return nullptr;
+  }
+
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << info.computeMinByteSize() << "B";
+    return nullptr;
+  }
+
+  const int rows_per_stripe = (info.height() + stripe_count - 1) / stripe_count;
+  std::atomic<bool> failed = false;
+  task_runner.ParallelFor(stripe_count, [&](size_t stripe) {
+    TRACE_EVENT0("flutter", "DecodeImageStripe");
+    const int first_row = stripe * rows_per_stripe;
+    const int row_count = std::min(rows_per_stripe, info.height() - first_row);
+    std::unique_ptr<SkCodec> codec =
+        stripe == 0 ? std::move(first_codec)
+                    : SkCodec::MakeFromData(descriptor->data());
+    if (!codec || codec->startScanlineDecode(info) != SkCodec::kSuccess ||
+        !codec->skipScanlines(first_row) ||
+        codec->getScanlines(bitmap.getAddr(0, first_row), row_count,
+                            bitmap.rowBytes()) != row_count) {
+      failed = true;
+    }
+  });
+  if (failed) {
+    FML_LOG(ERROR) << "Could not decode image in stripes.";
+    return nullptr;
+  }
+
+  // Marking this as immutable makes the MakeFromBitmap call share the pixels
+  // instead of copying.
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
+std::optional<SkYUVAPixmaps> YUVAPixmapsFromCompressedData(
+    fml::RefPtr<ImageDescriptor> descriptor,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  // The planes are not rotated by the EXIF orientation.
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(descriptor->data());
+  if (!codec || codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG ||
+      codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return std::nullopt;
+  }
+
+  // Single channel 8-bit textures are supported by every backend.
+  SkYUVAPixmapInfo::SupportedDataTypes data_types;
+  data_types.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8, 1);
+  SkYUVAPixmapInfo info;
+  if (!codec->queryYUVAInfo(data_types, &info)) {
+    return std::nullopt;
+  }
+
+  SkYUVAPixmaps pixmaps = SkYUVAPixmaps::Allocate(info);
+  if (!pixmaps.isValid()) {
+    FML_LOG(ERROR) << "Failed to allocate memory for YUV planes of size "
+                   << info.computeTotalBytes() << "B";
+    return std::nullopt;
+  }
+  if (codec->getYUVAPlanes(pixmaps) != SkCodec::kSuccess) {
+    FML_LOG(ERROR) << "Could not decode image to YUV planes.";
+    return std::nullopt;
+  }
+  return pixmaps;
+}
+
+static SkiaGPUObject<SkImage> UploadYUVAPixmaps(
+    const SkYUVAPixmaps& pixmaps,
+    fml::WeakPtr<IOManager> io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  SkiaGPUObject<SkImage> result;
+  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse(
+          [&result, context = io_manager->GetResourceContext(), &pixmaps,
+           queue = io_manager->GetSkiaUnrefQueue()] {
+            if (!context || !queue) {
+              return;
+            }
+            sk_sp<SkImage> texture_image = SkImage::MakeFromYUVAPixmaps(
+                context.get(),      // context
+                pixmaps,            // pixmaps
+                GrMipMapped::kYes,  // buildMips
+                true                // limitToMaxTextureSize
+            );
+            if (texture_image) {
+              result = {std::move(texture_image), queue};
+            }
+          }));
+  return result;
+}
+
 static SkiaGPUObject<SkImage> UploadRasterImage(
     sk_sp<SkImage> image,
     fml::WeakPtr<IOManager> io_manager,
@@ -214,6 +371,78 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+// Uploads |image| with a resource context of |pool| and passes the result to
+// |callback| on the thread of the pool that uploaded it. The texture is
+// released through the unref queue of that thread.
+static void UploadRasterImageInPool(
+    sk_sp<SkImage> image,
+    ResourceContextPool& pool,
+    std::function<void(SkiaGPUObject<SkImage>, fml::RefPtr<SkiaUnrefQueue>)>
+        callback) {
+  pool.PostUpload([image = std::move(image), callback = std::move(callback)](
+                      GrDirectContext* context,
+                      const fml::RefPtr<SkiaUnrefQueue>& queue) {
+    TRACE_EVENT0("flutter", "UploadRasterImageInPool");
+    SkPixmap pixmap;
+    if (!context || !image->peekPixels(&pixmap)) {
+      // Like on the IO thread without a resource context, the image is
+      // returned as-is.
+      callback({image, queue}, queue);
+      return;
+    }
+    sk_sp<SkImage> texture_image = SkImage::MakeCrossContextFromPixmap(
+        context,  // context
+        pixmap,   // pixmap
+        true,     // buildMips,
+        true      // limitToMaxTextureSize
+    );
+    if (!texture_image) {
+      FML_LOG(ERROR) << "Could not make x-context image.";
+      callback({}, queue);
+      return;
+    }
+    callback({std::move(texture_image), queue}, queue);
+  });
+}
+
+static SkiaGPUObject<SkImage> UploadCompressedTexture(
+    const CompressedTexture& texture,
+    fml::WeakPtr<IOManager> io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  const int width = texture.dimensions.width();
+  const int height = texture.dimensions.height();
+  SkiaGPUObject<SkImage> result;
+  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers()
+          .SetIfTrue([&result, &texture, width, height] {
+            result = {SkImage::MakeRasterFromCompressed(texture.data, width,
+                                                        height, texture.type),
+                      nullptr};
+          })
+          .SetIfFalse([&result, context = io_manager->GetResourceContext(),
+                       &texture, width, height,
+                       queue = io_manager->GetSkiaUnrefQueue()] {
+            sk_sp<SkImage> texture_image;
+            if (context && queue) {
+              texture_image = SkImage::MakeTextureFromCompressed(
+                  context.get(), texture.data, width, height, texture.type);
+            }
+            if (texture_image) {
+              result = {std::move(texture_image), queue};
+              return;
+            }
+            // There is no resource context, or the GPU does not support the
+            // compression format.
+            result = {SkImage::MakeRasterFromCompressed(texture.data, width,
+                                                        height, texture.type),
+                      queue};
+          }));
+  return result;
+}
+
 void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
                           uint32_t target_width,
                           uint32_t target_height,
@@ -244,28 +473,136 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
     return;
   }
 
+  if (descriptor->compressed_texture()) {
+    // Compressed textures need no decode, and are never resized.
+    runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+        [descriptor, io_manager = io_manager_, result,
+         flow = std::move(flow)]() mutable {
+          if (!io_manager) {
+            FML_LOG(ERROR) << "Could not acquire IO manager.";
+            return result({}, std::move(flow));
+          }
+          auto uploaded = UploadCompressedTexture(
+              *descriptor->compressed_texture(), io_manager, flow);
+          if (!uploaded.get()) {
+            FML_LOG(ERROR) << "Could not upload compressed texture.";
+          }
+          result(std::move(uploaded), std::move(flow));
+        }));
+    return;
+  }
+
+  const bool decode_in_stripes =
+      descriptor->is_compressed() && parallel_decode_pixel_threshold_ > 0 &&
+      !descriptor->should_resize(target_width, target_height) &&
+      static_cast<size_t>(descriptor->width()) * descriptor->height() >=
+          parallel_decode_pixel_threshold_;
+
+  const bool decode_to_yuv =
+      descriptor->is_compressed() && yuv_upload_enabled_ &&
+      !descriptor->should_resize(target_width, target_height);
+
+  // Raw pixels are not cached since equal bytes may be laid out differently.
+  std::shared_ptr<DecodedImageCache> cache =
+      descriptor->is_compressed() ? decoded_image_cache_ : nullptr;
+
+  std::shared_ptr<ResourceContextPool> pool =
+      resource_context_pool_ && resource_context_pool_->GetContextCount() > 0
+          ? resource_context_pool_
+          : nullptr;
+
   concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([descriptor,                              //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         target_width = target_width,             //
-                         target_height = target_height,           //
-                         flow = std::move(flow)                   //
+      fml::MakeCopyable([descriptor,                                        //
+                         io_manager = io_manager_,                          //
+                         io_runner = runners_.GetIOTaskRunner(),            //
+                         concurrent_task_runner = concurrent_task_runner_,  //
+                         decode_in_stripes,                                 //
+                         decode_to_yuv,                                     //
+                         cache,                                             //
+                         pool,                                              //
+                         result,                                            //
+                         target_width = target_width,                       //
+                         target_height = target_height,                     //
+                         flow = std::move(flow)                             //
   ]() mutable {
         // Step 1: Decompress the image.
         // On Worker.
 
-        auto decompressed =
-            descriptor->is_compressed()
-                ? ImageFromCompressedData(std::move(descriptor),  //
-                                          target_width,           //
-                                          target_height,          //
-                                          flow)
-                : ImageFromDecompressedData(std::move(descriptor),  //
+        std::optional<DecodedImageCache::Key> cache_key;
+        if (cache) {
+          cache_key = DecodedImageCache::MakeKey(descriptor->data(),
+                                                 target_width, target_height);
+          auto cached = cache->Get(*cache_key);
+          if (cached.get()) {
+            result(std::move(cached), std::move(flow));
+            return;
+          }
+        }
+
+        std::optional<SkYUVAPixmaps> pixmaps;
+        if (decode_to_yuv) {
+          pixmaps = YUVAPixmapsFromCompressedData(descriptor, flow);
+        }
+        if (pixmaps) {
+          // Step 2: Upload the planes to the GPU.
+          // On IO Thread.
+          io_runner->PostTask(fml::MakeCopyable(
+              [io_manager, descriptor, pixmaps = std::move(*pixmaps), result,
+               cache, cache_key = std::move(cache_key),
+               flow = std::move(flow)]() mutable {
+                if (!io_manager) {
+                  FML_LOG(ERROR) << "Could not acquire IO manager.";
+                  return result({}, std::move(flow));
+                }
+
+                auto uploaded = UploadYUVAPixmaps(pixmaps, io_manager, flow);
+
+                // The planes can not be used without the GPU. Decode the
+                // pixels instead, as is done for all other images.
+                if (!uploaded.get()) {
+                  auto decompressed = ImageFromCompressedData(
+                      descriptor, descriptor->width(), descriptor->height(),
+                      flow);
+                  if (decompressed && io_manager->GetResourceContext()) {
+                    uploaded = UploadRasterImage(std::move(decompressed),
+                                                 io_manager, flow);
+                  } else if (decompressed) {
+                    uploaded = {std::move(decompressed),
+                                io_manager->GetSkiaUnrefQueue()};
+                  }
+                }
+
+                if (!uploaded.get()) {
+                  FML_LOG(ERROR) << "Could not upload image to the GPU.";
+                  result({}, std::move(flow));
+                  return;
+                }
+
+                if (cache) {
+                  cache->Put(std::move(*cache_key), uploaded.get());
+                }
+                result(std::move(uploaded), std::move(flow));
+              }));
+          return;
+        }
+
+        sk_sp<SkImage> decompressed;
+        if (decode_in_stripes) {
+          decompressed = ImageFromCompressedDataInStripes(
+              descriptor, *concurrent_task_runner, flow);
+        }
+        if (!decompressed) {
+          decompressed =
+              descriptor->is_compressed()
+                  ? ImageFromCompressedData(std::move(descriptor),  //
                                             target_width,           //
                                             target_height,          //
-                                            flow);
+                                            flow)
+                  : ImageFromDecompressedData(std::move(descriptor),  //
+                                              target_width,           //
+                                              target_height,          //
+                                              flow);
+        }
 
         if (!decompressed) {
           FML_LOG(ERROR) << "Could not decompress image.";
@@ -273,10 +610,36 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
           return;
         }
 
+        if (pool) {
+          // Step 2: Upload the image to the GPU.
+          // On a thread of the resource context pool.
+          UploadRasterImageInPool(
+              std::move(decompressed), *pool,
+              fml::MakeCopyable(
+                  [result, cache, cache_key = std::move(cache_key),
+                   flow = std::move(flow)](
+                      SkiaGPUObject<SkImage> uploaded,
+                      fml::RefPtr<SkiaUnrefQueue> queue) mutable {
+                    if (!uploaded.get()) {
+                      FML_LOG(ERROR) << "Could not upload image to the GPU.";
+                      result({}, std::move(flow));
+                      return;
+                    }
+                    if (cache) {
+                      cache->Put(std::move(*cache_key), uploaded.get(),
+                                 std::move(queue));
+                    }
+                    result(std::move(uploaded), std::move(flow));
+                  }));
+          return;
+        }
+
         // Step 2: Update the image to the GPU.
         // On IO Thread.
 
         io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
+                                               cache,
+                                               cache_key = std::move(cache_key),
                                                flow =
                                                    std::move(flow)]() mutable {
           if (!io_manager) {
@@ -288,6 +651,9 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
           // might not have set one or a software backend could be in use.
           // Either way, just return the image as-is.
           if (!io_manager->GetResourceContext()) {
+            if (cache) {
+              cache->Put(std::move(*cache_key), decompressed);
+            }
             result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
                    std::move(flow));
             return;
@@ -302,6 +668,10 @@ void ImageDecoder::Decode(fml::RefPtr<ImageDescriptor> descriptor,
             return;
           }
 
+          if (cache) {
+            cache->Put(std::move(*cache_key), uploaded.get());
+          }
+
           // Finally, all done.
           result(std::move(uploaded), std::move(flow));
         }));
@@ -312,4 +682,43 @@ fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
 
+void ImageDecoder::SetParallelDecodePixelThreshold(size_t threshold) {
+  parallel_decode_pixel_threshold_ = threshold;
+}
+
+void ImageDecoder::SetDecodedImageCache(
+    std::shared_ptr<DecodedImageCache> cache) {
+  decoded_image_cache_ = std::move(cache);
+}
+
+void ImageDecoder::SetResourceContextPool(
+    std::shared_ptr<ResourceContextPool> pool) {
+  resource_context_pool_ = std::move(pool);
+}
+
+void ImageDecoder::SetYUVUploadEnabled(bool enabled) {
+  yuv_upload_enabled_ = enabled;
+}
+
+void ImageDecoder::SetAnimatedFrameAheadBytes(size_t bytes) {
+  animated_frame_ahead_bytes_ = bytes;
+}
+
+size_t ImageDecoder::GetAnimatedFrameAheadBytes() const {
+  return animated_frame_ahead_bytes_;
+}
+
+void ImageDecoder::SetPlatformDecodePixelThreshold(size_t threshold) {
+  platform_decode_pixel_threshold_ = threshold;
+}
+
+size_t ImageDecoder::GetPlatformDecodePixelThreshold() const {
+  return platform_decode_pixel_threshold_;
+}
+
+const std::shared_ptr<fml::ConcurrentTaskRunner>&
+ImageDecoder::GetConcurrentTaskRunner() const {
+  return concurrent_task_runner_;
+}
+
 }  // namespace flutter
@@ -15,12 +15,15 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/resource_context_pool.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 
 namespace flutter {
 
@@ -45,6 +48,9 @@ class ImageDecoder {
   // concurrently. Texture upload is done on the IO thread and the result
   // returned back on the UI thread. On error, the texture is null but the
   // callback is guaranteed to return on the UI thread.
+  //
+  // GPU compressed textures skip the worker thread, and are uploaded at their
+  // own size regardless of the target size.
   void Decode(fml::RefPtr<ImageDescriptor> descriptor,
               uint32_t target_width,
               uint32_t target_height,
@@ -52,10 +58,49 @@ class ImageDecoder {
 
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
+  // Encoded images with at least this many pixels that are decoded at their
+  // full size are split into stripes decoded in parallel on the concurrent
+  // task runner. Zero disables parallel decoding.
+  void SetParallelDecodePixelThreshold(size_t threshold);
+
+  // Compressed images found in the cache skip decoding and upload, and the
+  // images that are decoded are added to it. May be null.
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  // Decoded images are uploaded on the threads of the pool instead of the IO
+  // thread when it has resource contexts. May be null.
+  void SetResourceContextPool(std::shared_ptr<ResourceContextPool> pool);
+
+  // Encoded JPEGs decoded at their full size are decoded to YUV planes that
+  // are uploaded as separate textures and converted to RGB on the GPU.
+  void SetYUVUploadEnabled(bool enabled);
+
+  // Animated images decode up to this many bytes of frames ahead of playback
+  // on the concurrent task runner. Zero decodes each frame when requested.
+  void SetAnimatedFrameAheadBytes(size_t bytes);
+
+  size_t GetAnimatedFrameAheadBytes() const;
+
+  // Encoded JPEG and HEIF still images with at least this many pixels are
+  // decoded by the platform's decoder, which may be backed by hardware, when
+  // it can decode them. Zero leaves them to Skia.
+  void SetPlatformDecodePixelThreshold(size_t threshold);
+
+  size_t GetPlatformDecodePixelThreshold() const;
+
+  const std::shared_ptr<fml::ConcurrentTaskRunner>& GetConcurrentTaskRunner()
+      const;
+
  private:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  size_t parallel_decode_pixel_threshold_ = 0;
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+  std::shared_ptr<ResourceContextPool> resource_context_pool_;
+  size_t animated_frame_ahead_bytes_ = 0;
+  size_t platform_decode_pixel_threshold_ = 0;
+  bool yuv_upload_enabled_ = false;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
@@ -66,6 +111,30 @@ sk_sp<SkImage> ImageFromCompressedData(fml::RefPtr<ImageDescriptor> descriptor,
                                        uint32_t target_height,
                                        const fml::tracing::TraceFlow& flow);
 
+// Decodes the encoded image, or copies the raw pixels, of |descriptor| into an
+// image in memory on the calling thread. Returns nullptr for compressed
+// textures, which need the GPU, and if the image can not be decoded.
+sk_sp<SkImage> ImageFromDescriptor(fml::RefPtr<ImageDescriptor> descriptor,
+                                   uint32_t target_width,
+                                   uint32_t target_height,
+                                   const fml::tracing::TraceFlow& flow);
+
+// Decodes the image at its full size in horizontal stripes, each decoded by
+// its own codec on |task_runner|. Only codecs that can skip scanlines without
+// fully decoding them, currently JPEG, are split. Returns nullptr if the image
+// can not be decoded in stripes.
+sk_sp<SkImage> ImageFromCompressedDataInStripes(
+    fml::RefPtr<ImageDescriptor> descriptor,
+    fml::ConcurrentTaskRunner& task_runner,
+    const fml::tracing::TraceFlow& flow);
+
+// Decodes a top-left oriented JPEG at its full size to 8-bit YUV planes
+// instead of RGBA. Returns std::nullopt if the image can not be decoded to
+// planes.
+std::optional<SkYUVAPixmaps> YUVAPixmapsFromCompressedData(
+    fml::RefPtr<ImageDescriptor> descriptor,
+    const fml::tracing::TraceFlow& flow);
+
 }  // namespace flutter
 
 #endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
@@ -343,6 +343,65 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithoutAGPUContext) {
   latch.Wait();
 }
 
+TEST_F(ImageDecoderFixtureTest, CanDecodeJPEGsToYUVTextures) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<IOManager> io_manager;
+
+  auto release_io_manager = [&]() {
+    io_manager.reset();
+    latch.Signal();
+  };
+
+  SkISize decoded_size = SkISize::MakeEmpty();
+  auto decode_image = [&]() {
+    std::unique_ptr<ImageDecoder> image_decoder =
+        std::make_unique<ImageDecoder>(runners, loop->GetTaskRunner(),
+                                       io_manager->GetWeakIOManager());
+    image_decoder->SetYUVUploadEnabled(true);
+
+    auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+
+    ASSERT_TRUE(data);
+    ASSERT_GE(data->size(), 0u);
+
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    ASSERT_TRUE(codec);
+
+    auto descriptor =
+        fml::MakeRefCounted<ImageDescriptor>(std::move(data), std::move(codec));
+
+    ImageDecoder::ImageResult callback = [&](SkiaGPUObject<SkImage> image) {
+      ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+      ASSERT_TRUE(image.get());
+      EXPECT_TRUE(image.get()->isTextureBacked());
+      decoded_size = image.get()->dimensions();
+      runners.GetIOTaskRunner()->PostTask(release_io_manager);
+    };
+    image_decoder->Decode(descriptor, descriptor->width(), descriptor->height(),
+                          callback);
+  };
+
+  auto setup_io_manager_and_decode = [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+    runners.GetUITaskRunner()->PostTask(decode_image);
+  };
+
+  runners.GetIOTaskRunner()->PostTask(setup_io_manager_and_decode);
+
+  latch.Wait();
+
+  ASSERT_EQ(decoded_size, SkISize::Make(3024, 4032));
+}
+
 TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   const auto image_dimensions =
       SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
@@ -562,6 +621,23 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
       SkISize::Make(6, 2));
 }
 
+TEST(ImageDecoderTest, ProbesEncodedDimensions) {
+  // The dimensions are EXIF oriented, like those of a descriptor.
+  auto jpeg_dimensions = ImageDescriptor::ProbeEncodedDimensions(
+      OpenFixtureAsSkData("Horizontal.jpg"));
+  ASSERT_TRUE(jpeg_dimensions.has_value());
+  ASSERT_EQ(*jpeg_dimensions, SkISize::Make(600, 200));
+
+  auto png_dimensions = ImageDescriptor::ProbeEncodedDimensions(
+      OpenFixtureAsSkData("Horizontal.png"));
+  ASSERT_TRUE(png_dimensions.has_value());
+  ASSERT_EQ(*png_dimensions, SkISize::Make(300, 100));
+
+  ASSERT_FALSE(ImageDescriptor::ProbeEncodedDimensions(
+                   SkData::MakeWithCString("not an image"))
+                   .has_value());
+}
+
 TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   auto data = OpenFixtureAsSkData("Horizontal.jpg");
   auto codec = SkCodec::MakeFromData(data);
@@ -591,6 +667,102 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100));
 }
 
+TEST(ImageDecoderTest, VerifySampledDecodingOfCodecsWithoutScaling) {
+  auto data = OpenFixtureAsSkData("Horizontal.png");
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  // PNG decoders can not scale, so downscaling has to rely on sampling.
+  ASSERT_EQ(codec->getScaledDimensions(0.5), codec->dimensions());
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+  const SkISize dimensions = descriptor->image_info().dimensions();
+
+  auto sampled = descriptor->sampled_image(2);
+  ASSERT_TRUE(sampled != nullptr);
+  ASSERT_EQ(sampled->dimensions(),
+            SkISize::Make(dimensions.width() / 2, dimensions.height() / 2));
+  ASSERT_EQ(descriptor->sampled_image(1), nullptr);
+
+  auto decoded =
+      ImageFromCompressedData(descriptor, dimensions.width() / 3,
+                              dimensions.height() / 3,
+                              fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(decoded != nullptr);
+  ASSERT_EQ(decoded->dimensions(),
+            SkISize::Make(dimensions.width() / 3, dimensions.height() / 3));
+}
+
+TEST(ImageDecoderTest, VerifyStripedDecodingMatchesSingleDecode) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto task_runner = loop->GetTaskRunner();
+
+  auto striped = ImageFromCompressedDataInStripes(descriptor, *task_runner,
+                                                  fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(striped != nullptr);
+  auto expected = descriptor->image();
+  ASSERT_TRUE(expected != nullptr);
+  ASSERT_EQ(striped->dimensions(), expected->dimensions());
+
+  SkPixmap striped_pixels;
+  SkPixmap expected_pixels;
+  ASSERT_TRUE(striped->peekPixels(&striped_pixels));
+  ASSERT_TRUE(expected->peekPixels(&expected_pixels));
+  for (int y = 0; y < expected_pixels.height(); y++) {
+    ASSERT_EQ(memcmp(striped_pixels.addr(0, y), expected_pixels.addr(0, y),
+                     expected_pixels.info().minRowBytes()),
+              0)
+        << "Row " << y << " differs.";
+  }
+}
+
+TEST(ImageDecoderTest, VerifyYUVDecodingOfJPEGs) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+
+  auto pixmaps =
+      YUVAPixmapsFromCompressedData(descriptor, fml::tracing::TraceFlow(""));
+  ASSERT_TRUE(pixmaps.has_value());
+  ASSERT_TRUE(pixmaps->isValid());
+  ASSERT_EQ(pixmaps->numPlanes(), 3);
+  ASSERT_EQ(pixmaps->yuvaInfo().dimensions(),
+            descriptor->image_info().dimensions());
+
+  // The planes would not be rotated by the EXIF orientation.
+  auto rotated_data = OpenFixtureAsSkData("Horizontal.jpg");
+  auto rotated = fml::MakeRefCounted<ImageDescriptor>(
+      rotated_data, SkCodec::MakeFromData(rotated_data));
+  ASSERT_FALSE(
+      YUVAPixmapsFromCompressedData(rotated, fml::tracing::TraceFlow(""))
+          .has_value());
+
+  auto png_data = OpenFixtureAsSkData("Horizontal.png");
+  auto png = fml::MakeRefCounted<ImageDescriptor>(
+      png_data, SkCodec::MakeFromData(png_data));
+  ASSERT_FALSE(YUVAPixmapsFromCompressedData(png, fml::tracing::TraceFlow(""))
+                   .has_value());
+}
+
+TEST(ImageDecoderTest, SmallImagesAreNotDecodedInStripes) {
+  auto data = OpenFixtureAsSkData("Horizontal.png");
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  auto descriptor =
+      fml::MakeRefCounted<ImageDescriptor>(data, std::move(codec));
+  auto loop = fml::ConcurrentMessageLoop::Create();
+
+  ASSERT_EQ(ImageFromCompressedDataInStripes(descriptor, *loop->GetTaskRunner(),
+                                             fml::tracing::TraceFlow("")),
+            nullptr);
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -684,5 +856,88 @@ TEST_F(ImageDecoderFixtureTest,
   latch.Wait();
 }
 
+TEST_F(ImageDecoderFixtureTest,
+       MultiFrameCodecCanBeCollectedWhileDecodingAhead) {
+  // The frames after the first are decoded on the concurrent task runner once
+  // the IO task runner has decoded the first frame. Collect the codec while
+  // that work may still be pending or running.
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto vm_data = vm_ref.GetVMData();
+
+  auto gif_mapping = OpenFixtureAsSkData("hello_loop_2.gif");
+
+  ASSERT_TRUE(gif_mapping);
+
+  auto gif_codec = std::shared_ptr<SkCodecImageGenerator>(
+      static_cast<SkCodecImageGenerator*>(
+          SkCodecImageGenerator::MakeFromEncodedCodec(gif_mapping).release()));
+  ASSERT_TRUE(gif_codec);
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<TestIOManager> io_manager;
+
+  // Setup the IO manager.
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+    latch.Signal();
+  });
+  latch.Wait();
+
+  auto isolate =
+      RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                           GetFixturesPath(), io_manager->GetWeakIOManager());
+
+  fml::RefPtr<MultiFrameCodec> codec;
+  runners.GetUITaskRunner()->PostTask([&]() {
+    EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+      Dart_Handle library = Dart_RootLibrary();
+      if (Dart_IsError(library)) {
+        return false;
+      }
+      Dart_Handle closure =
+          Dart_GetField(library, Dart_NewStringFromCString("frameCallback"));
+      if (Dart_IsError(closure) || !Dart_IsClosure(closure)) {
+        return false;
+      }
+
+      codec = fml::MakeRefCounted<MultiFrameCodec>(
+          std::move(gif_codec), loop->GetTaskRunner(), 1 << 20);
+      codec->getNextFrame(closure);
+      return true;
+    }));
+    latch.Signal();
+  });
+  latch.Wait();
+
+  // Wait for the first frame, which schedules the frames ahead.
+  runners.GetIOTaskRunner()->PostTask([&]() { latch.Signal(); });
+  latch.Wait();
+
+  runners.GetUITaskRunner()->PostTask([&]() {
+    codec = nullptr;
+    latch.Signal();
+  });
+  latch.Wait();
+
+  // Joins the workers, which may still be decoding frames ahead.
+  loop.reset();
+
+  // Destroy the IO manager
+  runners.GetIOTaskRunner()->PostTask([&]() {
+    io_manager.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -10,24 +10,13 @@
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
+#include "flutter/lib/ui/painting/platform_image_generator.h"
 #include "flutter/lib/ui/painting/single_frame_codec.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 
-#ifdef OS_MACOSX
-#include "third_party/skia/include/ports/SkImageGeneratorCG.h"
-#define PLATFORM_IMAGE_GENERATOR(data) \
-  SkImageGeneratorCG::MakeFromEncodedCG(data)
-#elif OS_WIN
-#include "third_party/skia/include/ports/SkImageGeneratorWIC.h"
-#define PLATFORM_IMAGE_GENERATOR(data) \
-  SkImageGeneratorWIC::MakeFromEncodedWIC(data)
-#else
-#define PLATFORM_IMAGE_GENERATOR(data) \
-  std::unique_ptr<SkImageGenerator>(nullptr)
-#endif
-
 namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, ImageDescriptor);
@@ -44,6 +33,8 @@ FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 void ImageDescriptor::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register(
       {{"ImageDescriptor_initEncoded", ImageDescriptor::initEncoded, 3, true},
+       {"ImageDescriptor_probeEncoded", ImageDescriptor::probeEncoded, 1,
+        true},
        FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
@@ -54,6 +45,14 @@ const SkImageInfo ImageDescriptor::CreateImageInfo() const {
   if (platform_image_generator_) {
     return platform_image_generator_->getInfo();
   }
+  if (compressed_texture_) {
+    // BC1 RGBA8 textures have 1 bit alpha, the other formats are opaque.
+    const bool opaque = compressed_texture_->type !=
+                        SkImage::CompressionType::kBC1_RGBA8_UNORM;
+    return SkImageInfo::Make(
+        compressed_texture_->dimensions, kRGBA_8888_SkColorType,
+        opaque ? kOpaque_SkAlphaType : kPremul_SkAlphaType);
+  }
   return SkImageInfo::MakeUnknown();
 }
 
@@ -85,6 +84,15 @@ ImageDescriptor::ImageDescriptor(sk_sp<SkData> buffer,
       image_info_(CreateImageInfo()),
       row_bytes_(std::nullopt) {}
 
+ImageDescriptor::ImageDescriptor(sk_sp<SkData> buffer,
+                                 CompressedTexture compressed_texture)
+    : buffer_(std::move(buffer)),
+      generator_(nullptr),
+      platform_image_generator_(nullptr),
+      compressed_texture_(std::move(compressed_texture)),
+      image_info_(CreateImageInfo()),
+      row_bytes_(std::nullopt) {}
+
 void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
   Dart_Handle callback_handle = Dart_GetNativeArgument(args, 2);
   if (!Dart_IsClosure(callback_handle)) {
@@ -104,13 +112,34 @@ void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
   }
 
   // This call will succeed if Skia has a built-in codec for this.
-  // If it fails, we will check if the platform knows how to decode this image.
+  // If it fails, we will check if the data is a GPU compressed texture, or if
+  // the platform knows how to decode this image.
   std::unique_ptr<SkCodec> codec =
       SkCodec::MakeFromData(immutable_buffer->data());
+  std::optional<CompressedTexture> compressed_texture;
   fml::RefPtr<ImageDescriptor> descriptor;
-  if (!codec) {
+  // Large photos are handed to the platform decoder when it is preferred, as
+  // it may be backed by hardware.
+  std::unique_ptr<SkImageGenerator> preferred_generator;
+  auto image_decoder = UIDartState::Current()->GetImageDecoder();
+  if (codec && image_decoder &&
+      ShouldPreferPlatformImageDecoding(
+          *codec, image_decoder->GetPlatformDecodePixelThreshold())) {
+    preferred_generator = MakePlatformImageGenerator(immutable_buffer->data());
+  }
+  if (preferred_generator) {
+    descriptor = fml::MakeRefCounted<ImageDescriptor>(
+        immutable_buffer->data(), std::move(preferred_generator));
+  } else if (codec) {
+    descriptor = fml::MakeRefCounted<ImageDescriptor>(immutable_buffer->data(),
+                                                      std::move(codec));
+  } else if ((compressed_texture =
+                  ReadKTXCompressedTexture(immutable_buffer->data()))) {
+    descriptor = fml::MakeRefCounted<ImageDescriptor>(
+        immutable_buffer->data(), std::move(*compressed_texture));
+  } else {
     std::unique_ptr<SkImageGenerator> generator =
-        PLATFORM_IMAGE_GENERATOR(immutable_buffer->data());
+        MakePlatformImageGenerator(immutable_buffer->data());
     if (!generator) {
       // We don't have a Skia codec for this image, and the platform doesn't
       // know how to decode it.
@@ -119,9 +148,6 @@ void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
     }
     descriptor = fml::MakeRefCounted<ImageDescriptor>(immutable_buffer->data(),
                                                       std::move(generator));
-  } else {
-    descriptor = fml::MakeRefCounted<ImageDescriptor>(immutable_buffer->data(),
-                                                      std::move(codec));
   }
 
   FML_DCHECK(descriptor);
@@ -130,6 +156,43 @@ void ImageDescriptor::initEncoded(Dart_NativeArguments args) {
   tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
 }
 
+std::optional<SkISize> ImageDescriptor::ProbeEncodedDimensions(
+    const sk_sp<SkData>& data) {
+  TRACE_EVENT0("flutter", "ImageDescriptor::ProbeEncodedDimensions");
+  // Creating a codec only parses the header of the image, so for a mapped
+  // asset only its first pages are read.
+  if (std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data)) {
+    const SkISize dimensions = codec->dimensions();
+    if (SkEncodedOriginSwapsWidthHeight(codec->getOrigin())) {
+      return SkISize::Make(dimensions.height(), dimensions.width());
+    }
+    return dimensions;
+  }
+  if (auto compressed_texture = ReadKTXCompressedTexture(data)) {
+    return compressed_texture->dimensions;
+  }
+  if (auto generator = MakePlatformImageGenerator(data)) {
+    return generator->getInfo().dimensions();
+  }
+  return std::nullopt;
+}
+
+void ImageDescriptor::probeEncoded(Dart_NativeArguments args) {
+  ImmutableBuffer* immutable_buffer =
+      tonic::DartConverter<ImmutableBuffer*>::FromDart(
+          Dart_GetNativeArgument(args, 0));
+  if (!immutable_buffer) {
+    Dart_SetReturnValue(args, Dart_Null());
+    return;
+  }
+
+  std::vector<int> dimensions;
+  if (auto probed = ProbeEncodedDimensions(immutable_buffer->data())) {
+    dimensions = {probed->width(), probed->height()};
+  }
+  Dart_SetReturnValue(args, tonic::ToDart(dimensions));
+}
+
 void ImageDescriptor::initRaw(Dart_Handle descriptor_handle,
                               fml::RefPtr<ImmutableBuffer> data,
                               int width,
@@ -163,7 +226,14 @@ void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
         static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
         target_height);
   } else {
-    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    auto image_decoder = UIDartState::Current()->GetImageDecoder();
+    if (image_decoder && image_decoder->GetAnimatedFrameAheadBytes() > 0) {
+      ui_codec = fml::MakeRefCounted<MultiFrameCodec>(
+          generator_, image_decoder->GetConcurrentTaskRunner(),
+          image_decoder->GetAnimatedFrameAheadBytes());
+    } else {
+      ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    }
   }
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
@@ -190,8 +260,47 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
     return generator_->getPixels(pixmap.info(), pixmap.writable_addr(),
                                  pixmap.rowBytes());
   }
+  if (compressed_texture_) {
+    // Only needed when the texture can not be uploaded as it is.
+    sk_sp<SkImage> image = SkImage::MakeRasterFromCompressed(
+        compressed_texture_->data, compressed_texture_->dimensions.width(),
+        compressed_texture_->dimensions.height(), compressed_texture_->type);
+    return image && image->readPixels(pixmap, 0, 0);
+  }
   FML_DCHECK(platform_image_generator_);
   return platform_image_generator_->getPixels(pixmap);
 }
 
+sk_sp<SkImage> ImageDescriptor::sampled_image(int sample_size) const {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  if (!generator_ || sample_size <= 1) {
+    return nullptr;
+  }
+
+  auto codec = SkAndroidCodec::MakeFromData(buffer_);
+  if (!codec || codec->codec()->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return nullptr;
+  }
+
+  const auto sampled_info = image_info_.makeDimensions(
+      codec->getSampledDimensions(sample_size));
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(sampled_info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << sampled_info.computeMinByteSize() << "B";
+    return nullptr;
+  }
+
+  SkAndroidCodec::AndroidOptions options;
+  options.fSampleSize = sample_size;
+  const auto result = codec->getAndroidPixels(
+      sampled_info, bitmap.getPixels(), bitmap.rowBytes(), &options);
+  if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput) {
+    return nullptr;
+  }
+
+  bitmap.setImmutable();
+  return SkImage::MakeFromBitmap(bitmap);
+}
+
 }  // namespace flutter
@@ -11,6 +11,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/compressed_texture.h"
 #include "flutter/lib/ui/painting/immutable_buffer.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/core/SkImageGenerator.h"
@@ -42,8 +43,23 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///
   /// Calling this method will result in creating an SkCodec and
   /// SkImageGenerator to read EXIF corrected dimensions from the image data.
+  ///
+  /// KTX containers of GPU compressed textures are also accepted. Their
+  /// texture is uploaded as it is, and never decoded on the CPU.
   static void initEncoded(Dart_NativeArguments args);
 
+  /// Reads the EXIF oriented dimensions of an encoded image from its header,
+  /// in the formats |initEncoded| accepts.
+  ///
+  /// Unlike |initEncoded|, no codec or reference to |data| is kept, and
+  /// nothing is decoded. Returns nullopt if the format is not supported.
+  static std::optional<SkISize> ProbeEncodedDimensions(
+      const sk_sp<SkData>& data);
+
+  /// Returns the dimensions of the encoded image in a buffer as a list of its
+  /// width and height, or an empty list. See |ProbeEncodedDimensions|.
+  static void probeEncoded(Dart_NativeArguments args);
+
   /// Synchronously initializes an ImageDescriptor for decompressed image data
   /// as specified by the PixelFormat.
   static void initRaw(Dart_Handle descriptor_handle,
@@ -84,7 +100,15 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
 
   sk_sp<SkImage> image() const;
 
+  /// The GPU compressed texture read from a KTX container, if this descriptor
+  /// was created from one.
+  const std::optional<CompressedTexture>& compressed_texture() const {
+    return compressed_texture_;
+  }
+
   /// Whether this descriptor represents compressed (encoded) data or not.
+  ///
+  /// GPU compressed textures are not encoded, and are not decoded by a codec.
   bool is_compressed() const { return generator_ || platform_image_generator_; }
 
   /// The orientation corrected image info for this image.
@@ -103,6 +127,16 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   /// if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// Decodes this image keeping only every |sample_size|-th row and column.
+  ///
+  /// Unlike |get_scaled_dimensions|, which only some codecs such as JPEG
+  /// support, most codecs can sample while decoding. The full resolution
+  /// pixels are never allocated.
+  ///
+  /// Returns nullptr if the image can not be sampled, including images with an
+  /// EXIF orientation, which sampled decodes do not apply.
+  sk_sp<SkImage> sampled_image(int sample_size) const;
+
   void dispose() {
     ClearDartWrapper();
     generator_.reset();
@@ -122,10 +156,12 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ImageDescriptor(sk_sp<SkData> buffer, std::unique_ptr<SkCodec> codec);
   ImageDescriptor(sk_sp<SkData> buffer,
                   std::unique_ptr<SkImageGenerator> generator);
+  ImageDescriptor(sk_sp<SkData> buffer, CompressedTexture compressed_texture);
 
   sk_sp<SkData> buffer_;
   std::shared_ptr<SkCodecImageGenerator> generator_;
   std::unique_ptr<SkImageGenerator> platform_image_generator_;
+  std::optional<CompressedTexture> compressed_texture_;
   const SkImageInfo image_info_;
   std::optional<size_t> row_bytes_;
 
@@ -12,6 +12,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
@@ -129,24 +130,28 @@ void ConvertImageToRaster(sk_sp<SkImage> image,
   // Cross-context images do not support makeRasterImage. Convert these images
   // by drawing them into a surface.  This must be done on the raster thread
   // to prevent concurrent usage of the image on both the IO and raster threads.
+  // The pixels are read back asynchronously so the raster thread keeps
+  // drawing frames meanwhile.
   raster_task_runner->PostTask([image, encode_task = std::move(encode_task),
                                 resource_context, snapshot_delegate,
                                 io_task_runner]() {
-    sk_sp<SkImage> raster_image =
-        snapshot_delegate->ConvertToRasterImage(image);
-
-    io_task_runner->PostTask([image, encode_task = std::move(encode_task),
-                              raster_image = std::move(raster_image),
-                              resource_context]() mutable {
-      if (!raster_image) {
-        // The rasterizer was unable to render the cross-context image
-        // (presumably because it does not have a GrContext).  In that case,
-        // convert the image on the IO thread using the resource context.
-        raster_image =
-            ConvertToRasterUsingResourceContext(image, resource_context);
-      }
-      encode_task(raster_image);
-    });
+    snapshot_delegate->ConvertToRasterImageAsync(
+        image, [image, encode_task, resource_context,
+                io_task_runner](sk_sp<SkImage> raster_image) {
+          io_task_runner->PostTask([image, encode_task = std::move(encode_task),
+                                    raster_image = std::move(raster_image),
+                                    resource_context]() mutable {
+            if (!raster_image) {
+              // The rasterizer was unable to render the cross-context image
+              // (presumably because it does not have a GrContext).  In that
+              // case, convert the image on the IO thread using the resource
+              // context.
+              raster_image =
+                  ConvertToRasterUsingResourceContext(image, resource_context);
+            }
+            encode_task(raster_image);
+          });
+        });
   });
 }
 
@@ -223,6 +228,7 @@ void EncodeImageAndInvokeDataCallback(
     fml::RefPtr<fml::TaskRunner> ui_task_runner,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
     fml::RefPtr<fml::TaskRunner> io_task_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     GrDirectContext* resource_context,
     fml::WeakPtr<SnapshotDelegate> snapshot_delegate) {
   auto callback_task = fml::MakeCopyable(
@@ -230,13 +236,24 @@ void EncodeImageAndInvokeDataCallback(
         InvokeDataCallback(std::move(callback), std::move(encoded));
       });
 
+  // Encoding, PNG compression in particular, can take long for large images,
+  // so it runs on the worker pool instead of holding up the IO thread.
   auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](sk_sp<SkImage> raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
-    ui_task_runner->PostTask([callback_task = std::move(callback_task),
-                              encoded = std::move(encoded)]() mutable {
-      callback_task(std::move(encoded));
-    });
+                      ui_task_runner,
+                      concurrent_task_runner](sk_sp<SkImage> raster_image) {
+    auto encode = [callback_task, format, ui_task_runner,
+                   raster_image = std::move(raster_image)]() mutable {
+      sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
+      ui_task_runner->PostTask([callback_task = std::move(callback_task),
+                                encoded = std::move(encoded)]() mutable {
+        callback_task(std::move(encoded));
+      });
+    };
+    if (concurrent_task_runner) {
+      concurrent_task_runner->PostTask(std::move(encode));
+    } else {
+      encode();
+    }
   };
 
   ConvertImageToRaster(std::move(image), encode_task, raster_task_runner,
@@ -262,19 +279,38 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
       tonic::DartState::Current(), callback_handle);
 
   const auto& task_runners = UIDartState::Current()->GetTaskRunners();
+  if (!task_runners.GetIOTaskRunner()) {
+    // Isolates other than the root isolate have no engine threads to encode
+    // on. They encode images in memory synchronously, but cannot read back
+    // textures, e.g. of images transferred from the root isolate.
+    sk_sp<SkImage> image = canvas_image->image();
+    if (!image || image->isTextureBacked()) {
+      return ToDart("Texture images can only be encoded on the root isolate.");
+    }
+    InvokeDataCallback(std::move(callback),
+                       EncodeImage(image->makeRasterImage(), image_format));
+    return Dart_Null();
+  }
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner;
+  if (auto image_decoder = UIDartState::Current()->GetImageDecoder()) {
+    concurrent_task_runner = image_decoder->GetConcurrentTaskRunner();
+  }
 
   task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
       [callback = std::move(callback), image = canvas_image->image(),
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_task_runner = std::move(concurrent_task_runner),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate =
            UIDartState::Current()->GetSnapshotDelegate()]() mutable {
         EncodeImageAndInvokeDataCallback(
             std::move(image), std::move(callback), image_format,
             std::move(ui_task_runner), std::move(raster_task_runner),
-            std::move(io_task_runner), io_manager->GetResourceContext().get(),
+            std::move(io_task_runner), std::move(concurrent_task_runner),
+            io_manager->GetResourceContext().get(),
             std::move(snapshot_delegate));
       }));
 
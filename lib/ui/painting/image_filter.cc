@@ -4,7 +4,9 @@
 
 #include "flutter/lib/ui/painting/image_filter.h"
 
+#include "flutter/flow/paint_utils.h"
 #include "flutter/lib/ui/painting/matrix.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/effects/SkBlurImageFilter.h"
 #include "third_party/skia/include/effects/SkImageFilters.h"
 #include "third_party/skia/include/effects/SkImageSource.h"
@@ -17,7 +19,7 @@
 namespace flutter {
 
 static void ImageFilter_constructor(Dart_NativeArguments args) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
   DartCallConstructor(&ImageFilter::Create, args);
 }
 
@@ -52,12 +54,18 @@ void ImageFilter::initImage(CanvasImage* image) {
 }
 
 void ImageFilter::initPicture(Picture* picture) {
-  filter_ = SkPictureImageFilter::Make(picture->picture());
+  filter_ = SkPictureImageFilter::Make(picture->ToSkPicture());
 }
 
 void ImageFilter::initBlur(double sigma_x, double sigma_y) {
   filter_ = SkBlurImageFilter::Make(sigma_x, sigma_y, nullptr, nullptr,
                                     SkBlurImageFilter::kClamp_TileMode);
+  UIDartState* state = UIDartState::Current();
+  if (state->downsampled_blur_min_sigma() > 0) {
+    layer_filter_ = MakeBlurImageFilter(sigma_x, sigma_y,
+                                        state->downsampled_blur_min_sigma(),
+                                        state->downsampled_blur_max_factor());
+  }
 }
 
 void ImageFilter::initMatrix(const tonic::Float64List& matrix4,
@@ -75,6 +83,11 @@ void ImageFilter::initColorFilter(ColorFilter* colorFilter) {
 void ImageFilter::initComposeFilter(ImageFilter* outer, ImageFilter* inner) {
   filter_ = SkImageFilters::Compose(outer ? outer->filter() : nullptr,
                                     inner ? inner->filter() : nullptr);
+  if ((outer && outer->layer_filter_) || (inner && inner->layer_filter_)) {
+    layer_filter_ =
+        SkImageFilters::Compose(outer ? outer->layer_filter() : nullptr,
+                                inner ? inner->layer_filter() : nullptr);
+  }
 }
 
 }  // namespace flutter
@@ -31,12 +31,20 @@ class ImageFilter : public RefCountedDartWrappable<ImageFilter> {
 
   const sk_sp<SkImageFilter>& filter() const { return filter_; }
 
+  // The filter applied by the layers pushed with this filter. Large blurs are
+  // downsampled there, as configured by the settings.
+  const sk_sp<SkImageFilter>& layer_filter() const {
+    return layer_filter_ ? layer_filter_ : filter_;
+  }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
   ImageFilter();
 
   sk_sp<SkImageFilter> filter_;
+  // Only set when it differs from |filter_|.
+  sk_sp<SkImageFilter> layer_filter_;
 };
 
 }  // namespace flutter
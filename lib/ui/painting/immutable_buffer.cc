@@ -5,8 +5,12 @@
 #include "flutter/lib/ui/painting/immutable_buffer.h"
 
 #include <cstring>
+#include <optional>
 
+#include "flutter/assets/asset_manager.h"
+#include "flutter/lib/ui/painting/transfer_registry.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -21,14 +25,29 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, ImmutableBuffer);
 
 #define FOR_EACH_BINDING(V)   \
   V(ImmutableBuffer, dispose) \
-  V(ImmutableBuffer, length)
+  V(ImmutableBuffer, length)  \
+  V(ImmutableBuffer, transfer)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
+namespace {
+
+TransferRegistry<sk_sp<SkData>>& GetTransferRegistry() {
+  static TransferRegistry<sk_sp<SkData>>* registry =
+      new TransferRegistry<sk_sp<SkData>>();
+  return *registry;
+}
+
+}  // namespace
+
 ImmutableBuffer::~ImmutableBuffer() {}
 
 void ImmutableBuffer::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({{"ImmutableBuffer_init", ImmutableBuffer::init, 3, true},
+                     {"ImmutableBuffer_initFromAsset",
+                      ImmutableBuffer::initFromAsset, 3, true},
+                     {"ImmutableBuffer_initFromTransferToken",
+                      ImmutableBuffer::initFromTransferToken, 2, true},
                      FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
 }
 
@@ -49,6 +68,77 @@ void ImmutableBuffer::init(Dart_NativeArguments args) {
   tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
 }
 
+void ImmutableBuffer::initFromAsset(Dart_NativeArguments args) {
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 2);
+  if (!Dart_IsClosure(callback_handle)) {
+    Dart_SetReturnValue(args, tonic::ToDart("Callback must be a function"));
+    return;
+  }
+
+  Dart_Handle buffer_handle = Dart_GetNativeArgument(args, 0);
+  std::string asset_name = tonic::DartConverter<std::string>::FromDart(
+      Dart_GetNativeArgument(args, 1));
+
+  // Only the root isolate has access to the assets.
+  PlatformConfiguration* platform_configuration =
+      UIDartState::Current()->platform_configuration();
+  std::shared_ptr<AssetManager> asset_manager =
+      platform_configuration
+          ? platform_configuration->client()->GetAssetManager()
+          : nullptr;
+  std::unique_ptr<fml::Mapping> mapping =
+      asset_manager ? asset_manager->GetAsMapping(asset_name) : nullptr;
+  if (!mapping) {
+    Dart_SetReturnValue(args, tonic::ToDart("Asset not found"));
+    return;
+  }
+
+  auto sk_data = MakeSkDataWithMapping(std::move(mapping));
+  const size_t size = sk_data->size();
+  auto buffer = fml::MakeRefCounted<ImmutableBuffer>(sk_data);
+  buffer->AssociateWithDartWrapper(buffer_handle);
+  tonic::DartInvoke(callback_handle, {tonic::ToDart(size)});
+}
+
+void ImmutableBuffer::initFromTransferToken(Dart_NativeArguments args) {
+  Dart_Handle buffer_handle = Dart_GetNativeArgument(args, 0);
+  int64_t token = tonic::DartConverter<int64_t>::FromDart(
+      Dart_GetNativeArgument(args, 1));
+
+  std::optional<sk_sp<SkData>> sk_data = GetTransferRegistry().Take(token);
+  if (!sk_data) {
+    Dart_SetIntegerReturnValue(args, -1);
+    return;
+  }
+
+  const size_t size = (*sk_data)->size();
+  auto buffer = fml::MakeRefCounted<ImmutableBuffer>(std::move(*sk_data));
+  buffer->AssociateWithDartWrapper(buffer_handle);
+  Dart_SetIntegerReturnValue(args, size);
+}
+
+int64_t ImmutableBuffer::transfer() {
+  FML_DCHECK(data_);
+  const int64_t token = GetTransferRegistry().Add(std::move(data_));
+  ClearDartWrapper();
+  return token;
+}
+
+sk_sp<SkData> ImmutableBuffer::MakeSkDataWithMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  const uint8_t* data = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+  if (data == nullptr || size == 0) {
+    return SkData::MakeEmpty();
+  }
+  // The mapping, usually a file mapping of the asset, backs the SkData until
+  // its last reference is released.
+  SkData::ReleaseProc proc = [](const void*, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(data, size, proc, mapping.release());
+}
+
 size_t ImmutableBuffer::GetAllocationSize() const {
   return sizeof(ImmutableBuffer) + data_->size();
 }
@@ -8,6 +8,7 @@
 #include <cstdint>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -39,6 +40,42 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
   /// when the copy has completed.
   static void init(Dart_NativeArguments args);
 
+  /// Initializes a new ImmutableData from an asset of the engine's asset
+  /// manager.
+  ///
+  /// The data is not copied. The buffer keeps the mapping of the asset, which
+  /// for assets on disk is a file mapping, alive instead.
+  ///
+  /// The zero indexed argument is the the caller that will be registered as the
+  /// Dart peer of the native ImmutableBuffer object.
+  ///
+  /// The first indexed argument is the name of the asset.
+  ///
+  /// The second indexed argument is expected to be a callback accepting the
+  /// length of the buffer in bytes.
+  ///
+  /// An error string is returned if the asset is not available.
+  static void initFromAsset(Dart_NativeArguments args);
+
+  /// Initializes a new ImmutableData from the data of a buffer another isolate
+  /// passed to |transfer|. The data is not copied.
+  ///
+  /// The zero indexed argument is the the caller that will be registered as the
+  /// Dart peer of the native ImmutableBuffer object.
+  ///
+  /// The first indexed argument is the token returned by |transfer|.
+  ///
+  /// The length of the buffer in bytes is returned, or -1 if the token is
+  /// unknown or was already claimed.
+  static void initFromTransferToken(Dart_NativeArguments args);
+
+  /// Moves the data into the process-wide transfer registry and disposes this
+  /// buffer.
+  ///
+  /// @return     The token with which another isolate can claim the data with
+  ///             |initFromTransferToken|.
+  int64_t transfer();
+
   /// The length of the data in bytes.
   size_t length() const {
     FML_DCHECK(data_);
@@ -69,6 +106,9 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
 
   static sk_sp<SkData> MakeSkDataWithCopy(const void* data, size_t length);
 
+  static sk_sp<SkData> MakeSkDataWithMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
   DEFINE_WRAPPERTYPEINFO();
   FML_FRIEND_MAKE_REF_COUNTED(ImmutableBuffer);
   FML_DISALLOW_COPY_AND_ASSIGN(ImmutableBuffer);
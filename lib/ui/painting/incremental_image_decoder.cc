@@ -0,0 +1,308 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/dart_args.h"
+#include "third_party/tonic/dart_binding_macros.h"
+#include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/logging/dart_invoke.h"
+
+namespace flutter {
+
+static void IncrementalImageDecoder_constructor(Dart_NativeArguments args) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  DartCallConstructor(&IncrementalImageDecoder::Create, args);
+}
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, IncrementalImageDecoder);
+
+#define FOR_EACH_BINDING(V)              \
+  V(IncrementalImageDecoder, addBytes)   \
+  V(IncrementalImageDecoder, close)      \
+  V(IncrementalImageDecoder, decode)     \
+  V(IncrementalImageDecoder, isComplete) \
+  V(IncrementalImageDecoder, dispose)
+
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+
+void IncrementalImageDecoder::RegisterNatives(
+    tonic::DartLibraryNatives* natives) {
+  natives->Register({{"IncrementalImageDecoder_constructor",
+                      IncrementalImageDecoder_constructor, 1, true},
+                     FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+}
+
+namespace {
+
+// A stream over the bytes added to the decoder so far. Reads past them return
+// no bytes without ending the stream, so the codec can resume once more bytes
+// were added.
+class IncrementalImageDecoderStream : public SkStream {
+ public:
+  explicit IncrementalImageDecoderStream(
+      const IncrementalImageDecoder::State* state)
+      : state_(state) {}
+
+  // |SkStream|
+  size_t read(void* buffer, size_t size) override {
+    const size_t read = state_->ReadBytes(offset_, buffer, size);
+    offset_ += read;
+    return read;
+  }
+
+  // |SkStream|
+  bool isAtEnd() const override { return state_->IsAtEnd(offset_); }
+
+  // |SkStream|
+  bool rewind() override {
+    offset_ = 0;
+    return true;
+  }
+
+ private:
+  // The state owns the codec that owns this stream.
+  const IncrementalImageDecoder::State* state_;
+  size_t offset_ = 0;
+};
+
+}  // namespace
+
+IncrementalImageDecoder::State::State() = default;
+
+IncrementalImageDecoder::State::~State() = default;
+
+void IncrementalImageDecoder::State::AddBytes(const uint8_t* bytes,
+                                              size_t size) {
+  std::scoped_lock lock(data_mutex_);
+  if (closed_) {
+    return;
+  }
+  data_.insert(data_.end(), bytes, bytes + size);
+}
+
+void IncrementalImageDecoder::State::Close() {
+  std::scoped_lock lock(data_mutex_);
+  closed_ = true;
+}
+
+bool IncrementalImageDecoder::State::IsComplete() const {
+  return complete_;
+}
+
+size_t IncrementalImageDecoder::State::ReadBytes(size_t offset,
+                                                 void* buffer,
+                                                 size_t size) const {
+  std::scoped_lock lock(data_mutex_);
+  if (offset >= data_.size()) {
+    return 0;
+  }
+  const size_t read = std::min(size, data_.size() - offset);
+  if (buffer) {
+    memcpy(buffer, data_.data() + offset, read);
+  }
+  return read;
+}
+
+bool IncrementalImageDecoder::State::IsAtEnd(size_t offset) const {
+  std::scoped_lock lock(data_mutex_);
+  return closed_ && offset >= data_.size();
+}
+
+sk_sp<SkImage> IncrementalImageDecoder::State::Decode() {
+  TRACE_EVENT0("flutter", "IncrementalImageDecoder::Decode");
+  std::scoped_lock lock(decode_mutex_);
+  if (complete_) {
+    return SkImage::MakeRasterCopy(bitmap_.pixmap());
+  }
+
+  bool closed = false;
+  {
+    std::scoped_lock data_lock(data_mutex_);
+    closed = closed_;
+  }
+
+  if (!codec_) {
+    // Fails until the bytes of the header were added.
+    codec_ = SkCodec::MakeFromStream(
+        std::make_unique<IncrementalImageDecoderStream>(this));
+    if (!codec_) {
+      if (closed) {
+        FML_LOG(ERROR) << "Invalid image data";
+      }
+      return nullptr;
+    }
+    SkImageInfo info = codec_->getInfo().makeColorType(kN32_SkColorType);
+    if (info.alphaType() == kUnpremul_SkAlphaType) {
+      info = info.makeAlphaType(kPremul_SkAlphaType);
+    }
+    if (!bitmap_.tryAllocPixels(info)) {
+      FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                     << info.computeMinByteSize() << "B";
+      codec_.reset();
+      return nullptr;
+    }
+    bitmap_.eraseColor(SK_ColorTRANSPARENT);
+  }
+
+  if (!incremental_decode_started_) {
+    const SkCodec::Result result = codec_->startIncrementalDecode(
+        bitmap_.info(), bitmap_.getPixels(), bitmap_.rowBytes());
+    if (result == SkCodec::kIncompleteInput) {
+      return nullptr;
+    }
+    if (result != SkCodec::kSuccess) {
+      // The codec can not decode incrementally. Decode the image once all of
+      // its bytes were added.
+      if (!closed) {
+        return nullptr;
+      }
+      if (codec_->getPixels(bitmap_.pixmap()) != SkCodec::kSuccess) {
+        FML_LOG(ERROR) << "Could not decode image.";
+        return nullptr;
+      }
+      complete_ = true;
+      return SkImage::MakeRasterCopy(bitmap_.pixmap());
+    }
+    incremental_decode_started_ = true;
+  }
+
+  int rows_decoded = 0;
+  const SkCodec::Result result = codec_->incrementalDecode(&rows_decoded);
+  if (result == SkCodec::kSuccess) {
+    complete_ = true;
+  } else if (result != SkCodec::kIncompleteInput) {
+    FML_LOG(ERROR) << "Could not decode image incrementally.";
+    return nullptr;
+  } else if (closed) {
+    // The image is truncated. Show what could be decoded.
+    complete_ = true;
+  } else if (rows_decoded == 0) {
+    return nullptr;
+  }
+
+  // The bitmap keeps being written by the next decodes.
+  return SkImage::MakeRasterCopy(bitmap_.pixmap());
+}
+
+fml::RefPtr<IncrementalImageDecoder> IncrementalImageDecoder::Create() {
+  return fml::MakeRefCounted<IncrementalImageDecoder>();
+}
+
+IncrementalImageDecoder::IncrementalImageDecoder()
+    : state_(std::make_shared<State>()) {}
+
+IncrementalImageDecoder::~IncrementalImageDecoder() = default;
+
+void IncrementalImageDecoder::addBytes(const tonic::Uint8List& bytes) {
+  state_->AddBytes(bytes.data(), bytes.num_elements());
+}
+
+void IncrementalImageDecoder::close() {
+  state_->Close();
+}
+
+bool IncrementalImageDecoder::isComplete() const {
+  return state_->IsComplete();
+}
+
+void IncrementalImageDecoder::dispose() {
+  ClearDartWrapper();
+}
+
+static void InvokeDecodeCallback(
+    SkiaGPUObject<SkImage> image,
+    std::unique_ptr<DartPersistentValue> callback) {
+  std::shared_ptr<tonic::DartState> dart_state = callback->dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(ERROR) << "Could not acquire Dart state while attempting to fire "
+                       "incremental decode callback.";
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  if (!image.get()) {
+    tonic::DartInvoke(callback->value(), {Dart_Null()});
+    return;
+  }
+  auto canvas_image = CanvasImage::Create();
+  canvas_image->set_image(std::move(image));
+  tonic::DartInvoke(callback->value(), {tonic::ToDart(canvas_image)});
+}
+
+// Only the complete image gets mipmaps. Previews are soon replaced, while the
+// complete image is the one that stays on screen, often drawn downscaled in a
+// list of thumbnails. Building its mipmaps here keeps the raster thread from
+// building them when it is first drawn.
+static SkiaGPUObject<SkImage> UploadDecodedImage(
+    sk_sp<SkImage> image,
+    bool build_mips,
+    fml::WeakPtr<IOManager> io_manager) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  if (!image || !io_manager) {
+    return {};
+  }
+  auto resource_context = io_manager->GetResourceContext();
+  SkPixmap pixmap;
+  if (resource_context && image->peekPixels(&pixmap)) {
+    auto texture_image = SkImage::MakeCrossContextFromPixmap(
+        resource_context.get(), pixmap, build_mips);
+    if (texture_image) {
+      image = std::move(texture_image);
+    }
+  }
+  // Without a resource context, the raster image is uploaded when it is
+  // drawn.
+  return {std::move(image), io_manager->GetSkiaUnrefQueue()};
+}
+
+Dart_Handle IncrementalImageDecoder::decode(Dart_Handle callback_handle) {
+  if (!Dart_IsClosure(callback_handle)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  auto image_decoder = dart_state->GetImageDecoder();
+  if (!image_decoder) {
+    return tonic::ToDart("Image decoder not available.");
+  }
+
+  const auto& task_runners = dart_state->GetTaskRunners();
+  image_decoder->GetConcurrentTaskRunner()->PostTask(fml::MakeCopyable(
+      [state = state_,
+       callback = std::make_unique<DartPersistentValue>(
+           tonic::DartState::Current(), callback_handle),
+       io_task_runner = task_runners.GetIOTaskRunner(),
+       ui_task_runner = task_runners.GetUITaskRunner(),
+       io_manager = dart_state->GetIOManager()]() mutable {
+        sk_sp<SkImage> image = state->Decode();
+        const bool complete = state->IsComplete();
+        io_task_runner->PostTask(fml::MakeCopyable(
+            [image = std::move(image), complete,
+             callback = std::move(callback),
+             ui_task_runner = std::move(ui_task_runner),
+             io_manager = std::move(io_manager)]() mutable {
+              auto uploaded =
+                  UploadDecodedImage(std::move(image), complete, io_manager);
+              ui_task_runner->PostTask(fml::MakeCopyable(
+                  [uploaded = std::move(uploaded),
+                   callback = std::move(callback)]() mutable {
+                    InvokeDecodeCallback(std::move(uploaded),
+                                         std::move(callback));
+                  }));
+            }));
+      }));
+
+  return Dart_Null();
+}
+
+}  // namespace flutter
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/tonic/typed_data/typed_list.h"
+
+namespace tonic {
+class DartLibraryNatives;
+}  // namespace tonic
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Decodes an encoded image while its bytes are still being received.
+///
+/// The bytes are appended on the UI thread as they arrive. Each decode runs
+/// on the concurrent task runner and continues the incremental decode of the
+/// previous one with the bytes added since, using
+/// |SkCodec::incrementalDecode|. The rows decoded so far are uploaded on the
+/// IO thread and returned to Dart as an image; rows that are not decoded yet
+/// are transparent. Formats whose codec can not decode incrementally are
+/// decoded once all bytes were added.
+///
+class IncrementalImageDecoder
+    : public RefCountedDartWrappable<IncrementalImageDecoder> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(IncrementalImageDecoder);
+
+ public:
+  static fml::RefPtr<IncrementalImageDecoder> Create();
+
+  ~IncrementalImageDecoder() override;
+
+  void addBytes(const tonic::Uint8List& bytes);
+
+  // Signals that all bytes were added.
+  void close();
+
+  // Invokes |callback| with the image decoded from the bytes added so far, or
+  // with null if no part of the image can be decoded yet.
+  Dart_Handle decode(Dart_Handle callback);
+
+  // Whether a decode has decoded the whole image.
+  bool isComplete() const;
+
+  void dispose();
+
+  static void RegisterNatives(tonic::DartLibraryNatives* natives);
+
+  // Shared with the decodes on the concurrent and IO task runners, which may
+  // outlive the Dart object.
+  class State : public std::enable_shared_from_this<State> {
+   public:
+    State();
+
+    ~State();
+
+    void AddBytes(const uint8_t* bytes, size_t size);
+
+    void Close();
+
+    bool IsComplete() const;
+
+    // Decodes as much of the image as the bytes added so far allow. Returns
+    // nullptr if no part of the image can be decoded yet or decoding failed.
+    //
+    // Decodes are serialized, and are expected to run on a worker thread.
+    sk_sp<SkImage> Decode();
+
+    // Copies up to |size| of the bytes added so far from |offset|, or skips
+    // them if |buffer| is null. Returns the number of bytes read.
+    size_t ReadBytes(size_t offset, void* buffer, size_t size) const;
+
+    // Whether all bytes were added and |offset| is past the last one.
+    bool IsAtEnd(size_t offset) const;
+
+   private:
+    mutable std::mutex data_mutex_;
+    std::vector<uint8_t> data_;
+    bool closed_ = false;
+
+    std::mutex decode_mutex_;
+    std::unique_ptr<SkCodec> codec_;
+    SkBitmap bitmap_;
+    bool incremental_decode_started_ = false;
+    std::atomic<bool> complete_ = false;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(State);
+  };
+
+ private:
+  IncrementalImageDecoder();
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
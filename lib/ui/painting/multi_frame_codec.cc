@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -12,16 +13,60 @@
 
 namespace flutter {
 
+// The codec may be shared with the image descriptor and other codecs created
+// from it. Decoding ahead happens off the IO thread, so use a private one.
+static std::shared_ptr<SkCodecImageGenerator> CreatePrivateGenerator(
+    const std::shared_ptr<SkCodecImageGenerator>& generator) {
+  auto codec = SkCodec::MakeFromData(generator->refEncodedData());
+  if (!codec) {
+    return nullptr;
+  }
+  return std::shared_ptr<SkCodecImageGenerator>(
+      static_cast<SkCodecImageGenerator*>(
+          SkCodecImageGenerator::MakeFromCodec(std::move(codec)).release()));
+}
+
+static SkImageInfo CreateFrameInfo(const SkCodecImageGenerator& generator) {
+  SkImageInfo info = generator.getInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+  return info;
+}
+
 MultiFrameCodec::MultiFrameCodec(
     std::shared_ptr<SkCodecImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+    : MultiFrameCodec(std::move(generator), nullptr, 0) {}
+
+MultiFrameCodec::MultiFrameCodec(
+    std::shared_ptr<SkCodecImageGenerator> generator,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
+    size_t ahead_bytes) {
+  if (concurrent_task_runner && ahead_bytes > 0) {
+    auto private_generator = CreatePrivateGenerator(generator);
+    if (private_generator) {
+      generator = std::move(private_generator);
+    } else {
+      concurrent_task_runner = nullptr;
+    }
+  }
+  state_ = std::make_shared<State>(std::move(generator),
+                                   std::move(concurrent_task_runner),
+                                   ahead_bytes);
+}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<SkCodecImageGenerator> generator)
+MultiFrameCodec::State::State(
+    std::shared_ptr<SkCodecImageGenerator> generator,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
+    size_t ahead_bytes)
     : generator_(std::move(generator)),
       frameCount_(generator_->getFrameCount()),
       repetitionCount_(generator_->getRepetitionCount()),
+      frameInfo_(CreateFrameInfo(*generator_)),
+      concurrentTaskRunner_(std::move(concurrent_task_runner)),
+      aheadBytes_(concurrentTaskRunner_ ? ahead_bytes : 0),
       nextFrameIndex_(0) {}
 
 static void InvokeNextFrameCallback(
@@ -40,95 +85,156 @@ static void InvokeNextFrameCallback(
                     {tonic::ToDart(image), tonic::ToDart(duration)});
 }
 
-// Copied the source bitmap to the destination. If this cannot occur due to
-// running out of memory or the image info not being compatible, returns false.
-static bool CopyToBitmap(SkBitmap* dst,
-                         SkColorType dstColorType,
-                         const SkBitmap& src) {
-  SkPixmap srcPM;
-  if (!src.peekPixels(&srcPM)) {
-    return false;
-  }
-
-  SkBitmap tmpDst;
-  SkImageInfo dstInfo = srcPM.info().makeColorType(dstColorType);
-  if (!tmpDst.setInfo(dstInfo)) {
-    return false;
-  }
-
-  if (!tmpDst.tryAllocPixels()) {
-    return false;
-  }
-
-  SkPixmap dstPM;
-  if (!tmpDst.peekPixels(&dstPM)) {
-    return false;
-  }
-
-  if (!srcPM.readPixels(dstPM)) {
-    return false;
-  }
-
-  dst->swap(tmpDst);
-  return true;
-}
+MultiFrameCodec::DecodedFrame MultiFrameCodec::State::DecodeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeNextFrame");
+  const int frameIndex = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
-sk_sp<SkImage> MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext) {
-  SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->getInfo().makeColorType(kN32_SkColorType);
-  if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
+  DecodedFrame frame;
+  SkBitmap bitmap = AcquireBitmap();
+  if (bitmap.drawsNothing()) {
+    FML_LOG(ERROR) << "Failed to allocate memory for frame of size "
+                   << frameInfo_.computeMinByteSize() << "B";
+    return frame;
   }
-  bitmap.allocPixels(info);
 
   SkCodec::Options options;
-  options.fFrameIndex = nextFrameIndex_;
+  options.fFrameIndex = frameIndex;
   SkCodec::FrameInfo frameInfo{0};
-  generator_->getFrameInfo(nextFrameIndex_, &frameInfo);
+  generator_->getFrameInfo(frameIndex, &frameInfo);
   const int requiredFrameIndex = frameInfo.fRequiredFrame;
   if (requiredFrameIndex != SkCodec::kNoFrame) {
     if (lastRequiredFrame_ == nullptr) {
-      FML_LOG(ERROR) << "Frame " << nextFrameIndex_ << " depends on frame "
+      FML_LOG(ERROR) << "Frame " << frameIndex << " depends on frame "
                      << requiredFrameIndex
                      << " and no required frames are cached.";
-      return nullptr;
+      RecycleBitmap(std::move(bitmap));
+      return frame;
     } else if (lastRequiredFrameIndex_ != requiredFrameIndex) {
       FML_DLOG(INFO) << "Required frame " << requiredFrameIndex
                      << " is not cached. Using " << lastRequiredFrameIndex_
                      << " instead";
     }
 
+    // Copy into the pixels of the reused buffer instead of allocating a copy.
     if (lastRequiredFrame_->getPixels() &&
-        CopyToBitmap(&bitmap, lastRequiredFrame_->colorType(),
-                     *lastRequiredFrame_)) {
+        lastRequiredFrame_->readPixels(bitmap.pixmap())) {
       options.fPriorFrame = requiredFrameIndex;
     }
   }
 
-  if (!generator_->getPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
+  if (!generator_->getPixels(frameInfo_, bitmap.getPixels(), bitmap.rowBytes(),
                              &options)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
-    return nullptr;
+    FML_LOG(ERROR) << "Could not getPixels for frame " << frameIndex;
+    RecycleBitmap(std::move(bitmap));
+    return frame;
   }
 
   // Hold onto this if we need it to decode future frames.
   if (frameInfo.fDisposalMethod == SkCodecAnimation::DisposalMethod::kKeep) {
+    if (lastRequiredFrame_) {
+      RecycleBitmap(std::move(*lastRequiredFrame_));
+    }
     lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
   }
 
-  if (resourceContext) {
-    SkPixmap pixmap(bitmap.info(), bitmap.pixelRef()->pixels(),
-                    bitmap.pixelRef()->rowBytes());
-    return SkImage::MakeCrossContextFromPixmap(resourceContext.get(), pixmap,
-                                               true);
-  } else {
-    // Defer decoding until time of draw later on the raster thread. Can happen
-    // when GL operations are currently forbidden such as in the background
-    // on iOS.
-    return SkImage::MakeFromBitmap(bitmap);
+  frame.bitmap = std::move(bitmap);
+  frame.duration = frameInfo.fDuration;
+  return frame;
+}
+
+MultiFrameCodec::DecodedFrame MultiFrameCodec::State::TakeNextFrame() {
+  auto take_from_ring = [this](DecodedFrame* frame) {
+    std::scoped_lock lock(ringMutex_);
+    if (ring_.empty()) {
+      return false;
+    }
+    *frame = std::move(ring_.front());
+    ring_.pop_front();
+    ringBytes_ -= frameInfo_.computeMinByteSize();
+    return true;
+  };
+
+  DecodedFrame frame;
+  if (take_from_ring(&frame)) {
+    return frame;
+  }
+  // Frames decoded ahead are added to the ring before the decoder is
+  // released, so check again once no frame is being decoded ahead.
+  std::scoped_lock lock(decodeMutex_);
+  if (take_from_ring(&frame)) {
+    return frame;
+  }
+  return DecodeNextFrame();
+}
+
+SkBitmap MultiFrameCodec::State::AcquireBitmap() {
+  {
+    std::scoped_lock lock(ringMutex_);
+    if (!freeBitmaps_.empty()) {
+      SkBitmap bitmap = std::move(freeBitmaps_.back());
+      freeBitmaps_.pop_back();
+      return bitmap;
+    }
+  }
+  SkBitmap bitmap;
+  bitmap.tryAllocPixels(frameInfo_);
+  return bitmap;
+}
+
+// Enough to decode the next frame while the previous one is uploaded.
+static constexpr size_t kMaxFreeBitmaps = 2;
+
+void MultiFrameCodec::State::RecycleBitmap(SkBitmap bitmap) {
+  // Images that were not uploaded to the GPU and required frames still share
+  // the pixels.
+  if (!bitmap.pixelRef() || !bitmap.pixelRef()->unique() ||
+      bitmap.info() != frameInfo_) {
+    return;
+  }
+  std::scoped_lock lock(ringMutex_);
+  if (freeBitmaps_.size() < kMaxFreeBitmaps) {
+    freeBitmaps_.push_back(std::move(bitmap));
+  }
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead() {
+  if (aheadBytes_ == 0) {
+    return;
+  }
+  {
+    std::scoped_lock lock(ringMutex_);
+    if (isDecodingAhead_ ||
+        ringBytes_ + frameInfo_.computeMinByteSize() > aheadBytes_) {
+      return;
+    }
+    isDecodingAhead_ = true;
+  }
+  concurrentTaskRunner_->PostTask(
+      [weak_state = std::weak_ptr<State>(shared_from_this())]() {
+        if (auto state = weak_state.lock()) {
+          state->DecodeAhead();
+        }
+      });
+}
+
+void MultiFrameCodec::State::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+  const size_t frameBytes = frameInfo_.computeMinByteSize();
+  while (true) {
+    std::scoped_lock decode_lock(decodeMutex_);
+    {
+      std::scoped_lock lock(ringMutex_);
+      if (ringBytes_ + frameBytes > aheadBytes_) {
+        isDecodingAhead_ = false;
+        return;
+      }
+    }
+    DecodedFrame frame = DecodeNextFrame();
+    std::scoped_lock lock(ringMutex_);
+    ring_.push_back(std::move(frame));
+    ringBytes_ += frameBytes;
   }
 }
 
@@ -140,15 +246,29 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     size_t trace_id) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
-  sk_sp<SkImage> skImage = GetNextFrameImage(resourceContext);
+  DecodedFrame frame = TakeNextFrame();
+  ScheduleDecodeAhead();
+
+  sk_sp<SkImage> skImage;
+  if (!frame.bitmap.drawsNothing()) {
+    if (resourceContext) {
+      SkPixmap pixmap(frame.bitmap.info(), frame.bitmap.pixelRef()->pixels(),
+                      frame.bitmap.pixelRef()->rowBytes());
+      skImage = SkImage::MakeCrossContextFromPixmap(resourceContext.get(),
+                                                    pixmap, true);
+    } else {
+      // Defer decoding until time of draw later on the raster thread. Can
+      // happen when GL operations are currently forbidden such as in the
+      // background on iOS.
+      skImage = SkImage::MakeFromBitmap(frame.bitmap);
+    }
+    RecycleBitmap(std::move(frame.bitmap));
+  }
   if (skImage) {
     image = CanvasImage::Create();
     image->set_image({skImage, std::move(unref_queue)});
-    SkCodec::FrameInfo skFrameInfo{0};
-    generator_->getFrameInfo(nextFrameIndex_, &skFrameInfo);
-    duration = skFrameInfo.fDuration;
+    duration = frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   ui_task_runner->PostTask(fml::MakeCopyable([callback = std::move(callback),
                                               image = std::move(image),
@@ -169,6 +289,10 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   auto* dart_state = UIDartState::Current();
 
   const auto& task_runners = dart_state->GetTaskRunners();
+  if (!task_runners.GetIOTaskRunner()) {
+    return tonic::ToDart(
+        "Animated images can only be decoded on the root isolate.");
+  }
 
   task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
       [callback = std::make_unique<DartPersistentValue>(
@@ -5,6 +5,12 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"
@@ -15,6 +21,13 @@ class MultiFrameCodec : public Codec {
  public:
   MultiFrameCodec(std::shared_ptr<SkCodecImageGenerator> generator);
 
+  // Decodes frames ahead of |getNextFrame| on |concurrent_task_runner| into a
+  // ring of at most |ahead_bytes| of decoded frames.
+  MultiFrameCodec(
+      std::shared_ptr<SkCodecImageGenerator> generator,
+      std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
+      size_t ahead_bytes);
+
   ~MultiFrameCodec() override;
 
   // |Codec|
@@ -27,25 +40,36 @@ class MultiFrameCodec : public Codec {
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
  private:
+  // A decoded frame. The bitmap is empty if the frame could not be decoded.
+  struct DecodedFrame {
+    SkBitmap bitmap;
+    int duration = 0;
+  };
+
   // Captures the state shared between the IO and UI task runners.
   //
   // The state is initialized on the UI task runner when the Dart object is
-  // created. Decoding occurs on the IO task runner. Since it is possible for
-  // the UI object to be collected independently of the IO task runner work,
-  // it is not safe for this state to live directly on the MultiFrameCodec.
-  // Instead, the MultiFrameCodec creates this object when it is constructed,
-  // shares it with the IO task runner's decoding work, and sets the live_
-  // member to false when it is destructed.
-  struct State {
-    State(std::shared_ptr<SkCodecImageGenerator> generator);
+  // created. Decoding occurs on the IO task runner, or ahead of time on the
+  // concurrent task runner. Since it is possible for the UI object to be
+  // collected independently of the IO task runner work, it is not safe for
+  // this state to live directly on the MultiFrameCodec. Instead, the
+  // MultiFrameCodec creates this object when it is constructed, shares it with
+  // the decoding work, and the decoding work stops once it is collected.
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<SkCodecImageGenerator> generator,
+          std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
+          size_t ahead_bytes);
 
     const std::shared_ptr<SkCodecImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
+    const SkImageInfo frameInfo_;
+    const std::shared_ptr<fml::ConcurrentTaskRunner> concurrentTaskRunner_;
+    const size_t aheadBytes_;
 
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    // Guards the decoder state below. It is held while a frame is decoded.
+    // When both mutexes are needed, this one is acquired first.
+    std::mutex decodeMutex_;
     int nextFrameIndex_;
     // The last decoded frame that's required to decode any subsequent frames.
     std::unique_ptr<SkBitmap> lastRequiredFrame_;
@@ -53,8 +77,31 @@ class MultiFrameCodec : public Codec {
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
-    sk_sp<SkImage> GetNextFrameImage(
-        fml::WeakPtr<GrDirectContext> resourceContext);
+    // Guards the frames decoded ahead of time and the pixel buffers that can
+    // be reused by the next decoded frames.
+    std::mutex ringMutex_;
+    std::deque<DecodedFrame> ring_;
+    size_t ringBytes_ = 0;
+    bool isDecodingAhead_ = false;
+    std::vector<SkBitmap> freeBitmaps_;
+
+    // Requires |decodeMutex_|.
+    DecodedFrame DecodeNextFrame();
+
+    // Returns the next frame in order, from the ring if it was decoded ahead.
+    DecodedFrame TakeNextFrame();
+
+    SkBitmap AcquireBitmap();
+
+    // Keeps the pixels of |bitmap| for the next decoded frames if nothing else
+    // references them.
+    void RecycleBitmap(SkBitmap bitmap);
+
+    // Starts decoding frames ahead on the concurrent task runner unless the
+    // ring is full or already being filled.
+    void ScheduleDecodeAhead();
+
+    void DecodeAhead();
 
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<DartPersistentValue> callback,
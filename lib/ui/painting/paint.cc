@@ -33,7 +33,8 @@ constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
 constexpr int kDitherIndex = 13;
-constexpr size_t kDataByteCount = 56;  // 4 * (last index + 1)
+static_assert(Paint::kDataByteCount == 4 * (kDitherIndex + 1),
+              "The paint data holds one 32bit value per index.");
 
 // Indices for objects.
 constexpr int kShaderIndex = 0;
@@ -106,9 +107,16 @@ Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data) {
 
   tonic::DartByteData byte_data(paint_data);
   FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
+  DecodeData(static_cast<const uint8_t*>(byte_data.data()));
+}
+
+Paint::Paint(const uint8_t* paint_data) : is_null_(false) {
+  DecodeData(paint_data);
+}
 
-  const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
+void Paint::DecodeData(const uint8_t* paint_data) {
+  const uint32_t* uint_data = reinterpret_cast<const uint32_t*>(paint_data);
+  const float* float_data = reinterpret_cast<const float*>(paint_data);
 
   paint_.setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
 
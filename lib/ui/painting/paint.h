@@ -12,14 +12,23 @@ namespace flutter {
 
 class Paint {
  public:
+  // The size of the data encoded by the Paint class in painting.dart.
+  static constexpr size_t kDataByteCount = 56;
+
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
+  // Decodes the |kDataByteCount| bytes of data of a paint that has no shader,
+  // color filter or image filter.
+  explicit Paint(const uint8_t* paint_data);
+
   const SkPaint* paint() const { return is_null_ ? nullptr : &paint_; }
 
  private:
   friend struct tonic::DartConverter<Paint>;
 
+  void DecodeData(const uint8_t* paint_data);
+
   SkPaint paint_;
   bool is_null_ = true;
 };
@@ -20,7 +20,7 @@ namespace flutter {
 typedef CanvasPath Path;
 
 static void Path_constructor(Dart_NativeArguments args) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
   DartCallConstructor(&CanvasPath::CreateNew, args);
 }
 
@@ -198,8 +198,8 @@ void CanvasPath::addArc(float left,
 }
 
 void CanvasPath::addPolygon(const tonic::Float32List& points, bool close) {
-  path_.addPoly(reinterpret_cast<const SkPoint*>(points.data()),
-                points.num_elements() / 2, close);
+  path_.addPoly(points.data_as<SkPoint>(), points.num_elements_as<SkPoint>(),
+                close);
 }
 
 void CanvasPath::addRRect(const RRect& rrect) {
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/path_cache.h"
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace flutter {
+
+PathCache::PathCache(size_t max_entries) : max_entries_(max_entries) {}
+
+PathCache::~PathCache() = default;
+
+size_t PathCache::HashPath(const SkPath& path) {
+  // The serialized form covers the verbs, points, conic weights and fill type,
+  // which is everything |SkPath::operator==| compares.
+  std::vector<char> buffer(path.writeToMemory(nullptr));
+  path.writeToMemory(buffer.data());
+  return std::hash<std::string_view>()(
+      std::string_view(buffer.data(), buffer.size()));
+}
+
+const SkPath& PathCache::Get(const SkPath& path) {
+  if (max_entries_ == 0 || path.countPoints() < kMinPointCount) {
+    return path;
+  }
+
+  // The same path drawn again, or a canonical path handed out earlier.
+  auto found = generation_index_.find(path.getGenerationID());
+  if (found != generation_index_.end()) {
+    hit_count_++;
+    Touch(found->second);
+    return found->second->path;
+  }
+
+  const size_t hash = HashPath(path);
+  auto range = hash_index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->path == path) {
+      hit_count_++;
+      Touch(it->second);
+      return it->second->path;
+    }
+  }
+
+  miss_count_++;
+  while (entries_.size() >= max_entries_) {
+    Evict();
+  }
+  // The copy shares the path data, and with it the generation ID.
+  entries_.push_front({path, hash});
+  generation_index_[path.getGenerationID()] = entries_.begin();
+  hash_index_.emplace(hash, entries_.begin());
+  return entries_.front().path;
+}
+
+void PathCache::Touch(EntryList::iterator entry) {
+  entries_.splice(entries_.begin(), entries_, entry);
+}
+
+void PathCache::Evict() {
+  auto last = std::prev(entries_.end());
+  generation_index_.erase(last->path.getGenerationID());
+  auto range = hash_index_.equal_range(last->hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == last) {
+      hash_index_.erase(it);
+      break;
+    }
+  }
+  entries_.erase(last);
+}
+
+void PathCache::Clear() {
+  generation_index_.clear();
+  hash_index_.clear();
+  entries_.clear();
+}
+
+PathCache::Stats PathCache::GetStats() const {
+  return {hit_count_, miss_count_, entries_.size()};
+}
+
+}  // namespace flutter
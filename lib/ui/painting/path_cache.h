@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_PATH_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_PATH_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A cache that maps paths to a canonical path with the same geometry.
+///
+/// Skia caches the tessellation and coverage masks of paths keyed by their
+/// generation ID. Frameworks usually rebuild their paths every frame, so a
+/// chart that draws the same polyline on every frame gets a new generation ID
+/// each time and is tessellated again. Drawing the canonical path instead
+/// lets those caches hit across frames and across pictures.
+///
+/// Paths are compared by content, so a hash collision never substitutes a
+/// different shape. Paths with few points are cheaper to tessellate than to
+/// hash and are returned as is.
+///
+/// The cache holds at most |max_entries| paths and evicts the least recently
+/// used ones first. It is not thread-safe; each UI isolate owns one.
+///
+class PathCache {
+ public:
+  struct Stats {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    size_t entry_count = 0;
+  };
+
+  static constexpr size_t kDefaultMaxEntries = 128;
+
+  // Paths with fewer points than this are not cached.
+  static constexpr int kMinPointCount = 16;
+
+  explicit PathCache(size_t max_entries = kDefaultMaxEntries);
+
+  ~PathCache();
+
+  //----------------------------------------------------------------------------
+  /// @return     A path equal to |path|. This is either the cached path with
+  ///             the same geometry or |path| itself, which then becomes the
+  ///             canonical path for that geometry.
+  ///
+  const SkPath& Get(const SkPath& path);
+
+  void Clear();
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    SkPath path;
+    size_t hash;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  static size_t HashPath(const SkPath& path);
+
+  void Touch(EntryList::iterator entry);
+
+  void Evict();
+
+  const size_t max_entries_;
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<uint32_t, EntryList::iterator> generation_index_;
+  std::unordered_multimap<size_t, EntryList::iterator> hash_index_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PathCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_PATH_CACHE_H_
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/path_cache.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A polyline of |PathCache::kMinPointCount| points starting at |y|.
+SkPath MakePolyline(SkScalar y) {
+  SkPath path;
+  path.moveTo(0, y);
+  for (int i = 1; i < PathCache::kMinPointCount; i++) {
+    path.lineTo(i * 10, y + (i % 2) * 10);
+  }
+  return path;
+}
+
+}  // namespace
+
+TEST(PathCacheTest, EqualPathsShareAGenerationID) {
+  PathCache cache;
+
+  const SkPath first = MakePolyline(0);
+  const uint32_t canonical_id = cache.Get(first).getGenerationID();
+  ASSERT_EQ(canonical_id, first.getGenerationID());
+
+  // A path rebuilt with the same geometry maps to the first one.
+  const SkPath second = MakePolyline(0);
+  ASSERT_NE(second.getGenerationID(), canonical_id);
+  const SkPath& found = cache.Get(second);
+  ASSERT_EQ(found.getGenerationID(), canonical_id);
+  ASSERT_TRUE(found == second);
+
+  // Different geometry and fill types do not.
+  ASSERT_NE(cache.Get(MakePolyline(5)).getGenerationID(), canonical_id);
+  SkPath even_odd = MakePolyline(0);
+  even_odd.setFillType(SkPathFillType::kEvenOdd);
+  ASSERT_NE(cache.Get(even_odd).getGenerationID(), canonical_id);
+
+  const auto stats = cache.GetStats();
+  ASSERT_EQ(stats.hit_count, 1u);
+  ASSERT_EQ(stats.miss_count, 3u);
+  ASSERT_EQ(stats.entry_count, 3u);
+}
+
+TEST(PathCacheTest, SmallPathsAreNotCached) {
+  PathCache cache;
+
+  SkPath rect;
+  rect.addRect(SkRect::MakeWH(10, 10));
+  const SkPath& found = cache.Get(rect);
+  ASSERT_EQ(&found, &rect);
+
+  const auto stats = cache.GetStats();
+  ASSERT_EQ(stats.hit_count, 0u);
+  ASSERT_EQ(stats.miss_count, 0u);
+  ASSERT_EQ(stats.entry_count, 0u);
+}
+
+TEST(PathCacheTest, EvictsLeastRecentlyUsedPaths) {
+  PathCache cache(2);
+
+  const SkPath a = MakePolyline(0);
+  const SkPath b = MakePolyline(1);
+  const SkPath c = MakePolyline(2);
+  cache.Get(a);
+  cache.Get(b);
+  // Using |a| again makes |b| the least recently used path.
+  cache.Get(a);
+  cache.Get(c);
+  ASSERT_EQ(cache.GetStats().entry_count, 2u);
+
+  ASSERT_EQ(cache.Get(MakePolyline(0)).getGenerationID(),
+            a.getGenerationID());
+  ASSERT_NE(cache.Get(MakePolyline(1)).getGenerationID(),
+            b.getGenerationID());
+}
+
+TEST(PathCacheTest, ClearDropsAllPaths) {
+  PathCache cache;
+
+  const SkPath path = MakePolyline(0);
+  cache.Get(path);
+  cache.Clear();
+  ASSERT_EQ(cache.GetStats().entry_count, 0u);
+  ASSERT_NE(cache.Get(MakePolyline(0)).getGenerationID(),
+            path.getGenerationID());
+}
+
+}  // namespace testing
+}  // namespace flutter
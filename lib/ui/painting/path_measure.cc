@@ -20,18 +20,20 @@ namespace flutter {
 typedef CanvasPathMeasure PathMeasure;
 
 static void PathMeasure_constructor(Dart_NativeArguments args) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
   DartCallConstructor(&CanvasPathMeasure::Create, args);
 }
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, PathMeasure);
 
-#define FOR_EACH_BINDING(V)  \
-  V(PathMeasure, setPath)    \
-  V(PathMeasure, getLength)  \
-  V(PathMeasure, getPosTan)  \
-  V(PathMeasure, getSegment) \
-  V(PathMeasure, isClosed)   \
+#define FOR_EACH_BINDING(V)   \
+  V(PathMeasure, setPath)     \
+  V(PathMeasure, getLength)   \
+  V(PathMeasure, getPosTan)   \
+  V(PathMeasure, getPosTans)  \
+  V(PathMeasure, getSegment)  \
+  V(PathMeasure, getSegments) \
+  V(PathMeasure, isClosed)    \
   V(PathMeasure, nextContour)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
@@ -98,6 +100,38 @@ tonic::Float32List CanvasPathMeasure::getPosTan(int contour_index,
   return posTan;
 }
 
+tonic::Float32List CanvasPathMeasure::getPosTans(
+    int contour_index,
+    const tonic::Float32List& distances) {
+  // Four values per distance: the position and the tangent vector. Distances
+  // Skia can't measure, like NaN, produce NaN values.
+  const intptr_t count = distances.num_elements();
+  tonic::Float32List pos_tans(
+      Dart_NewTypedData(Dart_TypedData_kFloat32, count * 4));
+  for (intptr_t i = 0; i < count * 4; i++) {
+    pos_tans[i] = NAN;
+  }
+  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
+          contour_index) >= measures_.size()) {
+    return pos_tans;
+  }
+
+  // The measure holds the length table of its segments, so each lookup is a
+  // binary search rather than a walk of the contour.
+  const SkContourMeasure& measure = *measures_[contour_index];
+  for (intptr_t i = 0; i < count; i++) {
+    SkPoint pos;
+    SkVector tan;
+    if (measure.getPosTan(distances[i], &pos, &tan)) {
+      pos_tans[i * 4] = pos.x();
+      pos_tans[i * 4 + 1] = pos.y();
+      pos_tans[i * 4 + 2] = tan.x();
+      pos_tans[i * 4 + 3] = tan.y();
+    }
+  }
+  return pos_tans;
+}
+
 void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
                                    int contour_index,
                                    float start_d,
@@ -117,6 +151,23 @@ void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
   }
 }
 
+void CanvasPathMeasure::getSegments(Dart_Handle path_handle,
+                                    int contour_index,
+                                    const tonic::Float32List& intervals,
+                                    bool start_with_move_to) {
+  SkPath dst;
+  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
+          contour_index) < measures_.size()) {
+    const SkContourMeasure& measure = *measures_[contour_index];
+    // Skia appends each segment to |dst|.
+    for (intptr_t i = 0; i + 1 < intervals.num_elements(); i += 2) {
+      measure.getSegment(intervals[i], intervals[i + 1], &dst,
+                         start_with_move_to);
+    }
+  }
+  CanvasPath::CreateFrom(path_handle, dst);
+}
+
 bool CanvasPathMeasure::isClosed(int contour_index) {
   if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
           contour_index) < measures_.size()) {
@@ -34,11 +34,17 @@ class CanvasPathMeasure : public RefCountedDartWrappable<CanvasPathMeasure> {
   void setPath(const CanvasPath* path, bool isClosed);
   float getLength(int contour_index);
   tonic::Float32List getPosTan(int contour_index, float distance);
+  tonic::Float32List getPosTans(int contour_index,
+                                const tonic::Float32List& distances);
   void getSegment(Dart_Handle path_handle,
                   int contour_index,
                   float start_d,
                   float stop_d,
                   bool start_with_move_to);
+  void getSegments(Dart_Handle path_handle,
+                   int contour_index,
+                   const tonic::Float32List& intervals,
+                   bool start_with_move_to);
   bool isClosed(int contour_index);
   bool nextContour();
 
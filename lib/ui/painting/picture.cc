@@ -10,6 +10,7 @@
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -31,40 +32,70 @@ DART_BIND_ALL(Picture, FOR_EACH_BINDING)
 fml::RefPtr<Picture> Picture::Create(
     Dart_Handle dart_handle,
     flutter::SkiaGPUObject<SkPicture> picture) {
-  auto canvas_picture = fml::MakeRefCounted<Picture>(std::move(picture));
+  auto canvas_picture = fml::MakeRefCounted<Picture>(
+      std::move(picture), flutter::SkiaGPUObject<DisplayList>());
 
   canvas_picture->AssociateWithDartWrapper(dart_handle);
   return canvas_picture;
 }
 
-Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture)
-    : picture_(std::move(picture)) {}
+fml::RefPtr<Picture> Picture::Create(
+    Dart_Handle dart_handle,
+    flutter::SkiaGPUObject<DisplayList> display_list) {
+  auto canvas_picture = fml::MakeRefCounted<Picture>(
+      flutter::SkiaGPUObject<SkPicture>(), std::move(display_list));
+
+  canvas_picture->AssociateWithDartWrapper(dart_handle);
+  return canvas_picture;
+}
+
+Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture,
+                 flutter::SkiaGPUObject<DisplayList> display_list)
+    : picture_(std::move(picture)), display_list_(std::move(display_list)) {}
 
 Picture::~Picture() = default;
 
 Dart_Handle Picture::toImage(uint32_t width,
                              uint32_t height,
                              Dart_Handle raw_image_callback) {
-  if (!picture_.get()) {
+  sk_sp<SkPicture> picture = ToSkPicture();
+  if (!picture) {
     return tonic::ToDart("Picture is null");
   }
 
-  return RasterizeToImage(picture_.get(), width, height, raw_image_callback);
+  return RasterizeToImage(std::move(picture), width, height,
+                          raw_image_callback);
 }
 
 void Picture::dispose() {
   picture_.reset();
+  display_list_.reset();
   ClearDartWrapper();
 }
 
 size_t Picture::GetAllocationSize() const {
   if (auto picture = picture_.get()) {
     return picture->approximateBytesUsed() + sizeof(Picture);
+  } else if (auto display_list = display_list_.get()) {
+    return display_list->bytes() + sizeof(Picture);
   } else {
     return sizeof(Picture);
   }
 }
 
+sk_sp<SkPicture> Picture::ToSkPicture() const {
+  if (auto picture = picture_.get()) {
+    return picture;
+  }
+  sk_sp<DisplayList> display_list = display_list_.get();
+  if (!display_list) {
+    return nullptr;
+  }
+  SkPictureRecorder recorder;
+  display_list->RenderTo(recorder.beginRecording(display_list->bounds()));
+  return recorder.finishRecordingAsPicture();
+}
+
 Dart_Handle Picture::RasterizeToImage(sk_sp<SkPicture> picture,
                                       uint32_t width,
                                       uint32_t height,
@@ -78,6 +109,11 @@ Dart_Handle Picture::RasterizeToImage(sk_sp<SkPicture> picture,
   }
 
   auto* dart_state = UIDartState::Current();
+  if (!dart_state->GetTaskRunners().GetRasterTaskRunner()) {
+    return tonic::ToDart(
+        "Pictures can only be rasterized on the root isolate. Transfer the "
+        "picture's image data or draw it there instead.");
+  }
   auto image_callback = std::make_unique<tonic::DartPersistentValue>(
       dart_state, raw_image_callback);
   auto unref_queue = dart_state->GetSkiaUnrefQueue();
@@ -123,12 +159,15 @@ Dart_Handle Picture::RasterizeToImage(sk_sp<SkPicture> picture,
   fml::TaskRunner::RunNowOrPostTask(
       raster_task_runner,
       [ui_task_runner, snapshot_delegate, picture, picture_bounds, ui_task] {
-        sk_sp<SkImage> raster_image =
-            snapshot_delegate->MakeRasterSnapshot(picture, picture_bounds);
-
-        fml::TaskRunner::RunNowOrPostTask(
-            ui_task_runner,
-            [ui_task, raster_image]() { ui_task(raster_image); });
+        // The pixels are read back asynchronously so the raster thread keeps
+        // drawing frames meanwhile.
+        snapshot_delegate->MakeRasterSnapshotAsync(
+            picture, picture_bounds,
+            [ui_task_runner, ui_task](sk_sp<SkImage> raster_image) {
+              fml::TaskRunner::RunNowOrPostTask(
+                  ui_task_runner,
+                  [ui_task, raster_image]() { ui_task(raster_image); });
+            });
       });
 
   return Dart_Null();
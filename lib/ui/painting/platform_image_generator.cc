@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/platform_image_generator.h"
+
+#include <mutex>
+
+#include "flutter/fml/build_config.h"
+
+#ifdef OS_MACOSX
+#include "third_party/skia/include/ports/SkImageGeneratorCG.h"
+#define PLATFORM_IMAGE_GENERATOR(data) \
+  SkImageGeneratorCG::MakeFromEncodedCG(data)
+#elif OS_WIN
+#include "third_party/skia/include/ports/SkImageGeneratorWIC.h"
+#define PLATFORM_IMAGE_GENERATOR(data) \
+  SkImageGeneratorWIC::MakeFromEncodedWIC(data)
+#else
+#define PLATFORM_IMAGE_GENERATOR(data) \
+  std::unique_ptr<SkImageGenerator>(nullptr)
+#endif
+
+namespace flutter {
+
+namespace {
+
+std::mutex& GetFactoryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+PlatformImageGeneratorFactory& GetFactory() {
+  static PlatformImageGeneratorFactory factory;
+  return factory;
+}
+
+}  // namespace
+
+void SetPlatformImageGeneratorFactory(PlatformImageGeneratorFactory factory) {
+  std::scoped_lock lock(GetFactoryMutex());
+  GetFactory() = std::move(factory);
+}
+
+std::unique_ptr<SkImageGenerator> MakePlatformImageGenerator(
+    sk_sp<SkData> data) {
+  PlatformImageGeneratorFactory factory;
+  {
+    std::scoped_lock lock(GetFactoryMutex());
+    factory = GetFactory();
+  }
+  if (factory) {
+    return factory(std::move(data));
+  }
+  return PLATFORM_IMAGE_GENERATOR(std::move(data));
+}
+
+bool ShouldPreferPlatformImageDecoding(SkCodec& codec, size_t pixel_threshold) {
+  if (pixel_threshold == 0) {
+    return false;
+  }
+  const auto format = codec.getEncodedFormat();
+  if (format != SkEncodedImageFormat::kJPEG &&
+      format != SkEncodedImageFormat::kHEIF) {
+    return false;
+  }
+  const auto dimensions = codec.dimensions();
+  return static_cast<size_t>(dimensions.width()) * dimensions.height() >=
+             pixel_threshold &&
+         codec.getFrameCount() == 1;
+}
+
+}  // namespace flutter
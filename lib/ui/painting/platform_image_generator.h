@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_PLATFORM_IMAGE_GENERATOR_H_
+#define FLUTTER_LIB_UI_PAINTING_PLATFORM_IMAGE_GENERATOR_H_
+
+#include <functional>
+#include <memory>
+
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageGenerator.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Creates an image generator backed by a decoder of the platform for the
+/// encoded image |data|, or returns null if the platform can not decode it.
+///
+using PlatformImageGeneratorFactory =
+    std::function<std::unique_ptr<SkImageGenerator>(sk_sp<SkData> data)>;
+
+//------------------------------------------------------------------------------
+/// @brief      Installs the factory used for the images that are decoded by
+///             the platform, replacing the default one. The defaults are
+///             ImageIO on Apple platforms and WIC on Windows; other platforms
+///             have none unless their embedding installs one. A null factory
+///             restores the default.
+///
+///             This method is thread safe.
+///
+void SetPlatformImageGeneratorFactory(PlatformImageGeneratorFactory factory);
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a generator for |data| with the installed platform
+///             factory.
+///
+///             This method is thread safe.
+///
+/// @return     The generator, or null if the platform can not decode |data|.
+///
+std::unique_ptr<SkImageGenerator> MakePlatformImageGenerator(
+    sk_sp<SkData> data);
+
+//------------------------------------------------------------------------------
+/// @brief      Whether an image that Skia can decode with |codec| should be
+///             decoded by the platform instead. Platform decoders are often
+///             backed by hardware for the formats of camera photos, JPEG and
+///             HEIF, which pays off for large still images. Animated images
+///             and smaller images stay with Skia, which can also sample,
+///             parallelize and cache their decodes.
+///
+/// @param[in]  codec            The Skia codec for the image.
+/// @param[in]  pixel_threshold  The number of pixels from which images are
+///                              decoded by the platform, or 0 to never prefer
+///                              it.
+///
+bool ShouldPreferPlatformImageDecoding(SkCodec& codec, size_t pixel_threshold);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_PLATFORM_IMAGE_GENERATOR_H_
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/platform_image_generator.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkEncodedImageFormat.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<SkData> EncodeImage(int width, int height, SkEncodedImageFormat format) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(width, height);
+  bitmap.eraseColor(SK_ColorBLUE);
+  return SkImage::MakeFromBitmap(bitmap)->encodeToData(format, 90);
+}
+
+}  // namespace
+
+TEST(PlatformImageGeneratorTest, PrefersThePlatformForLargePhotos) {
+  auto jpeg = SkCodec::MakeFromData(
+      EncodeImage(64, 64, SkEncodedImageFormat::kJPEG));
+  ASSERT_TRUE(jpeg);
+  EXPECT_TRUE(ShouldPreferPlatformImageDecoding(*jpeg, 64 * 64));
+  EXPECT_FALSE(ShouldPreferPlatformImageDecoding(*jpeg, 64 * 64 + 1));
+  EXPECT_FALSE(ShouldPreferPlatformImageDecoding(*jpeg, 0));
+
+  auto png =
+      SkCodec::MakeFromData(EncodeImage(64, 64, SkEncodedImageFormat::kPNG));
+  ASSERT_TRUE(png);
+  EXPECT_FALSE(ShouldPreferPlatformImageDecoding(*png, 1));
+}
+
+TEST(PlatformImageGeneratorTest, UsesTheInstalledFactory) {
+  size_t factory_calls = 0;
+  SetPlatformImageGeneratorFactory([&factory_calls](sk_sp<SkData> data) {
+    factory_calls++;
+    return SkImageGenerator::MakeFromEncoded(std::move(data));
+  });
+
+  auto generator = MakePlatformImageGenerator(
+      EncodeImage(8, 4, SkEncodedImageFormat::kPNG));
+  SetPlatformImageGeneratorFactory(nullptr);
+
+  EXPECT_EQ(factory_calls, 1u);
+  ASSERT_TRUE(generator);
+  EXPECT_EQ(generator->getInfo().dimensions(), SkISize::Make(8, 4));
+}
+
+}  // namespace testing
+}  // namespace flutter
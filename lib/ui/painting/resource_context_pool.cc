@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/resource_context_pool.h"
+
+#include <string>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ResourceContextPool::ResourceContextPool(size_t count,
+                                         const ContextFactory& factory) {
+  fml::CountDownLatch latch(count);
+  for (size_t index = 0; index < count; index++) {
+    auto worker = std::make_unique<Worker>();
+    worker->thread = std::make_unique<fml::Thread>(
+        "io.flutter.resource." + std::to_string(index + 1));
+    worker->thread->GetTaskRunner()->PostTask(
+        [&latch, &factory, index, worker = worker.get()]() {
+          TRACE_EVENT0("flutter", "ResourceContextPoolCreateContext");
+          worker->context = factory(index);
+          if (worker->context) {
+            worker->weak_factory =
+                std::make_unique<fml::WeakPtrFactory<GrDirectContext>>(
+                    worker->context.get());
+          }
+          worker->unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+              worker->thread->GetTaskRunner(),
+              fml::TimeDelta::FromMilliseconds(8),
+              worker->weak_factory ? worker->weak_factory->GetWeakPtr()
+                                   : fml::WeakPtr<GrDirectContext>());
+          latch.CountDown();
+        });
+    workers_.push_back(std::move(worker));
+  }
+  latch.Wait();
+
+  for (const auto& worker : workers_) {
+    if (worker->context) {
+      context_count_++;
+    }
+  }
+}
+
+ResourceContextPool::~ResourceContextPool() {
+  for (const auto& worker : workers_) {
+    // Like the IO manager, drain the unref queue one last time before the
+    // context goes away. Images still referenced afterwards are leaked.
+    worker->thread->GetTaskRunner()->PostTask([worker = worker.get()]() {
+      worker->unref_queue->Drain();
+      worker->weak_factory.reset();
+      worker->context.reset();
+    });
+    worker->thread->Join();
+  }
+}
+
+size_t ResourceContextPool::GetContextCount() const {
+  return context_count_;
+}
+
+void ResourceContextPool::PostUpload(UploadTask task) {
+  if (workers_.empty()) {
+    return;
+  }
+  Worker* worker = workers_[next_worker_++ % workers_.size()].get();
+  worker->thread->GetTaskRunner()->PostTask(
+      [worker, task = std::move(task)]() {
+        task(worker->context.get(), worker->unref_queue);
+      });
+}
+
+}  // namespace flutter
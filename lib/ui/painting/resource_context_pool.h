@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_RESOURCE_CONTEXT_POOL_H_
+#define FLUTTER_LIB_UI_PAINTING_RESOURCE_CONTEXT_POOL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/thread.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A pool of threads that each own a resource context in the share group of
+/// the resource context of the IO manager, so that textures can be uploaded
+/// from several threads instead of only the IO thread.
+///
+/// Each thread makes its context current once, when the pool is created, and
+/// keeps it until the pool is destroyed. Images uploaded on a thread must be
+/// released through the unref queue of that thread.
+///
+/// All methods are thread-safe.
+///
+class ResourceContextPool {
+ public:
+  // Creates the resource context with the given index on the calling thread,
+  // or returns nullptr if it is not available.
+  using ContextFactory = std::function<sk_sp<GrDirectContext>(size_t index)>;
+
+  // Runs on a thread of the pool. |context| is null if the thread has no
+  // resource context.
+  using UploadTask =
+      std::function<void(GrDirectContext* context,
+                         const fml::RefPtr<SkiaUnrefQueue>& unref_queue)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts |count| threads and creates their resource contexts
+  ///             with |factory|. Returns once all contexts were created.
+  ///
+  ResourceContextPool(size_t count, const ContextFactory& factory);
+
+  ~ResourceContextPool();
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of threads that have a resource context.
+  ///
+  size_t GetContextCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs |task| on the next thread of the pool, in round-robin
+  ///             order.
+  ///
+  void PostUpload(UploadTask task);
+
+ private:
+  struct Worker {
+    std::unique_ptr<fml::Thread> thread;
+    // Only accessed on |thread|.
+    sk_sp<GrDirectContext> context;
+    std::unique_ptr<fml::WeakPtrFactory<GrDirectContext>> weak_factory;
+    fml::RefPtr<SkiaUnrefQueue> unref_queue;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  size_t context_count_ = 0;
+  std::atomic_size_t next_worker_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResourceContextPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_RESOURCE_CONTEXT_POOL_H_
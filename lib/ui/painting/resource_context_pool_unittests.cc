@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/resource_context_pool.h"
+
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ResourceContextPoolTest, CreatesEachContextOnItsOwnThread) {
+  std::mutex mutex;
+  std::set<size_t> indices;
+  std::set<std::thread::id> threads;
+  ResourceContextPool pool(3, [&](size_t index) -> sk_sp<GrDirectContext> {
+    std::scoped_lock lock(mutex);
+    indices.insert(index);
+    threads.insert(std::this_thread::get_id());
+    return nullptr;
+  });
+
+  // The factory has run for every context once the pool is created.
+  std::scoped_lock lock(mutex);
+  ASSERT_EQ(indices, std::set<size_t>({0, 1, 2}));
+  ASSERT_EQ(threads.size(), 3u);
+  ASSERT_EQ(threads.count(std::this_thread::get_id()), 0u);
+  ASSERT_EQ(pool.GetContextCount(), 0u);
+}
+
+TEST(ResourceContextPoolTest, PostsUploadsToTheThreadsInTurn) {
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  {
+    ResourceContextPool pool(
+        2, [](size_t index) -> sk_sp<GrDirectContext> { return nullptr; });
+    fml::CountDownLatch latch(4);
+    for (size_t i = 0; i < 4; i++) {
+      pool.PostUpload(
+          [&](GrDirectContext* context,
+              const fml::RefPtr<SkiaUnrefQueue>& unref_queue) {
+            ASSERT_FALSE(context);
+            ASSERT_TRUE(unref_queue);
+            std::scoped_lock lock(mutex);
+            threads.insert(std::this_thread::get_id());
+            latch.CountDown();
+          });
+    }
+    latch.Wait();
+  }
+  ASSERT_EQ(threads.size(), 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
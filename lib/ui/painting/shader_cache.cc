@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/shader_cache.h"
+
+namespace flutter {
+
+ShaderCache::ShaderCache(size_t max_entries) : max_entries_(max_entries) {}
+
+ShaderCache::~ShaderCache() = default;
+
+sk_sp<SkShader> ShaderCache::Get(
+    const std::string& key,
+    const std::function<sk_sp<SkShader>()>& make_shader) {
+  if (max_entries_ == 0) {
+    return make_shader();
+  }
+
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    hit_count_++;
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->shader;
+  }
+
+  miss_count_++;
+  sk_sp<SkShader> shader = make_shader();
+  if (!shader) {
+    return nullptr;
+  }
+  while (entries_.size() >= max_entries_) {
+    auto last = std::prev(entries_.end());
+    index_.erase(last->key);
+    entries_.erase(last);
+  }
+  entries_.push_front({key, shader});
+  index_.emplace(entries_.front().key, entries_.begin());
+  return shader;
+}
+
+void ShaderCache::Clear() {
+  index_.clear();
+  entries_.clear();
+}
+
+ShaderCache::Stats ShaderCache::GetStats() const {
+  return {hit_count_, miss_count_, entries_.size()};
+}
+
+}  // namespace flutter
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_SHADER_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_SHADER_CACHE_H_
+
+#include <functional>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkShader.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A cache that interns the immutable shaders built from the parameters passed
+/// by the framework, such as the gradients.
+///
+/// Frameworks usually rebuild their gradients every frame, which makes a new
+/// shader each time with the same parameters. Handing out the same shader
+/// instead saves building it, and lets Skia reuse what it derived from it,
+/// such as the color stops it uploads for the gradient.
+///
+/// Shaders are keyed by the bytes of all the parameters they are built from,
+/// so a key never maps to a shader built from different parameters.
+///
+/// The cache holds at most |max_entries| shaders and evicts the least recently
+/// used ones first. It is not thread-safe; each UI isolate owns one.
+///
+class ShaderCache {
+ public:
+  struct Stats {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    size_t entry_count = 0;
+  };
+
+  static constexpr size_t kDefaultMaxEntries = 64;
+
+  explicit ShaderCache(size_t max_entries = kDefaultMaxEntries);
+
+  ~ShaderCache();
+
+  //----------------------------------------------------------------------------
+  /// Appends the bytes of |value| to the cache key |key|.
+  ///
+  template <typename T>
+  static void AppendToKey(std::string& key, const T& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  //----------------------------------------------------------------------------
+  /// Appends the bytes of the |count| values at |values| to the cache key
+  /// |key|. Null values are told apart from empty ones.
+  ///
+  template <typename T>
+  static void AppendToKey(std::string& key, const T* values, size_t count) {
+    AppendToKey(key, values != nullptr);
+    if (values) {
+      AppendToKey(key, count);
+      key.append(reinterpret_cast<const char*>(values), sizeof(T) * count);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// @return     The shader cached for |key|, or the one |make_shader| builds
+  ///             otherwise, which is then cached for |key| unless it is null.
+  ///
+  sk_sp<SkShader> Get(const std::string& key,
+                      const std::function<sk_sp<SkShader>()>& make_shader);
+
+  void Clear();
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    sk_sp<SkShader> shader;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t max_entries_;
+  // Most recently used first.
+  EntryList entries_;
+  // Keyed by views of the keys of the entries.
+  std::unordered_map<std::string_view, EntryList::iterator> index_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_SHADER_CACHE_H_
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/shader_cache.h"
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/effects/SkGradientShader.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::string MakeKey(float end) {
+  const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+  const float stops[] = {0, end};
+  std::string key;
+  ShaderCache::AppendToKey(key, colors, 2);
+  ShaderCache::AppendToKey(key, stops, 2);
+  return key;
+}
+
+sk_sp<SkShader> MakeGradient() {
+  const SkPoint points[] = {SkPoint::Make(0, 0), SkPoint::Make(10, 0)};
+  const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+  return SkGradientShader::MakeLinear(points, colors, nullptr, 2,
+                                      SkTileMode::kClamp);
+}
+
+}  // namespace
+
+TEST(ShaderCacheTest, EqualKeysShareAShader) {
+  ShaderCache cache;
+  int made_count = 0;
+  auto make_shader = [&made_count]() {
+    made_count++;
+    return MakeGradient();
+  };
+
+  sk_sp<SkShader> first = cache.Get(MakeKey(1), make_shader);
+  ASSERT_TRUE(first);
+  ASSERT_EQ(cache.Get(MakeKey(1), make_shader), first);
+  ASSERT_EQ(made_count, 1);
+
+  ASSERT_NE(cache.Get(MakeKey(0.5), make_shader), first);
+  ASSERT_EQ(made_count, 2);
+
+  const auto stats = cache.GetStats();
+  ASSERT_EQ(stats.hit_count, 1u);
+  ASSERT_EQ(stats.miss_count, 2u);
+  ASSERT_EQ(stats.entry_count, 2u);
+}
+
+TEST(ShaderCacheTest, NullValuesDifferFromEmptyValues) {
+  std::string null_key;
+  ShaderCache::AppendToKey<float>(null_key, nullptr, 0);
+  std::string empty_key;
+  const float empty[] = {0};
+  ShaderCache::AppendToKey(empty_key, empty, 0);
+  ASSERT_NE(null_key, empty_key);
+}
+
+TEST(ShaderCacheTest, NullShadersAreNotCached) {
+  ShaderCache cache;
+  ASSERT_FALSE(cache.Get(MakeKey(1), []() { return nullptr; }));
+  ASSERT_EQ(cache.GetStats().entry_count, 0u);
+  ASSERT_TRUE(cache.Get(MakeKey(1), MakeGradient));
+  ASSERT_EQ(cache.GetStats().entry_count, 1u);
+}
+
+TEST(ShaderCacheTest, EvictsTheLeastRecentlyUsedShader) {
+  ShaderCache cache(2);
+  sk_sp<SkShader> first = cache.Get(MakeKey(1), MakeGradient);
+  sk_sp<SkShader> second = cache.Get(MakeKey(0.5), MakeGradient);
+  // Makes the second shader the least recently used one.
+  ASSERT_EQ(cache.Get(MakeKey(1), MakeGradient), first);
+  cache.Get(MakeKey(0.25), MakeGradient);
+
+  ASSERT_EQ(cache.GetStats().entry_count, 2u);
+  ASSERT_EQ(cache.Get(MakeKey(1), MakeGradient), first);
+  ASSERT_NE(cache.Get(MakeKey(0.5), MakeGradient), second);
+}
+
+}  // namespace testing
+}  // namespace flutter
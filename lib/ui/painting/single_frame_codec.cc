@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/single_frame_codec.h"
 
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/logging/dart_invoke.h"
 
@@ -52,7 +53,11 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   auto decoder = dart_state->GetImageDecoder();
 
   if (!decoder) {
-    return tonic::ToDart("Image decoder not available.");
+    if (dart_state->IsRootIsolate()) {
+      return tonic::ToDart("Image decoder not available.");
+    }
+    DecodeInMemory();
+    return Dart_Null();
   }
 
   // The SingleFrameCodec must be deleted on the UI thread.  Allocate a RefPtr
@@ -85,6 +90,10 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
           codec->cached_image_ = std::move(canvas_image);
         }
 
+        // The encoded data was released and the decoded frame is now held by
+        // the codec, let the garbage collector know.
+        codec->UpdateAllocationSize();
+
         // The cached frame is now available and should be returned to any
         // future callers.
         codec->status_ = Status::kComplete;
@@ -107,8 +116,30 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   return Dart_Null();
 }
 
+void SingleFrameCodec::DecodeInMemory() {
+  // Isolates other than the root isolate have no engine threads or GPU
+  // context. They decode on their own thread, blocking only themselves, into
+  // an image in memory that is uploaded when it is first drawn.
+  fml::tracing::TraceFlow flow(__FUNCTION__);
+  sk_sp<SkImage> image = ImageFromDescriptor(descriptor_, target_width_,
+                                             target_height_, flow);
+  descriptor_ = nullptr;
+  if (image) {
+    cached_image_ = CanvasImage::Create();
+    cached_image_->set_image(UIDartState::CreateGPUObject(std::move(image)));
+  }
+  UpdateAllocationSize();
+  status_ = Status::kComplete;
+
+  for (const DartPersistentValue& callback : pending_callbacks_) {
+    tonic::DartInvoke(callback.value(),
+                      {tonic::ToDart(cached_image_), tonic::ToDart(0)});
+  }
+  pending_callbacks_.clear();
+}
+
 size_t SingleFrameCodec::GetAllocationSize() const {
-  const auto& data_size = descriptor_->GetAllocationSize();
+  const auto data_size = descriptor_ ? descriptor_->GetAllocationSize() : 0;
   const auto frame_byte_size =
       cached_image_ ? cached_image_->GetAllocationSize() : 0;
   return data_size + frame_byte_size + sizeof(this);
@@ -42,6 +42,9 @@ class SingleFrameCodec : public Codec {
   fml::RefPtr<CanvasImage> cached_image_;
   std::vector<DartPersistentValue> pending_callbacks_;
 
+  // Decodes the frame on the calling thread and invokes the pending callbacks.
+  void DecodeInMemory();
+
   FML_FRIEND_MAKE_REF_COUNTED(SingleFrameCodec);
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(SingleFrameCodec);
 };
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_TRANSFER_REGISTRY_H_
+#define FLUTTER_LIB_UI_PAINTING_TRANSFER_REGISTRY_H_
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Holds native objects that are being moved from one isolate to another.
+///
+/// Native-backed objects like |ImmutableBuffer| and |CanvasImage| cannot be
+/// sent through a |SendPort|, and copying their bytes into a message doubles
+/// the memory they use. Instead, the sending isolate moves the object into the
+/// registry and sends the returned token, which is a plain integer. The
+/// receiving isolate claims the object with the token and wraps it again.
+///
+/// Tokens are unique within the process and can be claimed once. An object
+/// may be added with an owner, such as the unref queue of the engine whose
+/// GPU context it belongs to. Only claims made on behalf of the same owner
+/// succeed then, and the object is released with |RemoveOwnedBy| when the
+/// owner goes away. An object without an owner that is never claimed stays
+/// alive until the process exits.
+///
+/// This class is thread-safe.
+///
+template <typename T>
+class TransferRegistry {
+ public:
+  TransferRegistry() = default;
+
+  ~TransferRegistry() = default;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  owner  The owner of |value|, or nullptr if it can be claimed
+  ///                    on behalf of anyone.
+  ///
+  /// @return     The token with which |value| can be claimed. Tokens are
+  ///             never zero.
+  ///
+  int64_t Add(T value, const void* owner = nullptr) {
+    std::scoped_lock lock(mutex_);
+    const int64_t token = next_token_++;
+    entries_.emplace(token, Entry{std::move(value), owner});
+    return token;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  owner  The owner on behalf of which the value is claimed.
+  ///
+  /// @return     The value added with |token|, or nothing if the token is
+  ///             unknown, was already claimed, or belongs to another owner.
+  ///             A value claimed for the wrong owner stays in the registry.
+  ///
+  std::optional<T> Take(int64_t token, const void* owner = nullptr) {
+    std::scoped_lock lock(mutex_);
+    auto found = entries_.find(token);
+    if (found == entries_.end() ||
+        (found->second.owner != nullptr && found->second.owner != owner)) {
+      return std::nullopt;
+    }
+    std::optional<T> value(std::move(found->second.value));
+    entries_.erase(found);
+    return value;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the values of |owner| that were not claimed. The
+  ///             values are destroyed on the calling thread.
+  ///
+  /// @return     The number of released values.
+  ///
+  size_t RemoveOwnedBy(const void* owner) {
+    std::vector<T> removed;
+    {
+      std::scoped_lock lock(mutex_);
+      for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.owner == owner) {
+          removed.push_back(std::move(it->second.value));
+          it = entries_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    return removed.size();
+  }
+
+  size_t GetPendingCount() const {
+    std::scoped_lock lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    T value;
+    const void* owner;
+  };
+
+  mutable std::mutex mutex_;
+  int64_t next_token_ = 1;
+  std::unordered_map<int64_t, Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TransferRegistry);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_TRANSFER_REGISTRY_H_
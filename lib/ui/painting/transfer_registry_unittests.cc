@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/transfer_registry.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(TransferRegistryTest, ValuesAreMovedAndClaimedOnce) {
+  TransferRegistry<std::unique_ptr<int>> registry;
+  auto value = std::make_unique<int>(42);
+  const int* address = value.get();
+
+  const int64_t token = registry.Add(std::move(value));
+  ASSERT_NE(token, 0);
+  ASSERT_EQ(registry.GetPendingCount(), 1u);
+
+  auto claimed = registry.Take(token);
+  ASSERT_TRUE(claimed.has_value());
+  ASSERT_EQ(claimed->get(), address);
+  ASSERT_EQ(**claimed, 42);
+  ASSERT_EQ(registry.GetPendingCount(), 0u);
+
+  ASSERT_FALSE(registry.Take(token).has_value());
+}
+
+TEST(TransferRegistryTest, UnknownTokensAreRejected) {
+  TransferRegistry<int> registry;
+  ASSERT_FALSE(registry.Take(0).has_value());
+  const int64_t token = registry.Add(1);
+  ASSERT_FALSE(registry.Take(token + 1).has_value());
+  ASSERT_EQ(registry.Take(token).value(), 1);
+}
+
+TEST(TransferRegistryTest, OwnedValuesCanOnlyBeClaimedByTheirOwner) {
+  TransferRegistry<int> registry;
+  int owner_a = 0;
+  int owner_b = 0;
+  const int64_t token = registry.Add(1, &owner_a);
+
+  ASSERT_FALSE(registry.Take(token, &owner_b).has_value());
+  ASSERT_FALSE(registry.Take(token).has_value());
+  // A rejected claim leaves the value to its owner.
+  ASSERT_EQ(registry.Take(token, &owner_a).value(), 1);
+
+  // Values without an owner can be claimed on behalf of anyone.
+  const int64_t shared_token = registry.Add(2);
+  ASSERT_EQ(registry.Take(shared_token, &owner_b).value(), 2);
+}
+
+TEST(TransferRegistryTest, RemoveOwnedByReleasesUnclaimedValues) {
+  TransferRegistry<std::shared_ptr<int>> registry;
+  int owner_a = 0;
+  int owner_b = 0;
+  auto value = std::make_shared<int>(1);
+  std::weak_ptr<int> weak_value = value;
+  const int64_t token_a = registry.Add(std::move(value), &owner_a);
+  const int64_t token_b = registry.Add(std::make_shared<int>(2), &owner_b);
+  const int64_t token_shared = registry.Add(std::make_shared<int>(3));
+
+  ASSERT_EQ(registry.RemoveOwnedBy(&owner_a), 1u);
+  ASSERT_TRUE(weak_value.expired());
+  ASSERT_FALSE(registry.Take(token_a, &owner_a).has_value());
+  ASSERT_EQ(*registry.Take(token_b, &owner_b).value(), 2);
+  ASSERT_EQ(*registry.Take(token_shared).value(), 3);
+}
+
+TEST(TransferRegistryTest, TokensAreUniqueAcrossThreads) {
+  TransferRegistry<int> registry;
+  constexpr int kThreadCount = 4;
+  constexpr int kValuesPerThread = 100;
+  std::vector<std::vector<int64_t>> tokens(kThreadCount);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&registry, &tokens, i]() {
+      for (int j = 0; j < kValuesPerThread; j++) {
+        tokens[i].push_back(registry.Add(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(registry.GetPendingCount(),
+            static_cast<size_t>(kThreadCount * kValuesPerThread));
+  for (int i = 0; i < kThreadCount; i++) {
+    for (int64_t token : tokens[i]) {
+      ASSERT_EQ(registry.Take(token).value(), i);
+    }
+  }
+  ASSERT_EQ(registry.GetPendingCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
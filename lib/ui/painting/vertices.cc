@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/vertices.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -14,16 +15,18 @@ namespace flutter {
 
 namespace {
 
-void DecodePoints(const tonic::Float32List& coords, SkPoint* points) {
-  for (int i = 0; i < coords.num_elements(); i += 2) {
-    points[i / 2] = SkPoint::Make(coords[i], coords[i + 1]);
-  }
-}
-
-template <typename T>
-void DecodeInts(const tonic::Int32List& ints, T* out) {
-  for (int i = 0; i < ints.num_elements(); i++) {
-    out[i] = ints[i];
+// The Dart lists share the memory layout of the Skia arrays: points are pairs
+// of floats and colors are 32 bit ARGB values. They are copied as blocks of
+// memory rather than element by element.
+static_assert(sizeof(SkPoint) == 2 * sizeof(float),
+              "SkPoint must be a pair of floats");
+static_assert(sizeof(SkColor) == sizeof(int32_t),
+              "SkColor must be a 32 bit value");
+
+template <typename T, typename List>
+void CopyElements(const List& list, T* out) {
+  if (list.num_elements() > 0) {
+    memcpy(out, list.data(), list.num_elements() * sizeof(list.data()[0]));
   }
 }
 
@@ -49,7 +52,22 @@ bool Vertices::init(Dart_Handle vertices_handle,
                     const tonic::Float32List& texture_coordinates,
                     const tonic::Int32List& colors,
                     const tonic::Uint16List& indices) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
+
+  // The lists are copied into arrays sized after the positions, so their
+  // lengths must match.
+  const intptr_t vertex_count = positions.num_elements() / 2;
+  if (positions.num_elements() % 2 != 0 ||
+      (texture_coordinates.data() &&
+       texture_coordinates.num_elements() != positions.num_elements()) ||
+      (colors.data() && colors.num_elements() != vertex_count)) {
+    return false;
+  }
+  if (indices.data() && indices.num_elements() > 0 &&
+      *std::max_element(indices.begin(), indices.end()) >= vertex_count) {
+    return false;
+  }
+
   uint32_t builderFlags = 0;
   if (texture_coordinates.data()) {
     builderFlags |= SkVertices::kHasTexCoords_BuilderFlag;
@@ -58,33 +76,22 @@ bool Vertices::init(Dart_Handle vertices_handle,
     builderFlags |= SkVertices::kHasColors_BuilderFlag;
   }
 
-  SkVertices::Builder builder(vertex_mode, positions.num_elements() / 2,
+  SkVertices::Builder builder(vertex_mode, vertex_count,
                               indices.num_elements(), builderFlags);
 
   if (!builder.isValid()) {
     return false;
   }
 
-  // positions are required for SkVertices::Builder
-  FML_DCHECK(positions.data());
-  if (positions.data()) {
-    DecodePoints(positions, builder.positions());
-  }
-
+  CopyElements(positions, builder.positions());
   if (texture_coordinates.data()) {
-    // SkVertices::Builder assumes equal numbers of elements
-    FML_DCHECK(positions.num_elements() == texture_coordinates.num_elements());
-    DecodePoints(texture_coordinates, builder.texCoords());
+    CopyElements(texture_coordinates, builder.texCoords());
   }
   if (colors.data()) {
-    // SkVertices::Builder assumes equal numbers of elements
-    FML_DCHECK(positions.num_elements() / 2 == colors.num_elements());
-    DecodeInts<SkColor>(colors, builder.colors());
+    CopyElements(colors, builder.colors());
   }
-
   if (indices.data()) {
-    std::copy(indices.data(), indices.data() + indices.num_elements(),
-              builder.indices());
+    CopyElements(indices, builder.indices());
   }
 
   auto vertices = fml::MakeRefCounted<Vertices>();
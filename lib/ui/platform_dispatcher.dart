@@ -208,6 +208,18 @@ class PlatformDispatcher {
     _invoke(onMetricsChanged, _onMetricsChangedZone);
   }
 
+  // Called from the engine, via hooks.dart
+  //
+  // Removes the window with the given id, which the platform no longer
+  // displays.
+  void _removeWindow(Object id) {
+    if (_views.remove(id) == null) {
+      return;
+    }
+    _viewConfigurations.remove(id);
+    _invoke(onMetricsChanged, _onMetricsChangedZone);
+  }
+
   /// A callback invoked when any view begins a frame.
   ///
   /// A callback that is invoked to notify the application that it is an
@@ -501,6 +513,21 @@ class PlatformDispatcher {
   ///    scheduling of frames.
   void scheduleFrame() native 'PlatformConfiguration_scheduleFrame';
 
+  /// Requests that the display refreshes at `framesPerSecond` while the
+  /// current scene is shown.
+  ///
+  /// Displays with variable refresh rates can then run at a low rate while the
+  /// UI is idle to save power, and at their highest rate while animations run.
+  /// Platforms that can't change the refresh rate ignore the request. Passing
+  /// 0 restores the default rate of the display.
+  void setPreferredFrameRate(double framesPerSecond) {
+    assert(framesPerSecond >= 0.0);
+    _setPreferredFrameRate(framesPerSecond);
+  }
+
+  void _setPreferredFrameRate(double framesPerSecond)
+      native 'PlatformConfiguration_setPreferredFrameRate';
+
   /// Additional accessibility features that may be enabled by the platform.
   AccessibilityFeatures get accessibilityFeatures => configuration.accessibilityFeatures;
 
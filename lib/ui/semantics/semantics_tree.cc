@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree.h"
+
+#include <cmath>
+#include <unordered_set>
+#include <vector>
+
+namespace flutter {
+
+namespace {
+
+constexpr int32_t kRootNodeId = 0;
+
+// Unset scroll positions are NaN, which would never compare equal.
+bool SameDouble(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool SameNode(const SemanticsNode& a, const SemanticsNode& b) {
+  return a.flags == b.flags && a.actions == b.actions &&
+         a.maxValueLength == b.maxValueLength &&
+         a.currentValueLength == b.currentValueLength &&
+         a.textSelectionBase == b.textSelectionBase &&
+         a.textSelectionExtent == b.textSelectionExtent &&
+         a.platformViewId == b.platformViewId &&
+         a.scrollChildren == b.scrollChildren &&
+         a.scrollIndex == b.scrollIndex &&
+         SameDouble(a.scrollPosition, b.scrollPosition) &&
+         SameDouble(a.scrollExtentMax, b.scrollExtentMax) &&
+         SameDouble(a.scrollExtentMin, b.scrollExtentMin) &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.textDirection == b.textDirection && a.rect == b.rect &&
+         a.transform == b.transform &&
+         a.childrenInTraversalOrder == b.childrenInTraversalOrder &&
+         a.childrenInHitTestOrder == b.childrenInHitTestOrder &&
+         a.customAccessibilityActions == b.customAccessibilityActions &&
+         a.label == b.label && a.hint == b.hint && a.value == b.value &&
+         a.increasedValue == b.increasedValue &&
+         a.decreasedValue == b.decreasedValue;
+}
+
+}  // namespace
+
+SemanticsTree::SemanticsTree() = default;
+
+SemanticsTree::~SemanticsTree() = default;
+
+SemanticsNodeUpdates SemanticsTree::Update(SemanticsNodeUpdates update) {
+  bool structure_changed = false;
+  for (auto it = update.begin(); it != update.end();) {
+    auto committed = nodes_.find(it->first);
+    if (committed != nodes_.end() && SameNode(committed->second, it->second)) {
+      it = update.erase(it);
+      continue;
+    }
+    if (committed == nodes_.end()) {
+      nodes_.emplace(it->first, it->second);
+    } else {
+      structure_changed |= committed->second.childrenInTraversalOrder !=
+                           it->second.childrenInTraversalOrder;
+      committed->second = it->second;
+    }
+    ++it;
+  }
+  if (structure_changed) {
+    RemoveUnreachableNodes();
+  }
+  return update;
+}
+
+void SemanticsTree::Reset() {
+  nodes_.clear();
+}
+
+void SemanticsTree::RemoveUnreachableNodes() {
+  if (nodes_.find(kRootNodeId) == nodes_.end()) {
+    return;
+  }
+  std::unordered_set<int32_t> reachable;
+  std::vector<int32_t> pending = {kRootNodeId};
+  while (!pending.empty()) {
+    int32_t id = pending.back();
+    pending.pop_back();
+    auto node = nodes_.find(id);
+    if (node == nodes_.end() || !reachable.insert(id).second) {
+      continue;
+    }
+    pending.insert(pending.end(), node->second.childrenInTraversalOrder.begin(),
+                   node->second.childrenInTraversalOrder.end());
+  }
+  for (auto it = nodes_.begin(); it != nodes_.end();) {
+    if (reachable.count(it->first) == 0) {
+      it = nodes_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_H_
+#define FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/semantics/semantics_node.h"
+
+namespace flutter {
+
+// The semantics tree last committed to the platform.
+//
+// The framework sends every node it marked dirty, which includes nodes whose
+// properties did not change. |Update| removes those nodes from an update so
+// that the platform bridges only convert and ship the nodes that changed.
+// Nodes that are no longer reachable from the root are forgotten, so that a
+// node that is removed and added again is sent again.
+class SemanticsTree {
+ public:
+  SemanticsTree();
+
+  ~SemanticsTree();
+
+  // Applies the update to the tree and returns the nodes of the update that
+  // differ from the committed ones.
+  SemanticsNodeUpdates Update(SemanticsNodeUpdates update);
+
+  // Forgets the committed tree, e.g. because the framework is about to send
+  // the whole tree again.
+  void Reset();
+
+  size_t GetNodeCount() const { return nodes_.size(); }
+
+ private:
+  SemanticsNodeUpdates nodes_;
+
+  void RemoveUnreachableNodes();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SemanticsTree);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_H_
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static SemanticsNode CreateNode(int32_t id,
+                                std::vector<int32_t> children = {}) {
+  SemanticsNode node;
+  node.id = id;
+  node.label = "node " + std::to_string(id);
+  node.childrenInHitTestOrder = children;
+  node.childrenInTraversalOrder = std::move(children);
+  return node;
+}
+
+TEST(SemanticsTreeTest, UnchangedNodesAreNotSent) {
+  SemanticsTree tree;
+  SemanticsNodeUpdates update = {
+      {0, CreateNode(0, {1, 2})},
+      {1, CreateNode(1)},
+      {2, CreateNode(2)},
+  };
+  ASSERT_EQ(tree.Update(update).size(), 3u);
+
+  update[2].label = "changed";
+  auto changed = tree.Update(update);
+  ASSERT_EQ(changed.size(), 1u);
+  ASSERT_EQ(changed.count(2), 1u);
+  ASSERT_EQ(changed[2].label, "changed");
+
+  ASSERT_TRUE(tree.Update(update).empty());
+}
+
+TEST(SemanticsTreeTest, UnsetScrollPositionsAreEqual) {
+  SemanticsTree tree;
+  SemanticsNodeUpdates update = {{0, CreateNode(0)}};
+  ASSERT_TRUE(std::isnan(update[0].scrollPosition));
+  ASSERT_EQ(tree.Update(update).size(), 1u);
+  ASSERT_TRUE(tree.Update(update).empty());
+}
+
+TEST(SemanticsTreeTest, RemovedNodesAreSentAgainOnceAdded) {
+  SemanticsTree tree;
+  tree.Update({
+      {0, CreateNode(0, {1, 2})},
+      {1, CreateNode(1, {3})},
+      {2, CreateNode(2)},
+      {3, CreateNode(3)},
+  });
+  ASSERT_EQ(tree.GetNodeCount(), 4u);
+
+  // Removes the subtree of node 1.
+  ASSERT_EQ(tree.Update({{0, CreateNode(0, {2})}}).size(), 1u);
+  ASSERT_EQ(tree.GetNodeCount(), 2u);
+
+  auto changed = tree.Update({
+      {0, CreateNode(0, {1, 2})},
+      {1, CreateNode(1)},
+      {2, CreateNode(2)},
+  });
+  ASSERT_EQ(changed.size(), 2u);
+  ASSERT_EQ(changed.count(0), 1u);
+  ASSERT_EQ(changed.count(1), 1u);
+}
+
+TEST(SemanticsTreeTest, ResetSendsAllNodesAgain) {
+  SemanticsTree tree;
+  SemanticsNodeUpdates update = {
+      {0, CreateNode(0, {1})},
+      {1, CreateNode(1)},
+  };
+  tree.Update(update);
+  tree.Reset();
+  ASSERT_EQ(tree.GetNodeCount(), 0u);
+  ASSERT_EQ(tree.Update(update).size(), 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
 
+#include <utility>
+
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/skia/include/core/SkScalar.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -102,17 +104,13 @@ void SemanticsUpdateBuilder::updateNode(
     scalarTransform[i] = transform.data()[i];
   }
   node.transform = SkM44::ColMajor(scalarTransform);
-  node.childrenInTraversalOrder =
-      std::vector<int32_t>(childrenInTraversalOrder.data(),
-                           childrenInTraversalOrder.data() +
-                               childrenInTraversalOrder.num_elements());
-  node.childrenInHitTestOrder = std::vector<int32_t>(
-      childrenInHitTestOrder.data(),
-      childrenInHitTestOrder.data() + childrenInHitTestOrder.num_elements());
-  node.customAccessibilityActions = std::vector<int32_t>(
-      localContextActions.data(),
-      localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+  node.childrenInTraversalOrder.assign(childrenInTraversalOrder.begin(),
+                                       childrenInTraversalOrder.end());
+  node.childrenInHitTestOrder.assign(childrenInHitTestOrder.begin(),
+                                     childrenInHitTestOrder.end());
+  node.customAccessibilityActions.assign(localContextActions.begin(),
+                                         localContextActions.end());
+  nodes_[id] = std::move(node);
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 #define FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 
+#include <functional>
+#include <utility>
+
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
@@ -16,6 +19,24 @@ class SnapshotDelegate {
                                             SkISize picture_size) = 0;
 
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
+
+  using SnapshotCallback = std::function<void(sk_sp<SkImage>)>;
+
+  // Like |MakeRasterSnapshot|, but the pixels may be read back from the GPU
+  // asynchronously so that the calling thread is not blocked on the transfer.
+  // |callback| is invoked on the calling thread, possibly before this returns.
+  virtual void MakeRasterSnapshotAsync(sk_sp<SkPicture> picture,
+                                       SkISize picture_size,
+                                       SnapshotCallback callback) {
+    callback(MakeRasterSnapshot(std::move(picture), picture_size));
+  }
+
+  // Like |ConvertToRasterImage|, but asynchronous like
+  // |MakeRasterSnapshotAsync|.
+  virtual void ConvertToRasterImageAsync(sk_sp<SkImage> image,
+                                         SnapshotCallback callback) {
+    callback(ConvertToRasterImage(std::move(image)));
+  }
 };
 
 }  // namespace flutter
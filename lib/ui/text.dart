@@ -2255,6 +2255,23 @@ class ParagraphBuilder extends NativeFieldWrapperClass2 {
     return paragraph;
   }
   void _build(Paragraph outParagraph) native 'ParagraphBuilder_build';
+
+  /// Applies the given paragraph style, and returns a [Paragraph] containing
+  /// the added text that was laid out with the given [ParagraphConstraints].
+  ///
+  /// The result is the same as calling [build] and then [Paragraph.layout],
+  /// but the layout runs on a background thread. Use this to lay out text
+  /// ahead of showing it, such as the next page of a long list, without
+  /// delaying frames.
+  ///
+  /// After calling this function, the paragraph builder object is invalid and
+  /// cannot be used further.
+  Future<Paragraph> buildAndLayout(ParagraphConstraints constraints) {
+    return _futurize((_Callback<Paragraph> callback) {
+      return _buildAndLayout(constraints.width, callback);
+    });
+  }
+  String? _buildAndLayout(double width, _Callback<Paragraph> callback) native 'ParagraphBuilder_buildAndLayout';
 }
 
 /// Loads a font from a buffer and makes it available for rendering text.
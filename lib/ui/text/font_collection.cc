@@ -165,12 +165,14 @@ void FontCollection::LoadFontFromList(const uint8_t* font_data,
       SkTypeface::MakeFromStream(std::move(font_stream));
   txt::TypefaceFontAssetProvider& font_provider =
       dynamic_font_manager_->font_provider();
-  if (family_name.empty()) {
-    font_provider.RegisterTypeface(typeface);
-  } else {
-    font_provider.RegisterTypeface(typeface, family_name);
-  }
-  collection_->ClearFontFamilyCache();
+  // Paragraphs may be laid out on worker threads meanwhile.
+  collection_->UpdateDynamicFonts([&] {
+    if (family_name.empty()) {
+      font_provider.RegisterTypeface(typeface);
+    } else {
+      font_provider.RegisterTypeface(typeface, family_name);
+    }
+  });
 }
 
 }  // namespace flutter
@@ -29,6 +29,11 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
     paragraph->AssociateWithDartWrapper(paragraph_handle);
   }
 
+  static fml::RefPtr<Paragraph> Create(
+      std::unique_ptr<txt::Paragraph> txt_paragraph) {
+    return fml::MakeRefCounted<Paragraph>(std::move(txt_paragraph));
+  }
+
   ~Paragraph() override;
 
   double width();
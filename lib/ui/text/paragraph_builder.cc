@@ -9,7 +9,10 @@
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
@@ -25,6 +28,8 @@
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/typed_data/dart_byte_data.h"
 
 namespace flutter {
@@ -132,7 +137,11 @@ const int sForceStrutHeightMask = 1 << sForceStrutHeightIndex;
 }  // namespace
 
 static void ParagraphBuilder_constructor(Dart_NativeArguments args) {
-  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::ThrowIfPaintingOperationsProhibited();
+  if (!UIDartState::Current()->GetFontCollection()) {
+    Dart_ThrowException(
+        tonic::ToDart("No fonts are available to build paragraphs."));
+  }
   DartCallConstructor(&ParagraphBuilder::create, args);
 }
 
@@ -143,7 +152,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, ParagraphBuilder);
   V(ParagraphBuilder, pop)            \
   V(ParagraphBuilder, addText)        \
   V(ParagraphBuilder, addPlaceholder) \
-  V(ParagraphBuilder, build)
+  V(ParagraphBuilder, build)          \
+  V(ParagraphBuilder, buildAndLayout)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
@@ -290,19 +300,19 @@ ParagraphBuilder::ParagraphBuilder(
     style.locale = locale;
   }
 
-  FontCollection& font_collection = UIDartState::Current()
-                                        ->platform_configuration()
-                                        ->client()
-                                        ->GetFontCollection();
+  std::shared_ptr<txt::FontCollection> font_collection =
+      UIDartState::Current()->GetFontCollection();
 
 #if FLUTTER_ENABLE_SKSHAPER
-#define FLUTTER_PARAGRAPH_BUILDER txt::ParagraphBuilder::CreateSkiaBuilder
-#else
-#define FLUTTER_PARAGRAPH_BUILDER txt::ParagraphBuilder::CreateTxtBuilder
-#endif
+  if (UIDartState::Current()->enable_skparagraph()) {
+    m_paragraphBuilder = txt::ParagraphBuilder::CreateSkiaBuilder(
+        style, std::move(font_collection));
+    return;
+  }
+#endif  // FLUTTER_ENABLE_SKSHAPER
 
   m_paragraphBuilder =
-      FLUTTER_PARAGRAPH_BUILDER(style, font_collection.GetFontCollection());
+      txt::ParagraphBuilder::CreateTxtBuilder(style, std::move(font_collection));
 }
 
 ParagraphBuilder::~ParagraphBuilder() = default;
@@ -510,4 +520,56 @@ void ParagraphBuilder::build(Dart_Handle paragraph_handle) {
   Paragraph::Create(paragraph_handle, m_paragraphBuilder->Build());
 }
 
+Dart_Handle ParagraphBuilder::buildAndLayout(double width,
+                                             Dart_Handle callback) {
+  if (!Dart_IsClosure(callback)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  std::unique_ptr<txt::Paragraph> paragraph = m_paragraphBuilder->Build();
+
+  // The font collection of Skia's text layout is not thread-safe.
+  fml::WeakPtr<ImageDecoder> image_decoder;
+  if (!dart_state->enable_skparagraph()) {
+    image_decoder = dart_state->GetImageDecoder();
+  }
+  if (!image_decoder) {
+    paragraph->Layout(width);
+    tonic::DartInvoke(callback,
+                      {tonic::ToDart(Paragraph::Create(std::move(paragraph)))});
+    return Dart_Null();
+  }
+
+  auto persistent_callback =
+      std::make_unique<tonic::DartPersistentValue>(dart_state, callback);
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+  image_decoder->GetConcurrentTaskRunner()->PostTask(fml::MakeCopyable(
+      [paragraph = std::move(paragraph), width, ui_task_runner,
+       callback = std::move(persistent_callback)]() mutable {
+        {
+          TRACE_EVENT0("flutter", "ParagraphBuilder::buildAndLayout");
+          paragraph->Layout(width);
+        }
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [paragraph = std::move(paragraph),
+             callback = std::move(callback)]() mutable {
+              auto dart_state = callback->dart_state().lock();
+              if (!dart_state) {
+                // The root isolate could have died in the meantime.
+                return;
+              }
+              tonic::DartState::Scope scope(dart_state);
+              tonic::DartInvoke(
+                  callback->Get(),
+                  {tonic::ToDart(Paragraph::Create(std::move(paragraph)))});
+
+              // The callback is associated with the Dart isolate and must be
+              // deleted on the UI thread.
+              callback.reset();
+            }));
+      }));
+  return Dart_Null();
+}
+
 }  // namespace flutter
@@ -71,6 +71,10 @@ class ParagraphBuilder : public RefCountedDartWrappable<ParagraphBuilder> {
 
   void build(Dart_Handle paragraph_handle);
 
+  // Builds the paragraph and lays it out on the concurrent task runner, then
+  // invokes |callback| with the paragraph on the UI thread.
+  Dart_Handle buildAndLayout(double width, Dart_Handle callback);
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
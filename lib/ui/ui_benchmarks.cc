@@ -5,6 +5,7 @@
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
+#include "flutter/lib/ui/window/pointer_data_packet_converter.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
@@ -70,4 +71,36 @@ static void BM_PlatformMessageResponseDartComplete(
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+static void BM_PointerDataPacketConverterConvert(
+    benchmark::State& state) {  // NOLINT
+  // A stroke of a stylus: a down, many moves and an up.
+  const size_t count = state.range(0);
+  std::vector<PointerData> stroke(count + 2);
+  for (size_t i = 0; i < stroke.size(); i++) {
+    PointerData& data = stroke[i];
+    data.Clear();
+    data.kind = PointerData::DeviceKind::kStylus;
+    data.change = PointerData::Change::kMove;
+    data.physical_x = i;
+    data.physical_y = i;
+    data.pressure = 1.0;
+  }
+  stroke.front().change = PointerData::Change::kDown;
+  stroke.back().change = PointerData::Change::kUp;
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    PointerDataPacketConverter converter;
+    auto packet = std::make_unique<PointerDataPacket>(stroke);
+    state.ResumeTiming();
+
+    auto converted = converter.Convert(std::move(packet));
+    benchmark::DoNotOptimize(converted);
+  }
+}
+
+BENCHMARK(BM_PointerDataPacketConverterConvert)
+    ->Range(8, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/ui_dart_state.h"
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_message_handler.h"
@@ -27,7 +28,11 @@ UIDartState::UIDartState(
     std::string logger_prefix,
     UnhandledExceptionCallback unhandled_exception_callback,
     std::shared_ptr<IsolateNameServer> isolate_name_server,
-    bool is_root_isolate)
+    bool is_root_isolate,
+    bool enable_display_list,
+    double downsampled_blur_min_sigma,
+    int downsampled_blur_max_factor,
+    bool enable_skparagraph)
     : task_runners_(std::move(task_runners)),
       add_callback_(std::move(add_callback)),
       remove_callback_(std::move(remove_callback)),
@@ -40,6 +45,10 @@ UIDartState::UIDartState(
       advisory_script_entrypoint_(std::move(advisory_script_entrypoint)),
       logger_prefix_(std::move(logger_prefix)),
       is_root_isolate_(is_root_isolate),
+      enable_display_list_(enable_display_list),
+      downsampled_blur_min_sigma_(downsampled_blur_min_sigma),
+      downsampled_blur_max_factor_(downsampled_blur_max_factor),
+      enable_skparagraph_(enable_skparagraph),
       unhandled_exception_callback_(unhandled_exception_callback),
       isolate_name_server_(std::move(isolate_name_server)) {
   AddOrRemoveTaskObserver(true /* add */);
@@ -73,6 +82,32 @@ void UIDartState::ThrowIfUIOperationsProhibited() {
   }
 }
 
+void UIDartState::ThrowIfPaintingOperationsProhibited() {
+  if (!UIDartState::Current()->CanPaint()) {
+    Dart_ThrowException(
+        tonic::ToDart("Painting is only available on the root isolate and "
+                      "the isolates it spawns."));
+  }
+}
+
+UIDartState::PaintingContext UIDartState::GetPaintingContext() const {
+  return {skia_unref_queue_, GetFontCollection()};
+}
+
+std::shared_ptr<txt::FontCollection> UIDartState::GetFontCollection() const {
+  if (platform_configuration_) {
+    return platform_configuration_->client()
+        ->GetFontCollection()
+        .GetFontCollection();
+  }
+  return font_collection_;
+}
+
+void UIDartState::SetFontCollection(
+    std::shared_ptr<txt::FontCollection> font_collection) {
+  font_collection_ = std::move(font_collection);
+}
+
 void UIDartState::SetDebugName(const std::string debug_name) {
   debug_name_ = debug_name;
   if (platform_configuration_) {
@@ -19,6 +19,8 @@
 #include "flutter/lib/ui/io_manager.h"
 #include "flutter/lib/ui/isolate_name_server/isolate_name_server.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/painting/path_cache.h"
+#include "flutter/lib/ui/painting/shader_cache.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -26,12 +28,24 @@
 #include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/dart_state.h"
 
+namespace txt {
+class FontCollection;
+}  // namespace txt
+
 namespace flutter {
 class FontSelector;
 class PlatformConfiguration;
 
 class UIDartState : public tonic::DartState {
  public:
+  // What isolates other than the root isolate need to record pictures and lay
+  // out paragraphs. The root isolate shares its context with the isolates
+  // spawned in its group.
+  struct PaintingContext {
+    fml::RefPtr<SkiaUnrefQueue> unref_queue;
+    std::shared_ptr<txt::FontCollection> font_collection;
+  };
+
   static UIDartState* Current();
 
   Dart_Port main_port() const { return main_port_; }
@@ -39,6 +53,21 @@ class UIDartState : public tonic::DartState {
   bool IsRootIsolate() const { return is_root_isolate_; }
   static void ThrowIfUIOperationsProhibited();
 
+  // Unlike |ThrowIfUIOperationsProhibited|, also allows the isolates spawned
+  // by the root isolate, which have no window but can paint off-screen.
+  static void ThrowIfPaintingOperationsProhibited();
+
+  // Whether this isolate has the resources to create pictures.
+  bool CanPaint() const { return is_root_isolate_ || skia_unref_queue_; }
+
+  PaintingContext GetPaintingContext() const;
+
+  // The fonts of the platform configuration, or of the root isolate that
+  // spawned this isolate. May be null.
+  std::shared_ptr<txt::FontCollection> GetFontCollection() const;
+
+  void SetFontCollection(std::shared_ptr<txt::FontCollection> font_collection);
+
   void SetDebugName(const std::string name);
 
   const std::string& debug_name() const { return debug_name_; }
@@ -69,6 +98,29 @@ class UIDartState : public tonic::DartState {
 
   std::shared_ptr<IsolateNameServer> GetIsolateNameServer() const;
 
+  // Canonical paths for the geometry drawn by this isolate. See |PathCache|.
+  PathCache& GetPathCache() { return path_cache_; }
+
+  // Interned gradients built by this isolate. See |ShaderCache|.
+  ShaderCache& GetShaderCache() { return shader_cache_; }
+
+  // Whether pictures are recorded into display lists instead of SkPictures.
+  bool enable_display_list() const { return enable_display_list_; }
+
+  // The sigma from which blurs pushed as layers are downsampled, or 0 to never
+  // downsample them. See |MakeBlurImageFilter|.
+  double downsampled_blur_min_sigma() const {
+    return downsampled_blur_min_sigma_;
+  }
+
+  int downsampled_blur_max_factor() const {
+    return downsampled_blur_max_factor_;
+  }
+
+  // Whether paragraphs are laid out with Skia's text layout module instead of
+  // libtxt. This only has an effect in engines built with the module.
+  bool enable_skparagraph() const { return enable_skparagraph_; }
+
   tonic::DartErrorHandleType GetLastError();
 
   void ReportUnhandledException(const std::string& error,
@@ -99,7 +151,11 @@ class UIDartState : public tonic::DartState {
               std::string logger_prefix,
               UnhandledExceptionCallback unhandled_exception_callback,
               std::shared_ptr<IsolateNameServer> isolate_name_server,
-              bool is_root_isolate_);
+              bool is_root_isolate_,
+              bool enable_display_list,
+              double downsampled_blur_min_sigma,
+              int downsampled_blur_max_factor,
+              bool enable_skparagraph);
 
   ~UIDartState() override;
 
@@ -126,11 +182,18 @@ class UIDartState : public tonic::DartState {
   const std::string logger_prefix_;
   Dart_Port main_port_ = ILLEGAL_PORT;
   const bool is_root_isolate_;
+  const bool enable_display_list_;
+  const double downsampled_blur_min_sigma_;
+  const int downsampled_blur_max_factor_;
+  const bool enable_skparagraph_;
   std::string debug_name_;
   std::unique_ptr<PlatformConfiguration> platform_configuration_;
+  std::shared_ptr<txt::FontCollection> font_collection_;
   tonic::DartMicrotaskQueue microtask_queue_;
   UnhandledExceptionCallback unhandled_exception_callback_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
+  PathCache path_cache_;
+  ShaderCache shader_cache_;
 
   void AddOrRemoveTaskObserver(bool add);
 };
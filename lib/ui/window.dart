@@ -253,8 +253,12 @@ abstract class FlutterView {
   ///   scheduling of frames.
   /// * [RendererBinding], the Flutter framework class which manages layout and
   ///   painting.
-  void render(Scene scene) => _render(scene, this);
-  void _render(Scene scene, FlutterView view) native 'PlatformConfiguration_render';
+  void render(Scene scene) => _render(scene, _viewId);
+  void _render(Scene scene, Object viewId) native 'PlatformConfiguration_render';
+
+  /// The id the engine knows this view by. Views that are not windows of the
+  /// platform dispatcher render into the implicit view, whose id is 0.
+  Object get _viewId => 0;
 }
 
 /// A top-level platform window displaying a Flutter layer tree drawn from a
@@ -279,6 +283,9 @@ class FlutterWindow extends FlutterView {
   /// The opaque ID for this view.
   final Object _windowId;
 
+  @override
+  Object get _viewId => _windowId;
+
   @override
   final PlatformDispatcher platformDispatcher;
 
@@ -6,6 +6,7 @@
 
 #include <cstring>
 
+#include "flutter/common/constants.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
@@ -44,7 +45,14 @@ void Render(Dart_NativeArguments args) {
     Dart_ThrowException(exception);
     return;
   }
-  UIDartState::Current()->platform_configuration()->client()->Render(scene);
+  int64_t view_id =
+      tonic::DartConverter<int64_t>::FromArguments(args, 2, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+  UIDartState::Current()->platform_configuration()->client()->Render(view_id,
+                                                                     scene);
 }
 
 void UpdateSemantics(Dart_NativeArguments args) {
@@ -82,6 +90,21 @@ void SetNeedsReportTimings(Dart_NativeArguments args) {
       ->SetNeedsReportTimings(value);
 }
 
+void SetPreferredFrameRate(Dart_NativeArguments args) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  Dart_Handle exception = nullptr;
+  double frames_per_second =
+      tonic::DartConverter<double>::FromArguments(args, 1, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+  UIDartState::Current()
+      ->platform_configuration()
+      ->client()
+      ->SetPreferredFrameRate(frames_per_second);
+}
+
 void ReportUnhandledException(Dart_NativeArguments args) {
   UIDartState::ThrowIfUIOperationsProhibited();
 
@@ -185,6 +208,27 @@ Dart_Handle ToByteData(const std::vector<uint8_t>& buffer) {
   return tonic::DartByteData::Create(buffer.data(), buffer.size());
 }
 
+// Below this size, copying a payload into the Dart heap is cheaper than
+// finalizing an external typed data.
+constexpr size_t kMessageCopyThreshold = 1000;
+
+void FinalizeMapping(void* isolate_callback_data, void* peer) {
+  delete reinterpret_cast<fml::Mapping*>(peer);
+}
+
+// Large payloads are handed to Dart without a copy, the returned byte data
+// owns |mapping|.
+Dart_Handle ToByteData(std::unique_ptr<fml::Mapping> mapping) {
+  const size_t size = mapping->GetSize();
+  if (size < kMessageCopyThreshold) {
+    return tonic::DartByteData::Create(mapping->GetMapping(), size);
+  }
+  uint8_t* bytes = const_cast<uint8_t*>(mapping->GetMapping());
+  void* peer = reinterpret_cast<void*>(mapping.release());
+  return Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, bytes, size, peer, size, FinalizeMapping);
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -198,8 +242,10 @@ PlatformConfiguration::~PlatformConfiguration() {}
 void PlatformConfiguration::DidCreateIsolate() {
   library_.Set(tonic::DartState::Current(),
                Dart_LookupLibrary(tonic::ToDart("dart:ui")));
-  windows_.insert(std::make_pair(0, std::unique_ptr<Window>(new Window{
-                                        0, ViewportMetrics{1.0, 0.0, 0.0}})));
+  windows_.insert(std::make_pair(
+      kFlutterImplicitViewId,
+      std::unique_ptr<Window>(new Window{kFlutterImplicitViewId,
+                                         ViewportMetrics{1.0, 0.0, 0.0}})));
 }
 
 void PlatformConfiguration::UpdateLocales(
@@ -243,6 +289,36 @@ void PlatformConfiguration::UpdateLifecycleState(const std::string& data) {
                                            }));
 }
 
+void PlatformConfiguration::AddWindow(int64_t window_id,
+                                      const ViewportMetrics& metrics) {
+  FML_DCHECK(window_id != kFlutterImplicitViewId);
+  auto found = windows_.find(window_id);
+  if (found == windows_.end()) {
+    found = windows_
+                .insert(std::make_pair(
+                    window_id,
+                    std::unique_ptr<Window>(new Window{window_id, metrics})))
+                .first;
+  }
+  found->second->UpdateWindowMetrics(metrics);
+}
+
+void PlatformConfiguration::RemoveWindow(int64_t window_id) {
+  FML_DCHECK(window_id != kFlutterImplicitViewId);
+  if (windows_.erase(window_id) == 0) {
+    return;
+  }
+  std::shared_ptr<tonic::DartState> dart_state = library_.dart_state().lock();
+  if (!dart_state) {
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  tonic::LogIfError(tonic::DartInvokeField(library_.value(), "_removeWindow",
+                                           {
+                                               tonic::ToDart(window_id),
+                                           }));
+}
+
 void PlatformConfiguration::UpdateSemanticsEnabled(bool enabled) {
   std::shared_ptr<tonic::DartState> dart_state = library_.dart_state().lock();
   if (!dart_state) {
@@ -278,7 +354,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToByteData(message->releaseData()) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -429,6 +505,8 @@ void PlatformConfiguration::RegisterNatives(
        true},
       {"PlatformConfiguration_reportUnhandledException",
        ReportUnhandledException, 2, true},
+      {"PlatformConfiguration_setPreferredFrameRate", SetPreferredFrameRate, 2,
+       true},
       {"PlatformConfiguration_setNeedsReportTimings", SetNeedsReportTimings, 2,
        true},
       {"PlatformConfiguration_getPersistentIsolateData",
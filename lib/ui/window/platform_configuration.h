@@ -18,6 +18,7 @@
 #include "third_party/tonic/dart_persistent_value.h"
 
 namespace flutter {
+class AssetManager;
 class FontCollection;
 class PlatformMessage;
 class Scene;
@@ -63,7 +64,10 @@ class PlatformConfigurationClient {
   /// @brief      Updates the client's rendering on the GPU with the newly
   ///             provided Scene.
   ///
-  virtual void Render(Scene* scene) = 0;
+  /// @param[in]  view_id  The id of the window the scene was rendered for.
+  /// @param[in]  scene    The scene to render.
+  ///
+  virtual void Render(int64_t view_id, Scene* scene) = 0;
 
   //--------------------------------------------------------------------------
   /// @brief      Receives a updated semantics tree from the Framework.
@@ -95,6 +99,14 @@ class PlatformConfigurationClient {
   ///             creation.
   virtual FontCollection& GetFontCollection() = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Returns the asset manager of the engine, or nullptr if no
+  ///             assets are available.
+  ///
+  ///             Assets read through the returned manager are usually memory
+  ///             mapped and may be handed to the engine without a copy.
+  virtual std::shared_ptr<AssetManager> GetAssetManager() = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      Notifies this client of the name of the root isolate and its
   ///             port when that isolate is launched, restarted (in the
@@ -138,6 +150,20 @@ class PlatformConfigurationClient {
   ///
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Requests that the display refreshes at the given rate while
+  ///             the current scene is shown, so that displays with variable
+  ///             refresh rates can run slower while the UI is idle.
+  ///
+  ///             This is the engine counterpart of
+  ///             `PlatformDispatcher.setPreferredFrameRate` in
+  ///             `platform_dispatcher.dart`.
+  ///
+  /// @param[in]  frames_per_second  The preferred frame rate, or 0 for the
+  ///                                default rate of the display.
+  ///
+  virtual void SetPreferredFrameRate(double frames_per_second) = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      The embedder can specify data that the isolate can request
   ///             synchronously on launch. This accessor fetches that data.
@@ -174,6 +200,17 @@ class PlatformConfigurationClient {
   ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Invoked when the Dart VM requests a deferred loading unit of
+  ///             the AOT program, when Dart code calls `loadLibrary` on a
+  ///             deferred import. The request is completed asynchronously by
+  ///             `DartIsolate::LoadLoadingUnit` or
+  ///             `DartIsolate::LoadLoadingUnitError`.
+  ///
+  /// @param[in]  loading_unit_id  The identifier of the loading unit.
+  ///
+  virtual void RequestDartDeferredLibrary(intptr_t loading_unit_id) = 0;
+
  protected:
   virtual ~PlatformConfigurationClient();
 };
@@ -256,6 +293,26 @@ class PlatformConfiguration final {
   ///
   void UpdateLifecycleState(const std::string& data);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a window for a view that the platform renders in
+  ///             addition to the implicit view, and notifies the framework of
+  ///             it with the window metrics. If the window was added already,
+  ///             only its metrics are updated.
+  ///
+  /// @param[in]  window_id  The id of the window, which must not be the id of
+  ///                        the implicit view.
+  /// @param[in]  metrics    The metrics of the window.
+  ///
+  void AddWindow(int64_t window_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a window added with |AddWindow| and notifies the
+  ///             framework, which stops rendering scenes for it.
+  ///
+  /// @param[in]  window_id  The id of the window to remove.
+  ///
+  void RemoveWindow(int64_t window_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the PlatformConfiguration that the embedder has
   ///             expressed an opinion about whether the accessibility tree
@@ -367,9 +424,13 @@ class PlatformConfiguration final {
   ///
   /// @param[in] window_id The id of the window to find and return.
   ///
-  /// @return     a pointer to the Window.
+  /// @return     a pointer to the Window, or null if there is no window with
+  ///             this id.
   ///
-  Window* get_window(int window_id) { return windows_[window_id].get(); }
+  Window* get_window(int64_t window_id) {
+    auto found = windows_.find(window_id);
+    return found != windows_.end() ? found->second.get() : nullptr;
+  }
 
   //----------------------------------------------------------------------------
   /// @brief      Responds to a previous platform message to the engine from the
@@ -27,13 +27,15 @@ class DummyPlatformConfigurationClient : public PlatformConfigurationClient {
   }
   std::string DefaultRouteName() override { return "TestRoute"; }
   void ScheduleFrame() override {}
-  void Render(Scene* scene) override {}
+  void Render(int64_t view_id, Scene* scene) override {}
   void UpdateSemantics(SemanticsUpdate* update) override {}
   void HandlePlatformMessage(fml::RefPtr<PlatformMessage> message) override {}
   FontCollection& GetFontCollection() override { return font_collection_; }
+  std::shared_ptr<AssetManager> GetAssetManager() override { return nullptr; }
   void UpdateIsolateDescription(const std::string isolate_name,
                                 int64_t isolate_port) override {}
   void SetNeedsReportTimings(bool value) override {}
+  void SetPreferredFrameRate(double frames_per_second) override {}
   std::shared_ptr<const fml::Mapping> GetPersistentIsolateData() override {
     return isolate_data_;
   }
@@ -41,6 +43,7 @@ class DummyPlatformConfigurationClient : public PlatformConfigurationClient {
       const std::vector<std::string>& supported_locale_data) override {
     return nullptr;
   };
+  void RequestDartDeferredLibrary(intptr_t loading_unit_id) override {}
 
  private:
   FontCollection font_collection_;
@@ -140,5 +143,57 @@ TEST_F(ShellTest, PlatformConfigurationWindowMetricsUpdate) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, PlatformConfigurationAddsAndRemovesWindows) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+
+  auto nativeValidateConfiguration = [message_latch](
+                                         Dart_NativeArguments args) {
+    PlatformConfiguration* configuration =
+        UIDartState::Current()->platform_configuration();
+
+    ASSERT_EQ(configuration->get_window(1), nullptr);
+    configuration->AddWindow(1, ViewportMetrics{2.0, 10.0, 20.0});
+    ASSERT_NE(configuration->get_window(1), nullptr);
+    ASSERT_EQ(configuration->get_window(1)->viewport_metrics().physical_width,
+              10.0);
+
+    // Adding the window again updates its metrics.
+    configuration->AddWindow(1, ViewportMetrics{2.0, 30.0, 40.0});
+    ASSERT_EQ(configuration->get_window(1)->viewport_metrics().physical_width,
+              30.0);
+
+    configuration->RemoveWindow(1);
+    ASSERT_EQ(configuration->get_window(1), nullptr);
+    ASSERT_NE(configuration->get_window(0), nullptr);
+
+    message_latch->Signal();
+  };
+
+  Settings settings = CreateSettingsForFixture();
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("ValidateConfiguration",
+                    CREATE_NATIVE_ENTRY(nativeValidateConfiguration));
+
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint("validateConfiguration");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -22,6 +22,13 @@ PlatformMessageResponseDart::PlatformMessageResponseDart(
 
 PlatformMessageResponseDart::~PlatformMessageResponseDart() {
   if (!callback_.is_empty()) {
+    // A response that was never completed is usually dropped on the UI thread,
+    // for example when the message had no handler, and doesn't need a task to
+    // release the callback.
+    if (ui_task_runner_->RunsTasksOnCurrentThread()) {
+      callback_.Clear();
+      return;
+    }
     ui_task_runner_->PostTask(fml::MakeCopyable(
         [callback = std::move(callback_)]() mutable { callback.Clear(); }));
   }
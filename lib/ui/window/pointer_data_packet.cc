@@ -14,10 +14,20 @@ PointerDataPacket::PointerDataPacket(size_t count)
 PointerDataPacket::PointerDataPacket(uint8_t* data, size_t num_bytes)
     : data_(data, data + num_bytes) {}
 
+PointerDataPacket::PointerDataPacket(const std::vector<PointerData>& data)
+    : data_(reinterpret_cast<const uint8_t*>(data.data()),
+            reinterpret_cast<const uint8_t*>(data.data() + data.size())) {}
+
 PointerDataPacket::~PointerDataPacket() = default;
 
 void PointerDataPacket::SetPointerData(size_t i, const PointerData& data) {
   memcpy(&data_[i * sizeof(PointerData)], &data, sizeof(PointerData));
 }
 
+PointerData PointerDataPacket::GetPointerData(size_t i) const {
+  PointerData data;
+  memcpy(&data, &data_[i * sizeof(PointerData)], sizeof(PointerData));
+  return data;
+}
+
 }  // namespace flutter
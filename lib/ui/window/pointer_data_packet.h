@@ -17,9 +17,12 @@ class PointerDataPacket {
  public:
   explicit PointerDataPacket(size_t count);
   PointerDataPacket(uint8_t* data, size_t num_bytes);
+  explicit PointerDataPacket(const std::vector<PointerData>& data);
   ~PointerDataPacket();
 
   void SetPointerData(size_t i, const PointerData& data);
+  PointerData GetPointerData(size_t i) const;
+  size_t GetLength() const { return data_.size() / sizeof(PointerData); }
   const std::vector<uint8_t>& data() const { return data_; }
 
  private:
@@ -15,30 +15,62 @@ PointerDataPacketConverter::PointerDataPacketConverter() : pointer_(0) {}
 PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
-    std::unique_ptr<PointerDataPacket> packet) {
-  size_t kBytesPerPointerData = kPointerDataFieldCount * kBytesPerField;
-  auto buffer = packet->data();
-  size_t buffer_length = buffer.size();
+    std::unique_ptr<PointerDataPacket> packet,
+    bool coalesce_moves) {
+  const size_t length = packet->GetLength();
 
   std::vector<PointerData> converted_pointers;
+  // Most pointers are converted to a single pointer, synthesized pointers
+  // are rare.
+  converted_pointers.reserve(length);
   // Converts each pointer data in the buffer and stores it in the
   // converted_pointers.
-  for (size_t i = 0; i < buffer_length / kBytesPerPointerData; i++) {
-    PointerData pointer_data;
-    memcpy(&pointer_data, &buffer[i * kBytesPerPointerData],
-           sizeof(PointerData));
-    ConvertPointerData(pointer_data, converted_pointers);
+  for (size_t i = 0; i < length; i++) {
+    ConvertPointerData(packet->GetPointerData(i), converted_pointers);
   }
 
-  // Writes converted_pointers into converted_packet.
-  auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
-  size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
-    converted_packet->SetPointerData(count++, converted_pointer);
+  if (coalesce_moves) {
+    CoalesceMoves(converted_pointers);
   }
 
-  return converted_packet;
+  // Writes converted_pointers into converted_packet in one go.
+  return std::make_unique<flutter::PointerDataPacket>(converted_pointers);
+}
+
+void PointerDataPacketConverter::CoalesceMoves(
+    std::vector<PointerData>& converted_pointers) {
+  // Maps a device to the index (in the coalesced output) of its last event if
+  // that event is a move that later moves may be merged into.
+  std::map<int64_t, size_t> last_moves;
+  size_t count = 0;
+  for (auto& pointer_data : converted_pointers) {
+    const bool is_move =
+        pointer_data.signal_kind == PointerData::SignalKind::kNone &&
+        (pointer_data.change == PointerData::Change::kMove ||
+         pointer_data.change == PointerData::Change::kHover);
+    if (!is_move) {
+      last_moves.erase(pointer_data.device);
+      converted_pointers[count++] = pointer_data;
+      continue;
+    }
+
+    auto last_move = last_moves.find(pointer_data.device);
+    if (last_move != last_moves.end()) {
+      PointerData& previous = converted_pointers[last_move->second];
+      if (previous.change == pointer_data.change &&
+          previous.kind == pointer_data.kind &&
+          previous.buttons == pointer_data.buttons &&
+          previous.pointer_identifier == pointer_data.pointer_identifier) {
+        pointer_data.physical_delta_x += previous.physical_delta_x;
+        pointer_data.physical_delta_y += previous.physical_delta_y;
+        previous = pointer_data;
+        continue;
+      }
+    }
+    last_moves[pointer_data.device] = count;
+    converted_pointers[count++] = pointer_data;
+  }
+  converted_pointers.resize(count);
 }
 
 void PointerDataPacketConverter::ConvertPointerData(
@@ -74,6 +74,14 @@ class PointerDataPacketConverter {
   ///
   /// @param[in]  packet                   The raw pointer packet sent from
   ///                                      embedding.
+  /// @param[in]  coalesce_moves           Whether consecutive move (or
+  ///                                      hover) events of the same device
+  ///                                      are merged into a single event
+  ///                                      with the latest position and the
+  ///                                      combined delta. This is useful
+  ///                                      for packets batching a frame's
+  ///                                      worth of events from high
+  ///                                      frequency input devices.
   ///
   /// @return     A full converted packet with all the required information
   /// filled.
@@ -81,7 +89,8 @@ class PointerDataPacketConverter {
   ///             converter's attempt to correct illegal pointer transitions.
   ///
   std::unique_ptr<PointerDataPacket> Convert(
-      std::unique_ptr<PointerDataPacket> packet);
+      std::unique_ptr<PointerDataPacket> packet,
+      bool coalesce_moves = false);
 
  private:
   std::map<int64_t, PointerState> states_;
@@ -102,6 +111,8 @@ class PointerDataPacketConverter {
   bool LocationNeedsUpdate(const PointerData pointer_data,
                            const PointerState state);
 
+  static void CoalesceMoves(std::vector<PointerData>& converted_pointers);
+
   FML_DISALLOW_COPY_AND_ASSIGN(PointerDataPacketConverter);
 };
 
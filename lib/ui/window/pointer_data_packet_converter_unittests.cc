@@ -573,5 +573,92 @@ TEST(PointerDataPacketConverterTest, CanConvetScroll) {
   ASSERT_EQ(result[6].scroll_delta_y, 0.0);
 }
 
+TEST(PointerDataPacketConverterTest, CanCoalesceMovesPerDevice) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(9);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 1, 10.0, 0.0);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 1.0, 0.0);
+  packet->SetPointerData(2, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 1, 11.0, 0.0);
+  packet->SetPointerData(3, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 3.0, 2.0);
+  packet->SetPointerData(4, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 6.0, 4.0);
+  packet->SetPointerData(5, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kUp, 0, 6.0, 4.0);
+  packet->SetPointerData(6, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 1, 12.0, 0.0);
+  packet->SetPointerData(7, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 1, 13.0, 1.0);
+  packet->SetPointerData(8, data);
+  auto converted_packet = converter.Convert(std::move(packet), true);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result.size(), (size_t)7);
+  ASSERT_EQ(result[0].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[1].change, PointerData::Change::kDown);
+  ASSERT_EQ(result[2].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[3].change, PointerData::Change::kDown);
+
+  // The three moves of device 0 before its up are merged.
+  ASSERT_EQ(result[4].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[4].device, 0);
+  ASSERT_EQ(result[4].physical_x, 6.0);
+  ASSERT_EQ(result[4].physical_y, 4.0);
+  ASSERT_EQ(result[4].physical_delta_x, 6.0);
+  ASSERT_EQ(result[4].physical_delta_y, 4.0);
+
+  // The moves of device 1 are merged across the events of device 0.
+  ASSERT_EQ(result[5].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[5].device, 1);
+  ASSERT_EQ(result[5].physical_x, 13.0);
+  ASSERT_EQ(result[5].physical_y, 1.0);
+  ASSERT_EQ(result[5].physical_delta_x, 3.0);
+  ASSERT_EQ(result[5].physical_delta_y, 1.0);
+
+  ASSERT_EQ(result[6].change, PointerData::Change::kUp);
+  ASSERT_EQ(result[6].device, 0);
+}
+
+TEST(PointerDataPacketConverterTest, DoesNotCoalesceMovesByDefault) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(3);
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 1.0, 0.0);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, 0, 2.0, 0.0);
+  packet->SetPointerData(2, data);
+  auto converted_packet = converter.Convert(std::move(packet));
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result.size(), (size_t)4);
+  ASSERT_EQ(result[2].change, PointerData::Change::kMove);
+  ASSERT_EQ(result[3].change, PointerData::Change::kMove);
+}
+
+TEST(PointerDataPacketTest, CanBeCreatedFromPointerData) {
+  std::vector<PointerData> data(2);
+  CreateSimulatedPointerData(data[0], PointerData::Change::kAdd, 0, 1.0, 2.0);
+  CreateSimulatedPointerData(data[1], PointerData::Change::kDown, 0, 3.0, 4.0);
+
+  PointerDataPacket packet(data);
+  ASSERT_EQ(packet.GetLength(), 2u);
+  ASSERT_EQ(packet.data().size(), 2 * sizeof(PointerData));
+  ASSERT_EQ(packet.GetPointerData(0).change, PointerData::Change::kAdd);
+  ASSERT_EQ(packet.GetPointerData(1).change, PointerData::Change::kDown);
+  ASSERT_EQ(packet.GetPointerData(1).physical_x, 3.0);
+  ASSERT_EQ(packet.GetPointerData(1).physical_y, 4.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -204,6 +204,45 @@ class ClipRectLayer extends ContainerLayer {
   }
 }
 
+/// A layer that clips its child layers to a viewport and translates them by
+/// the negated scroll offset.
+///
+/// There is no raster thread to scroll ahead of the framework on the web, so
+/// the offset only changes with new scenes.
+class ScrollLayer extends ContainerLayer {
+  final ui.Rect _viewport;
+  final ui.Offset _offset;
+
+  ScrollLayer(this._viewport, this._offset);
+
+  @override
+  void preroll(PrerollContext context, Matrix4 matrix) {
+    final Matrix4 translation =
+        Matrix4.translationValues(-_offset.dx, -_offset.dy, 0.0);
+    context.mutatorsStack.pushClipRect(_viewport);
+    context.mutatorsStack.pushTransform(translation);
+    final ui.Rect childPaintBounds =
+        prerollChildren(context, matrix * translation).shift(-_offset);
+    if (childPaintBounds.overlaps(_viewport)) {
+      paintBounds = childPaintBounds.intersect(_viewport);
+    }
+    context.mutatorsStack.pop();
+    context.mutatorsStack.pop();
+  }
+
+  @override
+  void paint(PaintContext paintContext) {
+    assert(needsPainting);
+
+    paintContext.internalNodesCanvas.save();
+    paintContext.internalNodesCanvas
+        .clipRect(_viewport, ui.ClipOp.intersect, false);
+    paintContext.internalNodesCanvas.translate(-_offset.dx, -_offset.dy);
+    paintChildren(paintContext);
+    paintContext.internalNodesCanvas.restore();
+  }
+}
+
 /// A layer that clips its child layers by a given [RRect].
 class ClipRRectLayer extends ContainerLayer {
   /// The rounded rectangle used to clip child layers.
@@ -248,6 +287,16 @@ class OpacityLayer extends ContainerLayer implements ui.OpacityEngineLayer {
 
   OpacityLayer(this._alpha, this._offset);
 
+  // Scenes are rasterized as soon as they are rendered on the web, so there
+  // is never a pending scene to patch.
+  @override
+  void latchAlpha(int alpha) {}
+
+  // There is no raster thread to advance animations without new scenes.
+  @override
+  void animateAlpha(int begin, int end, Duration duration,
+      {ui.LayerAnimationCurve curve = ui.LayerAnimationCurve.linear}) {}
+
   @override
   void preroll(PrerollContext context, Matrix4 matrix) {
     final Matrix4 childMatrix = Matrix4.copy(matrix);
@@ -289,6 +338,19 @@ class TransformLayer extends ContainerLayer
 
   TransformLayer(this._transform);
 
+  // Scenes are rasterized as soon as they are rendered on the web, so there
+  // is never a pending scene to patch.
+  @override
+  void latchTransform(Float64List matrix4) {}
+
+  @override
+  void latchOffset(double dx, double dy) {}
+
+  // There is no raster thread to advance animations without new scenes.
+  @override
+  void animateTransform(Float64List begin, Float64List end, Duration duration,
+      {ui.LayerAnimationCurve curve = ui.LayerAnimationCurve.linear}) {}
+
   @override
   void preroll(PrerollContext context, Matrix4 matrix) {
     final Matrix4 childMatrix = matrix * _transform;
@@ -351,6 +413,13 @@ class ImageFilterLayer extends ContainerLayer implements ui.OpacityEngineLayer {
 
   final ui.ImageFilter _filter;
 
+  @override
+  void latchAlpha(int alpha) {}
+
+  @override
+  void animateAlpha(int begin, int end, Duration duration,
+      {ui.LayerAnimationCurve curve = ui.LayerAnimationCurve.linear}) {}
+
   @override
   void paint(PaintContext paintContext) {
     assert(needsPainting);
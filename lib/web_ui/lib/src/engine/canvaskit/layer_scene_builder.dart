@@ -136,6 +136,18 @@ class LayerSceneBuilder implements ui.SceneBuilder {
     return null;
   }
 
+  @override
+  ui.ScrollEngineLayer? pushScroll(
+    ui.Rect viewport,
+    ui.Offset offset, {
+    required int scrollId,
+    required ui.Rect offsetRange,
+    ui.ScrollEngineLayer? oldLayer,
+  }) {
+    pushLayer(ScrollLayer(viewport, offset));
+    return null;
+  }
+
   @override
   ui.ColorFilterEngineLayer pushColorFilter(
     ui.ColorFilter filter, {
@@ -111,6 +111,18 @@ class CkContourMeasure extends ManagedSkiaObject<SkContourMeasure> implements ui
     );
   }
 
+  @override
+  Float32List getTangentsForOffsets(Float32List distances) {
+    return tangentsForOffsets(this, distances);
+  }
+
+  @override
+  ui.Path extractPathSegments(Float32List intervals,
+      {bool startWithMoveTo = true}) {
+    return pathSegmentsForIntervals(this, intervals,
+        startWithMoveTo: startWithMoveTo);
+  }
+
   @override
   bool get isClosed {
     return skiaObject.isClosed();
@@ -672,6 +672,13 @@ class CkParagraphBuilder implements ui.ParagraphBuilder {
     return CkParagraph(builtParagraph, _style, _commands);
   }
 
+  @override
+  Future<ui.Paragraph> buildAndLayout(ui.ParagraphConstraints constraints) {
+    final ui.Paragraph paragraph = build();
+    paragraph.layout(constraints);
+    return Future<ui.Paragraph>.value(paragraph);
+  }
+
   /// Builds the CkParagraph with the builder and deletes the builder.
   SkParagraph _buildCkParagraph() {
     final SkParagraph result = _paragraphBuilder.build();
@@ -73,6 +73,11 @@ class PersistedClipRect extends PersistedContainerSurface
   final ui.Clip? clipBehavior;
   final ui.Rect rect;
 
+  // Scenes are rasterized as soon as they are rendered on the web, so there
+  // is never a pending scene to patch.
+  @override
+  void latchClipRect(ui.Rect rect) {}
+
   @override
   void recomputeTransformAndClip() {
     _transform = parent!._transform;
@@ -115,6 +120,68 @@ class PersistedClipRect extends PersistedContainerSurface
   bool get isClipping => true;
 }
 
+/// A surface that clips its children to a viewport and translates them by the
+/// negated scroll offset.
+///
+/// There is no raster thread to scroll ahead of the framework on the web, so
+/// the offset only changes with new scenes.
+class PersistedScroll extends PersistedContainerSurface
+    with _DomClip
+    implements ui.ScrollEngineLayer {
+  PersistedScroll(PersistedScroll? oldLayer, this.viewport, this.offset)
+      : super(oldLayer);
+  final ui.Rect viewport;
+  final ui.Offset offset;
+
+  @override
+  void recomputeTransformAndClip() {
+    _transform = parent!._transform;
+    if (offset != ui.Offset.zero) {
+      _transform = _transform!.clone();
+      _transform!.translate(-offset.dx, -offset.dy);
+    }
+    // The clip is in the scrolled coordinates of the children.
+    _localClipBounds = viewport.shift(offset);
+    _localTransformInverse = null;
+    _projectedClip = null;
+  }
+
+  @override
+  Matrix4 get localTransformInverse => _localTransformInverse ??=
+      Matrix4.translationValues(offset.dx, offset.dy, 0);
+
+  @override
+  html.Element createElement() {
+    return super.createElement()..setAttribute('clip-type', 'scroll');
+  }
+
+  @override
+  void apply() {
+    rootElement!.style
+      ..left = '${viewport.left}px'
+      ..top = '${viewport.top}px'
+      ..width = '${viewport.width}px'
+      ..height = '${viewport.height}px';
+    applyOverflow(rootElement!, ui.Clip.hardEdge);
+
+    // Compensate for the translation of the rootElement, and scroll.
+    childContainer!.style
+      ..left = '${-viewport.left - offset.dx}px'
+      ..top = '${-viewport.top - offset.dy}px';
+  }
+
+  @override
+  void update(PersistedScroll oldSurface) {
+    super.update(oldSurface);
+    if (viewport != oldSurface.viewport || offset != oldSurface.offset) {
+      apply();
+    }
+  }
+
+  @override
+  bool get isClipping => true;
+}
+
 /// A surface that creates a rounded rectangular clip.
 class PersistedClipRRect extends PersistedContainerSurface
     with _DomClip
@@ -126,6 +193,11 @@ class PersistedClipRRect extends PersistedContainerSurface
   // TODO(yjbanov): can this be controlled in the browser?
   final ui.Clip? clipBehavior;
 
+  // Scenes are rasterized as soon as they are rendered on the web, so there
+  // is never a pending scene to patch.
+  @override
+  void latchClipRRect(ui.RRect rrect) {}
+
   @override
   void recomputeTransformAndClip() {
     _transform = parent!._transform;
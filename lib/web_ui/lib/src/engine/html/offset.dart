@@ -16,6 +16,11 @@ class PersistedOffset extends PersistedContainerSurface
   /// Vertical displacement.
   final double dy;
 
+  // Scenes are rasterized as soon as they are rendered on the web, so there
+  // is never a pending scene to patch.
+  @override
+  void latchOffset(double dx, double dy) {}
+
   @override
   void recomputeTransformAndClip() {
     _transform = parent!._transform;
@@ -14,6 +14,16 @@ class PersistedOpacity extends PersistedContainerSurface
   final int alpha;
   final ui.Offset offset;
 
+  // Scenes are rasterized as soon as they are rendered on the web, so there
+  // is never a pending scene to patch.
+  @override
+  void latchAlpha(int alpha) {}
+
+  // There is no raster thread to advance animations without new scenes.
+  @override
+  void animateAlpha(int begin, int end, Duration duration,
+      {ui.LayerAnimationCurve curve = ui.LayerAnimationCurve.linear}) {}
+
   @override
   void recomputeTransformAndClip() {
     _transform = parent!._transform;
@@ -574,6 +574,11 @@ class SurfacePathMetric implements ui.PathMetric {
     return _measure.getTangentForOffset(contourIndex, distance);
   }
 
+  @override
+  Float32List getTangentsForOffsets(Float32List distances) {
+    return tangentsForOffsets(this, distances);
+  }
+
   /// Given a start and end distance, return the intervening segment(s).
   ///
   /// `start` and `end` are pinned to legal values (0..[length])
@@ -583,10 +588,50 @@ class SurfacePathMetric implements ui.PathMetric {
         startWithMoveTo: startWithMoveTo);
   }
 
+  @override
+  ui.Path extractPathSegments(Float32List intervals,
+      {bool startWithMoveTo = true}) {
+    return pathSegmentsForIntervals(this, intervals,
+        startWithMoveTo: startWithMoveTo);
+  }
+
   @override
   String toString() => 'PathMetric';
 }
 
+/// Implements [ui.PathMetric.getTangentsForOffsets] with one call to
+/// [ui.PathMetric.getTangentForOffset] per distance.
+Float32List tangentsForOffsets(ui.PathMetric metric, Float32List distances) {
+  final Float32List posTans = Float32List(distances.length * 4);
+  for (int i = 0; i < distances.length; i++) {
+    final ui.Tangent? tangent = metric.getTangentForOffset(distances[i]);
+    posTans[i * 4] = tangent?.position.dx ?? double.nan;
+    posTans[i * 4 + 1] = tangent?.position.dy ?? double.nan;
+    posTans[i * 4 + 2] = tangent?.vector.dx ?? double.nan;
+    posTans[i * 4 + 3] = tangent?.vector.dy ?? double.nan;
+  }
+  return posTans;
+}
+
+/// Implements [ui.PathMetric.extractPathSegments] with one call to
+/// [ui.PathMetric.extractPath] per interval.
+ui.Path pathSegmentsForIntervals(ui.PathMetric metric, Float32List intervals,
+    {required bool startWithMoveTo}) {
+  assert(intervals.length.isEven,
+      'Intervals must hold pairs of start and end distances.');
+  final ui.Path path = ui.Path();
+  for (int i = 0; i + 1 < intervals.length; i += 2) {
+    final ui.Path segment = metric.extractPath(intervals[i], intervals[i + 1],
+        startWithMoveTo: startWithMoveTo);
+    if (startWithMoveTo) {
+      path.addPath(segment, ui.Offset.zero);
+    } else {
+      path.extendWithPath(segment, ui.Offset.zero);
+    }
+  }
+  return path;
+}
+
 // Given a vector dx, dy representing slope, normalize and return as [ui.Offset].
 ui.Offset _normalizeSlope(double dx, double dy) {
   final double length = math.sqrt(dx * dx + dy * dy);
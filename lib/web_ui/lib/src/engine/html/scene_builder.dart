@@ -116,6 +116,24 @@ class SurfaceSceneBuilder implements ui.SceneBuilder {
     return _pushSurface<PersistedClipRect>(PersistedClipRect(oldLayer as PersistedClipRect?, rect, clipBehavior));
   }
 
+  /// Pushes a scroll operation onto the operation stack.
+  ///
+  /// The children are clipped to [viewport] and translated by the negated
+  /// [offset].
+  ///
+  /// See [pop] for details about the operation stack.
+  @override
+  ui.ScrollEngineLayer pushScroll(
+    ui.Rect viewport,
+    ui.Offset offset, {
+    required int scrollId,
+    required ui.Rect offsetRange,
+    ui.ScrollEngineLayer? oldLayer,
+  }) {
+    return _pushSurface<PersistedScroll>(
+        PersistedScroll(oldLayer as PersistedScroll?, viewport, offset));
+  }
+
   /// Pushes a rounded-rectangular clip operation onto the operation stack.
   ///
   /// Rasterization outside the given rounded rectangle is discarded.
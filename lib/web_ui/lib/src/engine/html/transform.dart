@@ -13,6 +13,16 @@ class PersistedTransform extends PersistedContainerSurface
 
   final Float32List matrix4;
 
+  // Scenes are rasterized as soon as they are rendered on the web, so there
+  // is never a pending scene to patch.
+  @override
+  void latchTransform(Float64List matrix4) {}
+
+  // There is no raster thread to advance animations without new scenes.
+  @override
+  void animateTransform(Float64List begin, Float64List end, Duration duration,
+      {ui.LayerAnimationCurve curve = ui.LayerAnimationCurve.linear}) {}
+
   @override
   void recomputeTransformAndClip() {
     _transform = parent!._transform!.multiplied(Matrix4.fromFloat32List(matrix4));
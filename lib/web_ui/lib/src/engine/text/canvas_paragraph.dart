@@ -591,4 +591,11 @@ class CanvasParagraphBuilder implements ui.ParagraphBuilder {
       placeholderCount: _placeholderCount,
     );
   }
+
+  @override
+  Future<ui.Paragraph> buildAndLayout(ui.ParagraphConstraints constraints) {
+    final ui.Paragraph paragraph = build();
+    paragraph.layout(constraints);
+    return Future<ui.Paragraph>.value(paragraph);
+  }
 }
@@ -1311,6 +1311,13 @@ class DomParagraphBuilder implements ui.ParagraphBuilder {
     return _tryBuildPlainText() ?? _buildRichText();
   }
 
+  @override
+  Future<ui.Paragraph> buildAndLayout(ui.ParagraphConstraints constraints) {
+    final ui.Paragraph paragraph = build();
+    paragraph.layout(constraints);
+    return Future<ui.Paragraph>.value(paragraph);
+  }
+
   /// Attempts to build a [Paragraph] assuming it is plain text.
   ///
   /// A paragraph is considered plain if it is built using the following
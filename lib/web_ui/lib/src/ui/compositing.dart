@@ -10,17 +10,40 @@ abstract class Scene {
   void dispose();
 }
 
-abstract class TransformEngineLayer implements EngineLayer {}
+enum LayerAnimationCurve {
+  linear,
+  easeIn,
+  easeOut,
+  easeInOut,
+}
 
-abstract class OffsetEngineLayer implements EngineLayer {}
+abstract class TransformEngineLayer implements EngineLayer {
+  void latchTransform(Float64List matrix4);
+  void animateTransform(Float64List begin, Float64List end, Duration duration,
+      {LayerAnimationCurve curve = LayerAnimationCurve.linear});
+}
 
-abstract class ClipRectEngineLayer implements EngineLayer {}
+abstract class OffsetEngineLayer implements EngineLayer {
+  void latchOffset(double dx, double dy);
+}
 
-abstract class ClipRRectEngineLayer implements EngineLayer {}
+abstract class ClipRectEngineLayer implements EngineLayer {
+  void latchClipRect(Rect rect);
+}
+
+abstract class ClipRRectEngineLayer implements EngineLayer {
+  void latchClipRRect(RRect rrect);
+}
 
 abstract class ClipPathEngineLayer implements EngineLayer {}
 
-abstract class OpacityEngineLayer implements EngineLayer {}
+abstract class ScrollEngineLayer implements EngineLayer {}
+
+abstract class OpacityEngineLayer implements EngineLayer {
+  void latchAlpha(int alpha);
+  void animateAlpha(int begin, int end, Duration duration,
+      {LayerAnimationCurve curve = LayerAnimationCurve.linear});
+}
 
 abstract class ColorFilterEngineLayer implements EngineLayer {}
 
@@ -64,6 +87,13 @@ abstract class SceneBuilder {
     Clip clipBehavior = Clip.antiAlias,
     ClipPathEngineLayer? oldLayer,
   });
+  ScrollEngineLayer? pushScroll(
+    Rect viewport,
+    Offset offset, {
+    required int scrollId,
+    required Rect offsetRange,
+    ScrollEngineLayer? oldLayer,
+  });
   OpacityEngineLayer? pushOpacity(
     int alpha, {
     Offset offset = Offset.zero,
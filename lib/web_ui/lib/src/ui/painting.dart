@@ -337,6 +337,11 @@ abstract class Image {
 
   List<StackTrace>? debugGetOpenHandleStackTraces() => null;
 
+  int transfer() => throw UnsupportedError('Image.transfer is not supported on the web.');
+
+  static Image fromTransferToken(int token) =>
+      throw UnsupportedError('Image.fromTransferToken is not supported on the web.');
+
   @override
   String toString() => '[$width\u00D7$height]';
 }
@@ -717,9 +722,19 @@ class ImmutableBuffer {
     return instance;
   }
 
+  static Future<ImmutableBuffer> fromAsset(String assetKey) async {
+    final ByteData data = await _assetManager!.load(assetKey);
+    return fromUint8List(data.buffer.asUint8List(data.offsetInBytes, data.lengthInBytes));
+  }
+
+  static ImmutableBuffer fromTransferToken(int token) =>
+      throw UnsupportedError('ImmutableBuffer.fromTransferToken is not supported on the web.');
+
   Uint8List? _list;
   final int length;
   void dispose() => _list = null;
+
+  int transfer() => throw UnsupportedError('ImmutableBuffer.transfer is not supported on the web.');
 }
 
 class ImageDescriptor {
@@ -734,6 +749,8 @@ class ImageDescriptor {
     return descriptor;
   }
 
+  static Size? probeEncodedSize(ImmutableBuffer buffer) => null;
+
   // Not async because there's no expensive work to do here.
   ImageDescriptor.raw(
     ImmutableBuffer buffer, {
@@ -779,3 +796,35 @@ class ImageDescriptor {
     return await _createBmp(_data!, width, height, _rowBytes ?? width, _format!);
   }
 }
+
+class IncrementalImageDecoder {
+  IncrementalImageDecoder();
+
+  final List<int> _bytes = <int>[];
+  bool _closed = false;
+  bool _isComplete = false;
+
+  void addBytes(Uint8List bytes) {
+    if (!_closed) {
+      _bytes.addAll(bytes);
+    }
+  }
+
+  void close() => _closed = true;
+
+  bool get isComplete => _isComplete;
+
+  // The browser only decodes complete images.
+  Future<Image?> decode() async {
+    if (!_closed) {
+      return null;
+    }
+    final Codec codec = await instantiateImageCodec(Uint8List.fromList(_bytes));
+    final FrameInfo frame = await codec.getNextFrame();
+    codec.dispose();
+    _isComplete = true;
+    return frame.image;
+  }
+
+  void dispose() => _bytes.clear();
+}
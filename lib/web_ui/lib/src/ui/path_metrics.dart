@@ -22,7 +22,9 @@ abstract class PathMetric {
   double get length;
   int get contourIndex;
   Tangent? getTangentForOffset(double distance);
+  Float32List getTangentsForOffsets(Float32List distances);
   Path extractPath(double start, double end, {bool startWithMoveTo = true});
+  Path extractPathSegments(Float32List intervals, {bool startWithMoveTo = true});
   bool get isClosed;
 }
 
@@ -54,6 +54,9 @@ abstract class PlatformDispatcher {
 
   void scheduleFrame();
 
+  // Browsers pick the refresh rate, so the request is ignored.
+  void setPreferredFrameRate(double framesPerSecond) {}
+
   void render(Scene scene, [FlutterView view]);
 
   AccessibilityFeatures get accessibilityFeatures;
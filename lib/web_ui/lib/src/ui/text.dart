@@ -595,6 +595,7 @@ abstract class ParagraphBuilder {
   void pop();
   void addText(String text);
   Paragraph build();
+  Future<Paragraph> buildAndLayout(ParagraphConstraints constraints);
   int get placeholderCount;
   List<double> get placeholderScales;
   void addPlaceholder(
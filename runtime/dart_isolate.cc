@@ -90,7 +90,8 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     const fml::closure& isolate_shutdown_callback,
     std::optional<std::string> dart_entrypoint,
     std::optional<std::string> dart_entrypoint_library,
-    std::unique_ptr<IsolateConfiguration> isolate_configration) {
+    std::unique_ptr<IsolateConfiguration> isolate_configration,
+    DartIsolate* spawning_isolate) {
   if (!isolate_snapshot) {
     FML_LOG(ERROR) << "Invalid isolate snapshot.";
     return {};
@@ -117,7 +118,8 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
                                    advisory_script_entrypoint,         //
                                    isolate_flags,                      //
                                    isolate_create_callback,            //
-                                   isolate_shutdown_callback           //
+                                   isolate_shutdown_callback,          //
+                                   spawning_isolate                    //
                                    )
                      .lock();
 
@@ -137,7 +139,16 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     return {};
   }
 
-  if (!isolate_configration->PrepareIsolate(*isolate.get())) {
+  if (spawning_isolate) {
+    // The program was already loaded into the isolate group, so the isolate
+    // is prepared the same way as the children of the spawning isolate.
+    const auto& child_isolate_preparer =
+        isolate->GetIsolateGroupData().GetChildIsolatePreparer();
+    if (!child_isolate_preparer || !child_isolate_preparer(isolate.get())) {
+      FML_LOG(ERROR) << "Could not prepare spawned isolate.";
+      return {};
+    }
+  } else if (!isolate_configration->PrepareIsolate(*isolate.get())) {
     FML_LOG(ERROR) << "Could not prepare isolate.";
     return {};
   }
@@ -187,23 +198,10 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRootIsolate(
     std::string advisory_script_entrypoint,
     Flags flags,
     const fml::closure& isolate_create_callback,
-    const fml::closure& isolate_shutdown_callback) {
+    const fml::closure& isolate_shutdown_callback,
+    DartIsolate* spawning_isolate) {
   TRACE_EVENT0("flutter", "DartIsolate::CreateRootIsolate");
 
-  // The child isolate preparer is null but will be set when the isolate is
-  // being prepared to run.
-  auto isolate_group_data =
-      std::make_unique<std::shared_ptr<DartIsolateGroupData>>(
-          std::shared_ptr<DartIsolateGroupData>(new DartIsolateGroupData(
-              settings,                     // settings
-              std::move(isolate_snapshot),  // isolate snapshot
-              advisory_script_uri,          // advisory URI
-              advisory_script_entrypoint,   // advisory entrypoint
-              nullptr,                      // child isolate preparer
-              isolate_create_callback,      // isolate create callback
-              isolate_shutdown_callback     // isolate shutdown callback
-              )));
-
   auto isolate_data = std::make_unique<std::shared_ptr<DartIsolate>>(
       std::shared_ptr<DartIsolate>(new DartIsolate(
           settings,                        // settings
@@ -219,13 +217,35 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRootIsolate(
           )));
 
   DartErrorString error;
-  auto isolate_flags = flags.Get();
-  Dart_Isolate vm_isolate = CreateDartIsolateGroup(
-      std::move(isolate_group_data), std::move(isolate_data), &isolate_flags,
-      error.error());
-
-  if (error) {
-    FML_LOG(ERROR) << "CreateDartIsolateGroup failed: " << error.str();
+  Dart_Isolate vm_isolate = nullptr;
+  if (spawning_isolate) {
+    vm_isolate = CreateDartIsolateInGroup(
+        *spawning_isolate, std::move(isolate_data), error.error());
+    if (error) {
+      FML_LOG(ERROR) << "CreateDartIsolateInGroup failed: " << error.str();
+    }
+  } else {
+    // The child isolate preparer is null but will be set when the isolate is
+    // being prepared to run.
+    auto isolate_group_data =
+        std::make_unique<std::shared_ptr<DartIsolateGroupData>>(
+            std::shared_ptr<DartIsolateGroupData>(new DartIsolateGroupData(
+                settings,                     // settings
+                std::move(isolate_snapshot),  // isolate snapshot
+                advisory_script_uri,          // advisory URI
+                advisory_script_entrypoint,   // advisory entrypoint
+                nullptr,                      // child isolate preparer
+                isolate_create_callback,      // isolate create callback
+                isolate_shutdown_callback     // isolate shutdown callback
+                )));
+
+    auto isolate_flags = flags.Get();
+    vm_isolate = CreateDartIsolateGroup(std::move(isolate_group_data),
+                                        std::move(isolate_data),
+                                        &isolate_flags, error.error());
+    if (error) {
+      FML_LOG(ERROR) << "CreateDartIsolateGroup failed: " << error.str();
+    }
   }
 
   if (vm_isolate == nullptr) {
@@ -238,6 +258,11 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRootIsolate(
   (*root_isolate_data)
       ->SetPlatformConfiguration(std::move(platform_configuration));
 
+  // Isolates spawned by the root isolate paint with its resources.
+  (*root_isolate_data)
+      ->GetIsolateGroupData()
+      .SetPaintingContext((*root_isolate_data)->GetPaintingContext());
+
   return (*root_isolate_data)->GetWeakIsolatePtr();
 }
 
@@ -264,7 +289,11 @@ DartIsolate::DartIsolate(const Settings& settings,
                   settings.log_tag,
                   settings.unhandled_exception_callback,
                   DartVMRef::GetIsolateNameServer(),
-                  is_root_isolate),
+                  is_root_isolate,
+                  settings.enable_display_list,
+                  settings.downsampled_blur_min_sigma,
+                  settings.downsampled_blur_max_factor,
+                  settings.enable_skparagraph),
       may_insecurely_connect_to_all_domains_(
           settings.may_insecurely_connect_to_all_domains),
       domain_network_policy_(settings.domain_network_policy) {
@@ -320,6 +349,10 @@ bool DartIsolate::Initialize(Dart_Isolate dart_isolate) {
     return false;
   }
 
+  if (tonic::LogIfError(Dart_SetDeferredLoadHandler(OnDartLoadLibrary))) {
+    return false;
+  }
+
   if (!UpdateThreadPoolNames()) {
     return false;
   }
@@ -394,7 +427,11 @@ bool DartIsolate::LoadLibraries() {
   DartIO::InitForIsolate(may_insecurely_connect_to_all_domains_,
                          domain_network_policy_);
 
-  DartUI::InitForIsolate();
+  // Native resolvers are set on libraries, which all isolates of a group
+  // share.
+  if (!shares_isolate_group_program_) {
+    DartUI::InitForIsolate();
+  }
 
   const bool is_service_isolate = Dart_IsServiceIsolate(isolate());
 
@@ -442,6 +479,43 @@ bool DartIsolate::PrepareForRunningFromPrecompiledCode() {
   return true;
 }
 
+bool DartIsolate::LoadLoadingUnit(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  TRACE_EVENT1("flutter", "DartIsolate::LoadLoadingUnit", "loading_unit_id",
+               std::to_string(loading_unit_id).c_str());
+  tonic::DartState::Scope scope(this);
+
+  fml::RefPtr<DartSnapshot> dart_snapshot =
+      DartSnapshot::IsolateSnapshotFromMappings(
+          std::move(snapshot_data), std::move(snapshot_instructions));
+  if (!dart_snapshot || !dart_snapshot->IsValidForAOT()) {
+    Dart_DeferredLoadCompleteError(loading_unit_id,
+                                   "Invalid loading unit snapshot.",
+                                   /*transient=*/false);
+    return false;
+  }
+
+  Dart_Handle result = Dart_DeferredLoadComplete(
+      loading_unit_id, dart_snapshot->GetDataMapping(),
+      dart_snapshot->GetInstructionsMapping());
+  if (tonic::LogIfError(result)) {
+    return false;
+  }
+  loading_unit_snapshots_.insert(dart_snapshot);
+  return true;
+}
+
+void DartIsolate::LoadLoadingUnitError(intptr_t loading_unit_id,
+                                       const std::string& error_message,
+                                       bool transient) {
+  tonic::DartState::Scope scope(this);
+  Dart_Handle result = Dart_DeferredLoadCompleteError(
+      loading_unit_id, error_message.c_str(), transient);
+  tonic::LogIfError(result);
+}
+
 bool DartIsolate::LoadKernel(std::shared_ptr<const fml::Mapping> mapping,
                              bool last_piece) {
   if (!Dart_IsKernel(mapping->GetMapping(), mapping->GetSize())) {
@@ -487,11 +561,18 @@ bool DartIsolate::LoadKernel(std::shared_ptr<const fml::Mapping> mapping,
 
   tonic::DartState::Scope scope(this);
 
-  // Use root library provided by kernel in favor of one provided by snapshot.
-  Dart_SetRootLibrary(Dart_Null());
+  if (shares_isolate_group_program_) {
+    // The group already loaded the kernel, which would only be loaded again.
+    // Keep the mapping alive for as long as this isolate anyway.
+    kernel_buffers_.push_back(std::move(mapping));
+  } else {
+    // Use root library provided by kernel in favor of one provided by
+    // snapshot.
+    Dart_SetRootLibrary(Dart_Null());
 
-  if (!LoadKernel(mapping, last_piece)) {
-    return false;
+    if (!LoadKernel(mapping, last_piece)) {
+      return false;
+    }
   }
 
   if (!last_piece) {
@@ -689,6 +770,18 @@ Dart_Isolate DartIsolate::DartCreateAndStartServiceIsolate(
     return nullptr;
   }
 
+  // The VM creates the service isolate on a thread of its own, so waiting
+  // here does not hold up the launch of the VM or of the root isolate. The
+  // timeline is recorded by the VM in the meantime.
+  if (settings.defer_service_isolate_startup) {
+    TRACE_EVENT0("flutter", "WaitForDeferredServiceIsolateStartup");
+    if (!DartServiceIsolate::WaitForDeferredStartup()) {
+      *error = fml::strdup(
+          "The VM shut down before the deferred service isolate started.");
+      return nullptr;
+    }
+  }
+
   TaskRunners null_task_runners("io.flutter." DART_VM_SERVICE_ISOLATE_NAME,
                                 nullptr, nullptr, nullptr, nullptr);
 
@@ -805,6 +898,9 @@ Dart_Isolate DartIsolate::DartIsolateGroupCreateCallback(
               parent_group_data.GetChildIsolatePreparer(),
               parent_group_data.GetIsolateCreateCallback(),
               parent_group_data.GetIsolateShutdownCallback())));
+  const UIDartState::PaintingContext painting_context =
+      parent_group_data.GetPaintingContext();
+  (*isolate_group_data)->SetPaintingContext(painting_context);
 
   TaskRunners null_task_runners(advisory_script_uri,
                                 /* platform= */ nullptr,
@@ -819,11 +915,12 @@ Dart_Isolate DartIsolate::DartIsolateGroupCreateCallback(
           fml::WeakPtr<SnapshotDelegate>{},      // snapshot_delegate
           fml::WeakPtr<HintFreedDelegate>{},     // hint_freed_delegate
           fml::WeakPtr<IOManager>{},             // io_manager
-          fml::RefPtr<SkiaUnrefQueue>{},         // unref_queue
+          painting_context.unref_queue,          // unref_queue
           fml::WeakPtr<ImageDecoder>{},          // image_decoder
           advisory_script_uri,                   // advisory_script_uri
           advisory_script_entrypoint,            // advisory_script_entrypoint
           false)));                              // is_root_isolate
+  (*isolate_data)->SetFontCollection(painting_context.font_collection);
 
   Dart_Isolate vm_isolate = CreateDartIsolateGroup(
       std::move(isolate_group_data), std::move(isolate_data), flags, error);
@@ -835,6 +932,26 @@ Dart_Isolate DartIsolate::DartIsolateGroupCreateCallback(
   return vm_isolate;
 }
 
+// |Dart_DeferredLoadHandler|
+Dart_Handle DartIsolate::OnDartLoadLibrary(intptr_t loading_unit_id) {
+  TRACE_EVENT0("flutter", "DartIsolate::OnDartLoadLibrary");
+  auto* isolate_data =
+      static_cast<std::shared_ptr<DartIsolate>*>(Dart_CurrentIsolateData());
+  PlatformConfiguration* platform_configuration =
+      (*isolate_data)->platform_configuration();
+  if (platform_configuration == nullptr) {
+    const std::string error =
+        "Deferred loading units can only be loaded by the root isolate. "
+        "Loading unit " +
+        std::to_string(loading_unit_id) + " was requested by another isolate.";
+    return Dart_NewApiError(error.c_str());
+  }
+  // The loading unit is provided asynchronously by |LoadLoadingUnit| or
+  // |LoadLoadingUnitError|.
+  platform_configuration->client()->RequestDartDeferredLibrary(loading_unit_id);
+  return Dart_Null();
+}
+
 // |Dart_IsolateInitializeCallback|
 bool DartIsolate::DartIsolateInitializeCallback(void** child_callback_data,
                                                 char** error) {
@@ -855,6 +972,8 @@ bool DartIsolate::DartIsolateInitializeCallback(void** child_callback_data,
                                 /* raster= */ nullptr,
                                 /* ui= */ nullptr,
                                 /* io= */ nullptr);
+  const UIDartState::PaintingContext painting_context =
+      (*isolate_group_data)->GetPaintingContext();
 
   auto embedder_isolate = std::make_unique<std::shared_ptr<DartIsolate>>(
       std::shared_ptr<DartIsolate>(new DartIsolate(
@@ -863,12 +982,14 @@ bool DartIsolate::DartIsolateInitializeCallback(void** child_callback_data,
           fml::WeakPtr<SnapshotDelegate>{},               // snapshot_delegate
           fml::WeakPtr<HintFreedDelegate>{},              // hint_freed_delegate
           fml::WeakPtr<IOManager>{},                      // io_manager
-          fml::RefPtr<SkiaUnrefQueue>{},                  // unref_queue
+          painting_context.unref_queue,                   // unref_queue
           fml::WeakPtr<ImageDecoder>{},                   // image_decoder
           (*isolate_group_data)->GetAdvisoryScriptURI(),  // advisory_script_uri
           (*isolate_group_data)
               ->GetAdvisoryScriptEntrypoint(),  // advisory_script_entrypoint
           false)));                             // is_root_isolate
+  (*embedder_isolate)->SetFontCollection(painting_context.font_collection);
+  (*embedder_isolate)->shares_isolate_group_program_ = true;
 
   // root isolate should have been created via CreateRootIsolate
   if (!InitializeIsolate(*embedder_isolate, isolate, error)) {
@@ -914,6 +1035,38 @@ Dart_Isolate DartIsolate::CreateDartIsolateGroup(
   return isolate;
 }
 
+Dart_Isolate DartIsolate::CreateDartIsolateInGroup(
+    DartIsolate& spawning_isolate,
+    std::unique_ptr<std::shared_ptr<DartIsolate>> isolate_data,
+    char** error) {
+  TRACE_EVENT0("flutter", "DartIsolate::CreateDartIsolateInGroup");
+
+  // The new isolate shares the isolate group data (and so the snapshots,
+  // callbacks and child isolate preparer) of the spawning isolate.
+  Dart_Isolate isolate = Dart_CreateIsolateInGroup(
+      spawning_isolate.isolate(),
+      (*isolate_data)->GetAdvisoryScriptEntrypoint().c_str(),
+      reinterpret_cast<Dart_IsolateShutdownCallback>(
+          DartIsolate::DartIsolateShutdownCallback),
+      reinterpret_cast<Dart_IsolateCleanupCallback>(
+          DartIsolate::DartIsolateCleanupCallback),
+      isolate_data.get(), error);
+
+  if (isolate == nullptr) {
+    return nullptr;
+  }
+
+  // Ownership of the isolate data object has been transferred to the Dart VM.
+  std::shared_ptr<DartIsolate> embedder_isolate(*isolate_data);
+  isolate_data.release();
+
+  if (!InitializeIsolate(std::move(embedder_isolate), isolate, error)) {
+    return nullptr;
+  }
+
+  return isolate;
+}
+
 bool DartIsolate::InitializeIsolate(
     std::shared_ptr<DartIsolate> embedder_isolate,
     Dart_Isolate isolate,
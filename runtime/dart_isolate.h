@@ -205,6 +205,14 @@ class DartIsolate : public UIDartState {
   ///                                         for all isolate shutdowns
   ///                                         (including the children of the
   ///                                         root isolate).
+  /// @param[in]  spawning_isolate            If not null, the root isolate of
+  ///                                         another engine whose isolate group
+  ///                                         the new root isolate joins instead
+  ///                                         of forming its own. The isolates
+  ///                                         then share their heap, snapshots
+  ///                                         and group data, and the isolate
+  ///                                         configuration is only used to
+  ///                                         determine the null safety mode.
   ///
   /// @return     A weak pointer to the root Dart isolate. The caller must
   ///             ensure that the isolate is not referenced for long periods of
@@ -229,7 +237,8 @@ class DartIsolate : public UIDartState {
       const fml::closure& isolate_shutdown_callback,
       std::optional<std::string> dart_entrypoint,
       std::optional<std::string> dart_entrypoint_library,
-      std::unique_ptr<IsolateConfiguration> isolate_configration);
+      std::unique_ptr<IsolateConfiguration> isolate_configration,
+      DartIsolate* spawning_isolate = nullptr);
 
   // |UIDartState|
   ~DartIsolate() override;
@@ -384,6 +393,37 @@ class DartIsolate : public UIDartState {
   ///
   fml::RefPtr<fml::TaskRunner> GetMessageHandlingTaskRunner() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Completes a request of the Dart VM to load a deferred loading
+  ///             unit of the AOT program with its snapshot. The snapshot is
+  ///             kept alive for as long as the isolate.
+  ///
+  /// @param[in]  loading_unit_id        The loading unit requested by the VM.
+  /// @param[in]  snapshot_data          The heap snapshot of the loading unit.
+  /// @param[in]  snapshot_instructions  The instructions snapshot of the
+  ///                                    loading unit, mapped executable.
+  ///
+  /// @return     Whether the VM accepted the loading unit.
+  ///
+  bool LoadLoadingUnit(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fails a request of the Dart VM to load a deferred loading
+  ///             unit. The `loadLibrary` future in Dart completes with
+  ///             |error_message|.
+  ///
+  /// @param[in]  loading_unit_id  The loading unit requested by the VM.
+  /// @param[in]  error_message    Why the loading unit could not be loaded.
+  /// @param[in]  transient        Whether a later attempt may succeed, in
+  ///                              which case the VM allows loading it again.
+  ///
+  void LoadLoadingUnitError(intptr_t loading_unit_id,
+                            const std::string& error_message,
+                            bool transient);
+
  private:
   friend class IsolateConfiguration;
   class AutoFireClosure {
@@ -404,6 +444,12 @@ class DartIsolate : public UIDartState {
   fml::RefPtr<fml::TaskRunner> message_handling_task_runner_;
   const bool may_insecurely_connect_to_all_domains_;
   std::string domain_network_policy_;
+  // Whether the isolate was spawned into the group of a running isolate, with
+  // which it shares the loaded program and the native resolvers.
+  bool shares_isolate_group_program_ = false;
+  // The snapshots of the loaded deferred loading units, which must outlive
+  // the isolate.
+  std::set<fml::RefPtr<DartSnapshot>> loading_unit_snapshots_;
 
   static std::weak_ptr<DartIsolate> CreateRootIsolate(
       const Settings& settings,
@@ -419,7 +465,8 @@ class DartIsolate : public UIDartState {
       std::string advisory_script_entrypoint,
       Flags flags,
       const fml::closure& isolate_create_callback,
-      const fml::closure& isolate_shutdown_callback);
+      const fml::closure& isolate_shutdown_callback,
+      DartIsolate* spawning_isolate);
 
   DartIsolate(const Settings& settings,
               TaskRunners task_runners,
@@ -458,6 +505,9 @@ class DartIsolate : public UIDartState {
       std::shared_ptr<DartIsolate>* parent_isolate_group,
       char** error);
 
+  // |Dart_DeferredLoadHandler|
+  static Dart_Handle OnDartLoadLibrary(intptr_t loading_unit_id);
+
   // |Dart_IsolateInitializeCallback|
   static bool DartIsolateInitializeCallback(void** child_callback_data,
                                             char** error);
@@ -474,6 +524,11 @@ class DartIsolate : public UIDartState {
       Dart_IsolateFlags* flags,
       char** error);
 
+  static Dart_Isolate CreateDartIsolateInGroup(
+      DartIsolate& spawning_isolate,
+      std::unique_ptr<std::shared_ptr<DartIsolate>> isolate_data,
+      char** error);
+
   static bool InitializeIsolate(std::shared_ptr<DartIsolate> embedder_isolate,
                                 Dart_Isolate isolate,
                                 char** error);
@@ -64,4 +64,15 @@ void DartIsolateGroupData::SetChildIsolatePreparer(
   child_isolate_preparer_ = value;
 }
 
+UIDartState::PaintingContext DartIsolateGroupData::GetPaintingContext() const {
+  std::scoped_lock lock(painting_context_mutex_);
+  return painting_context_;
+}
+
+void DartIsolateGroupData::SetPaintingContext(
+    const UIDartState::PaintingContext& value) {
+  std::scoped_lock lock(painting_context_mutex_);
+  painting_context_ = value;
+}
+
 }  // namespace flutter
@@ -11,6 +11,7 @@
 #include "flutter/common/settings.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 
 namespace flutter {
 
@@ -53,6 +54,12 @@ class DartIsolateGroupData {
 
   void SetChildIsolatePreparer(const ChildIsolatePreparer& value);
 
+  // The painting context of the root isolate, which the other isolates of the
+  // group and the groups they spawn use to paint off-screen.
+  UIDartState::PaintingContext GetPaintingContext() const;
+
+  void SetPaintingContext(const UIDartState::PaintingContext& value);
+
  private:
   const Settings settings_;
   const fml::RefPtr<const DartSnapshot> isolate_snapshot_;
@@ -62,6 +69,8 @@ class DartIsolateGroupData {
   ChildIsolatePreparer child_isolate_preparer_;
   const fml::closure isolate_create_callback_;
   const fml::closure isolate_shutdown_callback_;
+  mutable std::mutex painting_context_mutex_;
+  UIDartState::PaintingContext painting_context_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DartIsolateGroupData);
 };
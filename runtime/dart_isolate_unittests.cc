@@ -4,10 +4,13 @@
 
 #include "flutter/runtime/dart_isolate.h"
 
+#include <atomic>
+
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/thread.h"
+#include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/runtime/isolate_configuration.h"
@@ -375,6 +378,33 @@ TEST_F(DartIsolateTest, CanCreateServiceIsolate) {
   ASSERT_TRUE(root_isolate->Shutdown());
 }
 
+TEST_F(DartIsolateTest, DeferredServiceIsolateStartsWhenResumed) {
+#if (FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_DEBUG) && \
+    (FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_PROFILE)
+  GTEST_SKIP();
+#endif
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  fml::AutoResetWaitableEvent service_isolate_latch;
+  std::atomic_bool service_isolate_created = false;
+  auto settings = CreateSettingsForFixture();
+  settings.enable_observatory = true;
+  settings.defer_service_isolate_startup = true;
+  settings.observatory_port = 0;
+  settings.observatory_host = "127.0.0.1";
+  settings.enable_service_port_fallback = true;
+  settings.service_isolate_create_callback = [&]() {
+    service_isolate_created = true;
+    service_isolate_latch.Signal();
+  };
+  auto vm_ref = DartVMRef::Create(settings);
+  ASSERT_TRUE(vm_ref);
+  ASSERT_FALSE(service_isolate_created);
+
+  DartServiceIsolate::ResumeDeferredStartup();
+  service_isolate_latch.Wait();
+  ASSERT_TRUE(service_isolate_created);
+}
+
 TEST_F(DartIsolateTest,
        RootIsolateCreateCallbackIsMadeOnceAndBeforeIsolateRunning) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
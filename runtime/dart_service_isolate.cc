@@ -54,6 +54,13 @@ std::mutex DartServiceIsolate::callbacks_mutex_;
 std::set<std::unique_ptr<DartServiceIsolate::ObservatoryServerStateCallback>>
     DartServiceIsolate::callbacks_;
 
+std::mutex DartServiceIsolate::startup_mutex_;
+
+std::condition_variable DartServiceIsolate::startup_cv_;
+
+DartServiceIsolate::StartupState DartServiceIsolate::startup_state_ =
+    DartServiceIsolate::StartupState::kResumed;
+
 void DartServiceIsolate::NotifyServerState(Dart_NativeArguments args) {
   Dart_Handle exception = nullptr;
   std::string uri =
@@ -126,6 +133,40 @@ void DartServiceIsolate::Shutdown(Dart_NativeArguments args) {
   // NO-OP.
 }
 
+void DartServiceIsolate::DeferStartup() {
+  std::scoped_lock lock(startup_mutex_);
+  startup_state_ = StartupState::kDeferred;
+}
+
+void DartServiceIsolate::ResumeDeferredStartup() {
+  {
+    std::scoped_lock lock(startup_mutex_);
+    if (startup_state_ != StartupState::kDeferred) {
+      return;
+    }
+    startup_state_ = StartupState::kResumed;
+  }
+  startup_cv_.notify_all();
+}
+
+void DartServiceIsolate::CancelDeferredStartup() {
+  {
+    std::scoped_lock lock(startup_mutex_);
+    if (startup_state_ != StartupState::kDeferred) {
+      return;
+    }
+    startup_state_ = StartupState::kCancelled;
+  }
+  startup_cv_.notify_all();
+}
+
+bool DartServiceIsolate::WaitForDeferredStartup() {
+  std::unique_lock lock(startup_mutex_);
+  startup_cv_.wait(
+      lock, [] { return startup_state_ != StartupState::kDeferred; });
+  return startup_state_ == StartupState::kResumed;
+}
+
 bool DartServiceIsolate::Startup(std::string server_ip,
                                  intptr_t server_port,
                                  Dart_LibraryTagHandler embedder_tag_handler,
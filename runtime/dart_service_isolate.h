@@ -5,6 +5,7 @@
 #ifndef FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 #define FLUTTER_RUNTIME_DART_SERVICE_ISOLATE_H_
 
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <set>
@@ -95,13 +96,60 @@ class DartServiceIsolate {
   ///
   static bool RemoveServerStatusCallback(CallbackHandle handle);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the next `WaitForDeferredStartup` call block until the
+  ///             startup is either resumed or cancelled. Called by the VM
+  ///             before it is initialized when
+  ///             `Settings::defer_service_isolate_startup` is set.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void DeferStartup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the deferred service isolate start, for example once
+  ///             tooling is about to attach. Does nothing if the startup was
+  ///             not deferred or has already been resumed.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void ResumeDeferredStartup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases a deferred startup without starting the service
+  ///             isolate. The VM must do this before it shuts down, as the VM
+  ///             waits for the creation of the service isolate to end.
+  ///
+  ///             This method is thread safe.
+  ///
+  static void CancelDeferredStartup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks the calling thread until the deferred startup is
+  ///             resumed or cancelled. This is called on the thread the VM
+  ///             creates the service isolate on.
+  ///
+  /// @return     Whether the service isolate should be started.
+  ///
+  static bool WaitForDeferredStartup();
+
  private:
+  enum class StartupState {
+    kDeferred,
+    kResumed,
+    kCancelled,
+  };
+
   // Native entries.
   static void NotifyServerState(Dart_NativeArguments args);
   static void Shutdown(Dart_NativeArguments args);
 
   static std::mutex callbacks_mutex_;
   static std::set<std::unique_ptr<ObservatoryServerStateCallback>> callbacks_;
+
+  static std::mutex startup_mutex_;
+  static std::condition_variable startup_cv_;
+  static StartupState startup_state_;
 };
 
 }  // namespace flutter
@@ -4,7 +4,10 @@
 
 #include "flutter/runtime/dart_snapshot.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
+#include <utility>
 
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
@@ -155,6 +158,77 @@ static std::shared_ptr<const fml::Mapping> ResolveIsolateInstructions(
 #endif  // DART_SNAPSHOT_STATIC_LINK
 }
 
+// Parses the "<offset> <size>" pairs of an order file. Offsets and sizes may be
+// decimal or hexadecimal with a 0x prefix. Malformed lines are skipped.
+static std::vector<std::pair<size_t, size_t>> ReadInstructionsOrderFile(
+    const std::string& path) {
+  std::vector<std::pair<size_t, size_t>> ranges;
+  auto mapping = fml::FileMapping::CreateReadOnly(path);
+  if (!mapping) {
+    FML_LOG(ERROR) << "Could not open the instructions order file: " << path;
+    return ranges;
+  }
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                  mapping->GetSize()));
+  std::string line;
+  while (std::getline(stream, line)) {
+    std::istringstream fields(line);
+    std::string offset, size;
+    if (!(fields >> offset >> size)) {
+      continue;
+    }
+    char* offset_end = nullptr;
+    char* size_end = nullptr;
+    const size_t range_offset = std::strtoull(offset.c_str(), &offset_end, 0);
+    const size_t range_size = std::strtoull(size.c_str(), &size_end, 0);
+    if (*offset_end != '\0' || *size_end != '\0' || range_size == 0) {
+      continue;
+    }
+    ranges.emplace_back(range_offset, range_size);
+  }
+  return ranges;
+}
+
+// Faults in the hot pages of the instructions now rather than during the first
+// frames, and asks for them to be backed by huge pages if requested.
+static void PrepareIsolateInstructions(const Settings& settings,
+                                       const fml::Mapping* instructions) {
+  if (instructions == nullptr || instructions->GetMapping() == nullptr) {
+    return;
+  }
+  const uint8_t* base = instructions->GetMapping();
+  // Symbol mappings do not know the size of the instructions.
+  const size_t size = instructions->GetSize();
+
+  if (settings.isolate_snapshot_instructions_huge_pages && size > 0) {
+    fml::AdviseHugePages(base, size);
+  }
+
+  if (!settings.prefault_isolate_snapshot_instructions) {
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "DartSnapshot::PrefaultIsolateInstructions");
+  if (settings.isolate_snapshot_instructions_order_file_path.empty()) {
+    if (size > 0) {
+      fml::PrefaultMemory(base, size);
+    }
+    return;
+  }
+
+  for (auto [offset, length] : ReadInstructionsOrderFile(
+           settings.isolate_snapshot_instructions_order_file_path)) {
+    if (size > 0) {
+      if (offset >= size) {
+        continue;
+      }
+      length = std::min(length, size - offset);
+    }
+    fml::PrefaultMemory(base + offset, length);
+  }
+}
+
 fml::RefPtr<DartSnapshot> DartSnapshot::VMSnapshotFromSettings(
     const Settings& settings) {
   TRACE_EVENT0("flutter", "DartSnapshot::VMSnapshotFromSettings");
@@ -175,6 +249,18 @@ fml::RefPtr<DartSnapshot> DartSnapshot::IsolateSnapshotFromSettings(
       fml::MakeRefCounted<DartSnapshot>(ResolveIsolateData(settings),         //
                                         ResolveIsolateInstructions(settings)  //
       );
+  if (snapshot->IsValid()) {
+    PrepareIsolateInstructions(settings, snapshot->instructions_.get());
+    return snapshot;
+  }
+  return nullptr;
+}
+
+fml::RefPtr<DartSnapshot> DartSnapshot::IsolateSnapshotFromMappings(
+    std::shared_ptr<const fml::Mapping> snapshot_data,
+    std::shared_ptr<const fml::Mapping> snapshot_instructions) {
+  auto snapshot = fml::MakeRefCounted<DartSnapshot>(
+      std::move(snapshot_data), std::move(snapshot_instructions));
   if (snapshot->IsValid()) {
     return snapshot;
   }
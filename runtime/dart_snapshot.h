@@ -102,6 +102,20 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   static fml::RefPtr<DartSnapshot> IsolateSnapshotFromSettings(
       const Settings& settings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an isolate snapshot from mappings of its heap and
+  ///             instructions, for example those of a deferred loading unit.
+  ///
+  /// @param[in]  snapshot_data          The heap snapshot.
+  /// @param[in]  snapshot_instructions  The instructions snapshot. This must
+  ///                                    be mapped executable.
+  ///
+  /// @return     A valid isolate snapshot or nullptr.
+  ///
+  static fml::RefPtr<DartSnapshot> IsolateSnapshotFromMappings(
+      std::shared_ptr<const fml::Mapping> snapshot_data,
+      std::shared_ptr<const fml::Mapping> snapshot_instructions);
+
   //----------------------------------------------------------------------------
   /// @brief      Determines if this snapshot contains a heap component. Since
   ///             the instructions component is optional, the method does not
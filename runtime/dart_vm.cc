@@ -8,6 +8,7 @@
 
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "flutter/common/settings.h"
@@ -265,7 +266,9 @@ size_t DartVM::GetVMLaunchCount() {
 DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
                std::shared_ptr<IsolateNameServer> isolate_name_server)
     : settings_(vm_data->GetSettings()),
-      concurrent_message_loop_(fml::ConcurrentMessageLoop::Create()),
+      concurrent_message_loop_(fml::ConcurrentMessageLoop::Create(
+          std::thread::hardware_concurrency(),
+          settings_.thread_launcher)),
       skia_concurrent_executor_(
           [runner = concurrent_message_loop_->GetTaskRunner()](
               fml::closure work) { runner->PostTask(work); }),
@@ -401,6 +404,10 @@ DartVM::DartVM(std::shared_ptr<const DartVMData> vm_data,
 
   DartUI::InitForGlobal();
 
+  if (settings_.enable_observatory && settings_.defer_service_isolate_startup) {
+    DartServiceIsolate::DeferStartup();
+  }
+
   {
     TRACE_EVENT0("flutter", "Dart_Initialize");
     Dart_InitializeParams params = {};
@@ -472,6 +479,10 @@ DartVM::~DartVM() {
     Dart_ExitIsolate();
   }
 
+  // The VM waits for the creation of the service isolate to end before it
+  // shuts down.
+  DartServiceIsolate::CancelDeferredStartup();
+
   char* result = Dart_Cleanup();
 
   dart::bin::CleanupDartIo();
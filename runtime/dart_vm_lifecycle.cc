@@ -5,6 +5,10 @@
 #include "flutter/runtime/dart_vm_lifecycle.h"
 
 #include <mutex>
+#include <thread>
+
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
@@ -14,6 +18,8 @@ namespace flutter {
 static std::mutex gVMMutex;
 static std::weak_ptr<DartVM> gVM;
 static std::shared_ptr<DartVM>* gVMLeak;
+// Held by |DartVMRef::Prewarm| until the next |DartVMRef::Create|.
+static std::shared_ptr<DartVM>* gVMPrewarm;
 
 // We are going to be modifying more than just the control blocks of the
 // following weak pointers (in the |Create| case where an old VM could not be
@@ -41,11 +47,11 @@ DartVMRef::~DartVMRef() {
   vm_.reset();
 }
 
-DartVMRef DartVMRef::Create(Settings settings,
-                            fml::RefPtr<DartSnapshot> vm_snapshot,
-                            fml::RefPtr<DartSnapshot> isolate_snapshot) {
-  std::scoped_lock lifecycle_lock(gVMMutex);
-
+// Must be called with |gVMMutex| held.
+static std::shared_ptr<DartVM> CreateVMLocked(
+    Settings settings,
+    fml::RefPtr<DartSnapshot> vm_snapshot,
+    fml::RefPtr<DartSnapshot> isolate_snapshot) {
   if (!settings.leak_vm) {
     FML_CHECK(!gVMLeak)
         << "Launch settings indicated that the VM should shut down in the "
@@ -61,7 +67,7 @@ DartVMRef DartVMRef::Create(Settings settings,
                          "already running. Ignoring arguments for current VM "
                          "create call and reusing the old VM.";
     // There was already a running VM in the process,
-    return DartVMRef{std::move(vm)};
+    return vm;
   }
 
   std::scoped_lock dependents_lock(gVMDependentsMutex);
@@ -82,7 +88,7 @@ DartVMRef DartVMRef::Create(Settings settings,
 
   if (!vm) {
     FML_LOG(ERROR) << "Could not create Dart VM instance.";
-    return {nullptr};
+    return nullptr;
   }
 
   gVMData = vm->GetVMData();
@@ -94,9 +100,39 @@ DartVMRef DartVMRef::Create(Settings settings,
     gVMLeak = new std::shared_ptr<DartVM>(vm);
   }
 
+  return vm;
+}
+
+DartVMRef DartVMRef::Create(Settings settings,
+                            fml::RefPtr<DartSnapshot> vm_snapshot,
+                            fml::RefPtr<DartSnapshot> isolate_snapshot) {
+  std::scoped_lock lifecycle_lock(gVMMutex);
+  auto vm = CreateVMLocked(std::move(settings), std::move(vm_snapshot),
+                           std::move(isolate_snapshot));
+
+  // The caller now keeps the prewarmed VM alive.
+  delete gVMPrewarm;
+  gVMPrewarm = nullptr;
+
   return DartVMRef{std::move(vm)};
 }
 
+void DartVMRef::Prewarm(Settings settings) {
+  std::thread thread([settings = std::move(settings)]() mutable {
+    fml::Thread::SetCurrentThreadName("io.flutter.vm_prewarm");
+    TRACE_EVENT0("flutter", "DartVMRef::Prewarm");
+    std::scoped_lock lifecycle_lock(gVMMutex);
+    if (!gVM.expired()) {
+      return;
+    }
+    auto vm = CreateVMLocked(std::move(settings), nullptr, nullptr);
+    if (vm && !gVMPrewarm) {
+      gVMPrewarm = new std::shared_ptr<DartVM>(std::move(vm));
+    }
+  });
+  thread.detach();
+}
+
 bool DartVMRef::IsInstanceRunning() {
   std::scoped_lock lock(gVMMutex);
   return !gVM.expired();
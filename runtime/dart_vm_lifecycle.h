@@ -31,6 +31,17 @@ class DartVMRef {
       fml::RefPtr<DartSnapshot> vm_snapshot = nullptr,
       fml::RefPtr<DartSnapshot> isolate_snapshot = nullptr);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Starts creating a VM with |settings| on a background thread if
+  ///             none is running, so that a later call to |Create| does not
+  ///             have to wait for the whole VM boot. A |Create| call made while
+  ///             the VM is still booting waits for it to finish.
+  ///
+  ///             The prewarmed VM is kept alive until the next call to
+  ///             |Create| takes a reference to it.
+  ///
+  static void Prewarm(Settings settings);
+
   DartVMRef(DartVMRef&&);
 
   ~DartVMRef();
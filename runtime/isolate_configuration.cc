@@ -238,21 +238,28 @@ std::unique_ptr<IsolateConfiguration> IsolateConfiguration::InferFromSettings(
     return nullptr;
   }
 
-  {
-    std::unique_ptr<fml::Mapping> kernel_list =
-        asset_manager->GetAsMapping(settings.application_kernel_list_asset);
-    if (!kernel_list) {
-      FML_LOG(ERROR) << "Failed to load: "
-                     << settings.application_kernel_list_asset;
-      return nullptr;
-    }
-    auto kernel_pieces_paths = ParseKernelListPaths(std::move(kernel_list));
-    auto kernel_mappings = PrepareKernelMappings(std::move(kernel_pieces_paths),
-                                                 asset_manager, io_worker);
-    return CreateForKernelList(std::move(kernel_mappings));
-  }
+  return CreateForKernelListAsset(settings.application_kernel_list_asset,
+                                  std::move(asset_manager),
+                                  std::move(io_worker));
+}
 
-  return nullptr;
+std::unique_ptr<IsolateConfiguration>
+IsolateConfiguration::CreateForKernelListAsset(
+    const std::string& kernel_list_asset,
+    std::shared_ptr<AssetManager> asset_manager,
+    fml::RefPtr<fml::TaskRunner> io_worker) {
+  FML_DCHECK(asset_manager);
+  std::unique_ptr<fml::Mapping> kernel_list =
+      asset_manager->GetAsMapping(kernel_list_asset);
+  if (!kernel_list) {
+    FML_LOG(ERROR) << "Failed to load: " << kernel_list_asset;
+    return nullptr;
+  }
+  auto kernel_pieces_paths = ParseKernelListPaths(std::move(kernel_list));
+  auto kernel_mappings = PrepareKernelMappings(std::move(kernel_pieces_paths),
+                                               std::move(asset_manager),
+                                               std::move(io_worker));
+  return CreateForKernelList(std::move(kernel_mappings));
 }
 
 std::unique_ptr<IsolateConfiguration>
@@ -123,6 +123,34 @@ class IsolateConfiguration {
   static std::unique_ptr<IsolateConfiguration> CreateForKernelList(
       std::vector<std::unique_ptr<const fml::Mapping>> kernel_pieces);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a JIT isolate configuration from the Dart kernel
+  ///             snapshots listed in an asset. The list names one snapshot
+  ///             asset per line, and the snapshots are loaded in that order.
+  ///             The snapshots are mapped on the IO worker if one is
+  ///             specified.
+  ///
+  ///             Since each snapshot is mapped from its own asset, a tool that
+  ///             splits the application kernel into several snapshots only
+  ///             has to rewrite the snapshots that changed, for example
+  ///             before a hot restart.
+  ///
+  /// @param[in]  kernel_list_asset  The name of the asset listing the kernel
+  ///                                snapshots.
+  /// @param[in]  asset_manager      The asset manager used to resolve the list
+  ///                                and the snapshots.
+  /// @param[in]  io_worker          An optional IO worker. Specify `nullptr`
+  ///                                if a worker should not be used or one is
+  ///                                not available.
+  ///
+  /// @return     A JIT isolate configuration, or `nullptr` if the list could
+  ///             not be loaded.
+  ///
+  static std::unique_ptr<IsolateConfiguration> CreateForKernelListAsset(
+      const std::string& kernel_list_asset,
+      std::shared_ptr<AssetManager> asset_manager,
+      fml::RefPtr<fml::TaskRunner> io_worker = nullptr);
+
   //----------------------------------------------------------------------------
   /// @brief      Create an isolate configuration. This has no threading
   /// restrictions.
@@ -5,8 +5,10 @@
 #ifndef FLUTTER_RUNTIME_PLATFORM_DATA_H_
 #define FLUTTER_RUNTIME_PLATFORM_DATA_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/lib/ui/window/viewport_metrics.h"
@@ -31,6 +33,9 @@ struct PlatformData {
   ~PlatformData();
 
   ViewportMetrics viewport_metrics;
+  // The metrics of the views added by the platform in addition to the
+  // implicit view, whose metrics are |viewport_metrics|, by view id.
+  std::unordered_map<int64_t, ViewportMetrics> view_metrics;
   std::string language_code;
   std::string country_code;
   std::string script_code;
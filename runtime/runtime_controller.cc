@@ -77,7 +77,7 @@ bool RuntimeController::IsRootIsolateRunning() {
 }
 
 std::unique_ptr<RuntimeController> RuntimeController::Clone() const {
-  return std::unique_ptr<RuntimeController>(new RuntimeController(
+  auto result = std::unique_ptr<RuntimeController>(new RuntimeController(
       client_,                      //
       vm_,                          //
       isolate_snapshot_,            //
@@ -95,16 +95,57 @@ std::unique_ptr<RuntimeController> RuntimeController::Clone() const {
       isolate_shutdown_callback_,   //
       persistent_isolate_data_      //
       ));
+  result->spawning_isolate_ = spawning_isolate_;
+  return result;
+}
+
+std::unique_ptr<RuntimeController> RuntimeController::Spawn(
+    RuntimeDelegate& client,
+    fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
+    fml::WeakPtr<HintFreedDelegate> hint_freed_delegate,
+    fml::WeakPtr<IOManager> io_manager,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue,
+    fml::WeakPtr<ImageDecoder> image_decoder) const {
+  PlatformData platform_data = platform_data_;
+  platform_data.viewport_metrics = ViewportMetrics{};
+  auto result = std::unique_ptr<RuntimeController>(new RuntimeController(
+      client,                          //
+      vm_,                             //
+      isolate_snapshot_,               //
+      task_runners_,                   //
+      std::move(snapshot_delegate),    //
+      std::move(hint_freed_delegate),  //
+      std::move(io_manager),           //
+      std::move(unref_queue),          //
+      std::move(image_decoder),        //
+      advisory_script_uri_,            //
+      advisory_script_entrypoint_,     //
+      idle_notification_callback_,     //
+      platform_data,                   //
+      isolate_create_callback_,        //
+      isolate_shutdown_callback_,      //
+      persistent_isolate_data_         //
+      ));
+  result->spawning_isolate_ = root_isolate_;
+  return result;
 }
 
 bool RuntimeController::FlushRuntimeStateToIsolate() {
-  return SetViewportMetrics(platform_data_.viewport_metrics) &&
-         SetLocales(platform_data_.locale_data) &&
-         SetSemanticsEnabled(platform_data_.semantics_enabled) &&
-         SetAccessibilityFeatures(
-             platform_data_.accessibility_feature_flags_) &&
-         SetUserSettingsData(platform_data_.user_settings_data) &&
-         SetLifecycleState(platform_data_.lifecycle_state);
+  if (!(SetViewportMetrics(platform_data_.viewport_metrics) &&
+        SetLocales(platform_data_.locale_data) &&
+        SetSemanticsEnabled(platform_data_.semantics_enabled) &&
+        SetAccessibilityFeatures(
+            platform_data_.accessibility_feature_flags_) &&
+        SetUserSettingsData(platform_data_.user_settings_data) &&
+        SetLifecycleState(platform_data_.lifecycle_state))) {
+    return false;
+  }
+  for (const auto& [view_id, metrics] : platform_data_.view_metrics) {
+    if (!SetViewportMetrics(view_id, metrics)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool RuntimeController::SetViewportMetrics(const ViewportMetrics& metrics) {
@@ -118,6 +159,29 @@ bool RuntimeController::SetViewportMetrics(const ViewportMetrics& metrics) {
   return false;
 }
 
+bool RuntimeController::SetViewportMetrics(int64_t view_id,
+                                           const ViewportMetrics& metrics) {
+  platform_data_.view_metrics[view_id] = metrics;
+
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    platform_configuration->AddWindow(view_id, metrics);
+    return true;
+  }
+
+  return false;
+}
+
+bool RuntimeController::RemoveView(int64_t view_id) {
+  platform_data_.view_metrics.erase(view_id);
+
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    platform_configuration->RemoveWindow(view_id);
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::SetLocales(
     const std::vector<std::string>& locale_data) {
   platform_data_.locale_data = locale_data;
@@ -271,8 +335,8 @@ void RuntimeController::ScheduleFrame() {
 }
 
 // |PlatformConfigurationClient|
-void RuntimeController::Render(Scene* scene) {
-  client_.Render(scene->takeLayerTree());
+void RuntimeController::Render(int64_t view_id, Scene* scene) {
+  client_.Render(scene->takeLayerTree(view_id));
 }
 
 // |PlatformConfigurationClient|
@@ -293,6 +357,11 @@ FontCollection& RuntimeController::GetFontCollection() {
   return client_.GetFontCollection();
 }
 
+// |PlatformConfigurationClient|
+std::shared_ptr<AssetManager> RuntimeController::GetAssetManager() {
+  return client_.GetAssetManager();
+}
+
 // |PlatformConfigurationClient|
 void RuntimeController::UpdateIsolateDescription(const std::string isolate_name,
                                                  int64_t isolate_port) {
@@ -304,6 +373,11 @@ void RuntimeController::SetNeedsReportTimings(bool value) {
   client_.SetNeedsReportTimings(value);
 }
 
+// |PlatformConfigurationClient|
+void RuntimeController::SetPreferredFrameRate(double frames_per_second) {
+  client_.SetPreferredFrameRate(frames_per_second);
+}
+
 // |PlatformConfigurationClient|
 std::shared_ptr<const fml::Mapping>
 RuntimeController::GetPersistentIsolateData() {
@@ -317,6 +391,34 @@ RuntimeController::ComputePlatformResolvedLocale(
   return client_.ComputePlatformResolvedLocale(supported_locale_data);
 }
 
+// |PlatformConfigurationClient|
+void RuntimeController::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
+  client_.RequestDartDeferredLibrary(loading_unit_id);
+}
+
+bool RuntimeController::LoadDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  std::shared_ptr<DartIsolate> root_isolate = root_isolate_.lock();
+  if (!root_isolate) {
+    return false;
+  }
+  return root_isolate->LoadLoadingUnit(loading_unit_id,
+                                       std::move(snapshot_data),
+                                       std::move(snapshot_instructions));
+}
+
+void RuntimeController::LoadDartDeferredLibraryError(
+    intptr_t loading_unit_id,
+    const std::string& error_message,
+    bool transient) {
+  if (std::shared_ptr<DartIsolate> root_isolate = root_isolate_.lock()) {
+    root_isolate->LoadLoadingUnitError(loading_unit_id, error_message,
+                                       transient);
+  }
+}
+
 Dart_Port RuntimeController::GetMainPort() {
   std::shared_ptr<DartIsolate> root_isolate = root_isolate_.lock();
   return root_isolate ? root_isolate->main_port() : ILLEGAL_PORT;
@@ -336,6 +438,23 @@ bool RuntimeController::HasLivePorts() {
   return Dart_HasLivePorts();
 }
 
+std::optional<DartHeapUsage> RuntimeController::GetDartHeapUsage() {
+  std::shared_ptr<DartIsolate> root_isolate = root_isolate_.lock();
+  if (!root_isolate) {
+    return std::nullopt;
+  }
+  tonic::DartState::Scope scope(root_isolate);
+  Dart_IsolateGroup group = Dart_CurrentIsolateGroup();
+  DartHeapUsage usage;
+  usage.new_used_bytes = Dart_IsolateGroupHeapNewUsedMetric(group);
+  usage.new_capacity_bytes = Dart_IsolateGroupHeapNewCapacityMetric(group);
+  usage.old_used_bytes = Dart_IsolateGroupHeapOldUsedMetric(group);
+  usage.old_capacity_bytes = Dart_IsolateGroupHeapOldCapacityMetric(group);
+  usage.external_bytes = Dart_IsolateGroupHeapNewExternalMetric(group) +
+                         Dart_IsolateGroupHeapOldExternalMetric(group);
+  return usage;
+}
+
 tonic::DartErrorHandleType RuntimeController::GetLastError() {
   std::shared_ptr<DartIsolate> root_isolate = root_isolate_.lock();
   return root_isolate ? root_isolate->GetLastError() : tonic::kNoError;
@@ -369,7 +488,8 @@ bool RuntimeController::LaunchRootIsolate(
           isolate_shutdown_callback_,                     //
           dart_entrypoint,                                //
           dart_entrypoint_library,                        //
-          std::move(isolate_configuration)                //
+          std::move(isolate_configuration),               //
+          spawning_isolate_.lock().get()                  //
           )
           .lock();
 
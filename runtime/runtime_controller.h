@@ -6,6 +6,7 @@
 #define FLUTTER_RUNTIME_RUNTIME_CONTROLLER_H_
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/common/task_runners.h"
@@ -28,6 +29,19 @@ class RuntimeDelegate;
 class View;
 class Window;
 
+//------------------------------------------------------------------------------
+/// The heap usage of the isolate group of the root isolate as reported by the
+/// Dart VM. External bytes include the native allocations that wrappers report
+/// to the VM via `DartWrappable::GetAllocationSize`.
+///
+struct DartHeapUsage {
+  int64_t new_used_bytes = 0;
+  int64_t new_capacity_bytes = 0;
+  int64_t old_used_bytes = 0;
+  int64_t old_capacity_bytes = 0;
+  int64_t external_bytes = 0;
+};
+
 //------------------------------------------------------------------------------
 /// Represents an instance of a running root isolate with window bindings. In
 /// normal operation, a single instance of this object is owned by the engine
@@ -172,6 +186,33 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   std::unique_ptr<RuntimeController> Clone() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a runtime controller for another engine whose root
+  ///             isolate joins the isolate group of the root isolate of this
+  ///             runtime controller, if it is still running when the new root
+  ///             isolate is launched. Both use the same VM, isolate snapshot
+  ///             and task runners. The window data is copied except for the
+  ///             viewport metrics, which the new engine must provide.
+  ///
+  /// @param      client               The runtime delegate of the new runtime
+  ///                                  controller.
+  /// @param[in]  snapshot_delegate    The snapshot delegate of the new engine.
+  /// @param[in]  hint_freed_delegate  The hint freed delegate of the new
+  ///                                  engine.
+  /// @param[in]  io_manager           The IO manager of the new engine.
+  /// @param[in]  unref_queue          The Skia unref queue of the new engine.
+  /// @param[in]  image_decoder        The image decoder of the new engine.
+  ///
+  /// @return     The runtime controller for the spawned engine.
+  ///
+  std::unique_ptr<RuntimeController> Spawn(
+      RuntimeDelegate& client,
+      fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
+      fml::WeakPtr<HintFreedDelegate> hint_freed_delegate,
+      fml::WeakPtr<IOManager> io_manager,
+      fml::RefPtr<SkiaUnrefQueue> unref_queue,
+      fml::WeakPtr<ImageDecoder> image_decoder) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Forward the specified viewport metrics to the running isolate.
   ///             If the isolate is not running, these metrics will be saved and
@@ -183,6 +224,31 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   bool SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Forward the viewport metrics of a view that the platform
+  ///             added in addition to the implicit view to the running
+  ///             isolate, which adds a window for the view if it does not
+  ///             know it yet. If the isolate is not running, these metrics
+  ///             will be saved and flushed to the isolate when it starts.
+  ///
+  /// @param[in]  view_id  The id of the view.
+  /// @param[in]  metrics  The view's viewport metrics.
+  ///
+  /// @return     If the view metrics were forwarded to the running isolate.
+  ///
+  bool SetViewportMetrics(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a view whose metrics were set with
+  ///             |SetViewportMetrics| from the running isolate, and forgets
+  ///             its metrics.
+  ///
+  /// @param[in]  view_id  The id of the view.
+  ///
+  /// @return     If the view was removed from the running isolate.
+  ///
+  bool RemoveView(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Forward the specified locale data to the running isolate. If
   ///             the isolate is not running, this data will be saved and
@@ -450,6 +516,14 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   bool HasLivePorts();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the heap usage of the isolate group of the root isolate.
+  ///
+  /// @return     The heap usage, or `std::nullopt` if the root isolate is not
+  ///             running.
+  ///
+  std::optional<DartHeapUsage> GetDartHeapUsage();
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last error encountered by the microtask queue.
   ///
@@ -473,6 +547,25 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   std::optional<uint32_t> GetRootIsolateReturnCode();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Completes a request of the root isolate to load a deferred
+  ///             loading unit. See `DartIsolate::LoadLoadingUnit`.
+  ///
+  /// @return     Whether the root isolate is running and loaded the unit.
+  ///
+  bool LoadDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fails a request of the root isolate to load a deferred
+  ///             loading unit. See `DartIsolate::LoadLoadingUnitError`.
+  ///
+  void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
+                                    const std::string& error_message,
+                                    bool transient);
+
  protected:
   /// Constructor for Mocks.
   RuntimeController(RuntimeDelegate& client, TaskRunners p_task_runners);
@@ -506,6 +599,8 @@ class RuntimeController : public PlatformConfigurationClient {
   std::function<void(int64_t)> idle_notification_callback_;
   PlatformData platform_data_;
   std::weak_ptr<DartIsolate> root_isolate_;
+  // The root isolate of the runtime controller this one was spawned from.
+  std::weak_ptr<DartIsolate> spawning_isolate_;
   std::optional<uint32_t> root_isolate_return_code_;
   const fml::closure isolate_create_callback_;
   const fml::closure isolate_shutdown_callback_;
@@ -522,7 +617,7 @@ class RuntimeController : public PlatformConfigurationClient {
   void ScheduleFrame() override;
 
   // |PlatformConfigurationClient|
-  void Render(Scene* scene) override;
+  void Render(int64_t view_id, Scene* scene) override;
 
   // |PlatformConfigurationClient|
   void UpdateSemantics(SemanticsUpdate* update) override;
@@ -533,6 +628,9 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   FontCollection& GetFontCollection() override;
 
+  // |PlatformConfigurationClient|
+  std::shared_ptr<AssetManager> GetAssetManager() override;
+
   // |PlatformConfigurationClient|
   void UpdateIsolateDescription(const std::string isolate_name,
                                 int64_t isolate_port) override;
@@ -540,6 +638,9 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   void SetNeedsReportTimings(bool value) override;
 
+  // |PlatformConfigurationClient|
+  void SetPreferredFrameRate(double frames_per_second) override;
+
   // |PlatformConfigurationClient|
   std::shared_ptr<const fml::Mapping> GetPersistentIsolateData() override;
 
@@ -547,6 +648,9 @@ class RuntimeController : public PlatformConfigurationClient {
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
 
+  // |PlatformConfigurationClient|
+  void RequestDartDeferredLibrary(intptr_t loading_unit_id) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(RuntimeController);
 };
 
@@ -32,6 +32,8 @@ class RuntimeDelegate {
 
   virtual FontCollection& GetFontCollection() = 0;
 
+  virtual std::shared_ptr<AssetManager> GetAssetManager() = 0;
+
   virtual void OnRootIsolateCreated() = 0;
 
   virtual void UpdateIsolateDescription(const std::string isolate_name,
@@ -39,10 +41,14 @@ class RuntimeDelegate {
 
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  virtual void SetPreferredFrameRate(double frames_per_second) = 0;
+
   virtual std::unique_ptr<std::vector<std::string>>
   ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) = 0;
 
+  virtual void RequestDartDeferredLibrary(intptr_t loading_unit_id) = 0;
+
  protected:
   virtual ~RuntimeDelegate();
 };
@@ -24,6 +24,8 @@ const std::string_view ServiceProtocol::kScreenshotExtensionName =
     "_flutter.screenshot";
 const std::string_view ServiceProtocol::kScreenshotSkpExtensionName =
     "_flutter.screenshotSkp";
+const std::string_view ServiceProtocol::kCaptureLayerTreeExtensionName =
+    "_flutter.captureLayerTree";
 const std::string_view ServiceProtocol::kRunInViewExtensionName =
     "_flutter.runInView";
 const std::string_view ServiceProtocol::kFlushUIThreadTasksExtensionName =
@@ -37,6 +39,31 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view
+    ServiceProtocol::kGetDecodedImageCacheStatsExtensionName =
+        "_flutter.getDecodedImageCacheStats";
+const std::string_view ServiceProtocol::kGetGlyphUsageExtensionName =
+    "_flutter.getGlyphUsage";
+const std::string_view ServiceProtocol::kGetFrameHistogramsExtensionName =
+    "_flutter.getFrameHistograms";
+const std::string_view ServiceProtocol::kGetFrameStatsExtensionName =
+    "_flutter.getFrameStats";
+const std::string_view
+    ServiceProtocol::kGetRasterCacheDecisionsExtensionName =
+        "_flutter.getRasterCacheDecisions";
+const std::string_view ServiceProtocol::kGetTraceRecordingExtensionName =
+    "_flutter.getTraceRecording";
+const std::string_view
+    ServiceProtocol::kGetRasterThreadMergerStatsExtensionName =
+        "_flutter.getRasterThreadMergerStats";
+const std::string_view ServiceProtocol::kGetResourceCacheBudgetExtensionName =
+    "_flutter.getResourceCacheBudget";
+const std::string_view ServiceProtocol::kGetMemoryBreakdownExtensionName =
+    "_flutter.getMemoryBreakdown";
+const std::string_view ServiceProtocol::kGetTaskQueueStatsExtensionName =
+    "_flutter.getTaskQueueStats";
+const std::string_view ServiceProtocol::kGetDartGCStatsExtensionName =
+    "_flutter.getDartGCStats";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -50,12 +77,24 @@ ServiceProtocol::ServiceProtocol()
           // Public
           kScreenshotExtensionName,
           kScreenshotSkpExtensionName,
+          kCaptureLayerTreeExtensionName,
           kRunInViewExtensionName,
           kFlushUIThreadTasksExtensionName,
           kSetAssetBundlePathExtensionName,
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetDecodedImageCacheStatsExtensionName,
+          kGetGlyphUsageExtensionName,
+          kGetFrameHistogramsExtensionName,
+          kGetFrameStatsExtensionName,
+          kGetRasterCacheDecisionsExtensionName,
+          kGetTraceRecordingExtensionName,
+          kGetRasterThreadMergerStatsExtensionName,
+          kGetResourceCacheBudgetExtensionName,
+          kGetMemoryBreakdownExtensionName,
+          kGetTaskQueueStatsExtensionName,
+          kGetDartGCStatsExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -23,12 +23,24 @@ class ServiceProtocol {
  public:
   static const std::string_view kScreenshotExtensionName;
   static const std::string_view kScreenshotSkpExtensionName;
+  static const std::string_view kCaptureLayerTreeExtensionName;
   static const std::string_view kRunInViewExtensionName;
   static const std::string_view kFlushUIThreadTasksExtensionName;
   static const std::string_view kSetAssetBundlePathExtensionName;
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetDecodedImageCacheStatsExtensionName;
+  static const std::string_view kGetGlyphUsageExtensionName;
+  static const std::string_view kGetFrameHistogramsExtensionName;
+  static const std::string_view kGetFrameStatsExtensionName;
+  static const std::string_view kGetRasterCacheDecisionsExtensionName;
+  static const std::string_view kGetTraceRecordingExtensionName;
+  static const std::string_view kGetRasterThreadMergerStatsExtensionName;
+  static const std::string_view kGetResourceCacheBudgetExtensionName;
+  static const std::string_view kGetMemoryBreakdownExtensionName;
+  static const std::string_view kGetTaskQueueStatsExtensionName;
+  static const std::string_view kGetDartGCStatsExtensionName;
 
   class Handler {
    public:
@@ -0,0 +1,49 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/adaptive_pipeline_depth.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+AdaptivePipelineDepth::AdaptivePipelineDepth(uint32_t max_depth)
+    : max_depth_(std::max<uint32_t>(max_depth, 1u)) {}
+
+AdaptivePipelineDepth::~AdaptivePipelineDepth() = default;
+
+bool AdaptivePipelineDepth::RecordFrame(fml::TimeDelta build_time,
+                                        fml::TimeDelta raster_time,
+                                        fml::TimeDelta frame_budget) {
+  total_build_time_ = total_build_time_ + build_time;
+  total_raster_time_ = total_raster_time_ + raster_time;
+  total_frame_budget_ = total_frame_budget_ + frame_budget;
+  if (++sample_count_ < kSampleCount) {
+    return false;
+  }
+
+  // All three totals are over the same number of frames, so they can be
+  // compared directly instead of as averages.
+  const fml::TimeDelta build = total_build_time_;
+  const fml::TimeDelta raster = total_raster_time_;
+  const fml::TimeDelta budget = total_frame_budget_;
+  sample_count_ = 0;
+  total_build_time_ = {};
+  total_raster_time_ = {};
+  total_frame_budget_ = {};
+
+  const bool raster_bound = raster > build;
+  const uint32_t previous_depth = depth_;
+  if (raster_bound && build + raster > budget) {
+    depth_ = std::min(depth_ + 1, max_depth_);
+  } else if (!raster_bound || (build + raster) * 4 <= budget * 3) {
+    // Require some headroom before going back to the lower latency mode so
+    // that the depth does not flip every window when the frames take about
+    // as long as the budget.
+    depth_ = std::max(depth_ - 1, 1u);
+  }
+  return depth_ != previous_depth;
+}
+
+}  // namespace flutter
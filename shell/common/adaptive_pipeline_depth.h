@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_ADAPTIVE_PIPELINE_DEPTH_H_
+#define FLUTTER_SHELL_COMMON_ADAPTIVE_PIPELINE_DEPTH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Chooses how many frames the |Animator| keeps in flight from the build and
+/// raster times of recently rasterized frames.
+///
+/// A second frame in flight lets the UI thread build the next frame while the
+/// raster thread is still busy with the previous one, at the cost of one
+/// frame of latency. That only pays off when the raster thread is the
+/// bottleneck and building and rasterizing a frame back to back does not fit
+/// in the frame budget. Otherwise a single frame in flight gives the lowest
+/// latency.
+///
+/// Timings are evaluated in windows of |kSampleCount| frames so that a single
+/// slow frame does not cause the depth to oscillate.
+///
+class AdaptivePipelineDepth {
+ public:
+  static constexpr size_t kSampleCount = 8;
+
+  explicit AdaptivePipelineDepth(uint32_t max_depth);
+
+  ~AdaptivePipelineDepth();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timings of a rasterized frame.
+  ///
+  /// @return     Whether the recommended depth changed.
+  ///
+  bool RecordFrame(fml::TimeDelta build_time,
+                   fml::TimeDelta raster_time,
+                   fml::TimeDelta frame_budget);
+
+  uint32_t GetDepth() const { return depth_; }
+
+ private:
+  const uint32_t max_depth_;
+  uint32_t depth_ = 1;
+  size_t sample_count_ = 0;
+  fml::TimeDelta total_build_time_;
+  fml::TimeDelta total_raster_time_;
+  fml::TimeDelta total_frame_budget_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AdaptivePipelineDepth);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_ADAPTIVE_PIPELINE_DEPTH_H_
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/adaptive_pipeline_depth.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kBudget = fml::TimeDelta::FromMilliseconds(16);
+
+// Records a full window of identical frames and returns whether the depth
+// changed at the end of it.
+bool RecordWindow(AdaptivePipelineDepth& policy,
+                  int64_t build_millis,
+                  int64_t raster_millis) {
+  bool changed = false;
+  for (size_t i = 0; i < AdaptivePipelineDepth::kSampleCount; i++) {
+    EXPECT_FALSE(changed);
+    changed =
+        policy.RecordFrame(fml::TimeDelta::FromMilliseconds(build_millis),
+                           fml::TimeDelta::FromMilliseconds(raster_millis),
+                           kBudget);
+  }
+  return changed;
+}
+
+}  // namespace
+
+TEST(AdaptivePipelineDepthTest, StartsWithLowestLatency) {
+  AdaptivePipelineDepth policy(2);
+  EXPECT_EQ(policy.GetDepth(), 1u);
+}
+
+TEST(AdaptivePipelineDepthTest, StaysShallowWhenFramesFitTheBudget) {
+  AdaptivePipelineDepth policy(2);
+  EXPECT_FALSE(RecordWindow(policy, 4, 8));
+  EXPECT_EQ(policy.GetDepth(), 1u);
+}
+
+TEST(AdaptivePipelineDepthTest, DeepensWhenRasterIsTheBottleneck) {
+  AdaptivePipelineDepth policy(2);
+  EXPECT_TRUE(RecordWindow(policy, 6, 12));
+  EXPECT_EQ(policy.GetDepth(), 2u);
+
+  // Never exceeds the maximum depth.
+  EXPECT_FALSE(RecordWindow(policy, 6, 12));
+  EXPECT_EQ(policy.GetDepth(), 2u);
+}
+
+TEST(AdaptivePipelineDepthTest, DoesNotDeepenWhenBuildIsTheBottleneck) {
+  AdaptivePipelineDepth policy(2);
+  EXPECT_FALSE(RecordWindow(policy, 12, 6));
+  EXPECT_EQ(policy.GetDepth(), 1u);
+}
+
+TEST(AdaptivePipelineDepthTest, ReturnsToLowLatencyWithHeadroom) {
+  AdaptivePipelineDepth policy(2);
+  ASSERT_TRUE(RecordWindow(policy, 6, 12));
+
+  // Just under the budget is not enough headroom.
+  EXPECT_FALSE(RecordWindow(policy, 5, 10));
+  EXPECT_EQ(policy.GetDepth(), 2u);
+
+  EXPECT_TRUE(RecordWindow(policy, 3, 8));
+  EXPECT_EQ(policy.GetDepth(), 1u);
+}
+
+TEST(AdaptivePipelineDepthTest, SingleSlowFrameDoesNotChangeDepth) {
+  AdaptivePipelineDepth policy(2);
+  policy.RecordFrame(fml::TimeDelta::FromMilliseconds(4),
+                     fml::TimeDelta::FromMilliseconds(40), kBudget);
+  for (size_t i = 1; i < AdaptivePipelineDepth::kSampleCount; i++) {
+    policy.RecordFrame(fml::TimeDelta::FromMilliseconds(2),
+                       fml::TimeDelta::FromMilliseconds(4), kBudget);
+  }
+  EXPECT_EQ(policy.GetDepth(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <string>
+
+#include "flutter/common/constants.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
@@ -21,14 +24,14 @@ constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
 
 Animator::Animator(Delegate& delegate,
                    TaskRunners task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   bool enable_adaptive_pipelining)
     : delegate_(delegate),
       task_runners_(std::move(task_runners)),
       waiter_(std::move(waiter)),
       last_frame_begin_time_(),
       last_vsync_start_time_(),
       last_frame_target_time_(),
-      dart_frame_deadline_(0),
 #if FLUTTER_SHELL_ENABLE_METAL
       layer_tree_pipeline_(fml::MakeRefCounted<LayerTreePipeline>(2)),
 #else   // FLUTTER_SHELL_ENABLE_METAL
@@ -49,6 +52,14 @@ Animator::Animator(Delegate& delegate,
       notify_idle_task_id_(0),
       dimension_change_pending_(false),
       weak_factory_(this) {
+  if (enable_adaptive_pipelining) {
+    // Start out with the lowest latency. The pipeline depth it was created
+    // with becomes the upper bound.
+    adaptive_pipeline_depth_ = std::make_unique<AdaptivePipelineDepth>(
+        layer_tree_pipeline_->GetDepth());
+    layer_tree_pipeline_->SetEffectiveDepth(
+        adaptive_pipeline_depth_->GetDepth());
+  }
 }
 
 Animator::~Animator() = default;
@@ -83,6 +94,35 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
       });
 }
 
+void Animator::OnFrameRasterized(const FrameTiming& timing) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (!adaptive_pipeline_depth_ || last_frame_interval_ <= fml::TimeDelta()) {
+    return;
+  }
+
+  const auto build_time = timing.Get(FrameTiming::kBuildFinish) -
+                          timing.Get(FrameTiming::kBuildStart);
+  const auto raster_time = timing.Get(FrameTiming::kRasterFinish) -
+                           timing.Get(FrameTiming::kRasterStart);
+  if (adaptive_pipeline_depth_->RecordFrame(build_time, raster_time,
+                                            last_frame_interval_)) {
+    const uint32_t depth = adaptive_pipeline_depth_->GetDepth();
+    TRACE_EVENT1("flutter", "Animator::AdaptPipelineDepth", "depth",
+                 std::to_string(depth).c_str());
+    layer_tree_pipeline_->SetEffectiveDepth(depth);
+  }
+}
+
+void Animator::OnPresentationFeedback(const PresentationFeedback& feedback) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  waiter_->UpdatePresentationFeedback(feedback);
+}
+
+void Animator::SetPreferredFrameRate(double frames_per_second) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  waiter_->SetPreferredFrameRate(frames_per_second);
+}
+
 // This Parity is used by the timeline component to correctly align
 // GPU Workloads events with their respective Framework Workload.
 const char* Animator::FrameParity() {
@@ -136,11 +176,11 @@ void Animator::BeginFrame(fml::TimePoint vsync_start_time,
                                         last_vsync_start_time_,
                                         last_frame_begin_time_);
   last_frame_target_time_ = frame_target_time;
-  dart_frame_deadline_ = FxlToDartOrEarlier(frame_target_time);
+  last_frame_interval_ = frame_target_time - vsync_start_time;
   {
     TRACE_EVENT2("flutter", "Framework Workload", "mode", "basic", "frame",
                  FrameParity());
-    delegate_.OnAnimatorBeginFrame(frame_target_time);
+    delegate_.OnAnimatorBeginFrame(GetPresentationTargetTime());
   }
 
   if (!frame_scheduled_) {
@@ -151,7 +191,7 @@ void Animator::BeginFrame(fml::TimePoint vsync_start_time,
     // viewport event).  Because of this, we hold off on calling
     // |OnAnimatorNotifyIdle| for a little bit, as that could cause garbage
     // collection to trigger at a highly undesirable time.
-    task_runners_.GetUITaskRunner()->PostDelayedTask(
+    task_runners_.GetUITaskRunner()->PostTaskForTimeWithPriority(
         [self = weak_factory_.GetWeakPtr(),
          notify_idle_task_id = notify_idle_task_id_]() {
           if (!self) {
@@ -168,11 +208,48 @@ void Animator::BeginFrame(fml::TimePoint vsync_start_time,
                                                  100000);
           }
         },
-        kNotifyIdleTaskWaitTime);
+        fml::TimePoint::Now() + kNotifyIdleTaskWaitTime,
+        fml::TaskPriority::kIdle, fml::TimePoint::Max());
+  }
+}
+
+int64_t Animator::GetPredictedIdleDeadline() const {
+  // The next frame begins at the vsync the last frame targeted. Once that has
+  // passed, for example when a frame is requested after a pause, it begins at
+  // the next vsync on the cadence of the last frames, instead of the stale
+  // target leaving the VM no time at all.
+  fml::TimePoint next_vsync = last_frame_target_time_;
+  const fml::TimePoint now = fml::TimePoint::Now();
+  if (next_vsync < now && last_frame_interval_ > fml::TimeDelta::Zero()) {
+    const int64_t intervals = (now - next_vsync) / last_frame_interval_ + 1;
+    next_vsync = next_vsync + last_frame_interval_ * intervals;
+  }
+  return FxlToDartOrEarlier(next_vsync);
+}
+
+fml::TimePoint Animator::GetPresentationTargetTime() const {
+  if (!adaptive_pipeline_depth_) {
+    return last_frame_target_time_;
   }
+  // Each additional frame in flight delays the presentation of the frame
+  // being built by one frame interval. Animations should be sampled for the
+  // vsync at which the frame will actually be displayed.
+  const int64_t frames_ahead = layer_tree_pipeline_->GetEffectiveDepth() - 1;
+  return last_frame_target_time_ + last_frame_interval_ * frames_ahead;
 }
 
 void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
+  if (layer_tree->view_id() != kFlutterImplicitViewId) {
+    // The trees of the other views do not go through the pipeline. The
+    // framework renders them in the same frames as the implicit view, which
+    // the pipeline paces, and the shell drops the trees that the raster thread
+    // did not draw before a newer one for the same view came in.
+    layer_tree->RecordBuildTime(last_vsync_start_time_, last_frame_begin_time_,
+                                last_frame_target_time_);
+    delegate_.OnAnimatorDrawView(std::move(layer_tree));
+    return;
+  }
+
   if (dimension_change_pending_ &&
       layer_tree->frame_size() != last_layer_tree_size_) {
     dimension_change_pending_ = false;
@@ -197,6 +274,11 @@ bool Animator::CanReuseLastLayerTree() {
 }
 
 void Animator::DrawLastLayerTree() {
+  // This services the frame request like |BeginFrame| would, without calling
+  // into the framework, so that a frame requested only to show new texture
+  // frames does not leave the animator waiting for one.
+  TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending", frame_number_++);
+  frame_scheduled_ = false;
   pending_frame_semaphore_.Signal();
   delegate_.OnAnimatorDrawLastLayerTree();
 }
@@ -238,6 +320,7 @@ void Animator::AwaitVSync() {
       [self = weak_factory_.GetWeakPtr()](fml::TimePoint vsync_start_time,
                                           fml::TimePoint frame_target_time) {
         if (self) {
+          self->RunBeginFrameCallbacks();
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree();
           } else {
@@ -246,11 +329,41 @@ void Animator::AwaitVSync() {
         }
       });
 
-  delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
+  delegate_.OnAnimatorNotifyIdle(GetPredictedIdleDeadline());
 }
 
 void Animator::ScheduleSecondaryVsyncCallback(const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(callback);
 }
 
+void Animator::ScheduleBeginFrameCallback(const fml::closure& callback) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (!callback) {
+    return;
+  }
+  begin_frame_callbacks_.push_back(callback);
+
+  // The vsync callback of a pending frame runs the callbacks. Without one,
+  // the secondary callback provides the vsync. It runs after the main
+  // callback of the same vsync, so there is nothing left for it to do when
+  // a frame was pending.
+  waiter_->ScheduleSecondaryCallback([self = weak_factory_.GetWeakPtr()]() {
+    if (self) {
+      self->RunBeginFrameCallbacks();
+    }
+  });
+}
+
+void Animator::RunBeginFrameCallbacks() {
+  if (begin_frame_callbacks_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Animator::RunBeginFrameCallbacks");
+  auto callbacks = std::move(begin_frame_callbacks_);
+  begin_frame_callbacks_.clear();
+  for (const auto& callback : callbacks) {
+    callback();
+  }
+}
+
 }  // namespace flutter
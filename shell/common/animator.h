@@ -6,12 +6,15 @@
 #define FLUTTER_SHELL_COMMON_ANIMATOR_H_
 
 #include <deque>
+#include <vector>
 
+#include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/adaptive_pipeline_depth.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -39,11 +42,26 @@ class Animator final {
         fml::TimePoint frame_target_time) = 0;
 
     virtual void OnAnimatorDrawLastLayerTree() = 0;
+
+    // Called with the trees rendered for views other than the implicit view,
+    // which do not go through the pipeline.
+    virtual void OnAnimatorDrawView(
+        std::unique_ptr<flutter::LayerTree> layer_tree) = 0;
   };
 
+  //----------------------------------------------------------------------------
+  /// @param[in]  enable_adaptive_pipelining  Whether the number of frames in
+  ///                                         flight is adjusted to the build
+  ///                                         and raster times reported via
+  ///                                         |OnFrameRasterized| instead of
+  ///                                         being fixed.
+  ///
+  /// @see        `AdaptivePipelineDepth`
+  ///
   Animator(Delegate& delegate,
            TaskRunners task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           bool enable_adaptive_pipelining = false);
 
   ~Animator();
 
@@ -68,6 +86,20 @@ class Animator final {
   /// @see      `PointerDataDispatcher::ScheduleSecondaryVsyncCallback`.
   void ScheduleSecondaryVsyncCallback(const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Schedule a callback to be executed on the UI thread at the
+  ///           next vsync, before the animator decides whether the frame of
+  ///           that vsync needs a new layer tree.
+  ///
+  ///           A frame requested by the callback is therefore begun at the
+  ///           same vsync instead of the next one. If no frame is pending,
+  ///           the callback is still executed at vsync.
+  ///
+  ///           This callback is used by `LatchingPointerDataDispatcher`.
+  ///
+  /// @see      `PointerDataDispatcher::ScheduleBeginFrameCallback`.
+  void ScheduleBeginFrameCallback(const fml::closure& callback);
+
   void Start();
 
   void Stop();
@@ -78,12 +110,33 @@ class Animator final {
   // will be ended during the next |BeginFrame|.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  // Feeds the timings of a rasterized frame to the adaptive pipelining
+  // policy. Does nothing unless adaptive pipelining is enabled.
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  // Feeds how the recently presented frames met the display to the vsync
+  // waiter.
+  void OnPresentationFeedback(const PresentationFeedback& feedback);
+
+  // Forwards the frame rate preferred by the framework for the current scene
+  // to the vsync waiter. 0 restores the default rate of the display.
+  void SetPreferredFrameRate(double frames_per_second);
+
  private:
   using LayerTreePipeline = Pipeline<flutter::LayerTree>;
 
   void BeginFrame(fml::TimePoint frame_start_time,
                   fml::TimePoint frame_target_time);
 
+  // The target time handed to the framework for the frame about to be built.
+  fml::TimePoint GetPresentationTargetTime() const;
+
+  // The end of the window the UI thread is predicted to be idle for while it
+  // waits for the next vsync, as a Dart timeline timestamp.
+  int64_t GetPredictedIdleDeadline() const;
+
+  void RunBeginFrameCallbacks();
+
   bool CanReuseLastLayerTree();
   void DrawLastLayerTree();
 
@@ -98,8 +151,10 @@ class Animator final {
   fml::TimePoint last_frame_begin_time_;
   fml::TimePoint last_vsync_start_time_;
   fml::TimePoint last_frame_target_time_;
-  int64_t dart_frame_deadline_;
+  fml::TimeDelta last_frame_interval_;
   fml::RefPtr<LayerTreePipeline> layer_tree_pipeline_;
+  // Null unless adaptive pipelining is enabled.
+  std::unique_ptr<AdaptivePipelineDepth> adaptive_pipeline_depth_;
   fml::Semaphore pending_frame_semaphore_;
   LayerTreePipeline::ProducerContinuation producer_continuation_;
   int64_t frame_number_;
@@ -110,6 +165,7 @@ class Animator final {
   bool dimension_change_pending_;
   SkISize last_layer_tree_size_;
   std::deque<uint64_t> trace_flow_ids_;
+  std::vector<fml::closure> begin_frame_callbacks_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
@@ -9,6 +9,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -94,5 +95,61 @@ TEST_F(ShellTest, VSyncTargetTime) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, VsyncWaiterPacesTargetTimesToPresentationFeedback) {
+  TaskRunners task_runners = GetTaskRunnersForFixture();
+  auto vsync_waiter = std::make_shared<ConstantFiringVsyncWaiter>(task_runners);
+
+  PresentationFeedback feedback;
+  feedback.refresh_period = fml::TimeDelta::FromMicroseconds(8333);
+  vsync_waiter->UpdatePresentationFeedback(feedback);
+
+  fml::TimePoint target_time;
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetUITaskRunner(), [&vsync_waiter, &target_time, &latch]() {
+        vsync_waiter->AsyncWaitForVsync(
+            [&target_time, &latch](fml::TimePoint frame_start_time,
+                                   fml::TimePoint frame_target_time) {
+              target_time = frame_target_time;
+              latch.Signal();
+            });
+      });
+  latch.Wait();
+
+  ASSERT_EQ(target_time, ConstantFiringVsyncWaiter::frame_begin_time +
+                             fml::TimeDelta::FromMicroseconds(8333));
+}
+
+class FrameRateRecordingVsyncWaiter : public ConstantFiringVsyncWaiter {
+ public:
+  using ConstantFiringVsyncWaiter::ConstantFiringVsyncWaiter;
+
+  std::vector<double> frame_rates;
+
+ protected:
+  void OnPreferredFrameRateChanged(double frames_per_second) override {
+    frame_rates.push_back(frames_per_second);
+  }
+};
+
+TEST_F(ShellTest, VsyncWaiterForwardsPreferredFrameRateChanges) {
+  TaskRunners task_runners = GetTaskRunnersForFixture();
+  auto vsync_waiter =
+      std::make_shared<FrameRateRecordingVsyncWaiter>(task_runners);
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(task_runners.GetUITaskRunner(),
+                                    [&vsync_waiter, &latch]() {
+                                      vsync_waiter->SetPreferredFrameRate(120);
+                                      vsync_waiter->SetPreferredFrameRate(120);
+                                      vsync_waiter->SetPreferredFrameRate(30);
+                                      vsync_waiter->SetPreferredFrameRate(-1);
+                                      latch.Signal();
+                                    });
+  latch.Wait();
+
+  ASSERT_EQ(vsync_waiter->frame_rates, std::vector<double>({120, 30, 0}));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+void WriteAsset(const fml::ScopedTemporaryDirectory& dir,
+                const std::string& name,
+                const std::string& contents) {
+  ASSERT_TRUE(
+      fml::WriteAtomically(dir.fd(), name.c_str(), fml::DataMapping(contents)));
+}
+
+std::unique_ptr<AssetManager> CreateAssetManager(
+    const fml::ScopedTemporaryDirectory& dir) {
+  auto asset_manager = std::make_unique<AssetManager>();
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(dir.path().c_str(), false, fml::FilePermission::kRead),
+      false));
+  return asset_manager;
+}
+
+}  // namespace
+
+TEST(AssetManagerTest, CanPrefetchAssets) {
+  fml::ScopedTemporaryDirectory dir;
+  WriteAsset(dir, "image.png", "image");
+  auto asset_manager = CreateAssetManager(dir);
+
+  ASSERT_TRUE(asset_manager->PrefetchAsset("image.png"));
+  ASSERT_FALSE(asset_manager->PrefetchAsset("missing.png"));
+  ASSERT_FALSE(asset_manager->PrefetchAsset(""));
+}
+
+TEST(AssetManagerTest, PrefetchesAssetsOfTheManifest) {
+  fml::ScopedTemporaryDirectory dir;
+  WriteAsset(dir, "a.png", "a");
+  WriteAsset(dir, "b.json", "{}");
+  WriteAsset(dir, AssetManager::kPrefetchManifestName,
+             R"(["a.png", "missing.png", 42, "b.json"])");
+  auto asset_manager = CreateAssetManager(dir);
+
+  ASSERT_EQ(asset_manager->PrefetchManifestAssets(), 2u);
+}
+
+TEST(AssetManagerTest, PrefetchIsSkippedWithoutAValidManifest) {
+  fml::ScopedTemporaryDirectory dir;
+  WriteAsset(dir, "a.png", "a");
+  auto asset_manager = CreateAssetManager(dir);
+  ASSERT_EQ(asset_manager->PrefetchManifestAssets(), 0u);
+
+  WriteAsset(dir, AssetManager::kPrefetchManifestName, R"({"a.png": true})");
+  ASSERT_EQ(asset_manager->PrefetchManifestAssets(), 0u);
+}
+
+TEST(AssetManagerTest, CanMapAssetsExecutable) {
+  fml::ScopedTemporaryDirectory dir;
+  WriteAsset(dir, "isolate_snapshot_instr-2", "instructions");
+  auto asset_manager = CreateAssetManager(dir);
+
+  auto mapping =
+      asset_manager->GetAsExecutableMapping("isolate_snapshot_instr-2");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize()),
+            "instructions");
+  ASSERT_EQ(asset_manager->GetAsExecutableMapping("missing"), nullptr);
+  ASSERT_EQ(asset_manager->GetAsExecutableMapping(""), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,196 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/compressed_asset_bundle.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct TestAsset {
+  std::string name;
+  std::string contents;
+  CompressedAssetBundle::Method method;
+};
+
+template <typename T>
+void Append(std::vector<uint8_t>& data, T value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+std::vector<uint8_t> Compress(const std::string& contents) {
+  uLongf size = ::compressBound(contents.size());
+  std::vector<uint8_t> compressed(size);
+  EXPECT_EQ(::compress(compressed.data(), &size,
+                       reinterpret_cast<const Bytef*>(contents.data()),
+                       contents.size()),
+            Z_OK);
+  compressed.resize(size);
+  return compressed;
+}
+
+std::unique_ptr<fml::Mapping> CreateContainer(
+    const std::vector<TestAsset>& assets) {
+  std::vector<std::vector<uint8_t>> blobs;
+  size_t data_offset = 16;
+  for (const auto& asset : assets) {
+    data_offset += 32 + asset.name.size();
+    if (asset.method == CompressedAssetBundle::Method::kDeflate) {
+      blobs.push_back(Compress(asset.contents));
+    } else {
+      blobs.emplace_back(asset.contents.begin(), asset.contents.end());
+    }
+  }
+
+  std::vector<uint8_t> data;
+  Append<uint32_t>(data, 0x42414346);
+  Append<uint32_t>(data, 1);
+  Append<uint32_t>(data, assets.size());
+  Append<uint32_t>(data, 0);
+  for (size_t i = 0; i < assets.size(); i++) {
+    Append<uint32_t>(data, assets[i].name.size());
+    Append<uint32_t>(data, static_cast<uint32_t>(assets[i].method));
+    Append<uint64_t>(data, data_offset);
+    Append<uint64_t>(data, blobs[i].size());
+    Append<uint64_t>(data, assets[i].contents.size());
+    data.insert(data.end(), assets[i].name.begin(), assets[i].name.end());
+    data_offset += blobs[i].size();
+  }
+  for (const auto& blob : blobs) {
+    data.insert(data.end(), blob.begin(), blob.end());
+  }
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  if (!mapping) {
+    return "<missing>";
+  }
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+}  // namespace
+
+TEST(CompressedAssetBundleTest, CanReadStoredAndCompressedAssets) {
+  const std::string text(4096, 'a');
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<CompressedAssetBundle>(
+          CreateContainer({
+              {"assets/text.txt", text,
+               CompressedAssetBundle::Method::kDeflate},
+              {"assets/image.png", "png",
+               CompressedAssetBundle::Method::kStored},
+              {"empty", "", CompressedAssetBundle::Method::kDeflate},
+          }),
+          false);
+  ASSERT_TRUE(bundle->IsValid());
+
+  ASSERT_EQ(ToString(bundle->GetAsMapping("assets/text.txt")), text);
+  ASSERT_EQ(ToString(bundle->GetAsMapping("assets/image.png")), "png");
+  ASSERT_EQ(ToString(bundle->GetAsMapping("empty")), "");
+  ASSERT_EQ(ToString(bundle->GetAsMapping("missing")), "<missing>");
+  ASSERT_EQ(bundle->GetAsMappings(".*\\.png").size(), 1u);
+}
+
+TEST(CompressedAssetBundleTest, CorruptContainersAreInvalid) {
+  std::unique_ptr<AssetResolver> empty =
+      std::make_unique<CompressedAssetBundle>(
+          std::make_unique<fml::DataMapping>(std::vector<uint8_t>()), false);
+  ASSERT_FALSE(empty->IsValid());
+
+  auto container =
+      CreateContainer({{"a", "apple", CompressedAssetBundle::Method::kStored}});
+  std::vector<uint8_t> truncated(container->GetMapping(),
+                                 container->GetMapping() + 20);
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<CompressedAssetBundle>(
+          std::make_unique<fml::DataMapping>(std::move(truncated)), false);
+  ASSERT_FALSE(bundle->IsValid());
+  ASSERT_EQ(bundle->GetAsMapping("a"), nullptr);
+}
+
+TEST(CompressedAssetBundleTest, IndexRecordsAreCheckedAgainstTheContainer) {
+  // The record of the only entry starts after the 16 byte header.
+  constexpr size_t kRecordOffset = 16;
+  constexpr size_t kDataOffsetField = kRecordOffset + 8;
+  constexpr size_t kSizeField = kRecordOffset + 24;
+  const std::string text(100, 't');
+  auto container =
+      CreateContainer({{"t", text, CompressedAssetBundle::Method::kDeflate}});
+
+  auto make_bundle = [&container](size_t field, uint64_t value) {
+    std::vector<uint8_t> data(container->GetMapping(),
+                              container->GetMapping() + container->GetSize());
+    memcpy(data.data() + field, &value, sizeof(value));
+    return std::make_unique<CompressedAssetBundle>(
+        std::make_unique<fml::DataMapping>(std::move(data)), false);
+  };
+
+  // A size that no deflate stream of the entry's length decompresses to.
+  std::unique_ptr<AssetResolver> huge = make_bundle(kSizeField, 1ull << 40);
+  ASSERT_FALSE(huge->IsValid());
+  ASSERT_EQ(huge->GetAsMapping("t"), nullptr);
+
+  // Data that overlaps the index.
+  std::unique_ptr<AssetResolver> overlapping =
+      make_bundle(kDataOffsetField, kRecordOffset);
+  ASSERT_FALSE(overlapping->IsValid());
+
+  // Data that runs past the end of the container.
+  std::unique_ptr<AssetResolver> past_end =
+      make_bundle(kDataOffsetField, container->GetSize() - 1);
+  ASSERT_FALSE(past_end->IsValid());
+
+  // An entry count that the container is too small to hold.
+  std::unique_ptr<AssetResolver> too_many = make_bundle(8, 0xffffffffu);
+  ASSERT_FALSE(too_many->IsValid());
+
+  std::unique_ptr<AssetResolver> intact = make_bundle(kSizeField, text.size());
+  ASSERT_TRUE(intact->IsValid());
+  ASSERT_EQ(ToString(intact->GetAsMapping("t")), text);
+}
+
+TEST(CompressedAssetBundleTest, DecompressedAssetsAreEvictedLeastRecentFirst) {
+  const std::string a(1000, 'a');
+  const std::string b(1000, 'b');
+  const std::string c(1000, 'c');
+  auto bundle = std::make_unique<CompressedAssetBundle>(
+      CreateContainer({
+          {"a", a, CompressedAssetBundle::Method::kDeflate},
+          {"b", b, CompressedAssetBundle::Method::kDeflate},
+          {"c", c, CompressedAssetBundle::Method::kDeflate},
+      }),
+      false, 2500);
+  AssetResolver* resolver = bundle.get();
+
+  auto mapping_a = resolver->GetAsMapping("a");
+  ASSERT_EQ(resolver->GetAsMapping("b")->GetSize(), 1000u);
+  ASSERT_EQ(bundle->GetCachedBytes(), 2000u);
+
+  // Touching "a" makes "b" the least recently used entry.
+  ASSERT_EQ(resolver->GetAsMapping("a")->GetMapping(),
+            mapping_a->GetMapping());
+  ASSERT_EQ(resolver->GetAsMapping("c")->GetSize(), 1000u);
+  ASSERT_EQ(bundle->GetCachedBytes(), 2000u);
+  ASSERT_EQ(resolver->GetAsMapping("a")->GetMapping(),
+            mapping_a->GetMapping());
+
+  // Evicting "a" does not invalidate a mapping handed out before.
+  resolver->GetAsMapping("b");
+  resolver->GetAsMapping("c");
+  ASSERT_NE(resolver->GetAsMapping("a")->GetMapping(),
+            mapping_a->GetMapping());
+  ASSERT_EQ(ToString(mapping_a), a);
+}
+
+}  // namespace testing
+}  // namespace flutter
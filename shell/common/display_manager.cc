@@ -31,6 +31,9 @@ void DisplayManager::HandleDisplayUpdates(DisplayUpdateType update_type,
       FML_CHECK(displays_.empty());
       displays_ = displays;
       return;
+    case DisplayUpdateType::kConfigurationChanged:
+      displays_ = displays;
+      return;
     default:
       FML_CHECK(false) << "Unknown DisplayUpdateType.";
   }
@@ -20,7 +20,11 @@ enum class DisplayUpdateType {
   ///    1. The frame buffer hardware is connected.
   ///    2. The display is drawable, e.g. it isn't being mirrored from another
   ///       connected display or sleeping.
-  kStartup
+  kStartup,
+  /// The configuration of the displays changed, for example because the
+  /// refresh rate of the main display was switched. The displays replace the
+  /// ones that were previously reported.
+  kConfigurationChanged,
 };
 
 /// Manages lifecycle of the connected displays. This class is thread-safe.
@@ -13,12 +13,14 @@
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/lib/snapshot/snapshot.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/glyph_usage.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/shell.h"
 #include "rapidjson/document.h"
@@ -34,6 +36,33 @@ static constexpr char kNavigationChannel[] = "flutter/navigation";
 static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
+static constexpr char kLoadingUnitDataAssetPrefix[] = "isolate_snapshot_data-";
+static constexpr char kLoadingUnitInstructionsAssetPrefix[] =
+    "isolate_snapshot_instr-";
+
+// Counts the generations of the Dart heap that shrank from |before| to
+// |after| in |scavenges| and |old_gen_collections|.
+static void CountDartCollections(const std::optional<DartHeapUsage>& before,
+                                 const std::optional<DartHeapUsage>& after,
+                                 const char* trace_name,
+                                 uint64_t* scavenges,
+                                 uint64_t* old_gen_collections) {
+  if (!before || !after) {
+    return;
+  }
+  const bool scavenged = after->new_used_bytes < before->new_used_bytes;
+  const bool old_gen_collected = after->old_used_bytes < before->old_used_bytes;
+  if (scavenged) {
+    (*scavenges)++;
+  }
+  if (old_gen_collected) {
+    (*old_gen_collections)++;
+  }
+  if (scavenged || old_gen_collected) {
+    TRACE_EVENT_INSTANT1("flutter", trace_name, "generation",
+                         old_gen_collected ? "old" : "new");
+  }
+}
 
 Engine::Engine(
     Delegate& delegate,
@@ -43,6 +72,7 @@ Engine::Engine(
     Settings settings,
     std::unique_ptr<Animator> animator,
     fml::WeakPtr<IOManager> io_manager,
+    std::shared_ptr<FontCollection> font_collection,
     std::unique_ptr<RuntimeController> runtime_controller)
     : delegate_(delegate),
       settings_(std::move(settings)),
@@ -50,10 +80,18 @@ Engine::Engine(
       runtime_controller_(std::move(runtime_controller)),
       activity_running_(true),
       have_surface_(false),
+      font_collection_(std::move(font_collection)),
       image_decoder_(task_runners, image_decoder_task_runner, io_manager),
       task_runners_(std::move(task_runners)),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
+  image_decoder_.SetParallelDecodePixelThreshold(
+      settings_.parallel_image_decode_pixel_threshold);
+  image_decoder_.SetYUVUploadEnabled(settings_.enable_yuv_image_upload);
+  image_decoder_.SetAnimatedFrameAheadBytes(
+      settings_.animated_image_frame_ahead_bytes);
+  image_decoder_.SetPlatformDecodePixelThreshold(
+      settings_.platform_image_decode_pixel_threshold);
 }
 
 Engine::Engine(Delegate& delegate,
@@ -74,6 +112,7 @@ Engine::Engine(Delegate& delegate,
              settings,
              std::move(animator),
              io_manager,
+             std::make_shared<FontCollection>(),
              nullptr) {
   runtime_controller_ = std::make_unique<RuntimeController>(
       *this,                                 // runtime delegate
@@ -95,6 +134,37 @@ Engine::Engine(Delegate& delegate,
   );
 }
 
+std::unique_ptr<Engine> Engine::Spawn(
+    Delegate& delegate,
+    const PointerDataDispatcherMaker& dispatcher_maker,
+    Settings settings,
+    std::unique_ptr<Animator> animator,
+    fml::WeakPtr<IOManager> io_manager,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue,
+    fml::WeakPtr<SnapshotDelegate> snapshot_delegate) const {
+  auto result = std::make_unique<Engine>(
+      delegate,                                  //
+      dispatcher_maker,                          //
+      image_decoder_.GetConcurrentTaskRunner(),  //
+      task_runners_,                             //
+      std::move(settings),                       //
+      std::move(animator),                       //
+      io_manager,                                //
+      font_collection_,                          //
+      nullptr                                    //
+  );
+  result->is_spawned_ = true;
+  result->runtime_controller_ = runtime_controller_->Spawn(
+      *result,                             // runtime delegate
+      std::move(snapshot_delegate),        // snapshot delegate
+      result->GetWeakPtr(),                // hint freed delegate
+      std::move(io_manager),               // io manager
+      std::move(unref_queue),              // Skia unref queue
+      result->image_decoder_.GetWeakPtr()  // image decoder
+  );
+  return result;
+}
+
 Engine::~Engine() = default;
 
 fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
@@ -102,8 +172,19 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 }
 
 void Engine::SetupDefaultFontManager() {
+  if (is_spawned_) {
+    return;
+  }
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
-  font_collection_.SetupDefaultFontManager();
+  font_collection_->SetupDefaultFontManager();
+}
+
+void Engine::SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache) {
+  image_decoder_.SetDecodedImageCache(std::move(cache));
+}
+
+void Engine::SetResourceContextPool(std::shared_ptr<ResourceContextPool> pool) {
+  image_decoder_.SetResourceContextPool(std::move(pool));
 }
 
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
@@ -123,10 +204,10 @@ bool Engine::UpdateAssetManager(
   }
 
   // Using libTXT as the text engine.
-  font_collection_.RegisterFonts(asset_manager_);
+  font_collection_->RegisterFonts(asset_manager_);
 
   if (settings_.use_test_fonts) {
-    font_collection_.RegisterTestFonts();
+    font_collection_->RegisterTestFonts();
   }
 
   return true;
@@ -139,6 +220,7 @@ bool Engine::Restart(RunConfiguration configuration) {
     return false;
   }
   delegate_.OnPreEngineRestart();
+  semantics_tree_.Reset();
   runtime_controller_ = runtime_controller_->Clone();
   UpdateAssetManager(nullptr);
   return Run(std::move(configuration)) == Engine::RunStatus::Success;
@@ -184,7 +266,12 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
 
 void Engine::BeginFrame(fml::TimePoint frame_time) {
   TRACE_EVENT0("flutter", "Engine::BeginFrame");
+  const auto heap_usage = runtime_controller_->GetDartHeapUsage();
   runtime_controller_->BeginFrame(frame_time);
+  dart_gc_stats_.frames++;
+  CountDartCollections(heap_usage, runtime_controller_->GetDartHeapUsage(),
+                       "DartGCDuringFrame", &dart_gc_stats_.frame_scavenges,
+                       &dart_gc_stats_.frame_old_gen_collections);
 }
 
 void Engine::ReportTimings(std::vector<int64_t> timings) {
@@ -192,6 +279,14 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
 
+void Engine::OnFrameRasterized(const FrameTiming& timing) {
+  animator_->OnFrameRasterized(timing);
+}
+
+void Engine::OnPresentationFeedback(const PresentationFeedback& feedback) {
+  animator_->OnPresentationFeedback(feedback);
+}
+
 void Engine::HintFreed(size_t size) {
   hint_freed_bytes_since_last_idle_ += size;
 }
@@ -200,8 +295,13 @@ void Engine::NotifyIdle(int64_t deadline) {
   auto trace_event = std::to_string(deadline - Dart_TimelineGetMicros());
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
                trace_event.c_str());
+  const auto heap_usage = runtime_controller_->GetDartHeapUsage();
   runtime_controller_->NotifyIdle(deadline, hint_freed_bytes_since_last_idle_);
   hint_freed_bytes_since_last_idle_ = 0;
+  dart_gc_stats_.idle_notifications++;
+  CountDartCollections(heap_usage, runtime_controller_->GetDartHeapUsage(),
+                       "DartGCWhileIdle", &dart_gc_stats_.idle_scavenges,
+                       &dart_gc_stats_.idle_old_gen_collections);
 }
 
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -224,6 +324,18 @@ tonic::DartErrorHandleType Engine::GetUIIsolateLastError() {
   return runtime_controller_->GetLastError();
 }
 
+std::optional<DartHeapUsage> Engine::GetUIIsolateHeapUsage() {
+  return runtime_controller_->GetDartHeapUsage();
+}
+
+const Engine::DartGCStats& Engine::GetDartGCStats() const {
+  return dart_gc_stats_;
+}
+
+void Engine::ResetDartGCStats() {
+  dart_gc_stats_ = {};
+}
+
 void Engine::OnOutputSurfaceCreated() {
   have_surface_ = true;
   StartAnimatorIfPossible();
@@ -242,6 +354,7 @@ void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
       viewport_metrics_.device_pixel_ratio != metrics.device_pixel_ratio;
   viewport_metrics_ = metrics;
   runtime_controller_->SetViewportMetrics(viewport_metrics_);
+  PrewarmGlyphs(viewport_metrics_.device_pixel_ratio);
   if (animator_) {
     if (dimensions_changed) {
       animator_->SetDimensionChangePending();
@@ -252,6 +365,45 @@ void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
   }
 }
 
+void Engine::SetViewportMetrics(int64_t view_id,
+                                const ViewportMetrics& metrics) {
+  runtime_controller_->SetViewportMetrics(view_id, metrics);
+  if (animator_ && have_surface_) {
+    ScheduleFrame();
+  }
+}
+
+void Engine::RemoveView(int64_t view_id) {
+  runtime_controller_->RemoveView(view_id);
+}
+
+void Engine::PrewarmGlyphs(double device_pixel_ratio) {
+  if (glyph_prewarm_started_ || !(device_pixel_ratio > 0) || !asset_manager_) {
+    return;
+  }
+  glyph_prewarm_started_ = true;
+
+  std::unique_ptr<fml::Mapping> json =
+      asset_manager_->GetAsMapping(kGlyphUsageAssetName);
+  const auto& task_runner = image_decoder_.GetConcurrentTaskRunner();
+  if (!json || !task_runner) {
+    return;
+  }
+
+  task_runner->PostTask(fml::MakeCopyable(
+      [json = std::move(json),
+       font_collection = font_collection_->GetFontCollection(),
+       scale = static_cast<float>(device_pixel_ratio)]() {
+        TRACE_EVENT0("flutter", "Engine::PrewarmGlyphs");
+        txt::GlyphUsageRecorder::Usage usage;
+        if (!GlyphUsageFromJSON(*json, &usage)) {
+          FML_LOG(ERROR) << "Could not parse " << kGlyphUsageAssetName;
+          return;
+        }
+        txt::GlyphUsageRecorder::Prewarm(usage, *font_collection, scale);
+      }));
+}
+
 void Engine::DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) {
   std::string channel = message->channel();
   if (channel == kLifecycleChannel) {
@@ -282,7 +434,8 @@ void Engine::DispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) {
 
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string state(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string state(reinterpret_cast<const char*>(data.GetMapping()),
+                    data.GetSize());
   if (state == "AppLifecycleState.paused" ||
       state == "AppLifecycleState.detached") {
     activity_running_ = false;
@@ -309,7 +462,8 @@ bool Engine::HandleNavigationPlatformMessage(
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -327,7 +481,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject()) {
     return false;
   }
@@ -367,7 +522,8 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
 
 void Engine::HandleSettingsPlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
-  std::string jsonData(reinterpret_cast<const char*>(data.data()), data.size());
+  std::string jsonData(reinterpret_cast<const char*>(data.GetMapping()),
+                       data.GetSize());
   if (runtime_controller_->SetUserSettingsData(std::move(jsonData)) &&
       have_surface_) {
     ScheduleFrame();
@@ -389,6 +545,8 @@ void Engine::DispatchSemanticsAction(int id,
 }
 
 void Engine::SetSemanticsEnabled(bool enabled) {
+  // The framework sends the whole tree once semantics are enabled again.
+  semantics_tree_.Reset();
   runtime_controller_->SetSemanticsEnabled(enabled);
 }
 
@@ -428,22 +586,81 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
     return;
   }
 
+  if (last_dispatched_pointer_flow_id_) {
+    layer_tree->set_dispatched_pointer_flow_id(
+        *last_dispatched_pointer_flow_id_);
+  }
   animator_->Render(std::move(layer_tree));
 }
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
                              CustomAccessibilityActionUpdates actions) {
+  update = semantics_tree_.Update(std::move(update));
+  if (update.empty() && actions.empty()) {
+    return;
+  }
   delegate_.OnEngineUpdateSemantics(std::move(update), std::move(actions));
 }
 
 void Engine::HandlePlatformMessage(fml::RefPtr<PlatformMessage> message) {
   if (message->channel() == kAssetChannel) {
     HandleAssetPlatformMessage(std::move(message));
+    return;
+  }
+
+  auto batching = batched_channels_.find(message->channel());
+  if (batching != batched_channels_.end()) {
+    BatchPlatformMessage(std::move(message), batching->second);
   } else {
     delegate_.OnEngineHandlePlatformMessage(std::move(message));
   }
 }
 
+void Engine::SetPlatformMessageChannelBatching(
+    const std::string& channel,
+    PlatformMessageBatching batching) {
+  if (batching == PlatformMessageBatching::kNone) {
+    batched_channels_.erase(channel);
+  } else {
+    batched_channels_[channel] = batching;
+  }
+}
+
+void Engine::BatchPlatformMessage(fml::RefPtr<PlatformMessage> message,
+                                  PlatformMessageBatching batching) {
+  if (batching == PlatformMessageBatching::kKeepLatest) {
+    for (auto& pending : batched_platform_messages_) {
+      if (pending->channel() == message->channel()) {
+        if (auto response = pending->response()) {
+          response->CompleteEmpty();
+        }
+        pending = std::move(message);
+        return;
+      }
+    }
+  }
+
+  batched_platform_messages_.push_back(std::move(message));
+  if (batched_platform_messages_flush_posted_) {
+    return;
+  }
+  batched_platform_messages_flush_posted_ = true;
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = weak_factory_.GetWeakPtr()]() {
+        if (engine) {
+          engine->FlushBatchedPlatformMessages();
+        }
+      });
+}
+
+void Engine::FlushBatchedPlatformMessages() {
+  TRACE_EVENT0("flutter", "Engine::FlushBatchedPlatformMessages");
+  batched_platform_messages_flush_posted_ = false;
+  delegate_.OnEngineHandlePlatformMessages(
+      std::move(batched_platform_messages_));
+  batched_platform_messages_.clear();
+}
+
 void Engine::OnRootIsolateCreated() {
   delegate_.OnRootIsolateCreated();
 }
@@ -458,17 +675,77 @@ std::unique_ptr<std::vector<std::string>> Engine::ComputePlatformResolvedLocale(
   return delegate_.ComputePlatformResolvedLocale(supported_locale_data);
 }
 
+void Engine::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
+  if (!asset_manager_) {
+    delegate_.RequestDartDeferredLibrary(loading_unit_id);
+    return;
+  }
+
+  // Map the loading unit off the UI thread. Its instructions are only paged
+  // in as they are executed.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [asset_manager = asset_manager_, engine = GetWeakPtr(),
+       ui_task_runner = task_runners_.GetUITaskRunner(), loading_unit_id]() {
+        TRACE_EVENT0("flutter", "Engine::RequestDartDeferredLibrary");
+        const std::string id = std::to_string(loading_unit_id);
+        std::unique_ptr<fml::Mapping> data =
+            asset_manager->GetAsMapping(kLoadingUnitDataAssetPrefix + id);
+        std::unique_ptr<fml::Mapping> instructions;
+        if (data) {
+          instructions = asset_manager->GetAsExecutableMapping(
+              kLoadingUnitInstructionsAssetPrefix + id);
+        }
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [engine, loading_unit_id, data = std::move(data),
+             instructions = std::move(instructions)]() mutable {
+              if (!engine) {
+                return;
+              }
+              if (data && instructions) {
+                engine->LoadDartDeferredLibrary(
+                    loading_unit_id, std::move(data), std::move(instructions));
+              } else {
+                engine->delegate_.RequestDartDeferredLibrary(loading_unit_id);
+              }
+            }));
+      });
+}
+
+void Engine::LoadDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  if (!runtime_controller_->LoadDartDeferredLibrary(
+          loading_unit_id, std::move(snapshot_data),
+          std::move(snapshot_instructions))) {
+    FML_LOG(ERROR) << "Could not load deferred loading unit "
+                   << loading_unit_id;
+  }
+}
+
+void Engine::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
+                                          const std::string& error_message,
+                                          bool transient) {
+  runtime_controller_->LoadDartDeferredLibraryError(loading_unit_id,
+                                                    error_message, transient);
+}
+
 void Engine::SetNeedsReportTimings(bool needs_reporting) {
   delegate_.SetNeedsReportTimings(needs_reporting);
 }
 
+void Engine::SetPreferredFrameRate(double frames_per_second) {
+  animator_->SetPreferredFrameRate(frames_per_second);
+}
+
 FontCollection& Engine::GetFontCollection() {
-  return font_collection_;
+  return *font_collection_;
 }
 
 void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
   animator_->EnqueueTraceFlowId(trace_flow_id);
+  last_dispatched_pointer_flow_id_ = trace_flow_id;
   if (runtime_controller_) {
     runtime_controller_->DispatchPointerDataPacket(*packet);
   }
@@ -478,25 +755,41 @@ void Engine::ScheduleSecondaryVsyncCallback(const fml::closure& callback) {
   animator_->ScheduleSecondaryVsyncCallback(callback);
 }
 
+void Engine::ScheduleBeginFrameCallback(const fml::closure& callback) {
+  animator_->ScheduleBeginFrameCallback(callback);
+}
+
 void Engine::HandleAssetPlatformMessage(fml::RefPtr<PlatformMessage> message) {
   fml::RefPtr<PlatformMessageResponse> response = message->response();
   if (!response) {
     return;
   }
   const auto& data = message->data();
-  std::string asset_name(reinterpret_cast<const char*>(data.data()),
-                         data.size());
-
-  if (asset_manager_) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset_name);
-    if (asset_mapping) {
-      response->Complete(std::move(asset_mapping));
-      return;
-    }
+  std::string asset_name(reinterpret_cast<const char*>(data.GetMapping()),
+                         data.GetSize());
+
+  if (!asset_manager_) {
+    response->CompleteEmpty();
+    return;
   }
 
-  response->CompleteEmpty();
+  // Read the asset on the IO thread so that the UI thread neither waits on
+  // storage nor faults in the pages of the mapping when the response is
+  // copied into the Dart heap. Responses may be completed on any thread.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [asset_manager = asset_manager_, asset_name = std::move(asset_name),
+       response = std::move(response)]() {
+        TRACE_EVENT0("flutter", "Engine::HandleAssetPlatformMessage");
+        std::unique_ptr<fml::Mapping> asset_mapping =
+            asset_manager->GetAsMapping(asset_name);
+        if (!asset_mapping) {
+          response->CompleteEmpty();
+          return;
+        }
+        const uint8_t* data = asset_mapping->GetMapping();
+        response->Complete(std::make_unique<fml::DataMapping>(
+            std::vector<uint8_t>(data, data + asset_mapping->GetSize())));
+      });
 }
 
 const std::string& Engine::GetLastEntrypoint() const {
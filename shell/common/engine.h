@@ -6,7 +6,10 @@
 #define SHELL_COMMON_ENGINE_H_
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
@@ -16,6 +19,7 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/semantics_tree.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -128,6 +132,31 @@ class Engine final : public RuntimeDelegate,
     Failure,
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      How the platform messages the framework sends on a channel are
+  ///             forwarded to the delegate.
+  ///
+  enum class PlatformMessageBatching {
+    //--------------------------------------------------------------------------
+    /// Each message is forwarded on its own as soon as it is sent.
+    ///
+    kNone,
+
+    //--------------------------------------------------------------------------
+    /// The messages sent before the UI task runner gets to its next task are
+    /// forwarded together, in order, with
+    /// `Delegate::OnEngineHandlePlatformMessages`.
+    ///
+    kBatch,
+
+    //--------------------------------------------------------------------------
+    /// Like `kBatch`, but only the last of the batched messages of the channel
+    /// is forwarded. The responses of the messages it supersedes are completed
+    /// empty. This suits channels that send state updates.
+    ///
+    kKeepLatest,
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      While the engine operates entirely on the UI task runner, it
   ///             needs the capabilities of the other components to fulfill the
@@ -177,6 +206,18 @@ class Engine final : public RuntimeDelegate,
     virtual void OnEngineHandlePlatformMessage(
         fml::RefPtr<PlatformMessage> message) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Like `OnEngineHandlePlatformMessage`, but for a batch of
+    ///             messages of channels whose messages are batched. The
+    ///             messages should be forwarded to the platform together.
+    ///
+    /// @see        `Engine::SetPlatformMessageChannelBatching`
+    ///
+    /// @param[in]  messages  The messages, in the order they were sent.
+    ///
+    virtual void OnEngineHandlePlatformMessages(
+        std::vector<fml::RefPtr<PlatformMessage>> messages) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Notifies the delegate that the root isolate of the
     ///             application is about to be discarded and a new isolate with
@@ -260,6 +301,19 @@ class Engine final : public RuntimeDelegate,
     virtual std::unique_ptr<std::vector<std::string>>
     ComputePlatformResolvedLocale(
         const std::vector<std::string>& supported_locale_data) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Invoked when the root isolate requests a deferred loading
+    ///             unit that is not bundled with the assets of the engine. The
+    ///             delegate completes the request with
+    ///             `Engine::LoadDartDeferredLibrary` or
+    ///             `Engine::LoadDartDeferredLibraryError` once the platform
+    ///             provided the loading unit, for example after downloading
+    ///             it.
+    ///
+    /// @param[in]  loading_unit_id  The identifier of the loading unit.
+    ///
+    virtual void RequestDartDeferredLibrary(intptr_t loading_unit_id) = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -274,6 +328,7 @@ class Engine final : public RuntimeDelegate,
          Settings settings,
          std::unique_ptr<Animator> animator,
          fml::WeakPtr<IOManager> io_manager,
+         std::shared_ptr<FontCollection> font_collection,
          std::unique_ptr<RuntimeController> runtime_controller);
 
   //----------------------------------------------------------------------------
@@ -339,6 +394,35 @@ class Engine final : public RuntimeDelegate,
   ///
   ~Engine() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an engine for another shell that shares the font
+  ///             collection and the task runners of this engine, and whose
+  ///             root isolate joins the isolate group of the root isolate of
+  ///             this engine. Called by the spawned shell on the UI task
+  ///             runner, which it shares with this engine.
+  ///
+  /// @param      delegate           The shell of the spawned engine.
+  /// @param      dispatcher_maker   The pointer data dispatcher maker of the
+  ///                                platform view of the spawned shell.
+  /// @param[in]  settings           The settings of the spawned shell.
+  /// @param[in]  animator           The animator of the spawned shell.
+  /// @param[in]  io_manager         The IO manager of the spawned shell.
+  /// @param[in]  unref_queue        The Skia unref queue of the spawned shell.
+  /// @param[in]  snapshot_delegate  The snapshot delegate of the spawned
+  ///                                shell.
+  ///
+  /// @return     The engine for the spawned shell. Its root isolate still has
+  ///             to be launched with `Run`.
+  ///
+  std::unique_ptr<Engine> Spawn(
+      Delegate& delegate,
+      const PointerDataDispatcherMaker& dispatcher_maker,
+      Settings settings,
+      std::unique_ptr<Animator> animator,
+      fml::WeakPtr<IOManager> io_manager,
+      fml::RefPtr<SkiaUnrefQueue> unref_queue,
+      fml::WeakPtr<SnapshotDelegate> snapshot_delegate) const;
+
   //----------------------------------------------------------------------------
   /// @return     The pointer to this instance of the engine. The engine may
   ///             only be accessed safely on the UI task runner.
@@ -534,6 +618,25 @@ class Engine final : public RuntimeDelegate,
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that a frame was rasterized so that the
+  ///             animator can adapt how many frames it keeps in flight. Only
+  ///             called when `Settings::enable_adaptive_frame_pipelining` is
+  ///             set.
+  ///
+  /// @param[in]  timing  The timings of the rasterized frame.
+  ///
+  void OnFrameRasterized(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine of how the recently presented frames met
+  ///             the display so that the vsync waiter can pace frames to the
+  ///             refresh period the display actually runs at.
+  ///
+  /// @param[in]  feedback  The feedback of the presentation engine.
+  ///
+  void OnPresentationFeedback(const PresentationFeedback& feedback);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -595,6 +698,34 @@ class Engine final : public RuntimeDelegate,
   ///
   tonic::DartErrorHandleType GetUIIsolateLastError();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the heap usage of the isolate group of the root isolate.
+  ///
+  /// @return     The heap usage, or `std::nullopt` if the root isolate is not
+  ///             running.
+  ///
+  std::optional<DartHeapUsage> GetUIIsolateHeapUsage();
+
+  //----------------------------------------------------------------------------
+  /// @brief      How many of the frame builds and idle notifications saw the
+  ///             Dart VM collect garbage. A collection is inferred from the
+  ///             used size of a generation shrinking, so collections that
+  ///             free nothing are missed, and the old generation also shrinks
+  ///             when it is swept concurrently.
+  ///
+  struct DartGCStats {
+    uint64_t frames = 0;
+    uint64_t frame_scavenges = 0;
+    uint64_t frame_old_gen_collections = 0;
+    uint64_t idle_notifications = 0;
+    uint64_t idle_scavenges = 0;
+    uint64_t idle_old_gen_collections = 0;
+  };
+
+  const DartGCStats& GetDartGCStats() const;
+
+  void ResetDartGCStats();
+
   //----------------------------------------------------------------------------
   /// @brief      As described in the discussion for `UIIsolateHasLivePorts`,
   ///             the "done-ness" of a Dart application is tricky to ascertain
@@ -643,6 +774,37 @@ class Engine final : public RuntimeDelegate,
   ///
   void OnOutputSurfaceDestroyed();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the cache of decoded images that the image decoder of
+  ///             this engine consults before decoding compressed images. The
+  ///             cache is owned by the IO manager of the shell.
+  ///
+  /// @param[in]  cache  The cache, or null to decode every image.
+  ///
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the pool of resource contexts that the image decoder of
+  ///             this engine uploads decoded images with. The pool is owned
+  ///             by the IO manager of the shell.
+  ///
+  /// @param[in]  pool  The pool, or null to upload every image on the IO
+  ///                   thread.
+  ///
+  void SetResourceContextPool(std::shared_ptr<ResourceContextPool> pool);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets how the platform messages the framework sends on
+  ///             `channel` are forwarded to the platform. Batching saves a
+  ///             platform task per message for channels that send many small
+  ///             messages per frame.
+  ///
+  /// @param[in]  channel   The name of the channel.
+  /// @param[in]  batching  How the messages of the channel are forwarded.
+  ///
+  void SetPlatformMessageChannelBatching(const std::string& channel,
+                                         PlatformMessageBatching batching);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the viewport metrics for the currently running Flutter
   ///             application. The viewport metrics detail the size of the
@@ -655,6 +817,28 @@ class Engine final : public RuntimeDelegate,
   ///
   void SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Updates the viewport metrics of a view that the platform
+  ///             renders in addition to the implicit view, and adds the view
+  ///             to the running Flutter application if it does not know it
+  ///             yet. The framework renders the views of the application in
+  ///             the same frame.
+  ///
+  /// @see        `PlatformView::AddView`
+  ///
+  /// @param[in]  view_id  The id of the view.
+  /// @param[in]  metrics  The metrics of the view.
+  ///
+  void SetViewportMetrics(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a view added with the view id overload of
+  ///             `SetViewportMetrics` from the running Flutter application.
+  ///
+  /// @param[in]  view_id  The id of the view.
+  ///
+  void RemoveView(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a message.
   ///             This call originates in the platform view and has been
@@ -739,8 +923,8 @@ class Engine final : public RuntimeDelegate,
   // |RuntimeDelegate|
   FontCollection& GetFontCollection() override;
 
-  // Return the asset manager associated with the current engine, or nullptr.
-  std::shared_ptr<AssetManager> GetAssetManager();
+  // |RuntimeDelegate|
+  std::shared_ptr<AssetManager> GetAssetManager() override;
 
   // |PointerDataDispatcher::Delegate|
   void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
@@ -749,6 +933,9 @@ class Engine final : public RuntimeDelegate,
   // |PointerDataDispatcher::Delegate|
   void ScheduleSecondaryVsyncCallback(const fml::closure& callback) override;
 
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleBeginFrameCallback(const fml::closure& callback) override;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint that was used in the RunConfiguration
   ///             when |Engine::Run| was called.
@@ -761,6 +948,32 @@ class Engine final : public RuntimeDelegate,
   ///
   const std::string& GetLastEntrypointLibrary() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Completes a request of the root isolate to load a deferred
+  ///             loading unit with its snapshot.
+  ///
+  /// @param[in]  loading_unit_id        The identifier of the loading unit.
+  /// @param[in]  snapshot_data          The heap snapshot of the loading unit.
+  /// @param[in]  snapshot_instructions  The instructions snapshot of the
+  ///                                    loading unit, mapped executable.
+  ///
+  void LoadDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fails a request of the root isolate to load a deferred
+  ///             loading unit.
+  ///
+  /// @param[in]  loading_unit_id  The identifier of the loading unit.
+  /// @param[in]  error_message    Why the loading unit could not be loaded.
+  /// @param[in]  transient        Whether loading it may be retried.
+  ///
+  void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
+                                    const std::string& error_message,
+                                    bool transient);
+
   //----------------------------------------------------------------------------
   /// @brief      Getter for the initial route.  This can be set with a platform
   ///             message.
@@ -785,10 +998,26 @@ class Engine final : public RuntimeDelegate,
   std::shared_ptr<AssetManager> asset_manager_;
   bool activity_running_;
   bool have_surface_;
-  FontCollection font_collection_;
+  // Shared with the engines spawned from this one.
+  std::shared_ptr<FontCollection> font_collection_;
+  // Whether the font collection is owned by the engine this one was spawned
+  // from, which already set up its default font manager.
+  bool is_spawned_ = false;
   ImageDecoder image_decoder_;
   TaskRunners task_runners_;
   size_t hint_freed_bytes_since_last_idle_ = 0;
+  DartGCStats dart_gc_stats_;
+  bool glyph_prewarm_started_ = false;
+  std::unordered_map<std::string, PlatformMessageBatching> batched_channels_;
+  // The messages of batched channels waiting for the flush task.
+  std::vector<fml::RefPtr<PlatformMessage>> batched_platform_messages_;
+  bool batched_platform_messages_flush_posted_ = false;
+  // The semantics tree last sent to the delegate. Only the nodes that changed
+  // since are sent.
+  SemanticsTree semantics_tree_;
+  // The trace flow id of the last pointer data packet dispatched to the
+  // framework, recorded in the layer trees it renders.
+  std::optional<uint64_t> last_dispatched_pointer_flow_id_;
   fml::WeakPtrFactory<Engine> weak_factory_;
 
   // |RuntimeDelegate|
@@ -815,8 +1044,18 @@ class Engine final : public RuntimeDelegate,
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
 
+  // |RuntimeDelegate|
+  //
+  // Loading units bundled with the assets, as `isolate_snapshot_data-<id>`
+  // and `isolate_snapshot_instr-<id>`, are mapped on the IO task runner.
+  // Other loading units are requested from the delegate.
+  void RequestDartDeferredLibrary(intptr_t loading_unit_id) override;
+
   void SetNeedsReportTimings(bool value) override;
 
+  // |RuntimeDelegate|
+  void SetPreferredFrameRate(double frames_per_second) override;
+
   void StopAnimator();
 
   void StartAnimatorIfPossible();
@@ -831,8 +1070,18 @@ class Engine final : public RuntimeDelegate,
 
   void HandleAssetPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  void BatchPlatformMessage(fml::RefPtr<PlatformMessage> message,
+                            PlatformMessageBatching batching);
+
+  void FlushBatchedPlatformMessages();
+
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
+  // Rasterizes the glyphs of the |kGlyphUsageAssetName| asset, if bundled, on
+  // the concurrent task runner at the scale of |device_pixel_ratio|. Only the
+  // first call with a valid ratio does so.
+  void PrewarmGlyphs(double device_pixel_ratio);
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Engine);
@@ -25,6 +25,8 @@ class MockDelegate : public Engine::Delegate {
                void(SemanticsNodeUpdates, CustomAccessibilityActionUpdates));
   MOCK_METHOD1(OnEngineHandlePlatformMessage,
                void(fml::RefPtr<PlatformMessage>));
+  MOCK_METHOD1(OnEngineHandlePlatformMessages,
+               void(std::vector<fml::RefPtr<PlatformMessage>>));
   MOCK_METHOD0(OnPreEngineRestart, void());
   MOCK_METHOD0(OnRootIsolateCreated, void());
   MOCK_METHOD2(UpdateIsolateDescription, void(const std::string, int64_t));
@@ -32,6 +34,7 @@ class MockDelegate : public Engine::Delegate {
   MOCK_METHOD1(ComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    const std::vector<std::string>&));
+  MOCK_METHOD1(RequestDartDeferredLibrary, void(intptr_t));
 };
 
 class MockResponse : public PlatformMessageResponse {
@@ -49,12 +52,15 @@ class MockRuntimeDelegate : public RuntimeDelegate {
                void(SemanticsNodeUpdates, CustomAccessibilityActionUpdates));
   MOCK_METHOD1(HandlePlatformMessage, void(fml::RefPtr<PlatformMessage>));
   MOCK_METHOD0(GetFontCollection, FontCollection&());
+  MOCK_METHOD0(GetAssetManager, std::shared_ptr<AssetManager>());
   MOCK_METHOD0(OnRootIsolateCreated, void());
   MOCK_METHOD2(UpdateIsolateDescription, void(const std::string, int64_t));
   MOCK_METHOD1(SetNeedsReportTimings, void(bool));
+  MOCK_METHOD1(SetPreferredFrameRate, void(double));
   MOCK_METHOD1(ComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    const std::vector<std::string>&));
+  MOCK_METHOD1(RequestDartDeferredLibrary, void(intptr_t));
 };
 
 class MockRuntimeController : public RuntimeController {
@@ -143,6 +149,7 @@ TEST_F(EngineTest, Create) {
         /*settings=*/settings_,
         /*animator=*/std::move(animator_),
         /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
         /*runtime_controller=*/std::move(runtime_controller_));
     EXPECT_TRUE(engine);
   });
@@ -163,6 +170,7 @@ TEST_F(EngineTest, DispatchPlatformMessageUnknown) {
         /*settings=*/settings_,
         /*animator=*/std::move(animator_),
         /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
         /*runtime_controller=*/std::move(mock_runtime_controller));
 
     fml::RefPtr<PlatformMessageResponse> response =
@@ -188,6 +196,7 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRoute) {
         /*settings=*/settings_,
         /*animator=*/std::move(animator_),
         /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
         /*runtime_controller=*/std::move(mock_runtime_controller));
 
     fml::RefPtr<PlatformMessageResponse> response =
@@ -220,6 +229,7 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRouteIgnored) {
         /*settings=*/settings_,
         /*animator=*/std::move(animator_),
         /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
         /*runtime_controller=*/std::move(mock_runtime_controller));
 
     fml::RefPtr<PlatformMessageResponse> response =
@@ -235,4 +245,43 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRouteIgnored) {
   });
 }
 
+TEST_F(EngineTest, BatchedPlatformMessagesKeepLatest) {
+  std::unique_ptr<Engine> engine;
+  auto superseded_response = fml::MakeRefCounted<MockResponse>();
+  fml::RefPtr<PlatformMessage> latest_message;
+  PostUITaskSync([&] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+    engine->SetPlatformMessageChannelBatching(
+        "state", Engine::PlatformMessageBatching::kKeepLatest);
+
+    EXPECT_CALL(*superseded_response, CompleteEmpty());
+    EXPECT_CALL(delegate_, OnEngineHandlePlatformMessage(::testing::_))
+        .Times(0);
+    latest_message = fml::MakeRefCounted<PlatformMessage>("state", nullptr);
+    EXPECT_CALL(delegate_,
+                OnEngineHandlePlatformMessages(
+                    std::vector<fml::RefPtr<PlatformMessage>>{latest_message}));
+
+    // Messages are sent to the engine through its |RuntimeDelegate|.
+    RuntimeDelegate* runtime_delegate = engine.get();
+    runtime_delegate->HandlePlatformMessage(
+        fml::MakeRefCounted<PlatformMessage>("state", superseded_response));
+    runtime_delegate->HandlePlatformMessage(latest_message);
+  });
+  // The batch is flushed by a task posted to the UI task runner.
+  PostUITaskSync([&] { engine.reset(); });
+}
+
 }  // namespace flutter
@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/glyph_usage.h"
+
+#include <limits>
+
+namespace flutter {
+
+rapidjson::Value GlyphUsageToJSON(
+    const txt::GlyphUsageRecorder::Usage& usage,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value fonts(rapidjson::kArrayType);
+  for (const auto& [key, glyph_set] : usage) {
+    rapidjson::Value font(rapidjson::kObjectType);
+    font.AddMember("family", rapidjson::Value(key.family.c_str(), allocator),
+                   allocator);
+    font.AddMember("weight", key.weight, allocator);
+    font.AddMember("width", key.width, allocator);
+    font.AddMember("slant", key.slant, allocator);
+    font.AddMember("size", key.size, allocator);
+    font.AddMember("fakeBold", key.fake_bold, allocator);
+    font.AddMember("fakeItalic", key.fake_italic, allocator);
+    rapidjson::Value glyphs(rapidjson::kArrayType);
+    for (uint16_t glyph : glyph_set) {
+      glyphs.PushBack(static_cast<unsigned>(glyph), allocator);
+    }
+    font.AddMember("glyphs", glyphs, allocator);
+    fonts.PushBack(font, allocator);
+  }
+  return fonts;
+}
+
+bool GlyphUsageFromJSON(const fml::Mapping& json,
+                        txt::GlyphUsageRecorder::Usage* usage) {
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(json.GetMapping()),
+                 json.GetSize());
+  if (document.HasParseError() || !document.IsArray()) {
+    return false;
+  }
+
+  for (const auto& font : document.GetArray()) {
+    if (!font.IsObject() || !font.HasMember("family") ||
+        !font["family"].IsString() || !font.HasMember("size") ||
+        !font["size"].IsNumber() || !font.HasMember("glyphs") ||
+        !font["glyphs"].IsArray()) {
+      continue;
+    }
+
+    txt::GlyphUsageRecorder::FontKey key;
+    key.family = font["family"].GetString();
+    key.size = font["size"].GetFloat();
+    if (font.HasMember("weight") && font["weight"].IsInt()) {
+      key.weight = font["weight"].GetInt();
+    }
+    if (font.HasMember("width") && font["width"].IsInt()) {
+      key.width = font["width"].GetInt();
+    }
+    if (font.HasMember("slant") && font["slant"].IsInt()) {
+      key.slant = font["slant"].GetInt();
+    }
+    if (font.HasMember("fakeBold") && font["fakeBold"].IsBool()) {
+      key.fake_bold = font["fakeBold"].GetBool();
+    }
+    if (font.HasMember("fakeItalic") && font["fakeItalic"].IsBool()) {
+      key.fake_italic = font["fakeItalic"].GetBool();
+    }
+
+    std::set<uint16_t>& glyphs = (*usage)[key];
+    for (const auto& glyph : font["glyphs"].GetArray()) {
+      if (glyph.IsUint() &&
+          glyph.GetUint() <= std::numeric_limits<uint16_t>::max()) {
+        glyphs.insert(static_cast<uint16_t>(glyph.GetUint()));
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,41 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_GLYPH_USAGE_H_
+#define FLUTTER_SHELL_COMMON_GLYPH_USAGE_H_
+
+#include "flutter/fml/mapping.h"
+#include "rapidjson/document.h"
+#include "txt/glyph_usage_recorder.h"
+
+namespace flutter {
+
+// The asset that the glyph usage of a training run is bundled as. Its contents
+// are the "fonts" array of the |_flutter.getGlyphUsage| service protocol
+// response.
+static constexpr char kGlyphUsageAssetName[] = "io.flutter.glyph_usage.json";
+
+//------------------------------------------------------------------------------
+/// @brief      Serializes |usage| as a JSON array with one object per font:
+///
+///             {"family": "Roboto", "weight": 400, "width": 5, "slant": 0,
+///              "size": 14.0, "fakeBold": false, "fakeItalic": false,
+///              "glyphs": [36, 72, 79, 82]}
+///
+rapidjson::Value GlyphUsageToJSON(
+    const txt::GlyphUsageRecorder::Usage& usage,
+    rapidjson::Document::AllocatorType& allocator);
+
+//------------------------------------------------------------------------------
+/// @brief      Parses the glyph usage serialized by |GlyphUsageToJSON|.
+///             Malformed fonts are skipped.
+///
+/// @return     Whether |json| is a JSON array.
+///
+bool GlyphUsageFromJSON(const fml::Mapping& json,
+                        txt::GlyphUsageRecorder::Usage* usage);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_GLYPH_USAGE_H_
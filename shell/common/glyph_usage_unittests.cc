@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/glyph_usage.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(GlyphUsageTest, RoundTripsThroughJSON) {
+  txt::GlyphUsageRecorder::FontKey roboto;
+  roboto.family = "Roboto";
+  roboto.weight = 400;
+  roboto.width = 5;
+  roboto.slant = 0;
+  roboto.size = 14;
+  txt::GlyphUsageRecorder::FontKey bold = roboto;
+  bold.size = 20.5;
+  bold.fake_bold = true;
+
+  txt::GlyphUsageRecorder::Usage usage;
+  usage[roboto] = {36, 72, 79};
+  usage[bold] = {82};
+
+  rapidjson::Document document;
+  rapidjson::Value fonts = GlyphUsageToJSON(usage, document.GetAllocator());
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  fonts.Accept(writer);
+  ASSERT_EQ(std::string(buffer.GetString()),
+            "[{\"family\":\"Roboto\",\"weight\":400,\"width\":5,\"slant\":0,"
+            "\"size\":14.0,\"fakeBold\":false,\"fakeItalic\":false,"
+            "\"glyphs\":[36,72,79]},"
+            "{\"family\":\"Roboto\",\"weight\":400,\"width\":5,\"slant\":0,"
+            "\"size\":20.5,\"fakeBold\":true,\"fakeItalic\":false,"
+            "\"glyphs\":[82]}]");
+
+  fml::NonOwnedMapping json(
+      reinterpret_cast<const uint8_t*>(buffer.GetString()), buffer.GetSize());
+  txt::GlyphUsageRecorder::Usage parsed;
+  ASSERT_TRUE(GlyphUsageFromJSON(json, &parsed));
+  ASSERT_EQ(parsed.size(), 2u);
+  ASSERT_EQ(parsed[roboto], usage[roboto]);
+  ASSERT_EQ(parsed[bold], usage[bold]);
+}
+
+TEST(GlyphUsageTest, SkipsMalformedFonts) {
+  const std::string contents =
+      "[{\"family\":\"Roboto\",\"size\":14,\"glyphs\":[1,70000,2]},"
+      "{\"family\":\"Missing size\",\"glyphs\":[3]},"
+      "\"not a font\"]";
+  fml::NonOwnedMapping json(reinterpret_cast<const uint8_t*>(contents.data()),
+                            contents.size());
+  txt::GlyphUsageRecorder::Usage usage;
+  ASSERT_TRUE(GlyphUsageFromJSON(json, &usage));
+  ASSERT_EQ(usage.size(), 1u);
+  ASSERT_EQ(usage.begin()->first.family, "Roboto");
+  ASSERT_EQ(usage.begin()->second, std::set<uint16_t>({1, 2}));
+
+  const std::string object = "{\"fonts\":[]}";
+  fml::NonOwnedMapping object_json(
+      reinterpret_cast<const uint8_t*>(object.data()), object.size());
+  ASSERT_FALSE(GlyphUsageFromJSON(object_json, &usage));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
@@ -412,5 +413,45 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+namespace {
+
+class RecordingDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    dispatched_flow_ids.push_back(trace_flow_id);
+  }
+
+  void ScheduleSecondaryVsyncCallback(const fml::closure& callback) override {}
+
+  void ScheduleBeginFrameCallback(const fml::closure& callback) override {
+    begin_frame_callbacks.push_back(callback);
+  }
+
+  std::vector<uint64_t> dispatched_flow_ids;
+  std::vector<fml::closure> begin_frame_callbacks;
+};
+
+}  // namespace
+
+TEST(LatchingPointerDataDispatcherTest, DispatchesPacketsRightBeforeFrame) {
+  RecordingDispatcherDelegate delegate;
+  LatchingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(std::make_unique<PointerDataPacket>(1), 1);
+  dispatcher.DispatchPacket(std::make_unique<PointerDataPacket>(1), 2);
+  ASSERT_TRUE(delegate.dispatched_flow_ids.empty());
+  // A single callback covers all the packets of a frame.
+  ASSERT_EQ(delegate.begin_frame_callbacks.size(), 1u);
+
+  delegate.begin_frame_callbacks[0]();
+  ASSERT_EQ(delegate.dispatched_flow_ids, std::vector<uint64_t>({1, 2}));
+
+  dispatcher.DispatchPacket(std::make_unique<PointerDataPacket>(1), 3);
+  ASSERT_EQ(delegate.begin_frame_callbacks.size(), 2u);
+  delegate.begin_frame_callbacks[1]();
+  ASSERT_EQ(delegate.dispatched_flow_ids, std::vector<uint64_t>({1, 2, 3}));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_pack.h"
+
+#include <map>
+
+#include "flutter/fml/file.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<fml::UniqueFD> OpenDirectory(
+    const fml::ScopedTemporaryDirectory& dir) {
+  return std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      dir.path().c_str(), false, fml::FilePermission::kReadWrite));
+}
+
+bool Append(PersistentCachePack& pack,
+            const std::string& key,
+            const std::string& value) {
+  return pack.Append(fml::DataMapping(key), fml::DataMapping(value));
+}
+
+std::string Load(const PersistentCachePack& pack, const std::string& key) {
+  auto value = pack.Load(fml::DataMapping(key));
+  if (!value) {
+    return "<missing>";
+  }
+  return std::string(reinterpret_cast<const char*>(value->GetMapping()),
+                     value->GetSize());
+}
+
+size_t GetPackSize(const std::shared_ptr<fml::UniqueFD>& directory) {
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      *directory, PersistentCachePack::kFileName);
+  return mapping ? mapping->GetSize() : 0;
+}
+
+}  // namespace
+
+TEST(PersistentCachePackTest, CanAppendAndLoad) {
+  fml::ScopedTemporaryDirectory dir;
+  PersistentCachePack pack(OpenDirectory(dir), false);
+  ASSERT_TRUE(pack.IsValid());
+  ASSERT_EQ(pack.GetEntryCount(), 0u);
+
+  ASSERT_TRUE(Append(pack, "a", "apple"));
+  ASSERT_TRUE(Append(pack, "b", "banana"));
+  ASSERT_EQ(pack.GetEntryCount(), 2u);
+  ASSERT_EQ(Load(pack, "a"), "apple");
+  ASSERT_EQ(Load(pack, "b"), "banana");
+  ASSERT_EQ(Load(pack, "c"), "<missing>");
+}
+
+TEST(PersistentCachePackTest, EntriesSurviveReopening) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenDirectory(dir);
+  {
+    PersistentCachePack pack(directory, false);
+    ASSERT_TRUE(Append(pack, "a", "apple"));
+    ASSERT_TRUE(Append(pack, "b", "banana"));
+    ASSERT_TRUE(Append(pack, "a", "apricot"));
+  }
+
+  PersistentCachePack pack(directory, true);
+  ASSERT_EQ(pack.GetEntryCount(), 2u);
+  ASSERT_EQ(Load(pack, "a"), "apricot");
+
+  std::map<std::string, std::string> entries;
+  pack.VisitEntries([&entries](const fml::Mapping& key,
+                               const fml::Mapping& value) {
+    entries[std::string(reinterpret_cast<const char*>(key.GetMapping()),
+                        key.GetSize())] =
+        std::string(reinterpret_cast<const char*>(value.GetMapping()),
+                    value.GetSize());
+  });
+  std::map<std::string, std::string> expected = {{"a", "apricot"},
+                                                 {"b", "banana"}};
+  ASSERT_EQ(entries, expected);
+}
+
+TEST(PersistentCachePackTest, ReadOnlyPackCannotBeWritten) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenDirectory(dir);
+
+  // A read-only pack does not create the file.
+  ASSERT_FALSE(PersistentCachePack(directory, true).IsValid());
+
+  {
+    PersistentCachePack writer(directory, false);
+    ASSERT_TRUE(Append(writer, "a", "apple"));
+  }
+  PersistentCachePack pack(directory, true);
+  ASSERT_TRUE(pack.IsValid());
+  ASSERT_FALSE(Append(pack, "b", "banana"));
+  ASSERT_EQ(Load(pack, "a"), "apple");
+}
+
+TEST(PersistentCachePackTest, IncompleteRecordsAreDiscarded) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenDirectory(dir);
+  {
+    PersistentCachePack pack(directory, false);
+    ASSERT_TRUE(Append(pack, "a", "apple"));
+    ASSERT_TRUE(Append(pack, "b", "banana"));
+  }
+
+  // Cut the last record short, as if the process died while appending it.
+  const size_t size = GetPackSize(directory);
+  {
+    auto file = fml::OpenFile(*directory, PersistentCachePack::kFileName, false,
+                              fml::FilePermission::kReadWrite);
+    ASSERT_TRUE(fml::TruncateFile(file, size - 2));
+  }
+
+  PersistentCachePack pack(directory, false);
+  ASSERT_EQ(pack.GetEntryCount(), 1u);
+  ASSERT_EQ(Load(pack, "a"), "apple");
+  ASSERT_EQ(Load(pack, "b"), "<missing>");
+
+  // Appends continue after the last complete record.
+  ASSERT_TRUE(Append(pack, "c", "cherry"));
+  PersistentCachePack reopened(directory, true);
+  ASSERT_EQ(reopened.GetEntryCount(), 2u);
+  ASSERT_EQ(Load(reopened, "c"), "cherry");
+}
+
+TEST(PersistentCachePackTest, CompactionDropsShadowedRecords) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenDirectory(dir);
+  PersistentCachePack pack(directory, false);
+
+  const std::string value(16 * 1024, 'x');
+  ASSERT_TRUE(Append(pack, "live", "value"));
+  ASSERT_TRUE(Append(pack, "shadowed", value));
+  ASSERT_FALSE(pack.NeedsCompaction());
+  for (int i = 0; i < 8; i++) {
+    ASSERT_TRUE(Append(pack, "shadowed", value + std::to_string(i)));
+  }
+  ASSERT_TRUE(pack.NeedsCompaction());
+
+  const size_t size_before = GetPackSize(directory);
+  ASSERT_TRUE(pack.Compact());
+  ASSERT_FALSE(pack.NeedsCompaction());
+  ASSERT_LT(GetPackSize(directory) * 4, size_before);
+
+  ASSERT_EQ(pack.GetEntryCount(), 2u);
+  ASSERT_EQ(Load(pack, "live"), "value");
+  ASSERT_EQ(Load(pack, "shadowed"), value + "7");
+
+  // The compacted file can still be appended to.
+  ASSERT_TRUE(Append(pack, "new", "entry"));
+  ASSERT_EQ(PersistentCachePack(directory, true).GetEntryCount(), 3u);
+}
+
+TEST(PersistentCachePackTest, ResetDropsEntriesOfPurgedFile) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenDirectory(dir);
+  PersistentCachePack pack(directory, false);
+  ASSERT_TRUE(Append(pack, "a", "apple"));
+
+  ASSERT_TRUE(fml::RemoveFilesInDirectory(*directory));
+  pack.Reset();
+  ASSERT_EQ(pack.GetEntryCount(), 0u);
+  ASSERT_TRUE(Append(pack, "b", "banana"));
+  ASSERT_EQ(PersistentCachePack(directory, true).GetEntryCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/common/graphics/persistent_cache.h"
 
 #include <memory>
+#include <set>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/flow/layers/container_layer.h"
@@ -12,13 +13,17 @@
 #include "flutter/flow/layers/physical_shape_layer.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/fml/command_line.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/version/version.h"
 #include "flutter/testing/testing.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkPicture.h"
 
 namespace flutter {
@@ -307,5 +312,178 @@ TEST_F(ShellTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, CanStoreAndLoadRasterCacheImages) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  ASSERT_EQ(persistent_cache->LoadRasterCacheImages().size(), 0u);
+
+  fml::Thread worker("io.flutter.test.persistent_cache_worker");
+  persistent_cache->AddWorkerTaskRunner(worker.GetTaskRunner());
+
+  sk_sp<SkData> key = SkData::MakeWithCString("key");
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(10, 10);
+  bitmap.eraseColor(SK_ColorRED);
+  persistent_cache->StoreRasterCacheImage(key, SkImage::MakeFromBitmap(bitmap));
+
+  fml::AutoResetWaitableEvent latch;
+  worker.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  auto images = persistent_cache->LoadRasterCacheImages();
+  ASSERT_EQ(images.size(), 1u);
+  ASSERT_TRUE(images[0].first->equals(key.get()));
+  auto image = SkImage::MakeFromEncoded(images[0].second);
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->dimensions(), SkISize::Make(10, 10));
+
+  persistent_cache->RemoveWorkerTaskRunner(worker.GetTaskRunner());
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(ShellTest, StoredRasterCacheImagesAreCapped) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  fml::Thread worker("io.flutter.test.persistent_cache_worker");
+  persistent_cache->AddWorkerTaskRunner(worker.GetTaskRunner());
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(10, 10);
+  bitmap.eraseColor(SK_ColorRED);
+  sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
+  const size_t stored_count = PersistentCache::kMaxRasterCacheImageCount + 3;
+  for (size_t i = 0; i < stored_count; i++) {
+    persistent_cache->StoreRasterCacheImage(
+        SkData::MakeWithCopy(&i, sizeof(i)), image);
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  worker.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  // The oldest images were evicted.
+  auto images = persistent_cache->LoadRasterCacheImages();
+  ASSERT_EQ(images.size(), PersistentCache::kMaxRasterCacheImageCount);
+  std::set<size_t> stored_keys;
+  for (const auto& stored : images) {
+    ASSERT_EQ(stored.first->size(), sizeof(size_t));
+    stored_keys.insert(*static_cast<const size_t*>(stored.first->data()));
+  }
+  EXPECT_EQ(*stored_keys.begin(), 3u);
+  EXPECT_EQ(*stored_keys.rbegin(), stored_count - 1);
+
+  persistent_cache->RemoveWorkerTaskRunner(worker.GetTaskRunner());
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(ShellTest, CanStoreAndLoadVulkanPipelineCachesPerDevice) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  const std::string device_a = "0123456789abcdef0123456789abcdef";
+  const std::string device_b = "fedcba9876543210fedcba9876543210";
+  ASSERT_EQ(persistent_cache->LoadVulkanPipelineCache(device_a), nullptr);
+
+  // Without a worker task runner, the pipeline cache is written right away.
+  sk_sp<SkData> data = SkData::MakeWithCString("pipeline cache data");
+  persistent_cache->StoreVulkanPipelineCache(device_a, data);
+
+  auto loaded = persistent_cache->LoadVulkanPipelineCache(device_a);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_TRUE(loaded->equals(data.get()));
+  ASSERT_EQ(persistent_cache->LoadVulkanPipelineCache(device_b), nullptr);
+
+  // The pipeline cache is not mistaken for a shader.
+  ASSERT_EQ(persistent_cache->LoadSkSLs().size(), 0u);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(ShellTest, CanStoreAndLoadMetalBinaryArchivesPerDevice) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  const std::string device_a = "4294968625-20A362";
+  const std::string device_b = "4294968625-20B82";
+  ASSERT_EQ(persistent_cache->LoadMetalBinaryArchive(device_a), nullptr);
+
+  sk_sp<SkData> data = SkData::MakeWithCString("binary archive data");
+  persistent_cache->StoreMetalBinaryArchive(device_a, data);
+
+  auto loaded = persistent_cache->LoadMetalBinaryArchive(device_a);
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_TRUE(loaded->equals(data.get()));
+  ASSERT_EQ(persistent_cache->LoadMetalBinaryArchive(device_b), nullptr);
+
+  // Archives are kept apart from the Vulkan pipeline caches and shaders.
+  ASSERT_EQ(persistent_cache->LoadVulkanPipelineCache(device_a), nullptr);
+  ASSERT_EQ(persistent_cache->LoadSkSLs().size(), 0u);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(ShellTest, CanLoadSkSLsConcurrently) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  PersistentCache::SetCacheSkSL(true);
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  fml::Thread worker("io.flutter.test.persistent_cache_worker");
+  persistent_cache->AddWorkerTaskRunner(worker.GetTaskRunner());
+
+  constexpr size_t kShaderCount = 64;
+  for (size_t i = 0; i < kShaderCount; i++) {
+    std::string name = "shader" + std::to_string(i);
+    sk_sp<SkData> key = SkData::MakeWithCString(name.c_str());
+    std::string sksl = "sksl " + name;
+    sk_sp<SkData> value = SkData::MakeWithCopy(sksl.data(), sksl.size());
+    StorePersistentCache(persistent_cache, *key, *value);
+  }
+  fml::AutoResetWaitableEvent latch;
+  worker.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  persistent_cache->SetConcurrentTaskRunner(loop->GetTaskRunner());
+  auto shaders = persistent_cache->LoadSkSLs();
+  ASSERT_EQ(shaders.size(), kShaderCount);
+  for (const auto& shader : shaders) {
+    std::string key(reinterpret_cast<const char*>(shader.first->bytes()));
+    CheckTextSkData(shader.second, "sksl " + key);
+  }
+
+  // Loading falls back to the calling thread once the loop is gone.
+  loop.reset();
+  ASSERT_EQ(persistent_cache->LoadSkSLs().size(), kShaderCount);
+
+  persistent_cache->RemoveWorkerTaskRunner(worker.GetTaskRunner());
+  PersistentCache::SetCacheSkSL(false);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -91,14 +93,30 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
   };
 
   explicit Pipeline(uint32_t depth)
-      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth),
+        effective_depth_(depth),
+        empty_(depth),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  uint32_t GetDepth() const { return depth_; }
+
+  /// Limits the number of resources in flight to |depth|, which is clamped
+  /// to [1, |GetDepth()|]. Resources already in flight are not affected, the
+  /// limit only applies to subsequent calls to |Produce| and
+  /// |ProduceIfEmpty|.
+  void SetEffectiveDepth(uint32_t depth) {
+    effective_depth_ = std::clamp<uint32_t>(depth, 1u, depth_);
+  }
+
+  uint32_t GetEffectiveDepth() const { return effective_depth_; }
+
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!ReserveSlot()) {
       return {};
     }
     ++inflight_;
@@ -118,7 +136,7 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
   // Prefer using |Produce|. ProducerContinuation returned by this method
   // doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!ReserveSlot()) {
       return {};
     }
     ++inflight_;
@@ -173,12 +191,22 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
 
  private:
   const uint32_t depth_;
+  std::atomic<uint32_t> effective_depth_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  // Only called by the producer, so |inflight_| can only decrease (as the
+  // consumer catches up) between the check and the wait.
+  bool ReserveSlot() {
+    if (static_cast<uint32_t>(inflight_.load()) >= effective_depth_.load()) {
+      return false;
+    }
+    return empty_.TryWait();
+  }
+
   bool ProducerCommit(ResourcePtr resource, size_t trace_id) {
     {
       std::scoped_lock lock(queue_mutex_);
@@ -197,6 +225,7 @@ class Pipeline : public fml::RefCountedThreadSafe<Pipeline<R>> {
         // Bail if the queue is not empty, opens up spaces to produce other
         // frames.
         empty_.Signal();
+        --inflight_;
         return false;
       }
       queue_.emplace_back(std::move(resource), trace_id);
@@ -131,5 +131,51 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, EffectiveDepthLimitsFramesInFlight) {
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(2);
+  pipeline->SetEffectiveDepth(1);
+  ASSERT_EQ(pipeline->GetEffectiveDepth(), 1u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetEffectiveDepth(2);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)));
+
+  pipeline->SetEffectiveDepth(1);
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); }),
+            PipelineConsumeResult::MoreAvailable);
+  // One frame is still in flight.
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 2); }),
+            PipelineConsumeResult::Done);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+TEST(PipelineTest, EffectiveDepthIsClamped) {
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(2);
+  pipeline->SetEffectiveDepth(0);
+  ASSERT_EQ(pipeline->GetEffectiveDepth(), 1u);
+  pipeline->SetEffectiveDepth(3);
+  ASSERT_EQ(pipeline->GetEffectiveDepth(), 2u);
+}
+
+TEST(PipelineTest, FailedProduceIfEmptyReleasesItsSlot) {
+  fml::RefPtr<IntPipeline> pipeline = fml::MakeRefCounted<IntPipeline>(2);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->ProduceIfEmpty();
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)));
+  ASSERT_FALSE(continuation_2.Complete(std::make_unique<int>(2)));
+
+  pipeline->SetEffectiveDepth(2);
+  ASSERT_TRUE(pipeline->Produce());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/common/constants.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -37,9 +38,11 @@ void PlatformView::DispatchPlatformMessage(
 }
 
 void PlatformView::DispatchPointerDataPacket(
-    std::unique_ptr<PointerDataPacket> packet) {
+    std::unique_ptr<PointerDataPacket> packet,
+    bool coalesce_moves) {
   delegate_.OnPlatformViewDispatchPointerDataPacket(
-      pointer_data_packet_converter_.Convert(std::move(packet)));
+      pointer_data_packet_converter_.Convert(std::move(packet),
+                                             coalesce_moves));
 }
 
 void PlatformView::DispatchSemanticsAction(int32_t id,
@@ -84,6 +87,40 @@ void PlatformView::NotifyCreated() {
   delegate_.OnPlatformViewCreated(std::move(surface));
 }
 
+void PlatformView::AddView(int64_t view_id, const ViewportMetrics& metrics) {
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+  std::unique_ptr<Surface> surface;
+
+  // Threading: See |NotifyCreated|.
+  auto* platform_view = this;
+  fml::ManualResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [platform_view, view_id, &surface, &latch]() {
+        surface = platform_view->CreateViewRenderingSurface(view_id);
+        if (surface && !surface->IsValid()) {
+          surface.reset();
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+  if (!surface) {
+    FML_LOG(ERROR) << "Failed to create the rendering surface of view "
+                   << view_id;
+    return;
+  }
+  delegate_.OnPlatformViewAddView(view_id, std::move(surface), metrics);
+}
+
+void PlatformView::RemoveView(int64_t view_id) {
+  delegate_.OnPlatformViewRemoveView(view_id);
+}
+
+void PlatformView::SetViewportMetrics(int64_t view_id,
+                                      const ViewportMetrics& metrics) {
+  delegate_.OnPlatformViewSetViewMetrics(view_id, metrics);
+}
+
 void PlatformView::NotifyDestroyed() {
   delegate_.OnPlatformViewDestroyed();
 }
@@ -96,6 +133,13 @@ sk_sp<GrDirectContext> PlatformView::CreateResourceContext() const {
 
 void PlatformView::ReleaseResourceContext() const {}
 
+std::shared_ptr<ResourceContextPool> PlatformView::CreateResourceContextPool()
+    const {
+  return nullptr;
+}
+
+void PlatformView::PrewarmGPUContext() {}
+
 PointerDataDispatcherMaker PlatformView::GetDispatcherMaker() {
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<DefaultPointerDataDispatcher>(delegate);
@@ -109,11 +153,33 @@ fml::WeakPtr<PlatformView> PlatformView::GetWeakPtr() const {
 void PlatformView::UpdateSemantics(SemanticsNodeUpdates update,
                                    CustomAccessibilityActionUpdates actions) {}
 
+void PlatformView::PostSemanticsUpdate(
+    SemanticsNodeUpdates update,
+    CustomAccessibilityActionUpdates actions) {
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [view = GetWeakPtr(), update = std::move(update),
+       actions = std::move(actions)] {
+        if (view) {
+          view->UpdateSemantics(std::move(update), std::move(actions));
+        }
+      });
+}
+
 void PlatformView::HandlePlatformMessage(fml::RefPtr<PlatformMessage> message) {
   if (auto response = message->response())
     response->CompleteEmpty();
 }
 
+void PlatformView::HandleBackgroundPlatformMessage(
+    fml::RefPtr<PlatformMessage> message) {
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [view = GetWeakPtr(), message = std::move(message)]() {
+        if (view) {
+          view->HandlePlatformMessage(std::move(message));
+        }
+      });
+}
+
 void PlatformView::OnPreEngineRestart() const {}
 
 void PlatformView::RegisterTexture(std::shared_ptr<flutter::Texture> texture) {
@@ -136,6 +202,13 @@ std::unique_ptr<Surface> PlatformView::CreateRenderingSurface() {
   return nullptr;
 }
 
+std::unique_ptr<Surface> PlatformView::CreateViewRenderingSurface(
+    int64_t view_id) {
+  FML_DLOG(WARNING) << "This platform doesn't support rendering views other "
+                       "than the implicit view.";
+  return nullptr;
+}
+
 std::shared_ptr<ExternalViewEmbedder>
 PlatformView::CreateExternalViewEmbedder() {
   FML_DLOG(WARNING)
@@ -159,4 +232,8 @@ PlatformView::ComputePlatformResolvedLocales(
   return out;
 }
 
+bool PlatformView::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
+  return false;
+}
+
 }  // namespace flutter
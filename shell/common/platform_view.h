@@ -13,6 +13,7 @@
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/lib/ui/painting/resource_context_pool.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -100,6 +101,40 @@ class PlatformView {
     virtual void OnPlatformViewSetViewportMetrics(
         const ViewportMetrics& metrics) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the platform added a view that
+    ///             the engine renders in addition to the implicit view. The
+    ///             rasterizer draws the trees the framework renders for the
+    ///             view into its surface.
+    ///
+    /// @param[in]  view_id  The id of the view.
+    /// @param[in]  surface  The surface of the view.
+    /// @param[in]  metrics  The viewport metrics of the view.
+    ///
+    virtual void OnPlatformViewAddView(int64_t view_id,
+                                       std::unique_ptr<Surface> surface,
+                                       const ViewportMetrics& metrics) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the platform removed a view it
+    ///             added before. The surface of the view must be collected
+    ///             before this returns.
+    ///
+    /// @param[in]  view_id  The id of the view.
+    ///
+    virtual void OnPlatformViewRemoveView(int64_t view_id) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the viewport metrics of a view
+    ///             the platform added have been updated.
+    ///
+    /// @param[in]  view_id  The id of the view.
+    /// @param[in]  metrics  The updated viewport metrics.
+    ///
+    virtual void OnPlatformViewSetViewMetrics(
+        int64_t view_id,
+        const ViewportMetrics& metrics) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Notifies the delegate that the platform has dispatched a
     ///             platform message from the embedder to the Flutter
@@ -289,6 +324,19 @@ class PlatformView {
   ///
   virtual void HandlePlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Overridden by embedders to handle the platform messages of
+  ///             the channels made background channels with
+  ///             `Shell::SetPlatformMessageChannelBackground`. This is called
+  ///             on a background thread, in the order the messages were sent.
+  ///             The default implementation forwards the message to
+  ///             `HandlePlatformMessage` on the platform thread.
+  ///
+  /// @param[in]  message  The message
+  ///
+  virtual void HandleBackgroundPlatformMessage(
+      fml::RefPtr<PlatformMessage> message);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to dispatch an accessibility action to a
   ///             running isolate hosted by the engine.
@@ -351,6 +399,25 @@ class PlatformView {
   virtual void UpdateSemantics(SemanticsNodeUpdates updates,
                                CustomAccessibilityActionUpdates actions);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell to hand the semantics node updates of the
+  ///             framework to the embedder. This is called on the UI task
+  ///             runner, so that embedders may convert the updates to their
+  ///             platform representation there instead of on the platform
+  ///             task runner. The default implementation forwards the updates
+  ///             to `UpdateSemantics` on the platform task runner.
+  ///
+  /// @attention  Overrides must only access state of the platform view that is
+  ///             safe to access from the UI task runner.
+  ///
+  /// @param[in]  updates  A map with the stable semantics node identifier as
+  ///                      key and the node properties as the value.
+  /// @param[in]  actions  A map with the stable semantics node identifier as
+  ///                      key and the custom node action as the value.
+  ///
+  virtual void PostSemanticsUpdate(SemanticsNodeUpdates updates,
+                                   CustomAccessibilityActionUpdates actions);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to specify the updated viewport metrics. In
   ///             response to this call, on the raster thread, the rasterizer
@@ -363,6 +430,44 @@ class PlatformView {
   ///
   void SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to add a view that the engine renders in
+  ///             addition to the implicit view of the platform view, for
+  ///             example another window of a desktop application. The views
+  ///             share the root isolate, the raster cache and the GPU context
+  ///             of the engine. The surface of the view is obtained from
+  ///             `CreateViewRenderingSurface` on the raster task runner, and
+  ///             must render with the GPU context of the implicit view's
+  ///             surface. The surface remains in use till the corresponding
+  ///             call to `RemoveView`.
+  ///
+  /// @attention  Trees of these views are drawn without the external view
+  ///             embedder, so they cannot contain platform views.
+  ///
+  /// @param[in]  view_id  The id of the view, which must not be
+  ///                      `kFlutterImplicitViewId`.
+  /// @param[in]  metrics  The viewport metrics of the view.
+  ///
+  void AddView(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to remove a view added with `AddView`. The
+  ///             framework stops rendering the view, and its surface is
+  ///             collected by the time this returns.
+  ///
+  /// @param[in]  view_id  The id of the view.
+  ///
+  void RemoveView(int64_t view_id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to specify the updated viewport metrics of
+  ///             a view added with `AddView`.
+  ///
+  /// @param[in]  view_id  The id of the view.
+  /// @param[in]  metrics  The updated viewport metrics.
+  ///
+  void SetViewportMetrics(int64_t view_id, const ViewportMetrics& metrics);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify the shell that a platform view
   ///             has been created. This notification is used to create a
@@ -423,6 +528,39 @@ class PlatformView {
   ///
   virtual void ReleaseResourceContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell to obtain additional resource contexts in
+  ///             the share-group of the one returned by
+  ///             `CreateResourceContext()`. Decoded images are uploaded on
+  ///             the threads of the pool in parallel instead of only on the
+  ///             IO thread.
+  ///
+  /// @attention  Unlike all other methods on the platform view, this will be
+  ///             called on IO task runner, after `CreateResourceContext()`.
+  ///
+  /// @return     The pool, or `nullptr` if the platform only provides a
+  ///             single resource context.
+  ///
+  virtual std::shared_ptr<ResourceContextPool> CreateResourceContextPool()
+      const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell, when `Settings::prewarm_gpu_context` is
+  ///             set, to let the platform create the GPU context of its
+  ///             rendering surfaces before the first of them is created. The
+  ///             context is created without a window, while the isolate
+  ///             starts, and the surface returned by the next call to
+  ///             `CreateRenderingSurface()` renders with it. This takes the
+  ///             creation of the context and the precompilation of the cached
+  ///             shaders off the critical path of the first frame. Platforms
+  ///             that cannot do this ignore the call.
+  ///
+  /// @attention  Unlike all other methods on the platform view, this will be
+  ///             called on the raster task runner, before the first call to
+  ///             `CreateRenderingSurface()`.
+  ///
+  virtual void PrewarmGPUContext();
+
   //--------------------------------------------------------------------------
   /// @brief      Returns a platform-specific PointerDataDispatcherMaker so the
   ///             `Engine` can construct the PointerDataPacketDispatcher based
@@ -480,9 +618,14 @@ class PlatformView {
   ///             pointer input events. Each call to this method wakes up
   ///             the UI thread.
   ///
-  /// @param[in]  packet  The pointer data packet to dispatch to the framework.
+  /// @param[in]  packet          The pointer data packet to dispatch to the
+  ///                             framework.
+  /// @param[in]  coalesce_moves  Whether consecutive moves of the same device
+  ///                             within the packet are merged into one. Used
+  ///                             for packets batched over a frame interval.
   ///
-  void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet);
+  void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet,
+                                 bool coalesce_moves = false);
 
   //--------------------------------------------------------------------------
   /// @brief      Used by the embedder to specify a texture that it wants the
@@ -565,6 +708,21 @@ class PlatformView {
 
   virtual std::shared_ptr<ExternalViewEmbedder> CreateExternalViewEmbedder();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Invoked by the shell when the root isolate requests a
+  ///             deferred loading unit that is not bundled with the assets.
+  ///             Platforms that can provide loading units, for example by
+  ///             downloading them, do so asynchronously and complete the
+  ///             request with `Shell::LoadDartDeferredLibrary` or
+  ///             `Shell::LoadDartDeferredLibraryError`.
+  ///
+  /// @param[in]  loading_unit_id  The identifier of the loading unit.
+  ///
+  /// @return     Whether the platform will complete the request. The default
+  ///             implementation returns false, which fails the request.
+  ///
+  virtual bool RequestDartDeferredLibrary(intptr_t loading_unit_id);
+
  protected:
   PlatformView::Delegate& delegate_;
   const TaskRunners task_runners_;
@@ -577,6 +735,11 @@ class PlatformView {
   // GPU task runner.
   virtual std::unique_ptr<Surface> CreateRenderingSurface();
 
+  // Creates the surface of a view added with |AddView|. Like
+  // |CreateRenderingSurface|, this is called on the GPU task runner. The
+  // default implementation returns null, which fails to add the view.
+  virtual std::unique_ptr<Surface> CreateViewRenderingSurface(int64_t view_id);
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(PlatformView);
 };
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
 PointerDataDispatcher::~PointerDataDispatcher() = default;
@@ -13,6 +15,11 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+LatchingPointerDataDispatcher::LatchingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+LatchingPointerDataDispatcher::~LatchingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -60,4 +67,29 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void LatchingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  const bool needs_callback = pending_packets_.empty();
+  pending_packets_.emplace_back(std::move(packet), trace_flow_id);
+  if (needs_callback) {
+    delegate_.ScheduleBeginFrameCallback(
+        [dispatcher = weak_factory_.GetWeakPtr()]() {
+          if (dispatcher) {
+            dispatcher->DispatchPendingPackets();
+          }
+        });
+  }
+}
+
+void LatchingPointerDataDispatcher::DispatchPendingPackets() {
+  TRACE_EVENT0("flutter", "LatchingPointerDataDispatcher::Dispatch");
+  auto packets = std::move(pending_packets_);
+  pending_packets_.clear();
+  for (auto& [packet, trace_flow_id] : packets) {
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 trace_flow_id);
+  }
+}
+
 }  // namespace flutter
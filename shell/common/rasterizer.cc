@@ -4,9 +4,15 @@
 
 #include "flutter/shell/common/rasterizer.h"
 
+#include <algorithm>
+#include <string>
 #include <utility>
 
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/composition_timeline.h"
+#include "flutter/flow/layers/layer_tree_capture.h"
+#include "flutter/flow/layers/scroll_layer.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
@@ -36,12 +42,22 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// Under moderate memory pressure, the rasterizer only purges the resources
+// that have not been used within this interval.
+static constexpr std::chrono::milliseconds kModerateMemoryPressureExpiration(
+    1000);
+
+// How often Skia is asked whether pending snapshot readbacks have finished.
+static constexpr fml::TimeDelta kSnapshotReadbackCheckInterval =
+    fml::TimeDelta::FromMilliseconds(2);
+
 Rasterizer::Rasterizer(Delegate& delegate)
     : delegate_(delegate),
       compositor_context_(std::make_unique<flutter::CompositorContext>(
           delegate.GetFrameBudget())),
       user_override_resource_cache_bytes_(false),
-      weak_factory_(this) {
+      weak_factory_(this),
+      thread_safe_weak_factory_(this) {
   FML_DCHECK(compositor_context_);
 }
 
@@ -53,7 +69,8 @@ Rasterizer::Rasterizer(
     : delegate_(delegate),
       compositor_context_(std::move(compositor_context)),
       user_override_resource_cache_bytes_(false),
-      weak_factory_(this) {
+      weak_factory_(this),
+      thread_safe_weak_factory_(this) {
   FML_DCHECK(compositor_context_);
 }
 #endif
@@ -69,6 +86,10 @@ fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> Rasterizer::GetSnapshotDelegate()
   return weak_factory_.GetWeakPtr();
 }
 
+fml::ThreadSafeWeakPtr<Rasterizer> Rasterizer::GetThreadSafeWeakPtr() const {
+  return thread_safe_weak_factory_.GetWeakPtr();
+}
+
 void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   surface_ = std::move(surface);
   if (max_cache_bytes_.has_value()) {
@@ -76,8 +97,11 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
                              user_override_resource_cache_bytes_);
   }
   compositor_context_->OnGrContextCreated();
+  // Embedders that publish their platform views through a composition
+  // timeline don't need the raster thread to run on the platform thread.
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
+      !external_view_embedder_->GetCompositionTimeline() &&
       !raster_thread_merger_) {
     const auto platform_id =
         delegate_.GetTaskRunners().GetPlatformTaskRunner()->GetTaskQueueId();
@@ -97,6 +121,7 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
 }
 
 void Rasterizer::Teardown() {
+  RunDeferredSnapshots();
   compositor_context_->OnGrContextDestroyed();
   surface_.reset();
   last_layer_tree_.reset();
@@ -121,7 +146,16 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
   }
 }
 
-void Rasterizer::NotifyLowMemoryWarning() const {
+void Rasterizer::NotifyLowMemoryWarning(MemoryPressureLevel level) const {
+  auto& raster_cache = compositor_context_->raster_cache();
+  if (level == MemoryPressureLevel::kCritical) {
+    raster_cache.Clear();
+  } else {
+    raster_cache.Trim((raster_cache.EstimatePictureCacheByteSize() +
+                       raster_cache.EstimateLayerCacheByteSize() +
+                       raster_cache.EstimateShadowCacheByteSize()) /
+                      2);
+  }
   if (!surface_) {
     FML_DLOG(INFO)
         << "Rasterizer::NotifyLowMemoryWarning called with no surface.";
@@ -133,22 +167,176 @@ void Rasterizer::NotifyLowMemoryWarning() const {
         << "Rasterizer::NotifyLowMemoryWarning called with no GrContext.";
     return;
   }
+  if (level == MemoryPressureLevel::kModerate) {
+    context->performDeferredCleanup(kModerateMemoryPressureExpiration);
+    return;
+  }
   context->performDeferredCleanup(std::chrono::milliseconds(0));
+  context->freeGpuResources();
+  if (resource_cache_budget_ && !user_override_resource_cache_bytes_ &&
+      resource_cache_budget_->NotifyLowMemoryWarning(fml::TimePoint::Now())) {
+    ApplyResourceCacheMaxBytes(resource_cache_budget_->GetBudget());
+  }
 }
 
 flutter::TextureRegistry* Rasterizer::GetTextureRegistry() {
   return &compositor_context_->texture_registry();
 }
 
+bool Rasterizer::MarkTextureFrameAvailable(int64_t texture_id) {
+  std::shared_ptr<Texture> texture =
+      GetTextureRegistry()->GetTexture(texture_id);
+  if (!texture) {
+    return false;
+  }
+  texture->MarkNewFrameAvailable();
+
+  if (!last_layer_tree_ || !surface_ ||
+      (raster_thread_merger_ &&
+       !raster_thread_merger_->IsOnRasterizingThread())) {
+    return false;
+  }
+  texture_frame_pending_ = true;
+  ScheduleLayerAnimationFrame();
+  return true;
+}
+
 flutter::LayerTree* Rasterizer::GetLastLayerTree() {
   return last_layer_tree_.get();
 }
 
+void Rasterizer::AddView(int64_t view_id, std::unique_ptr<Surface> surface) {
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+  view_surfaces_[view_id] = std::move(surface);
+}
+
+void Rasterizer::RemoveView(int64_t view_id) {
+  view_surfaces_.erase(view_id);
+}
+
+RasterStatus Rasterizer::DrawView(
+    std::unique_ptr<flutter::LayerTree> layer_tree) {
+  TRACE_EVENT0("flutter", "Rasterizer::DrawView");
+  auto found = view_surfaces_.find(layer_tree->view_id());
+  if (found == view_surfaces_.end()) {
+    return RasterStatus::kFailed;
+  }
+  Surface& surface = *found->second;
+
+  auto frame = surface.AcquireFrame(layer_tree->frame_size());
+  if (frame == nullptr) {
+    return RasterStatus::kFailed;
+  }
+
+  const SkMatrix root_surface_transformation = surface.GetRootTransformation();
+  auto compositor_frame = compositor_context_->AcquireFrame(
+      surface.GetContext(),         // skia GrContext
+      frame->SkiaCanvas(),          // root surface canvas
+      nullptr,                      // external view embedder
+      root_surface_transformation,  // root surface transformation
+      false,                        // instrumentation enabled
+      frame->supports_readback(),   // surface supports pixel reads
+      nullptr                       // thread merger
+  );
+  if (!compositor_frame) {
+    return RasterStatus::kFailed;
+  }
+  // The raster cache is swept by the frames of the implicit view, so that it
+  // keeps the entries that only the other views use between them.
+  compositor_frame->set_sweeps_raster_cache(false);
+
+  RasterStatus raster_status =
+      compositor_frame->Raster(*layer_tree, false, nullptr);
+  if (raster_status == RasterStatus::kFailed ||
+      raster_status == RasterStatus::kSkipAndRetry) {
+    return raster_status;
+  }
+  frame->Submit();
+  return raster_status;
+}
+
 void Rasterizer::DrawLastLayerTree() {
   if (!last_layer_tree_ || !surface_) {
     return;
   }
-  DrawToSurface(*last_layer_tree_);
+  if (DrawToSurface(*last_layer_tree_) == RasterStatus::kSuccess) {
+    last_layer_tree_draw_time_ = fml::TimePoint::Now();
+    compositor_scroll_frame_pending_ = false;
+    texture_frame_pending_ = false;
+  }
+  // The frame was submitted without going through |DoDraw|, which would
+  // otherwise end it.
+  if (external_view_embedder_) {
+    external_view_embedder_->EndFrame(/*should_resubmit_frame=*/false,
+                                      raster_thread_merger_);
+  }
+}
+
+bool Rasterizer::HandleCompositorScroll(const SkPoint& device_point,
+                                        const SkVector& device_delta,
+                                        uint64_t pointer_flow_id) {
+  if (!last_layer_tree_ || !last_layer_tree_->root_layer()) {
+    return false;
+  }
+  std::vector<ScrollLayer*> scroll_layers;
+  last_layer_tree_->root_layer()->FindScrollLayers(&scroll_layers);
+  // Like the framework, let the innermost scrollable under the pointer that
+  // is not at the end of its extent take the scroll.
+  for (auto it = scroll_layers.rbegin(); it != scroll_layers.rend(); ++it) {
+    ScrollLayer* layer = *it;
+    if (!layer->ContainsDevicePoint(device_point)) {
+      continue;
+    }
+    const SkPoint previous_offset = layer->offset();
+    if (!layer->ScrollBy(layer->MapDeviceDelta(device_delta))) {
+      continue;
+    }
+    TRACE_EVENT0("flutter", "Rasterizer::HandleCompositorScroll");
+    unacknowledged_scroll_deltas_[layer->scroll_id()].push_back(
+        {pointer_flow_id, layer->offset() - previous_offset});
+    compositor_scroll_frame_pending_ = true;
+    ScheduleLayerAnimationFrame();
+    return true;
+  }
+  return false;
+}
+
+void Rasterizer::ApplyUnacknowledgedScrollDeltas(
+    flutter::LayerTree& layer_tree) {
+  if (unacknowledged_scroll_deltas_.empty()) {
+    return;
+  }
+  const std::optional<uint64_t> flow_id =
+      layer_tree.dispatched_pointer_flow_id();
+  for (auto it = unacknowledged_scroll_deltas_.begin();
+       it != unacknowledged_scroll_deltas_.end();) {
+    auto& deltas = it->second;
+    if (flow_id) {
+      deltas.erase(std::remove_if(deltas.begin(), deltas.end(),
+                                  [&](const CompositorScrollDelta& delta) {
+                                    return delta.pointer_flow_id <= *flow_id;
+                                  }),
+                   deltas.end());
+    }
+    it = deltas.empty() ? unacknowledged_scroll_deltas_.erase(it) : ++it;
+  }
+  if (unacknowledged_scroll_deltas_.empty() || !layer_tree.root_layer()) {
+    return;
+  }
+
+  std::vector<ScrollLayer*> scroll_layers;
+  layer_tree.root_layer()->FindScrollLayers(&scroll_layers);
+  for (ScrollLayer* layer : scroll_layers) {
+    auto deltas = unacknowledged_scroll_deltas_.find(layer->scroll_id());
+    if (deltas == unacknowledged_scroll_deltas_.end()) {
+      continue;
+    }
+    SkVector total_delta = SkVector::Make(0, 0);
+    for (const auto& delta : deltas->second) {
+      total_delta += delta.delta;
+    }
+    layer->SetCompositorScrollDelta(total_delta);
+  }
 }
 
 void Rasterizer::Draw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
@@ -200,12 +388,13 @@ void Rasterizer::Draw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
   // between successive tries.
   switch (consume_result) {
     case PipelineConsumeResult::MoreAvailable: {
-      delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTask(
+      delegate_.GetTaskRunners().GetRasterTaskRunner()->PostTaskWithPriority(
           [weak_this = weak_factory_.GetWeakPtr(), pipeline]() {
             if (weak_this) {
               weak_this->Draw(pipeline);
             }
-          });
+          },
+          fml::TaskPriority::kCritical);
       break;
     }
     default:
@@ -243,6 +432,35 @@ sk_sp<SkImage> DrawSnapshot(
 
   return nullptr;
 }
+
+// The state of a snapshot readback, owned by Skia until its callback runs.
+struct SnapshotReadback {
+  SkImageInfo image_info;
+  std::function<void(SkCanvas*)> draw_callback;
+  SnapshotDelegate::SnapshotCallback callback;
+  std::function<void(std::unique_ptr<SnapshotReadback>, sk_sp<SkImage>)>
+      on_finished;
+};
+
+void OnSnapshotReadPixels(
+    void* context,
+    std::unique_ptr<const SkImage::AsyncReadResult> result) {
+  TRACE_EVENT0("flutter", "OnSnapshotReadPixels");
+  std::unique_ptr<SnapshotReadback> readback(
+      static_cast<SnapshotReadback*>(context));
+  sk_sp<SkImage> raster_image;
+  if (result && result->count() == 1) {
+    // The result only lives as long as this callback.
+    const size_t row_bytes = result->rowBytes(0);
+    raster_image = SkImage::MakeRasterData(
+        readback->image_info,
+        SkData::MakeWithCopy(result->data(0),
+                             row_bytes * readback->image_info.height()),
+        row_bytes);
+  }
+  auto on_finished = std::move(readback->on_finished);
+  on_finished(std::move(readback), std::move(raster_image));
+}
 }  // namespace
 
 sk_sp<SkImage> Rasterizer::DoMakeRasterSnapshot(
@@ -284,6 +502,159 @@ sk_sp<SkImage> Rasterizer::DoMakeRasterSnapshot(
   return result;
 }
 
+void Rasterizer::DoMakeRasterSnapshotAsync(
+    SkISize size,
+    std::function<void(SkCanvas*)> draw_callback,
+    SnapshotCallback callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  bool started = false;
+  if (surface_ != nullptr && surface_->GetContext() != nullptr) {
+    delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+        fml::SyncSwitch::Handlers().SetIfFalse([&] {
+          started = StartSnapshotReadback(size, draw_callback, callback);
+        }));
+  }
+  if (!started) {
+    callback(DoMakeRasterSnapshot(size, std::move(draw_callback)));
+  }
+}
+
+bool Rasterizer::StartSnapshotReadback(
+    SkISize size,
+    const std::function<void(SkCanvas*)>& draw_callback,
+    const SnapshotCallback& callback) {
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return false;
+  }
+
+  GrDirectContext* context = surface_->GetContext();
+  SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      size.width(), size.height(), SkColorSpace::MakeSRGB());
+  sk_sp<SkSurface> surface =
+      SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, image_info);
+  if (surface == nullptr || surface->getCanvas() == nullptr) {
+    return false;
+  }
+  draw_callback(surface->getCanvas());
+
+  // Skia copies the pixels into a transfer buffer once the GPU has drawn
+  // them, and maps the buffer when the copy is done, so the raster thread
+  // never waits on the GPU. A failed readback falls back to a synchronous
+  // snapshot.
+  auto readback = std::make_unique<SnapshotReadback>();
+  readback->image_info = image_info;
+  readback->draw_callback = draw_callback;
+  readback->callback = callback;
+  readback->on_finished = [weak_this = weak_factory_.GetWeakPtr()](
+                              std::unique_ptr<SnapshotReadback> readback,
+                              sk_sp<SkImage> raster_image) {
+    if (weak_this) {
+      weak_this->pending_snapshot_readbacks_--;
+      if (!raster_image) {
+        raster_image = weak_this->DoMakeRasterSnapshot(
+            readback->image_info.dimensions(),
+            std::move(readback->draw_callback));
+      }
+    }
+    readback->callback(std::move(raster_image));
+  };
+  // Skia may invoke the callback right away if the readback fails.
+  if (pending_snapshot_readbacks_++ == 0) {
+    ScheduleSnapshotReadbackCheck();
+  }
+  surface->asyncRescaleAndReadPixels(
+      image_info, SkIRect::MakeSize(size), SkImage::RescaleGamma::kSrc,
+      kNone_SkFilterQuality, &OnSnapshotReadPixels, readback.release());
+  context->submit();
+  return true;
+}
+
+void Rasterizer::ScheduleSnapshotReadbackCheck() {
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (weak_this) {
+          weak_this->CheckSnapshotReadbacks();
+        }
+      },
+      kSnapshotReadbackCheckInterval);
+}
+
+void Rasterizer::ScheduleLayerAnimationFrame() {
+  if (layer_animation_frame_scheduled_) {
+    return;
+  }
+  layer_animation_frame_scheduled_ = true;
+
+  // Draw at the start of the next frame interval, as a frame built by the
+  // framework would be, so that the frame has the whole interval to make it
+  // to the display.
+  const fml::TimeDelta frame_interval =
+      fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count());
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const fml::TimePoint latest_target_time =
+      delegate_.GetLatestFrameTargetTime();
+  fml::TimeDelta delay = frame_interval;
+  if (latest_target_time > now) {
+    delay = latest_target_time - now;
+  } else if (frame_interval > fml::TimeDelta::Zero()) {
+    delay = frame_interval - (now - latest_target_time) % frame_interval;
+  }
+
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (weak_this) {
+          weak_this->DrawLayerAnimationFrame();
+        }
+      },
+      delay);
+}
+
+void Rasterizer::DrawLayerAnimationFrame() {
+  layer_animation_frame_scheduled_ = false;
+  if (!last_layer_tree_ || !surface_ ||
+      !(last_layer_tree_->has_running_animations() ||
+        compositor_scroll_frame_pending_ || texture_frame_pending_)) {
+    return;
+  }
+  if (raster_thread_merger_ &&
+      !raster_thread_merger_->IsOnRasterizingThread()) {
+    return;
+  }
+
+  // A tree built by the framework was drawn in the meantime, which advanced
+  // the animations, applied the scrolls and painted the latest texture frames
+  // already.
+  const fml::TimeDelta frame_interval =
+      fml::TimeDelta::FromMillisecondsF(delegate_.GetFrameBudget().count());
+  if (fml::TimePoint::Now() - last_layer_tree_draw_time_ < frame_interval / 2) {
+    ScheduleLayerAnimationFrame();
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "Rasterizer::DrawLayerAnimationFrame");
+  DrawLastLayerTree();
+  if (last_layer_tree_->has_running_animations()) {
+    ScheduleLayerAnimationFrame();
+  }
+}
+
+void Rasterizer::CheckSnapshotReadbacks() {
+  if (pending_snapshot_readbacks_ == 0 || surface_ == nullptr ||
+      surface_->GetContext() == nullptr) {
+    return;
+  }
+  {
+    auto context_switch = surface_->MakeRenderContextCurrent();
+    if (context_switch->GetResult()) {
+      surface_->GetContext()->checkAsyncWorkCompletion();
+    }
+  }
+  if (pending_snapshot_readbacks_ > 0) {
+    ScheduleSnapshotReadbackCheck();
+  }
+}
+
 sk_sp<SkImage> Rasterizer::MakeRasterSnapshot(sk_sp<SkPicture> picture,
                                               SkISize picture_size) {
   return DoMakeRasterSnapshot(picture_size,
@@ -292,6 +663,18 @@ sk_sp<SkImage> Rasterizer::MakeRasterSnapshot(sk_sp<SkPicture> picture,
                               });
 }
 
+void Rasterizer::MakeRasterSnapshotAsync(sk_sp<SkPicture> picture,
+                                         SkISize picture_size,
+                                         SnapshotCallback callback) {
+  RunOrDeferSnapshot([this, picture = std::move(picture), picture_size,
+                      callback = std::move(callback)]() {
+    DoMakeRasterSnapshotAsync(
+        picture_size,
+        [picture](SkCanvas* canvas) { canvas->drawPicture(picture); },
+        callback);
+  });
+}
+
 sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
@@ -313,6 +696,49 @@ sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
                               });
 }
 
+void Rasterizer::ConvertToRasterImageAsync(sk_sp<SkImage> image,
+                                           SnapshotCallback callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+
+  RunOrDeferSnapshot(
+      [this, image = std::move(image), callback = std::move(callback)]() {
+        // See |ConvertToRasterImage|.
+        if (surface_ == nullptr || surface_->GetContext() == nullptr ||
+            image == nullptr) {
+          callback(nullptr);
+          return;
+        }
+
+        SkISize image_size = image->dimensions();
+        DoMakeRasterSnapshotAsync(
+            image_size,
+            [image](SkCanvas* canvas) { canvas->drawImage(image, 0, 0); },
+            callback);
+      });
+}
+
+void Rasterizer::RunOrDeferSnapshot(fml::closure snapshot) {
+  if (delegate_.ShouldDeferSnapshots()) {
+    TRACE_EVENT0("flutter", "Rasterizer::DeferSnapshot");
+    deferred_snapshots_.push_back(std::move(snapshot));
+    return;
+  }
+  snapshot();
+}
+
+void Rasterizer::RunDeferredSnapshots() {
+  if (deferred_snapshots_.empty()) {
+    return;
+  }
+  TRACE_EVENT1("flutter", "Rasterizer::RunDeferredSnapshots", "count",
+               std::to_string(deferred_snapshots_.size()).c_str());
+  std::vector<fml::closure> snapshots;
+  std::swap(snapshots, deferred_snapshots_);
+  for (const auto& snapshot : snapshots) {
+    snapshot();
+  }
+}
+
 RasterStatus Rasterizer::DoDraw(
     std::unique_ptr<flutter::LayerTree> layer_tree) {
   FML_DCHECK(delegate_.GetTaskRunners()
@@ -332,12 +758,33 @@ RasterStatus Rasterizer::DoDraw(
   timing.Set(FrameTiming::kBuildFinish, layer_tree->build_finish());
   timing.Set(FrameTiming::kRasterStart, fml::TimePoint::Now());
 
+  // On displays with a variable refresh rate, the vsync interval of each frame
+  // is its budget, rather than the nominal rate of the display.
+  fml::Milliseconds frame_budget = delegate_.GetFrameBudget();
+  const fml::TimeDelta vsync_interval =
+      layer_tree->target_time() - layer_tree->vsync_start();
+  if (vsync_interval > fml::TimeDelta::Zero()) {
+    frame_budget = fml::Milliseconds(vsync_interval.ToMillisecondsF());
+  }
+  compositor_context_->SetFrameBudget(frame_budget);
+
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
 
+  ApplyUnacknowledgedScrollDeltas(*layer_tree);
   RasterStatus raster_status = DrawToSurface(*layer_tree);
   if (raster_status == RasterStatus::kSuccess) {
+    auto& frame_histograms = compositor_context_->frame_histograms();
+    frame_histograms.Record(FrameHistograms::kVsyncOverhead,
+                            layer_tree->vsync_overhead());
+    frame_histograms.Record(FrameHistograms::kBuild, layer_tree->build_time());
     last_layer_tree_ = std::move(layer_tree);
+    last_layer_tree_draw_time_ = fml::TimePoint::Now();
+    compositor_scroll_frame_pending_ = false;
+    texture_frame_pending_ = false;
+    if (last_layer_tree_->has_running_animations()) {
+      ScheduleLayerAnimationFrame();
+    }
   } else if (raster_status == RasterStatus::kResubmit ||
              raster_status == RasterStatus::kSkipAndRetry) {
     resubmitted_layer_tree_ = std::move(layer_tree);
@@ -364,7 +811,7 @@ RasterStatus Rasterizer::DoDraw(
   if (raster_finish_time > frame_target_time) {
     fml::TimePoint latest_frame_target_time =
         delegate_.GetLatestFrameTargetTime();
-    const auto frame_budget_millis = delegate_.GetFrameBudget().count();
+    const auto frame_budget_millis = frame_budget.count();
     if (latest_frame_target_time < raster_finish_time) {
       latest_frame_target_time =
           latest_frame_target_time +
@@ -460,12 +907,29 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
       raster_thread_merger_           // thread merger
   );
 
+  // Partial repaint is only attempted when the whole frame is rendered into
+  // the root surface and that surface is able to present it.
+  std::unique_ptr<FrameDamage> damage;
+  if (!external_view_embedder_ &&
+      frame->framebuffer_info().supports_partial_repaint) {
+    damage = std::make_unique<FrameDamage>();
+    damage->SetExistingBufferDamage(frame->framebuffer_info().existing_damage);
+    if (last_layer_tree_) {
+      damage->SetPreviousPaintRegions(last_layer_tree_->paint_regions());
+    }
+  }
+
   if (compositor_frame) {
-    RasterStatus raster_status = compositor_frame->Raster(layer_tree, false);
+    RasterStatus raster_status =
+        compositor_frame->Raster(layer_tree, false, damage.get());
     if (raster_status == RasterStatus::kFailed ||
         raster_status == RasterStatus::kSkipAndRetry) {
       return raster_status;
     }
+    if (damage) {
+      frame->set_submit_info({damage->frame_damage(), damage->buffer_damage()});
+    }
+    const fml::TimePoint submit_start = fml::TimePoint::Now();
     if (external_view_embedder_ &&
         (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
       FML_DCHECK(!frame->IsSubmitted());
@@ -474,6 +938,19 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
     } else {
       frame->Submit();
     }
+    compositor_context_->frame_histograms().Record(
+        FrameHistograms::kSubmit, fml::TimePoint::Now() - submit_start);
+
+    // The GPU times trail the frames by the depth of the GPU queue.
+    for (const auto& gpu_time : surface_->TakeGPUFrameTimes()) {
+      compositor_context_->gpu_time().SetLapTime(gpu_time);
+      compositor_context_->frame_histograms().Record(FrameHistograms::kGPU,
+                                                     gpu_time);
+    }
+
+    if (auto feedback = surface_->TakePresentationFeedback()) {
+      delegate_.OnPresentationFeedback(*feedback);
+    }
 
     FireNextFrameCallbackIfPresent();
 
@@ -482,6 +959,8 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
       surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
     }
 
+    RecordResourceCacheUsage();
+
     return raster_status;
   }
 
@@ -504,7 +983,7 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   auto frame = compositor_context.ACQUIRE_FRAME(
       nullptr, recorder.getRecordingCanvas(), nullptr,
       root_surface_transformation, false, true, nullptr);
-  frame->Raster(*tree, true);
+  frame->Raster(*tree, true, nullptr);
 
 #if defined(OS_FUCHSIA)
   SkSerialProcs procs = {0};
@@ -518,6 +997,15 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   return recorder.finishRecordingAsPicture()->serialize(&procs);
 }
 
+static sk_sp<SkData> ScreenshotLayerTreeAsCapture(flutter::LayerTree* tree) {
+  FML_DCHECK(tree != nullptr);
+  // The typefaces are embedded so that the capture can be replayed on a
+  // device without the fonts of the application.
+  SkSerialProcs procs = {0};
+  procs.fTypefaceProc = SerializeTypefaceWithData;
+  return CaptureLayerTree(*tree, procs);
+}
+
 static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
                                               const SkISize& size) {
   const auto image_info = SkImageInfo::MakeN32Premul(
@@ -572,7 +1060,7 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
       surface_context, canvas, nullptr, root_surface_transformation, false,
       true, nullptr);
   canvas->clear(SK_ColorTRANSPARENT);
-  frame->Raster(*tree, true);
+  frame->Raster(*tree, true, nullptr);
   canvas->flush();
 
   // Prepare an image from the surface, this image may potentially be on th GPU.
@@ -630,6 +1118,9 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
       data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
                                         surface_context, true);
       break;
+    case ScreenshotType::LayerTreeCapture:
+      data = ScreenshotLayerTreeAsCapture(layer_tree);
+      break;
   }
 
   if (data == nullptr) {
@@ -676,6 +1167,14 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 
   max_cache_bytes_ = max_bytes;
+  if (resource_cache_budget_ && !user_override_resource_cache_bytes_) {
+    resource_cache_budget_->SetBaseBudget(max_bytes);
+    max_bytes = resource_cache_budget_->GetBudget();
+  }
+  ApplyResourceCacheMaxBytes(max_bytes);
+}
+
+void Rasterizer::ApplyResourceCacheMaxBytes(size_t max_bytes) const {
   if (!surface_) {
     return;
   }
@@ -688,6 +1187,43 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 }
 
+void Rasterizer::EnableAdaptiveResourceCacheBudget(size_t device_memory_bytes) {
+  resource_cache_budget_ =
+      std::make_unique<ResourceCacheBudget>(device_memory_bytes);
+  if (max_cache_bytes_.has_value()) {
+    SetResourceCacheMaxBytes(max_cache_bytes_.value(), false);
+  }
+}
+
+const ResourceCacheBudget* Rasterizer::GetResourceCacheBudget() const {
+  return user_override_resource_cache_bytes_ ? nullptr
+                                             : resource_cache_budget_.get();
+}
+
+void Rasterizer::RecordResourceCacheUsage() {
+  if (!resource_cache_budget_ || user_override_resource_cache_bytes_ ||
+      !surface_) {
+    return;
+  }
+  GrDirectContext* context = surface_->GetContext();
+  if (!context) {
+    return;
+  }
+  size_t usage_bytes = 0;
+  context->getResourceCacheUsage(nullptr, &usage_bytes);
+  if (resource_cache_budget_->RecordFrame(
+          usage_bytes, context->getResourceCachePurgeableBytes(),
+          fml::TimePoint::Now())) {
+    const size_t budget = resource_cache_budget_->GetBudget();
+    TRACE_EVENT2(
+        "flutter", "Rasterizer::AdaptResourceCacheBudget", "bytes",
+        std::to_string(budget).c_str(), "decision",
+        ResourceCacheBudget::DecisionToString(
+            resource_cache_budget_->GetLastDecision()));
+    ApplyResourceCacheMaxBytes(budget);
+  }
+}
+
 std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
   if (!surface_) {
     return std::nullopt;
@@ -701,6 +1237,20 @@ std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
   return std::nullopt;
 }
 
+std::optional<std::pair<size_t, size_t>> Rasterizer::GetResourceCacheUsage()
+    const {
+  if (!surface_) {
+    return std::nullopt;
+  }
+  GrDirectContext* context = surface_->GetContext();
+  if (!context) {
+    return std::nullopt;
+  }
+  size_t used_bytes = 0;
+  context->getResourceCacheUsage(nullptr, &used_bytes);
+  return std::make_pair(used_bytes, context->getResourceCachePurgeableBytes());
+}
+
 Rasterizer::Screenshot::Screenshot() {}
 
 Rasterizer::Screenshot::Screenshot(sk_sp<SkData> p_data, SkISize p_size)
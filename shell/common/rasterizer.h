@@ -5,16 +5,21 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <map>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "flow/embedded_views.h"
+#include "flutter/common/memory_pressure_level.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/memory/thread_safe_weak_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -23,6 +28,7 @@
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/resource_cache_budget.h"
 
 namespace flutter {
 
@@ -69,6 +75,16 @@ class Rasterizer final : public SnapshotDelegate {
     ///
     virtual void OnFrameRasterized(const FrameTiming& frame_timing) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate of how the recently presented frames
+    ///             met the display, for surfaces whose presentation engine
+    ///             reports it. The shell forwards this to the vsync waiter.
+    ///
+    /// @see        `Surface::TakePresentationFeedback`
+    ///
+    virtual void OnPresentationFeedback(
+        const PresentationFeedback& feedback) = 0;
+
     /// Time limit for a smooth frame.
     ///
     /// See: `DisplayManager::GetMainDisplayRefreshRate`.
@@ -88,6 +104,12 @@ class Rasterizer final : public SnapshotDelegate {
     /// is critical that GPU operations are not processed.
     virtual std::shared_ptr<fml::SyncSwitch> GetIsGpuDisabledSyncSwitch()
         const = 0;
+
+    /// Whether asynchronous snapshots requested now should wait because the
+    /// UI thread is building a frame, which it has yet to post for
+    /// rasterization. If so, the delegate calls `RunDeferredSnapshots` once
+    /// that frame was posted.
+    virtual bool ShouldDeferSnapshots() = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -148,13 +170,59 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   void Teardown();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the on-screen surface of a view that the platform
+  ///             renders in addition to the implicit view, whose surface is
+  ///             provided with `Rasterizer::Setup`. The views share the
+  ///             compositor context, and so the raster cache, of the
+  ///             rasterizer. The surface is held till the balancing call to
+  ///             `Rasterizer::RemoveView`.
+  ///
+  /// @see        `PlatformView::AddView`
+  ///
+  /// @param[in]  view_id  The id of the view.
+  /// @param[in]  surface  The on-screen render surface of the view.
+  ///
+  void AddView(int64_t view_id, std::unique_ptr<Surface> surface);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the surface of a view added with
+  ///             `Rasterizer::AddView`.
+  ///
+  /// @param[in]  view_id  The id of the view.
+  ///
+  void RemoveView(int64_t view_id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws a layer tree the framework rendered for a view added
+  ///             with `Rasterizer::AddView` into the surface of the view.
+  ///             Unlike the trees of the implicit view, these do not come
+  ///             through the pipeline, are not kept for redraws, and are drawn
+  ///             without the external view embedder.
+  ///
+  /// @param[in]  layer_tree  The layer tree to draw.
+  ///
+  /// @return     The result of the draw, which fails if the view of the tree
+  ///             is not known.
+  ///
+  RasterStatus DrawView(std::unique_ptr<flutter::LayerTree> layer_tree);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the rasterizer that there is a low memory situation
   ///             and it must purge as many unnecessary resources as possible.
   ///             Currently, the Skia context associated with onscreen rendering
   ///             is told to free GPU resources.
   ///
-  void NotifyLowMemoryWarning() const;
+  ///             Under moderate pressure, only the least recently used half
+  ///             of the raster cache and the GPU resources unused for a
+  ///             second are freed. Under critical pressure, the raster cache
+  ///             is cleared and Skia frees all its GPU resources, including
+  ///             its glyph atlases.
+  ///
+  /// @param[in]  level  How much memory the rasterizer should free.
+  ///
+  void NotifyLowMemoryWarning(
+      MemoryPressureLevel level = MemoryPressureLevel::kCritical) const;
 
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
@@ -166,6 +234,16 @@ class Rasterizer final : public SnapshotDelegate {
 
   fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> GetSnapshotDelegate() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets a weak pointer to the rasterizer that can be pinned on
+  ///             any thread. It is meant for reading the statistics of the
+  ///             rasterizer that are safe to read from any thread, like the
+  ///             frame histograms, without waiting on the raster task runner.
+  ///
+  /// @return     The thread-safe weak pointer to the rasterizer.
+  ///
+  fml::ThreadSafeWeakPtr<Rasterizer> GetThreadSafeWeakPtr() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Sometimes, it may be necessary to render the same frame again
   ///             without having to wait for the framework to build a whole new
@@ -196,6 +274,31 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   void DrawLastLayerTree();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Scrolls the innermost scroll layer of the last layer tree
+  ///             under |device_point| that can still move by |device_delta|,
+  ///             and draws the tree again on the next frame interval. This
+  ///             lets pointer scroll events scroll already recorded content
+  ///             without waiting for the framework to build a new frame.
+  ///
+  ///             The framework receives the same events and scrolls by the
+  ///             same deltas. Until it has, the layer trees it builds are
+  ///             drawn with the deltas the rasterizer applied ahead of it,
+  ///             which are then dropped.
+  ///
+  /// @param[in]  device_point     The position of the event on the surface.
+  /// @param[in]  device_delta     The scroll delta of the event in physical
+  ///                              pixels.
+  /// @param[in]  pointer_flow_id  The trace flow id of the pointer data
+  ///                              packet of the event. See
+  ///                              |LayerTree::dispatched_pointer_flow_id|.
+  ///
+  /// @return     Whether a scroll layer moved.
+  ///
+  bool HandleCompositorScroll(const SkPoint& device_point,
+                              const SkVector& device_delta,
+                              uint64_t pointer_flow_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the registry of external textures currently in use by the
   ///             rasterizer. These textures may be updated at a cadence
@@ -207,6 +310,25 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   flutter::TextureRegistry* GetTextureRegistry();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the texture |texture_id| that its producer has a new
+  ///             frame, and draws the last layer tree again at the start of
+  ///             the next frame interval so that the texture paints it.
+  ///
+  ///             Notifications from any number of textures within a frame
+  ///             interval result in a single draw, in which every texture
+  ///             paints its latest frame. Neither the UI thread nor the
+  ///             framework take part.
+  ///
+  /// @param[in]  texture_id  The identifier of the texture.
+  ///
+  /// @return     Whether the last layer tree will be drawn again. If not,
+  ///             for example before the first frame or while the raster
+  ///             thread is merged with the platform thread for platform
+  ///             views, the caller must schedule a frame instead.
+  ///
+  bool MarkTextureFrameAvailable(int64_t texture_id);
+
   using LayerTreeDiscardCallback = std::function<bool(flutter::LayerTree&)>;
 
   //----------------------------------------------------------------------------
@@ -271,6 +393,16 @@ class Rasterizer final : public SnapshotDelegate {
     /// container is used.
     ///
     CompressedImage,
+
+    //--------------------------------------------------------------------------
+    /// A format used to denote a layer tree capture. Unlike a Skia picture, a
+    /// capture keeps the structure of the layer tree, so that the frame can
+    /// be rasterized again through a compositor context, with its raster
+    /// cache and offscreen layers, by the `layer_tree_replay` tool.
+    ///
+    /// @see      `CaptureLayerTree`
+    ///
+    LayerTreeCapture,
   };
 
   //----------------------------------------------------------------------------
@@ -370,6 +502,17 @@ class Rasterizer final : public SnapshotDelegate {
     return compositor_context_.get();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the raster thread merger of this rasterizer. This is
+  ///             `nullptr` unless the external view embedder supports dynamic
+  ///             thread merging and the rasterizer has been set up.
+  ///
+  /// @return     The raster thread merger used by this rasterizer.
+  ///
+  fml::RefPtr<fml::RasterThreadMerger> GetRasterThreadMerger() {
+    return raster_thread_merger_;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Skia has no notion of time. To work around the performance
   ///             implications of this, it may cache GPU resources to reference
@@ -409,6 +552,42 @@ class Rasterizer final : public SnapshotDelegate {
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes held by Skia's resource cache and how many
+  ///             of them are purgeable, if a surface is present.
+  ///
+  /// @return     The used and purgeable bytes of Skia's resource cache, if
+  ///             available.
+  ///
+  std::optional<std::pair<size_t, size_t>> GetResourceCacheUsage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adapts the size of Skia's resource cache to how the cache is
+  ///             used after each frame, starting from the size set by the
+  ///             platform with `SetResourceCacheMaxBytes`. A size set by user
+  ///             code disables the adaptation.
+  ///
+  /// @see        `ResourceCacheBudget`
+  ///
+  /// @param[in]  device_memory_bytes  The physical memory of the device, or 0
+  ///                                  if it is not known.
+  ///
+  void EnableAdaptiveResourceCacheBudget(size_t device_memory_bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The controller adapting the size of Skia's resource cache,
+  ///             or null if the size is not adapted.
+  ///
+  const ResourceCacheBudget* GetResourceCacheBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the asynchronous snapshots, e.g. of `Picture.toImage`,
+  ///             that were deferred while the UI thread was building a frame.
+  ///
+  /// @see        `Delegate::ShouldDeferSnapshots`
+  ///
+  void RunDeferredSnapshots();
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -436,6 +615,8 @@ class Rasterizer final : public SnapshotDelegate {
  private:
   Delegate& delegate_;
   std::unique_ptr<Surface> surface_;
+  // The surfaces of the views added with |AddView|, by view id.
+  std::map<int64_t, std::unique_ptr<Surface>> view_surfaces_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
   // This is the last successfully rasterized layer tree.
   std::unique_ptr<flutter::LayerTree> last_layer_tree_;
@@ -446,9 +627,38 @@ class Rasterizer final : public SnapshotDelegate {
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
+  std::unique_ptr<ResourceCacheBudget> resource_cache_budget_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
+  // The number of snapshots whose pixels are being read back from the GPU.
+  size_t pending_snapshot_readbacks_ = 0;
+  // The asynchronous snapshots waiting for the frame the UI thread is building
+  // to be posted, so that they don't delay its rasterization.
+  std::vector<fml::closure> deferred_snapshots_;
+  // Whether a frame is scheduled to advance the layer animations of
+  // |last_layer_tree_|, and when that tree was last drawn.
+  bool layer_animation_frame_scheduled_ = false;
+  fml::TimePoint last_layer_tree_draw_time_;
+  // The scroll deltas applied by |HandleCompositorScroll| that the framework
+  // may not have received yet, by scroll id.
+  struct CompositorScrollDelta {
+    uint64_t pointer_flow_id;
+    SkVector delta;
+  };
+  std::map<int64_t, std::vector<CompositorScrollDelta>>
+      unacknowledged_scroll_deltas_;
+  // Whether |last_layer_tree_| was scrolled since it was last drawn.
+  bool compositor_scroll_frame_pending_ = false;
+  // Whether a texture has a new frame since |last_layer_tree_| was drawn.
+  bool texture_frame_pending_ = false;
+  // Must be the last member so that pins from other threads are released
+  // before any other member is destroyed.
+  fml::ThreadSafeWeakPtrFactory<Rasterizer> thread_safe_weak_factory_;
+
+  void ApplyResourceCacheMaxBytes(size_t max_bytes) const;
+
+  void RecordResourceCacheUsage();
 
   // |SnapshotDelegate|
   sk_sp<SkImage> MakeRasterSnapshot(sk_sp<SkPicture> picture,
@@ -457,6 +667,15 @@ class Rasterizer final : public SnapshotDelegate {
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
+  // |SnapshotDelegate|
+  void MakeRasterSnapshotAsync(sk_sp<SkPicture> picture,
+                               SkISize picture_size,
+                               SnapshotCallback callback) override;
+
+  // |SnapshotDelegate|
+  void ConvertToRasterImageAsync(sk_sp<SkImage> image,
+                                 SnapshotCallback callback) override;
+
   sk_sp<SkData> ScreenshotLayerTreeAsImage(
       flutter::LayerTree* tree,
       flutter::CompositorContext& compositor_context,
@@ -467,6 +686,40 @@ class Rasterizer final : public SnapshotDelegate {
       SkISize size,
       std::function<void(SkCanvas*)> draw_callback);
 
+  // Runs |snapshot| now, or with |RunDeferredSnapshots| if the delegate asks
+  // for snapshots to be deferred.
+  void RunOrDeferSnapshot(fml::closure snapshot);
+
+  void DoMakeRasterSnapshotAsync(SkISize size,
+                                 std::function<void(SkCanvas*)> draw_callback,
+                                 SnapshotCallback callback);
+
+  // Draws the snapshot on the GPU and starts reading its pixels back into a
+  // transfer buffer. Returns false if the readback could not be started.
+  bool StartSnapshotReadback(
+      SkISize size,
+      const std::function<void(SkCanvas*)>& draw_callback,
+      const SnapshotCallback& callback);
+
+  // Lets Skia invoke the callbacks of the finished readbacks, and checks again
+  // later while some are pending.
+  void CheckSnapshotReadbacks();
+
+  void ScheduleSnapshotReadbackCheck();
+
+  // Draws |last_layer_tree_| again at the start of the next frame interval
+  // while it has running layer animations, so that they advance without new
+  // layer trees, or after it was scrolled or one of its textures got a new
+  // frame. See |LayerAnimation|, |HandleCompositorScroll| and
+  // |MarkTextureFrameAvailable|.
+  void ScheduleLayerAnimationFrame();
+
+  void DrawLayerAnimationFrame();
+
+  // Drops the scroll deltas that the framework received before it built
+  // |layer_tree|, and applies the others to its scroll layers.
+  void ApplyUnacknowledgedScrollDeltas(flutter::LayerTree& layer_tree);
+
   RasterStatus DoDraw(std::unique_ptr<flutter::LayerTree> layer_tree);
 
   RasterStatus DrawToSurface(flutter::LayerTree& layer_tree);
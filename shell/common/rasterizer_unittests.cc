@@ -6,11 +6,13 @@
 
 #include "flutter/shell/common/rasterizer.h"
 
+#include "flutter/flow/composition_timeline.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
 
 using testing::_;
+using testing::AnyNumber;
 using testing::ByMove;
 using testing::Return;
 using testing::ReturnRef;
@@ -20,11 +22,14 @@ namespace {
 class MockDelegate : public Rasterizer::Delegate {
  public:
   MOCK_METHOD1(OnFrameRasterized, void(const FrameTiming& frame_timing));
+  MOCK_METHOD1(OnPresentationFeedback,
+               void(const PresentationFeedback& feedback));
   MOCK_METHOD0(GetFrameBudget, fml::Milliseconds());
   MOCK_CONST_METHOD0(GetLatestFrameTargetTime, fml::TimePoint());
   MOCK_CONST_METHOD0(GetTaskRunners, const TaskRunners&());
   MOCK_CONST_METHOD0(GetIsGpuDisabledSyncSwitch,
                      std::shared_ptr<fml::SyncSwitch>());
+  MOCK_METHOD0(ShouldDeferSnapshots, bool());
 };
 
 class MockSurface : public Surface {
@@ -37,6 +42,9 @@ class MockSurface : public Surface {
   MOCK_METHOD0(GetExternalViewEmbedder, ExternalViewEmbedder*());
   MOCK_METHOD0(MakeRenderContextCurrent, std::unique_ptr<GLContextResult>());
   MOCK_METHOD0(ClearRenderContext, bool());
+  MOCK_METHOD0(TakeGPUFrameTimes, std::vector<fml::TimeDelta>());
+  MOCK_METHOD0(TakePresentationFeedback,
+               std::optional<PresentationFeedback>());
 };
 
 class MockExternalViewEmbedder : public ExternalViewEmbedder {
@@ -62,6 +70,22 @@ class MockExternalViewEmbedder : public ExternalViewEmbedder {
                void(bool should_resubmit_frame,
                     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger));
   MOCK_METHOD0(SupportsDynamicThreadMerging, bool());
+  MOCK_METHOD0(GetCompositionTimeline, fml::RefPtr<CompositionTimeline>());
+};
+
+class MockTexture : public Texture {
+ public:
+  explicit MockTexture(int64_t id) : Texture(id) {}
+  MOCK_METHOD5(Paint,
+               void(SkCanvas& canvas,
+                    const SkRect& bounds,
+                    bool freeze,
+                    GrDirectContext* context,
+                    SkFilterQuality quality));
+  MOCK_METHOD0(OnGrContextCreated, void());
+  MOCK_METHOD0(OnGrContextDestroyed, void());
+  MOCK_METHOD0(MarkNewFrameAvailable, void());
+  MOCK_METHOD0(OnTextureUnregistered, void());
 };
 }  // namespace
 
@@ -262,6 +286,271 @@ TEST(
   rasterizer->Draw(pipeline, no_discard);
 }
 
+TEST(RasterizerTest,
+     drawWithExternalViewEmbedderAndCompositionTimelineDoesNotMergeThreads) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+  auto timeline = fml::MakeRefCounted<CompositionTimeline>(
+      task_runners.GetPlatformTaskRunner(),
+      [](const CompositionTimeline::Transaction&) {});
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*external_view_embedder, GetCompositionTimeline)
+      .WillRepeatedly(Return(timeline));
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*supports_readback=*/true,
+      /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) { return true; });
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+
+  // Without a thread merger, the frame is submitted from the raster thread.
+  auto has_no_merger = ::testing::Truly(
+      [](const fml::RefPtr<fml::RasterThreadMerger>& merger) {
+        return !merger;
+      });
+  EXPECT_CALL(*external_view_embedder,
+              BeginFrame(/*frame_size=*/SkISize(), /*context=*/nullptr,
+                         /*device_pixel_ratio=*/2.0,
+                         /*raster_thread_merger=*/has_no_merger))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder, SubmitFrame).Times(1);
+  EXPECT_CALL(*external_view_embedder, EndFrame(/*should_resubmit_frame=*/false,
+                                                /*raster_thread_merger=*/_))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    rasterizer->Draw(pipeline, no_discard);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawRecordsTheGPUTimesOfTheSurface) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*supports_readback=*/true,
+      /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) { return true; });
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  std::vector<fml::TimeDelta> gpu_times = {fml::TimeDelta::FromMilliseconds(2),
+                                           fml::TimeDelta::FromMilliseconds(5)};
+  EXPECT_CALL(*surface, TakeGPUFrameTimes()).WillOnce(Return(gpu_times));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    rasterizer->Draw(pipeline, no_discard);
+    latch.Signal();
+  });
+  latch.Wait();
+
+  auto summary = rasterizer->compositor_context()->frame_histograms().Summarize(
+      FrameHistograms::kGPU);
+  EXPECT_EQ(summary.count, 2u);
+  EXPECT_EQ(summary.max, 5000u);
+  EXPECT_EQ(rasterizer->compositor_context()->gpu_time().MaxDelta(),
+            fml::TimeDelta::FromMilliseconds(5));
+}
+
+TEST(RasterizerTest, drawForwardsThePresentationFeedbackOfTheSurface) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  PresentationFeedback forwarded;
+  EXPECT_CALL(delegate, OnPresentationFeedback(_))
+      .WillOnce([&forwarded](const PresentationFeedback& feedback) {
+        forwarded = feedback;
+      });
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*supports_readback=*/true,
+      /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) { return true; });
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  PresentationFeedback feedback;
+  feedback.refresh_period = fml::TimeDelta::FromMicroseconds(8333);
+  feedback.present_margin = fml::TimeDelta::FromMicroseconds(1500);
+  feedback.late_frames = 1;
+  EXPECT_CALL(*surface, TakePresentationFeedback()).WillOnce(Return(feedback));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    rasterizer->Draw(pipeline, no_discard);
+    latch.Signal();
+  });
+  latch.Wait();
+
+  EXPECT_EQ(forwarded.refresh_period, fml::TimeDelta::FromMicroseconds(8333));
+  EXPECT_EQ(forwarded.present_margin, fml::TimeDelta::FromMicroseconds(1500));
+  EXPECT_EQ(forwarded.late_frames, 1u);
+}
+
+TEST(RasterizerTest, drawLastLayerTreeEndsTheExternalViewEmbedderFrame) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  MockDelegate delegate;
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(AnyNumber());
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<MockSurface>();
+
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .Times(2)
+      .WillRepeatedly([](const SkISize&) {
+        return std::make_unique<SurfaceFrame>(
+            /*surface=*/nullptr, /*supports_readback=*/true,
+            /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) {
+              return true;
+            });
+      });
+  EXPECT_CALL(*external_view_embedder, BeginFrame).Times(2);
+  EXPECT_CALL(*external_view_embedder, SubmitFrame).Times(2);
+  // Once for the tree drawn from the pipeline, and once for the same tree
+  // drawn again for a new texture frame.
+  EXPECT_CALL(
+      *external_view_embedder,
+      EndFrame(/*should_resubmit_frame=*/false,
+               /*raster_thread_merger=*/fml::RefPtr<fml::RasterThreadMerger>(
+                   nullptr)))
+      .Times(2);
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/10));
+    auto layer_tree = std::make_unique<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    bool result = pipeline->Produce().Complete(std::move(layer_tree));
+    EXPECT_TRUE(result);
+    auto no_discard = [](LayerTree&) { return false; };
+    rasterizer->Draw(pipeline, no_discard);
+    rasterizer->DrawLastLayerTree();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawViewDrawsIntoTheSurfaceOfTheView) {
+  MockDelegate delegate;
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto view_surface = std::make_unique<MockSurface>();
+
+  std::shared_ptr<MockExternalViewEmbedder> external_view_embedder =
+      std::make_shared<MockExternalViewEmbedder>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+
+  // The trees of other views than the implicit one are drawn without the
+  // external view embedder.
+  EXPECT_CALL(*external_view_embedder, BeginFrame).Times(0);
+  EXPECT_CALL(*view_surface, AcquireFrame(SkISize::Make(30, 40)))
+      .WillOnce([](const SkISize&) {
+        return std::make_unique<SurfaceFrame>(
+            /*surface=*/nullptr, /*supports_readback=*/true,
+            /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) {
+              return true;
+            });
+      });
+
+  rasterizer->AddView(/*view_id=*/1, std::move(view_surface));
+
+  auto layer_tree = std::make_unique<LayerTree>(
+      /*frame_size=*/SkISize::Make(30, 40), /*device_pixel_ratio=*/2.0f);
+  layer_tree->set_view_id(1);
+  EXPECT_EQ(rasterizer->DrawView(std::move(layer_tree)),
+            RasterStatus::kSuccess);
+
+  // Trees of views that were removed are dropped.
+  rasterizer->RemoveView(/*view_id=*/1);
+  layer_tree = std::make_unique<LayerTree>(
+      /*frame_size=*/SkISize::Make(30, 40), /*device_pixel_ratio=*/2.0f);
+  layer_tree->set_view_id(1);
+  EXPECT_EQ(rasterizer->DrawView(std::move(layer_tree)), RasterStatus::kFailed);
+}
+
 TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNoSurfaceIsSet) {
   std::string test_name =
       ::testing::UnitTest::GetInstance()->current_test_info()->name();
@@ -297,4 +586,19 @@ TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNoSurfaceIsSet) {
   });
   latch.Wait();
 }
+
+TEST(RasterizerTest, textureFramesNeedAFrameBeforeTheFirstLayerTree) {
+  MockDelegate delegate;
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto texture = std::make_shared<MockTexture>(/*id=*/7);
+  rasterizer->GetTextureRegistry()->RegisterTexture(texture);
+
+  // The texture is told about its new frame, but there is no layer tree to
+  // draw it with, so the caller has to schedule a frame.
+  EXPECT_CALL(*texture, MarkNewFrameAvailable()).Times(1);
+  EXPECT_FALSE(rasterizer->MarkTextureFrameAvailable(/*texture_id=*/7));
+
+  // Unknown textures are left to the caller as well.
+  EXPECT_FALSE(rasterizer->MarkTextureFrameAvailable(/*texture_id=*/8));
+}
 }  // namespace flutter
@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resource_cache_budget.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+// Low memory warnings closer together than this halve the ceiling, down to a
+// quarter of its initial value.
+static constexpr fml::TimeDelta kFrequentLowMemoryInterval =
+    fml::TimeDelta::FromSeconds(60);
+static constexpr uint32_t kMaxCeilingShift = 2;
+
+ResourceCacheBudget::ResourceCacheBudget(size_t device_memory_bytes)
+    : device_memory_bytes_(device_memory_bytes) {}
+
+ResourceCacheBudget::~ResourceCacheBudget() = default;
+
+void ResourceCacheBudget::SetBaseBudget(size_t base_bytes) {
+  if (base_bytes == base_) {
+    return;
+  }
+  base_ = base_bytes;
+  budget_ = std::clamp(base_, GetFloor(), GetCeiling());
+  sample_count_ = 0;
+  total_usage_bytes_ = 0;
+  total_purgeable_bytes_ = 0;
+}
+
+size_t ResourceCacheBudget::GetFloor() const {
+  return base_ / 2;
+}
+
+size_t ResourceCacheBudget::GetCeiling() const {
+  size_t ceiling = (base_ * 4) >> ceiling_shift_;
+  if (device_memory_bytes_ > 0) {
+    ceiling = std::min(ceiling, device_memory_bytes_ / 8);
+  }
+  return std::max(ceiling, GetFloor());
+}
+
+bool ResourceCacheBudget::SetBudget(size_t budget, Decision decision) {
+  budget = std::clamp(budget, GetFloor(), GetCeiling());
+  if (budget == budget_) {
+    return false;
+  }
+  budget_ = budget;
+  last_decision_ = decision;
+  if (decision == Decision::kGrow) {
+    grow_count_++;
+  } else if (decision == Decision::kShrink) {
+    shrink_count_++;
+  }
+  return true;
+}
+
+bool ResourceCacheBudget::RecordFrame(size_t usage_bytes,
+                                      size_t purgeable_bytes,
+                                      fml::TimePoint now) {
+  total_usage_bytes_ += usage_bytes;
+  total_purgeable_bytes_ += std::min(purgeable_bytes, usage_bytes);
+  if (++sample_count_ < kSampleCount || budget_ == 0) {
+    return false;
+  }
+
+  const uint64_t usage = total_usage_bytes_ / sample_count_;
+  const uint64_t purgeable = total_purgeable_bytes_ / sample_count_;
+  sample_count_ = 0;
+  total_usage_bytes_ = 0;
+  total_purgeable_bytes_ = 0;
+
+  const uint64_t in_use = usage - purgeable;
+  const bool cooling_down = has_low_memory_warning_ &&
+                            now - last_low_memory_warning_ < kLowMemoryCooldown;
+  // The cache is at its budget and barely anything in it can be purged, so
+  // resources still in use are being evicted and uploaded again.
+  if (in_use * 10 >= budget_ * 9 && !cooling_down) {
+    return SetBudget(budget_ + budget_ / 4, Decision::kGrow);
+  }
+  // More than half of the cache is not in use. Keep some headroom above the
+  // resources in use so that the budget does not flip every window.
+  if (purgeable * 2 > budget_) {
+    const size_t target = std::max<size_t>(budget_ - budget_ / 4, in_use * 2);
+    return target < budget_ && SetBudget(target, Decision::kShrink);
+  }
+  return false;
+}
+
+bool ResourceCacheBudget::NotifyLowMemoryWarning(fml::TimePoint now) {
+  low_memory_count_++;
+  if (has_low_memory_warning_ &&
+      now - last_low_memory_warning_ < kFrequentLowMemoryInterval) {
+    ceiling_shift_ = std::min(ceiling_shift_ + 1, kMaxCeilingShift);
+  }
+  has_low_memory_warning_ = true;
+  last_low_memory_warning_ = now;
+  sample_count_ = 0;
+  total_usage_bytes_ = 0;
+  total_purgeable_bytes_ = 0;
+  return SetBudget(budget_ / 2, Decision::kLowMemory);
+}
+
+const char* ResourceCacheBudget::DecisionToString(Decision decision) {
+  switch (decision) {
+    case Decision::kNone:
+      return "none";
+    case Decision::kGrow:
+      return "grow";
+    case Decision::kShrink:
+      return "shrink";
+    case Decision::kLowMemory:
+      return "lowMemory";
+  }
+  return "none";
+}
+
+}  // namespace flutter
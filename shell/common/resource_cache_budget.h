@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_RESOURCE_CACHE_BUDGET_H_
+#define FLUTTER_SHELL_COMMON_RESOURCE_CACHE_BUDGET_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Adjusts the byte budget of Skia's GPU resource cache from how the cache is
+/// used, instead of using the budget computed from the surface size as is.
+///
+/// The budget grows while the cache is full of resources that are still in
+/// use, as resources evicted then have to be uploaded again on the next
+/// frames. It shrinks while a large part of the cache is purgeable. Low
+/// memory warnings halve the budget, and frequent warnings also lower the
+/// highest budget the controller may choose, so that the budget settles
+/// lower on devices under memory pressure.
+///
+/// The budget stays between half and four times the base budget, and never
+/// exceeds an eighth of the memory of the device when it is known.
+///
+/// Usage is evaluated in windows of |kSampleCount| frames so that a single
+/// frame does not cause the budget to oscillate.
+///
+class ResourceCacheBudget {
+ public:
+  static constexpr size_t kSampleCount = 30;
+
+  // After a low memory warning, the budget does not grow for this long.
+  static constexpr fml::TimeDelta kLowMemoryCooldown =
+      fml::TimeDelta::FromSeconds(30);
+
+  enum class Decision {
+    kNone,
+    kGrow,
+    kShrink,
+    kLowMemory,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  device_memory_bytes  The physical memory of the device, or 0
+  ///                                  if it is not known.
+  ///
+  explicit ResourceCacheBudget(size_t device_memory_bytes);
+
+  ~ResourceCacheBudget();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the budget the controller adapts from, usually derived
+  ///             from the surface size. Resets the budget if it changed.
+  ///
+  void SetBaseBudget(size_t base_bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the resource cache usage after a frame.
+  ///
+  /// @param[in]  usage_bytes      The bytes held by the resource cache.
+  /// @param[in]  purgeable_bytes  The part of |usage_bytes| held by resources
+  ///                              that are not in use.
+  ///
+  /// @return     Whether the budget changed.
+  ///
+  bool RecordFrame(size_t usage_bytes,
+                   size_t purgeable_bytes,
+                   fml::TimePoint now);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a low memory warning.
+  ///
+  /// @return     Whether the budget changed.
+  ///
+  bool NotifyLowMemoryWarning(fml::TimePoint now);
+
+  size_t GetBudget() const { return budget_; }
+
+  size_t GetBaseBudget() const { return base_; }
+
+  size_t GetCeiling() const;
+
+  Decision GetLastDecision() const { return last_decision_; }
+
+  size_t GetGrowCount() const { return grow_count_; }
+
+  size_t GetShrinkCount() const { return shrink_count_; }
+
+  size_t GetLowMemoryWarningCount() const { return low_memory_count_; }
+
+  static const char* DecisionToString(Decision decision);
+
+ private:
+  const size_t device_memory_bytes_;
+  size_t base_ = 0;
+  size_t budget_ = 0;
+  // Halved by frequent low memory warnings, applied to the ceiling.
+  uint32_t ceiling_shift_ = 0;
+  size_t sample_count_ = 0;
+  uint64_t total_usage_bytes_ = 0;
+  uint64_t total_purgeable_bytes_ = 0;
+  fml::TimePoint last_low_memory_warning_;
+  bool has_low_memory_warning_ = false;
+  Decision last_decision_ = Decision::kNone;
+  size_t grow_count_ = 0;
+  size_t shrink_count_ = 0;
+  size_t low_memory_count_ = 0;
+
+  size_t GetFloor() const;
+
+  bool SetBudget(size_t budget, Decision decision);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResourceCacheBudget);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_RESOURCE_CACHE_BUDGET_H_
@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resource_cache_budget.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr size_t kBase = 100 * 1024 * 1024;
+
+// Records a full window of identical frames and returns whether the budget
+// changed at the end of it.
+bool RecordWindow(ResourceCacheBudget& budget,
+                  size_t usage_bytes,
+                  size_t purgeable_bytes,
+                  fml::TimePoint now = fml::TimePoint()) {
+  bool changed = false;
+  for (size_t i = 0; i < ResourceCacheBudget::kSampleCount; i++) {
+    EXPECT_FALSE(changed);
+    changed = budget.RecordFrame(usage_bytes, purgeable_bytes, now);
+  }
+  return changed;
+}
+
+}  // namespace
+
+TEST(ResourceCacheBudgetTest, StartsAtTheBaseBudget) {
+  ResourceCacheBudget budget(0);
+  budget.SetBaseBudget(kBase);
+  EXPECT_EQ(budget.GetBudget(), kBase);
+  EXPECT_EQ(budget.GetLastDecision(), ResourceCacheBudget::Decision::kNone);
+}
+
+TEST(ResourceCacheBudgetTest, GrowsWhileResourcesInUseFillTheCache) {
+  ResourceCacheBudget budget(0);
+  budget.SetBaseBudget(kBase);
+  EXPECT_TRUE(RecordWindow(budget, kBase, 0));
+  EXPECT_EQ(budget.GetBudget(), kBase + kBase / 4);
+  EXPECT_EQ(budget.GetLastDecision(), ResourceCacheBudget::Decision::kGrow);
+
+  // Never exceeds four times the base budget.
+  for (int i = 0; i < 20; i++) {
+    RecordWindow(budget, budget.GetBudget(), 0);
+  }
+  EXPECT_EQ(budget.GetBudget(), kBase * 4);
+}
+
+TEST(ResourceCacheBudgetTest, GrowthIsCappedByDeviceMemory) {
+  ResourceCacheBudget budget(kBase * 16);
+  budget.SetBaseBudget(kBase);
+  for (int i = 0; i < 20; i++) {
+    RecordWindow(budget, budget.GetBudget(), 0);
+  }
+  EXPECT_EQ(budget.GetBudget(), kBase * 2);
+}
+
+TEST(ResourceCacheBudgetTest, ShrinksWhileMostOfTheCacheIsPurgeable) {
+  ResourceCacheBudget budget(0);
+  budget.SetBaseBudget(kBase);
+  EXPECT_TRUE(RecordWindow(budget, kBase, kBase * 3 / 4));
+  EXPECT_EQ(budget.GetBudget(), kBase - kBase / 4);
+  EXPECT_EQ(budget.GetLastDecision(), ResourceCacheBudget::Decision::kShrink);
+
+  // Never goes below half the base budget.
+  for (int i = 0; i < 20; i++) {
+    RecordWindow(budget, budget.GetBudget(), budget.GetBudget());
+  }
+  EXPECT_EQ(budget.GetBudget(), kBase / 2);
+}
+
+TEST(ResourceCacheBudgetTest, KeepsTheBudgetForModerateUsage) {
+  ResourceCacheBudget budget(0);
+  budget.SetBaseBudget(kBase);
+  EXPECT_FALSE(RecordWindow(budget, kBase / 2, kBase / 4));
+  EXPECT_EQ(budget.GetBudget(), kBase);
+}
+
+TEST(ResourceCacheBudgetTest, LowMemoryWarningsHalveTheBudget) {
+  ResourceCacheBudget budget(0);
+  budget.SetBaseBudget(kBase);
+  RecordWindow(budget, kBase, 0);
+  const auto now =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(3600));
+  EXPECT_TRUE(budget.NotifyLowMemoryWarning(now));
+  EXPECT_EQ(budget.GetBudget(), (kBase + kBase / 4) / 2);
+  EXPECT_EQ(budget.GetLastDecision(),
+            ResourceCacheBudget::Decision::kLowMemory);
+
+  // The budget does not grow right after a warning.
+  EXPECT_FALSE(RecordWindow(budget, kBase, 0, now));
+  EXPECT_TRUE(
+      RecordWindow(budget, kBase, 0,
+                   now + ResourceCacheBudget::kLowMemoryCooldown +
+                       fml::TimeDelta::FromSeconds(1)));
+}
+
+TEST(ResourceCacheBudgetTest, FrequentLowMemoryWarningsLowerTheCeiling) {
+  ResourceCacheBudget budget(0);
+  budget.SetBaseBudget(kBase);
+  EXPECT_EQ(budget.GetCeiling(), kBase * 4);
+  auto now =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(3600));
+  budget.NotifyLowMemoryWarning(now);
+  EXPECT_EQ(budget.GetCeiling(), kBase * 4);
+  now = now + fml::TimeDelta::FromSeconds(10);
+  budget.NotifyLowMemoryWarning(now);
+  EXPECT_EQ(budget.GetCeiling(), kBase * 2);
+  now = now + fml::TimeDelta::FromSeconds(10);
+  budget.NotifyLowMemoryWarning(now);
+  EXPECT_EQ(budget.GetCeiling(), kBase);
+  EXPECT_EQ(budget.GetLowMemoryWarningCount(), 3u);
+}
+
+}  // namespace testing
+}  // namespace flutter
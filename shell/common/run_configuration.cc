@@ -6,6 +6,7 @@
 
 #include <sstream>
 
+#include "flutter/assets/compressed_asset_bundle.h"
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
@@ -24,10 +25,20 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
+  auto assets_directory = fml::OpenDirectory(settings.assets_path.c_str(),
+                                             false, fml::FilePermission::kRead);
+
+  // Assets that are not shipped as plain files may be packed into a
+  // compressed container at the root of the assets directory.
+  auto compressed_assets = fml::FileMapping::CreateReadOnly(
+      assets_directory, CompressedAssetBundle::kFileName);
+  if (compressed_assets) {
+    asset_manager->PushBack(std::make_unique<CompressedAssetBundle>(
+        std::move(compressed_assets), true));
+  }
+
   asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+      std::move(assets_directory), true));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
@@ -7,21 +7,28 @@
 
 #include <memory>
 #include <sstream>
+#include <utility>
 #include <vector>
 
+#include "flutter/assets/asset_manager.h"
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/future.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/glyph_usage.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -38,6 +45,9 @@ constexpr char kSkiaChannel[] = "flutter/skia";
 constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
+// The extension of a main script that lists the Dart kernel snapshots of the
+// application rather than being one, as used by the tool for hot restarts.
+constexpr char kKernelListExtension[] = ".dilplist";
 
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     DartVMRef vm,
@@ -46,7 +56,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     Settings settings,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
-    const Shell::CreateCallback<Rasterizer>& on_create_rasterizer) {
+    const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
+    const Shell* spawning_shell) {
   if (!task_runners.IsValid()) {
     FML_LOG(ERROR) << "Task runners to run the shell were invalid.";
     return nullptr;
@@ -54,21 +65,62 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
   auto shell =
       std::unique_ptr<Shell>(new Shell(std::move(vm), task_runners, settings));
+  shell->is_spawned_ = spawning_shell != nullptr;
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
   auto rasterizer_future = rasterizer_promise.get_future();
-  std::promise<fml::WeakPtr<SnapshotDelegate>> snapshot_delegate_promise;
-  auto snapshot_delegate_future = snapshot_delegate_promise.get_future();
+  fml::Promise<fml::WeakPtr<SnapshotDelegate>> snapshot_delegate_promise;
+  auto snapshot_delegate_future = snapshot_delegate_promise.GetFuture();
   fml::TaskRunner::RunNowOrPostTask(
       task_runners.GetRasterTaskRunner(), [&rasterizer_promise,  //
-                                           &snapshot_delegate_promise,
+                                           snapshot_delegate_promise,
                                            on_create_rasterizer,  //
                                            shell = shell.get()    //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
-        snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
+        auto& raster_cache = rasterizer->compositor_context()->raster_cache();
+        raster_cache.SetMaxBytes(shell->GetSettings().raster_cache_max_bytes);
+        rasterizer->compositor_context()->frame_stats().SetCapacity(
+            shell->GetSettings().frame_stats_capacity);
+        raster_cache.SetCompactOpaqueEntries(
+            shell->GetSettings().raster_cache_compact_opaque_entries);
+        raster_cache.SetRecordDecisions(
+            shell->GetSettings().trace_raster_cache_decisions);
+        raster_cache.SetShowDecisionHeatmap(
+            shell->GetSettings().show_raster_cache_heatmap);
+        if (shell->GetSettings().enable_shared_raster_cache) {
+          raster_cache.SetSharedCache(SharedRasterCache::GetInstance());
+        }
+        if (shell->GetSettings().enable_async_raster_cache) {
+          raster_cache.SetAsyncRasterizationTaskRunner(
+              shell->GetDartVM()->GetConcurrentWorkerTaskRunner());
+          raster_cache.SetRecordDeferredDisplayLists(
+              shell->GetSettings().enable_parallel_raster_cache_recording);
+        }
+        if (shell->GetSettings().enable_adaptive_resource_cache_budget) {
+          rasterizer->EnableAdaptiveResourceCacheBudget(
+              shell->GetSettings().device_memory_bytes);
+        }
+        if (shell->GetSettings().enable_parallel_preroll) {
+          rasterizer->compositor_context()->SetPrerollTaskRunner(
+              shell->GetDartVM()->GetConcurrentWorkerTaskRunner());
+        }
+        if (shell->GetSettings().enable_tiled_software_paint) {
+          rasterizer->compositor_context()->SetTiledPaintTaskRunner(
+              shell->GetDartVM()->GetConcurrentWorkerTaskRunner());
+        }
+        rasterizer->compositor_context()->SetLayerCostProfileEnabled(
+            shell->GetSettings().enable_layer_cost_profile);
+        if (shell->GetSettings().enable_raster_cache_persistence) {
+          raster_cache.SetPersistCallback(
+              [](sk_sp<SkData> key, sk_sp<SkImage> image) {
+                PersistentCache::GetCacheForProcess()->StoreRasterCacheImage(
+                    std::move(key), std::move(image));
+              });
+        }
+        snapshot_delegate_promise.SetValue(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
@@ -78,24 +130,24 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
-    return nullptr;
-  }
-
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
   // first be booted and the necessary references obtained to initialize the
-  // other subsystems.
-  std::promise<std::unique_ptr<ShellIOManager>> io_manager_promise;
-  auto io_manager_future = io_manager_promise.get_future();
-  std::promise<fml::WeakPtr<ShellIOManager>> weak_io_manager_promise;
-  auto weak_io_manager_future = weak_io_manager_promise.get_future();
-  std::promise<fml::RefPtr<SkiaUnrefQueue>> unref_queue_promise;
-  auto unref_queue_future = unref_queue_promise.get_future();
+  // other subsystems. Spawned shells use the IO manager of the shell they were
+  // spawned from instead.
+  struct IOSubsystem {
+    fml::WeakPtr<ShellIOManager> weak_io_manager;
+    fml::RefPtr<SkiaUnrefQueue> unref_queue;
+    std::shared_ptr<DecodedImageCache> decoded_image_cache;
+    std::shared_ptr<ResourceContextPool> resource_context_pool;
+  };
+  fml::Promise<std::shared_ptr<ShellIOManager>> io_manager_promise;
+  auto io_manager_future = io_manager_promise.GetFuture();
+  fml::Promise<IOSubsystem> io_subsystem_promise;
+  auto io_subsystem_future = io_subsystem_promise.GetFuture();
   auto io_task_runner = shell->GetTaskRunners().GetIOTaskRunner();
+  const size_t decoded_image_cache_max_bytes =
+      settings.decoded_image_cache_max_bytes;
 
   // TODO(gw280): The WeakPtr here asserts that we are derefing it on the
   // same thread as it was created on. We are currently on the IO thread
@@ -105,68 +157,147 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // https://github.com/flutter/flutter/issues/42948
   fml::TaskRunner::RunNowOrPostTask(
       io_task_runner,
-      [&io_manager_promise,                                               //
-       &weak_io_manager_promise,                                          //
-       &unref_queue_promise,                                              //
+      [io_manager_promise,                                                //
+       io_subsystem_promise,                                              //
        platform_view = platform_view->GetWeakPtr(),                       //
        io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch(),  //
+       decoded_image_cache_max_bytes,                                     //
+       spawning_io_manager =
+           spawning_shell ? spawning_shell->io_manager_ : nullptr  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
-        auto io_manager = std::make_unique<ShellIOManager>(
-            platform_view.getUnsafe()->CreateResourceContext(),
-            is_backgrounded_sync_switch, io_task_runner);
-        weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
-        unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
-        io_manager_promise.set_value(std::move(io_manager));
+        std::shared_ptr<ShellIOManager> io_manager = spawning_io_manager;
+        if (!io_manager) {
+          io_manager = std::make_shared<ShellIOManager>(
+              platform_view.getUnsafe()->CreateResourceContext(),
+              is_backgrounded_sync_switch, io_task_runner);
+        }
+        if (!spawning_io_manager && decoded_image_cache_max_bytes > 0) {
+          io_manager->SetDecodedImageCache(std::make_shared<DecodedImageCache>(
+              decoded_image_cache_max_bytes, io_manager->GetSkiaUnrefQueue()));
+        }
+        if (!spawning_io_manager) {
+          io_manager->SetResourceContextPool(
+              platform_view.getUnsafe()->CreateResourceContextPool());
+        }
+        io_subsystem_promise.SetValue({
+            io_manager->GetWeakPtr(),             //
+            io_manager->GetSkiaUnrefQueue(),      //
+            io_manager->GetDecodedImageCache(),   //
+            io_manager->GetResourceContextPool()  //
+        });
+        io_manager_promise.SetValue(std::move(io_manager));
       });
 
+  // Ask the platform view for the vsync waiter. This will be used by the engine
+  // to create the animator. This is done after the IO subsystem setup is
+  // kicked off so that it does not delay the creation of the resource context.
+  auto vsync_waiter = platform_view->CreateVSyncWaiter();
+  if (!vsync_waiter) {
+    // The raster and IO tasks reference the shell and the platform view,
+    // which are about to be collected.
+    rasterizer_future.wait();
+    io_manager_future.Wait();
+    return nullptr;
+  }
+
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
-  auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  PointerDataDispatcherMaker dispatcher_maker;
+  if (settings.latch_pointer_events_before_frame) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<LatchingPointerDataDispatcher>(delegate);
+    };
+  } else {
+    dispatcher_maker = platform_view->GetDispatcherMaker();
+  }
 
-  // Create the engine on the UI thread.
+  // Create the engine on the UI thread once the raster and IO subsystems it
+  // depends on are set up. The UI thread is not blocked in the meantime, which
+  // matters to spawned shells as they share it with a running engine.
   std::promise<std::unique_ptr<Engine>> engine_promise;
   auto engine_future = engine_promise.get_future();
-  fml::TaskRunner::RunNowOrPostTask(
-      shell->GetTaskRunners().GetUITaskRunner(),
-      fml::MakeCopyable([&engine_promise,                                 //
-                         shell = shell.get(),                             //
-                         &dispatcher_maker,                               //
-                         &platform_data,                                  //
-                         isolate_snapshot = std::move(isolate_snapshot),  //
-                         vsync_waiter = std::move(vsync_waiter),          //
-                         &weak_io_manager_future,                         //
-                         &snapshot_delegate_future,                       //
-                         &unref_queue_future                              //
-  ]() mutable {
+  auto create_engine = fml::MakeCopyable(
+      [&engine_promise,                                 //
+       shell = shell.get(),                             //
+       &dispatcher_maker,                               //
+       &platform_data,                                  //
+       isolate_snapshot = std::move(isolate_snapshot),  //
+       vsync_waiter = std::move(vsync_waiter),          //
+       spawning_engine =
+           spawning_shell ? spawning_shell->engine_.get() : nullptr  //
+  ](const fml::WeakPtr<SnapshotDelegate>& snapshot_delegate,
+        const IOSubsystem& io) mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
-
-        engine_promise.set_value(std::make_unique<Engine>(
-            *shell,                         //
-            dispatcher_maker,               //
-            *shell->GetDartVM(),            //
-            std::move(isolate_snapshot),    //
-            task_runners,                   //
-            platform_data,                  //
-            shell->GetSettings(),           //
-            std::move(animator),            //
-            weak_io_manager_future.get(),   //
-            unref_queue_future.get(),       //
-            snapshot_delegate_future.get()  //
-            ));
-      }));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().enable_adaptive_frame_pipelining);
+
+        std::unique_ptr<Engine> engine;
+        if (spawning_engine) {
+          engine = spawning_engine->Spawn(*shell,                //
+                                          dispatcher_maker,      //
+                                          shell->GetSettings(),  //
+                                          std::move(animator),   //
+                                          io.weak_io_manager,    //
+                                          io.unref_queue,        //
+                                          snapshot_delegate      //
+          );
+        } else {
+          engine = std::make_unique<Engine>(*shell,                       //
+                                            dispatcher_maker,             //
+                                            *shell->GetDartVM(),          //
+                                            std::move(isolate_snapshot),  //
+                                            task_runners,                 //
+                                            platform_data,                //
+                                            shell->GetSettings(),         //
+                                            std::move(animator),          //
+                                            io.weak_io_manager,           //
+                                            io.unref_queue,               //
+                                            snapshot_delegate             //
+          );
+        }
+        engine->SetDecodedImageCache(io.decoded_image_cache);
+        engine->SetResourceContextPool(io.resource_context_pool);
+
+        // Set up the time-consuming default font manager while the platform
+        // thread finishes setting up the shell, instead of once it is done.
+        task_runners.GetUITaskRunner()->PostTask(
+            [engine = engine->GetWeakPtr()] {
+              if (engine) {
+                engine->SetupDefaultFontManager();
+              }
+            });
+        engine_promise.set_value(std::move(engine));
+      });
+
+  auto ui_task_runner = shell->GetTaskRunners().GetUITaskRunner();
+  if (ui_task_runner->RunsTasksOnCurrentThread()) {
+    // The platform thread is also the UI thread and is about to block on the
+    // engine, the continuations could never run.
+    create_engine(snapshot_delegate_future.Wait(), io_subsystem_future.Wait());
+  } else {
+    snapshot_delegate_future.OnReady(
+        ui_task_runner,
+        [ui_task_runner, io_subsystem_future,
+         create_engine](const fml::WeakPtr<SnapshotDelegate>& delegate) {
+          io_subsystem_future.OnReady(
+              ui_task_runner,
+              [delegate, create_engine](const IOSubsystem& io) {
+                create_engine(delegate, io);
+              });
+        });
+  }
 
   if (!shell->Setup(std::move(platform_view),  //
                     engine_future.get(),       //
                     rasterizer_future.get(),   //
-                    io_manager_future.get())   //
+                    io_manager_future.Wait())  //
   ) {
     return nullptr;
   }
@@ -174,6 +305,35 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   return shell;
 }
 
+// Starts reading the assets listed in the prefetch manifest of the bundle on
+// the IO thread so that the first frames do not block on disk I/O. The run
+// configuration and its asset manager are only provided when the engine is
+// run, so the directories in the settings are resolved separately.
+static void PrefetchStartupAssets(
+    const fml::RefPtr<fml::TaskRunner>& io_task_runner,
+    const Settings& settings) {
+  fml::UniqueFD assets_dir;
+  if (fml::UniqueFD::traits_type::IsValid(settings.assets_dir)) {
+    assets_dir = fml::Duplicate(settings.assets_dir);
+  }
+  io_task_runner->PostTask(fml::MakeCopyable(
+      [assets_dir = std::move(assets_dir),
+       assets_path = settings.assets_path]() mutable {
+        AssetManager asset_manager;
+        if (assets_dir.is_valid()) {
+          asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+              std::move(assets_dir), false));
+        }
+        if (!assets_path.empty()) {
+          asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+              fml::OpenDirectory(assets_path.c_str(), false,
+                                 fml::FilePermission::kRead),
+              false));
+        }
+        asset_manager.PrefetchManifestAssets();
+      }));
+}
+
 static void Tokenize(const std::string& input,
                      std::vector<std::string>* results,
                      char delimiter) {
@@ -209,7 +369,13 @@ static void PerformInitializationTasks(Settings& settings) {
         [](const char* message) { FML_LOG(ERROR) << message; });
 
     if (settings.trace_skia) {
-      InitSkiaEventTracer(settings.trace_skia);
+      std::vector<std::string> skia_prefixes;
+      Tokenize(settings.trace_skia_allowlist, &skia_prefixes, ',');
+      InitSkiaEventTracer(settings.trace_skia, skia_prefixes);
+    }
+
+    if (settings.enable_trace_recorder) {
+      fml::tracing::TraceRecorder::SetEnabled(true);
     }
 
     if (!settings.trace_allowlist.empty()) {
@@ -236,6 +402,12 @@ static void PerformInitializationTasks(Settings& settings) {
   });
 }
 
+void Shell::PrewarmDartVM(Settings settings) {
+  PerformInitializationTasks(settings);
+  TRACE_EVENT0("flutter", "Shell::PrewarmDartVM");
+  DartVMRef::Prewarm(std::move(settings));
+}
+
 std::unique_ptr<Shell> Shell::Create(
     TaskRunners task_runners,
     Settings settings,
@@ -257,6 +429,8 @@ std::unique_ptr<Shell> Shell::Create(
     Shell::CreateCallback<Rasterizer> on_create_rasterizer) {
   PerformInitializationTasks(settings);
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  PersistentCache::SetDeferSkSLWarmUp(settings.defer_sksl_warm_up);
+  txt::GlyphUsageRecorder::SetEnabled(settings.record_glyph_usage);
 
   TRACE_EVENT0("flutter", "Shell::Create");
 
@@ -285,6 +459,8 @@ std::unique_ptr<Shell> Shell::Create(
     DartVMRef vm) {
   PerformInitializationTasks(settings);
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  PersistentCache::SetDeferSkSLWarmUp(settings.defer_sksl_warm_up);
+  txt::GlyphUsageRecorder::SetEnabled(settings.record_glyph_usage);
 
   TRACE_EVENT0("flutter", "Shell::CreateWithSnapshots");
 
@@ -293,6 +469,8 @@ std::unique_ptr<Shell> Shell::Create(
     return nullptr;
   }
 
+  PrefetchStartupAssets(task_runners.GetIOTaskRunner(), settings);
+
   fml::AutoResetWaitableEvent latch;
   std::unique_ptr<Shell> shell;
   fml::TaskRunner::RunNowOrPostTask(
@@ -321,6 +499,39 @@ std::unique_ptr<Shell> Shell::Create(
   return shell;
 }
 
+std::unique_ptr<Shell> Shell::Spawn(
+    RunConfiguration run_configuration,
+    const CreateCallback<PlatformView>& on_create_platform_view,
+    const CreateCallback<Rasterizer>& on_create_rasterizer) const {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  TRACE_EVENT0("flutter", "Shell::Spawn");
+
+  if (!on_create_platform_view || !on_create_rasterizer) {
+    return nullptr;
+  }
+
+  auto vm = DartVMRef::Create(settings_);
+  FML_CHECK(vm) << "Must be able to initialize the VM.";
+  auto isolate_snapshot = vm->GetVMData()->GetIsolateSnapshot();
+
+  auto shell = CreateShellOnPlatformThread(std::move(vm),                //
+                                           task_runners_,                //
+                                           PlatformData{},               //
+                                           settings_,                    //
+                                           std::move(isolate_snapshot),  //
+                                           on_create_platform_view,      //
+                                           on_create_rasterizer,         //
+                                           this                          //
+  );
+  if (!shell) {
+    return nullptr;
+  }
+
+  shell->RunEngine(std::move(run_configuration));
+  return shell;
+}
+
 Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
     : task_runners_(std::move(task_runners)),
       settings_(std::move(settings)),
@@ -334,6 +545,16 @@ Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
 
   display_manager_ = std::make_unique<DisplayManager>();
 
+  if (settings_.task_timer_slack_ms > 0) {
+    const auto slack =
+        fml::TimeDelta::FromMilliseconds(settings_.task_timer_slack_ms);
+    auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+    task_queues->SetTimerSlack(task_runners_.GetUITaskRunner()->GetTaskQueueId(),
+                               slack);
+    task_queues->SetTimerSlack(task_runners_.GetIOTaskRunner()->GetTaskQueueId(),
+                               slack);
+  }
+
   // Generate a WeakPtrFactory for use with the raster thread. This does not
   // need to wait on a latch because it can only ever be used from the raster
   // thread from this class, so we have ordering guarantees.
@@ -353,6 +574,10 @@ Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
       task_runners_.GetRasterTaskRunner(),
       std::bind(&Shell::OnServiceProtocolScreenshotSKP, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kCaptureLayerTreeExtensionName] =
+      {task_runners_.GetRasterTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolCaptureLayerTree, this,
+                 std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kRunInViewExtensionName] = {
       task_runners_.GetUITaskRunner(),
       std::bind(&Shell::OnServiceProtocolRunInView, this, std::placeholders::_1,
@@ -381,6 +606,58 @@ Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetDecodedImageCacheStatsExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetDecodedImageCacheStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetGlyphUsageExtensionName] = {
+      task_runners_.GetUITaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetGlyphUsage, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameHistogramsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameHistograms, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetFrameStatsExtensionName] = {
+      task_runners_.GetPlatformTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetFrameStats, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetRasterCacheDecisionsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetRasterCacheDecisions, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTraceRecordingExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTraceRecording, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetRasterThreadMergerStatsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetRasterThreadMergerStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetResourceCacheBudgetExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetResourceCacheBudget, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetMemoryBreakdownExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetMemoryBreakdown, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTaskQueueStatsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTaskQueueStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetDartGCStatsExtensionName] = {
+      task_runners_.GetUITaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetDartGCStats, this,
+                std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -399,6 +676,13 @@ Shell::~Shell() {
       }));
   ui_latch.Wait();
 
+  // No more messages can be posted to the background handlers now that the
+  // engine is gone. Let them finish before the platform view is collected.
+  {
+    std::scoped_lock lock(background_channels_mutex_);
+    background_message_thread_.reset();
+  }
+
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetRasterTaskRunner(),
       fml::MakeCopyable(
@@ -413,9 +697,11 @@ Shell::~Shell() {
       task_runners_.GetIOTaskRunner(),
       fml::MakeCopyable([io_manager = std::move(io_manager_),
                          platform_view = platform_view_.get(),
-                         &io_latch]() mutable {
+                         is_spawned = is_spawned_, &io_latch]() mutable {
         io_manager.reset();
-        if (platform_view) {
+        // The resource context of a spawned shell belongs to the platform view
+        // of the shell it was spawned from.
+        if (platform_view && !is_spawned) {
           platform_view->ReleaseResourceContext();
         }
         io_latch.Signal();
@@ -436,26 +722,55 @@ Shell::~Shell() {
   platform_latch.Wait();
 }
 
-void Shell::NotifyLowMemoryWarning() const {
+void Shell::NotifyLowMemoryWarning(MemoryPressureLevel level) const {
   auto trace_id = fml::tracing::TraceNonce();
-  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
-                           trace_id);
-  // This does not require a current isolate but does require a running VM.
-  // Since a valid shell will not be returned to the embedder without a valid
-  // DartVMRef, we can be certain that this is a safe spot to assume a VM is
-  // running.
-  ::Dart_NotifyLowMemory();
+  TRACE_EVENT_ASYNC_BEGIN1("flutter", "Shell::NotifyLowMemoryWarning",
+                           trace_id, "level",
+                           level == MemoryPressureLevel::kCritical
+                               ? "critical"
+                               : "moderate");
+  if (level == MemoryPressureLevel::kCritical) {
+    // This does not require a current isolate but does require a running VM.
+    // Since a valid shell will not be returned to the embedder without a
+    // valid DartVMRef, we can be certain that this is a safe spot to assume a
+    // VM is running.
+    ::Dart_NotifyLowMemory();
+    // The glyph cache is shared by all the threads rendering text.
+    SkGraphics::PurgeFontCache();
+
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_]() {
+          if (engine) {
+            engine->GetFontCollection()
+                .GetFontCollection()
+                ->ClearFontFamilyCache();
+          }
+        });
+  }
 
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
+      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id, level]() {
         if (rasterizer) {
-          rasterizer->NotifyLowMemoryWarning();
+          rasterizer->NotifyLowMemoryWarning(level);
         }
         TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
                                trace_id);
       });
   // The IO Manager uses resource cache limits of 0, so it is not necessary
-  // to purge them.
+  // to purge them. Decoded images it caches are dropped though, or only the
+  // least recently used half of them under moderate pressure.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [io_manager = io_manager_->GetWeakPtr(), level]() {
+        if (!io_manager || !io_manager->GetDecodedImageCache()) {
+          return;
+        }
+        auto cache = io_manager->GetDecodedImageCache();
+        if (level == MemoryPressureLevel::kCritical) {
+          cache->Clear();
+        } else {
+          cache->Trim(cache->GetStats().byte_size / 2);
+        }
+      });
 }
 
 void Shell::RunEngine(RunConfiguration run_configuration) {
@@ -533,7 +848,7 @@ bool Shell::IsSetup() const {
 bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
                   std::unique_ptr<Engine> engine,
                   std::unique_ptr<Rasterizer> rasterizer,
-                  std::unique_ptr<ShellIOManager> io_manager) {
+                  std::shared_ptr<ShellIOManager> io_manager) {
   if (is_setup_) {
     return false;
   }
@@ -546,6 +861,7 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   engine_ = std::move(engine);
   rasterizer_ = std::move(rasterizer);
   io_manager_ = std::move(io_manager);
+  io_idle_task_queue_ = io_manager_->GetIdleTaskQueue();
 
   // Set the external view embedder for the rasterizer.
   auto view_embedder = platform_view_->CreateExternalViewEmbedder();
@@ -555,20 +871,15 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   // ptr.
   weak_engine_ = engine_->GetWeakPtr();
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
+  thread_safe_weak_rasterizer_ = rasterizer_->GetThreadSafeWeakPtr();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
-  // Setup the time-consuming default font manager right after engine created.
-  fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                    [engine = weak_engine_] {
-                                      if (engine) {
-                                        engine->SetupDefaultFontManager();
-                                      }
-                                    });
-
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
+  PersistentCache::GetCacheForProcess()->SetConcurrentTaskRunner(
+      vm_->GetConcurrentWorkerTaskRunner());
 
   PersistentCache::GetCacheForProcess()->SetIsDumpingSkp(
       settings_.dump_skp_on_shader_compilation);
@@ -577,9 +888,70 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
     PersistentCache::GetCacheForProcess()->Purge();
   }
 
+  if (settings_.enable_raster_cache_persistence) {
+    LoadPersistedRasterCacheImages();
+  }
+
+  if (settings_.prewarm_gpu_context) {
+    // The isolate is not launched before |RunEngine|, so the context is
+    // created while it starts. The platform view outlives the task, as the
+    // rasterizer is collected by a later task on the raster thread before the
+    // platform view is collected.
+    task_runners_.GetRasterTaskRunner()->PostTask(
+        [platform_view = platform_view_.get()]() {
+          TRACE_EVENT0("flutter", "Shell::PrewarmGPUContext");
+          platform_view->PrewarmGPUContext();
+        });
+  }
+
   return true;
 }
 
+void Shell::LoadPersistedRasterCacheImages() {
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [raster_task_runner = task_runners_.GetRasterTaskRunner(),
+       rasterizer = weak_rasterizer_,
+       max_bytes = settings_.raster_cache_max_bytes]() {
+        TRACE_EVENT0("flutter", "Shell::LoadPersistedRasterCacheImages");
+        std::vector<std::pair<sk_sp<SkData>, sk_sp<SkImage>>> images;
+        size_t bytes = 0;
+        for (const auto& stored :
+             PersistentCache::GetCacheForProcess()->LoadRasterCacheImages()) {
+          // Encoded images are decoded lazily, so their size is known before
+          // paying for the decode. Images that would not fit in the raster
+          // cache are not decoded at all.
+          sk_sp<SkImage> image = SkImage::MakeFromEncoded(stored.second);
+          if (!image) {
+            continue;
+          }
+          const size_t image_bytes = image->imageInfo().computeMinByteSize();
+          if (max_bytes != 0 && bytes + image_bytes > max_bytes) {
+            continue;
+          }
+          // Decode now so that the raster thread only has to upload it.
+          image = image->makeRasterImage();
+          if (image) {
+            bytes += image_bytes;
+            images.emplace_back(stored.first, std::move(image));
+          }
+        }
+        if (images.empty()) {
+          return;
+        }
+        raster_task_runner->PostTask(
+            [rasterizer, images = std::move(images)]() {
+              if (!rasterizer) {
+                return;
+              }
+              auto& raster_cache =
+                  rasterizer->compositor_context()->raster_cache();
+              for (const auto& image : images) {
+                raster_cache.AddPersistedImage(image.first, image.second);
+              }
+            });
+      });
+}
+
 const Settings& Shell::GetSettings() const {
   return settings_;
 }
@@ -845,6 +1217,88 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
   }
 }
 
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewAddView(int64_t view_id,
+                                  std::unique_ptr<Surface> surface,
+                                  const ViewportMetrics& metrics) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+
+  // The surface is added before the framework learns about the view, so that
+  // it is there for the first tree rendered for the view.
+  task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
+      [rasterizer = rasterizer_->GetWeakPtr(), view_id,
+       surface = std::move(surface)]() mutable {
+        if (rasterizer) {
+          rasterizer->AddView(view_id, std::move(surface));
+        }
+      }));
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), view_id, metrics]() {
+        if (engine) {
+          engine->SetViewportMetrics(view_id, metrics);
+        }
+      });
+}
+
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewRemoveView(int64_t view_id) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  // The framework stops rendering the view first, so that no tree for it is
+  // drawn after its surface is collected.
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [engine = engine_->GetWeakPtr(), view_id, &latch]() {
+        if (engine) {
+          engine->RemoveView(view_id);
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  {
+    std::scoped_lock lock(pending_view_layer_trees_mutex_);
+    pending_view_layer_trees_.erase(view_id);
+  }
+
+  // The platform may destroy the window of the view once this returns.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [rasterizer = rasterizer_->GetWeakPtr(), view_id, &latch]() {
+        if (rasterizer) {
+          rasterizer->RemoveView(view_id);
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+}
+
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewSetViewMetrics(int64_t view_id,
+                                         const ViewportMetrics& metrics) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (metrics.device_pixel_ratio <= 0 || metrics.physical_width <= 0 ||
+      metrics.physical_height <= 0) {
+    FML_DLOG(ERROR) << "Embedding reported invalid ViewportMetrics for view "
+                    << view_id << ", ignoring update.";
+    return;
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), view_id, metrics]() {
+        if (engine) {
+          engine->SetViewportMetrics(view_id, metrics);
+        }
+      });
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchPlatformMessage(
     fml::RefPtr<PlatformMessage> message) {
@@ -866,6 +1320,9 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  if (settings_.enable_compositor_scrolling) {
+    DispatchCompositorScrolls(*packet, next_pointer_flow_id_);
+  }
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
@@ -876,6 +1333,31 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   next_pointer_flow_id_++;
 }
 
+void Shell::DispatchCompositorScrolls(const PointerDataPacket& packet,
+                                      uint64_t flow_id) {
+  std::vector<std::pair<SkPoint, SkVector>> scrolls;
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    const PointerData data = packet.GetPointerData(i);
+    if (data.signal_kind == PointerData::SignalKind::kScroll) {
+      scrolls.emplace_back(SkPoint::Make(data.physical_x, data.physical_y),
+                           SkVector::Make(data.scroll_delta_x,
+                                          data.scroll_delta_y));
+    }
+  }
+  if (scrolls.empty()) {
+    return;
+  }
+  task_runners_.GetRasterTaskRunner()->PostTask(
+      [rasterizer = rasterizer_->GetWeakPtr(), scrolls = std::move(scrolls),
+       flow_id]() {
+        if (rasterizer) {
+          for (const auto& [point, delta] : scrolls) {
+            rasterizer->HandleCompositorScroll(point, delta, flow_id);
+          }
+        }
+      });
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchSemanticsAction(int32_t id,
                                                   SemanticsAction action,
@@ -954,29 +1436,21 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
   // Tell the rasterizer that one of its textures has a new frame available.
+  // The rasterizer draws the last layer tree again by itself, coalescing the
+  // frames of all textures, so the UI thread is not involved.
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), texture_id]() {
-        auto* registry = rasterizer->GetTextureRegistry();
-
-        if (!registry) {
+      [rasterizer = rasterizer_->GetWeakPtr(), engine = engine_->GetWeakPtr(),
+       ui_task_runner = task_runners_.GetUITaskRunner(), texture_id]() {
+        if (!rasterizer || rasterizer->MarkTextureFrameAvailable(texture_id)) {
           return;
         }
-
-        auto texture = registry->GetTexture(texture_id);
-
-        if (!texture) {
-          return;
-        }
-
-        texture->MarkNewFrameAvailable();
+        // Schedule a new frame without having to rebuild the layer tree.
+        ui_task_runner->PostTask([engine]() {
+          if (engine) {
+            engine->ScheduleFrame(false);
+          }
+        });
       });
-
-  // Schedule a new frame without having to rebuild the layer tree.
-  task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
-    if (engine) {
-      engine->ScheduleFrame(false);
-    }
-  });
 }
 
 // |PlatformView::Delegate|
@@ -1002,8 +1476,35 @@ void Shell::OnAnimatorBeginFrame(fml::TimePoint frame_target_time) {
     std::scoped_lock time_recorder_lock(time_recorder_mutex_);
     latest_frame_target_time_.emplace(frame_target_time);
   }
-  if (engine_) {
-    engine_->BeginFrame(frame_target_time);
+  // Maintenance work waits for the idle period after this frame.
+  io_idle_task_queue_->SetIdleDeadline(fml::TimePoint::Now());
+  if (!engine_) {
+    return;
+  }
+
+  // Snapshots requested while the frame is built would otherwise be
+  // rasterized before it, as the frame is only posted at its end.
+  {
+    std::scoped_lock lock(frame_in_flight_mutex_);
+    frame_in_flight_ = true;
+  }
+  engine_->BeginFrame(frame_target_time);
+  bool snapshots_deferred;
+  {
+    std::scoped_lock lock(frame_in_flight_mutex_);
+    frame_in_flight_ = false;
+    snapshots_deferred = snapshots_deferred_;
+    snapshots_deferred_ = false;
+  }
+  if (snapshots_deferred) {
+    // The frame, if one was rendered, was posted with a critical priority, so
+    // this task runs after it.
+    task_runners_.GetRasterTaskRunner()->PostTask(
+        [rasterizer = rasterizer_->GetWeakPtr()]() {
+          if (rasterizer) {
+            rasterizer->RunDeferredSnapshots();
+          }
+        });
   }
 }
 
@@ -1012,6 +1513,10 @@ void Shell::OnAnimatorNotifyIdle(int64_t deadline) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
+  // |deadline| is on the Dart timeline clock.
+  io_idle_task_queue_->SetIdleDeadline(
+      fml::TimePoint::Now() +
+      fml::TimeDelta::FromMicroseconds(deadline - Dart_TimelineGetMicros()));
   if (engine_) {
     engine_->NotifyIdle(deadline);
   }
@@ -1038,7 +1543,7 @@ void Shell::OnAnimatorDraw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
            tree.frame_size() != expected_frame_size_;
   };
 
-  task_runners_.GetRasterTaskRunner()->PostTask(
+  task_runners_.GetRasterTaskRunner()->PostTaskWithPriority(
       [&waiting_for_first_frame = waiting_for_first_frame_,
        &waiting_for_first_frame_condition = waiting_for_first_frame_condition_,
        rasterizer = rasterizer_->GetWeakPtr(), pipeline = std::move(pipeline),
@@ -1051,7 +1556,8 @@ void Shell::OnAnimatorDraw(fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline,
             waiting_for_first_frame_condition.notify_all();
           }
         }
-      });
+      },
+      fml::TaskPriority::kCritical);
 }
 
 // |Animator::Delegate|
@@ -1066,19 +1572,51 @@ void Shell::OnAnimatorDrawLastLayerTree() {
       });
 }
 
+// |Animator::Delegate|
+void Shell::OnAnimatorDrawView(std::unique_ptr<flutter::LayerTree> layer_tree) {
+  FML_DCHECK(is_setup_);
+
+  const int64_t view_id = layer_tree->view_id();
+  {
+    std::scoped_lock lock(pending_view_layer_trees_mutex_);
+    std::unique_ptr<flutter::LayerTree>& pending_layer_tree =
+        pending_view_layer_trees_[view_id];
+    const bool draw_posted = pending_layer_tree != nullptr;
+    pending_layer_tree = std::move(layer_tree);
+    if (draw_posted) {
+      // The raster thread has yet to draw the previous tree of the view, and
+      // draws this one instead.
+      return;
+    }
+  }
+
+  task_runners_.GetRasterTaskRunner()->PostTaskWithPriority(
+      [this, rasterizer = rasterizer_->GetWeakPtr(), view_id]() {
+        if (!rasterizer) {
+          return;
+        }
+        std::unique_ptr<flutter::LayerTree> layer_tree;
+        {
+          std::scoped_lock lock(pending_view_layer_trees_mutex_);
+          auto found = pending_view_layer_trees_.find(view_id);
+          if (found == pending_view_layer_trees_.end()) {
+            return;
+          }
+          layer_tree = std::move(found->second);
+          pending_view_layer_trees_.erase(found);
+        }
+        rasterizer->DrawView(std::move(layer_tree));
+      },
+      fml::TaskPriority::kCritical);
+}
+
 // |Engine::Delegate|
 void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
                                     CustomAccessibilityActionUpdates actions) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
-  task_runners_.GetPlatformTaskRunner()->PostTask(
-      [view = platform_view_->GetWeakPtr(), update = std::move(update),
-       actions = std::move(actions)] {
-        if (view) {
-          view->UpdateSemantics(std::move(update), std::move(actions));
-        }
-      });
+  platform_view_->PostSemanticsUpdate(std::move(update), std::move(actions));
 }
 
 // |Engine::Delegate|
@@ -1092,6 +1630,18 @@ void Shell::OnEngineHandlePlatformMessage(
     return;
   }
 
+  {
+    std::scoped_lock lock(background_channels_mutex_);
+    if (background_channels_.count(message->channel()) != 0) {
+      // The thread is joined before the platform view is collected.
+      background_message_thread_->GetTaskRunner()->PostTask(
+          [view = platform_view_.get(), message = std::move(message)]() {
+            view->HandleBackgroundPlatformMessage(std::move(message));
+          });
+      return;
+    }
+  }
+
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), message = std::move(message)]() {
         if (view) {
@@ -1100,11 +1650,30 @@ void Shell::OnEngineHandlePlatformMessage(
       });
 }
 
+// |Engine::Delegate|
+void Shell::OnEngineHandlePlatformMessages(
+    std::vector<fml::RefPtr<PlatformMessage>> messages) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  task_runners_.GetPlatformTaskRunner()->PostTask(fml::MakeCopyable(
+      [view = platform_view_->GetWeakPtr(),
+       messages = std::move(messages)]() mutable {
+        if (!view) {
+          return;
+        }
+        for (auto& message : messages) {
+          view->HandlePlatformMessage(std::move(message));
+        }
+      }));
+}
+
 void Shell::HandleEngineSkiaMessage(fml::RefPtr<PlatformMessage> message) {
   const auto& data = message->data();
 
   rapidjson::Document document;
-  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
+                 data.GetSize());
   if (document.HasParseError() || !document.IsObject())
     return;
   auto root = document.GetObject();
@@ -1185,6 +1754,60 @@ std::unique_ptr<std::vector<std::string>> Shell::ComputePlatformResolvedLocale(
   return platform_view_->ComputePlatformResolvedLocales(supported_locale_data);
 }
 
+// |Engine::Delegate|
+void Shell::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [view = platform_view_->GetWeakPtr(),
+       ui_task_runner = task_runners_.GetUITaskRunner(),
+       engine = weak_engine_, loading_unit_id]() {
+        if (view && view->RequestDartDeferredLibrary(loading_unit_id)) {
+          return;
+        }
+        ui_task_runner->PostTask([engine, loading_unit_id]() {
+          if (engine) {
+            engine->LoadDartDeferredLibraryError(
+                loading_unit_id,
+                "Deferred loading unit " + std::to_string(loading_unit_id) +
+                    " is not bundled and the platform can not provide it.",
+                /*transient=*/false);
+          }
+        });
+      });
+}
+
+void Shell::LoadDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      fml::MakeCopyable(
+          [engine = weak_engine_, loading_unit_id,
+           data = std::move(snapshot_data),
+           instructions = std::move(snapshot_instructions)]() mutable {
+            if (engine) {
+              engine->LoadDartDeferredLibrary(
+                  loading_unit_id, std::move(data), std::move(instructions));
+            }
+          }));
+}
+
+void Shell::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
+                                         const std::string& error_message,
+                                         bool transient) {
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, loading_unit_id, error_message, transient]() {
+        if (engine) {
+          engine->LoadDartDeferredLibraryError(loading_unit_id, error_message,
+                                               transient);
+        }
+      });
+}
+
 void Shell::ReportTimings() {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
@@ -1215,6 +1838,15 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (settings_.enable_adaptive_frame_pipelining) {
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, timing]() {
+          if (engine) {
+            engine->OnFrameRasterized(timing);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1264,6 +1896,22 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   }
 }
 
+void Shell::OnPresentationFeedback(const PresentationFeedback& feedback) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  FML_TRACE_COUNTER("flutter", "LatePresentedFrames",
+                    reinterpret_cast<int64_t>(this), "Frames",
+                    feedback.late_frames);
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = weak_engine_, feedback]() {
+        if (engine) {
+          engine->OnPresentationFeedback(feedback);
+        }
+      });
+}
+
 fml::Milliseconds Shell::GetFrameBudget() {
   double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
   if (display_refresh_rate > 0) {
@@ -1280,6 +1928,16 @@ fml::TimePoint Shell::GetLatestFrameTargetTime() const {
   return latest_frame_target_time_.value();
 }
 
+// |Rasterizer::Delegate|
+bool Shell::ShouldDeferSnapshots() {
+  std::scoped_lock lock(frame_in_flight_mutex_);
+  if (!frame_in_flight_) {
+    return false;
+  }
+  snapshots_deferred_ = true;
+  return true;
+}
+
 // |ServiceProtocol::Handler|
 fml::RefPtr<fml::TaskRunner> Shell::GetServiceProtocolHandlerTaskRunner(
     std::string_view method) const {
@@ -1341,6 +1999,18 @@ static void ServiceProtocolFailureError(rapidjson::Document* response,
   response->AddMember("message", message, allocator);
 }
 
+static rapidjson::Value HistogramSummaryToJSON(
+    const fml::Histogram::Summary& summary,
+    rapidjson::Document::AllocatorType& allocator) {
+  rapidjson::Value histogram(rapidjson::kObjectType);
+  histogram.AddMember<uint64_t>("count", summary.count, allocator);
+  histogram.AddMember<uint64_t>("p50", summary.p50, allocator);
+  histogram.AddMember<uint64_t>("p90", summary.p90, allocator);
+  histogram.AddMember<uint64_t>("p99", summary.p99, allocator);
+  histogram.AddMember<uint64_t>("max", summary.max, allocator);
+  return histogram;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolScreenshot(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1383,6 +2053,27 @@ bool Shell::OnServiceProtocolScreenshotSKP(
   return false;
 }
 
+// Service protocol handler
+bool Shell::OnServiceProtocolCaptureLayerTree(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto screenshot = rasterizer_->ScreenshotLastLayerTree(
+      Rasterizer::ScreenshotType::LayerTreeCapture, true);
+  if (screenshot.data) {
+    response->SetObject();
+    auto& allocator = response->GetAllocator();
+    response->AddMember("type", "LayerTreeCapture", allocator);
+    rapidjson::Value capture;
+    capture.SetString(static_cast<const char*>(screenshot.data->data()),
+                      screenshot.data->size(), allocator);
+    response->AddMember("capture", capture, allocator);
+    return true;
+  }
+  ServiceProtocolFailureError(response, "Could not capture the layer tree.");
+  return false;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolRunInView(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1406,12 +2097,38 @@ bool Shell::OnServiceProtocolRunInView(
   std::string asset_directory_path =
       fml::paths::FromURI(params.at("assetDirectory").data());
 
-  auto main_script_file_mapping =
-      std::make_unique<fml::FileMapping>(fml::OpenFile(
-          main_script_path.c_str(), false, fml::FilePermission::kRead));
+  std::unique_ptr<IsolateConfiguration> isolate_configuration;
+  const std::string kernel_list_extension(kKernelListExtension);
+  if (main_script_path.size() > kernel_list_extension.size() &&
+      main_script_path.compare(
+          main_script_path.size() - kernel_list_extension.size(),
+          kernel_list_extension.size(), kernel_list_extension) == 0) {
+    // The application is split into several kernel snapshots, each mapped
+    // from its own file on the IO thread. The tool only has to rewrite the
+    // snapshots that changed since the last restart, and unchanged ones are
+    // mapped from the page cache instead of being read again.
+    auto kernel_directory = std::make_shared<AssetManager>();
+    kernel_directory->PushBack(std::make_unique<DirectoryAssetBundle>(
+        fml::OpenDirectory(
+            fml::paths::GetDirectoryName(main_script_path).c_str(), false,
+            fml::FilePermission::kRead),
+        false));
+    isolate_configuration = IsolateConfiguration::CreateForKernelListAsset(
+        main_script_path.substr(main_script_path.find_last_of("/\\") + 1),
+        std::move(kernel_directory), task_runners_.GetIOTaskRunner());
+    if (!isolate_configuration) {
+      ServiceProtocolFailureError(response,
+                                  "Could not load the kernel list.");
+      return false;
+    }
+  } else {
+    auto main_script_file_mapping =
+        std::make_unique<fml::FileMapping>(fml::OpenFile(
+            main_script_path.c_str(), false, fml::FilePermission::kRead));
 
-  auto isolate_configuration = IsolateConfiguration::CreateForKernel(
-      std::move(main_script_file_mapping));
+    isolate_configuration = IsolateConfiguration::CreateForKernel(
+        std::move(main_script_file_mapping));
+  }
 
   RunConfiguration configuration(std::move(isolate_configuration));
 
@@ -1528,6 +2245,358 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+// Service protocol handler
+bool Shell::OnServiceProtocolGetDecodedImageCacheStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto cache = io_manager_->GetDecodedImageCache();
+  const auto stats = cache ? cache->GetStats() : DecodedImageCache::Stats{};
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "DecodedImageCacheStats", allocator);
+  response->AddMember<uint64_t>("hitCount", stats.hit_count, allocator);
+  response->AddMember<uint64_t>("missCount", stats.miss_count, allocator);
+  response->AddMember<uint64_t>("entryCount", stats.entry_count, allocator);
+  response->AddMember<uint64_t>("bytes", stats.byte_size, allocator);
+  response->AddMember<uint64_t>("maxBytes", stats.max_bytes, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetGlyphUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "GetGlyphUsage", allocator);
+  response->AddMember(
+      "fonts",
+      GlyphUsageToJSON(txt::GlyphUsageRecorder::GetInstance().GetUsage(),
+                       allocator),
+      allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameHistograms(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  // The histograms are atomic, so they are read without waiting on the raster
+  // task runner, which could be busy with frames.
+  auto rasterizer = thread_safe_weak_rasterizer_.Pin();
+  if (!rasterizer) {
+    ServiceProtocolFailureError(response, "The rasterizer is not available.");
+    return false;
+  }
+  auto& frame_histograms = rasterizer->compositor_context()->frame_histograms();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameHistograms", allocator);
+  rapidjson::Value phases(rapidjson::kObjectType);
+  for (auto phase : FrameHistograms::kPhases) {
+    phases.AddMember(
+        rapidjson::StringRef(FrameHistograms::GetPhaseName(phase)),
+        HistogramSummaryToJSON(frame_histograms.Summarize(phase), allocator),
+        allocator);
+  }
+  response->AddMember("phases", phases, allocator);
+  auto reset = params.find("reset");
+  if (reset != params.end() && reset->second == "true") {
+    frame_histograms.Reset();
+  }
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  // Like the histograms, the ring is read without waiting on the raster task
+  // runner.
+  auto rasterizer = thread_safe_weak_rasterizer_.Pin();
+  if (!rasterizer) {
+    ServiceProtocolFailureError(response, "The rasterizer is not available.");
+    return false;
+  }
+  auto& frame_stats = rasterizer->compositor_context()->frame_stats();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameStats", allocator);
+  response->AddMember<uint64_t>("capacity", frame_stats.GetCapacity(),
+                                allocator);
+  response->AddMember<uint64_t>("dropped", frame_stats.GetDroppedCount(),
+                                allocator);
+  // Each frame is an array rather than an object to keep long recordings
+  // small. The "fields" member names its elements.
+  rapidjson::Value fields(rapidjson::kArrayType);
+  for (const char* field :
+       {"frameNumber", "rasterStartMicros", "prerollMicros", "paintMicros",
+        "layers", "pictures", "ops", "rasterCacheHits",
+        "rasterCacheInsertions", "rasterCacheLayerEntries",
+        "rasterCachePictureEntries"}) {
+    fields.PushBack(rapidjson::StringRef(field), allocator);
+  }
+  response->AddMember("fields", fields, allocator);
+  rapidjson::Value frames(rapidjson::kArrayType);
+  for (const auto& stats : frame_stats.GetFrames()) {
+    rapidjson::Value frame(rapidjson::kArrayType);
+    frame.PushBack<uint64_t>(stats.frame_number, allocator);
+    frame.PushBack<int64_t>(stats.raster_start_micros, allocator);
+    frame.PushBack(stats.preroll_micros, allocator);
+    frame.PushBack(stats.paint_micros, allocator);
+    frame.PushBack(stats.layer_count, allocator);
+    frame.PushBack(stats.picture_count, allocator);
+    frame.PushBack(stats.op_count, allocator);
+    frame.PushBack(stats.raster_cache_hits, allocator);
+    frame.PushBack(stats.raster_cache_insertions, allocator);
+    frame.PushBack(stats.raster_cache_layer_entries, allocator);
+    frame.PushBack(stats.raster_cache_picture_entries, allocator);
+    frames.PushBack(frame, allocator);
+  }
+  response->AddMember("frames", frames, allocator);
+  auto clear = params.find("clear");
+  if (clear != params.end() && clear->second == "true") {
+    frame_stats.Clear();
+  }
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetRasterCacheDecisions(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto& raster_cache = rasterizer_->compositor_context()->raster_cache();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "RasterCacheDecisions", allocator);
+  response->AddMember("recording", raster_cache.IsRecordingDecisions(),
+                      allocator);
+  rapidjson::Value decisions(rapidjson::kArrayType);
+  for (const auto& decision : raster_cache.GetLastFrameDecisions()) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember(
+        "kind",
+        rapidjson::StringRef(RasterCacheDecision::GetKindName(decision.kind)),
+        allocator);
+    value.AddMember("outcome",
+                    rapidjson::StringRef(
+                        RasterCacheDecision::GetOutcomeName(decision.outcome)),
+                    allocator);
+    value.AddMember<uint64_t>("id", decision.id, allocator);
+    rapidjson::Value rect(rapidjson::kArrayType);
+    rect.PushBack(decision.device_rect.left(), allocator);
+    rect.PushBack(decision.device_rect.top(), allocator);
+    rect.PushBack(decision.device_rect.right(), allocator);
+    rect.PushBack(decision.device_rect.bottom(), allocator);
+    value.AddMember("rect", rect, allocator);
+    value.AddMember<uint64_t>("accessCount", decision.access_count, allocator);
+    value.AddMember<int64_t>("rasterizeMicros",
+                             decision.rasterize_time.ToMicroseconds(),
+                             allocator);
+    value.AddMember<uint64_t>("bytes", decision.bytes, allocator);
+    decisions.PushBack(value, allocator);
+  }
+  response->AddMember("decisions", decisions, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetTraceRecording(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const auto json = fml::tracing::TraceRecorder::GetChromeTraceJSON();
+  response->Parse(json.c_str(), json.size());
+  if (response->HasParseError() || !response->IsObject()) {
+    ServiceProtocolFailureError(response, "Could not format the recording.");
+    return false;
+  }
+  response->AddMember("type", "TraceRecording", response->GetAllocator());
+  auto clear = params.find("clear");
+  if (clear != params.end() && clear->second == "true") {
+    fml::tracing::TraceRecorder::Clear();
+  }
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetRasterThreadMergerStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto raster_thread_merger = rasterizer_->GetRasterThreadMerger();
+  const auto stats = raster_thread_merger
+                         ? raster_thread_merger->GetStats()
+                         : fml::RasterThreadMerger::Stats{0, 0, 1};
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "RasterThreadMergerStats", allocator);
+  response->AddMember("hasThreadMerger", raster_thread_merger != nullptr,
+                      allocator);
+  response->AddMember<uint64_t>("mergeCount", stats.merge_count, allocator);
+  response->AddMember<uint64_t>("unmergeCount", stats.unmerge_count,
+                                allocator);
+  response->AddMember<uint64_t>("leaseTermMultiplier",
+                                stats.lease_term_multiplier, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetResourceCacheBudget(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto* budget = rasterizer_->GetResourceCacheBudget();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "ResourceCacheBudget", allocator);
+  response->AddMember<uint64_t>(
+      "maxBytes", rasterizer_->GetResourceCacheMaxBytes().value_or(0),
+      allocator);
+  response->AddMember("adaptive", budget != nullptr, allocator);
+  if (budget) {
+    response->AddMember<uint64_t>("baseBytes", budget->GetBaseBudget(),
+                                  allocator);
+    response->AddMember<uint64_t>("ceilingBytes", budget->GetCeiling(),
+                                  allocator);
+    response->AddMember<uint64_t>("growCount", budget->GetGrowCount(),
+                                  allocator);
+    response->AddMember<uint64_t>("shrinkCount", budget->GetShrinkCount(),
+                                  allocator);
+    response->AddMember<uint64_t>("lowMemoryWarningCount",
+                                  budget->GetLowMemoryWarningCount(),
+                                  allocator);
+    response->AddMember(
+        "lastDecision",
+        rapidjson::StringRef(
+            ResourceCacheBudget::DecisionToString(budget->GetLastDecision())),
+        allocator);
+  }
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetTaskQueueStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  // The statistics are atomic, so they are read without waiting on the task
+  // runners, which could be the ones backed up.
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto reset_param = params.find("reset");
+  const bool reset =
+      reset_param != params.end() && reset_param->second == "true";
+  const std::pair<const char*, fml::RefPtr<fml::TaskRunner>> runners[] = {
+      {"platform", task_runners_.GetPlatformTaskRunner()},
+      {"ui", task_runners_.GetUITaskRunner()},
+      {"raster", task_runners_.GetRasterTaskRunner()},
+      {"io", task_runners_.GetIOTaskRunner()},
+  };
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TaskQueueStats", allocator);
+  rapidjson::Value queues(rapidjson::kObjectType);
+  for (const auto& [name, runner] : runners) {
+    fml::TaskQueueStats::Summary summary;
+    if (!runner ||
+        !task_queues->GetTaskStats(runner->GetTaskQueueId(), &summary)) {
+      continue;
+    }
+    rapidjson::Value queue(rapidjson::kObjectType);
+    queue.AddMember("queueLatency",
+                    HistogramSummaryToJSON(summary.queue_latency, allocator),
+                    allocator);
+    queue.AddMember("runTime",
+                    HistogramSummaryToJSON(summary.run_time, allocator),
+                    allocator);
+    queue.AddMember("queueDepth",
+                    HistogramSummaryToJSON(summary.queue_depth, allocator),
+                    allocator);
+    queues.AddMember(rapidjson::StringRef(name), queue, allocator);
+    if (reset) {
+      task_queues->ResetTaskStats(runner->GetTaskQueueId());
+    }
+  }
+  response->AddMember("queues", queues, allocator);
+  response->AddMember<uint64_t>(
+      "sampleInterval", fml::TaskQueueStats::kSampleInterval, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetDartGCStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (!engine_) {
+    ServiceProtocolFailureError(response, "The engine is not available.");
+    return false;
+  }
+  const Engine::DartGCStats& stats = engine_->GetDartGCStats();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "DartGCStats", allocator);
+  response->AddMember<uint64_t>("frames", stats.frames, allocator);
+  response->AddMember<uint64_t>("frameScavenges", stats.frame_scavenges,
+                                allocator);
+  response->AddMember<uint64_t>("frameOldGenCollections",
+                                stats.frame_old_gen_collections, allocator);
+  response->AddMember<uint64_t>("idleNotifications", stats.idle_notifications,
+                                allocator);
+  response->AddMember<uint64_t>("idleScavenges", stats.idle_scavenges,
+                                allocator);
+  response->AddMember<uint64_t>("idleOldGenCollections",
+                                stats.idle_old_gen_collections, allocator);
+  auto reset = params.find("reset");
+  if (reset != params.end() && reset->second == "true") {
+    engine_->ResetDartGCStats();
+  }
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetMemoryBreakdown(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  const MemoryBreakdown breakdown = GetMemoryBreakdown();
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "MemoryBreakdown", allocator);
+  rapidjson::Value dart_heap(rapidjson::kObjectType);
+  dart_heap.AddMember<int64_t>("newUsedBytes",
+                               breakdown.dart_heap.new_used_bytes, allocator);
+  dart_heap.AddMember<int64_t>(
+      "newCapacityBytes", breakdown.dart_heap.new_capacity_bytes, allocator);
+  dart_heap.AddMember<int64_t>("oldUsedBytes",
+                               breakdown.dart_heap.old_used_bytes, allocator);
+  dart_heap.AddMember<int64_t>(
+      "oldCapacityBytes", breakdown.dart_heap.old_capacity_bytes, allocator);
+  dart_heap.AddMember<int64_t>("externalBytes",
+                               breakdown.dart_heap.external_bytes, allocator);
+  response->AddMember("dartHeap", dart_heap, allocator);
+  rapidjson::Value raster_cache(rapidjson::kObjectType);
+  raster_cache.AddMember<uint64_t>(
+      "layerBytes", breakdown.raster_cache_layer_bytes, allocator);
+  raster_cache.AddMember<uint64_t>(
+      "pictureBytes", breakdown.raster_cache_picture_bytes, allocator);
+  response->AddMember("rasterCache", raster_cache, allocator);
+  rapidjson::Value gpu_resources(rapidjson::kObjectType);
+  gpu_resources.AddMember<uint64_t>("bytes", breakdown.gpu_resource_bytes,
+                                    allocator);
+  gpu_resources.AddMember<uint64_t>(
+      "purgeableBytes", breakdown.gpu_resource_purgeable_bytes, allocator);
+  response->AddMember("gpuResources", gpu_resources, allocator);
+  response->AddMember<uint64_t>("decodedImageCacheBytes",
+                                breakdown.decoded_image_cache_bytes, allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1601,6 +2670,65 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+Shell::MemoryBreakdown Shell::GetMemoryBreakdown() {
+  TRACE_EVENT0("flutter", "Shell::GetMemoryBreakdown");
+  MemoryBreakdown breakdown;
+  fml::AutoResetWaitableEvent latch;
+
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [&latch, engine = weak_engine_, &breakdown]() {
+        if (engine) {
+          if (auto heap = engine->GetUIIsolateHeapUsage()) {
+            breakdown.dart_heap = *heap;
+          }
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [&latch, rasterizer = GetRasterizer(), &breakdown]() {
+        if (rasterizer) {
+          const auto& raster_cache =
+              rasterizer->compositor_context()->raster_cache();
+          breakdown.raster_cache_layer_bytes =
+              raster_cache.EstimateLayerCacheByteSize();
+          breakdown.raster_cache_picture_bytes =
+              raster_cache.EstimatePictureCacheByteSize();
+          if (auto usage = rasterizer->GetResourceCacheUsage()) {
+            breakdown.gpu_resource_bytes = usage->first;
+            breakdown.gpu_resource_purgeable_bytes = usage->second;
+          }
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetIOTaskRunner(),
+      [&latch, io_manager = io_manager_->GetWeakPtr(), &breakdown]() {
+        if (io_manager) {
+          if (auto cache = io_manager->GetDecodedImageCache()) {
+            breakdown.decoded_image_cache_bytes = cache->GetStats().byte_size;
+          }
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+
+  return breakdown;
+}
+
+Histogram::Summary Shell::GetFrameHistogram(FrameHistograms::Phase phase) {
+  if (auto rasterizer = thread_safe_weak_rasterizer_.Pin()) {
+    return rasterizer->compositor_context()->frame_histograms().Summarize(
+        phase);
+  }
+  return {};
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_setup_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -1623,6 +2751,32 @@ fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   }
 }
 
+void Shell::SetPlatformMessageChannelBackground(const std::string& channel,
+                                                bool background) {
+  std::scoped_lock lock(background_channels_mutex_);
+  if (!background) {
+    background_channels_.erase(channel);
+    return;
+  }
+  background_channels_.insert(channel);
+  if (!background_message_thread_) {
+    background_message_thread_ =
+        std::make_unique<fml::Thread>("io.flutter.platform_messages");
+  }
+}
+
+void Shell::SetPlatformMessageChannelBatching(
+    const std::string& channel,
+    Engine::PlatformMessageBatching batching) {
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetUITaskRunner(),
+      [engine = weak_engine_, channel, batching]() {
+        if (engine) {
+          engine->SetPlatformMessageChannelBatching(channel, batching);
+        }
+      });
+}
+
 bool Shell::ReloadSystemFonts() {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
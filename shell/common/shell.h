@@ -6,12 +6,15 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <map>
 #include <mutex>
+#include <set>
 #include <string_view>
 #include <unordered_map>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/texture.h"
+#include "flutter/common/memory_pressure_level.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/surface.h"
@@ -19,6 +22,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/thread_checker.h"
+#include "flutter/fml/memory/thread_safe_weak_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/status.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -98,6 +102,20 @@ class Shell final : public PlatformView::Delegate,
   template <class T>
   using CreateCallback = std::function<std::unique_ptr<T>(Shell&)>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Starts bootstrapping the Dart VM with the provided settings on
+  ///             a background thread, so that the VM boot overlaps with the
+  ///             work the embedder does before it creates the first shell, such
+  ///             as showing a splash screen. The first shell created later
+  ///             with the same settings uses the prewarmed VM, and waits for
+  ///             its boot to finish if necessary.
+  ///
+  ///             Nothing is done if a VM is already running in the process.
+  ///
+  /// @param[in]  settings  The settings the first shell will be created with.
+  ///
+  static void PrewarmDartVM(Settings settings);
+
   //----------------------------------------------------------------------------
   /// @brief      Creates a shell instance using the provided settings. The
   ///             callbacks to create the various shell subcomponents will be
@@ -212,6 +230,35 @@ class Shell final : public PlatformView::Delegate,
       const CreateCallback<Rasterizer>& on_create_rasterizer,
       DartVMRef vm);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a shell that shares as much as possible with this
+  ///             one and runs it with |run_configuration|. The new shell uses
+  ///             the VM, task runners, settings, IO manager (and so the GPU
+  ///             resource context) and font collection of this shell, and its
+  ///             root isolate joins the isolate group of the root isolate of
+  ///             this shell instead of loading its own copy of the program.
+  ///             Only the platform view, rasterizer and engine are created
+  ///             for it.
+  ///
+  ///             This must be called on the platform task runner after the
+  ///             engine of this shell was run. The spawned shell must be
+  ///             destroyed before this shell, which owns the resource context
+  ///             it uses.
+  ///
+  /// @param[in]  run_configuration        The configuration to run the spawned
+  ///                                      engine with.
+  /// @param[in]  on_create_platform_view  The callback that must return a
+  ///                                      platform view for the spawned shell.
+  /// @param[in]  on_create_rasterizer     The callback that must provide a
+  ///                                      rasterizer for the spawned shell.
+  ///
+  /// @return     The spawned shell, or nullptr if it could not be set up.
+  ///
+  std::unique_ptr<Shell> Spawn(
+      RunConfiguration run_configuration,
+      const CreateCallback<PlatformView>& on_create_platform_view,
+      const CreateCallback<Rasterizer>& on_create_rasterizer) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys the shell. This is a synchronous operation and
   ///             synchronous barrier blocks are introduced on the various
@@ -291,9 +338,15 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
-  void NotifyLowMemoryWarning() const;
+  ///             warning. The shell trims the raster cache, Skia's resource
+  ///             cache and the decoded image cache. Under critical pressure,
+  ///             these caches are emptied, and the Dart VM, the glyph cache
+  ///             and the font family cache are purged as well.
+  ///
+  /// @param[in]  level  How much memory the shell should free.
+  ///
+  void NotifyLowMemoryWarning(
+      MemoryPressureLevel level = MemoryPressureLevel::kCritical) const;
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
@@ -321,6 +374,48 @@ class Shell final : public PlatformView::Delegate,
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes held by each subsystem of the shell, as
+  ///             accounted by the subsystem itself.
+  ///
+  struct MemoryBreakdown {
+    /// The heap of the isolate group of the root isolate. The external bytes
+    /// are the native allocations the `dart:ui` wrappers report to the VM.
+    DartHeapUsage dart_heap;
+    /// The layers and pictures rasterized into the `RasterCache`.
+    size_t raster_cache_layer_bytes = 0;
+    size_t raster_cache_picture_bytes = 0;
+    /// The GPU resources held by Skia's resource cache, of which
+    /// `gpu_resource_purgeable_bytes` may be freed at any time.
+    size_t gpu_resource_bytes = 0;
+    size_t gpu_resource_purgeable_bytes = 0;
+    /// The images held by the `DecodedImageCache`.
+    size_t decoded_image_cache_bytes = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the memory held by each subsystem of the shell. This
+  ///             waits for a task on the UI, raster and IO task runners in
+  ///             turn, so it must not be called while any of them is blocked
+  ///             on the calling thread.
+  ///
+  /// @return     The memory breakdown. Subsystems that are not running report
+  ///             zero bytes.
+  ///
+  MemoryBreakdown GetMemoryBreakdown();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Summarizes one phase of all the frames rendered by the
+  ///             rasterizer of this shell so far. May be called on any thread,
+  ///             and does not wait on the raster task runner.
+  ///
+  /// @param[in]  phase  The frame phase to summarize.
+  ///
+  /// @return     The percentiles of the phase. Its count is zero if no frame
+  ///             was rendered yet.
+  ///
+  Histogram::Summary GetFrameHistogram(FrameHistograms::Phase phase);
+
   //----------------------------------------------------------------------------
   /// @brief   Pauses the calling thread until the first frame is presented.
   ///
@@ -340,6 +435,43 @@ class Shell final : public PlatformView::Delegate,
   ///
   bool ReloadSystemFonts();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Makes the platform messages the framework sends on `channel`
+  ///             be delivered on a dedicated background thread instead of the
+  ///             platform thread. The messages of all background channels are
+  ///             handled in order on that thread, by
+  ///             `PlatformView::HandleBackgroundPlatformMessage`.
+  ///
+  ///             This lets embedders run slow handlers, like database queries,
+  ///             without delaying input and vsync on the platform thread.
+  ///
+  /// @attention  This may be called on any thread.
+  ///
+  /// @param[in]  channel     The name of the channel.
+  /// @param[in]  background  Whether the messages of the channel are handled
+  ///                         in the background.
+  ///
+  void SetPlatformMessageChannelBackground(const std::string& channel,
+                                           bool background);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets how the platform messages the framework sends on
+  ///             `channel` are forwarded to the platform view. Batched
+  ///             messages are delivered on the platform thread with one task
+  ///             per batch, so they may arrive after messages of other
+  ///             channels that were sent later.
+  ///
+  /// @see        `Engine::PlatformMessageBatching`
+  ///
+  /// @attention  This may be called on any thread.
+  ///
+  /// @param[in]  channel   The name of the channel.
+  /// @param[in]  batching  How the messages of the channel are forwarded.
+  ///
+  void SetPlatformMessageChannelBatching(
+      const std::string& channel,
+      Engine::PlatformMessageBatching batching);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to get the last error from the Dart UI
   ///             Isolate, if one exists.
@@ -382,6 +514,36 @@ class Shell final : public PlatformView::Delegate,
   ///
   double GetMainDisplayRefreshRate();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Completes a request of the root isolate to load a deferred
+  ///             loading unit, that the platform view accepted in
+  ///             `PlatformView::RequestDartDeferredLibrary`. May be called on
+  ///             any thread.
+  ///
+  /// @param[in]  loading_unit_id        The identifier of the loading unit.
+  /// @param[in]  snapshot_data          The heap snapshot of the loading unit.
+  /// @param[in]  snapshot_instructions  The instructions snapshot of the
+  ///                                    loading unit, mapped executable (for
+  ///                                    example with
+  ///                                    `fml::FileMapping::CreateReadExecute`).
+  ///
+  void LoadDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fails a request of the root isolate to load a deferred
+  ///             loading unit. May be called on any thread.
+  ///
+  /// @param[in]  loading_unit_id  The identifier of the loading unit.
+  /// @param[in]  error_message    Why the loading unit could not be loaded.
+  /// @param[in]  transient        Whether loading it may be retried.
+  ///
+  void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
+                                    const std::string& error_message,
+                                    bool transient);
+
  private:
   using ServiceProtocolHandler =
       std::function<bool(const ServiceProtocol::Handler::ServiceProtocolMap&,
@@ -395,12 +557,18 @@ class Shell final : public PlatformView::Delegate,
   std::unique_ptr<PlatformView> platform_view_;  // on platform task runner
   std::unique_ptr<Engine> engine_;               // on UI task runner
   std::unique_ptr<Rasterizer> rasterizer_;       // on GPU task runner
-  std::unique_ptr<ShellIOManager> io_manager_;   // on IO task runner
+  std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
+  // The idle work of |io_manager_|, scheduled from the animator's timing.
+  fml::RefPtr<fml::IdleTaskQueue> io_idle_task_queue_;
+  // Whether |io_manager_| was created by the shell this one was spawned from.
+  bool is_spawned_ = false;
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
 
   fml::WeakPtr<Engine> weak_engine_;  // to be shared across threads
   fml::TaskRunnerAffineWeakPtr<Rasterizer>
       weak_rasterizer_;  // to be shared across threads
+  fml::ThreadSafeWeakPtr<Rasterizer>
+      thread_safe_weak_rasterizer_;  // to be pinned on any thread
   fml::WeakPtr<PlatformView>
       weak_platform_view_;  // to be shared across threads
 
@@ -443,6 +611,26 @@ class Shell final : public PlatformView::Delegate,
   // used to discard wrong size layer tree produced during interactive resizing
   SkISize expected_frame_size_ = SkISize::MakeEmpty();
 
+  // The trees rendered for the views other than the implicit view that the
+  // raster thread has yet to draw, at most one per view. A tree that is
+  // replaced by a newer one for the same view before it is drawn is dropped.
+  std::mutex pending_view_layer_trees_mutex_;
+  std::map<int64_t, std::unique_ptr<flutter::LayerTree>>
+      pending_view_layer_trees_;
+
+  // Protects the channels whose platform messages are handled in the
+  // background, and the thread they are handled on. The thread is created
+  // when the first channel is made a background channel.
+  std::mutex background_channels_mutex_;
+  std::set<std::string> background_channels_;
+  std::unique_ptr<fml::Thread> background_message_thread_;
+
+  // Whether the UI thread is in |OnAnimatorBeginFrame|, and whether the
+  // rasterizer deferred snapshots meanwhile. Read on the raster thread.
+  std::mutex frame_in_flight_mutex_;
+  bool frame_in_flight_ = false;
+  bool snapshots_deferred_ = false;
+
   // How many frames have been timed since last report.
   size_t UnreportedFramesCount() const;
 
@@ -455,15 +643,19 @@ class Shell final : public PlatformView::Delegate,
       Settings settings,
       fml::RefPtr<const DartSnapshot> isolate_snapshot,
       const Shell::CreateCallback<PlatformView>& on_create_platform_view,
-      const Shell::CreateCallback<Rasterizer>& on_create_rasterizer);
+      const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
+      const Shell* spawning_shell = nullptr);
 
   bool Setup(std::unique_ptr<PlatformView> platform_view,
              std::unique_ptr<Engine> engine,
              std::unique_ptr<Rasterizer> rasterizer,
-             std::unique_ptr<ShellIOManager> io_manager);
+             std::shared_ptr<ShellIOManager> io_manager);
 
   void ReportTimings();
 
+  // Preloads the raster cache with the images stored by previous launches.
+  void LoadPersistedRasterCacheImages();
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -474,6 +666,18 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewSetViewportMetrics(
       const ViewportMetrics& metrics) override;
 
+  // |PlatformView::Delegate|
+  void OnPlatformViewAddView(int64_t view_id,
+                             std::unique_ptr<Surface> surface,
+                             const ViewportMetrics& metrics) override;
+
+  // |PlatformView::Delegate|
+  void OnPlatformViewRemoveView(int64_t view_id) override;
+
+  // |PlatformView::Delegate|
+  void OnPlatformViewSetViewMetrics(int64_t view_id,
+                                    const ViewportMetrics& metrics) override;
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchPlatformMessage(
       fml::RefPtr<PlatformMessage> message) override;
@@ -482,6 +686,11 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewDispatchPointerDataPacket(
       std::unique_ptr<PointerDataPacket> packet) override;
 
+  // Lets the rasterizer scroll the last frame by the scroll events of
+  // |packet|, ahead of the framework. See |Rasterizer::HandleCompositorScroll|.
+  void DispatchCompositorScrolls(const PointerDataPacket& packet,
+                                 uint64_t flow_id);
+
   // |PlatformView::Delegate|
   void OnPlatformViewDispatchSemanticsAction(
       int32_t id,
@@ -520,6 +729,10 @@ class Shell final : public PlatformView::Delegate,
   // |Animator::Delegate|
   void OnAnimatorDrawLastLayerTree() override;
 
+  // |Animator::Delegate|
+  void OnAnimatorDrawView(
+      std::unique_ptr<flutter::LayerTree> layer_tree) override;
+
   // |Engine::Delegate|
   void OnEngineUpdateSemantics(
       SemanticsNodeUpdates update,
@@ -529,6 +742,10 @@ class Shell final : public PlatformView::Delegate,
   void OnEngineHandlePlatformMessage(
       fml::RefPtr<PlatformMessage> message) override;
 
+  // |Engine::Delegate|
+  void OnEngineHandlePlatformMessages(
+      std::vector<fml::RefPtr<PlatformMessage>> messages) override;
+
   void HandleEngineSkiaMessage(fml::RefPtr<PlatformMessage> message);
 
   // |Engine::Delegate|
@@ -548,15 +765,24 @@ class Shell final : public PlatformView::Delegate,
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
 
+  // |Engine::Delegate|
+  void RequestDartDeferredLibrary(intptr_t loading_unit_id) override;
+
   // |Rasterizer::Delegate|
   void OnFrameRasterized(const FrameTiming&) override;
 
+  // |Rasterizer::Delegate|
+  void OnPresentationFeedback(const PresentationFeedback& feedback) override;
+
   // |Rasterizer::Delegate|
   fml::Milliseconds GetFrameBudget() override;
 
   // |Rasterizer::Delegate|
   fml::TimePoint GetLatestFrameTargetTime() const override;
 
+  // |Rasterizer::Delegate|
+  bool ShouldDeferSnapshots() override;
+
   // |ServiceProtocol::Handler|
   fml::RefPtr<fml::TaskRunner> GetServiceProtocolHandlerTaskRunner(
       std::string_view method) const override;
@@ -581,6 +807,14 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Returns the last layer tree as a Base 64 encoded layer tree capture, to
+  // be rasterized again with the layer_tree_replay tool.
+  bool OnServiceProtocolCaptureLayerTree(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   bool OnServiceProtocolRunInView(
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -613,6 +847,98 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  bool OnServiceProtocolGetDecodedImageCacheStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the glyphs recorded with |Settings::record_glyph_usage|. The
+  // "fonts" member can be bundled as the |kGlyphUsageAssetName| asset.
+  bool OnServiceProtocolGetGlyphUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the percentiles of every |FrameHistograms::Phase| of the frames
+  // rendered so far. The histograms are cleared afterwards if the "reset"
+  // parameter is "true", so that each query covers the frames since the last.
+  bool OnServiceProtocolGetFrameHistograms(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the |FrameStats| of the last frames recorded with
+  // |Settings::frame_stats_capacity|, oldest first. The frames are cleared
+  // afterwards if the "clear" parameter is "true".
+  bool OnServiceProtocolGetFrameStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the |RasterCacheDecision|s of the last frame, recorded with
+  // |Settings::trace_raster_cache_decisions| or
+  // |Settings::show_raster_cache_heatmap|.
+  bool OnServiceProtocolGetRasterCacheDecisions(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the events of the |fml::tracing::TraceRecorder| as a Chrome JSON
+  // trace, with a "traceEvents" member. The recording is cleared afterwards
+  // if the "clear" parameter is "true".
+  bool OnServiceProtocolGetTraceRecording(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns how often the raster and platform threads were merged and
+  // unmerged, and the current multiplier of the merge lease term. The counts
+  // are zero when the rasterizer has no |fml::RasterThreadMerger|.
+  bool OnServiceProtocolGetRasterThreadMergerStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the size of Skia's resource cache and, when it is adapted to the
+  // cache usage, the decisions of the |ResourceCacheBudget| so far.
+  bool OnServiceProtocolGetResourceCacheBudget(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the bytes held by the Dart heap and by the engine caches, see
+  // |GetMemoryBreakdown|.
+  bool OnServiceProtocolGetMemoryBreakdown(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the |fml::TaskQueueStats| of the platform, UI, raster and IO task
+  // runners. Task runners that do not run on a message loop, like the ones of
+  // embedders, report no tasks. The statistics are cleared afterwards if the
+  // "reset" parameter is "true".
+  bool OnServiceProtocolGetTaskQueueStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Returns the |Engine::DartGCStats| of the frames built so far. The counts
+  // are cleared afterwards if the "reset" parameter is "true".
+  bool OnServiceProtocolGetDartGCStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Creates an asset bundle from the original settings asset path or
   // directory.
   std::unique_ptr<DirectoryAssetBundle> RestoreOriginalAssetResolver();
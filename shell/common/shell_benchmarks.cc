@@ -5,42 +5,69 @@
 #include "flutter/shell/common/shell.h"
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/platform_view_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/skia_gpu_object.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/thread.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+#ifdef SHELL_ENABLE_GL
+#include "flutter/shell/gpu/gpu_surface_gl.h"
+#include "flutter/testing/test_gl_surface.h"
+#endif  // SHELL_ENABLE_GL
 
 namespace flutter {
 
+// Creates the settings of a shell that runs the engine fixtures. The AOT
+// symbols, if any, are loaded into |aot_symbols|, which must outlive the
+// shell.
+static Settings CreateSettingsForFixture(testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, fml::closure) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary();
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not setup settings with AOT symbols.";
+  } else {
+    settings.application_kernels = []() {
+      auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                           fml::FilePermission::kRead);
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
-  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
-                                       fml::FilePermission::kRead);
   std::unique_ptr<Shell> shell;
   std::unique_ptr<ThreadHost> thread_host;
   testing::ELFAOTSymbols aot_symbols;
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, fml::closure) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary();
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not setup settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
+    Settings settings = CreateSettingsForFixture(aot_symbols);
 
     thread_host = std::make_unique<ThreadHost>(
         "io.flutter.bench.", ThreadHost::Type::Platform |
@@ -119,4 +146,496 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// The frame pipeline benchmarks below render synthetic layer trees that stress
+// different parts of the pipeline. The phases of a frame are measured on a
+// compositor context driven directly, and the end-to-end latency of a frame on
+// the raster thread of a shell without a running isolate.
+
+namespace {
+
+const SkISize kFrameSize = SkISize::Make(800, 600);
+
+enum class Backend { kSoftware, kGL };
+
+enum class Scenario {
+  // Transform layers nested deeply, with a picture at every level.
+  kDeepTransforms,
+  // Many sibling picture layers.
+  kManyPictures,
+  // Opacity and clip layers nested in alternation.
+  kOpacityClipStack,
+  // Platform views interleaved with picture layers.
+  kPlatformViews,
+};
+
+enum class FramePhase {
+  // The preroll of the layer tree, including the raster cache lookups.
+  kPreroll,
+  // The paint of the layer tree, ignoring the raster cache.
+  kPaint,
+  // A whole frame, once the raster cache holds the pictures of the tree.
+  kRasterCache,
+};
+
+sk_sp<SkPicture> MakePicture(SkScalar size, SkColor color) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(size, size));
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  paint.setColor(color);
+  canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeWH(size, size), size / 8,
+                                        size / 8),
+                    paint);
+  paint.setColor(SK_ColorWHITE);
+  canvas->drawCircle(size / 2, size / 2, size / 4, paint);
+  return recorder.finishRecordingAsPicture();
+}
+
+std::shared_ptr<Layer> MakePictureLayer(const SkPoint& offset,
+                                        SkScalar size,
+                                        SkColor color,
+                                        fml::RefPtr<SkiaUnrefQueue> queue) {
+  // Complex pictures are raster cached once they have been drawn for a few
+  // frames.
+  return std::make_shared<PictureLayer>(
+      offset, SkiaGPUObject(MakePicture(size, color), std::move(queue)),
+      /*is_complex=*/true, /*will_change=*/false);
+}
+
+std::shared_ptr<Layer> MakeLayerTree(Scenario scenario,
+                                     fml::RefPtr<SkiaUnrefQueue> queue) {
+  auto root = std::make_shared<ContainerLayer>();
+  switch (scenario) {
+    case Scenario::kDeepTransforms: {
+      ContainerLayer* parent = root.get();
+      for (int i = 0; i < 64; i++) {
+        SkMatrix matrix = SkMatrix::Translate(6, 4);
+        matrix.preRotate(1);
+        auto transform = std::make_shared<TransformLayer>(matrix);
+        transform->Add(
+            MakePictureLayer(SkPoint::Make(0, 0), 48, SK_ColorBLUE, queue));
+        parent->Add(transform);
+        parent = transform.get();
+      }
+      break;
+    }
+    case Scenario::kManyPictures: {
+      for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+          root->Add(MakePictureLayer(SkPoint::Make(x * 50, y * 37), 32,
+                                     SkColorSetRGB(x * 16, y * 16, 128),
+                                     queue));
+        }
+      }
+      break;
+    }
+    case Scenario::kOpacityClipStack: {
+      ContainerLayer* parent = root.get();
+      for (int i = 0; i < 32; i++) {
+        const SkScalar inset = i * 8;
+        std::shared_ptr<ContainerLayer> layer;
+        if (i % 2 == 0) {
+          layer = std::make_shared<OpacityLayer>(240, SkPoint::Make(0, 0));
+        } else {
+          layer = std::make_shared<ClipRectLayer>(
+              SkRect::MakeLTRB(inset, inset, kFrameSize.width() - inset,
+                               kFrameSize.height() - inset),
+              i % 4 == 1 ? Clip::hardEdge : Clip::antiAlias);
+        }
+        layer->Add(MakePictureLayer(SkPoint::Make(inset, inset), 96,
+                                    SK_ColorGREEN, queue));
+        parent->Add(layer);
+        parent = layer.get();
+      }
+      break;
+    }
+    case Scenario::kPlatformViews: {
+      for (int i = 0; i < 8; i++) {
+        root->Add(
+            MakePictureLayer(SkPoint::Make(i * 96, 0), 80, SK_ColorRED, queue));
+        root->Add(std::make_shared<PlatformViewLayer>(
+            SkPoint::Make(i * 96, 100), SkSize::Make(80, 80), i));
+        root->Add(MakePictureLayer(SkPoint::Make(i * 96, 200), 80,
+                                   SK_ColorYELLOW, queue));
+      }
+      break;
+    }
+  }
+  return root;
+}
+
+// Records the content painted above each platform view into an overlay that
+// is drawn on top of the frame when it is submitted, like the embedders that
+// composite platform views do.
+class BenchmarkViewEmbedder final : public ExternalViewEmbedder {
+ public:
+  BenchmarkViewEmbedder() = default;
+
+  // Draws the overlays of the current frame on |canvas|, which may be null.
+  void DrawOverlays(SkCanvas* canvas) {
+    for (auto& overlay : overlays_) {
+      auto picture = overlay.second->finishRecordingAsPicture();
+      if (canvas) {
+        canvas->drawPicture(picture);
+      }
+    }
+    overlays_.clear();
+  }
+
+  // |ExternalViewEmbedder|
+  SkCanvas* GetRootCanvas() override { return nullptr; }
+
+  // |ExternalViewEmbedder|
+  void CancelFrame() override { overlays_.clear(); }
+
+  // |ExternalViewEmbedder|
+  void BeginFrame(
+      SkISize frame_size,
+      GrDirectContext* context,
+      double device_pixel_ratio,
+      fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) override {
+    frame_size_ = frame_size;
+    overlays_.clear();
+  }
+
+  // |ExternalViewEmbedder|
+  void PrerollCompositeEmbeddedView(
+      int view_id,
+      std::unique_ptr<EmbeddedViewParams> params) override {
+    auto recorder = std::make_unique<SkPictureRecorder>();
+    recorder->beginRecording(SkRect::Make(frame_size_));
+    overlays_.emplace_back(view_id, std::move(recorder));
+  }
+
+  // |ExternalViewEmbedder|
+  std::vector<SkCanvas*> GetCurrentCanvases() override {
+    std::vector<SkCanvas*> canvases;
+    for (const auto& overlay : overlays_) {
+      canvases.push_back(overlay.second->getRecordingCanvas());
+    }
+    return canvases;
+  }
+
+  // |ExternalViewEmbedder|
+  SkCanvas* CompositeEmbeddedView(int view_id) override {
+    for (const auto& overlay : overlays_) {
+      if (overlay.first == view_id) {
+        return overlay.second->getRecordingCanvas();
+      }
+    }
+    FML_CHECK(false) << "Platform view " << view_id << " was not prerolled.";
+    return nullptr;
+  }
+
+  // |ExternalViewEmbedder|
+  void SubmitFrame(GrDirectContext* context,
+                   std::unique_ptr<SurfaceFrame> frame) override {
+    DrawOverlays(frame->SkiaCanvas());
+    frame->Submit();
+  }
+
+ private:
+  SkISize frame_size_;
+  std::vector<std::pair<int, std::unique_ptr<SkPictureRecorder>>> overlays_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BenchmarkViewEmbedder);
+};
+
+// The surface the phase benchmarks render to.
+class BenchmarkRenderTarget {
+ public:
+  explicit BenchmarkRenderTarget(Backend backend) {
+    switch (backend) {
+      case Backend::kSoftware:
+        surface_ = SkSurface::MakeRasterN32Premul(kFrameSize.width(),
+                                                  kFrameSize.height());
+        break;
+      case Backend::kGL:
+#ifdef SHELL_ENABLE_GL
+        gl_surface_ = std::make_unique<testing::TestGLSurface>(kFrameSize);
+        FML_CHECK(gl_surface_->MakeCurrent());
+        gr_context_ = gl_surface_->GetGrContext();
+        surface_ = gl_surface_->GetOnscreenSurface();
+#endif  // SHELL_ENABLE_GL
+        break;
+    }
+    FML_CHECK(surface_) << "Could not create the render target.";
+  }
+
+  SkCanvas* canvas() const { return surface_->getCanvas(); }
+
+  GrDirectContext* gr_context() const { return gr_context_.get(); }
+
+  void Flush() { surface_->getCanvas()->flush(); }
+
+ private:
+#ifdef SHELL_ENABLE_GL
+  std::unique_ptr<testing::TestGLSurface> gl_surface_;
+#endif  // SHELL_ENABLE_GL
+  sk_sp<GrDirectContext> gr_context_;
+  sk_sp<SkSurface> surface_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BenchmarkRenderTarget);
+};
+
+// The platform view of the end-to-end benchmarks, which renders to an
+// offscreen surface.
+class BenchmarkPlatformView final : public PlatformView,
+#ifdef SHELL_ENABLE_GL
+                                    public GPUSurfaceGLDelegate,
+#endif  // SHELL_ENABLE_GL
+                                    public GPUSurfaceSoftwareDelegate {
+ public:
+  BenchmarkPlatformView(PlatformView::Delegate& delegate,
+                        TaskRunners task_runners,
+                        Backend backend,
+                        std::shared_ptr<ExternalViewEmbedder> view_embedder)
+      : PlatformView(delegate, std::move(task_runners)),
+        backend_(backend),
+        view_embedder_(std::move(view_embedder)) {
+#ifdef SHELL_ENABLE_GL
+    if (backend_ == Backend::kGL) {
+      gl_surface_ = std::make_unique<testing::TestGLSurface>(kFrameSize);
+    }
+#endif  // SHELL_ENABLE_GL
+  }
+
+ private:
+  const Backend backend_;
+  std::shared_ptr<ExternalViewEmbedder> view_embedder_;
+  sk_sp<SkSurface> backing_store_;
+#ifdef SHELL_ENABLE_GL
+  std::unique_ptr<testing::TestGLSurface> gl_surface_;
+#endif  // SHELL_ENABLE_GL
+
+  // |PlatformView|
+  std::unique_ptr<Surface> CreateRenderingSurface() override {
+    switch (backend_) {
+      case Backend::kSoftware:
+        return std::make_unique<GPUSurfaceSoftware>(this, true);
+      case Backend::kGL:
+#ifdef SHELL_ENABLE_GL
+        return std::make_unique<GPUSurfaceGL>(this, true);
+#endif  // SHELL_ENABLE_GL
+        break;
+    }
+    return nullptr;
+  }
+
+  // |PlatformView|
+  std::shared_ptr<ExternalViewEmbedder> CreateExternalViewEmbedder() override {
+    return view_embedder_;
+  }
+
+  // |GPUSurfaceSoftwareDelegate|
+  sk_sp<SkSurface> AcquireBackingStore(const SkISize& size) override {
+    if (!backing_store_ || backing_store_->width() != size.width() ||
+        backing_store_->height() != size.height()) {
+      backing_store_ =
+          SkSurface::MakeRasterN32Premul(size.width(), size.height());
+    }
+    return backing_store_;
+  }
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStore(sk_sp<SkSurface> backing_store) override {
+    return true;
+  }
+
+#ifdef SHELL_ENABLE_GL
+  // |GPUSurfaceGLDelegate|
+  std::unique_ptr<GLContextResult> GLContextMakeCurrent() override {
+    return std::make_unique<GLContextDefaultResult>(
+        gl_surface_->MakeCurrent());
+  }
+
+  // |GPUSurfaceGLDelegate|
+  bool GLContextClearCurrent() override { return gl_surface_->ClearCurrent(); }
+
+  // |GPUSurfaceGLDelegate|
+  bool GLContextPresent(uint32_t fbo_id) override {
+    return gl_surface_->Present();
+  }
+
+  // |GPUSurfaceGLDelegate|
+  intptr_t GLContextFBO(GLFrameInfo frame_info) const override {
+    return gl_surface_->GetFramebuffer(frame_info.width, frame_info.height);
+  }
+
+  // |GPUSurfaceGLDelegate|
+  GLProcResolver GetGLProcResolver() const override {
+    return [surface = gl_surface_.get()](const char* name) -> void* {
+      return surface->GetProcAddress(name);
+    };
+  }
+#endif  // SHELL_ENABLE_GL
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BenchmarkPlatformView);
+};
+
+}  // namespace
+
+static void BM_FramePhase(benchmark::State& state,
+                          Backend backend,
+                          Scenario scenario,
+                          FramePhase phase) {
+  fml::Thread unref_thread("io.flutter.bench.unref");
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      unref_thread.GetTaskRunner(), fml::TimeDelta::Zero());
+  BenchmarkRenderTarget target(backend);
+  BenchmarkViewEmbedder view_embedder;
+  ExternalViewEmbedder* embedder =
+      scenario == Scenario::kPlatformViews ? &view_embedder : nullptr;
+
+  CompositorContext compositor_context;
+  LayerTree layer_tree(kFrameSize, 1.0f);
+  layer_tree.set_root_layer(MakeLayerTree(scenario, unref_queue));
+  const bool ignore_raster_cache = phase == FramePhase::kPaint;
+  const SkMatrix root_surface_transformation = SkMatrix::I();
+
+  auto draw_frame = [&](bool timed) {
+    std::unique_ptr<CompositorContext::ScopedFrame> frame;
+    {
+      benchmarking::ScopedPauseTiming pause(
+          state, timed && phase != FramePhase::kRasterCache);
+      if (embedder) {
+        embedder->BeginFrame(kFrameSize, target.gr_context(), 1.0, nullptr);
+      }
+      frame = compositor_context.AcquireFrame(
+          target.gr_context(), target.canvas(), embedder,
+          root_surface_transformation, true, true, nullptr);
+    }
+    {
+      benchmarking::ScopedPauseTiming pause(
+          state, timed && phase == FramePhase::kPaint);
+      layer_tree.Preroll(*frame, ignore_raster_cache);
+    }
+    {
+      benchmarking::ScopedPauseTiming pause(
+          state, timed && phase == FramePhase::kPreroll);
+      layer_tree.Paint(*frame, ignore_raster_cache);
+    }
+    {
+      benchmarking::ScopedPauseTiming pause(
+          state, timed && phase != FramePhase::kRasterCache);
+      view_embedder.DrawOverlays(target.canvas());
+      // Ending the frame sweeps the raster cache.
+      frame.reset();
+    }
+    {
+      benchmarking::ScopedPauseTiming pause(state, timed);
+      target.Flush();
+    }
+  };
+
+  // Draw enough frames for the raster cache to hold the pictures.
+  for (int i = 0; i < 4; i++) {
+    draw_frame(false);
+  }
+  while (state.KeepRunning()) {
+    draw_frame(true);
+  }
+
+  layer_tree.set_root_layer(nullptr);
+  unref_queue->Drain();
+}
+
+static void BM_FrameEndToEnd(benchmark::State& state,
+                             Backend backend,
+                             Scenario scenario) {
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateSettingsForFixture(aot_symbols);
+  ThreadHost thread_host("io.flutter.bench.",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  std::shared_ptr<ExternalViewEmbedder> view_embedder;
+  if (scenario == Scenario::kPlatformViews) {
+    view_embedder = std::make_shared<BenchmarkViewEmbedder>();
+  }
+  auto shell = Shell::Create(
+      task_runners, settings,
+      [backend, view_embedder](Shell& shell) {
+        return std::make_unique<BenchmarkPlatformView>(
+            shell, shell.GetTaskRunners(), backend, view_embedder);
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  FML_CHECK(shell);
+
+  // Creating the platform view sets up the surface of the rasterizer.
+  {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners.GetPlatformTaskRunner(), [&shell, &latch]() {
+          shell->GetPlatformView()->NotifyCreated();
+          latch.Signal();
+        });
+    latch.Wait();
+  }
+
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      task_runners.GetIOTaskRunner(), fml::TimeDelta::Zero());
+  std::shared_ptr<Layer> root_layer = MakeLayerTree(scenario, unref_queue);
+  auto pipeline = fml::AdoptRef(new Pipeline<LayerTree>(/*depth=*/2));
+  auto rasterizer = shell->GetRasterizer();
+
+  // Measures the time from the layer tree being handed to the raster thread
+  // to the frame being submitted, as the UI thread would see it.
+  while (state.KeepRunning()) {
+    fml::AutoResetWaitableEvent latch;
+    task_runners.GetRasterTaskRunner()->PostTask([&]() {
+      auto layer_tree = std::make_unique<LayerTree>(kFrameSize, 1.0f);
+      layer_tree->set_root_layer(root_layer);
+      FML_CHECK(pipeline->Produce().Complete(std::move(layer_tree)));
+      rasterizer->Draw(pipeline);
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+
+  root_layer.reset();
+  {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(task_runners.GetPlatformTaskRunner(),
+                                      [&shell, &latch]() mutable {
+                                        shell.reset();
+                                        latch.Signal();
+                                      });
+    latch.Wait();
+  }
+  unref_queue->Drain();
+}
+
+#define SCENARIO_BENCHMARKS(backend_name, scenario_name)                   \
+  BENCHMARK_CAPTURE(BM_FramePhase, Preroll/scenario_name/backend_name,     \
+                    Backend::k##backend_name, Scenario::k##scenario_name,  \
+                    FramePhase::kPreroll)                                  \
+      ->Unit(benchmark::kMicrosecond);                                     \
+  BENCHMARK_CAPTURE(BM_FramePhase, Paint/scenario_name/backend_name,       \
+                    Backend::k##backend_name, Scenario::k##scenario_name,  \
+                    FramePhase::kPaint)                                    \
+      ->Unit(benchmark::kMicrosecond);                                     \
+  BENCHMARK_CAPTURE(BM_FramePhase, RasterCache/scenario_name/backend_name, \
+                    Backend::k##backend_name, Scenario::k##scenario_name,  \
+                    FramePhase::kRasterCache)                              \
+      ->Unit(benchmark::kMicrosecond);                                     \
+  BENCHMARK_CAPTURE(BM_FrameEndToEnd, scenario_name/backend_name,          \
+                    Backend::k##backend_name, Scenario::k##scenario_name)  \
+      ->Unit(benchmark::kMicrosecond);
+
+#define FRAME_BENCHMARKS(backend_name)                \
+  SCENARIO_BENCHMARKS(backend_name, DeepTransforms)   \
+  SCENARIO_BENCHMARKS(backend_name, ManyPictures)     \
+  SCENARIO_BENCHMARKS(backend_name, OpacityClipStack) \
+  SCENARIO_BENCHMARKS(backend_name, PlatformViews)
+
+FRAME_BENCHMARKS(Software)
+#ifdef SHELL_ENABLE_GL
+FRAME_BENCHMARKS(GL)
+#endif  // SHELL_ENABLE_GL
+
 }  // namespace flutter
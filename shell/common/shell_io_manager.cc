@@ -7,10 +7,19 @@
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/lib/ui/painting/image.h"
 #include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
 namespace flutter {
 
+// The longest an unref queue drain waits for an idle period between frames.
+static constexpr fml::TimeDelta kMaxUnrefQueueDrainDelay =
+    fml::TimeDelta::FromMilliseconds(100);
+
+// The longest a single unref queue drain may spend releasing objects.
+static constexpr fml::TimeDelta kUnrefQueueDrainBudget =
+    fml::TimeDelta::FromMilliseconds(2);
+
 sk_sp<GrDirectContext> ShellIOManager::CreateCompatibleResourceLoadingContext(
     GrBackend backend,
     sk_sp<const GrGLInterface> gl_interface) {
@@ -61,12 +70,16 @@ ShellIOManager::ShellIOManager(
               ? std::make_unique<fml::WeakPtrFactory<GrDirectContext>>(
                     resource_context_.get())
               : nullptr),
+      idle_task_queue_(
+          fml::MakeRefCounted<fml::IdleTaskQueue>(unref_queue_task_runner)),
       unref_queue_(fml::MakeRefCounted<flutter::SkiaUnrefQueue>(
           std::move(unref_queue_task_runner),
           fml::TimeDelta::FromMilliseconds(8),
           GetResourceContext())),
       is_gpu_disabled_sync_switch_(is_gpu_disabled_sync_switch),
       weak_factory_(this) {
+  unref_queue_->SetIdleTaskQueue(idle_task_queue_, kMaxUnrefQueueDrainDelay);
+  unref_queue_->SetDrainBudget(kUnrefQueueDrainBudget);
   if (!resource_context_) {
 #ifndef OS_FUCHSIA
     FML_DLOG(WARNING) << "The IO manager was initialized without a resource "
@@ -77,6 +90,9 @@ ShellIOManager::ShellIOManager(
 }
 
 ShellIOManager::~ShellIOManager() {
+  // Textures transferred between isolates of this engine can no longer be
+  // claimed, and are released along with the rest of the queue.
+  CanvasImage::ReleaseTransferredImages(unref_queue_.get());
   // Last chance to drain the IO queue as the platform side reference to the
   // underlying OpenGL context may be going away.
   is_gpu_disabled_sync_switch_->Execute(
@@ -95,6 +111,10 @@ void ShellIOManager::NotifyResourceContextAvailable(
 
 void ShellIOManager::UpdateResourceContext(
     sk_sp<GrDirectContext> resource_context) {
+  // Textures of the old context may not be used with the new one.
+  if (decoded_image_cache_) {
+    decoded_image_cache_->Clear();
+  }
   resource_context_ = std::move(resource_context);
   resource_context_weak_factory_ =
       resource_context_
@@ -114,6 +134,10 @@ fml::WeakPtr<GrDirectContext> ShellIOManager::GetResourceContext() const {
              : fml::WeakPtr<GrDirectContext>();
 }
 
+fml::RefPtr<fml::IdleTaskQueue> ShellIOManager::GetIdleTaskQueue() const {
+  return idle_task_queue_;
+}
+
 // |IOManager|
 fml::RefPtr<flutter::SkiaUnrefQueue> ShellIOManager::GetSkiaUnrefQueue() const {
   return unref_queue_;
@@ -129,4 +153,24 @@ std::shared_ptr<fml::SyncSwitch> ShellIOManager::GetIsGpuDisabledSyncSwitch() {
   return is_gpu_disabled_sync_switch_;
 }
 
+void ShellIOManager::SetDecodedImageCache(
+    std::shared_ptr<DecodedImageCache> cache) {
+  decoded_image_cache_ = std::move(cache);
+}
+
+std::shared_ptr<DecodedImageCache> ShellIOManager::GetDecodedImageCache()
+    const {
+  return decoded_image_cache_;
+}
+
+void ShellIOManager::SetResourceContextPool(
+    std::shared_ptr<ResourceContextPool> pool) {
+  resource_context_pool_ = std::move(pool);
+}
+
+std::shared_ptr<ResourceContextPool> ShellIOManager::GetResourceContextPool()
+    const {
+  return resource_context_pool_;
+}
+
 }  // namespace flutter
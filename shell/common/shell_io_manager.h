@@ -8,9 +8,12 @@
 #include <memory>
 
 #include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/idle_task_queue.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+#include "flutter/lib/ui/painting/resource_context_pool.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -43,6 +46,23 @@ class ShellIOManager final : public IOManager {
 
   fml::WeakPtr<ShellIOManager> GetWeakPtr();
 
+  // The cache of decoded images shared with the image decoder of the engine,
+  // or null if the cache is disabled. Images in the cache are released when
+  // the resource context is updated.
+  void SetDecodedImageCache(std::shared_ptr<DecodedImageCache> cache);
+
+  std::shared_ptr<DecodedImageCache> GetDecodedImageCache() const;
+
+  // The additional resource contexts that the image decoder of the engine
+  // uploads decoded images with, or null to upload them on the IO thread.
+  void SetResourceContextPool(std::shared_ptr<ResourceContextPool> pool);
+
+  std::shared_ptr<ResourceContextPool> GetResourceContextPool() const;
+
+  // The queue of maintenance work on the IO task runner that is scheduled
+  // into the idle periods between frames, such as draining the unref queue.
+  fml::RefPtr<fml::IdleTaskQueue> GetIdleTaskQueue() const;
+
   // |IOManager|
   fml::WeakPtr<IOManager> GetWeakIOManager() const override;
 
@@ -61,11 +81,18 @@ class ShellIOManager final : public IOManager {
   std::unique_ptr<fml::WeakPtrFactory<GrDirectContext>>
       resource_context_weak_factory_;
 
+  // Idle work on the IO task runner.
+  fml::RefPtr<fml::IdleTaskQueue> idle_task_queue_;
+
   // Unref queue management.
   fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue_;
 
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
 
+  std::shared_ptr<DecodedImageCache> decoded_image_cache_;
+
+  std::shared_ptr<ResourceContextPool> resource_context_pool_;
+
   fml::WeakPtrFactory<ShellIOManager> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ShellIOManager);
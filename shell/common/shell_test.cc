@@ -253,6 +253,40 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kEstimateRasterCacheMemory:
             shell->OnServiceProtocolEstimateRasterCacheMemory(params, response);
             break;
+          case ServiceProtocolEnum::kGetDecodedImageCacheStats:
+            shell->OnServiceProtocolGetDecodedImageCacheStats(params, response);
+            break;
+          case ServiceProtocolEnum::kGetGlyphUsage:
+            shell->OnServiceProtocolGetGlyphUsage(params, response);
+            break;
+          case ServiceProtocolEnum::kGetFrameHistograms:
+            shell->OnServiceProtocolGetFrameHistograms(params, response);
+            break;
+          case ServiceProtocolEnum::kGetFrameStats:
+            shell->OnServiceProtocolGetFrameStats(params, response);
+            break;
+          case ServiceProtocolEnum::kGetRasterCacheDecisions:
+            shell->OnServiceProtocolGetRasterCacheDecisions(params, response);
+            break;
+          case ServiceProtocolEnum::kGetTraceRecording:
+            shell->OnServiceProtocolGetTraceRecording(params, response);
+            break;
+          case ServiceProtocolEnum::kGetRasterThreadMergerStats:
+            shell->OnServiceProtocolGetRasterThreadMergerStats(params,
+                                                               response);
+            break;
+          case ServiceProtocolEnum::kGetResourceCacheBudget:
+            shell->OnServiceProtocolGetResourceCacheBudget(params, response);
+            break;
+          case ServiceProtocolEnum::kGetMemoryBreakdown:
+            shell->OnServiceProtocolGetMemoryBreakdown(params, response);
+            break;
+          case ServiceProtocolEnum::kGetTaskQueueStats:
+            shell->OnServiceProtocolGetTaskQueueStats(params, response);
+            break;
+          case ServiceProtocolEnum::kGetDartGCStats:
+            shell->OnServiceProtocolGetDartGCStats(params, response);
+            break;
           case ServiceProtocolEnum::kSetAssetBundlePath:
             shell->OnServiceProtocolSetAssetBundlePath(params, response);
             break;
@@ -95,6 +95,17 @@ class ShellTest : public FixtureTest {
   enum ServiceProtocolEnum {
     kGetSkSLs,
     kEstimateRasterCacheMemory,
+    kGetDecodedImageCacheStats,
+    kGetGlyphUsage,
+    kGetFrameHistograms,
+    kGetFrameStats,
+    kGetRasterCacheDecisions,
+    kGetTraceRecording,
+    kGetRasterThreadMergerStats,
+    kGetResourceCacheBudget,
+    kGetMemoryBreakdown,
+    kGetTaskQueueStats,
+    kGetDartGCStats,
     kSetAssetBundlePath,
     kRunInView,
   };
@@ -19,8 +19,12 @@
 #include "flutter/fml/dart/dart_converter.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -35,6 +39,7 @@
 #include "third_party/rapidjson/include/rapidjson/writer.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/tonic/converter/dart_converter.h"
+#include "txt/glyph_usage_recorder.h"
 
 #ifdef SHELL_ENABLE_VULKAN
 #include "flutter/vulkan/vulkan_application.h"  // nogncheck
@@ -226,6 +231,58 @@ TEST_F(ShellTest, InitializeWithGPUAndPlatformThreadsTheSame) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+namespace {
+
+class PrewarmRecordingPlatformView : public PlatformView {
+ public:
+  PrewarmRecordingPlatformView(Shell& shell,
+                               fml::AutoResetWaitableEvent& prewarm_latch)
+      : PlatformView(shell, shell.GetTaskRunners()),
+        prewarm_latch_(prewarm_latch) {}
+
+  // |PlatformView|
+  void PrewarmGPUContext() override {
+    EXPECT_TRUE(
+        task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+    prewarm_latch_.Signal();
+  }
+
+ private:
+  fml::AutoResetWaitableEvent& prewarm_latch_;
+};
+
+}  // namespace
+
+TEST_F(ShellTest, PrewarmsTheGPUContextOnTheRasterThreadBeforeRunning) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  Settings settings = CreateSettingsForFixture();
+  settings.prewarm_gpu_context = true;
+  ThreadHost thread_host(
+      "io.flutter.test." + GetCurrentTestName() + ".",
+      ThreadHost::Type::GPU | ThreadHost::Type::IO | ThreadHost::Type::UI);
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  TaskRunners task_runners("test",
+                           fml::MessageLoop::GetCurrent().GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  fml::AutoResetWaitableEvent prewarm_latch;
+  auto shell = Shell::Create(
+      std::move(task_runners), settings,
+      [&prewarm_latch](Shell& shell) {
+        return std::make_unique<PrewarmRecordingPlatformView>(shell,
+                                                              prewarm_latch);
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  ASSERT_TRUE(shell && shell->IsSetup());
+
+  // The engine has not been run, nor has the platform view a surface.
+  prewarm_latch.Wait();
+
+  DestroyShell(std::move(shell), std::move(task_runners));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, FixturesAreFunctional) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   auto settings = CreateSettingsForFixture();
@@ -272,6 +329,59 @@ TEST_F(ShellTest, SecondaryIsolateBindingsAreSetupViaShellSettings) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, CanSpawnShellThatSharesFontCollection) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  fml::AutoResetWaitableEvent main_latch;
+  AddNativeCallback(
+      "SayHiFromFixturesAreFunctionalMain",
+      CREATE_NATIVE_ENTRY([&main_latch](auto args) { main_latch.Signal(); }));
+
+  std::unique_ptr<Shell> spawn;
+  fml::AutoResetWaitableEvent spawn_latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetPlatformTaskRunner(), [&]() {
+        auto spawn_configuration =
+            RunConfiguration::InferFromSettings(settings);
+        spawn_configuration.SetEntrypoint("fixturesAreFunctionalMain");
+        auto vsync_clock = std::make_shared<ShellTestVsyncClock>();
+        spawn = shell->Spawn(
+            std::move(spawn_configuration),
+            [vsync_clock](Shell& shell) {
+              const TaskRunners& task_runners = shell.GetTaskRunners();
+              return ShellTestPlatformView::Create(
+                  shell, task_runners, vsync_clock,
+                  [task_runners]() {
+                    return static_cast<std::unique_ptr<VsyncWaiter>>(
+                        std::make_unique<VsyncWaiterFallback>(task_runners));
+                  },
+                  ShellTestPlatformView::BackendType::kDefaultBackend,
+                  nullptr);
+            },
+            [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+        spawn_latch.Signal();
+      });
+  spawn_latch.Wait();
+  ASSERT_TRUE(ValidateShell(spawn.get()));
+
+  // The spawned engine runs its own entrypoint.
+  main_latch.Wait();
+  ASSERT_EQ(GetFontCollection(shell.get()), GetFontCollection(spawn.get()));
+
+  DestroyShell(std::move(spawn));
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+  DestroyShell(std::move(shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, LastEntrypoint) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   auto settings = CreateSettingsForFixture();
@@ -1937,6 +2047,45 @@ TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   DestroyShell(std::move(shell), std::move(task_runners));
 }
 
+TEST_F(ShellTest, RasterizerMakeRasterSnapshotAsync) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell =
+      CreateShell(std::move(settings), std::move(task_runners));
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto latch = std::make_shared<fml::AutoResetWaitableEvent>();
+
+  PumpOneFrame(shell.get());
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&shell, latch]() {
+        SnapshotDelegate* delegate =
+            reinterpret_cast<Rasterizer*>(shell->GetRasterizer().get());
+        delegate->MakeRasterSnapshotAsync(
+            SkPicture::MakePlaceholder({0, 0, 50, 50}), SkISize::Make(50, 50),
+            [latch](sk_sp<SkImage> image) {
+              EXPECT_NE(image, nullptr);
+              if (image) {
+                EXPECT_EQ(image->dimensions(), SkISize::Make(50, 50));
+                // The pixels are in host memory.
+                SkPixmap pixmap;
+                EXPECT_TRUE(image->peekPixels(&pixmap));
+              }
+              latch->Signal();
+            });
+      });
+  latch->Wait();
+  DestroyShell(std::move(shell), std::move(task_runners));
+}
+
 static sk_sp<SkPicture> MakeSizedPicture(int width, int height) {
   SkPictureRecorder recorder;
   SkCanvas* recording_canvas =
@@ -2023,6 +2172,366 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetDecodedImageCacheStatsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  settings.decoded_image_cache_max_bytes = 1024;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetDecodedImageCacheStats,
+      shell->GetTaskRunners().GetIOTaskRunner(), empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"DecodedImageCacheStats\",\"hitCount\":0,\"missCount\":0,"
+      "\"entryCount\":0,\"bytes\":0,\"maxBytes\":1024}";
+  ASSERT_EQ(buffer.GetString(), expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetGlyphUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  settings.record_glyph_usage = true;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  ASSERT_TRUE(txt::GlyphUsageRecorder::IsEnabled());
+  txt::GlyphUsageRecorder::GetInstance().Clear();
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetGlyphUsage,
+                    shell->GetTaskRunners().GetUITaskRunner(), empty_params,
+                    &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  ASSERT_EQ(std::string(buffer.GetString()),
+            "{\"type\":\"GetGlyphUsage\",\"fonts\":[]}");
+
+  DestroyShell(std::move(shell));
+  txt::GlyphUsageRecorder::SetEnabled(false);
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetFrameHistogramsWorks) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  ASSERT_EQ(shell->GetFrameHistogram(FrameHistograms::kBuild).count, 0u);
+  PumpOneFrame(shell.get());
+  ASSERT_EQ(shell->GetFrameHistogram(FrameHistograms::kBuild).count, 1u);
+  ASSERT_EQ(shell->GetFrameHistogram(FrameHistograms::kPaint).count, 1u);
+
+  ServiceProtocol::Handler::ServiceProtocolMap reset_params;
+  reset_params["reset"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameHistograms,
+                    shell->GetTaskRunners().GetPlatformTaskRunner(),
+                    reset_params, &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "FrameHistograms");
+  for (auto phase : FrameHistograms::kPhases) {
+    const auto& histogram =
+        document["phases"][FrameHistograms::GetPhaseName(phase)];
+    ASSERT_EQ(histogram["count"].GetUint64(), 1u);
+    ASSERT_LE(histogram["p50"].GetUint64(), histogram["max"].GetUint64());
+  }
+
+  // The histograms were reset by the previous query.
+  ASSERT_EQ(shell->GetFrameHistogram(FrameHistograms::kBuild).count, 0u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetFrameStatsWorks) {
+  auto settings = CreateSettingsForFixture();
+  settings.frame_stats_capacity = 2;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  for (int i = 0; i < 3; i++) {
+    PumpOneFrame(shell.get());
+  }
+
+  ServiceProtocol::Handler::ServiceProtocolMap clear_params;
+  clear_params["clear"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameStats,
+                    shell->GetTaskRunners().GetPlatformTaskRunner(),
+                    clear_params, &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "FrameStats");
+  ASSERT_EQ(document["capacity"].GetUint64(), 2u);
+  ASSERT_EQ(document["dropped"].GetUint64(), 1u);
+  const auto& fields = document["fields"];
+  const auto& frames = document["frames"];
+  ASSERT_EQ(frames.Size(), 2u);
+  ASSERT_EQ(frames[0].Size(), fields.Size());
+  ASSERT_LT(frames[0][0].GetUint64(), frames[1][0].GetUint64());
+  // The layer tree of |PumpOneFrame| only has its root transform layer.
+  ASSERT_EQ(std::string(fields[4].GetString()), "layers");
+  ASSERT_EQ(frames[1][4].GetUint(), 1u);
+
+  // The frames were cleared by the previous query.
+  rapidjson::Document cleared_document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameStats,
+                    shell->GetTaskRunners().GetPlatformTaskRunner(), {},
+                    &cleared_document);
+  ASSERT_EQ(cleared_document["frames"].Size(), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetRasterCacheDecisionsWorks) {
+  auto settings = CreateSettingsForFixture();
+  settings.trace_raster_cache_decisions = true;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetRasterCacheDecisions,
+                    shell->GetTaskRunners().GetRasterTaskRunner(), {},
+                    &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "RasterCacheDecisions");
+  ASSERT_TRUE(document["recording"].GetBool());
+  // The layer tree of |PumpOneFrame| has nothing worth caching.
+  ASSERT_TRUE(document["decisions"].IsArray());
+  ASSERT_EQ(document["decisions"].Size(), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetTraceRecordingWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  fml::tracing::TraceRecorder::SetEnabled(true);
+  fml::tracing::TraceRecorder::Clear();
+  TRACE_EVENT_INSTANT0("flutter", "ShellTestTraceRecording");
+  fml::tracing::TraceRecorder::SetEnabled(false);
+
+  ServiceProtocol::Handler::ServiceProtocolMap clear_params;
+  clear_params["clear"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTraceRecording,
+                    shell->GetTaskRunners().GetIOTaskRunner(), clear_params,
+                    &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "TraceRecording");
+  bool found = false;
+  for (const auto& event : document["traceEvents"].GetArray()) {
+    if (std::string(event["name"].GetString()) == "ShellTestTraceRecording") {
+      found = true;
+      ASSERT_EQ(std::string(event["ph"].GetString()), "i");
+    }
+  }
+  ASSERT_TRUE(found);
+  // The recording was cleared by the previous query.
+  ASSERT_TRUE(fml::tracing::TraceRecorder::GetEvents().empty());
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetRasterThreadMergerStatsWorks) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(),
+                    ServiceProtocolEnum::kGetRasterThreadMergerStats,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+  ASSERT_EQ(std::string(document["type"].GetString()),
+            "RasterThreadMergerStats");
+  // There is no external view embedder, so the threads are never merged.
+  ASSERT_FALSE(document["hasThreadMerger"].GetBool());
+  ASSERT_EQ(document["mergeCount"].GetUint64(), 0u);
+  ASSERT_EQ(document["unmergeCount"].GetUint64(), 0u);
+  ASSERT_EQ(document["leaseTermMultiplier"].GetUint64(), 1u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetResourceCacheBudgetWorks) {
+  auto settings = CreateSettingsForFixture();
+  settings.enable_adaptive_resource_cache_budget = true;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetResourceCacheBudget,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "ResourceCacheBudget");
+  ASSERT_TRUE(document["adaptive"].GetBool());
+  ASSERT_EQ(document["lowMemoryWarningCount"].GetUint64(), 0u);
+  ASSERT_EQ(std::string(document["lastDecision"].GetString()), "none");
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetMemoryBreakdownWorks) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetMemoryBreakdown,
+                    shell->GetTaskRunners().GetPlatformTaskRunner(),
+                    empty_params, &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "MemoryBreakdown");
+  ASSERT_TRUE(document["dartHeap"].IsObject());
+  ASSERT_GT(document["dartHeap"]["oldUsedBytes"].GetInt64(), 0);
+  ASSERT_TRUE(document["rasterCache"].IsObject());
+  ASSERT_EQ(document["rasterCache"]["layerBytes"].GetUint64(), 0u);
+  ASSERT_TRUE(document["gpuResources"].IsObject());
+  ASSERT_EQ(document["decodedImageCacheBytes"].GetUint64(), 0u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetDartGCStatsCountsFrames) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["reset"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetDartGCStats,
+                    shell->GetTaskRunners().GetUITaskRunner(), params,
+                    &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "DartGCStats");
+  ASSERT_GE(document["frames"].GetUint64(), 1u);
+  ASSERT_LE(document["frameScavenges"].GetUint64(),
+            document["frames"].GetUint64());
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetTaskQueueStatsWorks) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["reset"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTaskQueueStats,
+                    shell->GetTaskRunners().GetPlatformTaskRunner(), params,
+                    &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "TaskQueueStats");
+  ASSERT_EQ(document["sampleInterval"].GetUint64(),
+            fml::TaskQueueStats::kSampleInterval);
+  for (const char* name : {"platform", "ui", "raster", "io"}) {
+    ASSERT_TRUE(document["queues"].HasMember(name)) << name;
+    const auto& queue = document["queues"][name];
+    ASSERT_TRUE(queue["queueLatency"].IsObject());
+    ASSERT_TRUE(queue["runTime"].IsObject());
+    ASSERT_TRUE(queue["queueDepth"].IsObject());
+  }
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolRunInViewLoadsKernelList) {
+  if (DartVM::IsRunningPrecompiledCode()) {
+    // Restarting from kernel requires JIT mode.
+    GTEST_SKIP();
+    return;
+  }
+
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  // A kernel list with the single snapshot of the fixtures.
+  fml::ScopedTemporaryDirectory kernel_dir;
+  const std::string kernel_list =
+      fml::paths::JoinPaths({GetFixturesPath(), "kernel_blob.bin"});
+  ASSERT_TRUE(fml::WriteAtomically(
+      fml::OpenDirectory(kernel_dir.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      "app.dilplist", fml::DataMapping(kernel_list)));
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["mainScript"] =
+      fml::paths::JoinPaths({kernel_dir.path(), "app.dilplist"});
+  params["assetDirectory"] = GetFixturesPath();
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kRunInView,
+                    shell->GetTaskRunners().GetUITaskRunner(), params,
+                    &document);
+  ASSERT_EQ(std::string(document["type"].GetString()), "Success");
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, DiscardLayerTreeOnResize) {
   auto settings = CreateSettingsForFixture();
 
@@ -5,8 +5,14 @@
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 
 #define TRACE_EVENT_HIDE_MACROS
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/posix_wrappers.h"
 #include "flutter/fml/trace_event.h"
@@ -61,7 +67,10 @@ class FlutterEventTracer : public SkEventTracer {
   static constexpr uint8_t kYes = 1;
   static constexpr uint8_t kNo = 0;
 
-  FlutterEventTracer(bool enabled) : enabled_(enabled ? kYes : kNo){};
+  FlutterEventTracer(bool enabled, const std::vector<std::string>& allowlist)
+      : enabled_(enabled) {
+    allowlist_.Fill(allowlist);
+  }
 
   SkEventTracer::Handle addTraceEvent(char phase,
                                       const uint8_t* category_enabled_flag,
@@ -220,8 +229,19 @@ class FlutterEventTracer : public SkEventTracer {
 #endif
   }
 
+  // Skia caches the returned flag at each trace site, so this is only called
+  // the first time a site is reached. The events of a category that is not
+  // enabled are then skipped by Skia after checking the flag, without calling
+  // into the tracer. The flags are stored in a map so that their addresses
+  // remain valid as categories are added.
   const uint8_t* getCategoryGroupEnabled(const char* name) override {
-    return &enabled_;
+    std::scoped_lock lock(mutex_);
+    auto found = category_flags_.find(name);
+    if (found == category_flags_.end()) {
+      found = category_flags_.emplace(name, kNo).first;
+      found->second = IsCategoryEnabled(found->first);
+    }
+    return &found->second;
   }
 
   const char* getCategoryGroupName(
@@ -229,10 +249,36 @@ class FlutterEventTracer : public SkEventTracer {
     return kSkiaTag;
   }
 
-  void enable() { enabled_ = kYes; }
+  void enable() {
+    std::scoped_lock lock(mutex_);
+    enabled_ = true;
+    UpdateCategoryFlags();
+  }
+
+  // Only the categories prefixed by an entry of |allowlist| are traced. An
+  // empty allowlist traces all the categories.
+  void SetAllowlist(const std::vector<std::string>& allowlist) {
+    std::scoped_lock lock(mutex_);
+    allowlist_.Fill(allowlist);
+    UpdateCategoryFlags();
+  }
 
  private:
-  uint8_t enabled_;
+  std::mutex mutex_;
+  bool enabled_;
+  fml::AsciiTrie allowlist_;
+  std::map<std::string, uint8_t> category_flags_;
+
+  uint8_t IsCategoryEnabled(const std::string& category) {
+    return enabled_ && allowlist_.Query(category.c_str()) ? kYes : kNo;
+  }
+
+  void UpdateCategoryFlags() {
+    for (auto& [category, flag] : category_flags_) {
+      flag = IsCategoryEnabled(category);
+    }
+  }
+
   FML_DISALLOW_COPY_AND_ASSIGN(FlutterEventTracer);
 };
 
@@ -248,12 +294,43 @@ bool enableSkiaTracingCallback(const char* method,
   return true;
 }
 
-void InitSkiaEventTracer(bool enabled) {
+// Takes the comma separated category prefixes of the "allowlist" parameter.
+// An empty or missing allowlist traces all the categories.
+bool setSkiaTraceAllowlistCallback(const char* method,
+                                   const char** param_keys,
+                                   const char** param_values,
+                                   intptr_t num_params,
+                                   void* user_data,
+                                   const char** json_object) {
+  FlutterEventTracer* tracer = static_cast<FlutterEventTracer*>(user_data);
+  std::vector<std::string> allowlist;
+  for (intptr_t i = 0; i < num_params; i++) {
+    if (std::string_view(param_keys[i]) != "allowlist") {
+      continue;
+    }
+    std::istringstream prefixes(param_values[i]);
+    std::string prefix;
+    while (std::getline(prefixes, prefix, ',')) {
+      if (!prefix.empty()) {
+        allowlist.push_back(prefix);
+      }
+    }
+  }
+  tracer->SetAllowlist(allowlist);
+  *json_object = fml::strdup("{\"type\":\"Success\"}");
+  return true;
+}
+
+void InitSkiaEventTracer(bool enabled,
+                         const std::vector<std::string>& allowlist) {
   // TODO(chinmaygarde): Leaked https://github.com/flutter/flutter/issues/30808.
-  auto tracer = new FlutterEventTracer(enabled);
+  auto tracer = new FlutterEventTracer(enabled, allowlist);
   Dart_RegisterRootServiceRequestCallback("_flutter.enableSkiaTracing",
                                           enableSkiaTracingCallback,
                                           static_cast<void*>(tracer));
+  Dart_RegisterRootServiceRequestCallback("_flutter.setSkiaTraceAllowlist",
+                                          setSkiaTraceAllowlistCallback,
+                                          static_cast<void*>(tracer));
   // Initialize the binding to Skia's tracing events. Skia will
   // take ownership of and clean up the memory allocated here.
   SkEventTracer::SetInstance(tracer);
@@ -5,9 +5,17 @@
 #ifndef FLUTTER_SHELL_COMMON_SKIA_EVENT_TRACER_IMPL_H_
 #define FLUTTER_SHELL_COMMON_SKIA_EVENT_TRACER_IMPL_H_
 
+#include <string>
+#include <vector>
+
 namespace flutter {
 
-void InitSkiaEventTracer(bool enabled);
+// Forwards the trace events of Skia to the timeline. Only the categories
+// prefixed by an entry of |allowlist| are traced, or all of them if it is
+// empty. The allowlist can be replaced at runtime with the
+// _flutter.setSkiaTraceAllowlist service extension.
+void InitSkiaEventTracer(bool enabled,
+                         const std::vector<std::string>& allowlist = {});
 
 }  // namespace flutter
 
@@ -220,6 +220,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_observatory =
       !command_line.HasOption(FlagForSwitch(Switch::DisableObservatory));
 
+  settings.defer_service_isolate_startup =
+      command_line.HasOption(FlagForSwitch(Switch::DeferServiceIsolateStartup));
+
   // Enable mDNS Observatory Publication
   settings.enable_observatory_publication = !command_line.HasOption(
       FlagForSwitch(Switch::DisableObservatoryPublication));
@@ -278,6 +281,33 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_adaptive_frame_pipelining = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptiveFramePipelining));
+
+  settings.latch_pointer_events_before_frame = command_line.HasOption(
+      FlagForSwitch(Switch::LatchPointerEventsBeforeFrame));
+
+  settings.enable_compositor_scrolling =
+      command_line.HasOption(FlagForSwitch(Switch::EnableCompositorScrolling));
+
+  settings.prewarm_gpu_context =
+      command_line.HasOption(FlagForSwitch(Switch::PrewarmGPUContext));
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::VulkanPresentMode),
+                              &settings.vulkan_present_mode);
+
+  GetSwitchValue(command_line, Switch::VulkanSwapchainImageCount,
+                 &settings.vulkan_swapchain_image_count);
+
+  settings.enable_vulkan_display_timing =
+      command_line.HasOption(FlagForSwitch(Switch::EnableVulkanDisplayTiming));
+
+  settings.enable_vulkan_surface_control =
+      command_line.HasOption(FlagForSwitch(Switch::EnableVulkanSurfaceControl));
+
+  GetSwitchValue(command_line, Switch::MetalMaximumDrawableCount,
+                 &settings.metal_maximum_drawable_count);
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -287,6 +317,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_skia =
       command_line.HasOption(FlagForSwitch(Switch::TraceSkia));
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::TraceSkiaAllowlist),
+                              &settings.trace_skia_allowlist);
+
+  settings.enable_trace_recorder =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTraceRecorder));
+
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceAllowlist),
                               &settings.trace_allowlist);
 
@@ -350,6 +386,16 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         {snapshot_asset_path, isolate_snapshot_instr_filename});
   }
 
+  command_line.GetOptionValue(
+      FlagForSwitch(Switch::SnapshotInstructionsOrderFile),
+      &settings.isolate_snapshot_instructions_order_file_path);
+  settings.prefault_isolate_snapshot_instructions =
+      command_line.HasOption(
+          FlagForSwitch(Switch::PrefaultSnapshotInstructions)) ||
+      !settings.isolate_snapshot_instructions_order_file_path.empty();
+  settings.isolate_snapshot_instructions_huge_pages = command_line.HasOption(
+      FlagForSwitch(Switch::SnapshotInstructionsHugePages));
+
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
 
@@ -401,6 +447,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.cache_sksl =
       command_line.HasOption(FlagForSwitch(Switch::CacheSkSL));
 
+  settings.record_glyph_usage =
+      command_line.HasOption(FlagForSwitch(Switch::RecordGlyphUsage));
+
+  settings.defer_sksl_warm_up =
+      command_line.HasOption(FlagForSwitch(Switch::DeferSkSLWarmUp));
+
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
@@ -410,6 +462,133 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
                                 &old_gen_heap_size);
     settings.old_gen_heap_size = std::stoi(old_gen_heap_size);
   }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxBytes))) {
+    std::string raster_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxBytes),
+                                &raster_cache_max_bytes);
+    settings.raster_cache_max_bytes = std::stoull(raster_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::FrameStatsCapacity))) {
+    std::string frame_stats_capacity;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FrameStatsCapacity),
+                                &frame_stats_capacity);
+    settings.frame_stats_capacity = std::stoull(frame_stats_capacity);
+  }
+
+  settings.raster_cache_compact_opaque_entries = command_line.HasOption(
+      FlagForSwitch(Switch::RasterCacheCompactOpaqueEntries));
+
+  settings.enable_shared_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableSharedRasterCache));
+
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+
+  settings.enable_parallel_raster_cache_recording = command_line.HasOption(
+      FlagForSwitch(Switch::EnableParallelRasterCacheRecording));
+
+  settings.enable_raster_cache_persistence = command_line.HasOption(
+      FlagForSwitch(Switch::EnableRasterCachePersistence));
+
+  settings.enable_adaptive_resource_cache_budget = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptiveResourceCacheBudget));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::DeviceMemoryMB))) {
+    std::string device_memory_mb;
+    command_line.GetOptionValue(FlagForSwitch(Switch::DeviceMemoryMB),
+                                &device_memory_mb);
+    settings.device_memory_bytes =
+        std::stoull(device_memory_mb) * 1024 * 1024;
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::DisableThreadPriorities))) {
+    settings.ui_thread_priority = fml::Thread::ThreadPriority::kNormal;
+    settings.raster_thread_priority = fml::Thread::ThreadPriority::kNormal;
+    settings.io_thread_priority = fml::Thread::ThreadPriority::kNormal;
+  }
+
+  settings.enable_thread_cpu_affinity =
+      command_line.HasOption(FlagForSwitch(Switch::EnableThreadCpuAffinity));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::TaskTimerSlackMs))) {
+    std::string task_timer_slack_ms;
+    command_line.GetOptionValue(FlagForSwitch(Switch::TaskTimerSlackMs),
+                                &task_timer_slack_ms);
+    settings.task_timer_slack_ms = std::stoll(task_timer_slack_ms);
+  }
+
+  settings.enable_parallel_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableParallelPreroll));
+
+  settings.enable_tiled_software_paint =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTiledSoftwarePaint));
+
+  settings.enable_layer_cost_profile =
+      command_line.HasOption(FlagForSwitch(Switch::EnableLayerCostProfile));
+
+  settings.trace_raster_cache_decisions =
+      command_line.HasOption(FlagForSwitch(Switch::TraceRasterCacheDecisions));
+
+  settings.show_raster_cache_heatmap =
+      command_line.HasOption(FlagForSwitch(Switch::ShowRasterCacheHeatmap));
+
+  settings.enable_yuv_image_upload =
+      command_line.HasOption(FlagForSwitch(Switch::EnableYUVImageUpload));
+
+  settings.enable_display_list =
+      command_line.HasOption(FlagForSwitch(Switch::EnableDisplayList));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ParallelImageDecodePixelThreshold))) {
+    std::string threshold;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ParallelImageDecodePixelThreshold), &threshold);
+    settings.parallel_image_decode_pixel_threshold = std::stoull(threshold);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DecodedImageCacheMaxBytes))) {
+    std::string max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::DecodedImageCacheMaxBytes), &max_bytes);
+    settings.decoded_image_cache_max_bytes = std::stoull(max_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageFrameAheadBytes))) {
+    std::string ahead_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageFrameAheadBytes), &ahead_bytes);
+    settings.animated_image_frame_ahead_bytes = std::stoull(ahead_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::PlatformImageDecodePixelThreshold))) {
+    std::string threshold;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::PlatformImageDecodePixelThreshold), &threshold);
+    settings.platform_image_decode_pixel_threshold = std::stoull(threshold);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::DownsampledBlurMinSigma))) {
+    std::string min_sigma;
+    command_line.GetOptionValue(FlagForSwitch(Switch::DownsampledBlurMinSigma),
+                                &min_sigma);
+    settings.downsampled_blur_min_sigma = std::stod(min_sigma);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DownsampledBlurMaxFactor))) {
+    std::string max_factor;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::DownsampledBlurMaxFactor), &max_factor);
+    settings.downsampled_blur_max_factor = std::stoi(max_factor);
+  }
+
+  settings.enable_skparagraph =
+      command_line.HasOption(FlagForSwitch(Switch::EnableSkParagraph));
   return settings;
 }
 
@@ -49,6 +49,19 @@ DEF_SWITCH(IsolateSnapshotInstructions,
            "isolate-snapshot-instr",
            "The isolate instructions snapshot that will be memory mapped as "
            "read and executable. SnapshotAssetPath must be present.")
+DEF_SWITCH(PrefaultSnapshotInstructions,
+           "prefault-snapshot-instructions",
+           "Fault in the pages of the isolate snapshot instructions when the "
+           "snapshot is loaded instead of during the first frames.")
+DEF_SWITCH(SnapshotInstructionsOrderFile,
+           "snapshot-instructions-order-file",
+           "Path to a file listing the byte ranges of the isolate snapshot "
+           "instructions to prefault, one \"<offset> <size>\" pair per line. "
+           "Implies PrefaultSnapshotInstructions.")
+DEF_SWITCH(SnapshotInstructionsHugePages,
+           "snapshot-instructions-huge-pages",
+           "Request transparent huge pages for the isolate snapshot "
+           "instructions where the platform supports them.")
 DEF_SWITCH(CacheDirPath,
            "cache-dir-path",
            "Path to the cache directory. "
@@ -79,6 +92,10 @@ DEF_SWITCH(DisableObservatory,
            "disable-observatory",
            "Disable the Dart Observatory. The observatory is never available "
            "in release mode.")
+DEF_SWITCH(DeferServiceIsolateStartup,
+           "defer-service-isolate-startup",
+           "Do not start the Dart VM service until the embedder asks for it. "
+           "The timeline is still recorded in the meantime.")
 DEF_SWITCH(DisableObservatoryPublication,
            "disable-observatory-publication",
            "Disable mDNS Dart Observatory publication.")
@@ -101,6 +118,61 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableAdaptiveFramePipelining,
+           "enable-adaptive-frame-pipelining",
+           "Adjust the number of frames in flight to the build and raster "
+           "times of recent frames. A second frame is only built while the "
+           "previous one is still being rasterized when the raster thread is "
+           "the bottleneck, trading one frame of latency for throughput.")
+DEF_SWITCH(VulkanPresentMode,
+           "vulkan-present-mode",
+           "The present mode of Vulkan swapchains: \"fifo\" (the default), "
+           "\"fifo-relaxed\" or \"mailbox\". Mailbox replaces a frame that "
+           "waits for the display with a newer one instead of queueing behind "
+           "it, which cuts latency when frames are produced faster than the "
+           "display refreshes. Unsupported modes fall back to \"fifo\".")
+DEF_SWITCH(VulkanSwapchainImageCount,
+           "vulkan-swapchain-image-count",
+           "The number of images of Vulkan swapchains. Clamped to what the "
+           "surface supports. By default, the minimum the surface supports is "
+           "used.")
+DEF_SWITCH(EnableVulkanDisplayTiming,
+           "enable-vulkan-display-timing",
+           "Use VK_GOOGLE_display_timing, where available, to pace the target "
+           "times of frames to the refresh period the display actually runs "
+           "at.")
+DEF_SWITCH(EnableVulkanSurfaceControl,
+           "enable-vulkan-surface-control",
+           "On Android 10 and later, render Vulkan frames into a pool of "
+           "hardware buffers and hand them to the system compositor through "
+           "a SurfaceControl transaction with their fences, instead of "
+           "through a swapchain. Devices without the needed Vulkan "
+           "extensions keep using the swapchain.")
+DEF_SWITCH(MetalMaximumDrawableCount,
+           "metal-maximum-drawable-count",
+           "The number of drawables of Metal layers, 2 or 3. Two drawables "
+           "shorten latency while three let the raster thread start the next "
+           "frame while the display still holds the previous two. By default, "
+           "Core Animation decides.")
+DEF_SWITCH(LatchPointerEventsBeforeFrame,
+           "latch-pointer-events-before-frame",
+           "Dispatch pointer events to the framework right before the next "
+           "frame begins instead of as soon as they are received. This lets "
+           "the frame of the next vsync react to the latest pointer "
+           "positions, which shortens touch-to-photon latency by a frame.")
+DEF_SWITCH(EnableCompositorScrolling,
+           "enable-compositor-scrolling",
+           "Scroll the scroll layers of the last frame on the raster thread "
+           "as pointer scroll events arrive, without waiting for the "
+           "framework to build a frame for them. The framework receives the "
+           "same events, and its next frames take over the scroll offsets.")
+DEF_SWITCH(PrewarmGPUContext,
+           "prewarm-gpu-context",
+           "Create the GPU context and precompile the cached shaders as soon "
+           "as the engine starts, in parallel with the startup of the Dart "
+           "isolate, so that the first frame does not wait for them once the "
+           "platform view has a surface. Only the OpenGL ES surfaces of "
+           "Android support this.")
 DEF_SWITCH(SkiaDeterministicRendering,
            "skia-deterministic-rendering",
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
@@ -132,6 +204,17 @@ DEF_SWITCH(TraceSkia,
            "Trace Skia calls. This is useful when debugging the GPU threed."
            "By default, Skia tracing is not enabled to reduce the number of "
            "traced events")
+DEF_SWITCH(TraceSkiaAllowlist,
+           "trace-skia-allowlist",
+           "Only trace the Skia categories that are specified in this comma "
+           "separated list of allowed prefixes, e.g. \"skia.gpu\". Skia calls "
+           "in the other categories are not slowed down by tracing.")
+DEF_SWITCH(EnableTraceRecorder,
+           "enable-trace-recorder",
+           "Record the most recent trace events of the engine in memory, "
+           "independently of the Dart timeline. The recording can be "
+           "collected with the _flutter.getTraceRecording service extension. "
+           "This is cheap enough to be used in release builds.")
 DEF_SWITCH(TraceWhitelist,
            "trace-whitelist",
            "(deprecated) Use --trace-allowlist instead.")
@@ -151,6 +234,20 @@ DEF_SWITCH(CacheSkSL,
            "should only be used during development phases. The generated SkSLs "
            "can later be used in the release build for shader precompilation "
            "at launch in order to eliminate the shader-compile jank.")
+DEF_SWITCH(RecordGlyphUsage,
+           "record-glyph-usage",
+           "Record the typefaces, font sizes and glyphs that text is laid out "
+           "with. The recorded glyphs can be retrieved through the service "
+           "protocol and bundled, so that release builds rasterize them at "
+           "launch instead of when text first uses them. This should only be "
+           "used during development phases.")
+DEF_SWITCH(DeferSkSLWarmUp,
+           "defer-sksl-warm-up",
+           "Precompile the cached and bundled SkSL shaders in portions after "
+           "each frame instead of all of them before the first frame. This "
+           "shortens the time to the first frame at the risk of shader "
+           "compilation jank in the frames rendered before the warm-up "
+           "finishes.")
 DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
@@ -202,6 +299,132 @@ DEF_SWITCH(
 DEF_SWITCH(OldGenHeapSize,
            "old-gen-heap-size",
            "The size limit in megabytes for the Dart VM old gen heap space.")
+DEF_SWITCH(RasterCacheMaxBytes,
+           "raster-cache-max-bytes",
+           "The maximum number of bytes the raster cache may use for its "
+           "images. Defaults to no limit.")
+DEF_SWITCH(FrameStatsCapacity,
+           "frame-stats-capacity",
+           "The number of frames whose layer tree and raster cache statistics "
+           "are kept for the _flutter.getFrameStats service protocol "
+           "extension. Defaults to none.")
+DEF_SWITCH(RasterCacheCompactOpaqueEntries,
+           "raster-cache-compact-opaque-entries",
+           "Store the opaque images of the raster cache rasterized on the CPU "
+           "as RGB565 instead of RGBA8888, halving their memory.")
+DEF_SWITCH(EnableSharedRasterCache,
+           "enable-shared-raster-cache",
+           "Share the raster cache images of identical content between the "
+           "engines of the process.")
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Rasterize the pictures selected for the raster cache on a "
+           "concurrent worker thread instead of the raster thread. The "
+           "pictures are drawn directly until their cached images are ready.")
+DEF_SWITCH(EnableParallelRasterCacheRecording,
+           "enable-parallel-raster-cache-recording",
+           "Record the GPU commands of the pictures rasterized asynchronously "
+           "for the raster cache on concurrent worker threads and replay them "
+           "on the raster thread. Only has an effect along with "
+           "--enable-async-raster-cache.")
+DEF_SWITCH(EnableRasterCachePersistence,
+           "enable-raster-cache-persistence",
+           "Store the most used raster cache images next to the persistent "
+           "shader cache and preload them when the application is launched "
+           "again.")
+DEF_SWITCH(EnableAdaptiveResourceCacheBudget,
+           "enable-adaptive-resource-cache-budget",
+           "Adapt the size of the GPU resource cache to how much of it is in "
+           "use and to low memory warnings.")
+DEF_SWITCH(DeviceMemoryMB,
+           "device-memory-mb",
+           "The physical memory of the device in megabytes. Caps the adaptive "
+           "GPU resource cache budget.")
+DEF_SWITCH(DisableThreadPriorities,
+           "disable-thread-priorities",
+           "Keep the UI, raster and IO threads created by the engine at the "
+           "default priority instead of raising the priority of the UI and "
+           "raster threads.")
+DEF_SWITCH(EnableThreadCpuAffinity,
+           "enable-thread-cpu-affinity",
+           "On CPUs with cores of different speeds, keep the UI and raster "
+           "threads created by the engine on the fastest cores and the IO "
+           "thread on the other ones.")
+DEF_SWITCH(TaskTimerSlackMs,
+           "task-timer-slack-ms",
+           "How late, in milliseconds, the UI and IO task runners may wake up "
+           "for delayed tasks so that nearby ones share a wake up. Frame work "
+           "is never delayed.")
+DEF_SWITCH(EnableParallelPreroll,
+           "enable-parallel-preroll",
+           "Preroll the children of layers with many children in parallel on "
+           "the concurrent worker threads.")
+DEF_SWITCH(EnableLayerCostProfile,
+           "enable-layer-cost-profile",
+           "Time the preroll and paint of each layer and report the costliest "
+           "layers and types of layers as timeline counters and in the "
+           "performance overlay. Disables parallel preroll and tiled paint.")
+DEF_SWITCH(TraceRasterCacheDecisions,
+           "trace-raster-cache-decisions",
+           "Record whether the raster cache reused, rasterized or rejected each "
+           "picture, display list, layer and shadow of each frame, and why. "
+           "The decisions are traced to the timeline and served by the "
+           "_flutter.getRasterCacheDecisions service extension.")
+DEF_SWITCH(ShowRasterCacheHeatmap,
+           "show-raster-cache-heatmap",
+           "Paint the candidates of the raster cache over each frame: green "
+           "when drawn from the cache, red when rasterized during the frame, "
+           "yellow while waiting to be rasterized and blue when rejected.")
+DEF_SWITCH(EnableTiledSoftwarePaint,
+           "enable-tiled-software-paint",
+           "When rendering with the software backend, split each frame into "
+           "tiles painted in parallel on the concurrent worker threads. Frames "
+           "with backdrop filters, textures or the performance overlay are "
+           "still painted on the raster thread.")
+DEF_SWITCH(ParallelImageDecodePixelThreshold,
+           "parallel-image-decode-pixel-threshold",
+           "The number of pixels from which images are decoded in stripes in "
+           "parallel on the concurrent worker threads. Only applies to codecs "
+           "that can skip scanlines, such as JPEG. Defaults to 0, which "
+           "disables parallel decoding.")
+DEF_SWITCH(DecodedImageCacheMaxBytes,
+           "decoded-image-cache-max-bytes",
+           "The maximum number of bytes of decoded images shared between "
+           "images created from the same encoded bytes. Defaults to 0, which "
+           "disables the cache.")
+DEF_SWITCH(AnimatedImageFrameAheadBytes,
+           "animated-image-frame-ahead-bytes",
+           "The maximum number of bytes of frames of each animated image that "
+           "are decoded ahead of playback on the concurrent worker threads. "
+           "Defaults to 0, which decodes each frame when it is requested.")
+DEF_SWITCH(PlatformImageDecodePixelThreshold,
+           "platform-image-decode-pixel-threshold",
+           "The number of pixels from which JPEG and HEIF still images are "
+           "decoded by the image decoder of the platform, when it has one, "
+           "instead of Skia. Defaults to 0, which only uses the platform "
+           "decoder for formats Skia can not decode.")
+DEF_SWITCH(EnableYUVImageUpload,
+           "enable-yuv-image-upload",
+           "Decode JPEGs to YUV planes that are uploaded to the GPU and "
+           "converted to RGB there, instead of decoding them to RGBA.")
+DEF_SWITCH(EnableDisplayList,
+           "enable-display-list",
+           "Record pictures into display lists owned by the engine instead of "
+           "Skia pictures.")
+DEF_SWITCH(DownsampledBlurMinSigma,
+           "downsampled-blur-min-sigma",
+           "The sigma from which blurs applied by image filter and backdrop "
+           "filter layers are evaluated at a reduced resolution. 0 disables "
+           "the downsampling.")
+DEF_SWITCH(DownsampledBlurMaxFactor,
+           "downsampled-blur-max-factor",
+           "The largest factor by which the resolution of downsampled blurs "
+           "is reduced.")
+DEF_SWITCH(EnableSkParagraph,
+           "enable-skparagraph",
+           "Lay out paragraphs with Skia's text layout module instead of "
+           "libtxt. This requires an engine built with the Skia text shaper "
+           "module and is ignored otherwise.")
 
 DEF_SWITCHES_END
 
@@ -6,26 +6,57 @@
 
 namespace flutter {
 
+// Threads created without settings keep the default priority of new threads.
+static Settings DefaultThreadSettings() {
+  Settings settings;
+  settings.ui_thread_priority = fml::Thread::ThreadPriority::kNormal;
+  settings.raster_thread_priority = fml::Thread::ThreadPriority::kNormal;
+  settings.io_thread_priority = fml::Thread::ThreadPriority::kNormal;
+  return settings;
+}
+
 ThreadHost::ThreadHost() = default;
 
 ThreadHost::ThreadHost(ThreadHost&&) = default;
 
 ThreadHost::ThreadHost(std::string name_prefix_arg, uint64_t mask)
+    : ThreadHost(name_prefix_arg, mask, DefaultThreadSettings()) {}
+
+ThreadHost::ThreadHost(std::string name_prefix_arg,
+                       uint64_t mask,
+                       const Settings& settings)
     : name_prefix(name_prefix_arg) {
+  const bool pin = settings.enable_thread_cpu_affinity;
+
   if (mask & ThreadHost::Type::Platform) {
     platform_thread = std::make_unique<fml::Thread>(name_prefix + ".platform");
   }
 
   if (mask & ThreadHost::Type::UI) {
-    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui");
+    ui_thread = std::make_unique<fml::Thread>(
+        settings.thread_launcher,
+        fml::Thread::ThreadConfig(
+            name_prefix + ".ui", settings.ui_thread_priority,
+            pin ? std::optional(fml::CpuAffinity::kPerformance)
+                : std::nullopt));
   }
 
   if (mask & ThreadHost::Type::GPU) {
-    raster_thread = std::make_unique<fml::Thread>(name_prefix + ".raster");
+    raster_thread = std::make_unique<fml::Thread>(
+        settings.thread_launcher,
+        fml::Thread::ThreadConfig(
+            name_prefix + ".raster", settings.raster_thread_priority,
+            pin ? std::optional(fml::CpuAffinity::kPerformance)
+                : std::nullopt));
   }
 
   if (mask & ThreadHost::Type::IO) {
-    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io");
+    io_thread = std::make_unique<fml::Thread>(
+        settings.thread_launcher,
+        fml::Thread::ThreadConfig(
+            name_prefix + ".io", settings.io_thread_priority,
+            pin ? std::optional(fml::CpuAffinity::kNotPerformance)
+                : std::nullopt));
   }
 
   if (mask & ThreadHost::Type::Profiler) {
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/thread.h"
 
@@ -37,6 +38,12 @@ struct ThreadHost {
 
   ThreadHost(std::string name_prefix, uint64_t type_mask);
 
+  /// Creates the threads of |type_mask| with the priorities and CPU affinity
+  /// requested by |settings|.
+  ThreadHost(std::string name_prefix,
+             uint64_t type_mask,
+             const Settings& settings);
+
   ~ThreadHost();
 
   void Reset();
@@ -88,6 +88,26 @@ void VsyncWaiter::ScheduleSecondaryCallback(const fml::closure& callback) {
   AwaitVSync();
 }
 
+void VsyncWaiter::UpdatePresentationFeedback(
+    const PresentationFeedback& feedback) {
+  std::scoped_lock lock(feedback_mutex_);
+  presented_refresh_period_ = feedback.refresh_period;
+}
+
+void VsyncWaiter::SetPreferredFrameRate(double frames_per_second) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (frames_per_second < 0) {
+    frames_per_second = 0;
+  }
+  if (frames_per_second == preferred_frame_rate_) {
+    return;
+  }
+  preferred_frame_rate_ = frames_per_second;
+  OnPreferredFrameRateChanged(frames_per_second);
+}
+
+void VsyncWaiter::OnPreferredFrameRateChanged(double frames_per_second) {}
+
 void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
                                fml::TimePoint frame_target_time) {
   Callback callback;
@@ -99,6 +119,16 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
     secondary_callback = std::move(secondary_callback_);
   }
 
+  {
+    // The presentation engine knows the period the display actually runs at,
+    // which the platform estimate lags behind, for example right after a
+    // refresh rate switch.
+    std::scoped_lock lock(feedback_mutex_);
+    if (presented_refresh_period_ > fml::TimeDelta::Zero()) {
+      frame_target_time = frame_start_time + presented_refresh_period_;
+    }
+  }
+
   if (!callback && !secondary_callback) {
     // This means that the vsync waiter implementation fired a callback for a
     // request we did not make. This is a paranoid check but we still want to
@@ -118,14 +148,17 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
 
     TRACE_FLOW_BEGIN("flutter", kVsyncFlowName, flow_identifier);
 
-    task_runners_.GetUITaskRunner()->PostTaskForTime(
+    // The frame must not wait behind other work queued on the UI thread, such
+    // as a burst of platform message responses.
+    task_runners_.GetUITaskRunner()->PostTaskForTimeWithPriority(
         [callback, flow_identifier, frame_start_time, frame_target_time]() {
           FML_TRACE_EVENT("flutter", kVsyncTraceName, "StartTime",
                           frame_start_time, "TargetTime", frame_target_time);
           callback(frame_start_time, frame_target_time);
           TRACE_FLOW_END("flutter", kVsyncFlowName, flow_identifier);
         },
-        frame_start_time);
+        frame_start_time, fml::TaskPriority::kCritical,
+        fml::TimePoint::Max());
   }
 
   if (secondary_callback) {
@@ -10,6 +10,7 @@
 #include <mutex>
 
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/surface.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace flutter {
@@ -30,6 +31,18 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// See also |PointerDataDispatcher::ScheduleSecondaryVsyncCallback|.
   void ScheduleSecondaryCallback(const fml::closure& callback);
 
+  /// Paces the target times of later frames to the refresh period reported by
+  /// the presentation engine instead of the one estimated by the platform.
+  ///
+  /// See also |Surface::TakePresentationFeedback|.
+  void UpdatePresentationFeedback(const PresentationFeedback& feedback);
+
+  /// Asks the platform to refresh the display at |frames_per_second|, or at
+  /// its default rate when 0. Displays with variable refresh rates can then
+  /// slow down while the UI is idle and speed up for animations. Must be
+  /// called on the UI task runner.
+  void SetPreferredFrameRate(double frames_per_second);
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -49,6 +62,11 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   void FireCallback(fml::TimePoint frame_start_time,
                     fml::TimePoint frame_target_time);
 
+  // Called on the UI task runner when the preferred frame rate changes, see
+  // |SetPreferredFrameRate|. Platforms that can change the refresh rate of the
+  // display override this. The default implementation does nothing.
+  virtual void OnPreferredFrameRateChanged(double frames_per_second);
+
  private:
   std::mutex callback_mutex_;
   Callback callback_;
@@ -56,6 +74,11 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   std::mutex secondary_callback_mutex_;
   fml::closure secondary_callback_;
 
+  std::mutex feedback_mutex_;
+  fml::TimeDelta presented_refresh_period_;
+
+  double preferred_frame_rate_ = 0;
+
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiter);
 };
 
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/gpu/gpu_surface_gl.h"
 
+#include <string>
+
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/logging.h"
@@ -21,6 +23,11 @@
 #define GPU_GL_RGBA8 0x8058
 #define GPU_GL_RGBA4 0x8056
 #define GPU_GL_RGB565 0x8D62
+// From ARB_timer_query and EXT_disjoint_timer_query.
+#define GPU_GL_QUERY_RESULT 0x8866
+#define GPU_GL_QUERY_RESULT_AVAILABLE 0x8867
+#define GPU_GL_TIME_ELAPSED 0x88BF
+#define GPU_GL_GPU_DISJOINT 0x8FBB
 
 namespace flutter {
 
@@ -34,6 +41,18 @@ static const int kGrCacheMaxCount = 8192;
 // system channel.
 static const size_t kGrCacheMaxByteSize = 24 * (1 << 20);
 
+// Maximum number of presented frames whose damage is remembered to compute
+// the stale area of framebuffers that are reused with partial repaint.
+static const size_t kMaxDamageHistory = 4;
+
+// Time spent precompiling deferred SkSLs after each presented frame.
+static constexpr fml::TimeDelta kSkSLWarmUpBudgetPerFrame =
+    fml::TimeDelta::FromMilliseconds(2);
+
+// Maximum number of frames whose GPU time is being measured at once. The
+// queries of older frames are dropped if the GPU falls further behind.
+static const size_t kMaxPendingTimerQueries = 4;
+
 GPUSurfaceGL::GPUSurfaceGL(GPUSurfaceGLDelegate* delegate,
                            bool render_to_surface)
     : delegate_(delegate),
@@ -46,6 +65,40 @@ GPUSurfaceGL::GPUSurfaceGL(GPUSurfaceGLDelegate* delegate,
     return;
   }
 
+  sk_sp<GrDirectContext> context = MakeGLContext(delegate_);
+
+  if (context == nullptr) {
+    FML_LOG(ERROR) << "Failed to setup Skia Gr context.";
+    return;
+  }
+
+  context_ = std::move(context);
+
+  context_owner_ = true;
+
+  valid_ = true;
+
+  SetUpTimerQueries(delegate_->GetGLInterface());
+
+  std::vector<PersistentCache::SkSLCache> caches =
+      PersistentCache::GetCacheForProcess()->LoadSkSLs();
+  if (PersistentCache::defer_sksl_warm_up()) {
+    FML_LOG(INFO) << "Found " << caches.size()
+                  << " SkSL shaders; deferring their precompilation";
+    pending_sksls_ = std::move(caches);
+  } else {
+    TRACE_EVENT1("flutter", "GPUSurfaceGL::PrecompileSkSLs", "count",
+                 std::to_string(caches.size()).c_str());
+    int compiled_count = PrecompileSkSLs(context_.get(), caches);
+    FML_LOG(INFO) << "Found " << caches.size() << " SkSL shaders; precompiled "
+                  << compiled_count;
+  }
+
+  delegate_->GLContextClearCurrent();
+}
+
+sk_sp<GrDirectContext> GPUSurfaceGL::MakeGLContext(
+    GPUSurfaceGLDelegate* delegate) {
   GrContextOptions options;
 
   if (PersistentCache::cache_sksl()) {
@@ -65,31 +118,23 @@ GPUSurfaceGL::GPUSurfaceGL(GPUSurfaceGLDelegate* delegate,
   // A similar work-around is also used in shell/common/io_manager.cc.
   options.fDisableGpuYUVConversion = true;
 
-  auto context = GrDirectContext::MakeGL(delegate_->GetGLInterface(), options);
+  auto context = GrDirectContext::MakeGL(delegate->GetGLInterface(), options);
 
-  if (context == nullptr) {
-    FML_LOG(ERROR) << "Failed to setup Skia Gr context.";
-    return;
+  if (context != nullptr) {
+    context->setResourceCacheLimits(kGrCacheMaxCount, kGrCacheMaxByteSize);
   }
 
-  context_ = std::move(context);
-
-  context_->setResourceCacheLimits(kGrCacheMaxCount, kGrCacheMaxByteSize);
-
-  context_owner_ = true;
-
-  valid_ = true;
+  return context;
+}
 
-  std::vector<PersistentCache::SkSLCache> caches =
-      PersistentCache::GetCacheForProcess()->LoadSkSLs();
+int GPUSurfaceGL::PrecompileSkSLs(
+    GrDirectContext* context,
+    const std::vector<PersistentCache::SkSLCache>& caches) {
   int compiled_count = 0;
   for (const auto& cache : caches) {
-    compiled_count += context_->precompileShader(*cache.first, *cache.second);
+    compiled_count += context->precompileShader(*cache.first, *cache.second);
   }
-  FML_LOG(INFO) << "Found " << caches.size() << " SkSL shaders; precompiled "
-                << compiled_count;
-
-  delegate_->GLContextClearCurrent();
+  return compiled_count;
 }
 
 GPUSurfaceGL::GPUSurfaceGL(sk_sp<GrDirectContext> gr_context,
@@ -106,6 +151,8 @@ GPUSurfaceGL::GPUSurfaceGL(sk_sp<GrDirectContext> gr_context,
     return;
   }
 
+  SetUpTimerQueries(delegate_->GetGLInterface());
+
   delegate_->GLContextClearCurrent();
 
   valid_ = true;
@@ -123,6 +170,7 @@ GPUSurfaceGL::~GPUSurfaceGL() {
     return;
   }
 
+  DeleteTimerQueries();
   onscreen_surface_ = nullptr;
   fbo_id_ = 0;
   if (context_owner_) {
@@ -195,6 +243,7 @@ bool GPUSurfaceGL::CreateOrUpdateSurfaces(const SkISize& size) {
   // Either way, we need to get rid of previous surface.
   onscreen_surface_ = nullptr;
   fbo_id_ = 0;
+  damage_history_.clear();
 
   if (size.isEmpty()) {
     FML_LOG(ERROR) << "Cannot create surfaces of empty size.";
@@ -260,18 +309,44 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGL::AcquireFrame(const SkISize& size) {
   }
 
   surface->getCanvas()->setMatrix(root_surface_transformation);
+  BeginTimerQuery();
   SurfaceFrame::SubmitCallback submit_callback =
       [weak = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
                                           SkCanvas* canvas) {
-        return weak ? weak->PresentSurface(canvas) : false;
+        return weak ? weak->PresentSurface(surface_frame, canvas) : false;
       };
 
-  return std::make_unique<SurfaceFrame>(
+  auto frame = std::make_unique<SurfaceFrame>(
       surface, delegate_->SurfaceSupportsReadback(), submit_callback,
       std::move(context_switch));
+
+  if (delegate_->GLContextSupportsPartialRepaint()) {
+    SurfaceFrame::FramebufferInfo framebuffer_info;
+    framebuffer_info.supports_partial_repaint = true;
+    framebuffer_info.existing_damage =
+        GetExistingDamage(delegate_->GLContextBufferAge());
+    frame->set_framebuffer_info(framebuffer_info);
+  }
+
+  return frame;
+}
+
+std::optional<SkIRect> GPUSurfaceGL::GetExistingDamage(
+    uint32_t buffer_age) const {
+  // A framebuffer of age N holds the frame presented N frames ago, so it is
+  // missing the damage of the last N - 1 presented frames.
+  if (buffer_age == 0 || buffer_age - 1 > damage_history_.size()) {
+    return std::nullopt;
+  }
+  SkIRect existing_damage = SkIRect::MakeEmpty();
+  for (size_t i = damage_history_.size() - (buffer_age - 1);
+       i < damage_history_.size(); i++) {
+    existing_damage.join(damage_history_[i]);
+  }
+  return existing_damage;
 }
 
-bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
+bool GPUSurfaceGL::PresentSurface(const SurfaceFrame& frame, SkCanvas* canvas) {
   if (delegate_ == nullptr || canvas == nullptr || context_ == nullptr) {
     return false;
   }
@@ -281,10 +356,24 @@ bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
     onscreen_surface_->getCanvas()->flush();
   }
 
-  if (!delegate_->GLContextPresent(fbo_id_)) {
+  EndTimerQuery();
+
+  const SurfaceFrame::SubmitInfo& submit_info = frame.submit_info();
+  GLPresentInfo present_info = {
+      fbo_id_,                    // fbo_id
+      submit_info.frame_damage,   // frame_damage
+      submit_info.buffer_damage,  // buffer_damage
+  };
+  if (!delegate_->GLContextPresentWithInfo(present_info)) {
     return false;
   }
 
+  damage_history_.push_back(submit_info.frame_damage.value_or(
+      SkIRect::MakeWH(onscreen_surface_->width(), onscreen_surface_->height())));
+  if (damage_history_.size() > kMaxDamageHistory) {
+    damage_history_.pop_front();
+  }
+
   if (delegate_->GLContextFBOResetAfterPresent()) {
     auto current_size =
         SkISize::Make(onscreen_surface_->width(), onscreen_surface_->height());
@@ -309,9 +398,131 @@ bool GPUSurfaceGL::PresentSurface(SkCanvas* canvas) {
     fbo_id_ = fbo_id;
   }
 
+  PrecompilePendingSkSLs(kSkSLWarmUpBudgetPerFrame);
+  CollectTimerQueries();
+
   return true;
 }
 
+void GPUSurfaceGL::PrecompilePendingSkSLs(fml::TimeDelta budget) {
+  if (pending_sksls_.empty()) {
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "GPUSurfaceGL::PrecompilePendingSkSLs");
+  const fml::TimePoint deadline = fml::TimePoint::Now() + budget;
+  // Always make progress, even if a single shader exceeds the budget.
+  do {
+    const auto& cache = pending_sksls_[precompiled_sksl_count_++];
+    context_->precompileShader(*cache.first, *cache.second);
+  } while (precompiled_sksl_count_ < pending_sksls_.size() &&
+           fml::TimePoint::Now() < deadline);
+
+  FML_TRACE_COUNTER("flutter", "SkSLWarmUp", reinterpret_cast<int64_t>(this),
+                    "Precompiled", precompiled_sksl_count_, "Remaining",
+                    pending_sksls_.size() - precompiled_sksl_count_);
+
+  if (precompiled_sksl_count_ == pending_sksls_.size()) {
+    FML_LOG(INFO) << "Finished the deferred precompilation of "
+                  << precompiled_sksl_count_ << " SkSL shaders";
+    pending_sksls_.clear();
+    pending_sksls_.shrink_to_fit();
+  }
+}
+
+void GPUSurfaceGL::SetUpTimerQueries(sk_sp<const GrGLInterface> interface) {
+  if (!interface) {
+    return;
+  }
+  const bool has_extension =
+      interface->hasExtension("GL_EXT_disjoint_timer_query") ||
+      interface->hasExtension("GL_ARB_timer_query") ||
+      interface->hasExtension("GL_EXT_timer_query");
+  const auto& gl = interface->fFunctions;
+  if (!has_extension || !gl.fGenQueries || !gl.fDeleteQueries ||
+      !gl.fBeginQuery || !gl.fEndQuery || !gl.fGetQueryObjectuiv ||
+      !gl.fGetQueryObjectui64v) {
+    FML_DLOG(INFO) << "GPU timer queries are not supported by the driver.";
+    return;
+  }
+  timer_query_interface_ = std::move(interface);
+}
+
+void GPUSurfaceGL::BeginTimerQuery() {
+  // A frame that was acquired but never presented leaves its query running,
+  // in which case its GPU time is added to the time of the next frame.
+  if (!timer_query_interface_ || current_timer_query_ != 0) {
+    return;
+  }
+  const auto& gl = timer_query_interface_->fFunctions;
+  gl.fGenQueries(1, &current_timer_query_);
+  gl.fBeginQuery(GPU_GL_TIME_ELAPSED, current_timer_query_);
+}
+
+void GPUSurfaceGL::EndTimerQuery() {
+  if (current_timer_query_ == 0) {
+    return;
+  }
+  const auto& gl = timer_query_interface_->fFunctions;
+  gl.fEndQuery(GPU_GL_TIME_ELAPSED);
+  pending_timer_queries_.push_back(current_timer_query_);
+  current_timer_query_ = 0;
+  if (pending_timer_queries_.size() > kMaxPendingTimerQueries) {
+    gl.fDeleteQueries(1, &pending_timer_queries_.front());
+    pending_timer_queries_.pop_front();
+  }
+}
+
+void GPUSurfaceGL::CollectTimerQueries() {
+  if (!timer_query_interface_ || pending_timer_queries_.empty()) {
+    return;
+  }
+  const auto& gl = timer_query_interface_->fFunctions;
+
+  // Results that straddle a disjoint operation, like a change of the GPU
+  // frequency, are meaningless. Reading the flag also resets it.
+  GrGLint disjoint = 0;
+  if (timer_query_interface_->hasExtension("GL_EXT_disjoint_timer_query")) {
+    gl.fGetIntegerv(GPU_GL_GPU_DISJOINT, &disjoint);
+  }
+
+  while (!pending_timer_queries_.empty()) {
+    const GrGLuint query = pending_timer_queries_.front();
+    GrGLuint available = 0;
+    gl.fGetQueryObjectuiv(query, GPU_GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+      break;
+    }
+    GrGLuint64 elapsed_nanos = 0;
+    gl.fGetQueryObjectui64v(query, GPU_GL_QUERY_RESULT, &elapsed_nanos);
+    gl.fDeleteQueries(1, &query);
+    pending_timer_queries_.pop_front();
+    if (!disjoint) {
+      const auto elapsed = fml::TimeDelta::FromNanoseconds(elapsed_nanos);
+      FML_TRACE_COUNTER("flutter", "GPUFrameTime",
+                        reinterpret_cast<int64_t>(this), "Microseconds",
+                        elapsed.ToMicroseconds());
+      gpu_frame_times_.push_back(elapsed);
+    }
+  }
+}
+
+void GPUSurfaceGL::DeleteTimerQueries() {
+  if (!timer_query_interface_) {
+    return;
+  }
+  const auto& gl = timer_query_interface_->fFunctions;
+  if (current_timer_query_ != 0) {
+    gl.fEndQuery(GPU_GL_TIME_ELAPSED);
+    pending_timer_queries_.push_back(current_timer_query_);
+    current_timer_query_ = 0;
+  }
+  for (GrGLuint query : pending_timer_queries_) {
+    gl.fDeleteQueries(1, &query);
+  }
+  pending_timer_queries_.clear();
+}
+
 sk_sp<SkSurface> GPUSurfaceGL::AcquireRenderSurface(
     const SkISize& untransformed_size,
     const SkMatrix& root_surface_transformation) {
@@ -343,4 +554,11 @@ bool GPUSurfaceGL::ClearRenderContext() {
   return delegate_->GLContextClearCurrent();
 }
 
+// |Surface|
+std::vector<fml::TimeDelta> GPUSurfaceGL::TakeGPUFrameTimes() {
+  std::vector<fml::TimeDelta> gpu_frame_times;
+  gpu_frame_times.swap(gpu_frame_times_);
+  return gpu_frame_times;
+}
+
 }  // namespace flutter
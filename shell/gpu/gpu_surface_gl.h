@@ -5,16 +5,21 @@
 #ifndef SHELL_GPU_GPU_SURFACE_GL_H_
 #define SHELL_GPU_GPU_SURFACE_GL_H_
 
+#include <deque>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
 namespace flutter {
 
@@ -27,6 +32,18 @@ class GPUSurfaceGL : public Surface {
                GPUSurfaceGLDelegate* delegate,
                bool render_to_surface);
 
+  // Creates a GrDirectContext configured like the ones the surfaces create
+  // for themselves. The GL context of |delegate| must be current. Platforms
+  // use this to create the context before they have a surface to render to,
+  // and hand it to the surface once they do.
+  static sk_sp<GrDirectContext> MakeGLContext(GPUSurfaceGLDelegate* delegate);
+
+  // Precompiles |caches| on |context|, whose GL context must be current.
+  // Returns the number of shaders that were compiled.
+  static int PrecompileSkSLs(
+      GrDirectContext* context,
+      const std::vector<PersistentCache::SkSLCache>& caches);
+
   // |Surface|
   ~GPUSurfaceGL() override;
 
@@ -48,6 +65,9 @@ class GPUSurfaceGL : public Surface {
   // |Surface|
   bool ClearRenderContext() override;
 
+  // |Surface|
+  std::vector<fml::TimeDelta> TakeGPUFrameTimes() override;
+
  private:
   GPUSurfaceGLDelegate* delegate_;
   sk_sp<GrDirectContext> context_;
@@ -61,6 +81,23 @@ class GPUSurfaceGL : public Surface {
   // external view embedder is present.
   const bool render_to_surface_;
   bool valid_ = false;
+  // The frame damage of the most recently presented frames, oldest first.
+  std::deque<SkIRect> damage_history_;
+  // SkSLs whose precompilation is spread over the frames after the first one
+  // when |PersistentCache::defer_sksl_warm_up| is set.
+  std::vector<PersistentCache::SkSLCache> pending_sksls_;
+  size_t precompiled_sksl_count_ = 0;
+  // The interface used for the timer queries measuring the GPU time of the
+  // frames. Null when the driver does not support timer queries.
+  sk_sp<const GrGLInterface> timer_query_interface_;
+  // The query measuring the frame being drawn, or 0 if there is none.
+  GrGLuint current_timer_query_ = 0;
+  // The queries of the presented frames whose results are not available yet,
+  // oldest first.
+  std::deque<GrGLuint> pending_timer_queries_;
+  // The GPU time of the frames whose queries completed since the last call to
+  // |TakeGPUFrameTimes|.
+  std::vector<fml::TimeDelta> gpu_frame_times_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceGL> weak_factory_;
 
   bool CreateOrUpdateSurfaces(const SkISize& size);
@@ -69,7 +106,30 @@ class GPUSurfaceGL : public Surface {
       const SkISize& untransformed_size,
       const SkMatrix& root_surface_transformation);
 
-  bool PresentSurface(SkCanvas* canvas);
+  std::optional<SkIRect> GetExistingDamage(uint32_t buffer_age) const;
+
+  bool PresentSurface(const SurfaceFrame& frame, SkCanvas* canvas);
+
+  // Precompiles pending SkSLs until the budget is used up. The GL context must
+  // be current.
+  void PrecompilePendingSkSLs(fml::TimeDelta budget);
+
+  // The following methods must be called with the GL context current.
+
+  // Uses |interface| for timer queries if the driver supports them.
+  void SetUpTimerQueries(sk_sp<const GrGLInterface> interface);
+
+  // Starts measuring the GPU time of the frame about to be drawn.
+  void BeginTimerQuery();
+
+  // Stops measuring the frame that was just flushed.
+  void EndTimerQuery();
+
+  // Moves the results of the pending queries that completed to
+  // |gpu_frame_times_| without waiting for the others.
+  void CollectTimerQueries();
+
+  void DeleteTimerQueries();
 
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceGL);
 };
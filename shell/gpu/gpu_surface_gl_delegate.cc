@@ -12,6 +12,19 @@ namespace flutter {
 
 GPUSurfaceGLDelegate::~GPUSurfaceGLDelegate() = default;
 
+bool GPUSurfaceGLDelegate::GLContextPresentWithInfo(
+    const GLPresentInfo& present_info) {
+  return GLContextPresent(present_info.fbo_id);
+}
+
+bool GPUSurfaceGLDelegate::GLContextSupportsPartialRepaint() const {
+  return false;
+}
+
+uint32_t GPUSurfaceGLDelegate::GLContextBufferAge() const {
+  return 0;
+}
+
 bool GPUSurfaceGLDelegate::GLContextFBOResetAfterPresent() const {
   return false;
 }
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 
+#include <optional>
+
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
 namespace flutter {
@@ -20,6 +23,22 @@ struct GLFrameInfo {
   uint32_t height;
 };
 
+// A structure to represent the information which is passed to the embedder
+// when presenting the main GL surface.
+struct GLPresentInfo {
+  uint32_t fbo_id;
+
+  // The area of the frame that changed since the previously presented frame,
+  // in surface coordinates with a top-left origin. If std::nullopt, the whole
+  // frame changed.
+  std::optional<SkIRect> frame_damage;
+
+  // The area of the framebuffer that was repainted, in surface coordinates
+  // with a top-left origin. If std::nullopt, the whole framebuffer was
+  // repainted.
+  std::optional<SkIRect> buffer_damage;
+};
+
 class GPUSurfaceGLDelegate {
  public:
   ~GPUSurfaceGLDelegate();
@@ -35,6 +54,23 @@ class GPUSurfaceGLDelegate {
   // context and not any of the contexts dedicated for IO.
   virtual bool GLContextPresent(uint32_t fbo_id) = 0;
 
+  // Called to present the main GL surface along with the damage of the frame.
+  // Delegates that are able to make use of the damage (for example with
+  // eglSwapBuffersWithDamageKHR) should override this method. The default
+  // implementation calls |GLContextPresent|.
+  virtual bool GLContextPresentWithInfo(const GLPresentInfo& present_info);
+
+  // Whether the main window bound framebuffer may be presented with only part
+  // of its contents repainted. If true, |GLContextBufferAge| must report the
+  // age of the framebuffer contents.
+  virtual bool GLContextSupportsPartialRepaint() const;
+
+  // The age of the contents of the framebuffer the next frame will be
+  // rendered into, in frames (see EGL_EXT_buffer_age). An age of 1 means the
+  // framebuffer contains the previously presented frame. An age of 0 means
+  // the contents are undefined.
+  virtual uint32_t GLContextBufferAge() const;
+
   // The ID of the main window bound framebuffer. Typically FBO0.
   virtual intptr_t GLContextFBO(GLFrameInfo frame_info) const = 0;
 
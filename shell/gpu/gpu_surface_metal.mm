@@ -61,6 +61,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrame(const SkISize& frame
   // the raster thread, there is no such transaction.
   layer_.get().presentsWithTransaction = [[NSThread currentThread] isMainThread];
 
+  // The drawable is not acquired here. Skia wraps the layer in a lazy render target that only calls
+  // nextDrawable when the canvas is flushed, so the frame is recorded without waiting for the
+  // drawable pool and the raster thread only blocks, if at all, right before the GPU work is
+  // submitted.
   auto surface = SkSurface::MakeFromCAMetalLayer(context_.get(),            // context
                                                  layer_.get(),              // layer
                                                  kTopLeft_GrSurfaceOrigin,  // origin
@@ -97,9 +101,18 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetal::AcquireFrame(const SkISize& frame
         reinterpret_cast<id<CAMetalDrawable>>(next_drawable_));
     next_drawable_ = nullptr;
 
-    [command_buffer.get() commit];
-    [command_buffer.get() waitUntilScheduled];
-    [drawable.get() present];
+    if (layer_.get().presentsWithTransaction) {
+      // The drawable must be presented in the current transaction, after the GPU work has been
+      // scheduled.
+      [command_buffer.get() commit];
+      [command_buffer.get() waitUntilScheduled];
+      [drawable.get() present];
+    } else {
+      // Let Metal present the drawable once its work is scheduled instead of blocking the raster
+      // thread until then.
+      [command_buffer.get() presentDrawable:drawable.get()];
+      [command_buffer.get() commit];
+    }
 
     return true;
   };
@@ -9,6 +9,10 @@
 
 namespace flutter {
 
+// The number of presented frames whose damage is remembered, which bounds the
+// age of the backing stores that can be partially repainted.
+static const size_t kMaxDamageHistory = 4;
+
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
                                        bool render_to_surface)
     : delegate_(delegate),
@@ -66,10 +70,52 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->flush();
 
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
+    const SurfaceFrame::SubmitInfo& submit_info = surface_frame.submit_info();
+    const SoftwarePresentInfo present_info = {
+        submit_info.frame_damage,   // frame_damage
+        submit_info.buffer_damage,  // buffer_damage
+    };
+    sk_sp<SkSurface> backing_store = surface_frame.SkiaSurface();
+    if (!self->delegate_->PresentBackingStoreWithInfo(backing_store,
+                                                      present_info)) {
+      return false;
+    }
+
+    self->damage_history_.push_back(submit_info.frame_damage.value_or(
+        SkIRect::MakeWH(backing_store->width(), backing_store->height())));
+    if (self->damage_history_.size() > kMaxDamageHistory) {
+      self->damage_history_.pop_front();
+    }
+    return true;
   };
 
-  return std::make_unique<SurfaceFrame>(backing_store, true, on_submit);
+  auto frame = std::make_unique<SurfaceFrame>(backing_store, true, on_submit);
+
+  if (delegate_->SupportsPartialRepaint()) {
+    SurfaceFrame::FramebufferInfo framebuffer_info;
+    framebuffer_info.supports_partial_repaint = true;
+    framebuffer_info.existing_damage =
+        GetExistingDamage(delegate_->BackingStoreAge());
+    frame->set_framebuffer_info(framebuffer_info);
+  }
+
+  return frame;
+}
+
+std::optional<SkIRect> GPUSurfaceSoftware::GetExistingDamage(
+    uint32_t backing_store_age) const {
+  // A backing store of age N holds the frame presented N frames ago, so it is
+  // missing the damage of the last N - 1 presented frames.
+  if (backing_store_age == 0 ||
+      backing_store_age - 1 > damage_history_.size()) {
+    return std::nullopt;
+  }
+  SkIRect existing_damage = SkIRect::MakeEmpty();
+  for (size_t i = damage_history_.size() - (backing_store_age - 1);
+       i < damage_history_.size(); i++) {
+    existing_damage.join(damage_history_[i]);
+  }
+  return existing_damage;
 }
 
 // |Surface|
@@ -8,4 +8,18 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreWithInfo(
+    sk_sp<SkSurface> backing_store,
+    const SoftwarePresentInfo& present_info) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
+bool GPUSurfaceSoftwareDelegate::SupportsPartialRepaint() const {
+  return false;
+}
+
+uint32_t GPUSurfaceSoftwareDelegate::BackingStoreAge() const {
+  return 0;
+}
+
 }  // namespace flutter
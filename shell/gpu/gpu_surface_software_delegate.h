@@ -5,12 +5,28 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <optional>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
+// The information passed to the platform along with a software backing store
+// when it is presented.
+struct SoftwarePresentInfo {
+  // The area of the frame that changed since the previously presented frame,
+  // in surface coordinates with a top-left origin. If std::nullopt, the whole
+  // frame changed.
+  std::optional<SkIRect> frame_damage;
+
+  // The area of the backing store that was repainted, in surface coordinates
+  // with a top-left origin. If std::nullopt, the whole backing store was
+  // repainted.
+  std::optional<SkIRect> buffer_damage;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      Interface implemented by all platform surfaces that can present
 ///             a software backing store to the "screen". The GPU surface
@@ -48,6 +64,31 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the backing store along with the area of the frame
+  ///             that changed. Defaults to |PresentBackingStore|.
+  ///
+  virtual bool PresentBackingStoreWithInfo(
+      sk_sp<SkSurface> backing_store,
+      const SoftwarePresentInfo& present_info);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether backing stores may be presented with only part of
+  ///             their contents repainted. If true, |BackingStoreAge| must
+  ///             report the age of each acquired backing store. Defaults to
+  ///             false.
+  ///
+  virtual bool SupportsPartialRepaint() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The age of the contents of the backing store last returned
+  ///             by |AcquireBackingStore|, as defined by `EGL_EXT_buffer_age`:
+  ///             1 if it holds the previously presented frame, N if it holds
+  ///             the frame presented N frames ago and 0 if its contents are
+  ///             undefined. Defaults to 0.
+  ///
+  virtual uint32_t BackingStoreAge() const;
 };
 
 }  // namespace flutter
@@ -8,15 +8,32 @@
 
 namespace flutter {
 
+// Skia only writes the pipeline cache to the persistent cache when asked to.
+// Besides on teardown, it is stored every so often in case the process is
+// killed while the surface is still alive.
+static constexpr size_t kPipelineCacheStoreFrameInterval = 1800;
+
 GPUSurfaceVulkan::GPUSurfaceVulkan(
     GPUSurfaceVulkanDelegate* delegate,
     std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
-    bool render_to_surface)
-    : window_(delegate->vk(), std::move(native_surface), render_to_surface),
+    bool render_to_surface,
+    const vulkan::VulkanSwapchainConfig& swapchain_config)
+    : persistent_cache_(std::make_unique<GPUSurfaceVulkanPersistentCache>()),
+      window_(delegate->vk(),
+              std::move(native_surface),
+              render_to_surface,
+              swapchain_config,
+              persistent_cache_.get()),
       render_to_surface_(render_to_surface),
-      weak_factory_(this) {}
+      weak_factory_(this) {
+  // Skia loads the pipeline cache when it creates its first pipeline, which
+  // happens no earlier than the first frame.
+  persistent_cache_->SetPipelineCacheUUID(window_.GetPipelineCacheUUID());
+}
 
-GPUSurfaceVulkan::~GPUSurfaceVulkan() = default;
+GPUSurfaceVulkan::~GPUSurfaceVulkan() {
+  window_.StorePipelineCacheData();
+}
 
 bool GPUSurfaceVulkan::IsValid() {
   return window_.IsValid();
@@ -48,6 +65,11 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkan::AcquireFrame(
     if (canvas == nullptr || !weak_this) {
       return false;
     }
+    if (++weak_this->frames_since_pipeline_cache_stored_ >=
+        kPipelineCacheStoreFrameInterval) {
+      weak_this->frames_since_pipeline_cache_stored_ = 0;
+      weak_this->window_.StorePipelineCacheData();
+    }
     return weak_this->window_.SwapBuffers();
   };
   return std::make_unique<SurfaceFrame>(std::move(surface), true,
@@ -66,4 +88,20 @@ GrDirectContext* GPUSurfaceVulkan::GetContext() {
   return window_.GetSkiaGrContext();
 }
 
+std::optional<PresentationFeedback>
+GPUSurfaceVulkan::TakePresentationFeedback() {
+  vulkan::VulkanPresentationFeedback feedback;
+  if (!window_.TakePresentationFeedback(&feedback)) {
+    return std::nullopt;
+  }
+
+  return PresentationFeedback{
+      .refresh_period = fml::TimeDelta::FromNanoseconds(
+          static_cast<int64_t>(feedback.refresh_duration_ns)),
+      .present_margin = fml::TimeDelta::FromNanoseconds(
+          static_cast<int64_t>(feedback.present_margin_ns)),
+      .late_frames = feedback.late_presents,
+  };
+}
+
 }  // namespace flutter
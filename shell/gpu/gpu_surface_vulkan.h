@@ -11,6 +11,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
+#include "flutter/shell/gpu/gpu_surface_vulkan_persistent_cache.h"
 #include "flutter/vulkan/vulkan_native_surface.h"
 #include "flutter/vulkan/vulkan_window.h"
 
@@ -20,7 +21,8 @@ class GPUSurfaceVulkan : public Surface {
  public:
   GPUSurfaceVulkan(GPUSurfaceVulkanDelegate* delegate,
                    std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
-                   bool render_to_surface);
+                   bool render_to_surface,
+                   const vulkan::VulkanSwapchainConfig& swapchain_config = {});
 
   ~GPUSurfaceVulkan() override;
 
@@ -36,9 +38,15 @@ class GPUSurfaceVulkan : public Surface {
   // |Surface|
   GrDirectContext* GetContext() override;
 
+  // |Surface|
+  std::optional<PresentationFeedback> TakePresentationFeedback() override;
+
  private:
+  // The persistent cache must outlive the Skia context of the window.
+  std::unique_ptr<GPUSurfaceVulkanPersistentCache> persistent_cache_;
   vulkan::VulkanWindow window_;
   const bool render_to_surface_;
+  size_t frames_since_pipeline_cache_stored_ = 0;
 
   fml::WeakPtrFactory<GPUSurfaceVulkan> weak_factory_;
 
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/gpu/gpu_surface_vulkan_persistent_cache.h"
+
+#include <cstring>
+#include <utility>
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// The key under which Skia loads and stores the pipeline cache of a Vulkan
+// context. See |GrVkGpu::kPipelineCache_PersistentCacheKeyType|.
+static constexpr uint32_t kSkiaPipelineCacheKey = 1;
+
+static bool IsPipelineCacheKey(const SkData& key) {
+  if (key.size() != sizeof(kSkiaPipelineCacheKey)) {
+    return false;
+  }
+  uint32_t value = 0;
+  memcpy(&value, key.data(), sizeof(value));
+  return value == kSkiaPipelineCacheKey;
+}
+
+// Skia stores Vulkan shaders as SPIR-V, which must not end up among the SkSLs
+// that are precompiled on the next launch.
+static GrContextOptions::PersistentCache* GetShaderCache() {
+  if (PersistentCache::cache_sksl()) {
+    return nullptr;
+  }
+  return PersistentCache::GetCacheForProcess();
+}
+
+GPUSurfaceVulkanPersistentCache::GPUSurfaceVulkanPersistentCache() = default;
+
+GPUSurfaceVulkanPersistentCache::~GPUSurfaceVulkanPersistentCache() = default;
+
+void GPUSurfaceVulkanPersistentCache::SetPipelineCacheUUID(
+    std::string pipeline_cache_uuid) {
+  pipeline_cache_uuid_ = std::move(pipeline_cache_uuid);
+}
+
+// |GrContextOptions::PersistentCache|
+sk_sp<SkData> GPUSurfaceVulkanPersistentCache::load(const SkData& key) {
+  if (!IsPipelineCacheKey(key)) {
+    auto shader_cache = GetShaderCache();
+    return shader_cache ? shader_cache->load(key) : nullptr;
+  }
+
+  TRACE_EVENT0("flutter", "LoadVulkanPipelineCache");
+  last_pipeline_cache_ =
+      PersistentCache::GetCacheForProcess()->LoadVulkanPipelineCache(
+          pipeline_cache_uuid_);
+  return last_pipeline_cache_;
+}
+
+// |GrContextOptions::PersistentCache|
+void GPUSurfaceVulkanPersistentCache::store(const SkData& key,
+                                            const SkData& data) {
+  if (!IsPipelineCacheKey(key)) {
+    if (auto shader_cache = GetShaderCache()) {
+      shader_cache->store(key, data);
+    }
+    return;
+  }
+
+  if (last_pipeline_cache_ && last_pipeline_cache_->equals(&data)) {
+    return;
+  }
+
+  last_pipeline_cache_ = SkData::MakeWithCopy(data.data(), data.size());
+  PersistentCache::GetCacheForProcess()->StoreVulkanPipelineCache(
+      pipeline_cache_uuid_, last_pipeline_cache_);
+}
+
+}  // namespace flutter
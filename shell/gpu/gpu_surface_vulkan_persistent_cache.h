@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_GPU_GPU_SURFACE_VULKAN_PERSISTENT_CACHE_H_
+#define SHELL_GPU_GPU_SURFACE_VULKAN_PERSISTENT_CACHE_H_
+
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/gpu/GrContextOptions.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The persistent cache of the Skia context of a Vulkan surface.
+///
+///             Skia stores the `VkPipelineCache` of its context under a fixed
+///             key, but the data is only valid for the device and driver that
+///             wrote it. So the pipeline cache is kept apart from the shaders,
+///             keyed on the pipeline cache UUID of the device. Shaders are
+///             forwarded to the `PersistentCache` of the process.
+///
+class GPUSurfaceVulkanPersistentCache
+    : public GrContextOptions::PersistentCache {
+ public:
+  GPUSurfaceVulkanPersistentCache();
+
+  ~GPUSurfaceVulkanPersistentCache() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the pipeline cache UUID of the device of the context.
+  ///             Must be called before Skia creates its first pipeline, which
+  ///             is when it loads the pipeline cache.
+  ///
+  void SetPipelineCacheUUID(std::string pipeline_cache_uuid);
+
+  // |GrContextOptions::PersistentCache|
+  sk_sp<SkData> load(const SkData& key) override;
+
+  // |GrContextOptions::PersistentCache|
+  void store(const SkData& key, const SkData& data) override;
+
+ private:
+  std::string pipeline_cache_uuid_;
+  // The pipeline cache as last loaded or stored. Skia stores the whole
+  // pipeline cache every time it is asked to, so unchanged data is skipped.
+  sk_sp<SkData> last_pipeline_cache_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceVulkanPersistentCache);
+};
+
+}  // namespace flutter
+
+#endif  // SHELL_GPU_GPU_SURFACE_VULKAN_PERSISTENT_CACHE_H_
@@ -93,6 +93,15 @@ class AndroidContextGL : public AndroidContext {
   ///
   std::unique_ptr<AndroidEGLSurface> CreateOffscreenSurface() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates an 1x1 pbuffer surface for the onscreen context,
+  ///             that is used for making the onscreen context current before
+  ///             there is a window to create its window surface for.
+  ///
+  /// @return     The pbuffer surface.
+  ///
+  std::unique_ptr<AndroidEGLSurface> CreateOnscreenPbufferSurface() const;
+
   //----------------------------------------------------------------------------
   /// @return     The Android environment that contains a reference to the
   /// display.
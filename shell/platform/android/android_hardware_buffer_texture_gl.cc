@@ -0,0 +1,389 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_hardware_buffer_texture_gl.h"
+
+#include <GLES/glext.h>
+#include <poll.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLTypes.h"
+
+struct AHardwareBuffer;
+
+namespace flutter {
+
+namespace {
+
+// AIMAGE_FORMAT_PRIVATE, which lets the producer pick the layout the GPU
+// samples best, like YUV for video.
+constexpr int32_t kImageFormatPrivate = 0x22;
+// AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE.
+constexpr uint64_t kUsageGPUSampledImage = 1ull << 8;
+// One image bound to the texture, one queued and one being produced.
+constexpr int32_t kMaxImages = 3;
+// AMEDIA_OK.
+constexpr int32_t kMediaOk = 0;
+
+// Has the layout of AImageReader_ImageListener.
+struct ImageListener {
+  void* context;
+  void (*on_image_available)(void* context, AImageReader* reader);
+};
+
+// The image reader functions of the NDK and the EGL extension functions. The
+// NDK functions are only available from API level 26, so they are resolved
+// when first used rather than linked.
+struct Procs {
+  int32_t (*AImageReader_newWithUsage)(int32_t width,
+                                       int32_t height,
+                                       int32_t format,
+                                       uint64_t usage,
+                                       int32_t max_images,
+                                       AImageReader** reader);
+  void (*AImageReader_delete)(AImageReader* reader);
+  int32_t (*AImageReader_getWindow)(AImageReader* reader,
+                                    ANativeWindow** window);
+  int32_t (*AImageReader_setImageListener)(AImageReader* reader,
+                                           ImageListener* listener);
+  int32_t (*AImageReader_acquireLatestImageAsync)(AImageReader* reader,
+                                                  AImage** image,
+                                                  int* acquire_fence_fd);
+  void (*AImage_deleteAsync)(AImage* image, int release_fence_fd);
+  int32_t (*AImage_getHardwareBuffer)(const AImage* image,
+                                      AHardwareBuffer** buffer);
+  int32_t (*AImage_getWidth)(const AImage* image, int32_t* width);
+  int32_t (*AImage_getHeight)(const AImage* image, int32_t* height);
+  jobject (*ANativeWindow_toSurface)(JNIEnv* env, ANativeWindow* window);
+
+  PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC eglGetNativeClientBufferANDROID;
+  PFNEGLCREATEIMAGEKHRPROC eglCreateImageKHR;
+  PFNEGLDESTROYIMAGEKHRPROC eglDestroyImageKHR;
+  PFNEGLCREATESYNCKHRPROC eglCreateSyncKHR;
+  PFNEGLDESTROYSYNCKHRPROC eglDestroySyncKHR;
+  PFNEGLWAITSYNCKHRPROC eglWaitSyncKHR;
+  PFNEGLDUPNATIVEFENCEFDANDROIDPROC eglDupNativeFenceFDANDROID;
+  PFNGLEGLIMAGETARGETTEXTURE2DOESPROC glEGLImageTargetTexture2DOES;
+
+  bool valid = false;
+};
+
+template <typename T>
+bool Resolve(const fml::RefPtr<fml::NativeLibrary>& library,
+             const char* name,
+             T& proc) {
+  proc = reinterpret_cast<T>(library->ResolveSymbol(name));
+  return proc != nullptr;
+}
+
+template <typename T>
+bool Resolve(const char* name, T& proc) {
+  proc = reinterpret_cast<T>(eglGetProcAddress(name));
+  return proc != nullptr;
+}
+
+const Procs& GetProcs() {
+  static const Procs procs = []() {
+    Procs procs = {};
+    // The libraries are never unloaded as the functions are kept.
+    static fml::RefPtr<fml::NativeLibrary> media =
+        fml::NativeLibrary::Create("libmediandk.so");
+    static fml::RefPtr<fml::NativeLibrary> android =
+        fml::NativeLibrary::Create("libandroid.so");
+    if (!media || !android) {
+      return procs;
+    }
+    procs.valid =
+        Resolve(media, "AImageReader_newWithUsage",
+                procs.AImageReader_newWithUsage) &&
+        Resolve(media, "AImageReader_delete", procs.AImageReader_delete) &&
+        Resolve(media, "AImageReader_getWindow",
+                procs.AImageReader_getWindow) &&
+        Resolve(media, "AImageReader_setImageListener",
+                procs.AImageReader_setImageListener) &&
+        Resolve(media, "AImageReader_acquireLatestImageAsync",
+                procs.AImageReader_acquireLatestImageAsync) &&
+        Resolve(media, "AImage_deleteAsync", procs.AImage_deleteAsync) &&
+        Resolve(media, "AImage_getHardwareBuffer",
+                procs.AImage_getHardwareBuffer) &&
+        Resolve(media, "AImage_getWidth", procs.AImage_getWidth) &&
+        Resolve(media, "AImage_getHeight", procs.AImage_getHeight) &&
+        Resolve(android, "ANativeWindow_toSurface",
+                procs.ANativeWindow_toSurface) &&
+        Resolve("eglGetNativeClientBufferANDROID",
+                procs.eglGetNativeClientBufferANDROID) &&
+        Resolve("eglCreateImageKHR", procs.eglCreateImageKHR) &&
+        Resolve("eglDestroyImageKHR", procs.eglDestroyImageKHR) &&
+        Resolve("glEGLImageTargetTexture2DOES",
+                procs.glEGLImageTargetTexture2DOES);
+    // Without fences, the frames are waited on and released on the CPU.
+    Resolve("eglCreateSyncKHR", procs.eglCreateSyncKHR);
+    Resolve("eglDestroySyncKHR", procs.eglDestroySyncKHR);
+    Resolve("eglWaitSyncKHR", procs.eglWaitSyncKHR);
+    Resolve("eglDupNativeFenceFDANDROID", procs.eglDupNativeFenceFDANDROID);
+    if (!procs.valid) {
+      FML_LOG(INFO) << "Hardware buffer textures are not supported.";
+    }
+    return procs;
+  }();
+  return procs;
+}
+
+bool HasExtension(const char* extensions, const char* name) {
+  if (extensions == nullptr) {
+    return false;
+  }
+  const size_t length = strlen(name);
+  for (const char* found = strstr(extensions, name); found != nullptr;
+       found = strstr(found + length, name)) {
+    const bool starts = found == extensions || found[-1] == ' ';
+    const bool ends = found[length] == '\0' || found[length] == ' ';
+    if (starts && ends) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SupportsNativeFences(const Procs& procs, EGLDisplay display) {
+  if (!procs.eglCreateSyncKHR || !procs.eglDestroySyncKHR ||
+      !procs.eglWaitSyncKHR || !procs.eglDupNativeFenceFDANDROID) {
+    return false;
+  }
+  const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+  return HasExtension(extensions, "EGL_ANDROID_native_fence_sync") &&
+         HasExtension(extensions, "EGL_KHR_wait_sync");
+}
+
+// Makes the GPU wait on the fence before it executes the commands issued
+// after this call. Takes ownership of the fence.
+void WaitOnFence(const Procs& procs, EGLDisplay display, int fence_fd) {
+  if (fence_fd < 0) {
+    return;
+  }
+  if (SupportsNativeFences(procs, display)) {
+    const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fence_fd,
+                                 EGL_NONE};
+    // The sync takes ownership of the fence if it is created.
+    EGLSyncKHR sync = procs.eglCreateSyncKHR(
+        display, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+    if (sync != EGL_NO_SYNC_KHR) {
+      procs.eglWaitSyncKHR(display, sync, 0);
+      procs.eglDestroySyncKHR(display, sync);
+      return;
+    }
+  }
+  fml::UniqueFD fence(fence_fd);
+  struct pollfd poll_fd = {};
+  poll_fd.fd = fence.get();
+  poll_fd.events = POLLIN;
+  while (poll(&poll_fd, 1, -1) < 0 && (errno == EINTR || errno == EAGAIN)) {
+  }
+}
+
+// Returns a fence that signals once the commands issued so far are executed,
+// or -1 if they have been executed already.
+int CreateFence(const Procs& procs, EGLDisplay display) {
+  EGLSyncKHR sync =
+      SupportsNativeFences(procs, display)
+          ? procs.eglCreateSyncKHR(display, EGL_SYNC_NATIVE_FENCE_ANDROID,
+                                   nullptr)
+          : EGL_NO_SYNC_KHR;
+  if (sync == EGL_NO_SYNC_KHR) {
+    glFinish();
+    return -1;
+  }
+  // The fence is only created once the sync is flushed.
+  glFlush();
+  const int fence_fd = procs.eglDupNativeFenceFDANDROID(display, sync);
+  procs.eglDestroySyncKHR(display, sync);
+  return fence_fd;
+}
+
+}  // namespace
+
+std::shared_ptr<AndroidHardwareBufferTextureGL>
+AndroidHardwareBufferTextureGL::Create(
+    int64_t id,
+    const SkISize& size,
+    std::function<void()> on_frame_available) {
+  const auto& procs = GetProcs();
+  if (!procs.valid || size.isEmpty()) {
+    return nullptr;
+  }
+
+  std::shared_ptr<AndroidHardwareBufferTextureGL> texture(
+      new AndroidHardwareBufferTextureGL(id, std::move(on_frame_available)));
+  if (procs.AImageReader_newWithUsage(size.width(), size.height(),
+                                      kImageFormatPrivate,
+                                      kUsageGPUSampledImage, kMaxImages,
+                                      &texture->reader_) != kMediaOk ||
+      procs.AImageReader_getWindow(texture->reader_, &texture->window_) !=
+          kMediaOk) {
+    FML_LOG(ERROR) << "Could not create the image reader of a texture.";
+    return nullptr;
+  }
+  // The reader copies the listener.
+  ImageListener listener = {texture.get(), &OnImageAvailable};
+  procs.AImageReader_setImageListener(texture->reader_, &listener);
+  return texture;
+}
+
+AndroidHardwareBufferTextureGL::AndroidHardwareBufferTextureGL(
+    int64_t id,
+    std::function<void()> on_frame_available)
+    : Texture(id), on_frame_available_(std::move(on_frame_available)) {}
+
+AndroidHardwareBufferTextureGL::~AndroidHardwareBufferTextureGL() {
+  const auto& procs = GetProcs();
+  ReleaseImage();
+  if (texture_name_ != 0) {
+    glDeleteTextures(1, &texture_name_);
+  }
+  if (reader_) {
+    procs.AImageReader_setImageListener(reader_, nullptr);
+    // Also invalidates |window_|.
+    procs.AImageReader_delete(reader_);
+  }
+}
+
+jobject AndroidHardwareBufferTextureGL::CreateSurface(JNIEnv* env) const {
+  return GetProcs().ANativeWindow_toSurface(env, window_);
+}
+
+// static
+void AndroidHardwareBufferTextureGL::OnImageAvailable(void* context,
+                                                      AImageReader* reader) {
+  static_cast<AndroidHardwareBufferTextureGL*>(context)->on_frame_available_();
+}
+
+bool AndroidHardwareBufferTextureGL::AcquireLatestImage(
+    GrDirectContext* context) {
+  TRACE_EVENT0("flutter", "AndroidHardwareBufferTextureGL::AcquireLatestImage");
+  const auto& procs = GetProcs();
+  AImage* image = nullptr;
+  int acquire_fence_fd = -1;
+  // Drops the frames queued before the latest one.
+  if (procs.AImageReader_acquireLatestImageAsync(reader_, &image,
+                                                 &acquire_fence_fd) !=
+      kMediaOk) {
+    return false;
+  }
+
+  AHardwareBuffer* buffer = nullptr;
+  int32_t width = 0;
+  int32_t height = 0;
+  EGLDisplay display = eglGetCurrentDisplay();
+  EGLImageKHR egl_image = EGL_NO_IMAGE_KHR;
+  if (procs.AImage_getHardwareBuffer(image, &buffer) == kMediaOk &&
+      procs.AImage_getWidth(image, &width) == kMediaOk &&
+      procs.AImage_getHeight(image, &height) == kMediaOk) {
+    const EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+    egl_image = procs.eglCreateImageKHR(
+        display, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID,
+        procs.eglGetNativeClientBufferANDROID(buffer), attributes);
+  }
+  if (egl_image == EGL_NO_IMAGE_KHR) {
+    FML_LOG(ERROR) << "Could not import the hardware buffer of a texture.";
+    // The producer may reuse the buffer once the acquire fence signals.
+    procs.AImage_deleteAsync(image, acquire_fence_fd);
+    return false;
+  }
+
+  // The draws that sampled the previous image were issued in earlier frames.
+  ReleaseImage();
+
+  glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture_name_);
+  procs.glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, egl_image);
+  glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+  // The binding was changed behind the back of Skia.
+  context->resetContext(kTextureBinding_GrGLBackendState);
+
+  // The draws that sample the image are issued after this wait.
+  WaitOnFence(procs, display, acquire_fence_fd);
+
+  image_ = image;
+  egl_image_ = egl_image;
+  image_size_ = SkISize::Make(width, height);
+  return true;
+}
+
+void AndroidHardwareBufferTextureGL::ReleaseImage() {
+  if (image_ == nullptr) {
+    return;
+  }
+  const auto& procs = GetProcs();
+  EGLDisplay display = eglGetCurrentDisplay();
+  // The producer writes into the buffer again once the fence signals.
+  procs.AImage_deleteAsync(image_, CreateFence(procs, display));
+  procs.eglDestroyImageKHR(display, egl_image_);
+  image_ = nullptr;
+  egl_image_ = EGL_NO_IMAGE_KHR;
+}
+
+// |flutter::Texture|
+void AndroidHardwareBufferTextureGL::Paint(SkCanvas& canvas,
+                                           const SkRect& bounds,
+                                           bool freeze,
+                                           GrDirectContext* context,
+                                           SkFilterQuality filter_quality) {
+  if (texture_name_ == 0) {
+    glGenTextures(1, &texture_name_);
+  }
+  if (!freeze && new_frame_ready_) {
+    new_frame_ready_ = false;
+    AcquireLatestImage(context);
+  }
+  if (image_ == nullptr) {
+    return;
+  }
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_EXTERNAL_OES, texture_name_,
+                                  GL_RGBA8_OES};
+  GrBackendTexture backend_texture(image_size_.width(), image_size_.height(),
+                                   GrMipMapped::kNo, texture_info);
+  sk_sp<SkImage> image = SkImage::MakeFromTexture(
+      context, backend_texture, kTopLeft_GrSurfaceOrigin,
+      kRGBA_8888_SkColorType, kPremul_SkAlphaType, nullptr);
+  if (image) {
+    SkPaint paint;
+    paint.setFilterQuality(filter_quality);
+    canvas.drawImageRect(image, bounds, &paint);
+  }
+}
+
+// |flutter::Texture|
+void AndroidHardwareBufferTextureGL::OnGrContextCreated() {
+  // The image was released with the previous context, so show the next one
+  // that is queued.
+  new_frame_ready_ = true;
+}
+
+// |flutter::Texture|
+void AndroidHardwareBufferTextureGL::OnGrContextDestroyed() {
+  ReleaseImage();
+  if (texture_name_ != 0) {
+    glDeleteTextures(1, &texture_name_);
+    texture_name_ = 0;
+  }
+}
+
+// |flutter::Texture|
+void AndroidHardwareBufferTextureGL::MarkNewFrameAvailable() {
+  new_frame_ready_ = true;
+}
+
+// |flutter::Texture|
+void AndroidHardwareBufferTextureGL::OnTextureUnregistered() {}
+
+}  // namespace flutter
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_HARDWARE_BUFFER_TEXTURE_GL_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_HARDWARE_BUFFER_TEXTURE_GL_H_
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES/gl.h>
+#include <android/native_window.h>
+#include <jni.h>
+
+#include <functional>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+struct AImage;
+struct AImageReader;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An external texture whose frames are the `AHardwareBuffer`s of
+///             an `AImageReader`. Producers like `MediaCodec` or the camera
+///             queue their frames to the surface of the reader, and each
+///             frame is bound as an `EGLImage` on the raster thread.
+///
+///             Unlike with `AndroidExternalTextureGL`, no JNI call is made
+///             per frame: the reader signals new frames from its own thread,
+///             and the buffer queue fences are waited on by the GPU. A frame
+///             is returned to the reader, with a fence that signals once the
+///             GPU is done sampling it, when the next frame replaces it.
+///
+///             This requires API level 26. |Create| returns nullptr on older
+///             devices.
+///
+class AndroidHardwareBufferTextureGL : public flutter::Texture {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a texture with an image reader of the given size.
+  ///
+  /// @param[in]  id                The identifier of the texture.
+  /// @param[in]  size              The default size of the buffers of the
+  ///                               reader. Producers may queue buffers of
+  ///                               other sizes.
+  /// @param[in]  on_frame_available  Called on a thread of the reader when a
+  ///                               frame was queued. Must not touch the
+  ///                               texture.
+  ///
+  /// @return     The texture, or nullptr if hardware buffer textures are not
+  ///             supported on this device.
+  ///
+  static std::shared_ptr<AndroidHardwareBufferTextureGL> Create(
+      int64_t id,
+      const SkISize& size,
+      std::function<void()> on_frame_available);
+
+  ~AndroidHardwareBufferTextureGL() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a Java `Surface` that queues frames to this texture.
+  ///
+  jobject CreateSurface(JNIEnv* env) const;
+
+  // |flutter::Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrDirectContext* context,
+             SkFilterQuality filter_quality) override;
+
+  // |flutter::Texture|
+  void OnGrContextCreated() override;
+
+  // |flutter::Texture|
+  void OnGrContextDestroyed() override;
+
+  // |flutter::Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |flutter::Texture|
+  void OnTextureUnregistered() override;
+
+ private:
+  AImageReader* reader_ = nullptr;
+  ANativeWindow* window_ = nullptr;
+  std::function<void()> on_frame_available_;
+  bool new_frame_ready_ = false;
+
+  // The frame currently bound to |texture_name_|. These are only accessed on
+  // the raster thread.
+  AImage* image_ = nullptr;
+  EGLImageKHR egl_image_ = EGL_NO_IMAGE_KHR;
+  SkISize image_size_ = SkISize::MakeEmpty();
+  GLuint texture_name_ = 0;
+
+  AndroidHardwareBufferTextureGL(int64_t id,
+                                 std::function<void()> on_frame_available);
+
+  bool AcquireLatestImage(GrDirectContext* context);
+
+  void ReleaseImage();
+
+  static void OnImageAvailable(void* context, AImageReader* reader);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidHardwareBufferTextureGL);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_HARDWARE_BUFFER_TEXTURE_GL_H_
@@ -0,0 +1,214 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_image_generator.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+
+struct AImageDecoder;
+struct AImageDecoderHeaderInfo;
+
+namespace flutter {
+
+namespace {
+
+// ANDROID_IMAGE_DECODER_SUCCESS.
+constexpr int kImageDecoderSuccess = 0;
+// ANDROID_BITMAP_FORMAT_RGBA_8888.
+constexpr int32_t kBitmapFormatRGBA8888 = 1;
+// ANDROID_BITMAP_FLAGS_ALPHA_OPAQUE.
+constexpr int kBitmapFlagsAlphaOpaque = 1;
+// ADATASPACE_SRGB.
+constexpr int32_t kDataSpaceSRGB = 142671872;
+
+// The image decoder functions are only available from API level 30, so they
+// are resolved when first used rather than linked.
+struct ImageDecoderProcs {
+  int (*AImageDecoder_createFromBuffer)(const void* buffer,
+                                        size_t length,
+                                        AImageDecoder** decoder);
+  void (*AImageDecoder_delete)(AImageDecoder* decoder);
+  const AImageDecoderHeaderInfo* (*AImageDecoder_getHeaderInfo)(
+      const AImageDecoder* decoder);
+  int32_t (*AImageDecoderHeaderInfo_getWidth)(
+      const AImageDecoderHeaderInfo* info);
+  int32_t (*AImageDecoderHeaderInfo_getHeight)(
+      const AImageDecoderHeaderInfo* info);
+  int (*AImageDecoderHeaderInfo_getAlphaFlags)(
+      const AImageDecoderHeaderInfo* info);
+  int (*AImageDecoder_setAndroidBitmapFormat)(AImageDecoder* decoder,
+                                              int32_t format);
+  int (*AImageDecoder_setDataSpace)(AImageDecoder* decoder, int32_t dataspace);
+  int (*AImageDecoder_setTargetSize)(AImageDecoder* decoder,
+                                     int32_t width,
+                                     int32_t height);
+  int (*AImageDecoder_decodeImage)(AImageDecoder* decoder,
+                                   void* pixels,
+                                   size_t stride,
+                                   size_t size);
+
+  bool valid = false;
+};
+
+template <typename T>
+bool Resolve(const fml::RefPtr<fml::NativeLibrary>& library,
+             const char* name,
+             T& proc) {
+  proc = reinterpret_cast<T>(library->ResolveSymbol(name));
+  return proc != nullptr;
+}
+
+const ImageDecoderProcs& GetProcs() {
+  static const ImageDecoderProcs procs = []() {
+    ImageDecoderProcs procs = {};
+    // The library is never unloaded as the functions are kept.
+    static fml::RefPtr<fml::NativeLibrary> jnigraphics =
+        fml::NativeLibrary::Create("libjnigraphics.so");
+    if (!jnigraphics) {
+      return procs;
+    }
+    procs.valid =
+        Resolve(jnigraphics, "AImageDecoder_createFromBuffer",
+                procs.AImageDecoder_createFromBuffer) &&
+        Resolve(jnigraphics, "AImageDecoder_delete",
+                procs.AImageDecoder_delete) &&
+        Resolve(jnigraphics, "AImageDecoder_getHeaderInfo",
+                procs.AImageDecoder_getHeaderInfo) &&
+        Resolve(jnigraphics, "AImageDecoderHeaderInfo_getWidth",
+                procs.AImageDecoderHeaderInfo_getWidth) &&
+        Resolve(jnigraphics, "AImageDecoderHeaderInfo_getHeight",
+                procs.AImageDecoderHeaderInfo_getHeight) &&
+        Resolve(jnigraphics, "AImageDecoderHeaderInfo_getAlphaFlags",
+                procs.AImageDecoderHeaderInfo_getAlphaFlags) &&
+        Resolve(jnigraphics, "AImageDecoder_setAndroidBitmapFormat",
+                procs.AImageDecoder_setAndroidBitmapFormat) &&
+        Resolve(jnigraphics, "AImageDecoder_setDataSpace",
+                procs.AImageDecoder_setDataSpace) &&
+        Resolve(jnigraphics, "AImageDecoder_setTargetSize",
+                procs.AImageDecoder_setTargetSize) &&
+        Resolve(jnigraphics, "AImageDecoder_decodeImage",
+                procs.AImageDecoder_decodeImage);
+    return procs;
+  }();
+  return procs;
+}
+
+// Deletes the decoder when it goes out of scope.
+class ScopedImageDecoder {
+ public:
+  explicit ScopedImageDecoder(const SkData& data) {
+    if (GetProcs().AImageDecoder_createFromBuffer(
+            data.data(), data.size(), &decoder_) != kImageDecoderSuccess) {
+      decoder_ = nullptr;
+    }
+  }
+
+  ~ScopedImageDecoder() {
+    if (decoder_ != nullptr) {
+      GetProcs().AImageDecoder_delete(decoder_);
+    }
+  }
+
+  AImageDecoder* get() const { return decoder_; }
+
+ private:
+  AImageDecoder* decoder_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedImageDecoder);
+};
+
+}  // namespace
+
+AndroidImageGenerator::AndroidImageGenerator(const SkImageInfo& info,
+                                             sk_sp<SkData> data)
+    : SkImageGenerator(info), data_(std::move(data)) {}
+
+AndroidImageGenerator::~AndroidImageGenerator() = default;
+
+bool AndroidImageGenerator::IsSupported() {
+  return GetProcs().valid;
+}
+
+std::unique_ptr<SkImageGenerator> AndroidImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data || !IsSupported()) {
+    return nullptr;
+  }
+
+  const ImageDecoderProcs& procs = GetProcs();
+  ScopedImageDecoder decoder(*data);
+  if (decoder.get() == nullptr) {
+    return nullptr;
+  }
+
+  const AImageDecoderHeaderInfo* header =
+      procs.AImageDecoder_getHeaderInfo(decoder.get());
+  const SkAlphaType alpha_type =
+      procs.AImageDecoderHeaderInfo_getAlphaFlags(header) ==
+              kBitmapFlagsAlphaOpaque
+          ? kOpaque_SkAlphaType
+          : kPremul_SkAlphaType;
+  // The dimensions are those of the image as displayed, with the EXIF
+  // orientation applied.
+  const SkImageInfo info = SkImageInfo::Make(
+      procs.AImageDecoderHeaderInfo_getWidth(header),
+      procs.AImageDecoderHeaderInfo_getHeight(header), kRGBA_8888_SkColorType,
+      alpha_type, SkColorSpace::MakeSRGB());
+  if (info.isEmpty()) {
+    return nullptr;
+  }
+
+  return std::unique_ptr<SkImageGenerator>(
+      new AndroidImageGenerator(info, std::move(data)));
+}
+
+sk_sp<SkData> AndroidImageGenerator::onRefEncodedData() {
+  return data_;
+}
+
+bool AndroidImageGenerator::onGetPixels(const SkImageInfo& info,
+                                        void* pixels,
+                                        size_t row_bytes,
+                                        const Options& options) {
+  TRACE_EVENT0("flutter", "AndroidImageGenerator::onGetPixels");
+  if (info.colorType() != kRGBA_8888_SkColorType ||
+      info.width() > getInfo().width() || info.height() > getInfo().height()) {
+    return false;
+  }
+
+  // A decoder can only decode once before API level 31, so every request
+  // gets its own.
+  const ImageDecoderProcs& procs = GetProcs();
+  ScopedImageDecoder decoder(*data_);
+  if (decoder.get() == nullptr) {
+    return false;
+  }
+
+  if (procs.AImageDecoder_setAndroidBitmapFormat(
+          decoder.get(), kBitmapFormatRGBA8888) != kImageDecoderSuccess ||
+      procs.AImageDecoder_setDataSpace(decoder.get(), kDataSpaceSRGB) !=
+          kImageDecoderSuccess) {
+    return false;
+  }
+
+  if (info.dimensions() != getInfo().dimensions() &&
+      procs.AImageDecoder_setTargetSize(decoder.get(), info.width(),
+                                        info.height()) !=
+          kImageDecoderSuccess) {
+    return false;
+  }
+
+  const int result = procs.AImageDecoder_decodeImage(
+      decoder.get(), pixels, row_bytes, row_bytes * info.height());
+  if (result != kImageDecoderSuccess) {
+    FML_DLOG(ERROR) << "AImageDecoder failed to decode an image: " << result;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_GENERATOR_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_GENERATOR_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageGenerator.h"
+
+namespace flutter {
+
+// An image generator that decodes with the |AImageDecoder| of the platform,
+// which is available from API level 30. It decodes the formats of the
+// platform, including HEIF, which Skia can not decode, and uses the hardware
+// decoders of the device where the platform does.
+//
+// Requests for an image smaller than the encoded one are decoded at the
+// requested size rather than scaled afterwards.
+class AndroidImageGenerator : public SkImageGenerator {
+ public:
+  ~AndroidImageGenerator() override;
+
+  // Whether |AImageDecoder| is available on this device.
+  static bool IsSupported();
+
+  // Returns null if |data| can not be decoded by the platform.
+  static std::unique_ptr<SkImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ protected:
+  // |SkImageGenerator|
+  sk_sp<SkData> onRefEncodedData() override;
+
+  // |SkImageGenerator|
+  bool onGetPixels(const SkImageInfo& info,
+                   void* pixels,
+                   size_t row_bytes,
+                   const Options& options) override;
+
+ private:
+  sk_sp<SkData> data_;
+
+  AndroidImageGenerator(const SkImageInfo& info, sk_sp<SkData> data);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_IMAGE_GENERATOR_H_
@@ -7,7 +7,6 @@
 #include "flutter/shell/platform/android/android_shell_holder.h"
 
 #include <pthread.h>
-#include <sys/resource.h>
 #include <sys/time.h>
 
 #include <sstream>
@@ -40,10 +39,12 @@ AndroidShellHolder::AndroidShellHolder(
             0);
 
   if (is_background_view) {
-    thread_host_ = {thread_label, ThreadHost::Type::UI};
+    thread_host_ = {thread_label, ThreadHost::Type::UI, settings_};
   } else {
-    thread_host_ = {thread_label, ThreadHost::Type::UI | ThreadHost::Type::GPU |
-                                      ThreadHost::Type::IO};
+    thread_host_ = {thread_label,
+                    ThreadHost::Type::UI | ThreadHost::Type::GPU |
+                        ThreadHost::Type::IO,
+                    settings_};
   }
 
   // Detach from JNI when the UI and raster threads exit.
@@ -70,13 +71,18 @@ AndroidShellHolder::AndroidShellHolder(
               shell,                   // delegate
               shell.GetTaskRunners(),  // task runners
               jni_facade,              // JNI interop
-              shell.GetSettings()
-                  .enable_software_rendering  // use software rendering
+              shell.GetSettings()      // settings
           );
         }
         weak_platform_view = platform_view_android->GetWeakPtr();
         shell.OnDisplayUpdates(DisplayUpdateType::kStartup,
                                {Display(jni_facade->GetDisplayRefreshRate())});
+        // The vsync waiter, which calls this, does not outlive the shell.
+        platform_view_android->SetOnRefreshRateChanged(
+            [&shell](double refresh_rate) {
+              shell.OnDisplayUpdates(DisplayUpdateType::kConfigurationChanged,
+                                     {Display(refresh_rate)});
+            });
         return platform_view_android;
       };
 
@@ -109,24 +115,6 @@ AndroidShellHolder::AndroidShellHolder(
                                     ui_runner,        // ui
                                     io_runner         // io
   );
-  task_runners.GetRasterTaskRunner()->PostTask([]() {
-    // Android describes -8 as "most important display threads, for
-    // compositing the screen and retrieving input events". Conservatively
-    // set the raster thread to slightly lower priority than it.
-    if (::setpriority(PRIO_PROCESS, gettid(), -5) != 0) {
-      // Defensive fallback. Depending on the OEM, it may not be possible
-      // to set priority to -5.
-      if (::setpriority(PRIO_PROCESS, gettid(), -2) != 0) {
-        FML_LOG(ERROR) << "Failed to set GPU task runner priority";
-      }
-    }
-  });
-  task_runners.GetUITaskRunner()->PostTask([]() {
-    if (::setpriority(PRIO_PROCESS, gettid(), -1) != 0) {
-      FML_LOG(ERROR) << "Failed to set UI task runner priority";
-    }
-  });
-
   shell_ =
       Shell::Create(task_runners,              // task runners
                     GetDefaultPlatformData(),  // window data
@@ -180,8 +168,8 @@ fml::WeakPtr<PlatformViewAndroid> AndroidShellHolder::GetPlatformView() {
   return platform_view_;
 }
 
-void AndroidShellHolder::NotifyLowMemoryWarning() {
+void AndroidShellHolder::NotifyLowMemoryWarning(MemoryPressureLevel level) {
   FML_DCHECK(shell_);
-  shell_->NotifyLowMemoryWarning();
+  shell_->NotifyLowMemoryWarning(level);
 }
 }  // namespace flutter
@@ -40,7 +40,8 @@ class AndroidShellHolder {
 
   void UpdateAssetManager(fml::RefPtr<flutter::AssetManager> asset_manager);
 
-  void NotifyLowMemoryWarning();
+  void NotifyLowMemoryWarning(
+      MemoryPressureLevel level = MemoryPressureLevel::kCritical);
 
  private:
   const flutter::Settings settings_;
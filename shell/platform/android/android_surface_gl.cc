@@ -6,9 +6,12 @@
 
 #include <GLES/gl.h>
 #include <utility>
+#include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/android/android_shell_holder.h"
 
 namespace flutter {
@@ -33,7 +36,13 @@ AndroidSurfaceGL::AndroidSurfaceGL(
   }
 }
 
-AndroidSurfaceGL::~AndroidSurfaceGL() = default;
+AndroidSurfaceGL::~AndroidSurfaceGL() {
+  if (prewarmed_gr_context_) {
+    // The context may not be made current on this thread. Its GL resources
+    // are collected with the EGL context instead.
+    prewarmed_gr_context_->abandonContext();
+  }
+}
 
 void AndroidSurfaceGL::TeardownOnScreenContext() {
   // When the onscreen surface is destroyed, the context and the surface
@@ -52,9 +61,45 @@ std::unique_ptr<Surface> AndroidSurfaceGL::CreateGPUSurface(
   if (gr_context) {
     return std::make_unique<GPUSurfaceGL>(sk_ref_sp(gr_context), this, true);
   }
+  if (prewarmed_gr_context_) {
+    return std::make_unique<GPUSurfaceGL>(prewarmed_gr_context_, this, true);
+  }
   return std::make_unique<GPUSurfaceGL>(this, true);
 }
 
+void AndroidSurfaceGL::PrewarmGPUContext() {
+  FML_DCHECK(IsValid());
+  if (prewarmed_gr_context_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "AndroidSurfaceGL::PrewarmGPUContext");
+
+  // The GrDirectContext only depends on the EGL context, not on the surface
+  // it is current with, so it keeps working once the window surface is made
+  // current instead of the pbuffer.
+  auto pbuffer_surface = android_context_.CreateOnscreenPbufferSurface();
+  if (!pbuffer_surface->IsValid() || !pbuffer_surface->MakeCurrent()) {
+    FML_LOG(ERROR) << "Could not make the onscreen context current to prewarm "
+                      "the GPU context.";
+    return;
+  }
+
+  sk_sp<GrDirectContext> gr_context = GPUSurfaceGL::MakeGLContext(this);
+  if (gr_context) {
+    std::vector<PersistentCache::SkSLCache> caches =
+        PersistentCache::GetCacheForProcess()->LoadSkSLs();
+    int compiled_count =
+        GPUSurfaceGL::PrecompileSkSLs(gr_context.get(), caches);
+    FML_LOG(INFO) << "Found " << caches.size() << " SkSL shaders; precompiled "
+                  << compiled_count << " ahead of the first surface";
+  } else {
+    FML_LOG(ERROR) << "Failed to prewarm the Skia Gr context.";
+  }
+
+  android_context_.ClearCurrent();
+  prewarmed_gr_context_ = std::move(gr_context);
+}
+
 bool AndroidSurfaceGL::OnScreenSurfaceResize(const SkISize& size) {
   FML_DCHECK(IsValid());
   FML_DCHECK(onscreen_surface_);
@@ -12,10 +12,36 @@
 
 namespace flutter {
 
+static VkPresentModeKHR PresentModeFromSettings(const Settings& settings) {
+  if (settings.vulkan_present_mode == "mailbox") {
+    return VK_PRESENT_MODE_MAILBOX_KHR;
+  }
+  if (settings.vulkan_present_mode == "fifo-relaxed") {
+    return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+  }
+  if (settings.vulkan_present_mode != "fifo") {
+    FML_LOG(ERROR) << "Unknown Vulkan present mode \""
+                   << settings.vulkan_present_mode << "\". Using fifo.";
+  }
+  return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+static vulkan::VulkanSwapchainConfig SwapchainConfigFromSettings(
+    const Settings& settings) {
+  vulkan::VulkanSwapchainConfig config;
+  config.present_mode = PresentModeFromSettings(settings);
+  config.image_count = settings.vulkan_swapchain_image_count;
+  config.enable_display_timing = settings.enable_vulkan_display_timing;
+  config.use_surface_control = settings.enable_vulkan_surface_control;
+  return config;
+}
+
 AndroidSurfaceVulkan::AndroidSurfaceVulkan(
     const AndroidContext& android_context,
-    std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
-    : proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()) {}
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+    const Settings& settings)
+    : proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()),
+      swapchain_config_(SwapchainConfigFromSettings(settings)) {}
 
 AndroidSurfaceVulkan::~AndroidSurfaceVulkan() = default;
 
@@ -46,7 +72,7 @@ std::unique_ptr<Surface> AndroidSurfaceVulkan::CreateGPUSurface(
   }
 
   auto gpu_surface = std::make_unique<GPUSurfaceVulkan>(
-      this, std::move(vulkan_surface_android), true);
+      this, std::move(vulkan_surface_android), true, swapchain_config_);
 
   if (!gpu_surface->IsValid()) {
     return nullptr;
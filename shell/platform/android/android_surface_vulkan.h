@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
@@ -21,7 +22,8 @@ class AndroidSurfaceVulkan : public AndroidSurface,
                              public GPUSurfaceVulkanDelegate {
  public:
   AndroidSurfaceVulkan(const AndroidContext& android_context,
-                       std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+                       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+                       const Settings& settings);
 
   ~AndroidSurfaceVulkan() override;
 
@@ -53,6 +55,7 @@ class AndroidSurfaceVulkan : public AndroidSurface,
  private:
   fml::RefPtr<vulkan::VulkanProcTable> proc_table_;
   fml::RefPtr<AndroidNativeWindow> native_window_;
+  const vulkan::VulkanSwapchainConfig swapchain_config_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceVulkan);
 };
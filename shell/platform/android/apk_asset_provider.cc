@@ -4,12 +4,14 @@
 
 #include "flutter/shell/platform/android/apk_asset_provider.h"
 
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <sstream>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/unique_fd.h"
 
 namespace flutter {
 
@@ -49,6 +51,59 @@ class APKAssetMapping : public fml::Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(APKAssetMapping);
 };
 
+// Maps an asset that is stored uncompressed in the APK straight from the APK
+// file. Unlike |AAsset_getBuffer|, which may read the whole asset into the
+// native heap, the pages are only read on access and are shared with the
+// page cache of the APK.
+class APKAssetFileMapping : public fml::Mapping {
+ public:
+  // Returns null if the asset is compressed or could not be mapped.
+  static std::unique_ptr<APKAssetFileMapping> Create(AAsset* asset) {
+    off64_t start = 0;
+    off64_t length = 0;
+    fml::UniqueFD fd(AAsset_openFileDescriptor64(asset, &start, &length));
+    if (!fd.is_valid() || length <= 0) {
+      return nullptr;
+    }
+
+    // Entries are only aligned to 4 bytes unless the APK was zipaligned with
+    // page alignment, so map from the page that contains the start.
+    const off64_t page_size = ::sysconf(_SC_PAGESIZE);
+    const off64_t page_offset = start % page_size;
+    const size_t mapped_size = page_offset + length;
+    void* mapping = ::mmap64(nullptr, mapped_size, PROT_READ, MAP_SHARED,
+                             fd.get(), start - page_offset);
+    if (mapping == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::unique_ptr<APKAssetFileMapping>(new APKAssetFileMapping(
+        static_cast<uint8_t*>(mapping), mapped_size, page_offset, length));
+  }
+
+  ~APKAssetFileMapping() override { ::munmap(mapping_, mapped_size_); }
+
+  size_t GetSize() const override { return size_; }
+
+  const uint8_t* GetMapping() const override { return mapping_ + offset_; }
+
+ private:
+  uint8_t* const mapping_;
+  const size_t mapped_size_;
+  const size_t offset_;
+  const size_t size_;
+
+  APKAssetFileMapping(uint8_t* mapping,
+                      size_t mapped_size,
+                      size_t offset,
+                      size_t size)
+      : mapping_(mapping),
+        mapped_size_(mapped_size),
+        offset_(offset),
+        size_(size) {}
+
+  FML_DISALLOW_COPY_AND_ASSIGN(APKAssetFileMapping);
+};
+
 std::unique_ptr<fml::Mapping> APKAssetProvider::GetAsMapping(
     const std::string& asset_name) const {
   std::stringstream ss;
@@ -59,6 +114,13 @@ std::unique_ptr<fml::Mapping> APKAssetProvider::GetAsMapping(
     return nullptr;
   }
 
+  // The mapping keeps its own reference to the APK file, so the asset is no
+  // longer needed once it is made.
+  if (auto file_mapping = APKAssetFileMapping::Create(asset)) {
+    AAsset_close(asset);
+    return file_mapping;
+  }
+
   return std::make_unique<APKAssetMapping>(asset);
 }
 
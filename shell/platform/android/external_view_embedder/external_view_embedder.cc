@@ -92,6 +92,8 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   // below.
   SkAutoCanvasRestore save(background_canvas, /*doSave=*/true);
 
+  // Reused by the queries below.
+  std::vector<SkRect> intersection_rects;
   for (size_t i = 0; i < current_frame_view_count; i++) {
     int64_t view_id = composition_order_[i];
 
@@ -113,8 +115,8 @@ void AndroidExternalViewEmbedder::SubmitFrame(
       int64_t current_view_id = composition_order_[j];
       SkRect current_view_rect = GetViewRect(current_view_id);
       // Each rect corresponds to a native view that renders Flutter UI.
-      std::list<SkRect> intersection_rects =
-          rtree->searchNonOverlappingDrawnRects(current_view_rect);
+      rtree->searchNonOverlappingDrawnRects(current_view_rect,
+                                            &intersection_rects);
       auto allocation_size = intersection_rects.size();
 
       // Limit the number of native views, so it doesn't grow forever.
@@ -16,10 +16,12 @@
 #include "flutter/fml/platform/android/jni_util.h"
 #include "flutter/fml/platform/android/paths_android.h"
 #include "flutter/fml/size.h"
+#include "flutter/lib/ui/painting/platform_image_generator.h"
 #include "flutter/lib/ui/plugins/callback_cache.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/switches.h"
+#include "flutter/shell/platform/android/android_image_generator.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 
@@ -120,6 +122,16 @@ void FlutterMain::Init(JNIEnv* env,
       make_mapping_callback(kPlatformStrongDill, kPlatformStrongDillSize);
 #endif  // FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
 
+  // Decode the formats Skia does not know, such as HEIF, and large photos when
+  // preferred, with the platform's image decoder.
+  if (AndroidImageGenerator::IsSupported()) {
+    SetPlatformImageGeneratorFactory(&AndroidImageGenerator::MakeFromData);
+  }
+
+  // Boot the VM while the activity inflates its views so that attaching the
+  // first FlutterEngine only has to launch the root isolate.
+  Shell::PrewarmDartVM(settings);
+
   // Not thread safe. Will be removed when FlutterMain is refactored to no
   // longer be a singleton.
   g_flutter_main.reset(new FlutterMain(std::move(settings)));
@@ -161,6 +173,10 @@ static void PrefetchDefaultFontManager(JNIEnv* env, jclass jcaller) {
   SkFontMgr::RefDefault();
 }
 
+static void StartDeferredServiceIsolate(JNIEnv* env, jclass jcaller) {
+  DartServiceIsolate::ResumeDeferredStartup();
+}
+
 bool FlutterMain::Register(JNIEnv* env) {
   static const JNINativeMethod methods[] = {
       {
@@ -174,6 +190,11 @@ bool FlutterMain::Register(JNIEnv* env) {
           .signature = "()V",
           .fnPtr = reinterpret_cast<void*>(&PrefetchDefaultFontManager),
       },
+      {
+          .name = "nativeStartDeferredServiceIsolate",
+          .signature = "()V",
+          .fnPtr = reinterpret_cast<void*>(&StartDeferredServiceIsolate),
+      },
   };
 
   jclass clazz = env->FindClass("io/flutter/embedding/engine/FlutterJNI");
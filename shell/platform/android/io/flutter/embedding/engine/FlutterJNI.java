@@ -30,6 +30,7 @@ import io.flutter.plugin.platform.PlatformViewsController;
 import io.flutter.view.AccessibilityBridge;
 import io.flutter.view.FlutterCallbackInformation;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.Locale;
@@ -117,6 +118,17 @@ public class FlutterJNI {
     FlutterJNI.nativePrefetchDefaultFontManager();
   }
 
+  /**
+   * Starts the Dart VM service if its startup was deferred with the {@code
+   * --defer-service-isolate-startup} flag, for example when tooling is about to attach. Does
+   * nothing otherwise, or if it was already started.
+   */
+  public void startDeferredServiceIsolate() {
+    nativeStartDeferredServiceIsolate();
+  }
+
+  private static native void nativeStartDeferredServiceIsolate();
+
   /**
    * Perform one time initialization of the Dart VM and Flutter engine.
    *
@@ -633,6 +645,27 @@ public class FlutterJNI {
   private native void nativeRegisterTexture(
       long nativePlatformViewId, long textureId, @NonNull SurfaceTextureWrapper textureWrapper);
 
+  /**
+   * Registers a texture whose frames are the images queued to the returned {@link Surface}, like
+   * the output of a {@code MediaCodec} or of a camera.
+   *
+   * <p>The frames are imported as hardware buffers without any JNI call per frame. This requires
+   * API level 26 and OpenGL ES rendering.
+   *
+   * @return The {@link Surface} to queue the frames to, or null if this type of texture is not
+   *     supported.
+   */
+  @UiThread
+  @Nullable
+  public Surface registerImageTexture(long textureId, int width, int height) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    return nativeRegisterImageTexture(nativePlatformViewId, textureId, width, height);
+  }
+
+  private native Surface nativeRegisterImageTexture(
+      long nativePlatformViewId, long textureId, int width, int height);
+
   /**
    * Call this method to inform Flutter that a texture previously registered with {@link
    * #registerTexture(long, SurfaceTexture)} has a new frame available.
@@ -899,6 +932,77 @@ public class FlutterJNI {
     platformViewsController.onEndFrame();
   }
 
+  // The commands of a frame transaction. Must match platform_view_android_jni_impl.cc.
+  private static final int DISPLAY_PLATFORM_VIEW_COMMAND = 0;
+  private static final int DISPLAY_OVERLAY_SURFACE_COMMAND = 1;
+  private static final int TRANSFORM_MUTATOR = 0;
+  private static final int CLIP_RECT_MUTATOR = 1;
+
+  /**
+   * Displays the platform views and overlay surfaces of a frame, then ends the frame.
+   *
+   * <p>The {@code transaction} batches the calls to {@link #onDisplayPlatformView} and {@link
+   * #onDisplayOverlaySurface} of the frame into a single call from native. It is encoded in
+   * platform_view_android_jni_impl.cc.
+   */
+  @SuppressWarnings("unused")
+  @UiThread
+  public void onEndFrameWithTransaction(@NonNull ByteBuffer transaction) {
+    ensureRunningOnMainThread();
+    transaction.order(ByteOrder.LITTLE_ENDIAN);
+    while (transaction.hasRemaining()) {
+      int command = transaction.getInt();
+      switch (command) {
+        case DISPLAY_PLATFORM_VIEW_COMMAND:
+          {
+            int viewId = transaction.getInt();
+            int x = transaction.getInt();
+            int y = transaction.getInt();
+            int width = transaction.getInt();
+            int height = transaction.getInt();
+            int viewWidth = transaction.getInt();
+            int viewHeight = transaction.getInt();
+            FlutterMutatorsStack mutatorsStack = new FlutterMutatorsStack();
+            int mutatorCount = transaction.getInt();
+            for (int i = 0; i < mutatorCount; i++) {
+              int mutator = transaction.getInt();
+              if (mutator == TRANSFORM_MUTATOR) {
+                float[] matrix = new float[9];
+                for (int j = 0; j < matrix.length; j++) {
+                  matrix[j] = transaction.getFloat();
+                }
+                mutatorsStack.pushTransform(matrix);
+              } else if (mutator == CLIP_RECT_MUTATOR) {
+                int left = transaction.getInt();
+                int top = transaction.getInt();
+                int right = transaction.getInt();
+                int bottom = transaction.getInt();
+                mutatorsStack.pushClipRect(left, top, right, bottom);
+              } else {
+                throw new IllegalStateException("Unknown mutator " + mutator);
+              }
+            }
+            onDisplayPlatformView(
+                viewId, x, y, width, height, viewWidth, viewHeight, mutatorsStack);
+            break;
+          }
+        case DISPLAY_OVERLAY_SURFACE_COMMAND:
+          {
+            int id = transaction.getInt();
+            int x = transaction.getInt();
+            int y = transaction.getInt();
+            int width = transaction.getInt();
+            int height = transaction.getInt();
+            onDisplayOverlaySurface(id, x, y, width, height);
+            break;
+          }
+        default:
+          throw new IllegalStateException("Unknown frame transaction command " + command);
+      }
+    }
+    onEndFrame();
+  }
+
   @SuppressWarnings("unused")
   @UiThread
   public FlutterOverlaySurface createOverlaySurface() {
@@ -1028,6 +1132,20 @@ public class FlutterJNI {
 
   private native void nativeNotifyLowMemoryWarning(long nativePlatformViewId);
 
+  /**
+   * Notifies the engine of memory pressure. Under moderate pressure, the engine only trims its
+   * caches so that the next frames stay fast. Critical pressure is handled like {@link
+   * #notifyLowMemoryWarning()}.
+   */
+  @UiThread
+  public void notifyMemoryPressure(boolean critical) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeNotifyMemoryPressure(nativePlatformViewId, critical);
+  }
+
+  private native void nativeNotifyMemoryPressure(long nativePlatformViewId, boolean critical);
+
   private void ensureRunningOnMainThread() {
     if (Looper.myLooper() != mainLooper) {
       throw new RuntimeException(
@@ -28,6 +28,10 @@ public class FlutterShellArgs {
   public static final String ARG_DISABLE_SERVICE_AUTH_CODES = "--disable-service-auth-codes";
   public static final String ARG_KEY_ENDLESS_TRACE_BUFFER = "endless-trace-buffer";
   public static final String ARG_ENDLESS_TRACE_BUFFER = "--endless-trace-buffer";
+  public static final String ARG_KEY_DEFER_SERVICE_ISOLATE_STARTUP =
+      "defer-service-isolate-startup";
+  public static final String ARG_DEFER_SERVICE_ISOLATE_STARTUP =
+      "--defer-service-isolate-startup";
   public static final String ARG_KEY_USE_TEST_FONTS = "use-test-fonts";
   public static final String ARG_USE_TEST_FONTS = "--use-test-fonts";
   public static final String ARG_KEY_ENABLE_DART_PROFILING = "enable-dart-profiling";
@@ -38,6 +42,8 @@ public class FlutterShellArgs {
   public static final String ARG_SKIA_DETERMINISTIC_RENDERING = "--skia-deterministic-rendering";
   public static final String ARG_KEY_TRACE_SKIA = "trace-skia";
   public static final String ARG_TRACE_SKIA = "--trace-skia";
+  public static final String ARG_KEY_TRACE_SKIA_ALLOWLIST = "trace-skia-allowlist";
+  public static final String ARG_TRACE_SKIA_ALLOWLIST = "--trace-skia-allowlist=";
   public static final String ARG_KEY_TRACE_SYSTRACE = "trace-systrace";
   public static final String ARG_TRACE_SYSTRACE = "--trace-systrace";
   public static final String ARG_KEY_DUMP_SHADER_SKP_ON_SHADER_COMPILATION =
@@ -77,6 +83,9 @@ public class FlutterShellArgs {
     if (intent.getBooleanExtra(ARG_KEY_DISABLE_SERVICE_AUTH_CODES, false)) {
       args.add(ARG_DISABLE_SERVICE_AUTH_CODES);
     }
+    if (intent.getBooleanExtra(ARG_KEY_DEFER_SERVICE_ISOLATE_STARTUP, false)) {
+      args.add(ARG_DEFER_SERVICE_ISOLATE_STARTUP);
+    }
     if (intent.getBooleanExtra(ARG_KEY_ENDLESS_TRACE_BUFFER, false)) {
       args.add(ARG_ENDLESS_TRACE_BUFFER);
     }
@@ -95,6 +104,9 @@ public class FlutterShellArgs {
     if (intent.getBooleanExtra(ARG_KEY_TRACE_SKIA, false)) {
       args.add(ARG_TRACE_SKIA);
     }
+    if (intent.hasExtra(ARG_KEY_TRACE_SKIA_ALLOWLIST)) {
+      args.add(ARG_TRACE_SKIA_ALLOWLIST + intent.getStringExtra(ARG_KEY_TRACE_SKIA_ALLOWLIST));
+    }
     if (intent.getBooleanExtra(ARG_KEY_TRACE_SYSTRACE, false)) {
       args.add(ARG_TRACE_SYSTRACE);
     }
@@ -246,6 +246,16 @@ public class DartExecutor implements BinaryMessenger {
     }
   }
 
+  /**
+   * Notify the engine of memory pressure. Under moderate pressure, the engine only trims its caches
+   * instead of freeing every resource it can recreate like {@link #notifyLowMemoryWarning()}.
+   */
+  public void notifyMemoryPressure(boolean critical) {
+    if (flutterJNI.isAttached()) {
+      flutterJNI.notifyMemoryPressure(critical);
+    }
+  }
+
   /**
    * Configuration options that specify which Dart entrypoint function is executed and where to find
    * that entrypoint and other assets required for Dart execution.
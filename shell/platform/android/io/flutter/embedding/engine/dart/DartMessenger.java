@@ -85,13 +85,13 @@ class DartMessenger implements BinaryMessenger, PlatformMessageHandler {
         handler.onMessage(buffer, new Reply(flutterJNI, replyId));
       } catch (Exception ex) {
         Log.e(TAG, "Uncaught exception in binary message listener", ex);
-        flutterJNI.invokePlatformMessageEmptyResponseCallback(replyId);
+        replyEmpty(flutterJNI, replyId);
       } catch (Error err) {
         handleError(err);
       }
     } else {
       Log.v(TAG, "No registered handler for message. Responding to Dart with empty reply message.");
-      flutterJNI.invokePlatformMessageEmptyResponseCallback(replyId);
+      replyEmpty(flutterJNI, replyId);
     }
   }
 
@@ -139,6 +139,16 @@ class DartMessenger implements BinaryMessenger, PlatformMessageHandler {
     currentThread.getUncaughtExceptionHandler().uncaughtException(currentThread, err);
   }
 
+  /**
+   * Sends an empty reply to a message from Dart, unless Dart did not wait for a reply, in which
+   * case the message has a {@code replyId} of 0.
+   */
+  private static void replyEmpty(@NonNull FlutterJNI flutterJNI, int replyId) {
+    if (replyId != 0) {
+      flutterJNI.invokePlatformMessageEmptyResponseCallback(replyId);
+    }
+  }
+
   static class Reply implements BinaryMessenger.BinaryReply {
     @NonNull private final FlutterJNI flutterJNI;
     private final int replyId;
@@ -154,6 +164,10 @@ class DartMessenger implements BinaryMessenger, PlatformMessageHandler {
       if (done.getAndSet(true)) {
         throw new IllegalStateException("Reply already submitted");
       }
+      if (replyId == 0) {
+        // Dart did not wait for a reply to this message.
+        return;
+      }
       if (reply == null) {
         flutterJNI.invokePlatformMessageEmptyResponseCallback(replyId);
       } else {
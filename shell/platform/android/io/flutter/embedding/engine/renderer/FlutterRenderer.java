@@ -169,6 +169,60 @@ public class FlutterRenderer implements TextureRegistry {
       released = true;
     }
   }
+
+  /**
+   * Creates a texture whose frames are the images queued to a {@link Surface}, which Flutter
+   * samples without copying them. Returns null before API level 26 or when Flutter does not render
+   * with OpenGL ES.
+   */
+  @Override
+  @Nullable
+  public ImageTextureEntry createImageTexture(int width, int height) {
+    if (Build.VERSION.SDK_INT < Build.VERSION_CODES.O) {
+      return null;
+    }
+    Log.v(TAG, "Creating an image texture.");
+    final long id = nextTextureId.getAndIncrement();
+    final Surface surface = flutterJNI.registerImageTexture(id, width, height);
+    if (surface == null) {
+      return null;
+    }
+    Log.v(TAG, "New image texture ID: " + id);
+    return new ImageTextureRegistryEntry(id, surface);
+  }
+
+  final class ImageTextureRegistryEntry implements TextureRegistry.ImageTextureEntry {
+    private final long id;
+    @NonNull private final Surface surface;
+    private boolean released;
+
+    ImageTextureRegistryEntry(long id, @NonNull Surface surface) {
+      this.id = id;
+      this.surface = surface;
+    }
+
+    @Override
+    @NonNull
+    public Surface surface() {
+      return surface;
+    }
+
+    @Override
+    public long id() {
+      return id;
+    }
+
+    @Override
+    public void release() {
+      if (released) {
+        return;
+      }
+      Log.v(TAG, "Releasing an image texture (" + id + ").");
+      surface.release();
+      unregisterTexture(id);
+      released = true;
+    }
+  }
   // ------ END TextureRegistry IMPLEMENTATION ----
 
   /**
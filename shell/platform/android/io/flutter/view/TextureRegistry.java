@@ -5,6 +5,9 @@
 package io.flutter.view;
 
 import android.graphics.SurfaceTexture;
+import android.view.Surface;
+import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
 
 // TODO(mattcarroll): re-evalute docs in this class and add nullability annotations.
 /**
@@ -20,6 +23,21 @@ public interface TextureRegistry {
    */
   SurfaceTextureEntry createSurfaceTexture();
 
+  /**
+   * Creates and registers a texture whose frames are the images queued to a {@link Surface}.
+   *
+   * <p>Unlike a {@link SurfaceTexture}, the frames are not updated through JNI calls on the raster
+   * thread, which makes this cheaper for video players and cameras. This requires API level 26.
+   *
+   * @param width The default width of the frames.
+   * @param height The default height of the frames.
+   * @return An ImageTextureEntry, or null if this type of texture is not supported.
+   */
+  @Nullable
+  default ImageTextureEntry createImageTexture(int width, int height) {
+    return null;
+  }
+
   /** A registry entry for a managed SurfaceTexture. */
   interface SurfaceTextureEntry {
     /** @return The managed SurfaceTexture. */
@@ -31,4 +49,17 @@ public interface TextureRegistry {
     /** Deregisters and releases this SurfaceTexture. */
     void release();
   }
+
+  /** A registry entry for a texture created with {@link #createImageTexture(int, int)}. */
+  interface ImageTextureEntry {
+    /** @return The Surface that frames are queued to. */
+    @NonNull
+    Surface surface();
+
+    /** @return The identity of this texture. */
+    long id();
+
+    /** Deregisters and releases this texture. */
+    void release();
+  }
 }
@@ -12,6 +12,7 @@
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "flutter/shell/platform/android/android_context_gl.h"
 #include "flutter/shell/platform/android/android_external_texture_gl.h"
+#include "flutter/shell/platform/android/android_hardware_buffer_texture_gl.h"
 #include "flutter/shell/platform/android/android_surface_gl.h"
 #include "flutter/shell/platform/android/android_surface_software.h"
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
@@ -30,8 +31,9 @@ namespace flutter {
 
 AndroidSurfaceFactoryImpl::AndroidSurfaceFactoryImpl(
     const AndroidContext& context,
-    std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
-    : android_context_(context), jni_facade_(jni_facade) {}
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+    const Settings& settings)
+    : android_context_(context), jni_facade_(jni_facade), settings_(settings) {}
 
 AndroidSurfaceFactoryImpl::~AndroidSurfaceFactoryImpl() = default;
 
@@ -45,7 +47,7 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
     case AndroidRenderingAPI::kVulkan:
 #if SHELL_ENABLE_VULKAN
       return std::make_unique<AndroidSurfaceVulkan>(android_context_,
-                                                    jni_facade_);
+                                                    jni_facade_, settings_);
 #endif  // SHELL_ENABLE_VULKAN
     default:
       return nullptr;
@@ -57,11 +59,11 @@ PlatformViewAndroid::PlatformViewAndroid(
     PlatformView::Delegate& delegate,
     flutter::TaskRunners task_runners,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-    bool use_software_rendering)
+    const Settings& settings)
     : PlatformView(delegate, std::move(task_runners)),
       jni_facade_(jni_facade),
       platform_view_android_delegate_(jni_facade) {
-  if (use_software_rendering) {
+  if (settings.enable_software_rendering) {
     android_context_ =
         std::make_unique<AndroidContext>(AndroidRenderingAPI::kSoftware);
   } else {
@@ -78,7 +80,7 @@ PlatformViewAndroid::PlatformViewAndroid(
       << "Could not create an Android context.";
 
   surface_factory_ = std::make_shared<AndroidSurfaceFactoryImpl>(
-      *android_context_, jni_facade);
+      *android_context_, jni_facade, settings);
 
   android_surface_ = surface_factory_->CreateSurface();
   FML_CHECK(android_surface_ && android_surface_->IsValid())
@@ -274,6 +276,22 @@ void PlatformViewAndroid::UpdateSemantics(
   platform_view_android_delegate_.UpdateSemantics(update, actions);
 }
 
+void PlatformViewAndroid::PostSemanticsUpdate(
+    flutter::SemanticsNodeUpdates update,
+    flutter::CustomAccessibilityActionUpdates actions) {
+  // Encoding large trees is costly, so it is done here on the UI thread while
+  // only the JNI call is made on the platform thread.
+  using EncodedSemantics = PlatformViewAndroidDelegate::EncodedSemantics;
+  auto encoded = std::make_shared<EncodedSemantics>(
+      PlatformViewAndroidDelegate::EncodeSemantics(update, actions));
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [view = GetWeakPtr(), this, encoded = std::move(encoded)]() {
+        if (view) {
+          platform_view_android_delegate_.UpdateSemantics(*encoded);
+        }
+      });
+}
+
 void PlatformViewAndroid::RegisterExternalTexture(
     int64_t texture_id,
     const fml::jni::JavaObjectWeakGlobalRef& surface_texture) {
@@ -281,9 +299,45 @@ void PlatformViewAndroid::RegisterExternalTexture(
       texture_id, surface_texture, std::move(jni_facade_)));
 }
 
+jobject PlatformViewAndroid::RegisterHardwareBufferTexture(
+    JNIEnv* env,
+    int64_t texture_id,
+    const SkISize& size) {
+  if (android_context_->RenderingApi() != AndroidRenderingAPI::kOpenGLES) {
+    return nullptr;
+  }
+  // The frames are queued on a thread of the image reader.
+  auto task_runner = task_runners_.GetPlatformTaskRunner();
+  auto on_frame_available = [platform_view = GetWeakPtr(), task_runner,
+                             texture_id]() {
+    task_runner->PostTask([platform_view, texture_id]() {
+      if (platform_view) {
+        platform_view->MarkTextureFrameAvailable(texture_id);
+      }
+    });
+  };
+  auto texture = AndroidHardwareBufferTextureGL::Create(texture_id, size,
+                                                        on_frame_available);
+  if (!texture) {
+    return nullptr;
+  }
+  jobject surface = texture->CreateSurface(env);
+  if (surface == nullptr) {
+    return nullptr;
+  }
+  RegisterTexture(std::move(texture));
+  return surface;
+}
+
+void PlatformViewAndroid::SetOnRefreshRateChanged(
+    VsyncWaiterAndroid::RefreshRateCallback on_refresh_rate_changed) {
+  on_refresh_rate_changed_ = std::move(on_refresh_rate_changed);
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewAndroid::CreateVSyncWaiter() {
-  return std::make_unique<VsyncWaiterAndroid>(task_runners_);
+  return std::make_unique<VsyncWaiterAndroid>(task_runners_,
+                                              on_refresh_rate_changed_);
 }
 
 // |PlatformView|
@@ -294,6 +348,13 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
   return android_surface_->CreateGPUSurface();
 }
 
+// |PlatformView|
+void PlatformViewAndroid::PrewarmGPUContext() {
+  if (android_surface_) {
+    android_surface_->PrewarmGPUContext();
+  }
+}
+
 // |PlatformView|
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
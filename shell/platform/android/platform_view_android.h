@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/platform/android/jni_weak_ref.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
@@ -20,13 +21,15 @@
 #include "flutter/shell/platform/android/platform_view_android_delegate/platform_view_android_delegate.h"
 #include "flutter/shell/platform/android/surface/android_native_window.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
+#include "flutter/shell/platform/android/vsync_waiter_android.h"
 
 namespace flutter {
 
 class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
  public:
   AndroidSurfaceFactoryImpl(const AndroidContext& context,
-                            std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+                            std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
+                            const Settings& settings);
 
   ~AndroidSurfaceFactoryImpl() override;
 
@@ -35,6 +38,7 @@ class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
  private:
   const AndroidContext& android_context_;
   std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
+  const Settings settings_;
 };
 
 class PlatformViewAndroid final : public PlatformView {
@@ -51,7 +55,7 @@ class PlatformViewAndroid final : public PlatformView {
   PlatformViewAndroid(PlatformView::Delegate& delegate,
                       flutter::TaskRunners task_runners,
                       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-                      bool use_software_rendering);
+                      const Settings& settings);
 
   ~PlatformViewAndroid() override;
 
@@ -93,6 +97,27 @@ class PlatformViewAndroid final : public PlatformView {
       int64_t texture_id,
       const fml::jni::JavaObjectWeakGlobalRef& surface_texture);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a texture whose frames are the hardware buffers
+  ///             queued to the returned surface, see
+  ///             |AndroidHardwareBufferTextureGL|.
+  ///
+  /// @return     A local reference to the Java `Surface` producers queue
+  ///             their frames to, or nullptr if hardware buffer textures are
+  ///             not supported by the device or the rendering API.
+  ///
+  jobject RegisterHardwareBufferTexture(JNIEnv* env,
+                                        int64_t texture_id,
+                                        const SkISize& size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the callback the vsync waiter calls on the UI thread
+  ///             when the refresh rate of the display changes. Must be called
+  ///             before the shell creates the vsync waiter.
+  ///
+  void SetOnRefreshRateChanged(
+      VsyncWaiterAndroid::RefreshRateCallback on_refresh_rate_changed);
+
  private:
   const std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
   std::unique_ptr<AndroidContext> android_context_;
@@ -101,6 +126,7 @@ class PlatformViewAndroid final : public PlatformView {
   PlatformViewAndroidDelegate platform_view_android_delegate_;
 
   std::unique_ptr<AndroidSurface> android_surface_;
+  VsyncWaiterAndroid::RefreshRateCallback on_refresh_rate_changed_;
   // We use id 0 to mean that no response is expected.
   int next_response_id_ = 1;
   std::unordered_map<int, fml::RefPtr<flutter::PlatformMessageResponse>>
@@ -111,6 +137,11 @@ class PlatformViewAndroid final : public PlatformView {
       flutter::SemanticsNodeUpdates update,
       flutter::CustomAccessibilityActionUpdates actions) override;
 
+  // |PlatformView|
+  void PostSemanticsUpdate(
+      flutter::SemanticsNodeUpdates update,
+      flutter::CustomAccessibilityActionUpdates actions) override;
+
   // |PlatformView|
   void HandlePlatformMessage(
       fml::RefPtr<flutter::PlatformMessage> message) override;
@@ -124,6 +155,9 @@ class PlatformViewAndroid final : public PlatformView {
   // |PlatformView|
   std::unique_ptr<Surface> CreateRenderingSurface() override;
 
+  // |PlatformView|
+  void PrewarmGPUContext() override;
+
   // |PlatformView|
   std::shared_ptr<ExternalViewEmbedder> CreateExternalViewEmbedder() override;
 
@@ -13,6 +13,14 @@ PlatformViewAndroidDelegate::PlatformViewAndroidDelegate(
 void PlatformViewAndroidDelegate::UpdateSemantics(
     flutter::SemanticsNodeUpdates update,
     flutter::CustomAccessibilityActionUpdates actions) {
+  UpdateSemantics(EncodeSemantics(update, actions));
+}
+
+PlatformViewAndroidDelegate::EncodedSemantics
+PlatformViewAndroidDelegate::EncodeSemantics(
+    const flutter::SemanticsNodeUpdates& update,
+    const flutter::CustomAccessibilityActionUpdates& actions) {
+  EncodedSemantics encoded;
   constexpr size_t kBytesPerNode = 41 * sizeof(int32_t);
   constexpr size_t kBytesPerChild = sizeof(int32_t);
   constexpr size_t kBytesPerAction = 4 * sizeof(int32_t);
@@ -35,11 +43,12 @@ void PlatformViewAndroidDelegate::UpdateSemantics(
     //
     // If any of the encoding structure or length is changed, those locations
     // must be updated (at a minimum).
-    std::vector<uint8_t> buffer(num_bytes);
+    std::vector<uint8_t>& buffer = encoded.buffer;
+    buffer.resize(num_bytes);
     int32_t* buffer_int32 = reinterpret_cast<int32_t*>(&buffer[0]);
     float* buffer_float32 = reinterpret_cast<float*>(&buffer[0]);
 
-    std::vector<std::string> strings;
+    std::vector<std::string>& strings = encoded.strings;
     size_t position = 0;
     for (const auto& value : update) {
       // If you edit this code, make sure you update kBytesPerNode
@@ -114,11 +123,12 @@ void PlatformViewAndroidDelegate::UpdateSemantics(
 
     // custom accessibility actions.
     size_t num_action_bytes = actions.size() * kBytesPerAction;
-    std::vector<uint8_t> actions_buffer(num_action_bytes);
+    std::vector<uint8_t>& actions_buffer = encoded.actions_buffer;
+    actions_buffer.resize(num_action_bytes);
     int32_t* actions_buffer_int32 =
         reinterpret_cast<int32_t*>(&actions_buffer[0]);
 
-    std::vector<std::string> action_strings;
+    std::vector<std::string>& action_strings = encoded.action_strings;
     size_t actions_position = 0;
     for (const auto& value : actions) {
       // If you edit this code, make sure you update kBytesPerAction
@@ -140,17 +150,21 @@ void PlatformViewAndroidDelegate::UpdateSemantics(
         action_strings.push_back(action.hint);
       }
     }
+  }
+  return encoded;
+}
 
-    // Calling NewDirectByteBuffer in API level 22 and below with a size of zero
-    // will cause a JNI crash.
-    if (actions_buffer.size() > 0) {
-      jni_facade_->FlutterViewUpdateCustomAccessibilityActions(actions_buffer,
-                                                               action_strings);
-    }
+void PlatformViewAndroidDelegate::UpdateSemantics(
+    const EncodedSemantics& encoded) {
+  // Calling NewDirectByteBuffer in API level 22 and below with a size of zero
+  // will cause a JNI crash.
+  if (encoded.actions_buffer.size() > 0) {
+    jni_facade_->FlutterViewUpdateCustomAccessibilityActions(
+        encoded.actions_buffer, encoded.action_strings);
+  }
 
-    if (buffer.size() > 0) {
-      jni_facade_->FlutterViewUpdateSemantics(buffer, strings);
-    }
+  if (encoded.buffer.size() > 0) {
+    jni_facade_->FlutterViewUpdateSemantics(encoded.buffer, encoded.strings);
   }
 }
 
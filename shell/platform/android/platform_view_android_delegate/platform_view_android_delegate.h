@@ -16,11 +16,27 @@ namespace flutter {
 
 class PlatformViewAndroidDelegate {
  public:
+  // Semantics updates in the encoding of the accessibility bridge.
+  struct EncodedSemantics {
+    std::vector<uint8_t> buffer;
+    std::vector<std::string> strings;
+    std::vector<uint8_t> actions_buffer;
+    std::vector<std::string> action_strings;
+  };
+
   PlatformViewAndroidDelegate(
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
   void UpdateSemantics(flutter::SemanticsNodeUpdates update,
                        flutter::CustomAccessibilityActionUpdates actions);
 
+  // Encodes semantics updates. Unlike sending them, this may be done on any
+  // thread.
+  static EncodedSemantics EncodeSemantics(
+      const flutter::SemanticsNodeUpdates& update,
+      const flutter::CustomAccessibilityActionUpdates& actions);
+
+  void UpdateSemantics(const EncodedSemantics& encoded);
+
  private:
   const std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
 };
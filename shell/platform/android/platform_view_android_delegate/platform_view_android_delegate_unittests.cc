@@ -93,5 +93,29 @@ TEST(PlatformViewShell,
   delegate->UpdateSemantics(update, actions);
 }
 
+TEST(PlatformViewShell, EncodedSemanticsCanBeSentLater) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto delegate = std::make_unique<PlatformViewAndroidDelegate>(jni_mock);
+
+  flutter::SemanticsNodeUpdates update;
+  flutter::SemanticsNode node0;
+  node0.id = 0;
+  node0.label = "label";
+  update.insert(std::make_pair(0, std::move(node0)));
+  flutter::CustomAccessibilityActionUpdates actions;
+
+  auto encoded = PlatformViewAndroidDelegate::EncodeSemantics(update, actions);
+  ASSERT_EQ(encoded.buffer.size(), 164u);
+  ASSERT_EQ(encoded.strings, std::vector<std::string>{"label"});
+  ASSERT_TRUE(encoded.actions_buffer.empty());
+
+  EXPECT_CALL(*jni_mock,
+              FlutterViewUpdateSemantics(encoded.buffer, encoded.strings));
+  EXPECT_CALL(*jni_mock, FlutterViewUpdateCustomAccessibilityActions(
+                             ::testing::_, ::testing::_))
+      .Times(0);
+  delegate->UpdateSemantics(encoded);
+}
+
 }  // namespace testing
 }  // namespace flutter
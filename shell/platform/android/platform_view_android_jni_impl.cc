@@ -6,6 +6,7 @@
 
 #include <android/native_window_jni.h>
 #include <jni.h>
+#include <cstring>
 #include <utility>
 
 #include "unicode/uchar.h"
@@ -100,23 +101,12 @@ static jmethodID g_detach_from_gl_context_method = nullptr;
 
 static jmethodID g_compute_platform_resolved_locale_method = nullptr;
 
-// Called By Java
-static jmethodID g_on_display_platform_view_method = nullptr;
-
-// static jmethodID g_on_composite_platform_view_method = nullptr;
-
-static jmethodID g_on_display_overlay_surface_method = nullptr;
+static jmethodID g_on_end_frame_with_transaction_method = nullptr;
 
 static jmethodID g_overlay_surface_id_method = nullptr;
 
 static jmethodID g_overlay_surface_surface_method = nullptr;
 
-// Mutators
-static fml::jni::ScopedJavaGlobalRef<jclass>* g_mutators_stack_class = nullptr;
-static jmethodID g_mutators_stack_init_method = nullptr;
-static jmethodID g_mutators_stack_push_transform_method = nullptr;
-static jmethodID g_mutators_stack_push_cliprect_method = nullptr;
-
 // Called By Java
 static jlong AttachJNI(JNIEnv* env,
                        jclass clazz,
@@ -433,6 +423,19 @@ static void RegisterTexture(JNIEnv* env,
   );
 }
 
+static jobject RegisterImageTexture(JNIEnv* env,
+                                    jobject jcaller,
+                                    jlong shell_holder,
+                                    jlong texture_id,
+                                    jint width,
+                                    jint height) {
+  return ANDROID_SHELL_HOLDER->GetPlatformView()->RegisterHardwareBufferTexture(
+      env,                               //
+      static_cast<int64_t>(texture_id),  //
+      SkISize::Make(width, height)       //
+  );
+}
+
 static void MarkTextureFrameAvailable(JNIEnv* env,
                                       jobject jcaller,
                                       jlong shell_holder,
@@ -479,6 +482,15 @@ static void NotifyLowMemoryWarning(JNIEnv* env,
   ANDROID_SHELL_HOLDER->NotifyLowMemoryWarning();
 }
 
+static void NotifyMemoryPressure(JNIEnv* env,
+                                 jobject obj,
+                                 jlong shell_holder,
+                                 jboolean critical) {
+  ANDROID_SHELL_HOLDER->NotifyLowMemoryWarning(
+      critical ? MemoryPressureLevel::kCritical
+               : MemoryPressureLevel::kModerate);
+}
+
 static jboolean FlutterTextUtilsIsEmoji(JNIEnv* env,
                                         jobject obj,
                                         jint codePoint) {
@@ -554,6 +566,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(J)V",
           .fnPtr = reinterpret_cast<void*>(&NotifyLowMemoryWarning),
       },
+      {
+          .name = "nativeNotifyMemoryPressure",
+          .signature = "(JZ)V",
+          .fnPtr = reinterpret_cast<void*>(&NotifyMemoryPressure),
+      },
 
       // Start of methods from FlutterView
       {
@@ -617,6 +634,11 @@ bool RegisterApi(JNIEnv* env) {
                        "SurfaceTextureWrapper;)V",
           .fnPtr = reinterpret_cast<void*>(&RegisterTexture),
       },
+      {
+          .name = "nativeRegisterImageTexture",
+          .signature = "(JJII)Landroid/view/Surface;",
+          .fnPtr = reinterpret_cast<void*>(&RegisterImageTexture),
+      },
       {
           .name = "nativeMarkTextureFrameAvailable",
           .signature = "(JJ)V",
@@ -792,48 +814,6 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
-  g_mutators_stack_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
-      env,
-      env->FindClass(
-          "io/flutter/embedding/engine/mutatorsstack/FlutterMutatorsStack"));
-  if (g_mutators_stack_class == nullptr) {
-    FML_LOG(ERROR) << "Could not locate FlutterMutatorsStack";
-    return false;
-  }
-
-  g_mutators_stack_init_method =
-      env->GetMethodID(g_mutators_stack_class->obj(), "<init>", "()V");
-  if (g_mutators_stack_init_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate FlutterMutatorsStack.init method";
-    return false;
-  }
-
-  g_mutators_stack_push_transform_method =
-      env->GetMethodID(g_mutators_stack_class->obj(), "pushTransform", "([F)V");
-  if (g_mutators_stack_push_transform_method == nullptr) {
-    FML_LOG(ERROR)
-        << "Could not locate FlutterMutatorsStack.pushTransform method";
-    return false;
-  }
-
-  g_mutators_stack_push_cliprect_method = env->GetMethodID(
-      g_mutators_stack_class->obj(), "pushClipRect", "(IIII)V");
-  if (g_mutators_stack_push_cliprect_method == nullptr) {
-    FML_LOG(ERROR)
-        << "Could not locate FlutterMutatorsStack.pushCilpRect method";
-    return false;
-  }
-
-  g_on_display_platform_view_method =
-      env->GetMethodID(g_flutter_jni_class->obj(), "onDisplayPlatformView",
-                       "(IIIIIIILio/flutter/embedding/engine/mutatorsstack/"
-                       "FlutterMutatorsStack;)V");
-
-  if (g_on_display_platform_view_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onDisplayPlatformView method";
-    return false;
-  }
-
   g_on_begin_frame_method =
       env->GetMethodID(g_flutter_jni_class->obj(), "onBeginFrame", "()V");
 
@@ -850,11 +830,12 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
-  g_on_display_overlay_surface_method = env->GetMethodID(
-      g_flutter_jni_class->obj(), "onDisplayOverlaySurface", "(IIIII)V");
+  g_on_end_frame_with_transaction_method =
+      env->GetMethodID(g_flutter_jni_class->obj(), "onEndFrameWithTransaction",
+                       "(Ljava/nio/ByteBuffer;)V");
 
-  if (g_on_display_overlay_surface_method == nullptr) {
-    FML_LOG(ERROR) << "Could not locate onDisplayOverlaySurface method";
+  if (g_on_end_frame_with_transaction_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate onEndFrameWithTransaction method";
     return false;
   }
 
@@ -931,10 +912,10 @@ void PlatformViewAndroidJNIImpl::FlutterViewHandlePlatformMessage(
 
   if (message->hasData()) {
     fml::jni::ScopedJavaLocalRef<jbyteArray> message_array(
-        env, env->NewByteArray(message->data().size()));
+        env, env->NewByteArray(message->data().GetSize()));
     env->SetByteArrayRegion(
-        message_array.obj(), 0, message->data().size(),
-        reinterpret_cast<const jbyte*>(message->data().data()));
+        message_array.obj(), 0, message->data().GetSize(),
+        reinterpret_cast<const jbyte*>(message->data().GetMapping()));
     env->CallVoidMethod(java_object.obj(), g_handle_platform_message_method,
                         java_channel.obj(), message_array.obj(), responseId);
   } else {
@@ -1139,6 +1120,34 @@ void PlatformViewAndroidJNIImpl::SurfaceTextureDetachFromGLContext(
   FML_CHECK(CheckException(env));
 }
 
+// The commands of a frame transaction, which batches the platform views and
+// overlay surfaces displayed in a frame into a single JNI call when the frame
+// ends. The values must match the ones decoded by
+// FlutterJNI#onEndFrameWithTransaction.
+enum FrameTransactionCommand : int32_t {
+  kDisplayPlatformView = 0,
+  kDisplayOverlaySurface = 1,
+};
+
+enum FrameTransactionMutator : int32_t {
+  kTransformMutator = 0,
+  kClipRectMutator = 1,
+};
+
+// The transaction is read as a little endian ByteBuffer, which is the byte
+// order of the devices Android runs on.
+static void AppendToTransaction(std::vector<uint8_t>& transaction,
+                                int32_t value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  transaction.insert(transaction.end(), bytes, bytes + sizeof(value));
+}
+
+static void AppendToTransaction(std::vector<uint8_t>& transaction,
+                                float value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  transaction.insert(transaction.end(), bytes, bytes + sizeof(value));
+}
+
 void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int view_id,
     int x,
@@ -1148,14 +1157,15 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int viewWidth,
     int viewHeight,
     MutatorsStack mutators_stack) {
-  JNIEnv* env = fml::jni::AttachCurrentThread();
-  auto java_object = java_object_.get(env);
-  if (java_object.is_null()) {
-    return;
+  for (int32_t value : {static_cast<int32_t>(kDisplayPlatformView), view_id, x,
+                        y, width, height, viewWidth, viewHeight}) {
+    AppendToTransaction(frame_transaction_, value);
   }
 
-  jobject mutatorsStack = env->NewObject(g_mutators_stack_class->obj(),
-                                         g_mutators_stack_init_method);
+  // The count is written once the mutators that can be sent are known.
+  const size_t mutator_count_offset = frame_transaction_.size();
+  int32_t mutator_count = 0;
+  AppendToTransaction(frame_transaction_, mutator_count);
 
   std::vector<std::shared_ptr<Mutator>>::const_iterator iter =
       mutators_stack.Begin();
@@ -1165,21 +1175,23 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
         const SkMatrix& matrix = (*iter)->GetMatrix();
         SkScalar matrix_array[9];
         matrix.get9(matrix_array);
-        fml::jni::ScopedJavaLocalRef<jfloatArray> transformMatrix(
-            env, env->NewFloatArray(9));
-
-        env->SetFloatArrayRegion(transformMatrix.obj(), 0, 9, matrix_array);
-        env->CallVoidMethod(mutatorsStack,
-                            g_mutators_stack_push_transform_method,
-                            transformMatrix.obj());
+        AppendToTransaction(frame_transaction_,
+                            static_cast<int32_t>(kTransformMutator));
+        for (SkScalar value : matrix_array) {
+          AppendToTransaction(frame_transaction_, static_cast<float>(value));
+        }
+        mutator_count++;
         break;
       }
       case clip_rect: {
         const SkRect& rect = (*iter)->GetRect();
-        env->CallVoidMethod(
-            mutatorsStack, g_mutators_stack_push_cliprect_method,
-            static_cast<int>(rect.left()), static_cast<int>(rect.top()),
-            static_cast<int>(rect.right()), static_cast<int>(rect.bottom()));
+        AppendToTransaction(frame_transaction_,
+                            static_cast<int32_t>(kClipRectMutator));
+        for (SkScalar value :
+             {rect.left(), rect.top(), rect.right(), rect.bottom()}) {
+          AppendToTransaction(frame_transaction_, static_cast<int32_t>(value));
+        }
+        mutator_count++;
         break;
       }
       // TODO(cyanglaz): Implement other mutators.
@@ -1192,11 +1204,8 @@ void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     ++iter;
   }
 
-  env->CallVoidMethod(java_object.obj(), g_on_display_platform_view_method,
-                      view_id, x, y, width, height, viewWidth, viewHeight,
-                      mutatorsStack);
-
-  FML_CHECK(CheckException(env));
+  memcpy(frame_transaction_.data() + mutator_count_offset, &mutator_count,
+         sizeof(mutator_count));
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
@@ -1205,20 +1214,15 @@ void PlatformViewAndroidJNIImpl::FlutterViewDisplayOverlaySurface(
     int y,
     int width,
     int height) {
-  JNIEnv* env = fml::jni::AttachCurrentThread();
-
-  auto java_object = java_object_.get(env);
-  if (java_object.is_null()) {
-    return;
+  for (int32_t value : {static_cast<int32_t>(kDisplayOverlaySurface),
+                        surface_id, x, y, width, height}) {
+    AppendToTransaction(frame_transaction_, value);
   }
-
-  env->CallVoidMethod(java_object.obj(), g_on_display_overlay_surface_method,
-                      surface_id, x, y, width, height);
-
-  FML_CHECK(CheckException(env));
 }
 
 void PlatformViewAndroidJNIImpl::FlutterViewBeginFrame() {
+  frame_transaction_.clear();
+
   JNIEnv* env = fml::jni::AttachCurrentThread();
 
   auto java_object = java_object_.get(env);
@@ -1236,10 +1240,22 @@ void PlatformViewAndroidJNIImpl::FlutterViewEndFrame() {
 
   auto java_object = java_object_.get(env);
   if (java_object.is_null()) {
+    frame_transaction_.clear();
     return;
   }
 
-  env->CallVoidMethod(java_object.obj(), g_on_end_frame_method);
+  if (frame_transaction_.empty()) {
+    env->CallVoidMethod(java_object.obj(), g_on_end_frame_method);
+  } else {
+    // The buffer is only read for the duration of the call.
+    fml::jni::ScopedJavaLocalRef<jobject> transaction(
+        env, env->NewDirectByteBuffer(frame_transaction_.data(),
+                                      frame_transaction_.size()));
+    env->CallVoidMethod(java_object.obj(),
+                        g_on_end_frame_with_transaction_method,
+                        transaction.obj());
+    frame_transaction_.clear();
+  }
 
   FML_CHECK(CheckException(env));
 }
@@ -84,6 +84,11 @@ class PlatformViewAndroidJNIImpl final : public PlatformViewAndroidJNI {
   // Reference to FlutterJNI object.
   const fml::jni::JavaObjectWeakGlobalRef java_object_;
 
+  // The platform views and overlay surfaces displayed in the current frame,
+  // which are sent to Java in one call when the frame ends. Only accessed on
+  // the platform thread.
+  std::vector<uint8_t> frame_transaction_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewAndroidJNIImpl);
 };
 
@@ -8,4 +8,6 @@ namespace flutter {
 
 AndroidSurface::~AndroidSurface() = default;
 
+void AndroidSurface::PrewarmGPUContext() {}
+
 }  // namespace flutter
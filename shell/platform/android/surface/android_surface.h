@@ -35,6 +35,12 @@ class AndroidSurface {
   virtual bool ResourceContextClearCurrent() = 0;
 
   virtual bool SetNativeWindow(fml::RefPtr<AndroidNativeWindow> window) = 0;
+
+  // Creates the GrDirectContext of the surfaces returned by
+  // |CreateGPUSurface| ahead of the first of them, before there is a native
+  // window. Called on the raster thread. See
+  // |PlatformView::PrewarmGPUContext|.
+  virtual void PrewarmGPUContext();
 };
 
 class AndroidSurfaceFactory {
@@ -569,7 +569,9 @@ public class FlutterActivityAndFragmentDelegateTest {
     delegate.onTrimMemory(TRIM_MEMORY_UI_HIDDEN);
 
     // Verify that the call was forwarded to the engine.
-    verify(mockFlutterEngine.getDartExecutor(), times(7)).notifyLowMemoryWarning();
+    // Only the critical levels free everything.
+    verify(mockFlutterEngine.getDartExecutor(), times(2)).notifyLowMemoryWarning();
+    verify(mockFlutterEngine.getDartExecutor(), times(5)).notifyMemoryPressure(false);
     verify(mockFlutterEngine.getSystemChannel(), times(1)).sendMemoryPressureWarning();
   }
 
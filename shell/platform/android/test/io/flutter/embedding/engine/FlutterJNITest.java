@@ -1,6 +1,9 @@
 package io.flutter.embedding.engine;
 
 import static org.junit.Assert.assertEquals;
+import static org.mockito.ArgumentMatchers.any;
+import static org.mockito.ArgumentMatchers.eq;
+import static org.mockito.Mockito.inOrder;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
@@ -17,10 +20,13 @@ import io.flutter.embedding.engine.renderer.FlutterUiDisplayListener;
 import io.flutter.embedding.engine.systemchannels.LocalizationChannel;
 import io.flutter.plugin.localization.LocalizationPlugin;
 import io.flutter.plugin.platform.PlatformViewsController;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Locale;
 import java.util.concurrent.atomic.AtomicInteger;
 import org.junit.Test;
 import org.junit.runner.RunWith;
+import org.mockito.InOrder;
 import org.robolectric.RobolectricTestRunner;
 import org.robolectric.annotation.Config;
 
@@ -237,4 +243,51 @@ public class FlutterJNITest {
     // --- Verify Results ---
     verify(platformViewsController, times(1)).createOverlaySurface();
   }
+
+  @Test
+  public void onEndFrameWithTransaction__displaysViewsThenEndsTheFrame() {
+    PlatformViewsController platformViewsController = mock(PlatformViewsController.class);
+
+    // --- Test Setup ---
+    FlutterJNI flutterJNI = new FlutterJNI();
+    flutterJNI.setPlatformViewsController(platformViewsController);
+    ByteBuffer transaction = ByteBuffer.allocate(29 * 4).order(ByteOrder.LITTLE_ENDIAN);
+    // A platform view with a clip rect.
+    transaction.putInt(0);
+    for (int value : new int[] {1, 10, 20, 100, 200, 100, 200}) {
+      transaction.putInt(value);
+    }
+    transaction.putInt(1);
+    transaction.putInt(1);
+    for (int value : new int[] {0, 0, 50, 50}) {
+      transaction.putInt(value);
+    }
+    // An overlay surface.
+    transaction.putInt(1);
+    for (int value : new int[] {2, 10, 20, 30, 40}) {
+      transaction.putInt(value);
+    }
+    transaction.flip();
+
+    // --- Execute Test ---
+    flutterJNI.onEndFrameWithTransaction(transaction);
+
+    // --- Verify Results ---
+    InOrder inOrder = inOrder(platformViewsController);
+    inOrder
+        .verify(platformViewsController, times(1))
+        .onDisplayPlatformView(
+            eq(/*viewId=*/ 1),
+            eq(/*x=*/ 10),
+            eq(/*y=*/ 20),
+            eq(/*width=*/ 100),
+            eq(/*height=*/ 200),
+            eq(/*viewWidth=*/ 100),
+            eq(/*viewHeight=*/ 200),
+            any(FlutterMutatorsStack.class));
+    inOrder
+        .verify(platformViewsController, times(1))
+        .onDisplayOverlaySurface(/*id=*/ 2, /*x=*/ 10, /*y=*/ 20, /*width=*/ 30, /*height=*/ 40);
+    inOrder.verify(platformViewsController, times(1)).onEndFrame();
+  }
 }
@@ -65,6 +65,16 @@ public class DartExecutorTest {
     verify(mockFlutterJNI, times(1)).notifyLowMemoryWarning();
   }
 
+  @Test
+  public void itNotifiesMemoryPressure() {
+    FlutterJNI mockFlutterJNI = mock(FlutterJNI.class);
+    when(mockFlutterJNI.isAttached()).thenReturn(true);
+
+    DartExecutor dartExecutor = new DartExecutor(mockFlutterJNI, mock(AssetManager.class));
+    dartExecutor.notifyMemoryPressure(false);
+    verify(mockFlutterJNI, times(1)).notifyMemoryPressure(false);
+  }
+
   @Test
   public void itThrowsWhenCreatingADefaultDartEntrypointWithAnUninitializedFlutterLoader() {
     assertThrows(
@@ -3,7 +3,10 @@ package io.flutter.embedding.engine.dart;
 import static junit.framework.TestCase.assertNotNull;
 import static junit.framework.TestCase.assertTrue;
 import static org.mockito.Matchers.any;
+import static org.mockito.Matchers.anyInt;
 import static org.mockito.Mockito.mock;
+import static org.mockito.Mockito.never;
+import static org.mockito.Mockito.verify;
 
 import io.flutter.embedding.engine.FlutterJNI;
 import io.flutter.plugin.common.BinaryMessenger.BinaryMessageHandler;
@@ -51,4 +54,20 @@ public class DartMessengerTest {
     assertTrue(reportingHandler.latestException instanceof AssertionError);
     currentThread.setUncaughtExceptionHandler(savedHandler);
   }
+
+  @Test
+  public void itDoesNotReplyToMessagesWithoutReplyId() {
+    final FlutterJNI fakeFlutterJni = mock(FlutterJNI.class);
+    final DartMessenger messenger = new DartMessenger(fakeFlutterJni);
+    final BinaryMessageHandler replyingHandler =
+        (message, reply) -> reply.reply(ByteBuffer.allocateDirect(4));
+    messenger.setMessageHandler("test", replyingHandler);
+
+    messenger.handleMessageFromDart("test", new byte[] {}, 0);
+    messenger.handleMessageFromDart("unhandled", new byte[] {}, 0);
+
+    verify(fakeFlutterJni, never())
+        .invokePlatformMessageResponseCallback(anyInt(), any(ByteBuffer.class), anyInt());
+    verify(fakeFlutterJni, never()).invokePlatformMessageEmptyResponseCallback(anyInt());
+  }
 }
@@ -1,12 +1,18 @@
 package io.flutter.embedding.engine.renderer;
 
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.mockito.Matchers.anyInt;
+import static org.mockito.Matchers.anyLong;
 import static org.mockito.Matchers.eq;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
+import static org.mockito.Mockito.when;
 
 import android.view.Surface;
 import io.flutter.embedding.engine.FlutterJNI;
+import io.flutter.view.TextureRegistry;
 import org.junit.Before;
 import org.junit.Test;
 import org.junit.runner.RunWith;
@@ -116,4 +122,36 @@ public class FlutterRendererTest {
     // Verify behavior under test.
     verify(fakeFlutterJNI, times(0)).markTextureFrameAvailable(eq(entry.id()));
   }
+
+  @Test
+  public void itRegistersAndReleasesImageTextures() {
+    // Setup the test.
+    FlutterRenderer flutterRenderer = new FlutterRenderer(fakeFlutterJNI);
+    when(fakeFlutterJNI.registerImageTexture(anyLong(), eq(640), eq(480)))
+        .thenReturn(fakeSurface);
+
+    // Execute the behavior under test.
+    TextureRegistry.ImageTextureEntry entry = flutterRenderer.createImageTexture(640, 480);
+    entry.release();
+    entry.release();
+
+    // Verify behavior under test.
+    assertEquals(fakeSurface, entry.surface());
+    verify(fakeFlutterJNI, times(1)).registerImageTexture(eq(entry.id()), eq(640), eq(480));
+    verify(fakeSurface, times(1)).release();
+    verify(fakeFlutterJNI, times(1)).unregisterTexture(eq(entry.id()));
+  }
+
+  @Test
+  public void itReturnsNoImageTextureWhenUnsupported() {
+    // Setup the test.
+    FlutterRenderer flutterRenderer = new FlutterRenderer(fakeFlutterJNI);
+    when(fakeFlutterJNI.registerImageTexture(anyLong(), anyInt(), anyInt())).thenReturn(null);
+
+    // Execute the behavior under test.
+    TextureRegistry.ImageTextureEntry entry = flutterRenderer.createImageTexture(640, 480);
+
+    // Verify behavior under test.
+    assertNull(entry);
+  }
 }
@@ -4,11 +4,13 @@
 
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
+#include <atomic>
 #include <cmath>
 #include <utility>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
 #include "flutter/fml/size.h"
@@ -18,14 +20,99 @@ namespace flutter {
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
+static jfieldID g_refresh_rate_fps_field_ = nullptr;
+
+namespace {
+
+struct AChoreographer;
+
+using AChoreographerFrameCallback64 = void (*)(int64_t frame_time_nanos,
+                                               void* data);
+using AChoreographerRefreshRateCallback = void (*)(int64_t vsync_period_nanos,
+                                                   void* data);
+
+// The native Choreographer can post frame callbacks with 64 bit frame times
+// from API 29 and reports refresh rate changes from API 30. The functions
+// are resolved at runtime as the engine supports older API levels.
+struct ChoreographerProcs {
+  AChoreographer* (*AChoreographer_getInstance)();
+  void (*AChoreographer_postFrameCallback64)(
+      AChoreographer* choreographer,
+      AChoreographerFrameCallback64 callback,
+      void* data);
+  void (*AChoreographer_registerRefreshRateCallback)(
+      AChoreographer* choreographer,
+      AChoreographerRefreshRateCallback callback,
+      void* data);
+
+  bool valid = false;
+};
+
+template <typename T>
+bool Resolve(const fml::RefPtr<fml::NativeLibrary>& library,
+             const char* name,
+             T& proc) {
+  proc = reinterpret_cast<T>(library->ResolveSymbol(name));
+  return proc != nullptr;
+}
+
+const ChoreographerProcs& GetChoreographerProcs() {
+  static const ChoreographerProcs procs = []() {
+    ChoreographerProcs procs = {};
+    // The library is never unloaded as the functions are kept.
+    static fml::RefPtr<fml::NativeLibrary> android =
+        fml::NativeLibrary::Create("libandroid.so");
+    if (!android) {
+      return procs;
+    }
+    procs.valid =
+        Resolve(android, "AChoreographer_getInstance",
+                procs.AChoreographer_getInstance) &&
+        Resolve(android, "AChoreographer_postFrameCallback64",
+                procs.AChoreographer_postFrameCallback64) &&
+        Resolve(android, "AChoreographer_registerRefreshRateCallback",
+                procs.AChoreographer_registerRefreshRateCallback);
+    return procs;
+  }();
+  return procs;
+}
+
+// The refresh period of the main display, as last reported by the native
+// Choreographer of any thread. Zero until it is known.
+std::atomic<int64_t> g_refresh_period_nanos{0};
+
+void OnRefreshRateChanged(int64_t vsync_period_nanos, void* data) {
+  g_refresh_period_nanos = vsync_period_nanos;
+}
+
+// Returns the refresh period that the Java Choreographer path would use,
+// which is the refresh rate reported to FlutterJNI.
+int64_t GetRefreshPeriodFromJava() {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+  const float fps = env->GetStaticFloatField(g_vsync_waiter_class->obj(),
+                                             g_refresh_rate_fps_field_);
+  if (fps <= 0.0f) {
+    return fml::TimeDelta::FromSecondsF(1.0 / 60.0).ToNanoseconds();
+  }
+  return fml::TimeDelta::FromSecondsF(1.0 / fps).ToNanoseconds();
+}
 
-VsyncWaiterAndroid::VsyncWaiterAndroid(flutter::TaskRunners task_runners)
-    : VsyncWaiter(std::move(task_runners)) {}
+}  // namespace
+
+VsyncWaiterAndroid::VsyncWaiterAndroid(
+    flutter::TaskRunners task_runners,
+    RefreshRateCallback on_refresh_rate_changed)
+    : VsyncWaiter(std::move(task_runners)),
+      on_refresh_rate_changed_(std::move(on_refresh_rate_changed)) {}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
 
 // |VsyncWaiter|
 void VsyncWaiterAndroid::AwaitVSync() {
+  if (AwaitVSyncFromNativeChoreographer()) {
+    return;
+  }
+
   auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
   jlong java_baton = reinterpret_cast<jlong>(weak_this);
 
@@ -38,6 +125,69 @@ void VsyncWaiterAndroid::AwaitVSync() {
   });
 }
 
+bool VsyncWaiterAndroid::AwaitVSyncFromNativeChoreographer() {
+  const ChoreographerProcs& procs = GetChoreographerProcs();
+  // The UI thread has a looper, which the native Choreographer requires, so
+  // the callback is delivered to it directly instead of through the platform
+  // thread.
+  if (!procs.valid ||
+      !task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread()) {
+    return false;
+  }
+  AChoreographer* choreographer = procs.AChoreographer_getInstance();
+  if (choreographer == nullptr) {
+    return false;
+  }
+
+  // Each thread has its own Choreographer, whose refresh rate callback is
+  // registered once and kept for the lifetime of the thread.
+  thread_local bool registered_refresh_rate_callback = false;
+  if (!registered_refresh_rate_callback) {
+    if (g_refresh_period_nanos == 0) {
+      g_refresh_period_nanos = GetRefreshPeriodFromJava();
+    }
+    procs.AChoreographer_registerRefreshRateCallback(
+        choreographer, &OnRefreshRateChanged, nullptr);
+    registered_refresh_rate_callback = true;
+  }
+
+  auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
+  procs.AChoreographer_postFrameCallback64(
+      choreographer, &OnChoreographerFrame, weak_this);
+  return true;
+}
+
+// static
+void VsyncWaiterAndroid::OnChoreographerFrame(int64_t frame_time_nanos,
+                                              void* data) {
+  TRACE_EVENT0("flutter", "VSYNC");
+
+  auto* weak_this = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(data);
+  auto shared_this = weak_this->lock();
+  delete weak_this;
+  if (!shared_this) {
+    return;
+  }
+
+  // The frame must be ready by the time the next vsync is due.
+  const int64_t refresh_period_nanos = g_refresh_period_nanos;
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(frame_time_nanos));
+  auto target_time =
+      frame_time + fml::TimeDelta::FromNanoseconds(refresh_period_nanos);
+
+  auto* waiter = static_cast<VsyncWaiterAndroid*>(shared_this.get());
+  if (refresh_period_nanos != waiter->reported_refresh_period_nanos_) {
+    waiter->reported_refresh_period_nanos_ = refresh_period_nanos;
+    if (waiter->on_refresh_rate_changed_ && refresh_period_nanos > 0) {
+      waiter->on_refresh_rate_changed_(
+          1e9 / static_cast<double>(refresh_period_nanos));
+    }
+  }
+
+  shared_this->FireCallback(frame_time, target_time);
+}
+
 // static
 void VsyncWaiterAndroid::OnNativeVsync(JNIEnv* env,
                                        jclass jcaller,
@@ -91,6 +241,11 @@ bool VsyncWaiterAndroid::Register(JNIEnv* env) {
 
   FML_CHECK(g_async_wait_for_vsync_method_ != nullptr);
 
+  g_refresh_rate_fps_field_ = env->GetStaticFieldID(
+      g_vsync_waiter_class->obj(), "refreshRateFPS", "F");
+
+  FML_CHECK(g_refresh_rate_fps_field_ != nullptr);
+
   return env->RegisterNatives(clazz, methods, fml::size(methods)) == 0;
 }
 
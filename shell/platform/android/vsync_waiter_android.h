@@ -7,6 +7,7 @@
 
 #include <jni.h>
 
+#include <functional>
 #include <memory>
 
 #include "flutter/fml/macros.h"
@@ -18,14 +19,31 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
  public:
   static bool Register(JNIEnv* env);
 
-  VsyncWaiterAndroid(flutter::TaskRunners task_runners);
+  // Called on the UI thread with the refresh rate of the display, in frames
+  // per second, when the native Choreographer reports that it changed.
+  using RefreshRateCallback = std::function<void(double refresh_rate)>;
+
+  VsyncWaiterAndroid(flutter::TaskRunners task_runners,
+                     RefreshRateCallback on_refresh_rate_changed = nullptr);
 
   ~VsyncWaiterAndroid() override;
 
  private:
+  const RefreshRateCallback on_refresh_rate_changed_;
+  // The refresh period last reported to |on_refresh_rate_changed_|, only
+  // accessed on the UI thread.
+  int64_t reported_refresh_period_nanos_ = 0;
+
   // |VsyncWaiter|
   void AwaitVSync() override;
 
+  // Requests the vsync from the native Choreographer of the UI thread, which
+  // avoids going through Java on API levels that support it. Returns false if
+  // the Java Choreographer must be used instead.
+  bool AwaitVSyncFromNativeChoreographer();
+
+  static void OnChoreographerFrame(int64_t frame_time_nanos, void* data);
+
   static void OnNativeVsync(JNIEnv* env,
                             jclass jcaller,
                             jlong frameTimeNanos,
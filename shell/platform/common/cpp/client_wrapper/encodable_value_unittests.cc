@@ -130,6 +130,17 @@ TEST(EncodableValueTest, DoubleList) {
   EXPECT_EQ(list_value[2], std::numeric_limits<double>::max());
 }
 
+// Tests that constructing from an rvalue moves the data instead of copying it.
+TEST(EncodableValueTest, DoubleListMove) {
+  std::vector<double> data = {-10.0, 2.0};
+  const double* elements = data.data();
+  EncodableValue value(std::move(data));
+
+  auto& list_value = std::get<std::vector<double>>(value);
+  ASSERT_EQ(list_value.size(), 2u);
+  EXPECT_EQ(list_value.data(), elements);
+}
+
 TEST(EncodableValueTest, List) {
   EncodableList encodables = {
       EncodableValue(1),
@@ -8,11 +8,31 @@
 #include <string>
 
 #include "rapidjson/error/en.h"
-#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
 namespace flutter {
 
+namespace {
+
+// A rapidjson output stream that appends to a byte vector, so messages are
+// serialized directly into the buffer that is sent to the engine.
+class ByteVectorOutputStream {
+ public:
+  typedef char Ch;
+
+  explicit ByteVectorOutputStream(std::vector<uint8_t>* bytes)
+      : bytes_(bytes) {}
+
+  void Put(Ch c) { bytes_->push_back(static_cast<uint8_t>(c)); }
+
+  void Flush() {}
+
+ private:
+  std::vector<uint8_t>* bytes_;
+};
+
+}  // namespace
+
 // static
 const JsonMessageCodec& JsonMessageCodec::GetInstance() {
   static JsonMessageCodec sInstance;
@@ -21,13 +41,11 @@ const JsonMessageCodec& JsonMessageCodec::GetInstance() {
 
 std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageInternal(
     const rapidjson::Document& message) const {
-  // TODO: Look into alternate writers that would avoid the buffer copy.
-  rapidjson::StringBuffer buffer;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  ByteVectorOutputStream stream(encoded.get());
+  rapidjson::Writer<ByteVectorOutputStream> writer(stream);
   message.Accept(writer);
-  const char* buffer_start = buffer.GetString();
-  return std::make_unique<std::vector<uint8_t>>(
-      buffer_start, buffer_start + buffer.GetSize());
+  return encoded;
 }
 
 std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
@@ -40,11 +58,16 @@ std::unique_ptr<rapidjson::Document> JsonMessageCodec::DecodeMessageInternal(
   bool parsing_successful =
       result == rapidjson::ParseErrorCode::kParseErrorNone;
   if (!parsing_successful) {
-    std::cerr << "Unable to parse JSON message:" << std::endl
-              << rapidjson::GetParseError_En(result.Code()) << std::endl;
+    LogParseError(result);
     return nullptr;
   }
   return json_message;
 }
 
+// static
+void JsonMessageCodec::LogParseError(const rapidjson::ParseResult& result) {
+  std::cerr << "Unable to parse JSON message:" << std::endl
+            << rapidjson::GetParseError_En(result.Code()) << std::endl;
+}
+
 }  // namespace flutter
@@ -6,6 +6,8 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_CPP_JSON_MESSAGE_CODEC_H_
 
 #include <rapidjson/document.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
 
 #include "flutter/shell/platform/common/cpp/client_wrapper/include/flutter/message_codec.h"
 
@@ -24,6 +26,28 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   JsonMessageCodec(JsonMessageCodec const&) = delete;
   JsonMessageCodec& operator=(JsonMessageCodec const&) = delete;
 
+  // Parses |binary_message| and reports its contents to |handler| as SAX
+  // events instead of building a document, so large messages can be processed
+  // without allocating a node per value. |Handler| must implement the
+  // rapidjson Handler concept, e.g. by extending rapidjson::BaseReaderHandler.
+  //
+  // Returns false if the message is not valid JSON or |handler| returned false
+  // from one of its events.
+  template <typename Handler>
+  bool ParseMessage(const uint8_t* binary_message,
+                    const size_t message_size,
+                    Handler* handler) const {
+    rapidjson::MemoryStream stream(
+        reinterpret_cast<const char*>(binary_message), message_size);
+    rapidjson::Reader reader;
+    rapidjson::ParseResult result = reader.Parse(stream, *handler);
+    if (result.IsError()) {
+      LogParseError(result);
+      return false;
+    }
+    return true;
+  }
+
  protected:
   // Instances should be obtained via GetInstance.
   JsonMessageCodec() = default;
@@ -36,6 +60,10 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   // |flutter::MessageCodec|
   std::unique_ptr<std::vector<uint8_t>> EncodeMessageInternal(
       const rapidjson::Document& message) const override;
+
+ private:
+  // Logs the reason a message could not be parsed.
+  static void LogParseError(const rapidjson::ParseResult& result);
 };
 
 }  // namespace flutter
@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -43,4 +44,42 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+// Tests that a message can be parsed into SAX events without a document.
+TEST(JsonMessageCodec, ParseMessage) {
+  struct CountingHandler
+      : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, CountingHandler> {
+    bool Default() {
+      values++;
+      return true;
+    }
+    bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+      keys.emplace_back(str, length);
+      return true;
+    }
+
+    int values = 0;
+    std::vector<std::string> keys;
+  };
+
+  const std::string message = R"({"a": [1, 2.5, "three"], "b": null})";
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  CountingHandler handler;
+  EXPECT_TRUE(codec.ParseMessage(
+      reinterpret_cast<const uint8_t*>(message.data()), message.size(),
+      &handler));
+  // Two objects and arrays starting and ending, and four values.
+  EXPECT_EQ(handler.values, 8);
+  EXPECT_EQ(handler.keys, std::vector<std::string>({"a", "b"}));
+}
+
+// Tests that invalid messages are reported as parse failures.
+TEST(JsonMessageCodec, ParseInvalidMessage) {
+  const std::string message = R"({"a": )";
+  const JsonMessageCodec& codec = JsonMessageCodec::GetInstance();
+  rapidjson::BaseReaderHandler<> handler;
+  EXPECT_FALSE(codec.ParseMessage(
+      reinterpret_cast<const uint8_t*>(message.data()), message.size(),
+      &handler));
+}
+
 }  // namespace flutter
@@ -39,6 +39,24 @@ void TextInputModel::SetText(const std::string& text) {
   text_ = utf16_converter.from_bytes(text);
   selection_ = TextRange(0);
   composing_range_ = TextRange(0);
+  deltas_.clear();
+}
+
+std::vector<TextEditingDelta> TextInputModel::TakeDeltas() {
+  std::vector<TextEditingDelta> deltas;
+  deltas.swap(deltas_);
+  return deltas;
+}
+
+void TextInputModel::ReplaceText(const TextRange& range,
+                                 const std::u16string& text) {
+  if (range.collapsed() && text.empty()) {
+    return;
+  }
+  text_.replace(range.start(), range.length(), text);
+  if (delta_tracking_) {
+    deltas_.push_back({TextRange(range.start(), range.end()), text});
+  }
 }
 
 bool TextInputModel::SetSelection(const TextRange& range) {
@@ -77,7 +95,7 @@ void TextInputModel::UpdateComposingText(const std::string& composing_text) {
     return;
   }
   DeleteSelected();
-  text_.replace(composing_range_.start(), composing_range_.length(), text);
+  ReplaceText(composing_range_, text);
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(composing_range_.end());
 }
@@ -101,7 +119,7 @@ bool TextInputModel::DeleteSelected() {
     return false;
   }
   size_t start = selection_.start();
-  text_.erase(start, selection_.length());
+  ReplaceText(selection_, u"");
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -128,12 +146,12 @@ void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
   if (composing_) {
     // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
+    ReplaceText(composing_range_, u"");
     selection_ = TextRange(composing_range_.start());
     composing_range_.set_end(composing_range_.start() + text.length());
   }
   size_t position = selection_.position();
-  text_.insert(position, text);
+  ReplaceText(TextRange(position), text);
   selection_ = TextRange(position + text.length());
 }
 
@@ -151,7 +169,7 @@ bool TextInputModel::Backspace() {
   size_t position = selection_.position();
   if (position != editable_range().start()) {
     int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
-    text_.erase(position - count, count);
+    ReplaceText(TextRange(position - count, position), u"");
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -169,7 +187,7 @@ bool TextInputModel::Delete() {
   size_t position = selection_.position();
   if (position < editable_range().end()) {
     int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
-    text_.erase(position, count);
+    ReplaceText(TextRange(position, position + count), u"");
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -207,7 +225,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
   }
 
   auto deleted_length = end - start;
-  text_.erase(start, deleted_length);
+  ReplaceText(TextRange(start, end), u"");
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -7,11 +7,19 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/shell/platform/common/cpp/text_range.h"
 
 namespace flutter {
 
+// A change to the text of a |TextInputModel|: the replacement of |range| of the
+// text before the change with |text|. Positions are UTF-16 code unit offsets.
+struct TextEditingDelta {
+  TextRange range;
+  std::u16string text;
+};
+
 // Handles underlying text input state, using a simple ASCII model.
 //
 // Ignores special states like "insert mode" for now.
@@ -22,9 +30,25 @@ class TextInputModel {
 
   // Sets the text.
   //
-  // Resets the selection base and extent.
+  // Resets the selection base and extent. Discards the pending deltas, since
+  // the caller already knows the new text.
   void SetText(const std::string& text);
 
+  // Sets whether changes to the text are recorded as deltas, see |TakeDeltas|.
+  //
+  // Recording is disabled by default.
+  void set_delta_tracking(bool enabled) {
+    delta_tracking_ = enabled;
+    deltas_.clear();
+  }
+
+  // Returns the changes made to the text since the last call, in the order
+  // they were made, and clears them.
+  //
+  // Sending these instead of the whole text keeps edits of long texts
+  // proportional to the size of the edit.
+  std::vector<TextEditingDelta> TakeDeltas();
+
   // Attempts to set the text selection.
   //
   // Returns false if the selection is not within the bounds of the text.
@@ -166,6 +190,10 @@ class TextInputModel {
   bool composing() const { return composing_; }
 
  private:
+  // Replaces |range| of the text with |text|, recording the change if delta
+  // tracking is enabled.
+  void ReplaceText(const TextRange& range, const std::u16string& text);
+
   // Deletes the current selection, if any.
   //
   // Returns true if any text is deleted. The selection base and extent are
@@ -187,6 +215,8 @@ class TextInputModel {
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
+  bool delta_tracking_ = false;
+  std::vector<TextEditingDelta> deltas_;
 };
 
 }  // namespace flutter
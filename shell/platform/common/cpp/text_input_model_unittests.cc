@@ -1486,4 +1486,69 @@ TEST(TextInputModel, GetCursorOffsetReverseSelection) {
   EXPECT_EQ(model->GetCursorOffset(), 1);
 }
 
+TEST(TextInputModel, DeltasAreNotTrackedByDefault) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(5)));
+  model->AddText("F");
+  EXPECT_TRUE(model->TakeDeltas().empty());
+}
+
+TEST(TextInputModel, DeltasDescribeEachEdit) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_delta_tracking(true);
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(1, 3)));
+  model->AddCodePoint('x');
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_TRUE(model->Delete());
+  EXPECT_EQ(model->GetText(), "AE");
+
+  std::vector<TextEditingDelta> deltas = model->TakeDeltas();
+  ASSERT_EQ(deltas.size(), 4u);
+  // Replacing the selection deletes it, then inserts the new text.
+  EXPECT_EQ(deltas[0].range.start(), 1u);
+  EXPECT_EQ(deltas[0].range.end(), 3u);
+  EXPECT_EQ(deltas[0].text, u"");
+  EXPECT_EQ(deltas[1].range.start(), 1u);
+  EXPECT_EQ(deltas[1].range.end(), 1u);
+  EXPECT_EQ(deltas[1].text, u"x");
+  EXPECT_EQ(deltas[2].range.start(), 1u);
+  EXPECT_EQ(deltas[2].range.end(), 2u);
+  EXPECT_EQ(deltas[2].text, u"");
+  EXPECT_EQ(deltas[3].range.start(), 1u);
+  EXPECT_EQ(deltas[3].range.end(), 2u);
+  EXPECT_EQ(deltas[3].text, u"");
+  EXPECT_TRUE(model->TakeDeltas().empty());
+}
+
+TEST(TextInputModel, DeltasOfComposingReplaceTheComposingRange) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_delta_tracking(true);
+  model->SetText("AB");
+  EXPECT_TRUE(model->SetSelection(TextRange(2)));
+  model->BeginComposing();
+  model->UpdateComposingText("k");
+  model->UpdateComposingText("\u304b");
+  model->CommitComposing();
+  model->EndComposing();
+
+  std::vector<TextEditingDelta> deltas = model->TakeDeltas();
+  ASSERT_EQ(deltas.size(), 2u);
+  EXPECT_EQ(deltas[0].range.start(), 2u);
+  EXPECT_EQ(deltas[0].range.end(), 2u);
+  EXPECT_EQ(deltas[0].text, u"k");
+  EXPECT_EQ(deltas[1].range.start(), 2u);
+  EXPECT_EQ(deltas[1].range.end(), 3u);
+  EXPECT_EQ(deltas[1].text, u"\u304b");
+}
+
+TEST(TextInputModel, SetTextDiscardsDeltas) {
+  auto model = std::make_unique<TextInputModel>();
+  model->set_delta_tracking(true);
+  model->AddText("A");
+  model->SetText("ABC");
+  EXPECT_TRUE(model->TakeDeltas().empty());
+}
+
 }  // namespace flutter
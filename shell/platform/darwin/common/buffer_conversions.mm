@@ -20,7 +20,18 @@ std::unique_ptr<fml::Mapping> GetMappingFromNSData(NSData* data) {
 }
 
 NSData* GetNSDataFromMapping(std::unique_ptr<fml::Mapping> mapping) {
-  return [NSData dataWithBytes:mapping->GetMapping() length:mapping->GetSize()];
+  const size_t size = mapping->GetSize();
+  if (size == 0) {
+    return [NSData data];
+  }
+  // The bytes are not copied, the mapping is owned by the NSData instead.
+  uint8_t* bytes = const_cast<uint8_t*>(mapping->GetMapping());
+  fml::Mapping* owned_mapping = mapping.release();
+  return [[[NSData alloc] initWithBytesNoCopy:bytes
+                                       length:size
+                                  deallocator:^(void* deallocated_bytes, NSUInteger length) {
+                                    delete owned_mapping;
+                                  }] autorelease];
 }
 
 }  // namespace flutter
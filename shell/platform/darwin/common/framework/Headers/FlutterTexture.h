@@ -55,6 +55,21 @@ FLUTTER_EXPORT
  * @param textureId The result that was previously returned from `registerTexture:`.
  */
 - (void)unregisterTexture:(int64_t)textureId;
+
+@optional
+/**
+ * Pushes a new frame of a previously registered texture and notifies Flutter that it is available.
+ *
+ * Once a frame was pushed, Flutter paints the latest pushed pixel buffer and no longer calls
+ * `-[FlutterTexture copyPixelBuffer]` for the texture, so producers such as video decoders do not
+ * wait on the raster thread. Can be called on any thread.
+ *
+ * The content of the pixel buffer must be complete when it is pushed, for example after the GPU
+ * work that rendered it has completed, and must not change while Flutter retains it, which is until
+ * a newer frame is painted. When Flutter renders with Metal, pixel buffers backed by an IOSurface
+ * are sampled without being copied.
+ */
+- (void)textureFrameAvailable:(int64_t)textureId pixelBuffer:(CVPixelBufferRef)pixelBuffer;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -7,6 +7,8 @@
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterEngine_Internal.h"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/platform/darwin/platform_version.h"
@@ -81,6 +83,9 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   fml::scoped_nsobject<FlutterBasicMessageChannel> _keyEventChannel;
 
   int64_t _nextTextureId;
+  // The mailboxes of the registered textures, into which frames may be pushed from any thread.
+  std::mutex _textureMailboxesMutex;
+  std::unordered_map<int64_t, std::shared_ptr<flutter::IOSExternalTextureMailbox>> _textureMailboxes;
 
   BOOL _allowHeadlessExecution;
   FlutterBinaryMessengerRelay* _binaryMessenger;
@@ -508,7 +513,8 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   return [NSString stringWithFormat:@"%@.%zu", labelPrefix, ++s_shellCount];
 }
 
-+ (flutter::ThreadHost)makeThreadHost:(NSString*)threadLabel {
++ (flutter::ThreadHost)makeThreadHost:(NSString*)threadLabel
+                             settings:(const flutter::Settings&)settings {
   // The current thread will be used as the platform thread. Ensure that the message loop is
   // initialized.
   fml::MessageLoop::EnsureInitializedForCurrentThread();
@@ -519,7 +525,8 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
     threadHostType = threadHostType | flutter::ThreadHost::Type::Profiler;
   }
   return {threadLabel.UTF8String,  // label
-          threadHostType};
+          threadHostType,           // type mask
+          settings};
 }
 
 - (BOOL)createShell:(NSString*)entrypoint
@@ -534,6 +541,7 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
 
   auto settings = [_dartProject.get() settings];
   FlutterView.forceSoftwareRendering = settings.enable_software_rendering;
+  FlutterView.metalMaximumDrawableCount = settings.metal_maximum_drawable_count;
 
   auto platformData = [_dartProject.get() defaultPlatformData];
 
@@ -550,7 +558,7 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   }
 
   NSString* threadLabel = [FlutterEngine generateThreadLabel:_labelPrefix];
-  _threadHost = [FlutterEngine makeThreadHost:threadLabel];
+  _threadHost = [FlutterEngine makeThreadHost:threadLabel settings:settings];
 
   // Lambda captures by pointers to ObjC objects are fine here because the
   // create call is synchronous.
@@ -795,11 +803,20 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
 
 - (int64_t)registerTexture:(NSObject<FlutterTexture>*)texture {
   int64_t textureId = _nextTextureId++;
-  self.iosPlatformView->RegisterExternalTexture(textureId, texture);
+  auto mailbox = std::make_shared<flutter::IOSExternalTextureMailbox>();
+  {
+    std::lock_guard<std::mutex> guard(_textureMailboxesMutex);
+    _textureMailboxes[textureId] = mailbox;
+  }
+  self.iosPlatformView->RegisterExternalTexture(textureId, texture, std::move(mailbox));
   return textureId;
 }
 
 - (void)unregisterTexture:(int64_t)textureId {
+  {
+    std::lock_guard<std::mutex> guard(_textureMailboxesMutex);
+    _textureMailboxes.erase(textureId);
+  }
   _shell->GetPlatformView()->UnregisterTexture(textureId);
 }
 
@@ -807,6 +824,27 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
   _shell->GetPlatformView()->MarkTextureFrameAvailable(textureId);
 }
 
+- (void)textureFrameAvailable:(int64_t)textureId pixelBuffer:(CVPixelBufferRef)pixelBuffer {
+  {
+    std::lock_guard<std::mutex> guard(_textureMailboxesMutex);
+    auto found = _textureMailboxes.find(textureId);
+    if (found == _textureMailboxes.end()) {
+      return;
+    }
+    found->second->Push(fml::CFRef<CVPixelBufferRef>(CVPixelBufferRetain(pixelBuffer)));
+  }
+
+  if ([NSThread isMainThread]) {
+    [self textureFrameAvailable:textureId];
+    return;
+  }
+  dispatch_async(dispatch_get_main_queue(), ^{
+    if (_shell) {
+      [self textureFrameAvailable:textureId];
+    }
+  });
+}
+
 - (NSString*)lookupKeyForAsset:(NSString*)asset {
   return [FlutterDartProject lookupKeyForAsset:asset];
 }
@@ -4,10 +4,11 @@
 
 #import <UIKit/UIGestureRecognizerSubclass.h>
 
-#include <list>
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/rtree.h"
@@ -85,6 +86,15 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer
 }
 
 void FlutterPlatformViewLayerPool::RecycleLayers() {
+  for (size_t i = 0; i < layers_.size(); i++) {
+    std::shared_ptr<FlutterPlatformViewLayer>& layer = layers_[i];
+    layer->unused_frame_count = i < available_layer_index_ ? 0 : layer->unused_frame_count + 1;
+  }
+  // Layers are handed out in order, so the layers unused for the longest are at the end. Unused
+  // layers were already removed from the view hierarchy.
+  while (!layers_.empty() && layers_.back()->unused_frame_count > kMaxUnusedFrameCount) {
+    layers_.pop_back();
+  }
   available_layer_index_ = 0;
 }
 
@@ -486,6 +496,8 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
   auto did_submit = true;
   auto num_platform_views = composition_order_.size();
 
+  // Reused by the queries below.
+  std::vector<SkRect> intersection_rects;
   for (size_t i = 0; i < num_platform_views; i++) {
     int64_t platform_view_id = composition_order_[i];
     sk_sp<RTree> rtree = platform_view_rtrees_[platform_view_id];
@@ -496,8 +508,7 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
     for (size_t j = i + 1; j > 0; j--) {
       int64_t current_platform_view_id = composition_order_[j - 1];
       SkRect platform_view_rect = GetPlatformViewRect(current_platform_view_id);
-      std::list<SkRect> intersection_rects =
-          rtree->searchNonOverlappingDrawnRects(platform_view_rect);
+      rtree->searchNonOverlappingDrawnRects(platform_view_rect, &intersection_rects);
       auto allocation_size = intersection_rects.size();
 
       // For testing purposes, the overlay id is used to find the overlay view.
@@ -617,12 +628,21 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   overlay_view_wrapper.accessibilityIdentifier =
       [NSString stringWithFormat:@"platform_view[%lld].overlay[%lld]", view_id, overlay_id];
 
+  // Only the top left corner of the surface, which is as large as `rect`, is drawn into.
+  SkISize surface_size = SkISize::Make(
+      std::max(layer->surface_size.width(), static_cast<int32_t>(std::ceil(rect.width()))),
+      std::max(layer->surface_size.height(), static_cast<int32_t>(std::ceil(rect.height()))));
+  // The frame may have shrunk since the surface last grew, for example after a rotation.
+  layer->surface_size = SkISize::Make(std::min(surface_size.width(), frame_size_.width()),
+                                      std::min(surface_size.height(), frame_size_.height()));
+
   UIView* overlay_view = layer->overlay_view.get();
-  // Set the size of the overlay view.
-  // This size is equal to the the device screen size.
-  overlay_view.frame = flutter_view_.get().bounds;
+  // Set the size of the overlay view to the size of its surface. The wrapper masks the part of it
+  // that is larger than the overlay.
+  overlay_view.frame = CGRectMake(0, 0, layer->surface_size.width() / screenScale,
+                                  layer->surface_size.height() / screenScale);
 
-  std::unique_ptr<SurfaceFrame> frame = layer->surface->AcquireFrame(frame_size_);
+  std::unique_ptr<SurfaceFrame> frame = layer->surface->AcquireFrame(layer->surface_size);
   // If frame is null, AcquireFrame already printed out an error message.
   if (!frame) {
     return layer;
@@ -78,6 +78,11 @@ class FlutterPlatformViewsTestMockPlatformViewDelegate : public PlatformView::De
   void OnPlatformViewDestroyed() override {}
   void OnPlatformViewSetNextFrameCallback(const fml::closure& closure) override {}
   void OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) override {}
+  void OnPlatformViewAddView(int64_t view_id,
+                             std::unique_ptr<Surface> surface,
+                             const ViewportMetrics& metrics) override {}
+  void OnPlatformViewRemoveView(int64_t view_id) override {}
+  void OnPlatformViewSetViewMetrics(int64_t view_id, const ViewportMetrics& metrics) override {}
   void OnPlatformViewDispatchPlatformMessage(fml::RefPtr<PlatformMessage> message) override {}
   void OnPlatformViewDispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet) override {
   }
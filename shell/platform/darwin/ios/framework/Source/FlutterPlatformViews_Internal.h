@@ -82,6 +82,14 @@ struct FlutterPlatformViewLayer {
   // We track this to know when the GrContext for the Flutter app has changed
   // so we can update the overlay with the new context.
   GrDirectContext* gr_context;
+
+  // The size in pixels of the frames acquired from `surface`. It only grows to fit the overlays
+  // drawn into the layer, up to the size of the Flutter view, so that an overlay that changes size
+  // in every frame does not reallocate its surface.
+  SkISize surface_size = SkISize::MakeEmpty();
+
+  // The number of consecutive frames in which the pool did not hand out this layer.
+  size_t unused_frame_count = 0;
 };
 
 // This class isn't thread safe.
@@ -100,10 +108,14 @@ class FlutterPlatformViewLayerPool {
   // This method doesn't mark the layers as unused.
   std::vector<std::shared_ptr<FlutterPlatformViewLayer>> GetUnusedLayers();
 
-  // Marks the layers in the pool as available for reuse.
+  // Marks the layers in the pool as available for reuse, and releases the layers that were not used
+  // in the last `kMaxUnusedFrameCount` frames.
   void RecycleLayers();
 
  private:
+  // About two seconds at 60fps, so that overlays that come and go do not reallocate their surfaces.
+  static const size_t kMaxUnusedFrameCount = 120;
+
   // The index of the entry in the layers_ vector that determines the beginning of the unused
   // layers. For example, consider the following vector:
   //  _____
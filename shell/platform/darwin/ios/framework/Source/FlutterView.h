@@ -35,6 +35,10 @@
 
 // Set by FlutterEngine or FlutterViewController to override software rendering.
 @property(class, nonatomic) BOOL forceSoftwareRendering;
+
+// Set by FlutterEngine or FlutterViewController to override the number of drawables of the Metal
+// layer. Zero keeps the default of Core Animation.
+@property(class, nonatomic) NSUInteger metalMaximumDrawableCount;
 @end
 
 #endif  // SHELL_PLATFORM_IOS_FRAMEWORK_SOURCE_FLUTTER_VIEW_H_
@@ -4,6 +4,10 @@
 
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterView.h"
 
+#if FLUTTER_SHELL_ENABLE_METAL
+#include <QuartzCore/CAMetalLayer.h>
+#endif  // FLUTTER_SHELL_ENABLE_METAL
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/layers/layer_tree.h"
@@ -51,11 +55,28 @@
   if (self) {
     _delegate = delegate;
     self.layer.opaque = opaque;
+    [self configureMetalLayer];
   }
 
   return self;
 }
 
+- (void)configureMetalLayer {
+#if FLUTTER_SHELL_ENABLE_METAL
+  if (![self.layer isKindOfClass:NSClassFromString(@"CAMetalLayer")]) {
+    return;
+  }
+  // Core Animation only accepts 2 or 3 drawables. With 3, the raster thread does not block in
+  // nextDrawable while the display holds on to the two previous frames.
+  NSUInteger drawableCount = FlutterView.metalMaximumDrawableCount;
+  if (drawableCount == 2 || drawableCount == 3) {
+    if (@available(iOS 11.2, *)) {
+      reinterpret_cast<CAMetalLayer*>(self.layer).maximumDrawableCount = drawableCount;
+    }
+  }
+#endif  // FLUTTER_SHELL_ENABLE_METAL
+}
+
 - (void)layoutSubviews {
   if ([self.layer isKindOfClass:NSClassFromString(@"CAEAGLLayer")] ||
       [self.layer isKindOfClass:NSClassFromString(@"CAMetalLayer")]) {
@@ -78,6 +99,16 @@ static BOOL _forceSoftwareRendering;
   _forceSoftwareRendering = forceSoftwareRendering;
 }
 
+static NSUInteger _metalMaximumDrawableCount;
+
++ (NSUInteger)metalMaximumDrawableCount {
+  return _metalMaximumDrawableCount;
+}
+
++ (void)setMetalMaximumDrawableCount:(NSUInteger)metalMaximumDrawableCount {
+  _metalMaximumDrawableCount = metalMaximumDrawableCount;
+}
+
 + (Class)layerClass {
   return flutter::GetCoreAnimationLayerClassForRenderingAPI(
       flutter::GetRenderingAPIForProcess(FlutterView.forceSoftwareRendering));
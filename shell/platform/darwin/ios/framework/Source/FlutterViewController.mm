@@ -163,6 +163,7 @@ typedef enum UIAccessibilityContrast : NSInteger {
     project = [[[FlutterDartProject alloc] init] autorelease];
   }
   FlutterView.forceSoftwareRendering = project.settings.enable_software_rendering;
+  FlutterView.metalMaximumDrawableCount = project.settings.metal_maximum_drawable_count;
   auto engine = fml::scoped_nsobject<FlutterEngine>{[[FlutterEngine alloc]
                 initWithName:@"io.flutter"
                      project:project
@@ -1379,6 +1380,10 @@ static flutter::PointerData::DeviceKind DeviceKindFromTouchType(UITouch* touch)
   [_engine.get() textureFrameAvailable:textureId];
 }
 
+- (void)textureFrameAvailable:(int64_t)textureId pixelBuffer:(CVPixelBufferRef)pixelBuffer {
+  [_engine.get() textureFrameAvailable:textureId pixelBuffer:pixelBuffer];
+}
+
 - (NSString*)lookupKeyForAsset:(NSString*)asset {
   return [FlutterDartProject lookupKeyForAsset:asset];
 }
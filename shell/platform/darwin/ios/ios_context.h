@@ -12,6 +12,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterTexture.h"
+#import "flutter/shell/platform/darwin/ios/ios_external_texture_mailbox.h"
 #import "flutter/shell/platform/darwin/ios/rendering_api_selection.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -98,13 +99,17 @@ class IOSContext {
   ///
   /// @param[in]  texture_id  The texture identifier
   /// @param[in]  texture     The texture
+  /// @param[in]  mailbox     The pixel buffers pushed by the producer of the
+  ///                         texture, which are painted instead of asking
+  ///                         the texture to copy its pixel buffer.
   ///
   /// @return     The texture proxy if the rendering backend supports embedder
   ///             provided external textures.
   ///
   virtual std::unique_ptr<Texture> CreateExternalTexture(
       int64_t texture_id,
-      fml::scoped_nsobject<NSObject<FlutterTexture>> texture) = 0;
+      fml::scoped_nsobject<NSObject<FlutterTexture>> texture,
+      std::shared_ptr<IOSExternalTextureMailbox> mailbox) = 0;
 
  protected:
   IOSContext();
@@ -52,8 +52,9 @@ std::unique_ptr<GLContextResult> IOSContextGL::MakeCurrent() {
 // |IOSContext|
 std::unique_ptr<Texture> IOSContextGL::CreateExternalTexture(
     int64_t texture_id,
-    fml::scoped_nsobject<NSObject<FlutterTexture>> texture) {
-  return std::make_unique<IOSExternalTextureGL>(texture_id, std::move(texture));
+    fml::scoped_nsobject<NSObject<FlutterTexture>> texture,
+    std::shared_ptr<IOSExternalTextureMailbox> mailbox) {
+  return std::make_unique<IOSExternalTextureGL>(texture_id, std::move(texture), std::move(mailbox));
 }
 
 }  // namespace flutter
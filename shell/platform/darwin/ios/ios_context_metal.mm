@@ -104,8 +104,10 @@ std::unique_ptr<GLContextResult> IOSContextMetal::MakeCurrent() {
 // |IOSContext|
 std::unique_ptr<Texture> IOSContextMetal::CreateExternalTexture(
     int64_t texture_id,
-    fml::scoped_nsobject<NSObject<FlutterTexture>> texture) {
-  return std::make_unique<IOSExternalTextureMetal>(texture_id, texture_cache_, std::move(texture));
+    fml::scoped_nsobject<NSObject<FlutterTexture>> texture,
+    std::shared_ptr<IOSExternalTextureMailbox> mailbox) {
+  return std::make_unique<IOSExternalTextureMetal>(texture_id, device_, texture_cache_,
+                                                   std::move(texture), std::move(mailbox));
 }
 
 }  // namespace flutter
@@ -26,7 +26,8 @@ class IOSContextSoftware final : public IOSContext {
   // |IOSContext|
   std::unique_ptr<Texture> CreateExternalTexture(
       int64_t texture_id,
-      fml::scoped_nsobject<NSObject<FlutterTexture>> texture) override;
+      fml::scoped_nsobject<NSObject<FlutterTexture>> texture,
+      std::shared_ptr<IOSExternalTextureMailbox> mailbox) override;
 
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(IOSContextSoftware);
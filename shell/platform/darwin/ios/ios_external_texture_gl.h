@@ -5,16 +5,21 @@
 #ifndef FLUTTER_SHELL_PLATFORM_IOS_EXTERNAL_TEXTURE_GL_H_
 #define FLUTTER_SHELL_PLATFORM_IOS_EXTERNAL_TEXTURE_GL_H_
 
+#include <memory>
+
 #include "flutter/common/graphics/texture.h"
 #include "flutter/fml/platform/darwin/cf_utils.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterTexture.h"
+#import "flutter/shell/platform/darwin/ios/ios_external_texture_mailbox.h"
 
 namespace flutter {
 
 class IOSExternalTextureGL final : public Texture {
  public:
-  IOSExternalTextureGL(int64_t textureId, NSObject<FlutterTexture>* externalTexture);
+  IOSExternalTextureGL(int64_t textureId,
+                       NSObject<FlutterTexture>* externalTexture,
+                       std::shared_ptr<IOSExternalTextureMailbox> mailbox);
 
   // |Texture|
   ~IOSExternalTextureGL() override;
@@ -22,6 +27,7 @@ class IOSExternalTextureGL final : public Texture {
  private:
   bool new_frame_ready_ = false;
   fml::scoped_nsobject<NSObject<FlutterTexture>> external_texture_;
+  std::shared_ptr<IOSExternalTextureMailbox> mailbox_;
   fml::CFRef<CVOpenGLESTextureCacheRef> cache_ref_;
   fml::CFRef<CVOpenGLESTextureRef> texture_ref_;
   fml::CFRef<CVPixelBufferRef> buffer_ref_;
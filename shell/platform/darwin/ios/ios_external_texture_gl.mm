@@ -18,10 +18,13 @@
 namespace flutter {
 
 IOSExternalTextureGL::IOSExternalTextureGL(int64_t textureId,
-                                           NSObject<FlutterTexture>* externalTexture)
+                                           NSObject<FlutterTexture>* externalTexture,
+                                           std::shared_ptr<IOSExternalTextureMailbox> mailbox)
     : Texture(textureId),
-      external_texture_(fml::scoped_nsobject<NSObject<FlutterTexture>>([externalTexture retain])) {
+      external_texture_(fml::scoped_nsobject<NSObject<FlutterTexture>>([externalTexture retain])),
+      mailbox_(std::move(mailbox)) {
   FML_DCHECK(external_texture_);
+  FML_DCHECK(mailbox_);
 }
 
 IOSExternalTextureGL::~IOSExternalTextureGL() = default;
@@ -152,7 +155,9 @@ void IOSExternalTextureGL::Paint(SkCanvas& canvas,
                                  SkFilterQuality filter_quality) {
   EnsureTextureCacheExists();
   if (NeedUpdateTexture(freeze)) {
-    auto pixelBuffer = [external_texture_.get() copyPixelBuffer];
+    // Textures whose producer pushes its frames are not asked to copy them on this thread.
+    auto pixelBuffer = mailbox_->HasProducer() ? mailbox_->Take().Release()
+                                               : [external_texture_.get() copyPixelBuffer];
     if (pixelBuffer) {
       buffer_ref_.Reset(pixelBuffer);
       pixel_format_ = CVPixelBufferGetPixelFormatType(buffer_ref_);
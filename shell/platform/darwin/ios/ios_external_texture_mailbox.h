@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_EXTERNAL_TEXTURE_MAILBOX_H_
+#define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_EXTERNAL_TEXTURE_MAILBOX_H_
+
+#include <mutex>
+
+#import <CoreVideo/CoreVideo.h>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/platform/darwin/cf_utils.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Holds the latest pixel buffer pushed by the producer of an
+///             external texture until the raster thread paints it.
+///
+///             Once a producer pushes its frames, the texture stops asking it
+///             to copy them on the raster thread. A frame that is pushed
+///             before the previous one was painted replaces it.
+///
+class IOSExternalTextureMailbox {
+ public:
+  IOSExternalTextureMailbox();
+
+  ~IOSExternalTextureMailbox();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replaces the pixel buffer waiting to be painted. Can be called
+  ///             on any thread.
+  ///
+  void Push(fml::CFRef<CVPixelBufferRef> pixel_buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a pixel buffer was ever pushed.
+  ///
+  bool HasProducer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the pixel buffer pushed since the last call, if any.
+  ///
+  fml::CFRef<CVPixelBufferRef> Take();
+
+ private:
+  mutable std::mutex mutex_;
+  bool has_producer_ = false;
+  fml::CFRef<CVPixelBufferRef> pixel_buffer_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IOSExternalTextureMailbox);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_EXTERNAL_TEXTURE_MAILBOX_H_
@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/ios/ios_external_texture_mailbox.h"
+
+namespace flutter {
+
+IOSExternalTextureMailbox::IOSExternalTextureMailbox() = default;
+
+IOSExternalTextureMailbox::~IOSExternalTextureMailbox() = default;
+
+void IOSExternalTextureMailbox::Push(fml::CFRef<CVPixelBufferRef> pixel_buffer) {
+  if (!pixel_buffer) {
+    return;
+  }
+  // The replaced pixel buffer is released outside of the lock.
+  fml::CFRef<CVPixelBufferRef> replaced;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    has_producer_ = true;
+    replaced = std::move(pixel_buffer_);
+    pixel_buffer_ = std::move(pixel_buffer);
+  }
+}
+
+bool IOSExternalTextureMailbox::HasProducer() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return has_producer_;
+}
+
+fml::CFRef<CVPixelBufferRef> IOSExternalTextureMailbox::Take() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return std::move(pixel_buffer_);
+}
+
+}  // namespace flutter
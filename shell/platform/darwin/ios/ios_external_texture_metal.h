@@ -6,14 +6,17 @@
 #define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_EXTERNAL_TEXTURE_METAL_H_
 
 #include <atomic>
+#include <memory>
 
 #import <CoreVideo/CoreVideo.h>
+#import <Metal/Metal.h>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/darwin/cf_utils.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterTexture.h"
+#import "flutter/shell/platform/darwin/ios/ios_external_texture_mailbox.h"
 #include "third_party/skia/include/core/SkImage.h"
 
 namespace flutter {
@@ -21,15 +24,19 @@ namespace flutter {
 class IOSExternalTextureMetal final : public Texture {
  public:
   IOSExternalTextureMetal(int64_t texture_id,
+                          fml::scoped_nsprotocol<id<MTLDevice>> device,
                           fml::CFRef<CVMetalTextureCacheRef> texture_cache,
-                          fml::scoped_nsobject<NSObject<FlutterTexture>> external_texture);
+                          fml::scoped_nsobject<NSObject<FlutterTexture>> external_texture,
+                          std::shared_ptr<IOSExternalTextureMailbox> mailbox);
 
   // |Texture|
   ~IOSExternalTextureMetal();
 
  private:
+  fml::scoped_nsprotocol<id<MTLDevice>> device_;
   fml::CFRef<CVMetalTextureCacheRef> texture_cache_;
   fml::scoped_nsobject<NSObject<FlutterTexture>> external_texture_;
+  std::shared_ptr<IOSExternalTextureMailbox> mailbox_;
   std::atomic_bool texture_frame_available_;
   fml::CFRef<CVPixelBufferRef> last_pixel_buffer_;
   sk_sp<SkImage> external_image_;
@@ -61,6 +68,17 @@ class IOSExternalTextureMetal final : public Texture {
   sk_sp<SkImage> WrapNV12ExternalPixelBuffer(fml::CFRef<CVPixelBufferRef> pixel_buffer,
                                              GrDirectContext* context) const;
 
+  // Wraps a plane of |pixel_buffer| in a Metal texture. The IOSurface of the pixel buffer is wrapped
+  // directly when it has one, otherwise the texture comes from the texture cache and
+  // |cache_texture| must outlive it.
+  fml::scoped_nsprotocol<id<MTLTexture>> WrapPixelBufferPlane(
+      CVPixelBufferRef pixel_buffer,
+      MTLPixelFormat pixel_format,
+      size_t width,
+      size_t height,
+      size_t plane,
+      fml::CFRef<CVMetalTextureRef>* cache_texture) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(IOSExternalTextureMetal);
 };
 
@@ -14,13 +14,19 @@ namespace flutter {
 
 IOSExternalTextureMetal::IOSExternalTextureMetal(
     int64_t texture_id,
+    fml::scoped_nsprotocol<id<MTLDevice>> device,
     fml::CFRef<CVMetalTextureCacheRef> texture_cache,
-    fml::scoped_nsobject<NSObject<FlutterTexture>> external_texture)
+    fml::scoped_nsobject<NSObject<FlutterTexture>> external_texture,
+    std::shared_ptr<IOSExternalTextureMailbox> mailbox)
     : Texture(texture_id),
+      device_(std::move(device)),
       texture_cache_(std::move(texture_cache)),
-      external_texture_(std::move(external_texture)) {
+      external_texture_(std::move(external_texture)),
+      mailbox_(std::move(mailbox)) {
+  FML_DCHECK(device_);
   FML_DCHECK(texture_cache_);
   FML_DCHECK(external_texture_);
+  FML_DCHECK(mailbox_);
 }
 
 IOSExternalTextureMetal::~IOSExternalTextureMetal() = default;
@@ -33,7 +39,10 @@ void IOSExternalTextureMetal::Paint(SkCanvas& canvas,
   const bool needs_updated_texture = (!freeze && texture_frame_available_) || !external_image_;
 
   if (needs_updated_texture) {
-    auto pixel_buffer = fml::CFRef<CVPixelBufferRef>([external_texture_ copyPixelBuffer]);
+    // Textures whose producer pushes its frames are not asked to copy them on this thread.
+    auto pixel_buffer = mailbox_->HasProducer()
+                            ? mailbox_->Take()
+                            : fml::CFRef<CVPixelBufferRef>([external_texture_ copyPixelBuffer]);
     if (!pixel_buffer) {
       pixel_buffer = std::move(last_pixel_buffer_);
     } else {
@@ -83,65 +92,91 @@ sk_sp<SkImage> IOSExternalTextureMetal::WrapExternalPixelBuffer(
   return image;
 }
 
+fml::scoped_nsprotocol<id<MTLTexture>> IOSExternalTextureMetal::WrapPixelBufferPlane(
+    CVPixelBufferRef pixel_buffer,
+    MTLPixelFormat pixel_format,
+    size_t width,
+    size_t height,
+    size_t plane,
+    fml::CFRef<CVMetalTextureRef>* cache_texture) const {
+  if (@available(iOS 11.0, *)) {
+    // Pixel buffers that producers share with the GPU are backed by an IOSurface, which Metal can
+    // sample from without the bookkeeping of the texture cache.
+    IOSurfaceRef io_surface = CVPixelBufferGetIOSurface(pixel_buffer);
+    if (io_surface != nullptr) {
+      MTLTextureDescriptor* descriptor =
+          [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:pixel_format
+                                                             width:width
+                                                            height:height
+                                                         mipmapped:NO];
+      descriptor.usage = MTLTextureUsageShaderRead;
+      fml::scoped_nsprotocol<id<MTLTexture>> texture(
+          [device_.get() newTextureWithDescriptor:descriptor iosurface:io_surface plane:plane]);
+      if (texture) {
+        return texture;
+      }
+    }
+  }
+
+  CVMetalTextureRef metal_texture_raw = nullptr;
+  auto cv_return = CVMetalTextureCacheCreateTextureFromImage(/*allocator=*/kCFAllocatorDefault,
+                                                             /*textureCache=*/texture_cache_,
+                                                             /*sourceImage=*/pixel_buffer,
+                                                             /*textureAttributes=*/nullptr,
+                                                             /*pixelFormat=*/pixel_format,
+                                                             /*width=*/width,
+                                                             /*height=*/height,
+                                                             /*planeIndex=*/plane,
+                                                             /*texture=*/&metal_texture_raw);
+
+  if (cv_return != kCVReturnSuccess) {
+    FML_DLOG(ERROR) << "Could not create Metal texture from pixel buffer: CVReturn " << cv_return;
+    return {};
+  }
+
+  cache_texture->Reset(metal_texture_raw);
+  return fml::scoped_nsprotocol<id<MTLTexture>>(
+      [CVMetalTextureGetTexture(metal_texture_raw) retain]);
+}
+
 sk_sp<SkImage> IOSExternalTextureMetal::WrapNV12ExternalPixelBuffer(
     fml::CFRef<CVPixelBufferRef> pixel_buffer,
     GrDirectContext* context) const {
   auto texture_size =
       SkISize::Make(CVPixelBufferGetWidth(pixel_buffer), CVPixelBufferGetHeight(pixel_buffer));
-  CVMetalTextureRef y_metal_texture_raw = nullptr;
-  {
-    auto cv_return =
-        CVMetalTextureCacheCreateTextureFromImage(/*allocator=*/kCFAllocatorDefault,
-                                                  /*textureCache=*/texture_cache_,
-                                                  /*sourceImage=*/pixel_buffer,
-                                                  /*textureAttributes=*/nullptr,
-                                                  /*pixelFormat=*/MTLPixelFormatR8Unorm,
-                                                  /*width=*/texture_size.width(),
-                                                  /*height=*/texture_size.height(),
-                                                  /*planeIndex=*/0u,
-                                                  /*texture=*/&y_metal_texture_raw);
-
-    if (cv_return != kCVReturnSuccess) {
-      FML_DLOG(ERROR) << "Could not create Metal texture from pixel buffer: CVReturn " << cv_return;
-      return nullptr;
-    }
-  }
 
-  CVMetalTextureRef uv_metal_texture_raw = nullptr;
-  {
-    auto cv_return =
-        CVMetalTextureCacheCreateTextureFromImage(/*allocator=*/kCFAllocatorDefault,
-                                                  /*textureCache=*/texture_cache_,
-                                                  /*sourceImage=*/pixel_buffer,
-                                                  /*textureAttributes=*/nullptr,
-                                                  /*pixelFormat=*/MTLPixelFormatRG8Unorm,
-                                                  /*width=*/texture_size.width() / 2,
-                                                  /*height=*/texture_size.height() / 2,
-                                                  /*planeIndex=*/1u,
-                                                  /*texture=*/&uv_metal_texture_raw);
-
-    if (cv_return != kCVReturnSuccess) {
-      FML_DLOG(ERROR) << "Could not create Metal texture from pixel buffer: CVReturn " << cv_return;
-      return nullptr;
-    }
+  fml::CFRef<CVMetalTextureRef> y_cache_texture;
+  auto y_metal_texture = WrapPixelBufferPlane(/*pixel_buffer=*/pixel_buffer,
+                                              /*pixel_format=*/MTLPixelFormatR8Unorm,
+                                              /*width=*/texture_size.width(),
+                                              /*height=*/texture_size.height(),
+                                              /*plane=*/0u,
+                                              /*cache_texture=*/&y_cache_texture);
+  if (!y_metal_texture) {
+    return nullptr;
   }
 
-  fml::CFRef<CVMetalTextureRef> y_metal_texture(y_metal_texture_raw);
+  fml::CFRef<CVMetalTextureRef> uv_cache_texture;
+  auto uv_metal_texture = WrapPixelBufferPlane(/*pixel_buffer=*/pixel_buffer,
+                                               /*pixel_format=*/MTLPixelFormatRG8Unorm,
+                                               /*width=*/texture_size.width() / 2,
+                                               /*height=*/texture_size.height() / 2,
+                                               /*plane=*/1u,
+                                               /*cache_texture=*/&uv_cache_texture);
+  if (!uv_metal_texture) {
+    return nullptr;
+  }
 
   GrMtlTextureInfo y_skia_texture_info;
-  y_skia_texture_info.fTexture = sk_cf_obj<const void*>{
-      [reinterpret_cast<NSObject*>(CVMetalTextureGetTexture(y_metal_texture)) retain]};
+  y_skia_texture_info.fTexture = sk_cf_obj<const void*>{[y_metal_texture.get() retain]};
 
   GrBackendTexture y_skia_backend_texture(/*width=*/texture_size.width(),
                                           /*height=*/texture_size.height(),
                                           /*mipMapped=*/GrMipMapped ::kNo,
                                           /*textureInfo=*/y_skia_texture_info);
 
-  fml::CFRef<CVMetalTextureRef> uv_metal_texture(uv_metal_texture_raw);
-
   GrMtlTextureInfo uv_skia_texture_info;
-  uv_skia_texture_info.fTexture = sk_cf_obj<const void*>{
-      [reinterpret_cast<NSObject*>(CVMetalTextureGetTexture(uv_metal_texture)) retain]};
+  uv_skia_texture_info.fTexture = sk_cf_obj<const void*>{[uv_metal_texture.get() retain]};
 
   GrBackendTexture uv_skia_backend_texture(/*width=*/texture_size.width(),
                                            /*height=*/texture_size.height(),
@@ -163,8 +198,8 @@ sk_sp<SkImage> IOSExternalTextureMetal::WrapNV12ExternalPixelBuffer(
 
   auto captures = std::make_unique<ImageCaptures>();
   captures->buffer = std::move(pixel_buffer);
-  captures->y_texture = std::move(y_metal_texture);
-  captures->uv_texture = std::move(uv_metal_texture);
+  captures->y_texture = std::move(y_cache_texture);
+  captures->uv_texture = std::move(uv_cache_texture);
 
   SkImage::TextureReleaseProc release_proc = [](SkImage::ReleaseContext release_context) {
     auto captures = reinterpret_cast<ImageCaptures*>(release_context);
@@ -181,28 +216,20 @@ sk_sp<SkImage> IOSExternalTextureMetal::WrapRGBAExternalPixelBuffer(
     GrDirectContext* context) const {
   auto texture_size =
       SkISize::Make(CVPixelBufferGetWidth(pixel_buffer), CVPixelBufferGetHeight(pixel_buffer));
-  CVMetalTextureRef metal_texture_raw = nullptr;
-  auto cv_return =
-      CVMetalTextureCacheCreateTextureFromImage(/*allocator=*/kCFAllocatorDefault,
-                                                /*textureCache=*/texture_cache_,
-                                                /*sourceImage=*/pixel_buffer,
-                                                /*textureAttributes=*/nullptr,
-                                                /*pixelFormat=*/MTLPixelFormatBGRA8Unorm,
-                                                /*width=*/texture_size.width(),
-                                                /*height=*/texture_size.height(),
-                                                /*planeIndex=*/0u,
-                                                /*texture=*/&metal_texture_raw);
 
-  if (cv_return != kCVReturnSuccess) {
-    FML_DLOG(ERROR) << "Could not create Metal texture from pixel buffer: CVReturn " << cv_return;
+  fml::CFRef<CVMetalTextureRef> cache_texture;
+  auto metal_texture = WrapPixelBufferPlane(/*pixel_buffer=*/pixel_buffer,
+                                            /*pixel_format=*/MTLPixelFormatBGRA8Unorm,
+                                            /*width=*/texture_size.width(),
+                                            /*height=*/texture_size.height(),
+                                            /*plane=*/0u,
+                                            /*cache_texture=*/&cache_texture);
+  if (!metal_texture) {
     return nullptr;
   }
 
-  fml::CFRef<CVMetalTextureRef> metal_texture(metal_texture_raw);
-
   GrMtlTextureInfo skia_texture_info;
-  skia_texture_info.fTexture = sk_cf_obj<const void*>{
-      [reinterpret_cast<NSObject*>(CVMetalTextureGetTexture(metal_texture)) retain]};
+  skia_texture_info.fTexture = sk_cf_obj<const void*>{[metal_texture.get() retain]};
 
   GrBackendTexture skia_backend_texture(/*width=*/texture_size.width(),
                                         /*height=*/texture_size.height(),
@@ -216,7 +243,7 @@ sk_sp<SkImage> IOSExternalTextureMetal::WrapRGBAExternalPixelBuffer(
 
   auto captures = std::make_unique<ImageCaptures>();
   captures->buffer = std::move(pixel_buffer);
-  captures->texture = std::move(metal_texture);
+  captures->texture = std::move(cache_texture);
 
   SkImage::TextureReleaseProc release_proc = [](SkImage::ReleaseContext release_context) {
     auto captures = reinterpret_cast<ImageCaptures*>(release_context);
@@ -23,7 +23,6 @@ IOSSurfaceMetal::IOSSurfaceMetal(fml::scoped_nsobject<CAMetalLayer> layer,
   auto metal_context = CastToMetalContext(GetContext());
 
   layer_.get().device = metal_context->GetDevice().get();
-  layer_.get().presentsWithTransaction = YES;
 
   is_valid_ = true;
 }
@@ -32,6 +32,8 @@ class IOSSwitchableGLContext final : public SwitchableGLContext {
 
   bool RemoveCurrent() override;
 
+  bool IsCurrent() const override;
+
  private:
   // These pointers are managed by IOSRendererTarget/IOSContextGL or a 3rd party
   // plugin that uses gl context. |IOSSwitchableGLContext| should never outlive
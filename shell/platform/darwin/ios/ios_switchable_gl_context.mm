@@ -22,4 +22,11 @@ bool IOSSwitchableGLContext::RemoveCurrent() {
   FML_DCHECK_CREATION_THREAD_IS_CURRENT(checker);
   return [EAGLContext setCurrentContext:previous_context_];
 };
+
+bool IOSSwitchableGLContext::IsCurrent() const {
+  FML_DCHECK_CREATION_THREAD_IS_CURRENT(checker);
+  // Reading the current context is a thread local lookup, while setting it
+  // flushes the context that was current.
+  return EAGLContext.currentContext == context_;
+};
 }
@@ -18,6 +18,7 @@
 #import "flutter/shell/platform/darwin/ios/framework/Source/accessibility_bridge.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/platform_message_router.h"
 #import "flutter/shell/platform/darwin/ios/ios_context.h"
+#import "flutter/shell/platform/darwin/ios/ios_external_texture_mailbox.h"
 #import "flutter/shell/platform/darwin/ios/ios_external_view_embedder.h"
 #import "flutter/shell/platform/darwin/ios/ios_surface.h"
 #import "flutter/shell/platform/darwin/ios/rendering_api_selection.h"
@@ -78,9 +79,12 @@ class PlatformViewIOS final : public PlatformView {
 
   /**
    * Called through when an external texture such as video or camera is
-   * given to the `FlutterEngine` or `FlutterViewController`.
+   * given to the `FlutterEngine` or `FlutterViewController`. The frames pushed into the `mailbox`
+   * are painted instead of asking the texture to copy its pixel buffer.
    */
-  void RegisterExternalTexture(int64_t id, NSObject<FlutterTexture>* texture);
+  void RegisterExternalTexture(int64_t id,
+                               NSObject<FlutterTexture>* texture,
+                               std::shared_ptr<IOSExternalTextureMailbox> mailbox);
 
   // |PlatformView|
   PointerDataDispatcherMaker GetDispatcherMaker() override;
@@ -124,9 +124,11 @@ PointerDataDispatcherMaker PlatformViewIOS::GetDispatcherMaker() {
 }
 
 void PlatformViewIOS::RegisterExternalTexture(int64_t texture_id,
-                                              NSObject<FlutterTexture>* texture) {
+                                              NSObject<FlutterTexture>* texture,
+                                              std::shared_ptr<IOSExternalTextureMailbox> mailbox) {
   RegisterTexture(ios_context_->CreateExternalTexture(
-      texture_id, fml::scoped_nsobject<NSObject<FlutterTexture>>{[texture retain]}));
+      texture_id, fml::scoped_nsobject<NSObject<FlutterTexture>>{[texture retain]},
+      std::move(mailbox)));
 }
 
 // |PlatformView|
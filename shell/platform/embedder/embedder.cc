@@ -8,6 +8,7 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -47,7 +48,9 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_dart_ring_buffer.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
+#include "flutter/shell/platform/embedder/embedder_frame_pump.h"
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
@@ -113,8 +116,8 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+  if (!SAFE_EXISTS_ONE_OF(software_config, surface_present_callback,
+                          surface_present_with_info_callback)) {
     return false;
   }
 
@@ -151,6 +154,15 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // OS_LINUX || OS_WIN
 
+static FlutterRect SkIRectToFlutterRect(const SkIRect& rect) {
+  return FlutterRect{
+      static_cast<double>(rect.left()),   // left
+      static_cast<double>(rect.top()),    // top
+      static_cast<double>(rect.right()),  // right
+      static_cast<double>(rect.bottom())  // bottom
+  };
+}
+
 static flutter::Shell::CreateCallback<flutter::PlatformView>
 InferOpenGLPlatformViewCreationCallback(
     const FlutterRendererConfig* config,
@@ -170,15 +182,31 @@ InferOpenGLPlatformViewCreationCallback(
   auto gl_clear_current = [ptr = config->open_gl.clear_current,
                            user_data]() -> bool { return ptr(user_data); };
 
-  auto gl_present = [present = config->open_gl.present,
-                     present_with_info = config->open_gl.present_with_info,
-                     user_data](uint32_t fbo_id) -> bool {
+  auto gl_present =
+      [present = config->open_gl.present,
+       present_with_info = config->open_gl.present_with_info,
+       user_data](const flutter::GLPresentInfo& gl_present_info) -> bool {
     if (present) {
       return present(user_data);
     } else {
+      FlutterRect frame_damage_rect = {};
+      FlutterRect buffer_damage_rect = {};
       FlutterPresentInfo present_info = {};
       present_info.struct_size = sizeof(FlutterPresentInfo);
-      present_info.fbo_id = fbo_id;
+      present_info.fbo_id = gl_present_info.fbo_id;
+      present_info.frame_damage.struct_size = sizeof(FlutterDamage);
+      if (gl_present_info.frame_damage.has_value()) {
+        frame_damage_rect = SkIRectToFlutterRect(*gl_present_info.frame_damage);
+        present_info.frame_damage.num_rects = 1;
+        present_info.frame_damage.damage = &frame_damage_rect;
+      }
+      present_info.buffer_damage.struct_size = sizeof(FlutterDamage);
+      if (gl_present_info.buffer_damage.has_value()) {
+        buffer_damage_rect =
+            SkIRectToFlutterRect(*gl_present_info.buffer_damage);
+        present_info.buffer_damage.num_rects = 1;
+        present_info.buffer_damage.damage = &buffer_damage_rect;
+      }
       return present_with_info(user_data, &present_info);
     }
   };
@@ -207,6 +235,18 @@ InferOpenGLPlatformViewCreationCallback(
         };
   }
 
+  std::function<bool(size_t)> gl_make_pooled_resource_current_callback =
+      nullptr;
+  size_t gl_pooled_resource_context_count = 0;
+  if (SAFE_ACCESS(open_gl_config, make_pooled_resource_current, nullptr) !=
+      nullptr) {
+    gl_make_pooled_resource_current_callback =
+        [ptr = config->open_gl.make_pooled_resource_current,
+         user_data](size_t index) { return ptr(user_data, index); };
+    gl_pooled_resource_context_count =
+        SAFE_ACCESS(open_gl_config, pooled_resource_context_count, 0);
+  }
+
   std::function<SkMatrix(void)> gl_surface_transformation_callback = nullptr;
   if (SAFE_ACCESS(open_gl_config, surface_transformation, nullptr) != nullptr) {
     gl_surface_transformation_callback =
@@ -247,6 +287,15 @@ InferOpenGLPlatformViewCreationCallback(
   bool fbo_reset_after_present =
       SAFE_ACCESS(open_gl_config, fbo_reset_after_present, false);
 
+  // Partial repaint is not supported in combination with a custom compositor
+  // as the frame is then rendered into embedder provided backing stores.
+  std::function<uint32_t(void)> gl_buffer_age_callback = nullptr;
+  if (SAFE_ACCESS(open_gl_config, buffer_age_callback, nullptr) != nullptr &&
+      !external_view_embedder) {
+    gl_buffer_age_callback = [ptr = config->open_gl.buffer_age_callback,
+                              user_data]() { return ptr(user_data); };
+  }
+
   flutter::EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table = {
       gl_make_current,                     // gl_make_current_callback
       gl_clear_current,                    // gl_clear_current_callback
@@ -255,7 +304,12 @@ InferOpenGLPlatformViewCreationCallback(
       gl_make_resource_current_callback,   // gl_make_resource_current_callback
       gl_surface_transformation_callback,  // gl_surface_transformation_callback
       gl_proc_resolver,                    // gl_proc_resolver
+      gl_buffer_age_callback,              // gl_buffer_age_callback
   };
+  gl_dispatch_table.gl_make_pooled_resource_current_callback =
+      gl_make_pooled_resource_current_callback;
+  gl_dispatch_table.gl_pooled_resource_context_count =
+      gl_pooled_resource_context_count;
 
   return fml::MakeCopyable(
       [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
@@ -287,15 +341,73 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store;
+  if (auto ptr = SAFE_ACCESS(&config->software, surface_present_callback,
+                             nullptr)) {
+    software_present_backing_store =
+        [ptr, user_data](const void* allocation, size_t row_bytes,
+                         size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
+
+  std::function<bool(const flutter::EmbedderSurfaceSoftware::PresentInfo&)>
+      software_present_backing_store_with_info;
+  if (auto ptr = SAFE_ACCESS(&config->software,
+                             surface_present_with_info_callback, nullptr)) {
+    software_present_backing_store_with_info =
+        [ptr, user_data](
+            const flutter::EmbedderSurfaceSoftware::PresentInfo& info) -> bool {
+      FlutterRect frame_damage_rect = {};
+      FlutterRect buffer_damage_rect = {};
+      FlutterSoftwarePresentInfo present_info = {};
+      present_info.struct_size = sizeof(FlutterSoftwarePresentInfo);
+      present_info.allocation = info.allocation;
+      present_info.row_bytes = info.row_bytes;
+      present_info.height = info.height;
+      present_info.buffer_user_data = info.buffer_user_data;
+      present_info.frame_damage.struct_size = sizeof(FlutterDamage);
+      if (info.frame_damage.has_value()) {
+        frame_damage_rect = SkIRectToFlutterRect(*info.frame_damage);
+        present_info.frame_damage.num_rects = 1;
+        present_info.frame_damage.damage = &frame_damage_rect;
+      }
+      present_info.buffer_damage.struct_size = sizeof(FlutterDamage);
+      if (info.buffer_damage.has_value()) {
+        buffer_damage_rect = SkIRectToFlutterRect(*info.buffer_damage);
+        present_info.buffer_damage.num_rects = 1;
+        present_info.buffer_damage.damage = &buffer_damage_rect;
+      }
+      return ptr(user_data, &present_info);
+    };
+  }
+
+  std::function<std::optional<flutter::EmbedderSurfaceSoftware::Buffer>(
+      const SkISize&)>
+      software_acquire_buffer;
+  if (auto ptr =
+          SAFE_ACCESS(&config->software, acquire_buffer_callback, nullptr)) {
+    software_acquire_buffer = [ptr, user_data](const SkISize& size)
+        -> std::optional<flutter::EmbedderSurfaceSoftware::Buffer> {
+      FlutterSoftwareBuffer buffer = {};
+      buffer.struct_size = sizeof(FlutterSoftwareBuffer);
+      if (!ptr(user_data, size.width(), size.height(), &buffer)) {
+        return std::nullopt;
+      }
+      return flutter::EmbedderSurfaceSoftware::Buffer{
+          buffer.allocation,  // allocation
+          buffer.row_bytes,   // row bytes
+          buffer.user_data,   // user data
+      };
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,            // required (or next)
+          software_present_backing_store_with_info,  // required (or previous)
+          software_acquire_buffer,                   // optional
       };
 
   return fml::MakeCopyable(
@@ -567,9 +679,11 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
             user_data);
       };
 
-  return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              create_render_target_callback, present_callback),
-          false};
+  auto view_embedder = std::make_unique<flutter::EmbedderExternalViewEmbedder>(
+      create_render_target_callback, present_callback);
+  view_embedder->SetCoalesceOverlays(
+      SAFE_ACCESS(compositor, coalesce_overlay_layers, false));
+  return {std::move(view_embedder), false};
 }
 
 struct _FlutterPlatformMessageResponseHandle {
@@ -819,6 +933,54 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   settings.assets_path = args->assets_path;
   settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
   settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
+  settings.raster_cache_max_bytes =
+      SAFE_ACCESS(args, raster_cache_max_bytes, 0);
+
+  // Embedders opt into the priorities of the engine managed threads, so that
+  // they are not changed under embedders tuning their own threads.
+  if (!SAFE_ACCESS(args, enable_thread_priorities, false)) {
+    settings.ui_thread_priority = fml::Thread::ThreadPriority::kNormal;
+    settings.raster_thread_priority = fml::Thread::ThreadPriority::kNormal;
+    settings.io_thread_priority = fml::Thread::ThreadPriority::kNormal;
+  }
+  settings.enable_thread_cpu_affinity =
+      settings.enable_thread_cpu_affinity ||
+      SAFE_ACCESS(args, enable_thread_cpu_affinity, false);
+
+  if (SAFE_ACCESS(args, thread_launch_callback, nullptr) != nullptr) {
+    settings.thread_launcher = [ptr = args->thread_launch_callback, user_data](
+                                   const fml::Thread::ThreadConfig& config,
+                                   fml::closure entry) -> bool {
+      FlutterThreadConfig embedder_config = {};
+      embedder_config.struct_size = sizeof(FlutterThreadConfig);
+      embedder_config.name = config.name.c_str();
+      switch (config.priority) {
+        case fml::Thread::ThreadPriority::kBackground:
+          embedder_config.priority = kFlutterThreadPriorityBackground;
+          break;
+        case fml::Thread::ThreadPriority::kNormal:
+          embedder_config.priority = kFlutterThreadPriorityNormal;
+          break;
+        case fml::Thread::ThreadPriority::kDisplay:
+          embedder_config.priority = kFlutterThreadPriorityDisplay;
+          break;
+        case fml::Thread::ThreadPriority::kRaster:
+          embedder_config.priority = kFlutterThreadPriorityRaster;
+          break;
+      }
+      auto* entry_data = new fml::closure(std::move(entry));
+      FlutterThreadEntryCallback entry_callback = [](void* data) {
+        std::unique_ptr<fml::closure> closure(
+            reinterpret_cast<fml::closure*>(data));
+        (*closure)();
+      };
+      if (!ptr(user_data, &embedder_config, entry_callback, entry_data)) {
+        delete entry_data;
+        return false;
+      }
+      return true;
+    };
+  }
 
   if (!flutter::DartVM::IsRunningPrecompiledCode()) {
     // Verify the assets path contains Dart 2 kernel assets.
@@ -941,8 +1103,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           const FlutterPlatformMessage incoming_message = {
               sizeof(FlutterPlatformMessage),  // struct_size
               message->channel().c_str(),      // channel
-              message->data().data(),          // message
-              message->data().size(),          // message_size
+              message->data().GetMapping(),    // message
+              message->data().GetSize(),       // message_size
               handle,                          // response_handle
           };
           handle->message = std::move(message);
@@ -957,6 +1119,30 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     };
   }
 
+  flutter::VsyncWaiterEmbedder::PreferredFrameRateCallback
+      preferred_frame_rate_callback = nullptr;
+  if (SAFE_ACCESS(args, preferred_frame_rate_callback, nullptr) != nullptr) {
+    preferred_frame_rate_callback =
+        [ptr = args->preferred_frame_rate_callback,
+         user_data](double frames_per_second) {
+          ptr(user_data, frames_per_second);
+        };
+  }
+
+  std::shared_ptr<flutter::EmbedderFramePump> frame_pump;
+  if (SAFE_ACCESS(args, manual_frame_pumping, false)) {
+    if (vsync_callback) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "A vsync callback may not be specified with manual frame pumping.");
+    }
+    frame_pump = std::make_shared<flutter::EmbedderFramePump>(
+        &flutter::VsyncWaiterEmbedder::OnEmbedderVsync);
+    vsync_callback = [frame_pump](intptr_t baton) {
+      frame_pump->OnVsyncRequested(baton);
+    };
+  }
+
   flutter::PlatformViewEmbedder::ComputePlatformResolvedLocaleCallback
       compute_platform_resolved_locale_callback = nullptr;
   if (SAFE_ACCESS(args, compute_platform_resolved_locale_callback, nullptr) !=
@@ -1019,6 +1205,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
           platform_message_response_callback,         //
           vsync_callback,                             //
           compute_platform_resolved_locale_callback,  //
+          preferred_frame_rate_callback,              //
       };
 
   auto on_create_platform_view = InferPlatformViewCreationCallback(
@@ -1097,9 +1284,71 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   }
 #endif
 
+#if defined(SHELL_ENABLE_GL) && OS_LINUX
+  static_assert(FLUTTER_DMA_BUF_MAX_PLANES ==
+                    flutter::EmbedderExternalTextureDmaBuf::kMaxPlanes,
+                "The plane counts of the embedder API and the texture differ.");
+  flutter::EmbedderExternalTextureDmaBuf::FrameCallback
+      dma_buf_texture_callback;
+  flutter::EmbedderExternalTextureDmaBuf::ProcResolver dma_buf_proc_resolver;
+  if (config->type == kOpenGL) {
+    const FlutterOpenGLRendererConfig* open_gl_config = &config->open_gl;
+    if (SAFE_ACCESS(open_gl_config, gl_dma_buf_texture_frame_callback,
+                    nullptr) != nullptr) {
+      dma_buf_texture_callback =
+          [ptr = open_gl_config->gl_dma_buf_texture_frame_callback, user_data](
+              int64_t texture_identifier, const SkISize& size,
+              flutter::EmbedderExternalTextureDmaBuf::Frame* frame) -> bool {
+        FlutterDmaBufTexture texture = {};
+        texture.acquire_fence_fd = -1;
+
+        if (!ptr(user_data, texture_identifier, size.width(), size.height(),
+                 &texture)) {
+          return false;
+        }
+
+        frame->target = texture.target;
+        frame->size = SkISize::Make(texture.width, texture.height);
+        frame->fourcc = texture.fourcc;
+        frame->has_modifier = texture.has_modifier;
+        frame->modifier = texture.modifier;
+        // Invalid plane counts are rejected, and the frame released, on
+        // import.
+        const size_t plane_count =
+            texture.plane_count > FLUTTER_DMA_BUF_MAX_PLANES
+                ? 0
+                : texture.plane_count;
+        for (size_t i = 0; i < plane_count; i++) {
+          frame->planes.push_back({texture.planes[i].fd,
+                                   texture.planes[i].offset,
+                                   texture.planes[i].pitch});
+        }
+        frame->acquire_fence_fd = texture.acquire_fence_fd;
+        if (texture.release_callback != nullptr) {
+          frame->release_callback = [release = texture.release_callback,
+                                     release_user_data = texture.user_data](
+                                        int release_fence_fd) {
+            release(release_user_data, release_fence_fd);
+          };
+        }
+        return true;
+      };
+
+      if (SAFE_ACCESS(open_gl_config, gl_proc_resolver, nullptr) != nullptr) {
+        dma_buf_proc_resolver = [ptr = open_gl_config->gl_proc_resolver,
+                                 user_data](const char* name) {
+          return ptr(user_data, name);
+        };
+      } else {
+        dma_buf_proc_resolver = DefaultGLProcResolver;
+      }
+    }
+  }
+#endif
+
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          SAFE_ACCESS(args, custom_task_runners, nullptr));
+          SAFE_ACCESS(args, custom_task_runners, nullptr), settings);
 
   if (!thread_host || !thread_host->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
@@ -1158,6 +1407,17 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 #endif
   );
 
+  if (frame_pump) {
+    embedder_engine->SetFramePump(std::move(frame_pump));
+  }
+
+#if defined(SHELL_ENABLE_GL) && OS_LINUX
+  if (dma_buf_texture_callback) {
+    embedder_engine->SetDmaBufTextureCallbacks(
+        std::move(dma_buf_texture_callback), std::move(dma_buf_proc_resolver));
+  }
+#endif
+
   // Release the ownership of the embedder engine to the caller.
   *engine_out = reinterpret_cast<FLUTTER_API_SYMBOL(FlutterEngine)>(
       embedder_engine.release());
@@ -1202,6 +1462,19 @@ FlutterEngineResult FlutterEngineRunInitialized(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEnginePrewarmDartVM(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine) {
+  if (!engine) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->PrewarmDartVM()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "The engine was already run.");
+  }
+
+  return kSuccess;
+}
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineDeinitialize(FLUTTER_API_SYMBOL(FlutterEngine)
                                                   engine) {
@@ -1320,6 +1593,56 @@ inline int64_t PointerDataButtonsForLegacyEvent(
   return 0;
 }
 
+// Converts a pointer event from the embedder API into the form used by the
+// engine.
+static flutter::PointerData ToPointerData(
+    const FlutterPointerEvent* current) {
+  flutter::PointerData pointer_data;
+  pointer_data.Clear();
+  // this is currely in use only on android embedding.
+  pointer_data.embedder_id = 0;
+  pointer_data.time_stamp = SAFE_ACCESS(current, timestamp, 0);
+  pointer_data.change = ToPointerDataChange(
+      SAFE_ACCESS(current, phase, FlutterPointerPhase::kCancel));
+  pointer_data.physical_x = SAFE_ACCESS(current, x, 0.0);
+  pointer_data.physical_y = SAFE_ACCESS(current, y, 0.0);
+  // Delta will be generated in pointer_data_packet_converter.cc.
+  pointer_data.physical_delta_x = 0.0;
+  pointer_data.physical_delta_y = 0.0;
+  pointer_data.device = SAFE_ACCESS(current, device, 0);
+  // Pointer identifier will be generated in
+  // pointer_data_packet_converter.cc.
+  pointer_data.pointer_identifier = 0;
+  pointer_data.signal_kind = ToPointerDataSignalKind(
+      SAFE_ACCESS(current, signal_kind, kFlutterPointerSignalKindNone));
+  pointer_data.scroll_delta_x = SAFE_ACCESS(current, scroll_delta_x, 0.0);
+  pointer_data.scroll_delta_y = SAFE_ACCESS(current, scroll_delta_y, 0.0);
+  FlutterPointerDeviceKind device_kind = SAFE_ACCESS(current, device_kind, 0);
+  // For backwards compatibility with embedders written before the device
+  // kind and buttons were exposed, if the device kind is not set treat it
+  // as a mouse, with a synthesized primary button state based on the phase.
+  if (device_kind == 0) {
+    pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
+    pointer_data.buttons =
+        PointerDataButtonsForLegacyEvent(pointer_data.change);
+
+  } else {
+    pointer_data.kind = ToPointerDataKind(device_kind);
+    if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
+      // For touch events, set the button internally rather than requiring
+      // it at the API level, since it's a confusing construction to expose.
+      if (pointer_data.change == flutter::PointerData::Change::kDown ||
+          pointer_data.change == flutter::PointerData::Change::kMove) {
+        pointer_data.buttons = flutter::kPointerButtonTouchContact;
+      }
+    } else {
+      // Buttons use the same mask values, so pass them through directly.
+      pointer_data.buttons = SAFE_ACCESS(current, buttons, 0);
+    }
+  }
+  return pointer_data;
+}
+
 FlutterEngineResult FlutterEngineSendPointerEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPointerEvent* pointers,
@@ -1337,50 +1660,7 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
   const FlutterPointerEvent* current = pointers;
 
   for (size_t i = 0; i < events_count; ++i) {
-    flutter::PointerData pointer_data;
-    pointer_data.Clear();
-    // this is currely in use only on android embedding.
-    pointer_data.embedder_id = 0;
-    pointer_data.time_stamp = SAFE_ACCESS(current, timestamp, 0);
-    pointer_data.change = ToPointerDataChange(
-        SAFE_ACCESS(current, phase, FlutterPointerPhase::kCancel));
-    pointer_data.physical_x = SAFE_ACCESS(current, x, 0.0);
-    pointer_data.physical_y = SAFE_ACCESS(current, y, 0.0);
-    // Delta will be generated in pointer_data_packet_converter.cc.
-    pointer_data.physical_delta_x = 0.0;
-    pointer_data.physical_delta_y = 0.0;
-    pointer_data.device = SAFE_ACCESS(current, device, 0);
-    // Pointer identifier will be generated in
-    // pointer_data_packet_converter.cc.
-    pointer_data.pointer_identifier = 0;
-    pointer_data.signal_kind = ToPointerDataSignalKind(
-        SAFE_ACCESS(current, signal_kind, kFlutterPointerSignalKindNone));
-    pointer_data.scroll_delta_x = SAFE_ACCESS(current, scroll_delta_x, 0.0);
-    pointer_data.scroll_delta_y = SAFE_ACCESS(current, scroll_delta_y, 0.0);
-    FlutterPointerDeviceKind device_kind = SAFE_ACCESS(current, device_kind, 0);
-    // For backwards compatibility with embedders written before the device
-    // kind and buttons were exposed, if the device kind is not set treat it
-    // as a mouse, with a synthesized primary button state based on the phase.
-    if (device_kind == 0) {
-      pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
-      pointer_data.buttons =
-          PointerDataButtonsForLegacyEvent(pointer_data.change);
-
-    } else {
-      pointer_data.kind = ToPointerDataKind(device_kind);
-      if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
-        // For touch events, set the button internally rather than requiring
-        // it at the API level, since it's a confusing construction to expose.
-        if (pointer_data.change == flutter::PointerData::Change::kDown ||
-            pointer_data.change == flutter::PointerData::Change::kMove) {
-          pointer_data.buttons = flutter::kPointerButtonTouchContact;
-        }
-      } else {
-        // Buttons use the same mask values, so pass them through directly.
-        pointer_data.buttons = SAFE_ACCESS(current, buttons, 0);
-      }
-    }
-    packet->SetPointerData(i, pointer_data);
+    packet->SetPointerData(i, ToPointerData(current));
     current = reinterpret_cast<const FlutterPointerEvent*>(
         reinterpret_cast<const uint8_t*>(current) + current->struct_size);
   }
@@ -1393,6 +1673,37 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
                                   "running Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineQueuePointerEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* pointers,
+    size_t events_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (pointers == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
+  }
+
+  std::vector<flutter::PointerData> pointer_data;
+  pointer_data.reserve(events_count);
+
+  const FlutterPointerEvent* current = pointers;
+
+  for (size_t i = 0; i < events_count; ++i) {
+    pointer_data.push_back(ToPointerData(current));
+    current = reinterpret_cast<const FlutterPointerEvent*>(
+        reinterpret_cast<const uint8_t*>(current) + current->struct_size);
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)->QueuePointerData(
+             pointer_data.data(), pointer_data.size())
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not queue pointer events for the "
+                                  "running Flutter application.");
+}
+
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* flutter_message) {
@@ -1426,10 +1737,29 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     response = response_handle->message->response();
   }
 
+  VoidCallback message_release_callback =
+      SAFE_ACCESS(flutter_message, message_release_callback, nullptr);
+  void* message_release_user_data =
+      SAFE_ACCESS(flutter_message, message_release_user_data, nullptr);
+
   fml::RefPtr<flutter::PlatformMessage> message;
   if (message_size == 0) {
+    if (message_release_callback) {
+      message_release_callback(message_release_user_data);
+    }
     message = fml::MakeRefCounted<flutter::PlatformMessage>(
         flutter_message->channel, response);
+  } else if (message_release_callback) {
+    // The buffer is handed to the engine (and possibly Dart) without a copy.
+    message = fml::MakeRefCounted<flutter::PlatformMessage>(
+        flutter_message->channel,
+        std::make_unique<fml::NonOwnedMapping>(
+            message_data, message_size,
+            [message_release_callback, message_release_user_data](
+                const uint8_t* data, size_t size) {
+              message_release_callback(message_release_user_data);
+            }),
+        response);
   } else {
     message = fml::MakeRefCounted<flutter::PlatformMessage>(
         flutter_message->channel,
@@ -1545,6 +1875,26 @@ FlutterEngineResult FlutterEngineRegisterExternalTexture(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineRegisterExternalDmaBufTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (texture_identifier == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Texture identifier was invalid.");
+  }
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->RegisterDmaBufTexture(texture_identifier)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "DMA-BUF textures are not supported by this renderer configuration.");
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineUnregisterExternalTexture(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier) {
@@ -1676,6 +2026,151 @@ FlutterEngineResult FlutterEngineReloadSystemFonts(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineSetPlatformMessageChannelBackground(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    bool background) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid channel name.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->SetPlatformMessageChannelBackground(channel, background)) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not update the platform message channel.");
+  }
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSetPlatformMessageChannelBatching(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageBatching batching) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid channel name.");
+  }
+
+  flutter::Engine::PlatformMessageBatching engine_batching;
+  switch (batching) {
+    case kFlutterPlatformMessageBatchingNone:
+      engine_batching = flutter::Engine::PlatformMessageBatching::kNone;
+      break;
+    case kFlutterPlatformMessageBatchingBatch:
+      engine_batching = flutter::Engine::PlatformMessageBatching::kBatch;
+      break;
+    case kFlutterPlatformMessageBatchingKeepLatest:
+      engine_batching = flutter::Engine::PlatformMessageBatching::kKeepLatest;
+      break;
+    default:
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid platform message batching.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->SetPlatformMessageChannelBatching(channel, engine_batching)) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not update the platform message channel.");
+  }
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (ring_buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid ring buffer out parameter.");
+  }
+
+  auto buffer = flutter::EmbedderDartRingBuffer::Create(port, capacity);
+  if (!buffer) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid port or ring buffer capacity.");
+  }
+
+  if (!buffer->PostToPort()) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not post the ring buffer to the Dart VM.");
+  }
+
+  *ring_buffer = reinterpret_cast<FlutterEngineRingBuffer>(
+      new std::shared_ptr<flutter::EmbedderDartRingBuffer>(std::move(buffer)));
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    bool* written) {
+  if (ring_buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid ring buffer.");
+  }
+
+  if ((data == nullptr && size > 0) || written == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid arguments.");
+  }
+
+  auto& buffer =
+      *reinterpret_cast<std::shared_ptr<flutter::EmbedderDartRingBuffer>*>(
+          ring_buffer);
+  *written = buffer->Write(data, size);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FlutterEngineRingBuffer ring_buffer) {
+  if (ring_buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid ring buffer.");
+  }
+
+  delete reinterpret_cast<std::shared_ptr<flutter::EmbedderDartRingBuffer>*>(
+      ring_buffer);
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEnginePumpFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    uint64_t frame_start_time_nanos,
+    uint64_t frame_target_time_nanos) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  TRACE_EVENT0("flutter", "FlutterEnginePumpFrame");
+
+  auto start_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(frame_start_time_nanos));
+
+  auto target_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(frame_target_time_nanos));
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->PumpFrame(
+          start_time, target_time)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The engine was not initialized with manual frame pumping.");
+  }
+
+  return kSuccess;
+}
+
 void FlutterEngineTraceEventDurationBegin(const char* name) {
   fml::tracing::TraceEvent0("flutter", name);
 }
@@ -1727,6 +2222,20 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "Could not run the specified task.");
 }
 
+FlutterEngineResult FlutterEngineRunTasks(FLUTTER_API_SYMBOL(FlutterEngine)
+                                              engine,
+                                          FlutterTaskRunner runner) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)->RunTasks(runner)
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                  "Could not run the tasks of the specified "
+                                  "task runner.");
+}
+
 static bool DispatchJSONPlatformMessage(FLUTTER_API_SYMBOL(FlutterEngine)
                                             engine,
                                         rapidjson::Document document,
@@ -1948,12 +2457,32 @@ FlutterEngineResult FlutterEnginePostDartObject(
 
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) raw_engine) {
+  return FlutterEngineNotifyMemoryPressure(raw_engine,
+                                           kFlutterMemoryPressureCritical);
+}
+
+FlutterEngineResult FlutterEngineNotifyMemoryPressure(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterMemoryPressureLevel level) {
   auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
   if (engine == nullptr || !engine->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
   }
 
-  engine->GetShell().NotifyLowMemoryWarning();
+  flutter::MemoryPressureLevel engine_level;
+  switch (level) {
+    case kFlutterMemoryPressureModerate:
+      engine_level = flutter::MemoryPressureLevel::kModerate;
+      break;
+    case kFlutterMemoryPressureCritical:
+      engine_level = flutter::MemoryPressureLevel::kCritical;
+      break;
+    default:
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid memory pressure level specified.");
+  }
+
+  engine->GetShell().NotifyLowMemoryWarning(engine_level);
 
   rapidjson::Document document;
   auto& allocator = document.GetAllocator();
@@ -1969,6 +2498,35 @@ FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
                    "Could not dispatch the low memory notification message.");
 }
 
+FlutterEngineResult FlutterEngineGetMemoryBreakdown(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterEngineMemoryBreakdown* breakdown) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (breakdown == nullptr ||
+      breakdown->struct_size < sizeof(FlutterEngineMemoryBreakdown)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid memory breakdown specified.");
+  }
+
+  const auto memory = engine->GetShell().GetMemoryBreakdown();
+  breakdown->dart_heap_used_bytes =
+      memory.dart_heap.new_used_bytes + memory.dart_heap.old_used_bytes;
+  breakdown->dart_heap_capacity_bytes =
+      memory.dart_heap.new_capacity_bytes + memory.dart_heap.old_capacity_bytes;
+  breakdown->dart_external_bytes = memory.dart_heap.external_bytes;
+  breakdown->raster_cache_bytes =
+      memory.raster_cache_layer_bytes + memory.raster_cache_picture_bytes;
+  breakdown->gpu_resource_bytes = memory.gpu_resource_bytes;
+  breakdown->gpu_resource_purgeable_bytes =
+      memory.gpu_resource_purgeable_bytes;
+  breakdown->decoded_image_cache_bytes = memory.decoded_image_cache_bytes;
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterNativeThreadCallback callback,
@@ -2048,6 +2606,58 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
   }
 }
 
+FlutterEngineResult FlutterEngineGetFrameHistogram(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterFramePhase phase,
+    FlutterFrameHistogram* histogram) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (histogram == nullptr ||
+      histogram->struct_size < sizeof(FlutterFrameHistogram)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame histogram specified.");
+  }
+
+  flutter::FrameHistograms::Phase frame_phase;
+  switch (phase) {
+    case kFlutterFramePhaseVsyncOverhead:
+      frame_phase = flutter::FrameHistograms::kVsyncOverhead;
+      break;
+    case kFlutterFramePhaseBuild:
+      frame_phase = flutter::FrameHistograms::kBuild;
+      break;
+    case kFlutterFramePhasePreroll:
+      frame_phase = flutter::FrameHistograms::kPreroll;
+      break;
+    case kFlutterFramePhasePaint:
+      frame_phase = flutter::FrameHistograms::kPaint;
+      break;
+    case kFlutterFramePhaseSubmit:
+      frame_phase = flutter::FrameHistograms::kSubmit;
+      break;
+    case kFlutterFramePhaseRasterCacheHits:
+      frame_phase = flutter::FrameHistograms::kRasterCacheHits;
+      break;
+    case kFlutterFramePhaseGPU:
+      frame_phase = flutter::FrameHistograms::kGPU;
+      break;
+    default:
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid FlutterFramePhase specified.");
+  }
+
+  const auto summary = engine->GetShell().GetFrameHistogram(frame_phase);
+  histogram->count = summary.count;
+  histogram->p50 = summary.p50;
+  histogram->p90 = summary.p90;
+  histogram->p99 = summary.p99;
+  histogram->max = summary.max;
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -2097,6 +2707,22 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(PostCallbackOnAllNativeThreads,
            FlutterEnginePostCallbackOnAllNativeThreads);
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
+  SET_PROC(QueuePointerEvents, FlutterEngineQueuePointerEvents);
+  SET_PROC(PrewarmDartVM, FlutterEnginePrewarmDartVM);
+  SET_PROC(GetFrameHistogram, FlutterEngineGetFrameHistogram);
+  SET_PROC(RegisterExternalDmaBufTexture,
+           FlutterEngineRegisterExternalDmaBufTexture);
+  SET_PROC(SetPlatformMessageChannelBackground,
+           FlutterEngineSetPlatformMessageChannelBackground);
+  SET_PROC(SetPlatformMessageChannelBatching,
+           FlutterEngineSetPlatformMessageChannelBatching);
+  SET_PROC(CreateRingBuffer, FlutterEngineCreateRingBuffer);
+  SET_PROC(RingBufferWrite, FlutterEngineRingBufferWrite);
+  SET_PROC(CollectRingBuffer, FlutterEngineCollectRingBuffer);
+  SET_PROC(PumpFrame, FlutterEnginePumpFrame);
+  SET_PROC(NotifyMemoryPressure, FlutterEngineNotifyMemoryPressure);
+  SET_PROC(GetMemoryBreakdown, FlutterEngineGetMemoryBreakdown);
+  SET_PROC(RunTasks, FlutterEngineRunTasks);
 #undef SET_PROC
 
   return kSuccess;
@@ -294,6 +294,7 @@ typedef struct {
 typedef bool (*BoolCallback)(void* /* user data */);
 typedef FlutterTransformation (*TransformationCallback)(void* /* user data */);
 typedef uint32_t (*UIntCallback)(void* /* user data */);
+typedef bool (*BoolIndexCallback)(void* /* user data */, size_t /* index */);
 typedef bool (*SoftwareSurfacePresentCallback)(void* /* user data */,
                                                const void* /* allocation */,
                                                size_t /* row bytes */,
@@ -305,6 +306,71 @@ typedef bool (*TextureFrameCallback)(void* /* user data */,
                                      size_t /* height */,
                                      FlutterOpenGLTexture* /* texture out */);
 typedef void (*VsyncCallback)(void* /* user data */, intptr_t /* baton */);
+typedef void (*PreferredFrameRateCallback)(void* /* user data */,
+                                           double /* frames per second */);
+
+/// The maximum number of planes of a `FlutterDmaBufTexture`.
+#define FLUTTER_DMA_BUF_MAX_PLANES 4
+
+typedef struct {
+  /// The file descriptor of the DMA-BUF that contains the plane. The engine
+  /// only uses it while importing the buffer and does not take ownership of
+  /// it.
+  int32_t fd;
+  /// The offset of the plane from the start of the buffer, in bytes.
+  uint32_t offset;
+  /// The number of bytes between the starts of two rows of the plane.
+  uint32_t pitch;
+} FlutterDmaBufPlane;
+
+typedef void (*FlutterDmaBufReleaseCallback)(void* /* user data */,
+                                             int32_t /* release fence fd */);
+
+typedef struct {
+  /// The target the buffer is bound to as a texture. GL_TEXTURE_2D (or 0) for
+  /// single plane RGB formats. GL_TEXTURE_EXTERNAL_OES for formats the GPU
+  /// has to convert when sampling, like multi-planar YUV formats, on OpenGL
+  /// ES.
+  uint32_t target;
+  /// The width of the buffer, in pixels.
+  uint32_t width;
+  /// The height of the buffer, in pixels.
+  uint32_t height;
+  /// The DRM fourcc code of the format of the buffer (example
+  /// DRM_FORMAT_ABGR8888 or DRM_FORMAT_NV12).
+  uint32_t fourcc;
+  /// Whether the planes have an explicit DRM format modifier. This requires
+  /// `EGL_EXT_image_dma_buf_import_modifiers`.
+  bool has_modifier;
+  /// The DRM format modifier of all the planes (example
+  /// DRM_FORMAT_MOD_LINEAR).
+  uint64_t modifier;
+  /// The number of valid entries of `planes`, at most
+  /// `FLUTTER_DMA_BUF_MAX_PLANES`.
+  size_t plane_count;
+  FlutterDmaBufPlane planes[FLUTTER_DMA_BUF_MAX_PLANES];
+  /// A sync file that signals once the producer of the buffer is done writing
+  /// into it, or -1 if the buffer is ready. The engine takes ownership of the
+  /// file descriptor and makes the GPU wait on it before sampling the buffer,
+  /// so the embedder does not have to block.
+  int32_t acquire_fence_fd;
+  /// User data to be returned on the invocation of the release callback.
+  void* user_data;
+  /// Callback invoked (on an engine managed thread) once the engine is done
+  /// with the buffer, after a newer frame replaced it or the texture was
+  /// unregistered. The release fence fd is a sync file that signals once the
+  /// GPU stopped reading the buffer, or -1 if it already has. The embedder
+  /// takes ownership of it and must wait on it before writing into the buffer
+  /// again.
+  FlutterDmaBufReleaseCallback release_callback;
+} FlutterDmaBufTexture;
+
+typedef bool (*DmaBufTextureFrameCallback)(
+    void* /* user data */,
+    int64_t /* texture identifier */,
+    size_t /* width */,
+    size_t /* height */,
+    FlutterDmaBufTexture* /* texture out */);
 
 /// A structure to represent the width and height.
 typedef struct {
@@ -359,6 +425,18 @@ typedef uint32_t (*UIntFrameInfoCallback)(
     void* /* user data */,
     const FlutterFrameInfo* /* frame info */);
 
+/// A region of a surface, described as a list of rectangles in surface
+/// coordinates with a top-left origin.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterDamage).
+  size_t struct_size;
+  /// The number of rectangles in `damage`.
+  size_t num_rects;
+  /// The rectangles making up the region. This array is owned by the engine
+  /// and is only valid for the duration of the call it is passed to.
+  FlutterRect* damage;
+} FlutterDamage;
+
 /// This information is passed to the embedder when a surface is presented.
 ///
 /// See: \ref FlutterOpenGLRendererConfig.present_with_info.
@@ -367,6 +445,15 @@ typedef struct {
   size_t struct_size;
   /// Id of the fbo backing the surface that was presented.
   uint32_t fbo_id;
+  /// The area of the frame that changed since the previously presented frame.
+  /// Embedders may pass this to `eglSwapBuffersWithDamageKHR` or an
+  /// equivalent. If `num_rects` is 0, the whole frame changed.
+  FlutterDamage frame_damage;
+  /// The area of the framebuffer that was repainted by the engine. This is
+  /// larger than `frame_damage` when the framebuffer was older than the
+  /// previous frame. Embedders may pass this to `eglSetDamageRegionKHR` or an
+  /// equivalent. If `num_rects` is 0, the whole framebuffer was repainted.
+  FlutterDamage buffer_damage;
 } FlutterPresentInfo;
 
 /// Callback for when a surface is presented.
@@ -432,8 +519,96 @@ typedef struct {
   /// `FlutterPresentInfo` struct that the embedder can use to release any
   /// resources. The return value indicates success of the present call.
   BoolPresentInfoCallback present_with_info;
+  /// This is an optional callback. If specified, the engine will only repaint
+  /// the area of each frame that changed since the previous frame. Before
+  /// rendering a frame, the engine calls this callback to query the age of
+  /// the contents of the framebuffer about to be rendered into, as defined
+  /// by `EGL_EXT_buffer_age`: 1 if it contains the previously presented
+  /// frame, N if it contains the frame presented N frames ago and 0 if its
+  /// contents are undefined. The damage of each frame is passed to
+  /// `present_with_info`. This callback is ignored when a custom compositor
+  /// is specified.
+  UIntCallback buffer_age_callback;
+  /// This is an optional callback. When a texture registered with
+  /// `FlutterEngineRegisterExternalDmaBufTexture` has a new frame available,
+  /// the engine calls this method (on an internal engine managed thread) to
+  /// get the DMA-BUF that contains the frame. The buffer is imported as an
+  /// `EGLImage` with `EGL_EXT_image_dma_buf_import` and sampled without
+  /// being copied. This requires an EGL context, and the `gl_proc_resolver`
+  /// must also resolve the EGL extension functions, like
+  /// `eglGetProcAddress` does. DMA-BUF textures are only supported on Linux.
+  DmaBufTextureFrameCallback gl_dma_buf_texture_frame_callback;
+  /// The number of additional resource contexts that the engine may make
+  /// current with `make_pooled_resource_current`. Decoded images are
+  /// uploaded on that many engine managed threads in parallel instead of
+  /// only on the thread of `make_resource_current`. Zero, the default,
+  /// disables the pool.
+  size_t pooled_resource_context_count;
+  /// This is an optional callback. Flutter will ask the embedder to make the
+  /// resource context with the given index, between 0 and
+  /// `pooled_resource_context_count - 1`, current on a background thread.
+  /// Each index is made current once, on its own thread, which keeps it for
+  /// the lifetime of the engine. Like the context of `make_resource_current`,
+  /// these contexts must be in the same sharegroup as the main rendering
+  /// context. Returning false makes the engine skip that context.
+  BoolIndexCallback make_pooled_resource_current;
 } FlutterOpenGLRendererConfig;
 
+/// A buffer supplied by the embedder for the software renderer to render a
+/// frame into.
+///
+/// See: \ref FlutterSoftwareRendererConfig.acquire_buffer_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwareBuffer).
+  size_t struct_size;
+  /// The pixels of the buffer, `height` rows of `row_bytes` bytes each. The
+  /// pixel format is the native 32-bit RGBA format.
+  void* allocation;
+  /// The number of bytes between the start of two rows. Must be at least four
+  /// times the width of the buffer.
+  size_t row_bytes;
+  /// Passed back to the embedder when the buffer is presented.
+  void* user_data;
+} FlutterSoftwareBuffer;
+
+/// Callback for when the software renderer needs a buffer of the given size.
+typedef bool (*SoftwareBufferAcquireCallback)(
+    void* /* user data */,
+    size_t /* width */,
+    size_t /* height */,
+    FlutterSoftwareBuffer* /* buffer out */);
+
+/// This information is passed to the embedder when a software buffer is
+/// presented.
+///
+/// See: \ref FlutterSoftwareRendererConfig.surface_present_with_info_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwarePresentInfo).
+  size_t struct_size;
+  /// The pixels of the presented buffer.
+  const void* allocation;
+  /// The number of bytes between the start of two rows.
+  size_t row_bytes;
+  /// The number of rows in the buffer.
+  size_t height;
+  /// The `user_data` of the buffer returned by the `acquire_buffer_callback`,
+  /// or NULL if the buffer is owned by the engine.
+  void* buffer_user_data;
+  /// The area of the frame that changed since the previously presented frame.
+  /// Remote display embedders only need to send these pixels. If `num_rects`
+  /// is 0, the whole frame changed.
+  FlutterDamage frame_damage;
+  /// The area of the buffer that was repainted by the engine. This is larger
+  /// than `frame_damage` when the buffer was older than the previous frame. If
+  /// `num_rects` is 0, the whole buffer was repainted.
+  FlutterDamage buffer_damage;
+} FlutterSoftwarePresentInfo;
+
+/// Callback for when a software buffer is presented.
+typedef bool (*SoftwareSurfacePresentWithInfoCallback)(
+    void* /* user data */,
+    const FlutterSoftwarePresentInfo* /* present info */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
@@ -441,7 +616,22 @@ typedef struct {
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
+  ///
+  /// Specifying one (and only one) of `surface_present_callback` or
+  /// `surface_present_with_info_callback` is required.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// Like `surface_present_callback`, but also describes the area of the
+  /// buffer that changed. When this callback is specified, the engine only
+  /// repaints the parts of a buffer that are out of date. This requires the
+  /// contents of a buffer to be left untouched after it is presented.
+  SoftwareSurfacePresentWithInfoCallback surface_present_with_info_callback;
+  /// This is an optional callback. When specified, the engine calls it before
+  /// rendering each frame to get the buffer to render into, instead of using
+  /// a buffer it owns. This lets embedders render directly into memory they
+  /// manage, like a pool of shared memory buffers read by another process.
+  /// The buffer must stay valid until it has been presented, after which the
+  /// engine no longer accesses it. Returning false skips the frame.
+  SoftwareBufferAcquireCallback acquire_buffer_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -574,6 +764,16 @@ typedef struct {
   /// `FlutterEngineSendPlatformMessageResponse` will cause a memory leak. It is
   /// not safe to send multiple responses on a single response object.
   const FlutterPlatformMessageResponseHandle* response_handle;
+  /// Optional. Only used when sending messages to the engine. If specified,
+  /// the engine does not copy the `message` buffer. It takes ownership of it
+  /// when `FlutterEngineSendPlatformMessage` is called and invokes this
+  /// callback with `message_release_user_data` once it is done with it. The
+  /// callback may be invoked on any thread. The buffer may be modified by the
+  /// Dart application until then, so it must be writable. If
+  /// `FlutterEngineSendPlatformMessage` returns `kInvalidArguments`, the
+  /// callback is not invoked and the buffer remains owned by the caller.
+  VoidCallback message_release_callback;
+  void* message_release_user_data;
 } FlutterPlatformMessage;
 
 typedef void (*FlutterPlatformMessageCallback)(
@@ -713,6 +913,12 @@ typedef void (*FlutterTaskRunnerPostTaskCallback)(
     uint64_t /* target time nanos */,
     void* /* user data */);
 
+typedef void (*FlutterTaskRunnerPostTasksCallback)(
+    FlutterTaskRunner /* runner */,
+    uint64_t /* target time nanos */,
+    size_t /* task count */,
+    void* /* user data */);
+
 /// An interface used by the Flutter engine to execute tasks at the target time
 /// on a specified thread. There should be a 1-1 relationship between a thread
 /// and a task runner. It is undefined behavior to run a task on a thread that
@@ -735,11 +941,28 @@ typedef struct {
   /// delta, `FlutterEngineGetCurrentTime` may be called and the difference used
   /// as the delta.
   ///
-  /// @attention     This field is required.
+  /// @attention     This field is required unless `post_tasks_callback` is
+  ///                specified.
   FlutterTaskRunnerPostTaskCallback post_task_callback;
   /// A unique identifier for the task runner. If multiple task runners service
   /// tasks on the same thread, their identifiers must match.
   size_t identifier;
+  /// May be called from any thread. If specified, the engine queues the tasks
+  /// of this task runner itself and uses this callback instead of
+  /// `post_task_callback`. The callback tells the embedder that `task count`
+  /// tasks will be ready at the given target time, which uses the same clock
+  /// as the target time of `post_task_callback`. The embedder should then
+  /// call `FlutterEngineRunTasks` once, on the thread associated with the
+  /// task runner, at or after that time to run all the tasks that have
+  /// expired.
+  ///
+  /// The callback is only made when the earliest pending task moves earlier
+  /// than the last target time the embedder was given, so an embedder that
+  /// schedules a single wakeup per callback (replacing a later one) is woken
+  /// at most once for a burst of tasks. If tasks remain once
+  /// `FlutterEngineRunTasks` is done, the callback is made again with the
+  /// target time of the next one.
+  FlutterTaskRunnerPostTasksCallback post_tasks_callback;
 } FlutterTaskRunnerDescription;
 
 typedef struct {
@@ -757,6 +980,41 @@ typedef struct {
   const FlutterTaskRunnerDescription* render_task_runner;
 } FlutterCustomTaskRunners;
 
+/// The priority the engine would give to a thread it asks the embedder to
+/// start via the `FlutterThreadLaunchCallback`.
+typedef enum {
+  /// For threads that must not compete with the rendering of frames.
+  kFlutterThreadPriorityBackground,
+  /// The default priority of new threads.
+  kFlutterThreadPriorityNormal,
+  /// For threads that produce the content of frames, like the UI thread.
+  kFlutterThreadPriorityDisplay,
+  /// For threads that rasterize frames.
+  kFlutterThreadPriorityRaster,
+} FlutterThreadPriority;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterThreadConfig).
+  size_t struct_size;
+  /// The name the engine would give to the thread. The string is only valid
+  /// for the duration of the call.
+  const char* name;
+  /// The priority the engine would give to the thread.
+  FlutterThreadPriority priority;
+} FlutterThreadConfig;
+
+typedef void (*FlutterThreadEntryCallback)(void* /* entry data */);
+
+/// Asks the embedder to start a thread that calls `entry` with `entry_data`.
+/// The thread must not be used for anything else until `entry` returns, which
+/// happens once the engine no longer needs the thread. Returns false if the
+/// thread could not be started, in which case the engine starts it itself.
+typedef bool (*FlutterThreadLaunchCallback)(
+    void* /* user data */,
+    const FlutterThreadConfig* /* config */,
+    FlutterThreadEntryCallback /* entry */,
+    void* /* entry data */);
+
 typedef struct {
   /// The type of the OpenGL backing store. Currently, it can either be a
   /// texture or a framebuffer.
@@ -937,6 +1195,13 @@ typedef struct {
   /// Callback invoked by the engine to composite the contents of each layer
   /// onto the screen.
   FlutterLayersPresentCallback present_layers_callback;
+  /// Whether the engine may render the Flutter contents stacked above a
+  /// platform view into the backing store below when these contents do not
+  /// intersect with the platform views in between. The engine then presents
+  /// fewer layers and asks for fewer backing stores, but the embedder can no
+  /// longer assume that each platform view is followed by a backing store
+  /// layer.
+  bool coalesce_overlay_layers;
 } FlutterCompositor;
 
 typedef struct {
@@ -1001,8 +1266,42 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// The level parameter that is passed to `FlutterEngineNotifyMemoryPressure`.
+typedef enum {
+  /// Memory is running low. The engine trims its caches of the resources that
+  /// are least likely to be needed for the next frames.
+  kFlutterMemoryPressureModerate,
+  /// The process is about to be killed for its memory use. The engine frees
+  /// every resource it can recreate, which slows down the next frames.
+  kFlutterMemoryPressureCritical,
+} FlutterMemoryPressureLevel;
+
+/// The bytes held by each subsystem of the engine, as reported by
+/// `FlutterEngineGetMemoryBreakdown`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterEngineMemoryBreakdown).
+  size_t struct_size;
+  /// The used and reserved bytes of the Dart heap of the root isolate group.
+  int64_t dart_heap_used_bytes;
+  int64_t dart_heap_capacity_bytes;
+  /// The native allocations the `dart:ui` objects report to the Dart VM, like
+  /// the bytes of images and buffers.
+  int64_t dart_external_bytes;
+  /// The layers and pictures rasterized into the raster cache.
+  size_t raster_cache_bytes;
+  /// The GPU resources held by Skia's resource cache, of which
+  /// `gpu_resource_purgeable_bytes` may be freed at any time.
+  size_t gpu_resource_bytes;
+  size_t gpu_resource_purgeable_bytes;
+  /// The images held by the decoded image cache.
+  size_t decoded_image_cache_bytes;
+} FlutterEngineMemoryBreakdown;
+
 typedef int64_t FlutterEngineDartPort;
 
+/// A ring buffer shared with an isolate. See `FlutterEngineCreateRingBuffer`.
+typedef struct _FlutterEngineRingBuffer* FlutterEngineRingBuffer;
+
 typedef enum {
   kFlutterEngineDartObjectTypeNull,
   kFlutterEngineDartObjectTypeBool,
@@ -1337,8 +1636,102 @@ typedef struct {
   /// `FlutterProjectArgs`.
   const char* const* dart_entrypoint_argv;
 
+  /// The maximum number of bytes the raster cache may use for its images. When
+  /// the limit is reached, new entries are not cached and the least recently
+  /// used entries are evicted. A value of 0 (the default) means no limit.
+  size_t raster_cache_max_bytes;
+
+  /// When true, the engine does not wait for vsync events. Each frame the
+  /// framework schedules is instead produced with the next frame time the
+  /// embedder supplies via `FlutterEnginePumpFrame`, as soon as both are
+  /// available. This suits rendering frames offscreen as fast as possible,
+  /// for example to export a video or generate images on a server. The
+  /// `vsync_callback` must not be specified along with this.
+  bool manual_frame_pumping;
+
+  /// This is an optional callback, which is only used along with the
+  /// `vsync_callback`. The engine invokes it on the UI task runner when the
+  /// framework asks for the display to refresh at a different rate, for
+  /// example a low rate while the UI is idle and the highest rate while an
+  /// animation runs. A rate of 0 means the default rate of the display.
+  /// Embedders driving displays with variable refresh rates may switch modes
+  /// accordingly, and report the resulting intervals through the frame times
+  /// passed to `FlutterEngineOnVsync`.
+  PreferredFrameRateCallback preferred_frame_rate_callback;
+
+  /// When true, the threads created by the engine for the UI and raster task
+  /// runners run at a raised priority: a lower nice value on Linux, the user
+  /// interactive QoS class on macOS and an above normal priority on Windows.
+  /// Task runners supplied via `custom_task_runners` are not affected.
+  bool enable_thread_priorities;
+
+  /// When true and the CPU has cores of different speeds, the threads created
+  /// by the engine for the UI and raster task runners are kept on the fastest
+  /// cores, and the thread of the IO task runner on the other ones. Task
+  /// runners supplied via `custom_task_runners` are not affected.
+  bool enable_thread_cpu_affinity;
+
+  /// This is an optional callback the engine invokes to start the threads of
+  /// its UI and IO task runners, of its render task runner unless one is
+  /// supplied via `custom_task_runners`, and of the workers of the Dart VM.
+  /// This lets hosts start all the threads of the process with their own
+  /// stack sizes, schedulers and instrumentation. The Dart VM is shared by
+  /// the engines of the process, so its workers are only started by the
+  /// callback of the first engine. When the callback is not specified, the
+  /// engine starts the threads itself.
+  FlutterThreadLaunchCallback thread_launch_callback;
+
 } FlutterProjectArgs;
 
+/// How the platform messages the framework sends on a channel are delivered.
+/// See `FlutterEngineSetPlatformMessageChannelBatching`.
+typedef enum {
+  /// Each message is delivered on its own. This is the default.
+  kFlutterPlatformMessageBatchingNone,
+  /// The messages the framework sends in one go, e.g. while building a frame,
+  /// are delivered in order in a single platform task.
+  kFlutterPlatformMessageBatchingBatch,
+  /// Like `kFlutterPlatformMessageBatchingBatch`, but only the last message of
+  /// the channel in each batch is delivered. The responses of the other
+  /// messages are empty. This suits channels that send state updates.
+  kFlutterPlatformMessageBatchingKeepLatest,
+} FlutterPlatformMessageBatching;
+
+/// The phases of the frames rendered by an engine instance that are
+/// aggregated in histograms. See `FlutterEngineGetFrameHistogram`.
+typedef enum {
+  /// The time from the vsync to the start of the frame build, in microseconds.
+  kFlutterFramePhaseVsyncOverhead,
+  /// The time spent building the frame on the UI thread, in microseconds.
+  kFlutterFramePhaseBuild,
+  /// The time spent prerolling the layer tree, in microseconds.
+  kFlutterFramePhasePreroll,
+  /// The time spent painting the layer tree, in microseconds.
+  kFlutterFramePhasePaint,
+  /// The time spent submitting the frame to the GPU, in microseconds.
+  kFlutterFramePhaseSubmit,
+  /// The number of raster cache entries drawn in the frame.
+  kFlutterFramePhaseRasterCacheHits,
+  /// The time the GPU spent executing the frame, in microseconds. Only
+  /// measured by OpenGL renderers whose driver supports timer queries.
+  kFlutterFramePhaseGPU,
+} FlutterFramePhase;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameHistogram).
+  size_t struct_size;
+  /// The number of frames in the histogram.
+  uint64_t count;
+  /// The median of the phase.
+  uint64_t p50;
+  /// The 90th percentile of the phase.
+  uint64_t p90;
+  /// The 99th percentile of the phase.
+  uint64_t p99;
+  /// The largest recorded value of the phase.
+  uint64_t max;
+} FlutterFrameHistogram;
+
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
 
 //------------------------------------------------------------------------------
@@ -1482,6 +1875,23 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineRunInitialized(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Starts bootstrapping the Dart VM for an initialized engine
+///             instance on a background thread. The embedder can then do
+///             other startup work, like creating its window, while the VM
+///             boots. A later call to `FlutterEngineRunInitialized` uses the
+///             prewarmed VM, waiting for its boot to finish if necessary.
+///
+///             Nothing is done if a Dart VM is already running in the process.
+///
+/// @param[in]  engine  An initialized engine instance that has not been run.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePrewarmDartVM(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -1493,6 +1903,34 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
     const FlutterPointerEvent* events,
     size_t events_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Queues pointer events to be sent to the framework in a batch.
+///             Unlike `FlutterEngineSendPointerEvent`, which dispatches the
+///             events immediately, queued events are buffered and handed to
+///             the framework at most once per frame interval, with
+///             consecutive move events of the same device merged into one.
+///             This is intended for input devices that report events faster
+///             than the display refreshes.
+///
+///             Events sent with `FlutterEngineSendPointerEvent` are not
+///             ordered with respect to queued events. Embedders should use
+///             one or the other for a given device.
+///
+/// @note       This call only copies the events into the queue and may be
+///             made on any thread.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  events        The pointer events to queue.
+/// @param[in]  events_count  The number of events in `events`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineQueuePointerEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* events,
+    size_t events_count);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -1611,6 +2049,28 @@ FlutterEngineResult FlutterEngineRegisterExternalTexture(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
 
+//------------------------------------------------------------------------------
+/// @brief      Register an external texture whose frames are DMA-BUFs that the
+///             engine samples directly, rather than OpenGL textures filled by
+///             the embedder. Only OpenGL renderer configurations that specify
+///             a `gl_dma_buf_texture_frame_callback` accept these
+///             registrations. The texture is unregistered and its frames are
+///             marked as available like other external textures.
+///
+/// @see        FlutterEngineUnregisterExternalTexture()
+/// @see        FlutterEngineMarkExternalTextureFrameAvailable()
+///
+/// @param[in]  engine              A running engine instance.
+/// @param[in]  texture_identifier  The identifier of the texture to register
+///                                 with the engine.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRegisterExternalDmaBufTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier);
+
 //------------------------------------------------------------------------------
 /// @brief      Unregister a previous texture registration.
 ///
@@ -1827,6 +2287,24 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task);
 
+//------------------------------------------------------------------------------
+/// @brief      Inform the engine to run all the expired tasks of a task runner
+///             whose description specified a
+///             `FlutterTaskRunnerDescription.post_tasks_callback`. This call
+///             must be made on the thread associated with the task runner.
+///             Tasks that are not due yet are left pending, and the
+///             `post_tasks_callback` is made again for the next of these.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  runner     The task runner given to the `post_tasks_callback`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRunTasks(FLUTTER_API_SYMBOL(FlutterEngine)
+                                              engine,
+                                          FlutterTaskRunner runner);
+
 //------------------------------------------------------------------------------
 /// @brief      Notify a running engine instance that the locale has been
 ///             updated. The preferred locale must be the first item in the list
@@ -1917,6 +2395,44 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Posts a memory pressure notification of the given level to a
+///             running engine instance. Under moderate pressure, the engine
+///             only trims its caches, so that the next frames stay fast.
+///             Under critical pressure, it behaves like
+///             `FlutterEngineNotifyLowMemoryWarning`.
+///
+///             Flutter applications are notified like for
+///             `FlutterEngineNotifyLowMemoryWarning`.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  level      How much memory the engine should free.
+///
+/// @return     If the memory pressure notification was sent to the running
+///             engine instance.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineNotifyMemoryPressure(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterMemoryPressureLevel level);
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the number of bytes held by the Dart heap and by each
+///             cache of a running engine instance. The call blocks until the
+///             UI, raster and IO threads of the engine have reported their
+///             usage, so it must not be made from one of these threads.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[out] breakdown  The breakdown to fill. Its `struct_size` must be set
+///                        by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetMemoryBreakdown(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMemoryBreakdown* breakdown);
+
 //------------------------------------------------------------------------------
 /// @brief      Schedule a callback to be run on all engine managed threads.
 ///             The engine will attempt to service this callback the next time
@@ -1973,6 +2489,164 @@ FlutterEngineResult FlutterEngineNotifyDisplayUpdate(
     const FlutterEngineDisplay* displays,
     size_t display_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the percentiles of one phase of all the frames rendered by
+///             a running engine instance so far. The values are aggregated
+///             as the frames are rendered so this call is cheap and meant to
+///             be polled by monitoring. Percentiles are reported with a
+///             precision of 1/8th of their value.
+///
+///             This call blocks until the render thread is able to service
+///             it.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  phase      The frame phase to get the histogram of.
+/// @param[out] histogram  The histogram of the phase. Its `struct_size` must
+///                        be set by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameHistogram(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFramePhase phase,
+    FlutterFrameHistogram* histogram);
+
+//------------------------------------------------------------------------------
+/// @brief      Makes the platform messages the framework sends on a channel be
+///             delivered to the `platform_message_callback` on a dedicated
+///             background thread instead of the platform task runner. The
+///             messages of all background channels are delivered in order on
+///             that thread. This lets embedders run slow handlers, like
+///             database queries, without delaying the other tasks of the
+///             platform thread.
+///
+///             The responses to these messages may be sent with
+///             `FlutterEngineSendPlatformMessageResponse` on any thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[in]  channel     The name of the channel.
+/// @param[in]  background  Whether the messages of the channel are delivered
+///                         on the background thread.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSetPlatformMessageChannelBackground(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    bool background);
+
+//------------------------------------------------------------------------------
+/// @brief      Sets how the platform messages the framework sends on a channel
+///             are delivered to the `platform_message_callback`. Batching
+///             saves a platform task per message for channels that send many
+///             small messages per frame. Batched messages may be delivered
+///             after messages of other channels that were sent later.
+///
+/// @param[in]  engine    A running engine instance.
+/// @param[in]  channel   The name of the channel.
+/// @param[in]  batching  How the messages of the channel are delivered.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSetPlatformMessageChannelBatching(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageBatching batching);
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a single producer, single consumer ring buffer whose
+///             memory is shared with the isolate listening on the port. This
+///             suits streams of small records, like sensor samples, where a
+///             `FlutterEnginePostDartObject` call per record is too costly.
+///
+///             The buffer is posted once to the port as a `Uint8List`. It
+///             starts with a header of 64 bytes holding three little endian
+///             64 bit words: the number of bytes written so far at offset 0,
+///             the number of bytes read so far at offset 8 and the capacity of
+///             the data area at offset 16. The data area follows the header,
+///             and the byte with the running offset `n` is at
+///             `64 + n % capacity`. After each write, the new number of bytes
+///             written is posted to the port as an `int`. The isolate reads
+///             the data up to that offset and then stores its new read offset
+///             in the header, which frees the space for the writer.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  port         The send port to post the buffer and the wakeups
+///                          to.
+/// @param[in]  capacity     The size of the data area in bytes.
+/// @param[out] ring_buffer  The handle of the ring buffer. It must be
+///                          collected with `FlutterEngineCollectRingBuffer`.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCreateRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer);
+
+//------------------------------------------------------------------------------
+/// @brief      Copies bytes into a ring buffer and wakes up its isolate. The
+///             bytes are written all at once or not at all. Writes to the same
+///             ring buffer must not be made from multiple threads at once.
+///
+/// @param[in]  ring_buffer  The ring buffer.
+/// @param[in]  data         The bytes to write.
+/// @param[in]  size         The number of bytes to write.
+/// @param[out] written      Whether there was room for the bytes.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRingBufferWrite(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    bool* written);
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the handle of a ring buffer. The memory of the buffer
+///             stays alive until the isolate collected its `Uint8List` too.
+///
+/// @param[in]  ring_buffer  The ring buffer.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCollectRingBuffer(
+    FlutterEngineRingBuffer ring_buffer);
+
+//------------------------------------------------------------------------------
+/// @brief      Supplies the time of a frame to an engine initialized with
+///             `manual_frame_pumping`. The frame is produced as soon as the
+///             framework schedules one, or right away if it already has. Frame
+///             times pumped while no frame is scheduled are queued and used in
+///             order, so a whole sequence of frames, like those of a video, may
+///             be pumped up front. The pixels of each frame are presented to
+///             the renderer as usual, e.g. to the `surface_present_callback`
+///             of the software renderer. This may be called on any thread.
+///
+/// @param[in]  engine                   A running engine instance.
+/// @param[in]  frame_start_time_nanos   The time of the frame, which drives
+///                                      the animations of the framework, in
+///                                      the timebase of
+///                                      `FlutterEngineGetCurrentTime`.
+/// @param[in]  frame_target_time_nanos  The time the frame should be done by.
+///                                      This is a hint the engine uses to
+///                                      schedule Dart VM garbage collection.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePumpFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    uint64_t frame_start_time_nanos,
+    uint64_t frame_target_time_nanos);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2084,6 +2758,54 @@ typedef FlutterEngineResult (*FlutterEngineNotifyDisplayUpdateFnPtr)(
     FlutterEngineDisplaysUpdateType update_type,
     const FlutterEngineDisplay* displays,
     size_t display_count);
+typedef FlutterEngineResult (*FlutterEngineQueuePointerEventsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* events,
+    size_t events_count);
+typedef FlutterEngineResult (*FlutterEnginePrewarmDartVMFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine);
+typedef FlutterEngineResult (*FlutterEngineGetFrameHistogramFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFramePhase phase,
+    FlutterFrameHistogram* histogram);
+typedef FlutterEngineResult (*FlutterEngineRegisterExternalDmaBufTextureFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier);
+typedef FlutterEngineResult (
+    *FlutterEngineSetPlatformMessageChannelBackgroundFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    bool background);
+typedef FlutterEngineResult (
+    *FlutterEngineSetPlatformMessageChannelBatchingFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    FlutterPlatformMessageBatching batching);
+typedef FlutterEngineResult (*FlutterEngineCreateRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineDartPort port,
+    size_t capacity,
+    FlutterEngineRingBuffer* ring_buffer);
+typedef FlutterEngineResult (*FlutterEngineRingBufferWriteFnPtr)(
+    FlutterEngineRingBuffer ring_buffer,
+    const uint8_t* data,
+    size_t size,
+    bool* written);
+typedef FlutterEngineResult (*FlutterEngineCollectRingBufferFnPtr)(
+    FlutterEngineRingBuffer ring_buffer);
+typedef FlutterEngineResult (*FlutterEnginePumpFrameFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    uint64_t frame_start_time_nanos,
+    uint64_t frame_target_time_nanos);
+typedef FlutterEngineResult (*FlutterEngineNotifyMemoryPressureFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterMemoryPressureLevel level);
+typedef FlutterEngineResult (*FlutterEngineGetMemoryBreakdownFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterEngineMemoryBreakdown* breakdown);
+typedef FlutterEngineResult (*FlutterEngineRunTasksFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner runner);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2127,6 +2849,21 @@ typedef struct {
   FlutterEnginePostCallbackOnAllNativeThreadsFnPtr
       PostCallbackOnAllNativeThreads;
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
+  FlutterEngineQueuePointerEventsFnPtr QueuePointerEvents;
+  FlutterEnginePrewarmDartVMFnPtr PrewarmDartVM;
+  FlutterEngineGetFrameHistogramFnPtr GetFrameHistogram;
+  FlutterEngineRegisterExternalDmaBufTextureFnPtr RegisterExternalDmaBufTexture;
+  FlutterEngineSetPlatformMessageChannelBackgroundFnPtr
+      SetPlatformMessageChannelBackground;
+  FlutterEngineSetPlatformMessageChannelBatchingFnPtr
+      SetPlatformMessageChannelBatching;
+  FlutterEngineCreateRingBufferFnPtr CreateRingBuffer;
+  FlutterEngineRingBufferWriteFnPtr RingBufferWrite;
+  FlutterEngineCollectRingBufferFnPtr CollectRingBuffer;
+  FlutterEnginePumpFrameFnPtr PumpFrame;
+  FlutterEngineNotifyMemoryPressureFnPtr NotifyMemoryPressure;
+  FlutterEngineGetMemoryBreakdownFnPtr GetMemoryBreakdown;
+  FlutterEngineRunTasksFnPtr RunTasks;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
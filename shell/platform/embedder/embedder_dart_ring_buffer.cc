@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_dart_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+#include "third_party/dart/runtime/include/dart_native_api.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kWriteOffsetIndex = 0;
+constexpr size_t kReadOffsetIndex = 1;
+constexpr size_t kCapacityIndex = 2;
+
+}  // namespace
+
+std::shared_ptr<EmbedderDartRingBuffer> EmbedderDartRingBuffer::Create(
+    Dart_Port port,
+    size_t capacity) {
+  if (port == ILLEGAL_PORT || capacity == 0) {
+    return nullptr;
+  }
+  return std::shared_ptr<EmbedderDartRingBuffer>(
+      new EmbedderDartRingBuffer(port, capacity));
+}
+
+EmbedderDartRingBuffer::EmbedderDartRingBuffer(Dart_Port port,
+                                               size_t capacity)
+    : port_(port),
+      capacity_(capacity),
+      buffer_(new uint8_t[kHeaderSize + capacity]()) {
+  static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+                "The header words must be plain 64 bit words.");
+  reinterpret_cast<uint64_t*>(buffer_.get())[kCapacityIndex] = capacity;
+}
+
+EmbedderDartRingBuffer::~EmbedderDartRingBuffer() = default;
+
+std::atomic<uint64_t>* EmbedderDartRingBuffer::WriteOffset() const {
+  return reinterpret_cast<std::atomic<uint64_t>*>(buffer_.get()) +
+         kWriteOffsetIndex;
+}
+
+std::atomic<uint64_t>* EmbedderDartRingBuffer::ReadOffset() const {
+  return reinterpret_cast<std::atomic<uint64_t>*>(buffer_.get()) +
+         kReadOffsetIndex;
+}
+
+bool EmbedderDartRingBuffer::PostToPort() {
+  // The isolate holds a reference to the buffer for as long as the typed data
+  // is alive, so that the embedder may collect its handle at any time.
+  auto peer = new std::shared_ptr<EmbedderDartRingBuffer>(shared_from_this());
+
+  Dart_CObject object = {};
+  object.type = Dart_CObject_kExternalTypedData;
+  object.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+  object.value.as_external_typed_data.length = kHeaderSize + capacity_;
+  object.value.as_external_typed_data.data = buffer_.get();
+  object.value.as_external_typed_data.peer = peer;
+  object.value.as_external_typed_data.callback =
+      +[](void* unused_isolate_callback_data, void* peer) {
+        delete reinterpret_cast<std::shared_ptr<EmbedderDartRingBuffer>*>(
+            peer);
+      };
+
+  if (!Dart_PostCObject(port_, &object)) {
+    delete peer;
+    return false;
+  }
+  return true;
+}
+
+bool EmbedderDartRingBuffer::Write(const uint8_t* data, size_t size) {
+  const uint64_t write_offset = WriteOffset()->load(std::memory_order_relaxed);
+  const uint64_t read_offset = ReadOffset()->load(std::memory_order_acquire);
+  FML_DCHECK(write_offset - read_offset <= capacity_);
+  if (size > capacity_ - (write_offset - read_offset)) {
+    return false;
+  }
+
+  uint8_t* storage = buffer_.get() + kHeaderSize;
+  const size_t start = write_offset % capacity_;
+  const size_t head = std::min(size, capacity_ - start);
+  ::memcpy(storage + start, data, head);
+  ::memcpy(storage, data + head, size - head);
+
+  const uint64_t new_write_offset = write_offset + size;
+  WriteOffset()->store(new_write_offset, std::memory_order_release);
+
+  // The isolate may be busy or gone, in which case it catches up on the next
+  // wakeup or the writes fail once the buffer is full.
+  if (!Dart_PostInteger(port_, new_write_offset)) {
+    FML_DLOG(WARNING) << "Could not wake up the isolate of the ring buffer.";
+  }
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_DART_RING_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_DART_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A single producer, single consumer ring buffer whose memory is
+///             shared with an isolate. The buffer is posted once to a port as
+///             an external `Uint8List`. After that, writes only copy the
+///             bytes into the buffer and post the new write offset to the
+///             port as an integer to wake up the isolate.
+///
+///             The buffer starts with a header of |kHeaderSize| bytes that
+///             holds three little endian 64 bit words:
+///               * At offset 0, the number of bytes written so far. Only the
+///                 writer updates it.
+///               * At offset 8, the number of bytes read so far. Only the
+///                 isolate updates it, once it is done with the bytes.
+///               * At offset 16, the capacity of the data area.
+///             The data area follows the header. The byte with the running
+///             offset `n` is at `kHeaderSize + n % capacity`.
+///
+class EmbedderDartRingBuffer
+    : public std::enable_shared_from_this<EmbedderDartRingBuffer> {
+ public:
+  static constexpr size_t kHeaderSize = 64;
+
+  static std::shared_ptr<EmbedderDartRingBuffer> Create(Dart_Port port,
+                                                        size_t capacity);
+
+  ~EmbedderDartRingBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Posts the buffer to the port. The isolate keeps a reference
+  ///             to the buffer until the `Uint8List` is collected.
+  ///
+  /// @return     If the buffer was posted.
+  ///
+  bool PostToPort();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies the bytes into the buffer and wakes up the isolate.
+  ///             Must only be called from one thread at a time.
+  ///
+  /// @param[in]  data  The bytes to write.
+  /// @param[in]  size  The number of bytes to write.
+  ///
+  /// @return     If there was room for all the bytes. Nothing is written
+  ///             otherwise.
+  ///
+  bool Write(const uint8_t* data, size_t size);
+
+  size_t GetCapacity() const { return capacity_; }
+
+ private:
+  const Dart_Port port_;
+  const size_t capacity_;
+  std::unique_ptr<uint8_t[]> buffer_;
+
+  EmbedderDartRingBuffer(Dart_Port port, size_t capacity);
+
+  std::atomic<uint64_t>* WriteOffset() const;
+
+  std::atomic<uint64_t>* ReadOffset() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderDartRingBuffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_DART_RING_BUFFER_H_
@@ -66,10 +66,39 @@ bool EmbedderEngine::LaunchShell() {
   // shell again.
   shell_args_.reset();
 
+  if (IsValid()) {
+    Shell* shell = shell_.get();
+    auto platform_view = shell_->GetPlatformView();
+    pointer_data_queue_ = std::make_unique<EmbedderPointerDataQueue>(
+        task_runners_.GetPlatformTaskRunner(),
+        [shell]() {
+          const double refresh_rate = shell->GetMainDisplayRefreshRate();
+          return fml::TimeDelta::FromMillisecondsF(
+              (refresh_rate > 0 ? fml::RefreshRateToFrameBudget(refresh_rate)
+                                : fml::kDefaultFrameBudget)
+                  .count());
+        },
+        [platform_view](std::unique_ptr<PointerDataPacket> packet) {
+          if (platform_view) {
+            platform_view->DispatchPointerDataPacket(std::move(packet),
+                                                     /*coalesce_moves=*/true);
+          }
+        });
+  }
+
   return IsValid();
 }
 
+bool EmbedderEngine::PrewarmDartVM() {
+  if (!shell_args_) {
+    return false;
+  }
+  Shell::PrewarmDartVM(shell_args_->settings);
+  return true;
+}
+
 bool EmbedderEngine::CollectShell() {
+  pointer_data_queue_.reset();
   shell_.reset();
   return IsValid();
 }
@@ -136,6 +165,16 @@ bool EmbedderEngine::DispatchPointerDataPacket(
   return true;
 }
 
+bool EmbedderEngine::QueuePointerData(const flutter::PointerData* data,
+                                      size_t count) {
+  if (!IsValid() || !pointer_data_queue_ || data == nullptr) {
+    return false;
+  }
+
+  pointer_data_queue_->Enqueue(data, count);
+  return true;
+}
+
 bool EmbedderEngine::SendPlatformMessage(
     fml::RefPtr<flutter::PlatformMessage> message) {
   if (!IsValid() || !message) {
@@ -164,9 +203,45 @@ bool EmbedderEngine::RegisterTexture(int64_t texture) {
   return true;
 }
 
+#if defined(SHELL_ENABLE_GL) && OS_LINUX
+void EmbedderEngine::SetDmaBufTextureCallbacks(
+    EmbedderExternalTextureDmaBuf::FrameCallback frame_callback,
+    EmbedderExternalTextureDmaBuf::ProcResolver proc_resolver) {
+  dma_buf_frame_callback_ = std::move(frame_callback);
+  dma_buf_proc_resolver_ = std::move(proc_resolver);
+}
+#endif
+
+bool EmbedderEngine::RegisterDmaBufTexture(int64_t texture) {
+#if defined(SHELL_ENABLE_GL) && OS_LINUX
+  if (!IsValid() || !dma_buf_frame_callback_ || !dma_buf_proc_resolver_) {
+    return false;
+  }
+  shell_->GetPlatformView()->RegisterTexture(
+      std::make_unique<EmbedderExternalTextureDmaBuf>(
+          texture, dma_buf_frame_callback_, dma_buf_proc_resolver_));
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool EmbedderEngine::HasTextureCallback() const {
+#ifdef SHELL_ENABLE_GL
+#if OS_LINUX
+  if (dma_buf_frame_callback_) {
+    return true;
+  }
+#endif  // OS_LINUX
+  return static_cast<bool>(external_texture_callback_);
+#else
+  return false;
+#endif  // SHELL_ENABLE_GL
+}
+
 bool EmbedderEngine::UnregisterTexture(int64_t texture) {
 #ifdef SHELL_ENABLE_GL
-  if (!IsValid() || !external_texture_callback_) {
+  if (!IsValid() || !HasTextureCallback()) {
     return false;
   }
   shell_->GetPlatformView()->UnregisterTexture(texture);
@@ -177,7 +252,7 @@ bool EmbedderEngine::UnregisterTexture(int64_t texture) {
 
 bool EmbedderEngine::MarkTextureFrameAvailable(int64_t texture) {
 #ifdef SHELL_ENABLE_GL
-  if (!IsValid() || !external_texture_callback_) {
+  if (!IsValid() || !HasTextureCallback()) {
     return false;
   }
   shell_->GetPlatformView()->MarkTextureFrameAvailable(texture);
@@ -236,6 +311,21 @@ bool EmbedderEngine::OnVsyncEvent(intptr_t baton,
                                               frame_target_time);
 }
 
+void EmbedderEngine::SetFramePump(
+    std::shared_ptr<EmbedderFramePump> frame_pump) {
+  frame_pump_ = std::move(frame_pump);
+}
+
+bool EmbedderEngine::PumpFrame(fml::TimePoint frame_start_time,
+                               fml::TimePoint frame_target_time) {
+  if (!IsValid() || !frame_pump_) {
+    return false;
+  }
+
+  frame_pump_->PumpFrame(frame_start_time, frame_target_time);
+  return true;
+}
+
 bool EmbedderEngine::ReloadSystemFonts() {
   if (!IsValid()) {
     return false;
@@ -244,6 +334,28 @@ bool EmbedderEngine::ReloadSystemFonts() {
   return shell_->ReloadSystemFonts();
 }
 
+bool EmbedderEngine::SetPlatformMessageChannelBackground(
+    const std::string& channel,
+    bool background) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  shell_->SetPlatformMessageChannelBackground(channel, background);
+  return true;
+}
+
+bool EmbedderEngine::SetPlatformMessageChannelBatching(
+    const std::string& channel,
+    Engine::PlatformMessageBatching batching) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  shell_->SetPlatformMessageChannelBatching(channel, batching);
+  return true;
+}
+
 bool EmbedderEngine::PostRenderThreadTask(const fml::closure& task) {
   if (!IsValid()) {
     return false;
@@ -264,6 +376,14 @@ bool EmbedderEngine::RunTask(const FlutterTask* task) {
                                 task->task);
 }
 
+bool EmbedderEngine::RunTasks(FlutterTaskRunner runner) {
+  // Like |RunTask|, this is valid before the shell is running.
+  if (runner == nullptr) {
+    return false;
+  }
+  return thread_host_->RunExpiredTasks(reinterpret_cast<int64_t>(runner));
+}
+
 bool EmbedderEngine::PostTaskOnEngineManagedNativeThreads(
     std::function<void(FlutterNativeThreadType)> closure) const {
   if (!IsValid() || closure == nullptr) {
@@ -8,15 +8,21 @@
 #include <memory>
 #include <unordered_map>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_frame_pump.h"
+#include "flutter/shell/platform/embedder/embedder_pointer_data_queue.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
 
 #ifdef SHELL_ENABLE_GL
 #include "flutter/shell/platform/embedder/embedder_external_texture_gl.h"
-#endif
+#if OS_LINUX
+#include "flutter/shell/platform/embedder/embedder_external_texture_dma_buf.h"
+#endif  // OS_LINUX
+#endif  // SHELL_ENABLE_GL
 
 namespace flutter {
 
@@ -43,6 +49,10 @@ class EmbedderEngine {
 
   bool LaunchShell();
 
+  // Boots the Dart VM for the shell that |LaunchShell| will create on a
+  // background thread. Returns false if the shell was already launched.
+  bool PrewarmDartVM();
+
   bool CollectShell();
 
   const TaskRunners& GetTaskRunners() const;
@@ -60,10 +70,22 @@ class EmbedderEngine {
   bool DispatchPointerDataPacket(
       std::unique_ptr<flutter::PointerDataPacket> packet);
 
+  bool QueuePointerData(const flutter::PointerData* data, size_t count);
+
   bool SendPlatformMessage(fml::RefPtr<flutter::PlatformMessage> message);
 
   bool RegisterTexture(int64_t texture);
 
+#if defined(SHELL_ENABLE_GL) && OS_LINUX
+  void SetDmaBufTextureCallbacks(
+      EmbedderExternalTextureDmaBuf::FrameCallback frame_callback,
+      EmbedderExternalTextureDmaBuf::ProcResolver proc_resolver);
+#endif
+
+  // Returns false unless the embedder supplies the frames of DMA-BUF
+  // textures.
+  bool RegisterDmaBufTexture(int64_t texture);
+
   bool UnregisterTexture(int64_t texture);
 
   bool MarkTextureFrameAvailable(int64_t texture);
@@ -80,12 +102,29 @@ class EmbedderEngine {
                     fml::TimePoint frame_start_time,
                     fml::TimePoint frame_target_time);
 
+  // Set when the embedder pumps frames itself instead of answering vsync
+  // requests. See |EmbedderFramePump|.
+  void SetFramePump(std::shared_ptr<EmbedderFramePump> frame_pump);
+
+  // Returns false unless a frame pump is set.
+  bool PumpFrame(fml::TimePoint frame_start_time,
+                 fml::TimePoint frame_target_time);
+
   bool ReloadSystemFonts();
 
+  bool SetPlatformMessageChannelBackground(const std::string& channel,
+                                           bool background);
+
+  bool SetPlatformMessageChannelBatching(
+      const std::string& channel,
+      Engine::PlatformMessageBatching batching);
+
   bool PostRenderThreadTask(const fml::closure& task);
 
   bool RunTask(const FlutterTask* task);
 
+  bool RunTasks(FlutterTaskRunner runner);
+
   bool PostTaskOnEngineManagedNativeThreads(
       std::function<void(FlutterNativeThreadType)> closure) const;
 
@@ -93,14 +132,24 @@ class EmbedderEngine {
 
  private:
   const std::unique_ptr<EmbedderThreadHost> thread_host_;
+  // Outlives the shell, so that a pending vsync request is only returned once
+  // the vsync waiter is gone.
+  std::shared_ptr<EmbedderFramePump> frame_pump_;
   TaskRunners task_runners_;
   RunConfiguration run_configuration_;
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
+  std::unique_ptr<EmbedderPointerDataQueue> pointer_data_queue_;
 #ifdef SHELL_ENABLE_GL
   const EmbedderExternalTextureGL::ExternalTextureCallback
       external_texture_callback_;
-#endif
+#if OS_LINUX
+  EmbedderExternalTextureDmaBuf::FrameCallback dma_buf_frame_callback_;
+  EmbedderExternalTextureDmaBuf::ProcResolver dma_buf_proc_resolver_;
+#endif  // OS_LINUX
+#endif  // SHELL_ENABLE_GL
+
+  bool HasTextureCallback() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
@@ -0,0 +1,391 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_external_texture_dma_buf.h"
+
+#include <poll.h>
+
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLTypes.h"
+
+namespace flutter {
+
+namespace {
+
+// The embedder does not link against EGL, so the few types and enums of
+// EGL_EXT_image_dma_buf_import, EGL_ANDROID_native_fence_sync and
+// OES_EGL_image that are needed are declared here. The functions are
+// resolved through the proc resolver of the embedder.
+using EGLDisplay = void*;
+using EGLImage = void*;
+using EGLSync = void*;
+using EGLint = int32_t;
+using EGLenum = uint32_t;
+using EGLBoolean = uint32_t;
+using GLenum = uint32_t;
+using GLuint = uint32_t;
+using GLint = int32_t;
+using GLsizei = int32_t;
+
+constexpr EGLint kEGLNone = 0x3038;
+constexpr EGLint kEGLExtensions = 0x3055;
+constexpr EGLint kEGLHeight = 0x3056;
+constexpr EGLint kEGLWidth = 0x3057;
+constexpr EGLenum kEGLLinuxDmaBuf = 0x3270;
+constexpr EGLint kEGLLinuxDrmFourcc = 0x3271;
+constexpr EGLenum kEGLSyncNativeFence = 0x3144;
+constexpr EGLint kEGLSyncNativeFenceFd = 0x3145;
+
+// The fd, offset, pitch, modifier low bits and modifier high bits attributes
+// of each plane.
+constexpr EGLint
+    kEGLPlaneAttributes[EmbedderExternalTextureDmaBuf::kMaxPlanes][5] = {
+    {0x3272, 0x3273, 0x3274, 0x3443, 0x3444},
+    {0x3275, 0x3276, 0x3277, 0x3445, 0x3446},
+    {0x3278, 0x3279, 0x327A, 0x3447, 0x3448},
+    {0x3440, 0x3441, 0x3442, 0x3449, 0x344A},
+};
+
+constexpr GLenum kGLTexture2D = 0x0DE1;
+constexpr GLenum kGLTextureMagFilter = 0x2800;
+constexpr GLenum kGLTextureMinFilter = 0x2801;
+constexpr GLint kGLLinear = 0x2601;
+constexpr GLenum kGLRGBA8 = 0x8058;
+
+bool HasExtension(const char* extensions, const char* name) {
+  if (extensions == nullptr) {
+    return false;
+  }
+  const size_t length = strlen(name);
+  for (const char* found = strstr(extensions, name); found != nullptr;
+       found = strstr(found + length, name)) {
+    const bool starts = found == extensions || found[-1] == ' ';
+    const bool ends = found[length] == '\0' || found[length] == ' ';
+    if (starts && ends) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Blocks until the sync file signals. Only used when the GPU cannot wait on
+// it.
+void WaitOnFence(int fence_fd) {
+  struct pollfd poll_fd = {};
+  poll_fd.fd = fence_fd;
+  poll_fd.events = POLLIN;
+  while (poll(&poll_fd, 1, -1) < 0 && (errno == EINTR || errno == EAGAIN)) {
+  }
+}
+
+}  // namespace
+
+struct EmbedderExternalTextureDmaBuf::Procs {
+  EGLDisplay (*GetCurrentDisplay)();
+  const char* (*QueryString)(EGLDisplay, EGLint);
+  EGLImage (*CreateImage)(EGLDisplay, void*, EGLenum, void*, const EGLint*);
+  EGLBoolean (*DestroyImage)(EGLDisplay, EGLImage);
+  EGLSync (*CreateSync)(EGLDisplay, EGLenum, const EGLint*);
+  EGLBoolean (*DestroySync)(EGLDisplay, EGLSync);
+  EGLint (*WaitSync)(EGLDisplay, EGLSync, EGLint);
+  EGLint (*DupNativeFenceFD)(EGLDisplay, EGLSync);
+  void (*ImageTargetTexture2D)(GLenum, void*);
+  void (*GenTextures)(GLsizei, GLuint*);
+  void (*DeleteTextures)(GLsizei, const GLuint*);
+  void (*BindTexture)(GLenum, GLuint);
+  void (*TexParameteri)(GLenum, GLenum, GLint);
+  void (*Flush)();
+  void (*Finish)();
+
+  EGLDisplay display = nullptr;
+  bool supports_modifiers = false;
+  // Whether the GPU can wait on and signal sync files.
+  bool supports_fences = false;
+
+  static std::shared_ptr<Procs> Resolve(const ProcResolver& resolver) {
+    auto procs = std::make_shared<Procs>();
+    bool resolved = true;
+    auto resolve = [&](auto& proc, const char* name) {
+      proc = reinterpret_cast<std::remove_reference_t<decltype(proc)>>(
+          resolver(name));
+      resolved &= proc != nullptr;
+    };
+    resolve(procs->GetCurrentDisplay, "eglGetCurrentDisplay");
+    resolve(procs->QueryString, "eglQueryString");
+    resolve(procs->CreateImage, "eglCreateImageKHR");
+    resolve(procs->DestroyImage, "eglDestroyImageKHR");
+    resolve(procs->ImageTargetTexture2D, "glEGLImageTargetTexture2DOES");
+    resolve(procs->GenTextures, "glGenTextures");
+    resolve(procs->DeleteTextures, "glDeleteTextures");
+    resolve(procs->BindTexture, "glBindTexture");
+    resolve(procs->TexParameteri, "glTexParameteri");
+    resolve(procs->Flush, "glFlush");
+    resolve(procs->Finish, "glFinish");
+    if (!resolved) {
+      FML_LOG(ERROR) << "Could not resolve the functions needed to import "
+                        "DMA-BUF textures.";
+      return nullptr;
+    }
+
+    procs->display = procs->GetCurrentDisplay();
+    if (procs->display == nullptr) {
+      FML_LOG(ERROR) << "DMA-BUF textures require an EGL context.";
+      return nullptr;
+    }
+    const char* extensions =
+        procs->QueryString(procs->display, kEGLExtensions);
+    if (!HasExtension(extensions, "EGL_EXT_image_dma_buf_import")) {
+      FML_LOG(ERROR) << "EGL_EXT_image_dma_buf_import is not supported.";
+      return nullptr;
+    }
+    procs->supports_modifiers =
+        HasExtension(extensions, "EGL_EXT_image_dma_buf_import_modifiers");
+
+    resolved = true;
+    resolve(procs->CreateSync, "eglCreateSyncKHR");
+    resolve(procs->DestroySync, "eglDestroySyncKHR");
+    resolve(procs->WaitSync, "eglWaitSyncKHR");
+    resolve(procs->DupNativeFenceFD, "eglDupNativeFenceFDANDROID");
+    procs->supports_fences =
+        resolved && HasExtension(extensions, "EGL_KHR_wait_sync") &&
+        HasExtension(extensions, "EGL_ANDROID_native_fence_sync");
+    return procs;
+  }
+
+  // Makes the GPU wait on the sync file before it executes the commands
+  // issued after this call. Takes ownership of the fd.
+  void WaitOnFenceFD(int fence_fd) const {
+    if (fence_fd < 0) {
+      return;
+    }
+    if (supports_fences) {
+      const EGLint attributes[] = {kEGLSyncNativeFenceFd, fence_fd, kEGLNone};
+      // The sync takes ownership of the fd if it is created.
+      EGLSync sync = CreateSync(display, kEGLSyncNativeFence, attributes);
+      if (sync != nullptr) {
+        WaitSync(display, sync, 0);
+        DestroySync(display, sync);
+        return;
+      }
+    }
+    fml::UniqueFD fd(fence_fd);
+    WaitOnFence(fd.get());
+  }
+
+  // Returns a sync file that signals once the commands issued so far are
+  // executed, or -1 if the commands have been executed already.
+  int CreateFenceFD() const {
+    EGLSync sync = supports_fences
+                       ? CreateSync(display, kEGLSyncNativeFence, nullptr)
+                       : nullptr;
+    if (sync == nullptr) {
+      Finish();
+      return -1;
+    }
+    // The fence fd is only available once the sync is flushed.
+    Flush();
+    const int fence_fd = DupNativeFenceFD(display, sync);
+    DestroySync(display, sync);
+    return fence_fd;
+  }
+};
+
+namespace {
+
+// The resources of an imported frame, collected once Skia releases the
+// texture that wraps them.
+struct ImportedFrame {
+  std::shared_ptr<EmbedderExternalTextureDmaBuf::Procs> procs;
+  EGLImage image = nullptr;
+  GLuint texture = 0;
+  std::function<void(int release_fence_fd)> release_callback;
+};
+
+void ReleaseImportedFrame(void* context) {
+  std::unique_ptr<ImportedFrame> frame(static_cast<ImportedFrame*>(context));
+  const auto& procs = *frame->procs;
+  // Skia releases the texture after it issued the draws that sampled it, so
+  // the fence covers them.
+  const int release_fence_fd =
+      frame->image != nullptr ? procs.CreateFenceFD() : -1;
+  if (frame->texture != 0) {
+    procs.DeleteTextures(1, &frame->texture);
+  }
+  if (frame->image != nullptr) {
+    procs.DestroyImage(procs.display, frame->image);
+  }
+  if (frame->release_callback) {
+    frame->release_callback(release_fence_fd);
+  } else {
+    fml::UniqueFD fd(release_fence_fd);
+  }
+}
+
+}  // namespace
+
+EmbedderExternalTextureDmaBuf::EmbedderExternalTextureDmaBuf(
+    int64_t texture_identifier,
+    const FrameCallback& frame_callback,
+    const ProcResolver& proc_resolver)
+    : Texture(texture_identifier),
+      frame_callback_(frame_callback),
+      proc_resolver_(proc_resolver) {
+  FML_DCHECK(frame_callback_);
+  FML_DCHECK(proc_resolver_);
+}
+
+EmbedderExternalTextureDmaBuf::~EmbedderExternalTextureDmaBuf() = default;
+
+sk_sp<SkImage> EmbedderExternalTextureDmaBuf::ImportFrame(
+    GrDirectContext* context,
+    Frame frame) {
+  TRACE_EVENT0("flutter", "EmbedderExternalTextureDmaBuf::ImportFrame");
+  auto imported = std::make_unique<ImportedFrame>();
+  imported->procs = procs_;
+  imported->release_callback = std::move(frame.release_callback);
+  const auto& procs = *procs_;
+
+  if (frame.planes.empty() || frame.planes.size() > kMaxPlanes ||
+      frame.size.isEmpty() ||
+      (frame.has_modifier && !procs.supports_modifiers)) {
+    FML_LOG(ERROR) << "Invalid DMA-BUF texture frame.";
+    fml::UniqueFD acquire_fence(frame.acquire_fence_fd);
+    ReleaseImportedFrame(imported.release());
+    return nullptr;
+  }
+
+  std::vector<EGLint> attributes = {
+      kEGLWidth,          frame.size.width(),
+      kEGLHeight,         frame.size.height(),
+      kEGLLinuxDrmFourcc, static_cast<EGLint>(frame.fourcc),
+  };
+  for (size_t i = 0; i < frame.planes.size(); i++) {
+    const auto& plane = frame.planes[i];
+    const auto* names = kEGLPlaneAttributes[i];
+    attributes.insert(attributes.end(),
+                      {names[0], plane.fd, names[1],
+                       static_cast<EGLint>(plane.offset), names[2],
+                       static_cast<EGLint>(plane.pitch)});
+    if (frame.has_modifier) {
+      attributes.insert(
+          attributes.end(),
+          {names[3], static_cast<EGLint>(frame.modifier & 0xFFFFFFFF),
+           names[4], static_cast<EGLint>(frame.modifier >> 32)});
+    }
+  }
+  attributes.push_back(kEGLNone);
+
+  imported->image = procs.CreateImage(procs.display, nullptr, kEGLLinuxDmaBuf,
+                                      nullptr, attributes.data());
+  if (imported->image == nullptr) {
+    FML_LOG(ERROR) << "Could not import the DMA-BUF texture frame.";
+    fml::UniqueFD acquire_fence(frame.acquire_fence_fd);
+    ReleaseImportedFrame(imported.release());
+    return nullptr;
+  }
+
+  const GLenum target = frame.target == 0 ? kGLTexture2D : frame.target;
+  procs.GenTextures(1, &imported->texture);
+  procs.BindTexture(target, imported->texture);
+  procs.TexParameteri(target, kGLTextureMinFilter, kGLLinear);
+  procs.TexParameteri(target, kGLTextureMagFilter, kGLLinear);
+  procs.ImageTargetTexture2D(target, imported->image);
+  procs.BindTexture(target, 0);
+  // The binding was changed behind the back of Skia.
+  context->resetContext(kTextureBinding_GrGLBackendState);
+
+  // The draws that sample the frame are issued after this wait.
+  procs.WaitOnFenceFD(frame.acquire_fence_fd);
+
+  GrGLTextureInfo texture_info = {target, imported->texture, kGLRGBA8};
+  GrBackendTexture backend_texture(frame.size.width(), frame.size.height(),
+                                   GrMipMapped::kNo, texture_info);
+  ImportedFrame* release_context = imported.release();
+  auto image = SkImage::MakeFromTexture(
+      context,                   // context
+      backend_texture,           // texture handle
+      kTopLeft_GrSurfaceOrigin,  // origin
+      kRGBA_8888_SkColorType,    // color type
+      kPremul_SkAlphaType,       // alpha type
+      nullptr,                   // colorspace
+      ReleaseImportedFrame,      // texture release proc
+      release_context            // texture release context
+  );
+  if (!image) {
+    // Skia does not call the release proc of the textures it rejects.
+    FML_LOG(ERROR) << "Could not wrap the DMA-BUF texture frame.";
+    ReleaseImportedFrame(release_context);
+    return nullptr;
+  }
+  return image;
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureDmaBuf::Paint(SkCanvas& canvas,
+                                          const SkRect& bounds,
+                                          bool freeze,
+                                          GrDirectContext* context,
+                                          SkFilterQuality filter_quality) {
+  if (new_frame_available_ && !freeze && context != nullptr) {
+    if (!procs_resolved_) {
+      procs_ = Procs::Resolve(proc_resolver_);
+      procs_resolved_ = true;
+    }
+    Frame frame;
+    if (procs_ &&
+        frame_callback_(Id(), SkISize::Make(bounds.width(), bounds.height()),
+                        &frame)) {
+      new_frame_available_ = false;
+      // Replacing the last image releases its frame once Skia is done with
+      // it.
+      if (auto image = ImportFrame(context, std::move(frame))) {
+        last_image_ = std::move(image);
+      }
+    }
+  }
+
+  if (last_image_) {
+    SkPaint paint;
+    paint.setFilterQuality(filter_quality);
+    if (bounds != SkRect::Make(last_image_->bounds())) {
+      canvas.drawImageRect(last_image_, bounds, &paint);
+    } else {
+      canvas.drawImage(last_image_, bounds.x(), bounds.y(), &paint);
+    }
+  }
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureDmaBuf::OnGrContextCreated() {
+  // The display may have changed along with the context.
+  procs_ = nullptr;
+  procs_resolved_ = false;
+  new_frame_available_ = true;
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureDmaBuf::OnGrContextDestroyed() {
+  last_image_.reset();
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureDmaBuf::MarkNewFrameAvailable() {
+  new_frame_available_ = true;
+}
+
+// |flutter::Texture|
+void EmbedderExternalTextureDmaBuf::OnTextureUnregistered() {
+  last_image_.reset();
+}
+
+}  // namespace flutter
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_DMA_BUF_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_DMA_BUF_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An external texture whose frames are DMA-BUFs supplied by the
+///             embedder, typically by a camera or a video decoder. Each frame
+///             is imported as an `EGLImage` and bound to a texture, so the
+///             GPU samples the buffer directly instead of a copy of it.
+///
+///             The embedder is only asked for a frame after it marked one as
+///             available. The previous frame is released, with a fence that
+///             signals once the GPU stopped reading it, when the next frame
+///             replaces it.
+///
+class EmbedderExternalTextureDmaBuf : public flutter::Texture {
+ public:
+  static constexpr size_t kMaxPlanes = 4;
+
+  struct Plane {
+    int fd = -1;
+    uint32_t offset = 0;
+    uint32_t pitch = 0;
+  };
+
+  struct Frame {
+    // GL_TEXTURE_2D or GL_TEXTURE_EXTERNAL_OES.
+    uint32_t target = 0;
+    SkISize size = SkISize::MakeEmpty();
+    // A DRM fourcc format code.
+    uint32_t fourcc = 0;
+    bool has_modifier = false;
+    uint64_t modifier = 0;
+    std::vector<Plane> planes;
+    // A sync file owned by the texture once the frame is returned, or -1.
+    int acquire_fence_fd = -1;
+    // Called with a sync file that the callee owns, or -1, once the frame is
+    // no longer sampled.
+    std::function<void(int release_fence_fd)> release_callback;
+  };
+
+  using FrameCallback = std::function<
+      bool(int64_t texture_identifier, const SkISize& size, Frame* frame)>;
+
+  // Resolves the EGL and OpenGL functions used to import the frames in
+  // the context of the raster thread.
+  using ProcResolver = std::function<void*(const char* name)>;
+
+  EmbedderExternalTextureDmaBuf(int64_t texture_identifier,
+                                const FrameCallback& frame_callback,
+                                const ProcResolver& proc_resolver);
+
+  ~EmbedderExternalTextureDmaBuf();
+
+  // The resolved EGL and OpenGL functions.
+  struct Procs;
+
+ private:
+  FrameCallback frame_callback_;
+  ProcResolver proc_resolver_;
+  // Resolved on the first frame, nullptr if the context cannot import
+  // DMA-BUFs.
+  std::shared_ptr<Procs> procs_;
+  bool procs_resolved_ = false;
+  bool new_frame_available_ = true;
+  sk_sp<SkImage> last_image_;
+
+  sk_sp<SkImage> ImportFrame(GrDirectContext* context, Frame frame);
+
+  // |flutter::Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrDirectContext* context,
+             SkFilterQuality filter_quality) override;
+
+  // |flutter::Texture|
+  void OnGrContextCreated() override;
+
+  // |flutter::Texture|
+  void OnGrContextDestroyed() override;
+
+  // |flutter::Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |flutter::Texture|
+  void OnTextureUnregistered() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalTextureDmaBuf);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_DMA_BUF_H_
@@ -32,8 +32,9 @@ EmbedderExternalView::EmbedderExternalView(
       embedded_view_params_(std::move(params)),
       recorder_(std::make_unique<SkPictureRecorder>()),
       canvas_spy_(std::make_unique<CanvasSpy>(
-          recorder_->beginRecording(frame_size.width(), frame_size.height()))) {
-}
+          recorder_->beginRecording(frame_size.width(),
+                                    frame_size.height(),
+                                    &rtree_factory_))) {}
 
 EmbedderExternalView::~EmbedderExternalView() = default;
 
@@ -59,7 +60,10 @@ bool EmbedderExternalView::HasPlatformView() const {
 }
 
 bool EmbedderExternalView::HasEngineRenderedContents() const {
-  return canvas_spy_->DidDrawIntoCanvas();
+  if (contents_coalesced_) {
+    return false;
+  }
+  return canvas_spy_->DidDrawIntoCanvas() || !coalesced_pictures_.empty();
 }
 
 EmbedderExternalView::ViewIdentifier EmbedderExternalView::GetViewIdentifier()
@@ -71,6 +75,38 @@ const EmbeddedViewParams* EmbedderExternalView::GetEmbeddedViewParams() const {
   return embedded_view_params_.get();
 }
 
+const sk_sp<SkPicture>& EmbedderExternalView::FinishRecording() {
+  if (!picture_) {
+    picture_ = recorder_->finishRecordingAsPicture();
+  }
+  return picture_;
+}
+
+bool EmbedderExternalView::HasEngineRenderedContentsIn(const SkRect& rect) {
+  if (!canvas_spy_->DidDrawIntoCanvas()) {
+    return false;
+  }
+  // The tree is only populated once the recording ends.
+  FinishRecording();
+  std::vector<SkRect> drawn_rects;
+  rtree_factory_.getInstance()->searchNonOverlappingDrawnRects(rect,
+                                                               &drawn_rects);
+  return !drawn_rects.empty();
+}
+
+void EmbedderExternalView::CoalesceContentsOf(EmbedderExternalView& view) {
+  FML_DCHECK(&view != this);
+  FinishRecording();
+  if (view.canvas_spy_->DidDrawIntoCanvas() && view.FinishRecording()) {
+    coalesced_pictures_.push_back(view.picture_);
+  }
+  coalesced_pictures_.insert(coalesced_pictures_.end(),
+                             view.coalesced_pictures_.begin(),
+                             view.coalesced_pictures_.end());
+  view.coalesced_pictures_.clear();
+  view.contents_coalesced_ = true;
+}
+
 bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
 
@@ -78,7 +114,7 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
       << "Unnecessarily asked to render into a render target when there was "
          "nothing to render.";
 
-  auto picture = recorder_->finishRecordingAsPicture();
+  auto picture = FinishRecording();
   if (!picture) {
     return false;
   }
@@ -99,6 +135,9 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
   canvas->setMatrix(surface_transformation_);
   canvas->clear(SK_ColorTRANSPARENT);
   canvas->drawPicture(picture);
+  for (const auto& coalesced_picture : coalesced_pictures_) {
+    canvas->drawPicture(coalesced_picture);
+  }
   canvas->flush();
 
   return true;
@@ -8,8 +8,10 @@
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/rtree.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/canvas_spy.h"
@@ -108,6 +110,26 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the contents rendered by the engine into this view
+  ///             intersect with the given rect. Ends the recording of the
+  ///             contents of the view.
+  ///
+  /// @param[in]  rect  The rect in the coordinates of the frame.
+  ///
+  bool HasEngineRenderedContentsIn(const SkRect& rect);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Moves the contents rendered by the engine into the other view
+  ///             into this view, where they are rendered after the contents
+  ///             of this view. The other view no longer needs a render target
+  ///             after this. Ends the recording of the contents of both views.
+  ///
+  /// @param      view  The view stacked above this one whose contents are
+  ///                   moved.
+  ///
+  void CoalesceContentsOf(EmbedderExternalView& view);
+
   bool Render(const EmbedderRenderTarget& render_target);
 
  private:
@@ -115,8 +137,16 @@ class EmbedderExternalView {
   const SkMatrix surface_transformation_;
   ViewIdentifier view_identifier_;
   std::unique_ptr<EmbeddedViewParams> embedded_view_params_;
+  RTreeFactory rtree_factory_;
   std::unique_ptr<SkPictureRecorder> recorder_;
   std::unique_ptr<CanvasSpy> canvas_spy_;
+  sk_sp<SkPicture> picture_;
+  // The pictures of the views stacked above this one whose contents are
+  // rendered into the render target of this view.
+  std::vector<sk_sp<SkPicture>> coalesced_pictures_;
+  bool contents_coalesced_ = false;
+
+  const sk_sp<SkPicture>& FinishRecording();
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalView);
 };
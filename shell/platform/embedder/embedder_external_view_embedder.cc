@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -28,6 +29,10 @@ void EmbedderExternalViewEmbedder::SetSurfaceTransformationCallback(
   surface_transformation_callback_ = surface_transformation_callback;
 }
 
+void EmbedderExternalViewEmbedder::SetCoalesceOverlays(bool coalesce_overlays) {
+  coalesce_overlays_ = coalesce_overlays;
+}
+
 SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
   if (!surface_transformation_callback_) {
     return SkMatrix{};
@@ -130,10 +135,53 @@ static FlutterBackingStoreConfig MakeBackingStoreConfig(
   return config;
 }
 
+void EmbedderExternalViewEmbedder::CoalesceOverlays() {
+  TRACE_EVENT0("flutter", "EmbedderExternalViewEmbedder::CoalesceOverlays");
+  if (composition_order_.empty()) {
+    return;
+  }
+  // The view whose render target the contents of the views above it may be
+  // rendered into, and the rects of the platform views stacked above it. The
+  // root view is at the bottom of the composition order.
+  EmbedderExternalView* target_view =
+      pending_views_.at(composition_order_.front()).get();
+  std::vector<SkRect> platform_view_rects;
+  for (size_t i = 1; i < composition_order_.size(); i++) {
+    const auto& view_id = composition_order_[i];
+    auto& view = *pending_views_.at(view_id);
+    if (view.HasPlatformView()) {
+      platform_view_rects.push_back(
+          view.GetEmbeddedViewParams()->finalBoundingRect());
+    }
+    if (!view.HasEngineRenderedContents()) {
+      continue;
+    }
+
+    // The contents of this view are drawn above the contents of the target
+    // view and below the platform views stacked above this one in either
+    // case, so they may only move if no platform view in between covers them.
+    const bool covers_platform_view =
+        std::any_of(platform_view_rects.begin(), platform_view_rects.end(),
+                    [&view](const SkRect& rect) {
+                      return view.HasEngineRenderedContentsIn(rect);
+                    });
+    if (covers_platform_view) {
+      target_view = &view;
+      platform_view_rects.clear();
+      continue;
+    }
+    target_view->CoalesceContentsOf(view);
+  }
+}
+
 // |ExternalViewEmbedder|
 void EmbedderExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     std::unique_ptr<SurfaceFrame> frame) {
+  if (coalesce_overlays_) {
+    CoalesceOverlays();
+  }
+
   auto [matched_render_targets, pending_keys] =
       render_target_cache_.GetExistingTargetsInCache(pending_views_);
 
@@ -68,6 +68,18 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   void SetSurfaceTransformationCallback(
       SurfaceTransformationCallback surface_transformation_callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the contents rendered above a platform view are
+  ///             moved into the render target below when they don't
+  ///             intersect with the platform views they are stacked above.
+  ///             This saves the embedder a layer and a render target for each
+  ///             such interleaving level, but changes the layers presented to
+  ///             it. Disabled by default.
+  ///
+  /// @param[in]  coalesce_overlays  Whether to coalesce overlays.
+  ///
+  void SetCoalesceOverlays(bool coalesce_overlays);
+
  private:
   // |ExternalViewEmbedder|
   void CancelFrame() override;
@@ -101,6 +113,7 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
+  bool coalesce_overlays_ = false;
   SkISize pending_frame_size_ = SkISize::Make(0, 0);
   double pending_device_pixel_ratio_ = 1.0;
   SkMatrix pending_surface_transformation_;
@@ -110,6 +123,8 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
 
   void Reset();
 
+  void CoalesceOverlays();
+
   SkMatrix GetSurfaceTransformation() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalViewEmbedder);
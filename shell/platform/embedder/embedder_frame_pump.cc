@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_frame_pump.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+EmbedderFramePump::EmbedderFramePump(FireCallback fire_callback)
+    : fire_callback_(std::move(fire_callback)) {
+  FML_DCHECK(fire_callback_);
+}
+
+EmbedderFramePump::~EmbedderFramePump() {
+  if (pending_baton_ != 0) {
+    const auto now = fml::TimePoint::Now();
+    fire_callback_(pending_baton_, now, now);
+  }
+}
+
+void EmbedderFramePump::OnVsyncRequested(intptr_t baton) {
+  FrameTimes frame;
+  {
+    std::scoped_lock lock(mutex_);
+    // The engine waits for one vsync at a time.
+    FML_DCHECK(pending_baton_ == 0);
+    if (queued_frames_.empty()) {
+      pending_baton_ = baton;
+      return;
+    }
+    frame = queued_frames_.front();
+    queued_frames_.pop_front();
+  }
+  TRACE_EVENT0("flutter", "EmbedderFramePump::Fire");
+  fire_callback_(baton, frame.first, frame.second);
+}
+
+void EmbedderFramePump::PumpFrame(fml::TimePoint frame_start_time,
+                                  fml::TimePoint frame_target_time) {
+  intptr_t baton = 0;
+  {
+    std::scoped_lock lock(mutex_);
+    if (pending_baton_ == 0) {
+      queued_frames_.emplace_back(frame_start_time, frame_target_time);
+      return;
+    }
+    baton = pending_baton_;
+    pending_baton_ = 0;
+  }
+  TRACE_EVENT0("flutter", "EmbedderFramePump::Fire");
+  fire_callback_(baton, frame_start_time, frame_target_time);
+}
+
+size_t EmbedderFramePump::GetQueuedFrameCount() const {
+  std::scoped_lock lock(mutex_);
+  return queued_frames_.size();
+}
+
+}  // namespace flutter
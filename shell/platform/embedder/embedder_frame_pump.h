@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_FRAME_PUMP_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_FRAME_PUMP_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Answers the vsync requests of the engine with frame times supplied by the
+/// embedder instead of waiting on a display.
+///
+/// The embedder queues frame times with |PumpFrame|, for example the times
+/// of the frames of a video being exported. Each vsync request of the engine
+/// takes the oldest queued frame time, so frames are produced as soon as the
+/// framework schedules them and as fast as the engine can render them. A
+/// request made while no frame time is queued waits for the next one.
+///
+/// All methods may be called on any thread.
+///
+class EmbedderFramePump {
+ public:
+  using FireCallback = std::function<bool(intptr_t baton,
+                                          fml::TimePoint frame_start_time,
+                                          fml::TimePoint frame_target_time)>;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  fire_callback  Returns a baton to the engine with the frame
+  ///                            times, as |VsyncWaiterEmbedder::OnEmbedderVsync|
+  ///                            does. Invoked without holding any lock.
+  ///
+  explicit EmbedderFramePump(FireCallback fire_callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the pending baton, if any, so that it is released.
+  ///             The engine is shut down by then and produces no frame.
+  ///
+  ~EmbedderFramePump();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The vsync callback of the platform view. Fires the baton
+  ///             right away when a frame time is queued.
+  ///
+  void OnVsyncRequested(intptr_t baton);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Queues the times of a frame, or fires the pending vsync
+  ///             request with them.
+  ///
+  void PumpFrame(fml::TimePoint frame_start_time,
+                 fml::TimePoint frame_target_time);
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of frame times no vsync request has taken yet.
+  ///
+  size_t GetQueuedFrameCount() const;
+
+ private:
+  using FrameTimes = std::pair<fml::TimePoint, fml::TimePoint>;
+
+  const FireCallback fire_callback_;
+  mutable std::mutex mutex_;
+  intptr_t pending_baton_ = 0;
+  std::deque<FrameTimes> queued_frames_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderFramePump);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_FRAME_PUMP_H_
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_pointer_data_queue.h"
+
+#include <algorithm>
+#include <string>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+EmbedderPointerDataQueue::State::State(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    FrameIntervalCallback frame_interval,
+    DispatchCallback dispatch_callback)
+    : task_runner(std::move(task_runner)),
+      frame_interval(std::move(frame_interval)),
+      dispatch_callback(std::move(dispatch_callback)) {}
+
+EmbedderPointerDataQueue::EmbedderPointerDataQueue(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    FrameIntervalCallback frame_interval,
+    DispatchCallback dispatch_callback)
+    : state_(std::make_shared<State>(std::move(task_runner),
+                                     std::move(frame_interval),
+                                     std::move(dispatch_callback))) {}
+
+EmbedderPointerDataQueue::~EmbedderPointerDataQueue() = default;
+
+void EmbedderPointerDataQueue::Enqueue(const PointerData* data, size_t count) {
+  if (data == nullptr || count == 0) {
+    return;
+  }
+
+  const fml::TimeDelta frame_interval = state_->frame_interval();
+  fml::TimePoint drain_time;
+  {
+    std::scoped_lock lock(state_->mutex);
+    state_->pending.insert(state_->pending.end(), data, data + count);
+    if (state_->drain_scheduled) {
+      return;
+    }
+    state_->drain_scheduled = true;
+    drain_time = std::max(fml::TimePoint::Now(),
+                          state_->last_drain + frame_interval);
+  }
+
+  std::weak_ptr<State> weak_state = state_;
+  state_->task_runner->PostTaskForTime([weak_state]() { Drain(weak_state); },
+                                       drain_time);
+}
+
+void EmbedderPointerDataQueue::Drain(const std::weak_ptr<State>& weak_state) {
+  auto state = weak_state.lock();
+  if (!state) {
+    return;
+  }
+
+  std::vector<PointerData> pending;
+  {
+    std::scoped_lock lock(state->mutex);
+    pending.swap(state->pending);
+    state->drain_scheduled = false;
+    state->last_drain = fml::TimePoint::Now();
+  }
+
+  TRACE_EVENT1("flutter", "EmbedderPointerDataQueue::Drain", "events",
+               std::to_string(pending.size()).c_str());
+  auto packet = std::make_unique<PointerDataPacket>(
+      reinterpret_cast<uint8_t*>(pending.data()),
+      pending.size() * sizeof(PointerData));
+  state->dispatch_callback(std::move(packet));
+}
+
+}  // namespace flutter
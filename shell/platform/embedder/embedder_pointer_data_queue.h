@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_POINTER_DATA_QUEUE_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_POINTER_DATA_QUEUE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Buffers pointer events written by the embedder and hands them to the
+/// engine as a single packet at most once per frame interval.
+///
+/// Enqueuing only takes a lock and appends to a buffer. The first event
+/// written after a drain posts one task to the task runner, which drains
+/// everything written until then. High frequency input devices (such as
+/// stylus digitizers reporting faster than the display refreshes) therefore
+/// cost one task and one packet per frame instead of one per event.
+///
+class EmbedderPointerDataQueue {
+ public:
+  using DispatchCallback =
+      std::function<void(std::unique_ptr<PointerDataPacket> packet)>;
+  using FrameIntervalCallback = std::function<fml::TimeDelta(void)>;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  task_runner        The task runner the dispatch callback is
+  ///                                invoked on.
+  /// @param[in]  frame_interval     Returns the minimum interval between two
+  ///                                drains. May be called on any thread.
+  /// @param[in]  dispatch_callback  Invoked on the task runner with every
+  ///                                event enqueued since the last drain.
+  ///
+  EmbedderPointerDataQueue(fml::RefPtr<fml::TaskRunner> task_runner,
+                           FrameIntervalCallback frame_interval,
+                           DispatchCallback dispatch_callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops all pending events. Drains that are already posted
+  ///             become no-ops.
+  ///
+  ~EmbedderPointerDataQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends events to the queue. May be called on any thread.
+  ///
+  void Enqueue(const PointerData* data, size_t count);
+
+ private:
+  struct State {
+    const fml::RefPtr<fml::TaskRunner> task_runner;
+    const FrameIntervalCallback frame_interval;
+    const DispatchCallback dispatch_callback;
+
+    std::mutex mutex;
+    std::vector<PointerData> pending;
+    bool drain_scheduled = false;
+    fml::TimePoint last_drain;
+
+    State(fml::RefPtr<fml::TaskRunner> task_runner,
+          FrameIntervalCallback frame_interval,
+          DispatchCallback dispatch_callback);
+  };
+
+  std::shared_ptr<State> state_;
+
+  static void Drain(const std::weak_ptr<State>& weak_state);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderPointerDataQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_POINTER_DATA_QUEUE_H_
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
 EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
@@ -17,6 +19,7 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
 
+  EmbedderExternalView::ViewIdentifierSet views_without_own_target;
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
@@ -25,7 +28,7 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
     auto& compatible_targets =
         cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
     if (compatible_targets.size() == 0) {
-      unmatched_identifiers.insert(view.first);
+      views_without_own_target.insert(view.first);
     } else {
       std::unique_ptr<EmbedderRenderTarget> target =
           std::move(compatible_targets.top());
@@ -33,6 +36,27 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
       resolved_render_targets[view.first] = std::move(target);
     }
   }
+
+  // Render targets are not tied to a view, so a view that didn't render into
+  // a target of this size last frame may take the target of any view that
+  // is gone. This avoids asking the embedder for new render targets as
+  // platform views are added and removed, while scrolling for instance.
+  for (const auto& view_identifier : views_without_own_target) {
+    const auto size =
+        pending_views.at(view_identifier)->GetRenderSurfaceSize();
+    auto compatible_targets = std::find_if(
+        cached_render_targets_.begin(), cached_render_targets_.end(),
+        [&size](const auto& targets) {
+          return targets.first.surface_size == size && !targets.second.empty();
+        });
+    if (compatible_targets == cached_render_targets_.end()) {
+      unmatched_identifiers.insert(view_identifier);
+      continue;
+    }
+    resolved_render_targets[view_identifier] =
+        std::move(compatible_targets->second.top());
+    compatible_targets->second.pop();
+  }
   return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
 }
 
@@ -10,4 +10,9 @@ EmbedderSurface::EmbedderSurface() = default;
 
 EmbedderSurface::~EmbedderSurface() = default;
 
+std::shared_ptr<ResourceContextPool>
+EmbedderSurface::CreateResourceContextPool() const {
+  return nullptr;
+}
+
 }  // namespace flutter
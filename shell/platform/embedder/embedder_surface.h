@@ -8,6 +8,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/resource_context_pool.h"
 
 namespace flutter {
 
@@ -23,6 +24,9 @@ class EmbedderSurface {
 
   virtual sk_sp<GrDirectContext> CreateResourceContext() const = 0;
 
+  virtual std::shared_ptr<ResourceContextPool> CreateResourceContextPool()
+      const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurface);
 };
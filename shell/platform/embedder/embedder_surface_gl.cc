@@ -46,7 +46,24 @@ bool EmbedderSurfaceGL::GLContextClearCurrent() {
 
 // |GPUSurfaceGLDelegate|
 bool EmbedderSurfaceGL::GLContextPresent(uint32_t fbo_id) {
-  return gl_dispatch_table_.gl_present_callback(fbo_id);
+  return gl_dispatch_table_.gl_present_callback(GLPresentInfo{fbo_id});
+}
+
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGL::GLContextPresentWithInfo(
+    const GLPresentInfo& present_info) {
+  return gl_dispatch_table_.gl_present_callback(present_info);
+}
+
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGL::GLContextSupportsPartialRepaint() const {
+  return static_cast<bool>(gl_dispatch_table_.gl_buffer_age_callback);
+}
+
+// |GPUSurfaceGLDelegate|
+uint32_t EmbedderSurfaceGL::GLContextBufferAge() const {
+  auto callback = gl_dispatch_table_.gl_buffer_age_callback;
+  return callback ? callback() : 0;
 }
 
 // |GPUSurfaceGLDelegate|
@@ -107,4 +124,29 @@ sk_sp<GrDirectContext> EmbedderSurfaceGL::CreateResourceContext() const {
   return nullptr;
 }
 
+// |EmbedderSurface|
+std::shared_ptr<ResourceContextPool>
+EmbedderSurfaceGL::CreateResourceContextPool() const {
+  auto callback = gl_dispatch_table_.gl_make_pooled_resource_current_callback;
+  const size_t count = gl_dispatch_table_.gl_pooled_resource_context_count;
+  if (!callback || count == 0) {
+    return nullptr;
+  }
+  // The factory is only invoked while the pool is being created.
+  auto pool = std::make_shared<ResourceContextPool>(
+      count, [this, &callback](size_t index) -> sk_sp<GrDirectContext> {
+        if (!callback(index)) {
+          FML_LOG(ERROR) << "Could not make the pooled resource context "
+                         << index << " current.";
+          return nullptr;
+        }
+        return ShellIOManager::CreateCompatibleResourceLoadingContext(
+            GrBackend::kOpenGL_GrBackend, GetGLInterface());
+      });
+  if (pool->GetContextCount() == 0) {
+    return nullptr;
+  }
+  return pool;
+}
+
 }  // namespace flutter
@@ -18,12 +18,16 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   struct GLDispatchTable {
     std::function<bool(void)> gl_make_current_callback;           // required
     std::function<bool(void)> gl_clear_current_callback;          // required
-    std::function<bool(uint32_t)> gl_present_callback;            // required
+    std::function<bool(GLPresentInfo)> gl_present_callback;       // required
     std::function<intptr_t(GLFrameInfo)> gl_fbo_callback;         // required
     std::function<bool(void)> gl_make_resource_current_callback;  // optional
     std::function<SkMatrix(void)>
         gl_surface_transformation_callback;              // optional
     std::function<void*(const char*)> gl_proc_resolver;  // optional
+    std::function<uint32_t(void)> gl_buffer_age_callback;  // optional
+    std::function<bool(size_t)>
+        gl_make_pooled_resource_current_callback;  // optional
+    size_t gl_pooled_resource_context_count = 0;   // optional
   };
 
   EmbedderSurfaceGL(
@@ -49,6 +53,10 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   // |EmbedderSurface|
   sk_sp<GrDirectContext> CreateResourceContext() const override;
 
+  // |EmbedderSurface|
+  std::shared_ptr<ResourceContextPool> CreateResourceContextPool()
+      const override;
+
   // |GPUSurfaceGLDelegate|
   std::unique_ptr<GLContextResult> GLContextMakeCurrent() override;
 
@@ -58,6 +66,15 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   // |GPUSurfaceGLDelegate|
   bool GLContextPresent(uint32_t fbo_id) override;
 
+  // |GPUSurfaceGLDelegate|
+  bool GLContextPresentWithInfo(const GLPresentInfo& present_info) override;
+
+  // |GPUSurfaceGLDelegate|
+  bool GLContextSupportsPartialRepaint() const override;
+
+  // |GPUSurfaceGLDelegate|
+  uint32_t GLContextBufferAge() const override;
+
   // |GPUSurfaceGLDelegate|
   intptr_t GLContextFBO(GLFrameInfo frame_info) const override;
 
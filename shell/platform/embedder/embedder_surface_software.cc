@@ -9,12 +9,17 @@
 
 namespace flutter {
 
+// The number of presented buffers remembered to compute the age of the next
+// one. Older buffers are repainted in full.
+static const size_t kMaxPresentedAllocations = 4;
+
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : software_dispatch_table_(software_dispatch_table),
       external_view_embedder_(external_view_embedder) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !software_dispatch_table_.software_present_backing_store_with_info) {
     return;
   }
   valid_ = true;
@@ -57,12 +62,20 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
+  if (software_dispatch_table_.software_acquire_buffer) {
+    return AcquireEmbedderBackingStore(size);
+  }
+
   if (sk_surface_ != nullptr &&
       SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
     // The old and new surface sizes are the same. Nothing to do here.
+    backing_store_age_ = presented_allocations_.empty() ? 0 : 1;
     return sk_surface_;
   }
 
+  presented_allocations_.clear();
+  backing_store_age_ = 0;
+
   SkImageInfo info = SkImageInfo::MakeN32(
       size.fWidth, size.fHeight, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
   sk_surface_ = SkSurface::MakeRaster(info, nullptr);
@@ -75,9 +88,64 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
   return sk_surface_;
 }
 
+sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireEmbedderBackingStore(
+    const SkISize& size) {
+  if (sk_surface_ == nullptr ||
+      SkISize::Make(sk_surface_->width(), sk_surface_->height()) != size) {
+    // Buffers presented at another size can't be partially repainted.
+    presented_allocations_.clear();
+  }
+  sk_surface_ = nullptr;
+  buffer_user_data_ = nullptr;
+  backing_store_age_ = 0;
+
+  auto buffer = software_dispatch_table_.software_acquire_buffer(size);
+  if (!buffer.has_value() || buffer->allocation == nullptr) {
+    FML_LOG(ERROR) << "Embedder did not supply a buffer for software rendering.";
+    return nullptr;
+  }
+
+  SkImageInfo info = SkImageInfo::MakeN32(
+      size.fWidth, size.fHeight, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
+  if (buffer->row_bytes < info.minRowBytes()) {
+    FML_LOG(ERROR) << "Embedder supplied a software buffer with too few bytes "
+                      "per row.";
+    return nullptr;
+  }
+
+  sk_surface_ =
+      SkSurface::MakeRasterDirect(info, buffer->allocation, buffer->row_bytes);
+  if (sk_surface_ == nullptr) {
+    FML_LOG(ERROR) << "Could not wrap the embedder supplied software buffer.";
+    return nullptr;
+  }
+
+  buffer_user_data_ = buffer->user_data;
+  backing_store_age_ = AgeOfAllocation(buffer->allocation);
+  return sk_surface_;
+}
+
+uint32_t EmbedderSurfaceSoftware::AgeOfAllocation(
+    const void* allocation) const {
+  const size_t count = presented_allocations_.size();
+  for (size_t age = 1; age <= count; age++) {
+    if (presented_allocations_[count - age] == allocation) {
+      return age;
+    }
+  }
+  return 0;
+}
+
 // |GPUSurfaceSoftwareDelegate|
 bool EmbedderSurfaceSoftware::PresentBackingStore(
     sk_sp<SkSurface> backing_store) {
+  return PresentBackingStoreWithInfo(std::move(backing_store), {});
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreWithInfo(
+    sk_sp<SkSurface> backing_store,
+    const SoftwarePresentInfo& present_info) {
   if (!IsValid()) {
     FML_LOG(ERROR) << "Tried to present an invalid software surface.";
     return false;
@@ -89,21 +157,56 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
-  // Some basic sanity checking.
-  uint64_t expected_pixmap_data_size = pixmap.width() * pixmap.height() * 4;
+  // Some basic sanity checking. Embedder supplied buffers may pad their rows.
+  if (!software_dispatch_table_.software_acquire_buffer) {
+    uint64_t expected_pixmap_data_size = pixmap.width() * pixmap.height() * 4;
 
-  const size_t pixmap_size = pixmap.computeByteSize();
+    const size_t pixmap_size = pixmap.computeByteSize();
 
-  if (expected_pixmap_data_size != pixmap_size) {
-    FML_LOG(ERROR) << "Software backing store had unexpected size.";
-    return false;
+    if (expected_pixmap_data_size != pixmap_size) {
+      FML_LOG(ERROR) << "Software backing store had unexpected size.";
+      return false;
+    }
   }
 
-  return software_dispatch_table_.software_present_backing_store(
-      pixmap.addr(),      //
-      pixmap.rowBytes(),  //
-      pixmap.height()     //
-  );
+  bool presented = false;
+  if (software_dispatch_table_.software_present_backing_store_with_info) {
+    PresentInfo info;
+    info.allocation = pixmap.addr();
+    info.row_bytes = pixmap.rowBytes();
+    info.height = pixmap.height();
+    info.buffer_user_data = buffer_user_data_;
+    info.frame_damage = present_info.frame_damage;
+    info.buffer_damage = present_info.buffer_damage;
+    presented =
+        software_dispatch_table_.software_present_backing_store_with_info(info);
+  } else {
+    presented = software_dispatch_table_.software_present_backing_store(
+        pixmap.addr(),      //
+        pixmap.rowBytes(),  //
+        pixmap.height()     //
+    );
+  }
+
+  if (presented) {
+    presented_allocations_.push_back(pixmap.addr());
+    if (presented_allocations_.size() > kMaxPresentedAllocations) {
+      presented_allocations_.pop_front();
+    }
+  }
+
+  return presented;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::SupportsPartialRepaint() const {
+  return static_cast<bool>(
+      software_dispatch_table_.software_present_backing_store_with_info);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+uint32_t EmbedderSurfaceSoftware::BackingStoreAge() const {
+  return backing_store_age_;
 }
 
 }  // namespace flutter
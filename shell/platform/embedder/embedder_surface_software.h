@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include <deque>
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
@@ -15,9 +18,29 @@ namespace flutter {
 class EmbedderSurfaceSoftware final : public EmbedderSurface,
                                       public GPUSurfaceSoftwareDelegate {
  public:
+  // A buffer provided by the embedder to render a frame into.
+  struct Buffer {
+    void* allocation = nullptr;
+    size_t row_bytes = 0;
+    void* user_data = nullptr;
+  };
+
+  struct PresentInfo {
+    const void* allocation = nullptr;
+    size_t row_bytes = 0;
+    size_t height = 0;
+    void* buffer_user_data = nullptr;
+    std::optional<SkIRect> frame_damage;
+    std::optional<SkIRect> buffer_damage;
+  };
+
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // required (or next)
+    std::function<bool(const PresentInfo& present_info)>
+        software_present_backing_store_with_info;  // required (or previous)
+    std::function<std::optional<Buffer>(const SkISize& size)>
+        software_acquire_buffer;  // optional
   };
 
   EmbedderSurfaceSoftware(
@@ -30,6 +53,11 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
+  void* buffer_user_data_ = nullptr;
+  uint32_t backing_store_age_ = 0;
+  // The pixels of the most recently presented buffers, newest last. Used to
+  // tell how many frames old a buffer handed back by the embedder is.
+  std::deque<const void*> presented_allocations_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
   // |EmbedderSurface|
@@ -47,6 +75,21 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreWithInfo(
+      sk_sp<SkSurface> backing_store,
+      const SoftwarePresentInfo& present_info) override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool SupportsPartialRepaint() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  uint32_t BackingStoreAge() const override;
+
+  sk_sp<SkSurface> AcquireEmbedderBackingStore(const SkISize& size);
+
+  uint32_t AgeOfAllocation(const void* allocation) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/embedder/embedder_task_runner.h"
 
+#include <iterator>
+#include <vector>
+
 #include "flutter/fml/message_loop_impl.h"
 #include "flutter/fml/message_loop_task_queues.h"
 
@@ -16,7 +19,8 @@ EmbedderTaskRunner::EmbedderTaskRunner(DispatchTable table,
       dispatch_table_(std::move(table)),
       placeholder_id_(
           fml::MessageLoopTaskQueues::GetInstance()->CreateTaskQueue()) {
-  FML_DCHECK(dispatch_table_.post_task_callback);
+  FML_DCHECK(dispatch_table_.post_task_callback ||
+             dispatch_table_.post_tasks_callback);
   FML_DCHECK(dispatch_table_.runs_task_on_current_thread_callback);
 }
 
@@ -36,6 +40,24 @@ void EmbedderTaskRunner::PostTaskForTime(const fml::closure& task,
     return;
   }
 
+  if (dispatch_table_.post_tasks_callback) {
+    size_t task_count = 0;
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      queued_tasks_.emplace(target_time, task);
+      // The embedder already has a wakeup that will run this task, or will
+      // be told about it once the tasks being run are done.
+      if (draining_depth_ > 0 || (scheduled_target_time_.has_value() &&
+                                  *scheduled_target_time_ <= target_time)) {
+        return;
+      }
+      scheduled_target_time_ = target_time;
+      task_count = CountQueuedTasksUntil(target_time);
+    }
+    dispatch_table_.post_tasks_callback(this, target_time, task_count);
+    return;
+  }
+
   uint64_t baton = 0;
 
   {
@@ -53,6 +75,20 @@ void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
   PostTaskForTime(task, fml::TimePoint::Now() + delay);
 }
 
+// The embedder's event loop has no notion of priorities.
+void EmbedderTaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                              fml::TaskPriority priority) {
+  PostTask(task);
+}
+
+void EmbedderTaskRunner::PostTaskForTimeWithPriority(
+    const fml::closure& task,
+    fml::TimePoint target_time,
+    fml::TaskPriority priority,
+    fml::TimePoint deadline) {
+  PostTaskForTime(task, target_time);
+}
+
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
   return dispatch_table_.runs_task_on_current_thread_callback();
 }
@@ -78,6 +114,53 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
   return true;
 }
 
+bool EmbedderTaskRunner::RunExpiredTasks() {
+  if (!dispatch_table_.post_tasks_callback) {
+    FML_LOG(ERROR) << "Embedder attempted to run the tasks of a task runner "
+                      "that does not batch them.";
+    return false;
+  }
+
+  std::vector<fml::closure> expired_tasks;
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    ++draining_depth_;
+    scheduled_target_time_.reset();
+    auto end = queued_tasks_.upper_bound(fml::TimePoint::Now());
+    expired_tasks.reserve(std::distance(queued_tasks_.begin(), end));
+    for (auto it = queued_tasks_.begin(); it != end; ++it) {
+      expired_tasks.push_back(std::move(it->second));
+    }
+    queued_tasks_.erase(queued_tasks_.begin(), end);
+  }
+
+  // The tasks may post more tasks, so run them without the lock held.
+  for (const auto& task : expired_tasks) {
+    task();
+  }
+
+  fml::TimePoint next_target_time;
+  size_t task_count = 0;
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    --draining_depth_;
+    if (draining_depth_ > 0 || queued_tasks_.empty()) {
+      return true;
+    }
+    next_target_time = queued_tasks_.begin()->first;
+    scheduled_target_time_ = next_target_time;
+    task_count = CountQueuedTasksUntil(next_target_time);
+  }
+  dispatch_table_.post_tasks_callback(this, next_target_time, task_count);
+  return true;
+}
+
+size_t EmbedderTaskRunner::CountQueuedTasksUntil(
+    fml::TimePoint target_time) const {
+  return std::distance(queued_tasks_.begin(),
+                       queued_tasks_.upper_bound(target_time));
+}
+
 // |fml::TaskRunner|
 fml::TaskQueueId EmbedderTaskRunner::GetTaskQueueId() {
   return placeholder_id_;
@@ -5,7 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 
+#include <map>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -39,6 +41,17 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
     /// thread.
     ///
     std::function<bool(void)> runs_task_on_current_thread_callback;
+    //--------------------------------------------------------------------------
+    /// Optional. If set, the task runner keeps the tasks in a queue of its
+    /// own and this is called instead of `post_task_callback`, to tell the
+    /// embedder that `task_count` tasks will be ready at `target_time`. The
+    /// embedder must then call `EmbedderTaskRunner::RunExpiredTasks` on the
+    /// correct thread once `target_time` expires.
+    ///
+    std::function<void(EmbedderTaskRunner* task_runner,
+                       fml::TimePoint target_time,
+                       size_t task_count)>
+        post_tasks_callback;
   };
 
   //----------------------------------------------------------------------------
@@ -71,14 +84,40 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
 
   bool PostTask(uint64_t baton);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs, in order, the tasks whose target time had expired when
+  ///             the call was made. Tasks that are still pending afterwards,
+  ///             including those posted by the tasks that ran, are announced
+  ///             to the embedder again via the `post_tasks_callback`.
+  ///
+  /// @attention  Only valid for task runners whose dispatch table specifies a
+  ///             `post_tasks_callback`. Must be called on the thread the
+  ///             embedder runs the tasks of this task runner on.
+  ///
+  /// @return     Whether the task runner batches its tasks.
+  ///
+  bool RunExpiredTasks();
+
  private:
   const size_t embedder_identifier_;
   DispatchTable dispatch_table_;
   std::mutex tasks_mutex_;
   uint64_t last_baton_;
   std::unordered_map<uint64_t, fml::closure> pending_tasks_;
+  // The tasks of a task runner with a |post_tasks_callback|, by target time.
+  // Tasks with the same target time keep the order they were posted in.
+  std::multimap<fml::TimePoint, fml::closure> queued_tasks_;
+  // The target time the embedder was last told about, if it has not called
+  // |RunExpiredTasks| since.
+  std::optional<fml::TimePoint> scheduled_target_time_;
+  // The number of |RunExpiredTasks| calls on the stack. The embedder is not
+  // told about the tasks posted meanwhile until the outermost one is done.
+  size_t draining_depth_ = 0;
   fml::TaskQueueId placeholder_id_;
 
+  // Must be called with |tasks_mutex_| held.
+  size_t CountQueuedTasksUntil(fml::TimePoint target_time) const;
+
   // |fml::TaskRunner|
   void PostTask(const fml::closure& task) override;
 
@@ -89,6 +128,16 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   // |fml::TaskRunner|
   void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
 
+  // |fml::TaskRunner|
+  void PostTaskWithPriority(const fml::closure& task,
+                            fml::TaskPriority priority) override;
+
+  // |fml::TaskRunner|
+  void PostTaskForTimeWithPriority(const fml::closure& task,
+                                   fml::TimePoint target_time,
+                                   fml::TaskPriority priority,
+                                   fml::TimePoint deadline) override;
+
   // |fml::TaskRunner|
   bool RunsTasksOnCurrentThread() override;
 
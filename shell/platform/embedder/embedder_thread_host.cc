@@ -42,9 +42,13 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
     return {false, {}};
   }
 
-  if (SAFE_ACCESS(description, post_task_callback, nullptr) == nullptr) {
-    FML_LOG(ERROR)
-        << "FlutterTaskRunnerDescription.post_task_callback was nullptr.";
+  auto post_tasks_callback_c =
+      SAFE_ACCESS(description, post_tasks_callback, nullptr);
+
+  if (SAFE_ACCESS(description, post_task_callback, nullptr) == nullptr &&
+      post_tasks_callback_c == nullptr) {
+    FML_LOG(ERROR) << "FlutterTaskRunnerDescription.post_task_callback and "
+                      "post_tasks_callback were both nullptr.";
     return {false, {}};
   }
 
@@ -74,6 +78,19 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
         return runs_task_on_current_thread_callback_c(user_data);
       }};
 
+  if (post_tasks_callback_c != nullptr) {
+    // The engine keeps the queue and only tells the embedder when to drain it.
+    task_runner_dispatch_table.post_task_callback = nullptr;
+    task_runner_dispatch_table.post_tasks_callback =
+        [post_tasks_callback_c, user_data](EmbedderTaskRunner* task_runner,
+                                           fml::TimePoint target_time,
+                                           size_t task_count) -> void {
+      post_tasks_callback_c(reinterpret_cast<FlutterTaskRunner>(task_runner),
+                            target_time.ToEpochDelta().ToNanoseconds(),
+                            task_count, user_data);
+    };
+  }
+
   return {true, fml::MakeRefCounted<EmbedderTaskRunner>(
                     task_runner_dispatch_table,
                     SAFE_ACCESS(description, identifier, 0u))};
@@ -81,9 +98,10 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
 
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-    const FlutterCustomTaskRunners* custom_task_runners) {
+    const FlutterCustomTaskRunners* custom_task_runners,
+    const flutter::Settings& settings) {
   {
-    auto host = CreateEmbedderManagedThreadHost(custom_task_runners);
+    auto host = CreateEmbedderManagedThreadHost(custom_task_runners, settings);
     if (host && host->IsValid()) {
       return host;
     }
@@ -94,7 +112,7 @@ EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
   // configuration if the embedder attempted to specify a configuration but
   // messed up with an incorrect configuration.
   if (custom_task_runners == nullptr) {
-    auto host = CreateEngineManagedThreadHost();
+    auto host = CreateEngineManagedThreadHost(settings);
     if (host && host->IsValid()) {
       return host;
     }
@@ -113,7 +131,8 @@ constexpr const char* kFlutterThreadName = "io.flutter";
 // static
 std::unique_ptr<EmbedderThreadHost>
 EmbedderThreadHost::CreateEmbedderManagedThreadHost(
-    const FlutterCustomTaskRunners* custom_task_runners) {
+    const FlutterCustomTaskRunners* custom_task_runners,
+    const flutter::Settings& settings) {
   if (custom_task_runners == nullptr) {
     return nullptr;
   }
@@ -154,7 +173,8 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
   // Create a thread host with just the threads that need to be managed by the
   // engine. The embedder has provided the rest.
-  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask);
+  ThreadHost thread_host(kFlutterThreadName, engine_thread_host_mask,
+                         settings);
 
   // If the embedder has supplied a platform task runner, use that. If not, use
   // the current thread task runner.
@@ -205,12 +225,14 @@ EmbedderThreadHost::CreateEmbedderManagedThreadHost(
 
 // static
 std::unique_ptr<EmbedderThreadHost>
-EmbedderThreadHost::CreateEngineManagedThreadHost() {
+EmbedderThreadHost::CreateEngineManagedThreadHost(
+    const flutter::Settings& settings) {
   // Create a thread host with the current thread as the platform thread and all
   // other threads managed.
-  ThreadHost thread_host(kFlutterThreadName, ThreadHost::Type::GPU |
-                                                 ThreadHost::Type::IO |
-                                                 ThreadHost::Type::UI);
+  ThreadHost thread_host(
+      kFlutterThreadName,
+      ThreadHost::Type::GPU | ThreadHost::Type::IO | ThreadHost::Type::UI,
+      settings);
 
   // For embedder platforms that don't have native message loop interop, this
   // will reference a task runner that points to a null message loop
@@ -270,4 +292,12 @@ bool EmbedderThreadHost::PostTask(int64_t runner, uint64_t task) const {
   return found->second->PostTask(task);
 }
 
+bool EmbedderThreadHost::RunExpiredTasks(int64_t runner) const {
+  auto found = runners_map_.find(runner);
+  if (found == runners_map_.end()) {
+    return false;
+  }
+  return found->second->RunExpiredTasks();
+}
+
 }  // namespace flutter
@@ -257,6 +257,15 @@ void platform_messages_no_response() {
   signalNativeTest();
 }
 
+@pragma('vm:entry-point')
+void platform_messages_background() {
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    PlatformDispatcher.instance.sendPlatformMessage('test/background', data, null);
+  };
+  signalNativeTest();
+}
+
 @pragma('vm:entry-point')
 void null_platform_messages() {
   PlatformDispatcher.instance.onPlatformMessage =
@@ -773,6 +782,28 @@ void objects_can_be_posted() {
   signalNativeCount(port.sendPort.nativePort);
 }
 
+@pragma('vm:entry-point')
+void ring_buffer_can_be_read() {
+  Uint8List? buffer;
+  ReceivePort port = ReceivePort();
+  port.listen((dynamic message) {
+    if (message is Uint8List) {
+      buffer = message;
+      return;
+    }
+    ByteData header = ByteData.sublistView(buffer!, 0, 64);
+    int capacity = header.getUint64(16, Endian.little);
+    int readOffset = header.getUint64(8, Endian.little);
+    StringBuffer text = StringBuffer();
+    for (; readOffset < (message as int); readOffset++) {
+      text.writeCharCode(buffer![64 + readOffset % capacity]);
+    }
+    header.setUint64(8, readOffset, Endian.little);
+    signalNativeMessage(text.toString());
+  });
+  signalNativeCount(port.sendPort.nativePort);
+}
+
 @pragma('vm:entry-point')
 void empty_scene_posts_zero_layers_to_compositor() {
   PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
@@ -814,6 +845,57 @@ void render_targets_are_recycled() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+void render_targets_are_recycled_across_platform_views() {
+  int frame_count = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    SceneBuilder builder = SceneBuilder();
+    // Scroll a new platform view in, and the oldest one out, every frame.
+    for (int i = 0; i < 10; i++) {
+      builder.addPicture(Offset(0.0, 0.0), CreateGradientBox(Size(30.0, 20.0)));
+      builder.addPlatformView(42 + frame_count + i, width: 30.0, height: 20.0);
+    }
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    PlatformDispatcher.instance.scheduleFrame();
+    frame_count++;
+    if (frame_count == 8) {
+      signalNativeTest();
+    }
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
+@pragma('vm:entry-point')
+void can_coalesce_overlay_layers() {
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    Color red = Color.fromARGB(255, 255, 0, 0);
+    Color blue = Color.fromARGB(255, 0, 0, 255);
+    Size size = Size(100.0, 100.0);
+
+    SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset(0.0, 0.0), CreateColoredBox(red, size));
+
+    builder.pushOffset(200.0, 200.0);
+    builder.addPlatformView(42, width: 100.0, height: 100.0);
+    builder.pop();
+
+    // Does not intersect with the platform view below.
+    builder.addPicture(Offset(500.0, 400.0), CreateColoredBox(blue, size));
+
+    builder.pushOffset(0.0, 300.0);
+    builder.addPlatformView(24, width: 100.0, height: 100.0);
+    builder.pop();
+
+    // Intersects with the platform view below.
+    builder.addPicture(Offset(50.0, 350.0), CreateColoredBox(blue, size));
+
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    signalNativeTest(); // Signal 2
+  };
+  signalNativeTest(); // Signal 1
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 void nativeArgumentsCallback(List<String> args) native 'NativeArgumentsCallback';
 
 @pragma('vm:entry-point')
@@ -68,6 +68,14 @@ void PlatformViewEmbedder::HandlePlatformMessage(
       std::move(message));
 }
 
+// |PlatformView|
+void PlatformViewEmbedder::HandleBackgroundPlatformMessage(
+    fml::RefPtr<flutter::PlatformMessage> message) {
+  // The embedder asked for the messages of this channel off the platform
+  // thread, so deliver them on the current thread.
+  HandlePlatformMessage(std::move(message));
+}
+
 // |PlatformView|
 std::unique_ptr<Surface> PlatformViewEmbedder::CreateRenderingSurface() {
   if (embedder_surface_ == nullptr) {
@@ -92,6 +100,15 @@ sk_sp<GrDirectContext> PlatformViewEmbedder::CreateResourceContext() const {
   return embedder_surface_->CreateResourceContext();
 }
 
+// |PlatformView|
+std::shared_ptr<ResourceContextPool>
+PlatformViewEmbedder::CreateResourceContextPool() const {
+  if (embedder_surface_ == nullptr) {
+    return nullptr;
+  }
+  return embedder_surface_->CreateResourceContextPool();
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewEmbedder::CreateVSyncWaiter() {
   if (!platform_dispatch_table_.vsync_callback) {
@@ -100,7 +117,8 @@ std::unique_ptr<VsyncWaiter> PlatformViewEmbedder::CreateVSyncWaiter() {
   }
 
   return std::make_unique<VsyncWaiterEmbedder>(
-      platform_dispatch_table_.vsync_callback, task_runners_);
+      platform_dispatch_table_.vsync_callback, task_runners_,
+      platform_dispatch_table_.preferred_frame_rate_callback);
 }
 
 // |PlatformView|
@@ -42,6 +42,8 @@ class PlatformViewEmbedder final : public PlatformView {
     VsyncWaiterEmbedder::VsyncCallback vsync_callback;  // optional
     ComputePlatformResolvedLocaleCallback
         compute_platform_resolved_locale_callback;
+    VsyncWaiterEmbedder::PreferredFrameRateCallback
+        preferred_frame_rate_callback;  // optional
   };
 
   // Create a platform view that sets up a software rasterizer.
@@ -74,6 +76,10 @@ class PlatformViewEmbedder final : public PlatformView {
   void HandlePlatformMessage(
       fml::RefPtr<flutter::PlatformMessage> message) override;
 
+  // |PlatformView|
+  void HandleBackgroundPlatformMessage(
+      fml::RefPtr<flutter::PlatformMessage> message) override;
+
  private:
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<EmbedderSurface> embedder_surface_;
@@ -88,6 +94,10 @@ class PlatformViewEmbedder final : public PlatformView {
   // |PlatformView|
   sk_sp<GrDirectContext> CreateResourceContext() const override;
 
+  // |PlatformView|
+  std::shared_ptr<ResourceContextPool> CreateResourceContextPool()
+      const override;
+
   // |PlatformView|
   std::unique_ptr<VsyncWaiter> CreateVSyncWaiter() override;
 
@@ -145,6 +145,18 @@ void EmbedderConfigBuilder::SetOpenGLPresentCallBack() {
 #endif
 }
 
+void EmbedderConfigBuilder::SetOpenGLDmaBufTextureFrameCallBack() {
+#ifdef SHELL_ENABLE_GL
+  // SetOpenGLRendererConfig must be called before this.
+  FML_CHECK(renderer_config_.type == FlutterRendererType::kOpenGL);
+  renderer_config_.open_gl.gl_dma_buf_texture_frame_callback =
+      [](void* context, int64_t texture_identifier, size_t width,
+         size_t height, FlutterDmaBufTexture* texture) -> bool {
+    return false;
+  };
+#endif
+}
+
 void EmbedderConfigBuilder::SetOpenGLRendererConfig(SkISize surface_size) {
 #ifdef SHELL_ENABLE_GL
   renderer_config_.type = FlutterRendererType::kOpenGL;
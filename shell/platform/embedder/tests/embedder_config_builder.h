@@ -60,6 +60,10 @@ class EmbedderConfigBuilder {
   // test this behavior.
   void SetOpenGLPresentCallBack();
 
+  // Used to set an `open_gl.gl_dma_buf_texture_frame_callback` that supplies
+  // no frames, so that DMA-BUF textures can be registered.
+  void SetOpenGLDmaBufTextureFrameCallBack();
+
   void SetAssetsPath();
 
   void SetSnapshots();
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_frame_pump.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct Fired {
+  intptr_t baton;
+  fml::TimePoint frame_start_time;
+};
+
+fml::TimePoint FrameTime(int64_t frame) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(frame * 16));
+}
+
+}  // namespace
+
+TEST(EmbedderFramePumpTest, RequestsTakeQueuedFramesInOrder) {
+  std::vector<Fired> fired;
+  EmbedderFramePump pump([&](intptr_t baton, fml::TimePoint start,
+                             fml::TimePoint target) {
+    fired.push_back({baton, start});
+    return true;
+  });
+
+  pump.PumpFrame(FrameTime(0), FrameTime(1));
+  pump.PumpFrame(FrameTime(1), FrameTime(2));
+  ASSERT_EQ(pump.GetQueuedFrameCount(), 2u);
+  ASSERT_TRUE(fired.empty());
+
+  pump.OnVsyncRequested(1);
+  pump.OnVsyncRequested(2);
+  ASSERT_EQ(pump.GetQueuedFrameCount(), 0u);
+  ASSERT_EQ(fired.size(), 2u);
+  EXPECT_EQ(fired[0].baton, 1);
+  EXPECT_EQ(fired[0].frame_start_time, FrameTime(0));
+  EXPECT_EQ(fired[1].baton, 2);
+  EXPECT_EQ(fired[1].frame_start_time, FrameTime(1));
+}
+
+TEST(EmbedderFramePumpTest, RequestsWaitForTheNextFrame) {
+  std::vector<Fired> fired;
+  EmbedderFramePump pump([&](intptr_t baton, fml::TimePoint start,
+                             fml::TimePoint target) {
+    fired.push_back({baton, start});
+    return true;
+  });
+
+  pump.OnVsyncRequested(7);
+  ASSERT_TRUE(fired.empty());
+
+  pump.PumpFrame(FrameTime(3), FrameTime(4));
+  ASSERT_EQ(fired.size(), 1u);
+  EXPECT_EQ(fired[0].baton, 7);
+  EXPECT_EQ(fired[0].frame_start_time, FrameTime(3));
+  EXPECT_EQ(pump.GetQueuedFrameCount(), 0u);
+}
+
+TEST(EmbedderFramePumpTest, PendingBatonIsReturnedOnDestruction) {
+  std::vector<Fired> fired;
+  {
+    EmbedderFramePump pump([&](intptr_t baton, fml::TimePoint start,
+                               fml::TimePoint target) {
+      fired.push_back({baton, start});
+      return false;
+    });
+    pump.OnVsyncRequested(5);
+  }
+  ASSERT_EQ(fired.size(), 1u);
+  EXPECT_EQ(fired[0].baton, 5);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_pointer_data_queue.h"
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+PointerData MakeMove(int64_t device, double x) {
+  PointerData data;
+  data.Clear();
+  data.change = PointerData::Change::kMove;
+  data.device = device;
+  data.physical_x = x;
+  return data;
+}
+
+size_t CountEvents(const PointerDataPacket& packet) {
+  return packet.data().size() / sizeof(PointerData);
+}
+
+}  // namespace
+
+TEST(EmbedderPointerDataQueueTest, EventsEnqueuedBeforeDrainShareAPacket) {
+  fml::Thread thread("queue");
+  auto task_runner = thread.GetTaskRunner();
+
+  std::vector<size_t> packet_sizes;
+  fml::AutoResetWaitableEvent dispatched;
+  EmbedderPointerDataQueue queue(
+      task_runner, []() { return fml::TimeDelta::FromMilliseconds(16); },
+      [&](std::unique_ptr<PointerDataPacket> packet) {
+        packet_sizes.push_back(CountEvents(*packet));
+        dispatched.Signal();
+      });
+
+  // Hold the task runner so that every event is enqueued before the drain.
+  fml::ManualResetWaitableEvent release;
+  task_runner->PostTask([&release]() { release.Wait(); });
+  for (int i = 0; i < 4; i++) {
+    PointerData data = MakeMove(0, i);
+    queue.Enqueue(&data, 1);
+  }
+  release.Signal();
+  dispatched.Wait();
+
+  // A later event is dispatched in a separate packet.
+  PointerData data = MakeMove(0, 4);
+  queue.Enqueue(&data, 1);
+  dispatched.Wait();
+
+  ASSERT_EQ(packet_sizes.size(), 2u);
+  ASSERT_EQ(packet_sizes[0], 4u);
+  ASSERT_EQ(packet_sizes[1], 1u);
+}
+
+TEST(EmbedderPointerDataQueueTest, DrainsAreSpacedByTheFrameInterval) {
+  fml::Thread thread("queue");
+  auto task_runner = thread.GetTaskRunner();
+  const auto interval = fml::TimeDelta::FromMilliseconds(50);
+
+  std::vector<fml::TimePoint> drain_times;
+  fml::AutoResetWaitableEvent dispatched;
+  EmbedderPointerDataQueue queue(
+      task_runner, [interval]() { return interval; },
+      [&](std::unique_ptr<PointerDataPacket> packet) {
+        drain_times.push_back(fml::TimePoint::Now());
+        dispatched.Signal();
+      });
+
+  for (int i = 0; i < 2; i++) {
+    PointerData data = MakeMove(0, i);
+    queue.Enqueue(&data, 1);
+    dispatched.Wait();
+  }
+
+  // The second drain is scheduled a full interval after the first one started,
+  // which is slightly before the first dispatch was recorded.
+  ASSERT_EQ(drain_times.size(), 2u);
+  ASSERT_GE(drain_times[1] - drain_times[0],
+            interval - fml::TimeDelta::FromMilliseconds(5));
+}
+
+TEST(EmbedderPointerDataQueueTest, PendingDrainIsDroppedWithTheQueue) {
+  fml::Thread thread("queue");
+  auto task_runner = thread.GetTaskRunner();
+
+  bool dispatched = false;
+  fml::ManualResetWaitableEvent release;
+  task_runner->PostTask([&release]() { release.Wait(); });
+  {
+    EmbedderPointerDataQueue queue(
+        task_runner, []() { return fml::TimeDelta::FromMilliseconds(16); },
+        [&dispatched](std::unique_ptr<PointerDataPacket> packet) {
+          dispatched = true;
+        });
+    PointerData data = MakeMove(0, 0);
+    queue.Enqueue(&data, 1);
+  }
+  release.Signal();
+
+  fml::AutoResetWaitableEvent flushed;
+  task_runner->PostTask([&flushed]() { flushed.Signal(); });
+  flushed.Wait();
+  ASSERT_FALSE(dispatched);
+}
+
+}  // namespace testing
+}  // namespace flutter
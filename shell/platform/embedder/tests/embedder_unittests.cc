@@ -4,11 +4,14 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "embedder.h"
 #include "embedder_engine.h"
+#include "embedder_task_runner.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
@@ -196,6 +199,77 @@ TEST(EmbedderTestNoFixture, CanGetCurrentTimeInNanoseconds) {
   ASSERT_LT((point2 - point1), fml::TimeDelta::FromMilliseconds(1));
 }
 
+TEST(EmbedderTestNoFixture, BatchedTaskRunnerNotifiesOncePerWakeup) {
+  std::vector<std::pair<fml::TimePoint, size_t>> notifications;
+  EmbedderTaskRunner::DispatchTable table = {};
+  table.runs_task_on_current_thread_callback = []() { return true; };
+  table.post_tasks_callback = [&notifications](EmbedderTaskRunner*,
+                                               fml::TimePoint target_time,
+                                               size_t task_count) {
+    notifications.emplace_back(target_time, task_count);
+  };
+  auto task_runner = fml::MakeRefCounted<EmbedderTaskRunner>(table, 1u);
+  fml::TaskRunner* runner = task_runner.get();
+
+  std::vector<int> ran;
+  const auto now = fml::TimePoint::Now();
+  const auto later = now + fml::TimeDelta::FromSeconds(60);
+  runner->PostTaskForTime([&ran]() { ran.push_back(1); }, now);
+  runner->PostTaskForTime([&ran]() { ran.push_back(2); }, now);
+  runner->PostTaskForTime([&ran]() { ran.push_back(3); }, later);
+  // Only the first task moves the wakeup of the embedder.
+  ASSERT_EQ(notifications.size(), 1u);
+  EXPECT_EQ(notifications[0].first, now);
+  EXPECT_EQ(notifications[0].second, 1u);
+
+  ASSERT_TRUE(task_runner->RunExpiredTasks());
+  EXPECT_EQ(ran, std::vector<int>({1, 2}));
+  // The task that is not due yet is announced again.
+  ASSERT_EQ(notifications.size(), 2u);
+  EXPECT_EQ(notifications[1].first, later);
+  EXPECT_EQ(notifications[1].second, 1u);
+
+  // A task due earlier than the wakeup moves it.
+  runner->PostTask([&ran]() { ran.push_back(4); });
+  ASSERT_EQ(notifications.size(), 3u);
+  EXPECT_LT(notifications[2].first, later);
+  ASSERT_TRUE(task_runner->RunExpiredTasks());
+  EXPECT_EQ(ran, std::vector<int>({1, 2, 4}));
+}
+
+TEST(EmbedderTestNoFixture, BatchedTaskRunnerDefersTasksPostedWhileDraining) {
+  size_t notifications = 0;
+  EmbedderTaskRunner::DispatchTable table = {};
+  table.runs_task_on_current_thread_callback = []() { return true; };
+  table.post_tasks_callback = [&notifications](EmbedderTaskRunner*,
+                                               fml::TimePoint, size_t) {
+    notifications++;
+  };
+  auto task_runner = fml::MakeRefCounted<EmbedderTaskRunner>(table, 1u);
+  fml::RefPtr<fml::TaskRunner> runner = task_runner;
+
+  std::vector<int> ran;
+  runner->PostTask([&ran, runner]() {
+    ran.push_back(1);
+    runner->PostTask([&ran]() { ran.push_back(2); });
+    runner->PostTask([&ran]() { ran.push_back(3); });
+  });
+  ASSERT_EQ(notifications, 1u);
+
+  // The tasks posted by the first one wait for the next call, and the
+  // embedder is told about them once.
+  ASSERT_TRUE(task_runner->RunExpiredTasks());
+  EXPECT_EQ(ran, std::vector<int>({1}));
+  EXPECT_EQ(notifications, 2u);
+  ASSERT_TRUE(task_runner->RunExpiredTasks());
+  EXPECT_EQ(ran, std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(notifications, 2u);
+}
+
+TEST(EmbedderTestNoFixture, CannotRunTasksWithoutAnEngine) {
+  EXPECT_EQ(FlutterEngineRunTasks(nullptr, nullptr), kInvalidArguments);
+}
+
 TEST_F(EmbedderTest, CanReloadSystemFonts) {
   auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
   EmbedderConfigBuilder builder(context);
@@ -386,6 +460,171 @@ TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutResponseHandles) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that the messages of background channels are delivered off the
+/// platform thread.
+///
+TEST_F(EmbedderTest, PlatformMessagesOfBackgroundChannelsAreNotOnPlatform) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_background");
+
+  fml::AutoResetWaitableEvent ready, message_latch;
+  std::thread::id message_thread;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  builder.SetPlatformMessageCallback(
+      [&](const FlutterPlatformMessage* message) {
+        if (strcmp(message->channel, "test/background") == 0) {
+          message_thread = std::this_thread::get_id();
+          message_latch.Signal();
+        }
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ASSERT_EQ(FlutterEngineSetPlatformMessageChannelBackground(
+                engine.get(), "test/background", true),
+            kSuccess);
+  ready.Wait();
+
+  // The fixture echoes this message on the background channel.
+  const std::string message_data = "Hello from the background.";
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message =
+      reinterpret_cast<const uint8_t*>(message_data.data());
+  platform_message.message_size = message_data.size();
+  platform_message.response_handle = nullptr;
+  ASSERT_EQ(FlutterEngineSendPlatformMessage(engine.get(), &platform_message),
+            kSuccess);
+
+  message_latch.Wait();
+  ASSERT_NE(message_thread, std::this_thread::get_id());
+}
+
+TEST_F(EmbedderTest, RingBufferCanBeReadByIsolate) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("ring_buffer_can_be_read");
+
+  FlutterEngineDartPort port = 0;
+  fml::AutoResetWaitableEvent event;
+  context.AddNativeCallback("SignalNativeCount",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              port = tonic::DartConverter<int64_t>::FromDart(
+                                  Dart_GetNativeArgument(args, 0));
+                              event.Signal();
+                            }));
+  std::string received;
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        received = tonic::DartConverter<std::string>::FromDart(
+            Dart_GetNativeArgument(args, 0));
+        event.Signal();
+      }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  event.Wait();
+  ASSERT_NE(port, 0);
+
+  FlutterEngineRingBuffer ring_buffer = nullptr;
+  ASSERT_EQ(FlutterEngineCreateRingBuffer(engine.get(), port, 0, &ring_buffer),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineCreateRingBuffer(engine.get(), port, 8, &ring_buffer),
+            kSuccess);
+  ASSERT_NE(ring_buffer, nullptr);
+
+  auto write = [&](const std::string& text) {
+    bool written = false;
+    EXPECT_EQ(FlutterEngineRingBufferWrite(
+                  ring_buffer, reinterpret_cast<const uint8_t*>(text.data()),
+                  text.size(), &written),
+              kSuccess);
+    return written;
+  };
+
+  ASSERT_FALSE(write("Too large"));
+  ASSERT_TRUE(write("Hello"));
+  event.Wait();
+  ASSERT_EQ(received, "Hello");
+
+  // Wraps around the end of the data area.
+  ASSERT_TRUE(write("World!"));
+  event.Wait();
+  ASSERT_EQ(received, "World!");
+
+  ASSERT_EQ(FlutterEngineCollectRingBuffer(ring_buffer), kSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that the engine takes ownership of message buffers sent with a
+/// release callback and releases them once the application is done with them.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopies) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  // Large enough to be handed to Dart as external typed data.
+  const std::string message_data(4096, 'x');
+
+  fml::AutoResetWaitableEvent ready, message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  auto buffer =
+      new std::vector<uint8_t>(message_data.begin(), message_data.end());
+  static std::atomic_bool released;
+  released = false;
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message = buffer->data();
+  platform_message.message_size = buffer->size();
+  platform_message.response_handle = nullptr;
+  platform_message.message_release_callback = [](void* user_data) {
+    delete reinterpret_cast<std::vector<uint8_t>*>(user_data);
+    released = true;
+  };
+  platform_message.message_release_user_data = buffer;
+
+  auto result =
+      FlutterEngineSendPlatformMessage(engine.get(), &platform_message);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+
+  // The buffer is owned by the Dart heap until the isolate shuts down at the
+  // latest.
+  engine.reset();
+  ASSERT_TRUE(released);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a null platform message can be sent.
 ///
@@ -723,6 +962,47 @@ TEST_F(EmbedderTest, CanRunInitializedEngine) {
   engine.reset();
 }
 
+//------------------------------------------------------------------------------
+/// Test that the VM of an initialized engine can be prewarmed before it is run.
+///
+TEST_F(EmbedderTest, CanPrewarmDartVMOfInitializedEngine) {
+  EmbedderConfigBuilder builder(
+      GetEmbedderContext(ContextType::kSoftwareContext));
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.InitializeEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ASSERT_EQ(FlutterEnginePrewarmDartVM(engine.get()), kSuccess);
+  ASSERT_EQ(FlutterEngineRunInitialized(engine.get()), kSuccess);
+  // The VM of a running engine can not be prewarmed.
+  ASSERT_EQ(FlutterEnginePrewarmDartVM(engine.get()), kInvalidArguments);
+  engine.reset();
+}
+
+//------------------------------------------------------------------------------
+/// Test that the frame histograms of a running engine can be queried.
+///
+TEST_F(EmbedderTest, CanGetFrameHistogramOfRunningEngine) {
+  EmbedderConfigBuilder builder(
+      GetEmbedderContext(ContextType::kSoftwareContext));
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterFrameHistogram histogram = {};
+  histogram.struct_size = sizeof(FlutterFrameHistogram);
+  ASSERT_EQ(FlutterEngineGetFrameHistogram(engine.get(),
+                                           kFlutterFramePhaseBuild, &histogram),
+            kSuccess);
+  // No frame was rendered yet.
+  ASSERT_EQ(histogram.count, 0u);
+
+  histogram.struct_size = 0;
+  ASSERT_EQ(FlutterEngineGetFrameHistogram(engine.get(),
+                                           kFlutterFramePhaseBuild, &histogram),
+            kInvalidArguments);
+  engine.reset();
+}
+
 //------------------------------------------------------------------------------
 /// Test that an engine can be deinitialized.
 ///
@@ -960,6 +1240,112 @@ TEST_F(EmbedderTest, VerifyB143464703WithSoftwareBackend) {
                                   renderered_scene));
 }
 
+TEST_F(EmbedderTest, CompositorCanCoalesceOverlayLayers) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.GetCompositor().coalesce_overlay_layers = true;
+  builder.SetDartEntrypoint("can_coalesce_overlay_layers");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  fml::CountDownLatch latch(3);
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        // The contents above the first platform view don't intersect with
+        // it, so they are rendered into the root backing store.
+        ASSERT_EQ(layers_count, 4u);
+
+        // Layer 0 (Root)
+        {
+          FlutterBackingStore backing_store = *layers[0]->backing_store;
+          backing_store.type = kFlutterBackingStoreTypeSoftware;
+          backing_store.did_update = true;
+
+          FlutterLayer layer = {};
+          layer.struct_size = sizeof(layer);
+          layer.type = kFlutterLayerContentTypeBackingStore;
+          layer.backing_store = &backing_store;
+          layer.size = FlutterSizeMake(800.0, 600.0);
+          layer.offset = FlutterPointMake(0.0, 0.0);
+
+          ASSERT_EQ(*layers[0], layer);
+        }
+
+        // Layer 1
+        {
+          FlutterPlatformView platform_view = *layers[1]->platform_view;
+          platform_view.struct_size = sizeof(platform_view);
+          platform_view.identifier = 42;
+
+          FlutterLayer layer = {};
+          layer.struct_size = sizeof(layer);
+          layer.type = kFlutterLayerContentTypePlatformView;
+          layer.platform_view = &platform_view;
+          layer.size = FlutterSizeMake(100.0, 100.0);
+          layer.offset = FlutterPointMake(200.0, 200.0);
+
+          ASSERT_EQ(*layers[1], layer);
+        }
+
+        // Layer 2
+        {
+          FlutterPlatformView platform_view = *layers[2]->platform_view;
+          platform_view.struct_size = sizeof(platform_view);
+          platform_view.identifier = 24;
+
+          FlutterLayer layer = {};
+          layer.struct_size = sizeof(layer);
+          layer.type = kFlutterLayerContentTypePlatformView;
+          layer.platform_view = &platform_view;
+          layer.size = FlutterSizeMake(100.0, 100.0);
+          layer.offset = FlutterPointMake(0.0, 300.0);
+
+          ASSERT_EQ(*layers[2], layer);
+        }
+
+        // Layer 3
+        {
+          FlutterBackingStore backing_store = *layers[3]->backing_store;
+          backing_store.type = kFlutterBackingStoreTypeSoftware;
+          backing_store.did_update = true;
+
+          FlutterLayer layer = {};
+          layer.struct_size = sizeof(layer);
+          layer.type = kFlutterLayerContentTypeBackingStore;
+          layer.backing_store = &backing_store;
+          layer.size = FlutterSizeMake(800.0, 600.0);
+          layer.offset = FlutterPointMake(0.0, 0.0);
+
+          ASSERT_EQ(*layers[3], layer);
+        }
+
+        latch.CountDown();
+      });
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&latch](Dart_NativeArguments args) { latch.CountDown(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+}
+
 TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
 
@@ -978,6 +1364,95 @@ TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   ASSERT_EQ(FlutterEngineNotifyLowMemoryWarning(engine.get()), kSuccess);
 }
 
+TEST_F(EmbedderTest, CanNotifyMemoryPressureLevels) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  ASSERT_EQ(FlutterEngineNotifyMemoryPressure(engine.get(),
+                                              kFlutterMemoryPressureModerate),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineNotifyMemoryPressure(engine.get(),
+                                              kFlutterMemoryPressureCritical),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineNotifyMemoryPressure(
+                engine.get(), static_cast<FlutterMemoryPressureLevel>(42)),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, CanLaunchEngineWithThreadPrioritiesAndAffinity) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetProjectArgs().enable_thread_priorities = true;
+  builder.GetProjectArgs().enable_thread_cpu_affinity = true;
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+}
+
+TEST_F(EmbedderTest, CanLaunchEngineThreadsFromEmbedder) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  static std::mutex launched_names_mutex;
+  static std::vector<std::string> launched_names;
+  {
+    std::scoped_lock lock(launched_names_mutex);
+    launched_names.clear();
+  }
+  builder.GetProjectArgs().thread_launch_callback =
+      [](void* user_data, const FlutterThreadConfig* config,
+         FlutterThreadEntryCallback entry, void* entry_data) -> bool {
+    {
+      std::scoped_lock lock(launched_names_mutex);
+      launched_names.push_back(config->name);
+    }
+    // The workers of the Dart VM may outlive the test.
+    std::thread(entry, entry_data).detach();
+    return true;
+  };
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  engine.reset();
+
+  std::scoped_lock lock(launched_names_mutex);
+  // The UI, raster and IO threads.
+  ASSERT_GE(launched_names.size(), 3u);
+  for (const auto& name : launched_names) {
+    ASSERT_EQ(name.rfind("io.flutter", 0), 0u);
+  }
+}
+
+TEST_F(EmbedderTest, CanGetMemoryBreakdown) {
+  auto& context = GetEmbedderContext(ContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterEngineMemoryBreakdown breakdown = {};
+  ASSERT_EQ(FlutterEngineGetMemoryBreakdown(engine.get(), &breakdown),
+            kInvalidArguments);
+
+  breakdown.struct_size = sizeof(FlutterEngineMemoryBreakdown);
+  ASSERT_EQ(FlutterEngineGetMemoryBreakdown(engine.get(), &breakdown),
+            kSuccess);
+  ASSERT_GT(breakdown.dart_heap_used_bytes, 0);
+  ASSERT_GE(breakdown.dart_heap_capacity_bytes, breakdown.dart_heap_used_bytes);
+  ASSERT_EQ(breakdown.decoded_image_cache_bytes, 0u);
+}
+
 TEST_F(EmbedderTest, CanPostTaskToAllNativeThreads) {
   UniqueEngine engine;
   size_t worker_count = 0;
@@ -2950,6 +2950,43 @@ TEST_F(EmbedderTest, CompositorRenderTargetsAreRecycled) {
   ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 10u);
 }
 
+TEST_F(EmbedderTest, CompositorRenderTargetsAreRecycledAcrossPlatformViews) {
+  auto& context = GetEmbedderContext(ContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint(
+      "render_targets_are_recycled_across_platform_views");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::CountDownLatch latch(1);
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              latch.CountDown();
+                            }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  // The render target of the platform view that scrolled out is given to
+  // the one that scrolled in, instead of asking for a new one every frame.
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCreatedCount(), 10u);
+  engine.reset();
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 10u);
+}
+
 TEST_F(EmbedderTest, CompositorRenderTargetsAreInStableOrder) {
   auto& context = GetEmbedderContext(ContextType::kOpenGLContext);
 
@@ -3352,5 +3389,35 @@ TEST_F(EmbedderTest, MultipleDisplaysWithSameDisplayIdIsInvalid) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanRegisterDmaBufTexturesWithFrameCallback) {
+  auto& context = GetEmbedderContext(ContextType::kOpenGLContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(1, 1));
+  builder.SetOpenGLDmaBufTextureFrameCallBack();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+#if OS_LINUX
+  ASSERT_EQ(FlutterEngineRegisterExternalDmaBufTexture(engine.get(), 1),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineMarkExternalTextureFrameAvailable(engine.get(), 1),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineUnregisterExternalTexture(engine.get(), 1), kSuccess);
+#else
+  ASSERT_EQ(FlutterEngineRegisterExternalDmaBufTexture(engine.get(), 1),
+            kInvalidArguments);
+#endif  // OS_LINUX
+}
+
+TEST_F(EmbedderTest, CannotRegisterDmaBufTexturesWithoutFrameCallback) {
+  auto& context = GetEmbedderContext(ContextType::kOpenGLContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(1, 1));
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ASSERT_EQ(FlutterEngineRegisterExternalDmaBufTexture(engine.get(), 1),
+            kInvalidArguments);
+}
+
 }  // namespace testing
 }  // namespace flutter
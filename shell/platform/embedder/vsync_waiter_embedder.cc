@@ -6,9 +6,13 @@
 
 namespace flutter {
 
-VsyncWaiterEmbedder::VsyncWaiterEmbedder(const VsyncCallback& vsync_callback,
-                                         flutter::TaskRunners task_runners)
-    : VsyncWaiter(std::move(task_runners)), vsync_callback_(vsync_callback) {
+VsyncWaiterEmbedder::VsyncWaiterEmbedder(
+    const VsyncCallback& vsync_callback,
+    flutter::TaskRunners task_runners,
+    const PreferredFrameRateCallback& preferred_frame_rate_callback)
+    : VsyncWaiter(std::move(task_runners)),
+      vsync_callback_(vsync_callback),
+      preferred_frame_rate_callback_(preferred_frame_rate_callback) {
   FML_DCHECK(vsync_callback_);
 }
 
@@ -20,6 +24,14 @@ void VsyncWaiterEmbedder::AwaitVSync() {
   vsync_callback_(reinterpret_cast<intptr_t>(weak_waiter));
 }
 
+// |VsyncWaiter|
+void VsyncWaiterEmbedder::OnPreferredFrameRateChanged(
+    double frames_per_second) {
+  if (preferred_frame_rate_callback_) {
+    preferred_frame_rate_callback_(frames_per_second);
+  }
+}
+
 // static
 bool VsyncWaiterEmbedder::OnEmbedderVsync(intptr_t baton,
                                           fml::TimePoint frame_start_time,
@@ -13,9 +13,13 @@ namespace flutter {
 class VsyncWaiterEmbedder final : public VsyncWaiter {
  public:
   using VsyncCallback = std::function<void(intptr_t)>;
+  using PreferredFrameRateCallback = std::function<void(double)>;
 
-  VsyncWaiterEmbedder(const VsyncCallback& callback,
-                      flutter::TaskRunners task_runners);
+  VsyncWaiterEmbedder(
+      const VsyncCallback& callback,
+      flutter::TaskRunners task_runners,
+      const PreferredFrameRateCallback& preferred_frame_rate_callback =
+          nullptr);
 
   ~VsyncWaiterEmbedder() override;
 
@@ -25,10 +29,14 @@ class VsyncWaiterEmbedder final : public VsyncWaiter {
 
  private:
   const VsyncCallback vsync_callback_;
+  const PreferredFrameRateCallback preferred_frame_rate_callback_;
 
   // |VsyncWaiter|
   void AwaitVSync() override;
 
+  // |VsyncWaiter|
+  void OnPreferredFrameRateChanged(double frames_per_second) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterEmbedder);
 };
 
@@ -71,6 +71,15 @@ class MockPlatformViewDelegate : public flutter::PlatformView::Delegate {
     metrics_ = metrics;
   }
   // |flutter::PlatformView::Delegate|
+  void OnPlatformViewAddView(int64_t view_id,
+                             std::unique_ptr<flutter::Surface> surface,
+                             const flutter::ViewportMetrics& metrics) {}
+  // |flutter::PlatformView::Delegate|
+  void OnPlatformViewRemoveView(int64_t view_id) {}
+  // |flutter::PlatformView::Delegate|
+  void OnPlatformViewSetViewMetrics(int64_t view_id,
+                                    const flutter::ViewportMetrics& metrics) {}
+  // |flutter::PlatformView::Delegate|
   void OnPlatformViewDispatchPlatformMessage(
       fml::RefPtr<flutter::PlatformMessage> message) {
     message_ = std::move(message);
@@ -702,8 +711,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  auto data = delegate.message()->data();
-  auto call = std::string(data.begin(), data.end());
+  const fml::Mapping* data = &delegate.message()->data();
+  auto call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                          data->GetSize());
   std::string expected = "{\"method\":\"View.viewConnected\",\"args\":null}";
   EXPECT_EQ(expected, call);
 
@@ -717,8 +727,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  data = delegate.message()->data();
-  call = std::string(data.begin(), data.end());
+  data = &delegate.message()->data();
+  call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                     data->GetSize());
   expected = "{\"method\":\"View.viewDisconnected\",\"args\":null}";
   EXPECT_EQ(expected, call);
 
@@ -736,8 +747,9 @@ TEST_F(PlatformViewTests, ViewEventsTest) {
   session_listener->OnScenicEvent(std::move(events));
   RunLoopUntilIdle();
 
-  data = delegate.message()->data();
-  call = std::string(data.begin(), data.end());
+  data = &delegate.message()->data();
+  call = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                     data->GetSize());
   expected = "{\"method\":\"View.viewStateChanged\",\"args\":{\"state\":true}}";
   EXPECT_EQ(expected, call);
 }
@@ -165,7 +165,7 @@ void SessionConnection::PresentSession() {
       VsyncRecorder::GetInstance().GetCurrentVsyncInfo().presentation_interval;
 
   fml::TimePoint next_latch_point = CalculateNextLatchPoint(
-      fml::TimePoint::Now(), present_requested_time_,
+      present_requested_time_, fml::TimePoint::Now(),
       last_latch_point_targeted_,
       fml::TimeDelta::FromMicroseconds(0),  // flutter_frame_build_time
       presentation_interval, future_presentation_infos_);
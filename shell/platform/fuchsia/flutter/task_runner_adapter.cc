@@ -36,6 +36,19 @@ class CompatTaskRunner : public fml::TaskRunner {
                            zx::duration(delay.ToNanoseconds()));
   }
 
+  // The async loop has no notion of priorities.
+  void PostTaskWithPriority(const fml::closure& task,
+                            fml::TaskPriority priority) override {
+    PostTask(task);
+  }
+
+  void PostTaskForTimeWithPriority(const fml::closure& task,
+                                   fml::TimePoint target_time,
+                                   fml::TaskPriority priority,
+                                   fml::TimePoint deadline) override {
+    PostTaskForTime(task, target_time);
+  }
+
   bool RunsTasksOnCurrentThread() override {
     return forwarding_target_ == async_get_default_dispatcher();
   }
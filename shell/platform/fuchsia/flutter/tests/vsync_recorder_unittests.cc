@@ -131,4 +131,40 @@ TEST(VsyncRecorderTest, FramePresentedInfo_IsUpdatedCorrectly) {
       fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(time3)));
 }
 
+TEST(VsyncRecorderTest, PresentationInterval_IsDerivedFromPredictions) {
+  // Predictions for a 120hz display.
+  const int64_t interval = 8333333;
+  const int64_t start = 1000000000;
+  std::vector<fuchsia::scenic::scheduling::PresentationInfo>
+      future_presentations = {};
+  for (int64_t i = 0; i < 4; ++i) {
+    future_presentations.push_back(
+        CreatePresentationInfo(/*latch_point=*/start + i * interval - 1000,
+                               /*presentation_time=*/start + i * interval));
+  }
+  VsyncRecorder::GetInstance().UpdateNextPresentationInfo(
+      {.future_presentations = std::move(future_presentations),
+       .remaining_presents_in_flight_allowed = 1});
+
+  VsyncInfo vsync_info = VsyncRecorder::GetInstance().GetCurrentVsyncInfo();
+  EXPECT_EQ(vsync_info.presentation_interval,
+            fml::TimeDelta::FromNanoseconds(interval));
+
+  // Implausibly spaced predictions do not change the interval.
+  future_presentations.clear();
+  future_presentations.push_back(CreatePresentationInfo(
+      /*latch_point=*/start + 10 * interval,
+      /*presentation_time=*/start + 10 * interval + 10));
+  future_presentations.push_back(CreatePresentationInfo(
+      /*latch_point=*/start + 10 * interval + 10,
+      /*presentation_time=*/start + 10 * interval + 20));
+  VsyncRecorder::GetInstance().UpdateNextPresentationInfo(
+      {.future_presentations = std::move(future_presentations),
+       .remaining_presents_in_flight_allowed = 1});
+
+  vsync_info = VsyncRecorder::GetInstance().GetCurrentVsyncInfo();
+  EXPECT_EQ(vsync_info.presentation_interval,
+            fml::TimeDelta::FromNanoseconds(interval));
+}
+
 }  // namespace flutter_runner_test
@@ -17,8 +17,21 @@ std::mutex g_mutex;
 static constexpr fml::TimeDelta kDefaultPresentationInterval =
     fml::TimeDelta::FromSecondsF(1.0 / 60.0);
 
+// Intervals derived from Scenic's predictions outside of this range, from
+// 240hz to 10hz, are ignored. They come from predictions that are too sparse
+// or too noisy to tell the refresh rate from.
+static constexpr fml::TimeDelta kMinPresentationInterval =
+    fml::TimeDelta::FromSecondsF(1.0 / 240.0);
+static constexpr fml::TimeDelta kMaxPresentationInterval =
+    fml::TimeDelta::FromSecondsF(1.0 / 10.0);
+
 }  // namespace
 
+VsyncRecorder::VsyncRecorder()
+    : presentation_interval_(kDefaultPresentationInterval) {
+  next_presentation_info_.set_presentation_time(0);
+}
+
 VsyncRecorder& VsyncRecorder::GetInstance() {
   static VsyncRecorder vsync_recorder;
   return vsync_recorder;
@@ -29,7 +42,7 @@ VsyncInfo VsyncRecorder::GetCurrentVsyncInfo() const {
     std::unique_lock<std::mutex> lock(g_mutex);
     return {fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(
                 next_presentation_info_.presentation_time())),
-            kDefaultPresentationInterval};
+            presentation_interval_};
   }
 }
 
@@ -37,6 +50,20 @@ void VsyncRecorder::UpdateNextPresentationInfo(
     fuchsia::scenic::scheduling::FuturePresentationTimes info) {
   std::unique_lock<std::mutex> lock(g_mutex);
 
+  // Scenic predicts one presentation per vsync, so the average spacing of the
+  // predictions is the presentation interval.
+  const auto& future_presentations = info.future_presentations;
+  if (future_presentations.size() >= 2) {
+    const int64_t span = future_presentations.back().presentation_time() -
+                         future_presentations.front().presentation_time();
+    const fml::TimeDelta interval = fml::TimeDelta::FromNanoseconds(
+        span / static_cast<int64_t>(future_presentations.size() - 1));
+    if (interval >= kMinPresentationInterval &&
+        interval <= kMaxPresentationInterval) {
+      presentation_interval_ = interval;
+    }
+  }
+
   auto next_time = next_presentation_info_.presentation_time();
   // Get the earliest vsync time that is after our recorded |presentation_time|.
   for (auto& presentation_info : info.future_presentations) {
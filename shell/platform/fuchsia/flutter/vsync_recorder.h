@@ -22,7 +22,8 @@ class VsyncRecorder {
  public:
   static VsyncRecorder& GetInstance();
 
-  // Retrieve the most recent |PresentationInfo| provided to us by scenic.
+  // Retrieve the most recent |PresentationInfo| provided to us by scenic,
+  // along with the presentation interval Scenic predicts.
   // This function is safe to call from any thread.
   VsyncInfo GetCurrentVsyncInfo() const;
 
@@ -30,8 +31,10 @@ class VsyncRecorder {
   // to be called in |scenic::Session::Present2| immedaite callbacks with the
   // presentation info provided by Scenic.  Only the next vsync
   // information will be saved (in order to handle edge cases involving
-  // multiple Scenic sessions in the same process).  This function is safe to
-  // call from any thread.
+  // multiple Scenic sessions in the same process).  The presentation interval
+  // is derived from the spacing of the predicted presentation times, so that
+  // frames are paced to the actual refresh rate of the display.  This function
+  // is safe to call from any thread.
   void UpdateNextPresentationInfo(
       fuchsia::scenic::scheduling::FuturePresentationTimes info);
 
@@ -40,9 +43,10 @@ class VsyncRecorder {
   fml::TimePoint GetLastPresentationTime() const;
 
  private:
-  VsyncRecorder() { next_presentation_info_.set_presentation_time(0); }
+  VsyncRecorder();
 
   fuchsia::scenic::scheduling::PresentationInfo next_presentation_info_;
+  fml::TimeDelta presentation_interval_;
   fml::TimePoint last_presentation_time_ = fml::TimePoint::Now();
 
   // Disallow copy and assignment.
@@ -41,6 +41,10 @@ const int kFlutterDesktopDontCare = GLFW_DONT_CARE;
 
 static constexpr double kDpPerInch = 160.0;
 
+// The number of invisible windows created in addition to the resource window
+// so that the engine can upload resources from several background threads.
+static constexpr size_t kPooledResourceWindowCount = 2;
+
 // Struct for storing state within an instance of the GLFW Window.
 struct FlutterDesktopWindowControllerState {
   // The GLFW window that is bound to this state object.
@@ -50,6 +54,9 @@ struct FlutterDesktopWindowControllerState {
   UniqueGLFWwindowPtr resource_window =
       UniqueGLFWwindowPtr(nullptr, glfwDestroyWindow);
 
+  // Additional invisible GLFW windows used to upload resources in parallel.
+  std::vector<UniqueGLFWwindowPtr> pooled_resource_windows;
+
   // The state associated with the engine.
   std::unique_ptr<FlutterDesktopEngineState> engine;
 
@@ -509,6 +516,21 @@ static bool EngineMakeResourceContextCurrent(void* user_data) {
   return true;
 }
 
+static bool EngineMakePooledResourceContextCurrent(void* user_data,
+                                                  size_t index) {
+  FlutterDesktopEngineState* engine_state =
+      static_cast<FlutterDesktopEngineState*>(user_data);
+  FlutterDesktopWindowControllerState* window_controller =
+      engine_state->window_controller;
+  if (!window_controller ||
+      index >= window_controller->pooled_resource_windows.size()) {
+    return false;
+  }
+  glfwMakeContextCurrent(
+      window_controller->pooled_resource_windows[index].get());
+  return true;
+}
+
 static bool EngineClearContext(void* user_data) {
   FlutterDesktopEngineState* engine_state =
       static_cast<FlutterDesktopEngineState*>(user_data);
@@ -659,6 +681,10 @@ static bool RunFlutterEngine(
   // work even if GLFW initialization failed.
   if (engine_state->window_controller != nullptr) {
     config.open_gl.gl_proc_resolver = EngineProcResolver;
+    config.open_gl.pooled_resource_context_count =
+        engine_state->window_controller->pooled_resource_windows.size();
+    config.open_gl.make_pooled_resource_current =
+        EngineMakePooledResourceContextCurrent;
   }
   FlutterProjectArgs args = {};
   args.struct_size = sizeof(FlutterProjectArgs);
@@ -752,6 +778,13 @@ FlutterDesktopWindowControllerRef FlutterDesktopCreateWindow(
   // Create the share window before starting the engine, since it may call
   // EngineMakeResourceContextCurrent immediately.
   state->resource_window = CreateShareWindowForWindow(window);
+  for (size_t i = 0; i < kPooledResourceWindowCount; i++) {
+    UniqueGLFWwindowPtr share_window = CreateShareWindowForWindow(window);
+    if (!share_window) {
+      break;
+    }
+    state->pooled_resource_windows.push_back(std::move(share_window));
+  }
 
   state->engine = std::make_unique<FlutterDesktopEngineState>();
   state->engine->window_controller = state.get();
@@ -255,6 +255,39 @@ static void fl_engine_post_task(FlutterTask task,
   g_source_attach(source, nullptr);
 }
 
+// A request for a vsync made by the engine.
+typedef struct {
+  FlEngine* engine;
+  intptr_t baton;
+} VsyncRequest;
+
+// Called by the renderer on the GTK thread after the next vsync.
+static void fl_engine_vsync_ready_cb(uint64_t frame_start_time_nanos,
+                                     uint64_t frame_target_time_nanos,
+                                     gpointer user_data) {
+  VsyncRequest* request = static_cast<VsyncRequest*>(user_data);
+  FlEngine* self = request->engine;
+
+  if (self->engine != nullptr) {
+    self->embedder_api.OnVsync(self->engine, request->baton,
+                               frame_start_time_nanos, frame_target_time_nanos);
+  }
+
+  g_object_unref(request->engine);
+  g_free(request);
+}
+
+// Called by the engine on the UI thread when it waits for the next vsync.
+static void fl_engine_vsync_cb(void* user_data, intptr_t baton) {
+  FlEngine* self = static_cast<FlEngine*>(user_data);
+
+  VsyncRequest* request = g_new(VsyncRequest, 1);
+  request->engine = FL_ENGINE(g_object_ref(self));
+  request->baton = baton;
+  fl_renderer_wait_for_vsync(self->renderer, fl_engine_vsync_ready_cb,
+                             request);
+}
+
 // Called when a platform message is received from the engine.
 static void fl_engine_platform_message_cb(const FlutterPlatformMessage* message,
                                           void* user_data) {
@@ -403,6 +436,9 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
       dart_entrypoint_args != nullptr ? g_strv_length(dart_entrypoint_args) : 0;
   args.dart_entrypoint_argv =
       reinterpret_cast<const char* const*>(dart_entrypoint_args);
+  if (fl_renderer_supports_vsync(self->renderer)) {
+    args.vsync_callback = fl_engine_vsync_cb;
+  }
 
   if (self->embedder_api.RunsAOTCompiledDartCode()) {
     FlutterEngineAOTDataSource source = {};
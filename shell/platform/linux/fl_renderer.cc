@@ -209,6 +209,21 @@ void fl_renderer_set_geometry(FlRenderer* self,
   }
 }
 
+gboolean fl_renderer_supports_vsync(FlRenderer* self) {
+  g_return_val_if_fail(FL_IS_RENDERER(self), FALSE);
+
+  return FL_RENDERER_GET_CLASS(self)->wait_for_vsync != nullptr;
+}
+
+void fl_renderer_wait_for_vsync(FlRenderer* self,
+                                FlRendererVsyncCallback callback,
+                                gpointer user_data) {
+  g_return_if_fail(FL_IS_RENDERER(self));
+  g_return_if_fail(FL_RENDERER_GET_CLASS(self)->wait_for_vsync != nullptr);
+
+  FL_RENDERER_GET_CLASS(self)->wait_for_vsync(self, callback, user_data);
+}
+
 void* fl_renderer_get_proc_address(FlRenderer* self, const char* name) {
   return reinterpret_cast<void*>(eglGetProcAddress(name));
 }
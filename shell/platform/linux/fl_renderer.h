@@ -24,6 +24,19 @@ typedef enum {
 
 GQuark fl_renderer_error_quark(void) G_GNUC_CONST;
 
+/**
+ * FlRendererVsyncCallback:
+ * @frame_start_time_nanos: the time the frame should start, in the time base
+ * of the engine.
+ * @frame_target_time_nanos: the time the frame should be presented by.
+ * @user_data: user data passed to fl_renderer_wait_for_vsync().
+ *
+ * Function called on the GTK main thread after the next vsync.
+ */
+typedef void (*FlRendererVsyncCallback)(uint64_t frame_start_time_nanos,
+                                        uint64_t frame_target_time_nanos,
+                                        gpointer user_data);
+
 G_DECLARE_DERIVABLE_TYPE(FlRenderer, fl_renderer, FL, RENDERER, GObject)
 
 /**
@@ -90,6 +103,19 @@ struct _FlRendererClass {
   void (*set_geometry)(FlRenderer* renderer,
                        GdkRectangle* geometry,
                        gint scale);
+
+  /**
+   * Virtual method called when Flutter waits for the next vsync. May be
+   * called on any thread.
+   * Does not need to be implemented, in which case Flutter paces frames on a
+   * timer.
+   * @renderer: an #FlRenderer.
+   * @callback: function to call on the GTK main thread after the next vsync.
+   * @user_data: user data to pass to @callback.
+   */
+  void (*wait_for_vsync)(FlRenderer* renderer,
+                         FlRendererVsyncCallback callback,
+                         gpointer user_data);
 };
 
 /**
@@ -117,6 +143,28 @@ void fl_renderer_set_geometry(FlRenderer* renderer,
                               GdkRectangle* geometry,
                               gint scale);
 
+/**
+ * fl_renderer_supports_vsync:
+ * @renderer: an #FlRenderer.
+ *
+ * Checks if the renderer can notify Flutter of the vsyncs of the display.
+ *
+ * Returns: %TRUE if fl_renderer_wait_for_vsync() can be used.
+ */
+gboolean fl_renderer_supports_vsync(FlRenderer* renderer);
+
+/**
+ * fl_renderer_wait_for_vsync:
+ * @renderer: an #FlRenderer.
+ * @callback: function to call on the GTK main thread after the next vsync.
+ * @user_data: user data to pass to @callback.
+ *
+ * Waits for the next vsync of the display. May be called on any thread.
+ */
+void fl_renderer_wait_for_vsync(FlRenderer* renderer,
+                                FlRendererVsyncCallback callback,
+                                gpointer user_data);
+
 /**
  * fl_renderer_get_proc_address:
  * @renderer: an #FlRenderer.
@@ -11,6 +11,21 @@
 #include <wayland-egl-core.h>
 #include <cstring>
 
+// Refresh period assumed until the monitor of the window is known.
+static constexpr gint64 kDefaultRefreshPeriodNanos = 16666667;
+
+// Time after which waiters are notified if the compositor does not call the
+// frame callback, which it may not do while the surface is not visible.
+static constexpr guint kFrameCallbackTimeoutMilliseconds = 100;
+
+static constexpr gint64 kNanosecondsPerMicrosecond = 1000;
+
+// A request for the next vsync made with fl_renderer_wait_for_vsync().
+typedef struct {
+  FlRendererVsyncCallback callback;
+  gpointer user_data;
+} VsyncWaiter;
+
 struct _FlRendererWayland {
   FlRenderer parent_instance;
   wl_registry* registry;
@@ -30,6 +45,18 @@ struct _FlRendererWayland {
     wl_surface* surface;
     wl_egl_window* egl_window;
   } resource;
+
+  // State of the frame callbacks used to wait for vsync. Waiters are added
+  // from the Flutter UI thread and notified on the GTK main thread, so all
+  // fields are protected by the mutex.
+  struct {
+    GMutex mutex;
+    wl_callback* callback;
+    guint timeout_source_id;
+    // Pending #VsyncWaiter requests.
+    GSList* waiters;
+    gint64 refresh_period_nanos;
+  } vsync;
 };
 
 G_DEFINE_TYPE(FlRendererWayland, fl_renderer_wayland, fl_renderer_get_type())
@@ -76,10 +103,92 @@ static void fl_renderer_wayland_lazy_init_wl(FlRendererWayland* self) {
   wl_display_roundtrip(display);
 }
 
+// Notifies all pending waiters that a frame can start now. Called on the GTK
+// main thread.
+static void fl_renderer_wayland_notify_vsync_waiters(FlRendererWayland* self) {
+  g_mutex_lock(&self->vsync.mutex);
+  g_clear_pointer(&self->vsync.callback, wl_callback_destroy);
+  if (self->vsync.timeout_source_id != 0) {
+    g_source_remove(self->vsync.timeout_source_id);
+    self->vsync.timeout_source_id = 0;
+  }
+  GSList* waiters = g_slist_reverse(self->vsync.waiters);
+  self->vsync.waiters = nullptr;
+  gint64 refresh_period_nanos = self->vsync.refresh_period_nanos;
+  g_mutex_unlock(&self->vsync.mutex);
+
+  // The time of the frame callback is in milliseconds with an undefined base,
+  // so use the monotonic clock the engine measures time with instead.
+  uint64_t frame_start_time_nanos =
+      g_get_monotonic_time() * kNanosecondsPerMicrosecond;
+  uint64_t frame_target_time_nanos =
+      frame_start_time_nanos + refresh_period_nanos;
+  for (GSList* link = waiters; link != nullptr; link = link->next) {
+    VsyncWaiter* waiter = static_cast<VsyncWaiter*>(link->data);
+    waiter->callback(frame_start_time_nanos, frame_target_time_nanos,
+                     waiter->user_data);
+  }
+  g_slist_free_full(waiters, g_free);
+}
+
+// wl_callback.done callback for the frame callback of the subsurface.
+static void frame_callback_handle_done(void* data,
+                                       wl_callback* callback,
+                                       uint32_t time) {
+  fl_renderer_wayland_notify_vsync_waiters(FL_RENDERER_WAYLAND(data));
+}
+
+static const wl_callback_listener frame_callback_listener = {
+    .done = frame_callback_handle_done,
+};
+
+// Called when the compositor did not call the frame callback in time.
+static gboolean frame_callback_timeout_cb(gpointer user_data) {
+  FlRendererWayland* self = FL_RENDERER_WAYLAND(user_data);
+
+  g_mutex_lock(&self->vsync.mutex);
+  self->vsync.timeout_source_id = 0;
+  g_mutex_unlock(&self->vsync.mutex);
+
+  fl_renderer_wayland_notify_vsync_waiters(self);
+
+  return G_SOURCE_REMOVE;
+}
+
+// Requests a frame callback for the subsurface if none is pending. Called on
+// the GTK main thread.
+static gboolean request_frame_callback_cb(gpointer user_data) {
+  FlRendererWayland* self = FL_RENDERER_WAYLAND(user_data);
+
+  g_mutex_lock(&self->vsync.mutex);
+  gboolean has_waiters = self->vsync.waiters != nullptr;
+  gboolean has_request =
+      self->vsync.callback != nullptr || self->vsync.timeout_source_id != 0;
+  if (has_waiters && !has_request && self->subsurface.subsurface) {
+    self->vsync.callback = wl_surface_frame(self->subsurface.surface);
+    wl_callback_add_listener(self->vsync.callback, &frame_callback_listener,
+                             self);
+    wl_surface_commit(self->subsurface.surface);
+    wl_display_flush(gdk_wayland_display_get_wl_display(
+        GDK_WAYLAND_DISPLAY(gdk_display_get_default())));
+  }
+  if (has_waiters && !has_request) {
+    self->vsync.timeout_source_id =
+        g_timeout_add(kFrameCallbackTimeoutMilliseconds,
+                      frame_callback_timeout_cb, self);
+  }
+  g_mutex_unlock(&self->vsync.mutex);
+
+  return G_SOURCE_REMOVE;
+}
+
 // Implements GObject::dispose.
 static void fl_renderer_wayland_dispose(GObject* object) {
   FlRendererWayland* self = FL_RENDERER_WAYLAND(object);
 
+  // Don't leave waiters without an answer.
+  fl_renderer_wayland_notify_vsync_waiters(self);
+
   g_clear_pointer(&self->registry, wl_registry_destroy);
   g_clear_pointer(&self->subcompositor, wl_subcompositor_destroy);
 
@@ -93,6 +202,15 @@ static void fl_renderer_wayland_dispose(GObject* object) {
   G_OBJECT_CLASS(fl_renderer_wayland_parent_class)->dispose(object);
 }
 
+// Implements GObject::finalize.
+static void fl_renderer_wayland_finalize(GObject* object) {
+  FlRendererWayland* self = FL_RENDERER_WAYLAND(object);
+
+  g_mutex_clear(&self->vsync.mutex);
+
+  G_OBJECT_CLASS(fl_renderer_wayland_parent_class)->finalize(object);
+}
+
 // Implements FlRenderer::create_display.
 static EGLDisplay fl_renderer_wayland_create_display(FlRenderer* /*renderer*/) {
   GdkWaylandDisplay* gdk_display =
@@ -151,6 +269,19 @@ static void fl_renderer_wayland_on_window_map(FlRendererWayland* self,
   wl_region_destroy(region);
 
   wl_surface_commit(self->subsurface.surface);
+
+  // Pace frames to the refresh rate of the monitor showing the window.
+  GdkMonitor* monitor = gdk_display_get_monitor_at_window(
+      GDK_DISPLAY(gdk_display), GDK_WINDOW(window));
+  gint refresh_rate =
+      monitor != nullptr ? gdk_monitor_get_refresh_rate(monitor) : 0;
+  if (refresh_rate > 0) {
+    g_mutex_lock(&self->vsync.mutex);
+    // The refresh rate is in millihertz.
+    self->vsync.refresh_period_nanos =
+        G_GINT64_CONSTANT(1000000000000) / refresh_rate;
+    g_mutex_unlock(&self->vsync.mutex);
+  }
 }
 
 static void fl_renderer_wayland_on_window_unmap(FlRendererWayland* self,
@@ -281,15 +412,40 @@ static void fl_renderer_wayland_set_geometry(FlRenderer* renderer,
   self->subsurface.scale = scale;
 }
 
+// Implements FlRenderer::wait_for_vsync.
+static void fl_renderer_wayland_wait_for_vsync(FlRenderer* renderer,
+                                               FlRendererVsyncCallback callback,
+                                               gpointer user_data) {
+  FlRendererWayland* self = FL_RENDERER_WAYLAND(renderer);
+
+  VsyncWaiter* waiter = g_new(VsyncWaiter, 1);
+  waiter->callback = callback;
+  waiter->user_data = user_data;
+
+  g_mutex_lock(&self->vsync.mutex);
+  self->vsync.waiters = g_slist_prepend(self->vsync.waiters, waiter);
+  g_mutex_unlock(&self->vsync.mutex);
+
+  // Wayland objects are only used on the GTK main thread.
+  g_main_context_invoke_full(nullptr, G_PRIORITY_HIGH,
+                             request_frame_callback_cb, g_object_ref(self),
+                             g_object_unref);
+}
+
 static void fl_renderer_wayland_class_init(FlRendererWaylandClass* klass) {
   G_OBJECT_CLASS(klass)->dispose = fl_renderer_wayland_dispose;
+  G_OBJECT_CLASS(klass)->finalize = fl_renderer_wayland_finalize;
   FL_RENDERER_CLASS(klass)->create_display = fl_renderer_wayland_create_display;
   FL_RENDERER_CLASS(klass)->create_surfaces =
       fl_renderer_wayland_create_surfaces;
   FL_RENDERER_CLASS(klass)->set_geometry = fl_renderer_wayland_set_geometry;
+  FL_RENDERER_CLASS(klass)->wait_for_vsync = fl_renderer_wayland_wait_for_vsync;
 }
 
-static void fl_renderer_wayland_init(FlRendererWayland* self) {}
+static void fl_renderer_wayland_init(FlRendererWayland* self) {
+  g_mutex_init(&self->vsync.mutex);
+  self->vsync.refresh_period_nanos = kDefaultRefreshPeriodNanos;
+}
 
 FlRendererWayland* fl_renderer_wayland_new() {
   return FL_RENDERER_WAYLAND(
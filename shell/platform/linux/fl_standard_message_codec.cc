@@ -27,6 +27,11 @@ static constexpr int kValueFloat64List = 11;
 static constexpr int kValueList = 12;
 static constexpr int kValueMap = 13;
 
+// Typed lists of at least this many bytes are decoded in place, referencing the
+// message instead of copying it. Smaller lists are copied so they don't keep
+// the whole message alive.
+static constexpr size_t kMinInPlaceListSize = 4096;
+
 struct _FlStandardMessageCodec {
   FlMessageCodec parent_instance;
 };
@@ -68,8 +73,10 @@ static void write_float64(GByteArray* buffer, double value) {
 
 // Write padding bytes to align to @align multiple of bytes.
 static void write_align(GByteArray* buffer, guint align) {
-  while (buffer->len % align != 0) {
-    write_uint8(buffer, 0);
+  static const uint8_t padding[8] = {};
+  g_return_if_fail(align <= sizeof(padding));
+  if (buffer->len % align != 0) {
+    g_byte_array_append(buffer, padding, align - buffer->len % align);
   }
 }
 
@@ -104,6 +111,17 @@ static gboolean read_align(GBytes* buffer,
   return TRUE;
 }
 
+// Gets @size bytes at @offset in @buffer. Large ranges reference @buffer,
+// smaller ones are copied.
+static GBytes* get_slice(GBytes* buffer, size_t offset, size_t size) {
+  if (size >= kMinInPlaceListSize) {
+    return g_bytes_new_from_bytes(buffer, offset, size);
+  }
+  return g_bytes_new(
+      static_cast<const uint8_t*>(g_bytes_get_data(buffer, nullptr)) + offset,
+      size);
+}
+
 // Gets a pointer to the given offset in @buffer.
 static const uint8_t* get_data(GBytes* buffer, size_t* offset) {
   return static_cast<const uint8_t*>(g_bytes_get_data(buffer, nullptr)) +
@@ -242,7 +260,8 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  g_autoptr(GBytes) data = get_slice(buffer, *offset, length);
+  FlValue* value = fl_value_new_uint8_list_from_bytes(data);
   *offset += length;
   return value;
 }
@@ -265,8 +284,8 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  g_autoptr(GBytes) data = get_slice(buffer, *offset, sizeof(int32_t) * length);
+  FlValue* value = fl_value_new_int32_list_from_bytes(data);
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -289,8 +308,8 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  g_autoptr(GBytes) data = get_slice(buffer, *offset, sizeof(int64_t) * length);
+  FlValue* value = fl_value_new_int64_list_from_bytes(data);
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -313,8 +332,8 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  g_autoptr(GBytes) data = get_slice(buffer, *offset, sizeof(double) * length);
+  FlValue* value = fl_value_new_float_list_from_bytes(data);
   *offset += sizeof(double) * length;
   return value;
 }
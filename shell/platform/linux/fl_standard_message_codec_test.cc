@@ -584,6 +584,37 @@ TEST(FlStandardMessageCodecTest, DecodeFloatListShortData2) {
       FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA);
 }
 
+TEST(FlStandardMessageCodecTest, DecodeLargeFloatListInPlace) {
+  constexpr size_t length = 10000;
+  g_autofree double* data = g_new(double, length);
+  for (size_t i = 0; i < length; i++) {
+    data[i] = i * 0.5;
+  }
+  g_autoptr(FlValue) list = fl_value_new_float_list(data, length);
+
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), list, &error);
+  ASSERT_NE(message, nullptr);
+  EXPECT_EQ(error, nullptr);
+  g_autoptr(FlValue) value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(error, nullptr);
+
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT_LIST);
+  ASSERT_EQ(fl_value_get_length(value), length);
+  EXPECT_TRUE(fl_value_equal(value, list));
+  // The elements are read from the message instead of a copy of it.
+  const uint8_t* message_data =
+      static_cast<const uint8_t*>(g_bytes_get_data(message, nullptr));
+  const uint8_t* values =
+      reinterpret_cast<const uint8_t*>(fl_value_get_float_list(value));
+  EXPECT_GE(values, message_data);
+  EXPECT_LT(values, message_data + g_bytes_get_size(message));
+}
+
 TEST(FlStandardMessageCodecTest, EncodeListEmpty) {
   g_autoptr(FlValue) value = fl_value_new_list();
   g_autofree gchar* hex_string = encode_message(value);
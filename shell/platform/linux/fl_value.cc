@@ -37,24 +37,32 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // If set, @values points into this and is not owned by the value.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  // If set, @values points into this and is not owned by the value.
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  // If set, @values points into this and is not owned by the value.
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // If set, @values points into this and is not owned by the value.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
@@ -75,6 +83,20 @@ static FlValue* fl_value_new(FlValueType type, size_t size) {
   return self;
 }
 
+// Gets the elements of @data for a typed list with elements of
+// @element_size bytes. Returns TRUE if the elements are aligned so they can be
+// used in place.
+static gboolean get_typed_data(GBytes* data,
+                               size_t element_size,
+                               gconstpointer* values,
+                               size_t* values_length) {
+  gsize size;
+  *values = g_bytes_get_data(data, &size);
+  *values_length = size / element_size;
+  return *values != nullptr &&
+         reinterpret_cast<uintptr_t>(*values) % element_size == 0;
+}
+
 // Helper function to match GDestroyNotify type.
 static void fl_value_destroy(gpointer value) {
   fl_value_unref(static_cast<FlValue*>(value));
@@ -271,10 +293,18 @@ G_MODULE_EXPORT FlValue* fl_value_new_uint8_list(const uint8_t* data,
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list_from_bytes(GBytes* data) {
-  gsize length;
-  const uint8_t* d =
-      static_cast<const uint8_t*>(g_bytes_get_data(data, &length));
-  return fl_value_new_uint8_list(d, length);
+  g_return_val_if_fail(data != nullptr, nullptr);
+  gconstpointer values;
+  size_t values_length;
+  if (!get_typed_data(data, sizeof(uint8_t), &values, &values_length)) {
+    return fl_value_new_uint8_list(nullptr, 0);
+  }
+  FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
+      fl_value_new(FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
+  self->values_length = values_length;
+  self->values = static_cast<uint8_t*>(const_cast<gpointer>(values));
+  self->bytes = g_bytes_ref(data);
+  return reinterpret_cast<FlValue*>(self);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
@@ -287,6 +317,23 @@ G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_int32_list_from_bytes(GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+  g_return_val_if_fail(g_bytes_get_size(data) % sizeof(int32_t) == 0, nullptr);
+  gconstpointer values;
+  size_t values_length;
+  if (!get_typed_data(data, sizeof(int32_t), &values, &values_length)) {
+    return fl_value_new_int32_list(static_cast<const int32_t*>(values),
+                                   values_length);
+  }
+  FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
+      fl_value_new(FL_VALUE_TYPE_INT32_LIST, sizeof(FlValueInt32List)));
+  self->values_length = values_length;
+  self->values = static_cast<int32_t*>(const_cast<gpointer>(values));
+  self->bytes = g_bytes_ref(data);
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
                                                  size_t data_length) {
   FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
@@ -297,6 +344,23 @@ G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_int64_list_from_bytes(GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+  g_return_val_if_fail(g_bytes_get_size(data) % sizeof(int64_t) == 0, nullptr);
+  gconstpointer values;
+  size_t values_length;
+  if (!get_typed_data(data, sizeof(int64_t), &values, &values_length)) {
+    return fl_value_new_int64_list(static_cast<const int64_t*>(values),
+                                   values_length);
+  }
+  FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
+      fl_value_new(FL_VALUE_TYPE_INT64_LIST, sizeof(FlValueInt64List)));
+  self->values_length = values_length;
+  self->values = static_cast<int64_t*>(const_cast<gpointer>(values));
+  self->bytes = g_bytes_ref(data);
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
                                                  size_t data_length) {
   FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
@@ -307,6 +371,23 @@ G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_float_list_from_bytes(GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+  g_return_val_if_fail(g_bytes_get_size(data) % sizeof(double) == 0, nullptr);
+  gconstpointer values;
+  size_t values_length;
+  if (!get_typed_data(data, sizeof(double), &values, &values_length)) {
+    return fl_value_new_float_list(static_cast<const double*>(values),
+                                   values_length);
+  }
+  FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
+      fl_value_new(FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
+  self->values_length = values_length;
+  self->values = static_cast<double*>(const_cast<gpointer>(values));
+  self->bytes = g_bytes_ref(data);
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
   FlValueList* self = reinterpret_cast<FlValueList*>(
       fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
@@ -354,22 +435,38 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      if (v->bytes != nullptr) {
+        g_bytes_unref(v->bytes);
+      } else {
+        g_free(v->values);
+      }
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -6,6 +6,8 @@
 
 #include <gmodule.h>
 
+#include <cstring>
+
 #include "gtest/gtest.h"
 
 TEST(FlDartProjectTest, Null) {
@@ -210,6 +212,16 @@ TEST(FlValueTest, Uint8List) {
   EXPECT_EQ(fl_value_get_uint8_list(value)[3], 0xFF);
 }
 
+TEST(FlValueTest, Uint8ListFromBytes) {
+  static const uint8_t data[] = {0x00, 0x01, 0xFE, 0xFF};
+  g_autoptr(GBytes) bytes = g_bytes_new_static(data, 4);
+  g_autoptr(FlValue) value = fl_value_new_uint8_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_UINT8_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(4));
+  EXPECT_EQ(fl_value_get_uint8_list(value), data);
+  EXPECT_EQ(fl_value_get_uint8_list(value)[3], 0xFF);
+}
+
 TEST(FlValueTest, Uint8ListNullptr) {
   g_autoptr(FlValue) value = fl_value_new_uint8_list(nullptr, 0);
   ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_UINT8_LIST);
@@ -392,6 +404,30 @@ TEST(FlValueTest, FloatList) {
   EXPECT_EQ(fl_value_get_float_list(value)[2], M_PI);
 }
 
+TEST(FlValueTest, FloatListFromBytes) {
+  static const double data[] = {0.0, -1.0, M_PI};
+  g_autoptr(GBytes) bytes = g_bytes_new_static(data, sizeof(data));
+  g_autoptr(FlValue) value = fl_value_new_float_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(3));
+  EXPECT_EQ(fl_value_get_float_list(value), data);
+  EXPECT_EQ(fl_value_get_float_list(value)[2], M_PI);
+}
+
+TEST(FlValueTest, FloatListFromUnalignedBytes) {
+  static const double data[] = {0.0, -1.0, M_PI, 0.0};
+  g_autoptr(GBytes) bytes = g_bytes_new_static(
+      reinterpret_cast<const uint8_t*>(data) + 1, sizeof(double) * 3);
+  g_autoptr(FlValue) value = fl_value_new_float_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(3));
+  EXPECT_NE(static_cast<const void*>(fl_value_get_float_list(value)),
+            g_bytes_get_data(bytes, nullptr));
+  EXPECT_EQ(memcmp(fl_value_get_float_list(value),
+                   g_bytes_get_data(bytes, nullptr), sizeof(double) * 3),
+            0);
+}
+
 TEST(FlValueTest, FloatListNullptr) {
   g_autoptr(FlValue) value = fl_value_new_float_list(nullptr, 0);
   ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT_LIST);
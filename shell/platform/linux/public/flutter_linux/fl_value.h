@@ -150,8 +150,9 @@ FlValue* fl_value_new_uint8_list(const uint8_t* value, size_t value_length);
  * fl_value_new_uint8_list_from_bytes:
  * @value: a #GBytes.
  *
- * Creates an ordered list containing 8 bit unsigned integers. The data is
- * copied. The equivalent Dart type is a Uint8List.
+ * Creates an ordered list containing 8 bit unsigned integers. The data is not
+ * copied, the list keeps a reference to @value. The equivalent Dart type is a
+ * Uint8List.
  *
  * Returns: a new #FlValue.
  */
@@ -169,6 +170,18 @@ FlValue* fl_value_new_uint8_list_from_bytes(GBytes* value);
  */
 FlValue* fl_value_new_int32_list(const int32_t* value, size_t value_length);
 
+/**
+ * fl_value_new_int32_list_from_bytes:
+ * @value: a #GBytes containing signed 32 bit integers.
+ *
+ * Creates an ordered list containing 32 bit integers. If the data is aligned
+ * for 32 bit integers it is not copied, the list keeps a reference to @value
+ * instead. The equivalent Dart type is a Int32List.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_int32_list_from_bytes(GBytes* value);
+
 /**
  * fl_value_new_int64_list:
  * @value: an array of signed 64 bit integers.
@@ -181,6 +194,18 @@ FlValue* fl_value_new_int32_list(const int32_t* value, size_t value_length);
  */
 FlValue* fl_value_new_int64_list(const int64_t* value, size_t value_length);
 
+/**
+ * fl_value_new_int64_list_from_bytes:
+ * @value: a #GBytes containing signed 64 bit integers.
+ *
+ * Creates an ordered list containing 64 bit integers. If the data is aligned
+ * for 64 bit integers it is not copied, the list keeps a reference to @value
+ * instead. The equivalent Dart type is a Int64List.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_int64_list_from_bytes(GBytes* value);
+
 /**
  * fl_value_new_float_list:
  * @value: an array of floating point numbers.
@@ -193,6 +218,20 @@ FlValue* fl_value_new_int64_list(const int64_t* value, size_t value_length);
  */
 FlValue* fl_value_new_float_list(const double* value, size_t value_length);
 
+/**
+ * fl_value_new_float_list_from_bytes:
+ * @value: a #GBytes containing floating point numbers.
+ *
+ * Creates an ordered list containing floating point numbers. If the data is
+ * aligned for floating point numbers it is not copied, the list keeps a
+ * reference to @value instead. This allows large lists, e.g. sensor samples, to
+ * be sent from memory wrapped with g_bytes_new_static() or
+ * g_bytes_new_with_free_func(). The equivalent Dart type is a Float64List.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_float_list_from_bytes(GBytes* value);
+
 /**
  * fl_value_new_list:
  *
@@ -140,6 +140,18 @@ bool AngleSurfaceManager::Initialize() {
     return false;
   }
 
+  // Uploads fall back to the other contexts if these can not be created.
+  for (size_t i = 0; i < kPooledResourceContextCount; i++) {
+    EGLContext context = eglCreateContext(
+        egl_display_, egl_config_, egl_context_, display_context_attributes);
+    if (context == EGL_NO_CONTEXT) {
+      std::cerr << "EGL: Failed to create EGL pooled resource context"
+                << std::endl;
+      break;
+    }
+    egl_pooled_resource_contexts_.push_back(context);
+  }
+
   return true;
 }
 
@@ -165,6 +177,16 @@ void AngleSurfaceManager::CleanUp() {
     }
   }
 
+  if (egl_display_ != EGL_NO_DISPLAY) {
+    for (EGLContext context : egl_pooled_resource_contexts_) {
+      if (eglDestroyContext(egl_display_, context) == EGL_FALSE) {
+        std::cerr << "EGL: Failed to destroy pooled resource context"
+                  << std::endl;
+      }
+    }
+  }
+  egl_pooled_resource_contexts_.clear();
+
   if (egl_display_ != EGL_NO_DISPLAY) {
     eglTerminate(egl_display_);
     egl_display_ = EGL_NO_DISPLAY;
@@ -200,7 +222,7 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   return true;
 }
 
-void AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
+bool AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
                                         EGLint width,
                                         EGLint height) {
   EGLint existing_width, existing_height;
@@ -217,13 +239,15 @@ void AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
       std::cerr << "AngleSurfaceManager::ResizeSurface failed to create surface"
                 << std::endl;
     }
+    return true;
   }
+  return false;
 }
 
 void AngleSurfaceManager::GetSurfaceDimensions(EGLint* width, EGLint* height) {
   if (render_surface_ == EGL_NO_SURFACE || !initialize_succeeded_) {
-    width = 0;
-    height = 0;
+    *width = 0;
+    *height = 0;
     return;
   }
 
@@ -253,6 +277,14 @@ bool AngleSurfaceManager::MakeResourceCurrent() {
                          egl_resource_context_) == EGL_TRUE);
 }
 
+bool AngleSurfaceManager::MakePooledResourceCurrent(size_t index) {
+  if (index >= egl_pooled_resource_contexts_.size()) {
+    return false;
+  }
+  return (eglMakeCurrent(egl_display_, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                         egl_pooled_resource_contexts_[index]) == EGL_TRUE);
+}
+
 EGLBoolean AngleSurfaceManager::SwapBuffers() {
   return (eglSwapBuffers(egl_display_, render_surface_));
 }
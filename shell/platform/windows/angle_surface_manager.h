@@ -15,6 +15,8 @@
 // Windows platform specific includes
 #include <windows.h>
 
+#include <vector>
+
 #include "window_binding_handler.h"
 
 namespace flutter {
@@ -23,6 +25,11 @@ namespace flutter {
 // destroy surfaces
 class AngleSurfaceManager {
  public:
+  // The number of resource contexts created in addition to
+  // egl_resource_context_ so that textures can be uploaded from several
+  // threads.
+  static constexpr size_t kPooledResourceContextCount = 2;
+
   // Creates a new surface manager retaining reference to the passed-in target
   // for the lifetime of the manager.
   AngleSurfaceManager();
@@ -43,8 +50,8 @@ class AngleSurfaceManager {
   // Resizes backing surface from current size to newly requested size
   // based on width and height for the specific case when width and height do
   // not match current surface dimensions.  Target represents the visual entity
-  // to bind to.
-  void ResizeSurface(WindowsRenderTarget* render_target,
+  // to bind to. Returns true if the surface was recreated.
+  bool ResizeSurface(WindowsRenderTarget* render_target,
                      EGLint width,
                      EGLint height);
 
@@ -66,6 +73,10 @@ class AngleSurfaceManager {
   // and read surfaces returning a boolean result reflecting success.
   bool MakeResourceCurrent();
 
+  // Binds the pooled resource context with the given index to the current
+  // thread returning a boolean result reflecting success.
+  bool MakePooledResourceCurrent(size_t index);
+
   // Swaps the front and back buffers of the DX11 swapchain backing surface if
   // not null.
   EGLBoolean SwapBuffers();
@@ -88,6 +99,10 @@ class AngleSurfaceManager {
   // uploads.
   EGLContext egl_resource_context_;
 
+  // EGL representation of additional rendering contexts used for async
+  // texture uploads from other threads.
+  std::vector<EGLContext> egl_pooled_resource_contexts_;
+
   // current frame buffer configuration.
   EGLConfig egl_config_;
 
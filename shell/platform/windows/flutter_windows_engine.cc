@@ -45,7 +45,15 @@ FlutterRendererConfig GetRendererConfig() {
     }
     return host->view()->SwapBuffers();
   };
-  config.open_gl.fbo_callback = [](void* user_data) -> uint32_t { return 0; };
+  config.open_gl.fbo_with_frame_info_callback =
+      [](void* user_data, const FlutterFrameInfo* info) -> uint32_t {
+    auto host = static_cast<FlutterWindowsEngine*>(user_data);
+    if (!host->view()) {
+      return 0;
+    }
+    return host->view()->GetFrameBufferId(info->size.width,
+                                          info->size.height);
+  };
   config.open_gl.gl_proc_resolver = [](void* user_data,
                                        const char* what) -> void* {
     return reinterpret_cast<void*>(eglGetProcAddress(what));
@@ -57,6 +65,16 @@ FlutterRendererConfig GetRendererConfig() {
     }
     return host->view()->MakeResourceCurrent();
   };
+  config.open_gl.pooled_resource_context_count =
+      AngleSurfaceManager::kPooledResourceContextCount;
+  config.open_gl.make_pooled_resource_current = [](void* user_data,
+                                                   size_t index) -> bool {
+    auto host = static_cast<FlutterWindowsEngine*>(user_data);
+    if (!host->view()) {
+      return false;
+    }
+    return host->view()->MakePooledResourceCurrent(index);
+  };
   return config;
 }
 
@@ -196,6 +214,20 @@ bool FlutterWindowsEngine::RunWithEntrypoint(const char* entrypoint) {
     args.custom_dart_entrypoint = entrypoint;
   }
 
+  // Frames are paced to the vertical blanks of the display instead of the
+  // timer of the engine.
+  vsync_waiter_ = std::make_unique<Win32VsyncWaiter>(
+      embedder_api_.GetCurrentTime,
+      [this](intptr_t baton, uint64_t frame_start_time_nanos,
+             uint64_t frame_target_time_nanos) {
+        embedder_api_.OnVsync(engine_, baton, frame_start_time_nanos,
+                              frame_target_time_nanos);
+      });
+  args.vsync_callback = [](void* user_data, intptr_t baton) -> void {
+    auto host = static_cast<FlutterWindowsEngine*>(user_data);
+    host->vsync_waiter_->AsyncWaitForVsync(baton);
+  };
+
   FlutterRendererConfig renderer_config = GetRendererConfig();
 
   auto result = embedder_api_.Run(FLUTTER_ENGINE_VERSION, &renderer_config,
@@ -203,10 +235,12 @@ bool FlutterWindowsEngine::RunWithEntrypoint(const char* entrypoint) {
   if (result != kSuccess || engine_ == nullptr) {
     std::cerr << "Failed to start Flutter engine: error " << result
               << std::endl;
+    vsync_waiter_ = nullptr;
     return false;
   }
 
   SendSystemSettings();
+  SendDisplayRefreshRate();
 
   return true;
 }
@@ -216,6 +250,8 @@ bool FlutterWindowsEngine::Stop() {
     if (plugin_registrar_destruction_callback_) {
       plugin_registrar_destruction_callback_(plugin_registrar_.get());
     }
+    // Returns the pending batons to the engine before it shuts down.
+    vsync_waiter_ = nullptr;
     FlutterEngineResult result = embedder_api_.Shutdown(engine_);
     engine_ = nullptr;
     return (result == kSuccess);
@@ -310,6 +346,22 @@ void FlutterWindowsEngine::ReloadSystemFonts() {
   embedder_api_.ReloadSystemFonts(engine_);
 }
 
+void FlutterWindowsEngine::SendDisplayRefreshRate() {
+  if (!vsync_waiter_) {
+    return;
+  }
+  double refresh_rate = vsync_waiter_->GetRefreshRate();
+  if (refresh_rate <= 0) {
+    return;
+  }
+  FlutterEngineDisplay display = {};
+  display.struct_size = sizeof(display);
+  display.single_display = true;
+  display.refresh_rate = refresh_rate;
+  embedder_api_.NotifyDisplayUpdate(
+      engine_, kFlutterEngineDisplaysUpdateTypeStartup, &display, 1);
+}
+
 void FlutterWindowsEngine::SendSystemSettings() {
   std::vector<LanguageInfo> languages = GetPreferredLanguageInfo();
   std::vector<FlutterLocale> flutter_locales;
@@ -15,6 +15,7 @@
 #include "flutter/shell/platform/windows/flutter_project_bundle.h"
 #include "flutter/shell/platform/windows/public/flutter_windows.h"
 #include "flutter/shell/platform/windows/win32_task_runner.h"
+#include "flutter/shell/platform/windows/win32_vsync_waiter.h"
 #include "flutter/shell/platform/windows/win32_window_proc_delegate_manager.h"
 #include "flutter/shell/platform/windows/window_state.h"
 
@@ -115,6 +116,9 @@ class FlutterWindowsEngine {
   // system changes.
   void SendSystemSettings();
 
+  // Sends the refresh rate of the display to the engine, if it is known.
+  void SendDisplayRefreshRate();
+
   // The handle to the embedder.h engine instance.
   FLUTTER_API_SYMBOL(FlutterEngine) engine_ = nullptr;
 
@@ -131,6 +135,9 @@ class FlutterWindowsEngine {
   // Task runner for tasks posted from the engine.
   std::unique_ptr<Win32TaskRunner> task_runner_;
 
+  // The source of the vsync events of the engine while it is running.
+  std::unique_ptr<Win32VsyncWaiter> vsync_waiter_;
+
   // The plugin messenger handle given to API clients.
   std::unique_ptr<FlutterDesktopMessenger> messenger_;
 
@@ -50,10 +50,34 @@ void FlutterWindowsView::SetEngine(
                     binding_handler_->GetDpiScale());
 }
 
-void FlutterWindowsView::OnWindowSizeChanged(size_t width,
-                                             size_t height) const {
-  surface_manager_->ResizeSurface(GetRenderTarget(), width, height);
+void FlutterWindowsView::OnWindowSizeChanged(size_t width, size_t height) {
+  // A minimized window has no size, and the engine doesn't render frames to
+  // an empty surface, so there's no frame to wait for.
+  if (width == 0 || height == 0) {
+    SendWindowMetrics(width, height, binding_handler_->GetDpiScale());
+    return;
+  }
+
+  // The surface is resized on the raster thread once the engine renders a
+  // frame of the new size, see |GetFrameBufferId|. Until then, the frames of
+  // the previous size are dropped rather than presented stretched to the new
+  // size of the window, and the platform thread waits for the new frame so
+  // that the window is not shown at the new size before its content is.
+  std::unique_lock<std::mutex> lock(resize_mutex_);
+  resize_status_ = ResizeState::kResizeStarted;
+  resize_target_width_ = width;
+  resize_target_height_ = height;
+
   SendWindowMetrics(width, height, binding_handler_->GetDpiScale());
+
+  if (!resize_cv_.wait_for(lock, kResizeTimeout, [this] {
+        return resize_status_ == ResizeState::kDone;
+      })) {
+    // Give up on this resize. The surface is still resized with the next
+    // frame of the new size, but the frames of other sizes are presented
+    // again in the meantime.
+    resize_status_ = ResizeState::kDone;
+  }
 }
 
 void FlutterWindowsView::OnPointerMove(double x, double y) {
@@ -251,16 +275,59 @@ bool FlutterWindowsView::MakeResourceCurrent() {
   return surface_manager_->MakeResourceCurrent();
 }
 
+bool FlutterWindowsView::MakePooledResourceCurrent(size_t index) {
+  return surface_manager_->MakePooledResourceCurrent(index);
+}
+
 bool FlutterWindowsView::ClearContext() {
   return surface_manager_->ClearContext();
 }
 
 bool FlutterWindowsView::SwapBuffers() {
-  return surface_manager_->SwapBuffers();
+  std::unique_lock<std::mutex> lock(resize_mutex_);
+  switch (resize_status_) {
+    case ResizeState::kResizeStarted:
+      // This frame was rendered before the engine received the new size of
+      // the window. Drop it, the next frame has the new size.
+      return true;
+    case ResizeState::kFrameGenerated: {
+      bool swapped = surface_manager_->SwapBuffers();
+      resize_status_ = ResizeState::kDone;
+      lock.unlock();
+      resize_cv_.notify_all();
+      return swapped;
+    }
+    case ResizeState::kDone:
+    default:
+      return surface_manager_->SwapBuffers();
+  }
+}
+
+uint32_t FlutterWindowsView::GetFrameBufferId(size_t width, size_t height) {
+  std::unique_lock<std::mutex> lock(resize_mutex_);
+  if (width == resize_target_width_ && height == resize_target_height_) {
+    // Only the EGL surface and its swapchain are recreated, the context and
+    // the GPU resources the engine created in it are kept. This is a no-op
+    // if the surface already has this size.
+    if (surface_manager_->ResizeSurface(GetRenderTarget(), width, height)) {
+      // The resized surface replaces the one that was current on the raster
+      // thread when the frame was acquired.
+      surface_manager_->MakeCurrent();
+    }
+    if (resize_status_ == ResizeState::kResizeStarted) {
+      resize_status_ = ResizeState::kFrameGenerated;
+    }
+  }
+  return 0;
 }
 
 void FlutterWindowsView::CreateRenderSurface() {
   PhysicalWindowBounds bounds = binding_handler_->GetPhysicalWindowBounds();
+  {
+    std::lock_guard<std::mutex> lock(resize_mutex_);
+    resize_target_width_ = bounds.width;
+    resize_target_height_ = bounds.height;
+  }
   surface_manager_->CreateSurface(GetRenderTarget(), bounds.width,
                                   bounds.height);
 }
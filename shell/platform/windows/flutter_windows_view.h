@@ -7,7 +7,10 @@
 
 #include <windowsx.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -61,13 +64,19 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate {
   bool ClearContext();
   bool MakeCurrent();
   bool MakeResourceCurrent();
+  bool MakePooledResourceCurrent(size_t index);
   bool SwapBuffers();
 
+  // Returns the frame buffer id for the engine to render a frame of the given
+  // size to. While a resize is pending, this resizes the surface once the
+  // engine renders a frame of the new size.
+  uint32_t GetFrameBufferId(size_t width, size_t height);
+
   // Send initial bounds to embedder.  Must occur after engine has initialized.
   void SendInitialBounds();
 
   // |WindowBindingHandlerDelegate|
-  void OnWindowSizeChanged(size_t width, size_t height) const override;
+  void OnWindowSizeChanged(size_t width, size_t height) override;
 
   // |WindowBindingHandlerDelegate|
   void OnPointerMove(double x, double y) override;
@@ -99,6 +108,28 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate {
                 int scroll_offset_multiplier) override;
 
  private:
+  // The progress of a resize of the window, which the platform thread waits
+  // for until the raster thread has presented a frame of the new size.
+  enum class ResizeState {
+    // No resize is pending.
+    kDone,
+    // The window was resized and the engine was sent the new metrics, but
+    // has not rendered a frame of the new size yet.
+    kResizeStarted,
+    // The surface was resized for a frame of the new size, which has not been
+    // presented yet.
+    kFrameGenerated,
+  };
+
+  // How long the platform thread waits for a frame of the new size after the
+  // window was resized, after which frames of any size are presented again.
+  // This bounds the wait when the engine does not produce a frame, for
+  // example before the first frame or while the framework waits for a
+  // platform message, which can't be answered while the platform thread
+  // waits.
+  static constexpr std::chrono::milliseconds kResizeTimeout =
+      std::chrono::milliseconds(100);
+
   // Struct holding the mouse state. The engine doesn't keep track of which
   // mouse buttons have been pressed, so it's the embedding's responsibility.
   struct MouseState {
@@ -204,6 +235,20 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate {
   // Handler for cursor events.
   std::unique_ptr<flutter::CursorHandler> cursor_handler_;
 
+  // Guards the resize state, which is updated on the platform thread when the
+  // window is resized and on the raster thread when frames are rendered.
+  std::mutex resize_mutex_;
+
+  // Signaled when a frame of the pending size was presented.
+  std::condition_variable resize_cv_;
+
+  // The progress of the pending resize, if any.
+  ResizeState resize_status_ = ResizeState::kDone;
+
+  // The size of the window, in physical pixels, as of the pending resize.
+  size_t resize_target_width_ = 0;
+  size_t resize_target_height_ = 0;
+
   // Currently configured WindowBindingHandler for view.
   std::unique_ptr<flutter::WindowBindingHandler> binding_handler_;
 };
@@ -137,7 +137,9 @@ FLUTTER_EXPORT bool FlutterDesktopEngineRun(FlutterDesktopEngineRef engine,
 //
 // This should be called on every run of the application-level runloop, and
 // a wait for native events in the runloop should never be longer than the
-// last return value from this function.
+// last return value from this function. The engine also posts a thread
+// message when a delayed event is due, so a runloop that waits for messages
+// is woken up on time even if its wait is only millisecond-precise.
 FLUTTER_EXPORT uint64_t
 FlutterDesktopEngineProcessMessages(FlutterDesktopEngineRef engine);
 
@@ -6,8 +6,10 @@
 
 #include <windows.h>
 
+#include <codecvt>
 #include <cstdint>
 #include <iostream>
+#include <locale>
 
 #include "flutter/shell/platform/common/cpp/json_method_codec.h"
 
@@ -21,11 +23,14 @@ static constexpr char kMultilineInputType[] = "TextInputType.multiline";
 
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+static constexpr char kUpdateEditingStateWithDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 
 static constexpr char kTextInputAction[] = "inputAction";
 static constexpr char kTextInputType[] = "inputType";
 static constexpr char kTextInputTypeName[] = "name";
+static constexpr char kEnableDeltaModel[] = "enableDeltaModel";
 static constexpr char kComposingBaseKey[] = "composingBase";
 static constexpr char kComposingExtentKey[] = "composingExtent";
 static constexpr char kSelectionAffinityKey[] = "selectionAffinity";
@@ -34,6 +39,10 @@ static constexpr char kSelectionBaseKey[] = "selectionBase";
 static constexpr char kSelectionExtentKey[] = "selectionExtent";
 static constexpr char kSelectionIsDirectionalKey[] = "selectionIsDirectional";
 static constexpr char kTextKey[] = "text";
+static constexpr char kDeltasKey[] = "deltas";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
 
 static constexpr char kChannelName[] = "flutter/textinput";
 
@@ -134,7 +143,14 @@ void TextInputPlugin::HandleMethodCall(
         input_type_ = input_type_json->value.GetString();
       }
     }
+    enable_delta_model_ = false;
+    auto enable_delta_model_json = client_config.FindMember(kEnableDeltaModel);
+    if (enable_delta_model_json != client_config.MemberEnd() &&
+        enable_delta_model_json->value.IsBool()) {
+      enable_delta_model_ = enable_delta_model_json->value.GetBool();
+    }
     active_model_ = std::make_unique<TextInputModel>();
+    active_model_->set_delta_tracking(enable_delta_model_);
   } else if (method.compare(kSetEditingStateMethod) == 0) {
     if (!method_call.arguments() || method_call.arguments()->IsNull()) {
       result->Error(kBadArgumentError, "Method invoked without args");
@@ -180,7 +196,11 @@ void TextInputPlugin::HandleMethodCall(
   result->Success();
 }
 
-void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
+void TextInputPlugin::SendStateUpdate(TextInputModel& model) {
+  if (enable_delta_model_) {
+    SendDeltas(model);
+    return;
+  }
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
   args->PushBack(client_id_, allocator);
@@ -201,6 +221,48 @@ void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
   channel_->InvokeMethod(kUpdateEditingStateMethod, std::move(args));
 }
 
+void TextInputPlugin::SendDeltas(TextInputModel& model) {
+  auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = args->GetAllocator();
+  args->PushBack(client_id_, allocator);
+
+  TextRange selection = model.selection();
+  rapidjson::Value deltas_json(rapidjson::kArrayType);
+  auto add_delta = [&](const std::string& text, int start, int end) {
+    rapidjson::Value delta(rapidjson::kObjectType);
+    delta.AddMember(kDeltaTextKey, rapidjson::Value(text, allocator).Move(),
+                    allocator);
+    delta.AddMember(kDeltaStartKey, start, allocator);
+    delta.AddMember(kDeltaEndKey, end, allocator);
+    delta.AddMember(kComposingBaseKey, -1, allocator);
+    delta.AddMember(kComposingExtentKey, -1, allocator);
+    delta.AddMember(kSelectionAffinityKey, kAffinityDownstream, allocator);
+    delta.AddMember(kSelectionBaseKey, selection.base(), allocator);
+    delta.AddMember(kSelectionExtentKey, selection.extent(), allocator);
+    delta.AddMember(kSelectionIsDirectionalKey, false, allocator);
+    deltas_json.PushBack(delta, allocator);
+  };
+
+  std::vector<TextEditingDelta> deltas = model.TakeDeltas();
+  if (deltas.empty()) {
+    // Only the selection changed.
+    add_delta("", -1, -1);
+  }
+  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
+      utf8_converter;
+  for (const TextEditingDelta& delta : deltas) {
+    add_delta(utf8_converter.to_bytes(delta.text),
+              static_cast<int>(delta.range.start()),
+              static_cast<int>(delta.range.end()));
+  }
+
+  rapidjson::Value editing_state(rapidjson::kObjectType);
+  editing_state.AddMember(kDeltasKey, deltas_json, allocator);
+  args->PushBack(editing_state, allocator);
+
+  channel_->InvokeMethod(kUpdateEditingStateWithDeltasMethod, std::move(args));
+}
+
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType) {
     model->AddText(std::u16string({u'\n'}));
@@ -40,7 +40,11 @@ class TextInputPlugin : public KeyboardHookHandler {
 
  private:
   // Sends the current state of the given model to the Flutter engine.
-  void SendStateUpdate(const TextInputModel& model);
+  void SendStateUpdate(TextInputModel& model);
+
+  // Sends the changes made to the text of the given model since the last
+  // update to the Flutter engine, along with its current selection.
+  void SendDeltas(TextInputModel& model);
 
   // Sends an action triggered by the Enter key to the Flutter engine.
   void EnterPressed(TextInputModel* model);
@@ -66,6 +70,10 @@ class TextInputPlugin : public KeyboardHookHandler {
   // An action requested by the user on the input client. See available options:
   // https://docs.flutter.io/flutter/services/TextInputAction-class.html
   std::string input_action_;
+
+  // Whether the client asked for the edits of the text as deltas instead of
+  // the whole text after each edit.
+  bool enable_delta_model_ = false;
 };
 
 }  // namespace flutter
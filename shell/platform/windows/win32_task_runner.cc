@@ -4,20 +4,65 @@
 
 #include "flutter/shell/platform/windows/win32_task_runner.h"
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <utility>
 
+// Only declared by the Windows 10 1803 SDK and later.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace flutter {
 
+namespace {
+
+// The unit of the due time of waitable timers.
+using TimerTicks = std::chrono::duration<int64_t, std::ratio<1, 10000000>>;
+
+HANDLE CreateTimer() {
+  // High-resolution timers fire within a fraction of a millisecond of their
+  // due time without raising the resolution of the system timer. Versions of
+  // Windows before 10 1803 reject the flag, so fall back to a plain timer.
+  HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr,
+                                        CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                        TIMER_ALL_ACCESS);
+  if (timer == nullptr) {
+    timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+  }
+  return timer;
+}
+
+}  // namespace
+
 Win32TaskRunner::Win32TaskRunner(DWORD main_thread_id,
                                  CurrentTimeProc get_current_time,
                                  const TaskExpiredCallback& on_task_expired)
     : main_thread_id_(main_thread_id),
       get_current_time_(get_current_time),
-      on_task_expired_(std::move(on_task_expired)) {}
+      on_task_expired_(std::move(on_task_expired)),
+      timer_(CreateTimer()),
+      stop_event_(CreateEvent(nullptr, TRUE, FALSE, nullptr)) {
+  if (timer_ == nullptr || stop_event_ == nullptr) {
+    std::cerr << "Failed to create the task runner timer." << std::endl;
+    return;
+  }
+  timer_thread_ = std::thread([this]() { RunTimerThread(); });
+}
 
-Win32TaskRunner::~Win32TaskRunner() = default;
+Win32TaskRunner::~Win32TaskRunner() {
+  if (timer_thread_.joinable()) {
+    SetEvent(stop_event_);
+    timer_thread_.join();
+  }
+  if (timer_ != nullptr) {
+    CloseHandle(timer_);
+  }
+  if (stop_event_ != nullptr) {
+    CloseHandle(stop_event_);
+  }
+}
 
 bool Win32TaskRunner::RunsTasksOnCurrentThread() const {
   return GetCurrentThreadId() == main_thread_id_;
@@ -63,6 +108,7 @@ std::chrono::nanoseconds Win32TaskRunner::ProcessTasks() {
     std::lock_guard<std::mutex> lock(task_queue_mutex_);
     const auto next_wake = task_queue_.empty() ? TaskTimePoint::max()
                                                : task_queue_.top().fire_time;
+    ScheduleWakeup(next_wake);
 
     return std::min(next_wake - now, std::chrono::nanoseconds::max());
   }
@@ -88,6 +134,16 @@ void Win32TaskRunner::PostTask(FlutterTask flutter_task,
     std::lock_guard<std::mutex> lock(task_queue_mutex_);
     task_queue_.push(task);
 
+    // Delayed tasks are woken up by the timer, which only needs to move if
+    // this task is due before the one it is set for.
+    if (timer_thread_.joinable() &&
+        task.fire_time > TaskTimePoint::clock::now()) {
+      if (task.fire_time < timer_fire_time_) {
+        ScheduleWakeup(task.fire_time);
+      }
+      return;
+    }
+
     // Make sure the queue mutex is unlocked before waking up the loop. In case
     // the wake causes this thread to be descheduled for the primary thread to
     // process tasks, the acquisition of the lock on that thread while holding
@@ -99,4 +155,49 @@ void Win32TaskRunner::PostTask(FlutterTask flutter_task,
   }
 }
 
+void Win32TaskRunner::ScheduleWakeup(TaskTimePoint fire_time) {
+  const auto now = TaskTimePoint::clock::now();
+  // A timer set for a time that has passed may have fired before it, so it is
+  // set again.
+  if (!timer_thread_.joinable() ||
+      (fire_time == timer_fire_time_ && fire_time > now)) {
+    return;
+  }
+  timer_fire_time_ = fire_time;
+  if (fire_time == TaskTimePoint::max()) {
+    CancelWaitableTimer(timer_);
+    return;
+  }
+
+  // A negative due time is relative to now, which keeps the timer on the
+  // same monotonic clock as the task queue.
+  const auto delay = std::chrono::ceil<TimerTicks>(fire_time - now);
+  LARGE_INTEGER due_time;
+  due_time.QuadPart = -std::max<int64_t>(delay.count(), 1);
+  if (!SetWaitableTimer(timer_, &due_time, 0, nullptr, nullptr, FALSE)) {
+    std::cerr << "Failed to set the task runner timer." << std::endl;
+  }
+}
+
+void Win32TaskRunner::RunTimerThread() {
+  const HANDLE handles[] = {stop_event_, timer_};
+  while (true) {
+    const DWORD result = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+    if (result != WAIT_OBJECT_0 + 1) {
+      return;
+    }
+    {
+      // The main thread sets the timer again for the next task once it has
+      // processed the expired ones, unless it already has.
+      std::lock_guard<std::mutex> lock(task_queue_mutex_);
+      if (timer_fire_time_ <= TaskTimePoint::clock::now()) {
+        timer_fire_time_ = TaskTimePoint::max();
+      }
+    }
+    if (!PostThreadMessage(main_thread_id_, WM_NULL, 0, 0)) {
+      std::cerr << "Failed to post message to main thread." << std::endl;
+    }
+  }
+}
+
 }  // namespace flutter
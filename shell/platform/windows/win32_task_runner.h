@@ -22,6 +22,13 @@ typedef uint64_t (*CurrentTimeProc)();
 // A custom task runner that integrates with user32 GetMessage semantics so that
 // host app can own its own message loop and flutter still gets to process
 // tasks on a timely basis.
+//
+// Delayed tasks are woken up by a high-resolution waitable timer rather than
+// the timeout of the host's message wait, which is only as precise as the
+// system timer tick (15.6ms by default). The timer is waited on by a
+// background thread that posts a message to the main thread when it fires, so
+// neither the global timer resolution nor the host's message loop needs to
+// change.
 class Win32TaskRunner {
  public:
   using TaskExpiredCallback = std::function<void(const FlutterTask*)>;
@@ -62,12 +69,28 @@ class Win32TaskRunner {
   TaskTimePoint TimePointFromFlutterTime(
       uint64_t flutter_target_time_nanos) const;
 
+  // Wakes the main thread at |fire_time|, or as soon as possible if it has
+  // passed. Replaces the previous wakeup, if any. Must be called with
+  // |task_queue_mutex_| held.
+  void ScheduleWakeup(TaskTimePoint fire_time);
+
+  // Waits on |timer_| on the timer thread until |stop_event_| is signaled.
+  void RunTimerThread();
+
   DWORD main_thread_id_;
   CurrentTimeProc get_current_time_;
   TaskExpiredCallback on_task_expired_;
   std::mutex task_queue_mutex_;
   std::priority_queue<Task, std::deque<Task>, Task::Comparer> task_queue_;
 
+  // The waitable timer of the next delayed task, or null if it could not be
+  // created, in which case every posted task wakes the main thread.
+  HANDLE timer_ = nullptr;
+  HANDLE stop_event_ = nullptr;
+  // The time |timer_| is set to, or max if it is not set.
+  TaskTimePoint timer_fire_time_ = TaskTimePoint::max();
+  std::thread timer_thread_;
+
   Win32TaskRunner(const Win32TaskRunner&) = delete;
 
   Win32TaskRunner& operator=(const Win32TaskRunner&) = delete;
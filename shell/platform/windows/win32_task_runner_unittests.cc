@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/win32_task_runner.h"
+
+#include <chrono>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+uint64_t GetCurrentTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Waits for a message to the current thread for up to |timeout_ms|, and
+// removes it from the queue. Returns false if none arrived.
+bool WaitForThreadMessage(DWORD timeout_ms) {
+  if (MsgWaitForMultipleObjects(0, nullptr, FALSE, timeout_ms,
+                                QS_ALLPOSTMESSAGE) != WAIT_OBJECT_0) {
+    return false;
+  }
+  MSG msg;
+  while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+  }
+  return true;
+}
+}  // namespace
+
+TEST(Win32TaskRunner, RunsExpiredTasksInOrder) {
+  std::vector<uint64_t> ran;
+  Win32TaskRunner runner(
+      GetCurrentThreadId(), GetCurrentTime,
+      [&ran](const FlutterTask* task) { ran.push_back(task->task); });
+
+  const uint64_t now = GetCurrentTime();
+  runner.PostTask(FlutterTask{nullptr, 1}, now);
+  runner.PostTask(FlutterTask{nullptr, 2}, now);
+  runner.PostTask(FlutterTask{nullptr, 3}, now + 60000000000ull);
+  runner.ProcessTasks();
+
+  EXPECT_EQ(ran, std::vector<uint64_t>({1, 2}));
+}
+
+TEST(Win32TaskRunner, WakesTheMainThreadWhenADelayedTaskIsDue) {
+  std::vector<uint64_t> ran;
+  Win32TaskRunner runner(
+      GetCurrentThreadId(), GetCurrentTime,
+      [&ran](const FlutterTask* task) { ran.push_back(task->task); });
+
+  // Drain the messages left by previous tests.
+  while (WaitForThreadMessage(0)) {
+  }
+
+  const uint64_t target_time = GetCurrentTime() + 5000000;  // 5ms.
+  runner.PostTask(FlutterTask{nullptr, 1}, target_time);
+
+  // The runner posts a message to the thread once the task is due, without
+  // the loop having to time its wait.
+  for (int i = 0; i < 10 && ran.empty(); i++) {
+    ASSERT_TRUE(WaitForThreadMessage(5000));
+    runner.ProcessTasks();
+  }
+  EXPECT_EQ(ran, std::vector<uint64_t>({1}));
+  EXPECT_GE(GetCurrentTime(), target_time);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/win32_vsync_waiter.h"
+
+#include <dwmapi.h>
+
+#include <chrono>
+
+namespace flutter {
+
+namespace {
+
+// The refresh period assumed when DWM does not report one.
+constexpr uint64_t kFallbackRefreshPeriodNanos = 1000000000ull / 60;
+
+// Returns the timing information of the compositor, or false if DWM
+// composition is not available.
+bool GetCompositionTimingInfo(DWM_TIMING_INFO* info) {
+  *info = {};
+  info->cbSize = sizeof(DWM_TIMING_INFO);
+  return SUCCEEDED(DwmGetCompositionTimingInfo(nullptr, info));
+}
+
+}  // namespace
+
+Win32VsyncWaiter::Win32VsyncWaiter(CurrentTimeProc get_current_time,
+                                   const VsyncCallback& on_vsync)
+    : get_current_time_(get_current_time), on_vsync_(on_vsync) {
+  QueryPerformanceFrequency(&qpc_frequency_);
+  DWM_TIMING_INFO info;
+  if (GetCompositionTimingInfo(&info)) {
+    initial_frames_missed_ = info.cFramesMissed;
+  }
+  thread_ = std::thread([this]() { Run(); });
+}
+
+Win32VsyncWaiter::~Win32VsyncWaiter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+
+  // All batons must be returned before the engine is shut down.
+  const uint64_t now = get_current_time_();
+  for (intptr_t baton : batons_) {
+    on_vsync_(baton, now, now + kFallbackRefreshPeriodNanos);
+  }
+}
+
+void Win32VsyncWaiter::AsyncWaitForVsync(intptr_t baton) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batons_.push_back(baton);
+  }
+  cv_.notify_all();
+}
+
+double Win32VsyncWaiter::GetRefreshRate() const {
+  DWM_TIMING_INFO info;
+  if (!GetCompositionTimingInfo(&info) || info.rateRefresh.uiDenominator == 0) {
+    return 0;
+  }
+  return static_cast<double>(info.rateRefresh.uiNumerator) /
+         info.rateRefresh.uiDenominator;
+}
+
+Win32VsyncWaiter::Stats Win32VsyncWaiter::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void Win32VsyncWaiter::Run() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stopped_ || !batons_.empty(); });
+      if (stopped_) {
+        return;
+      }
+    }
+
+    uint64_t frame_start_time_nanos = 0;
+    uint64_t frame_target_time_nanos = 0;
+    WaitForVBlank(&frame_start_time_nanos, &frame_target_time_nanos);
+
+    // Requests made while waiting are serviced by the same vertical blank.
+    std::deque<intptr_t> batons;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopped_) {
+        return;
+      }
+      batons.swap(batons_);
+    }
+    for (intptr_t baton : batons) {
+      on_vsync_(baton, frame_start_time_nanos, frame_target_time_nanos);
+    }
+  }
+}
+
+void Win32VsyncWaiter::WaitForVBlank(uint64_t* frame_start_time_nanos,
+                                     uint64_t* frame_target_time_nanos) {
+  DWM_TIMING_INFO info;
+  // DwmFlush returns after the next composition pass, which is driven by the
+  // vertical blanks of the display.
+  if (SUCCEEDED(DwmFlush()) && GetCompositionTimingInfo(&info) &&
+      info.qpcRefreshPeriod > 0) {
+    const uint64_t vblank = EngineTimeFromQPC(info.qpcVBlank);
+    const uint64_t period = NanosFromQPCTicks(info.qpcRefreshPeriod);
+    *frame_start_time_nanos = vblank;
+    *frame_target_time_nanos = vblank + period;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.vsync_count++;
+    stats_.frames_missed = info.cFramesMissed - initial_frames_missed_;
+    stats_.refresh_period_nanos = period;
+    return;
+  }
+
+  // Without composition, pace the frames on a timer like the fallback waiter
+  // of the engine does.
+  std::this_thread::sleep_for(
+      std::chrono::nanoseconds(kFallbackRefreshPeriodNanos));
+  *frame_start_time_nanos = get_current_time_();
+  *frame_target_time_nanos =
+      *frame_start_time_nanos + kFallbackRefreshPeriodNanos;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.vsync_count++;
+  stats_.refresh_period_nanos = 0;
+}
+
+int64_t Win32VsyncWaiter::NanosFromQPCTicks(int64_t ticks) const {
+  const int64_t frequency = qpc_frequency_.QuadPart;
+  if (frequency <= 0) {
+    return 0;
+  }
+  // Split the conversion to avoid overflowing 64 bits.
+  return (ticks / frequency) * 1000000000ll +
+         (ticks % frequency) * 1000000000ll / frequency;
+}
+
+uint64_t Win32VsyncWaiter::EngineTimeFromQPC(uint64_t qpc) const {
+  LARGE_INTEGER now_qpc;
+  QueryPerformanceCounter(&now_qpc);
+  const uint64_t now = get_current_time_();
+  return now - NanosFromQPCTicks(static_cast<int64_t>(now_qpc.QuadPart) -
+                                 static_cast<int64_t>(qpc));
+}
+
+}  // namespace flutter
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_WIN32_VSYNC_WAITER_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_WIN32_VSYNC_WAITER_H_
+
+#include <windows.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "flutter/shell/platform/windows/win32_task_runner.h"
+
+namespace flutter {
+
+// Waits for the vertical blanks of the display on a background thread using
+// the Desktop Window Manager, so that frames are paced to the actual refresh
+// rate of the display instead of a timer.
+//
+// The frame start time of each vsync is the time of the vertical blank as
+// reported by DWM, and the target time is one refresh period later, both in
+// the time base of |get_current_time|.
+class Win32VsyncWaiter {
+ public:
+  // Called on the waiter thread with the baton of each request.
+  using VsyncCallback = std::function<void(intptr_t baton,
+                                           uint64_t frame_start_time_nanos,
+                                           uint64_t frame_target_time_nanos)>;
+
+  // Presentation statistics of the display, as reported by DWM.
+  struct Stats {
+    // The number of vsyncs delivered.
+    uint64_t vsync_count = 0;
+    // The number of compositor frames that missed their vertical blank since
+    // the waiter was created.
+    uint64_t frames_missed = 0;
+    // The refresh period of the display, or 0 if it is unknown.
+    uint64_t refresh_period_nanos = 0;
+  };
+
+  Win32VsyncWaiter(CurrentTimeProc get_current_time,
+                   const VsyncCallback& on_vsync);
+
+  // Stops the waiter thread. The batons of pending requests are returned to
+  // |on_vsync| on the calling thread, with the current time as their start.
+  ~Win32VsyncWaiter();
+
+  // Prevent copying.
+  Win32VsyncWaiter(Win32VsyncWaiter const&) = delete;
+  Win32VsyncWaiter& operator=(Win32VsyncWaiter const&) = delete;
+
+  // Requests a call to |on_vsync| with |baton| after the next vertical blank.
+  void AsyncWaitForVsync(intptr_t baton);
+
+  // Returns the refresh rate of the display in frames per second, or 0 if DWM
+  // does not report one, for example when composition is disabled.
+  double GetRefreshRate() const;
+
+  Stats GetStats() const;
+
+ private:
+  void Run();
+
+  // Blocks until the next vertical blank and returns its time and the time of
+  // the following one.
+  void WaitForVBlank(uint64_t* frame_start_time_nanos,
+                     uint64_t* frame_target_time_nanos);
+
+  // Converts a QueryPerformanceCounter value to the time base of
+  // |get_current_time_|.
+  uint64_t EngineTimeFromQPC(uint64_t qpc) const;
+
+  // Converts a duration in QueryPerformanceCounter ticks to nanoseconds.
+  int64_t NanosFromQPCTicks(int64_t ticks) const;
+
+  CurrentTimeProc get_current_time_;
+  VsyncCallback on_vsync_;
+  LARGE_INTEGER qpc_frequency_ = {};
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<intptr_t> batons_;
+  bool stopped_ = false;
+  uint64_t initial_frames_missed_ = 0;
+  Stats stats_;
+
+  std::thread thread_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_WIN32_VSYNC_WAITER_H_
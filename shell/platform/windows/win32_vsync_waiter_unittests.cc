@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/win32_vsync_waiter.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+uint64_t GetCurrentTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+TEST(Win32VsyncWaiter, ReturnsBatonsAfterTheNextVBlank) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<intptr_t> batons;
+  Win32VsyncWaiter waiter(
+      GetCurrentTime, [&](intptr_t baton, uint64_t frame_start_time_nanos,
+                          uint64_t frame_target_time_nanos) {
+        EXPECT_GT(frame_target_time_nanos, frame_start_time_nanos);
+        EXPECT_LE(frame_start_time_nanos, GetCurrentTime());
+        std::lock_guard<std::mutex> lock(mutex);
+        batons.push_back(baton);
+        cv.notify_all();
+      });
+
+  const uint64_t request_time = GetCurrentTime();
+  waiter.AsyncWaitForVsync(1);
+  waiter.AsyncWaitForVsync(2);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [&batons]() { return batons.size() == 2; });
+  EXPECT_EQ(batons, std::vector<intptr_t>({1, 2}));
+  EXPECT_GE(waiter.GetStats().vsync_count, 1u);
+  EXPECT_GT(GetCurrentTime(), request_time);
+}
+
+TEST(Win32VsyncWaiter, ReturnsPendingBatonsWhenDestroyed) {
+  std::vector<intptr_t> batons;
+  {
+    Win32VsyncWaiter waiter(GetCurrentTime,
+                            [&batons](intptr_t baton, uint64_t, uint64_t) {
+                              batons.push_back(baton);
+                            });
+    waiter.AsyncWaitForVsync(1);
+  }
+  // Whether the baton was returned by a vertical blank or by the destructor,
+  // it is returned exactly once.
+  EXPECT_EQ(batons, std::vector<intptr_t>({1}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// @dart = 2.6
+import 'dart:isolate';
+import 'dart:typed_data';
+import 'dart:ui';
+
+import 'package:test/test.dart';
+
+void recordPictureEntrypoint(SendPort port) {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Path path = Path()..addOval(const Rect.fromLTWH(0, 0, 10, 10));
+  canvas.drawPath(path, Paint()..color = const Color(0xFF00FF00));
+  canvas.drawShadow(path, const Color(0xFF000000), 2, false);
+  final Picture picture = recorder.endRecording();
+  port.send(picture.approximateBytesUsed > 0);
+  picture.dispose();
+}
+
+void layoutParagraphEntrypoint(SendPort port) {
+  final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(fontSize: 10))
+    ..addText('Hello, world');
+  final Paragraph paragraph = builder.build()
+    ..layout(const ParagraphConstraints(width: 1000));
+  port.send(paragraph.width);
+}
+
+Future<void> decodeImageEntrypoint(SendPort port) async {
+  final Uint8List pixels = Uint8List.fromList(<int>[1, 2, 3, 255, 4, 5, 6, 255]);
+  final ImageDescriptor descriptor = ImageDescriptor.raw(
+    await ImmutableBuffer.fromUint8List(pixels),
+    width: 2,
+    height: 1,
+    pixelFormat: PixelFormat.rgba8888,
+  );
+  final Codec codec = await descriptor.instantiateCodec();
+  final Image image = (await codec.getNextFrame()).image;
+  final ByteData data = await image.toByteData();
+  port.send(<dynamic>[image.width, image.height, data.buffer.asUint8List().toList()]);
+  image.dispose();
+}
+
+Future<dynamic> runInIsolate(void Function(SendPort) entrypoint) async {
+  final ReceivePort receivePort = ReceivePort();
+  final ReceivePort errorPort = ReceivePort();
+  await Isolate.spawn(entrypoint, receivePort.sendPort, onError: errorPort.sendPort);
+  errorPort.listen((dynamic error) => fail('Isolate failed: $error'));
+  final dynamic result = await receivePort.first;
+  errorPort.close();
+  return result;
+}
+
+void main() {
+  test('Background isolates can record pictures', () async {
+    expect(await runInIsolate(recordPictureEntrypoint), isTrue);
+  });
+
+  test('Background isolates can lay out paragraphs', () async {
+    final double width = await runInIsolate(layoutParagraphEntrypoint) as double;
+    expect(width, 1000);
+  });
+
+  test('Background isolates can decode images', () async {
+    final List<dynamic> result = await runInIsolate(decodeImageEntrypoint) as List<dynamic>;
+    expect(result[0], 2);
+    expect(result[1], 1);
+    expect(result[2], <int>[1, 2, 3, 255, 4, 5, 6, 255]);
+  });
+}
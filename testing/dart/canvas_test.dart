@@ -269,4 +269,35 @@ void main() {
     expectArgumentError(() => canvas.drawRawAtlas(image, Float32List(0), Float32List(4), null, null, rect, paint));
     expectArgumentError(() => canvas.drawRawAtlas(image, Float32List(4), Float32List(4), Int32List(2), BlendMode.src, rect, paint));
   });
+
+  test('Batched draws keep their order with the other canvas calls', () async {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    final Paint red = Paint()
+      ..isAntiAlias = false
+      ..color = const Color(0xFFFF0000);
+    final Paint green = Paint()
+      ..isAntiAlias = false
+      ..color = const Color(0xFF00FF00);
+    // More commands than fit in a single command buffer.
+    for (int y = 0; y < 40; y++) {
+      for (int x = 0; x < 50; x++) {
+        canvas.drawRect(Rect.fromLTWH(x.toDouble(), y.toDouble(), 1, 1), red);
+      }
+    }
+    canvas.save();
+    canvas.translate(10, 10);
+    canvas.drawRect(const Rect.fromLTWH(0, 0, 5, 5), green);
+    canvas.restore();
+    canvas.drawRect(const Rect.fromLTWH(12, 12, 1, 1), red);
+    final Picture picture = recorder.endRecording();
+    final Image image = await picture.toImage(50, 40);
+    final ByteData data = await image.toByteData();
+
+    int pixel(int x, int y) => data.getUint32((y * 50 + x) * 4);
+    expect(pixel(0, 0), 0xFF0000FF);
+    expect(pixel(49, 39), 0xFF0000FF);
+    expect(pixel(11, 11), 0x00FF00FF);
+    expect(pixel(12, 12), 0xFF0000FF);
+  });
 }
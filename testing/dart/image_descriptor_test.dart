@@ -83,6 +83,13 @@ void main() {
     final Codec codec = await descriptor.instantiateCodec();
     expect(codec.frameCount, 1);
   }, skip: !(Platform.isIOS || Platform.isMacOS || Platform.isWindows));
+
+  test('ImmutableBuffer.fromAsset throws for a missing asset', () {
+    expect(
+      () => ImmutableBuffer.fromAsset('does_not_exist.png'),
+      throwsA(isA<Exception>()),
+    );
+  });
 }
 
 Future<Uint8List> readFile(String fileName, ) async {
@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// @dart = 2.6
+import 'dart:io';
+import 'dart:typed_data';
+import 'dart:ui';
+
+import 'package:path/path.dart' as path;
+import 'package:test/test.dart';
+
+void main() {
+  test('incremental decoder returns null before the header is added', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder();
+    decoder.addBytes(Uint8List.sublistView(bytes, 0, 8));
+
+    expect(await decoder.decode(), isNull);
+    expect(decoder.isComplete, false);
+    decoder.dispose();
+  });
+
+  test('incremental decoder decodes the image once all bytes are added', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final IncrementalImageDecoder decoder = IncrementalImageDecoder();
+    final int half = bytes.length ~/ 2;
+    decoder.addBytes(Uint8List.sublistView(bytes, 0, half));
+    await decoder.decode();
+    expect(decoder.isComplete, false);
+
+    decoder.addBytes(Uint8List.sublistView(bytes, half));
+    decoder.close();
+    final Image image = await decoder.decode();
+    expect(decoder.isComplete, true);
+    expect(image.width, 10);
+    expect(image.height, 10);
+    decoder.dispose();
+  });
+}
+
+Future<Uint8List> readFile(String fileName) async {
+  final File file =
+      File(path.join('flutter', 'testing', 'resources', fileName));
+  return await file.readAsBytes();
+}
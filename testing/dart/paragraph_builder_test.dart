@@ -22,6 +22,22 @@ void main() {
     expect(paragraph.height, isNonZero);
   });
 
+  test('Should be able to build and layout a paragraph asynchronously', () async {
+    final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle());
+    builder.addText('Hello');
+    final Paragraph paragraph =
+        await builder.buildAndLayout(const ParagraphConstraints(width: 800.0));
+    expect(paragraph.width, 800.0);
+    expect(paragraph.height, isNonZero);
+
+    final ParagraphBuilder expectedBuilder = ParagraphBuilder(ParagraphStyle());
+    expectedBuilder.addText('Hello');
+    final Paragraph expected = expectedBuilder.build();
+    expected.layout(const ParagraphConstraints(width: 800.0));
+    expect(paragraph.height, expected.height);
+    expect(paragraph.longestLine, expected.longestLine);
+  });
+
   test('PushStyle should not segfault after build()', () {
     final ParagraphBuilder paragraphBuilder =
         ParagraphBuilder(ParagraphStyle());
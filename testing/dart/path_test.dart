@@ -3,7 +3,7 @@
 // found in the LICENSE file.
 
 // @dart = 2.6
-import 'dart:typed_data' show Float64List;
+import 'dart:typed_data' show Float32List, Float64List;
 import 'dart:ui';
 
 import 'package:test/test.dart';
@@ -191,6 +191,30 @@ void main() {
     expect(metrics[1].extractPath(4.0, 6.0).computeMetrics().first.length, 2.0);
   });
 
+  test('PathMetric measures many offsets and segments in one call', () {
+    final Path path = Path()
+      ..moveTo(0, 0)
+      ..lineTo(10, 0)
+      ..lineTo(10, 10);
+    final PathMetric metric = path.computeMetrics().first;
+
+    final Float32List posTans = metric.getTangentsForOffsets(
+        Float32List.fromList(<double>[5.0, 15.0, 100.0, double.nan]));
+    expect(posTans.length, 16);
+    expect(posTans.sublist(0, 4), <double>[5.0, 0.0, 1.0, 0.0]);
+    expect(posTans.sublist(4, 8), <double>[10.0, 5.0, 0.0, 1.0]);
+    // Offsets are clamped to the length of the contour.
+    expect(posTans.sublist(8, 12), <double>[10.0, 10.0, 0.0, 1.0]);
+    expect(posTans.sublist(12, 16).every((double value) => value.isNaN), isTrue);
+
+    final Path dashes = metric.extractPathSegments(
+        Float32List.fromList(<double>[0.0, 4.0, 8.0, 12.0]));
+    final List<PathMetric> dashMetrics = dashes.computeMetrics().toList();
+    expect(dashMetrics.length, 2);
+    expect(dashMetrics[0].length, 4.0);
+    expect(dashMetrics[1].length, 4.0);
+  });
+
   test('PathMetrics on a mutated path', () {
     final Path path = Path()..lineTo(0, 10);
     final PathMetrics metrics = path.computeMetrics();
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// @dart = 2.6
+import 'dart:isolate';
+import 'dart:typed_data';
+import 'dart:ui';
+
+import 'package:test/test.dart';
+
+Future<void> claimBufferEntrypoint(List<dynamic> message) async {
+  final SendPort port = message[0] as SendPort;
+  final ImmutableBuffer buffer = ImmutableBuffer.fromTransferToken(message[1] as int);
+  final ImageDescriptor descriptor = ImageDescriptor.raw(
+    buffer,
+    width: 2,
+    height: 1,
+    pixelFormat: PixelFormat.rgba8888,
+  );
+  final Codec codec = await descriptor.instantiateCodec();
+  final FrameInfo frame = await codec.getNextFrame();
+  final ByteData data = await frame.image.toByteData();
+  port.send(data.buffer.asUint8List().toList());
+}
+
+void main() {
+  final Uint8List pixels = Uint8List.fromList(<int>[1, 2, 3, 255, 4, 5, 6, 255]);
+
+  test('ImmutableBuffer can be transferred within an isolate', () async {
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(pixels);
+    final int token = buffer.transfer();
+
+    final ImmutableBuffer claimed = ImmutableBuffer.fromTransferToken(token);
+    expect(claimed.length, pixels.length);
+    expect(() => ImmutableBuffer.fromTransferToken(token), throwsArgumentError);
+    claimed.dispose();
+  });
+
+  test('ImmutableBuffer can be transferred to another isolate', () async {
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(pixels);
+    final ReceivePort receivePort = ReceivePort();
+    await Isolate.spawn(
+      claimBufferEntrypoint,
+      <dynamic>[receivePort.sendPort, buffer.transfer()],
+    );
+    final List<int> decoded = await receivePort.first as List<int>;
+    expect(decoded, pixels);
+  });
+
+  test('Image can be transferred and claimed once', () async {
+    final Codec codec = await ImageDescriptor.raw(
+      await ImmutableBuffer.fromUint8List(pixels),
+      width: 2,
+      height: 1,
+      pixelFormat: PixelFormat.rgba8888,
+    ).instantiateCodec();
+    final Image image = (await codec.getNextFrame()).image;
+
+    final int token = image.transfer();
+    expect(() => image.clone(), throwsStateError);
+
+    final Image claimed = Image.fromTransferToken(token);
+    expect(claimed.width, 2);
+    expect(claimed.height, 1);
+    final ByteData data = await claimed.toByteData();
+    expect(data.buffer.asUint8List(), pixels);
+    expect(() => Image.fromTransferToken(token), throwsArgumentError);
+    claimed.dispose();
+  });
+
+  test('Image with open clones cannot be transferred', () async {
+    final Codec codec = await ImageDescriptor.raw(
+      await ImmutableBuffer.fromUint8List(pixels),
+      width: 2,
+      height: 1,
+      pixelFormat: PixelFormat.rgba8888,
+    ).instantiateCodec();
+    final Image image = (await codec.getNextFrame()).image;
+    final Image clone = image.clone();
+
+    expect(() => image.transfer(), throwsStateError);
+    clone.dispose();
+    final Image claimed = Image.fromTransferToken(image.transfer());
+    claimed.dispose();
+  });
+}
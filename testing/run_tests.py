@@ -165,6 +165,8 @@ def RunEngineBenchmarks(build_dir, filter):
 
   RunEngineExecutable(build_dir, 'shell_benchmarks', filter)
 
+  RunEngineExecutable(build_dir, 'flow_benchmarks', filter)
+
   RunEngineExecutable(build_dir, 'fml_benchmarks', filter)
 
   RunEngineExecutable(build_dir, 'ui_benchmarks', filter)
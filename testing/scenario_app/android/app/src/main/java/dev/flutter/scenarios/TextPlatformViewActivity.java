@@ -21,6 +21,7 @@ import io.flutter.plugin.common.BasicMessageChannel;
 import io.flutter.plugin.common.BinaryCodec;
 import io.flutter.plugin.common.JSONMethodCodec;
 import io.flutter.plugin.common.MethodChannel;
+import java.io.File;
 import java.io.FileDescriptor;
 import java.io.FileOutputStream;
 import java.io.IOException;
@@ -75,6 +76,14 @@ public class TextPlatformViewActivity extends TestableFlutterActivity {
         .getPlatformViewsController()
         .getRegistry()
         .registerViewFactory("scenarios/textPlatformView", new TextPlatformViewFactory());
+    flutterEngine
+        .getDartExecutor()
+        .setMessageHandler(
+            "benchmark_results",
+            (byteBuffer, binaryReply) -> {
+              writeBenchmarkResults(byteBuffer);
+              binaryReply.reply(null);
+            });
   }
 
   @Override
@@ -85,10 +94,35 @@ public class TextPlatformViewActivity extends TestableFlutterActivity {
     }
     MethodChannel channel =
         new MethodChannel(getFlutterEngine().getDartExecutor(), "driver", JSONMethodCodec.INSTANCE);
-    Map<String, Object> test = new HashMap<>(2);
+    Map<String, Object> test = new HashMap<>(3);
     test.put("name", launchIntent.getStringExtra("scenario"));
     test.put("use_android_view", launchIntent.getBooleanExtra("use_android_view", false));
-    channel.invokeMethod("set_scenario", test);
+    if (launchIntent.hasExtra("benchmark_seconds")) {
+      test.put("duration_seconds", launchIntent.getIntExtra("benchmark_seconds", 10));
+      channel.invokeMethod("run_benchmark", test);
+    } else {
+      channel.invokeMethod("set_scenario", test);
+    }
+  }
+
+  /**
+   * Writes the JSON results of a frame pacing benchmark to {@code benchmark_results.json} in the
+   * app's external files directory, where the device lab pulls them from, and finishes the
+   * activity.
+   */
+  private void writeBenchmarkResults(ByteBuffer results) {
+    final File file = new File(getExternalFilesDir(null), "benchmark_results.json");
+    try {
+      final FileOutputStream outputStream = new FileOutputStream(file);
+      final byte[] bytes = new byte[results.remaining()];
+      results.get(bytes);
+      outputStream.write(bytes);
+      outputStream.close();
+      Log.i(TAG, "Wrote benchmark results to " + file.getPath());
+    } catch (IOException ex) {
+      Log.e(TAG, "Could not write benchmark results: " + ex.toString());
+    }
+    finish();
   }
 
   private void writeTimelineData(Uri logFile) {
@@ -52,6 +52,8 @@
     @"--tap-status-bar" : @"tap_status_bar",
     @"--text-semantics-focus" : @"text_semantics_focus",
     @"--animated-color-square" : @"animated_color_square",
+    @"--scrolling-list" : @"scrolling_list",
+    @"--backdrop-blur" : @"backdrop_blur",
   };
   __block NSString* flutterViewControllerTestName = nil;
   [launchArgsMap
@@ -82,6 +84,17 @@
   }
 }
 
+// The number of seconds following `--benchmark-seconds` in the launch arguments, or 0 if the
+// scenario should not run as a frame pacing benchmark.
+- (NSInteger)benchmarkSeconds {
+  NSArray<NSString*>* arguments = [[NSProcessInfo processInfo] arguments];
+  NSUInteger index = [arguments indexOfObject:@"--benchmark-seconds"];
+  if (index == NSNotFound || index + 1 >= arguments.count) {
+    return 0;
+  }
+  return [arguments[index + 1] integerValue];
+}
+
 - (void)setupFlutterViewControllerTest:(NSString*)scenarioIdentifier {
   FlutterEngine* engine = [[FlutterEngine alloc] initWithName:@"FlutterControllerTest" project:nil];
   [engine run];
@@ -96,7 +109,29 @@
                   methodChannelWithName:@"driver"
                         binaryMessenger:engine.binaryMessenger
                                   codec:[FlutterJSONMethodCodec sharedInstance]];
-              [channel invokeMethod:@"set_scenario" arguments:@{@"name" : scenarioIdentifier}];
+              NSInteger benchmarkSeconds = [self benchmarkSeconds];
+              if (benchmarkSeconds > 0) {
+                [channel invokeMethod:@"run_benchmark"
+                            arguments:@{
+                              @"name" : scenarioIdentifier,
+                              @"duration_seconds" : @(benchmarkSeconds)
+                            }];
+              } else {
+                [channel invokeMethod:@"set_scenario" arguments:@{@"name" : scenarioIdentifier}];
+              }
+            }];
+  [engine.binaryMessenger
+      setMessageHandlerOnChannel:@"benchmark_results"
+            binaryMessageHandler:^(NSData* _Nullable message, FlutterBinaryReply _Nonnull reply) {
+              // Written to the Documents directory, where the device lab pulls them from.
+              NSURL* documents = [[NSFileManager defaultManager] URLsForDirectory:NSDocumentDirectory
+                                                                         inDomains:NSUserDomainMask]
+                                     .firstObject;
+              NSURL* resultsURL = [documents URLByAppendingPathComponent:@"benchmark_results.json"];
+              if (![message writeToURL:resultsURL atomically:YES]) {
+                NSLog(@"Could not write benchmark results to %@", resultsURL.path);
+              }
+              reply(nil);
             }];
   [engine.binaryMessenger
       setMessageHandlerOnChannel:@"touches_scenario"
@@ -34,6 +34,10 @@ void _handleDriverMessage(Map<String, dynamic> call) {
       assert(call['args'] != null);
       loadScenario(call['args'] as Map<String, dynamic>);
     break;
+    case 'run_benchmark':
+      assert(call['args'] != null);
+      loadBenchmark(call['args'] as Map<String, dynamic>);
+    break;
     default:
       throw 'Unimplemented method: $methodName.';
   }
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// @dart = 2.6
+import 'dart:ui';
+
+import 'scenario.dart';
+
+/// A list of rows that scrolls continuously, wrapping around at its end.
+///
+/// Each row is a separate picture, so that the raster cache treats them like
+/// the items of a scrolling list in the framework.
+class ScrollingListScenario extends Scenario {
+  /// Creates the ScrollingList scenario.
+  ///
+  /// The [dispatcher] parameter must not be null.
+  ScrollingListScenario(PlatformDispatcher dispatcher)
+      : assert(dispatcher != null),
+        super(dispatcher);
+
+  static const double _rowHeight = 120;
+  static const int _rowCount = 100;
+  static const double _pixelsPerFrame = 12;
+
+  double _scrollOffset = 0;
+
+  @override
+  void onBeginFrame(Duration duration) {
+    final Size size = window.physicalSize;
+    const double listHeight = _rowHeight * _rowCount;
+    _scrollOffset = (_scrollOffset + _pixelsPerFrame) % listHeight;
+
+    final SceneBuilder builder = SceneBuilder();
+    builder.pushClipRect(Offset.zero & size);
+    final int firstRow = _scrollOffset ~/ _rowHeight;
+    for (int row = firstRow; row * _rowHeight < _scrollOffset + size.height; row += 1) {
+      builder.addPicture(
+        Offset(0, row * _rowHeight - _scrollOffset),
+        _recordRow(row % _rowCount, size.width),
+      );
+    }
+    builder.pop();
+    final Scene scene = builder.build();
+    window.render(scene);
+    scene.dispose();
+  }
+
+  Picture _recordRow(int row, double width) {
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.drawRect(
+      Rect.fromLTWH(0, 0, width, _rowHeight),
+      Paint()..color = row.isEven ? const Color(0xFFFFFFFF) : const Color(0xFFEEEEEE),
+    );
+    canvas.drawCircle(
+      const Offset(_rowHeight / 2, _rowHeight / 2),
+      _rowHeight / 3,
+      Paint()..color = Color.fromARGB(255, (row * 37) % 256, 120, 200),
+    );
+    canvas.drawRRect(
+      RRect.fromLTRBR(_rowHeight, _rowHeight / 3, width - 40, _rowHeight * 2 / 3, const Radius.circular(8)),
+      Paint()..color = const Color(0xFF9E9E9E),
+    );
+    return recorder.endRecording();
+  }
+
+  @override
+  void onDrawFrame() {
+    window.scheduleFrame();
+  }
+}
+
+/// Animated content drawn beneath a backdrop blur that covers the lower half
+/// of the viewport, which has to be blurred again on every frame.
+class BackdropBlurScenario extends Scenario {
+  /// Creates the BackdropBlur scenario.
+  ///
+  /// The [dispatcher] parameter must not be null.
+  BackdropBlurScenario(PlatformDispatcher dispatcher)
+      : assert(dispatcher != null),
+        super(dispatcher);
+
+  static const double _squareSize = 200;
+
+  int _frame = 0;
+
+  @override
+  void onBeginFrame(Duration duration) {
+    final Size size = window.physicalSize;
+    _frame += 1;
+
+    final PictureRecorder recorder = PictureRecorder();
+    final Canvas canvas = Canvas(recorder);
+    canvas.drawPaint(Paint()..color = const Color(0xFFFFFFFF));
+    for (int i = 0; i < 8; i += 1) {
+      final double left = (_frame * (i + 1) * 3 + i * 90) % (size.width + _squareSize) - _squareSize;
+      canvas.drawRect(
+        Rect.fromLTWH(left, i * size.height / 8, _squareSize, _squareSize),
+        Paint()..color = Color.fromARGB(255, 255 - i * 30, i * 30, 128),
+      );
+    }
+
+    final SceneBuilder builder = SceneBuilder();
+    builder.addPicture(Offset.zero, recorder.endRecording(), willChangeHint: true);
+    builder.pushClipRect(Rect.fromLTRB(0, size.height / 2, size.width, size.height));
+    builder.pushBackdropFilter(ImageFilter.blur(sigmaX: 20, sigmaY: 20));
+    builder.pop();
+    builder.pop();
+    final Scene scene = builder.build();
+    window.render(scene);
+    scene.dispose();
+  }
+
+  @override
+  void onDrawFrame() {
+    window.scheduleFrame();
+  }
+}
@@ -0,0 +1,194 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// @dart = 2.6
+import 'dart:async';
+import 'dart:convert';
+import 'dart:developer' as developer;
+import 'dart:io';
+import 'dart:typed_data';
+import 'dart:ui';
+
+import 'scenario.dart';
+
+/// Runs another scenario for a fixed duration, producing a new frame on every
+/// vsync, and reports how the frames were paced.
+///
+/// Once done, the results are sent to the platform as JSON on the
+/// `benchmark_results` channel, and printed on a single line starting with
+/// `BENCHMARK_RESULTS: `. They contain the percentiles of the [FrameTiming]
+/// durations in microseconds, the number of vsyncs that were missed, and the
+/// memory used by the engine when the benchmark ends. The memory is only
+/// reported where the VM service is available, that is in debug and profile
+/// builds.
+class FramePacingBenchmark extends Scenario {
+  /// Creates a benchmark of the scenario [name], which was created by
+  /// [scenario].
+  ///
+  /// The [dispatcher] parameter must not be null.
+  FramePacingBenchmark(
+    PlatformDispatcher dispatcher,
+    this.name,
+    this.scenario,
+    this.duration,
+  )   : assert(dispatcher != null),
+        assert(scenario != null),
+        assert(duration != null),
+        super(dispatcher) {
+    dispatcher.onReportTimings = _timings.addAll;
+    _timer = Timer(duration, _finish);
+  }
+
+  /// The name of the benchmarked scenario.
+  final String name;
+
+  /// The benchmarked scenario.
+  final Scenario scenario;
+
+  /// How long frames are produced for.
+  final Duration duration;
+
+  // The timings of the frames are reported in batches, at least once per
+  // second, so the results wait for the last batch.
+  static const Duration _lastTimingsDelay = Duration(milliseconds: 1500);
+
+  final List<FrameTiming> _timings = <FrameTiming>[];
+  Timer _timer;
+  bool _running = true;
+
+  @override
+  void onBeginFrame(Duration duration) {
+    if (_running) {
+      scenario.onBeginFrame(duration);
+    }
+  }
+
+  @override
+  void onDrawFrame() {
+    // The scenario's own [onDrawFrame] is skipped, as it may stop producing
+    // frames or ask for a screenshot.
+    if (_running) {
+      dispatcher.scheduleFrame();
+    }
+  }
+
+  @override
+  void unmount() {
+    _running = false;
+    _timer?.cancel();
+    dispatcher.onReportTimings = null;
+    scenario.unmount();
+    super.unmount();
+  }
+
+  @override
+  void onMetricsChanged() => scenario.onMetricsChanged();
+
+  @override
+  void onPointerDataPacket(PointerDataPacket packet) => scenario.onPointerDataPacket(packet);
+
+  @override
+  void onPlatformMessage(
+    String name,
+    ByteData data,
+    PlatformMessageResponseCallback callback,
+  ) {
+    scenario.onPlatformMessage(name, data, callback);
+  }
+
+  Future<void> _finish() async {
+    _running = false;
+    await Future<void>.delayed(_lastTimingsDelay);
+    dispatcher.onReportTimings = null;
+
+    final Map<String, dynamic> refreshRate = await _callServiceExtension('_flutter.getDisplayRefreshRate');
+    final Map<String, dynamic> memory = await _callServiceExtension('_flutter.getMemoryBreakdown');
+    double fps = refreshRate == null ? 0 : (refreshRate['fps'] as num).toDouble();
+    if (fps <= 0) {
+      fps = 60;
+    }
+
+    final String results = json.encode(<String, dynamic>{
+      'scenario': name,
+      'platform': Platform.operatingSystem,
+      'durationMicros': duration.inMicroseconds,
+      'refreshRate': fps,
+      'frameCount': _timings.length,
+      ..._summarizeFrames(_timings, Duration(microseconds: (Duration.microsecondsPerSecond / fps).round())),
+      'memory': memory == null ? null : <String, dynamic>{
+        'gpuResourceBytes': (memory['gpuResources'] as Map<String, dynamic>)['bytes'],
+        'rasterCache': memory['rasterCache'],
+        'decodedImageCacheBytes': memory['decodedImageCacheBytes'],
+        'dartHeap': memory['dartHeap'],
+      },
+    });
+    print('BENCHMARK_RESULTS: $results');
+    dispatcher.sendPlatformMessage(
+      'benchmark_results',
+      Uint8List.fromList(utf8.encode(results)).buffer.asByteData(),
+      null,
+    );
+  }
+}
+
+Map<String, dynamic> _summarizeFrames(List<FrameTiming> timings, Duration frameBudget) {
+  int missedVsyncs = 0;
+  int missedFrames = 0;
+  for (final FrameTiming timing in timings) {
+    // A frame that took more than one vsync interval from the vsync to the
+    // end of its rasterization held the previous frame on screen for as many
+    // intervals as it overran.
+    final int missed = timing.totalSpan.inMicroseconds ~/ frameBudget.inMicroseconds;
+    missedVsyncs += missed;
+    if (missed > 0) {
+      missedFrames += 1;
+    }
+  }
+  return <String, dynamic>{
+    'frameBudgetMicros': frameBudget.inMicroseconds,
+    'missedVsyncs': missedVsyncs,
+    'missedFrames': missedFrames,
+    'buildMicros': _percentiles(timings.map((FrameTiming timing) => timing.buildDuration)),
+    'rasterMicros': _percentiles(timings.map((FrameTiming timing) => timing.rasterDuration)),
+    'vsyncOverheadMicros': _percentiles(timings.map((FrameTiming timing) => timing.vsyncOverhead)),
+    'totalSpanMicros': _percentiles(timings.map((FrameTiming timing) => timing.totalSpan)),
+  };
+}
+
+Map<String, int> _percentiles(Iterable<Duration> durations) {
+  final List<int> micros = durations.map((Duration duration) => duration.inMicroseconds).toList()..sort();
+  if (micros.isEmpty) {
+    return null;
+  }
+  int percentile(double p) => micros[((micros.length - 1) * p).round()];
+  return <String, int>{
+    'p50': percentile(0.5),
+    'p90': percentile(0.9),
+    'p99': percentile(0.99),
+    'max': micros.last,
+  };
+}
+
+/// Calls a method of the VM service of this isolate's VM, if it is
+/// available, and returns its result.
+Future<Map<String, dynamic>> _callServiceExtension(String method) async {
+  final developer.ServiceProtocolInfo info = await developer.Service.getInfo();
+  if (info.serverUri == null) {
+    return null;
+  }
+  try {
+    final HttpClient client = HttpClient();
+    final HttpClientRequest request = await client.getUrl(info.serverUri.resolve(method));
+    final HttpClientResponse response = await request.close();
+    if (response.statusCode > 299) {
+      return null;
+    }
+    final Map<String, dynamic> body = json.decode(await utf8.decodeStream(response)) as Map<String, dynamic>;
+    client.close();
+    return body['result'] as Map<String, dynamic>;
+  } on Exception catch (error) {
+    print('Could not call $method: $error');
+    return null;
+  }
+}
@@ -6,6 +6,8 @@
 import 'dart:ui';
 
 import 'animated_color_square.dart';
+import 'benchmark_scenarios.dart';
+import 'frame_pacing_benchmark.dart';
 import 'initial_route_reply.dart';
 import 'locale_initialization.dart';
 import 'platform_view.dart';
@@ -43,6 +45,8 @@ Map<String, ScenarioFactory> _scenarios = <String, ScenarioFactory>{
   'tap_status_bar': () => TouchesScenario(PlatformDispatcher.instance),
   'text_semantics_focus': () => SendTextFocusSemantics(PlatformDispatcher.instance),
   'initial_route_reply': () => InitialRouteReply(PlatformDispatcher.instance),
+  'scrolling_list': () => ScrollingListScenario(PlatformDispatcher.instance),
+  'backdrop_blur': () => BackdropBlurScenario(PlatformDispatcher.instance),
 };
 
 Map<String, dynamic> _currentScenarioParams = <String, dynamic>{};
@@ -65,6 +69,28 @@ void loadScenario(Map<String, dynamic> scenario) {
   print('Loading scenario $scenarioName');
 }
 
+/// Loads a scenario like [loadScenario], and runs it as a
+/// [FramePacingBenchmark] for `duration_seconds`, which defaults to 10.
+void loadBenchmark(Map<String, dynamic> scenario) {
+  final String scenarioName = scenario['name'] as String;
+  assert(_scenarios[scenarioName] != null);
+  _currentScenarioParams = scenario;
+
+  if (_currentScenarioInstance != null) {
+    _currentScenarioInstance.unmount();
+  }
+
+  final int seconds = scenario['duration_seconds'] as int ?? 10;
+  _currentScenarioInstance = FramePacingBenchmark(
+    PlatformDispatcher.instance,
+    scenarioName,
+    _scenarios[scenarioName](),
+    Duration(seconds: seconds),
+  );
+  window.scheduleFrame();
+  print('Running benchmark $scenarioName for $seconds seconds');
+}
+
 /// Gets the loaded [Scenario].
 Scenario get currentScenario {
   return _currentScenarioInstance;
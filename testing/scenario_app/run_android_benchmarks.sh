@@ -0,0 +1,38 @@
+#!/bin/bash
+# Copyright 2013 The Flutter Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+# Runs the frame pacing benchmarks on a connected device that has the scenario
+# app installed, and pulls their JSON results into the given directory.
+#
+# Usage: ./run_android_benchmarks.sh <results directory> [seconds per scenario]
+
+set -e
+
+RESULTS_DIR="${1:?Usage: $0 <results directory> [seconds per scenario]}"
+SECONDS_PER_SCENARIO="${2:-10}"
+PACKAGE="dev.flutter.scenarios"
+DEVICE_RESULTS="/sdcard/Android/data/$PACKAGE/files/benchmark_results.json"
+
+# The platform view is composited as a texture unless use_android_view is set,
+# which stands in for a video texture.
+SCENARIOS=(
+  scrolling_list
+  backdrop_blur
+  platform_view_two_intersecting_overlays
+  platform_view
+)
+
+mkdir -p "$RESULTS_DIR"
+for scenario in "${SCENARIOS[@]}"; do
+  echo "Running $scenario for $SECONDS_PER_SCENARIO seconds"
+  adb shell rm -f "$DEVICE_RESULTS"
+  adb shell am start -W -S -n "$PACKAGE/.TextPlatformViewActivity" \
+    --es scenario "$scenario" --ei benchmark_seconds "$SECONDS_PER_SCENARIO"
+  # The activity finishes once it has written the results.
+  until adb shell ls "$DEVICE_RESULTS" > /dev/null 2>&1; do
+    sleep 1
+  done
+  adb pull "$DEVICE_RESULTS" "$RESULTS_DIR/$scenario.json"
+done
@@ -5,6 +5,8 @@
 #ifndef LIB_TONIC_DART_ARGS_H_
 #define LIB_TONIC_DART_ARGS_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
@@ -194,8 +196,130 @@ struct DartDispatcher<IndicesHolder<indices...>, ResultType (C::*)(ArgTypes...)>
   }
 };
 
+// Describes how arguments of primitive types are read with
+// Dart_GetNativeArguments. The conversions match the ones of |DartConverter|.
+template <typename T, typename Enable = void>
+struct DartNativeArgument {
+  static constexpr bool kIsPrimitive = false;
+};
+
+template <>
+struct DartNativeArgument<bool> {
+  static constexpr bool kIsPrimitive = true;
+  static constexpr Dart_NativeArgument_Type kType = Dart_NativeArgument_kBool;
+
+  static bool Get(const Dart_NativeArgument_Value& value) {
+    return value.as_bool;
+  }
+};
+
+template <typename T>
+struct DartNativeArgument<
+    T,
+    typename std::enable_if<(std::is_integral<T>::value &&
+                             !std::is_same<T, bool>::value) ||
+                            std::is_enum<T>::value>::type> {
+  static constexpr bool kIsPrimitive = true;
+  static constexpr Dart_NativeArgument_Type kType = Dart_NativeArgument_kInt64;
+
+  static T Get(const Dart_NativeArgument_Value& value) {
+    return static_cast<T>(value.as_int64);
+  }
+};
+
+template <typename T>
+struct DartNativeArgument<
+    T,
+    typename std::enable_if<std::is_floating_point<T>::value>::type> {
+  static constexpr bool kIsPrimitive = true;
+  static constexpr Dart_NativeArgument_Type kType = Dart_NativeArgument_kDouble;
+
+  static T Get(const Dart_NativeArgument_Value& value) {
+    return static_cast<T>(value.as_double);
+  }
+};
+
+template <typename T>
+using DartNativeArgumentFor = DartNativeArgument<
+    typename std::remove_const<typename std::remove_reference<T>::type>::type>;
+
+// Calls methods whose arguments are all primitives after reading the receiver
+// and the arguments with a single Dart_GetNativeArguments call, instead of one
+// Dart API call per argument. This is the bulk of the cost of small, hot calls
+// like the drawing methods of a canvas or the verbs of a path.
+//
+// |Call| returns false without side effects if the arguments could not be read
+// that way, e.g. for a disposed receiver, in which case the caller must fall
+// back to the generic path that reports the error.
+template <typename Sig>
+struct DartFastCall {
+  static constexpr bool kSupported = false;
+};
+
+template <typename C, typename ResultType, typename... ArgTypes>
+struct DartFastCallMethod {
+  static constexpr bool kSupported =
+      sizeof...(ArgTypes) > 0 &&
+      (DartNativeArgumentFor<ArgTypes>::kIsPrimitive && ...);
+
+  template <typename Method>
+  static bool Call(Method func, Dart_NativeArguments args) {
+    return Call(func, args, std::index_sequence_for<ArgTypes...>());
+  }
+
+ private:
+  template <typename Method, size_t... indices>
+  static bool Call(Method func,
+                   Dart_NativeArguments args,
+                   std::index_sequence<indices...>) {
+    constexpr size_t kCount = sizeof...(ArgTypes) + 1;
+    intptr_t native_fields[DartWrappable::kNumberOfNativeFields] = {};
+    Dart_NativeArgument_Descriptor descriptors[kCount] = {
+        {static_cast<uint8_t>(Dart_NativeArgument_kNativeFields), 0},
+        {static_cast<uint8_t>(DartNativeArgumentFor<ArgTypes>::kType),
+         static_cast<uint8_t>(indices + 1)}...};
+    Dart_NativeArgument_Value values[kCount];
+    values[0].as_native_fields.num_fields =
+        DartWrappable::kNumberOfNativeFields;
+    values[0].as_native_fields.values = native_fields;
+    if (Dart_IsError(Dart_GetNativeArguments(args, kCount, descriptors,
+                                             values))) {
+      return false;
+    }
+    auto* receiver = reinterpret_cast<DartWrappable*>(
+        native_fields[DartWrappable::kPeerIndex]);
+    if (!receiver) {
+      return false;
+    }
+    C* object = static_cast<C*>(receiver);
+    if constexpr (std::is_void<ResultType>::value) {
+      (object->*func)(
+          DartNativeArgumentFor<ArgTypes>::Get(values[indices + 1])...);
+    } else {
+      DartReturn(
+          (object->*func)(
+              DartNativeArgumentFor<ArgTypes>::Get(values[indices + 1])...),
+          args);
+    }
+    return true;
+  }
+};
+
+template <typename C, typename ResultType, typename... ArgTypes>
+struct DartFastCall<ResultType (C::*)(ArgTypes...)>
+    : public DartFastCallMethod<C, ResultType, ArgTypes...> {};
+
+template <typename C, typename ResultType, typename... ArgTypes>
+struct DartFastCall<ResultType (C::*)(ArgTypes...) const>
+    : public DartFastCallMethod<C, ResultType, ArgTypes...> {};
+
 template <typename Sig>
 void DartCall(Sig func, Dart_NativeArguments args) {
+  if constexpr (DartFastCall<Sig>::kSupported) {
+    if (DartFastCall<Sig>::Call(func, args)) {
+      return;
+    }
+  }
   DartArgIterator it(args);
   using Indices = typename IndicesForSignature<Sig>::type;
   DartDispatcher<Indices, Sig> decoder(&it);
@@ -57,6 +57,18 @@ void DartWeakPersistentValue::Clear() {
   handle_ = nullptr;
 }
 
+void DartWeakPersistentValue::UpdateExternalSize(
+    intptr_t external_allocation_size) {
+  if (!handle_) {
+    return;
+  }
+  auto dart_state = dart_state_.lock();
+  if (!dart_state || dart_state->IsShuttingDown()) {
+    return;
+  }
+  Dart_UpdateExternalSize(handle_, external_allocation_size);
+}
+
 Dart_Handle DartWeakPersistentValue::Get() {
   auto dart_state = dart_state_.lock();
   TONIC_DCHECK(dart_state);
@@ -34,6 +34,11 @@ class DartWeakPersistentValue {
   void Clear();
   Dart_Handle Get();
 
+  // Reports a new size of the native memory held on behalf of the object to
+  // the Dart garbage collector. Must be called on the mutator thread of the
+  // isolate that holds the handle. Does nothing if the handle is empty.
+  void UpdateExternalSize(intptr_t external_allocation_size);
+
   const std::weak_ptr<DartState>& dart_state() const { return dart_state_; }
 
  private:
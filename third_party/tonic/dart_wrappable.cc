@@ -80,6 +80,10 @@ void DartWrappable::ClearDartWrapper() {
   this->ReleaseDartWrappableReference();
 }
 
+void DartWrappable::UpdateAllocationSize() {
+  dart_wrapper_.UpdateExternalSize(GetAllocationSize());
+}
+
 void DartWrappable::FinalizeDartWrapper(void* isolate_callback_data,
                                         void* peer) {
   DartWrappable* wrappable = reinterpret_cast<DartWrappable*>(peer);
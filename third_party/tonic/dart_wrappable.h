@@ -40,6 +40,11 @@ class DartWrappable {
   // Implement using IMPLEMENT_WRAPPERTYPEINFO macro
   virtual size_t GetAllocationSize() const;
 
+  // Call this when the value returned by GetAllocationSize changes while the
+  // object has a Dart wrapper, e.g. once the native resources it wraps are
+  // created lazily. Must be called on the mutator thread.
+  void UpdateAllocationSize();
+
   virtual void RetainDartWrappableReference() const = 0;
 
   virtual void ReleaseDartWrappableReference() const = 0;
@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "tonic/dart_args.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+enum class Verb { kMove, kLine };
+
+class Receiver : public tonic::DartWrappable {
+ public:
+  void Primitives(double x, float y, int count, bool flag, Verb verb) {}
+  int ConstPrimitives(double value) const { return 0; }
+  void String(const std::string& value) {}
+  void Mixed(double x, const std::string& value) {}
+  void NoArguments() {}
+};
+
+}  // namespace
+
+TEST(DartArgs, PrimitiveMethodsUseTheFastPath) {
+  ASSERT_TRUE(tonic::DartFastCall<decltype(&Receiver::Primitives)>::kSupported);
+  ASSERT_TRUE(
+      tonic::DartFastCall<decltype(&Receiver::ConstPrimitives)>::kSupported);
+}
+
+TEST(DartArgs, OtherMethodsUseTheGenericPath) {
+  ASSERT_FALSE(tonic::DartFastCall<decltype(&Receiver::String)>::kSupported);
+  ASSERT_FALSE(tonic::DartFastCall<decltype(&Receiver::Mixed)>::kSupported);
+  ASSERT_FALSE(
+      tonic::DartFastCall<decltype(&Receiver::NoArguments)>::kSupported);
+}
+
+TEST(DartArgs, PrimitiveArgumentsConvertLikeTheirConverters) {
+  Dart_NativeArgument_Value value;
+  value.as_int64 = 0x100000001;
+  ASSERT_EQ(tonic::DartNativeArgument<int>::Get(value), 1);
+  ASSERT_EQ(tonic::DartNativeArgument<Verb>::Get(value), Verb::kLine);
+  value.as_double = 1.5;
+  ASSERT_EQ(tonic::DartNativeArgument<float>::Get(value), 1.5f);
+  value.as_bool = true;
+  ASSERT_TRUE(tonic::DartNativeArgument<bool>::Get(value));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -131,6 +131,42 @@ TEST_F(DartWeakPersistentHandle, ClearLaterDart) {
   event.Wait();
 }
 
+static int64_t GetExternalHeapBytes() {
+  Dart_IsolateGroup group = Dart_CurrentIsolateGroup();
+  return Dart_IsolateGroupHeapNewExternalMetric(group) +
+         Dart_IsolateGroupHeapOldExternalMetric(group);
+}
+
+TEST_F(DartWeakPersistentHandle, UpdateExternalSize) {
+  auto weak_persistent_value = tonic::DartWeakPersistentValue();
+
+  fml::AutoResetWaitableEvent event;
+  int64_t external_bytes_growth = 0;
+
+  AddNativeCallback(
+      "GiveObjectToNative", CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+        auto handle = Dart_GetNativeArgument(args, 0);
+
+        auto dart_state = tonic::DartState::Current();
+        ASSERT_TRUE(dart_state);
+        weak_persistent_value.Set(dart_state, handle, nullptr, 0, NopFinalizer);
+
+        const int64_t before = GetExternalHeapBytes();
+        weak_persistent_value.UpdateExternalSize(1 << 20);
+        external_bytes_growth = GetExternalHeapBytes() - before;
+
+        weak_persistent_value.Clear();
+
+        event.Signal();
+      }));
+
+  ASSERT_TRUE(RunWithEntrypoint("callGiveObjectToNative"));
+
+  event.Wait();
+
+  ASSERT_EQ(external_bytes_growth, 1 << 20);
+}
+
 // Handle outside the test body scope so it survives until isolate shutdown.
 tonic::DartWeakPersistentValue global_weak_persistent_value =
     tonic::DartWeakPersistentValue();
@@ -44,6 +44,21 @@ TypedList<kTypeName, ElemType>::~TypedList() {
   Release();
 }
 
+template <Dart_TypedData_Type kTypeName, typename ElemType>
+TypedList<kTypeName, ElemType>& TypedList<kTypeName, ElemType>::operator=(
+    TypedList<kTypeName, ElemType>&& other) {
+  if (this != &other) {
+    Release();
+    data_ = other.data_;
+    num_elements_ = other.num_elements_;
+    dart_handle_ = other.dart_handle_;
+    other.data_ = nullptr;
+    other.num_elements_ = 0;
+    other.dart_handle_ = nullptr;
+  }
+  return *this;
+}
+
 template <Dart_TypedData_Type kTypeName, typename ElemType>
 void TypedList<kTypeName, ElemType>::Release() {
   if (data_) {
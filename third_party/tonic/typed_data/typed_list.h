@@ -14,6 +14,11 @@ namespace tonic {
 // Dart_TypedDataAcquireData to obtain a raw pointer to the data, which is
 // released when this object is destroyed.
 //
+// The wrapper is a move-only view of the data: engine code should consume the
+// elements in place, e.g. through |data_as|, for the duration of the native
+// call rather than copy them. No Dart API may be called while the data is
+// acquired.
+//
 // This is designed to be used with DartConverter only.
 template <Dart_TypedData_Type kTypeName, typename ElemType>
 class TypedList {
@@ -23,6 +28,9 @@ class TypedList {
   TypedList();
   ~TypedList();
 
+  TypedList<kTypeName, ElemType>& operator=(
+      TypedList<kTypeName, ElemType>&& other);
+
   ElemType& at(intptr_t i) {
     TONIC_CHECK(0 <= i);
     TONIC_CHECK(i < num_elements_);
@@ -41,12 +49,37 @@ class TypedList {
   intptr_t num_elements() const { return num_elements_; }
   Dart_Handle dart_handle() const { return dart_handle_; }
 
+  const ElemType* begin() const { return data_; }
+  const ElemType* end() const { return data_ + num_elements_; }
+
+  // Views the elements in place as an array of |T| made of |ElemType|s, e.g.
+  // the floats of a Float32List as points or rects. Trailing elements that do
+  // not make up a whole |T| are not part of the view.
+  template <typename T>
+  const T* data_as() const {
+    static_assert(sizeof(T) % sizeof(ElemType) == 0,
+                  "T must be made of whole elements.");
+    static_assert(alignof(T) <= alignof(ElemType),
+                  "T must not be more aligned than the elements.");
+    return reinterpret_cast<const T*>(data_);
+  }
+
+  // The number of whole |T|s in the view returned by |data_as|.
+  template <typename T>
+  intptr_t num_elements_as() const {
+    return num_elements_ / (sizeof(T) / sizeof(ElemType));
+  }
+
   void Release();
 
  private:
   ElemType* data_;
   intptr_t num_elements_;
   Dart_Handle dart_handle_;
+
+  TypedList(const TypedList<kTypeName, ElemType>& other) = delete;
+  TypedList<kTypeName, ElemType>& operator=(
+      const TypedList<kTypeName, ElemType>& other) = delete;
 };
 
 template <Dart_TypedData_Type kTypeName, typename ElemType>
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <minikin/FontCollection.h>
+
+#include "flutter/fml/logging.h"
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
+#include "third_party/benchmark/include/benchmark/benchmark_api.h"
+#include "third_party/icu/source/common/unicode/unistr.h"
+#include "txt/font_collection.h"
+
+namespace txt {
+
+// Itemizes |text| with a collection of Roboto followed by a CJK family.
+static void ItemizeText(benchmark::State& state, const char* text) {
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+  std::shared_ptr<minikin::FontCollection> collection =
+      GetTestFontCollection()->GetMinikinFontCollectionForFamilies(
+          {"Roboto", "Noto Sans CJK JP"}, "en-US");
+  FML_CHECK(collection);
+  const minikin::FontStyle style;
+
+  std::vector<minikin::FontCollection::Run> runs;
+  while (state.KeepRunning()) {
+    runs.clear();
+    collection->itemize(reinterpret_cast<const uint16_t*>(u16_text.data()),
+                        u16_text.size(), style, &runs);
+  }
+  state.SetItemsProcessed(state.iterations() * u16_text.size());
+}
+
+static void BM_FontCollectionItemizeAscii(benchmark::State& state) {
+  ItemizeText(state,
+              "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Duis "
+              "dignissim, ipsum non auctor eleifend, nisl nunc tristique "
+              "urna, vel volutpat justo erat eu est. Fusce tincidunt urna "
+              "libero, quis efficitur sapien bibendum at.");
+}
+BENCHMARK(BM_FontCollectionItemizeAscii);
+
+static void BM_FontCollectionItemizeLatin1(benchmark::State& state) {
+  ItemizeText(state,
+              "Après le déjeuner, nous irons au café près de la forêt. "
+              "Über den Straßen, hören wir die Vögel; ¿qué tal, señor? "
+              "Ça fait très longtemps — à bientôt, garçon.");
+}
+BENCHMARK(BM_FontCollectionItemizeLatin1);
+
+static void BM_FontCollectionItemizeMixedScripts(benchmark::State& state) {
+  ItemizeText(state,
+              "Hello 世界, this is a 試験 of mixed text: 日本語の文章と "
+              "English words alternate, 東京 and Kyoto, 大阪 and Osaka.");
+}
+BENCHMARK(BM_FontCollectionItemizeMixedScripts);
+
+}  // namespace txt
@@ -33,6 +33,7 @@
 #include "txt/font_weight.h"
 #include "txt/paragraph.h"
 #include "txt/paragraph_builder_txt.h"
+#include "txt/paragraph_txt.h"
 
 namespace txt {
 
@@ -245,6 +246,43 @@ BENCHMARK_REGISTER_F(ParagraphFixture, StylesBigO)
     ->Range(1 << 3, 1 << 12)
     ->Complexity(benchmark::oN);
 
+BENCHMARK_F(ParagraphFixture, TableCellsLayout)(benchmark::State& state) {
+  // Cells of a data table repeat a few labels, which share their shaping.
+  const std::vector<std::u16string> labels = {
+      u"Buy", u"Sell", u"$1,234.56", u"$78.90", u"Pending", u"Filled",
+      u"Quantity", u"Price", u"12:30:45", u"-0.25%"};
+
+  txt::ParagraphStyle paragraph_style;
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  text_style.font_features.SetFeature("tnum", 1);
+
+  std::vector<std::unique_ptr<ParagraphTxt>> cells;
+  for (size_t i = 0; i < 500; ++i) {
+    txt::ParagraphBuilderTxt builder(paragraph_style, font_collection_);
+    builder.PushStyle(text_style);
+    builder.AddText(labels[i % labels.size()]);
+    builder.Pop();
+    cells.push_back(BuildParagraph(builder));
+  }
+
+  const minikin::LayoutCacheStats before = minikin::Layout::getCacheStats();
+  while (state.KeepRunning()) {
+    for (auto& cell : cells) {
+      cell->SetDirty();
+      cell->Layout(100);
+    }
+  }
+  const minikin::LayoutCacheStats after = minikin::Layout::getCacheStats();
+  const size_t hits = after.hitCount - before.hitCount;
+  const size_t lookups = hits + after.missCount - before.missCount;
+  if (lookups > 0) {
+    state.SetLabel("shaping cache hit rate " +
+                   std::to_string(100 * hits / lookups) + "%");
+  }
+}
+
 BENCHMARK_F(ParagraphFixture, PaintSimple)(benchmark::State& state) {
   const char* text = "Hello world! This is a simple sentence to test drawing.";
   auto icu_text = icu::UnicodeString::fromUTF8(text);
@@ -35,4 +35,28 @@ static void BM_StyledRunsGetRun(benchmark::State& state) {
 }
 BENCHMARK(BM_StyledRunsGetRun);
 
+// Rich text with many spans usually alternates between a few styles.
+static void BM_StyledRunsAddRepeatedStyles(benchmark::State& state) {
+  std::vector<TextStyle> styles(4);
+  for (size_t i = 0; i < styles.size(); ++i) {
+    styles[i].font_families = {"Roboto", "Noto Color Emoji"};
+    styles[i].locale = "en-US";
+    styles[i].font_weight = i % 2 ? FontWeight::w700 : FontWeight::w400;
+    styles[i].color = i < 2 ? SK_ColorBLACK : SK_ColorBLUE;
+    styles[i].text_shadows.emplace_back(SK_ColorBLACK, SkPoint::Make(1, 1), 2);
+    styles[i].font_features.SetFeature("tnum", 1);
+  }
+  const size_t span_count = state.range(0);
+  while (state.KeepRunning()) {
+    StyledRuns runs;
+    for (size_t i = 0; i < span_count; ++i) {
+      runs.StartRun(runs.AddStyle(styles[i % styles.size()]), i * 10);
+    }
+    runs.EndRunIfNeeded(span_count * 10);
+  }
+}
+BENCHMARK(BM_StyledRunsAddRepeatedStyles)
+    ->RangeMultiplier(4)
+    ->Range(1 << 4, 1 << 10);
+
 }  // namespace txt
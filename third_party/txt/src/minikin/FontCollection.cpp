@@ -19,6 +19,7 @@
 #define LOG_TAG "Minikin"
 
 #include <algorithm>
+#include <cstring>
 
 #include <log/log.h>
 #include "unicode/unistr.h"
@@ -43,7 +44,7 @@ static inline T max(T a, T b) {
 const uint32_t EMOJI_STYLE_VS = 0xFE0F;
 const uint32_t TEXT_STYLE_VS = 0xFE0E;
 
-uint32_t FontCollection::sNextId = 0;
+std::atomic<uint32_t> FontCollection::sNextId{0};
 
 // libtxt: return a locale string for a language list ID
 std::string GetFontLocale(uint32_t langListId) {
@@ -66,7 +67,6 @@ FontCollection::FontCollection(
 
 void FontCollection::init(
     const vector<std::shared_ptr<FontFamily>>& typefaces) {
-  std::scoped_lock _l(gMinikinLock);
   mId = sNextId++;
   vector<uint32_t> lastChar;
   size_t nTypefaces = typefaces.size();
@@ -125,6 +125,13 @@ void FontCollection::init(
   // See the comment in Range for more details.
   LOG_ALWAYS_FATAL_IF(mFamilyVec.size() >= 0xFFFF,
                       "Exceeded the maximum indexable cmap coverage.");
+
+  const SparseBitSet& firstCoverage = mFamilies[0]->getCoverage();
+  for (uint32_t c = 0; c < 0x100; c++) {
+    if (firstCoverage.get(c)) {
+      mFirstFamilyLatin1Coverage[c >> 6] |= uint64_t(1) << (c & 63);
+    }
+  }
 }
 
 // Special scores for the font fallback.
@@ -369,6 +376,7 @@ const std::shared_ptr<FontFamily>& FontCollection::findFallbackFont(
     uint32_t langListId) const {
   std::string locale = GetFontLocale(langListId);
 
+  std::scoped_lock lock(mCachedFallbackFamiliesMutex);
   const auto it = mCachedFallbackFamilies.find(locale);
   if (it != mCachedFallbackFamilies.end()) {
     for (const auto& fallbackFamily : it->second) {
@@ -428,8 +436,6 @@ bool FontCollection::hasVariationSelector(uint32_t baseCodepoint,
     return false;
   }
 
-  std::scoped_lock _l(gMinikinLock);
-
   // Currently mRanges can not be used here since it isn't aware of the
   // variation sequence.
   for (size_t i = 0; i < mVSFamilyVec.size(); i++) {
@@ -456,6 +462,30 @@ bool FontCollection::hasVariationSelector(uint32_t baseCodepoint,
   return false;
 }
 
+size_t FontCollection::firstFamilyLatin1SpanLength(const uint16_t* string,
+                                                   size_t size) const {
+  auto isCovered = [this](uint16_t c) {
+    return c < 0x100 &&
+           (mFirstFamilyLatin1Coverage[c >> 6] >> (c & 63) & 1) != 0;
+  };
+  size_t i = 0;
+  // Check four code units at a time for one outside of Latin-1, which ends
+  // the span, before looking up their coverage.
+  for (; i + 4 <= size; i += 4) {
+    uint64_t block;
+    memcpy(&block, string + i, sizeof(block));
+    if ((block & 0xFF00FF00FF00FF00ull) != 0 ||
+        !(isCovered(string[i]) && isCovered(string[i + 1]) &&
+          isCovered(string[i + 2]) && isCovered(string[i + 3]))) {
+      break;
+    }
+  }
+  while (i < size && isCovered(string[i])) {
+    i++;
+  }
+  return i;
+}
+
 void FontCollection::itemize(const uint16_t* string,
                              size_t string_size,
                              FontStyle style,
@@ -530,6 +560,30 @@ void FontCollection::itemize(const uint16_t* string,
     }
     prevCh = ch;
     run->end = nextUtf16Pos;  // exclusive
+
+    // Latin-1 characters that the first family covers are given to it
+    // whatever the style, and none of them is a variation selector, a
+    // combining mark or an emoji modifier. So a run of the first family
+    // extends over them without looking each up. The last one is left to the
+    // loop, as it may be followed by a variation selector.
+    if (lastFamily == mFamilies[0].get() && nextCh < 0x100) {
+      size_t span = firstFamilyLatin1SpanLength(string + nextUtf16Pos,
+                                                string_size - nextUtf16Pos);
+      if (nextUtf16Pos + span < string_size && span > 0) {
+        span--;
+      }
+      if (span > 0) {
+        nextUtf16Pos += span;
+        run->end = nextUtf16Pos;
+        prevCh = string[nextUtf16Pos - 1];
+        readLength = nextUtf16Pos;
+        if (readLength < string_size) {
+          U16_NEXT(string, readLength, string_size, nextCh);
+        } else {
+          nextCh = kEndOfString;
+        }
+      }
+    }
   } while (nextCh != kEndOfString);
 }
 
@@ -17,8 +17,11 @@
 #ifndef MINIKIN_FONT_COLLECTION_H
 #define MINIKIN_FONT_COLLECTION_H
 
+#include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -121,8 +124,13 @@ class FontCollection {
   static uint32_t calcVariantMatchingScore(int variant,
                                            const FontFamily& fontFamily);
 
+  // Returns how many code units at the start of |string| are Latin-1
+  // characters that the first family covers.
+  size_t firstFamilyLatin1SpanLength(const uint16_t* string,
+                                     size_t size) const;
+
   // static for allocating unique id's
-  static uint32_t sNextId;
+  static std::atomic<uint32_t> sNextId;
 
   // unique id for this font collection (suitable for cache key)
   uint32_t mId;
@@ -147,6 +155,10 @@ class FontCollection {
   // subtables.
   std::vector<std::shared_ptr<FontFamily>> mVSFamilyVec;
 
+  // The Latin-1 characters the first family covers, one bit each. Itemize
+  // assigns runs of them to the first family without looking each up.
+  uint64_t mFirstFamilyLatin1Coverage[4] = {};
+
   // Set of supported axes in this collection.
   std::unordered_set<AxisTag> mSupportedAxes;
 
@@ -154,8 +166,11 @@ class FontCollection {
   std::unique_ptr<FallbackFontProvider> mFallbackFontProvider;
 
   // libtxt extension: Fallback fonts discovered after this font collection
-  // was constructed.
-  mutable std::map<std::string, std::vector<std::shared_ptr<FontFamily>>>
+  // was constructed. This is the only state of a collection that changes
+  // after construction, so that itemize can run on several threads. The
+  // families are kept in deques, as references to them are handed out.
+  mutable std::mutex mCachedFallbackFamiliesMutex;
+  mutable std::map<std::string, std::deque<std::shared_ptr<FontFamily>>>
       mCachedFallbackFamilies;
 };
 
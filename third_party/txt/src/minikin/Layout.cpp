@@ -20,8 +20,11 @@
 #include <unicode/ubidi.h>
 #include <unicode/utf16.h>
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>  // for debugging
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -48,7 +51,9 @@ const int kDirection_Mask = 0x1;
 struct LayoutContext {
   MinikinPaint paint;
   FontStyle style;
-  std::vector<hb_font_t*> hbFonts;  // parallel to mFaces
+  // Parallel to mFaces. These are sub fonts of the cached fonts, owned by
+  // this context, which carry the paint and scale of the layout.
+  std::vector<hb_font_t*> hbFonts;
 
   void clearHbFonts() {
     for (size_t i = 0; i < hbFonts.size(); i++) {
@@ -83,6 +88,7 @@ class LayoutCacheKey {
         mLetterSpacing(paint.letterSpacing),
         mPaintFlags(paint.paintFlags),
         mHyphenEdit(paint.hyphenEdit),
+        mFontFeatureSettings(paint.fontFeatureSettings),
         mIsRtl(dir),
         mHash(computeHash()) {}
   bool operator==(const LayoutCacheKey& other) const;
@@ -121,6 +127,7 @@ class LayoutCacheKey {
   float mLetterSpacing;
   int32_t mPaintFlags;
   HyphenEdit mHyphenEdit;
+  std::string mFontFeatureSettings;
   bool mIsRtl;
   // Note: any fields added to MinikinPaint must also be reflected here.
   // TODO: language matching (possibly integrate into style)
@@ -129,56 +136,110 @@ class LayoutCacheKey {
   android::hash_t computeHash() const;
 };
 
-class LayoutCache : private android::OnEntryRemoved<LayoutCacheKey, Layout*> {
+// The cache is split in shards, selected by the hash of the key, which each
+// have their own lock so that threads laying out different words rarely
+// contend. Words are laid out outside of the locks. Cached layouts are shared
+// with the threads reading them, which keep them alive if they get evicted.
+class LayoutCache {
  public:
-  LayoutCache() : mCache(kMaxEntries) {
-    mCache.setOnEntryRemovedListener(this);
+  void clear() {
+    for (Shard& shard : mShards) {
+      std::scoped_lock lock(shard.mutex);
+      shard.cache.clear();
+    }
   }
 
-  void clear() { mCache.clear(); }
-
-  Layout* get(LayoutCacheKey& key,
-              LayoutContext* ctx,
-              const std::shared_ptr<FontCollection>& collection) {
-    Layout* layout = mCache.get(key);
-    if (layout == NULL) {
-      key.copyText();
-      layout = new Layout();
-      key.doLayout(layout, ctx, collection);
-      mCache.put(key, layout);
+  LayoutCacheStats getStats() const {
+    LayoutCacheStats stats;
+    stats.hitCount = mHitCount;
+    stats.missCount = mMissCount;
+    for (const Shard& shard : mShards) {
+      std::scoped_lock lock(shard.mutex);
+      stats.entryCount += shard.cache.size();
+    }
+    return stats;
+  }
+
+  std::shared_ptr<const Layout> get(
+      LayoutCacheKey& key,
+      LayoutContext* ctx,
+      const std::shared_ptr<FontCollection>& collection) {
+    Shard& shard = mShards[key.hash() % kShardCount];
+    {
+      std::scoped_lock lock(shard.mutex);
+      std::shared_ptr<const Layout> layout = shard.cache.get(key);
+      if (layout) {
+        mHitCount++;
+        return layout;
+      }
     }
+    mMissCount++;
+    auto layout = std::make_shared<Layout>();
+    key.doLayout(layout.get(), ctx, collection);
+
+    std::scoped_lock lock(shard.mutex);
+    // Another thread may have laid out the same word in the meantime.
+    std::shared_ptr<const Layout> cached = shard.cache.get(key);
+    if (cached) {
+      return cached;
+    }
+    key.copyText();
+    shard.cache.put(key, layout);
     return layout;
   }
 
  private:
-  // callback for OnEntryRemoved
-  void operator()(LayoutCacheKey& key, Layout*& value) {
-    key.freeText();
-    delete value;
-  }
+  class Shard : private android::OnEntryRemoved<LayoutCacheKey,
+                                                std::shared_ptr<const Layout>> {
+   public:
+    Shard() : cache(kMaxEntries / kShardCount) {
+      cache.setOnEntryRemovedListener(this);
+    }
 
-  android::LruCache<LayoutCacheKey, Layout*> mCache;
+    mutable std::mutex mutex;
+    android::LruCache<LayoutCacheKey, std::shared_ptr<const Layout>> cache;
 
-  // static const size_t kMaxEntries = LruCache<LayoutCacheKey,
-  // Layout*>::kUnlimitedCapacity;
+   private:
+    // callback for OnEntryRemoved
+    void operator()(LayoutCacheKey& key,
+                    std::shared_ptr<const Layout>& /* value */) {
+      key.freeText();
+    }
+  };
 
   // TODO: eviction based on memory footprint; for now, we just use a constant
   // number of strings
   static const size_t kMaxEntries = 5000;
+  static const size_t kShardCount = 16;
+
+  Shard mShards[kShardCount];
+  std::atomic<size_t> mHitCount{0};
+  std::atomic<size_t> mMissCount{0};
 };
 
 class LayoutEngine {
  public:
   LayoutEngine() {
     unicodeFunctions = hb_unicode_funcs_create(hb_icu_get_unicode_funcs());
-    hbBuffer = hb_buffer_create();
-    hb_buffer_set_unicode_funcs(hbBuffer, unicodeFunctions);
   }
 
-  hb_buffer_t* hbBuffer;
   hb_unicode_funcs_t* unicodeFunctions;
   LayoutCache layoutCache;
 
+  // HarfBuzz buffers cannot be shared between threads, so each thread shapes
+  // into its own.
+  hb_buffer_t* getThreadHbBuffer() {
+    struct BufferDeleter {
+      void operator()(hb_buffer_t* buffer) { hb_buffer_destroy(buffer); }
+    };
+    thread_local std::unique_ptr<hb_buffer_t, BufferDeleter> buffer;
+    if (!buffer) {
+      buffer.reset(hb_buffer_create());
+      hb_buffer_set_unicode_funcs(buffer.get(), unicodeFunctions);
+    }
+    return buffer.get();
+  }
+
   static LayoutEngine& getInstance() {
     static LayoutEngine* instance = new LayoutEngine();
     return *instance;
@@ -191,6 +252,7 @@ bool LayoutCacheKey::operator==(const LayoutCacheKey& other) const {
          mScaleX == other.mScaleX && mSkewX == other.mSkewX &&
          mLetterSpacing == other.mLetterSpacing &&
          mPaintFlags == other.mPaintFlags && mHyphenEdit == other.mHyphenEdit &&
+         mFontFeatureSettings == other.mFontFeatureSettings &&
          mIsRtl == other.mIsRtl && mNchars == other.mNchars &&
          !memcmp(mChars, other.mChars, mNchars * sizeof(uint16_t));
 }
@@ -206,6 +268,9 @@ android::hash_t LayoutCacheKey::computeHash() const {
   hash = android::JenkinsHashMix(hash, hash_type(mLetterSpacing));
   hash = android::JenkinsHashMix(hash, hash_type(mPaintFlags));
   hash = android::JenkinsHashMix(hash, hash_type(mHyphenEdit.getHyphen()));
+  hash = android::JenkinsHashMixBytes(
+      hash, reinterpret_cast<const uint8_t*>(mFontFeatureSettings.data()),
+      mFontFeatureSettings.size());
   hash = android::JenkinsHashMix(hash, hash_type(mIsRtl));
   hash = android::JenkinsHashMixShorts(hash, mChars, mNchars);
   return android::JenkinsHashWhiten(hash);
@@ -254,34 +319,31 @@ static hb_bool_t harfbuzzGetGlyphHorizontalOrigin(hb_font_t* /* hbFont */,
   return true;
 }
 
-hb_font_funcs_t* getHbFontFuncs(bool forColorBitmapFont) {
-  assertMinikinLocked();
-
-  static hb_font_funcs_t* hbFuncs = nullptr;
-  static hb_font_funcs_t* hbFuncsForColorBitmap = nullptr;
-
-  hb_font_funcs_t** funcs =
-      forColorBitmapFont ? &hbFuncs : &hbFuncsForColorBitmap;
-  if (*funcs == nullptr) {
-    *funcs = hb_font_funcs_create();
-    if (forColorBitmapFont) {
-      // Don't override the h_advance function since we use HarfBuzz's
-      // implementation for emoji for performance reasons. Note that it is
-      // technically possible for a TrueType font to have outline and embedded
-      // bitmap at the same time. We ignore modified advances of hinted outline
-      // glyphs in that case.
-    } else {
-      // Override the h_advance function since we can't use HarfBuzz's
-      // implemenation. It may return the wrong value if the font uses hinting
-      // aggressively.
-      hb_font_funcs_set_glyph_h_advance_func(
-          *funcs, harfbuzzGetGlyphHorizontalAdvance, 0, 0);
-    }
-    hb_font_funcs_set_glyph_h_origin_func(
-        *funcs, harfbuzzGetGlyphHorizontalOrigin, 0, 0);
-    hb_font_funcs_make_immutable(*funcs);
+static hb_font_funcs_t* createHbFontFuncs(bool forColorBitmapFont) {
+  hb_font_funcs_t* funcs = hb_font_funcs_create();
+  if (forColorBitmapFont) {
+    // Don't override the h_advance function since we use HarfBuzz's
+    // implementation for emoji for performance reasons. Note that it is
+    // technically possible for a TrueType font to have outline and embedded
+    // bitmap at the same time. We ignore modified advances of hinted outline
+    // glyphs in that case.
+  } else {
+    // Override the h_advance function since we can't use HarfBuzz's
+    // implemenation. It may return the wrong value if the font uses hinting
+    // aggressively.
+    hb_font_funcs_set_glyph_h_advance_func(
+        funcs, harfbuzzGetGlyphHorizontalAdvance, 0, 0);
   }
-  return *funcs;
+  hb_font_funcs_set_glyph_h_origin_func(funcs, harfbuzzGetGlyphHorizontalOrigin,
+                                        0, 0);
+  hb_font_funcs_make_immutable(funcs);
+  return funcs;
+}
+
+hb_font_funcs_t* getHbFontFuncs(bool forColorBitmapFont) {
+  static hb_font_funcs_t* hbFuncs = createHbFontFuncs(false);
+  static hb_font_funcs_t* hbFuncsForColorBitmap = createHbFontFuncs(true);
+  return forColorBitmapFont ? hbFuncsForColorBitmap : hbFuncs;
 }
 
 static bool isColorBitmapFont(hb_font_t* font) {
@@ -316,7 +378,11 @@ int Layout::findFace(const FakedFont& face, LayoutContext* ctx) {
   // Note: ctx == NULL means we're copying from the cache, no need to create
   // corresponding hb_font object.
   if (ctx != NULL) {
-    hb_font_t* font = getHbFontLocked(face.font);
+    // The cached font is shared with other threads, so the paint and scale
+    // of this layout are set on a sub font of it.
+    hb_font_t* cachedFont = getHbFont(face.font);
+    hb_font_t* font = hb_font_create_sub_font(cachedFont);
+    hb_font_destroy(cachedFont);
     hb_font_set_funcs(font, getHbFontFuncs(isColorBitmapFont(font)),
                       &ctx->paint, 0);
     ctx->hbFonts.push_back(font);
@@ -325,10 +391,7 @@ int Layout::findFace(const FakedFont& face, LayoutContext* ctx) {
 }
 
 static hb_script_t codePointToScript(hb_codepoint_t codepoint) {
-  static hb_unicode_funcs_t* u = 0;
-  if (!u) {
-    u = LayoutEngine::getInstance().unicodeFunctions;
-  }
+  static hb_unicode_funcs_t* u = LayoutEngine::getInstance().unicodeFunctions;
   return hb_unicode_script(u, codepoint);
 }
 
@@ -588,8 +651,6 @@ void Layout::doLayout(const uint16_t* buf,
                       const FontStyle& style,
                       const MinikinPaint& paint,
                       const std::shared_ptr<FontCollection>& collection) {
-  std::scoped_lock _l(gMinikinLock);
-
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
@@ -612,8 +673,6 @@ float Layout::measureText(const uint16_t* buf,
                           const MinikinPaint& paint,
                           const std::shared_ptr<FontCollection>& collection,
                           float* advances) {
-  std::scoped_lock _l(gMinikinLock);
-
   LayoutContext ctx;
   ctx.style = style;
   ctx.paint = paint;
@@ -708,27 +767,15 @@ float Layout::doLayoutWord(const uint16_t* buf,
   float wordSpacing =
       count == 1 && isWordSpace(buf[start]) ? ctx->paint.wordSpacing : 0;
 
-  float advance;
-  if (ctx->paint.skipCache()) {
-    Layout layoutForWord;
-    key.doLayout(&layoutForWord, ctx, collection);
-    if (layout) {
-      layout->appendLayout(&layoutForWord, bufStart, wordSpacing);
-    }
-    if (advances) {
-      layoutForWord.getAdvances(advances);
-    }
-    advance = layoutForWord.getAdvance();
-  } else {
-    Layout* layoutForWord = cache.get(key, ctx, collection);
-    if (layout) {
-      layout->appendLayout(layoutForWord, bufStart, wordSpacing);
-    }
-    if (advances) {
-      layoutForWord->getAdvances(advances);
-    }
-    advance = layoutForWord->getAdvance();
+  std::shared_ptr<const Layout> layoutForWord =
+      cache.get(key, ctx, collection);
+  if (layout) {
+    layout->appendLayout(layoutForWord.get(), bufStart, wordSpacing);
   }
+  if (advances) {
+    layoutForWord->getAdvances(advances);
+  }
+  float advance = layoutForWord->getAdvance();
 
   if (wordSpacing != 0) {
     advance += wordSpacing;
@@ -748,7 +795,7 @@ static void addFeatures(const std::string& str,
   const char* end = start + str.size();
 
   while (start < end) {
-    static hb_feature_t feature;
+    hb_feature_t feature;
     const char* p = strchr(start, ',');
     if (!p)
       p = end;
@@ -919,7 +966,7 @@ void Layout::doLayoutRun(const uint16_t* buf,
                          bool isRtl,
                          LayoutContext* ctx,
                          const std::shared_ptr<FontCollection>& collection) {
-  hb_buffer_t* buffer = LayoutEngine::getInstance().hbBuffer;
+  hb_buffer_t* buffer = LayoutEngine::getInstance().getThreadHbBuffer();
   std::vector<FontCollection::Run> items;
   collection->itemize(buf + start, count, ctx->style, &items);
 
@@ -1105,7 +1152,9 @@ void Layout::doLayoutRun(const uint16_t* buf,
   mAdvance = x;
 }
 
-void Layout::appendLayout(Layout* src, size_t start, float extraAdvance) {
+void Layout::appendLayout(const Layout* src,
+                          size_t start,
+                          float extraAdvance) {
   int fontMapStack[16];
   int* fontMap;
   if (src->mFaces.size() < sizeof(fontMapStack) / sizeof(fontMapStack[0])) {
@@ -1121,7 +1170,7 @@ void Layout::appendLayout(Layout* src, size_t start, float extraAdvance) {
   // jitter.
   float x0 = mAdvance;
   for (size_t i = 0; i < src->mGlyphs.size(); i++) {
-    LayoutGlyph& srcGlyph = src->mGlyphs[i];
+    const LayoutGlyph& srcGlyph = src->mGlyphs[i];
     int font_ix = fontMap[srcGlyph.font_ix];
     unsigned int glyph_id = srcGlyph.glyph_id;
     float x = x0 + srcGlyph.x;
@@ -1184,7 +1233,7 @@ float Layout::getAdvance() const {
   return mAdvance;
 }
 
-void Layout::getAdvances(float* advances) {
+void Layout::getAdvances(float* advances) const {
   memcpy(advances, &mAdvances[0], mAdvances.size() * sizeof(float));
 }
 
@@ -1192,11 +1241,14 @@ void Layout::getBounds(MinikinRect* bounds) const {
   bounds->set(mBounds);
 }
 
+LayoutCacheStats Layout::getCacheStats() {
+  return LayoutEngine::getInstance().layoutCache.getStats();
+}
+
 void Layout::purgeCaches() {
-  std::scoped_lock _l(gMinikinLock);
   LayoutCache& layoutCache = LayoutEngine::getInstance().layoutCache;
   layoutCache.clear();
-  purgeHbFontCacheLocked();
+  purgeHbFontCache();
 }
 
 }  // namespace minikin
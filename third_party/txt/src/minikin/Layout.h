@@ -57,6 +57,15 @@ enum {
   kBidi_Mask = 0x7
 };
 
+// Counters of the cache of shaped words. Words are cached by their text and
+// surrounding context, font collection, style and paint, so identical words
+// in different paragraphs share a single shaping.
+struct LayoutCacheStats {
+  size_t hitCount = 0;
+  size_t missCount = 0;
+  size_t entryCount = 0;
+};
+
 // Lifecycle and threading assumptions for Layout:
 // The object is assumed to be owned by a single thread; multiple threads
 // may not mutate it at the same time.
@@ -106,7 +115,7 @@ class Layout {
 
   // Get advances, copying into caller-provided buffer. The size of this
   // buffer must match the length of the string (count arg to doLayout).
-  void getAdvances(float* advances);
+  void getAdvances(float* advances) const;
 
   // The i parameter is an offset within the buf relative to start, it is <
   // count, where start and count are the parameters to doLayout
@@ -117,6 +126,9 @@ class Layout {
   // Purge all caches, useful in low memory conditions
   static void purgeCaches();
 
+  // The counters of the cache of shaped words, which is shared by all layouts
+  static LayoutCacheStats getCacheStats();
+
  private:
   friend class LayoutCacheKey;
 
@@ -163,7 +175,7 @@ class Layout {
                    const std::shared_ptr<FontCollection>& collection);
 
   // Append another layout (for example, cached value) into this one
-  void appendLayout(Layout* src, size_t start, float extraAdvance);
+  void appendLayout(const Layout* src, size_t start, float extraAdvance);
 
   std::vector<LayoutGlyph> mGlyphs;
   std::vector<float> mAdvances;
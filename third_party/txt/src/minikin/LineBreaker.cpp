@@ -74,11 +74,72 @@ void LineBreaker::setLocale(const icu::Locale& locale, Hyphenator* hyphenator) {
   mHyphenator = hyphenator;
 }
 
-void LineBreaker::setText() {
-  mWordBreaker.setText(mTextBuf.data(), mTextBuf.size());
+void BreakOpportunities::clear() {
+  mCharWidths.clear();
+  mRunWidths.clear();
+  mWordBreaks.clear();
+  mHyphenationPoints.clear();
+}
+
+void LineBreaker::recordBreakOpportunities(BreakOpportunities* opportunities) {
+  mRecording = opportunities;
+  mReplaying = nullptr;
+}
+
+void LineBreaker::replayBreakOpportunities(
+    const BreakOpportunities* opportunities) {
+  mReplaying = opportunities;
+  mRecording = nullptr;
+}
+
+ssize_t LineBreaker::nextWordBreak() {
+  if (mReplaying != nullptr) {
+    mReplayedWordBreak++;
+    LOG_ALWAYS_FATAL_IF(mReplayedWordBreak >= mReplaying->mWordBreaks.size(),
+                        "replayed more word breaks than were recorded");
+    return mReplaying->mWordBreaks[mReplayedWordBreak].offset;
+  }
+  ssize_t offset = mWordBreaker.next();
+  if (mRecording != nullptr) {
+    mRecording->mWordBreaks.push_back({offset, mWordBreaker.wordStart(),
+                                       mWordBreaker.wordEnd(),
+                                       mWordBreaker.breakBadness()});
+  }
+  return offset;
+}
+
+BreakOpportunities::WordBreak LineBreaker::currentWordBreak() const {
+  if (mReplaying != nullptr) {
+    return mReplaying->mWordBreaks[mReplayedWordBreak];
+  }
+  if (mRecording != nullptr) {
+    return mRecording->mWordBreaks.back();
+  }
+  return {mWordBreaker.current(), mWordBreaker.wordStart(),
+          mWordBreaker.wordEnd(), mWordBreaker.breakBadness()};
+}
 
-  // handle initial break here because addStyleRun may never be called
-  mWordBreaker.next();
+void LineBreaker::setText() {
+  // Opportunities recorded for another text cannot be replayed.
+  if (mReplaying != nullptr &&
+      (mReplaying->empty() ||
+       mReplaying->mCharWidths.size() != mTextBuf.size())) {
+    mReplaying = nullptr;
+  }
+  if (mReplaying != nullptr) {
+    std::copy(mReplaying->mCharWidths.begin(), mReplaying->mCharWidths.end(),
+              mCharWidths.begin());
+    mReplayedWordBreak = 0;
+    mReplayedHyphenationPoint = 0;
+    mReplayedRun = 0;
+  } else {
+    mWordBreaker.setText(mTextBuf.data(), mTextBuf.size());
+    if (mRecording != nullptr) {
+      mRecording->clear();
+    }
+    // handle initial break here because addStyleRun may never be called
+    nextWordBreak();
+  }
   mCandidates.clear();
   Candidate cand = {0,   0, 0.0, 0.0, 0.0,
                     0.0, 0, 0,   0,   HyphenationType::DONT_BREAK};
@@ -120,7 +181,8 @@ bool isLineEndSpace(uint16_t c) {
 // Ordinarily, this method measures the text in the range given. However, when
 // paint is nullptr, it assumes the widths have already been calculated and
 // stored in the width buffer. This method finds the candidate word breaks
-// (using the ICU break iterator) and sends them to addCandidate.
+// (using the ICU break iterator) and sends them to addCandidate. When break
+// opportunities are replayed, the recorded widths and breaks are used instead.
 float LineBreaker::addStyleRun(MinikinPaint* paint,
                                const std::shared_ptr<FontCollection>& typeface,
                                FontStyle style,
@@ -128,13 +190,19 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
                                size_t end,
                                bool isRtl) {
   float width = 0.0f;
-
-  float hyphenPenalty = 0.0;
-  if (paint != nullptr) {
+  if (mReplaying != nullptr) {
+    width = mReplaying->mRunWidths[mReplayedRun++];
+  } else if (paint != nullptr) {
     width = Layout::measureText(mTextBuf.data(), start, end - start,
                                 mTextBuf.size(), isRtl, style, *paint, typeface,
                                 mCharWidths.data() + start);
+  }
+  if (mRecording != nullptr) {
+    mRecording->mRunWidths.push_back(width);
+  }
 
+  float hyphenPenalty = 0.0;
+  if (paint != nullptr) {
     // a heuristic that seems to perform well
     hyphenPenalty =
         0.5 * paint->size * paint->scaleX * mLineWidths.getLineWidth(0);
@@ -154,7 +222,7 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
     }
   }
 
-  size_t current = (size_t)mWordBreaker.current();
+  size_t current = (size_t)currentWordBreak().offset;
   size_t afterWord = start;
   size_t lastBreak = start;
   ParaWidth lastBreakWidth = mWidth;
@@ -172,9 +240,20 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
       afterWord = i + 1;
     }
     if (i + 1 == current) {
-      size_t wordStart = mWordBreaker.wordStart();
-      size_t wordEnd = mWordBreaker.wordEnd();
-      if (paint != nullptr && mHyphenator != nullptr &&
+      const BreakOpportunities::WordBreak wordBreak = currentWordBreak();
+      size_t wordStart = wordBreak.wordStart;
+      size_t wordEnd = wordBreak.wordEnd;
+      if (mReplaying != nullptr) {
+        const auto& points = mReplaying->mHyphenationPoints;
+        for (; mReplayedHyphenationPoint < points.size() &&
+               points[mReplayedHyphenationPoint].offset < wordEnd;
+             mReplayedHyphenationPoint++) {
+          const auto& point = points[mReplayedHyphenationPoint];
+          addWordBreak(point.offset, postBreak - point.secondPartWidth,
+                       lastBreakWidth + point.firstPartWidth, postSpaceCount,
+                       postSpaceCount, hyphenPenalty, point.type);
+        }
+      } else if (paint != nullptr && mHyphenator != nullptr &&
           mHyphenationFrequency != kHyphenationFrequency_None &&
           wordStart >= start && wordEnd > wordStart &&
           wordEnd - wordStart <= LONGEST_HYPHENATED_WORD) {
@@ -209,6 +288,10 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
                 style, *paint, typeface, nullptr);
             ParaWidth hyphPreBreak = postBreak - secondPartWidth;
 
+            if (mRecording != nullptr) {
+              mRecording->mHyphenationPoints.push_back(
+                  {j, hyph, firstPartWidth, secondPartWidth});
+            }
             addWordBreak(j, hyphPreBreak, hyphPostBreak, postSpaceCount,
                          postSpaceCount, hyphenPenalty, hyph);
 
@@ -219,13 +302,13 @@ float LineBreaker::addStyleRun(MinikinPaint* paint,
 
       // Skip break for zero-width characters inside replacement span
       if (paint != nullptr || current == end || mCharWidths[current] > 0) {
-        float penalty = hyphenPenalty * mWordBreaker.breakBadness();
+        float penalty = hyphenPenalty * wordBreak.badness;
         addWordBreak(current, mWidth, postBreak, mSpaceCount, postSpaceCount,
                      penalty, HyphenationType::DONT_BREAK);
       }
       lastBreak = current;
       lastBreakWidth = mWidth;
-      current = (size_t)mWordBreaker.next();
+      current = (size_t)nextWordBreak();
     }
   }
 
@@ -520,6 +603,9 @@ void LineBreaker::computeBreaksOptimal(bool isRectangle) {
 }
 
 size_t LineBreaker::computeBreaks() {
+  if (mRecording != nullptr) {
+    mRecording->mCharWidths = mCharWidths;
+  }
   if (mStrategy == kBreakStrategy_Greedy) {
     computeBreaksGreedy();
   } else {
@@ -552,6 +638,8 @@ void LineBreaker::finish() {
   mHyphenationFrequency = kHyphenationFrequency_Normal;
   mLinePenalty = 0.0f;
   mJustified = false;
+  mRecording = nullptr;
+  mReplaying = nullptr;
 }
 
 }  // namespace minikin
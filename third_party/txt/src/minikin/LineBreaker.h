@@ -85,6 +85,42 @@ class LineWidths {
   std::vector<float> mIndents;
 };
 
+// The opportunities to break a text into lines, which do not depend on the
+// width of the lines: the widths of its characters, its word boundaries and
+// the widths of its hyphenated fragments. A LineBreaker records them while it
+// breaks a text, and can replay them to break the same text and style runs at
+// another width without measuring, segmenting or hyphenating it again.
+class BreakOpportunities {
+ public:
+  bool empty() const { return mWordBreaks.empty(); }
+
+  void clear();
+
+ private:
+  friend class LineBreaker;
+
+  // The state of the word breaker after each call to next().
+  struct WordBreak {
+    ssize_t offset;
+    ssize_t wordStart;
+    ssize_t wordEnd;
+    int badness;
+  };
+
+  struct HyphenationPoint {
+    size_t offset;
+    HyphenationType type;
+    float firstPartWidth;
+    float secondPartWidth;
+  };
+
+  std::vector<float> mCharWidths;
+  // The width returned by each call to addStyleRun.
+  std::vector<float> mRunWidths;
+  std::vector<WordBreak> mWordBreaks;
+  std::vector<HyphenationPoint> mHyphenationPoints;
+};
+
 class LineBreaker {
  public:
   const static int kTab_Shift =
@@ -113,6 +149,15 @@ class LineBreaker {
   // set text to current contents of buffer
   void setText();
 
+  // Records the break opportunities of the text set by the next setText()
+  // into |opportunities|, until finish().
+  void recordBreakOpportunities(BreakOpportunities* opportunities);
+
+  // Breaks the text set by the next setText() with |opportunities|, which
+  // must have been recorded for the same text, style runs and hyphenation
+  // settings, instead of measuring and segmenting it. Lasts until finish().
+  void replayBreakOpportunities(const BreakOpportunities* opportunities);
+
   void setLineWidths(float firstWidth,
                      int firstWidthLineCount,
                      float restWidth);
@@ -212,6 +257,10 @@ class LineBreaker {
 
   void finishBreaksOptimal();
 
+  // Advance the word breaker, or the replayed word breaks.
+  ssize_t nextWordBreak();
+  BreakOpportunities::WordBreak currentWordBreak() const;
+
   WordBreaker mWordBreaker;
   icu::Locale mLocale;
   std::vector<uint16_t> mTextBuf;
@@ -244,6 +293,12 @@ class LineBreaker {
   uint32_t mLastHyphenation;  // hyphen edit of last break kept for next line
   int mFirstTabIndex;
   size_t mSpaceCount;
+
+  BreakOpportunities* mRecording = nullptr;
+  const BreakOpportunities* mReplaying = nullptr;
+  size_t mReplayedWordBreak = 0;
+  size_t mReplayedHyphenationPoint = 0;
+  size_t mReplayedRun = 0;
 };
 
 }  // namespace minikin
@@ -31,8 +31,8 @@ namespace minikin {
 class MinikinFont;
 
 // Possibly move into own .h file?
-// Note: if you add a field here, either add it to LayoutCacheKey or to
-// skipCache()
+// Note: if you add a field that affects shaping here, add it to
+// LayoutCacheKey
 struct MinikinPaint {
   MinikinPaint()
       : font(nullptr),
@@ -46,8 +46,6 @@ struct MinikinPaint {
         hyphenEdit(),
         fontFeatureSettings() {}
 
-  bool skipCache() const { return !fontFeatureSettings.empty(); }
-
   MinikinFont* font;
   float size;
   float scaleX;
@@ -19,22 +19,18 @@
 #ifndef MINIKIN_INTERNAL_H
 #define MINIKIN_INTERNAL_H
 
-#include <mutex>
-
 #include <hb.h>
 
 #include <minikin/MinikinFont.h>
 
 namespace minikin {
 
-// All external Minikin interfaces are designed to be thread-safe.
-// Presently, that's implemented by through a global lock, and having
-// all external interfaces take that lock.
-
-extern std::recursive_mutex gMinikinLock;
-
-// Aborts if gMinikinLock is not acquired. Do nothing on the release build.
-void assertMinikinLocked();
+// All external Minikin interfaces are designed to be thread-safe, so that
+// text can be laid out on several threads at once. Font families and font
+// collections are immutable once constructed, and the caches they share
+// (the HarfBuzz font cache, the layout cache and the language list cache)
+// each take their own lock. Shaping never mutates a cached hb_font_t: each
+// layout shapes through a sub font that it owns.
 
 hb_blob_t* getFontTable(const MinikinFont* minikinFont, uint32_t tag);
 
@@ -94,15 +94,22 @@ FontCollection::~FontCollection() {
 }
 
 size_t FontCollection::GetFontManagersCount() const {
+  std::scoped_lock lock(mutex_);
   return GetFontManagerOrder().size();
 }
 
 void FontCollection::SetupDefaultFontManager() {
+  std::scoped_lock lock(mutex_);
   default_font_manager_ = GetDefaultFontManager();
+  font_families_cache_.clear();
+  ClearFallbackFonts();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   default_font_manager_ = font_manager;
+  font_families_cache_.clear();
+  ClearFallbackFonts();
 
 #if FLUTTER_ENABLE_SKSHAPER
   skt_collection_.reset();
@@ -110,7 +117,9 @@ void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   asset_font_manager_ = font_manager;
+  font_families_cache_.clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   skt_collection_.reset();
@@ -118,7 +127,9 @@ void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   dynamic_font_manager_ = font_manager;
+  font_families_cache_.clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   skt_collection_.reset();
@@ -126,7 +137,9 @@ void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(mutex_);
   test_font_manager_ = font_manager;
+  font_families_cache_.clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   skt_collection_.reset();
@@ -147,7 +160,21 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::GetFontManagerOrder() const {
   return order;
 }
 
+sk_sp<SkTypeface> FontCollection::MatchTypeface(const std::string& family_name,
+                                                const SkFontStyle& style) {
+  std::scoped_lock lock(mutex_);
+  for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
+    sk_sp<SkFontStyleSet> font_style_set(
+        manager->matchFamily(family_name.c_str()));
+    if (font_style_set == nullptr || font_style_set->count() == 0)
+      continue;
+    return sk_sp<SkTypeface>(font_style_set->matchStyle(style));
+  }
+  return nullptr;
+}
+
 void FontCollection::DisableFontFallback() {
+  std::scoped_lock lock(mutex_);
   enable_font_fallback_ = false;
 
 #if FLUTTER_ENABLE_SKSHAPER
@@ -161,6 +188,7 @@ std::shared_ptr<minikin::FontCollection>
 FontCollection::GetMinikinFontCollectionForFamilies(
     const std::vector<std::string>& font_families,
     const std::string& locale) {
+  std::scoped_lock lock(mutex_);
   // Look inside the font collections cache first.
   FamilyKey family_key(font_families, locale);
   auto cached = font_collections_cache_.find(family_key);
@@ -221,16 +249,26 @@ FontCollection::GetMinikinFontCollectionForFamilies(
 
 std::shared_ptr<minikin::FontFamily> FontCollection::FindFontFamilyInManagers(
     const std::string& family_name) {
+  // Font collections are rebuilt whenever a fallback font is added. Reuse the
+  // families, which are expensive to create for large fonts, across rebuilds.
+  auto cached = font_families_cache_.find(family_name);
+  if (cached != font_families_cache_.end()) {
+    return cached->second;
+  }
+
   TRACE_EVENT0("flutter", "FontCollection::FindFontFamilyInManagers");
+  std::shared_ptr<minikin::FontFamily> found_family;
   // Search for the font family in each font manager.
   for (sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
     std::shared_ptr<minikin::FontFamily> minikin_family =
         CreateMinikinFontFamily(manager, family_name);
     if (!minikin_family)
       continue;
-    return minikin_family;
+    found_family = std::move(minikin_family);
+    break;
   }
-  return nullptr;
+  font_families_cache_[family_name] = found_family;
+  return found_family;
 }
 
 void FontCollection::SortSkTypefaces(
@@ -309,19 +347,44 @@ std::shared_ptr<minikin::FontFamily> FontCollection::CreateMinikinFontFamily(
 const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
     uint32_t ch,
     std::string locale) {
+  std::scoped_lock lock(mutex_);
   // Check if the ch's matched font has been cached. We cache the results of
   // this method as repeated matchFamilyStyleCharacter calls can become
   // extremely laggy when typing a large number of complex emojis.
-  auto lookup = fallback_match_cache_.find(ch);
-  if (lookup != fallback_match_cache_.end()) {
+  auto& locale_match_cache = fallback_match_cache_[locale];
+  auto lookup = locale_match_cache.find(ch);
+  if (lookup != locale_match_cache.end()) {
     return *lookup->second;
   }
   const std::shared_ptr<minikin::FontFamily>* match =
-      &DoMatchFallbackFont(ch, locale);
-  fallback_match_cache_.insert(std::make_pair(ch, match));
+      &FindLoadedFallbackFont(ch, locale);
+  if (*match == nullptr) {
+    match = &DoMatchFallbackFont(ch, locale);
+  }
+  locale_match_cache.insert(std::make_pair(ch, match));
   return *match;
 }
 
+const std::shared_ptr<minikin::FontFamily>&
+FontCollection::FindLoadedFallbackFont(uint32_t ch, const std::string& locale) {
+  // Text that needs fallback fonts, like CJK text, usually has many distinct
+  // characters that the platform resolves to the same few fonts. Asking the
+  // font managers for each of them is slow, so prefer a fallback font that was
+  // already loaded for the locale and covers the character.
+  auto locale_fonts = fallback_fonts_for_locale_.find(locale);
+  if (locale_fonts == fallback_fonts_for_locale_.end()) {
+    return g_null_family;
+  }
+  for (const std::string& family_name : locale_fonts->second) {
+    auto fallback_it = fallback_fonts_.find(family_name);
+    if (fallback_it != fallback_fonts_.end() && fallback_it->second &&
+        fallback_it->second->hasGlyph(ch, 0)) {
+      return fallback_it->second;
+    }
+  }
+  return g_null_family;
+}
+
 const std::shared_ptr<minikin::FontFamily>& FontCollection::DoMatchFallbackFont(
     uint32_t ch,
     std::string locale) {
@@ -372,8 +435,16 @@ FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
   return insert_it.first->second;
 }
 
+void FontCollection::UpdateDynamicFonts(const std::function<void()>& update) {
+  std::scoped_lock lock(mutex_);
+  update();
+  ClearFontFamilyCache();
+}
+
 void FontCollection::ClearFontFamilyCache() {
+  std::scoped_lock lock(mutex_);
   font_collections_cache_.clear();
+  font_families_cache_.clear();
 
 #if FLUTTER_ENABLE_SKSHAPER
   if (skt_collection_) {
@@ -382,10 +453,18 @@ void FontCollection::ClearFontFamilyCache() {
 #endif
 }
 
+void FontCollection::ClearFallbackFonts() {
+  fallback_match_cache_.clear();
+  fallback_fonts_.clear();
+  fallback_fonts_for_locale_.clear();
+  font_collections_cache_.clear();
+}
+
 #if FLUTTER_ENABLE_SKSHAPER
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
+  std::scoped_lock lock(mutex_);
   if (!skt_collection_) {
     skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
 
@@ -17,7 +17,9 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -37,6 +39,9 @@
 
 namespace txt {
 
+// All methods are thread-safe, so that paragraphs using a collection can be
+// laid out on any thread. Minikin calls back into the collection for font
+// fallback while it shapes.
 class FontCollection : public std::enable_shared_from_this<FontCollection> {
  public:
   FontCollection();
@@ -61,6 +66,11 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       uint32_t ch,
       std::string locale);
 
+  // Returns the typeface of |family_name| that best matches |style|, from the
+  // first font manager that provides the family, or nullptr.
+  sk_sp<SkTypeface> MatchTypeface(const std::string& family_name,
+                                  const SkFontStyle& style);
+
   // Do not provide alternative fonts that can match characters which are
   // missing from the requested font family.
   void DisableFontFallback();
@@ -68,6 +78,10 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Remove all entries in the font family cache.
   void ClearFontFamilyCache();
 
+  // Runs |update|, which changes the fonts of the dynamic font manager, while
+  // no paragraph looks up fonts, and then clears the font family cache.
+  void UpdateDynamicFonts(const std::function<void()>& update);
+
 #if FLUTTER_ENABLE_SKSHAPER
 
   // Construct a Skia text layout FontCollection based on this collection.
@@ -90,6 +104,9 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
     };
   };
 
+  // Guards all the members below. Recursive, as methods that hold it call
+  // each other.
+  mutable std::recursive_mutex mutex_;
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
@@ -98,9 +115,15 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
                      std::shared_ptr<minikin::FontCollection>,
                      FamilyKey::Hasher>
       font_collections_cache_;
-  // Cache that stores the results of MatchFallbackFont to ensure lag-free emoji
-  // font fallback matching.
-  std::unordered_map<uint32_t, const std::shared_ptr<minikin::FontFamily>*>
+  // Cache of the families found by FindFontFamilyInManagers, including the
+  // families that were not found.
+  std::unordered_map<std::string, std::shared_ptr<minikin::FontFamily>>
+      font_families_cache_;
+  // Cache that stores the results of MatchFallbackFont per locale to ensure
+  // lag-free emoji font fallback matching.
+  std::unordered_map<
+      std::string,
+      std::unordered_map<uint32_t, const std::shared_ptr<minikin::FontFamily>*>>
       fallback_match_cache_;
   std::unordered_map<std::string, std::shared_ptr<minikin::FontFamily>>
       fallback_fonts_;
@@ -119,6 +142,14 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       uint32_t ch,
       std::string locale);
 
+  // Returns a fallback font already loaded for |locale| that covers |ch|.
+  const std::shared_ptr<minikin::FontFamily>& FindLoadedFallbackFont(
+      uint32_t ch,
+      const std::string& locale);
+
+  // Forgets the fallback fonts, which come from the default font manager.
+  void ClearFallbackFonts();
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
   std::shared_ptr<minikin::FontFamily> FindFontFamilyInManagers(
@@ -18,7 +18,9 @@
 
 #include <minikin/MinikinFont.h>
 
+#include "flutter/fml/build_config.h"
 #include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkStream.h"
 
 namespace txt {
 namespace {
@@ -42,6 +44,34 @@ hb_blob_t* GetTable(hb_face_t* face, hb_tag_t tag, void* context) {
                         HB_MEMORY_MODE_WRITABLE, buffer, free);
 }
 
+void DeleteStream(void* context) {
+  delete reinterpret_cast<SkStreamAsset*>(context);
+}
+
+// Creates a face that reads its tables directly from the font data if the
+// typeface is backed by memory, such as a mapped font file or asset. Pages of
+// the font are then only loaded when one of their tables is read, and tables
+// are not copied.
+hb_face_t* CreateFaceFromMemory(const SkTypeface& typeface) {
+#if defined(OS_MACOSX)
+  // CoreText typefaces reconstruct the whole font to open a stream.
+  return nullptr;
+#else
+  int ttc_index = 0;
+  std::unique_ptr<SkStreamAsset> stream = typeface.openStream(&ttc_index);
+  if (!stream || stream->getMemoryBase() == nullptr)
+    return nullptr;
+
+  const char* data = static_cast<const char*>(stream->getMemoryBase());
+  const size_t size = stream->getLength();
+  hb_blob_t* blob = hb_blob_create(data, size, HB_MEMORY_MODE_READONLY,
+                                   stream.release(), DeleteStream);
+  hb_face_t* face = hb_face_create(blob, ttc_index);
+  hb_blob_destroy(blob);
+  return face;
+#endif
+}
+
 }  // namespace
 
 FontSkia::FontSkia(sk_sp<SkTypeface> typeface)
@@ -83,6 +113,9 @@ void FontSkia::GetBounds(minikin::MinikinRect* bounds,
 }
 
 hb_face_t* FontSkia::CreateHarfBuzzFace() const {
+  hb_face_t* face = CreateFaceFromMemory(*typeface_);
+  if (face != nullptr)
+    return face;
   return hb_face_create_for_tables(GetTable, typeface_.get(), 0);
 }
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "glyph_usage_recorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+std::atomic<bool> GlyphUsageRecorder::enabled_ = false;
+
+bool GlyphUsageRecorder::FontKey::operator<(const FontKey& other) const {
+  return std::tie(family, weight, width, slant, size, fake_bold,
+                  fake_italic) < std::tie(other.family, other.weight,
+                                          other.width, other.slant, other.size,
+                                          other.fake_bold, other.fake_italic);
+}
+
+GlyphUsageRecorder::GlyphUsageRecorder() = default;
+
+GlyphUsageRecorder& GlyphUsageRecorder::GetInstance() {
+  static GlyphUsageRecorder* recorder = new GlyphUsageRecorder();
+  return *recorder;
+}
+
+void GlyphUsageRecorder::Record(const SkFont& font,
+                                const uint16_t* glyphs,
+                                size_t count) {
+  SkTypeface* typeface = font.getTypeface();
+  if (typeface == nullptr || count == 0)
+    return;
+
+  FontKey key;
+  SkString family;
+  typeface->getFamilyName(&family);
+  key.family = family.c_str();
+  SkFontStyle style = typeface->fontStyle();
+  key.weight = style.weight();
+  key.width = style.width();
+  key.slant = style.slant();
+  key.size = font.getSize();
+  key.fake_bold = font.isEmbolden();
+  key.fake_italic = font.getSkewX() != 0;
+
+  std::scoped_lock lock(mutex_);
+  usage_[key].insert(glyphs, glyphs + count);
+}
+
+GlyphUsageRecorder::Usage GlyphUsageRecorder::GetUsage() const {
+  std::scoped_lock lock(mutex_);
+  return usage_;
+}
+
+void GlyphUsageRecorder::Clear() {
+  std::scoped_lock lock(mutex_);
+  usage_.clear();
+}
+
+void GlyphUsageRecorder::Prewarm(const Usage& usage,
+                                 FontCollection& font_collection,
+                                 float scale) {
+  for (const auto& [key, glyph_set] : usage) {
+    if (glyph_set.empty() || !(key.size > 0))
+      continue;
+    sk_sp<SkTypeface> typeface = font_collection.MatchTypeface(
+        key.family,
+        SkFontStyle(key.weight, key.width,
+                    static_cast<SkFontStyle::Slant>(key.slant)));
+    if (!typeface)
+      continue;
+
+    // Use the parameters of ParagraphTxt so that the glyphs end up in the
+    // same cache entries as the ones of the paragraphs.
+    SkFont font(typeface, key.size);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+    font.setHinting(SkFontHinting::kSlight);
+    font.setEmbolden(key.fake_bold);
+    font.setSkewX(key.fake_italic ? -SK_Scalar1 / 4 : 0);
+
+    // Draw all glyphs at the same origin so that none of them is clipped
+    // away before it is rasterized.
+    const int dimension =
+        std::max(1, static_cast<int>(std::ceil(key.size * scale * 2)));
+    sk_sp<SkSurface> surface =
+        SkSurface::MakeRasterN32Premul(dimension, dimension);
+    if (!surface)
+      continue;
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->scale(scale, scale);
+
+    SkTextBlobBuilder builder;
+    const SkTextBlobBuilder::RunBuffer& buffer =
+        builder.allocRunPos(font, glyph_set.size());
+    size_t index = 0;
+    for (uint16_t glyph : glyph_set) {
+      buffer.glyphs[index] = glyph;
+      buffer.pos[index * 2] = 0;
+      buffer.pos[index * 2 + 1] = 0;
+      index++;
+    }
+    canvas->drawTextBlob(builder.make(), 0, key.size, SkPaint());
+  }
+}
+
+}  // namespace txt
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIB_TXT_SRC_GLYPH_USAGE_RECORDER_H_
+#define LIB_TXT_SRC_GLYPH_USAGE_RECORDER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "txt/font_collection.h"
+
+namespace txt {
+
+// Records the glyphs that paragraphs lay out, per typeface and font size, so
+// that a training run can collect the glyphs an app uses. Prewarm rasterizes
+// recorded glyphs into Skia's glyph cache at startup, before the first frames
+// need them.
+//
+// All methods are thread-safe.
+class GlyphUsageRecorder {
+ public:
+  struct FontKey {
+    std::string family;
+    int weight = 0;
+    int width = 0;
+    int slant = 0;
+    float size = 0;
+    bool fake_bold = false;
+    bool fake_italic = false;
+
+    bool operator<(const FontKey& other) const;
+  };
+
+  using Usage = std::map<FontKey, std::set<uint16_t>>;
+
+  static GlyphUsageRecorder& GetInstance();
+
+  // Whether layouts record their glyphs. Disabled by default.
+  static bool IsEnabled() { return enabled_; }
+
+  static void SetEnabled(bool enabled) { enabled_ = enabled; }
+
+  // Records |count| glyphs laid out with |font|.
+  void Record(const SkFont& font, const uint16_t* glyphs, size_t count);
+
+  Usage GetUsage() const;
+
+  void Clear();
+
+  // Rasterizes the glyphs of |usage| into Skia's process-wide glyph cache, as
+  // they are drawn on a canvas scaled by |scale|. Families that
+  // |font_collection| does not provide are skipped.
+  //
+  // This may take long and is expected to run on a worker thread.
+  static void Prewarm(const Usage& usage,
+                      FontCollection& font_collection,
+                      float scale);
+
+ private:
+  static std::atomic<bool> enabled_;
+
+  mutable std::mutex mutex_;
+  Usage usage_;
+
+  GlyphUsageRecorder();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphUsageRecorder);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_GLYPH_USAGE_RECORDER_H_
@@ -30,6 +30,7 @@
 #include "flutter/fml/logging.h"
 #include "font_collection.h"
 #include "font_skia.h"
+#include "glyph_usage_recorder.h"
 #include "minikin/FontLanguageListCache.h"
 #include "minikin/GraphemeBreak.h"
 #include "minikin/HbFontCache.h"
@@ -102,6 +103,16 @@ std::vector<Paragraph::Range<size_t>> GetLayoutTypefaceRuns(
   return result;
 }
 
+// Whether the text of two styles is painted the same way, so that it can be
+// drawn at once.
+bool IsTextPaintedAlike(const TextStyle& a, const TextStyle& b) {
+  if (a.has_foreground != b.has_foreground ||
+      a.text_shadows != b.text_shadows) {
+    return false;
+  }
+  return a.has_foreground ? a.foreground == b.foreground : a.color == b.color;
+}
+
 int GetWeight(const FontWeight weight) {
   switch (weight) {
     case FontWeight::w100:
@@ -265,6 +276,7 @@ bool ParagraphTxt::ComputeLineBreaks() {
   }
   // Break at the end of the paragraph.
   newline_positions.push_back(text_.size());
+  break_opportunities_.resize(newline_positions.size());
 
   // Calculate and add any breaks due to a line being too long.
   size_t run_index = 0;
@@ -292,6 +304,13 @@ bool ParagraphTxt::ComputeLineBreaks() {
     breaker_.resize(block_size);
     memcpy(breaker_.buffer(), text_.data() + block_start,
            block_size * sizeof(text_[0]));
+    minikin::BreakOpportunities& opportunities =
+        break_opportunities_[newline_index];
+    if (opportunities.empty()) {
+      breaker_.recordBreakOpportunities(&opportunities);
+    } else {
+      breaker_.replayBreakOpportunities(&opportunities);
+    }
     breaker_.setText();
 
     // Add the runs that include this line to the LineBreaker.
@@ -316,6 +335,8 @@ bool ParagraphTxt::ComputeLineBreaks() {
                               ? ""
                               : run.style.font_families[0])
                       << "\".";
+        breaker_.finish();
+        break_opportunities_.clear();
         return false;
       }
       size_t run_start = std::max(run.start, block_start) - block_start;
@@ -663,14 +684,32 @@ void ParagraphTxt::Layout(double width) {
     return;
   }
 
+  // Resizing does not change the lines if they all fit on a single line.
+  if (!needs_layout_ && CanRealignLines(rounded_width)) {
+    RealignLines(rounded_width);
+    return;
+  }
+
+  // The bidi runs only depend on the text and the styles, which did not change
+  // unless the paragraph is dirty.
+  const bool reuse_bidi_runs = !needs_layout_ && !bidi_runs_.empty();
+  // Neither do the break opportunities, which are replayed when they were
+  // recorded by a previous layout.
+  if (needs_layout_) {
+    break_opportunities_.clear();
+  }
+
   width_ = rounded_width;
 
   needs_layout_ = false;
 
   records_.clear();
+  line_blobs_.clear();
+  decorations_.clear();
   glyph_lines_.clear();
   code_unit_runs_.clear();
   inline_placeholder_code_unit_runs_.clear();
+  line_advances_.clear();
   max_right_ = FLT_MIN;
   min_left_ = FLT_MAX;
   final_line_count_ = 0;
@@ -678,9 +717,14 @@ void ParagraphTxt::Layout(double width) {
   if (!ComputeLineBreaks())
     return;
 
-  std::vector<BidiRun> bidi_runs;
-  if (!ComputeBidiRuns(&bidi_runs))
-    return;
+  if (!reuse_bidi_runs) {
+    bidi_runs_.clear();
+    if (!ComputeBidiRuns(&bidi_runs_)) {
+      bidi_runs_.clear();
+      return;
+    }
+  }
+  const std::vector<BidiRun>& bidi_runs = bidi_runs_;
 
   SkFont font;
   font.setEdging(SkFont::Edging::kAntiAlias);
@@ -797,6 +841,21 @@ void ParagraphTxt::Layout(double width) {
     double justify_x_offset = 0;
     std::vector<PaintRecord> paint_records;
 
+    // Merges the glyphs of the records painted alike, which are indexed
+    // within the line until the line is complete.
+    std::vector<LineBlob> line_blobs;
+    SkTextBlobBuilder line_blob_builder;
+    size_t line_blob_first_record = 0;
+    size_t line_blob_record_count = 0;
+    auto finish_line_blob = [&]() {
+      sk_sp<SkTextBlob> text = line_blob_builder.make();
+      if (line_blob_record_count > 1) {
+        line_blobs.push_back(
+            {line_blob_first_record, line_blob_record_count, std::move(text)});
+      }
+      line_blob_record_count = 0;
+    };
+
     for (auto line_run_it = line_runs.begin(); line_run_it != line_runs.end();
          ++line_run_it) {
       const BidiRun& run = *line_run_it;
@@ -1012,6 +1071,11 @@ void ParagraphTxt::Layout(double width) {
         if (glyph_positions.empty())
           continue;
 
+        if (GlyphUsageRecorder::IsEnabled() && !run.is_placeholder_run()) {
+          GlyphUsageRecorder::GetInstance().Record(
+              font, blob_buffer.glyphs, glyph_blob.end - glyph_blob.start);
+        }
+
         // Store the font metrics and TextStyle in the LineMetrics for this line
         // to provide metrics upon user request. We index this RunMetrics
         // instance at `run.end() - 1` to allow map::lower_bound to access the
@@ -1022,6 +1086,28 @@ void ParagraphTxt::Layout(double width) {
             &line_metrics.run_metrics.at(run_key).font_metrics;
         font.getMetrics(metrics);
 
+        if (line_blob_record_count > 0 &&
+            (run.is_placeholder_run() ||
+             !IsTextPaintedAlike(paint_records.back().style(), run.style()))) {
+          finish_line_blob();
+        }
+        if (!run.is_placeholder_run()) {
+          const size_t glyph_count = glyph_blob.end - glyph_blob.start;
+          const SkTextBlobBuilder::RunBuffer& line_blob_buffer =
+              line_blob_builder.allocRunPos(font, glyph_count);
+          std::copy(blob_buffer.glyphs, blob_buffer.glyphs + glyph_count,
+                    line_blob_buffer.glyphs);
+          for (size_t i = 0; i < glyph_count; ++i) {
+            line_blob_buffer.pos[i * 2] =
+                blob_buffer.pos[i * 2] + run_x_offset + justify_x_offset;
+            line_blob_buffer.pos[i * 2 + 1] = blob_buffer.pos[i * 2 + 1];
+          }
+          if (line_blob_record_count == 0) {
+            line_blob_first_record = paint_records.size();
+          }
+          line_blob_record_count++;
+        }
+
         Range<double> record_x_pos(
             glyph_positions.front().x_pos.start - run_x_offset,
             glyph_positions.back().x_pos.end - run_x_offset);
@@ -1149,9 +1235,15 @@ void ParagraphTxt::Layout(double width) {
     line_metrics.unscaled_ascent = max_unscaled_ascent;
     line_metrics.width = line_widths_[line_number];
     line_metrics.left = line_x_offset;
+    line_advances_.push_back(run_x_offset);
 
     final_line_count_++;
 
+    finish_line_blob();
+    for (LineBlob& line_blob : line_blobs) {
+      line_blob.first_record += records_.size();
+      line_blobs_.push_back(std::move(line_blob));
+    }
     for (PaintRecord& paint_record : paint_records) {
       paint_record.SetOffset(
           SkPoint::Make(paint_record.offset().x() + line_x_offset, y_offset));
@@ -1174,6 +1266,66 @@ void ParagraphTxt::Layout(double width) {
   longest_line_ = max_right_ - min_left_;
 }
 
+bool ParagraphTxt::CanRealignLines(double width) const {
+  // The previous layout must have completed.
+  if (final_line_count_ == 0 || line_advances_.size() != final_line_count_ ||
+      final_line_count_ !=
+          std::min(paragraph_style_.max_lines, line_metrics_.size())) {
+    return false;
+  }
+  // Lines that end in a hard break are never justified or ellipsized.
+  for (const LineMetrics& line_metrics : line_metrics_) {
+    if (!line_metrics.hard_break) {
+      return false;
+    }
+  }
+  // The widest line including its trailing whitespace must fit, so that the
+  // line breaker would not break it.
+  return width >= max_intrinsic_width_;
+}
+
+void ParagraphTxt::RealignLines(double width) {
+  width_ = width;
+
+  std::vector<double> deltas(final_line_count_);
+  for (size_t line_number = 0; line_number < final_line_count_;
+       ++line_number) {
+    LineMetrics& line_metrics = line_metrics_[line_number];
+    const double line_x_offset =
+        GetLineXOffset(line_advances_[line_number], false);
+    deltas[line_number] = line_x_offset - line_metrics.left;
+    line_metrics.left = line_x_offset;
+  }
+
+  for (CodeUnitRun& code_unit_run : code_unit_runs_) {
+    code_unit_run.Shift(deltas[code_unit_run.line_number]);
+  }
+  for (CodeUnitRun& code_unit_run : inline_placeholder_code_unit_runs_) {
+    code_unit_run.Shift(deltas[code_unit_run.line_number]);
+  }
+  for (PaintRecord& paint_record : records_) {
+    paint_record.SetOffset(
+        SkPoint::Make(paint_record.offset().x() + deltas[paint_record.line()],
+                      paint_record.offset().y()));
+  }
+  // The decorations are computed again for the new offsets.
+  decorations_.clear();
+
+  // Glyph lines are immutable, so they are rebuilt.
+  std::vector<GlyphLine> glyph_lines;
+  glyph_lines.reserve(glyph_lines_.size());
+  for (size_t line_number = 0; line_number < glyph_lines_.size();
+       ++line_number) {
+    std::vector<GlyphPosition> positions = glyph_lines_[line_number].positions;
+    for (GlyphPosition& position : positions) {
+      position.Shift(deltas[line_number]);
+    }
+    glyph_lines.emplace_back(std::move(positions),
+                             glyph_lines_[line_number].total_code_units);
+  }
+  glyph_lines_ = std::move(glyph_lines);
+}
+
 void ParagraphTxt::UpdateLineMetrics(const SkFontMetrics& metrics,
                                      const TextStyle& style,
                                      double& max_ascent,
@@ -1376,32 +1528,47 @@ sk_sp<SkTypeface> ParagraphTxt::GetDefaultSkiaTypeface(const TextStyle& style) {
 // The x,y coordinates will be the very top left corner of the rendered
 // paragraph.
 void ParagraphTxt::Paint(SkCanvas* canvas, double x, double y) {
-  SkPoint base_offset = SkPoint::Make(x, y);
-  SkPaint paint;
+  if (decorations_.size() != records_.size()) {
+    decorations_.clear();
+    decorations_.resize(records_.size());
+    for (size_t i = 0; i < records_.size(); ++i) {
+      ComputeDecorations(records_[i], &decorations_[i]);
+    }
+  }
+
+  SkAutoCanvasRestore auto_restore(canvas, true);
+  canvas->translate(x, y);
   // Paint the background first before painting any text to prevent
   // potential overlap.
   for (const PaintRecord& record : records_) {
-    PaintBackground(canvas, record, base_offset);
+    PaintBackground(canvas, record);
   }
-  for (const PaintRecord& record : records_) {
-    if (record.style().has_foreground) {
-      paint = record.style().foreground;
-    } else {
-      paint.reset();
-      paint.setColor(record.style().color);
+  size_t line_blob_index = 0;
+  size_t record_index = 0;
+  while (record_index < records_.size()) {
+    const PaintRecord& record = records_[record_index];
+    size_t record_count = 1;
+    if (line_blob_index < line_blobs_.size() &&
+        line_blobs_[line_blob_index].first_record == record_index) {
+      const LineBlob& line_blob = line_blobs_[line_blob_index++];
+      PaintText(canvas, record.style(), line_blob.text.get(),
+                SkPoint::Make(line_metrics_[record.line()].left,
+                              record.offset().y()));
+      record_count = line_blob.record_count;
+    } else if (record.GetPlaceholderRun() == nullptr) {
+      PaintText(canvas, record.style(), record.text(), record.offset());
     }
-    SkPoint offset = base_offset + record.offset();
-    if (record.GetPlaceholderRun() == nullptr) {
-      PaintShadow(canvas, record, offset);
-      canvas->drawTextBlob(record.text(), offset.x(), offset.y(), paint);
+    for (size_t i = record_index; i < record_index + record_count; ++i) {
+      for (const Decoration& decoration : decorations_[i]) {
+        canvas->drawPath(decoration.path, decoration.paint);
+      }
     }
-    PaintDecorations(canvas, record, base_offset);
+    record_index += record_count;
   }
 }
 
-void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
-                                    const PaintRecord& record,
-                                    SkPoint base_offset) {
+void ParagraphTxt::ComputeDecorations(const PaintRecord& record,
+                                      std::vector<Decoration>* decorations) {
   if (record.style().decoration == TextDecoration::kNone)
     return;
 
@@ -1439,9 +1606,16 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
   paint.setStrokeWidth(underline_thickness *
                        record.style().decoration_thickness_multiplier);
 
-  SkPoint record_offset = base_offset + record.offset();
-  SkScalar x = record_offset.x() + record.x_start();
-  SkScalar y = record_offset.y();
+  SkScalar x = record.offset().x() + record.x_start();
+  SkScalar y = record.offset().y();
+
+  // Decorations drawn with the same paint share a path.
+  auto add_decoration = [&paint, decorations]() -> SkPath& {
+    if (decorations->empty() || decorations->back().paint != paint) {
+      decorations->push_back({paint, SkPath()});
+    }
+    return decorations->back().path;
+  };
 
   // Setup the decorations.
   switch (record.style().decoration_style) {
@@ -1501,11 +1675,11 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
               ? metrics.fUnderlinePosition
               : underline_thickness;
       if (record.style().decoration_style != TextDecorationStyle::kWavy) {
-        canvas->drawLine(x, y + y_offset, x + width, y + y_offset, paint);
+        add_decoration()
+            .moveTo(x, y + y_offset)
+            .lineTo(x + width, y + y_offset);
       } else {
-        SkPath offsetPath = path;
-        offsetPath.offset(0, y_offset);
-        canvas->drawPath(offsetPath, paint);
+        add_decoration().addPath(path, 0, y_offset);
       }
       y_offset = y_offset_original;
     }
@@ -1515,11 +1689,11 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
       // second line to be above, not below the first.
       y_offset -= metrics.fAscent;
       if (record.style().decoration_style != TextDecorationStyle::kWavy) {
-        canvas->drawLine(x, y - y_offset, x + width, y - y_offset, paint);
+        add_decoration()
+            .moveTo(x, y - y_offset)
+            .lineTo(x + width, y - y_offset);
       } else {
-        SkPath offsetPath = path;
-        offsetPath.offset(0, -y_offset);
-        canvas->drawPath(offsetPath, paint);
+        add_decoration().addPath(path, 0, -y_offset);
       }
       y_offset = y_offset_original;
     }
@@ -1540,11 +1714,11 @@ void ParagraphTxt::PaintDecorations(SkCanvas* canvas,
               // available:
               : metrics.fXHeight / -2.0;
       if (record.style().decoration_style != TextDecorationStyle::kWavy) {
-        canvas->drawLine(x, y + y_offset, x + width, y + y_offset, paint);
+        add_decoration()
+            .moveTo(x, y + y_offset)
+            .lineTo(x + width, y + y_offset);
       } else {
-        SkPath offsetPath = path;
-        offsetPath.offset(0, y_offset);
-        canvas->drawPath(offsetPath, paint);
+        add_decoration().addPath(path, 0, y_offset);
       }
       y_offset = y_offset_original;
     }
@@ -1594,24 +1768,22 @@ void ParagraphTxt::ComputeWavyDecoration(SkPath& path,
 }
 
 void ParagraphTxt::PaintBackground(SkCanvas* canvas,
-                                   const PaintRecord& record,
-                                   SkPoint base_offset) {
+                                   const PaintRecord& record) {
   if (!record.style().has_background)
     return;
 
   const SkFontMetrics& metrics = record.metrics();
   SkRect rect(SkRect::MakeLTRB(record.x_start(), metrics.fAscent,
                                record.x_end(), metrics.fDescent));
-  rect.offset(base_offset + record.offset());
+  rect.offset(record.offset());
   canvas->drawRect(rect, record.style().background);
 }
 
-void ParagraphTxt::PaintShadow(SkCanvas* canvas,
-                               const PaintRecord& record,
-                               SkPoint offset) {
-  if (record.style().text_shadows.size() == 0)
-    return;
-  for (TextShadow text_shadow : record.style().text_shadows) {
+void ParagraphTxt::PaintText(SkCanvas* canvas,
+                             const TextStyle& style,
+                             const SkTextBlob* text,
+                             SkPoint offset) {
+  for (const TextShadow& text_shadow : style.text_shadows) {
     if (!text_shadow.hasShadow()) {
       continue;
     }
@@ -1622,9 +1794,17 @@ void ParagraphTxt::PaintShadow(SkCanvas* canvas,
       paint.setMaskFilter(SkMaskFilter::MakeBlur(
           kNormal_SkBlurStyle, text_shadow.blur_radius, false));
     }
-    canvas->drawTextBlob(record.text(), offset.x() + text_shadow.offset.x(),
+    canvas->drawTextBlob(text, offset.x() + text_shadow.offset.x(),
                          offset.y() + text_shadow.offset.y(), paint);
   }
+
+  SkPaint paint;
+  if (style.has_foreground) {
+    paint = style.foreground;
+  } else {
+    paint.setColor(style.color);
+  }
+  canvas->drawTextBlob(text, offset.x(), offset.y(), paint);
 }
 
 std::vector<Paragraph::TextBox> ParagraphTxt::GetRectsForRange(
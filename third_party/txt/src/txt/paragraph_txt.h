@@ -34,7 +34,10 @@
 #include "styled_runs.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMetrics.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
 #include "utils/LinuxUtils.h"
 #include "utils/MacUtils.h"
 #include "utils/WindowsUtils.h"
@@ -153,6 +156,10 @@ class ParagraphTxt : public Paragraph {
   FRIEND_TEST_LINUX_ONLY(ParagraphTest, EmojiMultiLineRectsParagraph);
   FRIEND_TEST(ParagraphTest, HyphenBreakParagraph);
   FRIEND_TEST(ParagraphTest, RepeatLayoutParagraph);
+  FRIEND_TEST(ParagraphTest, ResizeRealignsUnbrokenLines);
+  FRIEND_TEST(ParagraphTest, ResizeReplaysBreakOpportunities);
+  FRIEND_TEST(ParagraphTest, PaintMergesTextPaintedAlike);
+  FRIEND_TEST(ParagraphTest, EqualStylesAreSharedAcrossParagraphs);
   FRIEND_TEST(ParagraphTest, Ellipsize);
   FRIEND_TEST(ParagraphTest, UnderlineShiftParagraph);
   FRIEND_TEST(ParagraphTest, WavyDecorationParagraph);
@@ -193,6 +200,26 @@ class ParagraphTxt : public Paragraph {
   // Stores the result of Layout().
   std::vector<PaintRecord> records_;
 
+  // The glyphs of consecutive records of a line that are painted alike, merged
+  // into a single text blob so that they are drawn at once. Its glyphs are
+  // positioned relative to the left of the line.
+  struct LineBlob {
+    size_t first_record;
+    size_t record_count;
+    sk_sp<SkTextBlob> text;
+  };
+  // Sorted by first record.
+  std::vector<LineBlob> line_blobs_;
+
+  // A decoration line, in paragraph coordinates.
+  struct Decoration {
+    SkPaint paint;
+    SkPath path;
+  };
+  // The decorations of each record, computed when the paragraph is first
+  // painted after a layout.
+  std::vector<std::vector<Decoration>> decorations_;
+
   bool did_exceed_max_lines_;
 
   // Strut metrics of zero will have no effect on the layout.
@@ -309,6 +336,15 @@ class ParagraphTxt : public Paragraph {
   // Holds the positions of the inline placeholders.
   std::vector<CodeUnitRun> inline_placeholder_code_unit_runs_;
 
+  // The bidi runs of the text, which do not depend on the width and are reused
+  // when only the width changes between layouts.
+  std::vector<BidiRun> bidi_runs_;
+  // The break opportunities of each block of text between hard line breaks,
+  // which are reused like the bidi runs.
+  std::vector<minikin::BreakOpportunities> break_opportunities_;
+  // The total advance of each line laid out, before alignment.
+  std::vector<double> line_advances_;
+
   // The max width of the paragraph as provided in the most recent Layout()
   // call.
   double width_ = -1.0f;
@@ -373,10 +409,18 @@ class ParagraphTxt : public Paragraph {
   // alignment.
   double GetLineXOffset(double line_total_advance, bool justify_line);
 
-  // Creates and draws the decorations onto the canvas.
-  void PaintDecorations(SkCanvas* canvas,
-                        const PaintRecord& record,
-                        SkPoint base_offset);
+  // Whether the lines of the previous layout break at the same positions when
+  // laid out at |width|. This is the case when no line was broken because it
+  // was too long and every line still fits within |width|.
+  bool CanRealignLines(double width) const;
+
+  // Changes the width to |width| and shifts the lines of the previous layout
+  // according to their alignment, without breaking or shaping them again.
+  void RealignLines(double width);
+
+  // Creates the decorations of the record.
+  void ComputeDecorations(const PaintRecord& record,
+                          std::vector<Decoration>* decorations);
 
   // Computes the beziers for a wavy decoration. The results will be
   // applied to path.
@@ -387,12 +431,13 @@ class ParagraphTxt : public Paragraph {
                              double thickness);
 
   // Draws the background onto the canvas.
-  void PaintBackground(SkCanvas* canvas,
-                       const PaintRecord& record,
-                       SkPoint base_offset);
+  void PaintBackground(SkCanvas* canvas, const PaintRecord& record);
 
-  // Draws the shadows onto the canvas.
-  void PaintShadow(SkCanvas* canvas, const PaintRecord& record, SkPoint offset);
+  // Draws text in the given style, along with its shadows, onto the canvas.
+  void PaintText(SkCanvas* canvas,
+                 const TextStyle& style,
+                 const SkTextBlob* text,
+                 SkPoint offset);
 
   // Obtain a Minikin font collection matching this text style.
   std::shared_ptr<minikin::FontCollection> GetMinikinFontCollectionForStyle(
@@ -16,10 +16,83 @@
 
 #include "styled_runs.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
 #include "flutter/fml/logging.h"
 #include "utils/WindowsUtils.h"
 
 namespace txt {
+namespace {
+
+void HashCombine(size_t* hash, size_t value) {
+  *hash ^= value + 0x9e3779b9 + (*hash << 6) + (*hash >> 2);
+}
+
+// Hashes the properties of a style that tell most styles apart. Equal styles
+// have equal hashes.
+size_t HashTextStyle(const TextStyle& style) {
+  size_t hash = 0;
+  HashCombine(&hash, style.color);
+  HashCombine(&hash, style.decoration);
+  HashCombine(&hash, static_cast<size_t>(style.font_weight));
+  HashCombine(&hash, static_cast<size_t>(style.font_style));
+  HashCombine(&hash, std::hash<double>()(style.font_size));
+  HashCombine(&hash, std::hash<double>()(style.height));
+  HashCombine(&hash, style.has_foreground ? style.foreground.getColor() : 0);
+  HashCombine(&hash, style.text_shadows.size());
+  for (const std::string& family : style.font_families) {
+    HashCombine(&hash, std::hash<std::string>()(family));
+  }
+  HashCombine(&hash, std::hash<std::string>()(style.locale));
+  return hash;
+}
+
+// The number of interned styles from which released ones are forgotten.
+constexpr size_t kMinPruneSize = 64;
+
+// The styles in use by any StyledRuns. A style is released when the last
+// runs using it are destroyed.
+class TextStyleInterner {
+ public:
+  std::shared_ptr<const TextStyle> Intern(const TextStyle& style) {
+    const size_t hash = HashTextStyle(style);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = styles_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      std::shared_ptr<const TextStyle> interned = it->second.lock();
+      if (interned && *interned == style) {
+        return interned;
+      }
+    }
+
+    // Forget the styles that were released once they make up most entries.
+    if (styles_.size() >= prune_size_) {
+      for (auto it = styles_.begin(); it != styles_.end();) {
+        it = it->second.expired() ? styles_.erase(it) : std::next(it);
+      }
+      prune_size_ = std::max(kMinPruneSize, styles_.size() * 2);
+    }
+    auto interned = std::make_shared<const TextStyle>(style);
+    styles_.emplace(hash, interned);
+    return interned;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_multimap<size_t, std::weak_ptr<const TextStyle>> styles_;
+  size_t prune_size_ = kMinPruneSize;
+};
+
+TextStyleInterner& GetTextStyleInterner() {
+  static TextStyleInterner* interner = new TextStyleInterner();
+  return *interner;
+}
+
+}  // namespace
 
 StyledRuns::StyledRuns() = default;
 
@@ -43,12 +116,12 @@ void StyledRuns::swap(StyledRuns& other) {
 
 size_t StyledRuns::AddStyle(const TextStyle& style) {
   const size_t style_index = styles_.size();
-  styles_.push_back(style);
+  styles_.push_back(GetTextStyleInterner().Intern(style));
   return style_index;
 }
 
 const TextStyle& StyledRuns::GetStyle(size_t style_index) const {
-  return styles_[style_index];
+  return *styles_[style_index];
 }
 
 void StyledRuns::StartRun(size_t style_index, size_t start) {
@@ -70,7 +143,7 @@ void StyledRuns::EndRunIfNeeded(size_t end) {
 
 StyledRuns::Run StyledRuns::GetRun(size_t index) const {
   const IndexedRun& run = runs_[index];
-  return Run{styles_[run.style_index], run.start, run.end};
+  return Run{*styles_[run.style_index], run.start, run.end};
 }
 
 }  // namespace txt
@@ -18,6 +18,7 @@
 #define LIB_TXT_SRC_STYLED_RUNS_H_
 
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "text_style.h"
@@ -48,6 +49,9 @@ class StyledRuns {
 
   void swap(StyledRuns& other);
 
+  // Styles are interned: equal styles share a single immutable copy across
+  // every StyledRuns, so that adding a style that is already in use neither
+  // copies nor allocates it.
   size_t AddStyle(const TextStyle& style);
 
   const TextStyle& GetStyle(size_t style_index) const;
@@ -93,7 +97,7 @@ class StyledRuns {
         : style_index(style_index), start(start), end(end) {}
   };
 
-  std::vector<TextStyle> styles_;
+  std::vector<std::shared_ptr<const TextStyle>> styles_;
   std::vector<IndexedRun> runs_;
 };
 
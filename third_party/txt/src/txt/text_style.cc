@@ -67,4 +67,30 @@ bool TextStyle::equals(const TextStyle& other) const {
   return true;
 }
 
+bool TextStyle::operator==(const TextStyle& other) const {
+  return color == other.color && decoration == other.decoration &&
+         decoration_color == other.decoration_color &&
+         decoration_style == other.decoration_style &&
+         decoration_thickness_multiplier ==
+             other.decoration_thickness_multiplier &&
+         font_weight == other.font_weight && font_style == other.font_style &&
+         text_baseline == other.text_baseline &&
+         font_families == other.font_families &&
+         font_size == other.font_size &&
+         letter_spacing == other.letter_spacing &&
+         word_spacing == other.word_spacing && height == other.height &&
+         has_height_override == other.has_height_override &&
+         locale == other.locale && has_background == other.has_background &&
+         background == other.background &&
+         has_foreground == other.has_foreground &&
+         foreground == other.foreground &&
+         text_shadows == other.text_shadows &&
+         font_features.GetFontFeatures() ==
+             other.font_features.GetFontFeatures();
+}
+
+bool TextStyle::operator!=(const TextStyle& other) const {
+  return !(*this == other);
+}
+
 }  // namespace txt
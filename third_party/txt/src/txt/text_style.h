@@ -65,6 +65,11 @@ class TextStyle {
   TextStyle();
 
   bool equals(const TextStyle& other) const;
+
+  // Unlike equals(), compares every property of the styles.
+  bool operator==(const TextStyle& other) const;
+
+  bool operator!=(const TextStyle& other) const;
 };
 
 }  // namespace txt
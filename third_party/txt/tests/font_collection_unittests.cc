@@ -17,7 +17,9 @@
 #include "flutter/fml/logging.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/utils/SkCustomTypeface.h"
+#include "txt/asset_font_manager.h"
 #include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
 #include "txt_test_utils.h"
 
 namespace txt {
@@ -63,6 +65,37 @@ void PopulateUserTypefaceBoilerplate(SkCustomTypefaceBuilder* builder) {
     builder->setGlyph(index, width / upem, path.makeTransform(scale));
   }
 }
+
+// Resolves every character to the one font it provides, and counts how often
+// it is asked to.
+class FallbackFontManager : public AssetFontManager {
+ public:
+  explicit FallbackFontManager(sk_sp<SkTypeface> typeface)
+      : AssetFontManager(CreateProvider(typeface)),
+        typeface_(std::move(typeface)) {}
+
+  int match_count() const { return match_count_; }
+
+ private:
+  sk_sp<SkTypeface> typeface_;
+  mutable int match_count_ = 0;
+
+  static std::unique_ptr<FontAssetProvider> CreateProvider(
+      sk_sp<SkTypeface> typeface) {
+    auto provider = std::make_unique<TypefaceFontAssetProvider>();
+    provider->RegisterTypeface(std::move(typeface));
+    return provider;
+  }
+
+  SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
+                                          const SkFontStyle&,
+                                          const char* bcp47[],
+                                          int bcp47Count,
+                                          SkUnichar character) const override {
+    match_count_++;
+    return SkRef(typeface_.get());
+  }
+};
 }  // namespace
 
 TEST(FontCollectionTest, CheckSkTypefacesSorting) {
@@ -138,6 +171,65 @@ TEST(FontCollectionTest, CheckSkTypefacesSorting) {
             SkFontStyle::kExpanded_Width);
 }
 
+TEST(FontCollectionTest, ReusesLoadedFallbackFonts) {
+  sk_sp<SkTypeface> roboto =
+      GetTestFontCollection()->MatchTypeface("Roboto", SkFontStyle());
+  ASSERT_NE(roboto, nullptr);
+  auto manager = sk_make_sp<FallbackFontManager>(roboto);
+  auto collection = std::make_shared<FontCollection>();
+  collection->SetDefaultFontManager(manager);
+
+  const auto& a_family = collection->MatchFallbackFont('a', "");
+  ASSERT_NE(a_family, nullptr);
+  ASSERT_EQ(manager->match_count(), 1);
+
+  // The font loaded for 'a' covers 'b' as well.
+  ASSERT_EQ(collection->MatchFallbackFont('b', ""), a_family);
+  ASSERT_EQ(manager->match_count(), 1);
+
+  // Fallback fonts are resolved per locale.
+  ASSERT_NE(collection->MatchFallbackFont('a', "ja"), nullptr);
+  ASSERT_EQ(manager->match_count(), 2);
+
+  // Reloading the system fonts resolves the fallback fonts again.
+  collection->SetupDefaultFontManager();
+  collection->SetDefaultFontManager(manager);
+  ASSERT_NE(collection->MatchFallbackFont('a', ""), nullptr);
+  ASSERT_EQ(manager->match_count(), 3);
+}
+
+// Latin-1 text covered by the first family skips the per character family
+// lookup, which must not extend its runs over other characters.
+TEST(FontCollectionTest, ItemizesLatin1SpansWithTheFirstFamily) {
+  std::shared_ptr<minikin::FontCollection> collection =
+      GetTestFontCollection()->GetMinikinFontCollectionForFamilies(
+          {"Roboto", "Noto Sans CJK JP"}, "en-US");
+  ASSERT_NE(collection, nullptr);
+
+  const std::u16string text = u"Caf\u00e9, \u4e16\u754c World";
+  std::vector<minikin::FontCollection::Run> runs;
+  collection->itemize(reinterpret_cast<const uint16_t*>(text.data()),
+                      text.size(), minikin::FontStyle(), &runs);
+
+  ASSERT_EQ(runs.size(), 3u);
+  EXPECT_EQ(runs[0].start, 0);
+  EXPECT_EQ(runs[0].end, 6);
+  EXPECT_EQ(runs[1].start, 6);
+  EXPECT_EQ(runs[1].end, 8);
+  EXPECT_EQ(runs[2].start, 8);
+  EXPECT_EQ(runs[2].end, static_cast<int>(text.size()));
+  EXPECT_EQ(runs[0].fakedFont.font, runs[2].fakedFont.font);
+  EXPECT_NE(runs[0].fakedFont.font, runs[1].fakedFont.font);
+
+  // A single character is itemized as well as a span.
+  const std::u16string single = u"a";
+  runs.clear();
+  collection->itemize(reinterpret_cast<const uint16_t*>(single.data()),
+                      single.size(), minikin::FontStyle(), &runs);
+  ASSERT_EQ(runs.size(), 1u);
+  EXPECT_EQ(runs[0].end, 1);
+}
+
 #if 0
 
 TEST(FontCollection, HasDefaultRegistrations) {
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "txt/font_skia.h"
+
+#include <hb.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/build_config.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "txt_test_utils.h"
+
+namespace txt {
+
+TEST(FontSkiaTest, HarfBuzzFaceReadsTablesFromFontData) {
+  sk_sp<SkTypeface> typeface =
+      GetTestFontCollection()->MatchTypeface("Roboto", SkFontStyle());
+  ASSERT_NE(typeface, nullptr);
+  FontSkia font(typeface);
+
+  hb_face_t* face = font.CreateHarfBuzzFace();
+  const hb_tag_t cmap_tag = HB_TAG('c', 'm', 'a', 'p');
+  hb_blob_t* cmap = hb_face_reference_table(face, cmap_tag);
+  unsigned int cmap_size = 0;
+  const char* cmap_data = hb_blob_get_data(cmap, &cmap_size);
+
+  std::vector<char> expected(typeface->getTableSize(cmap_tag));
+  ASSERT_GT(expected.size(), 0u);
+  typeface->getTableData(cmap_tag, 0, expected.size(), expected.data());
+  ASSERT_EQ(cmap_size, expected.size());
+  ASSERT_EQ(memcmp(cmap_data, expected.data(), cmap_size), 0);
+
+#if !defined(OS_MACOSX)
+  // The table is not copied out of the font data.
+  std::unique_ptr<SkStreamAsset> stream = typeface->openStream(nullptr);
+  ASSERT_NE(stream->getMemoryBase(), nullptr);
+  const char* font_data = static_cast<const char*>(stream->getMemoryBase());
+  ASSERT_GE(cmap_data, font_data);
+  ASSERT_LE(cmap_data + cmap_size, font_data + stream->getLength());
+#endif
+
+  hb_blob_destroy(cmap);
+  hb_face_destroy(face);
+}
+
+}  // namespace txt
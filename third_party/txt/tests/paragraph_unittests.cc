@@ -16,14 +16,18 @@
 
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 #include "flutter/fml/logging.h"
+#include "minikin/Layout.h"
 #include "render_test.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "txt/font_style.h"
 #include "txt/font_weight.h"
+#include "txt/glyph_usage_recorder.h"
 #include "txt/paragraph_builder_txt.h"
 #include "txt/paragraph_txt.h"
 #include "txt/placeholder_run.h"
@@ -68,7 +72,7 @@ TEST_F(ParagraphTest, SimpleParagraph) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_TRUE(Snapshot());
 }
@@ -109,7 +113,7 @@ TEST_F(ParagraphTest, SimpleParagraphSmall) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_TRUE(Snapshot());
 }
@@ -1641,7 +1645,7 @@ TEST_F(ParagraphTest, SimpleRedParagraph) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_TRUE(Snapshot());
 }
@@ -1733,10 +1737,10 @@ TEST_F(ParagraphTest, RainbowParagraph) {
   ASSERT_TRUE(Snapshot());
   ASSERT_EQ(paragraph->runs_.runs_.size(), 4ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 5ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style1));
-  ASSERT_TRUE(paragraph->runs_.styles_[2].equals(text_style2));
-  ASSERT_TRUE(paragraph->runs_.styles_[3].equals(text_style3));
-  ASSERT_TRUE(paragraph->runs_.styles_[4].equals(text_style4));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style1));
+  ASSERT_TRUE(paragraph->runs_.styles_[2]->equals(text_style2));
+  ASSERT_TRUE(paragraph->runs_.styles_[3]->equals(text_style3));
+  ASSERT_TRUE(paragraph->runs_.styles_[4]->equals(text_style4));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style1.color);
   ASSERT_EQ(paragraph->records_[1].style().color, text_style2.color);
   ASSERT_EQ(paragraph->records_[2].style().color, text_style3.color);
@@ -1804,7 +1808,7 @@ TEST_F(ParagraphTest, BoldParagraph) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_TRUE(Snapshot());
 
@@ -1939,7 +1943,7 @@ TEST_F(ParagraphTest, DISABLE_ON_WINDOWS(LeftAlignParagraph)) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_.size(), paragraph_style.max_lines);
   double expected_y = 24;
 
@@ -2036,7 +2040,7 @@ TEST_F(ParagraphTest, DISABLE_ON_WINDOWS(RightAlignParagraph)) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   // Two records for each due to 'ghost' trailing whitespace run.
   ASSERT_EQ(paragraph->records_.size(), paragraph_style.max_lines * 2);
   double expected_y = 24;
@@ -2154,7 +2158,7 @@ TEST_F(ParagraphTest, DISABLE_ON_WINDOWS(CenterAlignParagraph)) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   // Two records for each due to 'ghost' trailing whitespace run.
   ASSERT_EQ(paragraph->records_.size(), paragraph_style.max_lines * 2);
   double expected_y = 24;
@@ -2263,7 +2267,7 @@ TEST_F(ParagraphTest, DISABLE_ON_WINDOWS(JustifyAlignParagraph)) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_.size(), 27ull);
   double expected_y = 24;
 
@@ -2818,7 +2822,7 @@ TEST_F(ParagraphTest, ChineseParagraph) {
 
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_EQ(paragraph->records_.size(), 7ull);
 
@@ -2865,7 +2869,7 @@ TEST_F(ParagraphTest, DISABLED_ArabicParagraph) {
 
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_EQ(paragraph->records_.size(), 2ull);
   ASSERT_EQ(paragraph->paragraph_style_.text_direction, TextDirection::rtl);
@@ -5061,7 +5065,7 @@ TEST_F(ParagraphTest, LongWordParagraph) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_EQ(paragraph->GetLineCount(), 4ull);
   ASSERT_TRUE(Snapshot());
@@ -5358,7 +5362,7 @@ TEST_F(ParagraphTest, HyphenBreakParagraph) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_EQ(paragraph->GetLineCount(), 5ull);
   ASSERT_TRUE(Snapshot());
@@ -5403,7 +5407,7 @@ TEST_F(ParagraphTest, RepeatLayoutParagraph) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_EQ(paragraph->GetLineCount(), 12ull);
 
@@ -5419,12 +5423,282 @@ TEST_F(ParagraphTest, RepeatLayoutParagraph) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
   ASSERT_EQ(paragraph->GetLineCount(), 6ull);
   ASSERT_TRUE(Snapshot());
 }
 
+TEST_F(ParagraphTest, ResizeRealignsUnbrokenLines) {
+  auto build = [this](double width) {
+    txt::ParagraphStyle paragraph_style;
+    paragraph_style.text_align = TextAlign::center;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.font_size = 26;
+    text_style.color = SK_ColorBLACK;
+    builder.PushStyle(text_style);
+    builder.AddText(u"Short line\nA somewhat longer line");
+    builder.Pop();
+
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(width);
+    return paragraph;
+  };
+
+  auto paragraph = build(500);
+  ASSERT_EQ(paragraph->GetLineCount(), 2ull);
+  const double line_width = paragraph->GetMaxIntrinsicWidth();
+  ASSERT_LT(line_width, 400);
+
+  // Growing and shrinking while every line fits only realigns the lines.
+  for (double width : {800.0, 400.0}) {
+    paragraph->Layout(width);
+    auto expected = build(width);
+    ASSERT_EQ(paragraph->GetLineCount(), expected->GetLineCount());
+    ASSERT_EQ(paragraph->records_.size(), expected->records_.size());
+    for (size_t i = 0; i < paragraph->records_.size(); ++i) {
+      ASSERT_EQ(paragraph->records_[i].offset(),
+                expected->records_[i].offset());
+    }
+    for (size_t i = 0; i < paragraph->line_metrics_.size(); ++i) {
+      ASSERT_DOUBLE_EQ(paragraph->line_metrics_[i].left,
+                       expected->line_metrics_[i].left);
+    }
+    auto boxes = paragraph->GetRectsForRange(
+        0, 30, Paragraph::RectHeightStyle::kTight,
+        Paragraph::RectWidthStyle::kTight);
+    auto expected_boxes = expected->GetRectsForRange(
+        0, 30, Paragraph::RectHeightStyle::kTight,
+        Paragraph::RectWidthStyle::kTight);
+    ASSERT_EQ(boxes.size(), expected_boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      ASSERT_EQ(boxes[i].rect, expected_boxes[i].rect);
+    }
+    ASSERT_EQ(paragraph->GetGlyphPositionAtCoordinate(width / 2, 5).position,
+              expected->GetGlyphPositionAtCoordinate(width / 2, 5).position);
+  }
+
+  // Lines that no longer fit are broken again.
+  paragraph->Layout(line_width / 2);
+  ASSERT_GT(paragraph->GetLineCount(), 2ull);
+}
+
+TEST_F(ParagraphTest, ResizeReplaysBreakOpportunities) {
+  auto build = [this](double width) {
+    txt::ParagraphStyle paragraph_style;
+    paragraph_style.break_strategy = minikin::kBreakStrategy_HighQuality;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+    txt::TextStyle text_style;
+    text_style.font_families = std::vector<std::string>(1, "Roboto");
+    text_style.font_size = 26;
+    text_style.color = SK_ColorBLACK;
+    builder.PushStyle(text_style);
+    builder.AddText(u"This is a very long sentence to test if the text will "
+                    u"properly wrap around\nand go to the next line.");
+    text_style.font_size = 14;
+    builder.PushStyle(text_style);
+    builder.AddText(u" Smaller words follow, some of them hyphen-ated.");
+    builder.Pop();
+    builder.Pop();
+
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(width);
+    return paragraph;
+  };
+
+  auto paragraph = build(550);
+  ASSERT_EQ(paragraph->break_opportunities_.size(), 2ull);
+  ASSERT_FALSE(paragraph->break_opportunities_[0].empty());
+  ASSERT_FALSE(paragraph->break_opportunities_[1].empty());
+
+  // Breaking at another width replays the recorded opportunities, and breaks
+  // the lines as a new paragraph would.
+  for (double width : {300.0, 120.0, 700.0}) {
+    paragraph->Layout(width);
+    auto expected = build(width);
+    ASSERT_EQ(paragraph->GetLineCount(), expected->GetLineCount());
+    for (size_t i = 0; i < paragraph->line_metrics_.size(); ++i) {
+      ASSERT_EQ(paragraph->line_metrics_[i].start_index,
+                expected->line_metrics_[i].start_index);
+      ASSERT_EQ(paragraph->line_metrics_[i].end_index,
+                expected->line_metrics_[i].end_index);
+      ASSERT_DOUBLE_EQ(paragraph->line_widths_[i], expected->line_widths_[i]);
+    }
+    ASSERT_DOUBLE_EQ(paragraph->GetMaxIntrinsicWidth(),
+                     expected->GetMaxIntrinsicWidth());
+  }
+
+  // A dirty paragraph records its opportunities again.
+  paragraph->SetDirty(true);
+  paragraph->Layout(300);
+  ASSERT_EQ(paragraph->GetLineCount(), build(300)->GetLineCount());
+}
+
+TEST_F(ParagraphTest, PaintMergesTextPaintedAlike) {
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.font_size = 20;
+  text_style.color = SK_ColorBLACK;
+  for (int i = 0; i < 10; ++i) {
+    text_style.font_weight = i % 2 ? FontWeight::w700 : FontWeight::w400;
+    text_style.decoration =
+        i == 3 ? TextDecoration::kUnderline : TextDecoration::kNone;
+    builder.PushStyle(text_style);
+    builder.AddText(u"word ");
+    builder.Pop();
+  }
+  text_style.color = SK_ColorRED;
+  builder.PushStyle(text_style);
+  builder.AddText(u"red");
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(GetTestCanvasWidth());
+  ASSERT_EQ(paragraph->GetLineCount(), 1ull);
+  ASSERT_EQ(paragraph->records_.size(), 11ull);
+
+  // The black records share a blob, the red one is drawn on its own.
+  ASSERT_EQ(paragraph->line_blobs_.size(), 1ull);
+  ASSERT_EQ(paragraph->line_blobs_[0].first_record, 0ull);
+  ASSERT_EQ(paragraph->line_blobs_[0].record_count, 10ull);
+
+  // Painting draws the merged text, the red text and the underline, besides
+  // saving, translating and restoring the canvas.
+  SkPictureRecorder recorder;
+  paragraph->Paint(
+      recorder.beginRecording(SkRect::MakeWH(GetTestCanvasWidth(), 100)), 10,
+      10);
+  ASSERT_EQ(recorder.finishRecordingAsPicture()->approximateOpCount(), 6);
+  ASSERT_EQ(paragraph->decorations_[3].size(), 1ull);
+
+  // The merged text looks the same as the text of each record.
+  SkBitmap expected;
+  expected.allocN32Pixels(GetTestCanvasWidth(), 100);
+  SkCanvas expected_canvas(expected);
+  expected_canvas.clear(SK_ColorWHITE);
+  for (const PaintRecord& record : paragraph->records_) {
+    SkPaint paint;
+    paint.setColor(record.style().color);
+    expected_canvas.drawTextBlob(record.text(), record.offset().x() + 10,
+                                 record.offset().y() + 10, paint);
+    for (const auto& decoration :
+         paragraph->decorations_[&record - paragraph->records_.data()]) {
+      SkAutoCanvasRestore auto_restore(&expected_canvas, true);
+      expected_canvas.translate(10, 10);
+      expected_canvas.drawPath(decoration.path, decoration.paint);
+    }
+  }
+  SkBitmap actual;
+  actual.allocN32Pixels(GetTestCanvasWidth(), 100);
+  SkCanvas actual_canvas(actual);
+  actual_canvas.clear(SK_ColorWHITE);
+  paragraph->Paint(&actual_canvas, 10, 10);
+  ASSERT_EQ(std::memcmp(actual.getPixels(), expected.getPixels(),
+                        actual.computeByteSize()),
+            0);
+}
+
+TEST_F(ParagraphTest, EqualStylesAreSharedAcrossParagraphs) {
+  auto build = [this](const txt::TextStyle& text_style) {
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(u"Hello");
+    builder.Pop();
+    return BuildParagraph(builder);
+  };
+
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  text_style.text_shadows.emplace_back(SK_ColorRED, SkPoint::Make(1, 1), 2);
+  auto first = build(text_style);
+  auto second = build(text_style);
+  ASSERT_EQ(&first->runs_.GetStyle(1), &second->runs_.GetStyle(1));
+
+  // Unlike equals(), interning tells styles of different sizes apart.
+  text_style.font_size = 30;
+  auto third = build(text_style);
+  ASSERT_NE(&third->runs_.GetStyle(1), &first->runs_.GetStyle(1));
+  ASSERT_EQ(third->runs_.GetStyle(1).font_size, 30);
+  ASSERT_EQ(first->runs_.GetStyle(1).font_size, 14);
+}
+
+TEST_F(ParagraphTest, ShapedWordsAreSharedAcrossParagraphs) {
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.color = SK_ColorBLACK;
+  text_style.font_features.SetFeature("tnum", 1);
+
+  auto layout = [&](const std::u16string& text) {
+    txt::ParagraphStyle paragraph_style;
+    txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(text);
+    builder.Pop();
+    auto paragraph = BuildParagraph(builder);
+    paragraph->Layout(500);
+  };
+
+  minikin::Layout::purgeCaches();
+  layout(u"Buy $12.50");
+  const minikin::LayoutCacheStats first = minikin::Layout::getCacheStats();
+  ASSERT_GT(first.missCount, 0ull);
+  ASSERT_GT(first.entryCount, 0ull);
+
+  // A different paragraph with the same words is shaped from the cache.
+  layout(u"Buy $12.50");
+  const minikin::LayoutCacheStats second = minikin::Layout::getCacheStats();
+  ASSERT_EQ(second.missCount, first.missCount);
+  ASSERT_GT(second.hitCount, first.hitCount);
+  ASSERT_EQ(second.entryCount, first.entryCount);
+
+  // Different font features are shaped separately.
+  text_style.font_features.SetFeature("tnum", 0);
+  layout(u"Buy $12.50");
+  ASSERT_GT(minikin::Layout::getCacheStats().missCount, second.missCount);
+}
+
+TEST_F(ParagraphTest, RecordsGlyphUsage) {
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, "Roboto");
+  text_style.font_size = 20;
+  text_style.color = SK_ColorBLACK;
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  builder.PushStyle(text_style);
+  builder.AddText(u"Hello");
+  builder.Pop();
+  auto paragraph = BuildParagraph(builder);
+
+  GlyphUsageRecorder& recorder = GlyphUsageRecorder::GetInstance();
+  recorder.Clear();
+  GlyphUsageRecorder::SetEnabled(true);
+  paragraph->Layout(500);
+  GlyphUsageRecorder::SetEnabled(false);
+
+  const GlyphUsageRecorder::Usage usage = recorder.GetUsage();
+  ASSERT_EQ(usage.size(), 1ull);
+  EXPECT_EQ(usage.begin()->first.family, "Roboto");
+  EXPECT_EQ(usage.begin()->first.size, 20);
+  // "l" is used twice.
+  EXPECT_EQ(usage.begin()->second.size(), 4ull);
+
+  // Disabled recording keeps the usage recorded so far.
+  paragraph->Layout(400);
+  ASSERT_EQ(recorder.GetUsage().begin()->second, usage.begin()->second);
+  GlyphUsageRecorder::Prewarm(usage, *GetTestFontCollection(), 2);
+  recorder.Clear();
+}
+
 TEST_F(ParagraphTest, Ellipsize) {
   const char* text =
       "This is a very long sentence to test if the text will properly wrap "
@@ -5569,7 +5843,7 @@ TEST_F(ParagraphTest, SimpleShadow) {
   }
   ASSERT_EQ(paragraph->runs_.runs_.size(), 1ull);
   ASSERT_EQ(paragraph->runs_.styles_.size(), 2ull);
-  ASSERT_TRUE(paragraph->runs_.styles_[1].equals(text_style));
+  ASSERT_TRUE(paragraph->runs_.styles_[1]->equals(text_style));
   ASSERT_EQ(paragraph->records_[0].style().color, text_style.color);
 
   ASSERT_EQ(paragraph->records_[0].style().text_shadows.size(), 1ull);
@@ -6560,4 +6834,81 @@ TEST_F(ParagraphTest, TextHeightBehaviorRectsParagraph) {
   ASSERT_TRUE(Snapshot());
 }
 
+// Lays out |text| and returns the width of each glyph position, so that
+// layouts can be compared.
+static std::vector<double> LayOutAndMeasure(const std::string& text,
+                                            const std::string& family) {
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+  txt::ParagraphBuilderTxt builder(paragraph_style, GetTestFontCollection());
+  txt::TextStyle text_style;
+  text_style.font_families = std::vector<std::string>(1, family);
+  text_style.font_size = 26;
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+
+  auto paragraph = BuildParagraph(builder);
+  paragraph->Layout(300);
+  std::vector<double> measurements = {paragraph->GetMaxIntrinsicWidth(),
+                                      paragraph->GetHeight()};
+  for (size_t i = 0; i < u16_text.length(); i++) {
+    for (const auto& box : paragraph->GetRectsForRange(
+             i, i + 1, Paragraph::RectHeightStyle::kTight,
+             Paragraph::RectWidthStyle::kTight)) {
+      measurements.push_back(box.rect.width());
+    }
+  }
+  return measurements;
+}
+
+// Shaping takes no global lock, so paragraphs laid out on several threads,
+// which share the layout and HarfBuzz font caches, must match those laid out
+// on one.
+TEST_F(ParagraphTest, ParagraphsCanBeLaidOutConcurrently) {
+  const std::vector<std::pair<std::string, std::string>> paragraphs = {
+      {"Hello World Text Dialog. The quick brown fox jumps.", "Roboto"},
+      {"Hello World again, with the same words in another font.",
+       "Droid Serif"},
+      {"من أسرع الطرق للتعلم أن تعلم غيرك", "Noto Naskh Arabic"},
+      {"個人的な問題です。Hello World", "Noto Sans CJK JP"},
+  };
+
+  minikin::Layout::purgeCaches();
+  std::vector<std::vector<double>> expected;
+  for (const auto& [text, family] : paragraphs) {
+    expected.push_back(LayOutAndMeasure(text, family));
+  }
+
+  minikin::Layout::purgeCaches();
+  const size_t kThreadCount = 8;
+  const size_t kIterationCount = 20;
+  std::vector<std::vector<std::vector<double>>> results(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadCount; t++) {
+    threads.emplace_back([&, t] {
+      // Threads start at different paragraphs, so that they miss the caches
+      // at the same time for different words.
+      for (size_t i = 0; i < kIterationCount * paragraphs.size(); i++) {
+        const auto& [text, family] = paragraphs[(i + t) % paragraphs.size()];
+        results[t].push_back(LayOutAndMeasure(text, family));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < kThreadCount; t++) {
+    ASSERT_EQ(results[t].size(), kIterationCount * paragraphs.size());
+    for (size_t i = 0; i < results[t].size(); i++) {
+      EXPECT_EQ(results[t][i], expected[(i + t) % paragraphs.size()])
+          << "Thread " << t << ", iteration " << i;
+    }
+  }
+}
+
 }  // namespace txt
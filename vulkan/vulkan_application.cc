@@ -49,6 +49,24 @@ VulkanApplication::VulkanApplication(
         VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
   }
 #endif
+#if OS_ANDROID
+  // The device extensions that import hardware buffers and export fences
+  // depend on these. See |VulkanDevice::SupportsHardwareBufferPresentation|.
+  if (ExtensionSupported(supported_extensions,
+                         VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) &&
+      ExtensionSupported(supported_extensions,
+                         VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME) &&
+      ExtensionSupported(
+          supported_extensions,
+          VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME)) {
+    enabled_extensions.emplace_back(
+        VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    enabled_extensions.emplace_back(
+        VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
+    enabled_extensions.emplace_back(
+        VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
+  }
+#endif  // OS_ANDROID
 
   const char* extensions[enabled_extensions.size()];
 
@@ -4,6 +4,8 @@
 
 #include "vulkan_device.h"
 
+#include <cstring>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <vector>
@@ -59,7 +61,7 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
       .pQueuePriorities = priorities,
   };
 
-  const char* extensions[] = {
+  std::vector<const char*> extensions = {
 #if OS_ANDROID
     VK_KHR_SWAPCHAIN_EXTENSION_NAME,
 #endif
@@ -72,6 +74,40 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
 #endif
   };
 
+#if OS_ANDROID
+  // Display timing is optional. It is only used for pacing feedback when the
+  // swapchain asks for it.
+  if (HasDeviceExtension(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME)) {
+    extensions.push_back(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
+    supports_display_timing_ = true;
+  }
+
+  // Importing hardware buffers as images and exporting fences for the system
+  // compositor is optional. It is only used by the SurfaceControl swapchain.
+  const char* hardware_buffer_extensions[] = {
+      VK_KHR_MAINTENANCE1_EXTENSION_NAME,
+      VK_KHR_BIND_MEMORY_2_EXTENSION_NAME,
+      VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+      VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,
+      VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,
+      VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
+      VK_ANDROID_EXTERNAL_MEMORY_ANDROID_HARDWARE_BUFFER_EXTENSION_NAME,
+      VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME,
+      VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME,
+  };
+  supports_hardware_buffer_presentation_ = true;
+  for (const char* extension : hardware_buffer_extensions) {
+    if (!HasDeviceExtension(extension)) {
+      supports_hardware_buffer_presentation_ = false;
+      break;
+    }
+  }
+  if (supports_hardware_buffer_presentation_) {
+    extensions.insert(extensions.end(), std::begin(hardware_buffer_extensions),
+                      std::end(hardware_buffer_extensions));
+  }
+#endif  // OS_ANDROID
+
   auto enabled_layers =
       DeviceLayersToEnable(vk, physical_device_, enable_validation_layers_);
 
@@ -89,8 +125,8 @@ VulkanDevice::VulkanDevice(VulkanProcTable& p_vk,
       .pQueueCreateInfos = &queue_create,
       .enabledLayerCount = static_cast<uint32_t>(enabled_layers.size()),
       .ppEnabledLayerNames = layers,
-      .enabledExtensionCount = sizeof(extensions) / sizeof(const char*),
-      .ppEnabledExtensionNames = extensions,
+      .enabledExtensionCount = static_cast<uint32_t>(extensions.size()),
+      .ppEnabledExtensionNames = extensions.data(),
       .pEnabledFeatures = nullptr,
   };
 
@@ -313,6 +349,7 @@ int VulkanDevice::ChooseSurfaceFormat(const VulkanSurface& surface,
 }
 
 bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
+                                     VkPresentModeKHR preferred_present_mode,
                                      VkPresentModeKHR* present_mode) const {
   if (!surface.IsValid() || present_mode == nullptr) {
     return false;
@@ -325,13 +362,93 @@ bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
   // powered by Vsync pulses instead of depending the submit to block.
   // However, for platforms that don't have VSync providers setup, it is better
   // to fall back to FIFO. For platforms that do have VSync providers, there
-  // should be little difference. In case there is a need for a mode other than
-  // FIFO, availability checks must be performed here before returning the
-  // result. FIFO is always present.
+  // should be little difference. Other modes are only used when explicitly
+  // preferred and supported by the surface. FIFO is always present.
   *present_mode = VK_PRESENT_MODE_FIFO_KHR;
+
+#if OS_ANDROID
+  if (preferred_present_mode == VK_PRESENT_MODE_FIFO_KHR) {
+    return true;
+  }
+
+  uint32_t mode_count = 0;
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, nullptr)) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  std::vector<VkPresentModeKHR> modes(mode_count);
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, modes.data())) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  for (uint32_t i = 0; i < mode_count; i++) {
+    if (modes[i] == preferred_present_mode) {
+      *present_mode = preferred_present_mode;
+      break;
+    }
+  }
+
+  if (*present_mode != preferred_present_mode) {
+    FML_DLOG(INFO) << "Present mode " << preferred_present_mode
+                   << " is not supported by the surface. Using FIFO.";
+  }
+#endif  // OS_ANDROID
   return true;
 }
 
+bool VulkanDevice::SupportsDisplayTiming() const {
+  return supports_display_timing_;
+}
+
+bool VulkanDevice::SupportsHardwareBufferPresentation() const {
+  return supports_hardware_buffer_presentation_;
+}
+
+std::string VulkanDevice::GetPipelineCacheUUID() const {
+  if (!physical_device_) {
+    return "";
+  }
+
+  VkPhysicalDeviceProperties properties = {};
+  vk.GetPhysicalDeviceProperties(physical_device_, &properties);
+
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  std::string uuid;
+  uuid.reserve(VK_UUID_SIZE * 2);
+  for (uint32_t i = 0; i < VK_UUID_SIZE; i++) {
+    uuid.push_back(kHexDigits[properties.pipelineCacheUUID[i] >> 4]);
+    uuid.push_back(kHexDigits[properties.pipelineCacheUUID[i] & 0xf]);
+  }
+  return uuid;
+}
+
+bool VulkanDevice::HasDeviceExtension(const char* name) const {
+  uint32_t count = 0;
+  if (VK_CALL_LOG_ERROR(vk.EnumerateDeviceExtensionProperties(
+          physical_device_, nullptr, &count, nullptr)) != VK_SUCCESS) {
+    return false;
+  }
+
+  std::vector<VkExtensionProperties> properties(count);
+  if (VK_CALL_LOG_ERROR(vk.EnumerateDeviceExtensionProperties(
+          physical_device_, nullptr, &count, properties.data())) !=
+      VK_SUCCESS) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    if (strncmp(properties[i].extensionName, name,
+                VK_MAX_EXTENSION_NAME_SIZE) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool VulkanDevice::QueueSubmit(
     std::vector<VkPipelineStageFlags> wait_dest_pipeline_stages,
     const std::vector<VkSemaphore>& wait_semaphores,
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_VULKAN_VULKAN_DEVICE_H_
 #define FLUTTER_VULKAN_VULKAN_DEVICE_H_
 
+#include <string>
 #include <vector>
 
 #include "flutter/fml/compiler_specific.h"
@@ -52,9 +53,23 @@ class VulkanDevice {
                                         std::vector<VkFormat> desired_formats,
                                         VkSurfaceFormatKHR* format) const;
 
+  // Picks |preferred_present_mode| if the surface supports it, and FIFO
+  // otherwise.
   [[nodiscard]] bool ChoosePresentMode(const VulkanSurface& surface,
+                                       VkPresentModeKHR preferred_present_mode,
                                        VkPresentModeKHR* present_mode) const;
 
+  // Whether VK_GOOGLE_display_timing was enabled on this device.
+  bool SupportsDisplayTiming() const;
+
+  // Whether the extensions that import AHardwareBuffers as images and export
+  // semaphores as sync fences were enabled on this device.
+  bool SupportsHardwareBufferPresentation() const;
+
+  // The pipeline cache UUID of the physical device as a hex string. Pipeline
+  // cache data is only compatible between devices with the same UUID.
+  std::string GetPipelineCacheUUID() const;
+
   [[nodiscard]] bool QueueSubmit(
       std::vector<VkPipelineStageFlags> wait_dest_pipeline_stages,
       const std::vector<VkSemaphore>& wait_semaphores,
@@ -73,9 +88,13 @@ class VulkanDevice {
   uint32_t graphics_queue_index_;
   bool valid_;
   bool enable_validation_layers_;
+  bool supports_display_timing_ = false;
+  bool supports_hardware_buffer_presentation_ = false;
 
   std::vector<VkQueueFamilyProperties> GetQueueFamilyProperties() const;
 
+  bool HasDeviceExtension(const char* name) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(VulkanDevice);
 };
 
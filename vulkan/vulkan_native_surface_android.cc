@@ -62,6 +62,10 @@ bool VulkanNativeSurfaceAndroid::IsValid() const {
   return native_window_ != nullptr;
 }
 
+ANativeWindow* VulkanNativeSurfaceAndroid::GetNativeWindow() const {
+  return native_window_;
+}
+
 SkISize VulkanNativeSurfaceAndroid::GetSize() const {
   return native_window_ == nullptr
              ? SkISize::Make(0, 0)
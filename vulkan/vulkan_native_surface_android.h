@@ -33,6 +33,8 @@ class VulkanNativeSurfaceAndroid : public VulkanNativeSurface {
 
   SkISize GetSize() const override;
 
+  ANativeWindow* GetNativeWindow() const;
+
  private:
   ANativeWindow* native_window_;
 
@@ -74,10 +74,12 @@ bool VulkanProcTable::SetupInstanceProcAddresses(
   ACQUIRE_PROC(CreateDevice, handle);
   ACQUIRE_PROC(DestroyDevice, handle);
   ACQUIRE_PROC(DestroyInstance, handle);
+  ACQUIRE_PROC(EnumerateDeviceExtensionProperties, handle);
   ACQUIRE_PROC(EnumerateDeviceLayerProperties, handle);
   ACQUIRE_PROC(EnumeratePhysicalDevices, handle);
   ACQUIRE_PROC(GetDeviceProcAddr, handle);
   ACQUIRE_PROC(GetPhysicalDeviceFeatures, handle);
+  ACQUIRE_PROC(GetPhysicalDeviceProperties, handle);
   ACQUIRE_PROC(GetPhysicalDeviceQueueFamilyProperties, handle);
 #if OS_ANDROID
   ACQUIRE_PROC(GetPhysicalDeviceSurfaceCapabilitiesKHR, handle);
@@ -135,6 +137,20 @@ bool VulkanProcTable::SetupDeviceProcAddresses(
   ACQUIRE_PROC(DestroySwapchainKHR, handle);
   ACQUIRE_PROC(GetSwapchainImagesKHR, handle);
   ACQUIRE_PROC(QueuePresentKHR, handle);
+  // The display timing functions are optional. Users check for their presence
+  // explicitly.
+  [this, &handle]() -> bool {
+    ACQUIRE_PROC(GetPastPresentationTimingGOOGLE, handle);
+    ACQUIRE_PROC(GetRefreshCycleDurationGOOGLE, handle);
+    return true;
+  }();
+  // So are the functions to import hardware buffers and export fences, which
+  // are only used by |VulkanSurfaceControlSwapchain|.
+  [this, &handle]() -> bool {
+    ACQUIRE_PROC(GetAndroidHardwareBufferPropertiesANDROID, handle);
+    ACQUIRE_PROC(GetSemaphoreFdKHR, handle);
+    return true;
+  }();
 #endif  // OS_ANDROID
 #if OS_FUCHSIA
   ACQUIRE_PROC(GetMemoryZirconHandleFUCHSIA, handle);
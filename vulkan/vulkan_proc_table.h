@@ -88,6 +88,7 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(DestroySwapchainKHR);
   DEFINE_PROC(DeviceWaitIdle);
   DEFINE_PROC(EndCommandBuffer);
+  DEFINE_PROC(EnumerateDeviceExtensionProperties);
   DEFINE_PROC(EnumerateDeviceLayerProperties);
   DEFINE_PROC(EnumerateInstanceExtensionProperties);
   DEFINE_PROC(EnumerateInstanceLayerProperties);
@@ -99,6 +100,7 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(GetImageMemoryRequirements);
   DEFINE_PROC(GetInstanceProcAddr);
   DEFINE_PROC(GetPhysicalDeviceFeatures);
+  DEFINE_PROC(GetPhysicalDeviceProperties);
   DEFINE_PROC(GetPhysicalDeviceQueueFamilyProperties);
   DEFINE_PROC(QueueSubmit);
   DEFINE_PROC(QueueWaitIdle);
@@ -106,10 +108,14 @@ class VulkanProcTable : public fml::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(ResetFences);
   DEFINE_PROC(WaitForFences);
 #if OS_ANDROID
+  DEFINE_PROC(GetAndroidHardwareBufferPropertiesANDROID);
+  DEFINE_PROC(GetPastPresentationTimingGOOGLE);
   DEFINE_PROC(GetPhysicalDeviceSurfaceCapabilitiesKHR);
   DEFINE_PROC(GetPhysicalDeviceSurfaceFormatsKHR);
   DEFINE_PROC(GetPhysicalDeviceSurfacePresentModesKHR);
   DEFINE_PROC(GetPhysicalDeviceSurfaceSupportKHR);
+  DEFINE_PROC(GetRefreshCycleDurationGOOGLE);
+  DEFINE_PROC(GetSemaphoreFdKHR);
   DEFINE_PROC(GetSwapchainImagesKHR);
   DEFINE_PROC(QueuePresentKHR);
   DEFINE_PROC(CreateAndroidSurfaceKHR);
@@ -0,0 +1,638 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "vulkan_surface_control_swapchain.h"
+
+#include <poll.h>
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/gpu/GrBackendSemaphore.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/vk/GrVkTypes.h"
+#include "vulkan_device.h"
+#include "vulkan_proc_table.h"
+
+struct ASurfaceControl;
+struct ASurfaceTransaction;
+
+namespace vulkan {
+
+namespace {
+
+// One buffer shown, one queued to the compositor and one being rendered to.
+constexpr size_t kMaxBufferCount = 3;
+// How long to wait for the compositor to release a buffer before the frame
+// is dropped.
+constexpr std::chrono::milliseconds kBufferReleaseTimeout(500);
+
+// AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM.
+constexpr uint32_t kHardwareBufferFormatRGBA8888 = 1;
+// AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE,
+// AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT and
+// AHARDWAREBUFFER_USAGE_COMPOSER_OVERLAY, so that the compositor can either
+// scan the buffer out or sample it.
+constexpr uint64_t kHardwareBufferUsage = (1ull << 8) | (1ull << 9) |
+                                          (1ull << 11);
+// ASURFACE_TRANSACTION_VISIBILITY_SHOW.
+constexpr int8_t kSurfaceTransactionVisibilityShow = 1;
+
+// Has the layout of AHardwareBuffer_Desc.
+struct HardwareBufferDesc {
+  uint32_t width;
+  uint32_t height;
+  uint32_t layers;
+  uint32_t format;
+  uint64_t usage;
+  uint32_t stride;
+  uint32_t rfu0;
+  uint64_t rfu1;
+};
+
+using SurfaceTransactionOnComplete = void (*)(void* context,
+                                              ASurfaceTransactionStats* stats);
+
+// The surface control functions are only available from API level 29, so
+// they are resolved when first used rather than linked.
+struct SurfaceControlProcs {
+  ASurfaceControl* (*ASurfaceControl_createFromWindow)(ANativeWindow* parent,
+                                                       const char* debug_name);
+  void (*ASurfaceControl_release)(ASurfaceControl* surface_control);
+  ASurfaceTransaction* (*ASurfaceTransaction_create)();
+  void (*ASurfaceTransaction_delete)(ASurfaceTransaction* transaction);
+  void (*ASurfaceTransaction_apply)(ASurfaceTransaction* transaction);
+  void (*ASurfaceTransaction_setOnComplete)(
+      ASurfaceTransaction* transaction,
+      void* context,
+      SurfaceTransactionOnComplete func);
+  void (*ASurfaceTransaction_reparent)(ASurfaceTransaction* transaction,
+                                       ASurfaceControl* surface_control,
+                                       ASurfaceControl* new_parent);
+  void (*ASurfaceTransaction_setVisibility)(ASurfaceTransaction* transaction,
+                                            ASurfaceControl* surface_control,
+                                            int8_t visibility);
+  void (*ASurfaceTransaction_setBuffer)(ASurfaceTransaction* transaction,
+                                        ASurfaceControl* surface_control,
+                                        AHardwareBuffer* buffer,
+                                        int acquire_fence_fd);
+  int (*ASurfaceTransactionStats_getPreviousReleaseFenceFd)(
+      ASurfaceTransactionStats* stats,
+      ASurfaceControl* surface_control);
+  int (*AHardwareBuffer_allocate)(const HardwareBufferDesc* desc,
+                                  AHardwareBuffer** buffer);
+  void (*AHardwareBuffer_release)(AHardwareBuffer* buffer);
+
+  bool valid = false;
+};
+
+template <typename T>
+bool Resolve(const fml::RefPtr<fml::NativeLibrary>& library,
+             const char* name,
+             T& proc) {
+  proc = reinterpret_cast<T>(library->ResolveSymbol(name));
+  return proc != nullptr;
+}
+
+const SurfaceControlProcs& GetProcs() {
+  static const SurfaceControlProcs procs = []() {
+    SurfaceControlProcs procs = {};
+    // The library is never unloaded as the functions are kept.
+    static fml::RefPtr<fml::NativeLibrary> android =
+        fml::NativeLibrary::Create("libandroid.so");
+    if (!android) {
+      return procs;
+    }
+    procs.valid =
+        Resolve(android, "ASurfaceControl_createFromWindow",
+                procs.ASurfaceControl_createFromWindow) &&
+        Resolve(android, "ASurfaceControl_release",
+                procs.ASurfaceControl_release) &&
+        Resolve(android, "ASurfaceTransaction_create",
+                procs.ASurfaceTransaction_create) &&
+        Resolve(android, "ASurfaceTransaction_delete",
+                procs.ASurfaceTransaction_delete) &&
+        Resolve(android, "ASurfaceTransaction_apply",
+                procs.ASurfaceTransaction_apply) &&
+        Resolve(android, "ASurfaceTransaction_setOnComplete",
+                procs.ASurfaceTransaction_setOnComplete) &&
+        Resolve(android, "ASurfaceTransaction_reparent",
+                procs.ASurfaceTransaction_reparent) &&
+        Resolve(android, "ASurfaceTransaction_setVisibility",
+                procs.ASurfaceTransaction_setVisibility) &&
+        Resolve(android, "ASurfaceTransaction_setBuffer",
+                procs.ASurfaceTransaction_setBuffer) &&
+        Resolve(android, "ASurfaceTransactionStats_getPreviousReleaseFenceFd",
+                procs.ASurfaceTransactionStats_getPreviousReleaseFenceFd) &&
+        Resolve(android, "AHardwareBuffer_allocate",
+                procs.AHardwareBuffer_allocate) &&
+        Resolve(android, "AHardwareBuffer_release",
+                procs.AHardwareBuffer_release);
+    return procs;
+  }();
+  return procs;
+}
+
+void WaitForFence(const fml::UniqueFD& fence) {
+  if (!fence.is_valid()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "WaitForBufferRelease");
+  struct pollfd poll_fd = {};
+  poll_fd.fd = fence.get();
+  poll_fd.events = POLLIN;
+  while (poll(&poll_fd, 1, -1) < 0 && (errno == EINTR || errno == EAGAIN)) {
+  }
+}
+
+}  // namespace
+
+// Removes the layer from the window when the last swapchain using it goes
+// away. Releasing a surface control alone would keep it shown for as long as
+// its parent is.
+class VulkanSurfaceControlSwapchain::SurfaceControl {
+ public:
+  static std::shared_ptr<SurfaceControl> Create(ANativeWindow* window) {
+    ASurfaceControl* handle =
+        GetProcs().ASurfaceControl_createFromWindow(window, "Flutter");
+    if (handle == nullptr) {
+      return nullptr;
+    }
+    return std::shared_ptr<SurfaceControl>(new SurfaceControl(handle));
+  }
+
+  ~SurfaceControl() {
+    const SurfaceControlProcs& procs = GetProcs();
+    ASurfaceTransaction* transaction = procs.ASurfaceTransaction_create();
+    procs.ASurfaceTransaction_reparent(transaction, handle_, nullptr);
+    procs.ASurfaceTransaction_apply(transaction);
+    procs.ASurfaceTransaction_delete(transaction);
+    procs.ASurfaceControl_release(handle_);
+  }
+
+  ASurfaceControl* handle() const { return handle_; }
+
+ private:
+  ASurfaceControl* const handle_;
+
+  explicit SurfaceControl(ASurfaceControl* handle) : handle_(handle) {}
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SurfaceControl);
+};
+
+struct VulkanSurfaceControlSwapchain::Buffer {
+  const VulkanProcTable& vk;
+  const VulkanHandle<VkDevice>& device;
+  AHardwareBuffer* hardware_buffer = nullptr;
+  VkImage image = VK_NULL_HANDLE;
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  // Signaled by Skia when the frame is rendered, and exported as the acquire
+  // fence of the buffer.
+  VkSemaphore render_semaphore = VK_NULL_HANDLE;
+  sk_sp<SkSurface> surface;
+  // Whether the buffer was handed to the compositor and not released yet.
+  bool presented = false;
+  // Signals once the compositor is done reading the buffer.
+  fml::UniqueFD release_fence;
+
+  Buffer(const VulkanProcTable& p_vk, const VulkanHandle<VkDevice>& p_device)
+      : vk(p_vk), device(p_device) {}
+
+  ~Buffer() {
+    surface.reset();
+    if (render_semaphore != VK_NULL_HANDLE) {
+      vk.DestroySemaphore(device, render_semaphore, nullptr);
+    }
+    if (image != VK_NULL_HANDLE) {
+      vk.DestroyImage(device, image, nullptr);
+    }
+    if (memory != VK_NULL_HANDLE) {
+      vk.FreeMemory(device, memory, nullptr);
+    }
+    if (hardware_buffer != nullptr) {
+      GetProcs().AHardwareBuffer_release(hardware_buffer);
+    }
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Buffer);
+};
+
+// The buffers the compositor released, along with their release fences.
+struct VulkanSurfaceControlSwapchain::ReleasedBuffers {
+  std::mutex mutex;
+  std::condition_variable released;
+  std::vector<std::pair<size_t, fml::UniqueFD>> buffers;
+};
+
+// Passed to the completion callback of a transaction.
+struct VulkanSurfaceControlSwapchain::TransactionContext {
+  std::weak_ptr<ReleasedBuffers> released_buffers;
+  // Kept alive until the callback, which queries it for the release fence.
+  std::shared_ptr<SurfaceControl> surface_control;
+  // The buffer that the one of the transaction replaces on screen.
+  std::optional<size_t> replaced_buffer_index;
+};
+
+bool VulkanSurfaceControlSwapchain::IsSupported(const VulkanProcTable& vk,
+                                                const VulkanDevice& device) {
+  return GetProcs().valid && device.SupportsHardwareBufferPresentation() &&
+         vk.GetAndroidHardwareBufferPropertiesANDROID &&
+         vk.GetSemaphoreFdKHR;
+}
+
+VulkanSurfaceControlSwapchain::VulkanSurfaceControlSwapchain(
+    const VulkanProcTable& p_vk,
+    const VulkanDevice& device,
+    ANativeWindow* window,
+    GrDirectContext* skia_context,
+    const SkISize& size,
+    std::unique_ptr<VulkanSurfaceControlSwapchain> old_swapchain)
+    : vk(p_vk),
+      device_(device),
+      skia_context_(skia_context),
+      size_(size),
+      released_buffers_(std::make_shared<ReleasedBuffers>()) {
+  if (!device_.IsValid() || skia_context_ == nullptr || size_.isEmpty() ||
+      !IsSupported(vk, device_)) {
+    FML_DLOG(INFO) << "SurfaceControl swapchain is not supported.";
+    return;
+  }
+
+  if (old_swapchain != nullptr) {
+    surface_control_ = std::move(old_swapchain->surface_control_);
+  }
+  if (surface_control_ == nullptr) {
+    surface_control_ = SurfaceControl::Create(window);
+  }
+  if (surface_control_ == nullptr) {
+    FML_DLOG(INFO) << "Could not create the surface control.";
+    return;
+  }
+
+  // Buffers are allocated as they are needed, up to |kMaxBufferCount|.
+  auto buffer = CreateBuffer();
+  if (buffer == nullptr) {
+    FML_DLOG(INFO) << "Could not create a hardware buffer.";
+    return;
+  }
+  buffers_.emplace_back(std::move(buffer));
+
+  valid_ = true;
+}
+
+VulkanSurfaceControlSwapchain::~VulkanSurfaceControlSwapchain() {
+  // The images may still be rendered to.
+  FML_ALLOW_UNUSED_LOCAL(device_.WaitIdle());
+}
+
+bool VulkanSurfaceControlSwapchain::IsValid() const {
+  return valid_;
+}
+
+SkISize VulkanSurfaceControlSwapchain::GetSize() const {
+  return size_;
+}
+
+std::unique_ptr<VulkanSurfaceControlSwapchain::Buffer>
+VulkanSurfaceControlSwapchain::CreateBuffer() const {
+  auto buffer = std::make_unique<Buffer>(vk, device_.GetHandle());
+
+  const HardwareBufferDesc desc = {
+      .width = static_cast<uint32_t>(size_.width()),
+      .height = static_cast<uint32_t>(size_.height()),
+      .layers = 1,
+      .format = kHardwareBufferFormatRGBA8888,
+      .usage = kHardwareBufferUsage,
+      .stride = 0,
+      .rfu0 = 0,
+      .rfu1 = 0,
+  };
+  if (GetProcs().AHardwareBuffer_allocate(&desc, &buffer->hardware_buffer) !=
+      0) {
+    return nullptr;
+  }
+
+  VkAndroidHardwareBufferFormatPropertiesANDROID format_properties = {};
+  format_properties.sType =
+      VK_STRUCTURE_TYPE_ANDROID_HARDWARE_BUFFER_FORMAT_PROPERTIES_ANDROID;
+  VkAndroidHardwareBufferPropertiesANDROID properties = {};
+  properties.sType =
+      VK_STRUCTURE_TYPE_ANDROID_HARDWARE_BUFFER_PROPERTIES_ANDROID;
+  properties.pNext = &format_properties;
+  if (VK_CALL_LOG_ERROR(vk.GetAndroidHardwareBufferPropertiesANDROID(
+          device_.GetHandle(), buffer->hardware_buffer, &properties)) !=
+          VK_SUCCESS ||
+      properties.memoryTypeBits == 0) {
+    return nullptr;
+  }
+
+  const VkImageUsageFlags usage_flags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                        VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                                        VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                                        VK_IMAGE_USAGE_SAMPLED_BIT;
+
+  const VkExternalMemoryImageCreateInfo external_memory_image_info = {
+      .sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO,
+      .pNext = nullptr,
+      .handleTypes =
+          VK_EXTERNAL_MEMORY_HANDLE_TYPE_ANDROID_HARDWARE_BUFFER_BIT_ANDROID,
+  };
+  const VkImageCreateInfo image_info = {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+      .pNext = &external_memory_image_info,
+      .flags = 0,
+      .imageType = VK_IMAGE_TYPE_2D,
+      .format = VK_FORMAT_R8G8B8A8_UNORM,
+      .extent = {static_cast<uint32_t>(size_.width()),
+                 static_cast<uint32_t>(size_.height()), 1},
+      .mipLevels = 1,
+      .arrayLayers = 1,
+      .samples = VK_SAMPLE_COUNT_1_BIT,
+      .tiling = VK_IMAGE_TILING_OPTIMAL,
+      .usage = usage_flags,
+      .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+      .queueFamilyIndexCount = 0,
+      .pQueueFamilyIndices = nullptr,
+      .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+  if (VK_CALL_LOG_ERROR(vk.CreateImage(device_.GetHandle(), &image_info,
+                                       nullptr, &buffer->image)) !=
+      VK_SUCCESS) {
+    return nullptr;
+  }
+
+  // Any memory type the buffer can be imported as will do.
+  uint32_t memory_type_index = 0;
+  while ((properties.memoryTypeBits & (1u << memory_type_index)) == 0) {
+    memory_type_index++;
+  }
+  const VkImportAndroidHardwareBufferInfoANDROID import_info = {
+      .sType = VK_STRUCTURE_TYPE_IMPORT_ANDROID_HARDWARE_BUFFER_INFO_ANDROID,
+      .pNext = nullptr,
+      .buffer = buffer->hardware_buffer,
+  };
+  const VkMemoryDedicatedAllocateInfo dedicated_info = {
+      .sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+      .pNext = &import_info,
+      .image = buffer->image,
+      .buffer = VK_NULL_HANDLE,
+  };
+  const VkMemoryAllocateInfo allocate_info = {
+      .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+      .pNext = &dedicated_info,
+      .allocationSize = properties.allocationSize,
+      .memoryTypeIndex = memory_type_index,
+  };
+  if (VK_CALL_LOG_ERROR(vk.AllocateMemory(device_.GetHandle(), &allocate_info,
+                                          nullptr, &buffer->memory)) !=
+          VK_SUCCESS ||
+      VK_CALL_LOG_ERROR(vk.BindImageMemory(device_.GetHandle(), buffer->image,
+                                           buffer->memory, 0)) != VK_SUCCESS) {
+    return nullptr;
+  }
+
+  const VkExportSemaphoreCreateInfo export_semaphore_info = {
+      .sType = VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO,
+      .pNext = nullptr,
+      .handleTypes = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT,
+  };
+  const VkSemaphoreCreateInfo semaphore_info = {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+      .pNext = &export_semaphore_info,
+      .flags = 0,
+  };
+  if (VK_CALL_LOG_ERROR(vk.CreateSemaphore(device_.GetHandle(),
+                                           &semaphore_info, nullptr,
+                                           &buffer->render_semaphore)) !=
+      VK_SUCCESS) {
+    return nullptr;
+  }
+
+  // The compositor reads the image once its acquire fence signals. Flushing
+  // the surface for presentation transitions it to the present layout.
+  GrVkImageInfo image_info_skia;
+  image_info_skia.fImage = buffer->image;
+  image_info_skia.fAlloc =
+      GrVkAlloc(buffer->memory, 0, properties.allocationSize, 0);
+  image_info_skia.fImageTiling = VK_IMAGE_TILING_OPTIMAL;
+  image_info_skia.fImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  image_info_skia.fFormat = VK_FORMAT_R8G8B8A8_UNORM;
+  image_info_skia.fImageUsageFlags = usage_flags;
+  image_info_skia.fSampleCount = 1;
+  image_info_skia.fLevelCount = 1;
+  image_info_skia.fCurrentQueueFamily = device_.GetGraphicsQueueIndex();
+  image_info_skia.fSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  GrBackendRenderTarget backend_render_target(size_.width(), size_.height(),
+                                              0, image_info_skia);
+  SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+  buffer->surface = SkSurface::MakeFromBackendRenderTarget(
+      skia_context_,             // context
+      backend_render_target,     // backend render target
+      kTopLeft_GrSurfaceOrigin,  // origin
+      kRGBA_8888_SkColorType,    // color type
+      SkColorSpace::MakeSRGB(),  // color space
+      &props                     // surface properties
+  );
+  if (buffer->surface == nullptr) {
+    return nullptr;
+  }
+
+  return buffer;
+}
+
+void VulkanSurfaceControlSwapchain::CollectReleasedBuffers() {
+  std::scoped_lock lock(released_buffers_->mutex);
+  for (auto& released : released_buffers_->buffers) {
+    if (released.first >= buffers_.size()) {
+      continue;
+    }
+    Buffer& buffer = *buffers_[released.first];
+    buffer.presented = false;
+    buffer.release_fence = std::move(released.second);
+  }
+  released_buffers_->buffers.clear();
+}
+
+std::optional<size_t> VulkanSurfaceControlSwapchain::GetAvailableBufferIndex() {
+  CollectReleasedBuffers();
+  for (size_t i = 0; i < buffers_.size(); i++) {
+    if (!buffers_[i]->presented) {
+      return i;
+    }
+  }
+
+  if (buffers_.size() < kMaxBufferCount) {
+    auto buffer = CreateBuffer();
+    if (buffer != nullptr) {
+      buffers_.emplace_back(std::move(buffer));
+      return buffers_.size() - 1;
+    }
+  }
+
+  // Every buffer is on screen or queued to the compositor. Wait for the next
+  // one to be replaced.
+  TRACE_EVENT0("flutter", "WaitForAvailableBuffer");
+  {
+    std::unique_lock lock(released_buffers_->mutex);
+    released_buffers_->released.wait_for(
+        lock, kBufferReleaseTimeout,
+        [this]() { return !released_buffers_->buffers.empty(); });
+  }
+  CollectReleasedBuffers();
+  for (size_t i = 0; i < buffers_.size(); i++) {
+    if (!buffers_[i]->presented) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+VulkanSwapchain::AcquireResult VulkanSurfaceControlSwapchain::AcquireSurface() {
+  VulkanSwapchain::AcquireResult error = {
+      VulkanSwapchain::AcquireStatus::ErrorSurfaceLost, nullptr};
+
+  if (!IsValid()) {
+    FML_DLOG(INFO) << "Swapchain was invalid.";
+    return error;
+  }
+
+  std::optional<size_t> index = GetAvailableBufferIndex();
+  if (!index.has_value()) {
+    FML_DLOG(INFO) << "The compositor did not release a buffer in time.";
+    return error;
+  }
+
+  Buffer& buffer = *buffers_[index.value()];
+  // Rendering must not start before the compositor is done with the
+  // previous contents of the buffer. The pool is deep enough for the fence
+  // to have signaled already in the common case.
+  WaitForFence(buffer.release_fence);
+  buffer.release_fence.reset();
+
+  acquired_buffer_index_ = index;
+  return {VulkanSwapchain::AcquireStatus::Success, buffer.surface};
+}
+
+bool VulkanSurfaceControlSwapchain::Submit() {
+  if (!IsValid() || !acquired_buffer_index_.has_value()) {
+    FML_DLOG(INFO) << "No buffer was acquired.";
+    return false;
+  }
+
+  const size_t index = acquired_buffer_index_.value();
+  acquired_buffer_index_.reset();
+  Buffer& buffer = *buffers_[index];
+
+  // ---------------------------------------------------------------------------
+  // Step 0:
+  // Flush the frame, and have Skia signal the render semaphore once it is
+  // rendered.
+  // ---------------------------------------------------------------------------
+  GrBackendSemaphore render_semaphore;
+  render_semaphore.initVulkan(buffer.render_semaphore);
+  GrFlushInfo flush_info;
+  flush_info.fNumSemaphores = 1;
+  flush_info.fSignalSemaphores = &render_semaphore;
+  const bool semaphore_submitted =
+      buffer.surface->flush(SkSurface::BackendSurfaceAccess::kPresent,
+                            flush_info) == GrSemaphoresSubmitted::kYes;
+  if (!skia_context_->submit()) {
+    FML_DLOG(INFO) << "Could not submit the frame.";
+    return false;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Step 1:
+  // Export the acquire fence the compositor waits on. Exporting a sync fence
+  // unsignals the semaphore, so that it can be signaled again next time the
+  // buffer is rendered to.
+  // ---------------------------------------------------------------------------
+  fml::UniqueFD acquire_fence;
+  if (semaphore_submitted) {
+    const VkSemaphoreGetFdInfoKHR get_fd_info = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR,
+        .pNext = nullptr,
+        .semaphore = buffer.render_semaphore,
+        .handleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT,
+    };
+    int fd = -1;
+    if (VK_CALL_LOG_ERROR(vk.GetSemaphoreFdKHR(device_.GetHandle(),
+                                               &get_fd_info, &fd)) !=
+        VK_SUCCESS) {
+      // The semaphore is left signaled and cannot be used again.
+      FML_DLOG(INFO) << "Could not export the acquire fence.";
+      valid_ = false;
+      return false;
+    }
+    acquire_fence.reset(fd);
+  } else {
+    // Without a fence, the compositor must only get the buffer once it is
+    // rendered.
+    FML_ALLOW_UNUSED_LOCAL(device_.WaitIdle());
+  }
+
+  // ---------------------------------------------------------------------------
+  // Step 2:
+  // Hand the buffer to the compositor. The buffer it replaces is released
+  // once it is no longer shown, which the completion callback reports.
+  // ---------------------------------------------------------------------------
+  const SurfaceControlProcs& procs = GetProcs();
+  ASurfaceTransaction* transaction = procs.ASurfaceTransaction_create();
+  if (transaction == nullptr) {
+    FML_DLOG(INFO) << "Could not create the transaction.";
+    return false;
+  }
+  procs.ASurfaceTransaction_setBuffer(transaction, surface_control_->handle(),
+                                      buffer.hardware_buffer,
+                                      acquire_fence.release());
+  procs.ASurfaceTransaction_setVisibility(transaction,
+                                          surface_control_->handle(),
+                                          kSurfaceTransactionVisibilityShow);
+  auto* context = new TransactionContext{
+      .released_buffers = released_buffers_,
+      .surface_control = surface_control_,
+      .replaced_buffer_index = presented_buffer_index_,
+  };
+  procs.ASurfaceTransaction_setOnComplete(transaction, context,
+                                          &OnTransactionComplete);
+  procs.ASurfaceTransaction_apply(transaction);
+  procs.ASurfaceTransaction_delete(transaction);
+
+  buffer.presented = true;
+  presented_buffer_index_ = index;
+  return true;
+}
+
+// static
+void VulkanSurfaceControlSwapchain::OnTransactionComplete(
+    void* context,
+    ASurfaceTransactionStats* stats) {
+  auto* transaction_context = reinterpret_cast<TransactionContext*>(context);
+  if (transaction_context->replaced_buffer_index.has_value()) {
+    fml::UniqueFD release_fence(
+        GetProcs().ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+            stats, transaction_context->surface_control->handle()));
+    auto released_buffers = transaction_context->released_buffers.lock();
+    // The swapchain may have been recreated in the meantime.
+    if (released_buffers) {
+      std::scoped_lock lock(released_buffers->mutex);
+      released_buffers->buffers.emplace_back(
+          transaction_context->replaced_buffer_index.value(),
+          std::move(release_fence));
+      released_buffers->released.notify_all();
+    }
+  }
+  delete transaction_context;
+}
+
+}  // namespace vulkan
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_VULKAN_VULKAN_SURFACE_CONTROL_SWAPCHAIN_H_
+#define FLUTTER_VULKAN_VULKAN_SURFACE_CONTROL_SWAPCHAIN_H_
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "vulkan_swapchain.h"
+
+struct ANativeWindow;
+struct ASurfaceTransactionStats;
+
+namespace vulkan {
+
+class VulkanDevice;
+class VulkanProcTable;
+
+/// A swapchain that renders into a pool of `AHardwareBuffer`s imported as
+/// Vulkan images, and presents a frame by setting its buffer on a child
+/// `ASurfaceControl` of the window in an `ASurfaceTransaction`.
+///
+/// The buffer is handed to the compositor along with a sync fence exported
+/// from a semaphore Skia signals once it is done rendering, so neither the
+/// raster thread nor a present queue waits for the GPU. A buffer is only
+/// rendered to again once the compositor has released it, which it reports
+/// with a release fence when the buffer is replaced on screen.
+///
+/// This requires API level 29 and a device that supports
+/// |VulkanDevice::SupportsHardwareBufferPresentation|.
+class VulkanSurfaceControlSwapchain {
+ public:
+  static bool IsSupported(const VulkanProcTable& vk,
+                          const VulkanDevice& device);
+
+  /// Creates a swapchain of |size| for |window|. The surface control of
+  /// |old_swapchain| is reused if there is one, so that recreating the
+  /// swapchain, for example on resize, does not add another layer.
+  VulkanSurfaceControlSwapchain(
+      const VulkanProcTable& vk,
+      const VulkanDevice& device,
+      ANativeWindow* window,
+      GrDirectContext* skia_context,
+      const SkISize& size,
+      std::unique_ptr<VulkanSurfaceControlSwapchain> old_swapchain);
+
+  ~VulkanSurfaceControlSwapchain();
+
+  bool IsValid() const;
+
+  /// See |VulkanSwapchain::AcquireSurface|.
+  VulkanSwapchain::AcquireResult AcquireSurface();
+
+  /// See |VulkanSwapchain::Submit|.
+  [[nodiscard]] bool Submit();
+
+  SkISize GetSize() const;
+
+ private:
+  class SurfaceControl;
+  struct Buffer;
+  struct ReleasedBuffers;
+  struct TransactionContext;
+
+  const VulkanProcTable& vk;
+  const VulkanDevice& device_;
+  GrDirectContext* skia_context_;
+  const SkISize size_;
+  std::shared_ptr<SurfaceControl> surface_control_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+  // Shared with the callbacks of the transactions, which run on a binder
+  // thread and may outlive the swapchain.
+  std::shared_ptr<ReleasedBuffers> released_buffers_;
+  std::optional<size_t> acquired_buffer_index_;
+  std::optional<size_t> presented_buffer_index_;
+  bool valid_ = false;
+
+  std::unique_ptr<Buffer> CreateBuffer() const;
+
+  std::optional<size_t> GetAvailableBufferIndex();
+
+  void CollectReleasedBuffers();
+
+  static void OnTransactionComplete(void* context,
+                                    ASurfaceTransactionStats* stats);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VulkanSurfaceControlSwapchain);
+};
+
+}  // namespace vulkan
+
+#endif  // FLUTTER_VULKAN_VULKAN_SURFACE_CONTROL_SWAPCHAIN_H_
@@ -4,6 +4,8 @@
 
 #include "vulkan_swapchain.h"
 
+#include <algorithm>
+
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkTypes.h"
@@ -41,7 +43,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
                                  const VulkanSurface& surface,
                                  GrDirectContext* skia_context,
                                  std::unique_ptr<VulkanSwapchain> old_swapchain,
-                                 uint32_t queue_family_index)
+                                 uint32_t queue_family_index,
+                                 const VulkanSwapchainConfig& config)
     : vk(p_vk),
       device_(device),
       capabilities_(),
@@ -79,11 +82,24 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
   }
 
   VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
-  if (!device_.ChoosePresentMode(surface, &present_mode)) {
+  if (!device_.ChoosePresentMode(surface, config.present_mode,
+                                 &present_mode)) {
     FML_DLOG(INFO) << "Could not choose present mode.";
     return;
   }
 
+  // Mailbox only helps when an image can be rendered to while one is queued
+  // and another one is shown, which the minimum does not always allow.
+  uint32_t image_count = config.image_count;
+  if (image_count == 0 && present_mode == VK_PRESENT_MODE_MAILBOX_KHR) {
+    image_count = capabilities_.minImageCount + 1;
+  }
+  // A maxImageCount of zero means that there is no upper limit.
+  image_count = std::max(image_count, capabilities_.minImageCount);
+  if (capabilities_.maxImageCount > 0) {
+    image_count = std::min(image_count, capabilities_.maxImageCount);
+  }
+
   // Check if the surface can present.
 
   VkBool32 supported = VK_FALSE;
@@ -122,7 +138,7 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
       .pNext = nullptr,
       .flags = 0,
       .surface = surface_handle,
-      .minImageCount = capabilities_.minImageCount,
+      .minImageCount = image_count,
       .imageFormat = surface_format_.format,
       .imageColorSpace = surface_format_.colorSpace,
       .imageExtent = capabilities_.currentExtent,
@@ -160,6 +176,16 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
     return;
   }
 
+  if (config.enable_display_timing && device_.SupportsDisplayTiming() &&
+      vk.GetRefreshCycleDurationGOOGLE && vk.GetPastPresentationTimingGOOGLE) {
+    VkRefreshCycleDurationGOOGLE refresh_cycle = {};
+    if (VK_CALL_LOG_ERROR(vk.GetRefreshCycleDurationGOOGLE(
+            device_.GetHandle(), swapchain_, &refresh_cycle)) == VK_SUCCESS) {
+      refresh_duration_ns_ = refresh_cycle.refreshDuration;
+      display_timing_enabled_ = true;
+    }
+  }
+
   valid_ = true;
 }
 
@@ -563,9 +589,23 @@ bool VulkanSwapchain::Submit() {
   // ---------------------------------------------------------------------------
   VkSwapchainKHR swapchain = swapchain_;
   uint32_t present_image_index = static_cast<uint32_t>(current_image_index_);
+
+  // The present is tagged so that its timing can be queried later. A desired
+  // present time of zero shows the image as soon as possible.
+  const VkPresentTimeGOOGLE present_time = {
+      .presentID = next_present_id_++,
+      .desiredPresentTime = 0,
+  };
+  const VkPresentTimesInfoGOOGLE present_times_info = {
+      .sType = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE,
+      .pNext = nullptr,
+      .swapchainCount = 1,
+      .pTimes = &present_time,
+  };
+
   const VkPresentInfoKHR present_info = {
       .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-      .pNext = nullptr,
+      .pNext = display_timing_enabled_ ? &present_times_info : nullptr,
       .waitSemaphoreCount =
           static_cast<uint32_t>(queue_signal_semaphores.size()),
       .pWaitSemaphores = queue_signal_semaphores.data(),
@@ -584,4 +624,39 @@ bool VulkanSwapchain::Submit() {
   return true;
 }
 
+bool VulkanSwapchain::TakePresentationFeedback(
+    VulkanPresentationFeedback* feedback) {
+  if (!IsValid() || !display_timing_enabled_ || feedback == nullptr) {
+    return false;
+  }
+
+  uint32_t count = 0;
+  if (VK_CALL_LOG_ERROR(vk.GetPastPresentationTimingGOOGLE(
+          device_.GetHandle(), swapchain_, &count, nullptr)) != VK_SUCCESS ||
+      count == 0) {
+    return false;
+  }
+
+  std::vector<VkPastPresentationTimingGOOGLE> timings(count);
+  VkResult result = vk.GetPastPresentationTimingGOOGLE(
+      device_.GetHandle(), swapchain_, &count, timings.data());
+  // VK_INCOMPLETE only means that more images were shown in the meantime.
+  // Those are collected by the next call.
+  if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || count == 0) {
+    return false;
+  }
+
+  uint32_t late_presents = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (timings[i].actualPresentTime > timings[i].earliestPresentTime) {
+      late_presents++;
+    }
+  }
+
+  feedback->refresh_duration_ns = refresh_duration_ns_;
+  feedback->present_margin_ns = timings[count - 1].presentMargin;
+  feedback->late_presents = late_presents;
+  return true;
+}
+
 }  // namespace vulkan
@@ -23,6 +23,36 @@ class VulkanSurface;
 class VulkanBackbuffer;
 class VulkanImage;
 
+// How a swapchain queues its images to the display.
+struct VulkanSwapchainConfig {
+  // Used if the surface supports it, VK_PRESENT_MODE_FIFO_KHR otherwise.
+  // Mailbox replaces a queued image with a newer one instead of waiting for
+  // it to be shown, and FIFO relaxed shows an image that missed its vsync
+  // right away instead of a refresh later.
+  VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
+  // The number of swapchain images to ask for, clamped to what the surface
+  // supports. Zero asks for the minimum the surface supports.
+  uint32_t image_count = 0;
+  // Collect presentation timings through VK_GOOGLE_display_timing if the
+  // device supports it. See |VulkanSwapchain::TakePresentationFeedback|.
+  bool enable_display_timing = false;
+  // Present through a |VulkanSurfaceControlSwapchain| if the device supports
+  // it. The present mode and image count do not apply to it.
+  bool use_surface_control = false;
+};
+
+// How the images presented since the last query met the display.
+struct VulkanPresentationFeedback {
+  // The duration of a refresh cycle of the display.
+  uint64_t refresh_duration_ns = 0;
+  // How much earlier than necessary the latest image was handed to the
+  // presentation engine.
+  uint64_t present_margin_ns = 0;
+  // The number of images that were shown later than the earliest time they
+  // could have been, because earlier images were still queued.
+  uint32_t late_presents = 0;
+};
+
 class VulkanSwapchain {
  public:
   VulkanSwapchain(const VulkanProcTable& vk,
@@ -30,7 +60,8 @@ class VulkanSwapchain {
                   const VulkanSurface& surface,
                   GrDirectContext* skia_context,
                   std::unique_ptr<VulkanSwapchain> old_swapchain,
-                  uint32_t queue_family_index);
+                  uint32_t queue_family_index,
+                  const VulkanSwapchainConfig& config = {});
 
   ~VulkanSwapchain();
 
@@ -60,6 +91,11 @@ class VulkanSwapchain {
 
   SkISize GetSize() const;
 
+  /// Collects the timings of the images presented since the last call. Returns
+  /// false if display timing was not enabled in the |VulkanSwapchainConfig|
+  /// or is not supported, or if no image was shown since the last call.
+  bool TakePresentationFeedback(VulkanPresentationFeedback* feedback);
+
 #if OS_ANDROID
  private:
   const VulkanProcTable& vk;
@@ -73,6 +109,9 @@ class VulkanSwapchain {
   VkPipelineStageFlagBits current_pipeline_stage_;
   size_t current_backbuffer_index_;
   size_t current_image_index_;
+  bool display_timing_enabled_ = false;
+  uint32_t next_present_id_ = 0;
+  uint64_t refresh_duration_ns_ = 0;
   bool valid_;
 
   std::vector<VkImage> GetImages() const;
@@ -11,7 +11,8 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
                                  const VulkanSurface& surface,
                                  GrDirectContext* skia_context,
                                  std::unique_ptr<VulkanSwapchain> old_swapchain,
-                                 uint32_t queue_family_index) {}
+                                 uint32_t queue_family_index,
+                                 const VulkanSwapchainConfig& config) {}
 
 VulkanSwapchain::~VulkanSwapchain() = default;
 
@@ -31,4 +32,9 @@ SkISize VulkanSwapchain::GetSize() const {
   return SkISize::Make(0, 0);
 }
 
+bool VulkanSwapchain::TakePresentationFeedback(
+    VulkanPresentationFeedback* feedback) {
+  return false;
+}
+
 }  // namespace vulkan
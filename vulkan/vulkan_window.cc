@@ -16,12 +16,21 @@
 #include "vulkan_surface.h"
 #include "vulkan_swapchain.h"
 
+#if OS_ANDROID
+#include "vulkan_native_surface_android.h"
+#include "vulkan_surface_control_swapchain.h"
+#endif  // OS_ANDROID
+
 namespace vulkan {
 
 VulkanWindow::VulkanWindow(fml::RefPtr<VulkanProcTable> proc_table,
                            std::unique_ptr<VulkanNativeSurface> native_surface,
-                           bool render_to_surface)
-    : valid_(false), vk(std::move(proc_table)) {
+                           bool render_to_surface,
+                           const VulkanSwapchainConfig& swapchain_config,
+                           GrContextOptions::PersistentCache* persistent_cache)
+    : valid_(false),
+      vk(std::move(proc_table)),
+      swapchain_config_(swapchain_config) {
   if (!vk || !vk->HasAcquiredMandatoryProcAddresses()) {
     FML_DLOG(INFO) << "Proc table has not acquired mandatory proc addresses.";
     return;
@@ -78,7 +87,7 @@ VulkanWindow::VulkanWindow(fml::RefPtr<VulkanProcTable> proc_table,
 
   // Create the Skia GrDirectContext.
 
-  if (!CreateSkiaGrContext()) {
+  if (!CreateSkiaGrContext(persistent_cache)) {
     FML_DLOG(INFO) << "Could not create Skia context.";
     return;
   }
@@ -103,14 +112,19 @@ GrDirectContext* VulkanWindow::GetSkiaGrContext() {
   return skia_gr_context_.get();
 }
 
-bool VulkanWindow::CreateSkiaGrContext() {
+bool VulkanWindow::CreateSkiaGrContext(
+    GrContextOptions::PersistentCache* persistent_cache) {
   GrVkBackendContext backend_context;
 
   if (!CreateSkiaBackendContext(&backend_context)) {
     return false;
   }
 
-  sk_sp<GrDirectContext> context = GrDirectContext::MakeVulkan(backend_context);
+  GrContextOptions options;
+  options.fPersistentCache = persistent_cache;
+
+  sk_sp<GrDirectContext> context =
+      GrDirectContext::MakeVulkan(backend_context, options);
 
   if (context == nullptr) {
     return false;
@@ -158,6 +172,30 @@ sk_sp<SkSurface> VulkanWindow::AcquireSurface() {
 
   auto surface_size = surface_->GetSize();
 
+#if OS_ANDROID
+  if (surface_control_swapchain_ != nullptr) {
+    if (!surface_control_swapchain_->IsValid() ||
+        (surface_size != SkISize::Make(0, 0) &&
+         surface_size != surface_control_swapchain_->GetSize())) {
+      if (!RecreateSwapchain()) {
+        FML_DLOG(INFO) << "Could not recreate swapchain.";
+        valid_ = false;
+        return nullptr;
+      }
+    }
+    // Recreating the swapchain falls back to |swapchain_| if the surface
+    // control could not be set up again.
+    if (surface_control_swapchain_ != nullptr) {
+      auto acquire_result = surface_control_swapchain_->AcquireSurface();
+      if (acquire_result.first != VulkanSwapchain::AcquireStatus::Success) {
+        FML_DLOG(INFO) << "Could not acquire a buffer.";
+        return nullptr;
+      }
+      return acquire_result.second;
+    }
+  }
+#endif  // OS_ANDROID
+
   // This check is theoretically unnecessary as the swapchain should report that
   // the surface is out-of-date and perform swapchain recreation at the new
   // configuration. However, on Android, the swapchain never reports that it is
@@ -221,9 +259,47 @@ bool VulkanWindow::SwapBuffers() {
     return false;
   }
 
+#if OS_ANDROID
+  if (surface_control_swapchain_ != nullptr) {
+    return surface_control_swapchain_->Submit();
+  }
+#endif  // OS_ANDROID
+
   return swapchain_->Submit();
 }
 
+bool VulkanWindow::TakePresentationFeedback(
+    VulkanPresentationFeedback* feedback) {
+  if (!IsValid()) {
+    return false;
+  }
+
+#if OS_ANDROID
+  // Presentation timings are only collected through display timing.
+  if (surface_control_swapchain_ != nullptr) {
+    return false;
+  }
+#endif  // OS_ANDROID
+
+  return swapchain_->TakePresentationFeedback(feedback);
+}
+
+std::string VulkanWindow::GetPipelineCacheUUID() const {
+  if (logical_device_ == nullptr) {
+    return "";
+  }
+
+  return logical_device_->GetPipelineCacheUUID();
+}
+
+void VulkanWindow::StorePipelineCacheData() {
+  if (skia_gr_context_ == nullptr) {
+    return;
+  }
+
+  skia_gr_context_->storeVkPipelineCacheData();
+}
+
 bool VulkanWindow::RecreateSwapchain() {
   // This way, we always lose our reference to the old swapchain. Even if we
   // cannot create a new one to replace it.
@@ -245,9 +321,30 @@ bool VulkanWindow::RecreateSwapchain() {
     return false;
   }
 
+#if OS_ANDROID
+  if (swapchain_config_.use_surface_control &&
+      VulkanSurfaceControlSwapchain::IsSupported(*vk, *logical_device_)) {
+    // The native surface of a window is always an Android one here.
+    const auto& native_surface = static_cast<const VulkanNativeSurfaceAndroid&>(
+        surface_->GetNativeSurface());
+    auto surface_control_swapchain =
+        std::make_unique<VulkanSurfaceControlSwapchain>(
+            *vk, *logical_device_, native_surface.GetNativeWindow(),
+            skia_gr_context_.get(), surface_->GetSize(),
+            std::move(surface_control_swapchain_));
+    if (surface_control_swapchain->IsValid()) {
+      surface_control_swapchain_ = std::move(surface_control_swapchain);
+      return true;
+    }
+    FML_LOG(INFO) << "Could not present through a surface control. Falling "
+                     "back to a swapchain.";
+  }
+#endif  // OS_ANDROID
+
   auto swapchain = std::make_unique<VulkanSwapchain>(
       *vk, *logical_device_, *surface_, skia_gr_context_.get(),
-      std::move(old_swapchain), logical_device_->GetGraphicsQueueIndex());
+      std::move(old_swapchain), logical_device_->GetGraphicsQueueIndex(),
+      swapchain_config_);
 
   if (!swapchain->IsValid()) {
     return false;
@@ -6,34 +6,40 @@
 #define FLUTTER_VULKAN_VULKAN_WINDOW_H_
 
 #include <memory>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrContextOptions.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkBackendContext.h"
 #include "vulkan_proc_table.h"
+#include "vulkan_swapchain.h"
 
 namespace vulkan {
 
 class VulkanNativeSurface;
 class VulkanDevice;
 class VulkanSurface;
-class VulkanSwapchain;
 class VulkanImage;
 class VulkanApplication;
 class VulkanBackbuffer;
+class VulkanSurfaceControlSwapchain;
 
 class VulkanWindow {
  public:
   VulkanWindow(fml::RefPtr<VulkanProcTable> proc_table,
                std::unique_ptr<VulkanNativeSurface> native_surface,
-               bool render_to_surface);
+               bool render_to_surface,
+               const VulkanSwapchainConfig& swapchain_config = {},
+               GrContextOptions::PersistentCache* persistent_cache = nullptr);
 
   ~VulkanWindow();
 
@@ -45,16 +51,33 @@ class VulkanWindow {
 
   bool SwapBuffers();
 
+  // See |VulkanSwapchain::TakePresentationFeedback|.
+  bool TakePresentationFeedback(VulkanPresentationFeedback* feedback);
+
+  // See |VulkanDevice::GetPipelineCacheUUID|.
+  std::string GetPipelineCacheUUID() const;
+
+  // Stores the pipeline cache of the Skia context in the persistent cache the
+  // window was created with, if any. Skia only reads the stored data when it
+  // creates its first pipeline.
+  void StorePipelineCacheData();
+
  private:
   bool valid_;
   fml::RefPtr<VulkanProcTable> vk;
   std::unique_ptr<VulkanApplication> application_;
   std::unique_ptr<VulkanDevice> logical_device_;
   std::unique_ptr<VulkanSurface> surface_;
+  const VulkanSwapchainConfig swapchain_config_;
   std::unique_ptr<VulkanSwapchain> swapchain_;
+#if OS_ANDROID
+  // Used instead of |swapchain_| if the swapchain config asks for it and the
+  // device supports it.
+  std::unique_ptr<VulkanSurfaceControlSwapchain> surface_control_swapchain_;
+#endif  // OS_ANDROID
   sk_sp<GrDirectContext> skia_gr_context_;
 
-  bool CreateSkiaGrContext();
+  bool CreateSkiaGrContext(GrContextOptions::PersistentCache* persistent_cache);
 
   bool CreateSkiaBackendContext(GrVkBackendContext* context);
 